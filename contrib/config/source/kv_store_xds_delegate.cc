@@ -3,11 +3,13 @@
 #include "envoy/registry/registry.h"
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/common/logger.h"
 #include "source/common/config/utility.h"
 #include "source/common/protobuf/utility.h"
 
 #include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/optional.h"
 #include "contrib/envoy/extensions/config/v3alpha/kv_store_xds_delegate_config.pb.h"
@@ -27,6 +29,11 @@ std::string constructKey(const XdsSourceId& source_id, const std::string& resour
   return absl::StrCat(source_id.toKey(), DELIMITER, resource_name);
 }
 
+// The persisted resources whose integrity is verified are prefixed by the format version and the
+// hex xxHash64 of the serialized resource.
+constexpr absl::string_view IntegrityFormatPrefix = "xds-v1:";
+constexpr size_t ChecksumLength = 16;
+
 } // namespace
 
 XdsKeyValueStoreStats KeyValueStoreXdsDelegate::generateStats(Stats::Scope& scope) {
@@ -34,10 +41,46 @@ XdsKeyValueStoreStats KeyValueStoreXdsDelegate::generateStats(Stats::Scope& scop
 }
 
 KeyValueStoreXdsDelegate::KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store,
-                                                   Stats::Scope& root_scope)
-    : xds_config_store_(std::move(xds_config_store)),
+                                                   Stats::Scope& root_scope, bool verify_integrity)
+    : verify_integrity_(verify_integrity), xds_config_store_(std::move(xds_config_store)),
       scope_(root_scope.createScope("xds.kv_store.")), stats_(generateStats(*scope_)) {}
 
+absl::optional<envoy::service::discovery::v3::Resource>
+KeyValueStoreXdsDelegate::parseResource(absl::string_view value) const {
+  if (verify_integrity_) {
+    uint64_t checksum;
+    if (!absl::ConsumePrefix(&value, IntegrityFormatPrefix) || value.size() < ChecksumLength ||
+        !absl::SimpleHexAtoi(value.substr(0, ChecksumLength), &checksum) ||
+        checksum != HashUtil::xxHash64(value.substr(ChecksumLength))) {
+      stats_.integrity_check_failed_.inc();
+      return absl::nullopt;
+    }
+    value.remove_prefix(ChecksumLength);
+  }
+  envoy::service::discovery::v3::Resource resource;
+  if (!resource.ParseFromArray(value.data(), value.size())) {
+    stats_.parse_failed_.inc();
+    return absl::nullopt;
+  }
+  return resource;
+}
+
+bool KeyValueStoreXdsDelegate::serializeResource(
+    const envoy::service::discovery::v3::Resource& resource, std::string& value) const {
+  std::string serialized_resource;
+  if (!resource.SerializeToString(&serialized_resource)) {
+    return false;
+  }
+  if (verify_integrity_) {
+    value = absl::StrCat(IntegrityFormatPrefix,
+                         absl::Hex(HashUtil::xxHash64(serialized_resource), absl::kZeroPad16),
+                         serialized_resource);
+  } else {
+    value = std::move(serialized_resource);
+  }
+  return true;
+}
+
 std::vector<envoy::service::discovery::v3::Resource> KeyValueStoreXdsDelegate::getResources(
     const XdsSourceId& source_id, const absl::flat_hash_set<std::string>& resource_names) const {
   std::vector<envoy::service::discovery::v3::Resource> resources;
@@ -49,15 +92,14 @@ std::vector<envoy::service::discovery::v3::Resource> KeyValueStoreXdsDelegate::g
     for (const std::string& resource_name : resource_names) {
       const std::string resource_key = constructKey(source_id, resource_name);
       if (const auto existing_resource = xds_config_store_->get(resource_key)) {
-        envoy::service::discovery::v3::Resource r;
-        if (r.ParseFromString(std::string(*existing_resource))) {
-          resources.push_back(std::move(r));
+        if (auto r = parseResource(*existing_resource)) {
+          resources.push_back(std::move(*r));
         } else {
-          // Resource failed to parse; this shouldn't happen unless fields get removed from the
-          // proto. Since the serialized resource in the KV store is no longer parseable into an
-          // xDS resource, we'll remove it from the store and not use it in xDS processing.
+          // Resource failed to parse or to match its checksum; this shouldn't happen unless fields
+          // get removed from the proto or the store is corrupted. Since the serialized resource in
+          // the KV store is no longer usable, we'll remove it from the store and not use it in xDS
+          // processing.
           xds_config_store_->remove(resource_key);
-          stats_.parse_failed_.inc();
         }
       } else {
         stats_.resource_missing_.inc();
@@ -77,19 +119,27 @@ std::vector<envoy::service::discovery::v3::Resource> KeyValueStoreXdsDelegate::g
 std::vector<envoy::service::discovery::v3::Resource>
 KeyValueStoreXdsDelegate::getAllResources(const XdsSourceId& source_id) const {
   std::vector<envoy::service::discovery::v3::Resource> resources;
+  std::vector<std::string> unusable_keys;
   // TODO(abeyad): This is slow as we are iterating over all entries in the KV store; the
   // expectation is we won't be iterating over too many values. But still, try to find a better way.
   xds_config_store_->iterate(
-      [&resources, &source_id](const std::string& key, const std::string& value) {
+      [this, &resources, &unusable_keys, &source_id](const std::string& key,
+                                                     const std::string& value) {
         if (absl::StartsWith(key, source_id.toKey())) {
           // The source id is a prefix of the key, so it should be included in the list of returned
           // resources.
-          envoy::service::discovery::v3::Resource r;
-          r.ParseFromString(value);
-          resources.push_back(std::move(r));
+          if (auto r = parseResource(value)) {
+            resources.push_back(std::move(*r));
+          } else {
+            unusable_keys.push_back(key);
+          }
         }
         return KeyValueStore::Iterate::Continue;
       });
+  // The store can't be modified while iterating.
+  for (const std::string& key : unusable_keys) {
+    xds_config_store_->remove(key);
+  }
   return resources;
 }
 
@@ -110,7 +160,7 @@ void KeyValueStoreXdsDelegate::onConfigUpdated(
         ttl = std::chrono::duration_cast<std::chrono::seconds>(decoded_resource.ttl().value());
       }
       std::string serialized_resource;
-      if (r.SerializeToString(&serialized_resource)) {
+      if (serializeResource(r, serialized_resource)) {
         xds_config_store_->addOrUpdate(constructKey(source_id, r.name()),
                                        std::move(serialized_resource), ttl);
       } else {
@@ -157,7 +207,8 @@ Envoy::Config::XdsResourcesDelegatePtr KeyValueStoreXdsDelegateFactory::createXd
       validator_config.key_value_store_config().config());
   KeyValueStorePtr xds_config_store = kv_store_factory.createStore(
       validator_config.key_value_store_config(), validation_visitor, dispatcher, api.fileSystem());
-  return std::make_unique<KeyValueStoreXdsDelegate>(std::move(xds_config_store), api.rootScope());
+  return std::make_unique<KeyValueStoreXdsDelegate>(std::move(xds_config_store), api.rootScope(),
+                                                    validator_config.verify_integrity());
 }
 
 REGISTER_FACTORY(KeyValueStoreXdsDelegateFactory, Envoy::Config::XdsResourcesDelegateFactory);
@@ -24,7 +24,9 @@ namespace Config {
   /* Number of times a persisted resource failed to parse into a xDS proto. */                     \
   COUNTER(parse_failed)                                                                            \
   /* Number of times a resource was requested but not found from the KV store. */                  \
-  COUNTER(resource_missing)
+  COUNTER(resource_missing)                                                                        \
+  /* Number of times a persisted resource didn't match its checksum. */                            \
+  COUNTER(integrity_check_failed)
 
 // Struct definition for all KV store xDS delegate stats. @see stats_macros.h
 struct XdsKeyValueStoreStats {
@@ -42,7 +44,8 @@ struct XdsKeyValueStoreStats {
 // not currently advised to use this feature for large and complicated configurations.
 class KeyValueStoreXdsDelegate : public Envoy::Config::XdsResourcesDelegate {
 public:
-  KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store, Stats::Scope& root_scope);
+  KeyValueStoreXdsDelegate(KeyValueStorePtr&& xds_config_store, Stats::Scope& root_scope,
+                           bool verify_integrity = false);
 
   std::vector<envoy::service::discovery::v3::Resource>
   getResources(const Envoy::Config::XdsSourceId& source_id,
@@ -61,8 +64,17 @@ private:
   std::vector<envoy::service::discovery::v3::Resource>
   getAllResources(const Envoy::Config::XdsSourceId& source_id) const;
 
+  // Parses a persisted resource, returning absl::nullopt if it doesn't match its checksum or fails
+  // to parse.
+  absl::optional<envoy::service::discovery::v3::Resource>
+  parseResource(absl::string_view value) const;
+  // Serializes a resource for persistence, prefixed by its checksum if integrity is verified.
+  bool serializeResource(const envoy::service::discovery::v3::Resource& resource,
+                         std::string& value) const;
+
   static XdsKeyValueStoreStats generateStats(Stats::Scope& scope);
 
+  const bool verify_integrity_;
   KeyValueStorePtr xds_config_store_;
   Stats::ScopeSharedPtr scope_;
   XdsKeyValueStoreStats stats_;
@@ -27,8 +27,11 @@ using ::Envoy::Config::DecodedResourceRef;
 using ::Envoy::Config::XdsConfigSourceId;
 using ::Envoy::Config::XdsSourceId;
 
-envoy::config::core::v3::TypedExtensionConfig kvStoreDelegateConfig() {
-  const std::string filename = TestEnvironment::temporaryPath("xds_kv_store.txt");
+std::string kvStoreFilename() { return TestEnvironment::temporaryPath("xds_kv_store.txt"); }
+
+envoy::config::core::v3::TypedExtensionConfig
+kvStoreDelegateConfig(bool verify_integrity = false) {
+  const std::string filename = kvStoreFilename();
   Api::OsSysCallsSingleton().get().unlink(filename.c_str());
 
   const std::string config_str = fmt::format(R"EOF(
@@ -41,8 +44,9 @@ envoy::config::core::v3::TypedExtensionConfig kvStoreDelegateConfig() {
           typed_config:
             "@type": type.googleapis.com/envoy.extensions.key_value.file_based.v3.FileBasedKeyValueStoreConfig
             filename: {}
+      verify_integrity: {}
     )EOF",
-                                             filename);
+                                             filename, verify_integrity);
 
   envoy::config::core::v3::TypedExtensionConfig config;
   TestUtility::loadFromYaml(config_str, config);
@@ -52,13 +56,16 @@ envoy::config::core::v3::TypedExtensionConfig kvStoreDelegateConfig() {
 class KeyValueStoreXdsDelegateTest : public testing::Test {
 public:
   KeyValueStoreXdsDelegateTest() : api_(Api::createApiForTest(store_)) {
-    auto config = kvStoreDelegateConfig();
+    createDelegate(kvStoreDelegateConfig());
+  }
+
+protected:
+  void createDelegate(const envoy::config::core::v3::TypedExtensionConfig& config) {
     Extensions::Config::KeyValueStoreXdsDelegateFactory delegate_factory;
     xds_delegate_ = delegate_factory.createXdsResourcesDelegate(
         config.typed_config(), ProtobufMessage::getStrictValidationVisitor(), *api_, dispatcher_);
   }
 
-protected:
   envoy::service::runtime::v3::Runtime parseYamlIntoRuntimeResource(const std::string& yaml) {
     envoy::service::runtime::v3::Runtime runtime;
     TestUtility::loadFromYaml(yaml, runtime);
@@ -335,5 +342,47 @@ TEST_F(KeyValueStoreXdsDelegateTest, ResourcesWithTTL) {
       source_id, /*resource_names=*/{"some_resource_1"}, decoded_resources.refvec_);
 }
 
+// Verifies that the resources persisted with a checksum are loaded, while the ones which don't
+// match their checksum, or were persisted without one, are discarded and removed from the store.
+TEST_F(KeyValueStoreXdsDelegateTest, VerifyIntegrity) {
+  const auto config = kvStoreDelegateConfig(/*verify_integrity=*/true);
+  const XdsConfigSourceId source_id{"rtds_cluster", Config::TypeUrl::get().Runtime};
+  auto runtime_resource_1 = parseYamlIntoRuntimeResource(R"EOF(
+    name: some_resource_1
+    layer:
+      foo: bar
+  )EOF");
+  auto runtime_resource_2 = parseYamlIntoRuntimeResource(R"EOF(
+    name: some_resource_2
+    layer:
+      abc: xyz
+  )EOF");
+  const auto saved_resources = TestUtility::decodeResources({runtime_resource_1});
+  createDelegate(config);
+  xds_delegate_->onConfigUpdated(source_id, saved_resources.refvec_);
+  checkSavedResources<envoy::service::runtime::v3::Runtime>(
+      source_id, /*resource_names=*/{"some_resource_1"}, saved_resources.refvec_);
+
+  // Reload the store after corrupting the last byte of the resource.
+  std::string contents = api_->fileSystem().fileReadToEnd(kvStoreFilename());
+  contents.back() ^= 1;
+  TestEnvironment::writeStringToFileForTest(kvStoreFilename(), contents,
+                                            /*fully_qualified_path=*/true);
+  createDelegate(config);
+  EXPECT_TRUE(xds_delegate_->getResources(source_id, {"some_resource_1"}).empty());
+  EXPECT_EQ(1, store_.counter("xds.kv_store.integrity_check_failed").value());
+  EXPECT_TRUE(xds_delegate_->getResources(source_id, {"some_resource_1"}).empty());
+  EXPECT_EQ(1, store_.counter("xds.kv_store.resource_missing").value());
+
+  // A resource persisted without a checksum is discarded by the wildcard as well.
+  createDelegate(kvStoreDelegateConfig());
+  const auto unverified_resources = TestUtility::decodeResources({runtime_resource_2});
+  xds_delegate_->onConfigUpdated(source_id, unverified_resources.refvec_);
+  createDelegate(config);
+  EXPECT_TRUE(xds_delegate_->getResources(source_id, {}).empty());
+  EXPECT_EQ(2, store_.counter("xds.kv_store.integrity_check_failed").value());
+  EXPECT_EQ(0, store_.counter("xds.kv_store.parse_failed").value());
+}
+
 } // namespace
 } // namespace Envoy
@@ -360,41 +360,26 @@ ssl_private_key_result_t rsaPrivateKeyDecryptForTest(CryptoMbPrivateKeyConnectio
 CryptoMbQueue::CryptoMbQueue(std::chrono::milliseconds poll_delay, enum KeyType type, int keysize,
                              IppCryptoSharedPtr ipp, Event::Dispatcher& d, CryptoMbStats& stats)
     : us_(std::chrono::duration_cast<std::chrono::microseconds>(poll_delay)), type_(type),
-      key_size_(keysize), ipp_(ipp), timer_(d.createTimer([this]() { processRequests(); })),
-      stats_(stats) {
-  request_queue_.reserve(MULTIBUFF_BATCH);
-}
-
-void CryptoMbQueue::startTimer() { timer_->enableHRTimer(us_); }
-
-void CryptoMbQueue::stopTimer() { timer_->disableTimer(); }
+      key_size_(keysize), ipp_(ipp), stats_(stats),
+      batcher_(d, MULTIBUFF_BATCH, us_, [this](std::vector<CryptoMbContextSharedPtr>& requests) {
+        processRequests(requests);
+      }) {}
 
 void CryptoMbQueue::addAndProcessEightRequests(CryptoMbContextSharedPtr mb_ctx) {
-  // Add the request to the processing queue.
-  ASSERT(request_queue_.size() < MULTIBUFF_BATCH);
-  request_queue_.push_back(mb_ctx);
-
-  if (request_queue_.size() == MULTIBUFF_BATCH) {
-    // There are eight requests in the queue and we can process them.
-    stopTimer();
-    ENVOY_LOG(debug, "processing directly 8 requests");
-    processRequests();
-  } else if (request_queue_.size() == 1) {
-    // First request in the queue, start the queue timer.
-    startTimer();
-  }
+  // Add the request to the batch, which is processed once there are eight requests in it or at
+  // its deadline.
+  batcher_.add(mb_ctx);
 }
 
-void CryptoMbQueue::processRequests() {
+void CryptoMbQueue::processRequests(std::vector<CryptoMbContextSharedPtr>& requests) {
   if (type_ == KeyType::Rsa) {
     // Record queue size statistic value for histogram.
-    stats_.rsa_queue_sizes_.recordValue(request_queue_.size());
-    processRsaRequests();
+    stats_.rsa_queue_sizes_.recordValue(requests.size());
+    processRsaRequests(requests);
   }
-  request_queue_.clear();
 }
 
-void CryptoMbQueue::processRsaRequests() {
+void CryptoMbQueue::processRsaRequests(std::vector<CryptoMbContextSharedPtr>& requests) {
 
   const unsigned char* rsa_priv_from[MULTIBUFF_BATCH] = {nullptr};
   unsigned char* rsa_priv_to[MULTIBUFF_BATCH] = {nullptr};
@@ -407,9 +392,9 @@ void CryptoMbQueue::processRsaRequests() {
   const BIGNUM* rsa_priv_iqmp[MULTIBUFF_BATCH] = {nullptr};
 
   /* Build arrays of pointers for call */
-  for (unsigned req_num = 0; req_num < request_queue_.size(); req_num++) {
+  for (unsigned req_num = 0; req_num < requests.size(); req_num++) {
     CryptoMbRsaContextSharedPtr mb_ctx =
-        std::static_pointer_cast<CryptoMbRsaContext>(request_queue_[req_num]);
+        std::static_pointer_cast<CryptoMbRsaContext>(requests[req_num]);
     rsa_priv_from[req_num] = mb_ctx->in_buf_.get();
     rsa_priv_to[req_num] = mb_ctx->out_buf_;
     rsa_priv_p[req_num] = mb_ctx->p_;
@@ -419,7 +404,7 @@ void CryptoMbQueue::processRsaRequests() {
     rsa_priv_iqmp[req_num] = mb_ctx->iqmp_;
   }
 
-  ENVOY_LOG(debug, "Multibuffer RSA process {} requests", request_queue_.size());
+  ENVOY_LOG(debug, "Multibuffer RSA process {} requests", requests.size());
 
   uint32_t rsa_sts =
       ipp_->mbxRsaPrivateCrtSslMb8(rsa_priv_from, rsa_priv_to, rsa_priv_p, rsa_priv_q,
@@ -427,9 +412,9 @@ void CryptoMbQueue::processRsaRequests() {
 
   enum RequestStatus status[MULTIBUFF_BATCH] = {RequestStatus::Retry};
 
-  for (unsigned req_num = 0; req_num < request_queue_.size(); req_num++) {
+  for (unsigned req_num = 0; req_num < requests.size(); req_num++) {
     CryptoMbRsaContextSharedPtr mb_ctx =
-        std::static_pointer_cast<CryptoMbRsaContext>(request_queue_[req_num]);
+        std::static_pointer_cast<CryptoMbRsaContext>(requests[req_num]);
     if (ipp_->mbxGetSts(rsa_sts, req_num)) {
       ENVOY_LOG(debug, "Multibuffer RSA request {} success", req_num);
       status[req_num] = RequestStatus::Success;
@@ -448,9 +433,9 @@ void CryptoMbQueue::processRsaRequests() {
   rsa_sts =
       ipp_->mbxRsaPublicSslMb8(rsa_priv_from, rsa_priv_to, rsa_lenstra_e, rsa_lenstra_n, key_size_);
 
-  for (unsigned req_num = 0; req_num < request_queue_.size(); req_num++) {
+  for (unsigned req_num = 0; req_num < requests.size(); req_num++) {
     CryptoMbRsaContextSharedPtr mb_ctx =
-        std::static_pointer_cast<CryptoMbRsaContext>(request_queue_[req_num]);
+        std::static_pointer_cast<CryptoMbRsaContext>(requests[req_num]);
     enum RequestStatus ctx_status;
     if (ipp_->mbxGetSts(rsa_sts, req_num)) {
       if (CRYPTO_memcmp(mb_ctx->in_buf_.get(), rsa_priv_to[req_num], mb_ctx->out_len_) != 0) {
@@ -8,6 +8,7 @@
 
 #include "source/common/common/c_smart_ptr.h"
 #include "source/common/common/logger.h"
+#include "source/extensions/transport_sockets/tls/private_key/operation_batcher.h"
 
 #include "contrib/cryptomb/private_key_providers/source/cryptomb_stats.h"
 #include "contrib/cryptomb/private_key_providers/source/ipp_crypto.h"
@@ -88,7 +89,7 @@ public:
 using CryptoMbContextSharedPtr = std::shared_ptr<CryptoMbContext>;
 using CryptoMbRsaContextSharedPtr = std::shared_ptr<CryptoMbRsaContext>;
 
-// CryptoMbQueue maintains the request queue and is able to process it.
+// CryptoMbQueue batches the requests of a worker and processes the batches.
 class CryptoMbQueue : public Logger::Loggable<Logger::Id::connection> {
 public:
   static constexpr uint32_t MULTIBUFF_BATCH = 8;
@@ -99,17 +100,12 @@ public:
   const std::chrono::microseconds& getPollDelayForTest() const { return us_; }
 
 private:
-  void processRequests();
-  void processRsaRequests();
-  void startTimer();
-  void stopTimer();
+  void processRequests(std::vector<CryptoMbContextSharedPtr>& requests);
+  void processRsaRequests(std::vector<CryptoMbContextSharedPtr>& requests);
 
-  // Polling delay.
+  // Polling delay, the maximum time a request is queued for.
   std::chrono::microseconds us_{};
 
-  // Queue for the requests.
-  std::vector<CryptoMbContextSharedPtr> request_queue_;
-
   // Key size and key type allowed for this particular queue.
   const enum KeyType type_;
   int key_size_{};
@@ -120,10 +116,11 @@ private:
   // Crypto operations library interface.
   IppCryptoSharedPtr ipp_{};
 
-  // Timer to trigger queue processing if eight requests are not received in time.
-  Event::TimerPtr timer_{};
-
   CryptoMbStats& stats_;
+
+  // Batches the requests, processing them when there are eight of them or at a deadline adapted
+  // to their arrival rate.
+  TransportSockets::Tls::OperationBatcher<CryptoMbContextSharedPtr> batcher_;
 };
 
 // CryptoMbPrivateKeyConnection maintains the data needed by a given SSL
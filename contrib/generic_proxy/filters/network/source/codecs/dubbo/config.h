@@ -45,6 +45,8 @@ public:
 
   absl::string_view method() const override { return inner_metadata_->request().methodName(); }
 
+  absl::optional<uint64_t> streamId() const override { return inner_metadata_->requestId(); }
+
   Common::Dubbo::MessageMetadataSharedPtr inner_metadata_;
 };
 
@@ -71,6 +73,7 @@ public:
   void setByReference(absl::string_view, absl::string_view) override {}
 
   Status status() const override { return status_; }
+  absl::optional<uint64_t> streamId() const override { return inner_metadata_->requestId(); }
 
   Status status_;
   Common::Dubbo::MessageMetadataSharedPtr inner_metadata_;
@@ -80,6 +80,14 @@ public:
  */
 class Request : public Tracing::TraceContext {
 public:
+  /**
+   * Get the stream id of the request. A request and its response share the stream id, which lets
+   * several requests be in flight on the same upstream connection.
+   *
+   * @return the optional stream id, or absl::nullopt if the protocol has no stream id.
+   */
+  virtual absl::optional<uint64_t> streamId() const { return absl::nullopt; }
+
   // Used for matcher.
   static constexpr absl::string_view name() { return "generic_proxy"; }
 };
@@ -106,6 +114,14 @@ public:
    * @return generic response status.
    */
   virtual Status status() const PURE;
+
+  /**
+   * Get the stream id of the response. A request and its response share the stream id, which lets
+   * several requests be in flight on the same upstream connection.
+   *
+   * @return the optional stream id, or absl::nullopt if the protocol has no stream id.
+   */
+  virtual absl::optional<uint64_t> streamId() const { return absl::nullopt; }
 };
 
 using ResponsePtr = std::unique_ptr<Response>;
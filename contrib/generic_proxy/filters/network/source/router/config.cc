@@ -9,10 +9,14 @@ namespace GenericProxy {
 namespace Router {
 
 FilterFactoryCb
-RouterFactory::createFilterFactoryFromProto(const Protobuf::Message&, const std::string&,
+RouterFactory::createFilterFactoryFromProto(const Protobuf::Message& config, const std::string&,
                                             Server::Configuration::FactoryContext& context) {
-  return [&context](FilterChainFactoryCallbacks& callbacks) {
-    callbacks.addDecoderFilter(std::make_shared<RouterFilter>(context));
+  const auto& typed_config = MessageUtil::downcastAndValidate<const RouterProtoConfig&>(
+      config, context.messageValidationVisitor());
+  auto router_config = std::make_shared<const RouterConfig>(typed_config, context);
+
+  return [router_config, &context](FilterChainFactoryCallbacks& callbacks) {
+    callbacks.addDecoderFilter(std::make_shared<RouterFilter>(router_config, context));
   };
 }
 
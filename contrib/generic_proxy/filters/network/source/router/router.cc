@@ -4,6 +4,7 @@
 #include "envoy/network/connection.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/tracing/tracer_impl.h"
 
 #include "contrib/generic_proxy/filters/network/source/interface/filter.h"
@@ -42,6 +43,15 @@ UpstreamRequest::UpstreamRequest(RouterFilter& parent, Upstream::TcpPoolData tcp
 }
 
 void UpstreamRequest::startStream() {
+  MultiplexedUpstream* multiplexed_upstream = parent_.config_->multiplexedUpstream();
+  if (multiplexed_upstream != nullptr) {
+    stream_id_ = parent_.request_->streamId();
+    if (stream_id_.has_value()) {
+      multiplexed_upstream->newStream(tcp_data_, *this, parent_.callbacks_->downstreamCodec());
+      return;
+    }
+  }
+
   Tcp::ConnectionPool::Cancellable* handle = tcp_data_.newConnection(*this);
   conn_pool_handle_ = handle;
 }
@@ -68,6 +78,12 @@ void UpstreamRequest::resetStream(StreamResetReason reason) {
     conn_data_.reset();
   }
 
+  if (multiplexed_connection_ != nullptr) {
+    ENVOY_LOG(debug, "generic proxy upstream request: detach from multiplexed upstream connection");
+    multiplexed_connection_->removeStream(*this);
+    multiplexed_connection_ = nullptr;
+  }
+
   if (span_ != nullptr) {
     span_->setTag(Tracing::Tags::get().Error, Tracing::Tags::get().True);
     span_->setTag(Tracing::Tags::get().ErrorReason, resetReasonToStringView(reason));
@@ -90,8 +106,13 @@ void UpstreamRequest::completeUpstreamRequest() {
 
   response_complete_ = true;
   ASSERT(conn_pool_handle_ == nullptr);
-  ASSERT(conn_data_ != nullptr);
-  conn_data_.reset();
+  if (multiplexed_connection_ != nullptr) {
+    multiplexed_connection_->removeStream(*this);
+    multiplexed_connection_ = nullptr;
+  } else {
+    ASSERT(conn_data_ != nullptr);
+    conn_data_.reset();
+  }
 
   // Remove this stream form the parent's list because this upstream request is complete.
   deferredDelete();
@@ -132,12 +153,17 @@ void UpstreamRequest::onEncodingSuccess(Buffer::Instance& buffer, bool expect_re
 void UpstreamRequest::onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn,
                                   Upstream::HostDescriptionConstSharedPtr host) {
   ENVOY_LOG(debug, "upstream request: tcp connection has ready");
-  onUpstreamHostSelected(host);
 
   conn_data_ = std::move(conn);
   conn_data_->addUpstreamCallbacks(*this);
   conn_pool_handle_ = nullptr;
 
+  onConnectionReady(std::move(host));
+}
+
+void UpstreamRequest::onConnectionReady(Upstream::HostDescriptionConstSharedPtr host) {
+  onUpstreamHostSelected(host);
+
   if (span_ != nullptr) {
     span_->injectContext(*parent_.request_, upstream_host_);
   }
@@ -191,14 +217,282 @@ void UpstreamRequest::onUpstreamHostSelected(Upstream::HostDescriptionConstShare
 }
 
 void UpstreamRequest::encodeBufferToUpstream(Buffer::Instance& buffer) {
-  ASSERT(conn_data_);
   ASSERT(!conn_pool_handle_);
 
   ENVOY_LOG(trace, "proxying {} bytes", buffer.length());
 
+  if (multiplexed_connection_ != nullptr) {
+    multiplexed_connection_->write(buffer);
+    return;
+  }
+
+  ASSERT(conn_data_);
   conn_data_->connection().write(buffer, false);
 }
 
+MultiplexedConnection::MultiplexedConnection(MultiplexedUpstream& parent,
+                                             Upstream::HostDescriptionConstSharedPtr host,
+                                             ResponseDecoderPtr response_decoder)
+    : parent_(parent), host_(std::move(host)), response_decoder_(std::move(response_decoder)) {
+  response_decoder_->setDecoderCallback(*this);
+}
+
+MultiplexedConnection::~MultiplexedConnection() {
+  if (conn_pool_handle_ != nullptr) {
+    conn_pool_handle_->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+  }
+  detachStreams();
+}
+
+void MultiplexedConnection::connect(Upstream::TcpPoolData& tcp_data) {
+  ASSERT(conn_pool_handle_ == nullptr && conn_data_ == nullptr);
+  conn_pool_handle_ = tcp_data.newConnection(*this);
+}
+
+bool MultiplexedConnection::acceptsStream(uint64_t stream_id, uint32_t max_streams) const {
+  return (conn_pool_handle_ != nullptr || conn_data_ != nullptr) &&
+         streams_.size() < max_streams && !streams_.contains(stream_id);
+}
+
+void MultiplexedConnection::addStream(UpstreamRequest& stream) {
+  ASSERT(stream.stream_id_.has_value());
+  streams_.emplace(stream.stream_id_.value(), &stream);
+  stream.multiplexed_connection_ = this;
+
+  if (conn_data_ != nullptr) {
+    stream.onConnectionReady(host_);
+  }
+}
+
+void MultiplexedConnection::removeStream(UpstreamRequest& stream) {
+  auto it = streams_.find(stream.stream_id_.value());
+  ASSERT(it != streams_.end() && it->second == &stream);
+
+  if (conn_data_ != nullptr && !stream.response_complete_) {
+    // The request was sent, so its response may still arrive.
+    it->second = nullptr;
+    abandoned_streams_++;
+  } else {
+    streams_.erase(it);
+  }
+  onStreamRemoved();
+}
+
+void MultiplexedConnection::write(Buffer::Instance& buffer) {
+  ASSERT(conn_data_ != nullptr);
+  conn_data_->connection().write(buffer, false);
+}
+
+void MultiplexedConnection::onStreamRemoved() {
+  if (streams_.size() > abandoned_streams_) {
+    return;
+  }
+
+  if (conn_pool_handle_ != nullptr) {
+    ENVOY_LOG(debug, "multiplexed upstream connection: cancel connecting without streams");
+    conn_pool_handle_->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+    conn_pool_handle_ = nullptr;
+  } else if (streams_.empty()) {
+    // The connection is idle, so it goes back to the pool to be reused.
+    ENVOY_LOG(debug, "multiplexed upstream connection: release idle connection");
+    conn_data_.reset();
+  } else {
+    // Only the reset streams are left. Close the connection rather than wait for their responses,
+    // as a non-multiplexed upstream request does.
+    ENVOY_LOG(debug, "multiplexed upstream connection: close connection of reset streams");
+    closeAndResetStreams(StreamResetReason::LocalReset);
+    return;
+  }
+  parent_.removeConnection(*this);
+}
+
+void MultiplexedConnection::closeAndResetStreams(StreamResetReason reason) {
+  if (conn_data_ != nullptr) {
+    // The connection data is moved out first to ignore the close event raised by close().
+    Tcp::ConnectionPool::ConnectionDataPtr conn_data = std::move(conn_data_);
+    conn_data->connection().close(Network::ConnectionCloseType::NoFlush);
+  }
+  parent_.removeConnection(*this);
+
+  for (UpstreamRequest* stream : detachStreams()) {
+    stream->resetStream(reason);
+  }
+}
+
+std::vector<UpstreamRequest*> MultiplexedConnection::detachStreams() {
+  std::vector<UpstreamRequest*> streams;
+  for (const auto& [stream_id, stream] : streams_) {
+    if (stream != nullptr) {
+      stream->multiplexed_connection_ = nullptr;
+      streams.push_back(stream);
+    }
+  }
+  streams_.clear();
+  abandoned_streams_ = 0;
+  return streams;
+}
+
+void MultiplexedConnection::onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                                          absl::string_view transport_failure_reason,
+                                          Upstream::HostDescriptionConstSharedPtr host) {
+  conn_pool_handle_ = nullptr;
+  parent_.removeConnection(*this);
+
+  for (UpstreamRequest* stream : detachStreams()) {
+    stream->onPoolFailure(reason, transport_failure_reason, host);
+  }
+}
+
+void MultiplexedConnection::onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn,
+                                        Upstream::HostDescriptionConstSharedPtr host) {
+  ENVOY_LOG(debug, "multiplexed upstream connection: tcp connection has ready");
+  conn_data_ = std::move(conn);
+  conn_data_->addUpstreamCallbacks(*this);
+  conn_pool_handle_ = nullptr;
+
+  // Sending a request may complete or reset its stream, so the pending streams are looked up
+  // again before each request is sent.
+  std::vector<uint64_t> stream_ids;
+  stream_ids.reserve(streams_.size());
+  for (const auto& [stream_id, stream] : streams_) {
+    stream_ids.push_back(stream_id);
+  }
+  for (const uint64_t stream_id : stream_ids) {
+    if (conn_data_ == nullptr) {
+      return;
+    }
+    auto it = streams_.find(stream_id);
+    if (it != streams_.end() && it->second != nullptr) {
+      it->second->onConnectionReady(host);
+    }
+  }
+}
+
+void MultiplexedConnection::onUpstreamData(Buffer::Instance& data, bool end_stream) {
+  response_decoder_->decode(data);
+
+  if (end_stream && conn_data_ != nullptr) {
+    closeAndResetStreams(StreamResetReason::ProtocolError);
+  }
+}
+
+void MultiplexedConnection::onDecodingSuccess(ResponsePtr response) {
+  if (conn_data_ == nullptr) {
+    // The connection was released or closed while decoding the previous responses.
+    return;
+  }
+
+  const absl::optional<uint64_t> stream_id = response->streamId();
+  if (!stream_id.has_value()) {
+    ENVOY_LOG(debug, "multiplexed upstream connection: response without stream id");
+    closeAndResetStreams(StreamResetReason::ProtocolError);
+    return;
+  }
+
+  auto it = streams_.find(stream_id.value());
+  if (it == streams_.end()) {
+    ENVOY_LOG(debug, "multiplexed upstream connection: drop response of unknown stream {}",
+              stream_id.value());
+    return;
+  }
+  if (it->second == nullptr) {
+    // The response of a reset stream.
+    streams_.erase(it);
+    abandoned_streams_--;
+    onStreamRemoved();
+    return;
+  }
+  it->second->onDecodingSuccess(std::move(response));
+}
+
+void MultiplexedConnection::onDecodingFailure() {
+  closeAndResetStreams(StreamResetReason::ProtocolError);
+}
+
+void MultiplexedConnection::onEvent(Network::ConnectionEvent event) {
+  if (conn_data_ == nullptr) {
+    return;
+  }
+
+  switch (event) {
+  case Network::ConnectionEvent::LocalClose:
+    conn_data_.reset();
+    closeAndResetStreams(StreamResetReason::LocalReset);
+    break;
+  case Network::ConnectionEvent::RemoteClose:
+    conn_data_.reset();
+    closeAndResetStreams(StreamResetReason::ConnectionTermination);
+    break;
+  default:
+    break;
+  }
+}
+
+void MultiplexedUpstream::newStream(Upstream::TcpPoolData& tcp_data, UpstreamRequest& stream,
+                                    const CodecFactory& codec_factory) {
+  Upstream::HostDescriptionConstSharedPtr host = tcp_data.host();
+  std::list<MultiplexedConnectionPtr>& connections = connections_[host.get()];
+
+  for (MultiplexedConnectionPtr& connection : connections) {
+    if (connection->acceptsStream(stream.stream_id_.value(), max_streams_per_connection_)) {
+      connection->addStream(stream);
+      return;
+    }
+  }
+
+  if (connections.size() >= max_connections_per_host_) {
+    ENVOY_LOG_MISC(debug, "multiplexed upstream: all connections to {} are full",
+                   host->address()->asString());
+    if (connections.empty()) {
+      connections_.erase(host.get());
+    }
+    stream.onPoolFailure(ConnectionPool::PoolFailureReason::Overflow, "", host);
+    return;
+  }
+
+  auto connection =
+      std::make_unique<MultiplexedConnection>(*this, host, codec_factory.responseDecoder());
+  MultiplexedConnection& raw_connection = *connection;
+  LinkedList::moveIntoList(std::move(connection), connections);
+
+  // The stream is added first so that a synchronous pool callback finds it.
+  raw_connection.addStream(stream);
+  raw_connection.connect(tcp_data);
+}
+
+void MultiplexedUpstream::removeConnection(MultiplexedConnection& connection) {
+  if (!connection.inserted()) {
+    return;
+  }
+  auto it = connections_.find(connection.hostKey());
+  ASSERT(it != connections_.end());
+  dispatcher_.deferredDelete(connection.removeFromList(it->second));
+  if (it->second.empty()) {
+    connections_.erase(it);
+  }
+}
+
+RouterConfig::RouterConfig(const RouterProtoConfig& config,
+                           Server::Configuration::FactoryContext& context) {
+  if (!config.has_upstream_multiplexing()) {
+    return;
+  }
+
+  const auto& multiplexing = config.upstream_multiplexing();
+  const uint32_t max_streams_per_connection =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(multiplexing, max_concurrent_requests_per_connection, 100);
+  const uint32_t max_connections_per_host =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(multiplexing, max_connections_per_host, 1);
+
+  multiplexed_upstream_ =
+      ThreadLocal::TypedSlot<MultiplexedUpstream>::makeUnique(context.threadLocal());
+  multiplexed_upstream_->set([max_streams_per_connection,
+                              max_connections_per_host](Event::Dispatcher& dispatcher) {
+    return std::make_shared<MultiplexedUpstream>(dispatcher, max_streams_per_connection,
+                                                 max_connections_per_host);
+  });
+}
+
 void RouterFilter::onUpstreamResponse(ResponsePtr response) {
   filter_complete_ = true;
   callbacks_->upstreamResponse(std::move(response));
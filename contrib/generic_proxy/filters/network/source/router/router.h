@@ -2,12 +2,16 @@
 
 #include "envoy/network/connection.h"
 #include "envoy/server/factory_context.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/stream_info/stream_info_impl.h"
 #include "source/common/upstream/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
+#include "contrib/envoy/extensions/filters/network/generic_proxy/router/v3/router.pb.h"
 #include "contrib/generic_proxy/filters/network/source/interface/codec.h"
 #include "contrib/generic_proxy/filters/network/source/interface/filter.h"
 #include "contrib/generic_proxy/filters/network/source/interface/stream.h"
@@ -34,6 +38,7 @@ enum class StreamResetReason : uint32_t {
 };
 
 class RouterFilter;
+class MultiplexedConnection;
 
 class UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
                         public Tcp::ConnectionPool::UpstreamCallbacks,
@@ -72,6 +77,9 @@ public:
   // RequestEncoderCallback
   void onEncodingSuccess(Buffer::Instance& buffer, bool expect_response) override;
 
+  // Called when the connection, either owned or multiplexed, is ready to send the request.
+  void onConnectionReady(Upstream::HostDescriptionConstSharedPtr host);
+
   void onUpstreamHostSelected(Upstream::HostDescriptionConstSharedPtr host);
   void encodeBufferToUpstream(Buffer::Instance& buffer);
 
@@ -84,6 +92,10 @@ public:
   Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
   Upstream::HostDescriptionConstSharedPtr upstream_host_;
 
+  // The shared upstream connection of the request, if it is multiplexed.
+  MultiplexedConnection* multiplexed_connection_{};
+  absl::optional<uint64_t> stream_id_;
+
   bool request_complete_{};
   bool response_started_{};
   bool response_complete_{};
@@ -99,11 +111,132 @@ public:
 };
 using UpstreamRequestPtr = std::unique_ptr<UpstreamRequest>;
 
+class MultiplexedUpstream;
+
+/**
+ * An upstream connection shared by several upstream requests. The responses are matched back to
+ * their requests by stream id.
+ */
+class MultiplexedConnection : public Tcp::ConnectionPool::Callbacks,
+                              public Tcp::ConnectionPool::UpstreamCallbacks,
+                              public LinkedObject<MultiplexedConnection>,
+                              public Envoy::Event::DeferredDeletable,
+                              public ResponseDecoderCallback,
+                              Logger::Loggable<Envoy::Logger::Id::filter> {
+public:
+  MultiplexedConnection(MultiplexedUpstream& parent, Upstream::HostDescriptionConstSharedPtr host,
+                        ResponseDecoderPtr response_decoder);
+  ~MultiplexedConnection() override;
+
+  void connect(Upstream::TcpPoolData& tcp_data);
+
+  /**
+   * @return whether the stream can be added to the connection, i.e. the connection has room for
+   * one more stream and no stream with the same id.
+   */
+  bool acceptsStream(uint64_t stream_id, uint32_t max_streams) const;
+  void addStream(UpstreamRequest& stream);
+  // Called when the stream is complete or reset.
+  void removeStream(UpstreamRequest& stream);
+  void write(Buffer::Instance& buffer);
+
+  const Upstream::HostDescription* hostKey() const { return host_.get(); }
+
+  // Tcp::ConnectionPool::Callbacks
+  void onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                     absl::string_view transport_failure_reason,
+                     Upstream::HostDescriptionConstSharedPtr host) override;
+  void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn,
+                   Upstream::HostDescriptionConstSharedPtr host) override;
+
+  // Tcp::ConnectionPool::UpstreamCallbacks
+  void onUpstreamData(Buffer::Instance& data, bool end_stream) override;
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override {}
+  void onBelowWriteBufferLowWatermark() override {}
+
+  // ResponseDecoderCallback
+  void onDecodingSuccess(ResponsePtr response) override;
+  void onDecodingFailure() override;
+
+  Tcp::ConnectionPool::Cancellable* conn_pool_handle_{};
+  Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+
+  // The streams by id. The streams reset after their request was sent are kept as nullptr
+  // until their response arrives, so that the response isn't taken for a later stream's.
+  absl::flat_hash_map<uint64_t, UpstreamRequest*> streams_;
+  size_t abandoned_streams_{};
+
+private:
+  // Releases or closes the connection once no stream is waiting for it.
+  void onStreamRemoved();
+  // Closes the connection and resets all its streams.
+  void closeAndResetStreams(StreamResetReason reason);
+  // Detaches all the streams from the connection and returns the live ones.
+  std::vector<UpstreamRequest*> detachStreams();
+
+  MultiplexedUpstream& parent_;
+  const Upstream::HostDescriptionConstSharedPtr host_;
+  ResponseDecoderPtr response_decoder_;
+};
+using MultiplexedConnectionPtr = std::unique_ptr<MultiplexedConnection>;
+
+/**
+ * The multiplexed upstream connections of a worker, by upstream host.
+ */
+class MultiplexedUpstream : public ThreadLocal::ThreadLocalObject {
+public:
+  MultiplexedUpstream(Event::Dispatcher& dispatcher, uint32_t max_streams_per_connection,
+                      uint32_t max_connections_per_host)
+      : dispatcher_(dispatcher), max_streams_per_connection_(max_streams_per_connection),
+        max_connections_per_host_(max_connections_per_host) {}
+
+  /**
+   * Adds the stream to a connection to the host of tcp_data. The stream is reset with an overflow
+   * if all the connections to the host are full.
+   */
+  void newStream(Upstream::TcpPoolData& tcp_data, UpstreamRequest& stream,
+                 const CodecFactory& codec_factory);
+  void removeConnection(MultiplexedConnection& connection);
+
+  size_t connectionCountForTest(const Upstream::HostDescription* host) const {
+    auto it = connections_.find(host);
+    return it == connections_.end() ? 0 : it->second.size();
+  }
+
+private:
+  Event::Dispatcher& dispatcher_;
+  const uint32_t max_streams_per_connection_;
+  const uint32_t max_connections_per_host_;
+  absl::flat_hash_map<const Upstream::HostDescription*, std::list<MultiplexedConnectionPtr>>
+      connections_;
+};
+
+using RouterProtoConfig = envoy::extensions::filters::network::generic_proxy::router::v3::Router;
+
+class RouterConfig {
+public:
+  RouterConfig(const RouterProtoConfig& config, Server::Configuration::FactoryContext& context);
+
+  /**
+   * @return the multiplexed upstream connections of the current worker, or nullptr if the
+   * upstream connections aren't multiplexed.
+   */
+  MultiplexedUpstream* multiplexedUpstream() const {
+    return multiplexed_upstream_ != nullptr ? multiplexed_upstream_->get().ptr() : nullptr;
+  }
+
+private:
+  ThreadLocal::TypedSlotPtr<MultiplexedUpstream> multiplexed_upstream_;
+};
+using RouterConfigSharedPtr = std::shared_ptr<const RouterConfig>;
+
 class RouterFilter : public DecoderFilter,
                      public Upstream::LoadBalancerContextBase,
                      Logger::Loggable<Envoy::Logger::Id::filter> {
 public:
-  RouterFilter(Server::Configuration::FactoryContext& context) : context_(context) {}
+  RouterFilter(RouterConfigSharedPtr config, Server::Configuration::FactoryContext& context)
+      : config_(std::move(config)), context_(context) {}
 
   // DecoderFilter
   void onDestroy() override;
@@ -145,6 +278,7 @@ private:
 
   DecoderFilterCallback* callbacks_{};
 
+  const RouterConfigSharedPtr config_;
   Server::Configuration::FactoryContext& context_;
 };
 
@@ -69,6 +69,7 @@ TEST(DubboRequestTest, DubboRequestTest) {
     EXPECT_EQ("fake_service", request.path());
     EXPECT_EQ("fake_method", request.method());
     EXPECT_EQ("fake_version", request.getByKey("version").value());
+    EXPECT_EQ(123456, request.streamId().value());
   }
 
   // Get and set headers.
@@ -105,6 +106,7 @@ TEST(DubboResponseTest, DubboResponseTest) {
     DubboResponse response(
         createDubboResponse(request, ResponseStatus::Ok, RpcResponseType::ResponseWithValue));
     EXPECT_EQ("dubbo", response.protocol());
+    EXPECT_EQ(123456, response.streamId().value());
   }
 
   // Response status check.
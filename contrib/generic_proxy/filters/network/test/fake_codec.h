@@ -53,20 +53,24 @@ public:
     absl::string_view host() const override { return host_; }
     absl::string_view path() const override { return path_; }
     absl::string_view method() const override { return method_; }
+    absl::optional<uint64_t> streamId() const override { return stream_id_; }
 
     std::string protocol_;
     std::string host_;
     std::string path_;
     std::string method_;
+    absl::optional<uint64_t> stream_id_;
   };
 
   class FakeResponse : public FakeStreamBase<Response> {
   public:
     absl::string_view protocol() const override { return protocol_; }
     Status status() const override { return status_; }
+    absl::optional<uint64_t> streamId() const override { return stream_id_; }
 
     std::string protocol_;
     Status status_;
+    absl::optional<uint64_t> stream_id_;
   };
 
   class FakeRequestDecoder : public RequestDecoder {
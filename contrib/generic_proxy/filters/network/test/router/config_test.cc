@@ -15,7 +15,7 @@ TEST(RouterFactoryTest, RouterFactoryTest) {
   NiceMock<Server::Configuration::MockFactoryContext> factory_context;
   RouterFactory factory;
 
-  ProtobufWkt::Struct proto_config;
+  envoy::extensions::filters::network::generic_proxy::router::v3::Router proto_config;
 
   EXPECT_NO_THROW(factory.createFilterFactoryFromProto(proto_config, "test", factory_context));
 
@@ -35,6 +35,21 @@ TEST(RouterFactoryTest, RouterFactoryTest) {
   fn(mock_cb);
 }
 
+TEST(RouterFactoryTest, RouterFactoryWithUpstreamMultiplexing) {
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  RouterFactory factory;
+
+  envoy::extensions::filters::network::generic_proxy::router::v3::Router proto_config;
+  proto_config.mutable_upstream_multiplexing()->mutable_max_connections_per_host()->set_value(2);
+
+  auto fn = factory.createFilterFactoryFromProto(proto_config, "test", factory_context);
+
+  NiceMock<MockFilterChainFactoryCallbacks> mock_cb;
+
+  EXPECT_CALL(mock_cb, addDecoderFilter(_));
+  fn(mock_cb);
+}
+
 } // namespace
 } // namespace Router
 } // namespace GenericProxy
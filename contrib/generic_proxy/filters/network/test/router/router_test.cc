@@ -13,6 +13,7 @@
 
 using testing::ByMove;
 using testing::NiceMock;
+using testing::Ref;
 using testing::Return;
 using testing::ReturnRef;
 
@@ -26,7 +27,8 @@ namespace {
 class RouterFilterTest : public testing::Test {
 public:
   RouterFilterTest() {
-    filter_ = std::make_shared<Router::RouterFilter>(factory_context_);
+    filter_ = std::make_shared<Router::RouterFilter>(
+        std::make_shared<RouterConfig>(RouterProtoConfig(), factory_context_), factory_context_);
     filter_->setDecoderFilterCallbacks(mock_filter_callback_);
     request_ = std::make_unique<FakeStreamCodecFactory::FakeRequest>();
 
@@ -667,6 +669,245 @@ TEST_F(RouterFilterTest, UpstreamRequestPoolReadyAndResponseDecodingFailure) {
   upstream_request->onDecodingFailure();
 }
 
+class MultiplexedRouterFilterTest : public testing::Test {
+public:
+  struct TestStream {
+    NiceMock<MockDecoderFilterCallback> callbacks_;
+    std::shared_ptr<RouterFilter> filter_;
+    FakeStreamCodecFactory::FakeRequest request_;
+  };
+
+  MultiplexedRouterFilterTest() {
+    RouterProtoConfig proto_config;
+    proto_config.mutable_upstream_multiplexing()
+        ->mutable_max_concurrent_requests_per_connection()
+        ->set_value(2);
+    config_ = std::make_shared<RouterConfig>(proto_config, factory_context_);
+
+    factory_context_.cluster_manager_.initializeThreadLocalClusters({cluster_name_});
+    ON_CALL(mock_route_entry_, clusterName()).WillByDefault(ReturnRef(cluster_name_));
+    ON_CALL(mock_codec_factory_, requestEncoder()).WillByDefault(Invoke([]() -> RequestEncoderPtr {
+      auto request_encoder = std::make_unique<NiceMock<MockRequestEncoder>>();
+      ON_CALL(*request_encoder, encode(_, _))
+          .WillByDefault(Invoke([](const Request&, RequestEncoderCallback& callback) {
+            Buffer::OwnedImpl buffer("hello");
+            callback.onEncodingSuccess(buffer, true);
+          }));
+      return request_encoder;
+    }));
+    ON_CALL(mock_codec_factory_, responseDecoder())
+        .WillByDefault(Invoke([this]() -> ResponseDecoderPtr {
+          auto response_decoder = std::make_unique<NiceMock<MockResponseDecoder>>();
+          ON_CALL(*response_decoder, setDecoderCallback(_))
+              .WillByDefault(Invoke(
+                  [this](ResponseDecoderCallback& callback) { response_callback_ = &callback; }));
+          return response_decoder;
+        }));
+  }
+
+  ~MultiplexedRouterFilterTest() override {
+    for (auto& stream : streams_) {
+      stream->filter_->onDestroy();
+    }
+  }
+
+  TestStream& createStream(absl::optional<uint64_t> stream_id) {
+    auto stream = std::make_unique<TestStream>();
+    stream->filter_ = std::make_shared<RouterFilter>(config_, factory_context_);
+    stream->filter_->setDecoderFilterCallbacks(stream->callbacks_);
+    stream->request_.stream_id_ = stream_id;
+
+    ON_CALL(stream->callbacks_, dispatcher()).WillByDefault(ReturnRef(dispatcher_));
+    ON_CALL(stream->callbacks_, downstreamCodec()).WillByDefault(ReturnRef(mock_codec_factory_));
+    ON_CALL(stream->callbacks_, streamInfo()).WillByDefault(ReturnRef(mock_stream_info_));
+    ON_CALL(stream->callbacks_, routeEntry()).WillByDefault(Return(&mock_route_entry_));
+
+    streams_.push_back(std::move(stream));
+    return *streams_.back();
+  }
+
+  void startStream(TestStream& stream) {
+    EXPECT_EQ(stream.filter_->onStreamDecoded(stream.request_), FilterStatus::StopIteration);
+  }
+
+  TestStream& newStream(absl::optional<uint64_t> stream_id) {
+    TestStream& stream = createStream(stream_id);
+    startStream(stream);
+    return stream;
+  }
+
+  ResponsePtr response(uint64_t stream_id) {
+    auto response = std::make_unique<FakeStreamCodecFactory::FakeResponse>();
+    response->stream_id_ = stream_id;
+    return response;
+  }
+
+  size_t connectionCount() {
+    return config_->multiplexedUpstream()->connectionCountForTest(tcp_conn_pool_.host_.get());
+  }
+
+  const std::string cluster_name_{"cluster_0"};
+
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context_;
+  Tcp::ConnectionPool::MockInstance& tcp_conn_pool_{
+      factory_context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_};
+  NiceMock<Envoy::Event::MockDispatcher> dispatcher_;
+  NiceMock<StreamInfo::MockStreamInfo> mock_stream_info_;
+  NiceMock<MockCodecFactory> mock_codec_factory_;
+  NiceMock<MockRouteEntry> mock_route_entry_;
+  NiceMock<Network::MockClientConnection> mock_conn_;
+
+  std::shared_ptr<RouterConfig> config_;
+  ResponseDecoderCallback* response_callback_{};
+
+  std::vector<std::unique_ptr<TestStream>> streams_;
+};
+
+TEST_F(MultiplexedRouterFilterTest, RequestsShareUpstreamConnection) {
+  EXPECT_CALL(tcp_conn_pool_, newConnection(_));
+  TestStream& stream_1 = newStream(1);
+  TestStream& stream_2 = newStream(2);
+  EXPECT_EQ(1, connectionCount());
+
+  // Both requests are sent once the connection is ready.
+  EXPECT_CALL(mock_conn_, write(_, _)).Times(2);
+  tcp_conn_pool_.poolReady(mock_conn_);
+
+  // The responses are matched by stream id, whatever their order.
+  EXPECT_CALL(stream_2.callbacks_, upstreamResponse(_)).WillOnce(Invoke([](ResponsePtr response) {
+    EXPECT_EQ(2, response->streamId().value());
+  }));
+  response_callback_->onDecodingSuccess(response(2));
+  EXPECT_EQ(1, connectionCount());
+
+  // The idle connection goes back to the pool.
+  EXPECT_CALL(stream_1.callbacks_, upstreamResponse(_)).WillOnce(Invoke([](ResponsePtr response) {
+    EXPECT_EQ(1, response->streamId().value());
+  }));
+  EXPECT_CALL(tcp_conn_pool_, released(Ref(mock_conn_)));
+  response_callback_->onDecodingSuccess(response(1));
+  EXPECT_EQ(0, connectionCount());
+}
+
+TEST_F(MultiplexedRouterFilterTest, FullConnectionOverflows) {
+  EXPECT_CALL(tcp_conn_pool_, newConnection(_));
+  TestStream& stream_1 = newStream(1);
+
+  EXPECT_CALL(mock_conn_, write(_, _)).Times(3);
+  tcp_conn_pool_.poolReady(mock_conn_);
+
+  // The request is sent right away on the ready connection.
+  newStream(2);
+
+  TestStream& stream_3 = createStream(3);
+  EXPECT_CALL(stream_3.callbacks_, sendLocalReply(_, _))
+      .WillOnce(Invoke([](Status status, ResponseUpdateFunction&&) {
+        EXPECT_EQ(status.message(), "overflow");
+      }));
+  startStream(stream_3);
+
+  // The completed stream makes room for another one.
+  EXPECT_CALL(stream_1.callbacks_, upstreamResponse(_));
+  response_callback_->onDecodingSuccess(response(1));
+  newStream(4);
+  EXPECT_EQ(1, connectionCount());
+
+  // The connection of the streams reset on destruction is closed.
+  EXPECT_CALL(mock_conn_, close(Network::ConnectionCloseType::NoFlush));
+}
+
+TEST_F(MultiplexedRouterFilterTest, ResetStreamKeepsConnectionForOtherStreams) {
+  EXPECT_CALL(tcp_conn_pool_, newConnection(_));
+  TestStream& stream_1 = newStream(1);
+  TestStream& stream_2 = newStream(2);
+
+  EXPECT_CALL(mock_conn_, write(_, _)).Times(2);
+  tcp_conn_pool_.poolReady(mock_conn_);
+
+  EXPECT_CALL(mock_conn_, close(_)).Times(0);
+  stream_1.filter_->onDestroy();
+  EXPECT_EQ(1, connectionCount());
+
+  // The stream id of the reset stream is reserved until its response arrives.
+  TestStream& stream_3 = createStream(1);
+  EXPECT_CALL(stream_3.callbacks_, sendLocalReply(_, _))
+      .WillOnce(Invoke([](Status status, ResponseUpdateFunction&&) {
+        EXPECT_EQ(status.message(), "overflow");
+      }));
+  startStream(stream_3);
+
+  // The late response of the reset stream is dropped.
+  response_callback_->onDecodingSuccess(response(1));
+  EXPECT_EQ(1, connectionCount());
+  testing::Mock::VerifyAndClearExpectations(&mock_conn_);
+
+  // The connection is closed once only reset streams are left.
+  EXPECT_CALL(mock_conn_, close(Network::ConnectionCloseType::NoFlush));
+  stream_2.filter_->onDestroy();
+  EXPECT_EQ(0, connectionCount());
+}
+
+TEST_F(MultiplexedRouterFilterTest, ConnectionCloseResetsAllStreams) {
+  EXPECT_CALL(tcp_conn_pool_, newConnection(_));
+  TestStream& stream_1 = newStream(1);
+  TestStream& stream_2 = newStream(2);
+
+  Tcp::ConnectionPool::UpstreamCallbacks* upstream_callbacks{};
+  EXPECT_CALL(*tcp_conn_pool_.connection_data_, addUpstreamCallbacks(_))
+      .WillOnce(Invoke([&](Tcp::ConnectionPool::UpstreamCallbacks& callbacks) {
+        upstream_callbacks = &callbacks;
+      }));
+  tcp_conn_pool_.poolReady(mock_conn_);
+
+  for (TestStream* stream : {&stream_1, &stream_2}) {
+    EXPECT_CALL(stream->callbacks_, sendLocalReply(_, _))
+        .WillOnce(Invoke([](Status status, ResponseUpdateFunction&&) {
+          EXPECT_EQ(status.message(), "connection_termination");
+        }));
+  }
+  upstream_callbacks->onEvent(Network::ConnectionEvent::RemoteClose);
+  EXPECT_EQ(0, connectionCount());
+}
+
+TEST_F(MultiplexedRouterFilterTest, PoolFailureResetsPendingStreams) {
+  EXPECT_CALL(tcp_conn_pool_, newConnection(_));
+  TestStream& stream_1 = newStream(1);
+  TestStream& stream_2 = newStream(2);
+
+  for (TestStream* stream : {&stream_1, &stream_2}) {
+    EXPECT_CALL(stream->callbacks_, sendLocalReply(_, _))
+        .WillOnce(Invoke([](Status status, ResponseUpdateFunction&&) {
+          EXPECT_EQ(status.message(), "connection_failure");
+        }));
+  }
+  tcp_conn_pool_.poolFailure(Tcp::ConnectionPool::PoolFailureReason::Timeout);
+  EXPECT_EQ(0, connectionCount());
+}
+
+TEST_F(MultiplexedRouterFilterTest, ResponseDecodingFailureResetsAllStreams) {
+  EXPECT_CALL(tcp_conn_pool_, newConnection(_));
+  TestStream& stream_1 = newStream(1);
+  TestStream& stream_2 = newStream(2);
+  tcp_conn_pool_.poolReady(mock_conn_);
+
+  for (TestStream* stream : {&stream_1, &stream_2}) {
+    EXPECT_CALL(stream->callbacks_, sendLocalReply(_, _))
+        .WillOnce(Invoke([](Status status, ResponseUpdateFunction&&) {
+          EXPECT_EQ(status.message(), "protocol_error");
+        }));
+  }
+  EXPECT_CALL(mock_conn_, close(Network::ConnectionCloseType::NoFlush));
+  response_callback_->onDecodingFailure();
+  EXPECT_EQ(0, connectionCount());
+}
+
+TEST_F(MultiplexedRouterFilterTest, RequestWithoutStreamIdOwnsConnection) {
+  EXPECT_CALL(tcp_conn_pool_, newConnection(_)).Times(2);
+  newStream(absl::nullopt);
+  newStream(absl::nullopt);
+  EXPECT_EQ(0, connectionCount());
+}
+
 } // namespace
 } // namespace Router
 } // namespace GenericProxy
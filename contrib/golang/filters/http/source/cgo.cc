@@ -102,6 +102,15 @@ CAPIStatus envoyGoFilterHttpRemoveHeader(void* r, void* key) {
   });
 }
 
+CAPIStatus envoyGoFilterHttpApplyHeaderMutations(void* r, void* strs, void* actions, int num) {
+  return envoyGoFilterHandlerWrapper(
+      r, [strs, actions, num](std::shared_ptr<Filter>& filter) -> CAPIStatus {
+        auto goStrs = reinterpret_cast<GoString*>(strs);
+        auto acts = reinterpret_cast<int*>(actions);
+        return filter->applyHeaderMutations(goStrs, acts, num);
+      });
+}
+
 CAPIStatus envoyGoFilterHttpGetBuffer(void* r, unsigned long long int buffer_ptr, void* data) {
   return envoyGoFilterHandlerWrapper(
       r, [buffer_ptr, data](std::shared_ptr<Filter>& filter) -> CAPIStatus {
@@ -26,6 +26,8 @@ typedef enum { // NOLINT(modernize-use-using)
 typedef enum { // NOLINT(modernize-use-using)
   HeaderSet,
   HeaderAdd,
+  // Only used by envoyGoFilterHttpApplyHeaderMutations.
+  HeaderRemove,
 } headerAction;
 
 // The return value of C Api that invoking from Go.
@@ -46,6 +48,9 @@ CAPIStatus envoyGoFilterHttpGetHeader(void* r, void* key, void* value);
 CAPIStatus envoyGoFilterHttpCopyHeaders(void* r, void* strs, void* buf);
 CAPIStatus envoyGoFilterHttpSetHeaderHelper(void* r, void* key, void* value, headerAction action);
 CAPIStatus envoyGoFilterHttpRemoveHeader(void* r, void* key);
+// Applies num header mutations at once, strs holds a key and a value for each of them, actions
+// their headerAction.
+CAPIStatus envoyGoFilterHttpApplyHeaderMutations(void* r, void* strs, void* actions, int num);
 
 CAPIStatus envoyGoFilterHttpGetBuffer(void* r, unsigned long long int buffer, void* value);
 CAPIStatus envoyGoFilterHttpSetBufferHelper(void* r, unsigned long long int buffer, void* data,
@@ -28,6 +28,9 @@ type HttpCAPI interface {
 	HttpCopyHeaders(r unsafe.Pointer, num uint64, bytes uint64) map[string][]string
 	HttpSetHeader(r unsafe.Pointer, key *string, value *string, add bool)
 	HttpRemoveHeader(r unsafe.Pointer, key *string)
+	// HttpApplyHeaderMutations applies the header mutations at once, strs holds a key and a value
+	// for each of the actions.
+	HttpApplyHeaderMutations(r unsafe.Pointer, strs []string, actions []HeaderAction)
 
 	HttpGetBuffer(r unsafe.Pointer, bufferPtr uint64, value *string, length uint64)
 	HttpSetBufferHelper(r unsafe.Pointer, bufferPtr uint64, value string, action BufferAction)
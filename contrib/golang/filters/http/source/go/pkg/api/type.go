@@ -144,6 +144,15 @@ const (
 	PrependBuffer BufferAction = 2
 )
 
+// HeaderAction is a mutation of a header map, the values match the headerAction enum in api.h.
+type HeaderAction int
+
+const (
+	SetHeader    HeaderAction = 0
+	AddHeader    HeaderAction = 1
+	RemoveHeader HeaderAction = 2
+)
+
 type DataBufferBase interface {
 	// Write appends the contents of p to the buffer, growing the buffer as
 	// needed. The return value n is the length of p; err is always nil. If the
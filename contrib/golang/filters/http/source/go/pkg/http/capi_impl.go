@@ -136,6 +136,19 @@ func (c *httpCApiImpl) HttpRemoveHeader(r unsafe.Pointer, key *string) {
 	handleCApiStatus(res)
 }
 
+func (c *httpCApiImpl) HttpApplyHeaderMutations(r unsafe.Pointer, strs []string, actions []api.HeaderAction) {
+	acts := make([]C.int, len(actions))
+	for i, action := range actions {
+		acts[i] = C.int(action)
+	}
+	sHeader := (*reflect.SliceHeader)(unsafe.Pointer(&strs))
+	aHeader := (*reflect.SliceHeader)(unsafe.Pointer(&acts))
+	res := C.envoyGoFilterHttpApplyHeaderMutations(r, unsafe.Pointer(sHeader.Data), unsafe.Pointer(aHeader.Data), C.int(len(actions)))
+	runtime.KeepAlive(strs)
+	runtime.KeepAlive(acts)
+	handleCApiStatus(res)
+}
+
 func (c *httpCApiImpl) HttpGetBuffer(r unsafe.Pointer, bufferPtr uint64, value *string, length uint64) {
 	buf := make([]byte, length)
 	bHeader := (*reflect.SliceHeader)(unsafe.Pointer(&buf))
@@ -56,6 +56,8 @@ type httpRequest struct {
 	req        *C.httpRequest
 	httpFilter api.StreamFilter
 	paniced    bool
+	// The header map of the current headers phase, its mutations are applied on Continue.
+	headerMap *httpHeaderMap
 }
 
 func (r *httpRequest) safeReplyPanic() {
@@ -91,6 +93,9 @@ func (r *httpRequest) Continue(status api.StatusType) {
 		fmt.Printf("warning: LocalReply status is useless after sendLocalReply, ignoring")
 		return
 	}
+	if r.headerMap != nil {
+		r.headerMap.flushMutations()
+	}
 	cAPI.HttpContinue(unsafe.Pointer(r.req), uint64(status))
 }
 
@@ -131,6 +131,10 @@ func envoyGoFilterOnHttpHeader(r *C.httpRequest, endStream, headerNum, headerByt
 		isTrailer:   phase == api.DecodeTrailerPhase || phase == api.EncodeTrailerPhase,
 	}
 
+	if !header.isTrailer {
+		req.headerMap = header
+	}
+
 	var status api.StatusType
 	switch phase {
 	case api.DecodeHeaderPhase:
@@ -142,6 +146,9 @@ func envoyGoFilterOnHttpHeader(r *C.httpRequest, endStream, headerNum, headerByt
 	case api.EncodeTrailerPhase:
 		status = f.EncodeTrailers(header)
 	}
+	// Apply the header mutations made in this call at once. The ones made later on by a goroutine
+	// are applied when it continues the phase.
+	header.flushMutations()
 	return uint64(status)
 }
 
@@ -19,6 +19,7 @@ package http
 
 import (
 	"strconv"
+	"sync"
 	"unsafe"
 
 	"github.com/envoyproxy/envoy/contrib/golang/filters/http/source/go/pkg/api"
@@ -38,14 +39,40 @@ type httpHeaderMap struct {
 	headerNum   uint64
 	headerBytes uint64
 	isTrailer   bool
+
+	// The header mutations not applied to Envoy yet, they are applied in one cgo call when the
+	// filter returns from the phase or continues it, see flushMutations.
+	mutationsLock   sync.Mutex
+	mutationStrs    []string
+	mutationActions []api.HeaderAction
 }
 
 var _ api.HeaderMap = (*httpHeaderMap)(nil)
 
+func (h *httpHeaderMap) addMutation(action api.HeaderAction, key, value string) {
+	h.mutationsLock.Lock()
+	h.mutationStrs = append(h.mutationStrs, key, value)
+	h.mutationActions = append(h.mutationActions, action)
+	h.mutationsLock.Unlock()
+}
+
+// flushMutations applies the collected header mutations to Envoy.
+func (h *httpHeaderMap) flushMutations() {
+	h.mutationsLock.Lock()
+	strs, actions := h.mutationStrs, h.mutationActions
+	h.mutationStrs, h.mutationActions = nil, nil
+	h.mutationsLock.Unlock()
+	if len(actions) != 0 {
+		cAPI.HttpApplyHeaderMutations(unsafe.Pointer(h.request.req), strs, actions)
+	}
+}
+
 func (h *httpHeaderMap) GetRaw(key string) string {
 	if h.isTrailer {
 		panic("unsupported yet")
 	}
+	// Envoy has to see the mutations made so far.
+	h.flushMutations()
 	var value string
 	cAPI.HttpGetHeader(unsafe.Pointer(h.request.req), &key, &value)
 	return value
@@ -82,8 +109,9 @@ func (h *httpHeaderMap) Values(key string) []string {
 }
 
 func (h *httpHeaderMap) Set(key, value string) {
-	// Get all header values first before setting a value, since the set operation may not take affects immediately
-	// when it's invoked in a Go thread, instead, it will post a callback to run in the envoy worker thread.
+	// Get all header values first before setting a value, since the mutations are applied to Envoy later on,
+	// and may not take affects immediately even then when it's invoked in a Go thread, instead, it will post
+	// a callback to run in the envoy worker thread.
 	// Otherwise, we may get outdated values in a following Get call.
 	if h.headers == nil && !h.isTrailer {
 		h.headers = cAPI.HttpCopyHeaders(unsafe.Pointer(h.request.req), h.headerNum, h.headerBytes)
@@ -94,11 +122,15 @@ func (h *httpHeaderMap) Set(key, value string) {
 	if h.isTrailer {
 		cAPI.HttpSetTrailer(unsafe.Pointer(h.request.req), &key, &value)
 	} else {
-		cAPI.HttpSetHeader(unsafe.Pointer(h.request.req), &key, &value, false)
+		h.addMutation(api.SetHeader, key, value)
 	}
 }
 
 func (h *httpHeaderMap) Add(key, value string) {
+	// Get all header values first, since the mutations are applied to Envoy later on.
+	if h.headers == nil && !h.isTrailer {
+		h.headers = cAPI.HttpCopyHeaders(unsafe.Pointer(h.request.req), h.headerNum, h.headerBytes)
+	}
 	if h.headers != nil {
 		if hdrs, found := h.headers[key]; found {
 			h.headers[key] = append(hdrs, value)
@@ -109,7 +141,7 @@ func (h *httpHeaderMap) Add(key, value string) {
 	if h.isTrailer {
 		panic("unsupported yet")
 	} else {
-		cAPI.HttpSetHeader(unsafe.Pointer(h.request.req), &key, &value, true)
+		h.addMutation(api.AddHeader, key, value)
 	}
 }
 
@@ -117,14 +149,13 @@ func (h *httpHeaderMap) Del(key string) {
 	if h.isTrailer {
 		panic("unsupported yet")
 	}
-	// Get all header values first before removing a key, since the set operation may not take affects immediately
-	// when it's invoked in a Go thread, instead, it will post a callback to run in the envoy worker thread.
+	// Get all header values first before removing a key, since the mutations are applied to Envoy later on.
 	// Otherwise, we may get outdated values in a following Get call.
-	if h.headers != nil {
+	if h.headers == nil {
 		h.headers = cAPI.HttpCopyHeaders(unsafe.Pointer(h.request.req), h.headerNum, h.headerBytes)
 	}
 	delete(h.headers, key)
-	cAPI.HttpRemoveHeader(unsafe.Pointer(h.request.req), &key)
+	h.addMutation(api.RemoveHeader, key, "")
 }
 
 func (h *httpHeaderMap) Range(f func(key, value string) bool) {
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "envoy/http/codes.h"
@@ -735,6 +736,82 @@ CAPIStatus Filter::removeHeader(absl::string_view key) {
   return CAPIStatus::CAPIOK;
 }
 
+namespace {
+
+void applyHeaderMutation(Http::HeaderMap& headers, int act, absl::string_view key,
+                         absl::string_view value) {
+  switch (act) {
+  case HeaderAdd:
+    headers.addCopy(Http::LowerCaseString(key), value);
+    break;
+
+  case HeaderSet:
+    headers.setCopy(Http::LowerCaseString(key), value);
+    break;
+
+  case HeaderRemove:
+    headers.remove(Http::LowerCaseString(key));
+    break;
+
+  default:
+    RELEASE_ASSERT(false, absl::StrCat("unknown header action: ", act));
+  }
+}
+
+} // namespace
+
+// Applies the header mutations the Go side collected during a phase in one call. Like setHeader,
+// it won't take affect immidiately while it's invoked from a Go thread, instead, it will post a
+// single callback applying all the mutations in the envoy worker thread.
+CAPIStatus Filter::applyHeaderMutations(GoString* go_strs, int* actions, int num) {
+  Thread::LockGuard lock(mutex_);
+  if (has_destroyed_) {
+    ENVOY_LOG(debug, "golang filter has been destroyed");
+    return CAPIStatus::CAPIFilterIsDestroy;
+  }
+  auto& state = getProcessorState();
+  if (!state.isProcessingInGo()) {
+    ENVOY_LOG(debug, "golang filter is not processing Go");
+    return CAPIStatus::CAPINotInGo;
+  }
+  if (headers_ == nullptr) {
+    ENVOY_LOG(debug, "invoking cgo api at invalid phase: {}", __func__);
+    return CAPIStatus::CAPIInvalidPhase;
+  }
+
+  if (state.isThreadSafe()) {
+    // it's safe to write header in the safe thread.
+    for (int i = 0; i < num; i++) {
+      applyHeaderMutation(*headers_, actions[i],
+                          absl::string_view(go_strs[2 * i].p, go_strs[2 * i].n),
+                          absl::string_view(go_strs[2 * i + 1].p, go_strs[2 * i + 1].n));
+    }
+    onHeadersModified();
+  } else {
+    // should deep copy the strings before post to dipatcher callback.
+    std::vector<std::tuple<int, std::string, std::string>> mutations;
+    mutations.reserve(num);
+    for (int i = 0; i < num; i++) {
+      mutations.emplace_back(actions[i], std::string(go_strs[2 * i].p, go_strs[2 * i].n),
+                             std::string(go_strs[2 * i + 1].p, go_strs[2 * i + 1].n));
+    }
+
+    auto weak_ptr = weak_from_this();
+    state.getDispatcher().post([this, weak_ptr, mutations = std::move(mutations)] {
+      Thread::LockGuard lock(mutex_);
+      if (!weak_ptr.expired() && !has_destroyed_) {
+        for (const auto& [act, key, value] : mutations) {
+          applyHeaderMutation(*headers_, act, key, value);
+        }
+        onHeadersModified();
+      } else {
+        ENVOY_LOG(debug, "golang filter has gone or destroyed in applyHeaderMutations");
+      }
+    });
+  }
+  return CAPIStatus::CAPIOK;
+}
+
 CAPIStatus Filter::copyBuffer(Buffer::Instance* buffer, char* data) {
   Thread::LockGuard lock(mutex_);
   if (has_destroyed_) {
@@ -157,6 +157,7 @@ public:
   CAPIStatus copyHeaders(GoString* go_strs, char* go_buf);
   CAPIStatus setHeader(absl::string_view key, absl::string_view value, headerAction act);
   CAPIStatus removeHeader(absl::string_view key);
+  CAPIStatus applyHeaderMutations(GoString* go_strs, int* actions, int num);
   CAPIStatus copyBuffer(Buffer::Instance* buffer, char* data);
   CAPIStatus setBufferHelper(Buffer::Instance* buffer, absl::string_view& value,
                              bufferAction action);
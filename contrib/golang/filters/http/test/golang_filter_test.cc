@@ -176,6 +176,16 @@ TEST_F(GolangHttpFilterTest, SetHeaderAtWrongStage) {
   EXPECT_EQ(CAPINotInGo, filter_->setHeader("foo", "bar", HeaderSet));
 }
 
+// applyHeaderMutations at wrong stage
+TEST_F(GolangHttpFilterTest, ApplyHeaderMutationsAtWrongStage) {
+  InSequence s;
+  setup(PASSTHROUGH, genSoPath(PASSTHROUGH), PASSTHROUGH);
+
+  GoString strs[2] = {{"foo", 3}, {"bar", 3}};
+  int actions[1] = {HeaderSet};
+  EXPECT_EQ(CAPINotInGo, filter_->applyHeaderMutations(strs, actions, 1));
+}
+
 } // namespace
 } // namespace Golang
 } // namespace HttpFilters
@@ -18,10 +18,12 @@ Network::FilterFactoryCb KafkaConfigFactory::createFilterFactoryFromProtoTyped(
   ASSERT(!proto_config.stat_prefix().empty());
 
   const std::string& stat_prefix = proto_config.stat_prefix();
+  const bool request_headers_only = proto_config.parse_request_headers_only();
 
-  return [&context, stat_prefix](Network::FilterManager& filter_manager) -> void {
-    Network::FilterSharedPtr filter =
-        std::make_shared<KafkaBrokerFilter>(context.scope(), context.timeSource(), stat_prefix);
+  return [&context, stat_prefix,
+          request_headers_only](Network::FilterManager& filter_manager) -> void {
+    Network::FilterSharedPtr filter = std::make_shared<KafkaBrokerFilter>(
+        context.scope(), context.timeSource(), stat_prefix, request_headers_only);
     filter_manager.addFilter(filter);
   };
 }
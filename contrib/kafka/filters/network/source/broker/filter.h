@@ -137,8 +137,10 @@ public:
    * Main constructor.
    * Creates decoders that eventually update prefixed metrics stored in scope, using time source for
    * duration calculation.
+   * If request_headers_only is set, the request data is skipped instead of being parsed.
    */
-  KafkaBrokerFilter(Stats::Scope& scope, TimeSource& time_source, const std::string& stat_prefix);
+  KafkaBrokerFilter(Stats::Scope& scope, TimeSource& time_source, const std::string& stat_prefix,
+                    bool request_headers_only);
 
   /**
    * Visible for testing.
@@ -162,7 +164,8 @@ private:
    * Helper delegate constructor.
    * Passes metrics facade as argument to decoders.
    */
-  KafkaBrokerFilter(const KafkaMetricsFacadeSharedPtr& metrics);
+  KafkaBrokerFilter(const KafkaMetricsFacadeSharedPtr& metrics,
+                    const RequestParserResolver& request_parser_resolver);
 
   const KafkaMetricsFacadeSharedPtr metrics_;
   const ResponseDecoderSharedPtr response_decoder_;
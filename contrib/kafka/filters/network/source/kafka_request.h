@@ -166,6 +166,25 @@ public:
   const Data data_;
 };
 
+/**
+ * Request which data has been skipped instead of being parsed, so that it only carries the header.
+ * Its serialized form consists of the header alone.
+ */
+class HeaderOnlyRequest : public AbstractRequest {
+public:
+  HeaderOnlyRequest(const RequestHeader& request_header) : AbstractRequest{request_header} {};
+
+  uint32_t computeSize() const override {
+    const EncodingContext context{request_header_.api_version_};
+    return context.computeSize(request_header_);
+  }
+
+  uint32_t encode(Buffer::Instance& dst) const override {
+    EncodingContext context{request_header_.api_version_};
+    return context.encode(request_header_, dst);
+  }
+};
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -9,6 +9,20 @@ const RequestParserResolver& RequestParserResolver::getDefaultInstance() {
   CONSTRUCT_ON_FIRST_USE(RequestParserResolver);
 }
 
+const RequestParserResolver& RequestParserResolver::getHeaderOnlyInstance() {
+  CONSTRUCT_ON_FIRST_USE(HeaderOnlyRequestParserResolver);
+}
+
+RequestParserSharedPtr
+HeaderOnlyRequestParserResolver::createParser(int16_t api_key, int16_t api_version,
+                                              RequestContextSharedPtr context) const {
+  if (requestHasParser(api_key, api_version)) {
+    return std::make_shared<RequestDataSkipParser>(context);
+  } else {
+    return std::make_shared<SentinelParser>(context);
+  }
+}
+
 RequestParseResponse RequestStartParser::parse(absl::string_view& data) {
   request_length_.feed(data);
   if (request_length_.ready()) {
@@ -67,6 +81,18 @@ RequestParseResponse RequestHeaderParser::parse(absl::string_view& data) {
   }
 }
 
+RequestParseResponse RequestDataSkipParser::parse(absl::string_view& data) {
+  const uint32_t min = std::min<uint32_t>(context_->remaining(), data.size());
+  data = {data.data() + min, data.size() - min};
+  context_->remaining() -= min;
+  if (0 == context_->remaining()) {
+    return RequestParseResponse::parsedMessage(
+        std::make_shared<HeaderOnlyRequest>(context_->request_header_));
+  } else {
+    return RequestParseResponse::stillWaiting();
+  }
+}
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -47,6 +47,15 @@ struct RequestContext {
 
 using RequestContextSharedPtr = std::shared_ptr<RequestContext>;
 
+/**
+ * Decides if there is a parser for request with given api key & version.
+ * This method gets implemented in generated code through 'kafka_request_resolver_cc.j2'.
+ * @param api_key Kafka request key.
+ * @param api_version Kafka request's version.
+ * @return Whether the request can be parsed.
+ */
+bool requestHasParser(const int16_t api_key, const int16_t api_version);
+
 /**
  * Request decoder configuration object.
  * Resolves the parser that will be responsible for consuming the request-specific data.
@@ -70,6 +79,21 @@ public:
    * Return default resolver, that uses request's api key and version to provide a matching parser.
    */
   static const RequestParserResolver& getDefaultInstance();
+
+  /**
+   * Return resolver that skips the data of the requests, so that only their headers are parsed.
+   */
+  static const RequestParserResolver& getHeaderOnlyInstance();
+};
+
+/**
+ * Resolver that provides parsers skipping the request data, for requests with given api key &
+ * version that could otherwise be parsed.
+ */
+class HeaderOnlyRequestParserResolver : public RequestParserResolver {
+public:
+  RequestParserSharedPtr createParser(int16_t api_key, int16_t api_version,
+                                      RequestContextSharedPtr context) const override;
 };
 
 /**
@@ -176,6 +200,26 @@ public:
   }
 };
 
+/**
+ * Parser that skips the request data without deserializing it, and returns a request that carries
+ * only the header.
+ */
+class RequestDataSkipParser : public RequestParser {
+public:
+  RequestDataSkipParser(RequestContextSharedPtr context) : context_{context} {};
+
+  /**
+   * Consumes the remaining bytes of the request.
+   * @return HeaderOnlyRequest instance when the end of the request is reached.
+   */
+  RequestParseResponse parse(absl::string_view& data) override;
+
+  const RequestContextSharedPtr contextForTest() const { return context_; }
+
+private:
+  const RequestContextSharedPtr context_;
+};
+
 /**
  * Request parser uses a single deserializer to construct a request object.
  * This parser is responsible for consuming request-specific data (e.g. topic names) and always
@@ -84,7 +84,7 @@ void RichKafkaProducer::send(const ProduceFinishCbSharedPtr origin, const Outbou
 
     if (RdKafka::ERR_NO_ERROR == ec) {
       // We have succeeded with submitting data to producer, so we register a callback.
-      unfinished_produce_requests_.push_back(origin);
+      unfinished_produce_requests_[value_data].push_back(origin);
     } else {
       // We could not submit data to producer.
       // Let's treat that as a normal failure (Envoy is a broker after all) and propagate
@@ -124,22 +124,31 @@ void RichKafkaProducer::dr_cb(RdKafka::Message& message) {
 }
 
 // We got the delivery data.
-// Now we just check all unfinished requests, find the one that originated this particular delivery,
-// and notify it.
+// Now we just check the unfinished requests that sent this payload, find the one that originated
+// this particular delivery, and notify it.
 void RichKafkaProducer::processDelivery(const DeliveryMemento& memento) {
-  for (auto it = unfinished_produce_requests_.begin(); it != unfinished_produce_requests_.end();) {
+  auto origins = unfinished_produce_requests_.find(memento.data_);
+  if (origins == unfinished_produce_requests_.end()) {
+    return;
+  }
+  for (auto it = origins->second.begin(); it != origins->second.end(); ++it) {
     bool accepted = (*it)->accept(memento);
     if (accepted) {
-      unfinished_produce_requests_.erase(it);
+      origins->second.erase(it);
       break; // This is important - a single request can be mapped into multiple callbacks here.
-    } else {
-      ++it;
     }
   }
+  if (origins->second.empty()) {
+    unfinished_produce_requests_.erase(origins);
+  }
 }
 
-std::list<ProduceFinishCbSharedPtr>& RichKafkaProducer::getUnfinishedRequestsForTest() {
-  return unfinished_produce_requests_;
+size_t RichKafkaProducer::getUnfinishedRequestCountForTest() const {
+  size_t result = 0;
+  for (const auto& origins : unfinished_produce_requests_) {
+    result += origins.second.size();
+  }
+  return result;
 }
 
 } // namespace Mesh
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <list>
 
 #include "envoy/event/dispatcher.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "contrib/kafka/filters/network/source/mesh/librdkafka_utils.h"
 #include "contrib/kafka/filters/network/source/mesh/upstream_kafka_client.h"
 
@@ -53,12 +55,16 @@ public:
   // Executed in Envoy worker thread.
   void processDelivery(const DeliveryMemento& memento);
 
-  std::list<ProduceFinishCbSharedPtr>& getUnfinishedRequestsForTest();
+  size_t getUnfinishedRequestCountForTest() const;
 
 private:
   Event::Dispatcher& dispatcher_;
 
-  std::list<ProduceFinishCbSharedPtr> unfinished_produce_requests_;
+  // Origins of the records waiting for their delivery, by the payload that was passed to the
+  // producer, so that a delivery confirmation does not need to be offered to all of them.
+  // Records can share a payload pointer (e.g. null values), hence the list.
+  absl::flat_hash_map<const void*, std::list<ProduceFinishCbSharedPtr>>
+      unfinished_produce_requests_;
 
   // Real Kafka producer (thread-safe).
   // Invoked by Envoy handler thread (to produce), and internal monitoring thread
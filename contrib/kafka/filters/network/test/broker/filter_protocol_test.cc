@@ -28,14 +28,15 @@ using ResponseB = MessageBasedTest<ResponseEncoder>;
 // Message size for all kind of broken messages (we are not going to process all the bytes).
 constexpr static int32_t BROKEN_MESSAGE_SIZE = std::numeric_limits<int32_t>::max();
 
-class KafkaBrokerFilterProtocolTest : public testing::Test,
+// Parameterized with whether only the request headers are parsed.
+class KafkaBrokerFilterProtocolTest : public testing::TestWithParam<bool>,
                                       protected RequestB,
                                       protected ResponseB {
 protected:
   Stats::TestUtil::TestStore store_;
   Stats::Scope& scope_{*store_.rootScope()};
   Event::TestRealTimeSystem time_source_;
-  KafkaBrokerFilter testee_{scope_, time_source_, "prefix"};
+  KafkaBrokerFilter testee_{scope_, time_source_, "prefix", GetParam()};
 
   Network::FilterStatus consumeRequestFromBuffer() {
     return testee_.onData(RequestB::buffer_, false);
@@ -46,7 +47,9 @@ protected:
   }
 };
 
-TEST_F(KafkaBrokerFilterProtocolTest, ShouldHandleUnknownRequestAndResponseWithoutBreaking) {
+INSTANTIATE_TEST_SUITE_P(RequestHeadersOnly, KafkaBrokerFilterProtocolTest, testing::Bool());
+
+TEST_P(KafkaBrokerFilterProtocolTest, ShouldHandleUnknownRequestAndResponseWithoutBreaking) {
   // given
   const int16_t unknown_api_key = std::numeric_limits<int16_t>::max();
 
@@ -71,7 +74,7 @@ TEST_F(KafkaBrokerFilterProtocolTest, ShouldHandleUnknownRequestAndResponseWitho
   ASSERT_EQ(store_.counter("kafka.prefix.response.unknown").value(), 1);
 }
 
-TEST_F(KafkaBrokerFilterProtocolTest, ShouldHandleBrokenRequestPayload) {
+TEST_P(KafkaBrokerFilterProtocolTest, ShouldHandleBrokenRequestPayload) {
   // given
 
   // Encode broken request into buffer.
@@ -90,7 +93,7 @@ TEST_F(KafkaBrokerFilterProtocolTest, ShouldHandleBrokenRequestPayload) {
   ASSERT_EQ(testee_.getRequestDecoderForTest()->getCurrentParserForTest(), nullptr);
 }
 
-TEST_F(KafkaBrokerFilterProtocolTest, ShouldHandleBrokenResponsePayload) {
+TEST_P(KafkaBrokerFilterProtocolTest, ShouldHandleBrokenResponsePayload) {
   // given
 
   const int32_t correlation_id = 42;
@@ -111,7 +114,7 @@ TEST_F(KafkaBrokerFilterProtocolTest, ShouldHandleBrokenResponsePayload) {
   ASSERT_EQ(testee_.getResponseDecoderForTest()->getCurrentParserForTest(), nullptr);
 }
 
-TEST_F(KafkaBrokerFilterProtocolTest, ShouldAbortOnUnregisteredResponse) {
+TEST_P(KafkaBrokerFilterProtocolTest, ShouldAbortOnUnregisteredResponse) {
   // given
   const ResponseMetadata response_metadata = {0, 0, 0};
   const ProduceResponse response_data = {{}};
@@ -125,7 +128,7 @@ TEST_F(KafkaBrokerFilterProtocolTest, ShouldAbortOnUnregisteredResponse) {
   ASSERT_EQ(result, Network::FilterStatus::StopIteration);
 }
 
-TEST_F(KafkaBrokerFilterProtocolTest, ShouldProcessMessages) {
+TEST_P(KafkaBrokerFilterProtocolTest, ShouldProcessMessages) {
   // given
   // For every request/response type & version, put a corresponding request into the buffer.
   for (const AbstractRequestSharedPtr& message : MessageUtilities::makeAllRequests()) {
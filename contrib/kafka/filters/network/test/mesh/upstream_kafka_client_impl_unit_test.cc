@@ -78,7 +78,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldSendRecordsAndReceiveConfirmations) {
   for (const auto& arg : payloads) {
     testee.send(origin_, makeRecord(arg));
   }
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), payloads.size());
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), payloads.size());
 
   // when, then - should process confirmations.
   EXPECT_CALL(*origin_, accept(_)).Times(3).WillRepeatedly(Return(true));
@@ -86,7 +86,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldSendRecordsAndReceiveConfirmations) {
     const DeliveryMemento memento = {arg.c_str(), RdKafka::ERR_NO_ERROR, 0};
     testee.processDelivery(memento);
   }
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
@@ -103,17 +103,42 @@ TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
   auto origin2 = std::make_shared<MockProduceFinishCb>();
   testee.send(origin1, makeRecord(payloads[0]));
   testee.send(origin2, makeRecord(payloads[1]));
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), payloads.size());
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), payloads.size());
 
-  // when, then - should process confirmations (notice we pass second memento first).
-  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(false)).WillOnce(Return(true));
+  // when, then - should process confirmations (notice we pass second memento first), only
+  // offering each of them to the origin that sent its payload.
+  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(true));
   EXPECT_CALL(*origin2, accept(_)).WillOnce(Return(true));
   const DeliveryMemento memento1 = {payloads[1].c_str(), RdKafka::ERR_NO_ERROR, 0};
   testee.processDelivery(memento1);
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 1);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 1);
   const DeliveryMemento memento2 = {payloads[0].c_str(), RdKafka::ERR_NO_ERROR, 0};
   testee.processDelivery(memento2);
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
+}
+
+TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveriesOfSamePayload) {
+  // given
+  setupConstructorExpectations();
+  RichKafkaProducer testee = {dispatcher_, thread_factory_, config_, kafka_utils_};
+
+  // when, then - should send request without problems.
+  EXPECT_CALL(producer_, produce("topic", 13, _, _, _, _, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(RdKafka::ERR_NO_ERROR));
+  const std::string payload = "value";
+  auto origin1 = std::make_shared<MockProduceFinishCb>();
+  auto origin2 = std::make_shared<MockProduceFinishCb>();
+  testee.send(origin1, makeRecord(payload));
+  testee.send(origin2, makeRecord(payload));
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 2);
+
+  // when, then - should offer the confirmation to the origins that sent the payload, in order.
+  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(false));
+  EXPECT_CALL(*origin2, accept(_)).WillOnce(Return(true));
+  const DeliveryMemento memento = {payload.c_str(), RdKafka::ERR_NO_ERROR, 0};
+  testee.processDelivery(memento);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 1);
 }
 
 TEST_F(UpstreamKafkaClientTest, ShouldHandleProduceFailures) {
@@ -127,7 +152,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldHandleProduceFailures) {
   EXPECT_CALL(kafka_utils_, deleteHeaders(_));
   EXPECT_CALL(*origin_, accept(_)).WillOnce(Return(true));
   testee.send(origin_, makeRecord("value"));
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 TEST_F(UpstreamKafkaClientTest, ShouldHandleKafkaCallback) {
@@ -152,7 +177,7 @@ TEST_F(UpstreamKafkaClientTest, ShouldHandleHeaderConversionFailures) {
   EXPECT_CALL(producer_, produce(_, _, _, _, _, _, _, _, _, _)).Times(0);
   EXPECT_CALL(*origin_, accept(_)).WillOnce(Return(true));
   testee.send(origin_, makeRecord("value"));
-  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
+  EXPECT_EQ(testee.getUnfinishedRequestCountForTest(), 0);
 }
 
 // This handles situations when users pass bad config to raw producer.
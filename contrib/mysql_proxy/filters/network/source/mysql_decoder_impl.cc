@@ -140,6 +140,14 @@ void DecoderImpl::parseMessage(Buffer::Instance& message, uint8_t seq, uint32_t
 
   // Process Command
   case MySQLSession::State::Req: {
+    // Only queries are decoded when only message boundaries are decoded.
+    uint8_t cmd;
+    if (message_boundaries_only_ &&
+        (BufferHelper::peekUint8(message, cmd) != DecodeStatus::Success ||
+         static_cast<Command::Cmd>(cmd) != Command::Cmd::Query)) {
+      session_.setState(MySQLSession::State::ReqResp);
+      break;
+    }
     Command command{};
     command.decode(message, seq, len);
     session_.setState(MySQLSession::State::ReqResp);
@@ -149,6 +157,10 @@ void DecoderImpl::parseMessage(Buffer::Instance& message, uint8_t seq, uint32_t
 
   // Process Command Response
   case MySQLSession::State::ReqResp: {
+    // Command responses are never decoded when only message boundaries are decoded.
+    if (message_boundaries_only_) {
+      break;
+    }
     CommandResponse command_resp{};
     command_resp.decode(message, seq, len);
     callbacks_.onCommandResponse(command_resp);
@@ -8,7 +8,10 @@ namespace MySQLProxy {
 
 class DecoderImpl : public Decoder, public Logger::Loggable<Logger::Id::filter> {
 public:
-  DecoderImpl(DecoderCallbacks& callbacks) : callbacks_(callbacks) {}
+  // When message_boundaries_only is true, the responses to commands and the commands other than
+  // queries are not decoded.
+  DecoderImpl(DecoderCallbacks& callbacks, bool message_boundaries_only = false)
+      : callbacks_(callbacks), message_boundaries_only_(message_boundaries_only) {}
 
   // MySQLProxy::Decoder
   void onData(Buffer::Instance& data) override;
@@ -19,6 +22,7 @@ private:
   void parseMessage(Buffer::Instance& message, uint8_t seq, uint32_t len);
 
   DecoderCallbacks& callbacks_;
+  const bool message_boundaries_only_;
   MySQLSession session_;
 };
 
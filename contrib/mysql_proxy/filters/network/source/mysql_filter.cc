@@ -16,8 +16,10 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace MySQLProxy {
 
-MySQLFilterConfig::MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope)
-    : scope_(scope), stats_(generateStats(stat_prefix, scope)) {}
+MySQLFilterConfig::MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope,
+                                     bool message_boundaries_only)
+    : scope_(scope), stats_(generateStats(stat_prefix, scope)),
+      message_boundaries_only_(message_boundaries_only) {}
 
 MySQLFilter::MySQLFilter(MySQLFilterConfigSharedPtr config) : config_(std::move(config)) {}
 
@@ -69,7 +71,7 @@ void MySQLFilter::doDecode(Buffer::Instance& buffer) {
 }
 
 DecoderPtr MySQLFilter::createDecoder(DecoderCallbacks& callbacks) {
-  return std::make_unique<DecoderImpl>(callbacks);
+  return std::make_unique<DecoderImpl>(callbacks, config_->message_boundaries_only_);
 }
 
 void MySQLFilter::onProtocolError() { config_->stats_.protocol_errors_.inc(); }
@@ -49,12 +49,14 @@ struct MySQLProxyStats {
  */
 class MySQLFilterConfig {
 public:
-  MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope);
+  MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope,
+                    bool message_boundaries_only = false);
 
   const MySQLProxyStats& stats() { return stats_; }
 
   Stats::Scope& scope_;
   MySQLProxyStats stats_;
+  const bool message_boundaries_only_;
 
 private:
   MySQLProxyStats generateStats(const std::string& prefix, Stats::Scope& scope) {
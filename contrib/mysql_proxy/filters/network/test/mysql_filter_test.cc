@@ -22,8 +22,8 @@ class MySQLFilterTest : public testing::Test, public MySQLTestUtils {
 public:
   MySQLFilterTest() { ENVOY_LOG_MISC(info, "test"); }
 
-  void initialize() {
-    config_ = std::make_shared<MySQLFilterConfig>(stat_prefix_, scope_);
+  void initialize(bool message_boundaries_only = false) {
+    config_ = std::make_shared<MySQLFilterConfig>(stat_prefix_, scope_, message_boundaries_only);
     filter_ = std::make_unique<MySQLFilter>(config_);
     filter_->initializeReadFilterCallbacks(filter_callbacks_);
   }
@@ -1068,6 +1068,50 @@ TEST_F(MySQLFilterTest, MySqlLoginAndQueryTest) {
   EXPECT_EQ(MySQLSession::State::ReqResp, filter_->getSession().getState());
 }
 
+// Only queries are decoded after the login when only message boundaries are decoded.
+TEST_F(MySQLFilterTest, MySqlMessageBoundariesOnlyTest) {
+  initialize(true);
+
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onNewConnection());
+  Buffer::OwnedImpl greet_data(encodeServerGreeting(MYSQL_PROTOCOL_10));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(greet_data, false));
+  Buffer::OwnedImpl client_login_data(
+      encodeClientLogin(CLIENT_PROTOCOL_41, "user1", CHALLENGE_SEQ_NUM));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(client_login_data, false));
+  EXPECT_EQ(1UL, config_->stats().login_attempts_.value());
+  Buffer::OwnedImpl server_resp_data(encodeClientLoginResp(MYSQL_RESP_OK));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(server_resp_data, false));
+  EXPECT_EQ(MySQLSession::State::Req, filter_->getSession().getState());
+
+  Command mysql_cmd_encode{};
+  mysql_cmd_encode.setCmd(Command::Cmd::FieldList);
+  mysql_cmd_encode.setData("");
+  Buffer::OwnedImpl cmd_field_list;
+  mysql_cmd_encode.encode(cmd_field_list);
+  BufferHelper::encodeHdr(cmd_field_list, 0);
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(cmd_field_list, false));
+  EXPECT_EQ(MySQLSession::State::ReqResp, filter_->getSession().getState());
+
+  Buffer::OwnedImpl field_list_resp_data(encodeClientLoginResp(MYSQL_RESP_OK, 0, 1));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(field_list_resp_data, false));
+  EXPECT_EQ(MySQLSession::State::ReqResp, filter_->getSession().getState());
+  EXPECT_EQ(0UL, config_->stats().queries_parsed_.value());
+
+  mysql_cmd_encode.setCmd(Command::Cmd::Query);
+  mysql_cmd_encode.setData("show databases");
+  Buffer::OwnedImpl query_show;
+  mysql_cmd_encode.encode(query_show);
+  BufferHelper::encodeHdr(query_show, 0);
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(query_show, false));
+  EXPECT_EQ(MySQLSession::State::ReqResp, filter_->getSession().getState());
+  EXPECT_EQ(1UL, config_->stats().queries_parsed_.value());
+
+  Buffer::OwnedImpl show_resp_data(encodeClientLoginResp(MYSQL_RESP_OK, 0, 1));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(show_resp_data, false));
+  EXPECT_EQ(MySQLSession::State::ReqResp, filter_->getSession().getState());
+  EXPECT_EQ(0UL, config_->stats().protocol_errors_.value());
+}
+
 } // namespace MySQLProxy
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -1,5 +1,6 @@
 #include "contrib/postgres_proxy/filters/network/source/postgres_decoder.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/strings/str_split.h"
@@ -98,6 +99,20 @@ void DecoderImpl::initialize() {
   BE_messages_.unknown_ =
       MessageProcessor{"Other", BODY_FORMAT(ByteN), {&DecoderImpl::incMessagesUnknown}};
 
+  // Setup jump tables used when only message boundaries are decoded.
+  FE_framing_.fill(FramedMessage::Unknown);
+  for (const auto& msg : FE_known_msgs) {
+    FE_framing_[static_cast<uint8_t>(msg.first)] = FramedMessage::Known;
+  }
+  if (sql_parsing_) {
+    FE_framing_['Q'] = FramedMessage::Query;
+    FE_framing_['P'] = FramedMessage::Parse;
+  }
+  BE_framing_.fill(FramedMessage::Unknown);
+  for (const auto& msg : BE_known_msgs) {
+    BE_framing_[static_cast<uint8_t>(msg.first)] = FramedMessage::Known;
+  }
+
   // Setup hash map for handling backend statements.
   BE_statements_["BEGIN"] = [this](DecoderImpl*) -> void {
     callbacks_->incStatements(DecoderCallbacks::StatementType::Other);
@@ -190,7 +205,8 @@ Decoder::Result DecoderImpl::onData(Buffer::Instance& data, bool frontend) {
   case State::EncryptedState:
     return onDataIgnore(data, frontend);
   case State::InSyncState:
-    return onDataInSync(data, frontend);
+    return message_boundaries_only_ ? onDataFraming(data, frontend)
+                                    : onDataInSync(data, frontend);
   case State::NegotiatingUpstreamSSL:
     return onDataInNegotiating(data, frontend);
   default:
@@ -390,6 +406,71 @@ Decoder::Result DecoderImpl::onDataInSync(Buffer::Instance& data, bool frontend)
 
   return Decoder::Result::ReadyForNext;
 }
+
+/*
+  onDataFraming is called instead of onDataInSync when only message boundaries
+  are decoded. Messages are counted from their type and length, and their
+  payload is drained as it arrives, without being validated or buffered.
+  Only Query and Parse messages are buffered when SQL parsing is enabled.
+*/
+Decoder::Result DecoderImpl::onDataFraming(Buffer::Instance& data, bool frontend) {
+  uint64_t& bytes_to_skip = frontend ? FE_bytes_to_skip_ : BE_bytes_to_skip_;
+  if (bytes_to_skip > 0) {
+    // Rest of the payload of a message which has already been counted.
+    const uint64_t length = std::min(bytes_to_skip, data.length());
+    data.drain(length);
+    bytes_to_skip -= length;
+    return Decoder::Result::ReadyForNext;
+  }
+
+  // The 1 byte message type and the 4 bytes message length are needed to frame the message.
+  if (data.length() < 5) {
+    return Decoder::Result::NeedMoreData;
+  }
+
+  data.copyOut(0, 1, &command_);
+  message_len_ = data.peekBEInt<uint32_t>(1);
+  if (message_len_ < 4) {
+    // The length includes itself, so the message boundaries are lost. Move to out-of-sync state.
+    data.drain(data.length());
+    state_ = State::OutOfSyncState;
+    return Decoder::Result::ReadyForNext;
+  }
+
+  const FramedMessage type =
+      (frontend ? FE_framing_ : BE_framing_)[static_cast<uint8_t>(command_)];
+  const uint64_t message_len = uint64_t(message_len_) + 1;
+  if ((type == FramedMessage::Query || type == FramedMessage::Parse) &&
+      data.length() < message_len) {
+    return Decoder::Result::NeedMoreData;
+  }
+
+  frontend ? callbacks_->incMessagesFrontend() : callbacks_->incMessagesBackend();
+  ENVOY_LOG(trace, "postgres_proxy: ({}) command = {}, length = {}",
+            frontend ? FRONTEND : BACKEND, command_, message_len_);
+
+  switch (type) {
+  case FramedMessage::Unknown:
+    incMessagesUnknown();
+    break;
+  case FramedMessage::Known:
+    break;
+  case FramedMessage::Query:
+  case FramedMessage::Parse:
+    data.drain(5);
+    message_.assign(static_cast<char*>(data.linearize(message_len_ - 4)), message_len_ - 4);
+    type == FramedMessage::Query ? onQuery() : onParse();
+    message_.erase();
+    data.drain(message_len_ - 4);
+    return Decoder::Result::ReadyForNext;
+  }
+
+  const uint64_t length = std::min(message_len, data.length());
+  data.drain(length);
+  bytes_to_skip = message_len - length;
+  return Decoder::Result::ReadyForNext;
+}
+
 /*
   onDataIgnore method is called when the decoder does not inspect passing
   messages. This happens when the decoder detected encrypted packets or
@@ -537,6 +618,10 @@ void DecoderImpl::onParse() {
   // The first string is optional. If no \0 is found it means
   // that the message contains query string only.
   std::vector<std::string> query_parts = absl::StrSplit(message_, absl::ByChar('\0'));
+  if (query_parts.size() < 2) {
+    // Only possible when the message was not validated, because only its boundaries are decoded.
+    return;
+  }
   callbacks_->processQuery(query_parts[1]);
 }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <cstdint>
 
 #include "envoy/common/platform.h"
@@ -80,7 +81,15 @@ using DecoderPtr = std::unique_ptr<Decoder>;
 
 class DecoderImpl : public Decoder, Logger::Loggable<Logger::Id::filter> {
 public:
-  DecoderImpl(DecoderCallbacks* callbacks) : callbacks_(callbacks) { initialize(); }
+  // When message_boundaries_only is true, messages received after the startup message are only
+  // framed and counted. Their payload is skipped, except for Query and Parse messages when
+  // sql_parsing is true.
+  DecoderImpl(DecoderCallbacks* callbacks, bool message_boundaries_only = false,
+              bool sql_parsing = true)
+      : callbacks_(callbacks), message_boundaries_only_(message_boundaries_only),
+        sql_parsing_(sql_parsing) {
+    initialize();
+  }
 
   Result onData(Buffer::Instance& data, bool frontend) override;
   PostgresSession& getSession() override { return session_; }
@@ -106,6 +115,7 @@ protected:
 
   Result onDataInit(Buffer::Instance& data, bool frontend);
   Result onDataInSync(Buffer::Instance& data, bool frontend);
+  Result onDataFraming(Buffer::Instance& data, bool frontend);
   Result onDataIgnore(Buffer::Instance& data, bool frontend);
   Result onDataInNegotiating(Buffer::Instance& data, bool frontend);
 
@@ -136,6 +146,16 @@ protected:
     MessageProcessor unknown_;
   };
 
+  // How messages are handled when only message boundaries are decoded.
+  enum class FramedMessage : uint8_t {
+    Unknown, // Counted as unknown message, payload skipped.
+    Known,   // Payload skipped.
+    Query,   // Payload read and passed to onQuery.
+    Parse    // Payload read and passed to onParse.
+  };
+  // Jump table indexed by the message type byte.
+  using FramingTable = std::array<FramedMessage, 256>;
+
   // Hash map binding keyword found in a message to an
   // action to be executed when the keyword is found.
   using KeywordProcessor = absl::flat_hash_map<std::string, MsgAction>;
@@ -174,6 +194,8 @@ protected:
 
   DecoderCallbacks* callbacks_{};
   PostgresSession session_{};
+  const bool message_boundaries_only_;
+  const bool sql_parsing_;
 
   // The following fields store result of message parsing.
   char command_{'-'};
@@ -186,6 +208,13 @@ protected:
   MsgGroup FE_messages_;
   MsgGroup BE_messages_;
 
+  // Jump tables for Backend (BE) and Frontend (FE) messages when only message boundaries are
+  // decoded, and the number of bytes of the current message payload still to be skipped.
+  FramingTable FE_framing_{};
+  FramingTable BE_framing_{};
+  uint64_t FE_bytes_to_skip_{};
+  uint64_t BE_bytes_to_skip_{};
+
   // Handler for startup postgres message.
   // Startup message message which does not start with 1 byte TYPE.
   // It starts with message length and must be therefore handled
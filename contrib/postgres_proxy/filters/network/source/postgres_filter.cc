@@ -17,7 +17,8 @@ PostgresFilterConfig::PostgresFilterConfig(const PostgresFilterConfigOptions& co
                                            Stats::Scope& scope)
     : enable_sql_parsing_(config_options.enable_sql_parsing_),
       terminate_ssl_(config_options.terminate_ssl_), upstream_ssl_(config_options.upstream_ssl_),
-      scope_{scope}, stats_{generateStats(config_options.stats_prefix_, scope)} {}
+      message_boundaries_only_(config_options.message_boundaries_only_), scope_{scope},
+      stats_{generateStats(config_options.stats_prefix_, scope)} {}
 
 PostgresFilter::PostgresFilter(PostgresFilterConfigSharedPtr config) : config_{config} {
   if (!decoder_) {
@@ -60,7 +61,8 @@ Network::FilterStatus PostgresFilter::onWrite(Buffer::Instance& data, bool) {
 }
 
 DecoderPtr PostgresFilter::createDecoder(DecoderCallbacks* callbacks) {
-  return std::make_unique<DecoderImpl>(callbacks);
+  return std::make_unique<DecoderImpl>(callbacks, config_->message_boundaries_only_,
+                                       config_->enable_sql_parsing_);
 }
 
 void PostgresFilter::incMessagesBackend() {
@@ -72,6 +72,7 @@ public:
     bool terminate_ssl_;
     envoy::extensions::filters::network::postgres_proxy::v3alpha::PostgresProxy::SSLMode
         upstream_ssl_;
+    bool message_boundaries_only_{false};
   };
   PostgresFilterConfig(const PostgresFilterConfigOptions& config_options, Stats::Scope& scope);
 
@@ -80,6 +81,7 @@ public:
   envoy::extensions::filters::network::postgres_proxy::v3alpha::PostgresProxy::SSLMode
       upstream_ssl_{
           envoy::extensions::filters::network::postgres_proxy::v3alpha::PostgresProxy::DISABLE};
+  bool message_boundaries_only_{false};
   Stats::Scope& scope_;
   PostgresProxyStats stats_;
 
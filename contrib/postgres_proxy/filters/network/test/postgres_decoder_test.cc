@@ -765,6 +765,110 @@ TEST_F(PostgresProxyDecoderTest, Linearize) {
   ASSERT_THAT(decoder_->state(), DecoderImpl::State::InSyncState);
 }
 
+// Fixture for decoders which only decode message boundaries.
+class PostgresProxyFramingDecoderTest : public ::testing::Test {
+public:
+  void createDecoder(bool sql_parsing) {
+    decoder_ = std::make_unique<DecoderImpl>(&callbacks_, true, sql_parsing);
+    decoder_->state(DecoderImpl::State::InSyncState);
+  }
+
+protected:
+  ::testing::NiceMock<DecoderCallbacksMock> callbacks_;
+  std::unique_ptr<DecoderImpl> decoder_;
+  Buffer::OwnedImpl data_;
+};
+
+// Messages are counted without inspecting their payload.
+TEST_F(PostgresProxyFramingDecoderTest, MessagesCounted) {
+  createDecoder(true);
+  EXPECT_CALL(callbacks_, incMessagesBackend()).Times(2);
+  EXPECT_CALL(callbacks_, incMessagesUnknown());
+  EXPECT_CALL(callbacks_, incStatements(testing::_)).Times(0);
+  EXPECT_CALL(callbacks_, incTransactions()).Times(0);
+
+  createPostgresMsg(data_, "C", "SELECT 1");
+  ASSERT_THAT(decoder_->onData(data_, false), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+
+  createPostgresMsg(data_, "=", "unknown");
+  ASSERT_THAT(decoder_->onData(data_, false), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+  ASSERT_THAT(decoder_->state(), DecoderImpl::State::InSyncState);
+}
+
+// The payload is drained as it arrives, without waiting for the whole message.
+TEST_F(PostgresProxyFramingDecoderTest, PartialPayload) {
+  createDecoder(true);
+  EXPECT_CALL(callbacks_, incMessagesBackend());
+  Buffer::OwnedImpl message;
+  createPostgresMsg(message, "D", std::string(100, 'a'));
+
+  data_.move(message, 10);
+  ASSERT_THAT(decoder_->onData(data_, false), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+  data_.move(message, 50);
+  ASSERT_THAT(decoder_->onData(data_, false), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+
+  // The rest of the payload is followed by the next message.
+  data_.move(message);
+  createPostgresMsg(message, "Z", "I");
+  data_.move(message);
+  EXPECT_CALL(callbacks_, incMessagesBackend());
+  ASSERT_THAT(decoder_->onData(data_, false), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 7);
+  ASSERT_THAT(decoder_->onData(data_, false), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+}
+
+// Queries are still read from Query and Parse messages when SQL parsing is enabled.
+TEST_F(PostgresProxyFramingDecoderTest, Queries) {
+  createDecoder(true);
+  const std::string query = "SELECT * FROM whatever;";
+  EXPECT_CALL(callbacks_, processQuery(query)).Times(2);
+
+  Buffer::OwnedImpl message;
+  createPostgresMsg(message, "Q", query);
+  data_.move(message, 10);
+  ASSERT_THAT(decoder_->onData(data_, true), Decoder::Result::NeedMoreData);
+  data_.move(message);
+  ASSERT_THAT(decoder_->onData(data_, true), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+
+  createPostgresMsg(data_, "P", std::string("P0_8\0", 5) + query + std::string("\0\0", 2));
+  ASSERT_THAT(decoder_->onData(data_, true), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+
+  // Parse messages without the query are skipped.
+  data_.add("P");
+  data_.writeBEInt<uint32_t>(8);
+  data_.add("P0_8");
+  ASSERT_THAT(decoder_->onData(data_, true), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+}
+
+TEST_F(PostgresProxyFramingDecoderTest, QueriesNotParsed) {
+  createDecoder(false);
+  EXPECT_CALL(callbacks_, processQuery(testing::_)).Times(0);
+  EXPECT_CALL(callbacks_, incMessagesFrontend());
+
+  Buffer::OwnedImpl message;
+  createPostgresMsg(message, "Q", "SELECT * FROM whatever;");
+  data_.move(message, 10);
+  ASSERT_THAT(decoder_->onData(data_, true), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(data_.length(), 0);
+}
+
+// A message length shorter than the length field loses the message boundaries.
+TEST_F(PostgresProxyFramingDecoderTest, InvalidLength) {
+  createDecoder(true);
+  data_.add("D");
+  data_.writeBEInt<uint32_t>(3);
+  ASSERT_THAT(decoder_->onData(data_, false), Decoder::Result::ReadyForNext);
+  ASSERT_THAT(decoder_->state(), DecoderImpl::State::OutOfSyncState);
+}
+
 } // namespace PostgresProxy
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -100,8 +100,9 @@ using ReservationSlicesOwnerPtr = std::unique_ptr<ReservationSlicesOwner>;
 /**
  * An interface for accounting for the usage for byte tracking in buffers.
  *
- * Currently this is only used by L7 streams to track the amount of memory
- * allocated in buffers by the stream.
+ * This is used by L7 streams to track the amount of memory allocated in
+ * buffers by the stream, and by connections to track the memory allocated in
+ * their read and write buffers.
  */
 class BufferMemoryAccount {
 public:
@@ -138,6 +139,19 @@ public:
 
 using BufferMemoryAccountSharedPtr = std::shared_ptr<BufferMemoryAccount>;
 
+/**
+ * Handler to close the connection whose buffers are charged to a buffer memory account.
+ */
+class ConnectionCloseHandler {
+public:
+  virtual ~ConnectionCloseHandler() = default;
+
+  /**
+   * Close the connection without flushing its pending data.
+   */
+  virtual void closeConnection() PURE;
+};
+
 /**
  * A basic buffer abstraction.
  */
@@ -316,6 +330,20 @@ public:
     return search(data, size, start, 0);
   }
 
+  /**
+   * Search for the first occurrence of any of several patterns within the buffer, in a single pass
+   * over the buffer.
+   * @param patterns supplies the patterns to search for. Nothing is found if any of them is empty.
+   * @param start supplies the starting index to search from.
+   * @param length limits the search to specified number of bytes starting from start index.
+   * When length value is zero, entire length of data from starting index to the end is searched.
+   * @param pattern_index is set to the index of the pattern found on a match. When several
+   * patterns start at the index of the match, the first of them in `patterns` is reported.
+   * @return the index where the match starts or -1 if there is no match.
+   */
+  virtual ssize_t searchAny(absl::Span<const absl::string_view> patterns, size_t start,
+                            size_t length, size_t& pattern_index) const PURE;
+
   /**
    * Search for an occurrence of data at the start of a buffer.
    * @param data supplies the data to search for.
@@ -554,6 +582,17 @@ public:
    */
   virtual BufferMemoryAccountSharedPtr createAccount(Http::StreamResetHandler& reset_handler) PURE;
 
+  /**
+   * Create and returns a buffer memory account for the buffers of a connection.
+   *
+   * @param close_handler supplies the handler the account will invoke to close
+   * the connection.
+   * @return a BufferMemoryAccountSharedPtr of the newly created account or
+   * nullptr if the tracking of connections is disabled.
+   */
+  virtual BufferMemoryAccountSharedPtr
+  createConnectionAccount(ConnectionCloseHandler& close_handler) PURE;
+
   /**
    * Goes through the tracked accounts, resetting the accounts and their
    * corresponding stream depending on the pressure.
@@ -563,6 +602,16 @@ public:
    * @return the number of streams reset
    */
   virtual uint64_t resetAccountsGivenPressure(float pressure) PURE;
+
+  /**
+   * Goes through the tracked connection accounts, closing the connections
+   * holding the most memory depending on the pressure.
+   *
+   * @param pressure scaled threshold pressure used to compute the buckets to
+   *  close internally.
+   * @return the number of connections closed
+   */
+  virtual uint64_t closeConnectionsGivenPressure(float pressure) PURE;
 };
 
 using WatermarkFactoryPtr = std::unique_ptr<WatermarkFactory>;
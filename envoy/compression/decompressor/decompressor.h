@@ -20,6 +20,20 @@ public:
    */
   virtual void decompress(const Buffer::Instance& input_buffer,
                           Buffer::Instance& output_buffer) PURE;
+
+  /**
+   * Decompresses data from the front of a buffer into another buffer, stopping once output_limit
+   * bytes have been output, so that highly compressed data can be decompressed in chunks of
+   * bounded size. The output is written directly into slices reserved in output_buffer.
+   * @param input_buffer supplies the buffer with compressed data. The data consumed is drained
+   *        from it, and the data left must be supplied first to the next call.
+   * @param output_buffer supplies the buffer to output decompressed data.
+   * @param output_limit supplies the largest number of bytes to output, which must not be zero.
+   * @return true if decompression stopped at output_limit, in which case more output may be
+   *         left even if input_buffer is empty, or false if all of input_buffer was consumed.
+   */
+  virtual bool decompressBounded(Buffer::Instance& input_buffer, Buffer::Instance& output_buffer,
+                                 uint64_t output_limit) PURE;
 };
 
 using DecompressorPtr = std::unique_ptr<Decompressor>;
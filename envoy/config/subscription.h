@@ -65,6 +65,12 @@ public:
    * @return optional ref<envoy::config::core::v3::Metadata> of a resource.
    */
   virtual const OptRef<const envoy::config::core::v3::Metadata> metadata() const PURE;
+
+  /**
+   * @return absl::optional<uint64_t> the MessageUtil::hash() of the resource, if it was computed
+   *         along with the decoding of the resource off the main thread.
+   */
+  virtual absl::optional<uint64_t> resourceHash() const { return absl::nullopt; }
 };
 
 using DecodedResourcePtr = std::unique_ptr<DecodedResource>;
@@ -87,6 +93,31 @@ public:
    *         the route config name for a envoy.config.route.v3.RouteConfiguration message.
    */
   virtual std::string resourceName(const Protobuf::Message& resource) PURE;
+
+  /**
+   * Decodes a resource like decodeResource(), except for the checks of the validation visitor
+   * (unknown and deprecated fields), so that it can be called from any thread. The checks are then
+   * done on the main thread by visitResource().
+   * @param resource some opaque resource (ProtobufWkt::Any).
+   * @return ProtobufTypes::MessagePtr decoded protobuf message in the opaque resource, or nullptr
+   *         if the resources can only be decoded on the main thread.
+   */
+  virtual ProtobufTypes::MessagePtr decodeResourceWithoutVisitor(const ProtobufWkt::Any&) {
+    return nullptr;
+  }
+
+  /**
+   * Runs the checks of the validation visitor on a resource returned by
+   * decodeResourceWithoutVisitor().
+   * @param resource the decoded resource.
+   */
+  virtual void visitResource(const Protobuf::Message&) {}
+
+  /**
+   * @return whether the resources decoded off the main thread should also be hashed there, for
+   *         subscribers comparing the resources with their previous hash.
+   */
+  virtual bool hashResources() const { return false; }
 };
 
 using OpaqueResourceDecoderSharedPtr = std::shared_ptr<OpaqueResourceDecoder>;
@@ -12,6 +12,7 @@
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Filesystem {
@@ -76,6 +77,15 @@ public:
    */
   virtual Api::IoCallSizeResult write(absl::string_view buffer) PURE;
 
+  /**
+   * Write the buffers to the file in order, with as few system calls as the platform allows. The
+   * file must be explicitly opened before writing.
+   *
+   * @return ssize_t number of bytes written, which is less than the total size of the buffers if
+   *         a write was partial, or -1 for failure
+   */
+  virtual Api::IoCallSizeResult writev(absl::Span<const absl::string_view> buffers) PURE;
+
   /**
    * Get additional details about the file. May or may not require a file system operation.
    *
@@ -33,6 +33,32 @@ public:
                              const Http::ResponseTrailerMap& response_trailers,
                              const StreamInfo::StreamInfo& stream_info,
                              absl::string_view local_reply_body) const PURE;
+
+  /**
+   * Append a formatted substitution line to a caller provided buffer, so that the buffer can be
+   * reused across lines.
+   * @param request_headers supplies the request headers.
+   * @param response_headers supplies the response headers.
+   * @param response_trailers supplies the response trailers.
+   * @param stream_info supplies the stream info.
+   * @param local_reply_body supplies the local reply body.
+   * @param output supplies the buffer the complete formatted substitution line is appended to.
+   */
+  virtual void formatTo(const Http::RequestHeaderMap& request_headers,
+                        const Http::ResponseHeaderMap& response_headers,
+                        const Http::ResponseTrailerMap& response_trailers,
+                        const StreamInfo::StreamInfo& stream_info,
+                        absl::string_view local_reply_body, std::string& output) const {
+    output.append(format(request_headers, response_headers, response_trailers, stream_info,
+                         local_reply_body));
+  }
+
+  /**
+   * @return absl::optional<std::string> the formatted substitution line when it is the same for
+   *         all headers/trailers/streams, so that callers can format it once at configuration
+   *         time. absl::nullopt when the line depends on the headers/trailers/stream.
+   */
+  virtual absl::optional<std::string> constantValue() const { return absl::nullopt; }
 };
 
 using FormatterPtr = std::unique_ptr<Formatter>;
@@ -61,6 +87,31 @@ public:
                                              const Http::ResponseTrailerMap& response_trailers,
                                              const StreamInfo::StreamInfo& stream_info,
                                              absl::string_view local_reply_body) const PURE;
+  /**
+   * Append a value extracted from the provided headers/trailers/stream to output. Providers on the
+   * hot path override this to save the allocation of the string returned by format().
+   * @param request_headers supplies the request headers.
+   * @param response_headers supplies the response headers.
+   * @param response_trailers supplies the response trailers.
+   * @param stream_info supplies the stream info.
+   * @param local_reply_body supplies the local reply body.
+   * @param output supplies the buffer the value is appended to. Nothing is appended when there is
+   *        no value.
+   * @return bool whether a value was extracted.
+   */
+  virtual bool formatTo(const Http::RequestHeaderMap& request_headers,
+                        const Http::ResponseHeaderMap& response_headers,
+                        const Http::ResponseTrailerMap& response_trailers,
+                        const StreamInfo::StreamInfo& stream_info,
+                        absl::string_view local_reply_body, std::string& output) const {
+    const absl::optional<std::string> value =
+        format(request_headers, response_headers, response_trailers, stream_info, local_reply_body);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
   /**
    * Extract a value from the provided headers/trailers/stream, preserving the value's type.
    * @param request_headers supplies the request headers.
@@ -76,6 +127,12 @@ public:
                                          const Http::ResponseTrailerMap& response_trailers,
                                          const StreamInfo::StreamInfo& stream_info,
                                          absl::string_view local_reply_body) const PURE;
+  /**
+   * @return absl::optional<std::string> the value extracted when it is the same for all
+   *         headers/trailers/streams and always present, so that formatters can extract it once.
+   *         absl::nullopt when the value depends on the headers/trailers/stream.
+   */
+  virtual absl::optional<std::string> constantValue() const { return absl::nullopt; }
 };
 
 using FormatterProviderPtr = std::unique_ptr<FormatterProvider>;
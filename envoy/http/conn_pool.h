@@ -5,6 +5,7 @@
 
 #include "envoy/common/conn_pool.h"
 #include "envoy/common/pure.h"
+#include "envoy/common/time.h"
 #include "envoy/event/deferred_deletable.h"
 #include "envoy/http/codec.h"
 #include "envoy/upstream/upstream.h"
@@ -85,6 +86,9 @@ public:
     bool can_send_early_data_;
     // True if the request can be sent over HTTP/3.
     bool can_use_http3_;
+    // If set, the time after which the request times out. Streams waiting for a connection are
+    // served earliest deadline first, and failed once their deadline has passed.
+    absl::optional<MonotonicTime> deadline_{};
   };
 
   ~Instance() override = default;
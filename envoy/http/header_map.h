@@ -302,6 +302,16 @@ private:
   DEFINE_INLINE_HEADER(name)                                                                       \
   virtual void set##name(uint64_t) PURE;
 
+/**
+ * Storage layout of the non-inline entries of a header map implementation.
+ */
+enum class HeaderMapLayout {
+  // Entries are nodes of a linked list.
+  LinkedList,
+  // Entries are kept in contiguous slots, ordered by a vector of pointers.
+  FlatVector,
+};
+
 /**
  * Wraps a set of HTTP headers.
  */
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
+
 #include "envoy/admin/v3/init_dump.pb.h"
 #include "envoy/common/pure.h"
+#include "envoy/common/time.h"
 #include "envoy/init/target.h"
 #include "envoy/init/watcher.h"
 
@@ -81,6 +85,20 @@ struct Manager {
    * Add unready targets information into the config dump.
    */
   virtual void dumpUnreadyTargets(envoy::admin::v3::UnreadyTargetsDumps& dumps) PURE;
+
+  /**
+   * Called when a target becomes ready, with the name of the target and the time it took since the
+   * manager started initializing it.
+   */
+  using TargetReadyCb =
+      std::function<void(absl::string_view target_name, std::chrono::milliseconds duration)>;
+
+  /**
+   * Measure how long each target takes to initialize. Must be called before `initialize`.
+   * @param time_source the time source to measure the targets with.
+   * @param cb the callback to notify when a target becomes ready.
+   */
+  virtual void trackTargetDurations(TimeSource& time_source, TargetReadyCb cb) PURE;
 };
 
 } // namespace Init
@@ -246,6 +246,12 @@ public:
   // TODO(snowp): Remove this in favor of StreamInfo::downstreamSslConnection.
   virtual Ssl::ConnectionInfoConstSharedPtr ssl() const PURE;
 
+  /**
+   * @return true if the transport socket of the connection reads and writes the payload to the
+   * socket as is. @see TransportSocket::forwardsPayloadUnchanged().
+   */
+  virtual bool forwardsPayloadUnchanged() const PURE;
+
   /**
    * @return requested server name (e.g. SNI in TLS), if any.
    */
@@ -261,6 +261,16 @@ public:
    * @return true if read filters were initialized successfully, otherwise false.
    */
   virtual bool initializeReadFilters() PURE;
+
+  /**
+   * @return the number of read filters installed, counting the combination filters.
+   */
+  virtual uint32_t numReadFilters() const PURE;
+
+  /**
+   * @return the number of write filters installed, counting the combination filters.
+   */
+  virtual uint32_t numWriteFilters() const PURE;
 };
 
 /**
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -30,6 +31,10 @@ class UdpListenerWorkerRouter;
 class ListenSocketFactory;
 using ListenSocketFactoryPtr = std::unique_ptr<ListenSocketFactory>;
 
+// By default, TCP listeners accept all the connections pending accept on each socket event.
+constexpr uint32_t DefaultMaxConnectionsToAcceptPerSocketEvent =
+    std::numeric_limits<uint32_t>::max();
+
 /**
  * ListenSocketFactory is a member of ListenConfig to provide listen socket.
  * Listeners created from the same ListenConfig instance have listening sockets
@@ -249,6 +254,13 @@ public:
    * limit.
    */
   virtual bool ignoreGlobalConnLimit() const PURE;
+
+  /**
+   * @return the maximum number of connections a TCP listener accepts per socket event. The
+   * connections left pending are accepted in later iterations of the event loop, after the other
+   * ready events.
+   */
+  virtual uint32_t maxConnectionsToAcceptPerSocketEvent() const PURE;
 };
 
 /**
@@ -267,11 +279,19 @@ public:
   enum class RejectCause {
     GlobalCxLimit,
     OverloadAction,
+    ListenerCxLimit,
   };
   /**
    * Called when a new connection is rejected.
    */
   virtual void onReject(RejectCause cause) PURE;
+
+  /**
+   * @return true if the listener reached its connection limit. The connections accepted while it
+   *         is are closed right away, before a socket is created for them, and reported with
+   *         RejectCause::ListenerCxLimit.
+   */
+  virtual bool listenerConnectionLimitReached() const PURE;
 };
 
 /**
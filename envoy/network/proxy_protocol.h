@@ -20,6 +20,8 @@ struct ProxyProtocolData {
   const Network::Address::InstanceConstSharedPtr src_addr_;
   const Network::Address::InstanceConstSharedPtr dst_addr_;
   const ProxyProtocolTLVVector tlv_vector_{};
+  // The PROXY protocol header as received, if the listener filter was configured to keep it.
+  const std::string original_header_{};
   std::string asStringForHash() const {
     return std::string(src_addr_ ? src_addr_->asString() : "null") +
            (dst_addr_ ? dst_addr_->asString() : "null");
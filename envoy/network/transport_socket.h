@@ -171,6 +171,13 @@ public:
    */
   virtual Ssl::ConnectionInfoConstSharedPtr ssl() const PURE;
 
+  /**
+   * @return true if the transport socket reads and writes the payload to the socket as is, without
+   * transforming or observing it, so that the payload may be moved to and from the socket without
+   * going through it, e.g. with splice(2).
+   */
+  virtual bool forwardsPayloadUnchanged() const { return false; }
+
   /**
    * Instructs a transport socket to start using secure transport.
    * It is up to the caller of this method to manage the coordination between the client
@@ -264,6 +271,14 @@ public:
    * that are marked as shared with the upstream connection.
    */
   virtual const StreamInfo::FilterState::Objects& downstreamSharedFilterStateObjects() const PURE;
+
+  /**
+   * @return the generic hash key of these options, as computed by
+   *         CommonUpstreamTransportSocketFactory::hashKey(), if the implementation computes it
+   *         ahead of time. Connection pools hash the options of every request they serve, so
+   *         immutable implementations can cache the key rather than hash their strings each time.
+   */
+  virtual OptRef<const std::vector<uint8_t>> precomputedHashKey() const { return {}; }
 };
 
 using TransportSocketOptionsConstSharedPtr = std::shared_ptr<const TransportSocketOptions>;
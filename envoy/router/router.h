@@ -125,6 +125,13 @@ public:
 class RouteSpecificFilterConfig {
 public:
   virtual ~RouteSpecificFilterConfig() = default;
+
+  /**
+   * @return whether the filter does nothing on the routes this config applies to. If so, and the
+   * envoy.reloadable_features.skip_route_disabled_http_filters runtime guard is enabled, the filter
+   * is not created for the streams that are first matched to these routes.
+   */
+  virtual bool disablesFilter() const { return false; }
 };
 using RouteSpecificFilterConfigConstSharedPtr = std::shared_ptr<const RouteSpecificFilterConfig>;
 
@@ -609,7 +616,7 @@ public:
 };
 
 class RateLimitPolicy;
-class Config;
+class CommonConfig;
 
 /**
  * Virtual host definition.
@@ -634,9 +641,11 @@ public:
   virtual const RateLimitPolicy& rateLimitPolicy() const PURE;
 
   /**
-   * @return const Config& the RouteConfiguration that owns this virtual host.
+   * @return const CommonConfig& the RouteConfiguration that owns this virtual host. Virtual hosts
+   * may be shared by successive versions of a RouteConfiguration, so only the settings common to
+   * these versions are exposed.
    */
-  virtual const Config& routeConfig() const PURE;
+  virtual const CommonConfig& routeConfig() const PURE;
 
   /**
    * @return bool whether to include the request count header in upstream requests.
@@ -686,6 +695,40 @@ public:
 /**
  * Route level hedging policy.
  */
+/**
+ * Tracks the recent response times of a route and the hedged requests sent for it, to hedge
+ * requests once they take longer than a percentile of the response times. The tracker is shared
+ * by the workers, so its methods are thread safe.
+ */
+class HedgeLatencyTracker {
+public:
+  virtual ~HedgeLatencyTracker() = default;
+
+  /**
+   * Called for each request of the route that may be hedged.
+   */
+  virtual void onRequest() PURE;
+
+  /**
+   * Records the response time of a request of the route.
+   * @param response_time the time from the end of the downstream request to the end of the
+   *        upstream response.
+   */
+  virtual void recordResponseTime(std::chrono::milliseconds response_time) PURE;
+
+  /**
+   * @return the configured percentile of the recent response times, or absl::nullopt if too few
+   *         response times were recorded to tell.
+   */
+  virtual absl::optional<std::chrono::milliseconds> hedgeDelay() const PURE;
+
+  /**
+   * Takes a hedged request out of the hedge budget of the route.
+   * @return false if the budget is used up, in which case the request must not be hedged.
+   */
+  virtual bool tryAcquireHedge() PURE;
+};
+
 class HedgePolicy {
 public:
   virtual ~HedgePolicy() = default;
@@ -707,6 +750,13 @@ public:
    * will be canceled immediately.
    */
   virtual bool hedgeOnPerTryTimeout() const PURE;
+
+  /**
+   * @return the tracker of the response times of the route, if hedged requests are sent once a
+   *         try takes longer than a percentile of the response times rather than after a fixed per
+   *         try timeout, or nullptr otherwise.
+   */
+  virtual HedgeLatencyTracker* latencyTracker() const PURE;
 };
 
 class MetadataMatchCriterion {
@@ -1270,10 +1320,48 @@ enum class RouteEvalStatus {
  */
 using RouteCallback = std::function<RouteMatchStatus(RouteConstSharedPtr, RouteEvalStatus)>;
 
+/**
+ * The settings of a RouteConfiguration that apply to all of its virtual hosts.
+ */
+class CommonConfig {
+public:
+  virtual ~CommonConfig() = default;
+
+  /**
+   * Return a list of headers that will be cleaned from any requests that are not from an internal
+   * (RFC1918) source.
+   */
+  virtual const std::list<Http::LowerCaseString>& internalOnlyHeaders() const PURE;
+
+  /**
+   * @return const std::string the RouteConfiguration name.
+   */
+  virtual const std::string& name() const PURE;
+
+  /**
+   * @return whether router configuration uses VHDS.
+   */
+  virtual bool usesVhds() const PURE;
+
+  /**
+   * @return bool whether most specific header mutations should take precedence. The default
+   * evaluation order is route level, then virtual host level and finally global connection
+   * manager level.
+   */
+  virtual bool mostSpecificHeaderMutationsWins() const PURE;
+
+  /**
+   * @return uint32_t The maximum bytes of the response direct response body size. The default value
+   * is 4096.
+   * TODO(dio): To allow overrides at different levels (e.g. per-route, virtual host, etc).
+   */
+  virtual uint32_t maxDirectResponseBodySizeBytes() const PURE;
+};
+
 /**
  * The router configuration.
  */
-class Config : public Rds::Config {
+class Config : public Rds::Config, public CommonConfig {
 public:
   /**
    * Based on the incoming HTTP request headers, determine the target route (containing either a
@@ -1305,36 +1393,6 @@ public:
   virtual RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                                     const StreamInfo::StreamInfo& stream_info,
                                     uint64_t random_value) const PURE;
-
-  /**
-   * Return a list of headers that will be cleaned from any requests that are not from an internal
-   * (RFC1918) source.
-   */
-  virtual const std::list<Http::LowerCaseString>& internalOnlyHeaders() const PURE;
-
-  /**
-   * @return const std::string the RouteConfiguration name.
-   */
-  virtual const std::string& name() const PURE;
-
-  /**
-   * @return whether router configuration uses VHDS.
-   */
-  virtual bool usesVhds() const PURE;
-
-  /**
-   * @return bool whether most specific header mutations should take precedence. The default
-   * evaluation order is route level, then virtual host level and finally global connection
-   * manager level.
-   */
-  virtual bool mostSpecificHeaderMutationsWins() const PURE;
-
-  /**
-   * @return uint32_t The maximum bytes of the response direct response body size. The default value
-   * is 4096.
-   * TODO(dio): To allow overrides at different levels (e.g. per-route, virtual host, etc).
-   */
-  virtual uint32_t maxDirectResponseBodySizeBytes() const PURE;
 };
 
 using ConfigConstSharedPtr = std::shared_ptr<const Config>;
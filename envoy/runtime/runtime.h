@@ -13,6 +13,7 @@
 #include "envoy/type/v3/percent.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/registered_key.h"
 #include "source/common/singleton/threadsafe_singleton.h"
 
 #include "absl/container/flat_hash_map.h"
@@ -201,6 +202,24 @@ public:
    */
   virtual bool getBoolean(absl::string_view key, bool default_value) const PURE;
 
+  /**
+   * Variants of the above reading a registered key, which the snapshot may look up once rather
+   * than for every read. They default to reading the key by name.
+   */
+  virtual bool featureEnabled(const RegisteredKey& key, uint64_t default_value) const {
+    return featureEnabled(key.name(), default_value);
+  }
+  virtual bool featureEnabled(const RegisteredKey& key, uint64_t default_value,
+                              uint64_t random_value) const {
+    return featureEnabled(key.name(), default_value, random_value);
+  }
+  virtual uint64_t getInteger(const RegisteredKey& key, uint64_t default_value) const {
+    return getInteger(key.name(), default_value);
+  }
+  virtual bool getBoolean(const RegisteredKey& key, bool default_value) const {
+    return getBoolean(key.name(), default_value);
+  }
+
   /**
    * Fetch the OverrideLayers that provide values in this snapshot. Layers are ordered from bottom
    * to top; for instance, the second layer's entries override the first layer's entries, and so on.
@@ -184,6 +184,12 @@ public:
    */
   virtual const std::string& logPath() const PURE;
 
+  /**
+   * @return the size in bytes of the per-thread buffers of the log lines written asynchronously,
+   *         or 0 if the log lines are written synchronously.
+   */
+  virtual uint64_t logAsyncBufferSize() const PURE;
+
   /**
    * @return the restart epoch. 0 indicates the first server start, 1 the second, and so on.
    */
@@ -240,6 +246,12 @@ public:
    */
   virtual bool cpusetThreadsEnabled() const PURE;
 
+  /**
+   * @return the CPUs the worker threads are pinned to. Worker i runs on CPU
+   *         workerCpus()[i % workerCpus().size()]. Empty if the workers aren't pinned.
+   */
+  virtual const std::vector<uint32_t>& workerCpus() const PURE;
+
   /**
    * @return the names of extensions to disable.
    */
@@ -267,6 +279,17 @@ public:
    */
   virtual const Stats::TagVector& statsTags() const PURE;
 
+  /**
+   * @return the path of the file in which to place the values of counters and gauges, or an empty
+   *         string to keep them in process memory.
+   */
+  virtual const std::string& statsSharedMemoryPath() const PURE;
+
+  /**
+   * @return the maximum number of stats placed in the shared memory file.
+   */
+  virtual uint32_t statsSharedMemoryMaxStats() const PURE;
+
   /**
    * @return the type of listener manager to create.
    */
@@ -37,6 +37,9 @@ public:
 
   // Overload action to reset streams using excessive memory.
   const std::string ResetStreams = "envoy.overload_actions.reset_high_memory_stream";
+
+  // Overload action to close connections using excessive memory.
+  const std::string CloseConnections = "envoy.overload_actions.close_high_memory_connections";
 };
 
 using OverloadActionNames = ConstSingleton<OverloadActionNameValues>;
@@ -48,6 +51,9 @@ class OverloadActionStatsNameValues {
 public:
   // Count of the number of streams the reset streams action has reset
   const std::string ResetStreamsCount = "envoy.overload_actions.reset_high_memory_stream.count";
+  // Count of the number of connections the close connections action has closed
+  const std::string CloseConnectionsCount =
+      "envoy.overload_actions.close_high_memory_connections.count";
 };
 
 using OverloadActionStatsNames = ConstSingleton<OverloadActionStatsNameValues>;
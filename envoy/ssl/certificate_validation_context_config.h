@@ -94,6 +94,13 @@ public:
    * @return the max depth used when verifying the certificate-chain
    */
   virtual absl::optional<uint32_t> maxVerifyDepth() const PURE;
+
+  /**
+   * @return the configuration of the asynchronous validation of the peer certificate chains, or
+   *         nullopt if they are validated by the worker threads.
+   */
+  virtual const absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>&
+  asyncValidation() const PURE;
 };
 
 using CertificateValidationContextConfigPtr = std::unique_ptr<CertificateValidationContextConfig>;
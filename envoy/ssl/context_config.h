@@ -6,7 +6,9 @@
 #include <string>
 #include <vector>
 
+#include "envoy/api/api.h"
 #include "envoy/common/pure.h"
+#include "envoy/extensions/transport_sockets/tls/v3/tls.pb.h"
 #include "envoy/ssl/certificate_validation_context_config.h"
 #include "envoy/ssl/handshaker.h"
 #include "envoy/ssl/tls_certificate_config.h"
@@ -107,10 +109,21 @@ public:
    */
   virtual const std::string& tlsKeyLogPath() const PURE;
 
+  /**
+   * @return true if the encryption of the data sent after the handshake is handed over to the
+   * kernel, when the connection allows it.
+   */
+  virtual bool kernelTlsTx() const PURE;
+
   /**
    * @return the access log manager object reference
    */
   virtual AccessLog::AccessLogManager& accessLogManager() const PURE;
+
+  /**
+   * @return a reference to the api object.
+   */
+  virtual Api::Api& api() const PURE;
 };
 
 class ClientContextConfig : public virtual ContextConfig {
@@ -185,6 +198,19 @@ public:
    */
   virtual bool disableStatelessSessionResumption() const PURE;
 
+  /**
+   * @return the maximum number of sessions which Envoy caches to resume them by their session ID,
+   *         or nullopt if BoringSSL caches them.
+   */
+  virtual absl::optional<uint32_t> maxCachedSessions() const PURE;
+
+  /**
+   * @return the configuration of the pool of threads performing the private key operations of the
+   *         handshakes, or nullopt if the workers perform them.
+   */
+  virtual const absl::optional<envoy::extensions::transport_sockets::tls::v3::HandshakeOffload>&
+  handshakeOffload() const PURE;
+
   /**
    * @return True if we allow full scan certificates when there is no cert matching SNI during
    * downstream TLS handshake, false otherwise.
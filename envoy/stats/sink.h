@@ -98,6 +98,13 @@ public:
    * @param value the value of the sample.
    */
   virtual void onHistogramComplete(const Histogram& histogram, uint64_t value) PURE;
+
+  /**
+   * @return whether the sink can be flushed with delta snapshots, which only contain the counters
+   * incremented, the gauges changed and the histograms recorded since the previous flush, along
+   * with all text readouts. Delta snapshots are only used if all sinks accept them.
+   */
+  virtual bool acceptsDeltaSnapshots() const { return false; }
 };
 
 using SinkPtr = std::unique_ptr<Sink>;
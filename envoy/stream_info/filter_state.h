@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "envoy/common/pure.h"
@@ -110,6 +112,22 @@ public:
   using Objects = std::vector<FilterObject>;
   using ObjectsPtr = std::unique_ptr<Objects>;
 
+  /**
+   * A data name registered at startup, see StreamInfo::FilterStateImpl::registerSlot(). The data
+   * stored under a registered name can be looked up by its slot without hashing the name.
+   */
+  class Slot {
+  public:
+    Slot(absl::string_view name, uint32_t index) : name_(name), index_(index) {}
+
+    const std::string& name() const { return name_; }
+    uint32_t index() const { return index_; }
+
+  private:
+    const std::string name_;
+    const uint32_t index_;
+  };
+
   virtual ~FilterState() = default;
 
   /**
@@ -145,6 +163,21 @@ public:
    */
   virtual const Object* getDataReadOnlyGeneric(absl::string_view data_name) const PURE;
 
+  /**
+   * @param slot the slot of the data being looked up (mutable/readonly).
+   * @return a typed pointer to the stored data or nullptr if the data does not exist or the data
+   * type does not match the expected type.
+   */
+  template <typename T> const T* getDataReadOnly(const Slot& slot) const {
+    return dynamic_cast<const T*>(getDataReadOnlyGeneric(slot));
+  }
+
+  /**
+   * @param slot the slot of the data being looked up (mutable/readonly).
+   * @return a const pointer to the stored data or nullptr if the data does not exist.
+   */
+  virtual const Object* getDataReadOnlyGeneric(const Slot& slot) const PURE;
+
   /**
    * @param data_name the name of the data being looked up (mutable/readonly).
    * @return a typed pointer to the stored data or nullptr if the data does not exist or the data
@@ -231,6 +231,8 @@ struct LocalCloseReasonValues {
       "closing_upstream_tcp_connection_due_to_downstream_local_close";
   const std::string NonPooledTcpConnectionHostHealthFailure =
       "non_pooled_tcp_connection_host_health_failure";
+  const std::string OverloadManagerCloseHighMemoryConnection =
+      "overload_manager_close_high_memory_connection";
 };
 
 using LocalCloseReasons = ConstSingleton<LocalCloseReasonValues>;
@@ -4,6 +4,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/common/pure.h"
 
@@ -56,6 +57,10 @@ using ThreadPtr = std::unique_ptr<Thread>;
 // Options specified during thread creation.
 struct Options {
   std::string name_; // A name supplied for the thread. On Linux this is limited to 15 chars.
+  // CPUs the thread is allowed to run on. Empty to inherit the affinity of the creating thread.
+  // Only supported on Linux, where the thread's memory is then first touched on the NUMA node of
+  // these CPUs.
+  std::vector<uint32_t> cpus_;
 };
 
 using OptionsOptConstRef = const absl::optional<Options>&;
@@ -247,6 +247,23 @@ public:
    * @return true if global threading has been shutdown or false if not.
    */
   virtual bool isShutdown() const PURE;
+
+  /**
+   * Starts coalescing the callbacks posted to the worker threads by the slots: until the matching
+   * endUpdateBatch(), set(), runOnAllThreads() and slot removals still run immediately on the main
+   * thread but their worker side is queued, and is posted as a single callback per worker at the
+   * end of the batch. The callbacks run on each worker in the order they were queued in. Batches
+   * can be nested, only the outermost one posts the queued callbacks. Must be called on the main
+   * thread.
+   */
+  virtual void beginUpdateBatch() PURE;
+
+  /**
+   * Ends a batch started by beginUpdateBatch(). Must be called on the main thread.
+   * @return uint64_t the number of posts saved by coalescing the queued callbacks, always 0 when
+   *         ending a nested batch.
+   */
+  virtual uint64_t endUpdateBatch() PURE;
 };
 
 } // namespace ThreadLocal
@@ -110,6 +110,17 @@ public:
   virtual SpanPtr startSpan(const Config& config, TraceContext& trace_conext,
                             const std::string& operation_name, SystemTime start_time,
                             const Tracing::Decision tracing_decision) PURE;
+
+  /**
+   * Propagates the trace context of a request that isn't traced, without creating a span: the
+   * propagation headers of the request are passed through as they are, and the driver adds the
+   * ones marking the request as not sampled if there are none.
+   * @param trace_context supplies the trace context of the request.
+   * @return true if the context was propagated, or false if the driver needs a span for the
+   *         request, for instance because its propagated context is sampled. startSpan() is then
+   *         called instead.
+   */
+  virtual bool propagateUntracedContext(TraceContext&) { return false; }
 };
 
 using DriverPtr = std::unique_ptr<Driver>;
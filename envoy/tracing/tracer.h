@@ -23,6 +23,11 @@ class Tracer {
 public:
   virtual ~Tracer() = default;
 
+  /**
+   * Starts the span of a request.
+   * @return the span, or nullptr if the request isn't traced and its trace context was propagated
+   *         without a span.
+   */
   virtual SpanPtr startSpan(const Config& config, TraceContext& trace_context,
                             const StreamInfo::StreamInfo& stream_info,
                             const Tracing::Decision tracing_decision) PURE;
@@ -219,10 +219,12 @@ public:
    *
    * @param cluster supplies the cluster configuration.
    * @param version_info supplies the xDS version of the cluster.
+   * @param hash supplies the MessageUtil::hash() of cluster, if it was already computed.
    * @return true if the action results in an add/update of a cluster.
    */
   virtual bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                                  const std::string& version_info) PURE;
+                                  const std::string& version_info,
+                                  absl::optional<uint64_t> hash = absl::nullopt) PURE;
 
   /**
    * Set a callback that will be invoked when all primary clusters have been initialized.
@@ -310,6 +312,15 @@ public:
    */
   virtual bool removeCluster(const std::string& cluster) PURE;
 
+  /**
+   * Coalesces the updates posted to the worker threads by many cluster additions, updates and
+   * removals, until the returned handle is destroyed. See
+   * ThreadLocal::Instance::beginUpdateBatch(). Must be called on the main thread.
+   *
+   * @return std::unique_ptr<Cleanup> ending the batch when destroyed.
+   */
+  virtual std::unique_ptr<Cleanup> batchThreadLocalUpdates() PURE;
+
   /**
    * Shutdown the cluster manager prior to destroying connection pools and other thread local data.
    */
@@ -26,8 +26,8 @@ using MetadataConstSharedPtr = std::shared_ptr<const envoy::config::core::v3::Me
  * All per host stats. @see stats_macros.h
  *
  * {rq_success, rq_error} have specific semantics driven by the needs of EDS load reporting. See
- * envoy.api.v2.endpoint.UpstreamLocalityStats for the definitions of success/error. These are
- * latched by LoadStatsReporter, independent of the normal stats sink flushing.
+ * envoy.api.v2.endpoint.UpstreamLocalityStats for the definitions of success/error. They are
+ * mirrored into the LocalityLoadStats of the host, which are what LoadStatsReporter reports.
  */
 #define ALL_HOST_STATS(COUNTER, GAUGE)                                                             \
   COUNTER(cx_connect_fail)                                                                         \
@@ -84,6 +84,42 @@ public:
   virtual StatMapPtr latch() PURE;
 };
 
+/**
+ * The request stats of the hosts of a locality of a cluster at one priority, aggregated on the
+ * request path so that load reports don't need to visit every host. The stats are updated along
+ * with the {rq_success, rq_error, rq_total, rq_active} HostStats of the hosts, with the same
+ * semantics.
+ */
+class LocalityLoadStats {
+public:
+  virtual ~LocalityLoadStats() = default;
+
+  struct LatchedStats {
+    uint64_t rq_success_{};
+    uint64_t rq_error_{};
+    uint64_t rq_total_{};
+    // The requests in progress, which are not cleared by latch().
+    uint64_t rq_active_{};
+  };
+
+  virtual void incRqSuccess() PURE;
+  virtual void incRqError() PURE;
+  virtual void incRqTotal() PURE;
+  virtual void incRqActive() PURE;
+  virtual void decRqActive() PURE;
+
+  /**
+   * @return the load metrics of the hosts of the locality.
+   */
+  virtual LoadMetricStats& loadMetricStats() PURE;
+
+  /**
+   * @return the counts of successful, failed and issued requests since the previous call, which
+   *         are cleared, and the count of requests in progress.
+   */
+  virtual LatchedStats latch() PURE;
+};
+
 class ClusterInfo;
 
 /**
@@ -167,10 +203,16 @@ public:
   virtual HostStats& stats() const PURE;
 
   /**
-   * @return custom stats for multi-dimensional load balancing.
+   * @return custom stats for multi-dimensional load balancing. These may be shared with the other
+   *         hosts of the same locality and priority.
    */
   virtual LoadMetricStats& loadMetricStats() const PURE;
 
+  /**
+   * @return the aggregated load report stats of the hosts of the locality and priority of the host.
+   */
+  virtual LocalityLoadStats& localityLoadStats() const PURE;
+
   /**
    * @return the locality of the host (deployment specific). This will be the default instance if
    *         unknown.
@@ -115,6 +115,13 @@ public:
    * elements in a list value defined in endpoint metadata.
    */
   virtual bool listAsAny() const PURE;
+
+  /*
+   * @return uint32_t the maximum number of subset load balancers to keep, which are then created
+   * when their subset is first selected, or 0 if the load balancers of all subsets are created
+   * with the subsets.
+   */
+  virtual uint32_t maxSubsetLoadBalancers() const PURE;
 };
 
 } // namespace Upstream
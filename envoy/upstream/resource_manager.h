@@ -4,8 +4,10 @@
 #include <cstdint>
 #include <memory>
 
+#include "envoy/common/optref.h"
 #include "envoy/common/pure.h"
 #include "envoy/common/resource.h"
+#include "envoy/common/time.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -31,6 +33,40 @@ private:
 
 using ResourceAutoIncDecPtr = std::unique_ptr<ResourceAutoIncDec>;
 
+/**
+ * A token bucket limiting the retries of a cluster to a share of its requests. The bucket is shared
+ * by all the workers.
+ */
+class RetryTokenBucket {
+public:
+  virtual ~RetryTokenBucket() = default;
+
+  /**
+   * Deposits the share of a token earned by a request which may be retried.
+   */
+  virtual void onRequest() PURE;
+
+  /**
+   * Records the outcome of an attempt of a request which may be retried.
+   * @param failed supplies whether the attempt failed in a way which may be retried.
+   */
+  virtual void onAttemptComplete(bool failed) PURE;
+
+  /**
+   * Withdraws the token of a retry.
+   * @param now supplies the current time, used to deposit the tokens accrued at the minimum retry
+   *        rate.
+   * @return bool whether there was a token to withdraw.
+   */
+  virtual bool tryWithdraw(MonotonicTime now) PURE;
+
+  /**
+   * @return double the factor to scale the backoff interval of retries by, which grows with the
+   *         share of the recent attempts which failed.
+   */
+  virtual double backoffMultiplier() const PURE;
+};
+
 /**
  * Global resource manager that loosely synchronizes maximum connections, pending requests, etc.
  * NOTE: Currently this is used on a per cluster basis. In the future we may consider also chaining
@@ -71,6 +107,11 @@ public:
    * @return uint64_t the max number of connections per host.
    */
   virtual uint64_t maxConnectionsPerHost() PURE;
+
+  /**
+   * @return OptRef<RetryTokenBucket> the retry token bucket, if one is configured.
+   */
+  virtual OptRef<RetryTokenBucket> retryTokenBucket() PURE;
 };
 
 } // namespace Upstream
@@ -29,6 +29,8 @@
 #include "envoy/upstream/resource_manager.h"
 #include "envoy/upstream/types.h"
 
+#include "source/common/stats/lazy_init.h"
+
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "fmt/format.h"
@@ -594,8 +596,10 @@ public:
   COUNTER(update_attempt)                                                                          \
   COUNTER(update_empty)                                                                            \
   COUNTER(update_failure)                                                                          \
+  COUNTER(update_merged)                                                                           \
   COUNTER(update_no_rebuild)                                                                       \
   COUNTER(update_success)                                                                          \
+  COUNTER(update_unchanged)                                                                        \
   GAUGE(version, NeverImport)
 
 /**
@@ -672,6 +676,7 @@ public:
   COUNTER(upstream_rq_max_duration_reached)                                                        \
   COUNTER(upstream_rq_pending_failure_eject)                                                       \
   COUNTER(upstream_rq_pending_overflow)                                                            \
+  COUNTER(upstream_rq_pending_shed)                                                                \
   COUNTER(upstream_rq_pending_total)                                                               \
   COUNTER(upstream_rq_0rtt)                                                                        \
   COUNTER(upstream_rq_per_try_timeout)                                                             \
@@ -682,6 +687,7 @@ public:
   COUNTER(upstream_rq_retry_limit_exceeded)                                                        \
   COUNTER(upstream_rq_retry_overflow)                                                              \
   COUNTER(upstream_rq_retry_success)                                                               \
+  COUNTER(upstream_rq_retry_token_bucket_exhausted)                                                \
   COUNTER(upstream_rq_rx_reset)                                                                    \
   COUNTER(upstream_rq_timeout)                                                                     \
   COUNTER(upstream_rq_total)                                                                       \
@@ -768,11 +774,11 @@ MAKE_STATS_STRUCT(ClusterLbStats, ClusterLbStatNames, ALL_CLUSTER_LB_STATS);
 MAKE_STAT_NAMES_STRUCT(ClusterTrafficStatNames, ALL_CLUSTER_TRAFFIC_STATS);
 MAKE_STATS_STRUCT(ClusterTrafficStats, ClusterTrafficStatNames, ALL_CLUSTER_TRAFFIC_STATS);
 /*
- * NOTE: LazyClusterTrafficStats for now is an alias of "std::unique_ptr<ClusterTrafficStats>",
- * this is to make way for future lazy-init on trafficStats(). See
- * https://github.com/envoyproxy/envoy/pull/23921#issuecomment-1335239116 for more context.
+ * The traffic stats are the bulk of the stats of a cluster, so they may be instantiated on first
+ * access. See https://github.com/envoyproxy/envoy/pull/23921#issuecomment-1335239116 for more
+ * context.
  */
-using LazyClusterTrafficStats = std::unique_ptr<ClusterTrafficStats>;
+using LazyClusterTrafficStats = Stats::LazyInit<ClusterTrafficStats, ClusterTrafficStatNames>;
 
 MAKE_STAT_NAMES_STRUCT(ClusterLoadReportStatNames, ALL_CLUSTER_LOAD_REPORT_STATS);
 MAKE_STATS_STRUCT(ClusterLoadReportStats, ClusterLoadReportStatNames,
@@ -1087,6 +1093,13 @@ public:
    */
   virtual ClusterLoadReportStats& loadReportStats() const PURE;
 
+  /**
+   * @return the load report stats shared by the hosts of the cluster in the given locality and
+   *         priority. The stats live as long as the cluster info.
+   */
+  virtual LocalityLoadStats& localityLoadStats(const envoy::config::core::v3::Locality& locality,
+                                               uint32_t priority) const PURE;
+
   /**
    * @return absl::optional<std::reference_wrapper<ClusterRequestResponseSizeStats>> stats to track
    * headers/body sizes of request/response for this cluster.
@@ -30,6 +30,15 @@ Buffer::InstancePtr toInternalData(envoy_data data) {
 
 envoy_data toBridgeData(Buffer::Instance& data, uint32_t max_bytes) {
   updateMaxBytes(max_bytes, data);
+  if (max_bytes != 0 && data.frontSlice().len_ == max_bytes) {
+    // The bytes are exactly the front slice: lend the slice instead of copying it. The slice is
+    // moved into a buffer of its own, which lives until the platform releases the envoy_data.
+    auto* lent_data = new Buffer::OwnedImpl();
+    lent_data->move(data, max_bytes);
+    return {static_cast<size_t>(max_bytes),
+            static_cast<const uint8_t*>(lent_data->frontSlice().mem_),
+            [](void* context) { delete static_cast<Buffer::OwnedImpl*>(context); }, lent_data};
+  }
   envoy_data bridge_data = copyToBridgeData(data, max_bytes);
   data.drain(bridge_data.length);
   return bridge_data;
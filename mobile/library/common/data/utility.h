@@ -16,7 +16,8 @@ namespace Utility {
 Buffer::InstancePtr toInternalData(envoy_data data);
 
 /**
- * Transform from Buffer::Instance to envoy_data.
+ * Transform from Buffer::Instance to envoy_data. The transformed bytes are drained from data. If
+ * they are a single slice of data, the slice is lent to the envoy_data rather than copied.
  * @param data, the Buffer::Instance to transform.
  * @param max_bytes, the maximum bytes to transform or 0 to copy all available data.
  * @return envoy_data, the bridge transformation of the Buffer::Instance param.
@@ -59,6 +59,41 @@ TEST(DataConstructorTest, FromCppToCPartial) {
   release_envoy_data(c_data);
 }
 
+TEST(DataConstructorTest, FromCppToCLendsSlice) {
+  std::string s = "test string";
+  Buffer::OwnedImpl cpp_data = Buffer::OwnedImpl(absl::string_view(s));
+  const void* slice_data = cpp_data.frontSlice().mem_;
+
+  envoy_data c_data = Utility::toBridgeData(cpp_data);
+
+  ASSERT_EQ(c_data.length, s.size());
+  ASSERT_EQ(c_data.bytes, slice_data);
+  ASSERT_EQ(Utility::copyToString(c_data), s);
+  ASSERT_EQ(cpp_data.length(), 0);
+  release_envoy_data(c_data);
+}
+
+TEST(DataConstructorTest, FromCppToCMultipleSlices) {
+  Buffer::OwnedImpl cpp_data;
+  cpp_data.appendSliceForTest("test ");
+  cpp_data.appendSliceForTest("string");
+
+  envoy_data c_data = Utility::toBridgeData(cpp_data);
+
+  ASSERT_EQ(c_data.length, 11);
+  ASSERT_EQ(Utility::copyToString(c_data), "test string");
+  ASSERT_EQ(cpp_data.length(), 0);
+  release_envoy_data(c_data);
+
+  cpp_data.appendSliceForTest("test ");
+  cpp_data.appendSliceForTest("string");
+  c_data = Utility::toBridgeData(cpp_data, 5);
+
+  ASSERT_EQ(Utility::copyToString(c_data), "test ");
+  ASSERT_EQ(cpp_data.toString(), "string");
+  release_envoy_data(c_data);
+}
+
 TEST(DataConstructorTest, CopyFromCppToC) {
   std::string s = "test string";
   Buffer::OwnedImpl cpp_data = Buffer::OwnedImpl(absl::string_view(s));
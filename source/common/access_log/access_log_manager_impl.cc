@@ -1,6 +1,8 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
 #include <string>
+#include <thread>
 
 #include "envoy/common/exception.h"
 
@@ -13,6 +15,73 @@
 namespace Envoy {
 namespace AccessLog {
 
+namespace {
+
+// The threads are numbered in the order they first write, so that each worker gets a write buffer
+// of its own as long as there are enough buffers.
+uint32_t writingThreadIndex() {
+  static std::atomic<uint32_t> next_thread_index{0};
+  static thread_local const uint32_t thread_index =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return thread_index;
+}
+
+} // namespace
+
+AccessLogFlushThread::~AccessLogFlushThread() {
+  {
+    Thread::LockGuard lock(wake_up_lock_);
+    flush_thread_exit_ = true;
+    flush_event_.notifyOne();
+  }
+
+  if (flush_thread_ != nullptr) {
+    flush_thread_->join();
+  }
+}
+
+void AccessLogFlushThread::addFile(AccessLogFileImpl& file) {
+  Thread::LockGuard lock(files_lock_);
+  files_.insert(&file);
+}
+
+void AccessLogFlushThread::removeFile(AccessLogFileImpl& file) {
+  Thread::LockGuard lock(files_lock_);
+  files_.erase(&file);
+}
+
+void AccessLogFlushThread::wakeUp() {
+  Thread::LockGuard lock(wake_up_lock_);
+  if (flush_thread_ == nullptr) {
+    flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
+                                                 Thread::Options{"AccessLogFlush"});
+  }
+  woken_up_ = true;
+  flush_event_.notifyOne();
+}
+
+void AccessLogFlushThread::flushThreadFunc() {
+  while (true) {
+    {
+      Thread::LockGuard lock(wake_up_lock_);
+      while (!woken_up_ && !flush_thread_exit_) {
+        // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
+        flush_event_.wait(wake_up_lock_);
+      }
+
+      if (flush_thread_exit_) {
+        return;
+      }
+      woken_up_ = false;
+    }
+
+    Thread::LockGuard lock(files_lock_);
+    for (AccessLogFileImpl* file : files_) {
+      file->flushIfRequested();
+    }
+  }
+}
+
 AccessLogManagerImpl::~AccessLogManagerImpl() {
   for (auto& [log_key, log_file_ptr] : access_logs_) {
     ENVOY_LOG(debug, "destroying access logger {}", log_key);
@@ -34,29 +103,35 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
   if (access_logs_.count(file_name)) {
     return access_logs_[file_name];
   }
+  if (flush_thread_ == nullptr) {
+    flush_thread_ = std::make_shared<AccessLogFlushThread>(api_.threadFactory());
+  }
   access_logs_[file_name] =
       std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
-                                          file_flush_interval_msec_, api_.threadFactory());
+                                          file_flush_interval_msec_, flush_thread_);
   return access_logs_[file_name];
 }
 
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
-                                     Thread::ThreadFactory& thread_factory)
-    : file_(std::move(file)), file_lock_(lock),
+                                     AccessLogFlushThreadSharedPtr flush_thread)
+    : file_(std::move(file)), file_lock_(lock), flush_thread_(std::move(flush_thread)),
+      write_buffer_count_(std::max(1U, std::thread::hardware_concurrency())),
+      write_buffers_(new WriteBuffer[write_buffer_count_]),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
-        flush_event_.notifyOne();
+        requestFlush();
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
-      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats) {
+      flush_interval_msec_(flush_interval_msec), stats_(stats) {
   flush_timer_->enableTimer(flush_interval_msec_);
   auto open_result = open();
   if (!open_result.return_value_) {
     throw EnvoyException(fmt::format("unable to open file '{}': {}", file_->path(),
                                      open_result.err_->getErrorDetails()));
   }
+  flush_thread_->addFile(*this);
 }
 
 Filesystem::FlagSet AccessLogFileImpl::defaultFlags() {
@@ -75,21 +150,12 @@ Api::IoCallBoolResult AccessLogFileImpl::open() {
 void AccessLogFileImpl::reopen() { reopen_file_ = true; }
 
 AccessLogFileImpl::~AccessLogFileImpl() {
-  {
-    Thread::LockGuard lock(write_lock_);
-    flush_thread_exit_ = true;
-    flush_event_.notifyOne();
-  }
-
-  if (flush_thread_ != nullptr) {
-    flush_thread_->join();
-  }
+  // Waits for the flush thread if it is flushing the file.
+  flush_thread_->removeFile(*this);
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
-    }
+    flush();
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
                                              result.err_->getErrorDetails()));
@@ -97,7 +163,15 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 }
 
 void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
+  if (buffer.length() == 0) {
+    return;
+  }
+
   Buffer::RawSliceVector slices = buffer.getRawSlices();
+  absl::FixedArray<absl::string_view> data(slices.size());
+  for (size_t i = 0; i < slices.size(); i++) {
+    data[i] = absl::string_view(static_cast<const char*>(slices[i].mem_), slices[i].len_);
+  }
 
   // We must do the actual writes to disk under lock, so that we don't intermix chunks from
   // different AccessLogFileImpl pointing to the same underlying file. This can happen either via
@@ -109,15 +183,12 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
   //            process lock or had multiple locks.
   {
     Thread::LockGuard lock(file_lock_);
-    for (const Buffer::RawSlice& slice : slices) {
-      absl::string_view data(static_cast<char*>(slice.mem_), slice.len_);
-      const Api::IoCallSizeResult result = file_->write(data);
-      if (result.ok() && result.return_value_ == static_cast<ssize_t>(slice.len_)) {
-        stats_.write_completed_.inc();
-      } else {
-        // Probably disk full.
-        stats_.write_failed_.inc();
-      }
+    const Api::IoCallSizeResult result = file_->writev(data);
+    if (result.ok() && result.return_value_ == static_cast<ssize_t>(buffer.length())) {
+      stats_.write_completed_.inc();
+    } else {
+      // Probably disk full.
+      stats_.write_failed_.inc();
     }
   }
 
@@ -125,91 +196,70 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
   buffer.drain(buffer.length());
 }
 
-void AccessLogFileImpl::flushThreadFunc() {
-
-  while (true) {
-    std::unique_lock<Thread::BasicLockable> flush_lock;
+void AccessLogFileImpl::collectWriteBuffers() {
+  for (uint32_t i = 0; i < write_buffer_count_; i++) {
+    WriteBuffer& write_buffer = write_buffers_[i];
+    Thread::LockGuard lock(write_buffer.lock_);
+    about_to_write_buffer_.move(write_buffer.buffer_);
+  }
+}
 
-    {
-      Thread::LockGuard write_lock(write_lock_);
+void AccessLogFileImpl::flushIfRequested() {
+  if (!flush_requested_.exchange(false)) {
+    return;
+  }
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
-        // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
-        flush_event_.wait(write_lock_);
-      }
+  Thread::LockGuard flush_lock(flush_lock_);
+  collectWriteBuffers();
 
-      if (flush_thread_exit_) {
-        return;
-      }
-
-      flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
+  if (reopen_file_) {
+    if (file_->isOpen()) {
+      const Api::IoCallBoolResult result = file_->close();
+      ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                               result.err_->getErrorDetails()));
     }
-
-    // if we failed to reopen before, do it next loop.
-    if (reopen_file_) {
-      if (file_->isOpen()) {
-        const Api::IoCallBoolResult result = file_->close();
-        ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
-                                                 result.err_->getErrorDetails()));
-      }
-      const Api::IoCallBoolResult open_result = open();
-      if (!open_result.return_value_) {
-        stats_.reopen_failed_.inc();
-      } else {
-        reopen_file_ = false;
-      }
+    const Api::IoCallBoolResult open_result = open();
+    if (!open_result.return_value_) {
+      stats_.reopen_failed_.inc();
+      // Retry on the next loop of the flush thread.
+      requestFlush();
+    } else {
+      reopen_file_ = false;
     }
-    // doWrite no matter file isOpen, if not, we can drain buffer
-    doWrite(about_to_write_buffer_);
   }
+  // doWrite no matter file isOpen, if not, we can drain buffer
+  doWrite(about_to_write_buffer_);
 }
 
 void AccessLogFileImpl::flush() {
-  std::unique_lock<Thread::BasicLockable> flush_buffer_lock;
-
-  {
-    Thread::LockGuard write_lock(write_lock_);
-
-    // flush_lock_ must be held while checking this or else it is
-    // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
-    // but has not yet completed doWrite(). This would allow flush() to
-    // return before the pending data has actually been written to disk.
-    flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-
-    if (flush_buffer_.length() == 0) {
-      return;
-    }
-
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
-  }
-
+  // flush_lock_ is held until the data has been written, so that flush() doesn't return while the
+  // flush thread is still writing data it collected before.
+  Thread::LockGuard flush_lock(flush_lock_);
+  collectWriteBuffers();
   doWrite(about_to_write_buffer_);
 }
 
 void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
-
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+  WriteBuffer& write_buffer = write_buffers_[writingThreadIndex() % write_buffer_count_];
+  bool flush_now;
+  {
+    Thread::LockGuard lock(write_buffer.lock_);
+    stats_.write_buffered_.inc();
+    stats_.write_total_buffered_.add(data.length());
+    write_buffer.buffer_.add(data.data(), data.size());
+    flush_now = write_buffer.buffer_.length() > MIN_FLUSH_SIZE;
   }
 
-  stats_.write_buffered_.inc();
-  stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
-    flush_event_.notifyOne();
+  // The first write is flushed right away rather than after the flush interval, so that a new file
+  // starts with it.
+  if (flush_now || (!written_.load(std::memory_order_relaxed) && !written_.exchange(true))) {
+    requestFlush();
   }
 }
 
-void AccessLogFileImpl::createFlushStructures() {
-  flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
-                                               Thread::Options{"AccessLogFlush"});
+void AccessLogFileImpl::requestFlush() {
+  flush_requested_ = true;
+  flush_thread_->wakeUp();
 }
 
 } // namespace AccessLog
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -13,6 +15,8 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 
+#include "absl/base/optimization.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/node_hash_map.h"
 
 namespace Envoy {
@@ -31,6 +35,45 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+class AccessLogFileImpl;
+
+/**
+ * The thread flushing all the access log files of a manager, so that the number of threads doesn't
+ * grow with the number of files.
+ */
+class AccessLogFlushThread {
+public:
+  explicit AccessLogFlushThread(Thread::ThreadFactory& thread_factory)
+      : thread_factory_(thread_factory) {}
+  ~AccessLogFlushThread();
+
+  void addFile(AccessLogFileImpl& file);
+  /**
+   * Removes a file, waiting for it to be flushed if it is being flushed.
+   */
+  void removeFile(AccessLogFileImpl& file);
+  /**
+   * Wakes the thread up to flush the files which requested it, starting the thread on first use.
+   */
+  void wakeUp();
+
+private:
+  void flushThreadFunc();
+
+  Thread::ThreadFactory& thread_factory_;
+  // Held while flushing the files, and always acquired before the locks of the files.
+  Thread::MutexBasicLockable files_lock_;
+  absl::flat_hash_set<AccessLogFileImpl*> files_ ABSL_GUARDED_BY(files_lock_);
+  // Only guards the wake up of the thread, so that waking it up never waits for a flush.
+  Thread::MutexBasicLockable wake_up_lock_;
+  Thread::CondVar flush_event_;
+  bool woken_up_ ABSL_GUARDED_BY(wake_up_lock_){};
+  bool flush_thread_exit_ ABSL_GUARDED_BY(wake_up_lock_){};
+  Thread::ThreadPtr flush_thread_ ABSL_GUARDED_BY(wake_up_lock_);
+};
+
+using AccessLogFlushThreadSharedPtr = std::shared_ptr<AccessLogFlushThread>;
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
@@ -52,22 +95,24 @@ private:
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
   AccessLogFileStats file_stats_;
+  // Shared with the files, which may outlive the manager.
+  AccessLogFlushThreadSharedPtr flush_thread_;
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
 /**
  * This is a file implementation geared for writing out access logs. It turn out that in certain
  * cases even if a standard file is opened with O_NONBLOCK, the kernel can still block when writing.
- * This implementation uses a flush thread per file, with the idea there aren't that many
- * files. If this turns out to be a good implementation we can potentially have a single flush
- * thread that flushes all files, but we will start with this.
+ * The writes are therefore buffered, and written to disk by the flush thread of the manager, which
+ * is shared by all the files. The writing threads buffer the data in buffers of their own, so that
+ * they don't contend with each other, and the order of the data of each thread is preserved.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
                     std::chrono::milliseconds flush_interval_msec,
-                    Thread::ThreadFactory& thread_factory);
+                    AccessLogFlushThreadSharedPtr flush_thread);
   ~AccessLogFileImpl() override;
 
   // AccessLog::AccessLogFile
@@ -81,24 +126,38 @@ public:
   void reopen() override;
   void flush() override;
 
+  /**
+   * Called by the flush thread to flush the file if it requested a flush.
+   */
+  void flushIfRequested();
+
 private:
+  // The buffer of the writing threads sharing an index, aligned so that the buffers of different
+  // threads don't share cache lines.
+  struct ABSL_CACHELINE_ALIGNED WriteBuffer {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
+  void requestFlush();
+  // Moves the data of all the write buffers to about_to_write_buffer_.
+  void collectWriteBuffers() ABSL_EXCLUSIVE_LOCKS_REQUIRED(flush_lock_);
   void doWrite(Buffer::Instance& buffer);
-  void flushThreadFunc();
   Api::IoCallBoolResult open();
-  void createFlushStructures();
 
   // return default flags set which used by open
   static Filesystem::FlagSet defaultFlags();
 
-  // Minimum size before the flush thread will be told to flush.
+  // Minimum size of a write buffer before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
 
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
-  //    1) write_lock_
+  //    1) the files lock of the flush thread
   //    2) flush_lock_
-  //    3) file_lock_
+  //    3) the locks of the write buffers
+  //    4) file_lock_
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -108,28 +167,18 @@ private:
                                           // concurrent access to the about_to_write_buffer_, fd_,
                                           // and all other data used during flushing and file
                                           // re-opening.
-  Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
-  Thread::ThreadPtr flush_thread_;
-  Thread::CondVar flush_event_;
-  std::atomic<bool> flush_thread_exit_{};
+  const AccessLogFlushThreadSharedPtr flush_thread_;
+  // Indexed by the index of the writing thread, modulo write_buffer_count_.
+  const uint32_t write_buffer_count_;
+  const std::unique_ptr<WriteBuffer[]> write_buffers_;
+  std::atomic<bool> flush_requested_{};
+  std::atomic<bool> written_{};
   std::atomic<bool> reopen_file_{};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
-  // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
-  // through the std::make_unique assignment. I do not believe it's possible to annotate this
-  // properly now due to limitations in the clang thread annotation analysis.
-  Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only by the flush thread. Data
-                                            // is moved from flush_buffer_ under lock, and then
-                                            // the lock is released so that flush_buffer_ can
-                                            // continue to fill. This buffer is then used for the
-                                            // final write to disk.
+  // This buffer is used only while flushing. Data is moved from the write buffers under their
+  // locks, which are then released so that the buffers can continue to fill. This buffer is then
+  // used for the final write to disk.
+  Buffer::OwnedImpl about_to_write_buffer_ ABSL_GUARDED_BY(flush_lock_);
   Event::TimerPtr flush_timer_;
-  Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
                                                         // matter if it reached the MIN_FLUSH_SIZE
                                                         // or not.
@@ -1,9 +1,11 @@
 #include "source/common/buffer/buffer_impl.h"
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 
+#include "source/common/buffer/pattern_scanner.h"
 #include "source/common/common/assert.h"
 
 #include "absl/container/fixed_array.h"
@@ -467,87 +469,119 @@ void OwnedImpl::commit(uint64_t length, absl::Span<RawSlice> slices,
   }
 }
 
+uint64_t OwnedImpl::searchEnd(size_t start, size_t length) const {
+  // length equal to zero means that entire buffer must be searched.
+  return length == 0 ? length_ : std::min<uint64_t>(length_, static_cast<uint64_t>(start) + length);
+}
+
+bool OwnedImpl::matchesAt(size_t slice_index, uint64_t offset, absl::string_view pattern) const {
+  for (; !pattern.empty(); slice_index++) {
+    if (slice_index == slices_.size()) {
+      return false;
+    }
+    const auto& slice = slices_[slice_index];
+    const uint64_t compared = std::min<uint64_t>(slice.dataSize() - offset, pattern.size());
+    if (compared > 0 && memcmp(slice.data() + offset, pattern.data(), compared) != 0) {
+      return false;
+    }
+    pattern.remove_prefix(compared);
+    offset = 0;
+  }
+  return true;
+}
+
 ssize_t OwnedImpl::search(const void* data, uint64_t size, size_t start, size_t length) const {
-  // This implementation uses the same search algorithm as evbuffer_search(), a naive
-  // scan that requires O(M*N) comparisons in the worst case.
-  // TODO(brian-pane): replace this with a more efficient search if it shows up
-  // prominently in CPU profiling.
   if (size == 0) {
     return (start <= length_) ? start : -1;
   }
 
-  // length equal to zero means that entire buffer must be searched.
-  // Adjust the length to buffer length taking the staring index into account.
-  size_t left_to_search = length;
-  if (0 == length) {
-    left_to_search = length_ - start;
-  }
-  ssize_t offset = 0;
-  const uint8_t* needle = static_cast<const uint8_t*>(data);
-  for (size_t slice_index = 0; slice_index < slices_.size() && (left_to_search > 0);
+  // Each slice is scanned with PatternScanner for the matches it holds entirely, then the last
+  // positions of the slice are compared one by one for the matches spanning the following slices.
+  const absl::string_view pattern(static_cast<const char*>(data), size);
+  const uint64_t end = searchEnd(start, length);
+  uint64_t slice_offset = 0;
+  for (size_t slice_index = 0; slice_index < slices_.size() && slice_offset < end;
        slice_index++) {
     const auto& slice = slices_[slice_index];
-    uint64_t slice_size = slice.dataSize();
-    if (slice_size <= start) {
-      start -= slice_size;
-      offset += slice_size;
+    const uint64_t slice_end = slice_offset + slice.dataSize();
+    if (slice_end <= start) {
+      slice_offset = slice_end;
       continue;
     }
-    const uint8_t* slice_start = slice.data();
-    const uint8_t* haystack = slice_start;
-    const uint8_t* haystack_end = haystack + slice_size;
-    haystack += start;
-    while (haystack < haystack_end) {
-      const size_t slice_search_limit =
-          std::min(static_cast<size_t>(haystack_end - haystack), left_to_search);
-      // Search within this slice for the first byte of the needle.
-      const uint8_t* first_byte_match =
-          static_cast<const uint8_t*>(memchr(haystack, needle[0], slice_search_limit));
-      if (first_byte_match == nullptr) {
-        left_to_search -= slice_search_limit;
+    const char* slice_data = reinterpret_cast<const char*>(slice.data());
+    const uint64_t from = std::max<uint64_t>(start, slice_offset);
+    const uint64_t scan_end = std::min(slice_end, end);
+    if (from + size <= scan_end) {
+      const size_t index = PatternScanner::find(
+          absl::string_view(slice_data + (from - slice_offset), scan_end - from), pattern);
+      if (index != absl::string_view::npos) {
+        return from + index;
+      }
+    }
+    for (uint64_t position = slice_end - std::min<uint64_t>(slice_end - from, size - 1);
+         position < slice_end && position + size <= end; position++) {
+      if (slice_data[position - slice_offset] == pattern[0] &&
+          matchesAt(slice_index, position - slice_offset, pattern)) {
+        return position;
+      }
+    }
+    slice_offset = slice_end;
+  }
+  return -1;
+}
+
+ssize_t OwnedImpl::searchAny(absl::Span<const absl::string_view> patterns, size_t start,
+                             size_t length, size_t& pattern_index) const {
+  // The buffer is scanned for the first bytes of the patterns, and the patterns starting with the
+  // byte found are compared at each of its occurrences.
+  std::string first_bytes;
+  uint64_t min_size = std::numeric_limits<uint64_t>::max();
+  for (const absl::string_view pattern : patterns) {
+    if (pattern.empty()) {
+      return -1;
+    }
+    if (first_bytes.find(pattern[0]) == std::string::npos) {
+      first_bytes.push_back(pattern[0]);
+    }
+    min_size = std::min<uint64_t>(min_size, pattern.size());
+  }
+  const uint64_t end = searchEnd(start, length);
+  if (patterns.empty() || min_size > end) {
+    return -1;
+  }
+
+  // No pattern fits in the range after last_start.
+  const uint64_t last_start = end - min_size;
+  uint64_t slice_offset = 0;
+  for (size_t slice_index = 0; slice_index < slices_.size() && slice_offset <= last_start;
+       slice_index++) {
+    const auto& slice = slices_[slice_index];
+    const uint64_t slice_end = slice_offset + slice.dataSize();
+    if (slice_end <= start) {
+      slice_offset = slice_end;
+      continue;
+    }
+    const char* slice_data = reinterpret_cast<const char*>(slice.data());
+    const uint64_t scan_end = std::min(slice_end, last_start + 1);
+    for (uint64_t position = std::max<uint64_t>(start, slice_offset); position < scan_end;
+         position++) {
+      const size_t index = PatternScanner::findFirstOf(
+          absl::string_view(slice_data + (position - slice_offset), scan_end - position),
+          first_bytes);
+      if (index == absl::string_view::npos) {
         break;
       }
-      // After finding a match for the first byte of the needle, check whether the following
-      // bytes in the buffer match the remainder of the needle. Note that the match can span
-      // two or more slices.
-      left_to_search -= static_cast<size_t>(first_byte_match - haystack + 1);
-      // Save the current number of bytes left to search.
-      // If the pattern is not found, the search will resume from the next byte
-      // and left_to_search value must be restored.
-      const size_t saved_left_to_search = left_to_search;
-      size_t i = 1;
-      size_t match_index = slice_index;
-      const uint8_t* match_next = first_byte_match + 1;
-      const uint8_t* match_end = haystack_end;
-      while ((i < size) && (0 < left_to_search)) {
-        if (match_next >= match_end) {
-          // We've hit the end of this slice, so continue checking against the next slice.
-          match_index++;
-          if (match_index == slices_.size()) {
-            // We've hit the end of the entire buffer.
-            break;
-          }
-          const auto& match_slice = slices_[match_index];
-          match_next = match_slice.data();
-          match_end = match_next + match_slice.dataSize();
-          continue;
+      position += index;
+      for (size_t i = 0; i < patterns.size(); i++) {
+        if (patterns[i][0] == slice_data[position - slice_offset] &&
+            position + patterns[i].size() <= end &&
+            matchesAt(slice_index, position - slice_offset, patterns[i])) {
+          pattern_index = i;
+          return position;
         }
-        left_to_search--;
-        if (*match_next++ != needle[i]) {
-          break;
-        }
-        i++;
-      }
-      if (i == size) {
-        // Successful match of the entire needle.
-        return offset + (first_byte_match - slice_start);
       }
-      // If this wasn't a successful match, start scanning again at the next byte.
-      haystack = first_byte_match + 1;
-      left_to_search = saved_left_to_search;
     }
-    start = 0;
-    offset += slice_size;
+    slice_offset = slice_end;
   }
   return -1;
 }
@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -55,7 +56,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(allocateStorage(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -111,6 +112,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseStorage();
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -129,7 +131,10 @@ public:
     return *this;
   }
 
-  ~Slice() { callAndClearDrainTrackersAndCharges(); }
+  ~Slice() {
+    callAndClearDrainTrackersAndCharges();
+    releaseStorage();
+  }
 
   /**
    * @return true if the data in the slice is mutable
@@ -369,10 +374,33 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {allocateStorage(slice_size), static_cast<size_t>(slice_size)};
+  }
+
+  /**
+   * Allocate backend storage of exactly `size` bytes, reusing storage from the current thread's
+   * SlicePool when possible.
+   * @param size the capacity of the storage; must be a multiple of the page size.
+   * @return the storage.
+   */
+  static StoragePtr allocateStorage(uint64_t size) {
+    StoragePtr storage = SlicePool::acquire(size);
+    if (storage == nullptr) {
+      storage.reset(new uint8_t[size]);
+    }
+    return storage;
   }
 
 protected:
+  /**
+   * Hand owned storage, if any, back to the current thread's SlicePool.
+   */
+  void releaseStorage() {
+    if (storage_ != nullptr) {
+      SlicePool::release(std::move(storage_), capacity_);
+    }
+  }
+
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
@@ -672,6 +700,8 @@ public:
   Reservation reserveForRead() override;
   ReservationSingleSlice reserveSingleSlice(uint64_t length, bool separate_slice = false) override;
   ssize_t search(const void* data, uint64_t size, size_t start, size_t length) const override;
+  ssize_t searchAny(absl::Span<const absl::string_view> patterns, size_t start, size_t length,
+                    size_t& pattern_index) const override;
   bool startsWith(absl::string_view data) const override;
   std::string toString() const override;
 
@@ -742,6 +772,18 @@ private:
   void addImpl(const void* data, uint64_t size);
   void drainImpl(uint64_t size);
 
+  /**
+   * @return the end of the range searched by search() and searchAny(), given their start and
+   *         length parameters.
+   */
+  uint64_t searchEnd(size_t start, size_t length) const;
+
+  /**
+   * @return whether the data starting at `offset` within the slice at `slice_index` matches
+   *         `pattern`, which may span the following slices.
+   */
+  bool matchesAt(size_t slice_index, uint64_t offset, absl::string_view pattern) const;
+
   /**
    * Moves contents of the `other_slice` by either taking its ownership or coalescing it
    * into an existing slice.
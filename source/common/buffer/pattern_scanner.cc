@@ -0,0 +1,248 @@
+#include "source/common/buffer/pattern_scanner.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "source/common/common/macros.h"
+
+namespace Envoy {
+namespace Buffer {
+
+namespace {
+
+constexpr size_t npos = absl::string_view::npos;
+
+// Looks for the first byte of the pattern with memchr(), which libc vectorizes, and compares the
+// rest of the pattern at each of its occurrences.
+size_t findFrom(absl::string_view haystack, absl::string_view pattern, size_t offset) {
+  const char* data = haystack.data();
+  const size_t size = pattern.size();
+  while (offset + size <= haystack.size()) {
+    const void* match = memchr(data + offset, pattern[0], haystack.size() - size + 1 - offset);
+    if (match == nullptr) {
+      return npos;
+    }
+    offset = static_cast<const char*>(match) - data;
+    if (memcmp(data + offset + 1, pattern.data() + 1, size - 1) == 0) {
+      return offset;
+    }
+    ++offset;
+  }
+  return npos;
+}
+
+size_t findFirstOfFrom(absl::string_view haystack, absl::string_view bytes, size_t offset) {
+  if (offset >= haystack.size()) {
+    return npos;
+  }
+  if (bytes.size() == 1) {
+    const void* match = memchr(haystack.data() + offset, bytes[0], haystack.size() - offset);
+    return match == nullptr ? npos : static_cast<const char*>(match) - haystack.data();
+  }
+  std::array<bool, 256> table{};
+  for (const char c : bytes) {
+    table[static_cast<uint8_t>(c)] = true;
+  }
+  for (; offset < haystack.size(); ++offset) {
+    if (table[static_cast<uint8_t>(haystack[offset])]) {
+      return offset;
+    }
+  }
+  return npos;
+}
+
+#if defined(ENVOY_SIMD_X86)
+
+size_t findSse2(absl::string_view haystack, absl::string_view pattern) {
+  const size_t size = pattern.size();
+  if (size == 1) {
+    return findFrom(haystack, pattern, 0);
+  }
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  const __m128i first = _mm_set1_epi8(pattern.front());
+  const __m128i last = _mm_set1_epi8(pattern.back());
+  size_t offset = 0;
+  // Each iteration checks the 16 positions starting at offset, whose last bytes end 16 bytes past
+  // offset + size - 1.
+  for (; offset + size - 1 + sizeof(__m128i) <= haystack.size(); offset += sizeof(__m128i)) {
+    const __m128i first_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    const __m128i last_bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + size - 1));
+    uint32_t mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(first_bytes, first), _mm_cmpeq_epi8(last_bytes, last)));
+    for (; mask != 0; mask &= mask - 1) {
+      const size_t candidate = offset + __builtin_ctz(mask);
+      if (memcmp(data + candidate + 1, pattern.data() + 1, size - 2) == 0) {
+        return candidate;
+      }
+    }
+  }
+  return findFrom(haystack, pattern, offset);
+}
+
+size_t findFirstOfSse2(absl::string_view haystack, absl::string_view bytes) {
+  if (bytes.size() == 1 || bytes.size() > PatternScanner::MaxVectorizedBytes) {
+    return findFirstOfFrom(haystack, bytes, 0);
+  }
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  __m128i sets[PatternScanner::MaxVectorizedBytes];
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    sets[i] = _mm_set1_epi8(bytes[i]);
+  }
+  size_t offset = 0;
+  for (; offset + sizeof(__m128i) <= haystack.size(); offset += sizeof(__m128i)) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    __m128i found = _mm_cmpeq_epi8(chars, sets[0]);
+    for (size_t i = 1; i < bytes.size(); ++i) {
+      found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, sets[i]));
+    }
+    const uint32_t mask = _mm_movemask_epi8(found);
+    if (mask != 0) {
+      return offset + __builtin_ctz(mask);
+    }
+  }
+  return findFirstOfFrom(haystack, bytes, offset);
+}
+
+__attribute__((target("avx2"))) size_t findAvx2(absl::string_view haystack,
+                                                 absl::string_view pattern) {
+  const size_t size = pattern.size();
+  if (size == 1) {
+    return findFrom(haystack, pattern, 0);
+  }
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  const __m256i first = _mm256_set1_epi8(pattern.front());
+  const __m256i last = _mm256_set1_epi8(pattern.back());
+  size_t offset = 0;
+  for (; offset + size - 1 + sizeof(__m256i) <= haystack.size(); offset += sizeof(__m256i)) {
+    const __m256i first_bytes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+    const __m256i last_bytes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + size - 1));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first_bytes, first),
+                                                          _mm256_cmpeq_epi8(last_bytes, last)));
+    for (; mask != 0; mask &= mask - 1) {
+      const size_t candidate = offset + __builtin_ctz(mask);
+      if (memcmp(data + candidate + 1, pattern.data() + 1, size - 2) == 0) {
+        _mm256_zeroupper();
+        return candidate;
+      }
+    }
+  }
+  _mm256_zeroupper();
+  const size_t index = findSse2(haystack.substr(offset), pattern);
+  return index == npos ? npos : offset + index;
+}
+
+__attribute__((target("avx2"))) size_t findFirstOfAvx2(absl::string_view haystack,
+                                                        absl::string_view bytes) {
+  if (bytes.size() == 1 || bytes.size() > PatternScanner::MaxVectorizedBytes) {
+    return findFirstOfFrom(haystack, bytes, 0);
+  }
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  __m256i sets[PatternScanner::MaxVectorizedBytes];
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    sets[i] = _mm256_set1_epi8(bytes[i]);
+  }
+  size_t offset = 0;
+  for (; offset + sizeof(__m256i) <= haystack.size(); offset += sizeof(__m256i)) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+    __m256i found = _mm256_cmpeq_epi8(chars, sets[0]);
+    for (size_t i = 1; i < bytes.size(); ++i) {
+      found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, sets[i]));
+    }
+    const uint32_t mask = _mm256_movemask_epi8(found);
+    if (mask != 0) {
+      _mm256_zeroupper();
+      return offset + __builtin_ctz(mask);
+    }
+  }
+  _mm256_zeroupper();
+  const size_t index = findFirstOfSse2(haystack.substr(offset), bytes);
+  return index == npos ? npos : offset + index;
+}
+
+#elif defined(ENVOY_SIMD_NEON)
+
+// Keeps the top bit of the 4 bits per byte of the narrowed comparison result.
+uint64_t matchMask(uint8x16_t matches) {
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0) &
+         0x8888888888888888ULL;
+}
+
+size_t findNeon(absl::string_view haystack, absl::string_view pattern) {
+  const size_t size = pattern.size();
+  if (size == 1) {
+    return findFrom(haystack, pattern, 0);
+  }
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  const uint8x16_t first = vdupq_n_u8(pattern.front());
+  const uint8x16_t last = vdupq_n_u8(pattern.back());
+  size_t offset = 0;
+  for (; offset + size - 1 + sizeof(uint8x16_t) <= haystack.size();
+       offset += sizeof(uint8x16_t)) {
+    const uint8x16_t matches = vandq_u8(vceqq_u8(vld1q_u8(data + offset), first),
+                                        vceqq_u8(vld1q_u8(data + offset + size - 1), last));
+    for (uint64_t mask = matchMask(matches); mask != 0; mask &= mask - 1) {
+      const size_t candidate = offset + (__builtin_ctzll(mask) >> 2);
+      if (memcmp(data + candidate + 1, pattern.data() + 1, size - 2) == 0) {
+        return candidate;
+      }
+    }
+  }
+  return findFrom(haystack, pattern, offset);
+}
+
+size_t findFirstOfNeon(absl::string_view haystack, absl::string_view bytes) {
+  if (bytes.size() == 1 || bytes.size() > PatternScanner::MaxVectorizedBytes) {
+    return findFirstOfFrom(haystack, bytes, 0);
+  }
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  uint8x16_t sets[PatternScanner::MaxVectorizedBytes];
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    sets[i] = vdupq_n_u8(bytes[i]);
+  }
+  size_t offset = 0;
+  for (; offset + sizeof(uint8x16_t) <= haystack.size(); offset += sizeof(uint8x16_t)) {
+    const uint8x16_t chars = vld1q_u8(data + offset);
+    uint8x16_t found = vceqq_u8(chars, sets[0]);
+    for (size_t i = 1; i < bytes.size(); ++i) {
+      found = vorrq_u8(found, vceqq_u8(chars, sets[i]));
+    }
+    const uint64_t mask = matchMask(found);
+    if (mask != 0) {
+      return offset + (__builtin_ctzll(mask) >> 2);
+    }
+  }
+  return findFirstOfFrom(haystack, bytes, offset);
+}
+
+#endif
+
+} // namespace
+
+size_t PatternScanner::findScalar(absl::string_view haystack, absl::string_view pattern) {
+  return findFrom(haystack, pattern, 0);
+}
+
+size_t PatternScanner::findFirstOfScalar(absl::string_view haystack, absl::string_view bytes) {
+  return findFirstOfFrom(haystack, bytes, 0);
+}
+
+const PatternScanner::Implementation& PatternScanner::get() {
+  CONSTRUCT_ON_FIRST_USE(Implementation, []() -> Implementation {
+    return Simd::select<Implementation>({
+#if defined(ENVOY_SIMD_X86)
+        {findAvx2, findFirstOfAvx2, Simd::InstructionSet::Avx2},
+        {findSse2, findFirstOfSse2, Simd::InstructionSet::Sse2},
+#elif defined(ENVOY_SIMD_NEON)
+        {findNeon, findFirstOfNeon, Simd::InstructionSet::Neon},
+#endif
+        {findScalar, findFirstOfScalar, Simd::InstructionSet::Scalar},
+    });
+  }());
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+
+#include "source/common/common/simd.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Search of byte patterns in contiguous memory, used by the searches of Buffer::OwnedImpl within
+ * each of its slices.
+ *
+ * The scans are vectorized with SSE2, AVX2 or NEON depending on the CPU Envoy runs on; the widest
+ * instruction set available is selected once at startup. find() filters the candidate positions
+ * on both the first and the last byte of the pattern, so that the positions only matching the
+ * first byte, which are frequent in text, are skipped 16 or 32 at a time without being compared.
+ */
+class PatternScanner {
+public:
+  // The largest number of bytes findFirstOf() compares with vector instructions, larger sets are
+  // looked up in a table byte after byte.
+  static constexpr size_t MaxVectorizedBytes = 16;
+
+  /**
+   * @return the offset of the first occurrence of `pattern`, which must not be empty, within
+   *         `haystack`, or absl::string_view::npos if there is none.
+   */
+  static size_t find(absl::string_view haystack, absl::string_view pattern) {
+    return get().find_(haystack, pattern);
+  }
+
+  /**
+   * @return the offset of the first byte of `haystack` that is one of `bytes`, which must be
+   *         distinct, or absl::string_view::npos if there is none.
+   */
+  static size_t findFirstOf(absl::string_view haystack, absl::string_view bytes) {
+    return get().find_first_of_(haystack, bytes);
+  }
+
+  /**
+   * Byte-at-a-time implementations of find() and findFirstOf(). Exposed for tests and benchmarks.
+   */
+  static size_t findScalar(absl::string_view haystack, absl::string_view pattern);
+  static size_t findFirstOfScalar(absl::string_view haystack, absl::string_view bytes);
+
+  /**
+   * @return the name of the implementation selected for this CPU, e.g. "avx2".
+   */
+  static absl::string_view implementationName() { return Simd::name(get().instruction_set_); }
+
+private:
+  using FindFn = size_t (*)(absl::string_view, absl::string_view);
+
+  struct Implementation {
+    FindFn find_;
+    FindFn find_first_of_;
+    Simd::InstructionSet instruction_set_;
+  };
+
+  static const Implementation& get();
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,108 @@
+#include "source/common/buffer/slice_pool.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+// Tracks the pools of all live threads so that stats() can sum them, and accumulates the counters
+// of pools whose threads have exited.
+struct PoolRegistry {
+  absl::Mutex mutex_;
+  absl::flat_hash_set<const void*> pools_ ABSL_GUARDED_BY(mutex_);
+  uint64_t retired_hits_ ABSL_GUARDED_BY(mutex_){};
+  uint64_t retired_misses_ ABSL_GUARDED_BY(mutex_){};
+};
+
+PoolRegistry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(PoolRegistry); }
+
+} // namespace
+
+std::atomic<uint64_t> SlicePool::max_bytes_per_thread_{0};
+std::atomic<uint64_t> SlicePool::generation_{0};
+thread_local bool SlicePool::thread_pool_destroyed_ = false;
+
+void SlicePool::setMaxBytesPerThread(uint64_t max_bytes) {
+  max_bytes_per_thread_.store(max_bytes, std::memory_order_relaxed);
+  // Make every thread drop what it holds so that a lowered limit is honored right away.
+  releaseAll();
+}
+
+SlicePoolStats SlicePool::stats() {
+  PoolRegistry& reg = registry();
+  absl::MutexLock lock(&reg.mutex_);
+  SlicePoolStats stats{reg.retired_hits_, reg.retired_misses_, 0};
+  for (const void* p : reg.pools_) {
+    const ThreadPool* pool = static_cast<const ThreadPool*>(p);
+    stats.hits_ += pool->hits_.load(std::memory_order_relaxed);
+    stats.misses_ += pool->misses_.load(std::memory_order_relaxed);
+    stats.bytes_held_ += pool->bytes_held_.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+SlicePool::ThreadPool::ThreadPool()
+    : generation_seen_(generation_.load(std::memory_order_relaxed)) {
+  PoolRegistry& reg = registry();
+  absl::MutexLock lock(&reg.mutex_);
+  reg.pools_.insert(this);
+}
+
+SlicePool::ThreadPool::~ThreadPool() {
+  thread_pool_destroyed_ = true;
+  clear();
+  PoolRegistry& reg = registry();
+  absl::MutexLock lock(&reg.mutex_);
+  reg.pools_.erase(this);
+  reg.retired_hits_ += hits_.load(std::memory_order_relaxed);
+  reg.retired_misses_ += misses_.load(std::memory_order_relaxed);
+}
+
+void SlicePool::ThreadPool::clear() {
+  for (auto& free_list : free_lists_) {
+    free_list.clear();
+  }
+  bytes_held_.store(0, std::memory_order_relaxed);
+}
+
+void SlicePool::ThreadPool::maybeClear() {
+  const uint64_t generation = generation_.load(std::memory_order_relaxed);
+  if (generation != generation_seen_) {
+    generation_seen_ = generation;
+    clear();
+  }
+}
+
+SlicePool::StoragePtr SlicePool::ThreadPool::acquireImpl(uint64_t size) {
+  maybeClear();
+  auto& free_list = free_lists_[size / PageSize - 1];
+  if (free_list.empty()) {
+    bump(misses_, 1);
+    return nullptr;
+  }
+  StoragePtr storage = std::move(free_list.back());
+  free_list.pop_back();
+  bump(hits_, 1);
+  bytes_held_.store(bytes_held_.load(std::memory_order_relaxed) - size, std::memory_order_relaxed);
+  return storage;
+}
+
+void SlicePool::ThreadPool::releaseImpl(StoragePtr&& storage, uint64_t size) {
+  ASSERT(storage != nullptr);
+  maybeClear();
+  if (bytes_held_.load(std::memory_order_relaxed) + size >
+      max_bytes_per_thread_.load(std::memory_order_relaxed)) {
+    storage.reset();
+    return;
+  }
+  free_lists_[size / PageSize - 1].push_back(std::move(storage));
+  bump(bytes_held_, size);
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Aggregated counters for the slice storage pools of all threads.
+ */
+struct SlicePoolStats {
+  // Number of storage requests satisfied from a pool.
+  uint64_t hits_{};
+  // Number of storage requests of a poolable size that required a heap allocation.
+  uint64_t misses_{};
+  // Number of bytes of free storage currently cached in pools.
+  uint64_t bytes_held_{};
+};
+
+/**
+ * A per-thread free list for the backing storage of owned buffer slices. Storage is pooled in
+ * 4KiB size classes up to 16KiB, which covers every slice allocated by OwnedImpl::add() for small
+ * writes as well as the default read reservation slices. Each thread holds at most
+ * maxBytesPerThread() bytes of free storage; anything beyond that is released to the heap.
+ *
+ * Pooling is disabled until setMaxBytesPerThread() is called with a non-zero value, in which case
+ * acquire() returns nullptr and release() frees the storage immediately.
+ */
+class SlicePool {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint64_t MaxPooledSize = 16384;
+
+  /**
+   * Set the per-thread limit of cached storage. A value of 0 disables pooling. Lowering the limit
+   * takes effect on each thread the next time it touches its pool.
+   */
+  static void setMaxBytesPerThread(uint64_t max_bytes);
+  static uint64_t maxBytesPerThread() {
+    return max_bytes_per_thread_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Ask every thread to return its cached storage to the heap. Threads observe the request the
+   * next time they acquire or release storage. Safe to call from any thread.
+   */
+  static void releaseAll() { generation_.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * @param size the capacity of the requested storage; must be a multiple of PageSize.
+   * @return cached storage of exactly `size` bytes, or nullptr if none is available and the caller
+   *         must allocate.
+   */
+  static StoragePtr acquire(uint64_t size) {
+    if (!poolable(size)) {
+      return nullptr;
+    }
+    ThreadPool* pool = threadPool();
+    return pool != nullptr ? pool->acquireImpl(size) : nullptr;
+  }
+
+  /**
+   * Return storage to the current thread's pool, or free it if it cannot be pooled.
+   * @param storage storage that was allocated with `new uint8_t[size]`.
+   * @param size the capacity of the storage.
+   */
+  static void release(StoragePtr&& storage, uint64_t size) {
+    if (!poolable(size)) {
+      storage.reset();
+      return;
+    }
+    ThreadPool* pool = threadPool();
+    if (pool == nullptr) {
+      storage.reset();
+      return;
+    }
+    pool->releaseImpl(std::move(storage), size);
+  }
+
+  /**
+   * @return counters summed over all threads, including threads that have exited.
+   */
+  static SlicePoolStats stats();
+
+private:
+  static constexpr uint32_t NumSizeClasses = MaxPooledSize / PageSize;
+
+  class ThreadPool {
+  public:
+    ThreadPool();
+    ~ThreadPool();
+
+    StoragePtr acquireImpl(uint64_t size);
+    void releaseImpl(StoragePtr&& storage, uint64_t size);
+    void clear();
+
+    // Only written by the owning thread; read by stats() from any thread.
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> bytes_held_{0};
+
+  private:
+    void maybeClear();
+    static void bump(std::atomic<uint64_t>& stat, uint64_t delta) {
+      stat.store(stat.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::array<std::vector<StoragePtr>, NumSizeClasses> free_lists_;
+    uint64_t generation_seen_;
+  };
+
+  static bool poolable(uint64_t size) {
+    return size != 0 && size <= MaxPooledSize && size % PageSize == 0 &&
+           max_bytes_per_thread_.load(std::memory_order_relaxed) != 0;
+  }
+
+  // Returns nullptr once the current thread's pool has been destroyed during thread exit, so that
+  // slices outliving it free their storage directly.
+  static ThreadPool* threadPool() {
+    if (thread_pool_destroyed_) {
+      return nullptr;
+    }
+    static thread_local ThreadPool pool;
+    return &pool;
+  }
+
+  static std::atomic<uint64_t> max_bytes_per_thread_;
+  static std::atomic<uint64_t> generation_;
+  static thread_local bool thread_pool_destroyed_;
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 
@@ -19,6 +20,8 @@ constexpr uint32_t kEffectivelyDisableTrackingBitshift = 63;
 // 50 is an arbitrary limit, and is meant to both limit the number of streams
 // Envoy ends up resetting and avoid triggering the Watchdog system.
 constexpr uint32_t kMaxNumberOfStreamsToResetPerInvocation = 50;
+// Same as above, for the number of connections Envoy ends up closing.
+constexpr uint32_t kMaxNumberOfConnectionsToClosePerInvocation = 50;
 } // end namespace
 
 void WatermarkBuffer::add(const void* data, uint64_t size) {
@@ -164,35 +167,52 @@ WatermarkBufferFactory::createAccount(Http::StreamResetHandler& reset_handler) {
   return BufferMemoryAccountImpl::createAccount(this, reset_handler);
 }
 
+BufferMemoryAccountSharedPtr
+WatermarkBufferFactory::createConnectionAccount(ConnectionCloseHandler& close_handler) {
+  if (bitshift_ == kEffectivelyDisableTrackingBitshift || !track_connections_) {
+    return nullptr; // No tracking
+  }
+  return BufferMemoryAccountImpl::createConnectionAccount(this, close_handler);
+}
+
+WatermarkBufferFactory::MemoryClassesToAccountsSet&
+WatermarkBufferFactory::accountSets(const BufferMemoryAccountSharedPtr& account) {
+  return static_cast<const BufferMemoryAccountImpl&>(*account).isConnectionAccount()
+             ? size_class_connection_account_sets_
+             : size_class_account_sets_;
+}
+
 void WatermarkBufferFactory::updateAccountClass(const BufferMemoryAccountSharedPtr& account,
                                                 absl::optional<uint32_t> current_class,
                                                 absl::optional<uint32_t> new_class) {
   ASSERT(current_class != new_class, "Expected the current_class and new_class to be different");
 
+  MemoryClassesToAccountsSet& size_class_account_sets = accountSets(account);
   if (!current_class.has_value()) {
     // Start tracking
     ASSERT(new_class.has_value());
-    ASSERT(!size_class_account_sets_[new_class.value()].contains(account));
-    size_class_account_sets_[new_class.value()].insert(account);
+    ASSERT(!size_class_account_sets[new_class.value()].contains(account));
+    size_class_account_sets[new_class.value()].insert(account);
   } else if (!new_class.has_value()) {
     // No longer track
     ASSERT(current_class.has_value());
-    ASSERT(size_class_account_sets_[current_class.value()].contains(account));
-    size_class_account_sets_[current_class.value()].erase(account);
+    ASSERT(size_class_account_sets[current_class.value()].contains(account));
+    size_class_account_sets[current_class.value()].erase(account);
   } else {
     // Moving between buckets
-    ASSERT(size_class_account_sets_[current_class.value()].contains(account));
-    ASSERT(!size_class_account_sets_[new_class.value()].contains(account));
-    size_class_account_sets_[new_class.value()].insert(
-        std::move(size_class_account_sets_[current_class.value()].extract(account).value()));
+    ASSERT(size_class_account_sets[current_class.value()].contains(account));
+    ASSERT(!size_class_account_sets[new_class.value()].contains(account));
+    size_class_account_sets[new_class.value()].insert(
+        std::move(size_class_account_sets[current_class.value()].extract(account).value()));
   }
 }
 
 void WatermarkBufferFactory::unregisterAccount(const BufferMemoryAccountSharedPtr& account,
                                                absl::optional<uint32_t> current_class) {
   if (current_class.has_value()) {
-    ASSERT(size_class_account_sets_[current_class.value()].contains(account));
-    size_class_account_sets_[current_class.value()].erase(account);
+    MemoryClassesToAccountsSet& size_class_account_sets = accountSets(account);
+    ASSERT(size_class_account_sets[current_class.value()].contains(account));
+    size_class_account_sets[current_class.value()].erase(account);
   }
 }
 
@@ -231,17 +251,59 @@ uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
   return num_streams_reset;
 }
 
+uint64_t WatermarkBufferFactory::closeConnectionsGivenPressure(float pressure) {
+  ASSERT(pressure >= 0.0 && pressure <= 1.0, "Provided pressure is out of range [0, 1].");
+
+  // Compute buckets to clear
+  const uint32_t buckets_to_clear = std::min<uint32_t>(
+      std::floor(pressure * BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_) + 1, 8);
+
+  // Pick the connections first, prioritizing the buckets with larger connections. Closing a
+  // connection can synchronously close others, e.g. the upstream connection it is proxied to,
+  // which unregisters their accounts.
+  std::vector<BufferMemoryAccountSharedPtr> accounts_to_close;
+  for (uint32_t buckets_cleared = 0; buckets_cleared < buckets_to_clear; ++buckets_cleared) {
+    const uint32_t bucket_to_clear =
+        BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_ - buckets_cleared - 1;
+    for (const BufferMemoryAccountSharedPtr& account :
+         size_class_connection_account_sets_[bucket_to_clear]) {
+      if (accounts_to_close.size() >= kMaxNumberOfConnectionsToClosePerInvocation) {
+        break;
+      }
+      accounts_to_close.push_back(account);
+    }
+  }
+  ENVOY_LOG_MISC(warn, "closing up to {} connections in buckets >= {}", accounts_to_close.size(),
+                 BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_ - buckets_to_clear);
+
+  uint32_t num_connections_closed = 0;
+  for (const BufferMemoryAccountSharedPtr& account : accounts_to_close) {
+    // Skip the connections closed meanwhile.
+    if (!static_cast<const BufferMemoryAccountImpl&>(*account).tracked()) {
+      continue;
+    }
+    account->resetDownstream();
+    ++num_connections_closed;
+  }
+  return num_connections_closed;
+}
+
 WatermarkBufferFactory::WatermarkBufferFactory(
     const envoy::config::overload::v3::BufferFactoryConfig& config)
     : bitshift_(config.minimum_account_to_track_power_of_two()
                     ? config.minimum_account_to_track_power_of_two() - 1
-                    : kEffectivelyDisableTrackingBitshift) {}
+                    : kEffectivelyDisableTrackingBitshift),
+      track_connections_(config.track_connections()) {}
 
 WatermarkBufferFactory::~WatermarkBufferFactory() {
   for (auto& account_set : size_class_account_sets_) {
     ASSERT(account_set.empty(),
            "Expected all Accounts to have unregistered from the Watermark Factory.");
   }
+  for (auto& account_set : size_class_connection_account_sets_) {
+    ASSERT(account_set.empty(),
+           "Expected all Accounts to have unregistered from the Watermark Factory.");
+  }
 }
 
 BufferMemoryAccountSharedPtr
@@ -257,6 +319,15 @@ BufferMemoryAccountImpl::createAccount(WatermarkBufferFactory* factory,
   return account;
 }
 
+BufferMemoryAccountSharedPtr
+BufferMemoryAccountImpl::createConnectionAccount(WatermarkBufferFactory* factory,
+                                                 ConnectionCloseHandler& close_handler) {
+  auto account =
+      std::shared_ptr<BufferMemoryAccount>(new BufferMemoryAccountImpl(factory, close_handler));
+  static_cast<BufferMemoryAccountImpl*>(account.get())->shared_this_ = account;
+  return account;
+}
+
 absl::optional<uint32_t> BufferMemoryAccountImpl::balanceToClassIndex() {
   const uint64_t shifted_balance = buffer_memory_allocated_ >> factory_->bitshift();
 
@@ -290,8 +361,9 @@ void BufferMemoryAccountImpl::charge(uint64_t amount) {
 }
 
 void BufferMemoryAccountImpl::clearDownstream() {
-  if (reset_handler_.has_value()) {
+  if (reset_handler_.has_value() || close_handler_.has_value()) {
     reset_handler_.reset();
+    close_handler_.reset();
     factory_->unregisterAccount(shared_this_, current_bucket_idx_);
     current_bucket_idx_.reset();
     shared_this_ = nullptr;
@@ -92,6 +92,8 @@ public:
   // and shared_this_.
   static BufferMemoryAccountSharedPtr createAccount(WatermarkBufferFactory* factory,
                                                     Http::StreamResetHandler& reset_handler);
+  static BufferMemoryAccountSharedPtr
+  createConnectionAccount(WatermarkBufferFactory* factory, ConnectionCloseHandler& close_handler);
   ~BufferMemoryAccountImpl() override {
     // The buffer_memory_allocated_ should always be zero on destruction, even
     // if we triggered a reset of the downstream. This is because the destructor
@@ -100,6 +102,7 @@ public:
     // account when they were deleted, maintaining this invariant.
     ASSERT(buffer_memory_allocated_ == 0);
     ASSERT(!reset_handler_.has_value());
+    ASSERT(!close_handler_.has_value());
   }
 
   // Make not copyable
@@ -111,6 +114,10 @@ public:
   BufferMemoryAccountImpl& operator=(BufferMemoryAccountImpl&&) = delete;
 
   uint64_t balance() const { return buffer_memory_allocated_; }
+  // Whether the account tracks the buffers of a connection rather than of a stream.
+  bool isConnectionAccount() const { return connection_account_; }
+  // Whether the account is tracked by the factory in one of the memory classes.
+  bool tracked() const { return current_bucket_idx_.has_value(); }
   void charge(uint64_t amount) override;
   void credit(uint64_t amount) override;
 
@@ -121,6 +128,8 @@ public:
   void resetDownstream() override {
     if (reset_handler_.has_value()) {
       reset_handler_->resetStream(Http::StreamResetReason::OverloadManager);
+    } else if (close_handler_.has_value()) {
+      close_handler_->closeConnection();
     }
   }
 
@@ -130,7 +139,9 @@ public:
 
 private:
   BufferMemoryAccountImpl(WatermarkBufferFactory* factory, Http::StreamResetHandler& reset_handler)
-      : factory_(factory), reset_handler_(reset_handler) {}
+      : factory_(factory), reset_handler_(reset_handler), connection_account_(false) {}
+  BufferMemoryAccountImpl(WatermarkBufferFactory* factory, ConnectionCloseHandler& close_handler)
+      : factory_(factory), close_handler_(close_handler), connection_account_(true) {}
 
   // Returns the class index based off of the buffer_memory_allocated_
   // This can differ with current_bucket_idx_ if buffer_memory_allocated_ was
@@ -145,7 +156,11 @@ private:
 
   WatermarkBufferFactory* factory_ = nullptr;
 
+  // Only one of the handlers is set, depending on whether the account tracks a stream or a
+  // connection.
   OptRef<Http::StreamResetHandler> reset_handler_;
+  OptRef<ConnectionCloseHandler> close_handler_;
+  const bool connection_account_;
   // Keep a copy of the shared_ptr pointing to this account. We opted to go this
   // route rather than enable_shared_from_this to avoid wasteful atomic
   // operations e.g. when updating the tracking of the account.
@@ -181,6 +196,9 @@ private:
  *    *BufferMemoryAccountImpl::balanceToClassIndex()* for details on the memory
  *    class for a given account balance.
  *
+ * If enabled, the accounts of connections are tracked with the same scheme,
+ * but in buckets of their own.
+ *
  * TODO(kbaichoo): Update this documentation when we make the minimum account
  * threshold configurable.
  *
@@ -199,7 +217,10 @@ public:
   }
 
   BufferMemoryAccountSharedPtr createAccount(Http::StreamResetHandler& reset_handler) override;
+  BufferMemoryAccountSharedPtr
+  createConnectionAccount(ConnectionCloseHandler& close_handler) override;
   uint64_t resetAccountsGivenPressure(float pressure) override;
+  uint64_t closeConnectionsGivenPressure(float pressure) override;
 
   // Called by BufferMemoryAccountImpls created by the factory on account class
   // updated.
@@ -218,9 +239,15 @@ protected:
   using MemoryClassesToAccountsSet = std::array<absl::flat_hash_set<BufferMemoryAccountSharedPtr>,
                                                 BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_>;
   MemoryClassesToAccountsSet size_class_account_sets_;
+  // The accounts of connections, tracked apart from the accounts of streams.
+  MemoryClassesToAccountsSet size_class_connection_account_sets_;
   // How much to bit shift right balances to test whether the account should be
   // tracked in *size_class_account_sets_*.
   const uint32_t bitshift_;
+  const bool track_connections_;
+
+private:
+  MemoryClassesToAccountsSet& accountSets(const BufferMemoryAccountSharedPtr& account);
 };
 
 } // namespace Buffer
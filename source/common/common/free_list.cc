@@ -0,0 +1,7 @@
+#include "source/common/common/free_list.h"
+
+namespace Envoy {
+
+std::atomic<uint64_t> ThreadLocalFreeLists::generation_{0};
+
+} // namespace Envoy
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Recycled blocks would hide the use after free and uninitialized reads of the pooled objects from
+// the sanitizers, which only see the allocations of the heap.
+#if defined(__SANITIZE_ADDRESS__)
+#define ENVOY_THREAD_LOCAL_FREE_LIST_DISABLED 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define ENVOY_THREAD_LOCAL_FREE_LIST_DISABLED 1
+#endif
+#endif
+
+namespace Envoy {
+
+/**
+ * The state shared by the free lists of all types.
+ */
+class ThreadLocalFreeLists {
+public:
+  /**
+   * Asks every thread to return the blocks of all its free lists to the heap. Threads observe the
+   * request the next time they allocate or free an object of the type of each list. Safe to call
+   * from any thread.
+   */
+  static void releaseAll() { generation_.fetch_add(1, std::memory_order_relaxed); }
+
+  static uint64_t generation() { return generation_.load(std::memory_order_relaxed); }
+
+private:
+  static std::atomic<uint64_t> generation_;
+};
+
+/**
+ * Recycles the storage of the objects of a single type on the thread that frees it, to spare the
+ * allocator the churn of objects that are created and destroyed at a high rate, like the streams
+ * of a worker. It is meant to back the class specific operator new and delete of T:
+ *
+ *   static void* operator new(size_t size) { return ThreadLocalFreeList<T, 64>::allocate(size); }
+ *   static void operator delete(void* ptr, size_t size) {
+ *     ThreadLocalFreeList<T, 64>::deallocate(ptr, size);
+ *   }
+ *
+ * Up to MaxFreeBlocks freed blocks are kept per thread. Objects may be freed by another thread
+ * than the one that allocated them, in which case their storage moves to the free list of that
+ * thread. Allocations of another size than sizeof(T), e.g. of subclasses, go straight to the heap.
+ * Every block comes from ::operator new, so the objects can also be freed with ::operator delete.
+ *
+ * The blocks aren't kept in sanitizer builds, where every allocation goes to the heap.
+ */
+template <class T, size_t MaxFreeBlocks> class ThreadLocalFreeList {
+public:
+  static void* allocate(size_t size) {
+#ifndef ENVOY_THREAD_LOCAL_FREE_LIST_DISABLED
+    if (size == sizeof(T)) {
+      std::vector<void*>& blocks = freeList().blocks();
+      if (!blocks.empty()) {
+        void* block = blocks.back();
+        blocks.pop_back();
+        return block;
+      }
+    }
+#endif
+    return ::operator new(size);
+  }
+
+  static void deallocate(void* ptr, size_t size) {
+#ifndef ENVOY_THREAD_LOCAL_FREE_LIST_DISABLED
+    if (size == sizeof(T)) {
+      std::vector<void*>& blocks = freeList().blocks();
+      if (blocks.size() < MaxFreeBlocks) {
+        blocks.push_back(ptr);
+        return;
+      }
+    }
+#else
+    static_cast<void>(size);
+#endif
+    ::operator delete(ptr);
+  }
+
+  /**
+   * @return the number of free blocks kept by the calling thread.
+   */
+  static size_t freeBlocks() { return freeList().blocks().size(); }
+
+private:
+  class FreeList {
+  public:
+    FreeList() : generation_seen_(ThreadLocalFreeLists::generation()) {
+      blocks_.reserve(MaxFreeBlocks);
+    }
+    ~FreeList() { clear(); }
+
+    // Returns the blocks, once those kept before the last ThreadLocalFreeLists::releaseAll() are
+    // released.
+    std::vector<void*>& blocks() {
+      const uint64_t generation = ThreadLocalFreeLists::generation();
+      if (generation != generation_seen_) {
+        generation_seen_ = generation;
+        clear();
+      }
+      return blocks_;
+    }
+
+  private:
+    void clear() {
+      for (void* block : blocks_) {
+        ::operator delete(block);
+      }
+      blocks_.clear();
+    }
+
+    std::vector<void*> blocks_;
+    uint64_t generation_seen_;
+  };
+
+  static FreeList& freeList() {
+    static thread_local FreeList free_list;
+    return free_list;
+  }
+};
+
+} // namespace Envoy
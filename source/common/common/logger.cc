@@ -77,22 +77,39 @@ void StderrSinkDelegate::flush() {
 }
 
 void DelegatingLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+  static std::atomic<uint64_t> next_formatter_version{1};
   absl::MutexLock lock(&format_mutex_);
   formatter_ = std::move(formatter);
+  formatter_version_.store(next_formatter_version.fetch_add(1), std::memory_order_release);
+}
+
+spdlog::formatter* DelegatingLogSink::threadFormatter() {
+  // The formatters aren't thread safe, so each thread formats with its own copy, rather than
+  // serializing the threads on the format mutex. The versions are unique across the sinks.
+  struct ThreadFormatter {
+    uint64_t version_{0};
+    std::unique_ptr<spdlog::formatter> formatter_;
+  };
+  static thread_local ThreadFormatter thread_formatter;
+  if (thread_formatter.version_ != formatter_version_.load(std::memory_order_acquire)) {
+    absl::MutexLock lock(&format_mutex_);
+    thread_formatter.formatter_ = formatter_ != nullptr ? formatter_->clone() : nullptr;
+    thread_formatter.version_ = formatter_version_.load(std::memory_order_relaxed);
+  }
+  return thread_formatter.formatter_.get();
 }
 
 void DelegatingLogSink::log(const spdlog::details::log_msg& msg) {
-  absl::ReleasableMutexLock lock(&format_mutex_);
   absl::string_view msg_view = absl::string_view(msg.payload.data(), msg.payload.size());
 
   // This memory buffer must exist in the scope of the entire function,
   // otherwise the string_view will refer to memory that is already free.
   spdlog::memory_buf_t formatted;
-  if (formatter_) {
-    formatter_->format(msg, formatted);
+  spdlog::formatter* formatter = threadFormatter();
+  if (formatter != nullptr) {
+    formatter->format(msg, formatted);
     msg_view = absl::string_view(formatted.data(), formatted.size());
   }
-  lock.Release();
 
   auto log_to_sink = [this, msg_view, msg](SinkDelegate& sink) {
     if (should_escape_) {
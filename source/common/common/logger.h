@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdint>
@@ -265,12 +266,16 @@ private:
   SinkDelegate** tlsSink();
   void setTlsDelegate(SinkDelegate* sink);
   SinkDelegate* tlsDelegate();
+  // The copy of the formatter of the calling thread, or nullptr if there is no formatter.
+  spdlog::formatter* threadFormatter();
 
   SinkDelegate* sink_ ABSL_GUARDED_BY(sink_mutex_){nullptr};
   absl::Mutex sink_mutex_;
   std::unique_ptr<StderrSinkDelegate> stderr_sink_; // Builtin sink to use as a last resort.
   std::unique_ptr<spdlog::formatter> formatter_ ABSL_GUARDED_BY(format_mutex_);
   absl::Mutex format_mutex_;
+  // Changed with the formatter, for the threads to renew their copy of it. 0 until it is set.
+  std::atomic<uint64_t> formatter_version_{0};
   bool should_escape_{false};
 };
 
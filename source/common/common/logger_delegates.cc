@@ -1,7 +1,9 @@
 #include "source/common/common/logger_delegates.h"
 
+#include <algorithm>
 #include <cassert> // use direct system-assert to avoid cyclic dependency.
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -9,6 +11,23 @@
 
 namespace Envoy {
 namespace Logger {
+
+namespace {
+
+uint64_t nextAsyncSinkDelegateId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Whether the calling thread is writing the buffered log lines, in which case the lines it logs
+// itself, e.g. when the write fails, are buffered and written on the next pass.
+bool& writingBufferedMessages() {
+  static thread_local bool writing = false;
+  return writing;
+}
+
+} // namespace
+
 FileSinkDelegate::FileSinkDelegate(const std::string& log_path,
                                    AccessLog::AccessLogManager& log_manager,
                                    DelegatingLogSinkSharedPtr log_sink)
@@ -31,5 +50,183 @@ void FileSinkDelegate::flush() {
   log_file_->flush();
 }
 
+/**
+ * The ring buffer of the log lines of a thread. It has a single producer, the thread, and a single
+ * consumer at a time, holding the write mutex of the delegate. The lines are stored as a header
+ * followed by the name of their logger and the formatted line, wrapping around the end.
+ */
+class AsyncSinkDelegate::Buffer {
+public:
+  explicit Buffer(uint64_t size) : data_(size) {}
+
+  bool push(spdlog::level::level_enum level, absl::string_view logger_name,
+            absl::string_view msg) {
+    const Header header{static_cast<uint32_t>(level), static_cast<uint32_t>(logger_name.size()),
+                        static_cast<uint32_t>(msg.size())};
+    const uint64_t size = sizeof(header) + logger_name.size() + msg.size();
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (size > data_.size() - (tail - head_.load(std::memory_order_acquire))) {
+      return false;
+    }
+    copyIn(tail, &header, sizeof(header));
+    copyIn(tail + sizeof(header), logger_name.data(), logger_name.size());
+    copyIn(tail + sizeof(header) + logger_name.size(), msg.data(), msg.size());
+    tail_.store(tail + size, std::memory_order_release);
+    return true;
+  }
+
+  template <class Callback> void popAll(Callback callback) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    while (head < tail) {
+      Header header;
+      copyOut(head, &header, sizeof(header));
+      logger_name_.resize(header.logger_name_size_);
+      copyOut(head + sizeof(header), logger_name_.data(), logger_name_.size());
+      msg_.resize(header.msg_size_);
+      copyOut(head + sizeof(header) + logger_name_.size(), msg_.data(), msg_.size());
+      head += sizeof(header) + logger_name_.size() + msg_.size();
+      // Hand the space back to the producer before writing the line.
+      head_.store(head, std::memory_order_release);
+      callback(static_cast<spdlog::level::level_enum>(header.level_), logger_name_, msg_);
+    }
+  }
+
+private:
+  struct Header {
+    uint32_t level_;
+    uint32_t logger_name_size_;
+    uint32_t msg_size_;
+  };
+
+  void copyIn(uint64_t position, const void* source, size_t size) {
+    const size_t offset = position % data_.size();
+    const size_t first = std::min(size, data_.size() - offset);
+    if (first > 0) {
+      memcpy(data_.data() + offset, source, first);
+    }
+    if (size > first) {
+      memcpy(data_.data(), static_cast<const char*>(source) + first, size - first);
+    }
+  }
+
+  void copyOut(uint64_t position, void* destination, size_t size) const {
+    const size_t offset = position % data_.size();
+    const size_t first = std::min(size, data_.size() - offset);
+    if (first > 0) {
+      memcpy(destination, data_.data() + offset, first);
+    }
+    if (size > first) {
+      memcpy(static_cast<char*>(destination) + first, data_.data(), size - first);
+    }
+  }
+
+  std::vector<char> data_;
+  // The positions of the oldest and past the newest lines, which only ever grow. The consumer
+  // writes head_ and the producer writes tail_, so they are on separate cache lines.
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  // Reused by the consumer to copy the lines out.
+  std::string logger_name_;
+  std::string msg_;
+};
+
+AsyncSinkDelegate::AsyncSinkDelegate(uint64_t buffer_bytes, Thread::ThreadFactory& thread_factory,
+                                     DelegatingLogSinkSharedPtr log_sink,
+                                     std::chrono::milliseconds write_interval)
+    : SinkDelegate(log_sink), buffer_bytes_(std::max<uint64_t>(buffer_bytes, 1)),
+      write_interval_(write_interval), id_(nextAsyncSinkDelegateId()) {
+  setDelegate();
+  sink_ = previousDelegate();
+  writer_ = thread_factory.createThread([this]() { writerLoop(); },
+                                        Thread::Options{"LogWriter"});
+}
+
+AsyncSinkDelegate::~AsyncSinkDelegate() {
+  // Stop taking log lines before writing the last ones.
+  restoreDelegate();
+  {
+    absl::MutexLock lock(&write_mutex_);
+    shutdown_ = true;
+  }
+  writer_->join();
+  absl::MutexLock lock(&write_mutex_);
+  writeBufferedMessages();
+  sink_->flush();
+}
+
+void AsyncSinkDelegate::log(absl::string_view msg, const spdlog::details::log_msg& log_msg) {
+  if (!threadBuffer().push(log_msg.level,
+                           absl::string_view(log_msg.logger_name.data(),
+                                             log_msg.logger_name.size()),
+                           msg)) {
+    dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void AsyncSinkDelegate::logWithStableName(absl::string_view stable_name, absl::string_view level,
+                                          absl::string_view component, absl::string_view msg) {
+  // The named logs are meant for sinks that intercept them, which are seldom used in production,
+  // so they are passed on synchronously.
+  sink_->logWithStableName(stable_name, level, component, msg);
+}
+
+void AsyncSinkDelegate::flush() {
+  if (writingBufferedMessages()) {
+    // A line logged while writing the buffered lines asked for a flush, which the pass in progress
+    // is going to do anyway.
+    return;
+  }
+  absl::MutexLock lock(&write_mutex_);
+  writeBufferedMessages();
+  sink_->flush();
+}
+
+AsyncSinkDelegate::Buffer& AsyncSinkDelegate::threadBuffer() {
+  // The buffers of the threads that exit stay registered until the delegate is destroyed, so that
+  // their last lines are written.
+  struct ThreadBuffer {
+    uint64_t owner_id_{0};
+    BufferSharedPtr buffer_;
+  };
+  static thread_local ThreadBuffer thread_buffer;
+  if (thread_buffer.owner_id_ != id_) {
+    thread_buffer.buffer_ = std::make_shared<Buffer>(buffer_bytes_);
+    thread_buffer.owner_id_ = id_;
+    absl::MutexLock lock(&buffers_mutex_);
+    buffers_.push_back(thread_buffer.buffer_);
+  }
+  return *thread_buffer.buffer_;
+}
+
+void AsyncSinkDelegate::writeBufferedMessages() {
+  std::vector<BufferSharedPtr> buffers;
+  {
+    absl::MutexLock lock(&buffers_mutex_);
+    buffers = buffers_;
+  }
+  writingBufferedMessages() = true;
+  for (const BufferSharedPtr& buffer : buffers) {
+    buffer->popAll([this](spdlog::level::level_enum level, absl::string_view logger_name,
+                          absl::string_view msg) {
+      // Only the formatted line is buffered, so it is also the payload of the message.
+      const spdlog::details::log_msg log_msg(
+          spdlog::string_view_t(logger_name.data(), logger_name.size()), level,
+          spdlog::string_view_t(msg.data(), msg.size()));
+      sink_->log(msg, log_msg);
+    });
+  }
+  writingBufferedMessages() = false;
+}
+
+void AsyncSinkDelegate::writerLoop() {
+  absl::MutexLock lock(&write_mutex_);
+  while (!shutdown_) {
+    write_mutex_.AwaitWithTimeout(absl::Condition(&shutdown_),
+                                  absl::Milliseconds(write_interval_.count()));
+    writeBufferedMessages();
+  }
+}
+
 } // namespace Logger
 } // namespace Envoy
@@ -1,15 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
+#include "envoy/thread/thread.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/common/macros.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Logger {
@@ -31,6 +36,56 @@ private:
   AccessLog::AccessLogFileSharedPtr log_file_;
 };
 
+/**
+ * SinkDelegate that hands the log lines over to a writer thread, which writes them to the
+ * delegate that was active before it. Each thread logs into its own lock-free ring buffer of
+ * buffer_bytes, so that the logging threads neither contend with one another nor wait for the
+ * writes. The lines logged while the buffer of their thread is full are dropped.
+ *
+ * Only one AsyncSinkDelegate is expected to be active at a time.
+ */
+class AsyncSinkDelegate : public SinkDelegate {
+public:
+  AsyncSinkDelegate(uint64_t buffer_bytes, Thread::ThreadFactory& thread_factory,
+                    DelegatingLogSinkSharedPtr log_sink,
+                    std::chrono::milliseconds write_interval = std::chrono::milliseconds(10));
+  ~AsyncSinkDelegate() override;
+
+  // SinkDelegate
+  void log(absl::string_view msg, const spdlog::details::log_msg& log_msg) override;
+  void logWithStableName(absl::string_view stable_name, absl::string_view level,
+                         absl::string_view component, absl::string_view msg) override;
+  // Writes the buffered lines of all the threads before flushing the previous delegate.
+  void flush() override;
+
+  /**
+   * @return the number of log lines dropped because the buffer of their thread was full.
+   */
+  uint64_t droppedMessages() const { return dropped_messages_.load(std::memory_order_relaxed); }
+
+private:
+  class Buffer;
+  using BufferSharedPtr = std::shared_ptr<Buffer>;
+
+  Buffer& threadBuffer();
+  void writeBufferedMessages() ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_mutex_);
+  void writerLoop();
+
+  const uint64_t buffer_bytes_;
+  const std::chrono::milliseconds write_interval_;
+  // Identifies the delegate in the thread local buffer cache, as its address may be reused.
+  const uint64_t id_;
+  // The delegate the lines are written to.
+  SinkDelegate* sink_{};
+  absl::Mutex buffers_mutex_;
+  std::vector<BufferSharedPtr> buffers_ ABSL_GUARDED_BY(buffers_mutex_);
+  // Serializes the consumers of the buffers: the writer thread and flush().
+  absl::Mutex write_mutex_;
+  bool shutdown_ ABSL_GUARDED_BY(write_mutex_){false};
+  std::atomic<uint64_t> dropped_messages_{0};
+  Thread::ThreadPtr writer_;
+};
+
 } // namespace Logger
 
 } // namespace Envoy
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <utility>
+
+#include "source/common/common/assert.h"
+
+#include "absl/container/node_hash_map.h"
+#include "absl/hash/hash.h"
+
+namespace Envoy {
+
+/**
+ * A hash map that keeps its entries ordered from the most to the least recently used, for the
+ * caches evicting their least recently used entries. The map only tracks the order: when and how
+ * many entries are evicted, e.g. beyond a number of entries or a byte budget, is up to the cache.
+ *
+ * Hash and Eq may be transparent, in which case the lookups accept the types they support.
+ * Pointers to the values stay valid until their entry is erased. The map isn't thread safe.
+ */
+template <class Key, class Value, class Hash = absl::Hash<Key>, class Eq = std::equal_to<Key>>
+class LruMap {
+public:
+  /**
+   * @return the value of key, now the most recently used, or nullptr if there is none.
+   */
+  template <class K> Value* get(const K& key) {
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return nullptr;
+    }
+    touch(it->second);
+    return &it->second.value_;
+  }
+
+  /**
+   * Inserts a default constructed value for key, unless there is one already.
+   * @return the value of key, now the most recently used, and whether it was inserted.
+   */
+  template <class K> std::pair<Value*, bool> getOrInsert(K&& key) {
+    auto [it, inserted] = map_.try_emplace(std::forward<K>(key));
+    if (inserted) {
+      lru_.push_front(&it->first);
+      it->second.lru_position_ = lru_.begin();
+    } else {
+      touch(it->second);
+    }
+    return {&it->second.value_, inserted};
+  }
+
+  /**
+   * Removes the entry of key, if any.
+   * @return whether there was one.
+   */
+  template <class K> bool erase(const K& key) {
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return false;
+    }
+    lru_.erase(it->second.lru_position_);
+    map_.erase(it);
+    return true;
+  }
+
+  /**
+   * @return the value of the least recently used entry. The map must not be empty.
+   */
+  Value& leastRecentlyUsed() {
+    ASSERT(!lru_.empty());
+    return map_.find(*lru_.back())->second.value_;
+  }
+
+  /**
+   * Removes the least recently used entry. The map must not be empty.
+   */
+  void eraseLeastRecentlyUsed() {
+    ASSERT(!lru_.empty());
+    map_.erase(*lru_.back());
+    lru_.pop_back();
+  }
+
+  void clear() {
+    lru_.clear();
+    map_.clear();
+  }
+
+  size_t size() const { return map_.size(); }
+  bool empty() const { return map_.empty(); }
+
+private:
+  struct Entry {
+    Value value_;
+    // The position of the key in lru_.
+    typename std::list<const Key*>::iterator lru_position_;
+  };
+
+  void touch(Entry& entry) { lru_.splice(lru_.begin(), lru_, entry.lru_position_); }
+
+  // A node map, so that lru_ can point to its keys.
+  absl::node_hash_map<Key, Entry, Hash, Eq> map_;
+  // The keys from the most to the least recently used.
+  std::list<const Key*> lru_;
+};
+
+} // namespace Envoy
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * An unbounded lock-free queue with multiple producers and a single consumer.
+ *
+ * Producers push each value in its own node onto an atomic stack with a compare-and-swap. The
+ * consumer takes the whole stack at once with an exchange and reverses it, so that the values are
+ * consumed in the order they were pushed. Since the consumer never takes nodes one at a time, it
+ * never races with the producers over a node, which keeps the queue free of the ABA problem.
+ */
+template <class T> class MpscQueue : NonCopyable {
+  struct Node {
+    Node* next_;
+    T value_;
+  };
+
+public:
+  /**
+   * The values taken from the queue by a call to popAll(), in the order they were pushed.
+   */
+  class Batch : NonCopyable {
+  public:
+    Batch(Batch&& other) noexcept : head_(std::exchange(other.head_, nullptr)) {}
+    ~Batch() {
+      while (!empty()) {
+        popFront();
+      }
+    }
+
+    bool empty() const { return head_ == nullptr; }
+    T& front() {
+      ASSERT(!empty());
+      return head_->value_;
+    }
+    // Destroys the front value.
+    void popFront() {
+      ASSERT(!empty());
+      Node* node = head_;
+      head_ = node->next_;
+      delete node;
+    }
+
+  private:
+    friend class MpscQueue;
+    explicit Batch(Node* head) : head_(head) {}
+
+    Node* head_;
+  };
+
+  ~MpscQueue() { popAll(); }
+
+  /**
+   * Pushes a value at the back of the queue. This may be called from any thread.
+   * @return true if the queue was empty, in which case the consumer may need to be woken up.
+   */
+  bool push(T value) {
+    Node* expected = head_.load(std::memory_order_relaxed);
+    Node* node = new Node{expected, std::move(value)};
+    // Publish the node, including its value, to the consumer. Once published the node may be
+    // taken, and freed, by the consumer at any time, so only the local copy of its next node is
+    // looked at afterwards.
+    while (!head_.compare_exchange_weak(expected, node, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+      node->next_ = expected;
+    }
+    return expected == nullptr;
+  }
+
+  /**
+   * Takes all the values pushed so far. This must only be called from the consumer thread.
+   */
+  Batch popAll() {
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+    Node* reversed = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next_;
+      node->next_ = reversed;
+      reversed = node;
+      node = next;
+    }
+    return Batch(reversed);
+  }
+
+  /**
+   * @return whether the queue is empty. Values may be pushed concurrently, so the result is only
+   * a snapshot.
+   */
+  bool empty() const { return head_.load(std::memory_order_acquire) == nullptr; }
+
+  /**
+   * @return the number of values in the queue, which is linear in that number. This must only be
+   * called from the consumer thread: the nodes are then not freed while they are counted.
+   */
+  size_t size() const {
+    size_t size = 0;
+    for (const Node* node = head_.load(std::memory_order_acquire); node != nullptr;
+         node = node->next_) {
+      ++size;
+    }
+    return size;
+  }
+
+private:
+  std::atomic<Node*> head_{nullptr};
+};
+
+} // namespace Envoy
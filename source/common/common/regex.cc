@@ -1,5 +1,7 @@
 #include "source/common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.validate.h"
@@ -8,20 +10,102 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/macros.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Regex {
 
-CompiledGoogleReMatcher::CompiledGoogleReMatcher(const std::string& regex,
-                                                 bool do_program_size_check)
-    : regex_(regex, re2::RE2::Quiet) {
+namespace {
+
+// The longest prefix of the values fully matched by regex, computed from the bounds of its
+// matches: the values between two strings share their common prefix.
+std::string literalPrefix(const re2::RE2& regex) {
+  std::string min;
+  std::string max;
+  if (!regex.PossibleMatchRange(&min, &max, 64)) {
+    return "";
+  }
+  const auto mismatch = std::mismatch(min.begin(), min.end(), max.begin(), max.end());
+  return std::string(min.begin(), mismatch.first);
+}
+
+class SharedRegexCacheImpl {
+public:
+  SharedRegexConstSharedPtr get(const std::string& pattern) {
+    {
+      absl::MutexLock lock(&mutex_);
+      auto it = regexes_.find(pattern);
+      if (it != regexes_.end()) {
+        SharedRegexConstSharedPtr regex = it->second.lock();
+        if (regex != nullptr) {
+          return regex;
+        }
+      }
+    }
+
+    // Compile the regex outside of the lock, as large regexes take a while. The deleter drops the
+    // regex from the cache, unless a thread already replaced it with a new one.
+    const SharedRegex* compiled = new SharedRegex(pattern);
+    SharedRegexConstSharedPtr regex(compiled, [this, pattern](const SharedRegex* regex) {
+      {
+        absl::MutexLock lock(&mutex_);
+        auto it = regexes_.find(pattern);
+        if (it != regexes_.end() && it->second.expired()) {
+          regexes_.erase(it);
+        }
+      }
+      delete regex;
+    });
+
+    // The lock is released before our regex is dropped, if another thread cached the same regex
+    // meanwhile.
+    absl::MutexLock lock(&mutex_);
+    std::weak_ptr<const SharedRegex>& entry = regexes_[pattern];
+    SharedRegexConstSharedPtr existing = entry.lock();
+    if (existing != nullptr) {
+      return existing;
+    }
+    entry = regex;
+    return regex;
+  }
+
+  size_t size() {
+    absl::MutexLock lock(&mutex_);
+    return regexes_.size();
+  }
+
+private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::weak_ptr<const SharedRegex>> regexes_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+SharedRegexCacheImpl& sharedRegexCache() { MUTABLE_CONSTRUCT_ON_FIRST_USE(SharedRegexCacheImpl); }
+
+} // namespace
+
+SharedRegex::SharedRegex(const std::string& pattern) : regex_(pattern, re2::RE2::Quiet) {
   if (!regex_.ok()) {
     throw EnvoyException(regex_.error());
   }
+  literal_prefix_ = literalPrefix(regex_);
+}
+
+SharedRegexConstSharedPtr SharedRegexCache::get(const std::string& pattern) {
+  return sharedRegexCache().get(pattern);
+}
 
+size_t SharedRegexCache::size() { return sharedRegexCache().size(); }
+
+CompiledGoogleReMatcher::CompiledGoogleReMatcher(const std::string& regex,
+                                                 bool do_program_size_check)
+    : regex_(SharedRegexCache::get(regex)) {
   if (do_program_size_check && Runtime::isRuntimeInitialized()) {
-    const uint32_t regex_program_size = static_cast<uint32_t>(regex_.ProgramSize());
+    const uint32_t regex_program_size = static_cast<uint32_t>(regex_->regex_.ProgramSize());
     const uint32_t max_program_size_error_level =
         Runtime::getInteger("re2.max_program_size.error_level", 100);
     if (regex_program_size > max_program_size_error_level) {
@@ -45,7 +129,7 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(const std::string& regex,
 CompiledGoogleReMatcher::CompiledGoogleReMatcher(
     const envoy::type::matcher::v3::RegexMatcher& config)
     : CompiledGoogleReMatcher(config.regex(), !config.google_re2().has_max_program_size()) {
-  const uint32_t regex_program_size = static_cast<uint32_t>(regex_.ProgramSize());
+  const uint32_t regex_program_size = static_cast<uint32_t>(regex_->regex_.ProgramSize());
 
   // Check if the deprecated field max_program_size is set first, and follow the old logic if so.
   if (config.google_re2().has_max_program_size()) {
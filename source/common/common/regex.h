@@ -12,12 +12,46 @@
 #include "source/common/singleton/threadsafe_singleton.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/strings/match.h"
 #include "re2/re2.h"
 #include "xds/type/matcher/v3/regex.pb.h"
 
 namespace Envoy {
 namespace Regex {
 
+/**
+ * A compiled RE2 regex, shared by the matchers of the same pattern.
+ */
+struct SharedRegex {
+  explicit SharedRegex(const std::string& pattern);
+
+  const re2::RE2 regex_;
+  // A prefix of all the values the regex fully matches, to reject the other values without running
+  // the regex. Empty if the regex doesn't have one.
+  std::string literal_prefix_;
+};
+
+using SharedRegexConstSharedPtr = std::shared_ptr<const SharedRegex>;
+
+/**
+ * A process-wide cache of the compiled regexes, so that the identical regexes of many routes or
+ * matchers are compiled and stored once. The regexes are refcounted, and leave the cache with their
+ * last matcher. The regexes are all compiled with the same options, so the pattern is the key.
+ */
+class SharedRegexCache {
+public:
+  /**
+   * @return the compiled regex of the pattern, compiling it if it isn't cached.
+   * @throw EnvoyException if the pattern is invalid.
+   */
+  static SharedRegexConstSharedPtr get(const std::string& pattern);
+
+  /**
+   * @return the number of cached regexes.
+   */
+  static size_t size();
+};
+
 class CompiledGoogleReMatcher : public CompiledMatcher {
 public:
   explicit CompiledGoogleReMatcher(const std::string& regex, bool do_program_size_check);
@@ -29,19 +63,26 @@ public:
 
   // CompiledMatcher
   bool match(absl::string_view value) const override {
-    return re2::RE2::FullMatch(re2::StringPiece(value.data(), value.size()), regex_);
+    // The values that don't start with the prefix common to all the matches are rejected without
+    // running the regex. The match doesn't extract any submatch, so RE2 can run its DFA.
+    if (!absl::StartsWith(value, regex_->literal_prefix_)) {
+      return false;
+    }
+    return re2::RE2::FullMatch(re2::StringPiece(value.data(), value.size()), regex_->regex_);
   }
 
   // CompiledMatcher
   std::string replaceAll(absl::string_view value, absl::string_view substitution) const override {
     std::string result = std::string(value);
-    re2::RE2::GlobalReplace(&result, regex_,
+    re2::RE2::GlobalReplace(&result, regex_->regex_,
                             re2::StringPiece(substitution.data(), substitution.size()));
     return result;
   }
 
+  const re2::RE2& regex() const { return regex_->regex_; }
+
 private:
-  const re2::RE2 regex_;
+  const SharedRegexConstSharedPtr regex_;
 };
 
 class GoogleReEngine : public Engine {
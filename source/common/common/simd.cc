@@ -0,0 +1,54 @@
+#include "source/common/common/simd.h"
+
+namespace Envoy {
+namespace Simd {
+
+bool supports(InstructionSet instruction_set) {
+  switch (instruction_set) {
+  case InstructionSet::Scalar:
+    return true;
+#if defined(ENVOY_SIMD_X86)
+  case InstructionSet::Sse2:
+    return true;
+  case InstructionSet::Ssse3:
+    return __builtin_cpu_supports("ssse3");
+  case InstructionSet::Avx2:
+    return __builtin_cpu_supports("avx2");
+  case InstructionSet::Neon:
+    return false;
+#elif defined(ENVOY_SIMD_NEON)
+  case InstructionSet::Sse2:
+  case InstructionSet::Ssse3:
+  case InstructionSet::Avx2:
+    return false;
+  case InstructionSet::Neon:
+    return true;
+#else
+  case InstructionSet::Sse2:
+  case InstructionSet::Ssse3:
+  case InstructionSet::Avx2:
+  case InstructionSet::Neon:
+    return false;
+#endif
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+absl::string_view name(InstructionSet instruction_set) {
+  switch (instruction_set) {
+  case InstructionSet::Scalar:
+    return "scalar";
+  case InstructionSet::Sse2:
+    return "sse2";
+  case InstructionSet::Ssse3:
+    return "ssse3";
+  case InstructionSet::Avx2:
+    return "avx2";
+  case InstructionSet::Neon:
+    return "neon";
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+} // namespace Simd
+} // namespace Envoy
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "source/common/common/assert.h"
+
+#include "absl/strings/string_view.h"
+
+// The vectorized scans are written with the x86 intrinsics of GCC and Clang, or with NEON on
+// AArch64. Other platforms only have the scalar implementations.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ENVOY_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define ENVOY_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Envoy {
+namespace Simd {
+
+/**
+ * The instruction sets the byte scans of Envoy are vectorized with. SSE2 and NEON are part of the
+ * x86-64 and AArch64 baselines, the others are detected on the CPU Envoy runs on.
+ *
+ * The implementations share a few conventions:
+ *   - The AVX2 implementations hand the remainder shorter than 32 bytes to their 16 byte one,
+ *     after clearing the upper halves of the registers with _mm256_zeroupper(), as the SSE
+ *     instructions of the 16 byte one would otherwise pay for the transition from AVX on every
+ *     call.
+ *   - NEON has no movemask, so the NEON implementations either narrow the comparison result to
+ *     4 bits per byte, or locate the matching byte of a vector with a scalar scan when matches
+ *     are rare.
+ */
+enum class InstructionSet : uint8_t { Scalar, Sse2, Ssse3, Avx2, Neon };
+
+/**
+ * @return true if the CPU Envoy runs on supports the instruction set.
+ */
+bool supports(InstructionSet instruction_set);
+
+/**
+ * @return the name of the instruction set, e.g. "avx2".
+ */
+absl::string_view name(InstructionSet instruction_set);
+
+/**
+ * Selects the implementation of a scan for the CPU Envoy runs on.
+ * @param candidates the implementations, each with an `instruction_set_` member, from the most to
+ *        the least preferred. The last one must be the scalar implementation.
+ * @return the first of the candidates whose instruction set is supported.
+ */
+template <class Implementation>
+Implementation select(std::initializer_list<Implementation> candidates) {
+  for (const Implementation& candidate : candidates) {
+    if (supports(candidate.instruction_set_)) {
+      return candidate;
+    }
+  }
+  PANIC("no scalar implementation");
+}
+
+} // namespace Simd
+} // namespace Envoy
@@ -1,6 +1,8 @@
 #include "source/common/common/token_bucket_impl.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 namespace Envoy {
 
@@ -51,4 +53,120 @@ void TokenBucketImpl::maybeReset(uint64_t num_tokens) {
   last_fill_ = time_source_.monotonicTime();
 }
 
+AtomicTokenBucketImpl::AtomicTokenBucketImpl(uint64_t max_tokens, TimeSource& time_source,
+                                             double fill_rate)
+    : max_tokens_(max_tokens), fill_rate_(std::abs(fill_rate)), time_source_(time_source),
+      // The bucket starts full.
+      time_in_seconds_(fill_rate_ > 0 ? timeNowInSeconds() - max_tokens_ / fill_rate_ : 0) {}
+
+uint64_t AtomicTokenBucketImpl::consume(uint64_t tokens, bool allow_partial) {
+  if (fill_rate_ == 0) {
+    return 0;
+  }
+  const double time_now = timeNowInSeconds();
+  double time_old = time_in_seconds_.load(std::memory_order_relaxed);
+  double time_new;
+  uint64_t consumed;
+  do {
+    // Another thread may have consumed at a later time than time_now.
+    const double available = std::clamp((time_now - time_old) * fill_rate_, 0.0, max_tokens_);
+    consumed = allow_partial ? std::min(tokens, static_cast<uint64_t>(std::floor(available)))
+                             : tokens;
+    if (consumed == 0 || consumed > available) {
+      return 0;
+    }
+    time_new = time_now - (available - consumed) / fill_rate_;
+  } while (!time_in_seconds_.compare_exchange_weak(time_old, time_new, std::memory_order_relaxed));
+  return consumed;
+}
+
+uint64_t AtomicTokenBucketImpl::consume(uint64_t tokens, bool allow_partial,
+                                        std::chrono::milliseconds& time_to_next_token) {
+  const uint64_t tokens_consumed = consume(tokens, allow_partial);
+  time_to_next_token = nextTokenAvailable();
+  return tokens_consumed;
+}
+
+std::chrono::milliseconds AtomicTokenBucketImpl::nextTokenAvailable() {
+  const double remaining = remainingTokens();
+  if (remaining >= 1) {
+    return std::chrono::milliseconds(0);
+  }
+  if (fill_rate_ == 0) {
+    return std::chrono::milliseconds::max();
+  }
+  return std::chrono::milliseconds(
+      static_cast<uint64_t>(std::ceil((1 - remaining) / fill_rate_ * 1000)));
+}
+
+void AtomicTokenBucketImpl::maybeReset(uint64_t num_tokens) {
+  ASSERT(num_tokens <= max_tokens_);
+  // Don't reset if reset once before.
+  if (reset_once_.exchange(true) || fill_rate_ == 0) {
+    return;
+  }
+  time_in_seconds_.store(timeNowInSeconds() - num_tokens / fill_rate_, std::memory_order_relaxed);
+}
+
+void AtomicTokenBucketImpl::returnTokens(uint64_t tokens) {
+  if (fill_rate_ == 0) {
+    return;
+  }
+  double time_old = time_in_seconds_.load(std::memory_order_relaxed);
+  while (!time_in_seconds_.compare_exchange_weak(time_old, time_old - tokens / fill_rate_,
+                                                 std::memory_order_relaxed)) {
+  }
+}
+
+double AtomicTokenBucketImpl::remainingTokens() const {
+  return std::clamp(
+      (timeNowInSeconds() - time_in_seconds_.load(std::memory_order_relaxed)) * fill_rate_, 0.0,
+      max_tokens_);
+}
+
+double AtomicTokenBucketImpl::timeNowInSeconds() const {
+  return std::chrono::duration<double>(time_source_.monotonicTime().time_since_epoch()).count();
+}
+
+HierarchicalTokenBucketImpl::HierarchicalTokenBucketImpl(
+    std::vector<AtomicTokenBucketImplSharedPtr> buckets, std::chrono::milliseconds fill_interval)
+    : buckets_(std::move(buckets)), fill_interval_(fill_interval) {
+  ASSERT(!buckets_.empty());
+}
+
+uint64_t HierarchicalTokenBucketImpl::consume(uint64_t tokens, bool allow_partial) {
+  for (size_t i = 0; i < buckets_.size() && tokens > 0; i++) {
+    const uint64_t consumed = buckets_[i]->consume(tokens, allow_partial);
+    if (consumed < tokens) {
+      for (size_t j = 0; j < i; j++) {
+        buckets_[j]->returnTokens(tokens - consumed);
+      }
+      tokens = consumed;
+    }
+  }
+  return tokens;
+}
+
+uint64_t HierarchicalTokenBucketImpl::consume(uint64_t tokens, bool allow_partial,
+                                              std::chrono::milliseconds& time_to_next_token) {
+  const uint64_t tokens_consumed = consume(tokens, allow_partial);
+  time_to_next_token = nextTokenAvailable();
+  return tokens_consumed;
+}
+
+std::chrono::milliseconds HierarchicalTokenBucketImpl::nextTokenAvailable() {
+  std::chrono::milliseconds next_token_available(0);
+  for (const AtomicTokenBucketImplSharedPtr& bucket : buckets_) {
+    next_token_available = std::max(next_token_available, bucket->nextTokenAvailable());
+  }
+  return next_token_available;
+}
+
+void HierarchicalTokenBucketImpl::maybeReset(uint64_t) {
+  for (const AtomicTokenBucketImplSharedPtr& bucket : buckets_) {
+    bucket->maybeReset(
+        static_cast<uint64_t>(bucket->fillRate() * fill_interval_.count() / 1000));
+  }
+}
+
 } // namespace Envoy
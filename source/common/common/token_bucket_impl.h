@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
 #include "envoy/common/time.h"
 #include "envoy/common/token_bucket.h"
 
@@ -35,4 +40,85 @@ private:
   TimeSource& time_source_;
 };
 
+/**
+ * A thread-safe implementation of the token bucket interface which doesn't take any lock, so that
+ * it can be shared by all the workers. The tokens are not stored but derived from a single atomic
+ * time, the time at which the bucket was empty: the bucket holds (now - time) * fill_rate tokens,
+ * up to max_tokens. Consuming moves that time forward with a compare and swap.
+ */
+class AtomicTokenBucketImpl : public TokenBucket {
+public:
+  /**
+   * @param max_tokens supplies the maximum number of tokens in the bucket.
+   * @param time_source supplies the time source.
+   * @param fill_rate supplies the number of tokens that will return to the bucket on each second.
+   * The default is 1. A bucket with a fill rate of 0 never hands out tokens.
+   */
+  explicit AtomicTokenBucketImpl(uint64_t max_tokens, TimeSource& time_source,
+                                 double fill_rate = 1);
+
+  // TokenBucket
+  uint64_t consume(uint64_t tokens, bool allow_partial) override;
+  uint64_t consume(uint64_t tokens, bool allow_partial,
+                   std::chrono::milliseconds& time_to_next_token) override;
+  std::chrono::milliseconds nextTokenAvailable() override;
+
+  /**
+   * Since the token bucket is shared, only the first reset call will work.
+   * Subsequent calls to reset method will be ignored.
+   */
+  void maybeReset(uint64_t num_tokens) override;
+
+  /**
+   * Puts back tokens that were consumed but could not be used.
+   */
+  void returnTokens(uint64_t tokens);
+
+  double fillRate() const { return fill_rate_; }
+  double remainingTokens() const;
+
+private:
+  double timeNowInSeconds() const;
+
+  const double max_tokens_;
+  const double fill_rate_;
+  TimeSource& time_source_;
+  std::atomic<double> time_in_seconds_;
+  std::atomic<bool> reset_once_{false};
+};
+
+using AtomicTokenBucketImplSharedPtr = std::shared_ptr<AtomicTokenBucketImpl>;
+
+/**
+ * A token bucket handing out the tokens available in each of a list of shared buckets, e.g. the
+ * buckets of a connection, of a route and of a whole filter chain. The buckets are consumed from
+ * in order, and the tokens a bucket can't match are returned to the buckets before it, so that no
+ * lock is needed across the buckets.
+ */
+class HierarchicalTokenBucketImpl : public TokenBucket {
+public:
+  /**
+   * @param buckets supplies the buckets, from the most to the least specific one.
+   * @param fill_interval supplies the interval which the first reset of each bucket fills it for.
+   */
+  HierarchicalTokenBucketImpl(std::vector<AtomicTokenBucketImplSharedPtr> buckets,
+                              std::chrono::milliseconds fill_interval);
+
+  // TokenBucket
+  uint64_t consume(uint64_t tokens, bool allow_partial) override;
+  uint64_t consume(uint64_t tokens, bool allow_partial,
+                   std::chrono::milliseconds& time_to_next_token) override;
+  std::chrono::milliseconds nextTokenAvailable() override;
+
+  /**
+   * Resets each bucket not reset before with the tokens it fills in the fill interval, as the
+   * buckets have different fill rates. num_tokens is ignored.
+   */
+  void maybeReset(uint64_t num_tokens) override;
+
+private:
+  const std::vector<AtomicTokenBucketImplSharedPtr> buckets_;
+  const std::chrono::milliseconds fill_interval_;
+};
+
 } // namespace Envoy
@@ -50,15 +50,44 @@ public:
     return std::make_unique<DecodedResourceImpl>(resource_decoder, resource);
   }
 
+  /**
+   * Like fromResource(), except that the resource is decoded by
+   * OpaqueResourceDecoder::decodeResourceWithoutVisitor(), so that it can be called from any
+   * thread. The resource must then be passed to OpaqueResourceDecoder::visitResource() on the main
+   * thread.
+   * @return nullptr if the decoder can only decode resources on the main thread.
+   */
+  static DecodedResourceImplPtr fromResourceWithoutVisitor(OpaqueResourceDecoder& resource_decoder,
+                                                           const ProtobufWkt::Any& resource,
+                                                           const std::string& version) {
+    if (resource.Is<envoy::service::discovery::v3::Resource>()) {
+      envoy::service::discovery::v3::Resource r;
+      MessageUtil::unpackTo(resource, r);
+      ProtobufTypes::MessagePtr decoded =
+          resource_decoder.decodeResourceWithoutVisitor(r.resource());
+      if (decoded == nullptr) {
+        return nullptr;
+      }
+
+      r.set_version(version);
+
+      return std::unique_ptr<DecodedResourceImpl>(
+          new DecodedResourceImpl(resource_decoder, std::move(decoded), r));
+    }
+
+    ProtobufTypes::MessagePtr decoded = resource_decoder.decodeResourceWithoutVisitor(resource);
+    if (decoded == nullptr) {
+      return nullptr;
+    }
+    return std::unique_ptr<DecodedResourceImpl>(new DecodedResourceImpl(
+        resource_decoder, std::move(decoded), absl::nullopt,
+        Protobuf::RepeatedPtrField<std::string>(), true, version, absl::nullopt, absl::nullopt));
+  }
+
   DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder,
                       const envoy::service::discovery::v3::Resource& resource)
-      : DecodedResourceImpl(
-            resource_decoder, resource.name(), resource.aliases(), resource.resource(),
-            resource.has_resource(), resource.version(),
-            resource.has_ttl() ? absl::make_optional(std::chrono::milliseconds(
-                                     DurationUtil::durationToMilliseconds(resource.ttl())))
-                               : absl::nullopt,
-            resource.has_metadata() ? makeOptRef(resource.metadata()) : absl::nullopt) {}
+      : DecodedResourceImpl(resource_decoder, resource_decoder.decodeResource(resource.resource()),
+                            resource) {}
   DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder,
                       const xds::core::v3::CollectionEntry::InlineEntry& inline_entry)
       : DecodedResourceImpl(resource_decoder, inline_entry.name(),
@@ -79,6 +108,9 @@ public:
   const OptRef<const envoy::config::core::v3::Metadata> metadata() const override {
     return metadata_;
   }
+  absl::optional<uint64_t> resourceHash() const override { return resource_hash_; }
+
+  void setResourceHash(uint64_t resource_hash) { resource_hash_ = resource_hash; }
 
 private:
   DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder, absl::optional<std::string> name,
@@ -86,7 +118,23 @@ private:
                       const ProtobufWkt::Any& resource, bool has_resource,
                       const std::string& version, absl::optional<std::chrono::milliseconds> ttl,
                       const OptRef<const envoy::config::core::v3::Metadata> metadata)
-      : resource_(resource_decoder.decodeResource(resource)), has_resource_(has_resource),
+      : DecodedResourceImpl(resource_decoder, resource_decoder.decodeResource(resource), name,
+                            aliases, has_resource, version, ttl, metadata) {}
+  DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder, ProtobufTypes::MessagePtr decoded,
+                      const envoy::service::discovery::v3::Resource& resource)
+      : DecodedResourceImpl(
+            resource_decoder, std::move(decoded), resource.name(), resource.aliases(),
+            resource.has_resource(), resource.version(),
+            resource.has_ttl() ? absl::make_optional(std::chrono::milliseconds(
+                                     DurationUtil::durationToMilliseconds(resource.ttl())))
+                               : absl::nullopt,
+            resource.has_metadata() ? makeOptRef(resource.metadata()) : absl::nullopt) {}
+  DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder, ProtobufTypes::MessagePtr decoded,
+                      absl::optional<std::string> name,
+                      const Protobuf::RepeatedPtrField<std::string>& aliases, bool has_resource,
+                      const std::string& version, absl::optional<std::chrono::milliseconds> ttl,
+                      const OptRef<const envoy::config::core::v3::Metadata> metadata)
+      : resource_(std::move(decoded)), has_resource_(has_resource),
         name_(name ? *name : resource_decoder.resourceName(*resource_)),
         aliases_(repeatedPtrFieldToVector(aliases)), version_(version), ttl_(ttl),
         metadata_(metadata) {}
@@ -102,6 +150,7 @@ private:
   // This is the metadata info under the Resource wrapper.
   // It is intended to be consumed in the xds_config_tracker extension.
   const OptRef<const envoy::config::core::v3::Metadata> metadata_;
+  absl::optional<uint64_t> resource_hash_;
 };
 
 struct DecodedResourcesWrapper {
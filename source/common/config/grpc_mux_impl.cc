@@ -64,13 +64,15 @@ GrpcMuxImpl::GrpcMuxImpl(const LocalInfo::LocalInfo& local_info,
                          CustomConfigValidatorsPtr&& config_validators,
                          XdsConfigTrackerOptRef xds_config_tracker,
                          XdsResourcesDelegateOptRef xds_resources_delegate,
-                         const std::string& target_xds_authority)
+                         const std::string& target_xds_authority,
+                         ParallelResourceDecoderSharedPtr parallel_resource_decoder)
     : grpc_stream_(this, std::move(async_client), service_method, random, dispatcher, scope,
                    rate_limit_settings),
       local_info_(local_info), skip_subsequent_node_(skip_subsequent_node),
       config_validators_(std::move(config_validators)), xds_config_tracker_(xds_config_tracker),
       xds_resources_delegate_(xds_resources_delegate), target_xds_authority_(target_xds_authority),
-      first_stream_request_(true), dispatcher_(dispatcher),
+      parallel_resource_decoder_(std::move(parallel_resource_decoder)), first_stream_request_(true),
+      dispatcher_(dispatcher),
       dynamic_update_callback_handle_(local_info.contextProvider().addDynamicContextUpdateCallback(
           [this](absl::string_view resource_type_url) {
             onDynamicContextUpdate(resource_type_url);
@@ -238,6 +240,17 @@ ScopedResume GrpcMuxImpl::pause(const std::vector<std::string> type_urls) {
   });
 }
 
+void GrpcMuxImpl::checkResourceTypeUrl(
+    const std::string& type_url, const ProtobufWkt::Any& resource,
+    const envoy::service::discovery::v3::DiscoveryResponse& message) {
+  // TODO(snowp): Check the underlying type when the resource is a Resource.
+  if (!resource.Is<envoy::service::discovery::v3::Resource>() && type_url != resource.type_url()) {
+    throw EnvoyException(
+        fmt::format("{} does not match the message-wide type URL {} in DiscoveryResponse {}",
+                    resource.type_url(), type_url, message.DebugString()));
+  }
+}
+
 void GrpcMuxImpl::onDiscoveryResponse(
     std::unique_ptr<envoy::service::discovery::v3::DiscoveryResponse>&& message,
     ControlPlaneStats& control_plane_stats) {
@@ -292,20 +305,26 @@ void GrpcMuxImpl::onDiscoveryResponse(
     std::vector<DecodedResourcePtr> resources;
     OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
 
-    for (const auto& resource : message->resources()) {
-      // TODO(snowp): Check the underlying type when the resource is a Resource.
-      if (!resource.Is<envoy::service::discovery::v3::Resource>() &&
-          type_url != resource.type_url()) {
-        throw EnvoyException(
-            fmt::format("{} does not match the message-wide type URL {} in DiscoveryResponse {}",
-                        resource.type_url(), type_url, message->DebugString()));
-      }
+    if (parallel_resource_decoder_ == nullptr) {
+      for (const auto& resource : message->resources()) {
+        checkResourceTypeUrl(type_url, resource, *message);
 
-      auto decoded_resource =
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info());
+        auto decoded_resource =
+            DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info());
 
-      if (!isHeartbeatResource(type_url, *decoded_resource)) {
-        resources.emplace_back(std::move(decoded_resource));
+        if (!isHeartbeatResource(type_url, *decoded_resource)) {
+          resources.emplace_back(std::move(decoded_resource));
+        }
+      }
+    } else {
+      for (const auto& resource : message->resources()) {
+        checkResourceTypeUrl(type_url, resource, *message);
+      }
+      for (auto& decoded_resource : parallel_resource_decoder_->decode(
+               resource_decoder, message->resources(), message->version_info())) {
+        if (!isHeartbeatResource(type_url, *decoded_resource)) {
+          resources.emplace_back(std::move(decoded_resource));
+        }
       }
     }
 
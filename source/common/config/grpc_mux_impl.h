@@ -21,6 +21,7 @@
 #include "source/common/config/api_version.h"
 #include "source/common/config/custom_config_validators.h"
 #include "source/common/config/grpc_stream.h"
+#include "source/common/config/parallel_resource_decoder.h"
 #include "source/common/config/ttl.h"
 #include "source/common/config/utility.h"
 #include "source/common/config/xds_context_params.h"
@@ -45,7 +46,8 @@ public:
               CustomConfigValidatorsPtr&& config_validators,
               XdsConfigTrackerOptRef xds_config_tracker,
               XdsResourcesDelegateOptRef xds_resources_delegate,
-              const std::string& target_xds_authority);
+              const std::string& target_xds_authority,
+              ParallelResourceDecoderSharedPtr parallel_resource_decoder = nullptr);
 
   ~GrpcMuxImpl() override;
 
@@ -190,6 +192,9 @@ private:
     return !resource.hasResource() &&
            resource.version() == apiStateFor(type_url).request_.version_info();
   }
+  // Throws if the type of resource doesn't match the type URL of the response.
+  static void checkResourceTypeUrl(const std::string& type_url, const ProtobufWkt::Any& resource,
+                                   const envoy::service::discovery::v3::DiscoveryResponse& message);
   void expiryCallback(absl::string_view type_url, const std::vector<std::string>& expired);
   // Request queue management logic.
   void queueDiscoveryRequest(absl::string_view queue_item);
@@ -212,6 +217,8 @@ private:
   XdsConfigTrackerOptRef xds_config_tracker_;
   XdsResourcesDelegateOptRef xds_resources_delegate_;
   const std::string target_xds_authority_;
+  // Decodes the resources of large responses on several threads, if set.
+  const ParallelResourceDecoderSharedPtr parallel_resource_decoder_;
   bool first_stream_request_;
   bool previously_fetched_data_{false};
 
@@ -10,8 +10,9 @@ namespace Config {
 template <typename Current> class OpaqueResourceDecoderImpl : public Config::OpaqueResourceDecoder {
 public:
   OpaqueResourceDecoderImpl(ProtobufMessage::ValidationVisitor& validation_visitor,
-                            absl::string_view name_field)
-      : validation_visitor_(validation_visitor), name_field_(name_field) {}
+                            absl::string_view name_field, bool hash_resources = false)
+      : validation_visitor_(validation_visitor), name_field_(name_field),
+        hash_resources_(hash_resources) {}
 
   // Config::OpaqueResourceDecoder
   ProtobufTypes::MessagePtr decodeResource(const ProtobufWkt::Any& resource) override {
@@ -28,9 +29,31 @@ public:
     return MessageUtil::getStringField(resource, name_field_);
   }
 
+  ProtobufTypes::MessagePtr
+  decodeResourceWithoutVisitor(const ProtobufWkt::Any& resource) override {
+    auto typed_message = std::make_unique<Current>();
+    if (!resource.type_url().empty()) {
+      MessageUtil::anyConvert<Current>(resource, *typed_message);
+      std::string err;
+      if (!Validate(*typed_message, &err)) {
+        ProtoExceptionUtil::throwProtoValidationException(err, *typed_message);
+      }
+    }
+    return typed_message;
+  }
+
+  void visitResource(const Protobuf::Message& resource) override {
+    if (!validation_visitor_.skipValidation()) {
+      MessageUtil::checkForUnexpectedFields(resource, validation_visitor_);
+    }
+  }
+
+  bool hashResources() const override { return hash_resources_; }
+
 private:
   ProtobufMessage::ValidationVisitor& validation_visitor_;
   const std::string name_field_;
+  const bool hash_resources_;
 };
 
 } // namespace Config
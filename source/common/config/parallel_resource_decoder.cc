@@ -0,0 +1,112 @@
+#include "source/common/config/parallel_resource_decoder.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Config {
+
+ParallelResourceDecoder::ParallelResourceDecoder(Thread::ThreadFactory& thread_factory,
+                                                 uint32_t threads) {
+  for (uint32_t i = 0; i < threads; i++) {
+    threads_.push_back(thread_factory.createThread([this]() -> void { threadFunc(); },
+                                                   Thread::Options{"XdsDecoder"}));
+  }
+}
+
+ParallelResourceDecoder::~ParallelResourceDecoder() {
+  {
+    Thread::LockGuard lock(lock_);
+    exit_ = true;
+    work_event_.notifyAll();
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+std::vector<DecodedResourceImplPtr>
+ParallelResourceDecoder::decode(OpaqueResourceDecoder& resource_decoder,
+                                const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+                                const std::string& version) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  Batch batch(resource_decoder, resources, version);
+  const bool parallel = !threads_.empty() && resources.size() >= MinParallelResources;
+  if (parallel) {
+    Thread::LockGuard lock(lock_);
+    batch_ = &batch;
+    batch_generation_++;
+    work_event_.notifyAll();
+  }
+  decodeBatch(batch);
+  if (parallel) {
+    // The threads that haven't joined the batch yet won't, so it only needs to outlive the
+    // active ones.
+    Thread::LockGuard lock(lock_);
+    batch_ = nullptr;
+    while (active_threads_ > 0) {
+      done_event_.wait(lock_);
+    }
+  }
+
+  for (int i = 0; i < resources.size(); i++) {
+    if (batch.errors_[i] != nullptr) {
+      std::rethrow_exception(batch.errors_[i]);
+    }
+    DecodedResourceImplPtr& decoded = batch.decoded_[i];
+    if (decoded == nullptr) {
+      decoded = DecodedResourceImpl::fromResource(resource_decoder, resources[i], version);
+    } else {
+      resource_decoder.visitResource(decoded->resource());
+    }
+  }
+  return std::move(batch.decoded_);
+}
+
+void ParallelResourceDecoder::decodeBatch(Batch& batch) {
+  for (int i = batch.next_.fetch_add(1, std::memory_order_relaxed); i < batch.resources_.size();
+       i = batch.next_.fetch_add(1, std::memory_order_relaxed)) {
+    TRY_NEEDS_AUDIT {
+      DecodedResourceImplPtr decoded = DecodedResourceImpl::fromResourceWithoutVisitor(
+          batch.resource_decoder_, batch.resources_[i], batch.version_);
+      if (decoded != nullptr && decoded->hasResource() && batch.resource_decoder_.hashResources()) {
+        decoded->setResourceHash(MessageUtil::hash(decoded->resource()));
+      }
+      batch.decoded_[i] = std::move(decoded);
+    }
+    catch (...) {
+      // Rethrown by the main thread, so that the error is handled as if the resources were
+      // decoded there.
+      batch.errors_[i] = std::current_exception();
+    }
+  }
+}
+
+void ParallelResourceDecoder::threadFunc() {
+  uint64_t generation = 0;
+  while (true) {
+    Batch* batch;
+    {
+      Thread::LockGuard lock(lock_);
+      while (!exit_ && (batch_ == nullptr || batch_generation_ == generation)) {
+        work_event_.wait(lock_);
+      }
+      if (exit_) {
+        return;
+      }
+      generation = batch_generation_;
+      batch = batch_;
+      active_threads_++;
+    }
+    decodeBatch(*batch);
+    {
+      Thread::LockGuard lock(lock_);
+      if (--active_threads_ == 0) {
+        done_event_.notifyAll();
+      }
+    }
+  }
+}
+
+} // namespace Config
+} // namespace Envoy
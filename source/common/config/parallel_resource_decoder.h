@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/subscription.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/thread.h"
+#include "source/common/config/decoded_resource_impl.h"
+#include "source/common/protobuf/protobuf.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * Decodes the resources of large discovery responses on a few threads along with the main thread,
+ * so that unpacking tens of thousands of resources and checking their type constraints doesn't
+ * hold the main thread for seconds. The checks of the validation visitor aren't thread safe, so
+ * they are still done by the main thread, followed in order by the decoded resources. The
+ * resources of decoders asking for it are also hashed by the threads.
+ */
+class ParallelResourceDecoder {
+public:
+  // Responses with fewer resources are decoded on the main thread only.
+  static constexpr int MinParallelResources = 64;
+
+  ParallelResourceDecoder(Thread::ThreadFactory& thread_factory, uint32_t threads);
+  ~ParallelResourceDecoder();
+
+  /**
+   * Decodes the resources like DecodedResourceImpl::fromResource(). Must be called from the main
+   * thread.
+   * @param resource_decoder supplies the decoder of the resources.
+   * @param resources supplies the resources to decode.
+   * @param version supplies the version of the resources.
+   * @return the decoded resources, in the order of resources.
+   * @throw EnvoyException the error of the first resource that couldn't be decoded.
+   */
+  std::vector<DecodedResourceImplPtr>
+  decode(OpaqueResourceDecoder& resource_decoder,
+         const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources, const std::string& version);
+
+private:
+  struct Batch {
+    Batch(OpaqueResourceDecoder& resource_decoder,
+          const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+          const std::string& version)
+        : resource_decoder_(resource_decoder), resources_(resources), version_(version),
+          decoded_(resources.size()), errors_(resources.size()) {}
+
+    OpaqueResourceDecoder& resource_decoder_;
+    const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources_;
+    const std::string& version_;
+    // Each resource is decoded by the thread that claims its index.
+    std::atomic<int> next_{0};
+    std::vector<DecodedResourceImplPtr> decoded_;
+    std::vector<std::exception_ptr> errors_;
+  };
+
+  static void decodeBatch(Batch& batch);
+  void threadFunc();
+
+  Thread::MutexBasicLockable lock_;
+  Thread::CondVar work_event_;
+  Thread::CondVar done_event_;
+  // The batch being decoded, which the threads may join until the main thread is done with it.
+  Batch* batch_ ABSL_GUARDED_BY(lock_){};
+  uint64_t batch_generation_ ABSL_GUARDED_BY(lock_){0};
+  uint32_t active_threads_ ABSL_GUARDED_BY(lock_){0};
+  bool exit_ ABSL_GUARDED_BY(lock_){false};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using ParallelResourceDecoderSharedPtr = std::shared_ptr<ParallelResourceDecoder>;
+
+} // namespace Config
+} // namespace Envoy
@@ -11,9 +11,9 @@ namespace Config {
 template <typename Current> struct SubscriptionBase : public Config::SubscriptionCallbacks {
 public:
   SubscriptionBase(ProtobufMessage::ValidationVisitor& validation_visitor,
-                   absl::string_view name_field)
+                   absl::string_view name_field, bool hash_resources = false)
       : resource_decoder_(std::make_shared<Config::OpaqueResourceDecoderImpl<Current>>(
-            validation_visitor, name_field)) {}
+            validation_visitor, name_field, hash_resources)) {}
 
   std::string getResourceName() const { return Envoy::Config::getResourceName<Current>(); }
 
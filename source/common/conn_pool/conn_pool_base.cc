@@ -202,7 +202,9 @@ void ConnPoolImplBase::attachStreamToClient(Envoy::ConnectionPool::ActiveClient&
   state_.incrActiveStreams(1);
   num_active_streams_++;
   host_->stats().rq_total_.inc();
+  host_->localityLoadStats().incRqTotal();
   host_->stats().rq_active_.inc();
+  host_->localityLoadStats().incRqActive();
   traffic_stats.upstream_rq_total_.inc();
   traffic_stats.upstream_rq_active_.inc();
   host_->cluster().resourceManager(priority_).requests().inc();
@@ -217,6 +219,7 @@ void ConnPoolImplBase::onStreamClosed(Envoy::ConnectionPool::ActiveClient& clien
   state_.decrActiveStreams(1);
   num_active_streams_--;
   host_->stats().rq_active_.dec();
+  host_->localityLoadStats().decRqActive();
   host_->cluster().trafficStats()->upstream_rq_active_.dec();
   host_->cluster().resourceManager(priority_).requests().dec();
   // We don't update the capacity for HTTP/3 as the stream count should only
@@ -252,8 +255,9 @@ void ConnPoolImplBase::onStreamClosed(Envoy::ConnectionPool::ActiveClient& clien
   }
 }
 
-ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& context,
-                                                             bool can_send_early_data) {
+ConnectionPool::Cancellable*
+ConnPoolImplBase::newStreamImpl(AttachContext& context, bool can_send_early_data,
+                                absl::optional<MonotonicTime> deadline) {
   ASSERT(!is_draining_for_deletion_);
   ASSERT(!deferred_deleting_);
 
@@ -287,7 +291,20 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
     return nullptr;
   }
 
+  if (deadline.has_value() && deadline.value() <= dispatcher_.timeSource().monotonicTime()) {
+    ENVOY_LOG(debug, "shedding stream past its deadline");
+    onPoolFailure(nullptr, "deadline exceeded", ConnectionPool::PoolFailureReason::Overflow,
+                  context);
+    host_->cluster().trafficStats()->upstream_rq_pending_shed_.inc();
+    return nullptr;
+  }
+
   ConnectionPool::Cancellable* pending = newPendingStream(context, can_send_early_data);
+  if (deadline.has_value()) {
+    ASSERT(pending == pending_streams_.front().get());
+    pending_streams_.front()->deadline_ = deadline;
+    sortNewestPendingStreamByDeadline();
+  }
   ENVOY_LOG(debug, "trying to create new connection");
   ENVOY_LOG(trace, fmt::format("{}", *this));
 
@@ -324,6 +341,9 @@ void ConnPoolImplBase::scheduleOnUpstreamReady() {
 
 void ConnPoolImplBase::onUpstreamReady() {
   while (!pending_streams_.empty() && !ready_clients_.empty()) {
+    if (maybeShedNextPendingStream()) {
+      continue;
+    }
     ActiveClientPtr& client = ready_clients_.front();
     ENVOY_CONN_LOG(debug, "attaching to next stream", *client);
     // Pending streams are pushed onto the front, so pull from the back.
@@ -336,6 +356,36 @@ void ConnPoolImplBase::onUpstreamReady() {
   }
 }
 
+void ConnPoolImplBase::sortNewestPendingStreamByDeadline() {
+  // Streams with no deadline are ordered as if their deadline never came. Since most streams of a
+  // pool share the same timeout, the newest stream usually has the latest deadline and the scan
+  // stops right away.
+  const auto deadline = [](const PendingStreamPtr& stream) {
+    return stream->deadline_.value_or(MonotonicTime::max());
+  };
+  const auto newest = pending_streams_.begin();
+  auto position = std::next(newest);
+  while (position != pending_streams_.end() && deadline(*position) > deadline(*newest)) {
+    ++position;
+  }
+  // Splicing within the list keeps the iterator of the stream valid.
+  pending_streams_.splice(position, pending_streams_, newest);
+}
+
+bool ConnPoolImplBase::maybeShedNextPendingStream() {
+  const absl::optional<MonotonicTime>& deadline = pending_streams_.back()->deadline_;
+  if (!deadline.has_value() || deadline.value() > dispatcher_.timeSource().monotonicTime()) {
+    return false;
+  }
+  ENVOY_LOG(debug, "shedding pending stream past its deadline");
+  state_.decrPendingStreams(1);
+  PendingStreamPtr stream = pending_streams_.back()->removeFromList(pending_streams_);
+  host_->cluster().trafficStats()->upstream_rq_pending_shed_.inc();
+  onPoolFailure(nullptr, "deadline exceeded", ConnectionPool::PoolFailureReason::Overflow,
+                stream->context());
+  return true;
+}
+
 std::list<ActiveClientPtr>& ConnPoolImplBase::owningList(ActiveClient::State state) {
   switch (state) {
   case ActiveClient::State::Connecting:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/conn_pool.h"
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/connection.h"
 #include "envoy/stats/timespan.h"
@@ -11,6 +12,7 @@
 #include "source/common/common/linked_object.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "fmt/ostream.h"
 
 namespace Envoy {
@@ -176,6 +178,8 @@ public:
   ConnPoolImplBase& parent_;
   // The request can be sent as early data.
   bool can_send_early_data_;
+  // If set, the time after which the request times out.
+  absl::optional<MonotonicTime> deadline_;
 };
 
 using PendingStreamPtr = std::unique_ptr<PendingStream>;
@@ -260,7 +264,11 @@ public:
   void checkForIdleAndCloseIdleConnsIfDraining();
 
   void scheduleOnUpstreamReady();
-  ConnectionPool::Cancellable* newStreamImpl(AttachContext& context, bool can_send_early_data);
+  // If a deadline is set, the stream is queued ahead of the pending streams with later deadlines,
+  // and failed instead of being attached once past its deadline.
+  ConnectionPool::Cancellable*
+  newStreamImpl(AttachContext& context, bool can_send_early_data,
+                absl::optional<MonotonicTime> deadline = absl::nullopt);
 
   virtual ConnectionPool::Cancellable* newPendingStream(AttachContext& context,
                                                         bool can_send_early_data) PURE;
@@ -396,6 +404,13 @@ private:
   // Prerequisite: the given clients shouldn't be idle.
   void drainClients(std::list<ActiveClientPtr>& clients);
 
+  // Moves the most recent pending stream, at the front of pending_streams_, behind the pending
+  // streams with later deadlines, so that the back of the list holds the earliest deadline.
+  void sortNewestPendingStreamByDeadline();
+
+  // Fails the next pending stream if its deadline has passed. Returns true if it was failed.
+  bool maybeShedNextPendingStream();
+
   std::list<PendingStreamPtr> pending_streams_;
 
   // The number of streams currently attached to clients.
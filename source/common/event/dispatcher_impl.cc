@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,8 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
       deferred_delete_cb_(base_scheduler_.createSchedulableCallback(
           [this]() -> void { clearDeferredDeleteList(); })),
       post_cb_(base_scheduler_.createSchedulableCallback([this]() -> void { runPostCallbacks(); })),
+      lock_free_post_(
+          Runtime::runtimeFeatureEnabled("envoy.restart_features.lock_free_dispatcher_post")),
       current_to_delete_(&to_delete_1_), scaled_timer_manager_(scaled_timer_factory(*this)) {
   ASSERT(!name_.empty());
   FatalErrorHandler::registerFatalErrorHandler(*this);
@@ -89,6 +92,9 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
 DispatcherImpl::~DispatcherImpl() {
   ENVOY_LOG(debug, "destroying dispatcher {}", name_);
   FatalErrorHandler::removeFatalErrorHandler(*this);
+  if (slow_callbacks_ != nullptr) {
+    SlowCallbackRegistry::get().remove(*slow_callbacks_);
+  }
   // TODO(lambdai): Resolve https://github.com/envoyproxy/envoy/issues/15072 and enable
   // ASSERT(deletable_in_dispatcher_thread_.empty())
 }
@@ -109,6 +115,8 @@ void DispatcherImpl::initializeStats(Stats::Scope& scope,
     stats_ = std::make_unique<DispatcherStats>(
         DispatcherStats{ALL_DISPATCHER_STATS(POOL_HISTOGRAM_PREFIX(scope, stats_prefix_ + "."))});
     base_scheduler_.initializeStats(stats_.get());
+    slow_callbacks_ = std::make_unique<SlowCallbackTracker>(stats_prefix_);
+    SlowCallbackRegistry::get().add(*slow_callbacks_);
     ENVOY_LOG(debug, "running {} on thread {}", stats_prefix_, run_tid_.debugString());
   });
 }
@@ -133,6 +141,7 @@ void DispatcherImpl::clearDeferredDeleteList() {
   }
 
   touchWatchdog();
+  const CallbackTiming timing(*this, CallbackCategory::DeferredDelete);
   deferred_deleting_ = true;
 
   // Calling clear() on the vector does not specify which order destructors run in. We want to
@@ -181,6 +190,7 @@ FileEventPtr DispatcherImpl::createFileEvent(os_fd_t fd, FileReadyCb cb, FileTri
       *this, fd,
       [this, cb](uint32_t events) {
         touchWatchdog();
+        const CallbackTiming timing(*this, CallbackCategory::FileEvent);
         cb(events);
       },
       trigger, events)};
@@ -191,14 +201,15 @@ Filesystem::WatcherPtr DispatcherImpl::createFilesystemWatcher() {
   return Filesystem::WatcherPtr{new Filesystem::WatcherImpl(*this, file_system_)};
 }
 
-Network::ListenerPtr DispatcherImpl::createListener(Network::SocketSharedPtr&& socket,
-                                                    Network::TcpListenerCallbacks& cb,
-                                                    Runtime::Loader& runtime, bool bind_to_port,
-                                                    bool ignore_global_conn_limit) {
+Network::ListenerPtr
+DispatcherImpl::createListener(Network::SocketSharedPtr&& socket, Network::TcpListenerCallbacks& cb,
+                               Runtime::Loader& runtime, bool bind_to_port,
+                               bool ignore_global_conn_limit,
+                               uint32_t max_connections_to_accept_per_socket_event) {
   ASSERT(isThreadSafe());
-  return std::make_unique<Network::TcpListenerImpl>(*this, random_generator_, runtime,
-                                                    std::move(socket), cb, bind_to_port,
-                                                    ignore_global_conn_limit);
+  return std::make_unique<Network::TcpListenerImpl>(
+      *this, random_generator_, runtime, std::move(socket), cb, bind_to_port,
+      ignore_global_conn_limit, max_connections_to_accept_per_socket_event);
 }
 
 Network::UdpListenerPtr
@@ -229,6 +240,7 @@ Event::SchedulableCallbackPtr DispatcherImpl::createSchedulableCallback(std::fun
   ASSERT(isThreadSafe());
   return base_scheduler_.createSchedulableCallback([this, cb]() {
     touchWatchdog();
+    const CallbackTiming timing(*this, CallbackCategory::PostCallback);
     cb();
   });
 }
@@ -237,6 +249,7 @@ TimerPtr DispatcherImpl::createTimerInternal(TimerCb cb) {
   return scheduler_->createTimer(
       [this, cb]() {
         touchWatchdog();
+        const CallbackTiming timing(*this, CallbackCategory::Timer);
         cb();
       },
       *this);
@@ -263,10 +276,12 @@ SignalEventPtr DispatcherImpl::listenForSignal(signal_t signal_num, SignalCb cb)
 
 void DispatcherImpl::post(std::function<void()> callback) {
   bool do_post;
-  {
+  if (lock_free_post_) {
+    do_post = post_queue_.push(std::move(callback));
+  } else {
     Thread::LockGuard lock(post_lock_);
     do_post = post_callbacks_.empty();
-    post_callbacks_.push_back(callback);
+    post_callbacks_.push_back(std::move(callback));
   }
 
   if (do_post) {
@@ -309,8 +324,10 @@ void DispatcherImpl::shutdown() {
   // callbacks and dispatcher thread deletable objects.
   ASSERT(isThreadSafe());
   auto deferred_deletables_size = current_to_delete_->size();
-  std::list<std::function<void()>>::size_type post_callbacks_size;
-  {
+  size_t post_callbacks_size;
+  if (lock_free_post_) {
+    post_callbacks_size = post_queue_.size();
+  } else {
     Thread::LockGuard lock(post_lock_);
     post_callbacks_size = post_callbacks_.size();
   }
@@ -349,6 +366,7 @@ void DispatcherImpl::runThreadLocalDelete() {
     // Touch the watchdog before deleting the objects to avoid spurious watchdog miss events when
     // executing complicated destruction.
     touchWatchdog();
+    const CallbackTiming timing(*this, CallbackCategory::DeferredDelete);
     // Delete in FIFO order.
     to_be_delete.pop_front();
   }
@@ -359,6 +377,18 @@ void DispatcherImpl::runPostCallbacks() {
   // objects that is being deferred deleted.
   clearDeferredDeleteList();
 
+  if (lock_free_post_) {
+    // Callbacks posted while these run are taken by the next run, like with post_callbacks_.
+    MpscQueue<std::function<void()>>::Batch callbacks = post_queue_.popAll();
+    while (!callbacks.empty()) {
+      touchWatchdog();
+      const CallbackTiming timing(*this, CallbackCategory::PostCallback);
+      callbacks.front()();
+      callbacks.popFront();
+    }
+    return;
+  }
+
   std::list<std::function<void()>> callbacks;
   {
     // Take ownership of the callbacks under the post_lock_. The lock must be released before
@@ -375,6 +405,7 @@ void DispatcherImpl::runPostCallbacks() {
     // Touch the watchdog before executing the callback to avoid spurious watchdog miss events when
     // executing a long list of callbacks.
     touchWatchdog();
+    const CallbackTiming timing(*this, CallbackCategory::PostCallback);
     // Run the callback.
     callbacks.front()();
     // Pop the front so that the destructor of the callback that just executed runs before the next
@@ -428,6 +459,56 @@ void DispatcherImpl::popTrackedObject(const ScopeTrackedObject* expected_object)
   tracked_object_stack_.pop_back();
   ASSERT(top == expected_object,
          "Popped the top of the tracked object stack, but it wasn't the expected object!");
+
+  // The outermost object gives the context of a slow callback, which is only built once the
+  // callback is known to be slow.
+  if (callback_start_.has_value() && tracked_object_stack_.empty() &&
+      slow_callbacks_->isSlow(std::chrono::duration_cast<std::chrono::microseconds>(
+          time_source_.monotonicTime() - *callback_start_))) {
+    std::ostringstream context;
+    top->dumpState(context);
+    callback_context_ = context.str();
+  }
+}
+
+DispatcherImpl::CallbackTiming::CallbackTiming(DispatcherImpl& dispatcher,
+                                               CallbackCategory category)
+    : dispatcher_(dispatcher.stats_ != nullptr && !dispatcher.callback_start_.has_value()
+                      ? &dispatcher
+                      : nullptr),
+      category_(category) {
+  if (dispatcher_ != nullptr) {
+    dispatcher_->callback_start_ = dispatcher_->time_source_.monotonicTime();
+  }
+}
+
+DispatcherImpl::CallbackTiming::~CallbackTiming() {
+  if (dispatcher_ == nullptr) {
+    return;
+  }
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      dispatcher_->time_source_.monotonicTime() - *dispatcher_->callback_start_);
+  dispatcher_->callbackHistogram(category_).recordValue(duration.count());
+  if (dispatcher_->slow_callbacks_->isSlow(duration)) {
+    dispatcher_->slow_callbacks_->record(category_, duration,
+                                         std::move(dispatcher_->callback_context_));
+  }
+  dispatcher_->callback_start_.reset();
+  dispatcher_->callback_context_.clear();
+}
+
+Stats::Histogram& DispatcherImpl::callbackHistogram(CallbackCategory category) {
+  switch (category) {
+  case CallbackCategory::FileEvent:
+    return stats_->file_event_duration_us_;
+  case CallbackCategory::Timer:
+    return stats_->timer_duration_us_;
+  case CallbackCategory::PostCallback:
+    return stats_->post_callback_duration_us_;
+  case CallbackCategory::DeferredDelete:
+    return stats_->deferred_delete_duration_us_;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
 } // namespace Event
@@ -15,12 +15,15 @@
 #include "envoy/stats/scope.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/common/mpsc_queue.h"
 #include "source/common/common/thread.h"
 #include "source/common/event/libevent.h"
 #include "source/common/event/libevent_scheduler.h"
+#include "source/common/event/slow_callback_tracker.h"
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Event {
@@ -75,9 +78,10 @@ public:
   FileEventPtr createFileEvent(os_fd_t fd, FileReadyCb cb, FileTriggerType trigger,
                                uint32_t events) override;
   Filesystem::WatcherPtr createFilesystemWatcher() override;
-  Network::ListenerPtr createListener(Network::SocketSharedPtr&& socket,
-                                      Network::TcpListenerCallbacks& cb, Runtime::Loader& runtime,
-                                      bool bind_to_port, bool ignore_global_conn_limit) override;
+  Network::ListenerPtr
+  createListener(Network::SocketSharedPtr&& socket, Network::TcpListenerCallbacks& cb,
+                 Runtime::Loader& runtime, bool bind_to_port, bool ignore_global_conn_limit,
+                 uint32_t max_connections_to_accept_per_socket_event) override;
   Network::UdpListenerPtr
   createUdpListener(Network::SocketSharedPtr socket, Network::UdpListenerCallbacks& cb,
                     const envoy::config::core::v3::UdpSocketConfig& config) override;
@@ -131,6 +135,21 @@ private:
   };
   using WatchdogRegistrationPtr = std::unique_ptr<WatchdogRegistration>;
 
+  // Measures the duration of a callback run by the event loop while it is in scope, if the
+  // dispatcher stats are enabled. Callbacks nested in a measured callback are not measured.
+  class CallbackTiming {
+  public:
+    CallbackTiming(DispatcherImpl& dispatcher, CallbackCategory category);
+    ~CallbackTiming();
+
+  private:
+    // nullptr if the callback is not measured.
+    DispatcherImpl* const dispatcher_;
+    const CallbackCategory category_;
+  };
+
+  Stats::Histogram& callbackHistogram(CallbackCategory category);
+
   TimerPtr createTimerInternal(TimerCb cb);
   void updateApproximateMonotonicTimeInternal();
   void runPostCallbacks();
@@ -153,6 +172,13 @@ private:
   Filesystem::Instance& file_system_;
   std::string stats_prefix_;
   DispatcherStatsPtr stats_;
+  // Set along with stats_.
+  std::unique_ptr<SlowCallbackTracker> slow_callbacks_;
+  // Start of the callback being measured, if any.
+  absl::optional<MonotonicTime> callback_start_;
+  // State dumped by the outermost tracked object of the callback being measured, if that callback
+  // was already slow when the object was popped.
+  std::string callback_context_;
   Thread::ThreadId run_tid_;
   Buffer::WatermarkFactorySharedPtr buffer_factory_;
   LibeventScheduler base_scheduler_;
@@ -168,8 +194,11 @@ private:
   SchedulableCallbackPtr deferred_delete_cb_;
 
   SchedulableCallbackPtr post_cb_;
+  // Whether posted callbacks are queued in post_queue_ rather than in post_callbacks_.
+  const bool lock_free_post_;
   Thread::MutexBasicLockable post_lock_;
   std::list<std::function<void()>> post_callbacks_ ABSL_GUARDED_BY(post_lock_);
+  MpscQueue<std::function<void()>> post_queue_;
 
   std::vector<DeferredDeletablePtr> to_delete_1_;
   std::vector<DeferredDeletablePtr> to_delete_2_;
@@ -8,6 +8,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/scope_tracker.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Event {
@@ -34,7 +35,7 @@ class ScaledRangeTimerManagerImpl::RangeTimerImpl final : public Timer {
 public:
   RangeTimerImpl(ScaledTimerMinimum minimum, TimerCb callback, ScaledRangeTimerManagerImpl& manager)
       : minimum_(minimum), manager_(manager), callback_(std::move(callback)),
-        min_duration_timer_(manager.dispatcher_.createTimer([this] { onMinTimerComplete(); })) {}
+        min_duration_timer_(manager.createMinDurationTimer([this] { onMinTimerComplete(); })) {}
 
   ~RangeTimerImpl() override { disableTimer(); }
 
@@ -140,6 +141,9 @@ private:
 ScaledRangeTimerManagerImpl::ScaledRangeTimerManagerImpl(
     Dispatcher& dispatcher, const ScaledTimerTypeMapConstSharedPtr& timer_minimums)
     : dispatcher_(dispatcher),
+      wheel_(Runtime::runtimeFeatureEnabled("envoy.restart_features.scaled_timer_wheel")
+                 ? std::make_unique<TimerWheel>(dispatcher)
+                 : nullptr),
       timer_minimums_(timer_minimums != nullptr ? timer_minimums
                                                 : std::make_shared<ScaledTimerTypeMap>()),
       scale_factor_(1.0) {}
@@ -163,6 +167,13 @@ TimerPtr ScaledRangeTimerManagerImpl::createTimer(ScaledTimerMinimum minimum, Ti
   return std::make_unique<RangeTimerImpl>(minimum, callback, *this);
 }
 
+TimerPtr ScaledRangeTimerManagerImpl::createMinDurationTimer(TimerCb callback) {
+  if (wheel_ != nullptr) {
+    return wheel_->createTimer(std::move(callback));
+  }
+  return dispatcher_.createTimer(std::move(callback));
+}
+
 void ScaledRangeTimerManagerImpl::setScaleFactor(UnitFloat scale_factor) {
   const MonotonicTime now = dispatcher_.approximateMonotonicTime();
   scale_factor_ = scale_factor;
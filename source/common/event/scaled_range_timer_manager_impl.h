@@ -7,6 +7,8 @@
 #include "envoy/event/scaled_range_timer_manager.h"
 #include "envoy/event/timer.h"
 
+#include "source/common/event/timer_wheel.h"
+
 #include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
@@ -20,6 +22,10 @@ namespace Event {
  * expectation is that the number of (max - min) values used to enable timers is small, so the
  * number of queues is tightly bounded. The queue-based implementation depends on that expectation
  * for efficient operation.
+ *
+ * With the envoy.restart_features.scaled_timer_wheel runtime feature, the min durations are tracked
+ * by a TimerWheel rather than by a real Timer per enabled timer, so that enabling and disabling
+ * timers stays constant time with large numbers of timers.
  */
 class ScaledRangeTimerManagerImpl : public ScaledRangeTimerManager {
 public:
@@ -122,7 +128,12 @@ private:
 
   void onQueueTimerFired(Queue& queue);
 
+  // Creates the timer tracking the min duration of a range timer.
+  TimerPtr createMinDurationTimer(TimerCb callback);
+
   Dispatcher& dispatcher_;
+  // Holds the min duration timers if set.
+  const std::unique_ptr<TimerWheel> wheel_;
   const ScaledTimerTypeMapConstSharedPtr timer_minimums_;
   UnitFloat scale_factor_;
   absl::flat_hash_set<std::unique_ptr<Queue>, Hash, Eq> queues_;
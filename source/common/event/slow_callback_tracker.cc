@@ -0,0 +1,87 @@
+#include "source/common/event/slow_callback_tracker.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
+
+namespace Envoy {
+namespace Event {
+
+absl::string_view callbackCategoryName(CallbackCategory category) {
+  switch (category) {
+  case CallbackCategory::FileEvent:
+    return "file_event";
+  case CallbackCategory::Timer:
+    return "timer";
+  case CallbackCategory::PostCallback:
+    return "post_callback";
+  case CallbackCategory::DeferredDelete:
+    return "deferred_delete";
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+void SlowCallbackTracker::record(CallbackCategory category, std::chrono::microseconds duration,
+                                 std::string context) {
+  Thread::LockGuard lock(mutex_);
+  // Another callback may have raised the threshold since isSlow() was checked.
+  if (!isSlow(duration)) {
+    return;
+  }
+  if (context.size() > MaxContextLength) {
+    context.resize(MaxContextLength);
+  }
+  auto it = std::upper_bound(slowest_.begin(), slowest_.end(), duration,
+                             [](std::chrono::microseconds d, const SlowCallback& callback) {
+                               return d > callback.duration_;
+                             });
+  slowest_.insert(it, SlowCallback{category, duration, std::move(context)});
+  if (slowest_.size() > MaxCallbacks) {
+    slowest_.pop_back();
+  }
+  if (slowest_.size() == MaxCallbacks) {
+    threshold_us_.store(slowest_.back().duration_.count(), std::memory_order_relaxed);
+  }
+}
+
+std::vector<SlowCallback> SlowCallbackTracker::slowest() const {
+  Thread::LockGuard lock(mutex_);
+  return slowest_;
+}
+
+void SlowCallbackTracker::clear() {
+  Thread::LockGuard lock(mutex_);
+  slowest_.clear();
+  threshold_us_.store(-1, std::memory_order_relaxed);
+}
+
+SlowCallbackRegistry& SlowCallbackRegistry::get() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(SlowCallbackRegistry);
+}
+
+void SlowCallbackRegistry::add(SlowCallbackTracker& tracker) {
+  Thread::LockGuard lock(mutex_);
+  trackers_.insert(&tracker);
+}
+
+void SlowCallbackRegistry::remove(SlowCallbackTracker& tracker) {
+  Thread::LockGuard lock(mutex_);
+  trackers_.erase(&tracker);
+}
+
+void SlowCallbackRegistry::forEach(const std::function<void(SlowCallbackTracker&)>& fn) {
+  Thread::LockGuard lock(mutex_);
+  std::vector<SlowCallbackTracker*> sorted(trackers_.begin(), trackers_.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const SlowCallbackTracker* a, const SlowCallbackTracker* b) {
+              return a->name() < b->name();
+            });
+  for (SlowCallbackTracker* tracker : sorted) {
+    fn(*tracker);
+  }
+}
+
+} // namespace Event
+} // namespace Envoy
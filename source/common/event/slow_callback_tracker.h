@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "source/common/common/non_copyable.h"
+#include "source/common/common/thread.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * The kinds of callbacks run by the event loop of a dispatcher.
+ */
+enum class CallbackCategory { FileEvent, Timer, PostCallback, DeferredDelete };
+
+absl::string_view callbackCategoryName(CallbackCategory category);
+
+/**
+ * A callback which stalled the event loop.
+ */
+struct SlowCallback {
+  CallbackCategory category_;
+  std::chrono::microseconds duration_;
+  // The state dumped by the outermost tracked object of the callback, if any.
+  std::string context_;
+};
+
+/**
+ * Keeps the slowest callbacks run by the event loop of a dispatcher. Callbacks are recorded from
+ * the dispatcher thread, and the slowest ones can be read from any thread.
+ */
+class SlowCallbackTracker : NonCopyable {
+public:
+  // Number of callbacks kept.
+  static constexpr size_t MaxCallbacks = 10;
+  // Maximum length of the context kept for a callback.
+  static constexpr size_t MaxContextLength = 1024;
+
+  explicit SlowCallbackTracker(std::string name) : name_(std::move(name)) {}
+
+  /**
+   * @return the name of the dispatcher.
+   */
+  const std::string& name() const { return name_; }
+
+  /**
+   * @return whether a callback running for `duration` would be kept. This is a single atomic load,
+   *         so that callbacks can be filtered before their context is built.
+   */
+  bool isSlow(std::chrono::microseconds duration) const {
+    return duration.count() > threshold_us_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Records a callback, which replaces the fastest one kept if there are already MaxCallbacks.
+   */
+  void record(CallbackCategory category, std::chrono::microseconds duration, std::string context);
+
+  /**
+   * @return the callbacks kept, from the slowest to the fastest.
+   */
+  std::vector<SlowCallback> slowest() const;
+
+  /**
+   * Drops the callbacks kept.
+   */
+  void clear();
+
+private:
+  const std::string name_;
+  mutable Thread::MutexBasicLockable mutex_;
+  // Sorted from the slowest to the fastest.
+  std::vector<SlowCallback> slowest_ ABSL_GUARDED_BY(mutex_);
+  // Duration of the fastest callback kept once there are MaxCallbacks, and -1 before that.
+  std::atomic<int64_t> threshold_us_{-1};
+};
+
+/**
+ * Process wide registry of the trackers of the dispatchers with stats enabled, read by the admin
+ * server.
+ */
+class SlowCallbackRegistry : NonCopyable {
+public:
+  static SlowCallbackRegistry& get();
+
+  void add(SlowCallbackTracker& tracker);
+  void remove(SlowCallbackTracker& tracker);
+
+  /**
+   * Calls `fn` with each registered tracker, sorted by name. Trackers can't be removed while this
+   * runs.
+   */
+  void forEach(const std::function<void(SlowCallbackTracker&)>& fn);
+
+private:
+  Thread::MutexBasicLockable mutex_;
+  absl::flat_hash_set<SlowCallbackTracker*> trackers_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Event
+} // namespace Envoy
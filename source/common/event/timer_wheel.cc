@@ -0,0 +1,253 @@
+#include "source/common/event/timer_wheel.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+namespace Envoy {
+namespace Event {
+
+class TimerWheel::WheelTimer final : public Timer {
+public:
+  WheelTimer(TimerWheel& wheel, TimerCb callback) : wheel_(wheel), callback_(std::move(callback)) {
+    ASSERT(callback_);
+  }
+  ~WheelTimer() override { disableTimer(); }
+
+  // Timer
+  void disableTimer() override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    if (enabled_) {
+      wheel_.unlink(*this);
+    }
+  }
+  void enableTimer(std::chrono::milliseconds duration, const ScopeTrackedObject* object) override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    disableTimer();
+    object_ = object;
+    wheel_.enable(*this, std::max(duration, std::chrono::milliseconds::zero()));
+  }
+  void enableHRTimer(std::chrono::microseconds duration,
+                     const ScopeTrackedObject* object = nullptr) override {
+    // Rounded up, so that the timer doesn't fire early.
+    enableTimer(std::chrono::ceil<std::chrono::milliseconds>(duration), object);
+  }
+  bool enabled() override { return enabled_; }
+
+  void fire() {
+    if (object_ == nullptr) {
+      callback_();
+      return;
+    }
+    ScopeTrackerScopeState scope(object_, wheel_.dispatcher_);
+    object_ = nullptr;
+    callback_();
+  }
+
+  TimerWheel& wheel_;
+  const TimerCb callback_;
+  const ScopeTrackedObject* object_{};
+  uint64_t expiry_tick_{};
+  // The links of the slot holding the timer while it is enabled.
+  WheelTimer* prev_{};
+  WheelTimer* next_{};
+  uint32_t slot_{};
+  bool enabled_{};
+};
+
+TimerWheel::TimerWheel(Dispatcher& dispatcher)
+    : dispatcher_(dispatcher), origin_(dispatcher.timeSource().monotonicTime()),
+      timer_(dispatcher.createTimer([this] { onTimer(); })) {}
+
+TimerWheel::~TimerWheel() {
+  // Timers created by the wheel shouldn't outlive it.
+  ASSERT(size_ == 0);
+}
+
+TimerPtr TimerWheel::createTimer(TimerCb callback) {
+  return std::make_unique<WheelTimer>(*this, std::move(callback));
+}
+
+uint32_t TimerWheel::slotIndex(uint32_t wheel, uint64_t tick) {
+  if (wheel == 0) {
+    return tick & ((1 << FirstWheelBits) - 1);
+  }
+  return (1 << FirstWheelBits) + (wheel - 1) * (1 << WheelBits) +
+         ((tick >> shift(wheel)) & ((1 << WheelBits) - 1));
+}
+
+uint64_t TimerWheel::floorTick(MonotonicTime time) const {
+  return std::chrono::floor<std::chrono::milliseconds>(time - origin_).count();
+}
+
+uint64_t TimerWheel::ceilTick(MonotonicTime time) const {
+  return std::chrono::ceil<std::chrono::milliseconds>(time - origin_).count();
+}
+
+void TimerWheel::enable(WheelTimer& timer, std::chrono::milliseconds duration) {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (size_ == 0) {
+    // Nothing is held by the wheel, so the ticks elapsed since it was last run can be skipped.
+    current_tick_ = std::max(current_tick_, floorTick(now));
+  }
+  timer.expiry_tick_ = std::max(ceilTick(now + duration), current_tick_);
+  insert(timer, current_tick_);
+  ++size_;
+  if (processing_) {
+    // The real timer is set once the current run of the wheel completes.
+    return;
+  }
+  // A timer in an upper wheel is processed when the first wheel starts a new turn.
+  armTimer(timer.slot_ < (1 << FirstWheelBits)
+               ? timer.expiry_tick_
+               : (current_tick_ + span(0) - 1) & ~(span(0) - 1),
+           false);
+}
+
+void TimerWheel::insert(WheelTimer& timer, uint64_t base) {
+  ASSERT(timer.expiry_tick_ >= base);
+  const uint64_t delta = timer.expiry_tick_ - base;
+  for (uint32_t wheel = 0; wheel < NumWheels; ++wheel) {
+    if (delta < span(wheel)) {
+      link(timer, slotIndex(wheel, timer.expiry_tick_));
+      return;
+    }
+  }
+  // Too far away for the wheels: park the timer in the last slot that can be reached, from which
+  // it is inserted again.
+  link(timer, slotIndex(NumWheels - 1, base + span(NumWheels - 1) - 1));
+}
+
+void TimerWheel::link(WheelTimer& timer, uint32_t slot) {
+  ASSERT(!timer.enabled_);
+  timer.slot_ = slot;
+  timer.prev_ = nullptr;
+  timer.next_ = slots_[slot];
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = &timer;
+  }
+  slots_[slot] = &timer;
+  timer.enabled_ = true;
+  if (slot != ExpiringSlot) {
+    ++wheel_sizes_[slot < (1 << FirstWheelBits)
+                       ? 0
+                       : 1 + (slot - (1 << FirstWheelBits)) / (1 << WheelBits)];
+  }
+}
+
+void TimerWheel::unlink(WheelTimer& timer) {
+  ASSERT(timer.enabled_);
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    slots_[timer.slot_] = timer.next_;
+  }
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = timer.prev_;
+  }
+  timer.enabled_ = false;
+  if (timer.slot_ != ExpiringSlot) {
+    --wheel_sizes_[timer.slot_ < (1 << FirstWheelBits)
+                       ? 0
+                       : 1 + (timer.slot_ - (1 << FirstWheelBits)) / (1 << WheelBits)];
+  }
+  if (--size_ == 0 && !processing_) {
+    timer_->disableTimer();
+    wake_tick_.reset();
+  }
+}
+
+void TimerWheel::cascade(uint64_t tick) {
+  // Upper wheels first, as their timers can move into the slots of the wheels below.
+  for (uint32_t wheel = NumWheels - 1; wheel > 0; --wheel) {
+    if ((tick & ((uint64_t(1) << shift(wheel)) - 1)) != 0 || wheel_sizes_[wheel] == 0) {
+      continue;
+    }
+    const uint32_t slot = slotIndex(wheel, tick);
+    while (slots_[slot] != nullptr) {
+      WheelTimer& timer = *slots_[slot];
+      unlink(timer);
+      insert(timer, tick);
+      ++size_;
+    }
+  }
+}
+
+void TimerWheel::run(uint64_t tick) {
+  const uint32_t slot = slotIndex(0, tick);
+  if (slots_[slot] == nullptr) {
+    return;
+  }
+  // Move the timers to the expiring slot, so that the callbacks can disable any of them.
+  ASSERT(slots_[ExpiringSlot] == nullptr);
+  slots_[ExpiringSlot] = std::exchange(slots_[slot], nullptr);
+  for (WheelTimer* timer = slots_[ExpiringSlot]; timer != nullptr; timer = timer->next_) {
+    ASSERT(timer->expiry_tick_ == tick);
+    timer->slot_ = ExpiringSlot;
+    --wheel_sizes_[0];
+  }
+  while (slots_[ExpiringSlot] != nullptr) {
+    WheelTimer& timer = *slots_[ExpiringSlot];
+    unlink(timer);
+    timer.fire();
+  }
+}
+
+void TimerWheel::onTimer() {
+  wake_tick_.reset();
+  const uint64_t now_tick = floorTick(dispatcher_.timeSource().monotonicTime());
+  processing_ = true;
+  while (current_tick_ <= now_tick && size_ > 0) {
+    if (wheel_sizes_[0] == 0) {
+      // Nothing expires before the first wheel starts a new turn.
+      const uint64_t turn = (current_tick_ + span(0) - 1) & ~(span(0) - 1);
+      if (turn > now_tick) {
+        current_tick_ = now_tick + 1;
+        break;
+      }
+      current_tick_ = turn;
+    }
+    const uint64_t tick = current_tick_;
+    cascade(tick);
+    current_tick_ = tick + 1;
+    run(tick);
+  }
+  processing_ = false;
+
+  const absl::optional<uint64_t> next = nextTick();
+  if (next.has_value()) {
+    armTimer(*next, true);
+  } else {
+    timer_->disableTimer();
+  }
+}
+
+void TimerWheel::armTimer(uint64_t tick, bool reset) {
+  if (!reset && wake_tick_.has_value() && *wake_tick_ <= tick) {
+    return;
+  }
+  wake_tick_ = tick;
+  const MonotonicTime wake_time = origin_ + std::chrono::milliseconds(tick);
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  // Set with microsecond precision, so that the rounding of the expiry times is the only delay.
+  timer_->enableHRTimer(wake_time > now
+                            ? std::chrono::ceil<std::chrono::microseconds>(wake_time - now)
+                            : std::chrono::microseconds::zero());
+}
+
+absl::optional<uint64_t> TimerWheel::nextTick() const {
+  if (size_ == 0) {
+    return absl::nullopt;
+  }
+  const bool upper_wheels = size_ > wheel_sizes_[0];
+  for (uint64_t tick = current_tick_;; ++tick) {
+    if ((upper_wheels && (tick & (span(0) - 1)) == 0) || slots_[slotIndex(0, tick)] != nullptr) {
+      return tick;
+    }
+  }
+}
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A hierarchical timing wheel holding timers of millisecond granularity, for the large numbers of
+ * coarse timeouts held by connections and streams.
+ *
+ * Timers are kept in intrusive lists, in slots of 4 wheels. The first wheel has one slot per
+ * millisecond for the next 256ms. Each of the other wheels has 64 slots, each covering a whole
+ * turn of the wheel below it, so that the wheels cover about 18 hours. Timers further away are
+ * kept in the last slot of the last wheel until they get closer. Enabling and disabling a timer is
+ * constant time, whatever the number of timers. When the first wheel moves into a new turn, the
+ * matching slot of the wheel above is moved down into the lower wheels.
+ *
+ * The wheel is driven by a single real Timer of the dispatcher, which is set for the next slot
+ * holding timers, or for the next turn of the first wheel if only the other wheels hold timers.
+ *
+ * Expiry times are rounded up to the next millisecond, so that timers never fire early. A timer
+ * enabled for 0ms from a callback of the wheel fires at the next millisecond at the earliest, so
+ * that callbacks enabling their own timer don't keep the wheel running.
+ */
+class TimerWheel : NonCopyable {
+public:
+  static constexpr uint32_t FirstWheelBits = 8;
+  static constexpr uint32_t WheelBits = 6;
+  static constexpr uint32_t NumWheels = 4;
+
+  explicit TimerWheel(Dispatcher& dispatcher);
+  ~TimerWheel();
+
+  /**
+   * Creates a timer held by this wheel. Timers must be destroyed before the wheel.
+   */
+  TimerPtr createTimer(TimerCb callback);
+
+  /**
+   * @return the number of enabled timers.
+   */
+  size_t size() const { return size_; }
+
+private:
+  class WheelTimer;
+
+  // First wheel, then one slot for the timers being run.
+  static constexpr uint32_t NumSlots =
+      (1 << FirstWheelBits) + (NumWheels - 1) * (1 << WheelBits) + 1;
+  static constexpr uint32_t ExpiringSlot = NumSlots - 1;
+
+  // Bits of the tick dropped to get the slots of a wheel.
+  static constexpr uint32_t shift(uint32_t wheel) {
+    return wheel == 0 ? 0 : FirstWheelBits + (wheel - 1) * WheelBits;
+  }
+  // The number of ticks that can be held from the start of a wheel to the end of the wheel.
+  static constexpr uint64_t span(uint32_t wheel) {
+    return uint64_t(1) << (FirstWheelBits + wheel * WheelBits);
+  }
+  static uint32_t slotIndex(uint32_t wheel, uint64_t tick);
+
+  uint64_t floorTick(MonotonicTime time) const;
+  uint64_t ceilTick(MonotonicTime time) const;
+
+  void enable(WheelTimer& timer, std::chrono::milliseconds duration);
+  // Adds the timer to the slot of its expiry tick, relative to the base tick.
+  void insert(WheelTimer& timer, uint64_t base);
+  void link(WheelTimer& timer, uint32_t slot);
+  void unlink(WheelTimer& timer);
+  // Moves the timers of the upper wheels that are due in the turn of the first wheel starting at
+  // the tick.
+  void cascade(uint64_t tick);
+  void run(uint64_t tick);
+  void onTimer();
+  // Sets the real timer for the next tick to process. Only moves the real timer earlier unless
+  // `reset` is set.
+  void armTimer(uint64_t tick, bool reset);
+  absl::optional<uint64_t> nextTick() const;
+
+  Dispatcher& dispatcher_;
+  const MonotonicTime origin_;
+  const TimerPtr timer_;
+  std::array<WheelTimer*, NumSlots> slots_{};
+  std::array<size_t, NumWheels> wheel_sizes_{};
+  size_t size_{};
+  // The next tick to process. Earlier ticks have been processed.
+  uint64_t current_tick_{};
+  // The tick the real timer is set for, if it is enabled.
+  absl::optional<uint64_t> wake_tick_;
+  bool processing_{};
+};
+
+} // namespace Event
+} // namespace Envoy
@@ -21,6 +21,21 @@ Api::IoError::IoErrorCode IoFileError::getErrorCode() const {
 
 std::string IoFileError::getErrorDetails() const { return errorDetails(errno_); }
 
+Api::IoCallSizeResult FileSharedImpl::writev(absl::Span<const absl::string_view> buffers) {
+  ssize_t written = 0;
+  for (const absl::string_view buffer : buffers) {
+    Api::IoCallSizeResult result = write(buffer);
+    if (!result.ok()) {
+      return result;
+    }
+    written += result.return_value_;
+    if (result.return_value_ != static_cast<ssize_t>(buffer.size())) {
+      break;
+    }
+  }
+  return resultSuccess(written);
+}
+
 bool FileSharedImpl::isOpen() const { return fd_ != INVALID_HANDLE; };
 
 std::string FileSharedImpl::path() const { return filepath_and_type_.path_; };
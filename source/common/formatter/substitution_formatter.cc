@@ -2,8 +2,10 @@
 
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
 #include <regex>
@@ -23,6 +25,7 @@
 #include "source/common/grpc/common.h"
 #include "source/common/grpc/status.h"
 #include "source/common/http/utility.h"
+#include "source/common/json/json_sanitizer.h"
 #include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
@@ -58,6 +61,79 @@ const std::regex& getSystemTimeFormatNewlinePattern() {
 }
 const std::regex& getNewlinePattern() { CONSTRUCT_ON_FIRST_USE(std::regex, "\n"); }
 
+void appendJsonString(absl::string_view value, std::string& sanitize_buffer, std::string& output) {
+  output.push_back('"');
+  output.append(Json::sanitize(sanitize_buffer, value));
+  output.push_back('"');
+}
+
+// Appends a number like the protobuf JSON printer, with the shorter of 15 and 17 digits that
+// round trips. JSON has no infinities or NaN, which are written as null.
+void appendJsonNumber(double value, std::string& output) {
+  if (!std::isfinite(value)) {
+    output.append("null");
+    return;
+  }
+
+  char buffer[32];
+  int length = snprintf(buffer, sizeof(buffer), "%.15g", value);
+  if (strtod(buffer, nullptr) != value) {
+    length = snprintf(buffer, sizeof(buffer), "%.17g", value);
+  }
+  output.append(buffer, length);
+}
+
+void appendJsonValue(const ProtobufWkt::Value& value, std::string& sanitize_buffer,
+                     std::string& output) {
+  switch (value.kind_case()) {
+  case ProtobufWkt::Value::kNumberValue:
+    appendJsonNumber(value.number_value(), output);
+    break;
+
+  case ProtobufWkt::Value::kStringValue:
+    appendJsonString(value.string_value(), sanitize_buffer, output);
+    break;
+
+  case ProtobufWkt::Value::kBoolValue:
+    output.append(value.bool_value() ? "true" : "false");
+    break;
+
+  case ProtobufWkt::Value::kStructValue: {
+    output.push_back('{');
+    bool first = true;
+    for (const auto& field : value.struct_value().fields()) {
+      if (!first) {
+        output.push_back(',');
+      }
+      first = false;
+      appendJsonString(field.first, sanitize_buffer, output);
+      output.push_back(':');
+      appendJsonValue(field.second, sanitize_buffer, output);
+    }
+    output.push_back('}');
+    break;
+  }
+
+  case ProtobufWkt::Value::kListValue: {
+    output.push_back('[');
+    bool first = true;
+    for (const ProtobufWkt::Value& element : value.list_value().values()) {
+      if (!first) {
+        output.push_back(',');
+      }
+      first = false;
+      appendJsonValue(element, sanitize_buffer, output);
+    }
+    output.push_back(']');
+    break;
+  }
+
+  default:
+    output.append("null");
+    break;
+  }
+}
+
 } // namespace
 
 const std::string SubstitutionFormatUtils::DEFAULT_FORMAT =
@@ -117,12 +193,39 @@ const std::string SubstitutionFormatUtils::getHostnameOrDefault() {
 FormatterImpl::FormatterImpl(const std::string& format, bool omit_empty_values)
     : empty_value_string_(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueString) {
   providers_ = SubstitutionFormatParser::parse(format);
+  mergeConstantProviders();
 }
 
 FormatterImpl::FormatterImpl(const std::string& format, bool omit_empty_values,
                              const std::vector<CommandParserPtr>& command_parsers)
     : empty_value_string_(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueString) {
   providers_ = SubstitutionFormatParser::parse(format, command_parsers);
+  mergeConstantProviders();
+}
+
+void FormatterImpl::mergeConstantProviders() {
+  std::vector<FormatterProviderPtr> providers;
+  std::string constant;
+  for (FormatterProviderPtr& provider : providers_) {
+    const absl::optional<std::string> value = provider->constantValue();
+    if (value.has_value()) {
+      constant.append(value.value());
+      continue;
+    }
+    if (!constant.empty()) {
+      providers.push_back(std::make_unique<PlainStringFormatter>(constant));
+      constant.clear();
+    }
+    providers.push_back(std::move(provider));
+  }
+
+  if (providers.empty()) {
+    constant_value_ = constant;
+  }
+  if (!constant.empty()) {
+    providers.push_back(std::make_unique<PlainStringFormatter>(constant));
+  }
+  providers_ = std::move(providers);
 }
 
 std::string FormatterImpl::format(const Http::RequestHeaderMap& request_headers,
@@ -132,21 +235,50 @@ std::string FormatterImpl::format(const Http::RequestHeaderMap& request_headers,
                                   absl::string_view local_reply_body) const {
   std::string log_line;
   log_line.reserve(256);
+  formatTo(request_headers, response_headers, response_trailers, stream_info, local_reply_body,
+           log_line);
+  return log_line;
+}
 
+void FormatterImpl::formatTo(const Http::RequestHeaderMap& request_headers,
+                             const Http::ResponseHeaderMap& response_headers,
+                             const Http::ResponseTrailerMap& response_trailers,
+                             const StreamInfo::StreamInfo& stream_info,
+                             absl::string_view local_reply_body, std::string& output) const {
   for (const FormatterProviderPtr& provider : providers_) {
-    const auto bit = provider->format(request_headers, response_headers, response_trailers,
-                                      stream_info, local_reply_body);
-    log_line += bit.value_or(empty_value_string_);
+    if (!provider->formatTo(request_headers, response_headers, response_trailers, stream_info,
+                            local_reply_body, output)) {
+      output.append(empty_value_string_);
+    }
   }
-
-  return log_line;
 }
 
+JsonFormatterImpl::JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping,
+                                     bool preserve_types, bool omit_empty_values)
+    : struct_formatter_(format_mapping, preserve_types, omit_empty_values),
+      direct_json_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.direct_json_access_log_formatter")) {}
+
+JsonFormatterImpl::JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping,
+                                     bool preserve_types, bool omit_empty_values,
+                                     const std::vector<CommandParserPtr>& commands)
+    : struct_formatter_(format_mapping, preserve_types, omit_empty_values, commands),
+      direct_json_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.direct_json_access_log_formatter")) {}
+
 std::string JsonFormatterImpl::format(const Http::RequestHeaderMap& request_headers,
                                       const Http::ResponseHeaderMap& response_headers,
                                       const Http::ResponseTrailerMap& response_trailers,
                                       const StreamInfo::StreamInfo& stream_info,
                                       absl::string_view local_reply_body) const {
+  if (direct_json_) {
+    std::string log_line;
+    log_line.reserve(256);
+    formatTo(request_headers, response_headers, response_trailers, stream_info, local_reply_body,
+             log_line);
+    return log_line;
+  }
+
   const ProtobufWkt::Struct output_struct = struct_formatter_.format(
       request_headers, response_headers, response_trailers, stream_info, local_reply_body);
 
@@ -155,6 +287,22 @@ std::string JsonFormatterImpl::format(const Http::RequestHeaderMap& request_head
   return absl::StrCat(log_line, "\n");
 }
 
+void JsonFormatterImpl::formatTo(const Http::RequestHeaderMap& request_headers,
+                                 const Http::ResponseHeaderMap& response_headers,
+                                 const Http::ResponseTrailerMap& response_trailers,
+                                 const StreamInfo::StreamInfo& stream_info,
+                                 absl::string_view local_reply_body, std::string& output) const {
+  if (!direct_json_) {
+    output.append(format(request_headers, response_headers, response_trailers, stream_info,
+                         local_reply_body));
+    return;
+  }
+
+  struct_formatter_.formatJson(request_headers, response_headers, response_trailers, stream_info,
+                               local_reply_body, output);
+  output.push_back('\n');
+}
+
 StructFormatter::StructFormatter(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
                                  bool omit_empty_values,
                                  const std::vector<CommandParserPtr>& commands)
@@ -323,6 +471,146 @@ ProtobufWkt::Struct StructFormatter::format(const Http::RequestHeaderMap& reques
   return structFormatMapCallback(struct_output_format_, visitor).struct_value();
 }
 
+struct StructFormatter::JsonContext {
+  JsonContext(const Http::RequestHeaderMap& request_headers,
+              const Http::ResponseHeaderMap& response_headers,
+              const Http::ResponseTrailerMap& response_trailers,
+              const StreamInfo::StreamInfo& stream_info, absl::string_view local_reply_body,
+              std::string& output)
+      : request_headers_(request_headers), response_headers_(response_headers),
+        response_trailers_(response_trailers), stream_info_(stream_info),
+        local_reply_body_(local_reply_body), output_(output) {}
+
+  const Http::RequestHeaderMap& request_headers_;
+  const Http::ResponseHeaderMap& response_headers_;
+  const Http::ResponseTrailerMap& response_trailers_;
+  const StreamInfo::StreamInfo& stream_info_;
+  const absl::string_view local_reply_body_;
+  std::string& output_;
+  // Reused for the string values and their escaping.
+  std::string value_;
+  std::string sanitize_buffer_;
+};
+
+void StructFormatter::formatJson(const Http::RequestHeaderMap& request_headers,
+                                 const Http::ResponseHeaderMap& response_headers,
+                                 const Http::ResponseTrailerMap& response_trailers,
+                                 const StreamInfo::StreamInfo& stream_info,
+                                 absl::string_view local_reply_body, std::string& output) const {
+  JsonContext context(request_headers, response_headers, response_trailers, stream_info,
+                      local_reply_body, output);
+  const size_t start = output.size();
+  if (writeJsonMap(struct_output_format_, context)) {
+    // All the fields were omitted.
+    output.resize(start);
+    output.append("{}");
+  }
+}
+
+bool StructFormatter::writeJsonValue(const StructFormatValue& value, JsonContext& context) const {
+  return absl::visit(
+      StructFormatMapVisitorHelper{
+          [&](const std::vector<FormatterProviderPtr>& providers) {
+            return writeJsonProviders(providers, context);
+          },
+          [&](const StructFormatMapWrapper& format_map) {
+            return writeJsonMap(format_map, context);
+          },
+          [&](const StructFormatListWrapper& format_list) {
+            return writeJsonList(format_list, context);
+          },
+      },
+      value);
+}
+
+bool StructFormatter::writeJsonProviders(const std::vector<FormatterProviderPtr>& providers,
+                                         JsonContext& context) const {
+  ASSERT(!providers.empty());
+  if (providers.size() == 1) {
+    const auto& provider = providers.front();
+    if (preserve_types_) {
+      const ProtobufWkt::Value value =
+          provider->formatValue(context.request_headers_, context.response_headers_,
+                                context.response_trailers_, context.stream_info_,
+                                context.local_reply_body_);
+      appendJsonValue(value, context.sanitize_buffer_, context.output_);
+      return value.kind_case() == ProtobufWkt::Value::kNullValue;
+    }
+
+    context.value_.clear();
+    if (!provider->formatTo(context.request_headers_, context.response_headers_,
+                            context.response_trailers_, context.stream_info_,
+                            context.local_reply_body_, context.value_)) {
+      if (omit_empty_values_) {
+        context.output_.append("null");
+        return true;
+      }
+      context.value_.append(DefaultUnspecifiedValueString);
+    }
+    appendJsonString(context.value_, context.sanitize_buffer_, context.output_);
+    return false;
+  }
+  // Multiple providers forces string output.
+  context.value_.clear();
+  for (const auto& provider : providers) {
+    if (!provider->formatTo(context.request_headers_, context.response_headers_,
+                            context.response_trailers_, context.stream_info_,
+                            context.local_reply_body_, context.value_)) {
+      context.value_.append(empty_value_);
+    }
+  }
+  appendJsonString(context.value_, context.sanitize_buffer_, context.output_);
+  return false;
+}
+
+bool StructFormatter::writeJsonMap(const StructFormatMapWrapper& format_map,
+                                   JsonContext& context) const {
+  std::string& output = context.output_;
+  const size_t start = output.size();
+  output.push_back('{');
+  bool empty = true;
+  for (const auto& pair : *format_map.value_) {
+    const size_t field_start = output.size();
+    if (!empty) {
+      output.push_back(',');
+    }
+    appendJsonString(pair.first, context.sanitize_buffer_, output);
+    output.push_back(':');
+    if (writeJsonValue(pair.second, context) && omit_empty_values_) {
+      output.resize(field_start);
+      continue;
+    }
+    empty = false;
+  }
+  if (omit_empty_values_ && empty) {
+    output.resize(start);
+    output.append("null");
+    return true;
+  }
+  output.push_back('}');
+  return false;
+}
+
+bool StructFormatter::writeJsonList(const StructFormatListWrapper& format_list,
+                                    JsonContext& context) const {
+  std::string& output = context.output_;
+  output.push_back('[');
+  bool empty = true;
+  for (const auto& value : *format_list.value_) {
+    const size_t element_start = output.size();
+    if (!empty) {
+      output.push_back(',');
+    }
+    if (writeJsonValue(value, context) && omit_empty_values_) {
+      output.resize(element_start);
+      continue;
+    }
+    empty = false;
+  }
+  output.push_back(']');
+  return false;
+}
+
 void SubstitutionFormatParser::parseSubcommandHeaders(const std::string& subcommand,
                                                       std::string& main_header,
                                                       std::string& alternative_header) {
@@ -695,6 +983,16 @@ public:
 
     return fmt::format_int(millis.value()).str();
   }
+  bool extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      return false;
+    }
+
+    const fmt::format_int formatted(millis.value());
+    output.append(formatted.data(), formatted.size());
+    return true;
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     const auto millis = extractMillis(stream_info);
     if (!millis) {
@@ -727,6 +1025,11 @@ public:
   absl::optional<std::string> extract(const StreamInfo::StreamInfo& stream_info) const override {
     return fmt::format_int(field_extractor_(stream_info)).str();
   }
+  bool extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const fmt::format_int formatted(field_extractor_(stream_info));
+    output.append(formatted.data(), formatted.size());
+    return true;
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
@@ -769,6 +1072,20 @@ public:
 
     return toString(*address);
   }
+  bool extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
+    if (!address) {
+      return false;
+    }
+
+    if (extraction_type_ == StreamInfoFormatter::StreamInfoAddressFieldExtractionType::WithPort) {
+      // The address caches its string form.
+      output.append(address->asStringView());
+    } else {
+      output.append(toString(*address));
+    }
+    return true;
+  }
   ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo& stream_info) const override {
     Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
     if (!address) {
@@ -1605,6 +1922,13 @@ absl::optional<std::string> StreamInfoFormatter::format(const Http::RequestHeade
   return field_extractor_->extract(stream_info);
 }
 
+bool StreamInfoFormatter::formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                   const Http::ResponseTrailerMap&,
+                                   const StreamInfo::StreamInfo& stream_info, absl::string_view,
+                                   std::string& output) const {
+  return field_extractor_->extractTo(stream_info, output);
+}
+
 ProtobufWkt::Value StreamInfoFormatter::formatValue(const Http::RequestHeaderMap&,
                                                     const Http::ResponseHeaderMap&,
                                                     const Http::ResponseTrailerMap&,
@@ -1631,6 +1955,13 @@ ProtobufWkt::Value PlainStringFormatter::formatValue(const Http::RequestHeaderMa
   return str_;
 }
 
+bool PlainStringFormatter::formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                    const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
+                                    absl::string_view, std::string& output) const {
+  output.append(str_.string_value());
+  return true;
+}
+
 PlainNumberFormatter::PlainNumberFormatter(double num) { num_.set_number_value(num); }
 
 absl::optional<std::string> PlainNumberFormatter::format(const Http::RequestHeaderMap&,
@@ -1650,6 +1981,13 @@ ProtobufWkt::Value PlainNumberFormatter::formatValue(const Http::RequestHeaderMa
   return num_;
 }
 
+bool PlainNumberFormatter::formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                    const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
+                                    absl::string_view, std::string& output) const {
+  absl::StrAppendFormat(&output, "%g", num_.number_value());
+  return true;
+}
+
 absl::optional<std::string>
 LocalReplyBodyFormatter::format(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                 const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
@@ -1665,6 +2003,16 @@ ProtobufWkt::Value LocalReplyBodyFormatter::formatValue(const Http::RequestHeade
   return ValueUtil::stringValue(std::string(local_reply_body));
 }
 
+bool LocalReplyBodyFormatter::formatTo(const Http::RequestHeaderMap&,
+                                       const Http::ResponseHeaderMap&,
+                                       const Http::ResponseTrailerMap&,
+                                       const StreamInfo::StreamInfo&,
+                                       absl::string_view local_reply_body,
+                                       std::string& output) const {
+  output.append(local_reply_body);
+  return true;
+}
+
 HeaderFormatter::HeaderFormatter(const std::string& main_header,
                                  const std::string& alternative_header,
                                  absl::optional<size_t> max_length)
@@ -1704,6 +2052,20 @@ ProtobufWkt::Value HeaderFormatter::formatValue(const Http::HeaderMap& headers)
   return ValueUtil::stringValue(val);
 }
 
+bool HeaderFormatter::formatTo(const Http::HeaderMap& headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    return false;
+  }
+
+  absl::string_view val = header->value().getStringView();
+  if (max_length_) {
+    val = val.substr(0, max_length_.value());
+  }
+  output.append(val);
+  return true;
+}
+
 ResponseHeaderFormatter::ResponseHeaderFormatter(const std::string& main_header,
                                                  const std::string& alternative_header,
                                                  absl::optional<size_t> max_length)
@@ -1721,6 +2083,14 @@ ProtobufWkt::Value ResponseHeaderFormatter::formatValue(
   return HeaderFormatter::formatValue(response_headers);
 }
 
+bool ResponseHeaderFormatter::formatTo(const Http::RequestHeaderMap&,
+                                       const Http::ResponseHeaderMap& response_headers,
+                                       const Http::ResponseTrailerMap&,
+                                       const StreamInfo::StreamInfo&, absl::string_view,
+                                       std::string& output) const {
+  return HeaderFormatter::formatTo(response_headers, output);
+}
+
 RequestHeaderFormatter::RequestHeaderFormatter(const std::string& main_header,
                                                const std::string& alternative_header,
                                                absl::optional<size_t> max_length)
@@ -1740,6 +2110,14 @@ RequestHeaderFormatter::formatValue(const Http::RequestHeaderMap& request_header
   return HeaderFormatter::formatValue(request_headers);
 }
 
+bool RequestHeaderFormatter::formatTo(const Http::RequestHeaderMap& request_headers,
+                                      const Http::ResponseHeaderMap&,
+                                      const Http::ResponseTrailerMap&,
+                                      const StreamInfo::StreamInfo&, absl::string_view,
+                                      std::string& output) const {
+  return HeaderFormatter::formatTo(request_headers, output);
+}
+
 ResponseTrailerFormatter::ResponseTrailerFormatter(const std::string& main_header,
                                                    const std::string& alternative_header,
                                                    absl::optional<size_t> max_length)
@@ -1759,6 +2137,14 @@ ResponseTrailerFormatter::formatValue(const Http::RequestHeaderMap&, const Http:
   return HeaderFormatter::formatValue(response_trailers);
 }
 
+bool ResponseTrailerFormatter::formatTo(const Http::RequestHeaderMap&,
+                                        const Http::ResponseHeaderMap&,
+                                        const Http::ResponseTrailerMap& response_trailers,
+                                        const StreamInfo::StreamInfo&, absl::string_view,
+                                        std::string& output) const {
+  return HeaderFormatter::formatTo(response_trailers, output);
+}
+
 HeadersByteSizeFormatter::HeadersByteSizeFormatter(const HeaderType header_type)
     : header_type_(header_type) {}
 
@@ -2247,5 +2633,11 @@ ProtobufWkt::Value StreamInfoRequestHeaderFormatter::formatValue(
   return HeaderFormatter::formatValue(*stream_info.getRequestHeaders());
 }
 
+bool StreamInfoRequestHeaderFormatter::formatTo(
+    const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&, const Http::ResponseTrailerMap&,
+    const StreamInfo::StreamInfo& stream_info, absl::string_view, std::string& output) const {
+  return HeaderFormatter::formatTo(*stream_info.getRequestHeaders(), output);
+}
+
 } // namespace Formatter
 } // namespace Envoy
@@ -150,10 +150,22 @@ public:
                      const Http::ResponseTrailerMap& response_trailers,
                      const StreamInfo::StreamInfo& stream_info,
                      absl::string_view local_reply_body) const override;
+  void formatTo(const Http::RequestHeaderMap& request_headers,
+                const Http::ResponseHeaderMap& response_headers,
+                const Http::ResponseTrailerMap& response_trailers,
+                const StreamInfo::StreamInfo& stream_info, absl::string_view local_reply_body,
+                std::string& output) const override;
+  absl::optional<std::string> constantValue() const override { return constant_value_; }
 
 private:
+  // Replaces each run of constant providers with a single plain string provider, so that only the
+  // providers depending on the headers/trailers/stream are evaluated per line.
+  void mergeConstantProviders();
+
   const std::string& empty_value_string_;
   std::vector<FormatterProviderPtr> providers_;
+  // The whole line when all the providers are constant.
+  absl::optional<std::string> constant_value_;
 };
 
 // Helper classes for StructFormatter::StructFormatMapVisitor.
@@ -177,6 +189,17 @@ public:
                              const StreamInfo::StreamInfo& stream_info,
                              absl::string_view local_reply_body) const;
 
+  /**
+   * Appends the formatted structure to output as a JSON object, like the serialization of the
+   * Struct returned by format() but without building it. The fields are written in the order of
+   * their keys.
+   */
+  void formatJson(const Http::RequestHeaderMap& request_headers,
+                  const Http::ResponseHeaderMap& response_headers,
+                  const Http::ResponseTrailerMap& response_trailers,
+                  const StreamInfo::StreamInfo& stream_info, absl::string_view local_reply_body,
+                  std::string& output) const;
+
 private:
   struct StructFormatMapWrapper;
   struct StructFormatListWrapper;
@@ -232,6 +255,14 @@ private:
   structFormatListCallback(const StructFormatter::StructFormatListWrapper& format_list,
                            const StructFormatMapVisitor& visitor) const;
 
+  // Methods for writing JSON directly, which return whether the value they wrote is null.
+  struct JsonContext;
+  bool writeJsonValue(const StructFormatValue& value, JsonContext& context) const;
+  bool writeJsonProviders(const std::vector<FormatterProviderPtr>& providers,
+                          JsonContext& context) const;
+  bool writeJsonMap(const StructFormatMapWrapper& format_map, JsonContext& context) const;
+  bool writeJsonList(const StructFormatListWrapper& format_list, JsonContext& context) const;
+
   const bool omit_empty_values_;
   const bool preserve_types_;
   const std::string empty_value_;
@@ -244,11 +275,9 @@ using StructFormatterPtr = std::unique_ptr<StructFormatter>;
 class JsonFormatterImpl : public Formatter {
 public:
   JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
-                    bool omit_empty_values)
-      : struct_formatter_(format_mapping, preserve_types, omit_empty_values) {}
+                    bool omit_empty_values);
   JsonFormatterImpl(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
-                    bool omit_empty_values, const std::vector<CommandParserPtr>& commands)
-      : struct_formatter_(format_mapping, preserve_types, omit_empty_values, commands) {}
+                    bool omit_empty_values, const std::vector<CommandParserPtr>& commands);
 
   // Formatter::format
   std::string format(const Http::RequestHeaderMap& request_headers,
@@ -256,9 +285,16 @@ public:
                      const Http::ResponseTrailerMap& response_trailers,
                      const StreamInfo::StreamInfo& stream_info,
                      absl::string_view local_reply_body) const override;
+  void formatTo(const Http::RequestHeaderMap& request_headers,
+                const Http::ResponseHeaderMap& response_headers,
+                const Http::ResponseTrailerMap& response_trailers,
+                const StreamInfo::StreamInfo& stream_info, absl::string_view local_reply_body,
+                std::string& output) const override;
 
 private:
   const StructFormatter struct_formatter_;
+  // Whether to write the JSON directly rather than serializing a Struct.
+  const bool direct_json_;
 };
 
 /**
@@ -276,6 +312,10 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  bool formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
+  absl::optional<std::string> constantValue() const override { return str_.string_value(); }
 
 private:
   ProtobufWkt::Value str_;
@@ -295,6 +335,9 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  bool formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
 
 private:
   ProtobufWkt::Value num_;
@@ -314,6 +357,9 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view local_reply_body) const override;
+  bool formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
+                absl::string_view local_reply_body, std::string& output) const override;
 };
 
 class HeaderFormatter {
@@ -324,6 +370,7 @@ public:
 protected:
   absl::optional<std::string> format(const Http::HeaderMap& headers) const;
   ProtobufWkt::Value formatValue(const Http::HeaderMap& headers) const;
+  bool formatTo(const Http::HeaderMap& headers, std::string& output) const;
 
 private:
   const Http::HeaderEntry* findHeader(const Http::HeaderMap& headers) const;
@@ -376,6 +423,9 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  bool formatTo(const Http::RequestHeaderMap& request_headers, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
 };
 
 /**
@@ -394,6 +444,9 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  bool formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap& response_headers,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
 };
 
 /**
@@ -412,6 +465,9 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  bool formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap& response_trailers, const StreamInfo::StreamInfo&,
+                absl::string_view, std::string& output) const override;
 };
 
 class GrpcStatusFormatter : public FormatterProvider, HeaderFormatter {
@@ -456,6 +512,9 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  bool formatTo(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo& stream_info,
+                absl::string_view, std::string& output) const override;
 
   class FieldExtractor {
   public:
@@ -463,6 +522,15 @@ public:
 
     virtual absl::optional<std::string> extract(const StreamInfo::StreamInfo&) const PURE;
     virtual ProtobufWkt::Value extractValue(const StreamInfo::StreamInfo&) const PURE;
+    // Appends the field to output, returning false and appending nothing if the field is unset.
+    virtual bool extractTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const {
+      const absl::optional<std::string> value = extract(stream_info);
+      if (!value.has_value()) {
+        return false;
+      }
+      output.append(value.value());
+      return true;
+    }
   };
   using FieldExtractorPtr = std::unique_ptr<FieldExtractor>;
   using FieldExtractorCreateFunc =
@@ -656,6 +724,8 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  // The environment is read once, when the formatter is created.
+  absl::optional<std::string> constantValue() const override { return str_.string_value(); }
 
 private:
   ProtobufWkt::Value str_;
@@ -679,6 +749,9 @@ public:
   ProtobufWkt::Value formatValue(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
                                  const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&,
                                  absl::string_view) const override;
+  bool formatTo(const Http::RequestHeaderMap& request_headers, const Http::ResponseHeaderMap&,
+                const Http::ResponseTrailerMap&, const StreamInfo::StreamInfo&, absl::string_view,
+                std::string& output) const override;
 };
 
 } // namespace Formatter
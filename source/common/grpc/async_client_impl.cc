@@ -30,6 +30,22 @@ AsyncClientImpl::~AsyncClientImpl() {
   }
 }
 
+const AsyncClientImpl::MethodInfoConstSharedPtr&
+AsyncClientImpl::methodInfo(absl::string_view service_full_name, absl::string_view method_name) {
+  auto& method_infos = method_infos_[service_full_name];
+  auto it = method_infos.find(method_name);
+  if (it == method_infos.end()) {
+    it = method_infos
+             .emplace(method_name,
+                      std::make_shared<const MethodInfo>(MethodInfo{
+                          host_name_.empty() ? remote_cluster_name_ : host_name_,
+                          absl::StrCat("/", service_full_name, "/", method_name),
+                          absl::StrCat("async ", service_full_name, ".", method_name, " egress")}))
+             .first;
+  }
+  return it->second;
+}
+
 AsyncRequest* AsyncClientImpl::sendRaw(absl::string_view service_full_name,
                                        absl::string_view method_name, Buffer::InstancePtr&& request,
                                        RawAsyncRequestCallbacks& callbacks,
@@ -69,7 +85,7 @@ RawAsyncStream* AsyncClientImpl::startRaw(absl::string_view service_full_name,
 AsyncStreamImpl::AsyncStreamImpl(AsyncClientImpl& parent, absl::string_view service_full_name,
                                  absl::string_view method_name, RawAsyncStreamCallbacks& callbacks,
                                  const Http::AsyncClient::StreamOptions& options)
-    : parent_(parent), service_full_name_(service_full_name), method_name_(method_name),
+    : parent_(parent), method_info_(parent.methodInfo(service_full_name, method_name)),
       callbacks_(callbacks), options_(options) {}
 
 void AsyncStreamImpl::initialize(bool buffer_body_for_retry) {
@@ -92,20 +108,19 @@ void AsyncStreamImpl::initialize(bool buffer_body_for_retry) {
 
   // TODO(htuch): match Google gRPC base64 encoding behavior for *-bin headers, see
   // https://github.com/envoyproxy/envoy/pull/2444#discussion_r163914459.
-  headers_message_ = Common::prepareHeaders(
-      parent_.host_name_.empty() ? parent_.remote_cluster_name_ : parent_.host_name_,
-      service_full_name_, method_name_, options_.timeout);
+  headers_ = Http::RequestHeaderMapImpl::create();
+  Common::prepareHeaders(*headers_, method_info_->authority_, method_info_->path_,
+                         options_.timeout);
   // Fill service-wide initial metadata.
   // TODO(cpakulski): Find a better way to access requestHeaders after runtime guard
   // envoy_reloadable_features_unified_header_formatter runtime guard is deprecated and
   // request headers are not stored in stream_info.
   // Maybe put it to parent_context?
   // Since request headers may be empty, consider using Envoy::OptRef.
-  parent_.metadata_parser_->evaluateHeaders(headers_message_->headers(),
-                                            options_.parent_context.stream_info);
+  parent_.metadata_parser_->evaluateHeaders(*headers_, options_.parent_context.stream_info);
 
-  callbacks_.onCreateInitialMetadata(headers_message_->headers());
-  stream_->sendHeaders(headers_message_->headers(), false);
+  callbacks_.onCreateInitialMetadata(*headers_);
+  stream_->sendHeaders(*headers_, false);
 }
 
 // TODO(htuch): match Google gRPC base64 encoding behavior for *-bin headers, see
@@ -234,14 +249,10 @@ AsyncRequestImpl::AsyncRequestImpl(AsyncClientImpl& parent, absl::string_view se
     : AsyncStreamImpl(parent, service_full_name, method_name, *this, options),
       request_(std::move(request)), callbacks_(callbacks) {
 
-  current_span_ =
-      parent_span.spawnChild(Tracing::EgressConfig::get(),
-                             absl::StrCat("async ", service_full_name, ".", method_name, " egress"),
-                             parent.time_source_.systemTime());
+  current_span_ = parent_span.spawnChild(Tracing::EgressConfig::get(), methodInfo().span_name_,
+                                         parent.time_source_.systemTime());
   current_span_->setTag(Tracing::Tags::get().UpstreamCluster, parent.remote_cluster_name_);
-  current_span_->setTag(Tracing::Tags::get().UpstreamAddress, parent.host_name_.empty()
-                                                                  ? parent.remote_cluster_name_
-                                                                  : parent.host_name_);
+  current_span_->setTag(Tracing::Tags::get().UpstreamAddress, methodInfo().authority_);
   current_span_->setTag(Tracing::Tags::get().Component, Tracing::Tags::get().Proxy);
 }
 
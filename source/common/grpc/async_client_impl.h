@@ -12,6 +12,8 @@
 #include "source/common/http/async_client_impl.h"
 #include "source/common/router/header_parser.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Grpc {
 
@@ -36,7 +38,23 @@ public:
                            const Http::AsyncClient::StreamOptions& options) override;
   absl::string_view destination() override { return remote_cluster_name_; }
 
+  /**
+   * The strings built once per method for its calls. The request headers of the calls refer to
+   * them rather than copy them, and the calls share them so that they outlive the headers even if
+   * the client is destroyed first.
+   */
+  struct MethodInfo {
+    // The host header value in the http transport.
+    const std::string authority_;
+    const std::string path_;
+    const std::string span_name_;
+  };
+  using MethodInfoConstSharedPtr = std::shared_ptr<const MethodInfo>;
+
 private:
+  const MethodInfoConstSharedPtr& methodInfo(absl::string_view service_full_name,
+                                             absl::string_view method_name);
+
   Upstream::ClusterManager& cm_;
   const std::string remote_cluster_name_;
   // The host header value in the http transport.
@@ -44,6 +62,9 @@ private:
   std::list<AsyncStreamImplPtr> active_streams_;
   TimeSource& time_source_;
   Router::HeaderParserPtr metadata_parser_;
+  // The method infos by service and method names.
+  absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, MethodInfoConstSharedPtr>>
+      method_infos_;
 
   friend class AsyncRequestImpl;
   friend class AsyncStreamImpl;
@@ -79,6 +100,9 @@ public:
 
   bool hasResetStream() const { return http_reset_; }
 
+protected:
+  const AsyncClientImpl::MethodInfo& methodInfo() const { return *method_info_; }
+
 private:
   void streamError(Status::GrpcStatus grpc_status, const std::string& message);
   void streamError(Status::GrpcStatus grpc_status) { streamError(grpc_status, EMPTY_STRING); }
@@ -88,10 +112,9 @@ private:
                        const std::string& grpc_message);
 
   Event::Dispatcher* dispatcher_{};
-  Http::RequestMessagePtr headers_message_;
   AsyncClientImpl& parent_;
-  std::string service_full_name_;
-  std::string method_name_;
+  const AsyncClientImpl::MethodInfoConstSharedPtr method_info_;
+  Http::RequestHeaderMapPtr headers_;
   RawAsyncStreamCallbacks& callbacks_;
   Http::AsyncClient::StreamOptions options_;
   bool http_reset_{};
@@ -15,6 +15,7 @@
 #include "source/common/common/macros.h"
 #include "source/common/common/safe_memcpy.h"
 #include "source/common/common/utility.h"
+#include "source/common/grpc/codec.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/message_impl.h"
@@ -192,13 +193,17 @@ Buffer::InstancePtr Common::serializeToGrpcFrame(const Protobuf::Message& messag
 Buffer::InstancePtr Common::serializeMessage(const Protobuf::Message& message) {
   auto body = std::make_unique<Buffer::OwnedImpl>();
   const uint32_t size = message.ByteSize();
-  auto reservation = body->reserveSingleSlice(size);
-  ASSERT(reservation.slice().len_ >= size);
-  uint8_t* current = reinterpret_cast<uint8_t*>(reservation.slice().mem_);
+  // The message is written after room for the 5 byte header, which is drained again so that
+  // prependGrpcFrameHeader() writes the header into the same BufferFragment.
+  const uint32_t alloc_size = size + GRPC_FRAME_HEADER_SIZE;
+  auto reservation = body->reserveSingleSlice(alloc_size);
+  ASSERT(reservation.slice().len_ >= alloc_size);
+  uint8_t* current = reinterpret_cast<uint8_t*>(reservation.slice().mem_) + GRPC_FRAME_HEADER_SIZE;
   Protobuf::io::ArrayOutputStream stream(current, size, -1);
   Protobuf::io::CodedOutputStream codec_stream(&stream);
   message.SerializeWithCachedSizes(&codec_stream);
-  reservation.commit(size);
+  reservation.commit(alloc_size);
+  body->drain(GRPC_FRAME_HEADER_SIZE);
   return body;
 }
 
@@ -287,6 +292,21 @@ Common::prepareHeaders(const std::string& host_name, const std::string& service_
   return message;
 }
 
+void Common::prepareHeaders(Http::RequestHeaderMap& headers, const std::string& host_name,
+                            const std::string& path,
+                            const absl::optional<std::chrono::milliseconds>& timeout) {
+  headers.setReferenceMethod(Http::Headers::get().MethodValues.Post);
+  headers.setReferencePath(path);
+  headers.setReferenceHost(host_name);
+  // According to https://github.com/grpc/grpc/blob/master/doc/PROTOCOL-HTTP2.md TE should appear
+  // before Timeout and ContentType.
+  headers.setReferenceTE(Http::Headers::get().TEValues.Trailers);
+  if (timeout) {
+    toGrpcTimeout(timeout.value(), headers);
+  }
+  headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Grpc);
+}
+
 void Common::checkForHeaderOnlyError(Http::ResponseMessage& http_response) {
   // First check for grpc-status in headers. If it is here, we have an error.
   absl::optional<Status::GrpcStatus> grpc_status_code =
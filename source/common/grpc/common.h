@@ -165,7 +165,8 @@ public:
   static Buffer::InstancePtr serializeToGrpcFrame(const Protobuf::Message& message);
 
   /**
-   * Serialize protobuf message. Without grpc header.
+   * Serialize protobuf message. Without grpc header, for which there is room in front of the
+   * message in its BufferFragment.
    */
   static Buffer::InstancePtr serializeMessage(const Protobuf::Message& message);
 
@@ -177,6 +178,14 @@ public:
                  const std::string& method_name,
                  const absl::optional<std::chrono::milliseconds>& timeout);
 
+  /**
+   * Prepare the headers of a request to a protobuf service in place. The headers refer to the host
+   * name and path rather than copy them, so these must outlive the headers.
+   */
+  static void prepareHeaders(Http::RequestHeaderMap& headers, const std::string& host_name,
+                             const std::string& path,
+                             const absl::optional<std::chrono::milliseconds>& timeout);
+
   /**
    * Basic validation of gRPC response, @throws Grpc::Exception in case of non successful response.
    */
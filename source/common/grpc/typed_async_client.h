@@ -38,6 +38,9 @@ public:
   void sendMessage(const Protobuf::Message& request, bool end_stream) {
     Internal::sendMessageUntyped(stream_, std::move(request), end_stream);
   }
+  void sendMessageRaw(Buffer::InstancePtr&& request, bool end_stream) {
+    stream_->sendMessageRaw(std::move(request), end_stream);
+  }
   void closeStream() { stream_->closeStream(); }
   void resetStream() { stream_->resetStream(); }
   bool isAboveWriteBufferHighWatermark() const {
@@ -114,6 +117,18 @@ public:
                                  options);
   }
 
+  /**
+   * Like send(), for a request already serialized.
+   */
+  virtual AsyncRequest* sendRaw(const Protobuf::MethodDescriptor& service_method,
+                                Buffer::InstancePtr&& request,
+                                AsyncRequestCallbacks<Response>& callbacks,
+                                Tracing::Span& parent_span,
+                                const Http::AsyncClient::RequestOptions& options) {
+    return client_->sendRaw(service_method.service()->full_name(), service_method.name(),
+                            std::move(request), callbacks, parent_span, options);
+  }
+
   virtual AsyncStream<Request> start(const Protobuf::MethodDescriptor& service_method,
                                      AsyncStreamCallbacks<Response>& callbacks,
                                      const Http::AsyncClient::StreamOptions& options) {
@@ -159,6 +159,7 @@ private:
       return additional_request_chance_;
     }
     bool hedgeOnPerTryTimeout() const override { return false; }
+    Router::HedgeLatencyTracker* latencyTracker() const override { return nullptr; }
 
     const envoy::type::v3::FractionalPercent additional_request_chance_;
   };
@@ -96,7 +96,10 @@ struct ConnectionManagerStats {
   ConnectionManagerStats(ConnectionManagerNamedStats&& named_stats, const std::string& prefix,
                          Stats::Scope& scope)
       : named_(std::move(named_stats)), prefix_(prefix),
-        prefix_stat_name_storage_(prefix, scope.symbolTable()), scope_(scope) {}
+        prefix_stat_name_storage_(prefix, scope.symbolTable()), scope_(scope),
+        pool_(scope.symbolTable()), filter_(pool_.add("filter")),
+        rq_body_buffered_bytes_(pool_.add("rq_body_buffered_bytes")),
+        rs_body_buffered_bytes_(pool_.add("rs_body_buffered_bytes")) {}
 
   Stats::StatName prefixStatName() const { return prefix_stat_name_storage_.statName(); }
 
@@ -104,6 +107,12 @@ struct ConnectionManagerStats {
   std::string prefix_;
   Stats::StatNameManagedStorage prefix_stat_name_storage_;
   Stats::Scope& scope_;
+  // The names of the per filter stats, which are created on first use as the filters are only
+  // known by the streams.
+  Stats::StatNamePool pool_;
+  const Stats::StatName filter_;
+  const Stats::StatName rq_body_buffered_bytes_;
+  const Stats::StatName rs_body_buffered_bytes_;
 };
 
 /**
@@ -46,6 +46,7 @@
 #include "source/common/router/config_impl.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/timespan_impl.h"
+#include "source/common/stats/utility.h"
 #include "source/common/stream_info/utility.h"
 
 #include "absl/strings/escaping.h"
@@ -696,6 +697,22 @@ absl::optional<uint64_t> ConnectionManagerImpl::HttpStreamIdProviderImpl::toInte
       *parent_.request_headers_);
 }
 
+void* ConnectionManagerImpl::ActiveStream::operator new(size_t size) {
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_stream_free_list")) {
+    return ::operator new(size);
+  }
+  return FreeList::allocate(size);
+}
+
+void ConnectionManagerImpl::ActiveStream::operator delete(void* ptr, size_t size) {
+  // The blocks of the free list come from ::operator new, so the guard may change in between.
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_stream_free_list")) {
+    ::operator delete(ptr);
+    return;
+  }
+  FreeList::deallocate(ptr, size);
+}
+
 ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connection_manager,
                                                   uint32_t buffer_limit,
                                                   Buffer::BufferMemoryAccountSharedPtr account)
@@ -868,6 +885,24 @@ void ConnectionManagerImpl::ActiveStream::onStreamMaxDurationReached() {
                  StreamInfo::ResponseCodeDetails::get().MaxDurationTimeout);
 }
 
+void ConnectionManagerImpl::ActiveStream::chargeBufferedBodyStats(
+    const FilterContext& filter_context, bool request, uint64_t bytes) {
+  const std::string& filter_name = filter_context.config_name.empty()
+                                       ? filter_context.filter_name
+                                       : filter_context.config_name;
+  ENVOY_STREAM_LOG(debug, "filter '{}' buffered {} {} body bytes", *this, filter_name, bytes,
+                   request ? "request" : "response");
+  if (filter_name.empty()) {
+    return;
+  }
+  ConnectionManagerStats& stats = connection_manager_.stats_;
+  Stats::Utility::counterFromElements(
+      stats.scope_,
+      {stats.prefixStatName(), stats.filter_, Stats::DynamicName(filter_name),
+       request ? stats.rq_body_buffered_bytes_ : stats.rs_body_buffered_bytes_})
+      .add(bytes);
+}
+
 void ConnectionManagerImpl::ActiveStream::chargeStats(const ResponseHeaderMap& headers) {
   uint64_t response_code = Utility::getResponseStatus(headers);
   filter_manager_.streamInfo().response_code_ = response_code;
@@ -1241,6 +1276,11 @@ void ConnectionManagerImpl::ActiveStream::traceRequest() {
       *this, *request_headers_, filter_manager_.streamInfo(), tracing_decision);
 
   if (!active_span_) {
+    // The trace context of the untraced request was propagated without a span. The decorator
+    // operation of an ingress request still isn't propagated to the service.
+    if (connection_manager_tracing_config_->operation_name_ == Tracing::OperationName::Ingress) {
+      request_headers_->removeEnvoyDecoratorOperation();
+    }
     return;
   }
 
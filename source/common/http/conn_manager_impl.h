@@ -37,6 +37,7 @@
 
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/dump_state_utils.h"
+#include "source/common/common/free_list.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/conn_manager_config.h"
@@ -166,6 +167,11 @@ private:
                  Buffer::BufferMemoryAccountSharedPtr account);
     void completeRequest();
 
+    // The storage of the streams, which embeds their filter manager and stream info, is recycled
+    // by the worker that frees it rather than returned to the allocator on each request.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
     const Network::Connection* connection();
     uint64_t streamId() { return stream_id_; }
 
@@ -247,6 +253,8 @@ private:
       response_trailers_ = std::move(response_trailers);
     }
     void chargeStats(const ResponseHeaderMap& headers) override;
+    void chargeBufferedBodyStats(const FilterContext& filter_context, bool request,
+                                 uint64_t bytes) override;
 
     Http::RequestHeaderMapOptRef requestHeaders() override {
       return makeOptRefFromPtr(request_headers_.get());
@@ -438,6 +446,9 @@ private:
     const Tracing::CustomTagMap* customTags() const override;
     bool verbose() const override;
     uint32_t maxPathTagLength() const override;
+
+    // Enough free streams per worker to absorb the bursts of a busy listener.
+    using FreeList = ThreadLocalFreeList<ActiveStream, 128>;
   };
 
   using ActiveStreamPtr = std::unique_ptr<ActiveStream>;
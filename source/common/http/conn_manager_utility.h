@@ -35,6 +35,7 @@ public:
    * @param scope supplies the stats scope for codec stats.
    * @param http1_settings supplies the HTTP/1 settings to use if HTTP/1 is chosen.
    * @param http2_settings supplies the HTTP/2 settings to use if HTTP/2 is chosen.
+   * @param header_map_layout supplies the storage layout of the decoded request headers.
    */
   static ServerConnectionPtr
   autoCreateCodec(Network::Connection& connection, const Buffer::Instance& data,
@@ -45,7 +46,8 @@ public:
                   const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
                   uint32_t max_request_headers_kb, uint32_t max_request_headers_count,
                   envoy::config::core::v3::HttpProtocolOptions::HeadersWithUnderscoresAction
-                      headers_with_underscores_action);
+                      headers_with_underscores_action,
+                  HeaderMapLayout header_map_layout = HeaderMapLayout::LinkedList);
 
   /* The result after calling mutateRequestHeaders(), containing the final remote address. Note that
    * an extension used for detecting the original IP of the request might decide it should be
@@ -61,7 +61,7 @@ HttpConnPoolImplBase::newStream(Http::ResponseDecoder& response_decoder,
                                 Http::ConnectionPool::Callbacks& callbacks,
                                 const Instance::StreamOptions& options) {
   HttpAttachContext context({&response_decoder, &callbacks});
-  return newStreamImpl(context, options.can_send_early_data_);
+  return newStreamImpl(context, options.can_send_early_data_, options.deadline_);
 }
 
 bool HttpConnPoolImplBase::hasActiveConnections() const {
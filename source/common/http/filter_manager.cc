@@ -47,6 +47,17 @@ void recordLatestDataFilter(const typename FilterList<T>::iterator current_filte
   }
 }
 
+// Whether the most specific config of the filter on route declares it a no-op, looking the config
+// up like the filter itself would.
+bool filterDisabledOnRoute(const Router::Route& route, const FilterContext& context) {
+  const Router::RouteSpecificFilterConfig* config =
+      route.mostSpecificPerFilterConfig(context.config_name);
+  if (config == nullptr && context.filter_name != context.config_name) {
+    config = route.mostSpecificPerFilterConfig(context.filter_name);
+  }
+  return config != nullptr && config->disablesFilter();
+}
+
 } // namespace
 
 void ActiveStreamFilterBase::commonContinue() {
@@ -175,6 +186,7 @@ void ActiveStreamFilterBase::commonHandleBufferData(Buffer::Instance& provided_d
     if (!bufferedData()) {
       bufferedData() = createBuffer();
     }
+    buffered_body_bytes_ += provided_data.length();
     bufferedData()->move(provided_data);
   }
 }
@@ -493,6 +505,10 @@ void ActiveStreamDecoderFilter::requestDataTooLarge() {
 }
 
 void FilterManager::applyFilterFactoryCb(FilterContext context, FilterFactoryCb& factory) {
+  if (filter_chain_route_ != nullptr && filterDisabledOnRoute(*filter_chain_route_, context)) {
+    ENVOY_STREAM_LOG(debug, "skipping filter {} disabled on the route", *this, context.config_name);
+    return;
+  }
   FilterChainFactoryCallbacksImpl callbacks(*this, context);
   factory(callbacks);
 }
@@ -1427,11 +1443,19 @@ bool FilterManager::createFilterChain() {
   }
 
   state_.created_filter_chain_ = true;
+  // The filters that declare themselves a no-op on the route of the stream are left out of its
+  // filter chain. The route is only held while the chain is created.
+  if (filter_manager_callbacks_.downstreamCallbacks() &&
+      Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.skip_route_disabled_http_filters")) {
+    filter_chain_route_ = filter_manager_callbacks_.downstreamCallbacks()->route(nullptr);
+  }
   if (upgrade != nullptr) {
     const Router::RouteEntry::UpgradeMap* upgrade_map = filter_manager_callbacks_.upgradeMap();
 
     if (filter_chain_factory_.createUpgradeFilterChain(upgrade->value().getStringView(),
                                                        upgrade_map, *this)) {
+      filter_chain_route_ = nullptr;
       filter_manager_callbacks_.upgradeFilterChainCreated();
       return true;
     } else {
@@ -1442,6 +1466,7 @@ bool FilterManager::createFilterChain() {
   }
 
   filter_chain_factory_.createFilterChain(*this);
+  filter_chain_route_ = nullptr;
   return !upgrade_rejected;
 }
 
@@ -150,6 +150,10 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
 
   const FilterContext filter_context_;
 
+  // The body bytes that the filter moved into the buffered body of the stream, by stopping the
+  // iteration to buffer them or by adding them to the buffered body.
+  uint64_t buffered_body_bytes_{};
+
   // If the filter resumes iteration from a StopAllBuffer/Watermark state, the current filter
   // hasn't parsed data and trailers. As a result, the filter iteration should start with the
   // current filter instead of the next one. If true, filter iteration starts with the current
@@ -385,6 +389,16 @@ public:
    */
   virtual void chargeStats(const ResponseHeaderMap& /*headers*/) {}
 
+  /**
+   * Optionally updates the stats of the body bytes that a filter moved into the buffered body of
+   * the stream, to find the filters that buffer the most.
+   * @param filter_context the context of the filter.
+   * @param request whether the bytes are of the request body, rather than of the response body.
+   * @param bytes the number of body bytes the filter buffered.
+   */
+  virtual void chargeBufferedBodyStats(const FilterContext& /*filter_context*/, bool /*request*/,
+                                       uint64_t /*bytes*/) {}
+
   // TODO(snowp): We should consider moving filter access to headers/trailers to happen via the
   // callbacks instead of via the encode/decode callbacks on the filters.
 
@@ -678,6 +692,10 @@ public:
   void onStreamComplete() {
     for (auto& filter : decoder_filters_) {
       filter->handle_->onStreamComplete();
+      if (filter->buffered_body_bytes_ > 0) {
+        filter_manager_callbacks_.chargeBufferedBodyStats(filter->filter_context_, true,
+                                                          filter->buffered_body_bytes_);
+      }
     }
 
     for (auto& filter : encoder_filters_) {
@@ -685,6 +703,10 @@ public:
       if (!filter->is_encoder_decoder_filter_) {
         filter->handle_->onStreamComplete();
       }
+      if (filter->buffered_body_bytes_ > 0) {
+        filter_manager_callbacks_.chargeBufferedBodyStats(filter->filter_context_, false,
+                                                          filter->buffered_body_bytes_);
+      }
     }
   }
 
@@ -999,6 +1021,8 @@ private:
   absl::optional<absl::string_view> upstream_override_host_;
 
   const FilterChainFactory& filter_chain_factory_;
+  // The route whose disabled filters are skipped, only set while the filter chain is created.
+  Router::RouteConstSharedPtr filter_chain_route_;
   // TODO(snowp): Once FM has been moved to its own file we'll make these private classes of FM,
   // at which point they no longer need to be friends.
   friend ActiveStreamFilterBase;
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Ordered collection of header entries stored in contiguous slots. The order is kept in a small
+ * vector of entry pointers, so iteration walks one array instead of chasing the nodes of a linked
+ * list, while the entries themselves never move and pointers to them stay valid until they are
+ * erased, as required by the inline O(1) header slots of the header maps.
+ *
+ * The first InlineCapacity entries are stored inside the list itself. Additional entries come
+ * from blocks of doubling size. Slots of erased entries are reused by later insertions.
+ */
+template <class Entry, size_t InlineCapacity> class FlatHeaderList : NonCopyable {
+public:
+  using EntryVector = absl::InlinedVector<Entry*, InlineCapacity>;
+
+  FlatHeaderList() : next_slot_(inline_slots_), slots_end_(inline_slots_ + InlineCapacity) {}
+  ~FlatHeaderList() { destroyEntries(); }
+
+  /**
+   * Constructs an entry and inserts it before the entry at `position`.
+   * @return the new entry.
+   */
+  template <class... Args> Entry* emplace(size_t position, Args&&... args) {
+    ASSERT(position <= entries_.size());
+    Entry* entry = new (allocateSlot()) Entry(std::forward<Args>(args)...);
+    entries_.insert(entries_.begin() + position, entry);
+    return entry;
+  }
+
+  /**
+   * Destroys the entry at `position`.
+   */
+  void erase(size_t position) {
+    ASSERT(position < entries_.size());
+    Entry* entry = entries_[position];
+    entries_.erase(entries_.begin() + position);
+    destroy(entry);
+  }
+
+  /**
+   * Destroys all entries for which `predicate` returns true, in a single pass.
+   */
+  template <class Predicate> void removeIf(Predicate predicate) {
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [this, &predicate](Entry* entry) {
+                                    if (!predicate(*entry)) {
+                                      return false;
+                                    }
+                                    destroy(entry);
+                                    return true;
+                                  }),
+                   entries_.end());
+  }
+
+  /**
+   * @return the position of `entry`, which must be part of the list.
+   */
+  size_t indexOf(const Entry* entry) const {
+    const auto it = std::find(entries_.begin(), entries_.end(), entry);
+    ASSERT(it != entries_.end());
+    return it - entries_.begin();
+  }
+
+  void clear() {
+    destroyEntries();
+    entries_.clear();
+    blocks_.clear();
+    free_slots_ = nullptr;
+    next_slot_ = inline_slots_;
+    slots_end_ = inline_slots_ + InlineCapacity;
+    next_block_capacity_ = InlineCapacity * 2;
+  }
+
+  const EntryVector& entries() const { return entries_; }
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+private:
+  struct Slot {
+    alignas(Entry) unsigned char storage_[sizeof(Entry)];
+  };
+  // Erased slots are chained through their own storage.
+  struct FreeSlot {
+    FreeSlot* next_;
+  };
+  static_assert(sizeof(Slot) >= sizeof(FreeSlot), "slots must be able to hold a free list link");
+
+  void* allocateSlot() {
+    if (free_slots_ != nullptr) {
+      FreeSlot* slot = free_slots_;
+      free_slots_ = slot->next_;
+      slot->~FreeSlot();
+      return slot;
+    }
+    if (next_slot_ == slots_end_) {
+      blocks_.emplace_back(new Slot[next_block_capacity_]);
+      next_slot_ = blocks_.back().get();
+      slots_end_ = next_slot_ + next_block_capacity_;
+      next_block_capacity_ *= 2;
+    }
+    return next_slot_++;
+  }
+
+  void destroy(Entry* entry) {
+    entry->~Entry();
+    free_slots_ = new (entry) FreeSlot{free_slots_};
+  }
+
+  void destroyEntries() {
+    for (Entry* entry : entries_) {
+      entry->~Entry();
+    }
+  }
+
+  EntryVector entries_;
+  std::vector<std::unique_ptr<Slot[]>> blocks_;
+  FreeSlot* free_slots_{};
+  Slot* next_slot_;
+  Slot* slots_end_;
+  size_t next_block_capacity_{InlineCapacity * 2};
+  Slot inline_slots_[InlineCapacity];
+};
+
+} // namespace Http
+} // namespace Envoy
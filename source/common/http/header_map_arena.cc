@@ -0,0 +1,72 @@
+#include "source/common/http/header_map_arena.h"
+
+#include <algorithm>
+#include <new>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Http {
+
+HeaderMapArena::HeaderMapArena()
+    : cursor_(initial_block_), end_(initial_block_ + InitialBlockSize) {}
+
+HeaderMapArena::~HeaderMapArena() = default;
+
+void* HeaderMapArena::allocate(size_t bytes, size_t alignment) {
+  ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  ASSERT(alignment <= alignof(std::max_align_t));
+
+  const uintptr_t cursor = reinterpret_cast<uintptr_t>(cursor_);
+  const size_t padding = (alignment - (cursor & (alignment - 1))) & (alignment - 1);
+  if (padding + bytes > static_cast<size_t>(end_ - cursor_)) {
+    if (reserved_bytes_ >= MaxArenaBytes) {
+      ++heap_allocations_;
+      return ::operator new(bytes);
+    }
+    // The remainder of the current block is abandoned. Blocks start at max_align_t alignment so
+    // no padding is needed at the start of the new one.
+    const size_t block_size = std::max(next_block_size_, bytes);
+    blocks_.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[block_size]), block_size});
+    cursor_ = blocks_.back().data_.get();
+    end_ = cursor_ + block_size;
+    reserved_bytes_ += block_size;
+    next_block_size_ = std::min(next_block_size_ * 2, MaxBlockSize);
+    last_allocation_ = cursor_;
+    cursor_ += bytes;
+    return last_allocation_;
+  }
+
+  last_allocation_ = cursor_ + padding;
+  cursor_ = last_allocation_ + bytes;
+  return last_allocation_;
+}
+
+void HeaderMapArena::deallocate(void* ptr, size_t bytes) {
+  uint8_t* const data = static_cast<uint8_t*>(ptr);
+  if (data == last_allocation_ && data + bytes == cursor_) {
+    // Undo the most recent allocation, which makes the common pattern of adding and immediately
+    // removing a header free.
+    cursor_ = data;
+    last_allocation_ = nullptr;
+    return;
+  }
+  if (!ownsBlockMemory(data)) {
+    ::operator delete(ptr);
+  }
+}
+
+bool HeaderMapArena::ownsBlockMemory(const uint8_t* ptr) const {
+  // Heap allocations only happen once the arena is full, so the common case is decided by the
+  // first comparison. There are at most a handful of additional blocks.
+  if (reserved_bytes_ < MaxArenaBytes ||
+      (ptr >= initial_block_ && ptr < initial_block_ + InitialBlockSize)) {
+    return true;
+  }
+  return std::any_of(blocks_.begin(), blocks_.end(), [ptr](const Block& block) {
+    return ptr >= block.data_.get() && ptr < block.data_.get() + block.size_;
+  });
+}
+
+} // namespace Http
+} // namespace Envoy
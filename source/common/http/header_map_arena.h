@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Monotonic allocator backing the entries of the header maps of a single stream. Memory is carved
+ * out of a small number of blocks and only returned when the arena itself is destroyed, which
+ * replaces one heap allocation per header with a handful of allocations per stream.
+ *
+ * Freed memory is not reused, except for the most recent allocation, so a header map that keeps
+ * removing and adding headers grows the arena. To bound this, allocations past MaxArenaBytes are
+ * served from the heap and freed individually.
+ *
+ * The arena is shared by all the header maps it backs and lives until the last of them is
+ * destroyed. It is not thread safe; like the header maps themselves it must only be used by one
+ * thread at a time.
+ */
+class HeaderMapArena : NonCopyable {
+public:
+  // Size of the block embedded in the arena. This fits the headers of a typical request.
+  static constexpr size_t InitialBlockSize = 8 * 1024;
+  // Additional blocks double in size up to this limit.
+  static constexpr size_t MaxBlockSize = 64 * 1024;
+  // Total size of the blocks after which allocations fall back to the heap.
+  static constexpr size_t MaxArenaBytes = 256 * 1024;
+
+  HeaderMapArena();
+  ~HeaderMapArena();
+
+  /**
+   * @return storage for `bytes` bytes aligned to `alignment`, which must be a power of two no
+   *         larger than alignof(std::max_align_t).
+   */
+  void* allocate(size_t bytes, size_t alignment);
+
+  /**
+   * Releases storage obtained with allocate(). This is a no-op unless `ptr` is the most recent
+   * allocation or was served from the heap.
+   */
+  void deallocate(void* ptr, size_t bytes);
+
+  /**
+   * @return the total size of the blocks owned by the arena, including the initial block.
+   */
+  size_t reservedBytes() const { return reserved_bytes_; }
+
+  /**
+   * @return the number of allocations that were served from the heap.
+   */
+  uint64_t heapAllocations() const { return heap_allocations_; }
+
+private:
+  struct Block {
+    std::unique_ptr<uint8_t[]> data_;
+    size_t size_;
+  };
+
+  bool ownsBlockMemory(const uint8_t* ptr) const;
+
+  std::vector<Block> blocks_;
+  uint8_t* cursor_;
+  uint8_t* end_;
+  uint8_t* last_allocation_{};
+  size_t next_block_size_{InitialBlockSize * 2};
+  size_t reserved_bytes_{InitialBlockSize};
+  uint64_t heap_allocations_{};
+  alignas(std::max_align_t) uint8_t initial_block_[InitialBlockSize];
+};
+
+using HeaderMapArenaSharedPtr = std::shared_ptr<HeaderMapArena>;
+
+/**
+ * Standard allocator drawing from a HeaderMapArena, or from the heap when constructed without
+ * one. Allocators compare equal if they use the same arena.
+ */
+template <class T> class HeaderMapArenaAllocator {
+public:
+  using value_type = T;
+
+  HeaderMapArenaAllocator() noexcept = default;
+  explicit HeaderMapArenaAllocator(HeaderMapArena* arena) noexcept : arena_(arena) {}
+  template <class U>
+  HeaderMapArenaAllocator(const HeaderMapArenaAllocator<U>& other) noexcept
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) noexcept {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(ptr, n);
+      return;
+    }
+    arena_->deallocate(ptr, n * sizeof(T));
+  }
+
+  HeaderMapArena* arena() const { return arena_; }
+
+  template <class U> bool operator==(const HeaderMapArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <class U> bool operator!=(const HeaderMapArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  HeaderMapArena* arena_{};
+};
+
+} // namespace Http
+} // namespace Envoy
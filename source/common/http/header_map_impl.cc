@@ -53,7 +53,7 @@ HeaderString::HeaderString(UnionString&& move_value) noexcept {
 // Specialization needed for HeaderMapImpl::HeaderList::insert() when key is LowerCaseString.
 // A fully specialized template must be defined once in the program, hence this may not be in
 // a header file.
-template <> bool HeaderMapImpl::HeaderList::isPseudoHeader(const LowerCaseString& key) {
+template <> bool HeaderMapImpl::HeaderList::isPseudoHeader(const LowerCaseString& key) const {
   return key.get().c_str()[0] == ':';
 }
 
@@ -63,10 +63,10 @@ bool HeaderMapImpl::HeaderList::maybeMakeMap() {
       return false;
     }
     // Add all entries from the list into the map.
-    for (auto node = headers_.begin(); node != headers_.end(); ++node) {
-      HeaderNodeVector& v = lazy_map_[node->key().getStringView()];
-      v.push_back(node);
-    }
+    iterate([this](HeaderEntryImpl& entry) {
+      lazy_map_[entry.key().getStringView()].push_back(&entry);
+      return HeaderMap::Iterate::Continue;
+    });
   }
   return true;
 }
@@ -87,14 +87,13 @@ size_t HeaderMapImpl::HeaderList::remove(absl::string_view key) {
     }
   } else {
     // Erase all same key entries from the list.
-    for (auto i = headers_.begin(); i != headers_.end();) {
-      if (i->key() == key) {
-        removed_bytes += i->key().size() + i->value().size();
-        i = erase(i, false /* remove_from_map */);
-      } else {
-        ++i;
+    removeIf([key, &removed_bytes](const HeaderEntryImpl& entry) {
+      if (entry.key() == key) {
+        removed_bytes += entry.key().size() + entry.value().size();
+        return true;
       }
-    }
+      return false;
+    });
   }
   return removed_bytes;
 }
@@ -220,15 +219,18 @@ bool HeaderMapImpl::operator==(const HeaderMap& rhs) const {
   rhs_headers.reserve(rhs.size());
   rhs.iterate(collectAllHeaders(&rhs_headers));
 
-  auto i = headers_.begin();
+  bool equal = true;
   auto j = rhs_headers.begin();
-  for (; i != headers_.end(); ++i, ++j) {
-    if (i->key() != j->first || i->value() != j->second) {
-      return false;
+  headers_.iterate([&equal, &j](const HeaderEntryImpl& entry) {
+    if (entry.key() != j->first || entry.value() != j->second) {
+      equal = false;
+      return HeaderMap::Iterate::Break;
     }
-  }
+    ++j;
+    return HeaderMap::Iterate::Continue;
+  });
 
-  return true;
+  return equal;
 }
 
 bool HeaderMapImpl::operator!=(const HeaderMap& rhs) const { return !operator==(rhs); }
@@ -248,8 +250,7 @@ void HeaderMapImpl::insertByKey(HeaderString&& key, HeaderString&& value) {
     }
   } else {
     addSize(key.size() + value.size());
-    HeaderNode i = headers_.insert(std::move(key), std::move(value));
-    i->entry_ = i;
+    headers_.insert(std::move(key), std::move(value));
   }
 }
 
@@ -335,10 +336,11 @@ uint64_t HeaderMapImpl::byteSize() const { return cached_byte_size_; }
 void HeaderMapImpl::verifyByteSizeInternalForTest() const {
   // Computes the total byte size by summing the byte size of the keys and values.
   uint64_t byte_size = 0;
-  for (const HeaderEntryImpl& header : headers_) {
+  headers_.iterate([&byte_size](const HeaderEntryImpl& header) {
     byte_size += header.key().size();
     byte_size += header.value().size();
-  }
+    return HeaderMap::Iterate::Continue;
+  });
   ASSERT(cached_byte_size_ == byte_size);
 }
 
@@ -367,9 +369,8 @@ HeaderMap::NonConstGetResult HeaderMapImpl::getExisting(absl::string_view key) {
     if (iter != headers_.mapEnd()) {
       const HeaderList::HeaderNodeVector& v = iter->second;
       ASSERT(!v.empty()); // It's impossible to have a map entry with an empty vector as its value.
-      for (const auto& values_it : v) {
-        // Convert the iterated value to a HeaderEntry*.
-        ret.push_back(&(*values_it));
+      for (HeaderNode node : v) {
+        ret.push_back(node);
       }
     }
     return ret;
@@ -378,29 +379,22 @@ HeaderMap::NonConstGetResult HeaderMapImpl::getExisting(absl::string_view key) {
   // If the requested header is not an O(1) header and the lazy map is not in use, we do a full
   // scan. Doing the trie lookup is wasteful in the miss case, but is present for code consistency
   // with other functions that do similar things.
-  for (HeaderEntryImpl& header : headers_) {
+  headers_.iterate([&key, &ret](HeaderEntryImpl& header) {
     if (header.key() == key) {
       ret.push_back(&header);
     }
-  }
+    return HeaderMap::Iterate::Continue;
+  });
 
   return ret;
 }
 
 void HeaderMapImpl::iterate(HeaderMap::ConstIterateCb cb) const {
-  for (const HeaderEntryImpl& header : headers_) {
-    if (cb(header) == HeaderMap::Iterate::Break) {
-      break;
-    }
-  }
+  headers_.iterate([&cb](const HeaderEntryImpl& header) { return cb(header); });
 }
 
 void HeaderMapImpl::iterateReverse(HeaderMap::ConstIterateCb cb) const {
-  for (auto it = headers_.rbegin(); it != headers_.rend(); it++) {
-    if (cb(*it) == HeaderMap::Iterate::Break) {
-      break;
-    }
-  }
+  headers_.iterateReverse([&cb](const HeaderEntryImpl& header) { return cb(header); });
 }
 
 void HeaderMapImpl::clear() {
@@ -457,9 +451,7 @@ HeaderMapImpl::HeaderEntryImpl& HeaderMapImpl::maybeCreateInline(HeaderEntryImpl
   }
 
   addSize(key.get().size());
-  HeaderNode i = headers_.insert(key);
-  i->entry_ = i;
-  *entry = &(*i);
+  *entry = headers_.insert(key);
   return **entry;
 }
 
@@ -472,9 +464,7 @@ HeaderMapImpl::HeaderEntryImpl& HeaderMapImpl::maybeCreateInline(HeaderEntryImpl
   }
 
   addSize(key.get().size() + value.size());
-  HeaderNode i = headers_.insert(key, std::move(value));
-  i->entry_ = i;
-  *entry = &(*i);
+  *entry = headers_.insert(key, std::move(value));
   return **entry;
 }
 
@@ -495,10 +485,10 @@ size_t HeaderMapImpl::removeInline(HeaderEntryImpl** ptr_to_entry) {
   }
 
   HeaderEntryImpl* entry = *ptr_to_entry;
-  const uint64_t size_to_subtract = entry->entry_->key().size() + entry->entry_->value().size();
+  const uint64_t size_to_subtract = entry->key().size() + entry->value().size();
   subtractSize(size_to_subtract);
   *ptr_to_entry = nullptr;
-  headers_.erase(entry->entry_, true);
+  headers_.erase(entry, true);
   return 1;
 }
 
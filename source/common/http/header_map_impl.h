@@ -12,6 +12,8 @@
 
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
+#include "source/common/http/flat_header_list.h"
+#include "source/common/http/header_map_arena.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -52,6 +54,13 @@ public:
  */
 class HeaderMapImpl : NonCopyable {
 public:
+  /**
+   * @param arena supplies the arena the header entries are allocated from, or nullptr to allocate
+   *        them from the heap. The map keeps the arena alive. Only used by the LinkedList layout.
+   * @param layout supplies the storage layout of the header entries.
+   */
+  HeaderMapImpl(HeaderMapArenaSharedPtr arena, HeaderMapLayout layout)
+      : arena_(std::move(arena)), headers_(arena_.get(), layout) {}
   virtual ~HeaderMapImpl() = default;
 
   // The following "constructors" call virtual functions during construction and must use the
@@ -122,9 +131,11 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    // Position of the entry in the list of a LinkedList layout header map.
+    std::list<HeaderEntryImpl, HeaderMapArenaAllocator<HeaderEntryImpl>>::iterator entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
+  using HeaderEntryList = std::list<HeaderEntryImpl, HeaderMapArenaAllocator<HeaderEntryImpl>>;
+  using HeaderNode = HeaderEntryImpl*;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -185,6 +196,10 @@ protected:
    * access given a header key. Once the map is initialized, it will be used even
    * if the number of headers decreases below the threshold.
    *
+   * Depending on the layout the entries are either nodes of a std::list or slots of a
+   * FlatHeaderList, which is allocated on first insertion. Either way entries keep their address
+   * until they are removed.
+   *
    * Note: the internal iterators held in fields make this unsafe to copy and move, since the
    * reference to end() is not preserved across a move (see Notes in
    * https://en.cppreference.com/w/cpp/container/list/list). The NonCopyable will suppress both copy
@@ -197,37 +212,79 @@ protected:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
     using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    HeaderList(HeaderMapArena* arena, HeaderMapLayout layout)
+        : headers_(HeaderMapArenaAllocator<HeaderEntryImpl>(arena)),
+          pseudo_headers_end_(headers_.end()),
+          flat_layout_(layout == HeaderMapLayout::FlatVector) {}
 
-    template <class Key> bool isPseudoHeader(const Key& key) {
+    template <class Key> bool isPseudoHeader(const Key& key) const {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
     }
 
     template <class Key, class... Value> HeaderNode insert(Key&& key, Value&&... value) {
       const bool is_pseudo_header = isPseudoHeader(key);
-      HeaderNode i = headers_.emplace(is_pseudo_header ? pseudo_headers_end_ : headers_.end(),
+      HeaderNode node;
+      if (flat_layout_) {
+        if (flat_headers_ == nullptr) {
+          flat_headers_ = std::make_unique<FlatHeaders>();
+        }
+        node = flat_headers_->emplace(is_pseudo_header ? flat_pseudo_headers_
+                                                       : flat_headers_->size(),
                                       std::forward<Key>(key), std::forward<Value>(value)...);
-      if (!lazy_map_.empty()) {
-        lazy_map_[i->key().getStringView()].push_back(i);
+        if (is_pseudo_header) {
+          flat_pseudo_headers_++;
+        }
+      } else {
+        auto i = headers_.emplace(is_pseudo_header ? pseudo_headers_end_ : headers_.end(),
+                                  std::forward<Key>(key), std::forward<Value>(value)...);
+        i->entry_ = i;
+        if (!is_pseudo_header && pseudo_headers_end_ == headers_.end()) {
+          pseudo_headers_end_ = i;
+        }
+        node = &(*i);
       }
-      if (!is_pseudo_header && pseudo_headers_end_ == headers_.end()) {
-        pseudo_headers_end_ = i;
+      if (!lazy_map_.empty()) {
+        lazy_map_[node->key().getStringView()].push_back(node);
       }
-      return i;
+      return node;
     }
 
-    HeaderNode erase(HeaderNode i, bool remove_from_map) {
-      if (pseudo_headers_end_ == i) {
-        pseudo_headers_end_++;
-      }
+    void erase(HeaderNode node, bool remove_from_map) {
       if (remove_from_map) {
-        lazy_map_.erase(i->key().getStringView());
+        lazy_map_.erase(node->key().getStringView());
+      }
+      if (flat_layout_) {
+        const size_t position = flat_headers_->indexOf(node);
+        if (position < flat_pseudo_headers_) {
+          flat_pseudo_headers_--;
+        }
+        flat_headers_->erase(position);
+      } else {
+        if (pseudo_headers_end_ == node->entry_) {
+          pseudo_headers_end_++;
+        }
+        headers_.erase(node->entry_);
       }
-      return headers_.erase(i);
     }
 
     template <class UnaryPredicate> void removeIf(UnaryPredicate p) {
-      if (!lazy_map_.empty()) {
+      if (flat_layout_) {
+        if (flat_headers_ == nullptr) {
+          return;
+        }
+        // A single pass over the vector is cheaper than erasing the entries one by one. The lazy
+        // map would be left with dangling nodes, so it is rebuilt on the next lookup instead.
+        flat_headers_->removeIf([this, &p](const HeaderEntryImpl& entry) {
+          if (!p(entry)) {
+            return false;
+          }
+          if (isPseudoHeader(entry.key())) {
+            flat_pseudo_headers_--;
+          }
+          return true;
+        });
+        lazy_map_.clear();
+      } else if (!lazy_map_.empty()) {
         // Lazy map is used, iterate over its elements and remove those that satisfy the predicate
         // from the map and from the list.
         for (auto map_it = lazy_map_.begin(); map_it != lazy_map_.end();) {
@@ -238,13 +295,13 @@ protected:
           // The call to erase that follows erases the unneeded cells (from remove_pos to the
           // end) and modifies the vector's size.
           const auto remove_pos =
-              std::remove_if(values_vec.begin(), values_vec.end(), [&](HeaderNode it) {
-                if (p(*(it->entry_))) {
+              std::remove_if(values_vec.begin(), values_vec.end(), [&](HeaderNode node) {
+                if (p(*node)) {
                   // Remove the element from the list.
-                  if (pseudo_headers_end_ == it->entry_) {
+                  if (pseudo_headers_end_ == node->entry_) {
                     pseudo_headers_end_++;
                   }
-                  headers_.erase(it);
+                  headers_.erase(node->entry_);
                   return true;
                 }
                 return false;
@@ -273,6 +330,53 @@ protected:
       }
     }
 
+    /**
+     * Invokes `cb` with each entry in order until it returns HeaderMap::Iterate::Break.
+     */
+    template <class Callback> void iterate(Callback cb) {
+      if (flat_layout_) {
+        if (flat_headers_ != nullptr) {
+          for (HeaderEntryImpl* entry : flat_headers_->entries()) {
+            if (cb(*entry) == HeaderMap::Iterate::Break) {
+              return;
+            }
+          }
+        }
+        return;
+      }
+      for (HeaderEntryImpl& entry : headers_) {
+        if (cb(entry) == HeaderMap::Iterate::Break) {
+          return;
+        }
+      }
+    }
+    template <class Callback> void iterate(Callback cb) const {
+      const_cast<HeaderList*>(this)->iterate(
+          [&cb](const HeaderEntryImpl& entry) { return cb(entry); });
+    }
+
+    /**
+     * Invokes `cb` with each entry in reverse order until it returns HeaderMap::Iterate::Break.
+     */
+    template <class Callback> void iterateReverse(Callback cb) const {
+      if (flat_layout_) {
+        if (flat_headers_ != nullptr) {
+          const auto& entries = flat_headers_->entries();
+          for (auto it = entries.rbegin(); it != entries.rend(); it++) {
+            if (cb(**it) == HeaderMap::Iterate::Break) {
+              return;
+            }
+          }
+        }
+        return;
+      }
+      for (auto it = headers_.rbegin(); it != headers_.rend(); it++) {
+        if (cb(*it) == HeaderMap::Iterate::Break) {
+          return;
+        }
+      }
+    }
+
     /*
      * Creates and populates a map if the number of headers is at least 3.
      *
@@ -287,25 +391,37 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
-    size_t size() const { return headers_.size(); }
-    bool empty() const { return headers_.empty(); }
+    size_t size() const {
+      if (flat_layout_) {
+        return flat_headers_ != nullptr ? flat_headers_->size() : 0;
+      }
+      return headers_.size();
+    }
+    bool empty() const { return size() == 0; }
     void clear() {
+      if (flat_headers_ != nullptr) {
+        flat_headers_->clear();
+      }
+      flat_pseudo_headers_ = 0;
       headers_.clear();
       pseudo_headers_end_ = headers_.end();
       lazy_map_.clear();
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
-    HeaderNode pseudo_headers_end_;
+    // Fits the headers of most requests and responses without an additional allocation.
+    static constexpr size_t FlatInlineCapacity = 16;
+    using FlatHeaders = FlatHeaderList<HeaderEntryImpl, FlatInlineCapacity>;
+
+    // Storage of the LinkedList layout.
+    HeaderEntryList headers_;
+    HeaderEntryList::iterator pseudo_headers_end_;
+    // Storage of the FlatVector layout.
+    std::unique_ptr<FlatHeaders> flat_headers_;
+    size_t flat_pseudo_headers_{};
+    const bool flat_layout_;
     HeaderLazyMap lazy_map_;
   };
 
@@ -327,6 +443,8 @@ protected:
   virtual void clearInline() PURE;
   virtual HeaderEntryImpl** inlineHeaders() PURE;
 
+  // Must outlive headers_, whose entries it backs.
+  HeaderMapArenaSharedPtr arena_;
   HeaderList headers_;
   // TODO(mattklein123): The formatter does not currently get copied when a header map gets
   // copied. This may be problematic in certain cases like request shadowing. This is omitted
@@ -344,6 +462,9 @@ protected:
  */
 template <class Interface> class TypedHeaderMapImpl : public HeaderMapImpl, public Interface {
 public:
+  TypedHeaderMapImpl(HeaderMapArenaSharedPtr arena, HeaderMapLayout layout)
+      : HeaderMapImpl(std::move(arena), layout) {}
+
   void setFormatter(StatefulHeaderKeyFormatterPtr&& formatter) {
     formatter_ = std::move(formatter);
   }
@@ -465,8 +586,11 @@ protected:
 class RequestHeaderMapImpl final : public TypedHeaderMapImpl<RequestHeaderMap>,
                                    public InlineStorage {
 public:
-  static std::unique_ptr<RequestHeaderMapImpl> create() {
-    return std::unique_ptr<RequestHeaderMapImpl>(new (inlineHeadersSize()) RequestHeaderMapImpl());
+  static std::unique_ptr<RequestHeaderMapImpl>
+  create(HeaderMapArenaSharedPtr arena = nullptr,
+         HeaderMapLayout layout = HeaderMapLayout::LinkedList) {
+    return std::unique_ptr<RequestHeaderMapImpl>(
+        new (inlineHeadersSize()) RequestHeaderMapImpl(std::move(arena), layout));
   }
 
   INLINE_REQ_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -504,7 +628,10 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  RequestHeaderMapImpl() { clearInline(); }
+  RequestHeaderMapImpl(HeaderMapArenaSharedPtr arena, HeaderMapLayout layout)
+      : TypedHeaderMapImpl<RequestHeaderMap>(std::move(arena), layout) {
+    clearInline();
+  }
 
   HeaderEntryImpl* inline_headers_[];
 };
@@ -516,9 +643,11 @@ private:
 class RequestTrailerMapImpl final : public TypedHeaderMapImpl<RequestTrailerMap>,
                                     public InlineStorage {
 public:
-  static std::unique_ptr<RequestTrailerMapImpl> create() {
-    return std::unique_ptr<RequestTrailerMapImpl>(new (inlineHeadersSize())
-                                                      RequestTrailerMapImpl());
+  static std::unique_ptr<RequestTrailerMapImpl>
+  create(HeaderMapArenaSharedPtr arena = nullptr,
+         HeaderMapLayout layout = HeaderMapLayout::LinkedList) {
+    return std::unique_ptr<RequestTrailerMapImpl>(
+        new (inlineHeadersSize()) RequestTrailerMapImpl(std::move(arena), layout));
   }
 
 protected:
@@ -528,7 +657,10 @@ protected:
   HeaderEntryImpl** inlineHeaders() override { return inline_headers_; }
 
 private:
-  RequestTrailerMapImpl() { clearInline(); }
+  RequestTrailerMapImpl(HeaderMapArenaSharedPtr arena, HeaderMapLayout layout)
+      : TypedHeaderMapImpl<RequestTrailerMap>(std::move(arena), layout) {
+    clearInline();
+  }
 
   HeaderEntryImpl* inline_headers_[];
 };
@@ -540,9 +672,11 @@ private:
 class ResponseHeaderMapImpl final : public TypedHeaderMapImpl<ResponseHeaderMap>,
                                     public InlineStorage {
 public:
-  static std::unique_ptr<ResponseHeaderMapImpl> create() {
-    return std::unique_ptr<ResponseHeaderMapImpl>(new (inlineHeadersSize())
-                                                      ResponseHeaderMapImpl());
+  static std::unique_ptr<ResponseHeaderMapImpl>
+  create(HeaderMapArenaSharedPtr arena = nullptr,
+         HeaderMapLayout layout = HeaderMapLayout::LinkedList) {
+    return std::unique_ptr<ResponseHeaderMapImpl>(
+        new (inlineHeadersSize()) ResponseHeaderMapImpl(std::move(arena), layout));
   }
 
   INLINE_RESP_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -570,7 +704,10 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseHeaderMapImpl() { clearInline(); }
+  ResponseHeaderMapImpl(HeaderMapArenaSharedPtr arena, HeaderMapLayout layout)
+      : TypedHeaderMapImpl<ResponseHeaderMap>(std::move(arena), layout) {
+    clearInline();
+  }
 
   HeaderEntryImpl* inline_headers_[];
 };
@@ -582,9 +719,11 @@ private:
 class ResponseTrailerMapImpl final : public TypedHeaderMapImpl<ResponseTrailerMap>,
                                      public InlineStorage {
 public:
-  static std::unique_ptr<ResponseTrailerMapImpl> create() {
-    return std::unique_ptr<ResponseTrailerMapImpl>(new (inlineHeadersSize())
-                                                       ResponseTrailerMapImpl());
+  static std::unique_ptr<ResponseTrailerMapImpl>
+  create(HeaderMapArenaSharedPtr arena = nullptr,
+         HeaderMapLayout layout = HeaderMapLayout::LinkedList) {
+    return std::unique_ptr<ResponseTrailerMapImpl>(
+        new (inlineHeadersSize()) ResponseTrailerMapImpl(std::move(arena), layout));
   }
 
   INLINE_RESP_STRING_HEADERS_TRAILERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -604,7 +743,10 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseTrailerMapImpl() { clearInline(); }
+  ResponseTrailerMapImpl(HeaderMapArenaSharedPtr arena, HeaderMapLayout layout)
+      : TypedHeaderMapImpl<ResponseTrailerMap>(std::move(arena), layout) {
+    clearInline();
+  }
 
   HeaderEntryImpl* inline_headers_[];
 };
@@ -0,0 +1,217 @@
+#include "source/common/http/header_name_scanner.h"
+
+#include <array>
+#include <cstdint>
+
+#include "source/common/common/macros.h"
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+// tchar = "!" / "#" / "$" / "%" / "&" / "'" / "*" / "+" / "-" / "." / "^" / "_" / "`" / "|" / "~"
+//       / DIGIT / ALPHA
+constexpr bool isTokenChar(uint8_t c) {
+  switch (c) {
+  case '!':
+  case '#':
+  case '$':
+  case '%':
+  case '&':
+  case '\'':
+  case '*':
+  case '+':
+  case '-':
+  case '.':
+  case '^':
+  case '_':
+  case '`':
+  case '|':
+  case '~':
+    return true;
+  default:
+    return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+  }
+}
+
+constexpr bool isLowercaseTokenChar(uint8_t c) { return isTokenChar(c) && !(c >= 'A' && c <= 'Z'); }
+
+using CharTable = std::array<bool, 256>;
+
+constexpr CharTable buildCharTable(bool (*allowed)(uint8_t)) {
+  CharTable table{};
+  for (size_t c = 0; c < table.size(); ++c) {
+    table[c] = allowed(static_cast<uint8_t>(c));
+  }
+  return table;
+}
+
+// The classes of the characters by low and high nibble: a character is allowed if the classes of
+// its nibbles share a bit. Each bit stands for one of the distinct sets of low nibbles allowed with
+// a given high nibble, of which a character table may have up to 8.
+struct NibbleTables {
+  std::array<uint8_t, 16> low_{};
+  std::array<uint8_t, 16> high_{};
+  // False if the character table has more than 8 such sets, and so can't be represented.
+  bool complete_{true};
+};
+
+constexpr NibbleTables buildNibbleTables(const CharTable& allowed) {
+  NibbleTables tables;
+  std::array<uint16_t, 8> rows{};
+  size_t num_rows = 0;
+  for (size_t high = 0; high < 16; ++high) {
+    uint16_t row = 0;
+    for (size_t low = 0; low < 16; ++low) {
+      if (allowed[(high << 4) | low]) {
+        row |= 1 << low;
+      }
+    }
+    if (row == 0) {
+      continue;
+    }
+    size_t bit = 0;
+    while (bit < num_rows && rows[bit] != row) {
+      ++bit;
+    }
+    if (bit == num_rows) {
+      if (num_rows == rows.size()) {
+        tables.complete_ = false;
+        return tables;
+      }
+      rows[num_rows++] = row;
+    }
+    tables.high_[high] |= 1 << bit;
+    for (size_t low = 0; low < 16; ++low) {
+      if ((row & (1 << low)) != 0) {
+        tables.low_[low] |= 1 << bit;
+      }
+    }
+  }
+  return tables;
+}
+
+constexpr CharTable TokenChars = buildCharTable(isTokenChar);
+constexpr CharTable LowercaseTokenChars = buildCharTable(isLowercaseTokenChar);
+constexpr NibbleTables TokenNibbles = buildNibbleTables(TokenChars);
+constexpr NibbleTables LowercaseTokenNibbles = buildNibbleTables(LowercaseTokenChars);
+static_assert(TokenNibbles.complete_ && LowercaseTokenNibbles.complete_);
+
+template <const CharTable& Allowed>
+size_t findFirstInvalidFrom(absl::string_view name, size_t offset) {
+  const auto* data = reinterpret_cast<const uint8_t*>(name.data());
+  for (; offset < name.size(); ++offset) {
+    if (!Allowed[data[offset]]) {
+      return offset;
+    }
+  }
+  return name.size();
+}
+
+#if defined(ENVOY_SIMD_X86)
+
+template <const CharTable& Allowed, const NibbleTables& Nibbles>
+__attribute__((target("ssse3"))) size_t findFirstInvalidSsse3(absl::string_view name) {
+  const auto* data = reinterpret_cast<const uint8_t*>(name.data());
+  const __m128i low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Nibbles.low_.data()));
+  const __m128i high_table =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(Nibbles.high_.data()));
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  size_t offset = 0;
+  for (; offset + sizeof(__m128i) <= name.size(); offset += sizeof(__m128i)) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    // There is no byte shift; the bits shifted in from the neighbouring bytes are masked out.
+    const __m128i low = _mm_shuffle_epi8(low_table, _mm_and_si128(chars, nibble));
+    const __m128i high =
+        _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(chars, 4), nibble));
+    const __m128i invalid = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+    const uint32_t mask = _mm_movemask_epi8(invalid);
+    if (mask != 0) {
+      return offset + __builtin_ctz(mask);
+    }
+  }
+  return findFirstInvalidFrom<Allowed>(name, offset);
+}
+
+template <const CharTable& Allowed, const NibbleTables& Nibbles>
+__attribute__((target("avx2"))) size_t findFirstInvalidAvx2(absl::string_view name) {
+  const auto* data = reinterpret_cast<const uint8_t*>(name.data());
+  // The shuffles look up each 128 bit lane separately, so both lanes hold the tables.
+  const __m256i low_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(Nibbles.low_.data())));
+  const __m256i high_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(Nibbles.high_.data())));
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  size_t offset = 0;
+  for (; offset + sizeof(__m256i) <= name.size(); offset += sizeof(__m256i)) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+    const __m256i low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(chars, nibble));
+    const __m256i high =
+        _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(chars, 4), nibble));
+    const __m256i invalid =
+        _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+    const uint32_t mask = _mm256_movemask_epi8(invalid);
+    if (mask != 0) {
+      return offset + __builtin_ctz(mask);
+    }
+  }
+  _mm256_zeroupper();
+  return offset + findFirstInvalidSsse3<Allowed, Nibbles>(name.substr(offset));
+}
+
+#elif defined(ENVOY_SIMD_NEON)
+
+template <const CharTable& Allowed, const NibbleTables& Nibbles>
+size_t findFirstInvalidNeon(absl::string_view name) {
+  const auto* data = reinterpret_cast<const uint8_t*>(name.data());
+  const uint8x16_t low_table = vld1q_u8(Nibbles.low_.data());
+  const uint8x16_t high_table = vld1q_u8(Nibbles.high_.data());
+  const uint8x16_t nibble = vdupq_n_u8(0x0f);
+  size_t offset = 0;
+  for (; offset + sizeof(uint8x16_t) <= name.size(); offset += sizeof(uint8x16_t)) {
+    const uint8x16_t chars = vld1q_u8(data + offset);
+    const uint8x16_t low = vqtbl1q_u8(low_table, vandq_u8(chars, nibble));
+    const uint8x16_t high = vqtbl1q_u8(high_table, vshrq_n_u8(chars, 4));
+    if (vminvq_u8(vandq_u8(low, high)) == 0) {
+      // Invalid names are rare, the invalid byte is located with a scalar scan.
+      return findFirstInvalidFrom<Allowed>(name, offset);
+    }
+  }
+  return findFirstInvalidFrom<Allowed>(name, offset);
+}
+
+#endif
+
+} // namespace
+
+size_t HeaderNameScanner::findFirstInvalidScalar(absl::string_view name) {
+  return findFirstInvalidFrom<TokenChars>(name, 0);
+}
+
+size_t HeaderNameScanner::findFirstInvalidLowercaseScalar(absl::string_view name) {
+  return findFirstInvalidFrom<LowercaseTokenChars>(name, 0);
+}
+
+const HeaderNameScanner::Implementation& HeaderNameScanner::get() {
+  CONSTRUCT_ON_FIRST_USE(Implementation, []() -> Implementation {
+    return Simd::select<Implementation>({
+#if defined(ENVOY_SIMD_X86)
+        {findFirstInvalidAvx2<TokenChars, TokenNibbles>,
+         findFirstInvalidAvx2<LowercaseTokenChars, LowercaseTokenNibbles>,
+         Simd::InstructionSet::Avx2},
+        {findFirstInvalidSsse3<TokenChars, TokenNibbles>,
+         findFirstInvalidSsse3<LowercaseTokenChars, LowercaseTokenNibbles>,
+         Simd::InstructionSet::Ssse3},
+#elif defined(ENVOY_SIMD_NEON)
+        {findFirstInvalidNeon<TokenChars, TokenNibbles>,
+         findFirstInvalidNeon<LowercaseTokenChars, LowercaseTokenNibbles>,
+         Simd::InstructionSet::Neon},
+#endif
+        {findFirstInvalidScalar, findFirstInvalidLowercaseScalar, Simd::InstructionSet::Scalar},
+    });
+  }());
+}
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+
+#include "source/common/common/simd.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Validation of the characters of header field names, which are tokens as defined by
+ * https://www.rfc-editor.org/rfc/rfc9110#section-5.1. HTTP/2 and HTTP/3 additionally require the
+ * names to be lowercase, see https://www.rfc-editor.org/rfc/rfc9113#section-8.2.1.
+ *
+ * Each character is classified with two 16 entry tables indexed by its low and high nibbles, which
+ * vectorizes with the byte shuffles of SSSE3, AVX2 or NEON depending on the CPU Envoy runs on. The
+ * widest instruction set available is selected once at startup. Names shorter than a vector, and
+ * the tails of the others, are validated with a 256 entry table.
+ */
+class HeaderNameScanner {
+public:
+  /**
+   * @return the offset of the first character of `name` that is not allowed in a header name, or
+   *         name.size() if all of them are.
+   */
+  static size_t findFirstInvalid(absl::string_view name) { return get().find_(name); }
+
+  /**
+   * Same as findFirstInvalid(), with the uppercase letters not allowed either.
+   */
+  static size_t findFirstInvalidLowercase(absl::string_view name) {
+    return get().find_lowercase_(name);
+  }
+
+  /**
+   * @return whether all characters of `name` are allowed in a header name.
+   */
+  static bool isValid(absl::string_view name) { return findFirstInvalid(name) == name.size(); }
+
+  /**
+   * @return whether all characters of `name` are allowed in a lowercase header name.
+   */
+  static bool isValidLowercase(absl::string_view name) {
+    return findFirstInvalidLowercase(name) == name.size();
+  }
+
+  /**
+   * Byte-at-a-time implementations of findFirstInvalid() and findFirstInvalidLowercase(). Exposed
+   * for tests and benchmarks.
+   */
+  static size_t findFirstInvalidScalar(absl::string_view name);
+  static size_t findFirstInvalidLowercaseScalar(absl::string_view name);
+
+  /**
+   * @return the name of the implementation selected for this CPU, e.g. "avx2".
+   */
+  static absl::string_view implementationName() { return Simd::name(get().instruction_set_); }
+
+private:
+  using FindFn = size_t (*)(absl::string_view);
+
+  struct Implementation {
+    FindFn find_;
+    FindFn find_lowercase_;
+    Simd::InstructionSet instruction_set_;
+  };
+
+  static const Implementation& get();
+};
+
+} // namespace Http
+} // namespace Envoy
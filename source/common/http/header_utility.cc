@@ -6,6 +6,8 @@
 #include "source/common/common/regex.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/http/header_name_scanner.h"
+#include "source/common/http/header_value_scanner.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
@@ -191,8 +193,11 @@ bool HeaderUtility::schemeIsValid(const absl::string_view scheme) {
 }
 
 bool HeaderUtility::headerValueIsValid(const absl::string_view header_value) {
-  return http2::adapter::HeaderValidator::IsValidHeaderValue(header_value,
-                                                             http2::adapter::ObsTextOption::kAllow);
+  return HeaderValueScanner::isValid(header_value);
+}
+
+bool HeaderUtility::headerNameIsValid(const absl::string_view header_name) {
+  return HeaderNameScanner::isValid(header_name);
 }
 
 bool HeaderUtility::headerNameContainsUnderscore(const absl::string_view header_name) {
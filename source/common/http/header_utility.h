@@ -139,6 +139,13 @@ public:
    */
   static bool headerValueIsValid(const absl::string_view header_value);
 
+  /**
+   * Validates that a header name is valid, according to RFC 9110, section 5.1.
+   * https://www.rfc-editor.org/rfc/rfc9110#section-5.1
+   * @return bool true if the header name is a token, according to the aforementioned RFC.
+   */
+  static bool headerNameIsValid(const absl::string_view header_name);
+
   /**
    * Checks if header name contains underscore characters.
    * Underscore character is allowed in header names by the RFC-7230 and this check is implemented
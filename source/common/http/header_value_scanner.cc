@@ -0,0 +1,126 @@
+#include "source/common/http/header_value_scanner.h"
+
+#include <array>
+#include <cstdint>
+
+#include "source/common/common/macros.h"
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+// Characters at or below this value are control characters; HTAB is the only one allowed.
+constexpr uint8_t MaxControlCharacter = 0x1f;
+constexpr uint8_t Tab = '\t';
+constexpr uint8_t Del = 0x7f;
+
+constexpr bool isInvalid(uint8_t c) { return (c <= MaxControlCharacter && c != Tab) || c == Del; }
+
+constexpr std::array<bool, 256> buildInvalidTable() {
+  std::array<bool, 256> table{};
+  for (size_t c = 0; c < table.size(); ++c) {
+    table[c] = isInvalid(static_cast<uint8_t>(c));
+  }
+  return table;
+}
+
+constexpr std::array<bool, 256> InvalidTable = buildInvalidTable();
+
+size_t findFirstInvalidFrom(absl::string_view value, size_t offset) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  for (; offset < value.size(); ++offset) {
+    if (InvalidTable[data[offset]]) {
+      return offset;
+    }
+  }
+  return value.size();
+}
+
+#if defined(ENVOY_SIMD_X86)
+
+size_t findFirstInvalidSse2(absl::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const __m128i max_control = _mm_set1_epi8(MaxControlCharacter);
+  const __m128i tab = _mm_set1_epi8(Tab);
+  const __m128i del = _mm_set1_epi8(Del);
+  size_t offset = 0;
+  for (; offset + sizeof(__m128i) <= value.size(); offset += sizeof(__m128i)) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    // There is no unsigned byte comparison; c <= 0x1f is equivalent to min(c, 0x1f) == c.
+    const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chars, max_control), chars);
+    const __m128i invalid = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(chars, tab), control),
+                                         _mm_cmpeq_epi8(chars, del));
+    const uint32_t mask = _mm_movemask_epi8(invalid);
+    if (mask != 0) {
+      return offset + __builtin_ctz(mask);
+    }
+  }
+  return findFirstInvalidFrom(value, offset);
+}
+
+__attribute__((target("avx2"))) size_t findFirstInvalidAvx2(absl::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const __m256i max_control = _mm256_set1_epi8(MaxControlCharacter);
+  const __m256i tab = _mm256_set1_epi8(Tab);
+  const __m256i del = _mm256_set1_epi8(Del);
+  size_t offset = 0;
+  for (; offset + sizeof(__m256i) <= value.size(); offset += sizeof(__m256i)) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+    const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(chars, max_control), chars);
+    const __m256i invalid = _mm256_or_si256(
+        _mm256_andnot_si256(_mm256_cmpeq_epi8(chars, tab), control), _mm256_cmpeq_epi8(chars, del));
+    const uint32_t mask = _mm256_movemask_epi8(invalid);
+    if (mask != 0) {
+      return offset + __builtin_ctz(mask);
+    }
+  }
+  _mm256_zeroupper();
+  return offset + findFirstInvalidSse2(value.substr(offset));
+}
+
+#elif defined(ENVOY_SIMD_NEON)
+
+size_t findFirstInvalidNeon(absl::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const uint8x16_t max_control = vdupq_n_u8(MaxControlCharacter);
+  const uint8x16_t tab = vdupq_n_u8(Tab);
+  const uint8x16_t del = vdupq_n_u8(Del);
+  size_t offset = 0;
+  for (; offset + sizeof(uint8x16_t) <= value.size(); offset += sizeof(uint8x16_t)) {
+    const uint8x16_t chars = vld1q_u8(data + offset);
+    const uint8x16_t invalid =
+        vorrq_u8(vbicq_u8(vcleq_u8(chars, max_control), vceqq_u8(chars, tab)),
+                 vceqq_u8(chars, del));
+    if (vmaxvq_u8(invalid) != 0) {
+      // Invalid values are rare, the invalid byte is located with a scalar scan.
+      return findFirstInvalidFrom(value, offset);
+    }
+  }
+  return findFirstInvalidFrom(value, offset);
+}
+
+#endif
+
+} // namespace
+
+size_t HeaderValueScanner::findFirstInvalidScalar(absl::string_view value) {
+  return findFirstInvalidFrom(value, 0);
+}
+
+const HeaderValueScanner::Implementation& HeaderValueScanner::get() {
+  CONSTRUCT_ON_FIRST_USE(Implementation, []() -> Implementation {
+    return Simd::select<Implementation>({
+#if defined(ENVOY_SIMD_X86)
+        {findFirstInvalidAvx2, Simd::InstructionSet::Avx2},
+        {findFirstInvalidSse2, Simd::InstructionSet::Sse2},
+#elif defined(ENVOY_SIMD_NEON)
+        {findFirstInvalidNeon, Simd::InstructionSet::Neon},
+#endif
+        {findFirstInvalidScalar, Simd::InstructionSet::Scalar},
+    });
+  }());
+}
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+
+#include "source/common/common/simd.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Validation of the characters of header field values, as defined by field-value in
+ * https://www.rfc-editor.org/rfc/rfc9110#section-5.5 with obs-text allowed. Only NUL, CR, LF, DEL
+ * and the other control characters except HTAB are rejected.
+ *
+ * The scan is vectorized with SSE2, AVX2 or NEON depending on the CPU Envoy runs on; the widest
+ * instruction set available is selected once at startup. Large values such as cookies and JWTs
+ * are validated 16 or 32 bytes at a time.
+ */
+class HeaderValueScanner {
+public:
+  /**
+   * @return the offset of the first character of `value` that is not allowed in a header value,
+   *         or value.size() if all of them are.
+   */
+  static size_t findFirstInvalid(absl::string_view value) { return get().find_(value); }
+
+  /**
+   * @return whether all characters of `value` are allowed in a header value.
+   */
+  static bool isValid(absl::string_view value) { return findFirstInvalid(value) == value.size(); }
+
+  /**
+   * Byte-at-a-time implementation of findFirstInvalid(). Exposed for tests and benchmarks.
+   */
+  static size_t findFirstInvalidScalar(absl::string_view value);
+
+  /**
+   * @return the name of the implementation selected for this CPU, e.g. "avx2".
+   */
+  static absl::string_view implementationName() { return Simd::name(get().instruction_set_); }
+
+private:
+  using FindFn = size_t (*)(absl::string_view);
+
+  struct Implementation {
+    FindFn find_;
+    Simd::InstructionSet instruction_set_;
+  };
+
+  static const Implementation& get();
+};
+
+} // namespace Http
+} // namespace Envoy
@@ -1,8 +1,10 @@
 #include "source/common/http/http1/codec_impl.h"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
@@ -127,12 +129,87 @@ void StreamEncoderImpl::encodeFormattedHeader(absl::string_view key, absl::strin
   }
 }
 
+namespace {
+
+// @return the key `header` is encoded with, or an empty view if it isn't encoded.
+absl::string_view encodedHeaderKey(const HeaderEntry& header, const HeaderValues& header_values) {
+  const absl::string_view key = header.key().getStringView();
+  // Translate :authority -> host so that upper layers do not need to deal with this.
+  if (key.size() > 1 && key[0] == ':' && key[1] == 'a') {
+    return header_values.HostLegacy.get();
+  }
+  // Skip all headers starting with ':' that make it here.
+  if (key[0] == ':') {
+    return {};
+  }
+  return key;
+}
+
+} // namespace
+
+void StreamEncoderImpl::encodeHeadersInSingleSlice(const RequestOrResponseHeaderMap& headers,
+                                                   absl::Span<const absl::string_view> start_line,
+                                                   absl::string_view extra_key,
+                                                   absl::string_view extra_value) {
+  const Http::HeaderValues& header_values = Http::Headers::get();
+  uint64_t start_line_size = 0;
+  for (const absl::string_view fragment : start_line) {
+    start_line_size += fragment.size();
+  }
+  uint64_t headers_size = 0;
+  headers.iterate([&header_values, &headers_size](const HeaderEntry& header) -> HeaderMap::Iterate {
+    const absl::string_view key = encodedHeaderKey(header, header_values);
+    if (!key.empty()) {
+      headers_size += key.size() + COLON_SPACE.size() + header.value().size() + CRLF.size();
+    }
+    return HeaderMap::Iterate::Continue;
+  });
+  if (!extra_key.empty()) {
+    headers_size += extra_key.size() + COLON_SPACE.size() + extra_value.size() + CRLF.size();
+  }
+
+  const uint64_t size = start_line_size + headers_size + CRLF.size();
+  Buffer::ReservationSingleSlice reservation = connection_.buffer().reserveSingleSlice(size);
+  char* mem = static_cast<char*>(reservation.slice().mem_);
+  const auto append = [&mem](absl::string_view data) {
+    memcpy(mem, data.data(), data.size()); // NOLINT(safe-memcpy)
+    mem += data.size();
+  };
+  const auto append_header = [&append](absl::string_view key, absl::string_view value) {
+    append(key);
+    append(COLON_SPACE);
+    append(value);
+    append(CRLF);
+  };
+
+  for (const absl::string_view fragment : start_line) {
+    append(fragment);
+  }
+  headers.iterate(
+      [&header_values, &append_header](const HeaderEntry& header) -> HeaderMap::Iterate {
+        const absl::string_view key = encodedHeaderKey(header, header_values);
+        if (!key.empty()) {
+          append_header(key, header.value().getStringView());
+        }
+        return HeaderMap::Iterate::Continue;
+      });
+  if (!extra_key.empty()) {
+    append_header(extra_key, extra_value);
+  }
+  append(CRLF);
+  ASSERT(mem == static_cast<char*>(reservation.slice().mem_) + size);
+  reservation.commit(size);
+
+  bytes_meter_->addHeaderBytesSent(headers_size);
+}
+
 void ResponseEncoderImpl::encode1xxHeaders(const ResponseHeaderMap& headers) {
   ASSERT(HeaderUtility::isSpecial1xx(headers));
   encodeHeaders(headers, false);
 }
 
 void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& headers,
+                                          absl::Span<const absl::string_view> start_line,
                                           absl::optional<uint64_t> status, bool end_stream,
                                           bool bodiless_request) {
   HeaderKeyFormatterOptConstRef formatter(headers.formatter());
@@ -141,30 +218,10 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
   }
 
   const Http::HeaderValues& header_values = Http::Headers::get();
-  bool saw_content_length = false;
-  headers.iterate(
-      [this, &header_values, formatter](const HeaderEntry& header) -> HeaderMap::Iterate {
-        absl::string_view key_to_use = header.key().getStringView();
-        uint32_t key_size_to_use = header.key().size();
-        // Translate :authority -> host so that upper layers do not need to deal with this.
-        if (key_size_to_use > 1 && key_to_use[0] == ':' && key_to_use[1] == 'a') {
-          key_to_use = absl::string_view(header_values.HostLegacy.get());
-          key_size_to_use = header_values.HostLegacy.get().size();
-        }
-
-        // Skip all headers starting with ':' that make it here.
-        if (key_to_use[0] == ':') {
-          return HeaderMap::Iterate::Continue;
-        }
-
-        encodeFormattedHeader(key_to_use, header.value().getStringView(), formatter);
-
-        return HeaderMap::Iterate::Continue;
-      });
-
-  if (headers.ContentLength()) {
-    saw_content_length = true;
-  }
+  const bool saw_content_length = headers.ContentLength() != nullptr;
+  // The header the codec adds to the ones of the map, if any.
+  absl::string_view extra_key;
+  absl::string_view extra_value;
 
   ASSERT(!headers.TransferEncoding());
 
@@ -199,7 +256,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // body, per https://tools.ietf.org/html/rfc7230#section-3.3.2
       if (!status || (*status >= 200 && *status != 204)) {
         if (!bodiless_request) {
-          encodeFormattedHeader(header_values.ContentLength.get(), "0", formatter);
+          extra_key = header_values.ContentLength.get();
+          extra_value = "0";
         }
       }
       chunk_encoding_ = false;
@@ -209,8 +267,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // For responses to connect requests, do not send the chunked encoding header:
       // https://tools.ietf.org/html/rfc7231#section-4.3.6.
       if (!is_response_to_connect_request_) {
-        encodeFormattedHeader(header_values.TransferEncoding.get(),
-                              header_values.TransferEncodingValues.Chunked, formatter);
+        extra_key = header_values.TransferEncoding.get();
+        extra_value = header_values.TransferEncodingValues.Chunked;
       }
       // We do not apply chunk encoding for HTTP upgrades, including CONNECT style upgrades.
       // If there is a body in a response on the upgrade path, the chunks will be
@@ -224,7 +282,23 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
     }
   }
 
-  connection_.buffer().add(CRLF);
+  if (!formatter.has_value()) {
+    encodeHeadersInSingleSlice(headers, start_line, extra_key, extra_value);
+  } else {
+    connection_.buffer().addFragments(start_line);
+    headers.iterate(
+        [this, &header_values, formatter](const HeaderEntry& header) -> HeaderMap::Iterate {
+          const absl::string_view key = encodedHeaderKey(header, header_values);
+          if (!key.empty()) {
+            encodeFormattedHeader(key, header.value().getStringView(), formatter);
+          }
+          return HeaderMap::Iterate::Continue;
+        });
+    if (!extra_key.empty()) {
+      encodeFormattedHeader(extra_key, extra_value, formatter);
+    }
+    connection_.buffer().add(CRLF);
+  }
 
   if (end_stream) {
     endEncode();
@@ -385,6 +459,42 @@ const Network::ConnectionInfoProvider& StreamEncoderImpl::connectionInfoProvider
 static constexpr absl::string_view RESPONSE_PREFIX = "HTTP/1.1 ";
 static constexpr absl::string_view HTTP_10_RESPONSE_PREFIX = "HTTP/1.0 ";
 
+namespace {
+
+// Status lines of HTTP/1.1 and HTTP/1.0 responses for each status code, with the reason phrase of
+// the status code. Responses are sent with the same few status lines, in particular local replies
+// and direct responses, so they are rendered once instead of with every response.
+class StatusLines {
+public:
+  static constexpr uint64_t MinStatus = 100;
+  static constexpr uint64_t MaxStatus = 599;
+
+  StatusLines() {
+    for (uint64_t status = MinStatus; status <= MaxStatus; ++status) {
+      const char* reason_phrase = CodeUtility::toString(static_cast<Code>(status));
+      http11_lines_.push_back(absl::StrCat(RESPONSE_PREFIX, status, SPACE, reason_phrase, CRLF));
+      http10_lines_.push_back(
+          absl::StrCat(HTTP_10_RESPONSE_PREFIX, status, SPACE, reason_phrase, CRLF));
+    }
+  }
+
+  // @return the status line for `status`, or an empty view if it is out of the cached range.
+  absl::string_view get(bool http10, uint64_t status) const {
+    if (status < MinStatus || status > MaxStatus) {
+      return {};
+    }
+    return http10 ? http10_lines_[status - MinStatus] : http11_lines_[status - MinStatus];
+  }
+
+private:
+  std::vector<std::string> http11_lines_;
+  std::vector<std::string> http10_lines_;
+};
+
+const StatusLines& statusLines() { CONSTRUCT_ON_FIRST_USE(StatusLines); }
+
+} // namespace
+
 void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool end_stream) {
   started_response_ = true;
 
@@ -392,33 +502,36 @@ void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool e
   ASSERT(headers.Status() != nullptr);
   uint64_t numeric_status = Utility::getResponseStatus(headers);
 
-  absl::string_view response_prefix;
-  if (connection_.protocol() == Protocol::Http10 && connection_.supportsHttp10()) {
-    response_prefix = HTTP_10_RESPONSE_PREFIX;
-  } else {
-    response_prefix = RESPONSE_PREFIX;
-  }
-
+  const bool http10 = connection_.protocol() == Protocol::Http10 && connection_.supportsHttp10();
   StatefulHeaderKeyFormatterOptConstRef formatter(headers.formatter());
-
-  absl::string_view reason_phrase;
-  if (formatter.has_value() && !formatter->getReasonPhrase().empty()) {
-    reason_phrase = formatter->getReasonPhrase();
-  } else {
-    const char* status_string = CodeUtility::toString(static_cast<Code>(numeric_status));
-    uint32_t status_string_len = strlen(status_string);
-    reason_phrase = {status_string, status_string_len};
-  }
-
-  connection_.buffer().addFragments(
-      {response_prefix, absl::StrCat(numeric_status), SPACE, reason_phrase, CRLF});
+  const bool custom_reason_phrase =
+      formatter.has_value() && !formatter->getReasonPhrase().empty();
 
   if (numeric_status >= 300) {
     // Don't do special CONNECT logic if the CONNECT was rejected.
     is_response_to_connect_request_ = false;
   }
 
-  encodeHeadersBase(headers, absl::make_optional<uint64_t>(numeric_status), end_stream, false);
+  absl::string_view status_line;
+  if (!custom_reason_phrase) {
+    status_line = statusLines().get(http10, numeric_status);
+  }
+  if (!status_line.empty()) {
+    encodeHeadersBase(headers, {status_line}, absl::make_optional<uint64_t>(numeric_status),
+                      end_stream, false);
+    return;
+  }
+  absl::string_view reason_phrase;
+  if (custom_reason_phrase) {
+    reason_phrase = formatter->getReasonPhrase();
+  } else {
+    reason_phrase = CodeUtility::toString(static_cast<Code>(numeric_status));
+  }
+  const std::string status_string = absl::StrCat(numeric_status);
+  encodeHeadersBase(headers,
+                    {http10 ? HTTP_10_RESPONSE_PREFIX : RESPONSE_PREFIX, status_string, SPACE,
+                     reason_phrase, CRLF},
+                    absl::make_optional<uint64_t>(numeric_status), end_stream, false);
 }
 
 static constexpr absl::string_view REQUEST_POSTFIX = " HTTP/1.1\r\n";
@@ -466,22 +579,20 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
     std::string url = absl::StrCat(scheme->value().getStringView(), "://",
                                    host->value().getStringView(), path->value().getStringView());
     ENVOY_CONN_LOG(trace, "Sending fully qualified URL: {}", connection_.connection(), url);
-    connection_.buffer().addFragments(
-        {method->value().getStringView(), SPACE, url, REQUEST_POSTFIX});
-  } else {
-    absl::string_view host_or_path_view;
-    if (is_connect) {
-      host_or_path_view = host->value().getStringView();
-    } else {
-      host_or_path_view = path->value().getStringView();
-    }
-
-    connection_.buffer().addFragments(
-        {method->value().getStringView(), SPACE, host_or_path_view, REQUEST_POSTFIX});
+    encodeHeadersBase(headers, {method->value().getStringView(), SPACE, url, REQUEST_POSTFIX},
+                      absl::nullopt, end_stream, HeaderUtility::requestShouldHaveNoBody(headers));
+    return okStatus();
   }
 
-  encodeHeadersBase(headers, absl::nullopt, end_stream,
-                    HeaderUtility::requestShouldHaveNoBody(headers));
+  absl::string_view host_or_path_view;
+  if (is_connect) {
+    host_or_path_view = host->value().getStringView();
+  } else {
+    host_or_path_view = path->value().getStringView();
+  }
+  encodeHeadersBase(headers,
+                    {method->value().getStringView(), SPACE, host_or_path_view, REQUEST_POSTFIX},
+                    absl::nullopt, end_stream, HeaderUtility::requestShouldHaveNoBody(headers));
   return okStatus();
 }
 
@@ -508,8 +619,10 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
     : connection_(connection), stats_(stats), codec_settings_(settings),
       encode_only_header_key_formatter_(encodeOnlyFormatterFromSettings(settings)),
       processing_trailers_(false), handling_upgrade_(false), reset_stream_called_(false),
-      deferred_end_stream_headers_(false), dispatching_(false), max_headers_kb_(max_headers_kb),
-      max_headers_count_(max_headers_count) {
+      deferred_end_stream_headers_(false), dispatching_(false),
+      use_header_map_arena_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_header_map_arena")),
+      max_headers_kb_(max_headers_kb), max_headers_count_(max_headers_count) {
   if (codec_settings_.use_balsa_parser_) {
     parser_ = std::make_unique<BalsaParser>(type, this, max_headers_kb_ * 1024, enableTrailers());
   } else {
@@ -676,6 +789,12 @@ Http::Status ConnectionImpl::dispatch(Buffer::Instance& data) {
   // If an upgrade has been handled and there is body data or early upgrade
   // payload to send on, send it on.
   maybeDirectDispatch(data);
+  if (handling_upgrade_ &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http1_release_parser_on_upgrade")) {
+    // The codec never leaves upgrade mode, all further data is direct-dispatched. Release the
+    // parser and the header state it holds for the rest of the, possibly long-lived, connection.
+    parser_.reset();
+  }
   return Http::okStatus();
 }
 
@@ -1032,7 +1151,8 @@ ServerConnectionImpl::ServerConnectionImpl(
     const Http1Settings& settings, uint32_t max_request_headers_kb,
     const uint32_t max_request_headers_count,
     envoy::config::core::v3::HttpProtocolOptions::HeadersWithUnderscoresAction
-        headers_with_underscores_action)
+        headers_with_underscores_action,
+    HeaderMapLayout header_map_layout)
     : ConnectionImpl(connection, stats, settings, MessageType::Request, max_request_headers_kb,
                      max_request_headers_count),
       callbacks_(callbacks),
@@ -1043,7 +1163,8 @@ ServerConnectionImpl::ServerConnectionImpl(
           [&]() -> void { this->onBelowLowWatermark(); },
           [&]() -> void { this->onAboveHighWatermark(); },
           []() -> void { /* TODO(adisuissa): handle overflow watermark */ })),
-      headers_with_underscores_action_(headers_with_underscores_action) {
+      headers_with_underscores_action_(headers_with_underscores_action),
+      header_map_layout_(header_map_layout) {
   owned_output_buffer_->setWatermarks(connection.bufferLimit());
   // Inform parent
   output_buffer_ = owned_output_buffer_.get();
@@ -87,8 +87,17 @@ public:
 
 protected:
   StreamEncoderImpl(ConnectionImpl& connection, StreamInfo::BytesMeterSharedPtr&& bytes_meter);
-  void encodeHeadersBase(const RequestOrResponseHeaderMap& headers, absl::optional<uint64_t> status,
-                         bool end_stream, bool bodiless_request);
+  /**
+   * Encodes the start line and the headers of a request or a response.
+   * @param headers supplies the headers to encode.
+   * @param start_line supplies the fragments of the request or status line, including its CRLF.
+   * @param status supplies the status of a response.
+   * @param end_stream supplies whether the stream ends with the headers.
+   * @param bodiless_request supplies whether the request shouldn't have a body.
+   */
+  void encodeHeadersBase(const RequestOrResponseHeaderMap& headers,
+                         absl::Span<const absl::string_view> start_line,
+                         absl::optional<uint64_t> status, bool end_stream, bool bodiless_request);
   void encodeTrailersBase(const HeaderMap& headers);
 
   Buffer::BufferMemoryAccountSharedPtr buffer_memory_account_;
@@ -117,6 +126,14 @@ private:
   void encodeFormattedHeader(absl::string_view key, absl::string_view value,
                              HeaderKeyFormatterOptConstRef formatter);
 
+  /**
+   * Encodes the start line, the headers, `extra_key` with `extra_value` unless it is empty and the
+   * end of the headers in a single slice. The keys are written as they are, without a formatter.
+   */
+  void encodeHeadersInSingleSlice(const RequestOrResponseHeaderMap& headers,
+                                  absl::Span<const absl::string_view> start_line,
+                                  absl::string_view extra_key, absl::string_view extra_value);
+
   void flushOutput(bool end_encode = false);
 
   absl::string_view details_;
@@ -286,9 +303,19 @@ protected:
    */
   Status checkMaxHeadersSize();
 
+  /**
+   * Starts a new arena for the headers and trailers of the message about to be decoded.
+   * @return the arena, or nullptr if header map arenas are disabled.
+   */
+  HeaderMapArenaSharedPtr newHeaderMapArena() {
+    header_map_arena_ = use_header_map_arena_ ? std::make_shared<HeaderMapArena>() : nullptr;
+    return header_map_arena_;
+  }
+
   Network::Connection& connection_;
   CodecStats& stats_;
   const Http1Settings codec_settings_;
+  // Released once the connection is upgraded.
   std::unique_ptr<Parser> parser_;
   Buffer::Instance* current_dispatching_buffer_{};
   Buffer::Instance* output_buffer_ = nullptr; // Not owned
@@ -306,6 +333,10 @@ protected:
   bool dispatching_ : 1;
   bool dispatching_slice_already_drained_ : 1;
   StreamInfo::BytesMeterSharedPtr bytes_meter_before_stream_;
+  // Backs the header maps of the message currently being decoded. The maps keep it alive after
+  // they have been handed to the decoder.
+  HeaderMapArenaSharedPtr header_map_arena_;
+  const bool use_header_map_arena_;
 
 private:
   enum class HeaderParsingState { Field, Value, Done };
@@ -456,7 +487,8 @@ public:
                        ServerConnectionCallbacks& callbacks, const Http1Settings& settings,
                        uint32_t max_request_headers_kb, const uint32_t max_request_headers_count,
                        envoy::config::core::v3::HttpProtocolOptions::HeadersWithUnderscoresAction
-                           headers_with_underscores_action);
+                           headers_with_underscores_action,
+                       HeaderMapLayout header_map_layout = HeaderMapLayout::LinkedList);
   bool supportsHttp10() override { return codec_settings_.accept_http_10_; }
 
 protected:
@@ -530,14 +562,15 @@ private:
   void allocHeaders(StatefulHeaderKeyFormatterPtr&& formatter) override {
     ASSERT(nullptr == absl::get<RequestHeaderMapPtr>(headers_or_trailers_));
     ASSERT(!processing_trailers_);
-    auto headers = RequestHeaderMapImpl::create();
+    auto headers = RequestHeaderMapImpl::create(newHeaderMapArena(), header_map_layout_);
     headers->setFormatter(std::move(formatter));
     headers_or_trailers_.emplace<RequestHeaderMapPtr>(std::move(headers));
   }
   void allocTrailers() override {
     ASSERT(processing_trailers_);
     if (!absl::holds_alternative<RequestTrailerMapPtr>(headers_or_trailers_)) {
-      headers_or_trailers_.emplace<RequestTrailerMapPtr>(RequestTrailerMapImpl::create());
+      headers_or_trailers_.emplace<RequestTrailerMapPtr>(
+          RequestTrailerMapImpl::create(header_map_arena_, header_map_layout_));
     }
   }
   void dumpAdditionalState(std::ostream& os, int indent_level) const override;
@@ -564,6 +597,8 @@ private:
   // The action to take when a request header name contains underscore characters.
   const envoy::config::core::v3::HttpProtocolOptions::HeadersWithUnderscoresAction
       headers_with_underscores_action_;
+  // Storage layout of the decoded request headers and trailers.
+  const HeaderMapLayout header_map_layout_;
 };
 
 /**
@@ -633,14 +668,15 @@ private:
   void allocHeaders(StatefulHeaderKeyFormatterPtr&& formatter) override {
     ASSERT(nullptr == absl::get<ResponseHeaderMapPtr>(headers_or_trailers_));
     ASSERT(!processing_trailers_);
-    auto headers = ResponseHeaderMapImpl::create();
+    auto headers = ResponseHeaderMapImpl::create(newHeaderMapArena());
     headers->setFormatter(std::move(formatter));
     headers_or_trailers_.emplace<ResponseHeaderMapPtr>(std::move(headers));
   }
   void allocTrailers() override {
     ASSERT(processing_trailers_);
     if (!absl::holds_alternative<ResponseTrailerMapPtr>(headers_or_trailers_)) {
-      headers_or_trailers_.emplace<ResponseTrailerMapPtr>(ResponseTrailerMapImpl::create());
+      headers_or_trailers_.emplace<ResponseTrailerMapPtr>(
+          ResponseTrailerMapImpl::create(header_map_arena_));
     }
   }
   void dumpAdditionalState(std::ostream& os, int indent_level) const override;
@@ -12,6 +12,7 @@
 #include "envoy/network/connection.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/byte_order.h"
 #include "source/common/common/cleanup.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/enum_to_int.h"
@@ -166,7 +167,11 @@ ConnectionImpl::StreamImpl::StreamImpl(ConnectionImpl& parent, uint32_t buffer_l
       pending_receive_buffer_high_watermark_called_(false),
       pending_send_buffer_high_watermark_called_(false), reset_due_to_messaging_error_(false),
       defer_processing_backedup_streams_(
-          Runtime::runtimeFeatureEnabled(Runtime::defer_processing_backedup_streams)) {
+          Runtime::runtimeFeatureEnabled(Runtime::defer_processing_backedup_streams)),
+      header_map_arena_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_header_map_arena")
+              ? std::make_shared<HeaderMapArena>()
+              : nullptr) {
   parent_.stats_.streams_active_.inc();
   if (buffer_limit > 0) {
     setWriteBufferWatermarks(buffer_limit);
@@ -250,7 +255,7 @@ void ConnectionImpl::ServerStreamImpl::encode1xxHeaders(const ResponseHeaderMap&
 void ConnectionImpl::StreamImpl::encodeHeadersBase(const HeaderMap& headers, bool end_stream) {
   local_end_stream_ = end_stream;
   submitHeaders(headers, end_stream);
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendOrDeferPendingFrames()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -316,7 +321,7 @@ void ConnectionImpl::StreamImpl::encodeTrailersBase(const HeaderMap& trailers) {
     }
   } else {
     submitTrailers(trailers);
-    if (parent_.sendPendingFramesAndHandleError()) {
+    if (parent_.sendOrDeferPendingFrames()) {
       // Intended to check through coverage that this error case is tested
       return;
     }
@@ -332,7 +337,7 @@ void ConnectionImpl::StreamImpl::encodeMetadata(const MetadataMapVector& metadat
     parent_.adapter_->SubmitMetadata(stream_id_, 16 * 1024, std::move(source));
   }
 
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendOrDeferPendingFrames()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -388,7 +393,7 @@ void ConnectionImpl::StreamImpl::processBufferedData() {
 void ConnectionImpl::StreamImpl::grantPeerAdditionalStreamWindow() {
   parent_.adapter_->MarkDataConsumedForStream(stream_id_, unconsumed_bytes_);
   unconsumed_bytes_ = 0;
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendOrDeferPendingFrames()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -430,6 +435,9 @@ void ConnectionImpl::StreamImpl::scheduleProcessingOfBufferedData(bool schedule_
 }
 
 void ConnectionImpl::StreamImpl::pendingRecvBufferHighWatermark() {
+  if (parent_.flow_control_window_tuner_ != nullptr) {
+    parent_.queueWindowUpdate(parent_.flow_control_window_tuner_->onReceiveBufferOverLimit());
+  }
   // If `defer_processing_backedup_streams_`, read disabling here can become
   // dangerous as it can prevent us from processing buffered data.
   if (!defer_processing_backedup_streams_) {
@@ -651,7 +659,7 @@ bool ConnectionImpl::StreamDataFrameSource::Send(absl::string_view frame_header,
 
   stream_.parent_.stats_.pending_send_bytes_.sub(payload_length);
   output.move(*stream_.pending_send_data_, payload_length);
-  stream_.parent_.connection_.write(output, false);
+  stream_.parent_.writeOutbound(output);
   return true;
 }
 
@@ -708,7 +716,7 @@ void ConnectionImpl::StreamImpl::encodeDataHelper(Buffer::Instance& data, bool e
     data_deferred_ = false;
   }
 
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendOrDeferPendingFrames()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -819,6 +827,8 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
                                const uint32_t max_headers_kb, const uint32_t max_headers_count)
     : use_oghttp2_library_(
           Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_use_oghttp2")),
+      coalesce_writes_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_coalesce_writes")),
       stats_(stats), connection_(connection), max_headers_kb_(max_headers_kb),
       max_headers_count_(max_headers_count),
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
@@ -827,6 +837,12 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
       random_(random_generator),
       last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
+  if (http2_options.has_hpack_table_size_tuning()) {
+    hpack_table_size_tuner_ = std::make_unique<HpackTableSizeTuner>(stats, http2_options);
+  }
+  if (http2_options.has_adaptive_flow_control()) {
+    flow_control_window_tuner_ = std::make_unique<FlowControlWindowTuner>(stats, http2_options);
+  }
   if (http2_options.has_connection_keepalive()) {
     keepalive_interval_ = std::chrono::milliseconds(
         PROTOBUF_GET_MS_OR_DEFAULT(http2_options.connection_keepalive(), interval, 0));
@@ -889,6 +905,18 @@ void ConnectionImpl::onKeepaliveResponse() {
   }
 }
 
+void ConnectionImpl::queueWindowUpdate(
+    absl::optional<FlowControlWindowTuner::WindowUpdate> update) {
+  if (!update.has_value()) {
+    return;
+  }
+  // The connection-level increments add up, only the latest stream-level window is advertised.
+  if (pending_window_update_.has_value()) {
+    update->connection_window_increment_ += pending_window_update_->connection_window_increment_;
+  }
+  pending_window_update_ = update;
+}
+
 void ConnectionImpl::onKeepaliveResponseTimeout() {
   ENVOY_CONN_LOG_EVENT(debug, "h2_ping_timeout", "Closing connection due to keepalive timeout",
                        connection_);
@@ -947,6 +975,29 @@ Http::Status ConnectionImpl::dispatch(Buffer::Instance& data) {
   ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, data.length());
   data.drain(data.length());
 
+  if (pending_hpack_table_size_.has_value()) {
+    ENVOY_CONN_LOG(debug, "advertising HPACK table size {}", connection_,
+                   pending_hpack_table_size_.value());
+    adapter_->SubmitSettings(
+        {{http2::adapter::HEADER_TABLE_SIZE, pending_hpack_table_size_.value()}});
+    pending_hpack_table_size_.reset();
+  }
+  if (pending_bdp_ping_) {
+    ENVOY_CONN_LOG(trace, "Sending bandwidth-delay product PING", connection_);
+    adapter_->SubmitPing(FlowControlWindowTuner::BdpPingPayload);
+    pending_bdp_ping_ = false;
+  }
+  if (pending_window_update_.has_value()) {
+    ENVOY_CONN_LOG(debug, "advertising stream-level window size {}", connection_,
+                   pending_window_update_->stream_window_size_);
+    adapter_->SubmitSettings(
+        {{http2::adapter::INITIAL_WINDOW_SIZE, pending_window_update_->stream_window_size_}});
+    if (pending_window_update_->connection_window_increment_ > 0) {
+      adapter_->SubmitWindowUpdate(0, pending_window_update_->connection_window_increment_);
+    }
+    pending_window_update_.reset();
+  }
+
   // Decoding incoming frames can generate outbound frames so flush pending.
   return sendPendingFrames();
 }
@@ -974,6 +1025,10 @@ ConnectionImpl::StreamImpl* ConnectionImpl::getStreamUnchecked(int32_t stream_id
 int ConnectionImpl::onData(int32_t stream_id, const uint8_t* data, size_t len) {
   ASSERT(connection_.state() == Network::Connection::State::Open);
   StreamImpl* stream = getStream(stream_id);
+  if (flow_control_window_tuner_ != nullptr && flow_control_window_tuner_->onData(len)) {
+    // PINGs are not submitted from within the frame callbacks. See dispatch().
+    pending_bdp_ping_ = true;
+  }
   // If this results in buffering too much data, the watermark buffer will call
   // pendingRecvBufferHighWatermark, resulting in ++read_disable_count_
   stream->pending_recv_data_->add(data, len);
@@ -1027,6 +1082,10 @@ Status ConnectionImpl::onBeforeFrameReceived(int32_t stream_id, size_t length, u
   if (type != NGHTTP2_HEADERS && type != NGHTTP2_DATA) {
     status = trackInboundFrames(stream_id, length, type, flags, 0);
   }
+  if (hpack_table_size_tuner_ != nullptr &&
+      (type == NGHTTP2_HEADERS || type == NGHTTP2_CONTINUATION)) {
+    hpack_table_size_tuner_->onHeaderBlockFragment(length);
+  }
 
   return status;
 }
@@ -1058,6 +1117,11 @@ Status ConnectionImpl::onFrameReceived(const nghttp2_frame* frame) {
     safeMemcpy(&data, &(frame->ping.opaque_data));
     ENVOY_CONN_LOG(trace, "recv PING ACK {}", connection_, data);
 
+    if (flow_control_window_tuner_ != nullptr &&
+        fromEndianness<ByteOrder::BigEndian>(data) == FlowControlWindowTuner::BdpPingPayload) {
+      queueWindowUpdate(flow_control_window_tuner_->onPingAck());
+      return okStatus();
+    }
     onKeepaliveResponse();
     return okStatus();
   }
@@ -1090,6 +1154,14 @@ Status ConnectionImpl::onFrameReceived(const nghttp2_frame* frame) {
     onSettings(frame->settings);
   }
 
+  if (hpack_table_size_tuner_ != nullptr && frame->hd.type == NGHTTP2_HEADERS) {
+    if (absl::optional<uint32_t> table_size = hpack_table_size_tuner_->onHeaderBlockEnd();
+        table_size.has_value()) {
+      // SETTINGS are not submitted from within the frame callbacks. See dispatch().
+      pending_hpack_table_size_ = table_size;
+    }
+  }
+
   StreamImpl* stream = getStreamUnchecked(frame->hd.stream_id);
   if (!stream) {
     return okStatus();
@@ -1293,10 +1365,18 @@ ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   // deleted before the codec object is deleted. This is presently guaranteed by the
   // destruction order of the Network::ConnectionImpl object where write_buffer_ is
   // destroyed before the filter_manager_ which owns the codec through Http::ConnectionManagerImpl.
-  connection_.write(buffer, false);
+  writeOutbound(buffer);
   return length;
 }
 
+void ConnectionImpl::writeOutbound(Buffer::OwnedImpl& output) {
+  if (coalesce_writes_) {
+    coalesced_write_buffer_.move(output);
+  } else {
+    connection_.write(output, false);
+  }
+}
+
 Status ConnectionImpl::onStreamClose(StreamImpl* stream, uint32_t error_code) {
   if (stream) {
     const int32_t stream_id = stream->stream_id_;
@@ -1408,6 +1488,9 @@ int ConnectionImpl::onMetadataFrameComplete(int32_t stream_id, bool end_metadata
 
 int ConnectionImpl::saveHeader(const nghttp2_frame* frame, HeaderString&& name,
                                HeaderString&& value) {
+  if (hpack_table_size_tuner_ != nullptr) {
+    hpack_table_size_tuner_->onHeader(name.size(), value.size());
+  }
   StreamImpl* stream = getStreamUnchecked(frame->hd.stream_id);
   if (!stream) {
     // We have seen 1 or 2 crashes where we get a headers callback but there is no associated
@@ -1447,7 +1530,14 @@ Status ConnectionImpl::sendPendingFrames() {
     return okStatus();
   }
 
+  if (send_pending_frames_callback_ != nullptr) {
+    // Everything submitted so far is sent below.
+    send_pending_frames_callback_->cancel();
+  }
   const int rc = adapter_->Send();
+  if (coalesced_write_buffer_.length() > 0) {
+    connection_.write(coalesced_write_buffer_, false);
+  }
   if (rc != 0) {
     ASSERT(rc == NGHTTP2_ERR_CALLBACK_FAILURE);
     return codecProtocolError(nghttp2_strerror(rc));
@@ -1496,6 +1586,25 @@ bool ConnectionImpl::sendPendingFramesAndHandleError() {
   return false;
 }
 
+bool ConnectionImpl::sendOrDeferPendingFrames() {
+  if (!coalesce_writes_ || dispatching_) {
+    return sendPendingFramesAndHandleError();
+  }
+  if (send_pending_frames_callback_ == nullptr) {
+    send_pending_frames_callback_ = connection_.dispatcher().createSchedulableCallback(
+        [this]() { onDeferredSendPendingFrames(); });
+  }
+  if (!send_pending_frames_callback_->enabled()) {
+    send_pending_frames_callback_->scheduleCallbackCurrentIteration();
+  }
+  return false;
+}
+
+void ConnectionImpl::onDeferredSendPendingFrames() {
+  ENVOY_CONN_LOG(trace, "sending coalesced frames", connection_);
+  sendPendingFramesAndHandleError();
+}
+
 void ConnectionImpl::sendSettingsHelper(
     const envoy::config::core::v3::Http2ProtocolOptions& http2_options, bool disable_push) {
   absl::InlinedVector<http2::adapter::Http2Setting, 10> settings;
@@ -1535,7 +1644,9 @@ void ConnectionImpl::sendSettingsHelper(
   // Insert named parameters.
   settings.insert(
       settings.end(),
-      {{http2::adapter::HEADER_TABLE_SIZE, http2_options.hpack_table_size().value()},
+      {{http2::adapter::HEADER_TABLE_SIZE, hpack_table_size_tuner_ != nullptr
+                                               ? hpack_table_size_tuner_->tableSize()
+                                               : http2_options.hpack_table_size().value()},
        {http2::adapter::ENABLE_CONNECT_PROTOCOL, http2_options.allow_connect()},
        {http2::adapter::MAX_CONCURRENT_STREAMS, http2_options.max_concurrent_streams().value()},
        {http2::adapter::INITIAL_WINDOW_SIZE, http2_options.initial_stream_window_size().value()}});
@@ -1998,10 +2109,12 @@ ServerConnectionImpl::ServerConnectionImpl(
     const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
     const uint32_t max_request_headers_kb, const uint32_t max_request_headers_count,
     envoy::config::core::v3::HttpProtocolOptions::HeadersWithUnderscoresAction
-        headers_with_underscores_action)
+        headers_with_underscores_action,
+    HeaderMapLayout header_map_layout)
     : ConnectionImpl(connection, stats, random_generator, http2_options, max_request_headers_kb,
                      max_request_headers_count),
-      callbacks_(callbacks), headers_with_underscores_action_(headers_with_underscores_action) {
+      callbacks_(callbacks), headers_with_underscores_action_(headers_with_underscores_action),
+      header_map_layout_(header_map_layout) {
   Http2Options h2_options(http2_options, max_request_headers_kb);
 
   auto visitor = std::make_unique<http2::adapter::CallbackVisitor>(
@@ -2039,7 +2152,8 @@ Status ServerConnectionImpl::onBeginHeaders(const nghttp2_frame* frame) {
     return okStatus();
   }
 
-  ServerStreamImplPtr stream(new ServerStreamImpl(*this, per_stream_buffer_limit_));
+  ServerStreamImplPtr stream(
+      new ServerStreamImpl(*this, per_stream_buffer_limit_, header_map_layout_));
   if (connection_.aboveHighWatermark()) {
     stream->runHighWatermarkCallbacks();
   }
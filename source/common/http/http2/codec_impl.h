@@ -26,6 +26,8 @@
 #include "source/common/http/codec_helper.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/http2/codec_stats.h"
+#include "source/common/http/http2/flow_control_window_tuner.h"
+#include "source/common/http/http2/hpack_table_size_tuner.h"
 #include "source/common/http/http2/metadata_decoder.h"
 #include "source/common/http/http2/metadata_encoder.h"
 #include "source/common/http/http2/protocol_constraints.h"
@@ -340,6 +342,10 @@ protected:
     bool pending_send_buffer_high_watermark_called_ : 1;
     bool reset_due_to_messaging_error_ : 1;
     bool defer_processing_backedup_streams_ : 1;
+    // Backs the header maps decoded on this stream, if enabled by
+    // envoy.reloadable_features.http_header_map_arena. The maps keep it alive after they have been
+    // handed to the decoder.
+    const HeaderMapArenaSharedPtr header_map_arena_;
     absl::string_view details_;
 
     /**
@@ -423,7 +429,7 @@ protected:
     ClientStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit,
                      ResponseDecoder& response_decoder)
         : StreamImpl(parent, buffer_limit), response_decoder_(response_decoder),
-          headers_or_trailers_(ResponseHeaderMapImpl::create()) {}
+          headers_or_trailers_(ResponseHeaderMapImpl::create(header_map_arena_)) {}
 
     // Http::MultiplexedStreamImplBase
     // Client streams do not need a flush timer because we currently assume that any failure
@@ -447,9 +453,11 @@ protected:
       // If we are waiting for informational headers, make a new response header map, otherwise
       // we are about to receive trailers. The codec makes sure this is the only valid sequence.
       if (received_noninformational_headers_) {
-        headers_or_trailers_.emplace<ResponseTrailerMapPtr>(ResponseTrailerMapImpl::create());
+        headers_or_trailers_.emplace<ResponseTrailerMapPtr>(
+            ResponseTrailerMapImpl::create(header_map_arena_));
       } else {
-        headers_or_trailers_.emplace<ResponseHeaderMapPtr>(ResponseHeaderMapImpl::create());
+        headers_or_trailers_.emplace<ResponseHeaderMapPtr>(
+            ResponseHeaderMapImpl::create(header_map_arena_));
       }
     }
     HeaderMapPtr cloneTrailers(const HeaderMap& trailers) override {
@@ -477,8 +485,11 @@ protected:
    * Server side stream (response).
    */
   struct ServerStreamImpl : public StreamImpl, public ResponseEncoder {
-    ServerStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit)
-        : StreamImpl(parent, buffer_limit), headers_or_trailers_(RequestHeaderMapImpl::create()) {}
+    ServerStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit,
+                     HeaderMapLayout header_map_layout)
+        : StreamImpl(parent, buffer_limit), header_map_layout_(header_map_layout),
+          headers_or_trailers_(
+              RequestHeaderMapImpl::create(header_map_arena_, header_map_layout_)) {}
 
     // StreamImpl
     void destroy() override;
@@ -498,7 +509,8 @@ protected:
       }
     }
     void allocTrailers() override {
-      headers_or_trailers_.emplace<RequestTrailerMapPtr>(RequestTrailerMapImpl::create());
+      headers_or_trailers_.emplace<RequestTrailerMapPtr>(
+          RequestTrailerMapImpl::create(header_map_arena_, header_map_layout_));
     }
     HeaderMapPtr cloneTrailers(const HeaderMap& trailers) override {
       return createHeaderMap<ResponseTrailerMapImpl>(trailers);
@@ -520,6 +532,7 @@ protected:
     // ScopeTrackedObject
     void dumpState(std::ostream& os, int indent_level) const override;
 
+    const HeaderMapLayout header_map_layout_;
     absl::variant<RequestHeaderMapSharedPtr, RequestTrailerMapPtr> headers_or_trailers_;
 
     bool streamErrorOnInvalidHttpMessage() const override {
@@ -564,6 +577,19 @@ protected:
    * Return true if the disconnect callback has been scheduled.
    */
   bool sendPendingFramesAndHandleError();
+
+  /**
+   * Used by streams after submitting frames. When write coalescing is enabled and the codec is not
+   * dispatching, this schedules a single call to sendPendingFramesAndHandleError() for the
+   * current event loop iteration, so that the frames of all streams encoding in the same
+   * iteration go out in one write. Otherwise this is sendPendingFramesAndHandleError().
+   * Return true if the disconnect callback has been scheduled.
+   */
+  bool sendOrDeferPendingFrames();
+  void onDeferredSendPendingFrames();
+  // Writes `output` to the connection, or appends it to the coalesced write buffer that is
+  // written once the pending frames have been sent.
+  void writeOutbound(Buffer::OwnedImpl& output);
   void sendSettings(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
                     bool disable_push);
   void sendSettingsHelper(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
@@ -603,6 +629,9 @@ protected:
 
   // Whether to use the new HTTP/2 library.
   const bool use_oghttp2_library_;
+  // Whether frames submitted by streams are sent once per event loop iteration and written to the
+  // connection in a single buffer.
+  const bool coalesce_writes_;
   static Http2Callbacks http2_callbacks_;
 
   // If deferred processing, the streams will be in LRU order based on when the
@@ -635,6 +664,17 @@ protected:
   // RST_STREAM.
   bool is_outbound_flood_monitored_control_frame_ = 0;
   ProtocolConstraints protocol_constraints_;
+  // Set if the advertised HPACK table size is tuned from the received header blocks.
+  HpackTableSizeTunerPtr hpack_table_size_tuner_;
+  // HPACK table size to advertise in a SETTINGS frame once the current dispatch completes.
+  absl::optional<uint32_t> pending_hpack_table_size_;
+  // Set if the advertised flow-control windows grow from the estimated bandwidth-delay product.
+  FlowControlWindowTunerPtr flow_control_window_tuner_;
+  // Whether to send a PING starting a bandwidth-delay product sample once the current dispatch
+  // completes.
+  bool pending_bdp_ping_{};
+  // Flow-control windows to advertise once the current dispatch completes.
+  absl::optional<FlowControlWindowTuner::WindowUpdate> pending_window_update_;
 
   // For the flood mitigation to work the onSend callback must be called once for each outbound
   // frame. This is what the nghttp2 library is doing, however this is not documented. The
@@ -657,6 +697,10 @@ protected:
   // Send a keepalive ping, and set the idle timer for ping timeout.
   void sendKeepalive();
 
+  // Queues a change of the flow-control windows to advertise at the end of the current or next
+  // dispatch.
+  void queueWindowUpdate(absl::optional<FlowControlWindowTuner::WindowUpdate> update);
+
   const MonotonicTime& lastReceivedDataTime() { return last_received_data_time_; }
 
 private:
@@ -700,6 +744,9 @@ private:
   bool dispatching_ : 1;
   bool raised_goaway_ : 1;
   Event::SchedulableCallbackPtr protocol_constraint_violation_callback_;
+  Event::SchedulableCallbackPtr send_pending_frames_callback_;
+  // Frames produced by a single sendPendingFrames() call when coalescing writes.
+  Buffer::OwnedImpl coalesced_write_buffer_;
   Random::RandomGenerator& random_;
   MonotonicTime last_received_data_time_{};
   Event::TimerPtr keepalive_send_timer_;
@@ -749,7 +796,8 @@ public:
                        const uint32_t max_request_headers_kb,
                        const uint32_t max_request_headers_count,
                        envoy::config::core::v3::HttpProtocolOptions::HeadersWithUnderscoresAction
-                           headers_with_underscores_action);
+                           headers_with_underscores_action,
+                       HeaderMapLayout header_map_layout = HeaderMapLayout::LinkedList);
 
 private:
   // ConnectionImpl
@@ -777,6 +825,8 @@ private:
   // The action to take when a request header name contains underscore characters.
   envoy::config::core::v3::HttpProtocolOptions::HeadersWithUnderscoresAction
       headers_with_underscores_action_;
+  // Storage layout of the decoded request headers and trailers.
+  const HeaderMapLayout header_map_layout_;
 };
 
 } // namespace Http2
@@ -15,8 +15,12 @@ namespace Http2 {
  */
 #define ALL_HTTP2_CODEC_STATS(COUNTER, GAUGE)                                                      \
   COUNTER(dropped_headers_with_underscores)                                                        \
+  COUNTER(flow_control_window_decreased)                                                           \
+  COUNTER(flow_control_window_increased)                                                           \
   COUNTER(header_overflow)                                                                         \
   COUNTER(headers_cb_no_stream)                                                                    \
+  COUNTER(hpack_table_size_decreased)                                                              \
+  COUNTER(hpack_table_size_increased)                                                              \
   COUNTER(inbound_empty_frames_flood)                                                              \
   COUNTER(inbound_priority_frames_flood)                                                           \
   COUNTER(inbound_window_update_frames_flood)                                                      \
@@ -33,7 +37,8 @@ namespace Http2 {
   COUNTER(keepalive_timeout)                                                                       \
   GAUGE(streams_active, Accumulate)                                                                \
   GAUGE(pending_send_bytes, Accumulate)                                                            \
-  GAUGE(deferred_stream_close, Accumulate)
+  GAUGE(deferred_stream_close, Accumulate)                                                         \
+  GAUGE(hpack_table_size_advertised, Accumulate)
 
 /**
  * Wrapper struct for the HTTP/2 codec stats. @see stats_macros.h
@@ -0,0 +1,88 @@
+#include "source/common/http/http2/flow_control_window_tuner.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+namespace {
+
+// Largest flow-control window allowed by RFC 7540 section 6.9.1.
+constexpr uint64_t MaxWindowSize = (1U << 31) - 1;
+
+} // namespace
+
+FlowControlWindowTuner::FlowControlWindowTuner(
+    CodecStats& stats, const envoy::config::core::v3::Http2ProtocolOptions& http2_options)
+    : stats_(stats),
+      initial_stream_window_size_(http2_options.initial_stream_window_size().value()),
+      max_stream_window_size_(
+          http2_options.adaptive_flow_control().max_stream_window_size().value()),
+      stream_window_size_(initial_stream_window_size_),
+      largest_stream_window_size_(initial_stream_window_size_),
+      connection_window_size_(http2_options.initial_connection_window_size().value()) {
+  ASSERT(initial_stream_window_size_ <= max_stream_window_size_);
+}
+
+bool FlowControlWindowTuner::onData(uint64_t length) {
+  if (sampling_) {
+    sample_bytes_ += length;
+    return false;
+  }
+  if (stream_window_size_ == max_stream_window_size_) {
+    return false;
+  }
+  sampling_ = true;
+  sample_bytes_ = length;
+  return true;
+}
+
+absl::optional<FlowControlWindowTuner::WindowUpdate> FlowControlWindowTuner::onPingAck() {
+  if (!sampling_) {
+    return absl::nullopt;
+  }
+  const uint64_t sample_bytes = sample_bytes_;
+  sampling_ = false;
+  sample_bytes_ = 0;
+  if (sample_bytes * 100 < uint64_t(stream_window_size_) * GrowSamplePercent) {
+    return absl::nullopt;
+  }
+
+  const uint32_t new_window_size =
+      static_cast<uint32_t>(std::min<uint64_t>(max_stream_window_size_, sample_bytes * 2));
+  if (new_window_size <= stream_window_size_) {
+    return absl::nullopt;
+  }
+  stats_.flow_control_window_increased_.inc();
+  stream_window_size_ = new_window_size;
+
+  uint32_t connection_window_increment = 0;
+  if (stream_window_size_ > largest_stream_window_size_) {
+    const uint64_t new_connection_window_size = std::min<uint64_t>(
+        MaxWindowSize, connection_window_size_ + stream_window_size_ - largest_stream_window_size_);
+    connection_window_increment =
+        static_cast<uint32_t>(new_connection_window_size - connection_window_size_);
+    connection_window_size_ = new_connection_window_size;
+    largest_stream_window_size_ = stream_window_size_;
+  }
+  return WindowUpdate{stream_window_size_, connection_window_increment};
+}
+
+absl::optional<FlowControlWindowTuner::WindowUpdate>
+FlowControlWindowTuner::onReceiveBufferOverLimit() {
+  const uint32_t new_window_size = std::max(initial_stream_window_size_, stream_window_size_ / 2);
+  if (new_window_size == stream_window_size_) {
+    return absl::nullopt;
+  }
+  ASSERT(new_window_size < stream_window_size_);
+  stats_.flow_control_window_decreased_.inc();
+  stream_window_size_ = new_window_size;
+  return WindowUpdate{stream_window_size_, 0};
+}
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
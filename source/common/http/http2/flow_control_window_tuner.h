@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/config/core/v3/protocol.pb.h"
+
+#include "source/common/http/http2/codec_stats.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+// Adjusts the stream-level flow-control window advertised to the peer with
+// SETTINGS_INITIAL_WINDOW_SIZE, within the bounds configured by
+// `Http2ProtocolOptions.adaptive_flow_control`, from an estimate of the bandwidth-delay product of
+// the connection.
+//
+// The estimate is sampled as gRPC does: when DATA arrives and no sample is in progress, a PING
+// with the BdpPingPayload payload is sent, and the DATA bytes received until its ACK are the
+// sample.
+// 1. If a sample reaches GrowSamplePercent of the window, the window limits the throughput of the
+//    connection, so the window is grown to twice the sample.
+// 2. If a stream buffers more received data than its limit, the data is not consumed as fast as
+//    the peer sends it and the window only adds to the memory used by the stream, so the window is
+//    halved, down to the initial window.
+// The connection-level window grows along with the largest stream-level window advertised; as it
+// can't be shrunk, it keeps its size when the stream-level window is halved.
+class FlowControlWindowTuner {
+public:
+  // Payload of the PING frames sent to sample the bandwidth-delay product. The keepalive PING
+  // frames carry the current time instead.
+  static constexpr uint64_t BdpPingPayload = 0x4244502d50494e47; // "BDP-PING"
+  // The window grows when a sample is at least this percentage of the window.
+  static constexpr uint64_t GrowSamplePercent = 66;
+
+  // A change of the advertised windows.
+  struct WindowUpdate {
+    // The new stream-level window, to advertise with SETTINGS_INITIAL_WINDOW_SIZE.
+    uint32_t stream_window_size_;
+    // The increment of the connection-level window, to advertise with WINDOW_UPDATE. 0 if the
+    // connection-level window doesn't change.
+    uint32_t connection_window_increment_;
+  };
+
+  FlowControlWindowTuner(CodecStats& stats,
+                         const envoy::config::core::v3::Http2ProtocolOptions& http2_options);
+
+  // Stream-level window currently advertised to the peer.
+  uint32_t streamWindowSize() const { return stream_window_size_; }
+
+  // Called for each DATA payload received.
+  // @return true if a PING with BdpPingPayload should be sent to start a sample.
+  bool onData(uint64_t length);
+
+  // Called when the ACK of the PING starting the sample is received.
+  // @return the change of the windows to advertise to the peer, if any.
+  absl::optional<WindowUpdate> onPingAck();
+
+  // Called when a stream buffers more received data than its limit.
+  // @return the change of the windows to advertise to the peer, if any.
+  absl::optional<WindowUpdate> onReceiveBufferOverLimit();
+
+private:
+  CodecStats& stats_;
+  const uint32_t initial_stream_window_size_;
+  const uint32_t max_stream_window_size_;
+  uint32_t stream_window_size_;
+  // Largest stream-level window advertised, which the connection-level window was grown for.
+  uint32_t largest_stream_window_size_;
+  // Connection-level window advertised.
+  uint64_t connection_window_size_;
+  bool sampling_{};
+  uint64_t sample_bytes_{};
+};
+
+using FlowControlWindowTunerPtr = std::unique_ptr<FlowControlWindowTuner>;
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,77 @@
+#include "source/common/http/http2/hpack_table_size_tuner.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+namespace {
+
+// Smallest size the table grows to from an empty or very small table.
+constexpr uint64_t MinGrowthTableSize = 4096;
+
+} // namespace
+
+HpackTableSizeTuner::HpackTableSizeTuner(
+    CodecStats& stats, const envoy::config::core::v3::Http2ProtocolOptions& http2_options)
+    : stats_(stats), min_table_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                         http2_options.hpack_table_size_tuning(), min_table_size, 0)),
+      max_table_size_(http2_options.hpack_table_size_tuning().max_table_size().value()),
+      table_size_(std::clamp(http2_options.hpack_table_size().value(), min_table_size_,
+                             max_table_size_)) {
+  ASSERT(min_table_size_ <= max_table_size_);
+  stats_.hpack_table_size_advertised_.add(table_size_);
+}
+
+HpackTableSizeTuner::~HpackTableSizeTuner() {
+  stats_.hpack_table_size_advertised_.sub(table_size_);
+}
+
+absl::optional<uint32_t> HpackTableSizeTuner::onHeaderBlockEnd() {
+  if (++sampled_blocks_ < SampleHeaderBlocks) {
+    return absl::nullopt;
+  }
+  const uint64_t wire_bytes = wire_bytes_;
+  const uint64_t decoded_bytes = decoded_bytes_;
+  sampled_blocks_ = 0;
+  wire_bytes_ = 0;
+  decoded_bytes_ = 0;
+  if (decoded_bytes == 0) {
+    return absl::nullopt;
+  }
+
+  const uint64_t wire_percent = wire_bytes * 100 / decoded_bytes;
+  uint32_t new_table_size = table_size_;
+  if (wire_percent >= ShrinkWirePercent) {
+    new_table_size = std::max(min_table_size_, table_size_ / 2);
+    last_growth_wire_percent_.reset();
+  } else if (wire_percent <= GrowWirePercent &&
+             (!last_growth_wire_percent_.has_value() ||
+              wire_percent + MinGrowthGainPercent <= last_growth_wire_percent_.value())) {
+    new_table_size = static_cast<uint32_t>(
+        std::min<uint64_t>(max_table_size_, std::max<uint64_t>(uint64_t(table_size_) * 2,
+                                                               MinGrowthTableSize)));
+    last_growth_wire_percent_ = wire_percent;
+  }
+
+  if (new_table_size == table_size_) {
+    return absl::nullopt;
+  }
+  if (new_table_size > table_size_) {
+    stats_.hpack_table_size_increased_.inc();
+    stats_.hpack_table_size_advertised_.add(new_table_size - table_size_);
+  } else {
+    stats_.hpack_table_size_decreased_.inc();
+    stats_.hpack_table_size_advertised_.sub(table_size_ - new_table_size);
+  }
+  table_size_ = new_table_size;
+  return table_size_;
+}
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/config/core/v3/protocol.pb.h"
+
+#include "source/common/http/http2/codec_stats.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+// Adjusts the size of the HPACK dynamic table advertised to the peer with
+// SETTINGS_HEADER_TABLE_SIZE, within the bounds configured by
+// `Http2ProtocolOptions.hpack_table_size_tuning`, based on how well the header blocks received on
+// the connection compress.
+//
+// The header blocks are sampled in windows of SampleHeaderBlocks blocks. At the end of each
+// window the wire size of the blocks is compared with their decoded size:
+// 1. If the blocks compress well the peer is reusing the table, so its size is doubled. Further
+//    growth only happens while the growth keeps improving the compression.
+// 2. If the blocks barely compress the table is not paying for the memory it uses, so its size is
+//    halved.
+class HpackTableSizeTuner {
+public:
+  // Number of header blocks in each sampling window.
+  static constexpr uint32_t SampleHeaderBlocks = 32;
+  // The table grows when the wire size of a window is at most this percentage of its decoded size.
+  static constexpr uint64_t GrowWirePercent = 50;
+  // The table shrinks when the wire size of a window is at least this percentage of its decoded
+  // size.
+  static constexpr uint64_t ShrinkWirePercent = 80;
+  // Minimum reduction of the wire size percentage, relative to the window that triggered the last
+  // growth, for the table to grow again.
+  static constexpr uint64_t MinGrowthGainPercent = 5;
+
+  HpackTableSizeTuner(CodecStats& stats,
+                      const envoy::config::core::v3::Http2ProtocolOptions& http2_options);
+  ~HpackTableSizeTuner();
+
+  // Size of the table currently advertised to the peer.
+  uint32_t tableSize() const { return table_size_; }
+
+  // Called for each HEADERS or CONTINUATION frame received, with the length of the frame payload.
+  void onHeaderBlockFragment(uint64_t length) { wire_bytes_ += length; }
+
+  // Called for each header decoded from a header block.
+  void onHeader(uint64_t name_length, uint64_t value_length) {
+    decoded_bytes_ += name_length + value_length;
+  }
+
+  // Called once a complete header block has been received.
+  // @return the new table size to advertise to the peer, if it changed.
+  absl::optional<uint32_t> onHeaderBlockEnd();
+
+private:
+  CodecStats& stats_;
+  const uint32_t min_table_size_;
+  const uint32_t max_table_size_;
+  uint32_t table_size_;
+  uint32_t sampled_blocks_{};
+  uint64_t wire_bytes_{};
+  uint64_t decoded_bytes_{};
+  absl::optional<uint64_t> last_growth_wire_percent_;
+};
+
+using HpackTableSizeTunerPtr = std::unique_ptr<HpackTableSizeTuner>;
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
@@ -11,8 +11,10 @@ const std::chrono::minutes DefaultExpirationTime{5};
 const int MaxConsecutiveBrokenCount = 8;
 } // namespace
 
-Http3StatusTrackerImpl::Http3StatusTrackerImpl(Event::Dispatcher& dispatcher)
-    : expiration_timer_(dispatcher.createTimer([this]() -> void { onExpirationTimeout(); })) {}
+Http3StatusTrackerImpl::Http3StatusTrackerImpl(Event::Dispatcher& dispatcher,
+                                               MarkCallback mark_cb)
+    : expiration_timer_(dispatcher.createTimer([this]() -> void { onExpirationTimeout(); })),
+      mark_cb_(std::move(mark_cb)) {}
 
 bool Http3StatusTrackerImpl::isHttp3Broken() const { return state_ == State::Broken; }
 
@@ -23,27 +25,52 @@ bool Http3StatusTrackerImpl::hasHttp3FailedRecently() const {
 }
 
 void Http3StatusTrackerImpl::markHttp3Broken() {
-  state_ = State::Broken;
-  if (!expiration_timer_->enabled()) {
-    std::chrono::minutes expiration_in_min =
-        DefaultExpirationTime * (1 << consecutive_broken_count_);
-    expiration_timer_->enableTimer(
-        std::chrono::duration_cast<std::chrono::milliseconds>(expiration_in_min));
-    if (consecutive_broken_count_ < MaxConsecutiveBrokenCount) {
-      ++consecutive_broken_count_;
-    }
+  applyMark(Mark::Broken);
+  if (mark_cb_) {
+    mark_cb_(Mark::Broken);
   }
 }
 
 void Http3StatusTrackerImpl::markHttp3Confirmed() {
-  state_ = State::Confirmed;
-  consecutive_broken_count_ = 0;
-  if (expiration_timer_->enabled()) {
-    expiration_timer_->disableTimer();
+  applyMark(Mark::Confirmed);
+  if (mark_cb_) {
+    mark_cb_(Mark::Confirmed);
+  }
+}
+
+void Http3StatusTrackerImpl::markHttp3FailedRecently() {
+  applyMark(Mark::FailedRecently);
+  if (mark_cb_) {
+    mark_cb_(Mark::FailedRecently);
   }
 }
 
-void Http3StatusTrackerImpl::markHttp3FailedRecently() { state_ = State::FailedRecently; }
+void Http3StatusTrackerImpl::applyMark(Mark mark) {
+  switch (mark) {
+  case Mark::Broken:
+    state_ = State::Broken;
+    if (!expiration_timer_->enabled()) {
+      std::chrono::minutes expiration_in_min =
+          DefaultExpirationTime * (1 << consecutive_broken_count_);
+      expiration_timer_->enableTimer(
+          std::chrono::duration_cast<std::chrono::milliseconds>(expiration_in_min));
+      if (consecutive_broken_count_ < MaxConsecutiveBrokenCount) {
+        ++consecutive_broken_count_;
+      }
+    }
+    return;
+  case Mark::Confirmed:
+    state_ = State::Confirmed;
+    consecutive_broken_count_ = 0;
+    if (expiration_timer_->enabled()) {
+      expiration_timer_->disableTimer();
+    }
+    return;
+  case Mark::FailedRecently:
+    state_ = State::FailedRecently;
+    return;
+  }
+}
 
 void Http3StatusTrackerImpl::onExpirationTimeout() {
   if (state_ != State::Broken) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "envoy/event/dispatcher.h"
@@ -13,7 +14,17 @@ namespace Http {
 // subject to exponential backoff.
 class Http3StatusTrackerImpl : public HttpServerPropertiesCache::Http3StatusTracker {
 public:
-  explicit Http3StatusTrackerImpl(Event::Dispatcher& dispatcher);
+  // The statuses which can be marked on a tracker.
+  enum class Mark {
+    Broken,
+    Confirmed,
+    FailedRecently,
+  };
+  // Called with the statuses marked on the tracker, to share them with the trackers of the same
+  // origin on the other workers.
+  using MarkCallback = std::function<void(Mark)>;
+
+  explicit Http3StatusTrackerImpl(Event::Dispatcher& dispatcher, MarkCallback mark_cb = nullptr);
 
   // Returns true if HTTP/3 is broken.
   bool isHttp3Broken() const override;
@@ -28,6 +39,10 @@ public:
   // Marks HTTP/3 as failed recently.
   void markHttp3FailedRecently() override;
 
+  // Applies a status marked on another tracker of the same origin, without calling the mark
+  // callback.
+  void applyMark(Mark mark);
+
 private:
   enum class State {
     Pending,
@@ -44,6 +59,7 @@ private:
   int consecutive_broken_count_{};
   // The timer which tracks when HTTP/3 broken status should expire
   Event::TimerPtr expiration_timer_;
+  const MarkCallback mark_cb_;
 };
 
 } // namespace Http
@@ -152,6 +152,20 @@ HttpServerPropertiesCacheImpl::~HttpServerPropertiesCacheImpl() = default;
 
 void HttpServerPropertiesCacheImpl::setAlternatives(const Origin& origin,
                                                     std::vector<AlternateProtocol>& protocols) {
+  auto it = setAlternativesImpl(origin, protocols);
+  if (update_callbacks_) {
+    update_callbacks_->onAlternativesSet(origin, *it->second.protocols);
+  }
+}
+
+void HttpServerPropertiesCacheImpl::applyAlternatives(const Origin& origin,
+                                                      std::vector<AlternateProtocol> protocols) {
+  setAlternativesImpl(origin, protocols);
+}
+
+HttpServerPropertiesCacheImpl::ProtocolsMap::iterator
+HttpServerPropertiesCacheImpl::setAlternativesImpl(const Origin& origin,
+                                                   std::vector<AlternateProtocol>& protocols) {
   OriginDataWithOptRef data;
   data.protocols = protocols;
   auto it = setPropertiesImpl(origin, data);
@@ -159,6 +173,7 @@ void HttpServerPropertiesCacheImpl::setAlternatives(const Origin& origin,
     key_value_store_->addOrUpdate(originToString(origin), originDataToStringForCache(it->second),
                                   absl::nullopt);
   }
+  return it;
 }
 
 void HttpServerPropertiesCacheImpl::setSrtt(const Origin& origin, std::chrono::microseconds srtt) {
@@ -283,17 +298,33 @@ HttpServerPropertiesCacheImpl::getOrCreateHttp3StatusTracker(const Origin& origi
   auto entry_it = protocols_.find(origin);
   if (entry_it != protocols_.end()) {
     if (entry_it->second.h3_status_tracker == nullptr) {
-      entry_it->second.h3_status_tracker = std::make_unique<Http3StatusTrackerImpl>(dispatcher_);
+      entry_it->second.h3_status_tracker = createHttp3StatusTracker(origin);
     }
     return *entry_it->second.h3_status_tracker;
   }
 
   OriginDataWithOptRef data;
-  data.h3_status_tracker = std::make_unique<Http3StatusTrackerImpl>(dispatcher_);
+  data.h3_status_tracker = createHttp3StatusTracker(origin);
   auto it = setPropertiesImpl(origin, data);
   return *it->second.h3_status_tracker;
 }
 
+void HttpServerPropertiesCacheImpl::applyHttp3StatusMark(const Origin& origin,
+                                                         Http3StatusTrackerImpl::Mark mark) {
+  // All the trackers of the cache are created by createHttp3StatusTracker().
+  static_cast<Http3StatusTrackerImpl&>(getOrCreateHttp3StatusTracker(origin)).applyMark(mark);
+}
+
+Http3StatusTrackerPtr
+HttpServerPropertiesCacheImpl::createHttp3StatusTracker(const Origin& origin) {
+  return std::make_unique<Http3StatusTrackerImpl>(
+      dispatcher_, [this, origin](Http3StatusTrackerImpl::Mark mark) {
+        if (update_callbacks_) {
+          update_callbacks_->onHttp3StatusMarked(origin, mark);
+        }
+      });
+}
+
 absl::string_view HttpServerPropertiesCacheImpl::getCanonicalSuffix(absl::string_view hostname) {
   for (const std::string& suffix : canonical_suffixes_) {
     if (absl::EndsWith(hostname, suffix)) {
@@ -52,6 +52,19 @@ public:
     uint32_t concurrent_streams;
   };
 
+  // Receives the alternate protocols and HTTP/3 statuses set on the cache, to share them with the
+  // caches of the other workers.
+  class UpdateCallbacks {
+  public:
+    virtual ~UpdateCallbacks() = default;
+
+    virtual void onAlternativesSet(const Origin& origin,
+                                   const std::vector<AlternateProtocol>& protocols) PURE;
+    virtual void onHttp3StatusMarked(const Origin& origin,
+                                     Http3StatusTrackerImpl::Mark mark) PURE;
+  };
+  using UpdateCallbacksPtr = std::unique_ptr<UpdateCallbacks>;
+
   // Converts an Origin to a string which can be parsed by stringToOrigin.
   static std::string originToString(const HttpServerPropertiesCache::Origin& origin);
   // Converts a string from originToString back to structured format.
@@ -92,6 +105,17 @@ public:
   HttpServerPropertiesCache::Http3StatusTracker&
   getOrCreateHttp3StatusTracker(const Origin& origin) override;
 
+  // Sets the callbacks receiving the updates made to the cache from now on.
+  void setUpdateCallbacks(UpdateCallbacksPtr&& callbacks) {
+    update_callbacks_ = std::move(callbacks);
+  }
+  // Applies alternate protocols set on the cache of another worker, without reporting them to the
+  // update callbacks.
+  void applyAlternatives(const Origin& origin, std::vector<AlternateProtocol> protocols);
+  // Applies an HTTP/3 status marked on the cache of another worker, without reporting it to the
+  // update callbacks.
+  void applyHttp3StatusMark(const Origin& origin, Http3StatusTrackerImpl::Mark mark);
+
 private:
   // Time source used to check expiration of entries.
   Event::Dispatcher& dispatcher_;
@@ -129,6 +153,11 @@ private:
     uint32_t concurrent_streams{0};
   };
 
+  ProtocolsMap::iterator setAlternativesImpl(const Origin& origin,
+                                             std::vector<AlternateProtocol>& protocols);
+
+  Http3StatusTrackerPtr createHttp3StatusTracker(const Origin& origin);
+
   ProtocolsMap::iterator setPropertiesImpl(const Origin& origin, OriginDataWithOptRef& origin_data);
 
   ProtocolsMap::iterator addOriginData(const Origin& origin, OriginData&& origin_data);
@@ -155,6 +184,9 @@ private:
   std::vector<std::string> canonical_suffixes_;
 
   const size_t max_entries_;
+
+  // The callbacks sharing the updates with the other workers, if any.
+  UpdateCallbacksPtr update_callbacks_;
 };
 
 } // namespace Http
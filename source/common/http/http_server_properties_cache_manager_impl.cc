@@ -7,6 +7,7 @@
 #include "source/common/config/utility.h"
 #include "source/common/http/http_server_properties_cache_impl.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/flat_hash_map.h"
 
@@ -15,10 +16,55 @@ namespace Http {
 
 SINGLETON_MANAGER_REGISTRATION(alternate_protocols_cache_manager);
 
+// Shares the updates made on the cache of a worker with the caches of the same name on the other
+// workers, so that they don't each have to learn the alternate protocols of an origin, or that
+// HTTP/3 is broken for it, on their own. The updates are posted to the main thread, which applies
+// them on the other threads.
+class HttpServerPropertiesCacheManagerImpl::CacheUpdateForwarder
+    : public HttpServerPropertiesCacheImpl::UpdateCallbacks {
+public:
+  CacheUpdateForwarder(std::weak_ptr<HttpServerPropertiesCacheManagerImpl> manager,
+                       Event::Dispatcher& main_thread_dispatcher, const std::string& name,
+                       Event::Dispatcher& dispatcher)
+      : manager_(std::move(manager)), main_thread_dispatcher_(main_thread_dispatcher),
+        name_(name), dispatcher_(dispatcher) {}
+
+  // HttpServerPropertiesCacheImpl::UpdateCallbacks
+  void onAlternativesSet(const HttpServerPropertiesCache::Origin& origin,
+                         const std::vector<HttpServerPropertiesCache::AlternateProtocol>&
+                             protocols) override {
+    forward([origin, protocols](HttpServerPropertiesCacheImpl& cache) {
+      cache.applyAlternatives(origin, protocols);
+    });
+  }
+  void onHttp3StatusMarked(const HttpServerPropertiesCache::Origin& origin,
+                           Http3StatusTrackerImpl::Mark mark) override {
+    forward([origin, mark](HttpServerPropertiesCacheImpl& cache) {
+      cache.applyHttp3StatusMark(origin, mark);
+    });
+  }
+
+private:
+  void forward(CacheUpdate update) {
+    main_thread_dispatcher_.post(
+        [manager = manager_, name = name_, source = &dispatcher_, update = std::move(update)]() {
+          if (auto locked_manager = manager.lock()) {
+            locked_manager->applyToOtherThreads(name, source, update);
+          }
+        });
+  }
+
+  const std::weak_ptr<HttpServerPropertiesCacheManagerImpl> manager_;
+  Event::Dispatcher& main_thread_dispatcher_;
+  const std::string name_;
+  // The dispatcher of the thread of the cache, which already has the updates.
+  Event::Dispatcher& dispatcher_;
+};
+
 HttpServerPropertiesCacheManagerImpl::HttpServerPropertiesCacheManagerImpl(
     AlternateProtocolsData& data, ThreadLocal::SlotAllocator& tls)
     : data_(data), slot_(tls) {
-  slot_.set([](Event::Dispatcher& /*dispatcher*/) { return std::make_shared<State>(); });
+  slot_.set([](Event::Dispatcher& dispatcher) { return std::make_shared<State>(dispatcher); });
 }
 
 HttpServerPropertiesCacheSharedPtr HttpServerPropertiesCacheManagerImpl::getCache(
@@ -76,10 +122,34 @@ HttpServerPropertiesCacheSharedPtr HttpServerPropertiesCacheManagerImpl::getCach
     }
   }
 
+  if (data_.concurrency_ > 1 &&
+      Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.share_http_server_properties_across_workers")) {
+    new_cache->setUpdateCallbacks(std::make_unique<CacheUpdateForwarder>(
+        weak_from_this(), data_.dispatcher_, options.name(), dispatcher));
+  }
+
   (*slot_).caches_.emplace(options.name(), CacheWithOptions{options, new_cache});
   return new_cache;
 }
 
+void HttpServerPropertiesCacheManagerImpl::applyToOtherThreads(const std::string& name,
+                                                               const Event::Dispatcher* source,
+                                                               CacheUpdate update) {
+  if (slot_.isShutdown()) {
+    return;
+  }
+  slot_.runOnAllThreads([name, source, update](OptRef<State> state) {
+    if (!state.has_value() || &state->dispatcher_ == source) {
+      return;
+    }
+    auto existing_cache = state->caches_.find(name);
+    if (existing_cache != state->caches_.end()) {
+      update(*existing_cache->second.cache_);
+    }
+  });
+}
+
 HttpServerPropertiesCacheManagerSharedPtr HttpServerPropertiesCacheManagerFactoryImpl::get() {
   return singleton_manager_.getTyped<HttpServerPropertiesCacheManager>(
       SINGLETON_MANAGER_REGISTERED_NAME(alternate_protocols_cache_manager),
@@ -7,6 +7,8 @@
 #include "envoy/singleton/manager.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/http/http_server_properties_cache_impl.h"
+
 #include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
@@ -23,8 +25,10 @@ struct AlternateProtocolsData {
   uint32_t concurrency_;
 };
 
-class HttpServerPropertiesCacheManagerImpl : public HttpServerPropertiesCacheManager,
-                                             public Singleton::Instance {
+class HttpServerPropertiesCacheManagerImpl
+    : public HttpServerPropertiesCacheManager,
+      public Singleton::Instance,
+      public std::enable_shared_from_this<HttpServerPropertiesCacheManagerImpl> {
 public:
   HttpServerPropertiesCacheManagerImpl(AlternateProtocolsData& data,
                                        ThreadLocal::SlotAllocator& tls);
@@ -35,22 +39,33 @@ public:
            Event::Dispatcher& dispatcher) override;
 
 private:
+  class CacheUpdateForwarder;
+  using CacheUpdate = std::function<void(HttpServerPropertiesCacheImpl&)>;
+
   // Contains a cache and the options associated with it.
   struct CacheWithOptions {
     CacheWithOptions(const envoy::config::core::v3::AlternateProtocolsCacheOptions& options,
-                     HttpServerPropertiesCacheSharedPtr cache)
+                     std::shared_ptr<HttpServerPropertiesCacheImpl> cache)
         : options_(options), cache_(cache) {}
 
     const envoy::config::core::v3::AlternateProtocolsCacheOptions options_;
-    HttpServerPropertiesCacheSharedPtr cache_;
+    std::shared_ptr<HttpServerPropertiesCacheImpl> cache_;
   };
 
   // Per-thread state.
   struct State : public ThreadLocal::ThreadLocalObject {
+    explicit State(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+    Event::Dispatcher& dispatcher_;
     // Map from config name to cache for that config.
     absl::flat_hash_map<std::string, CacheWithOptions> caches_;
   };
 
+  // Applies an update made on the cache of the thread of `source` to the caches of the same name
+  // on all the other threads. Must be called on the main thread.
+  void applyToOtherThreads(const std::string& name, const Event::Dispatcher* source,
+                           CacheUpdate update);
+
   AlternateProtocolsData& data_;
 
   // Thread local state for the cache.
@@ -212,6 +212,12 @@ initializeAndValidateOptions(const envoy::config::core::v3::Http2ProtocolOptions
     options_clone.mutable_hpack_table_size()->set_value(OptionsLimits::DEFAULT_HPACK_TABLE_SIZE);
   }
   ASSERT(options_clone.hpack_table_size().value() <= OptionsLimits::MAX_HPACK_TABLE_SIZE);
+  if (options.has_hpack_table_size_tuning() &&
+      options.hpack_table_size_tuning().min_table_size().value() >
+          options.hpack_table_size_tuning().max_table_size().value()) {
+    throw EnvoyException(
+        "the HPACK table size tuning min_table_size must not be larger than max_table_size");
+  }
   if (!options_clone.has_max_concurrent_streams()) {
     options_clone.mutable_max_concurrent_streams()->set_value(
         OptionsLimits::DEFAULT_MAX_CONCURRENT_STREAMS);
@@ -227,6 +233,12 @@ initializeAndValidateOptions(const envoy::config::core::v3::Http2ProtocolOptions
              OptionsLimits::MIN_INITIAL_STREAM_WINDOW_SIZE &&
          options_clone.initial_stream_window_size().value() <=
              OptionsLimits::MAX_INITIAL_STREAM_WINDOW_SIZE);
+  if (options.has_adaptive_flow_control() &&
+      options.adaptive_flow_control().max_stream_window_size().value() <
+          options_clone.initial_stream_window_size().value()) {
+    throw EnvoyException("the adaptive flow control max_stream_window_size must not be smaller "
+                         "than initial_stream_window_size");
+  }
   if (!options_clone.has_initial_connection_window_size()) {
     options_clone.mutable_initial_connection_window_size()->set_value(
         OptionsLimits::DEFAULT_INITIAL_CONNECTION_WINDOW_SIZE);
@@ -691,6 +703,25 @@ Utility::PreparedLocalReplyPtr Utility::prepareLocalReply(const EncodeFunctions&
       std::move(body_text), encode_functions.encode_headers_, encode_functions.encode_data_});
 }
 
+namespace {
+
+// Takes over the body of a local reply so that large bodies, e.g. direct responses read from
+// files, are handed to the codec without being copied into buffer slices.
+class LocalReplyBodyFragment : public Buffer::BufferFragment {
+public:
+  explicit LocalReplyBodyFragment(std::string&& body) : body_(std::move(body)) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return body_.data(); }
+  size_t size() const override { return body_.size(); }
+  void done() override { delete this; }
+
+private:
+  const std::string body_;
+};
+
+} // namespace
+
 void Utility::encodeLocalReply(const bool& is_reset, PreparedLocalReplyPtr prepared_local_reply) {
   ASSERT(prepared_local_reply != nullptr);
   ResponseHeaderMapPtr response_headers{std::move(prepared_local_reply->response_headers_)};
@@ -710,7 +741,13 @@ void Utility::encodeLocalReply(const bool& is_reset, PreparedLocalReplyPtr prepa
   prepared_local_reply->encode_headers_(std::move(response_headers), bodyless_response);
   // encode_headers() may have changed the referenced is_reset so we need to test it
   if (!bodyless_response && !is_reset) {
-    Buffer::OwnedImpl buffer(prepared_local_reply->response_body_);
+    Buffer::OwnedImpl buffer;
+    if (prepared_local_reply->response_body_.size() > Buffer::Slice::default_slice_size_) {
+      buffer.addBufferFragment(
+          *new LocalReplyBodyFragment(std::move(prepared_local_reply->response_body_)));
+    } else {
+      buffer.add(prepared_local_reply->response_body_);
+    }
     prepared_local_reply->encode_data_(buffer, true);
   }
 }
@@ -29,7 +29,7 @@ void ManagerImpl::add(const Target& target) {
     // it's important in this case that count_ was incremented above before calling the target,
     // because if the target calls the init manager back immediately, count_ will be decremented
     // here (see the definition of watcher_ above).
-    target_handle->initialize(watcher_);
+    initializeTarget(*target_handle);
     return;
   case State::Initialized:
     // If the manager has already completed initialization, consider this a programming error.
@@ -56,7 +56,7 @@ void ManagerImpl::initialize(const Watcher& watcher) {
     // Attempt to initialize each target. If a target is unavailable, treat it as though it
     // completed immediately.
     for (const auto& target_handle : target_handles_) {
-      if (!target_handle->initialize(watcher_)) {
+      if (!initializeTarget(*target_handle)) {
         onTargetReady(target_handle->name());
       }
     }
@@ -72,15 +72,37 @@ void ManagerImpl::dumpUnreadyTargets(envoy::admin::v3::UnreadyTargetsDumps& unre
   }
 }
 
+void ManagerImpl::trackTargetDurations(TimeSource& time_source, TargetReadyCb cb) {
+  ASSERT(state_ == State::Uninitialized);
+  time_source_ = &time_source;
+  target_ready_cb_ = std::move(cb);
+}
+
+bool ManagerImpl::initializeTarget(const TargetHandle& target_handle) {
+  if (time_source_ != nullptr) {
+    target_start_times_.try_emplace(target_handle.name(), time_source_->monotonicTime());
+  }
+  return target_handle.initialize(watcher_);
+}
+
 void ManagerImpl::onTargetReady(absl::string_view target_name) {
   // If there are no remaining targets and one mysteriously calls us back, this manager is haunted.
   ASSERT(count_ != 0,
          fmt::format("{} called back by target after initialization complete", target_name));
 
+  if (time_source_ != nullptr) {
+    auto it = target_start_times_.find(target_name);
+    if (it != target_start_times_.end()) {
+      target_ready_cb_(target_name, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        time_source_->monotonicTime() - it->second));
+    }
+  }
+
   // Decrease target_name count by 1.
   ASSERT(target_names_count_.find(target_name) != target_names_count_.end());
   if (--target_names_count_[target_name] == 0) {
     target_names_count_.erase(target_name);
+    target_start_times_.erase(target_name);
   }
 
   // If there are no uninitialized targets remaining when called back by a target, that means it was
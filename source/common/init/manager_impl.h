@@ -37,11 +37,14 @@ public:
   void add(const Target& target) override;
   void initialize(const Watcher& watcher) override;
   void dumpUnreadyTargets(envoy::admin::v3::UnreadyTargetsDumps& dumps) override;
+  void trackTargetDurations(TimeSource& time_source, TargetReadyCb cb) override;
 
 private:
   // Callback function with an additional target_name parameter, decrease unready targets count by
   // 1, update target_names_count_ hash map.
   void onTargetReady(absl::string_view target_name);
+  // Initializes the target, noting when it started if the target durations are tracked.
+  bool initializeTarget(const TargetHandle& target_handle);
 
   void ready();
 
@@ -68,6 +71,12 @@ private:
 
   // Count of target_name of unready targets.
   absl::flat_hash_map<std::string, uint32_t> target_names_count_;
+  // Set by trackTargetDurations.
+  TimeSource* time_source_{};
+  TargetReadyCb target_ready_cb_;
+  // When the initialization of the unready targets started, by target name. The targets sharing a
+  // name are measured from the first of them.
+  absl::flat_hash_map<std::string, MonotonicTime> target_start_times_;
 };
 
 } // namespace Init
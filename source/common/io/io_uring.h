@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/pure.h"
+#include "envoy/event/dispatcher.h"
 
 #include "source/common/network/address_impl.h"
 
@@ -86,6 +87,14 @@ public:
    */
   virtual IoUringResult prepareClose(os_fd_t fd, void* user_data) PURE;
 
+  /**
+   * Prepares a cancellation of the request submitted with the given `target_user_data` and puts
+   * it into the submission queue.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareCancel(void* target_user_data, void* user_data) PURE;
+
   /**
    * Submits the entries in the submission queue to the kernel using the
    * `io_uring_enter()` system call.
@@ -97,6 +106,63 @@ public:
   virtual IoUringResult submit() PURE;
 };
 
+/**
+ * A request submitted through an IoUringWorker. The request must stay alive until its completion
+ * has been delivered.
+ */
+class IoUringRequest {
+public:
+  virtual ~IoUringRequest() = default;
+
+  /**
+   * Called on the worker's thread once the kernel has completed the request.
+   * @param result the return code of the system call; negative values are -errno.
+   */
+  virtual void onCompletion(int32_t result) PURE;
+};
+
+/**
+ * An owner of in-flight IoUringRequests that has outlived its user, for example a socket that
+ * was closed while a write was still pending. It is kept alive by the IoUringWorker until it
+ * destroys itself through IoUringWorker::destroySocket().
+ */
+class IoUringSocket : public Event::DeferredDeletable {};
+
+using IoUringSocketPtr = std::unique_ptr<IoUringSocket>;
+
+/**
+ * Drives an IoUring from the event loop of a single thread. Requests are queued on the
+ * submission queue immediately but only submitted to the kernel once per event loop iteration,
+ * so that all the I/O issued while handling one batch of events costs a single
+ * `io_uring_enter()` call. Completions are delivered from the ring's eventfd file event.
+ */
+class IoUringWorker {
+public:
+  virtual ~IoUringWorker() = default;
+
+  virtual IoUringResult submitReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
+                                    IoUringRequest& request) PURE;
+  virtual IoUringResult submitWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
+                                     IoUringRequest& request) PURE;
+  virtual IoUringResult submitClose(os_fd_t fd, IoUringRequest& request) PURE;
+  virtual IoUringResult submitCancel(IoUringRequest& target, IoUringRequest& request) PURE;
+
+  /**
+   * Transfers ownership of a socket with outstanding requests to the worker.
+   */
+  virtual void adoptSocket(IoUringSocketPtr socket) PURE;
+
+  /**
+   * Destroys a socket previously passed to adoptSocket().
+   */
+  virtual void destroySocket(IoUringSocket& socket) PURE;
+
+  /**
+   * @return the dispatcher whose event loop drives this worker.
+   */
+  virtual Event::Dispatcher& dispatcher() PURE;
+};
+
 /**
  * Abstract factory for IoUring wrappers.
  */
@@ -0,0 +1,124 @@
+#include "source/common/io/io_uring_worker_impl.h"
+
+namespace Envoy {
+namespace Io {
+
+IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
+                                     Event::Dispatcher& dispatcher)
+    : io_uring_(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling)),
+      dispatcher_(dispatcher) {
+  const os_fd_t event_fd = io_uring_->registerEventfd();
+  // The eventfd is drained on every invocation, so an edge triggered event is sufficient.
+  file_event_ = dispatcher_.createFileEvent(
+      event_fd, [this](uint32_t) { onEventfd(); }, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+  submit_cb_ = dispatcher_.createSchedulableCallback([this]() { submit(); });
+}
+
+IoUringWorkerImpl::~IoUringWorkerImpl() {
+  file_event_.reset();
+  submit_cb_.reset();
+  // Tearing down the ring cancels every outstanding request, after which the buffers owned by
+  // adopted sockets can be released.
+  io_uring_->unregisterEventfd();
+  io_uring_.reset();
+  adopted_sockets_.clear();
+}
+
+template <typename PrepareFn> IoUringResult IoUringWorkerImpl::prepare(PrepareFn prepare) {
+  IoUringResult result = prepare();
+  if (result == IoUringResult::Failed) {
+    // The submission queue is full; hand what we have to the kernel and retry once.
+    submit();
+    result = prepare();
+  }
+  if (result == IoUringResult::Ok) {
+    scheduleSubmit();
+  }
+  return result;
+}
+
+IoUringResult IoUringWorkerImpl::submitReadv(os_fd_t fd, const struct iovec* iovecs,
+                                             unsigned nr_vecs, IoUringRequest& request) {
+  return prepare([&]() { return io_uring_->prepareReadv(fd, iovecs, nr_vecs, 0, &request); });
+}
+
+IoUringResult IoUringWorkerImpl::submitWritev(os_fd_t fd, const struct iovec* iovecs,
+                                              unsigned nr_vecs, IoUringRequest& request) {
+  return prepare([&]() { return io_uring_->prepareWritev(fd, iovecs, nr_vecs, 0, &request); });
+}
+
+IoUringResult IoUringWorkerImpl::submitClose(os_fd_t fd, IoUringRequest& request) {
+  return prepare([&]() { return io_uring_->prepareClose(fd, &request); });
+}
+
+IoUringResult IoUringWorkerImpl::submitCancel(IoUringRequest& target, IoUringRequest& request) {
+  return prepare([&]() { return io_uring_->prepareCancel(&target, &request); });
+}
+
+void IoUringWorkerImpl::adoptSocket(IoUringSocketPtr socket) {
+  IoUringSocket* key = socket.get();
+  adopted_sockets_.emplace(key, std::move(socket));
+}
+
+void IoUringWorkerImpl::destroySocket(IoUringSocket& socket) {
+  auto it = adopted_sockets_.find(&socket);
+  ASSERT(it != adopted_sockets_.end());
+  // Defer the deletion as the socket is usually in the middle of a completion callback.
+  dispatcher_.deferredDelete(std::move(it->second));
+  adopted_sockets_.erase(it);
+}
+
+void IoUringWorkerImpl::scheduleSubmit() {
+  if (!submit_cb_->enabled()) {
+    submit_cb_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void IoUringWorkerImpl::submit() {
+  submit_cb_->cancel();
+  if (io_uring_->submit() == IoUringResult::Busy) {
+    // Too many requests are in flight. Completions will arrive on the eventfd, after which the
+    // remaining entries are submitted.
+    ENVOY_LOG(trace, "io_uring submission queue busy, deferring submit");
+  }
+}
+
+void IoUringWorkerImpl::onEventfd() {
+  io_uring_->forEveryCompletion([](void* user_data, int32_t result) {
+    ASSERT(user_data != nullptr);
+    static_cast<IoUringRequest*>(user_data)->onCompletion(result);
+  });
+  // Completion handlers usually queue follow-up requests, and a previous submit may have been
+  // refused while the completion queue was full.
+  scheduleSubmit();
+}
+
+IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
+                                                   bool use_submission_queue_polling,
+                                                   ThreadLocal::SlotAllocator& tls)
+    : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
+      tls_(tls) {}
+
+OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
+  if (!tls_.currentThreadRegistered()) {
+    return absl::nullopt;
+  }
+  auto worker = tls_.get();
+  if (!worker.has_value()) {
+    return absl::nullopt;
+  }
+  return *worker;
+}
+
+void IoUringWorkerFactoryImpl::onServerInitialized() {
+  tls_.set([io_uring_size = io_uring_size_,
+            use_submission_queue_polling =
+                use_submission_queue_polling_](Event::Dispatcher& dispatcher) {
+    return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
+                                               dispatcher);
+  });
+}
+
+} // namespace Io
+} // namespace Envoy
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/io/io_uring_impl.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Io {
+
+class IoUringWorkerImpl : public IoUringWorker,
+                          public ThreadLocal::ThreadLocalObject,
+                          protected Logger::Loggable<Logger::Id::io> {
+public:
+  IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
+                    Event::Dispatcher& dispatcher);
+  ~IoUringWorkerImpl() override;
+
+  // IoUringWorker
+  IoUringResult submitReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
+                            IoUringRequest& request) override;
+  IoUringResult submitWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
+                             IoUringRequest& request) override;
+  IoUringResult submitClose(os_fd_t fd, IoUringRequest& request) override;
+  IoUringResult submitCancel(IoUringRequest& target, IoUringRequest& request) override;
+  void adoptSocket(IoUringSocketPtr socket) override;
+  void destroySocket(IoUringSocket& socket) override;
+  Event::Dispatcher& dispatcher() override { return dispatcher_; }
+
+private:
+  // Queues a request with `prepare`, flushing the submission queue first if it is full.
+  template <typename PrepareFn> IoUringResult prepare(PrepareFn prepare);
+  void scheduleSubmit();
+  void submit();
+  void onEventfd();
+
+  std::unique_ptr<IoUringImpl> io_uring_;
+  Event::Dispatcher& dispatcher_;
+  Event::FileEventPtr file_event_;
+  // Runs once at the end of the current event loop iteration to submit everything that was
+  // queued while handling the iteration's events.
+  Event::SchedulableCallbackPtr submit_cb_;
+  absl::flat_hash_map<IoUringSocket*, IoUringSocketPtr> adopted_sockets_;
+};
+
+/**
+ * Creates one IoUringWorkerImpl for every thread that runs an event loop.
+ */
+class IoUringWorkerFactoryImpl {
+public:
+  IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
+                           ThreadLocal::SlotAllocator& tls);
+
+  /**
+   * @return the worker of the calling thread, if the thread local slot has been initialized and
+   *         the thread runs an event loop.
+   */
+  OptRef<IoUringWorker> getIoUringWorker();
+
+  /**
+   * Creates the workers. Must be called on the main thread once the thread local slots can be
+   * set.
+   */
+  void onServerInitialized();
+
+private:
+  const uint32_t io_uring_size_;
+  const bool use_submission_queue_polling_;
+  ThreadLocal::TypedSlot<IoUringWorkerImpl> tls_;
+};
+
+} // namespace Io
+} // namespace Envoy
@@ -557,6 +557,204 @@ void Field::iterate(const ObjectCallback& callback) const {
 
 void Field::validateSchema(const std::string&) const { throw Exception("not implemented"); }
 
+/**
+ * Object backed by a nlohmann::json document. Unlike Field, the document is parsed without
+ * building an Object for each value, and the Objects of the nested values are only built when they
+ * are accessed. They share the ownership of the document. Line numbers aren't tracked.
+ */
+class LazyField : public Object {
+public:
+  using DocumentSharedPtr = std::shared_ptr<const nlohmann::json>;
+
+  LazyField(DocumentSharedPtr document, const nlohmann::json& value)
+      : document_(std::move(document)), value_(value) {}
+
+  static ObjectSharedPtr createObject() {
+    auto document = std::make_shared<const nlohmann::json>(nlohmann::json::object());
+    return std::make_shared<LazyField>(document, *document);
+  }
+
+  bool isArray() const override { return value_.is_array(); }
+  bool isObject() const override { return value_.is_object(); }
+
+  uint64_t hash() const override { return HashUtil::xxHash64(asJsonString()); }
+
+  bool getBoolean(const std::string& name) const override;
+  bool getBoolean(const std::string& name, bool default_value) const override;
+  double getDouble(const std::string& name) const override;
+  double getDouble(const std::string& name, double default_value) const override;
+  int64_t getInteger(const std::string& name) const override;
+  int64_t getInteger(const std::string& name, int64_t default_value) const override;
+  ObjectSharedPtr getObject(const std::string& name, bool allow_empty) const override;
+  std::vector<ObjectSharedPtr> getObjectArray(const std::string& name,
+                                              bool allow_empty) const override;
+  std::string getString(const std::string& name) const override;
+  std::string getString(const std::string& name, const std::string& default_value) const override;
+  std::vector<std::string> getStringArray(const std::string& name, bool allow_empty) const override;
+  std::vector<ObjectSharedPtr> asObjectArray() const override;
+  std::string asString() const override;
+  std::string asJsonString() const override { return value_.dump(); }
+
+  bool empty() const override;
+  bool hasObject(const std::string& name) const override { return find(name) != nullptr; }
+  void iterate(const ObjectCallback& callback) const override;
+  void validateSchema(const std::string&) const override { throw Exception("not implemented"); }
+
+private:
+  void checkType(nlohmann::json::value_t type, const char* type_name) const {
+    if (value_.type() != type) {
+      throw Exception(
+          fmt::format("JSON field accessed with type '{}' does not match actual type '{}'.",
+                      type_name, value_.type_name()));
+    }
+  }
+  // Returns the value of the name key, or nullptr if there is none.
+  const nlohmann::json* find(const std::string& name) const {
+    checkType(nlohmann::json::value_t::object, "Object");
+    auto value_itr = value_.find(name);
+    return value_itr == value_.end() ? nullptr : &*value_itr;
+  }
+  ObjectSharedPtr child(const nlohmann::json& value) const {
+    return std::make_shared<LazyField>(document_, value);
+  }
+  static int64_t integerValue(const std::string& name, const nlohmann::json& value) {
+    if (value.is_number_unsigned() &&
+        value.get<uint64_t>() > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+      throw Exception(fmt::format("key '{}' is larger than int64_t (not supported)", name));
+    }
+    return value.get<int64_t>();
+  }
+
+  const DocumentSharedPtr document_;
+  const nlohmann::json& value_;
+};
+
+bool LazyField::getBoolean(const std::string& name) const {
+  const nlohmann::json* value = find(name);
+  if (value == nullptr || !value->is_boolean()) {
+    throw Exception(fmt::format("key '{}' missing or not a boolean", name));
+  }
+  return value->get<bool>();
+}
+
+bool LazyField::getBoolean(const std::string& name, bool default_value) const {
+  return hasObject(name) ? getBoolean(name) : default_value;
+}
+
+double LazyField::getDouble(const std::string& name) const {
+  const nlohmann::json* value = find(name);
+  if (value == nullptr || !value->is_number_float()) {
+    throw Exception(fmt::format("key '{}' missing or not a double", name));
+  }
+  return value->get<double>();
+}
+
+double LazyField::getDouble(const std::string& name, double default_value) const {
+  return hasObject(name) ? getDouble(name) : default_value;
+}
+
+int64_t LazyField::getInteger(const std::string& name) const {
+  const nlohmann::json* value = find(name);
+  if (value == nullptr || !value->is_number_integer()) {
+    throw Exception(fmt::format("key '{}' missing or not an integer", name));
+  }
+  return integerValue(name, *value);
+}
+
+int64_t LazyField::getInteger(const std::string& name, int64_t default_value) const {
+  return hasObject(name) ? getInteger(name) : default_value;
+}
+
+ObjectSharedPtr LazyField::getObject(const std::string& name, bool allow_empty) const {
+  const nlohmann::json* value = find(name);
+  if (value == nullptr) {
+    if (allow_empty) {
+      return createObject();
+    }
+    throw Exception(fmt::format("key '{}' missing", name));
+  } else if (!value->is_object()) {
+    throw Exception(fmt::format("key '{}' not an object", name));
+  }
+  return child(*value);
+}
+
+std::vector<ObjectSharedPtr> LazyField::getObjectArray(const std::string& name,
+                                                       bool allow_empty) const {
+  const nlohmann::json* value = find(name);
+  if (value == nullptr || !value->is_array()) {
+    if (allow_empty && value == nullptr) {
+      return {};
+    }
+    throw Exception(fmt::format("key '{}' missing or not an array", name));
+  }
+  return child(*value)->asObjectArray();
+}
+
+std::string LazyField::getString(const std::string& name) const {
+  const nlohmann::json* value = find(name);
+  if (value == nullptr || !value->is_string()) {
+    throw Exception(fmt::format("key '{}' missing or not a string", name));
+  }
+  return value->get_ref<const std::string&>();
+}
+
+std::string LazyField::getString(const std::string& name, const std::string& default_value) const {
+  return hasObject(name) ? getString(name) : default_value;
+}
+
+std::vector<std::string> LazyField::getStringArray(const std::string& name,
+                                                   bool allow_empty) const {
+  std::vector<std::string> string_array;
+  const nlohmann::json* value = find(name);
+  if (value == nullptr || !value->is_array()) {
+    if (allow_empty && value == nullptr) {
+      return string_array;
+    }
+    throw Exception(fmt::format("key '{}' missing or not an array", name));
+  }
+
+  string_array.reserve(value->size());
+  for (const nlohmann::json& element : *value) {
+    if (!element.is_string()) {
+      throw Exception(fmt::format("JSON array '{}' does not contain all strings", name));
+    }
+    string_array.push_back(element.get_ref<const std::string&>());
+  }
+  return string_array;
+}
+
+std::vector<ObjectSharedPtr> LazyField::asObjectArray() const {
+  checkType(nlohmann::json::value_t::array, "Array");
+  std::vector<ObjectSharedPtr> array;
+  array.reserve(value_.size());
+  for (const nlohmann::json& element : value_) {
+    array.push_back(child(element));
+  }
+  return array;
+}
+
+std::string LazyField::asString() const {
+  checkType(nlohmann::json::value_t::string, "String");
+  return value_.get_ref<const std::string&>();
+}
+
+bool LazyField::empty() const {
+  if (!value_.is_object() && !value_.is_array()) {
+    throw Exception(
+        fmt::format("Json does not support empty() on types other than array and object"));
+  }
+  return value_.empty();
+}
+
+void LazyField::iterate(const ObjectCallback& callback) const {
+  checkType(nlohmann::json::value_t::object, "Object");
+  for (const auto& item : value_.items()) {
+    if (!callback(item.key(), LazyField(document_, item.value()))) {
+      break;
+    }
+  }
+}
+
 bool ObjectHandler::start_object(std::size_t) {
   FieldSharedPtr object = Field::createObject();
   object->setLineNumberStart(line_number_);
@@ -686,6 +884,16 @@ ObjectSharedPtr Factory::loadFromString(const std::string& json) {
   return handler.getRoot();
 }
 
+ObjectSharedPtr Factory::loadFromStringLazy(const std::string& json) {
+  auto document = std::make_shared<nlohmann::json>();
+  try {
+    *document = nlohmann::json::parse(json);
+  } catch (const nlohmann::json::parse_error& e) {
+    throw Exception(fmt::format("JSON supplied is not valid. Error({})\n", e.what()));
+  }
+  return std::make_shared<LazyField>(document, *document);
+}
+
 std::string Factory::serialize(absl::string_view str) {
   nlohmann::json j(str);
   return j.dump();
@@ -18,6 +18,12 @@ public:
    */
   static ObjectSharedPtr loadFromString(const std::string& json);
 
+  /**
+   * Constructs a Json Object from a string, without building the Objects of the nested values
+   * until they are accessed. The errors thrown by the Objects don't have line numbers.
+   */
+  static ObjectSharedPtr loadFromStringLazy(const std::string& json);
+
   /**
    * Serializes a string in JSON format, throwing an exception if not valid UTF-8.
    *
@@ -7,6 +7,9 @@ namespace Envoy {
 namespace Json {
 
 ObjectSharedPtr Factory::loadFromString(const std::string& json) {
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.lazy_json_loader")) {
+    return Nlohmann::Factory::loadFromStringLazy(json);
+  }
   return Nlohmann::Factory::loadFromString(json);
 }
 
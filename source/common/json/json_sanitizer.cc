@@ -1,6 +1,8 @@
 #include "source/common/json/json_sanitizer.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/simd.h"
 #include "source/common/common/thread.h"
 #include "source/common/json/json_internal.h"
 
@@ -47,22 +49,121 @@ static constexpr uint32_t needs_slow_sanitizer[256] = {
 // SPELLCHECKER(on)
 // clang-format on
 
-absl::string_view sanitize(std::string& buffer, absl::string_view str) {
-  // Fast-path to see whether any escapes or utf-encoding are needed. If str has
-  // only unescaped ascii characters, we can simply return it.
-  //
+namespace {
+
+bool needsSlowSanitizerFrom(absl::string_view str, size_t offset) {
   // Benchmarks show it's faster to just rip through the string with no
   // conditionals, so we only check the arithmetically ORed condition after the
   // loop. This avoids branches and allows simpler loop unrolling by the
   // compiler.
   static_assert(ARRAY_SIZE(needs_slow_sanitizer) == 256);
   uint32_t need_slow = 0;
-  for (char c : str) {
+  for (char c : str.substr(offset)) {
     // We need to escape control characters, characters >= 127, and double-quote
     // and backslash.
     need_slow |= needs_slow_sanitizer[static_cast<uint8_t>(c)];
   }
-  if (need_slow == 0) {
+  return need_slow != 0;
+}
+
+#if defined(ENVOY_SIMD_X86)
+
+// As signed bytes, the characters >= 128 are negative, so a single comparison finds them along
+// with the control characters.
+bool needsSlowSanitizerSse2(absl::string_view str) {
+  const auto* data = reinterpret_cast<const uint8_t*>(str.data());
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i del = _mm_set1_epi8(0x7f);
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  size_t offset = 0;
+  for (; offset + sizeof(__m128i) <= str.size(); offset += sizeof(__m128i)) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    const __m128i need_slow =
+        _mm_or_si128(_mm_or_si128(_mm_cmplt_epi8(chars, space), _mm_cmpeq_epi8(chars, del)),
+                     _mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)));
+    if (_mm_movemask_epi8(need_slow) != 0) {
+      return true;
+    }
+  }
+  return needsSlowSanitizerFrom(str, offset);
+}
+
+__attribute__((target("avx2"))) bool needsSlowSanitizerAvx2(absl::string_view str) {
+  const auto* data = reinterpret_cast<const uint8_t*>(str.data());
+  // There is no signed less than comparison; c < ' ' is equivalent to ' ' > c.
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i del = _mm256_set1_epi8(0x7f);
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  size_t offset = 0;
+  for (; offset + sizeof(__m256i) <= str.size(); offset += sizeof(__m256i)) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+    const __m256i need_slow = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpgt_epi8(space, chars), _mm256_cmpeq_epi8(chars, del)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chars, quote), _mm256_cmpeq_epi8(chars, backslash)));
+    if (_mm256_movemask_epi8(need_slow) != 0) {
+      return true;
+    }
+  }
+  _mm256_zeroupper();
+  return needsSlowSanitizerSse2(str.substr(offset));
+}
+
+#elif defined(ENVOY_SIMD_NEON)
+
+bool needsSlowSanitizerNeon(absl::string_view str) {
+  const auto* data = reinterpret_cast<const uint8_t*>(str.data());
+  const uint8x16_t space = vdupq_n_u8(' ');
+  const uint8x16_t del = vdupq_n_u8(0x7f);
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  size_t offset = 0;
+  for (; offset + sizeof(uint8x16_t) <= str.size(); offset += sizeof(uint8x16_t)) {
+    const uint8x16_t chars = vld1q_u8(data + offset);
+    const uint8x16_t need_slow =
+        vorrq_u8(vorrq_u8(vcltq_u8(chars, space), vcgeq_u8(chars, del)),
+                 vorrq_u8(vceqq_u8(chars, quote), vceqq_u8(chars, backslash)));
+    if (vmaxvq_u8(need_slow) != 0) {
+      return true;
+    }
+  }
+  return needsSlowSanitizerFrom(str, offset);
+}
+
+#endif
+
+struct NeedsSlowSanitizerImpl {
+  bool (*needs_slow_sanitizer_)(absl::string_view);
+  Simd::InstructionSet instruction_set_;
+};
+
+const NeedsSlowSanitizerImpl& needsSlowSanitizerImpl() {
+  CONSTRUCT_ON_FIRST_USE(NeedsSlowSanitizerImpl, []() -> NeedsSlowSanitizerImpl {
+    return Simd::select<NeedsSlowSanitizerImpl>({
+#if defined(ENVOY_SIMD_X86)
+        {needsSlowSanitizerAvx2, Simd::InstructionSet::Avx2},
+        {needsSlowSanitizerSse2, Simd::InstructionSet::Sse2},
+#elif defined(ENVOY_SIMD_NEON)
+        {needsSlowSanitizerNeon, Simd::InstructionSet::Neon},
+#endif
+        {needsSlowSanitizerScalar, Simd::InstructionSet::Scalar},
+    });
+  }());
+}
+
+} // namespace
+
+bool needsSlowSanitizer(absl::string_view str) {
+  return needsSlowSanitizerImpl().needs_slow_sanitizer_(str);
+}
+
+bool needsSlowSanitizerScalar(absl::string_view str) { return needsSlowSanitizerFrom(str, 0); }
+
+absl::string_view sanitize(std::string& buffer, absl::string_view str) {
+  // Fast-path to see whether any escapes or utf-encoding are needed. If str has
+  // only unescaped ascii characters, we can simply return it.
+  if (!needsSlowSanitizer(str)) {
     return str; // Fast path, should be executed most of the time.
   }
   TRY_ASSERT_MAIN_THREAD {
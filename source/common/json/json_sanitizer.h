@@ -37,6 +37,20 @@ namespace Json {
  */
 absl::string_view sanitize(std::string& buffer, absl::string_view str);
 
+/**
+ * @return whether str has characters requiring an escape or utf-8 validation,
+ *   in which case sanitize() can't return str unchanged. The scan is
+ *   vectorized with SSE2, AVX2 or NEON depending on the CPU Envoy runs on,
+ *   checking 16 or 32 bytes at a time.
+ */
+bool needsSlowSanitizer(absl::string_view str);
+
+/**
+ * Byte-at-a-time implementation of needsSlowSanitizer(). Exposed for tests and
+ * benchmarks.
+ */
+bool needsSlowSanitizerScalar(absl::string_view str);
+
 /**
  * Strips double-quotes on first and last characters of str. It's a
  * precondition to call this on a string that is surrounded by double-quotes.
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "envoy/matcher/matcher.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/matcher/field_matcher.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Matcher {
+
+/**
+ * An instruction of the flattened field predicates of a CompiledListMatcher. The predicates are
+ * stored in prefix order: the instructions of the operands of an All, Any or Not predicate follow
+ * it, and end_ points past them, so that a predicate can be skipped without being evaluated.
+ */
+struct FieldPredicateInstruction {
+  enum class Op { Single, All, Any, Not };
+
+  Op op_;
+  // The index of the data input and of the input matcher of a Single predicate.
+  uint32_t input_{};
+  uint32_t input_matcher_{};
+  // The index of the instruction that follows the predicate and its operands.
+  uint32_t end_{};
+};
+
+using FieldPredicateProgram = std::vector<FieldPredicateInstruction>;
+using FieldPredicateProgramConstSharedPtr = std::shared_ptr<const FieldPredicateProgram>;
+
+/**
+ * A match tree that iterates over a list of compiled field predicates to find the first one that
+ * matches, like ListMatcher does. The predicates share a deduplicated set of data inputs, and each
+ * data input is only read once per match, however many predicates use it.
+ */
+template <class DataType>
+class CompiledListMatcher : public MatchTree<DataType>, Logger::Loggable<Logger::Id::matcher> {
+public:
+  CompiledListMatcher(std::vector<DataInputPtr<DataType>>&& data_inputs,
+                      std::vector<InputMatcherPtr>&& input_matchers,
+                      FieldPredicateProgramConstSharedPtr program,
+                      absl::optional<OnMatch<DataType>> on_no_match)
+      : data_inputs_(std::move(data_inputs)), input_matchers_(std::move(input_matchers)),
+        program_(std::move(program)), on_no_match_(std::move(on_no_match)) {}
+
+  typename MatchTree<DataType>::MatchResult match(const DataType& matching_data) override {
+    InputCache inputs(data_inputs_.size());
+    for (const auto& matcher : matchers_) {
+      const auto maybe_match = evaluate(matcher.first, matching_data, inputs);
+
+      // One of the matchers don't have enough information, bail on evaluating the match.
+      if (maybe_match.match_state_ == MatchState::UnableToMatch) {
+        return {MatchState::UnableToMatch, {}};
+      }
+
+      if (maybe_match.result()) {
+        return {MatchState::MatchComplete, matcher.second};
+      }
+    }
+
+    return {MatchState::MatchComplete, on_no_match_};
+  }
+
+  /**
+   * Adds a matcher evaluating the predicate whose first instruction is at predicate.
+   */
+  void addMatcher(uint32_t predicate, OnMatch<DataType> action) {
+    ASSERT(predicate < program_->size());
+    matchers_.push_back({predicate, std::move(action)});
+  }
+
+private:
+  using InputCache = absl::InlinedVector<absl::optional<DataInputGetResult>, 8>;
+
+  const DataInputGetResult& input(uint32_t index, const DataType& data, InputCache& inputs) {
+    if (!inputs[index].has_value()) {
+      inputs[index] = data_inputs_[index]->get(data);
+    }
+    return *inputs[index];
+  }
+
+  // Evaluates the predicate at pc with the semantics of the FieldMatcher of its kind.
+  FieldMatchResult evaluate(uint32_t pc, const DataType& data, InputCache& inputs) {
+    const FieldPredicateInstruction& instruction = (*program_)[pc];
+    switch (instruction.op_) {
+    case FieldPredicateInstruction::Op::Single: {
+      const DataInputGetResult& data_input = input(instruction.input_, data, inputs);
+      ENVOY_LOG(trace, "Attempting to match {}", data_input);
+      if (data_input.data_availability_ == DataInputGetResult::DataAvailability::NotAvailable) {
+        return {MatchState::UnableToMatch, absl::nullopt};
+      }
+
+      const bool current_match =
+          input_matchers_[instruction.input_matcher_]->match(data_input.data_);
+      if (!current_match && data_input.data_availability_ ==
+                                DataInputGetResult::DataAvailability::MoreDataMightBeAvailable) {
+        ENVOY_LOG(trace, "No match yet; delaying result as more data might be available.");
+        return {MatchState::UnableToMatch, absl::nullopt};
+      }
+
+      ENVOY_LOG(trace, "Match result: {}", current_match);
+      return {MatchState::MatchComplete, current_match};
+    }
+    case FieldPredicateInstruction::Op::All:
+      for (uint32_t operand = pc + 1; operand < instruction.end_;
+           operand = (*program_)[operand].end_) {
+        const auto result = evaluate(operand, data, inputs);
+        if (result.match_state_ == MatchState::UnableToMatch || !result.result()) {
+          return result;
+        }
+      }
+      return {MatchState::MatchComplete, true};
+    case FieldPredicateInstruction::Op::Any: {
+      bool unable_to_match_some_matchers = false;
+      for (uint32_t operand = pc + 1; operand < instruction.end_;
+           operand = (*program_)[operand].end_) {
+        const auto result = evaluate(operand, data, inputs);
+        if (result.match_state_ == MatchState::UnableToMatch) {
+          unable_to_match_some_matchers = true;
+          continue;
+        }
+        if (result.result()) {
+          return {MatchState::MatchComplete, true};
+        }
+      }
+      if (unable_to_match_some_matchers) {
+        return {MatchState::UnableToMatch, absl::nullopt};
+      }
+      return {MatchState::MatchComplete, false};
+    }
+    case FieldPredicateInstruction::Op::Not: {
+      const auto result = evaluate(pc + 1, data, inputs);
+      if (result.match_state_ == MatchState::UnableToMatch) {
+        return result;
+      }
+      return {MatchState::MatchComplete, !result.result()};
+    }
+    }
+    PANIC_DUE_TO_CORRUPT_ENUM;
+  }
+
+  const std::vector<DataInputPtr<DataType>> data_inputs_;
+  const std::vector<InputMatcherPtr> input_matchers_;
+  const FieldPredicateProgramConstSharedPtr program_;
+  const absl::optional<OnMatch<DataType>> on_no_match_;
+  std::vector<std::pair<uint32_t, OnMatch<DataType>>> matchers_;
+};
+
+} // namespace Matcher
+} // namespace Envoy
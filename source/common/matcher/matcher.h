@@ -11,6 +11,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/config/utility.h"
+#include "source/common/matcher/compiled_list_matcher.h"
 #include "source/common/matcher/exact_map_matcher.h"
 #include "source/common/matcher/field_matcher.h"
 #include "source/common/matcher/list_matcher.h"
@@ -18,6 +19,8 @@
 #include "source/common/matcher/validation_visitor.h"
 #include "source/common/matcher/value_input_matcher.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
@@ -62,8 +65,6 @@ static inline MaybeMatchResult evaluateMatch(MatchTree<DataType>& match_tree,
   return MaybeMatchResult{result.on_match_->action_cb_, MatchState::MatchComplete};
 }
 
-template <class DataType> using FieldMatcherFactoryCb = std::function<FieldMatcherPtr<DataType>()>;
-
 /**
  * A matcher that will always resolve to associated on_no_match. This is used when
  * the matcher is configured without a matcher, allowing for a tree that always resolves
@@ -189,74 +190,107 @@ private:
           on_no_match ? absl::make_optional((*on_no_match)()) : absl::nullopt);
     };
   }
+  // The field predicates of a matcher list, flattened into a single program. The predicates
+  // reading the same input share its data input.
+  struct CompiledFieldPredicates {
+    std::vector<DataInputFactoryCb<DataType>> data_inputs_;
+    absl::flat_hash_map<std::string, uint32_t> data_input_indices_;
+    std::vector<InputMatcherFactoryCb> input_matchers_;
+    FieldPredicateProgram program_;
+  };
+
   template <class MatcherType>
   MatchTreeFactoryCb<DataType> createListMatcher(const MatcherType& config) {
-    std::vector<std::pair<FieldMatcherFactoryCb<DataType>, OnMatchFactoryCb<DataType>>>
-        matcher_factories;
+    CompiledFieldPredicates compiled;
+    std::vector<std::pair<uint32_t, OnMatchFactoryCb<DataType>>> matcher_factories;
     matcher_factories.reserve(config.matcher_list().matchers().size());
     for (const auto& matcher : config.matcher_list().matchers()) {
-      matcher_factories.push_back(std::make_pair(
-          createFieldMatcher<typename MatcherType::MatcherList::Predicate>(matcher.predicate()),
-          *createOnMatch(matcher.on_match())));
+      const uint32_t predicate = compiled.program_.size();
+      compileFieldPredicate<typename MatcherType::MatcherList::Predicate>(matcher.predicate(),
+                                                                          compiled);
+      matcher_factories.push_back(std::make_pair(predicate, *createOnMatch(matcher.on_match())));
     }
 
     auto on_no_match = createOnMatch(config.on_no_match());
 
-    return [matcher_factories, on_no_match]() {
-      auto list_matcher = std::make_unique<ListMatcher<DataType>>(
+    return [data_input_factories = std::move(compiled.data_inputs_),
+            input_matcher_factories = std::move(compiled.input_matchers_),
+            program = std::make_shared<const FieldPredicateProgram>(std::move(compiled.program_)),
+            matcher_factories, on_no_match]() {
+      std::vector<DataInputPtr<DataType>> data_inputs;
+      data_inputs.reserve(data_input_factories.size());
+      for (const auto& factory_cb : data_input_factories) {
+        data_inputs.emplace_back(factory_cb());
+      }
+      std::vector<InputMatcherPtr> input_matchers;
+      input_matchers.reserve(input_matcher_factories.size());
+      for (const auto& factory_cb : input_matcher_factories) {
+        input_matchers.emplace_back(factory_cb());
+      }
+
+      auto list_matcher = std::make_unique<CompiledListMatcher<DataType>>(
+          std::move(data_inputs), std::move(input_matchers), program,
           on_no_match ? absl::make_optional((*on_no_match)()) : absl::nullopt);
 
       for (const auto& matcher : matcher_factories) {
-        list_matcher->addMatcher(matcher.first(), matcher.second());
+        list_matcher->addMatcher(matcher.first, matcher.second());
       }
 
       return list_matcher;
     };
   }
 
-  template <class MatcherT, class PredicateType, class FieldPredicateType>
-  FieldMatcherFactoryCb<DataType> createAggregateFieldMatcherFactoryCb(
-      const Protobuf::RepeatedPtrField<FieldPredicateType>& predicates) {
-    std::vector<FieldMatcherFactoryCb<DataType>> sub_matchers;
+  template <class PredicateType, class FieldPredicateType>
+  void compileAggregateFieldPredicate(
+      FieldPredicateInstruction::Op op,
+      const Protobuf::RepeatedPtrField<FieldPredicateType>& predicates,
+      CompiledFieldPredicates& compiled) {
+    const uint32_t pc = compiled.program_.size();
+    compiled.program_.push_back({op});
     for (const auto& predicate : predicates) {
-      sub_matchers.emplace_back(createFieldMatcher<PredicateType>(predicate));
+      compileFieldPredicate<PredicateType>(predicate, compiled);
     }
-
-    return [sub_matchers]() {
-      std::vector<FieldMatcherPtr<DataType>> matchers;
-      matchers.reserve(sub_matchers.size());
-      for (const auto& factory_cb : sub_matchers) {
-        matchers.emplace_back(factory_cb());
-      }
-
-      return std::make_unique<MatcherT>(std::move(matchers));
-    };
+    compiled.program_[pc].end_ = compiled.program_.size();
   }
 
   template <class PredicateType, class FieldMatcherType>
-  FieldMatcherFactoryCb<DataType> createFieldMatcher(const FieldMatcherType& field_predicate) {
+  void compileFieldPredicate(const FieldMatcherType& field_predicate,
+                             CompiledFieldPredicates& compiled) {
     switch (field_predicate.match_type_case()) {
     case (PredicateType::kSinglePredicate): {
-      auto data_input =
-          match_input_factory_.createDataInput(field_predicate.single_predicate().input());
-      auto input_matcher = createInputMatcher(field_predicate.single_predicate());
+      const auto& single_predicate = field_predicate.single_predicate();
+      // Every input is created, and so validated, but the first one of each configuration is the
+      // only one instantiated.
+      auto data_input = match_input_factory_.createDataInput(single_predicate.input());
+      const auto& input_config = single_predicate.input().typed_config();
+      const auto [input, inserted] = compiled.data_input_indices_.try_emplace(
+          absl::StrCat(input_config.type_url(), "\n", input_config.value()),
+          compiled.data_inputs_.size());
+      if (inserted) {
+        compiled.data_inputs_.push_back(std::move(data_input));
+      }
+      compiled.input_matchers_.push_back(createInputMatcher(single_predicate));
 
-      return [data_input, input_matcher]() {
-        return std::make_unique<SingleFieldMatcher<DataType>>(data_input(), input_matcher());
-      };
+      const uint32_t pc = compiled.program_.size();
+      compiled.program_.push_back({FieldPredicateInstruction::Op::Single, input->second,
+                                   static_cast<uint32_t>(compiled.input_matchers_.size() - 1),
+                                   pc + 1});
+      return;
     }
     case (PredicateType::kOrMatcher):
-      return createAggregateFieldMatcherFactoryCb<AnyFieldMatcher<DataType>, PredicateType>(
-          field_predicate.or_matcher().predicate());
+      compileAggregateFieldPredicate<PredicateType>(
+          FieldPredicateInstruction::Op::Any, field_predicate.or_matcher().predicate(), compiled);
+      return;
     case (PredicateType::kAndMatcher):
-      return createAggregateFieldMatcherFactoryCb<AllFieldMatcher<DataType>, PredicateType>(
-          field_predicate.and_matcher().predicate());
+      compileAggregateFieldPredicate<PredicateType>(
+          FieldPredicateInstruction::Op::All, field_predicate.and_matcher().predicate(), compiled);
+      return;
     case (PredicateType::kNotMatcher): {
-      auto matcher_factory = createFieldMatcher<PredicateType>(field_predicate.not_matcher());
-
-      return [matcher_factory]() {
-        return std::make_unique<NotFieldMatcher<DataType>>(matcher_factory());
-      };
+      const uint32_t pc = compiled.program_.size();
+      compiled.program_.push_back({FieldPredicateInstruction::Op::Not});
+      compileFieldPredicate<PredicateType>(field_predicate.not_matcher(), compiled);
+      compiled.program_[pc].end_ = compiled.program_.size();
+      return;
     }
     case PredicateType::MATCH_TYPE_NOT_SET:
       PANIC_DUE_TO_PROTO_UNSET;
@@ -0,0 +1,51 @@
+#include "source/common/memory/allocation_counter.h"
+
+#include <algorithm>
+
+#if defined(TCMALLOC)
+#include "tcmalloc/malloc_extension.h"
+#endif
+
+namespace Envoy {
+namespace Memory {
+
+#if defined(TCMALLOC)
+
+bool AllocationCounter::supported() { return true; }
+
+absl::optional<AllocationCounter::Allocations>
+AllocationCounter::count(const std::function<void()>& fn) {
+  const int64_t sampling_rate = tcmalloc::MallocExtension::GetProfileSamplingRate();
+  tcmalloc::MallocExtension::SetProfileSamplingRate(1);
+  // Each thread only picks up the new rate when it takes its next sample, which the previous rate
+  // may have scheduled megabytes of allocations away. An allocation well past that distance makes
+  // the current thread sample every allocation from now on.
+  ::operator delete(::operator new(16 * static_cast<size_t>(std::max<int64_t>(sampling_rate, 1))));
+
+  tcmalloc::MallocExtension::AllocationProfilingToken token =
+      tcmalloc::MallocExtension::StartAllocationProfiling();
+  fn();
+  const tcmalloc::Profile profile = std::move(token).Stop();
+  tcmalloc::MallocExtension::SetProfileSamplingRate(sampling_rate);
+
+  Allocations allocations;
+  profile.Iterate([&allocations](const tcmalloc::Profile::Sample& sample) {
+    allocations.count_ += sample.count;
+    allocations.bytes_ += sample.sum;
+  });
+  return allocations;
+}
+
+#else
+
+bool AllocationCounter::supported() { return false; }
+
+absl::optional<AllocationCounter::Allocations>
+AllocationCounter::count(const std::function<void()>&) {
+  return absl::nullopt;
+}
+
+#endif
+
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Memory {
+
+/**
+ * Counts the heap allocations made by a piece of code, by sampling every allocation with the
+ * allocation profiler of tcmalloc while it runs. Sampling all allocations is slow, so this is only
+ * meant for tests and benchmarks. The allocations of all threads are counted.
+ */
+class AllocationCounter {
+public:
+  struct Allocations {
+    uint64_t count_{0};
+    uint64_t bytes_{0};
+  };
+
+  /**
+   * @return whether the current build can count the allocations.
+   */
+  static bool supported();
+
+  /**
+   * Runs `fn` and counts the allocations it makes.
+   * @return the number and the requested bytes of the allocations, or absl::nullopt if the
+   *         current build can't count them.
+   */
+  static absl::optional<Allocations> count(const std::function<void()>& fn);
+};
+
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,81 @@
+#include "source/common/memory/heap_breakdown.h"
+
+#include "source/common/common/macros.h"
+
+#include "absl/strings/match.h"
+
+#if defined(TCMALLOC)
+
+#include "absl/container/node_hash_map.h"
+#include "absl/debugging/symbolize.h"
+#include "tcmalloc/malloc_extension.h"
+
+#endif
+
+namespace Envoy {
+namespace Memory {
+
+const std::vector<HeapBreakdown::Rule>& HeapBreakdown::defaultRules() {
+  CONSTRUCT_ON_FIRST_USE(std::vector<Rule>, {{"buffers", "Envoy::Buffer::"},
+                                             {"stats", "Envoy::Stats::"},
+                                             {"clusters", "Envoy::Upstream::"},
+                                             {"routes", "Envoy::Router::"},
+                                             {"connections", "Envoy::Network::"},
+                                             {"connections", "Envoy::Http::"}});
+}
+
+absl::string_view HeapBreakdown::classify(absl::Span<const absl::string_view> symbols,
+                                          const std::vector<Rule>& rules) {
+  for (absl::string_view symbol : symbols) {
+    for (const Rule& rule : rules) {
+      if (absl::StartsWith(symbol, rule.symbol_prefix_)) {
+        return rule.subsystem_;
+      }
+    }
+  }
+  return OtherSubsystem;
+}
+
+#if defined(TCMALLOC)
+
+bool HeapBreakdown::supported() { return true; }
+
+absl::flat_hash_map<std::string, uint64_t>
+HeapBreakdown::sampledBytesBySubsystem(const std::vector<Rule>& rules) {
+  // The samples share most of their frames, so each frame is only symbolized once. The stacks
+  // refer to the symbols, which must not move.
+  absl::node_hash_map<void*, std::string> symbols;
+  absl::flat_hash_map<std::string, uint64_t> bytes;
+  const tcmalloc::Profile profile =
+      tcmalloc::MallocExtension::SnapshotCurrent(tcmalloc::ProfileType::kHeap);
+  profile.Iterate([&](const tcmalloc::Profile::Sample& sample) {
+    std::vector<absl::string_view> stack;
+    stack.reserve(sample.depth);
+    for (int i = 0; i < sample.depth; i++) {
+      auto [it, inserted] = symbols.try_emplace(sample.stack[i]);
+      if (inserted) {
+        char symbol[1024];
+        if (absl::Symbolize(sample.stack[i], symbol, sizeof(symbol))) {
+          it->second = symbol;
+        }
+      }
+      stack.push_back(it->second);
+    }
+    bytes[classify(stack, rules)] += sample.sum;
+  });
+  return bytes;
+}
+
+#else
+
+bool HeapBreakdown::supported() { return false; }
+
+absl::flat_hash_map<std::string, uint64_t>
+HeapBreakdown::sampledBytesBySubsystem(const std::vector<Rule>&) {
+  return {};
+}
+
+#endif
+
+} // namespace Memory
+} // namespace Envoy
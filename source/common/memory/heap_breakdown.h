@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Memory {
+
+/**
+ * Attributes the live allocations sampled by the heap profiler to the subsystems of Envoy, by
+ * matching the symbols of their stacks against classification rules. The innermost frame matching
+ * a rule decides, so e.g. the buffers allocated by the connections are attributed to the buffers.
+ */
+class HeapBreakdown {
+public:
+  /**
+   * A classification rule: the frames whose symbol starts with symbol_prefix_ belong to
+   * subsystem_.
+   */
+  struct Rule {
+    std::string subsystem_;
+    std::string symbol_prefix_;
+  };
+
+  // The subsystem of the allocations whose stack matches no rule.
+  static constexpr absl::string_view OtherSubsystem = "other";
+
+  /**
+   * @return the rules attributing allocations to the stats, clusters, routes, connections and
+   *         buffers.
+   */
+  static const std::vector<Rule>& defaultRules();
+
+  /**
+   * @return whether the current build samples the heap allocations.
+   */
+  static bool supported();
+
+  /**
+   * @return the estimated live bytes of each subsystem, from the allocations currently sampled by
+   *         the heap profiler. This symbolizes the stacks of the samples, so it is only meant for
+   *         the admin handler.
+   */
+  static absl::flat_hash_map<std::string, uint64_t>
+  sampledBytesBySubsystem(const std::vector<Rule>& rules);
+
+  /**
+   * @return the subsystem of the stack of an allocation, given the symbols of its frames from the
+   *         innermost.
+   */
+  static absl::string_view classify(absl::Span<const absl::string_view> symbols,
+                                    const std::vector<Rule>& rules);
+};
+
+} // namespace Memory
+} // namespace Envoy
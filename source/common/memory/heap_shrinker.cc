@@ -1,26 +1,57 @@
 #include "source/common/memory/heap_shrinker.h"
 
+#include "source/common/buffer/slice_pool.h"
+#include "source/common/common/free_list.h"
+#include "source/common/memory/stats.h"
 #include "source/common/memory/utils.h"
 #include "source/common/stats/symbol_table.h"
 
 #include "absl/strings/str_cat.h"
 
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
 namespace Envoy {
 namespace Memory {
 
 // TODO(eziskind): make this configurable
 constexpr std::chrono::milliseconds kTimerInterval = std::chrono::milliseconds(10000);
 
+namespace {
+
+// The number of page faults of the process that didn't need any I/O, which are the ones taken
+// when touching the pages released to the system again.
+uint64_t minorPageFaults() {
+#ifndef WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return usage.ru_minflt;
+  }
+#endif
+  return 0;
+}
+
+Envoy::Stats::Counter& actionCounter(Envoy::Stats::Scope& stats, absl::string_view action_name,
+                                     absl::string_view name) {
+  Envoy::Stats::StatNameManagedStorage stat_name(absl::StrCat("overload.", action_name, ".", name),
+                                                 stats.symbolTable());
+  return stats.counterFromStatName(stat_name.statName());
+}
+
+} // namespace
+
 HeapShrinker::HeapShrinker(Event::Dispatcher& dispatcher, Server::OverloadManager& overload_manager,
-                           Stats::Scope& stats)
-    : active_(false) {
+                           Envoy::Stats::Scope& stats)
+    : state_(Server::OverloadActionState::inactive()) {
   const auto action_name = Server::OverloadActionNames::get().ShrinkHeap;
   if (overload_manager.registerForAction(
           action_name, dispatcher,
-          [this](Server::OverloadActionState state) { active_ = state.isSaturated(); })) {
-    Envoy::Stats::StatNameManagedStorage stat_name(
-        absl::StrCat("overload.", action_name, ".shrink_count"), stats.symbolTable());
-    shrink_counter_ = &stats.counterFromStatName(stat_name.statName());
+          [this](Server::OverloadActionState state) { state_ = state; })) {
+    shrink_counter_ = &actionCounter(stats, action_name, "shrink_count");
+    released_bytes_counter_ = &actionCounter(stats, action_name, "released_bytes");
+    page_faults_counter_ = &actionCounter(stats, action_name, "page_faults");
+    page_faults_ = minorPageFaults();
     timer_ = dispatcher.createTimer([this] {
       shrinkHeap();
       timer_->enableTimer(kTimerInterval);
@@ -30,9 +61,38 @@ HeapShrinker::HeapShrinker(Event::Dispatcher& dispatcher, Server::OverloadManage
 }
 
 void HeapShrinker::shrinkHeap() {
-  if (active_) {
+  // The page faults are counted whether or not the heap is shrunk, so that the faults following a
+  // shrink can be told apart from the usual ones.
+  const uint64_t page_faults = minorPageFaults();
+  if (page_faults > page_faults_) {
+    page_faults_counter_->add(page_faults - page_faults_);
+  }
+  page_faults_ = page_faults;
+
+  const float pressure = state_.value().value();
+  if (pressure == 0) {
+    return;
+  }
+
+  const uint64_t unmapped_before = Stats::totalPageHeapUnmapped();
+  if (state_.isSaturated()) {
+    // Workers return their pooled slice storage and free list blocks the next time they touch
+    // them, so it is released to the system by a subsequent shrink.
+    Buffer::SlicePool::releaseAll();
+    ThreadLocalFreeLists::releaseAll();
     Utils::releaseFreeMemory();
     shrink_counter_->inc();
+  } else {
+    // Release the share of the free memory matching the pressure, so that the heap shrinks over a
+    // few intervals as the pressure builds up.
+    const uint64_t bytes = Stats::totalPageHeapFree() * pressure;
+    if (bytes > 0) {
+      Utils::releaseFreeMemory(bytes);
+    }
+  }
+  const uint64_t unmapped_after = Stats::totalPageHeapUnmapped();
+  if (unmapped_after > unmapped_before) {
+    released_bytes_counter_->add(unmapped_after - unmapped_before);
   }
 }
 
@@ -11,6 +11,11 @@ namespace Memory {
 /**
  * A utility class to periodically attempt to shrink the heap by releasing free memory
  * to the system if the "shrink heap" overload action has been configured and triggered.
+ *
+ * When the action saturates, all the free memory is released at once. While a scaled trigger
+ * holds the action between inactive and saturated, only the matching fraction of the free memory
+ * is released at each interval, so that the heap shrinks gradually as the memory pressure builds
+ * up rather than all at once, which would make the process page fault heavily afterwards.
  */
 class HeapShrinker {
 public:
@@ -20,8 +25,11 @@ public:
 private:
   void shrinkHeap();
 
-  bool active_;
+  Server::OverloadActionState state_;
   Envoy::Stats::Counter* shrink_counter_;
+  Envoy::Stats::Counter* released_bytes_counter_;
+  Envoy::Stats::Counter* page_faults_counter_;
+  uint64_t page_faults_{};
   Envoy::Event::TimerPtr timer_;
 };
 
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstdint>
+
 namespace Envoy {
 namespace Memory {
 
 class Utils {
 public:
   static void releaseFreeMemory();
+  /**
+   * Releases up to bytes of the free memory of the heap to the system.
+   */
+  static void releaseFreeMemory(uint64_t bytes);
   static void tryShrinkHeap();
 };
 
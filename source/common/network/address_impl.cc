@@ -9,6 +9,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/hash.h"
 #include "source/common/common/safe_memcpy.h"
 #include "source/common/common/thread.h"
 #include "source/common/common/utility.h"
@@ -154,8 +155,7 @@ Ipv4Instance::Ipv4Instance(const std::string& address, uint32_t port,
     throw EnvoyException(fmt::format("invalid ipv4 address '{}'", address));
   }
 
-  friendly_name_ = absl::StrCat(address, ":", port);
-  ip_.friendly_address_ = address;
+  ip_.setFriendlyNames(address, absl::StrCat(address, ":", port));
 }
 
 Ipv4Instance::Ipv4Instance(uint32_t port, const SocketInterface* sock_interface)
@@ -165,8 +165,7 @@ Ipv4Instance::Ipv4Instance(uint32_t port, const SocketInterface* sock_interface)
   ip_.ipv4_.address_.sin_family = AF_INET;
   ip_.ipv4_.address_.sin_port = htons(port);
   ip_.ipv4_.address_.sin_addr.s_addr = INADDR_ANY;
-  friendly_name_ = absl::StrCat("0.0.0.0:", port);
-  ip_.friendly_address_ = "0.0.0.0";
+  ip_.setFriendlyNames("0.0.0.0", absl::StrCat("0.0.0.0:", port));
 }
 
 Ipv4Instance::Ipv4Instance(absl::Status& status, const sockaddr_in* address,
@@ -222,14 +221,28 @@ absl::Status Ipv4Instance::validateProtocolSupported() {
 void Ipv4Instance::initHelper(const sockaddr_in* address) {
   memset(&ip_.ipv4_.address_, 0, sizeof(ip_.ipv4_.address_));
   ip_.ipv4_.address_ = *address;
-  ip_.friendly_address_ = sockaddrToString(*address);
+}
+
+void Ipv4Instance::IpHelper::formatFriendlyNames() const {
+  absl::call_once(friendly_names_once_, [this]() {
+    friendly_address_ = sockaddrToString(ipv4_.address_);
 
-  // Based on benchmark testing, this reserve+append implementation runs faster than absl::StrCat.
-  fmt::format_int port(ntohs(address->sin_port));
-  friendly_name_.reserve(ip_.friendly_address_.size() + 1 + port.size());
-  friendly_name_.append(ip_.friendly_address_);
-  friendly_name_.push_back(':');
-  friendly_name_.append(port.data(), port.size());
+    // Based on benchmark testing, this reserve+append implementation runs faster than
+    // absl::StrCat.
+    fmt::format_int port(ntohs(ipv4_.address_.sin_port));
+    friendly_name_.reserve(friendly_address_.size() + 1 + port.size());
+    friendly_name_.append(friendly_address_);
+    friendly_name_.push_back(':');
+    friendly_name_.append(port.data(), port.size());
+  });
+}
+
+void Ipv4Instance::IpHelper::setFriendlyNames(std::string friendly_address,
+                                              std::string friendly_name) {
+  absl::call_once(friendly_names_once_, [&]() {
+    friendly_address_ = std::move(friendly_address);
+    friendly_name_ = std::move(friendly_name);
+  });
 }
 
 absl::uint128 Ipv6Instance::Ipv6Helper::address() const {
@@ -333,9 +346,14 @@ absl::Status Ipv6Instance::validateProtocolSupported() {
 
 void Ipv6Instance::initHelper(const sockaddr_in6& address, bool v6only) {
   ip_.ipv6_.address_ = address;
-  ip_.friendly_address_ = ip_.ipv6_.makeFriendlyAddress();
   ip_.ipv6_.v6only_ = v6only;
-  friendly_name_ = fmt::format("[{}]:{}", ip_.friendly_address_, ip_.port());
+}
+
+void Ipv6Instance::IpHelper::formatFriendlyNames() const {
+  absl::call_once(friendly_names_once_, [this]() {
+    friendly_address_ = ipv6_.makeFriendlyAddress();
+    friendly_name_ = fmt::format("[{}]:{}", friendly_address_, port());
+  });
 }
 
 PipeInstance::PipeInstance(const sockaddr_un* address, socklen_t ss_len, mode_t mode,
@@ -443,6 +461,22 @@ bool EnvoyInternalInstance::operator==(const Instance& rhs) const {
   return rhs.type() == Type::EnvoyInternal && asString() == rhs.asString();
 }
 
+InstanceConstSharedPtr InstanceInternTable::intern(const sockaddr_storage& ss, socklen_t ss_len,
+                                                    os_fd_t fd) {
+  if (!((ss.ss_family == AF_INET && ss_len == sizeof(sockaddr_in)) ||
+        (ss.ss_family == AF_INET6 && ss_len == sizeof(sockaddr_in6)))) {
+    return addressFromSockAddrOrDie(ss, ss_len, fd);
+  }
+  const absl::string_view key(reinterpret_cast<const char*>(&ss), ss_len);
+  Entry& entry = entries_[HashUtil::xxHash64(key) % Size];
+  if (absl::string_view(reinterpret_cast<const char*>(entry.key_.data()), entry.key_len_) != key) {
+    entry.address_ = addressFromSockAddrOrDie(ss, ss_len, fd);
+    memcpy(entry.key_.data(), key.data(), key.size()); // NOLINT(safe-memcpy)
+    entry.key_len_ = ss_len;
+  }
+  return entry.address_;
+}
+
 } // namespace Address
 } // namespace Network
 } // namespace Envoy
@@ -13,6 +13,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/statusor.h"
 
+#include "absl/base/call_once.h"
+
 namespace Envoy {
 namespace Network {
 namespace Address {
@@ -123,6 +125,8 @@ public:
 
   // Network::Address::Instance
   bool operator==(const Instance& rhs) const override;
+  const std::string& asString() const override { return ip_.friendlyName(); }
+  absl::string_view asStringView() const override { return ip_.friendlyName(); }
   const Ip* ip() const override { return &ip_; }
   const Pipe* pipe() const override { return nullptr; }
   const EnvoyInternalAddress* envoyInternalAddress() const override { return nullptr; }
@@ -161,7 +165,10 @@ private:
   };
 
   struct IpHelper : public Ip {
-    const std::string& addressAsString() const override { return friendly_address_; }
+    const std::string& addressAsString() const override {
+      formatFriendlyNames();
+      return friendly_address_;
+    }
     bool isAnyAddress() const override { return ipv4_.address_.sin_addr.s_addr == INADDR_ANY; }
     bool isUnicastAddress() const override {
       return !isAnyAddress() && (ipv4_.address_.sin_addr.s_addr != INADDR_BROADCAST) &&
@@ -173,8 +180,19 @@ private:
     uint32_t port() const override { return ntohs(ipv4_.address_.sin_port); }
     IpVersion version() const override { return IpVersion::v4; }
 
+    const std::string& friendlyName() const {
+      formatFriendlyNames();
+      return friendly_name_;
+    }
+    // The names are formatted on first use: the addresses of most accepted connections and
+    // received datagrams are never printed.
+    void formatFriendlyNames() const;
+    void setFriendlyNames(std::string friendly_address, std::string friendly_name);
+
     Ipv4Helper ipv4_;
-    std::string friendly_address_;
+    mutable absl::once_flag friendly_names_once_;
+    mutable std::string friendly_address_;
+    mutable std::string friendly_name_;
   };
 
   void initHelper(const sockaddr_in* address);
@@ -214,6 +232,8 @@ public:
 
   // Network::Address::Instance
   bool operator==(const Instance& rhs) const override;
+  const std::string& asString() const override { return ip_.friendlyName(); }
+  absl::string_view asStringView() const override { return ip_.friendlyName(); }
   const Ip* ip() const override { return &ip_; }
   const Pipe* pipe() const override { return nullptr; }
   const EnvoyInternalAddress* envoyInternalAddress() const override { return nullptr; }
@@ -255,7 +275,10 @@ private:
   };
 
   struct IpHelper : public Ip {
-    const std::string& addressAsString() const override { return friendly_address_; }
+    const std::string& addressAsString() const override {
+      formatFriendlyNames();
+      return friendly_address_;
+    }
     bool isAnyAddress() const override {
       return 0 == memcmp(&ipv6_.address_.sin6_addr, &in6addr_any, sizeof(struct in6_addr));
     }
@@ -267,8 +290,17 @@ private:
     uint32_t port() const override { return ipv6_.port(); }
     IpVersion version() const override { return IpVersion::v6; }
 
+    const std::string& friendlyName() const {
+      formatFriendlyNames();
+      return friendly_name_;
+    }
+    // See Ipv4Instance::IpHelper::formatFriendlyNames().
+    void formatFriendlyNames() const;
+
     Ipv6Helper ipv6_;
-    std::string friendly_address_;
+    mutable absl::once_flag friendly_names_once_;
+    mutable std::string friendly_address_;
+    mutable std::string friendly_name_;
   };
 
   void initHelper(const sockaddr_in6& address, bool v6only);
@@ -372,6 +404,33 @@ private:
   EnvoyInternalAddressImpl internal_address_;
 };
 
+/**
+ * A bounded table of IP addresses seen on a socket, so that e.g. the datagrams of a peer share one
+ * address instance instead of each allocating and parsing its own. The table is direct-mapped: an
+ * address replaces the one in its slot, so that a flood of distinct peers costs no more than not
+ * interning at all. The table is not thread-safe; it's meant to be owned by the socket of a worker.
+ */
+class InstanceInternTable {
+public:
+  /**
+   * @return the address in `ss`, like addressFromSockAddrOrDie(ss, ss_len, fd) does. Addresses
+   *         other than IPv4 and IPv6 ones with their exact length are created but not interned.
+   */
+  InstanceConstSharedPtr intern(const sockaddr_storage& ss, socklen_t ss_len, os_fd_t fd);
+
+private:
+  static constexpr size_t Size = 64;
+
+  struct Entry {
+    // The sockaddr the address was created from.
+    std::array<uint8_t, sizeof(sockaddr_in6)> key_;
+    socklen_t key_len_{0};
+    InstanceConstSharedPtr address_;
+  };
+
+  std::array<Entry, Size> entries_;
+};
+
 } // namespace Address
 } // namespace Network
 } // namespace Envoy
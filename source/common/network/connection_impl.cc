@@ -100,6 +100,12 @@ ConnectionImpl::ConnectionImpl(Event::Dispatcher& dispatcher, ConnectionSocketPt
   // then we don't need a setter or any of the optional stuff.
   socket_->connectionInfoProvider().setConnectionID(id());
   socket_->connectionInfoProvider().setSslConnection(transport_socket_->ssl());
+
+  memory_account_ = dispatcher.getWatermarkFactory().createConnectionAccount(*this);
+  if (memory_account_ != nullptr) {
+    write_buffer_->bindAccount(memory_account_);
+    read_buffer_->bindAccount(memory_account_);
+  }
 }
 
 ConnectionImpl::~ConnectionImpl() {
@@ -111,6 +117,16 @@ ConnectionImpl::~ConnectionImpl() {
   // deletion). Hence the assert above. However, call close() here just to be completely sure that
   // the fd is closed and make it more likely that we crash from a bad close callback.
   close(ConnectionCloseType::NoFlush);
+  // The socket may have never been open.
+  if (memory_account_ != nullptr) {
+    memory_account_->clearDownstream();
+  }
+}
+
+void ConnectionImpl::closeConnection() {
+  ENVOY_CONN_LOG(debug, "closing connection using excessive memory", *this);
+  close(ConnectionCloseType::NoFlush,
+        StreamInfo::LocalCloseReasons::get().OverloadManagerCloseHighMemoryConnection);
 }
 
 void ConnectionImpl::addWriteFilter(WriteFilterSharedPtr filter) {
@@ -248,6 +264,11 @@ void ConnectionImpl::closeSocket(ConnectionEvent close_type) {
   }
 
   ENVOY_CONN_LOG(debug, "closing socket: {}", *this, static_cast<uint32_t>(close_type));
+  // Stop the tracking of the account before the buffers are drained, the slices moved out of the
+  // buffers credit it once released.
+  if (memory_account_ != nullptr) {
+    memory_account_->clearDownstream();
+  }
   transport_socket_->closeSocket(close_type);
 
   // Drain input and output buffers.
@@ -47,7 +47,9 @@ public:
  * Implementation of Network::Connection, Network::FilterManagerConnection and
  * Envoy::ScopeTrackedObject.
  */
-class ConnectionImpl : public ConnectionImplBase, public TransportSocketCallbacks {
+class ConnectionImpl : public ConnectionImplBase,
+                       public TransportSocketCallbacks,
+                       public Buffer::ConnectionCloseHandler {
 public:
   ConnectionImpl(Event::Dispatcher& dispatcher, ConnectionSocketPtr&& socket,
                  TransportSocketPtr&& transport_socket, StreamInfo::StreamInfo& stream_info,
@@ -61,6 +63,8 @@ public:
   void addReadFilter(ReadFilterSharedPtr filter) override;
   void removeReadFilter(ReadFilterSharedPtr filter) override;
   bool initializeReadFilters() override;
+  uint32_t numReadFilters() const override { return filter_manager_.numReadFilters(); }
+  uint32_t numWriteFilters() const override { return filter_manager_.numWriteFilters(); }
 
   // Network::Connection
   void addBytesSentCallback(BytesSentCb cb) override;
@@ -92,6 +96,9 @@ public:
     // SSL info may be overwritten by a filter in the provider.
     return socket_->connectionInfoProvider().sslConnection();
   }
+  bool forwardsPayloadUnchanged() const override {
+    return transport_socket_->forwardsPayloadUnchanged();
+  }
   State state() const override;
   bool connecting() const override {
     ENVOY_CONN_LOG_EVENT(debug, "connection_connecting_state", "current connecting state: {}",
@@ -143,6 +150,9 @@ public:
   void flushWriteBuffer() override;
   TransportSocketPtr& transportSocket() { return transport_socket_; }
 
+  // Buffer::ConnectionCloseHandler
+  void closeConnection() override;
+
   // Obtain global next connection ID. This should only be used in tests.
   static uint64_t nextGlobalIdForTest() { return next_global_id_; }
 
@@ -190,6 +200,8 @@ protected:
   // consuming, that the connection eventually stops reading from the wire.
   // This buffer is always allocated, never nullptr.
   Buffer::InstancePtr read_buffer_;
+  // The account charged for the read and write buffers, if connections are tracked.
+  Buffer::BufferMemoryAccountSharedPtr memory_account_;
   uint32_t read_buffer_limit_ = 0;
   bool connecting_{false};
   ConnectionEvent immediate_error_event_{ConnectionEvent::Connected};
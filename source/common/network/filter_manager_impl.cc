@@ -1,5 +1,6 @@
 #include "source/common/network/filter_manager_impl.h"
 
+#include <algorithm>
 #include <list>
 
 #include "envoy/network/connection.h"
@@ -38,6 +39,13 @@ void FilterManagerImpl::removeReadFilter(ReadFilterSharedPtr filter_to_remove) {
   }
 }
 
+uint32_t FilterManagerImpl::numReadFilters() const {
+  // Removed filters are nulled out rather than removed.
+  return std::count_if(
+      upstream_filters_.begin(), upstream_filters_.end(),
+      [](const ActiveReadFilterPtr& filter) { return filter->filter_ != nullptr; });
+}
+
 bool FilterManagerImpl::initializeReadFilters() {
   if (upstream_filters_.empty()) {
     return false;
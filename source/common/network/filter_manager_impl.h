@@ -109,6 +109,8 @@ public:
   void addReadFilter(ReadFilterSharedPtr filter);
   void removeReadFilter(ReadFilterSharedPtr filter);
   bool initializeReadFilters();
+  uint32_t numReadFilters() const;
+  uint32_t numWriteFilters() const { return downstream_filters_.size(); }
   void onRead();
   FilterStatus onWrite();
   bool startUpstreamSecureTransport();
@@ -7,6 +7,7 @@
 #include "envoy/network/io_handle.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
 
 namespace Envoy {
@@ -102,10 +103,14 @@ protected:
              : Api::IoErrorPtr(new IoSocketError(result.errno_), IoSocketError::deleteIoError)));
   }
 
+  // The table of the peer and local addresses of the received datagrams, created on first use.
+  Address::InstanceInternTable& receivedAddresses();
+
   os_fd_t fd_;
   int socket_v6only_{false};
   const absl::optional<int> domain_;
   Event::FileEventPtr file_event_{nullptr};
+  std::unique_ptr<Address::InstanceInternTable> received_addresses_;
 
   // The minimum cmsg buffer size to filled in destination address, packets dropped and gso
   // size when receiving a packet. It is possible for a received packet to contain both IPv4
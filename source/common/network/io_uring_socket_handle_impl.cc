@@ -0,0 +1,549 @@
+#include "source/common/network/io_uring_socket_handle_impl.h"
+
+#include <sys/socket.h>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Network {
+
+namespace {
+
+constexpr uint64_t MaxWriteSlices = 16;
+// Data read by the ring but not consumed yet, for example while listener filters peek at it.
+constexpr uint64_t ReadBufferLimit = 64 * 1024;
+
+Api::IoCallUint64Result eagainResult() {
+  return {0, Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                             IoSocketError::deleteIoError)};
+}
+
+Api::IoCallUint64Result errnoResult(int error) {
+  return {0, Api::IoErrorPtr(new IoSocketError(error), IoSocketError::deleteIoError)};
+}
+
+} // namespace
+
+/**
+ * The io_uring side of a connected socket. It owns every buffer referenced by an in-flight
+ * request, which is why it is handed over to the worker when the handle is closed before the
+ * kernel is done with them.
+ */
+class IoUringSocketHandleImpl::Socket : public Io::IoUringSocket {
+public:
+  Socket(Io::IoUringWorker& worker, os_fd_t fd, uint32_t read_buffer_size,
+         Event::FileReadyCb cb, uint32_t events)
+      : worker_(worker), fd_(fd), read_buffer_size_(read_buffer_size),
+        read_storage_(new uint8_t[read_buffer_size]), cb_(std::move(cb)),
+        event_cb_(worker_.dispatcher().createSchedulableCallback([this]() { runEvents(); })),
+        read_request_(*this, RequestType::Read), write_request_(*this, RequestType::Write),
+        cancel_request_(*this, RequestType::Cancel), close_request_(*this, RequestType::Close) {
+    enable(events);
+  }
+
+  ~Socket() override {
+    // Only reached with requests in flight when the worker itself is being torn down, after the
+    // ring has been destroyed.
+    if (SOCKET_VALID(fd_)) {
+      Api::OsSysCallsSingleton::get().close(fd_);
+    }
+  }
+
+  void enable(uint32_t events) {
+    const uint32_t newly_enabled = events & ~enabled_events_;
+    enabled_events_ = events;
+    // Emulate the readiness notification that epoll gives for newly enabled events.
+    if ((newly_enabled & Event::FileReadyType::Write) && write_buf_.length() < WriteBufferLimit) {
+      notify(Event::FileReadyType::Write);
+    }
+    if ((newly_enabled & (Event::FileReadyType::Read | Event::FileReadyType::Closed)) &&
+        (read_buf_.length() > 0 || read_eof_ || read_error_ != 0)) {
+      notify(Event::FileReadyType::Read | (read_eof_ ? Event::FileReadyType::Closed : 0));
+    }
+    maybeSubmitRead();
+  }
+
+  void activate(uint32_t events) { notify(events); }
+
+  void setCallback(Event::FileReadyCb cb, uint32_t events) {
+    cb_ = std::move(cb);
+    enabled_events_ = 0;
+    enable(events);
+  }
+
+  void resetEvents() {
+    cb_ = nullptr;
+    enabled_events_ = 0;
+    pending_events_ = 0;
+    event_cb_->cancel();
+  }
+
+  Api::IoCallUint64Result read(Buffer::Instance& buffer, uint64_t max_length) {
+    if (read_buf_.length() > 0) {
+      const uint64_t length = std::min(max_length, read_buf_.length());
+      buffer.move(read_buf_, length);
+      maybeSubmitRead();
+      return {length, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+    }
+    return emptyReadResult();
+  }
+
+  Api::IoCallUint64Result readv(uint64_t max_length, Buffer::RawSlice* slices,
+                                uint64_t num_slice) {
+    if (read_buf_.length() == 0) {
+      return emptyReadResult();
+    }
+    uint64_t copied = 0;
+    for (uint64_t i = 0; i < num_slice && copied < max_length && read_buf_.length() > 0; i++) {
+      const uint64_t length = std::min(
+          {static_cast<uint64_t>(slices[i].len_), max_length - copied, read_buf_.length()});
+      read_buf_.copyOut(0, length, slices[i].mem_);
+      read_buf_.drain(length);
+      copied += length;
+    }
+    maybeSubmitRead();
+    return {copied, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+  }
+
+  Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) {
+    // Listener filters peek at the data before the connection exists; the data the ring has
+    // already read must stay visible to them.
+    if (read_buf_.length() == 0) {
+      return emptyReadResult();
+    }
+    const uint64_t copied = std::min(static_cast<uint64_t>(length), read_buf_.length());
+    read_buf_.copyOut(0, copied, buffer);
+    if (!(flags & MSG_PEEK)) {
+      read_buf_.drain(copied);
+      maybeSubmitRead();
+    }
+    return {copied, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+  }
+
+  Api::IoCallUint64Result write(Buffer::Instance& buffer) {
+    if (write_error_ != 0) {
+      return errnoResult(write_error_);
+    }
+    if (write_buf_.length() >= WriteBufferLimit) {
+      return eagainResult();
+    }
+    const uint64_t length = buffer.length();
+    write_buf_.move(buffer);
+    maybeSubmitWrite();
+    return {length, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+  }
+
+  Api::IoCallUint64Result writev(const Buffer::RawSlice* slices, uint64_t num_slice) {
+    if (write_error_ != 0) {
+      return errnoResult(write_error_);
+    }
+    if (write_buf_.length() >= WriteBufferLimit) {
+      return eagainResult();
+    }
+    uint64_t length = 0;
+    for (uint64_t i = 0; i < num_slice; i++) {
+      if (slices[i].mem_ != nullptr && slices[i].len_ != 0) {
+        write_buf_.add(slices[i].mem_, slices[i].len_);
+        length += slices[i].len_;
+      }
+    }
+    maybeSubmitWrite();
+    return {length, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+  }
+
+  Api::SysCallIntResult shutdown(int how) {
+    if ((how == ENVOY_SHUT_WR || how == ENVOY_SHUT_RDWR) && write_buf_.length() > 0) {
+      // Shutting down now would discard the buffered writes; do it once they are flushed.
+      shutdown_pending_ = true;
+      if (how == ENVOY_SHUT_WR) {
+        return {0, 0};
+      }
+      how = ENVOY_SHUT_RD;
+    }
+    return Api::OsSysCallsSingleton::get().shutdown(fd_, how);
+  }
+
+  /**
+   * Starts closing the socket: buffered writes are flushed, the posted read is cancelled and the
+   * fd is closed through the ring.
+   * @return true if the socket is done and can be destroyed by the caller right away.
+   */
+  bool close() {
+    resetEvents();
+    closing_ = true;
+    if (read_in_flight_ && !cancel_in_flight_) {
+      if (worker_.submitCancel(read_request_, cancel_request_) == Io::IoUringResult::Ok) {
+        cancel_in_flight_ = true;
+      } else {
+        // Makes the pending read complete with EOF.
+        Api::OsSysCallsSingleton::get().shutdown(fd_, ENVOY_SHUT_RD);
+      }
+    }
+    return maybeFinishClose();
+  }
+
+  /**
+   * @return the worker whose ring the requests of the socket are submitted to.
+   */
+  Io::IoUringWorker& worker() { return worker_; }
+
+private:
+  enum class RequestType { Read, Write, Cancel, Close };
+
+  struct Request : public Io::IoUringRequest {
+    Request(Socket& socket, RequestType type) : socket_(socket), type_(type) {}
+    void onCompletion(int32_t result) override { socket_.onCompletion(type_, result); }
+
+    Socket& socket_;
+    const RequestType type_;
+  };
+
+  Api::IoCallUint64Result emptyReadResult() {
+    if (read_error_ != 0) {
+      return errnoResult(read_error_);
+    }
+    if (read_eof_) {
+      return Api::ioCallUint64ResultNoError();
+    }
+    maybeSubmitRead();
+    return eagainResult();
+  }
+
+  void notify(uint32_t events) {
+    pending_events_ |= events;
+    if (cb_ != nullptr && !event_cb_->enabled()) {
+      event_cb_->scheduleCallbackCurrentIteration();
+    }
+  }
+
+  void runEvents() {
+    uint32_t events = pending_events_;
+    pending_events_ = 0;
+    // Activated events are delivered regardless of the enabled set, like FileEvent::activate().
+    if (events != 0 && cb_ != nullptr) {
+      cb_(events);
+    }
+  }
+
+  void maybeSubmitRead() {
+    if (closing_ || read_in_flight_ || read_eof_ || read_error_ != 0 ||
+        !(enabled_events_ & (Event::FileReadyType::Read | Event::FileReadyType::Closed)) ||
+        read_buf_.length() >= ReadBufferLimit) {
+      return;
+    }
+    read_iov_.iov_base = read_storage_.get();
+    read_iov_.iov_len = read_buffer_size_;
+    if (worker_.submitReadv(fd_, &read_iov_, 1, read_request_) == Io::IoUringResult::Ok) {
+      read_in_flight_ = true;
+    }
+  }
+
+  void maybeSubmitWrite() {
+    if (write_in_flight_ || write_buf_.length() == 0 || write_error_ != 0) {
+      return;
+    }
+    Buffer::RawSliceVector slices = write_buf_.getRawSlices(MaxWriteSlices);
+    write_iovs_.clear();
+    for (const Buffer::RawSlice& slice : slices) {
+      write_iovs_.push_back({slice.mem_, slice.len_});
+    }
+    if (worker_.submitWritev(fd_, write_iovs_.data(), write_iovs_.size(), write_request_) ==
+        Io::IoUringResult::Ok) {
+      write_in_flight_ = true;
+    }
+  }
+
+  void onCompletion(RequestType type, int32_t result) {
+    switch (type) {
+    case RequestType::Read:
+      read_in_flight_ = false;
+      onRead(result);
+      break;
+    case RequestType::Write:
+      write_in_flight_ = false;
+      onWrite(result);
+      break;
+    case RequestType::Cancel:
+      cancel_in_flight_ = false;
+      break;
+    case RequestType::Close:
+      close_in_flight_ = false;
+      SET_SOCKET_INVALID(fd_);
+      worker_.destroySocket(*this);
+      return;
+    }
+    if (closing_) {
+      maybeFinishClose();
+    }
+  }
+
+  void onRead(int32_t result) {
+    if (closing_) {
+      return;
+    }
+    if (result > 0) {
+      read_buf_.add(read_storage_.get(), result);
+      notify(Event::FileReadyType::Read);
+    } else if (result == 0) {
+      read_eof_ = true;
+      notify(Event::FileReadyType::Read | Event::FileReadyType::Closed);
+    } else if (result != -ECANCELED) {
+      read_error_ = -result;
+      notify(Event::FileReadyType::Read);
+    }
+    maybeSubmitRead();
+  }
+
+  void onWrite(int32_t result) {
+    if (result >= 0) {
+      write_buf_.drain(result);
+    } else if (result != -ECANCELED) {
+      write_error_ = -result;
+      write_buf_.drain(write_buf_.length());
+    }
+    if (write_buf_.length() == 0 && shutdown_pending_) {
+      shutdown_pending_ = false;
+      Api::OsSysCallsSingleton::get().shutdown(fd_, ENVOY_SHUT_WR);
+    }
+    if (!closing_ && (enabled_events_ & Event::FileReadyType::Write) &&
+        (write_buf_.length() < WriteBufferLimit || write_error_ != 0)) {
+      notify(Event::FileReadyType::Write);
+    }
+    maybeSubmitWrite();
+  }
+
+  bool maybeFinishClose() {
+    maybeSubmitWrite();
+    if (read_in_flight_ || write_in_flight_ || cancel_in_flight_ || close_in_flight_) {
+      return false;
+    }
+    if (write_buf_.length() > 0 && write_error_ == 0) {
+      // The write could not be queued; wait for the ring to drain.
+      return false;
+    }
+    if (worker_.submitClose(fd_, close_request_) == Io::IoUringResult::Ok) {
+      close_in_flight_ = true;
+      return false;
+    }
+    Api::OsSysCallsSingleton::get().close(fd_);
+    SET_SOCKET_INVALID(fd_);
+    return true;
+  }
+
+  Io::IoUringWorker& worker_;
+  os_fd_t fd_;
+  const uint32_t read_buffer_size_;
+  std::unique_ptr<uint8_t[]> read_storage_;
+  struct iovec read_iov_ {};
+  Buffer::OwnedImpl read_buf_;
+  Buffer::OwnedImpl write_buf_;
+  std::vector<struct iovec> write_iovs_;
+  Event::FileReadyCb cb_;
+  uint32_t enabled_events_{0};
+  uint32_t pending_events_{0};
+  Event::SchedulableCallbackPtr event_cb_;
+  Request read_request_;
+  Request write_request_;
+  Request cancel_request_;
+  Request close_request_;
+  int read_error_{0};
+  int write_error_{0};
+  bool read_eof_{false};
+  bool read_in_flight_{false};
+  bool write_in_flight_{false};
+  bool cancel_in_flight_{false};
+  bool close_in_flight_{false};
+  bool shutdown_pending_{false};
+  bool closing_{false};
+};
+
+IoUringSocketHandleImpl::IoUringSocketHandleImpl(Io::IoUringWorkerFactoryImpl& worker_factory,
+                                                 uint32_t read_buffer_size, os_fd_t fd,
+                                                 bool socket_v6only, absl::optional<int> domain)
+    : IoSocketHandleImpl(fd, socket_v6only, domain), worker_factory_(worker_factory),
+      read_buffer_size_(read_buffer_size) {}
+
+IoUringSocketHandleImpl::~IoUringSocketHandleImpl() {
+  if (SOCKET_VALID(fd_)) {
+    IoUringSocketHandleImpl::close();
+  }
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::close() {
+  promote_cb_.reset();
+  if (socket_ == nullptr) {
+    return IoSocketHandleImpl::close();
+  }
+  ASSERT(SOCKET_VALID(fd_));
+  // The fd now belongs to the io_uring socket, which closes it once its requests are done.
+  SET_SOCKET_INVALID(fd_);
+  if (!socket_->close()) {
+    // Hand the socket to the worker whose ring its requests are in flight on, which is not
+    // necessarily the one of the calling thread.
+    Io::IoUringWorker& worker = socket_->worker();
+    worker.adoptSocket(std::move(socket_));
+  }
+  socket_.reset();
+  return Api::ioCallUint64ResultNoError();
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::readv(uint64_t max_length,
+                                                       Buffer::RawSlice* slices,
+                                                       uint64_t num_slice) {
+  if (socket_ == nullptr) {
+    return IoSocketHandleImpl::readv(max_length, slices, num_slice);
+  }
+  return socket_->readv(max_length, slices, num_slice);
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::read(Buffer::Instance& buffer,
+                                                      absl::optional<uint64_t> max_length) {
+  if (socket_ == nullptr) {
+    return IoSocketHandleImpl::read(buffer, max_length);
+  }
+  if (max_length.has_value() && max_length.value() == 0) {
+    return Api::ioCallUint64ResultNoError();
+  }
+  return socket_->read(buffer, max_length.value_or(UINT64_MAX));
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::writev(const Buffer::RawSlice* slices,
+                                                        uint64_t num_slice) {
+  if (socket_ == nullptr) {
+    return IoSocketHandleImpl::writev(slices, num_slice);
+  }
+  return socket_->writev(slices, num_slice);
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::write(Buffer::Instance& buffer) {
+  if (socket_ == nullptr) {
+    return IoSocketHandleImpl::write(buffer);
+  }
+  return socket_->write(buffer);
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::recv(void* buffer, size_t length, int flags) {
+  if (socket_ == nullptr) {
+    return IoSocketHandleImpl::recv(buffer, length, flags);
+  }
+  return socket_->recv(buffer, length, flags);
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::listen(int backlog) {
+  listening_ = true;
+  return IoSocketHandleImpl::listen(backlog);
+}
+
+IoHandlePtr IoUringSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* addrlen) {
+  auto result = Api::OsSysCallsSingleton::get().accept(fd_, addr, addrlen);
+  if (SOCKET_INVALID(result.return_value_)) {
+    return nullptr;
+  }
+  return std::make_unique<IoUringSocketHandleImpl>(worker_factory_, read_buffer_size_,
+                                                   result.return_value_, socket_v6only_, domain_);
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::connect(Address::InstanceConstSharedPtr address) {
+  Api::SysCallIntResult result = IoSocketHandleImpl::connect(address);
+  connecting_ = result.return_value_ != 0 && result.errno_ == SOCKET_ERROR_IN_PROGRESS;
+  return result;
+}
+
+void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
+                                                  Event::FileReadyCb cb,
+                                                  Event::FileTriggerType trigger,
+                                                  uint32_t events) {
+  ASSERT(file_event_ == nullptr, "Attempting to initialize two `file_event_` for the same "
+                                 "file descriptor. This is not allowed.");
+  cb_ = std::move(cb);
+  enabled_events_ = events;
+  if (socket_ != nullptr) {
+    // The events were reset earlier, e.g. when the listener filters handed the socket over to
+    // the connection.
+    socket_->setCallback(cb_, events);
+    return;
+  }
+  if (!listening_ && !connecting_) {
+    maybeUseIoUring(dispatcher);
+    if (socket_ != nullptr) {
+      return;
+    }
+  }
+  if (connecting_) {
+    // The connection is established once the socket becomes writable. Let the owner handle that
+    // on the regular path, then switch over before the next event.
+    promote_cb_ = dispatcher.createSchedulableCallback([this, &dispatcher]() {
+      if (SOCKET_VALID(fd_) && file_event_ != nullptr) {
+        maybeUseIoUring(dispatcher);
+      }
+    });
+    file_event_ = dispatcher.createFileEvent(
+        fd_,
+        [this](uint32_t events) {
+          if (connecting_ && (events & Event::FileReadyType::Write)) {
+            connecting_ = false;
+            promote_cb_->scheduleCallbackCurrentIteration();
+          }
+          cb_(events);
+        },
+        trigger, events);
+    return;
+  }
+  file_event_ = dispatcher.createFileEvent(fd_, cb_, trigger, events);
+}
+
+void IoUringSocketHandleImpl::maybeUseIoUring(Event::Dispatcher& dispatcher) {
+  OptRef<Io::IoUringWorker> worker = worker_factory_.getIoUringWorker();
+  if (!worker.has_value() || &worker->dispatcher() != &dispatcher) {
+    return;
+  }
+  file_event_.reset();
+  socket_ = std::make_unique<Socket>(*worker, fd_, read_buffer_size_, cb_, enabled_events_);
+  ENVOY_LOG(trace, "fd {} switched to io_uring", fd_);
+}
+
+IoHandlePtr IoUringSocketHandleImpl::duplicate() {
+  auto result = Api::OsSysCallsSingleton::get().duplicate(fd_);
+  RELEASE_ASSERT(result.return_value_ != -1,
+                 fmt::format("duplicate failed for '{}': ({}) {}", fd_, result.errno_,
+                             errorDetails(result.errno_)));
+  return std::make_unique<IoUringSocketHandleImpl>(worker_factory_, read_buffer_size_,
+                                                   result.return_value_, socket_v6only_, domain_);
+}
+
+void IoUringSocketHandleImpl::activateFileEvents(uint32_t events) {
+  if (socket_ == nullptr) {
+    IoSocketHandleImpl::activateFileEvents(events);
+    return;
+  }
+  socket_->activate(events);
+}
+
+void IoUringSocketHandleImpl::enableFileEvents(uint32_t events) {
+  enabled_events_ = events;
+  if (socket_ == nullptr) {
+    IoSocketHandleImpl::enableFileEvents(events);
+    return;
+  }
+  socket_->enable(events);
+}
+
+void IoUringSocketHandleImpl::resetFileEvents() {
+  promote_cb_.reset();
+  if (socket_ == nullptr) {
+    IoSocketHandleImpl::resetFileEvents();
+    return;
+  }
+  socket_->resetEvents();
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::shutdown(int how) {
+  if (socket_ == nullptr) {
+    return IoSocketHandleImpl::shutdown(how);
+  }
+  return socket_->shutdown(how);
+}
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/io/io_uring_worker_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * IoHandle for TCP sockets that performs reads, writes and close through the io_uring of the
+ * thread that owns the socket's file event. A read is kept posted on the ring while read events
+ * are enabled and its data is handed out by read()/readv(); writes are accepted into an internal
+ * buffer of up to WriteBufferLimit bytes and flushed by asynchronous writev requests. All the
+ * requests issued during one event loop iteration are submitted to the kernel together.
+ *
+ * Sockets fall back to the regular system call path when the thread has no io_uring worker, and
+ * listening sockets always use it. Client sockets switch to io_uring once connected.
+ */
+class IoUringSocketHandleImpl : public IoSocketHandleImpl {
+public:
+  IoUringSocketHandleImpl(Io::IoUringWorkerFactoryImpl& worker_factory, uint32_t read_buffer_size,
+                          os_fd_t fd = INVALID_SOCKET, bool socket_v6only = false,
+                          absl::optional<int> domain = absl::nullopt);
+  ~IoUringSocketHandleImpl() override;
+
+  // Maximum number of written bytes buffered by the handle before write() reports EAGAIN.
+  static constexpr uint64_t WriteBufferLimit = 64 * 1024;
+
+  // Network::IoHandle
+  Api::IoCallUint64Result close() override;
+  Api::IoCallUint64Result readv(uint64_t max_length, Buffer::RawSlice* slices,
+                                uint64_t num_slice) override;
+  Api::IoCallUint64Result read(Buffer::Instance& buffer,
+                               absl::optional<uint64_t> max_length) override;
+  Api::IoCallUint64Result writev(const Buffer::RawSlice* slices, uint64_t num_slice) override;
+  Api::IoCallUint64Result write(Buffer::Instance& buffer) override;
+  Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::SysCallIntResult listen(int backlog) override;
+  IoHandlePtr accept(struct sockaddr* addr, socklen_t* addrlen) override;
+  Api::SysCallIntResult connect(Address::InstanceConstSharedPtr address) override;
+  void initializeFileEvent(Event::Dispatcher& dispatcher, Event::FileReadyCb cb,
+                           Event::FileTriggerType trigger, uint32_t events) override;
+  IoHandlePtr duplicate() override;
+  void activateFileEvents(uint32_t events) override;
+  void enableFileEvents(uint32_t events) override;
+  void resetFileEvents() override;
+  Api::SysCallIntResult shutdown(int how) override;
+
+  /**
+   * @return true if the handle currently performs its I/O through io_uring.
+   */
+  bool usingIoUring() const { return socket_ != nullptr; }
+
+private:
+  class Socket;
+
+  // Moves the socket onto the io_uring of the current thread, if it has one.
+  void maybeUseIoUring(Event::Dispatcher& dispatcher);
+
+  Io::IoUringWorkerFactoryImpl& worker_factory_;
+  const uint32_t read_buffer_size_;
+  bool listening_{false};
+  bool connecting_{false};
+  Event::FileReadyCb cb_;
+  uint32_t enabled_events_{0};
+  Event::SchedulableCallbackPtr promote_cb_;
+  std::unique_ptr<Socket> socket_;
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -14,8 +14,10 @@
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/utility.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/numeric/int128.h"
+#include "absl/types/span.h"
 #include "fmt/format.h"
 
 namespace Envoy {
@@ -23,11 +25,10 @@ namespace Network {
 namespace LcTrie {
 
 /**
- * Maximum number of nodes an LC trie can hold.
- * @note If the size of LcTrieInternal::LcNode::address_ ever changes, this constant
- *       should be changed to match.
+ * Maximum number of nodes an LC trie can hold. LcTrieInternal::LcNode::address_ could index more
+ * nodes; this bounds the memory used by the nodes of a trie to 64MiB.
  */
-constexpr size_t MaxLcTrieNodes = (1 << 20);
+constexpr size_t MaxLcTrieNodes = (1 << 23);
 
 /**
  * Level Compressed Trie for associating data with CIDR ranges. Both IPv4 and IPv6 addresses are
@@ -58,11 +59,10 @@ public:
   LcTrie(const std::vector<std::pair<T, std::vector<Address::CidrRange>>>& data,
          bool exclusive = false, double fill_factor = 0.5, uint32_t root_branching_factor = 0) {
 
-    // The LcTrie implementation uses 20-bit "pointers" in its compact internal representation,
-    // so it cannot hold more than 2^20 nodes. But the number of nodes can be greater than the
-    // number of supported prefixes. Given N prefixes in the data input list, step 2 below can
-    // produce a new list of up to 2*N prefixes to insert in the LC trie. And the LC trie can
-    // use up to 2*N/fill_factor nodes.
+    // The LcTrie implementation cannot hold more than MaxLcTrieNodes nodes. But the number of
+    // nodes can be greater than the number of supported prefixes. Given N prefixes in the data
+    // input list, step 2 below can produce a new list of up to 2*N prefixes to insert in the LC
+    // trie. And the LC trie can use up to 2*N/fill_factor nodes.
     size_t num_prefixes = 0;
     for (const auto& pair_data : data) {
       num_prefixes += pair_data.second.size();
@@ -160,13 +160,22 @@ public:
     //   +---+      +---+     +---+      +---+
     //
     // Or, in the internal vector form that the LcTrie class uses for memory-efficiency,
-    //    # | branch | skip | first_child | data | note
+    //    # | branch | skip | first_child | leaf | note
     //   ---+--------+------+-------------+------+--------------------------------------------------
     //    0 |      2 |    0 |           1 |  -   | (1 << branch) == 4 children, starting at offset 1
-    //    1 |      - |    0 |           - |  A   | 1st child of node 0, reached if next bits are 00
-    //    2 |      - |    0 |           - |  A   |   .
-    //    3 |      - |    0 |           - |  A,B |   .
-    //    4 |      - |    0 |           - |  A,C | 4th child of node 0, reached if next bits are 11
+    //    1 |      - |    0 |           - |  0   | 1st child of node 0, reached if next bits are 00
+    //    2 |      - |    0 |           - |  0   |   .
+    //    3 |      - |    0 |           - |  1   |   .
+    //    4 |      - |    0 |           - |  2   | 4th child of node 0, reached if next bits are 11
+    //
+    // where the leaves hold the prefixes and the ranges of their data, which is stored once per
+    // distinct set of data:
+    //    # | prefix        | data
+    //   ---+---------------+-----------
+    //    0 | 0.0.0.0/1     | [0, 1)
+    //    1 | 128.0.0.0/2   | [1, 3)
+    //    2 | 192.0.0.0/2   | [3, 5)
+    //   data: A, A, B, A, C
     //
     // The Nilsson and Karlsson paper linked in lc_trie.h has a more thorough example.
 
@@ -183,6 +192,21 @@ public:
    * version of the ip_address.
    */
   std::vector<T> getData(const Network::Address::InstanceConstSharedPtr& ip_address) const {
+    const absl::Span<const T> data = getDataView(ip_address);
+    return std::vector<T>(data.begin(), data.end());
+  }
+
+  /**
+   * Retrieve data associated with the CIDR range that contains `ip_address`, without copying it.
+   * The data of all the ranges with the same set of data is stored once, so for small T, e.g.
+   * IDs interned by the caller, a lookup reads a handful of contiguous words.
+   * @param  ip_address supplies the IP address.
+   * @return a view of the data from the CIDR ranges and IP addresses that contains 'ip_address',
+   * valid for the lifetime of the trie. An empty view is returned if no prefix contains
+   * 'ip_address' or there is no data for the IP version of the ip_address.
+   */
+  absl::Span<const T>
+  getDataView(const Network::Address::InstanceConstSharedPtr& ip_address) const {
     if (ip_address->ip()->version() == Address::IpVersion::v4) {
       Ipv4 ip = ntohl(ip_address->ip()->ipv4()->address());
       return ipv4_trie_->getData(ip);
@@ -235,6 +259,22 @@ private:
   using DataSet = absl::node_hash_set<T>;
   using DataSetSharedPtr = std::shared_ptr<DataSet>;
 
+  // Hashes and compares sets of data by their contents, to store the data of equal sets once.
+  struct DataSetHash {
+    size_t operator()(const DataSet* data) const {
+      // The iteration order of equal sets may differ, so the element hashes are combined with a
+      // commutative operation.
+      size_t hash = data->size();
+      for (const T& value : *data) {
+        hash += typename DataSet::hasher()(value);
+      }
+      return hash;
+    }
+  };
+  struct DataSetEqual {
+    bool operator()(const DataSet* lhs, const DataSet* rhs) const { return *lhs == *rhs; }
+  };
+
   /**
    * Structure to hold a CIDR range and the data associated with it.
    */
@@ -242,12 +282,13 @@ private:
 
     IpPrefix() = default;
 
-    IpPrefix(const IpType& ip, uint32_t length, const T& data) : ip_(ip), length_(length) {
-      data_.insert(data);
+    IpPrefix(const IpType& ip, uint32_t length, const T& data)
+        : ip_(ip), length_(length), data_(std::make_shared<DataSet>()) {
+      data_->insert(data);
     }
 
-    IpPrefix(const IpType& ip, int length, const DataSet& data)
-        : ip_(ip), length_(length), data_(data) {}
+    IpPrefix(const IpType& ip, int length, DataSetSharedPtr data)
+        : ip_(ip), length_(length), data_(std::move(data)) {}
 
     /**
      * @return -1 if the current object is less than other. 0 if they are the same. 1
@@ -295,8 +336,8 @@ private:
     IpType ip_{0};
     // Length of the cidr range.
     uint32_t length_{0};
-    // Data for this entry.
-    DataSet data_;
+    // Data for this entry, which may be shared with other entries.
+    DataSetSharedPtr data_;
   };
 
   /**
@@ -332,7 +373,7 @@ private:
       if (node->data == nullptr) {
         node->data = std::make_shared<DataSet>();
       }
-      node->data->insert(prefix.data_.begin(), prefix.data_.end());
+      node->data->insert(prefix.data_->begin(), prefix.data_->end());
     }
 
     /**
@@ -381,7 +422,7 @@ private:
                 if (depth != 0) {
                   ip <<= (address_size - depth);
                 }
-                prefixes.emplace_back(IpPrefix<IpType>(ip, depth, *node->data));
+                prefixes.emplace_back(IpPrefix<IpType>(ip, depth, node->data));
               }
             }
           };
@@ -409,7 +450,7 @@ private:
    * 'http://www.csc.kth.se/~snilsson/software/router/C/' were used as reference during
    * implementation.
    *
-   * Note: The trie can only support up 524288(2^19) prefixes with a fill_factor of 1 and
+   * Note: The trie can only support up 4194304(2^22) prefixes with a fill_factor of 1 and
    * root_branching_factor not set. Refer to LcTrieInternal::build() method for more details.
    */
   template <class IpType, uint32_t address_size = CHAR_BIT * sizeof(IpType)> class LcTrieInternal {
@@ -429,28 +470,46 @@ private:
     /**
      * Retrieve the data associated with the CIDR range that contains `ip_address`.
      * @param  ip_address supplies the IP address in host byte order.
-     * @return a vector of data from the CIDR ranges and IP addresses that encompasses the input.
-     * An empty vector is returned if the LC Trie is empty.
+     * @return a view of the data from the CIDR ranges and IP addresses that encompasses the
+     * input. An empty view is returned if the LC Trie is empty.
      */
-    std::vector<T> getData(const IpType& ip_address) const;
+    absl::Span<const T> getData(const IpType& ip_address) const;
 
   private:
     /**
-     * Builds the Level Compressed Trie, by first sorting the data, removing duplicated
-     * prefixes and invoking buildRecursive() to build the trie.
+     * Builds the Level Compressed Trie, by first sorting the data into leaves_, storing the data
+     * of each distinct set once in data_ and invoking buildRecursive() to build the trie.
      */
     void build(std::vector<IpPrefix<IpType>>& data) {
       if (data.empty()) {
         return;
       }
 
-      ip_prefixes_ = data;
-      std::sort(ip_prefixes_.begin(), ip_prefixes_.end());
+      std::sort(data.begin(), data.end());
+      // Ranges of the same T often share their set of data, e.g. the ranges of a tag.
+      absl::flat_hash_map<const DataSet*, uint32_t, DataSetHash, DataSetEqual> data_begins;
+      std::vector<const DataSet*> data_sets;
+      uint32_t data_size = 0;
+      leaves_.reserve(data.size());
+      for (const IpPrefix<IpType>& prefix : data) {
+        auto [it, inserted] = data_begins.try_emplace(prefix.data_.get(), data_size);
+        if (inserted) {
+          data_sets.push_back(prefix.data_.get());
+          data_size += prefix.data_->size();
+        }
+        leaves_.push_back(Leaf{prefix.ip_, prefix.length_, it->second,
+                               static_cast<uint32_t>(prefix.data_->size())});
+      }
+      data_ = std::make_unique<T[]>(data_size);
+      T* next_data = data_.get();
+      for (const DataSet* data_set : data_sets) {
+        next_data = std::copy(data_set->begin(), data_set->end(), next_data);
+      }
 
       // Build the trie_.
-      trie_.reserve(static_cast<size_t>(ip_prefixes_.size() / fill_factor_));
+      trie_.reserve(static_cast<size_t>(leaves_.size() / fill_factor_));
       uint32_t next_free_index = 1;
-      buildRecursive(0u, 0u, ip_prefixes_.size(), 0u, next_free_index);
+      buildRecursive(0u, 0u, leaves_.size(), 0u, next_free_index);
 
       // The value of next_free_index is the final size of the trie_.
       ASSERT(next_free_index <= trie_.size());
@@ -463,14 +522,14 @@ private:
       ComputePair(int branch, int prefix) : branch_(branch), prefix_(prefix) {}
 
       uint32_t branch_;
-      // The total number of bits that have the same prefix for subset of ip_prefixes_.
+      // The total number of bits that have the same prefix for subset of leaves_.
       uint32_t prefix_;
     };
 
     /**
      * Compute the branch and skip values for the trie starting at position 'first' through
      * 'first+n-1' while disregarding the prefix.
-     * @param prefix supplies the common prefix in the ip_prefixes_ array.
+     * @param prefix supplies the common prefix in the leaves_ array.
      * @param first supplies the index where computing the branch should begin with.
      * @param n supplies the number of nodes to use while computing the branch.
      * @return pair of integers for the branching factor and the skip.
@@ -478,10 +537,10 @@ private:
     ComputePair computeBranchAndSkip(uint32_t prefix, uint32_t first, uint32_t n) const {
       ComputePair compute(0, 0);
 
-      // Compute the new prefix for the range between ip_prefixes_[first] and
-      // ip_prefixes_[first + n - 1].
-      IpType high = removeBits<IpType, address_size>(prefix, ip_prefixes_[first].ip_);
-      IpType low = removeBits<IpType, address_size>(prefix, ip_prefixes_[first + n - 1].ip_);
+      // Compute the new prefix for the range between leaves_[first] and
+      // leaves_[first + n - 1].
+      IpType high = removeBits<IpType, address_size>(prefix, leaves_[first].ip_);
+      IpType low = removeBits<IpType, address_size>(prefix, leaves_[first + n - 1].ip_);
       uint32_t index = prefix;
 
       // Find the index at which low and high diverge to get the skip.
@@ -519,8 +578,8 @@ private:
           break;
         }
 
-        // Start by checking the bit patterns at ip_prefixes_[first] through
-        // ip_prefixes_[first + n-1].
+        // Start by checking the bit patterns at leaves_[first] through
+        // leaves_[first + n-1].
         index = first;
         // Pattern to search for.
         uint32_t pattern = 0;
@@ -534,7 +593,7 @@ private:
           // an IP prefix doesn't match the pattern.
           while (index < first + n &&
                  static_cast<uint32_t>(extractBits<IpType, address_size>(
-                     compute.prefix_, branch, ip_prefixes_[index].ip_)) == pattern) {
+                     compute.prefix_, branch, leaves_[index].ip_)) == pattern) {
             ++index;
             pattern_found = true;
           }
@@ -546,7 +605,7 @@ private:
         }
         // Stop iterating once the size of the branch (with the fill factor ratio)
         // can no longer contain all of the prefixes within the current range of
-        // ip_prefixes_[first] to ip_prefixes_[first+n-1].
+        // leaves_[first] to leaves_[first+n-1].
       } while (count >= fill_factor_ * (1 << branch));
 
       // The branching factor is decremented because the algorithm requires the largest branching
@@ -564,7 +623,7 @@ private:
     /**
      * Recursively build a trie for IP prefixes from position 'first' to 'first+n-1'.
      * @param prefix supplies the prefix to ignore when building the sub-trie.
-     * @param first supplies the index into ip_prefixes_ for this sub-trie.
+     * @param first supplies the index into leaves_ for this sub-trie.
      * @param n supplies the number of entries for the sub-trie.
      * @param position supplies the root for this sub-trie.
      * @param next_free_index supplies the next available index in the trie_.
@@ -611,12 +670,12 @@ private:
       for (uint32_t bit_pattern = 0; bit_pattern < static_cast<uint32_t>(1 << output.branch_);
            ++bit_pattern) {
 
-        // count is the number of entries in the ip_prefixes_ vector that have the same bit
-        // pattern as the ip_prefixes_[new_position].
+        // count is the number of entries in the leaves_ vector that have the same bit
+        // pattern as the leaves_[new_position].
         int count = 0;
         while (new_position + count < first + n &&
                static_cast<uint32_t>(extractBits<IpType, address_size>(
-                   output.prefix_, output.branch_, ip_prefixes_[new_position + count].ip_)) ==
+                   output.prefix_, output.branch_, leaves_[new_position + count].ip_)) ==
                    bit_pattern) {
           ++count;
         }
@@ -626,7 +685,7 @@ private:
         // When there are no entries that match the current pattern, set a leaf at trie_[address +
         // bit_pattern].
         if (count == 0) {
-          // This case is hit when the last CIDR range(ip_prefixes_[first+n-1]) is being inserted
+          // This case is hit when the last CIDR range(leaves_[first+n-1]) is being inserted
           // into the trie_. new_position is decremented by one because the count added to
           // new_position at line 445 are the number of entries already visited.
           if (new_position == first + n) {
@@ -637,10 +696,10 @@ private:
                            next_free_index);
           }
         } else if (count == 1 &&
-                   ip_prefixes_[new_position].length_ - output.prefix_ < output.branch_) {
+                   leaves_[new_position].length_ - output.prefix_ < output.branch_) {
           // All Ip address that have the prefix of `bit_pattern` will map to the only CIDR range
           // with the bit_pattern as a prefix.
-          uint32_t bits = output.branch_ + output.prefix_ - ip_prefixes_[new_position].length_;
+          uint32_t bits = output.branch_ + output.prefix_ - leaves_[new_position].length_;
           for (uint32_t i = bit_pattern; i < bit_pattern + (1 << bits); ++i) {
             buildRecursive(output.prefix_ + output.branch_, new_position, 1, address + i,
                            next_free_index);
@@ -648,8 +707,8 @@ private:
           // Update the bit_pattern to skip over the trie_ entries initialized above.
           bit_pattern += (1 << bits) - 1;
         } else {
-          // Recursively build sub-tries for ip_prefixes_[new_position] to
-          // ip_prefixes_[new_position+count-1].
+          // Recursively build sub-tries for leaves_[new_position] to
+          // leaves_[new_position+count-1].
           buildRecursive(output.prefix_ + output.branch_, new_position, count,
                          address + bit_pattern, next_free_index);
         }
@@ -658,7 +717,7 @@ private:
     }
 
     /**
-     * LcNode is a uint32_t. A wrapper is provided to simplify getting/setting the branch, the
+     * LcNode is a uint64_t. A wrapper is provided to simplify getting/setting the branch, the
      * skip and the address values held within the structure.
      *
      * The LcNode has three parts to it
@@ -667,25 +726,38 @@ private:
      * 2, so there can be at most 2^31 descendant nodes.
      * - Skip: the next 7 bits represent the number of bits to skip when looking at an IP address.
      * This value can be between 0 and 127, so IPv6 is supported.
-     * - Address: the remaining 20 bits represent an index either into the trie_ or the
-     * ip_prefixes_. If branch_ != 0, the index is for the trie_. If branch == zero, the index is
-     * for the ip_prefixes_.
-     *
-     * Note: If more than 2^19-1 CIDR ranges are to be stored in trie_, uint64_t should be used
-     * instead.
+     * - Address: the next 32 bits represent an index either into the trie_ or the leaves_. If
+     * branch_ != 0, the index is for the trie_. If branch == zero, the index is for the leaves_.
      */
     struct LcNode {
-      uint32_t branch_ : 5;
-      uint32_t skip_ : 7;
-      uint32_t address_ : 20; // If this 20-bit size changes, please change MaxLcTrieNodes too.
+      uint64_t branch_ : 5;
+      uint64_t skip_ : 7;
+      uint64_t address_ : 32;
     };
 
-    // The CIDR range and data needs to be maintained separately from the LC-Trie. A LC-Trie skips
-    // chunks of data while searching for a match. This means that the node found in the LC-Trie
-    // is not guaranteed to have the IP address in range. The last step prior to returning
-    // associated data is to check the CIDR range pointed to by the node in the LC-Trie has
-    // the IP address in range.
-    std::vector<IpPrefix<IpType>> ip_prefixes_;
+    /**
+     * A leaf of the LC-Trie: a CIDR range, and the range of data_ holding its data. A LC-Trie
+     * skips chunks of data while searching for a match. This means that the node found in the
+     * LC-Trie is not guaranteed to have the IP address in range. The last step prior to returning
+     * associated data is to check the CIDR range of the leaf pointed to by the node in the
+     * LC-Trie has the IP address in range; the range and its data are read from the same leaf.
+     */
+    struct Leaf {
+      bool contains(const IpType& address) const {
+        return (extractBits<IpType, address_size>(0, length_, ip_) ==
+                extractBits<IpType, address_size>(0, length_, address));
+      }
+
+      IpType ip_;
+      uint32_t length_;
+      uint32_t data_begin_;
+      uint32_t data_size_;
+    };
+
+    std::vector<Leaf> leaves_;
+
+    // The data of the leaves, stored once per distinct set.
+    std::unique_ptr<T[]> data_;
 
     // Main trie search structure.
     std::vector<LcNode> trie_;
@@ -709,11 +781,10 @@ LcTrie<T>::LcTrieInternal<IpType, address_size>::LcTrieInternal(std::vector<IpPr
 
 template <class T>
 template <class IpType, uint32_t address_size>
-std::vector<T>
+absl::Span<const T>
 LcTrie<T>::LcTrieInternal<IpType, address_size>::getData(const IpType& ip_address) const {
-  std::vector<T> return_vector;
   if (trie_.empty()) {
-    return return_vector;
+    return {};
   }
 
   LcNode node = trie_[0];
@@ -735,11 +806,11 @@ LcTrie<T>::LcTrieInternal<IpType, address_size>::getData(const IpType& ip_addres
   // The path taken through the trie to match the ip_address may have contained skips,
   // so it is necessary to check whether the matched prefix really contains the
   // ip_address.
-  const auto& prefix = ip_prefixes_[address];
-  if (prefix.contains(ip_address)) {
-    return std::vector<T>(prefix.data_.begin(), prefix.data_.end());
+  const Leaf& leaf = leaves_[address];
+  if (leaf.contains(ip_address)) {
+    return {data_.get() + leaf.data_begin_, leaf.data_size_};
   }
-  return std::vector<T>();
+  return {};
 }
 
 } // namespace LcTrie
@@ -83,6 +83,20 @@ bool MultiConnectionBaseImpl::initializeReadFilters() {
   return true;
 }
 
+uint32_t MultiConnectionBaseImpl::numReadFilters() const {
+  if (connect_finished_) {
+    return connections_[0]->numReadFilters();
+  }
+  return post_connect_state_.read_filters_.size() + post_connect_state_.filters_.size();
+}
+
+uint32_t MultiConnectionBaseImpl::numWriteFilters() const {
+  if (connect_finished_) {
+    return connections_[0]->numWriteFilters();
+  }
+  return post_connect_state_.write_filters_.size() + post_connect_state_.filters_.size();
+}
+
 void MultiConnectionBaseImpl::addBytesSentCallback(Connection::BytesSentCb cb) {
   if (connect_finished_) {
     connections_[0]->addBytesSentCallback(cb);
@@ -174,6 +188,10 @@ Ssl::ConnectionInfoConstSharedPtr MultiConnectionBaseImpl::ssl() const {
   return connections_[0]->ssl();
 }
 
+bool MultiConnectionBaseImpl::forwardsPayloadUnchanged() const {
+  return connections_[0]->forwardsPayloadUnchanged();
+}
+
 Connection::State MultiConnectionBaseImpl::state() const {
   if (!connect_finished_) {
     ASSERT(connections_[0]->state() == Connection::State::Open);
@@ -81,6 +81,8 @@ public:
   void addReadFilter(ReadFilterSharedPtr filter) override;
   void removeReadFilter(ReadFilterSharedPtr filter) override;
   bool initializeReadFilters() override;
+  uint32_t numReadFilters() const override;
+  uint32_t numWriteFilters() const override;
   void addBytesSentCallback(BytesSentCb cb) override;
   void write(Buffer::Instance& data, bool end_stream) override;
   void addConnectionCallbacks(ConnectionCallbacks& cb) override;
@@ -112,6 +114,7 @@ public:
   absl::optional<UnixDomainSocketPeerCredentials> unixSocketPeerCredentials() const override;
   // Note, this might change before connect finishes.
   Ssl::ConnectionInfoConstSharedPtr ssl() const override;
+  bool forwardsPayloadUnchanged() const override;
   State state() const override;
   bool connecting() const override;
   uint32_t bufferLimit() const override;
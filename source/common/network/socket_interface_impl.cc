@@ -9,6 +9,11 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/win32_socket_handle_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#if defined(__linux__)
+#include "source/common/network/io_uring_socket_handle_impl.h"
+#endif
 
 namespace Envoy {
 namespace Network {
@@ -26,6 +31,26 @@ IoHandlePtr SocketInterfaceImpl::makeSocket(int socket_fd, bool socket_v6only,
   return makePlatformSpecificSocket(socket_fd, socket_v6only, domain);
 }
 
+IoHandlePtr SocketInterfaceImpl::makeSocketOfType(int socket_fd, bool socket_v6only,
+                                                  absl::optional<int> domain,
+                                                  Socket::Type socket_type,
+                                                  Address::Type addr_type) const {
+#if defined(__linux__)
+  if (socket_type == Socket::Type::Stream && addr_type == Address::Type::Ip) {
+    std::shared_ptr<Io::IoUringWorkerFactoryImpl> io_uring_worker_factory =
+        io_uring_worker_factory_.lock();
+    if (io_uring_worker_factory != nullptr) {
+      return std::make_unique<IoUringSocketHandleImpl>(
+          *io_uring_worker_factory, io_uring_read_buffer_size_, socket_fd, socket_v6only, domain);
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(socket_type);
+  UNREFERENCED_PARAMETER(addr_type);
+#endif
+  return makeSocket(socket_fd, socket_v6only, domain);
+}
+
 IoHandlePtr SocketInterfaceImpl::socket(Socket::Type socket_type, Address::Type addr_type,
                                         Address::IpVersion version, bool socket_v6only,
                                         const SocketCreationOptions& options) const {
@@ -70,7 +95,8 @@ IoHandlePtr SocketInterfaceImpl::socket(Socket::Type socket_type, Address::Type
       Api::OsSysCallsSingleton::get().socket(domain, flags, protocol);
   RELEASE_ASSERT(SOCKET_VALID(result.return_value_),
                  fmt::format("socket(2) failed, got error: {}", errorDetails(result.errno_)));
-  IoHandlePtr io_handle = makeSocket(result.return_value_, socket_v6only, domain);
+  IoHandlePtr io_handle =
+      makeSocketOfType(result.return_value_, socket_v6only, domain, socket_type, addr_type);
 
 #if defined(__APPLE__) || defined(WIN32)
   // Cannot set SOCK_NONBLOCK as a ::socket flag.
@@ -115,9 +141,49 @@ bool SocketInterfaceImpl::ipFamilySupported(int domain) {
   return SOCKET_VALID(result.return_value_);
 }
 
-Server::BootstrapExtensionPtr
-SocketInterfaceImpl::createBootstrapExtension(const Protobuf::Message&,
-                                              Server::Configuration::ServerFactoryContext&) {
+namespace {
+
+#if defined(__linux__)
+class IoUringSocketInterfaceExtension : public SocketInterfaceExtension {
+public:
+  IoUringSocketInterfaceExtension(SocketInterface& sock_interface,
+                                  std::shared_ptr<Io::IoUringWorkerFactoryImpl> factory)
+      : SocketInterfaceExtension(sock_interface), factory_(std::move(factory)) {}
+
+  // Server::BootstrapExtension
+  void onServerInitialized() override { factory_->onServerInitialized(); }
+
+private:
+  std::shared_ptr<Io::IoUringWorkerFactoryImpl> factory_;
+};
+#endif
+
+} // namespace
+
+Server::BootstrapExtensionPtr SocketInterfaceImpl::createBootstrapExtension(
+    const Protobuf::Message& message, Server::Configuration::ServerFactoryContext& context) {
+#if defined(__linux__)
+  const auto& config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::network::socket_interface::v3::DefaultSocketInterface&>(
+      message, context.messageValidationVisitor());
+  if (config.has_io_uring_options()) {
+    if (!Io::isIoUringSupported()) {
+      ENVOY_LOG_MISC(warn, "io_uring is not supported by this kernel, using system calls.");
+    } else {
+      const auto& options = config.io_uring_options();
+      io_uring_read_buffer_size_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, read_buffer_size, 8192);
+      auto io_uring_worker_factory = std::make_shared<Io::IoUringWorkerFactoryImpl>(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, io_uring_size, 300),
+          options.enable_submission_queue_polling(), context.threadLocal());
+      io_uring_worker_factory_ = io_uring_worker_factory;
+      return std::make_unique<IoUringSocketInterfaceExtension>(*this,
+                                                               std::move(io_uring_worker_factory));
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(message);
+  UNREFERENCED_PARAMETER(context);
+#endif
   return std::make_unique<SocketInterfaceExtension>(*this);
 }
 
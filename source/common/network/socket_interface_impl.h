@@ -4,6 +4,10 @@
 
 #include "source/common/network/socket_interface.h"
 
+#if defined(__linux__)
+#include "source/common/io/io_uring_worker_impl.h"
+#endif
+
 namespace Envoy {
 namespace Network {
 
@@ -32,6 +36,18 @@ public:
 protected:
   virtual IoHandlePtr makeSocket(int socket_fd, bool socket_v6only,
                                  absl::optional<int> domain) const;
+
+private:
+  // Creates the handle for a new socket, using io_uring for TCP sockets if it is configured.
+  IoHandlePtr makeSocketOfType(int socket_fd, bool socket_v6only, absl::optional<int> domain,
+                               Socket::Type socket_type, Address::Type addr_type) const;
+
+#if defined(__linux__)
+  // Owned by the bootstrap extension, as the thread local slot of the factory must not outlive the
+  // server, while this factory is a process wide singleton.
+  std::weak_ptr<Io::IoUringWorkerFactoryImpl> io_uring_worker_factory_;
+  uint32_t io_uring_read_buffer_size_{};
+#endif
 };
 
 DECLARE_FACTORY(SocketInterfaceImpl);
@@ -142,6 +142,17 @@ std::unique_ptr<Socket::Options> SocketOptionFactory::buildReusePortOptions() {
   return options;
 }
 
+std::unique_ptr<Socket::Options> SocketOptionFactory::buildIncomingCpuOptions(uint32_t cpu) {
+  std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
+#ifdef SO_INCOMING_CPU
+  options->push_back(std::make_shared<Network::SocketOptionImpl>(
+      envoy::config::core::v3::SocketOption::STATE_PREBIND, ENVOY_SOCKET_SO_INCOMING_CPU, cpu));
+#else
+  UNREFERENCED_PARAMETER(cpu);
+#endif
+  return options;
+}
+
 std::unique_ptr<Socket::Options> SocketOptionFactory::buildUdpGroOptions() {
   std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
   options->push_back(std::make_shared<SocketOptionImpl>(
@@ -59,6 +59,12 @@ namespace Network {
 #define ENVOY_SOCKET_SO_REUSEPORT Network::SocketOptionName()
 #endif
 
+#ifdef SO_INCOMING_CPU
+#define ENVOY_SOCKET_SO_INCOMING_CPU ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_SOCKET, SO_INCOMING_CPU)
+#else
+#define ENVOY_SOCKET_SO_INCOMING_CPU Network::SocketOptionName()
+#endif
+
 #ifdef SO_ORIGINAL_DST
 #define ENVOY_SOCKET_SO_ORIGINAL_DST ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_IP, SO_ORIGINAL_DST)
 #else
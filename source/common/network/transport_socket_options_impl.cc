@@ -15,36 +15,78 @@
 #include "source/common/network/proxy_protocol_filter_state.h"
 #include "source/common/network/upstream_server_name.h"
 #include "source/common/network/upstream_subject_alt_names.h"
+#include "source/common/stream_info/filter_state_impl.h"
 
 namespace Envoy {
 namespace Network {
+namespace {
+
+// The filter state is looked up for these on every upstream connection, mostly without finding
+// them, so the lookups go by slot.
+const StreamInfo::FilterState::Slot UpstreamServerNameSlot =
+    StreamInfo::FilterStateImpl::registerSlot(UpstreamServerName::key());
+const StreamInfo::FilterState::Slot ApplicationProtocolsSlot =
+    StreamInfo::FilterStateImpl::registerSlot(ApplicationProtocols::key());
+const StreamInfo::FilterState::Slot UpstreamSubjectAltNamesSlot =
+    StreamInfo::FilterStateImpl::registerSlot(UpstreamSubjectAltNames::key());
+const StreamInfo::FilterState::Slot ProxyProtocolFilterStateSlot =
+    StreamInfo::FilterStateImpl::registerSlot(ProxyProtocolFilterState::key());
+const StreamInfo::FilterState::Slot Http11ProxyInfoFilterStateSlot =
+    StreamInfo::FilterStateImpl::registerSlot(Http11ProxyInfoFilterState::key());
+
+} // namespace
+
+TransportSocketOptionsImpl::TransportSocketOptionsImpl(
+    absl::string_view override_server_name, std::vector<std::string>&& override_verify_san_list,
+    std::vector<std::string>&& override_alpn, std::vector<std::string>&& fallback_alpn,
+    absl::optional<Network::ProxyProtocolData> proxy_proto_options,
+    StreamInfo::FilterState::ObjectsPtr filter_state_objects,
+    std::unique_ptr<const Http11ProxyInfo>&& proxy_info)
+    : override_server_name_(override_server_name.empty()
+                                ? absl::nullopt
+                                : absl::optional<std::string>(override_server_name)),
+      override_verify_san_list_{std::move(override_verify_san_list)},
+      override_alpn_list_{std::move(override_alpn)}, alpn_fallback_{std::move(fallback_alpn)},
+      proxy_protocol_options_(proxy_proto_options),
+      filter_state_objects_(std::move(filter_state_objects)), proxy_info_(std::move(proxy_info)) {
+  CommonUpstreamTransportSocketFactory::computeHashKey(hash_key_, *this);
+}
 
 void CommonUpstreamTransportSocketFactory::hashKey(
     std::vector<uint8_t>& key, TransportSocketOptionsConstSharedPtr options) const {
   if (!options) {
     return;
   }
-  const auto& server_name_overide = options->serverNameOverride();
+  if (const auto precomputed = options->precomputedHashKey(); precomputed.has_value()) {
+    key.insert(key.end(), precomputed->begin(), precomputed->end());
+    return;
+  }
+  computeHashKey(key, *options);
+}
+
+void CommonUpstreamTransportSocketFactory::computeHashKey(std::vector<uint8_t>& key,
+                                                          const TransportSocketOptions& options) {
+  const auto& server_name_overide = options.serverNameOverride();
   if (server_name_overide.has_value()) {
     pushScalarToByteVector(StringUtil::CaseInsensitiveHash()(server_name_overide.value()), key);
   }
 
-  const auto& verify_san_list = options->verifySubjectAltNameListOverride();
+  const auto& verify_san_list = options.verifySubjectAltNameListOverride();
   for (const auto& san : verify_san_list) {
     pushScalarToByteVector(StringUtil::CaseInsensitiveHash()(san), key);
   }
 
-  const auto& alpn_list = options->applicationProtocolListOverride();
+  const auto& alpn_list = options.applicationProtocolListOverride();
   for (const auto& protocol : alpn_list) {
     pushScalarToByteVector(StringUtil::CaseInsensitiveHash()(protocol), key);
   }
 
-  const auto& alpn_fallback = options->applicationProtocolFallback();
+  const auto& alpn_fallback = options.applicationProtocolFallback();
   for (const auto& protocol : alpn_fallback) {
     pushScalarToByteVector(StringUtil::CaseInsensitiveHash()(protocol), key);
   }
 
-  for (const auto& object : options->downstreamSharedFilterStateObjects()) {
+  for (const auto& object : options.downstreamSharedFilterStateObjects()) {
     if (auto hashable = dynamic_cast<const Hashable*>(object.data_.get()); hashable != nullptr) {
       if (auto hash = hashable->hash(); hash) {
         pushScalarToByteVector(hash.value(), key);
@@ -63,35 +105,35 @@ TransportSocketOptionsUtility::fromFilterState(const StreamInfo::FilterState& fi
   std::unique_ptr<const TransportSocketOptions::Http11ProxyInfo> proxy_info;
 
   bool needs_transport_socket_options = false;
-  if (auto typed_data = filter_state.getDataReadOnly<UpstreamServerName>(UpstreamServerName::key());
+  if (auto typed_data = filter_state.getDataReadOnly<UpstreamServerName>(UpstreamServerNameSlot);
       typed_data != nullptr) {
     server_name = typed_data->value();
     needs_transport_socket_options = true;
   }
 
-  if (auto typed_data = filter_state.getDataReadOnly<Network::ApplicationProtocols>(
-          Network::ApplicationProtocols::key());
+  if (auto typed_data =
+          filter_state.getDataReadOnly<Network::ApplicationProtocols>(ApplicationProtocolsSlot);
       typed_data != nullptr) {
     application_protocols = typed_data->value();
     needs_transport_socket_options = true;
   }
 
   if (auto typed_data =
-          filter_state.getDataReadOnly<UpstreamSubjectAltNames>(UpstreamSubjectAltNames::key());
+          filter_state.getDataReadOnly<UpstreamSubjectAltNames>(UpstreamSubjectAltNamesSlot);
       typed_data != nullptr) {
     subject_alt_names = typed_data->value();
     needs_transport_socket_options = true;
   }
 
   if (auto typed_data =
-          filter_state.getDataReadOnly<ProxyProtocolFilterState>(ProxyProtocolFilterState::key());
+          filter_state.getDataReadOnly<ProxyProtocolFilterState>(ProxyProtocolFilterStateSlot);
       typed_data != nullptr) {
     proxy_protocol_options.emplace(typed_data->value());
     needs_transport_socket_options = true;
   }
 
-  if (auto typed_data = filter_state.getDataReadOnly<Http11ProxyInfoFilterState>(
-          Http11ProxyInfoFilterState::key());
+  if (auto typed_data =
+          filter_state.getDataReadOnly<Http11ProxyInfoFilterState>(Http11ProxyInfoFilterStateSlot);
       typed_data != nullptr) {
     proxy_info = std::make_unique<TransportSocketOptions::Http11ProxyInfo>(typed_data->hostname(),
                                                                            typed_data->address());
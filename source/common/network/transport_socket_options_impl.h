@@ -51,15 +51,7 @@ public:
       absl::optional<Network::ProxyProtocolData> proxy_proto_options = absl::nullopt,
       StreamInfo::FilterState::ObjectsPtr filter_state_objects =
           std::make_unique<StreamInfo::FilterState::Objects>(),
-      std::unique_ptr<const Http11ProxyInfo>&& proxy_info = nullptr)
-      : override_server_name_(override_server_name.empty()
-                                  ? absl::nullopt
-                                  : absl::optional<std::string>(override_server_name)),
-        override_verify_san_list_{std::move(override_verify_san_list)},
-        override_alpn_list_{std::move(override_alpn)}, alpn_fallback_{std::move(fallback_alpn)},
-        proxy_protocol_options_(proxy_proto_options),
-        filter_state_objects_(std::move(filter_state_objects)), proxy_info_(std::move(proxy_info)) {
-  }
+      std::unique_ptr<const Http11ProxyInfo>&& proxy_info = nullptr);
 
   // Network::TransportSocketOptions
   const absl::optional<std::string>& serverNameOverride() const override {
@@ -86,6 +78,7 @@ public:
   const StreamInfo::FilterState::Objects& downstreamSharedFilterStateObjects() const override {
     return *filter_state_objects_;
   }
+  OptRef<const std::vector<uint8_t>> precomputedHashKey() const override { return {hash_key_}; }
 
 private:
   const absl::optional<std::string> override_server_name_;
@@ -96,6 +89,8 @@ private:
   const StreamInfo::FilterState::ObjectsPtr filter_state_objects_;
   const StreamInfo::FilterStateSharedPtr filter_state_;
   std::unique_ptr<const Http11ProxyInfo> proxy_info_;
+  // The options are immutable, so their hash key is computed once at construction.
+  std::vector<uint8_t> hash_key_;
 };
 
 class TransportSocketOptionsUtility {
@@ -113,10 +108,16 @@ public:
 class CommonUpstreamTransportSocketFactory : public UpstreamTransportSocketFactory {
 public:
   /**
-   * Compute the generic hash key from the transport socket options.
+   * Compute the generic hash key from the transport socket options, reusing the precomputed key
+   * of the options if they have one.
    */
   void hashKey(std::vector<uint8_t>& key,
                TransportSocketOptionsConstSharedPtr options) const override;
+
+  /**
+   * Compute the generic hash key from the transport socket options, ignoring any precomputed key.
+   */
+  static void computeHashKey(std::vector<uint8_t>& key, const TransportSocketOptions& options);
 };
 
 } // namespace Network
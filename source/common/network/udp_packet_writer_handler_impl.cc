@@ -1,6 +1,12 @@
 #include "source/common/network/udp_packet_writer_handler_impl.h"
 
+#include <cstring>
+
+#include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+#include "source/common/network/address_impl.h"
 #include "source/common/network/utility.h"
 
 namespace Envoy {
@@ -24,5 +30,206 @@ Api::IoCallUint64Result UdpDefaultWriter::writePacket(const Buffer::Instance& bu
   return result;
 }
 
+Network::UdpPacketWriterPtr
+UdpDefaultWriterFactory::createUdpPacketWriter(Network::IoHandle& io_handle, Stats::Scope& scope) {
+  if (max_batched_datagrams_ > 0) {
+    return std::make_unique<UdpBatchWriter>(io_handle, max_batched_datagrams_, scope);
+  }
+  return std::make_unique<UdpDefaultWriter>(io_handle);
+}
+
+namespace {
+
+// Large enough for the packet info of both IP versions.
+constexpr size_t ControlSpace = CMSG_SPACE(sizeof(in6_pktinfo));
+
+} // namespace
+
+UdpDatagramBatch::UdpDatagramBatch(IoHandle& io_handle, uint32_t max_datagrams)
+    : io_handle_(io_handle), max_datagrams_(max_datagrams) {
+  ASSERT(max_datagrams_ > 0);
+  datagrams_.resize(max_datagrams_);
+  messages_.resize(max_datagrams_);
+  iovecs_.resize(max_datagrams_);
+  control_.resize(max_datagrams_ * ControlSpace);
+}
+
+bool UdpDatagramBatch::add(const Buffer::Instance& buffer, const Address::Ip* local_ip,
+                           const Address::Instance& peer_address) {
+  ASSERT(!full());
+  const auto* address_base = dynamic_cast<const Address::InstanceBase*>(&peer_address);
+  if (address_base == nullptr || address_base->sockAddr() == nullptr) {
+    return false;
+  }
+  Datagram& datagram = datagrams_[size_];
+  datagram.payload_.resize(buffer.length());
+  buffer.copyOut(0, buffer.length(), datagram.payload_.data());
+  memcpy(&datagram.peer_address_, address_base->sockAddr(), // NOLINT(safe-memcpy)
+         address_base->sockAddrLen());
+  datagram.peer_address_length_ = address_base->sockAddrLen();
+  if (local_ip == nullptr) {
+    datagram.local_ip_version_.reset();
+  } else if (local_ip->version() == Address::IpVersion::v4) {
+    datagram.local_ip_version_ = Address::IpVersion::v4;
+    datagram.local_ipv4_ = local_ip->ipv4()->address();
+  } else {
+    datagram.local_ip_version_ = Address::IpVersion::v6;
+    datagram.local_ipv6_ = local_ip->ipv6()->address();
+  }
+  ++size_;
+  return true;
+}
+
+void UdpDatagramBatch::fillMessage(Datagram& datagram, mmsghdr& message, iovec& iov,
+                                   char* control) {
+  iov.iov_base = datagram.payload_.data();
+  iov.iov_len = datagram.payload_.size();
+  msghdr& header = message.msg_hdr;
+  header.msg_name = &datagram.peer_address_;
+  header.msg_namelen = datagram.peer_address_length_;
+  header.msg_iov = &iov;
+  header.msg_iovlen = 1;
+  header.msg_flags = 0;
+  message.msg_len = 0;
+  if (!datagram.local_ip_version_.has_value()) {
+    header.msg_control = nullptr;
+    header.msg_controllen = 0;
+    return;
+  }
+  // The batches are only used where sendmmsg() is supported, i.e. by the platforms with the same
+  // packet info as Linux.
+#if ENVOY_MMSG_MORE
+  memset(control, 0, ControlSpace);
+  header.msg_control = control;
+  cmsghdr* cmsg;
+  if (datagram.local_ip_version_.value() == Address::IpVersion::v4) {
+    header.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
+    cmsg = CMSG_FIRSTHDR(&header);
+    cmsg->cmsg_level = IPPROTO_IP;
+    cmsg->cmsg_type = IP_PKTINFO;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+    auto* pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
+    pktinfo->ipi_spec_dst.s_addr = datagram.local_ipv4_;
+  } else {
+    header.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
+    cmsg = CMSG_FIRSTHDR(&header);
+    cmsg->cmsg_level = IPPROTO_IPV6;
+    cmsg->cmsg_type = IPV6_PKTINFO;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+    auto* pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+    *(reinterpret_cast<absl::uint128*>(pktinfo->ipi6_addr.s6_addr)) = datagram.local_ipv6_;
+  }
+#else
+  UNREFERENCED_PARAMETER(control);
+  PANIC("not reached");
+#endif
+}
+
+UdpDatagramBatch::FlushResult UdpDatagramBatch::flush(const DatagramCb& cb) {
+  FlushResult result;
+  for (size_t i = 0; i < size_; i++) {
+    fillMessage(datagrams_[i], messages_[i], iovecs_[i], &control_[i * ControlSpace]);
+  }
+
+  const auto complete = [&](size_t index, bool sent) {
+    const uint64_t length = datagrams_[index].payload_.size();
+    if (sent) {
+      ++result.datagrams_sent_;
+      result.bytes_sent_ += length;
+    }
+    if (cb != nullptr) {
+      cb(index, length, sent);
+    }
+  };
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  size_t next = 0;
+  while (next < size_) {
+    const Api::SysCallIntResult rc =
+        os_sys_calls.sendmmsg(io_handle_.fdDoNotUse(), &messages_[next], size_ - next, 0);
+    ++result.syscalls_;
+    if (rc.return_value_ > 0) {
+      for (int i = 0; i < rc.return_value_; i++) {
+        complete(next++, true);
+      }
+      continue;
+    }
+    if (rc.errno_ == SOCKET_ERROR_INTR) {
+      continue;
+    }
+    result.errno_ = rc.errno_;
+    if (rc.errno_ == SOCKET_ERROR_AGAIN) {
+      while (next < size_) {
+        complete(next++, false);
+      }
+      break;
+    }
+    // The first datagram failed, e.g. because it is too large for the socket: drops it and sends
+    // the next ones.
+    ENVOY_LOG_MISC(debug, "sendmmsg failed with error {}", rc.errno_);
+    complete(next++, false);
+  }
+  size_ = 0;
+  return result;
+}
+
+UdpBatchWriter::UdpBatchWriter(Network::IoHandle& io_handle, uint32_t max_batched_datagrams,
+                               Stats::Scope& scope)
+    : io_handle_(io_handle), stats_(generateStats(scope)) {
+  if (io_handle_.supportsMmsg()) {
+    batch_.emplace(io_handle_, max_batched_datagrams);
+  }
+}
+
+Api::IoCallUint64Result UdpBatchWriter::writePacket(const Buffer::Instance& buffer,
+                                                    const Address::Ip* local_ip,
+                                                    const Address::Instance& peer_address) {
+  if (write_blocked_) {
+    return {0, Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                               IoSocketError::deleteIoError)};
+  }
+  if (!batch_.has_value()) {
+    Api::IoCallUint64Result result =
+        Utility::writeToSocket(io_handle_, buffer, local_ip, peer_address);
+    stats_.send_syscalls_.inc();
+    if (result.ok()) {
+      stats_.datagrams_sent_.inc();
+    } else {
+      stats_.datagrams_dropped_.inc();
+      write_blocked_ = result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again;
+    }
+    return result;
+  }
+  if (!batch_->add(buffer, local_ip, peer_address)) {
+    stats_.datagrams_dropped_.inc();
+    return IoSocketError::ioResultSocketInvalidAddress();
+  }
+  const uint64_t length = buffer.length();
+  if (batch_->full()) {
+    // The datagram is queued whatever the result of the flush.
+    flush();
+  }
+  return {length, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+}
+
+Api::IoCallUint64Result UdpBatchWriter::flush() {
+  if (!batch_.has_value() || batch_->empty()) {
+    return {0, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+  }
+  const size_t size = batch_->size();
+  const UdpDatagramBatch::FlushResult result = batch_->flush(nullptr);
+  stats_.send_syscalls_.add(result.syscalls_);
+  stats_.datagrams_sent_.add(result.datagrams_sent_);
+  stats_.datagrams_dropped_.add(size - result.datagrams_sent_);
+  if (result.errno_ == SOCKET_ERROR_AGAIN) {
+    write_blocked_ = true;
+    return {0, Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                               IoSocketError::deleteIoError)};
+  }
+  if (result.errno_ != 0) {
+    return {0, Api::IoErrorPtr(new IoSocketError(result.errno_), IoSocketError::deleteIoError)};
+  }
+  return {result.bytes_sent_, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+}
+
 } // namespace Network
 } // namespace Envoy
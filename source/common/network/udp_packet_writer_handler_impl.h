@@ -1,11 +1,19 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "envoy/buffer/buffer.h"
 #include "envoy/network/socket.h"
 #include "envoy/network/udp_packet_writer_handler.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/network/io_socket_error_impl.h"
 
+#include "absl/numeric/int128.h"
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -42,10 +50,141 @@ private:
 
 class UdpDefaultWriterFactory : public Network::UdpPacketWriterFactory {
 public:
+  UdpDefaultWriterFactory() = default;
+  /**
+   * @param max_batched_datagrams supplies the size of the batches of the writers created, @see
+   * UdpBatchWriter, or 0 for the writers to send each datagram at once.
+   */
+  explicit UdpDefaultWriterFactory(uint32_t max_batched_datagrams)
+      : max_batched_datagrams_(max_batched_datagrams) {}
+
   Network::UdpPacketWriterPtr createUdpPacketWriter(Network::IoHandle& io_handle,
-                                                    Stats::Scope&) override {
-    return std::make_unique<UdpDefaultWriter>(io_handle);
+                                                    Stats::Scope& scope) override;
+
+private:
+  const uint32_t max_batched_datagrams_{0};
+};
+
+/**
+ * Datagrams queued to be sent through a UDP socket with as few sendmmsg() calls as possible,
+ * instead of a sendmsg() call per datagram. The datagrams are copied when they are queued, so that
+ * the callers don't have to keep them. Only usable for the IO handles supporting sendmmsg(), @see
+ * IoHandle::supportsMmsg().
+ */
+class UdpDatagramBatch {
+public:
+  /**
+   * Called for each datagram of the batch once it is flushed.
+   * @param index supplies the position of the datagram in the batch.
+   * @param length supplies the length of the datagram.
+   * @param sent supplies whether the datagram was sent, or else dropped.
+   */
+  using DatagramCb = std::function<void(size_t index, uint64_t length, bool sent)>;
+
+  struct FlushResult {
+    uint64_t syscalls_{0};
+    uint64_t datagrams_sent_{0};
+    uint64_t bytes_sent_{0};
+    // The error of the last datagram which couldn't be sent, if any.
+    int errno_{0};
+  };
+
+  UdpDatagramBatch(IoHandle& io_handle, uint32_t max_datagrams);
+
+  /**
+   * Queues a datagram.
+   * @param buffer supplies the payload of the datagram, which is copied.
+   * @param local_ip supplies the IP to send the datagram from, or nullptr to let the OS select it.
+   * @param peer_address supplies the address to send the datagram to.
+   * @return false if the datagram can't be sent to the peer address, in which case it is dropped.
+   */
+  bool add(const Buffer::Instance& buffer, const Address::Ip* local_ip,
+           const Address::Instance& peer_address);
+
+  /**
+   * Sends the queued datagrams and empties the batch. The datagrams which can't be sent are
+   * dropped, and so are all of those remaining once the socket would block.
+   * @param cb supplies the callback called for each datagram, or nullptr.
+   */
+  FlushResult flush(const DatagramCb& cb);
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ >= max_datagrams_; }
+
+private:
+  struct Datagram {
+    std::vector<uint8_t> payload_;
+    sockaddr_storage peer_address_;
+    socklen_t peer_address_length_;
+    absl::optional<Address::IpVersion> local_ip_version_;
+    uint32_t local_ipv4_;
+    absl::uint128 local_ipv6_;
+  };
+
+  void fillMessage(Datagram& datagram, mmsghdr& message, iovec& iov, char* control);
+
+  IoHandle& io_handle_;
+  const uint32_t max_datagrams_;
+  // The datagrams are kept once flushed so that their payloads reuse their memory.
+  std::vector<Datagram> datagrams_;
+  size_t size_{0};
+  std::vector<mmsghdr> messages_;
+  std::vector<iovec> iovecs_;
+  std::vector<char> control_;
+};
+
+/**
+ * All UDP batch writer stats. @see stats_macros.h
+ */
+#define ALL_UDP_BATCH_WRITER_STATS(COUNTER)                                                        \
+  COUNTER(datagrams_dropped)                                                                       \
+  COUNTER(datagrams_sent)                                                                          \
+  COUNTER(send_syscalls)
+
+/**
+ * Struct definition for all UDP batch writer stats. @see stats_macros.h
+ */
+struct UdpBatchWriterStats {
+  ALL_UDP_BATCH_WRITER_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * A writer queuing the datagrams in a UdpDatagramBatch until it is flushed or full. The datagrams
+ * are thus only sent once the users of the writer flush it, e.g. once per event loop iteration,
+ * and their results are those of their queuing. The writer sends each datagram at once when the IO
+ * handle doesn't support sendmmsg().
+ */
+class UdpBatchWriter : public UdpPacketWriter {
+public:
+  UdpBatchWriter(Network::IoHandle& io_handle, uint32_t max_batched_datagrams,
+                 Stats::Scope& scope);
+
+  // Network::UdpPacketWriter
+  Api::IoCallUint64Result writePacket(const Buffer::Instance& buffer, const Address::Ip* local_ip,
+                                      const Address::Instance& peer_address) override;
+  bool isWriteBlocked() const override { return write_blocked_; }
+  void setWritable() override { write_blocked_ = false; }
+  uint64_t getMaxPacketSize(const Address::Instance& /*peer_address*/) const override {
+    return Network::UdpMaxOutgoingPacketSize;
   }
+  bool isBatchMode() const override { return batch_.has_value(); }
+  Network::UdpPacketWriterBuffer
+  getNextWriteLocation(const Address::Ip* /*local_ip*/,
+                       const Address::Instance& /*peer_address*/) override {
+    return {nullptr, 0, nullptr};
+  }
+  Api::IoCallUint64Result flush() override;
+
+private:
+  static UdpBatchWriterStats generateStats(Stats::Scope& scope) {
+    return {ALL_UDP_BATCH_WRITER_STATS(POOL_COUNTER_PREFIX(scope, "udp_batch_writer."))};
+  }
+
+  Network::IoHandle& io_handle_;
+  UdpBatchWriterStats stats_;
+  absl::optional<UdpDatagramBatch> batch_;
+  bool write_blocked_{false};
 };
 
 } // namespace Network
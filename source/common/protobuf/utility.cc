@@ -50,8 +50,9 @@ void blockFormat(YAML::Node node) {
   }
 }
 
-ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
-  ProtobufWkt::Value value;
+// Parses the node into value in place, rather than returning the nested values, which would copy
+// every subtree once per level of nesting.
+void parseYamlNode(const YAML::Node& node, ProtobufWkt::Value& value) {
   switch (node.Type()) {
   case YAML::NodeType::Null:
     value.set_null_value(ProtobufWkt::NULL_VALUE);
@@ -88,7 +89,7 @@ ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
   case YAML::NodeType::Sequence: {
     auto& list_values = *value.mutable_list_value()->mutable_values();
     for (const auto& it : node) {
-      *list_values.Add() = parseYamlNode(it);
+      parseYamlNode(it, *list_values.Add());
     }
     break;
   }
@@ -96,7 +97,10 @@ ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
     auto& struct_fields = *value.mutable_struct_value()->mutable_fields();
     for (const auto& it : node) {
       if (it.first.Tag() != "!ignore") {
-        struct_fields[it.first.as<std::string>()] = parseYamlNode(it.second);
+        ProtobufWkt::Value& field = struct_fields[it.first.as<std::string>()];
+        // Duplicate keys override the previous values.
+        field.Clear();
+        parseYamlNode(it.second, field);
       }
     }
     break;
@@ -104,7 +108,6 @@ ProtobufWkt::Value parseYamlNode(const YAML::Node& node) {
   case YAML::NodeType::Undefined:
     throw EnvoyException("Undefined YAML value");
   }
-  return value;
 }
 
 void jsonConvertInternal(const Protobuf::Message& source,
@@ -295,7 +298,11 @@ void MessageUtil::loadFromJson(const std::string& json, ProtobufWkt::Struct& mes
 
 void MessageUtil::loadFromYaml(const std::string& yaml, Protobuf::Message& message,
                                ProtobufMessage::ValidationVisitor& validation_visitor) {
-  ProtobufWkt::Value value = ValueUtil::loadFromYaml(yaml);
+  // The value is discarded once converted, so it's allocated on an arena along with all its nested
+  // values, which are then freed at once.
+  Protobuf::Arena arena;
+  ProtobufWkt::Value& value = *Protobuf::Arena::CreateMessage<ProtobufWkt::Value>(&arena);
+  ValueUtil::loadFromYaml(yaml, value);
   if (value.kind_case() == ProtobufWkt::Value::kStructValue ||
       value.kind_case() == ProtobufWkt::Value::kListValue) {
     jsonConvertInternal(value, validation_visitor, message);
@@ -451,6 +458,10 @@ public:
     }
   }
 
+  // Only the deprecated and work-in-progress fields, and the deprecated values of the singular
+  // enum fields, are checked.
+  bool annotatedFieldsOnly() const override { return true; }
+
 private:
   ProtobufMessage::ValidationVisitor& validation_visitor_;
   Runtime::Loader* runtime_;
@@ -484,6 +495,7 @@ public:
   }
 
   void onField(const Protobuf::Message&, const Protobuf::FieldDescriptor&) override {}
+  bool annotatedFieldsOnly() const override { return true; }
 };
 
 } // namespace
@@ -800,7 +812,16 @@ void MessageUtil::wireCast(const Protobuf::Message& src, Protobuf::Message& dst)
 }
 
 ProtobufWkt::Value ValueUtil::loadFromYaml(const std::string& yaml) {
-  TRY_ASSERT_MAIN_THREAD { return parseYamlNode(YAML::Load(yaml)); }
+  ProtobufWkt::Value value;
+  loadFromYaml(yaml, value);
+  return value;
+}
+
+void ValueUtil::loadFromYaml(const std::string& yaml, ProtobufWkt::Value& value) {
+  TRY_ASSERT_MAIN_THREAD {
+    value.Clear();
+    parseYamlNode(YAML::Load(yaml), value);
+  }
   END_TRY
   catch (YAML::ParserException& e) {
     throw EnvoyException(e.what());
@@ -586,6 +586,11 @@ public:
    */
   static ProtobufWkt::Value loadFromYaml(const std::string& yaml);
 
+  /**
+   * Load YAML string into a ProtobufWkt::Value, which may be allocated on an arena.
+   */
+  static void loadFromYaml(const std::string& yaml, ProtobufWkt::Value& value);
+
   /**
    * Compare two ProtobufWkt::Values for equality.
    * @param v1 message of type type.googleapis.com/google.protobuf.Value
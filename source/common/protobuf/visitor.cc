@@ -2,10 +2,14 @@
 
 #include <vector>
 
+#include "source/common/common/macros.h"
 #include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "udpa/type/v1/typed_struct.pb.h"
+#include "xds/annotations/v3/status.pb.h"
 #include "xds/type/v3/typed_struct.pb.h"
 
 namespace Envoy {
@@ -39,6 +43,79 @@ convertTypedStruct(const Protobuf::Message& message) {
   return {std::move(inner_message), target_type_url};
 }
 
+/**
+ * The fields of a message type the traversal looks at, when the visitor only looks at the annotated
+ * fields. Computed once per message type, since the reflection over all the fields of all the
+ * messages is otherwise most of the cost of validating a config.
+ */
+struct TraversalPlan {
+  struct Field {
+    const Protobuf::FieldDescriptor* descriptor_;
+    // Whether onField() is invoked for the field.
+    bool annotated_;
+  };
+
+  // The annotated and the message fields, in the order of the descriptor.
+  std::vector<Field> fields_;
+};
+
+bool isAnnotatedField(const Protobuf::FieldDescriptor& field) {
+  if (field.options().deprecated() ||
+      field.options().GetExtension(xds::annotations::v3::field_status).work_in_progress()) {
+    return true;
+  }
+  if (field.is_repeated() || field.cpp_type() != Protobuf::FieldDescriptor::CPPTYPE_ENUM) {
+    return false;
+  }
+  const Protobuf::EnumDescriptor* enum_type = field.enum_type();
+  for (int i = 0; i < enum_type->value_count(); ++i) {
+    if (enum_type->value(i)->options().deprecated()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::unique_ptr<TraversalPlan> createTraversalPlan(const Protobuf::Descriptor& descriptor) {
+  auto plan = std::make_unique<TraversalPlan>();
+  for (int i = 0; i < descriptor.field_count(); ++i) {
+    const Protobuf::FieldDescriptor* field = descriptor.field(i);
+    const bool annotated = isAnnotatedField(*field);
+    if (annotated || field->cpp_type() == Protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+      plan->fields_.push_back({field, annotated});
+    }
+  }
+  return plan;
+}
+
+/**
+ * The plans of the generated message types, which live as long as the process. The types of the
+ * other pools may be freed with their pool, so their plans aren't kept.
+ */
+class TraversalPlans {
+public:
+  static TraversalPlans& get() { MUTABLE_CONSTRUCT_ON_FIRST_USE(TraversalPlans); }
+
+  const TraversalPlan& plan(const Protobuf::Descriptor& descriptor) {
+    {
+      absl::ReaderMutexLock lock(&mutex_);
+      auto it = plans_.find(&descriptor);
+      if (it != plans_.end()) {
+        return *it->second;
+      }
+    }
+    std::unique_ptr<TraversalPlan> plan = createTraversalPlan(descriptor);
+    absl::MutexLock lock(&mutex_);
+    // Another thread may have planned the type meanwhile, in which case its plan is kept.
+    return *plans_.try_emplace(&descriptor, std::move(plan)).first->second;
+  }
+
+private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<const Protobuf::Descriptor*, std::unique_ptr<TraversalPlan>>
+      plans_ ABSL_GUARDED_BY(mutex_);
+};
+
 /**
  * RAII wrapper that push message to parents on construction and pop it on destruction.
  */
@@ -55,6 +132,32 @@ private:
   std::vector<const Protobuf::Message*>& parents_;
 };
 
+void traverseMessageWorker(ConstProtoVisitor& visitor, const Protobuf::Message& message,
+                           std::vector<const Protobuf::Message*>& parents,
+                           bool was_any_or_top_level, bool recurse_into_any);
+
+// If field is a message, recurses in to the sub-messages it holds.
+void traverseMessageField(ConstProtoVisitor& visitor, const Protobuf::Message& message,
+                          const Protobuf::FieldDescriptor& field,
+                          std::vector<const Protobuf::Message*>& parents, bool recurse_into_any) {
+  if (field.cpp_type() != Protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+    return;
+  }
+  const Protobuf::Reflection* reflection = message.GetReflection();
+  ScopedMessageParents scoped_parents(parents, message);
+
+  if (field.is_repeated()) {
+    const int size = reflection->FieldSize(message, &field);
+    for (int j = 0; j < size; ++j) {
+      traverseMessageWorker(visitor, reflection->GetRepeatedMessage(message, &field, j), parents,
+                            false, recurse_into_any);
+    }
+  } else if (reflection->HasField(message, &field)) {
+    traverseMessageWorker(visitor, reflection->GetMessage(message, &field), parents, false,
+                          recurse_into_any);
+  }
+}
+
 void traverseMessageWorker(ConstProtoVisitor& visitor, const Protobuf::Message& message,
                            std::vector<const Protobuf::Message*>& parents,
                            bool was_any_or_top_level, bool recurse_into_any) {
@@ -91,26 +194,28 @@ void traverseMessageWorker(ConstProtoVisitor& visitor, const Protobuf::Message&
   }
 
   const Protobuf::Descriptor* descriptor = message.GetDescriptor();
-  const Protobuf::Reflection* reflection = message.GetReflection();
+  if (visitor.annotatedFieldsOnly()) {
+    std::unique_ptr<TraversalPlan> unshared_plan;
+    const TraversalPlan* plan;
+    if (descriptor->file()->pool() == Protobuf::DescriptorPool::generated_pool()) {
+      plan = &TraversalPlans::get().plan(*descriptor);
+    } else {
+      unshared_plan = createTraversalPlan(*descriptor);
+      plan = unshared_plan.get();
+    }
+    for (const TraversalPlan::Field& planned : plan->fields_) {
+      if (planned.annotated_) {
+        visitor.onField(message, *planned.descriptor_);
+      }
+      traverseMessageField(visitor, message, *planned.descriptor_, parents, recurse_into_any);
+    }
+    return;
+  }
+
   for (int i = 0; i < descriptor->field_count(); ++i) {
     const Protobuf::FieldDescriptor* field = descriptor->field(i);
     visitor.onField(message, *field);
-
-    // If this is a message, recurse in to the sub-message.
-    if (field->cpp_type() == Protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
-      ScopedMessageParents scoped_parents(parents, message);
-
-      if (field->is_repeated()) {
-        const int size = reflection->FieldSize(message, field);
-        for (int j = 0; j < size; ++j) {
-          traverseMessageWorker(visitor, reflection->GetRepeatedMessage(message, field, j), parents,
-                                false, recurse_into_any);
-        }
-      } else if (reflection->HasField(message, field)) {
-        traverseMessageWorker(visitor, reflection->GetMessage(message, field), parents, false,
-                              recurse_into_any);
-      }
-    }
+    traverseMessageField(visitor, message, *field, parents, recurse_into_any);
   }
 }
 
@@ -22,6 +22,12 @@ public:
   //                             only be achieved by using recurse_into_any.
   virtual void onMessage(const Protobuf::Message&, absl::Span<const Protobuf::Message* const>,
                          bool was_any_or_top_level) PURE;
+
+  // Returns whether onField() ignores the fields without deprecated or work-in-progress
+  // annotations, other than the singular enum fields having deprecated values. The traversal then
+  // only invokes onField() for the annotated fields, and only looks at the message fields of the
+  // other types to recurse into them.
+  virtual bool annotatedFieldsOnly() const { return false; }
 };
 
 void traverseMessage(ConstProtoVisitor& visitor, const Protobuf::Message& message,
@@ -1,5 +1,6 @@
 #include "source/common/quic/active_quic_listener.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "envoy/extensions/quic/connection_id_generator/v3/envoy_deterministic_connection_id_generator.pb.h"
@@ -19,9 +20,26 @@
 #include "source/common/quic/quic_network_connection.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Quic {
 
+namespace {
+
+// Returns the destination connection ID of a short header packet, assuming it has the length of
+// the connection IDs of the listener, or an empty view for the other packets.
+absl::string_view shortHeaderConnectionId(const Buffer::Instance& buffer) {
+  const Buffer::RawSlice slice = buffer.frontSlice();
+  const char* data = static_cast<const char*>(slice.mem_);
+  if (slice.len_ <= quic::kQuicDefaultConnectionIdLength || (data[0] & 0x80) != 0) {
+    return {};
+  }
+  return {data + 1, quic::kQuicDefaultConnectionIdLength};
+}
+
+} // namespace
+
 bool ActiveQuicListenerFactory::disable_kernel_bpf_packet_routing_for_test_ = false;
 
 ActiveQuicListener::ActiveQuicListener(
@@ -79,17 +97,27 @@ ActiveQuicListener::ActiveQuicListener(
   // `EnvoyQuicPacketWriter` as an adapter.
   auto* quic_packet_writer = dynamic_cast<quic::QuicPacketWriter*>(udp_packet_writer.get());
   if (quic_packet_writer != nullptr) {
-    quic_dispatcher_->InitializeWithWriter(quic_packet_writer);
     udp_packet_writer.release();
   } else {
-    quic_dispatcher_->InitializeWithWriter(new EnvoyQuicPacketWriter(std::move(udp_packet_writer)));
+    quic_packet_writer = new EnvoyQuicPacketWriter(std::move(udp_packet_writer));
+  }
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.quic_batch_packet_processing")) {
+    deferred_flush_writer_ = new EnvoyQuicDeferredFlushPacketWriter(quic_packet_writer);
+    quic_packet_writer = deferred_flush_writer_;
+    process_packets_cb_ =
+        dispatcher.createSchedulableCallback([this]() { processPendingPackets(); });
   }
+  quic_dispatcher_->InitializeWithWriter(quic_packet_writer);
 }
 
 ActiveQuicListener::~ActiveQuicListener() { onListenerShutdown(); }
 
 void ActiveQuicListener::onListenerShutdown() {
   ENVOY_LOG(info, "Quic listener {} shutdown.", config_->name());
+  if (process_packets_cb_ != nullptr) {
+    process_packets_cb_->cancel();
+  }
+  pending_packets_.clear();
   quic_dispatcher_->Shutdown();
   udp_listener_.reset();
 }
@@ -99,6 +127,54 @@ void ActiveQuicListener::onDataWorker(Network::UdpRecvData&& data) {
     return;
   }
 
+  if (process_packets_cb_ != nullptr) {
+    // The packets are processed once all of those read by this iteration of the event loop, or
+    // redirected to this worker, have been received.
+    pending_packets_.push_back(std::move(data));
+    if (!process_packets_cb_->enabled()) {
+      process_packets_cb_->scheduleCallbackCurrentIteration();
+    }
+    return;
+  }
+
+  processPacket(data);
+  if (quic_dispatcher_->HasChlosBuffered()) {
+    // If there are any buffered CHLOs, activate a read event for the next event loop to process
+    // them.
+    udp_listener_->activateRead();
+  }
+}
+
+void ActiveQuicListener::processPendingPackets() {
+  // The packets are grouped by connection, in the order of the first packet of each connection and
+  // in the order of arrival within a connection, so that the connections flush the packets sent in
+  // response to all their packets at once. The packets without a short header, most of which start
+  // connections, are left at their position.
+  absl::flat_hash_map<absl::string_view, size_t> first_packets;
+  processing_order_.clear();
+  for (size_t i = 0; i < pending_packets_.size(); i++) {
+    const absl::string_view connection_id = shortHeaderConnectionId(*pending_packets_[i].buffer_);
+    const size_t first =
+        connection_id.empty() ? i : first_packets.emplace(connection_id, i).first->second;
+    processing_order_.emplace_back(first, i);
+  }
+  std::sort(processing_order_.begin(), processing_order_.end());
+
+  deferred_flush_writer_->startDeferringFlush();
+  for (const auto& position : processing_order_) {
+    processPacket(pending_packets_[position.second]);
+  }
+  pending_packets_.clear();
+  deferred_flush_writer_->stopDeferringFlush();
+
+  if (quic_dispatcher_->HasChlosBuffered()) {
+    // If there are any buffered CHLOs, activate a read event for the next event loop to process
+    // them.
+    udp_listener_->activateRead();
+  }
+}
+
+void ActiveQuicListener::processPacket(const Network::UdpRecvData& data) {
   quic::QuicSocketAddress peer_address(
       envoyIpAddressToQuicSocketAddress(data.addresses_.peer_->ip()));
   quic::QuicSocketAddress self_address(
@@ -116,12 +192,6 @@ void ActiveQuicListener::onDataWorker(Network::UdpRecvData&& data) {
                                   /*packet_headers=*/nullptr, /*headers_length=*/0,
                                   /*owns_header_buffer*/ false);
   quic_dispatcher_->ProcessPacket(self_address, peer_address, packet);
-
-  if (quic_dispatcher_->HasChlosBuffered()) {
-    // If there are any buffered CHLOs, activate a read event for the next event loop to process
-    // them.
-    udp_listener_->activateRead();
-  }
 }
 
 void ActiveQuicListener::onReadReady() {
@@ -144,6 +214,9 @@ void ActiveQuicListener::onReadReady() {
 
 void ActiveQuicListener::onWriteReady(const Network::Socket& /*socket*/) {
   quic_dispatcher_->OnCanWrite();
+  if (deferred_flush_writer_ != nullptr && deferred_flush_writer_->flushPending()) {
+    deferred_flush_writer_->Flush();
+  }
 }
 
 void ActiveQuicListener::pauseListening() { quic_dispatcher_->StopAcceptingNewConnections(); }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "envoy/config/listener/v3/quic_config.pb.h"
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/network/connection_handler.h"
 #include "envoy/network/listener.h"
 #include "envoy/network/socket.h"
@@ -10,6 +14,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/quic/envoy_quic_connection_id_generator_factory.h"
 #include "source/common/quic/envoy_quic_dispatcher.h"
+#include "source/common/quic/envoy_quic_packet_writer.h"
 #include "source/common/quic/envoy_quic_proof_source_factory_interface.h"
 #include "source/common/quic/envoy_quic_server_preferred_address_config_factory.h"
 #include "source/common/runtime/runtime_protos.h"
@@ -70,6 +75,9 @@ private:
   friend class ActiveQuicListenerPeer;
 
   void closeConnectionsWithFilterChain(const Network::FilterChain* filter_chain);
+  void processPacket(const Network::UdpRecvData& data);
+  // Processes the packets received in the current event loop iteration, grouped by connection.
+  void processPendingPackets();
 
   uint8_t random_seed_[16];
   std::unique_ptr<quic::QuicCryptoServerConfig> crypto_config_;
@@ -79,6 +87,14 @@ private:
   const bool kernel_worker_routing_;
   absl::optional<Runtime::FeatureFlag> enabled_{};
   Network::UdpPacketWriter* udp_packet_writer_;
+  // Only set if the packets are processed in batches, in which case the flushes of the writer are
+  // deferred to the end of the batches.
+  EnvoyQuicDeferredFlushPacketWriter* deferred_flush_writer_{nullptr};
+  Event::SchedulableCallbackPtr process_packets_cb_;
+  std::vector<Network::UdpRecvData> pending_packets_;
+  // The positions of the first packets of the connections and of the pending packets, sorted to
+  // get the order in which they are processed.
+  std::vector<std::pair<size_t, size_t>> processing_order_;
 
   // The number of runs of the event loop in which at least one CHLO was buffered.
   // TODO(ggreenway): Consider making this a published stat, or some variation of this information.
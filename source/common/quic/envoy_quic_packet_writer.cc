@@ -74,5 +74,29 @@ quic::WriteResult EnvoyQuicPacketWriter::Flush() {
   return convertToQuicWriteResult(result);
 }
 
+EnvoyQuicDeferredFlushPacketWriter::EnvoyQuicDeferredFlushPacketWriter(
+    quic::QuicPacketWriter* writer) {
+  set_writer(writer);
+}
+
+void EnvoyQuicDeferredFlushPacketWriter::stopDeferringFlush() {
+  deferring_flush_ = false;
+  if (flush_pending_) {
+    Flush();
+  }
+}
+
+quic::WriteResult EnvoyQuicDeferredFlushPacketWriter::Flush() {
+  if (deferring_flush_) {
+    flush_pending_ = true;
+    return {quic::WRITE_STATUS_OK, 0};
+  }
+  const quic::WriteResult result = quic::QuicPacketWriterWrapper::Flush();
+  // The packets left buffered by a blocked flush have to be flushed once the socket is writable,
+  // since the connection which requested the flush may not be the one which was blocked.
+  flush_pending_ = quic::IsWriteBlockedStatus(result.status);
+  return result;
+}
+
 } // namespace Quic
 } // namespace Envoy
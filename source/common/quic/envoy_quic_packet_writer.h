@@ -3,6 +3,7 @@
 #include "envoy/network/udp_packet_writer_handler.h"
 
 #include "quiche/quic/core/quic_packet_writer.h"
+#include "quiche/quic/core/quic_packet_writer_wrapper.h"
 
 namespace Envoy {
 namespace Quic {
@@ -33,5 +34,36 @@ private:
   Network::UdpPacketWriterPtr envoy_udp_packet_writer_;
 };
 
+// A writer which can defer the flushes requested by the connections, so that the packets written
+// by several connections, or in response to several packets of a connection, are flushed at once
+// by a batch writer.
+class EnvoyQuicDeferredFlushPacketWriter : public quic::QuicPacketWriterWrapper {
+public:
+  // Takes the ownership of the writer.
+  explicit EnvoyQuicDeferredFlushPacketWriter(quic::QuicPacketWriter* writer);
+
+  /**
+   * Defers the flushes until stopDeferringFlush() is called.
+   */
+  void startDeferringFlush() { deferring_flush_ = true; }
+
+  /**
+   * Performs the flushes deferred since startDeferringFlush(), if any.
+   */
+  void stopDeferringFlush();
+
+  /**
+   * @return whether packets may be left buffered by a deferred or blocked flush.
+   */
+  bool flushPending() const { return flush_pending_; }
+
+  // quic::QuicPacketWriter
+  quic::WriteResult Flush() override;
+
+private:
+  bool deferring_flush_{false};
+  bool flush_pending_{false};
+};
+
 } // namespace Quic
 } // namespace Envoy
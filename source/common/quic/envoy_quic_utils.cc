@@ -285,5 +285,17 @@ void adjustNewConnectionIdForRoutine(quic::QuicConnectionId& new_connection_id,
   safeMemcpyUnsafeDst(new_connection_id_data, first_four_bytes);
 }
 
+QuicheMemSliceVector moveBufferToQuicheMemSlices(Buffer::Instance& buffer) {
+  QuicheMemSliceVector quic_slices;
+  while (buffer.length() > 0) {
+    // Each mem slice takes over the front slice of the buffer, so the slices don't need to be
+    // collected up front.
+    const uint64_t slice_length = buffer.frontSlice().len_;
+    ASSERT(slice_length != 0);
+    quic_slices.emplace_back(quiche::QuicheMemSlice::InPlace(), buffer, slice_length);
+  }
+  return quic_slices;
+}
+
 } // namespace Quic
 } // namespace Envoy
@@ -11,7 +11,9 @@
 #include "source/common/network/listen_socket_impl.h"
 #include "source/common/quic/quic_io_handle_wrapper.h"
 
+#include "absl/container/inlined_vector.h"
 #include "openssl/ssl.h"
+#include "quiche/common/platform/api/quiche_mem_slice.h"
 #include "quiche/quic/core/http/quic_header_list.h"
 #include "quiche/quic/core/quic_config.h"
 #include "quiche/quic/core/quic_error_codes.h"
@@ -193,5 +195,12 @@ void configQuicInitialFlowControlWindow(const envoy::config::core::v3::QuicProto
 void adjustNewConnectionIdForRoutine(quic::QuicConnectionId& new_connection_id,
                                      const quic::QuicConnectionId& old_connection_id);
 
+using QuicheMemSliceVector = absl::InlinedVector<quiche::QuicheMemSlice, 4>;
+
+// Moves all the slices of `buffer` into mem slices to be handed to QUICHE, one mem slice per
+// slice. The data isn't copied: each mem slice owns its slice until QUICHE releases it, which
+// returns the memory through the release callback of the slice, if any.
+QuicheMemSliceVector moveBufferToQuicheMemSlices(Buffer::Instance& buffer);
+
 } // namespace Quic
 } // namespace Envoy
@@ -49,6 +49,14 @@ bool QuicFilterManagerConnectionImpl::initializeReadFilters() {
   return filter_manager_->initializeReadFilters();
 }
 
+uint32_t QuicFilterManagerConnectionImpl::numReadFilters() const {
+  return filter_manager_->numReadFilters();
+}
+
+uint32_t QuicFilterManagerConnectionImpl::numWriteFilters() const {
+  return filter_manager_->numWriteFilters();
+}
+
 void QuicFilterManagerConnectionImpl::enableHalfClose(bool enabled) {
   RELEASE_ASSERT(!enabled, "Quic connection doesn't support half close.");
 }
@@ -43,6 +43,8 @@ public:
   void addReadFilter(Network::ReadFilterSharedPtr filter) override;
   void removeReadFilter(Network::ReadFilterSharedPtr filter) override;
   bool initializeReadFilters() override;
+  uint32_t numReadFilters() const override;
+  uint32_t numWriteFilters() const override;
 
   // Network::Connection
   void addBytesSentCallback(Network::Connection::BytesSentCb /*cb*/) override {
@@ -101,6 +103,7 @@ public:
     network_connection_->setConnectionStats(stats);
   }
   Ssl::ConnectionInfoConstSharedPtr ssl() const override;
+  bool forwardsPayloadUnchanged() const override { return false; }
   Network::Connection::State state() const override {
     if (!initialized_ || (quicConnection() != nullptr && quicConnection()->connected())) {
       return Network::Connection::State::Open;
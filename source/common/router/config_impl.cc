@@ -51,6 +51,7 @@
 #include "source/extensions/path/match/uri_template/uri_template_match.h"
 #include "source/extensions/path/rewrite/uri_template/uri_template_rewrite.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 
 namespace Envoy {
@@ -244,7 +245,11 @@ std::string SslRedirector::newUri(const Http::RequestHeaderMap& headers) const {
 HedgePolicyImpl::HedgePolicyImpl(const envoy::config::route::v3::HedgePolicy& hedge_policy)
     : initial_requests_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(hedge_policy, initial_requests, 1)),
       additional_request_chance_(hedge_policy.additional_request_chance()),
-      hedge_on_per_try_timeout_(hedge_policy.hedge_on_per_try_timeout()) {}
+      hedge_on_per_try_timeout_(hedge_policy.hedge_on_per_try_timeout()),
+      latency_tracker_(hedge_policy.has_latency_percentile_hedging()
+                           ? std::make_unique<HedgeLatencyTrackerImpl>(
+                                 hedge_policy.latency_percentile_hedging())
+                           : nullptr) {}
 
 HedgePolicyImpl::HedgePolicyImpl() : initial_requests_(1), hedge_on_per_try_timeout_(false) {}
 
@@ -1541,7 +1546,10 @@ RegexRouteEntryImpl::RegexRouteEntryImpl(
     Server::Configuration::ServerFactoryContext& factory_context,
     ProtobufMessage::ValidationVisitor& validator)
     : RouteEntryImplBase(vhost, route, optional_http_filters, factory_context, validator),
-      path_matcher_(Matchers::PathMatcher::createSafeRegex(route.match().safe_regex())) {
+      path_matcher_(Matchers::PathMatcher::createSafeRegex(route.match().safe_regex())),
+      uses_google_re2_(route.match().safe_regex().has_google_re2() ||
+                       dynamic_cast<const Regex::GoogleReEngine*>(
+                           Regex::EngineSingleton::getExisting()) != nullptr) {
   ASSERT(route.match().path_specifier_case() ==
          envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex);
 }
@@ -1640,7 +1648,8 @@ PathSeparatedPrefixRouteEntryImpl::matches(const Http::RequestHeaderMap& headers
 
 VirtualHostImpl::VirtualHostImpl(
     const envoy::config::route::v3::VirtualHost& virtual_host,
-    const OptionalHttpFilters& optional_http_filters, const ConfigImpl& global_route_config,
+    const OptionalHttpFilters& optional_http_filters,
+    const CommonConfigSharedPtr& global_route_config,
     Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
     ProtobufMessage::ValidationVisitor& validator,
     const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters)
@@ -1698,7 +1707,7 @@ VirtualHostImpl::VirtualHostImpl(
 
   // Inherit policies from the global config.
   if (shadow_policies_.empty()) {
-    shadow_policies_ = global_route_config_.shadowPolicies();
+    shadow_policies_ = global_route_config_->shadowPolicies();
   }
 
   if (virtual_host.has_matcher() && !virtual_host.routes().empty()) {
@@ -1723,6 +1732,10 @@ VirtualHostImpl::VirtualHostImpl(
       routes_.emplace_back(createAndValidateRoute(route, *this, optional_http_filters,
                                                   factory_context, validator, validation_clusters));
     }
+    if (routes_.size() >= MinRoutesForPathRouteIndex &&
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.route_path_index")) {
+      buildPathRouteIndex();
+    }
   }
 
   if (!virtual_host.virtual_clusters().empty()) {
@@ -1757,19 +1770,19 @@ VirtualHostImpl::VirtualClusterEntry::VirtualClusterEntry(
   headers_ = Http::HeaderUtility::buildHeaderDataVector(virtual_cluster.headers());
 }
 
-const Config& VirtualHostImpl::routeConfig() const { return global_route_config_; }
+const CommonConfig& VirtualHostImpl::routeConfig() const { return *global_route_config_; }
 
 const RouteSpecificFilterConfig*
 VirtualHostImpl::mostSpecificPerFilterConfig(const std::string& name) const {
   auto* per_filter_config = per_filter_configs_.get(name);
   return per_filter_config != nullptr ? per_filter_config
-                                      : global_route_config_.perFilterConfig(name);
+                                      : global_route_config_->perFilterConfig(name);
 }
 void VirtualHostImpl::traversePerFilterConfig(
     const std::string& filter_name,
     std::function<void(const Router::RouteSpecificFilterConfig&)> cb) const {
   // Parent first.
-  if (auto* maybe_rc_config = global_route_config_.perFilterConfig(filter_name);
+  if (auto* maybe_rc_config = global_route_config_->perFilterConfig(filter_name);
       maybe_rc_config != nullptr) {
     cb(*maybe_rc_config);
   }
@@ -1780,20 +1793,18 @@ void VirtualHostImpl::traversePerFilterConfig(
 }
 
 const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
-    const std::string& host, const RouteMatcher::WildcardVirtualHosts& wildcard_virtual_hosts,
+    absl::string_view host, const RouteMatcher::WildcardVirtualHosts& wildcard_virtual_hosts,
     RouteMatcher::SubstringFunction substring_function) const {
   // We do a longest wildcard match against the host that's passed in
   // (e.g. "foo-bar.baz.com" should match "*-bar.baz.com" before matching "*.baz.com" for suffix
   // wildcards). This is done by scanning the length => wildcards map looking for every wildcard
-  // whose size is < length.
-  for (const auto& iter : wildcard_virtual_hosts) {
-    const uint32_t wildcard_length = iter.first;
-    const auto& wildcard_map = iter.second;
-    // >= because *.foo.com shouldn't match .foo.com.
-    if (wildcard_length >= host.size()) {
-      continue;
-    }
-    const auto& match = wildcard_map.find(substring_function(host, wildcard_length));
+  // whose size is < length. Lengths are sorted in descending order, so the scan starts at the first
+  // wildcard shorter than the host; it is not >= because *.foo.com shouldn't match .foo.com.
+  // Wildcards are looked up by string_view, which does not copy the host.
+  for (auto iter = wildcard_virtual_hosts.lower_bound(static_cast<int64_t>(host.size()) - 1);
+       iter != wildcard_virtual_hosts.end(); ++iter) {
+    const auto& wildcard_map = iter->second;
+    const auto& match = wildcard_map.find(substring_function(host, iter->first));
     if (match != wildcard_map.end()) {
       return match->second.get();
     }
@@ -1803,9 +1814,10 @@ const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
 
 RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& route_config,
                            const OptionalHttpFilters& optional_http_filters,
-                           const ConfigImpl& global_route_config,
+                           const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
-                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters)
+                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           bool reuse_virtual_hosts, const RouteMatcher* previous_route_matcher)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
@@ -1814,9 +1826,27 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
     validation_clusters = factory_context.clusterManager().clusters();
   }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, optional_http_filters, global_route_config, factory_context,
-        *vhost_scope_, validator, validation_clusters);
+    VirtualHostSharedPtr virtual_host;
+    if (reuse_virtual_hosts) {
+      const uint64_t hash = MessageUtil::hash(virtual_host_config);
+      if (previous_route_matcher != nullptr) {
+        const auto it = previous_route_matcher->virtual_hosts_by_hash_.find(hash);
+        if (it != previous_route_matcher->virtual_hosts_by_hash_.end()) {
+          virtual_host = it->second;
+        }
+      }
+      if (virtual_host == nullptr) {
+        virtual_host = std::make_shared<VirtualHostImpl>(
+            virtual_host_config, optional_http_filters, global_route_config, factory_context,
+            *vhost_scope_, validator, validation_clusters);
+      }
+      virtual_hosts_by_hash_.emplace(hash, virtual_host);
+    } else {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, optional_http_filters,
+                                                       global_route_config, factory_context,
+                                                       *vhost_scope_, validator,
+                                                       validation_clusters);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const std::string domain = Http::LowerCaseString(domain_name).get();
       bool duplicate_found = false;
@@ -1883,6 +1913,68 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+void VirtualHostImpl::buildPathRouteIndex() {
+  auto index = std::make_unique<PathRouteIndex>();
+  for (uint32_t position = 0; position < routes_.size(); ++position) {
+    const RouteEntryImplBase& route = *routes_[position];
+    const std::string& matcher = route.matcher();
+    // Case insensitive literals are only indexed when they contain no letters, as is the case for
+    // the common "" and "/" prefixes. Regexes are always case sensitive.
+    const bool literal_indexable =
+        route.case_sensitive() || std::none_of(matcher.begin(), matcher.end(), absl::ascii_isalpha);
+    switch (route.matchType()) {
+    case PathMatchType::Prefix:
+    case PathMatchType::PathSeparatedPrefix:
+      if (literal_indexable) {
+        index->addPrefix(matcher, position);
+        continue;
+      }
+      break;
+    case PathMatchType::Exact:
+      if (literal_indexable) {
+        index->addExact(matcher, position);
+        continue;
+      }
+      break;
+    case PathMatchType::Regex:
+      // Regexes of other engines may not have the same semantics as RE2.
+      if (dynamic_cast<const RegexRouteEntryImpl&>(route).usesGoogleRe2() &&
+          index->addRegex(matcher, position)) {
+        continue;
+      }
+      break;
+    default:
+      break;
+    }
+    index->addUnindexed(position);
+  }
+  index->compile();
+  if (index->unindexedRoutes() < routes_.size()) {
+    path_route_index_ = std::move(index);
+  }
+}
+
+RouteConstSharedPtr
+VirtualHostImpl::getRouteFromPathRouteIndex(const Http::RequestHeaderMap& headers,
+                                            const StreamInfo::StreamInfo& stream_info,
+                                            uint64_t random_value) const {
+  // The index is looked up with the part of the path the route path matchers look at.
+  absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (global_route_config_->ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find(';'));
+  }
+  for (const uint32_t position : path_route_index_->candidates(path)) {
+    RouteConstSharedPtr route_entry =
+        routes_[position]->matches(headers, stream_info, random_value);
+    if (route_entry != nullptr) {
+      return route_entry;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -1931,6 +2023,12 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
+  // Route callbacks are told whether more routes follow the matched one, so they are only given
+  // routes from the linear scan.
+  if (path_route_index_ != nullptr && cb == nullptr && headers.Path() != nullptr) {
+    return getRouteFromPathRouteIndex(headers, stream_info, random_value);
+  }
+
   // Check for a route that matches the request.
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
@@ -1958,8 +2056,14 @@ const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMa
   }
   // TODO (@rshriram) Match Origin header in WebSocket
   // request with VHost, using wildcard match
-  // Lower-case the value of the host header, as hostnames are case insensitive.
-  const std::string host = absl::AsciiStrToLower(host_header_value);
+  // Lower-case the value of the host header, as hostnames are case insensitive. Host headers are
+  // almost always lower case already, in which case they are looked up without a copy.
+  std::string lower_case_host;
+  absl::string_view host = host_header_value;
+  if (std::any_of(host.begin(), host.end(), absl::ascii_isupper)) {
+    lower_case_host = absl::AsciiStrToLower(host);
+    host = lower_case_host;
+  }
   const auto& iter = virtual_hosts_.find(host);
   if (iter != virtual_hosts_.end()) {
     return iter->second.get();
@@ -1967,7 +2071,7 @@ const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMa
   if (!wildcard_virtual_host_suffixes_.empty()) {
     const VirtualHostImpl* vhost = findWildcardVirtualHost(
         host, wildcard_virtual_host_suffixes_,
-        [](const std::string& h, int l) -> std::string { return h.substr(h.size() - l); });
+        [](absl::string_view h, size_t l) { return h.substr(h.size() - l); });
     if (vhost != nullptr) {
       return vhost;
     }
@@ -1975,7 +2079,7 @@ const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMa
   if (!wildcard_virtual_host_prefixes_.empty()) {
     const VirtualHostImpl* vhost = findWildcardVirtualHost(
         host, wildcard_virtual_host_prefixes_,
-        [](const std::string& h, int l) -> std::string { return h.substr(0, l); });
+        [](absl::string_view h, size_t l) { return h.substr(0, l); });
     if (vhost != nullptr) {
       return vhost;
     }
@@ -2018,11 +2122,10 @@ VirtualHostImpl::virtualClusterFromEntries(const Http::HeaderMap& headers) const
   return nullptr;
 }
 
-ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
-                       const OptionalHttpFilters& optional_http_filters,
-                       Server::Configuration::ServerFactoryContext& factory_context,
-                       ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default)
+CommonConfigImpl::CommonConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                                   const OptionalHttpFilters& optional_http_filters,
+                                   Server::Configuration::ServerFactoryContext& factory_context,
+                                   ProtobufMessage::ValidationVisitor& validator)
     : name_(config.name()), symbol_table_(factory_context.scope().symbolTable()),
       per_filter_configs_(config.typed_per_filter_config(), optional_http_filters, factory_context,
                           validator),
@@ -2046,10 +2149,6 @@ ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& confi
     cluster_specifier_plugins_.emplace(plugin_proto.extension().name(), std::move(plugin));
   }
 
-  route_matcher_ = std::make_unique<RouteMatcher>(
-      config, optional_http_filters, *this, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
-
   for (const std::string& header : config.internal_only_headers()) {
     internal_only_headers_.push_back(Http::LowerCaseString(header));
   }
@@ -2065,7 +2164,7 @@ ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& confi
 }
 
 ClusterSpecifierPluginSharedPtr
-ConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
+CommonConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
   auto iter = cluster_specifier_plugins_.find(provider);
   if (iter == cluster_specifier_plugins_.end() || iter->second == nullptr) {
     throw EnvoyException(
@@ -2074,6 +2173,63 @@ ConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
   return iter->second;
 }
 
+namespace {
+
+// Selects every field of a route configuration but its virtual hosts.
+const Protobuf::FieldMask& sharedConfigFieldMask() {
+  CONSTRUCT_ON_FIRST_USE(Protobuf::FieldMask, []() {
+    Protobuf::FieldMask mask;
+    const Protobuf::Descriptor* descriptor =
+        envoy::config::route::v3::RouteConfiguration::descriptor();
+    for (int i = 0; i < descriptor->field_count(); i++) {
+      if (descriptor->field(i)->number() !=
+          envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber) {
+        mask.add_paths(descriptor->field(i)->name());
+      }
+    }
+    return mask;
+  }());
+}
+
+uint64_t sharedConfigHash(const envoy::config::route::v3::RouteConfiguration& config) {
+  envoy::config::route::v3::RouteConfiguration shared_config;
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(config, sharedConfigFieldMask(),
+                                              ProtobufUtil::FieldMaskUtil::MergeOptions(),
+                                              &shared_config);
+  return MessageUtil::hash(shared_config);
+}
+
+} // namespace
+
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       const OptionalHttpFilters& optional_http_filters,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default, const ConfigImpl* previous_config) {
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  // Virtual hosts validated against the clusters known at construction time can't be reused, as
+  // the clusters may have changed since.
+  if (!validate_clusters &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.reuse_unchanged_virtual_hosts")) {
+    shared_config_hash_ = sharedConfigHash(config);
+  }
+
+  const RouteMatcher* previous_route_matcher = nullptr;
+  if (shared_config_hash_.has_value() && previous_config != nullptr &&
+      previous_config->shared_config_hash_ == shared_config_hash_) {
+    shared_config_ = previous_config->shared_config_;
+    previous_route_matcher = previous_config->route_matcher_.get();
+  } else {
+    shared_config_ = std::make_shared<CommonConfigImpl>(config, optional_http_filters,
+                                                        factory_context, validator);
+  }
+
+  route_matcher_ = std::make_unique<RouteMatcher>(
+      config, optional_http_filters, shared_config_, factory_context, validator, validate_clusters,
+      shared_config_hash_.has_value(), previous_route_matcher);
+}
+
 RouteConstSharedPtr ConfigImpl::route(const RouteCallback& cb,
                                       const Http::RequestHeaderMap& headers,
                                       const StreamInfo::StreamInfo& stream_info,
@@ -30,11 +30,14 @@
 #include "source/common/router/config_utility.h"
 #include "source/common/router/header_formatter.h"
 #include "source/common/router/header_parser.h"
+#include "source/common/router/hedge_latency_tracker.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
+#include "source/common/router/path_route_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -214,7 +217,9 @@ using CorsPolicyImpl = CorsPolicyImplBase<envoy::config::route::v3::CorsPolicy>;
 using RetryPolicyConstOptRef = const OptRef<const envoy::config::route::v3::RetryPolicy>;
 using HedgePolicyConstOptRef = const OptRef<const envoy::config::route::v3::HedgePolicy>;
 
-class ConfigImpl;
+class CommonConfigImpl;
+using CommonConfigSharedPtr = std::shared_ptr<const CommonConfigImpl>;
+
 /**
  * Holds all routing configuration for an entire virtual host.
  */
@@ -222,7 +227,8 @@ class VirtualHostImpl : public VirtualHost, Logger::Loggable<Logger::Id::router>
 public:
   VirtualHostImpl(
       const envoy::config::route::v3::VirtualHost& virtual_host,
-      const OptionalHttpFilters& optional_http_filters, const ConfigImpl& global_route_config,
+      const OptionalHttpFilters& optional_http_filters,
+      const CommonConfigSharedPtr& global_route_config,
       Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
       ProtobufMessage::ValidationVisitor& validator,
       const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters);
@@ -232,7 +238,7 @@ public:
                                           const StreamInfo::StreamInfo& stream_info,
                                           uint64_t random_value) const;
   const VirtualCluster* virtualClusterFromEntries(const Http::HeaderMap& headers) const;
-  const ConfigImpl& globalRouteConfig() const { return global_route_config_; }
+  const CommonConfigImpl& globalRouteConfig() const { return *global_route_config_; }
   const HeaderParser& requestHeaderParser() const {
     if (request_headers_parser_ != nullptr) {
       return *request_headers_parser_;
@@ -255,7 +261,7 @@ public:
     }
     return DefaultRateLimitPolicy::get();
   }
-  const Config& routeConfig() const override;
+  const CommonConfig& routeConfig() const override;
   const RouteSpecificFilterConfig* mostSpecificPerFilterConfig(const std::string&) const override;
   bool includeAttemptCountInRequest() const override { return include_attempt_count_in_request_; }
   bool includeAttemptCountInResponse() const override { return include_attempt_count_in_response_; }
@@ -325,18 +331,27 @@ private:
   getRouteFromRoutes(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                      const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
                      absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const;
+  RouteConstSharedPtr getRouteFromPathRouteIndex(const Http::RequestHeaderMap& headers,
+                                                 const StreamInfo::StreamInfo& stream_info,
+                                                 uint64_t random_value) const;
+  void buildPathRouteIndex();
+
+  // Virtual hosts with fewer routes are matched with a linear scan, which is cheaper than a lookup
+  // in the path route index.
+  static constexpr size_t MinRoutesForPathRouteIndex = 16;
 
   static const std::shared_ptr<const SslRedirectRoute> SSL_REDIRECT_ROUTE;
 
   const Stats::StatNameManagedStorage stat_name_storage_;
   Stats::ScopeSharedPtr vcluster_scope_;
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  std::unique_ptr<const PathRouteIndex> path_route_index_;
   std::vector<VirtualClusterEntry> virtual_clusters_;
   std::unique_ptr<const RateLimitPolicyImpl> rate_limit_policy_;
   std::vector<ShadowPolicyPtr> shadow_policies_;
   std::unique_ptr<const CorsPolicyImpl> cors_policy_;
-  const ConfigImpl& global_route_config_; // See note in RouteEntryImplBase::clusterEntry() on why
-                                          // raw ref to the top level config is currently safe.
+  // Shared with every ConfigImpl that reuses this virtual host.
+  const CommonConfigSharedPtr global_route_config_;
   HeaderParserPtr request_headers_parser_;
   HeaderParserPtr response_headers_parser_;
   PerFilterConfigs per_filter_configs_;
@@ -460,11 +475,13 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  HedgeLatencyTracker* latencyTracker() const override { return latency_tracker_.get(); }
 
 private:
   const uint32_t initial_requests_;
   const envoy::type::v3::FractionalPercent additional_request_chance_;
   const bool hedge_on_per_try_timeout_;
+  const HedgeLatencyTrackerImplPtr latency_tracker_;
 };
 using DefaultHedgePolicy = ConstSingleton<HedgePolicyImpl>;
 
@@ -716,6 +733,7 @@ public:
 
   const PathMatcherSharedPtr& pathMatcher() const override { return path_matcher_; }
   const PathRewriterSharedPtr& pathRewriter() const override { return path_rewriter_; }
+  bool case_sensitive() const { return case_sensitive_; }
 
   uint32_t retryShadowBufferLimit() const override { return retry_shadow_buffer_limit_; }
   const std::vector<ShadowPolicyPtr>& shadowPolicies() const override { return shadow_policies_; }
@@ -1049,7 +1067,6 @@ protected:
   const std::string host_rewrite_;
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    uint64_t random_value) const;
 
@@ -1332,8 +1349,14 @@ public:
   absl::optional<std::string>
   currentUrlPathAfterRewrite(const Http::RequestHeaderMap& headers) const override;
 
+  /**
+   * @return true if the path regex is evaluated by RE2.
+   */
+  bool usesGoogleRe2() const { return uses_google_re2_; }
+
 private:
   const Matchers::PathMatcherConstSharedPtr path_matcher_;
+  const bool uses_google_re2_;
 };
 
 /**
@@ -1465,9 +1488,10 @@ class RouteMatcher {
 public:
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const OptionalHttpFilters& optional_http_filters,
-               const ConfigImpl& global_http_config,
+               const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
-               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               bool reuse_virtual_hosts, const RouteMatcher* previous_route_matcher);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1477,14 +1501,17 @@ public:
 private:
   using WildcardVirtualHosts =
       std::map<int64_t, absl::node_hash_map<std::string, VirtualHostSharedPtr>, std::greater<>>;
-  using SubstringFunction = std::function<std::string(const std::string&, int)>;
-  const VirtualHostImpl* findWildcardVirtualHost(const std::string& host,
+  using SubstringFunction = absl::string_view (*)(absl::string_view, size_t);
+  const VirtualHostImpl* findWildcardVirtualHost(absl::string_view host,
                                                  const WildcardVirtualHosts& wildcard_virtual_hosts,
                                                  SubstringFunction substring_function) const;
   bool ignorePortInHostMatching() const { return ignore_port_in_host_matching_; }
 
   Stats::ScopeSharedPtr vhost_scope_;
   absl::node_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_;
+  // All virtual hosts by hash of their config, so the next version of the route configuration can
+  // reuse the unchanged ones. Only populated if virtual hosts can be reused.
+  absl::flat_hash_map<uint64_t, VirtualHostSharedPtr> virtual_hosts_by_hash_;
   // std::greater as a minor optimization to iterate from more to less specific
   //
   // A note on using an unordered_map versus a vector of (string, VirtualHostSharedPtr) pairs:
@@ -1502,14 +1529,16 @@ private:
 };
 
 /**
- * Implementation of Config that reads from a proto file.
+ * The settings of a RouteConfiguration that are shared by all of its virtual hosts. They are kept
+ * apart from the virtual hosts so that a new version of the route configuration with the same
+ * settings can reuse the unchanged virtual hosts of the previous version.
  */
-class ConfigImpl : public Config {
+class CommonConfigImpl : public CommonConfig {
 public:
-  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
-             const OptionalHttpFilters& optional_http_filters,
-             Server::Configuration::ServerFactoryContext& factory_context,
-             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+  CommonConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                   const OptionalHttpFilters& optional_http_filters,
+                   Server::Configuration::ServerFactoryContext& factory_context,
+                   ProtobufMessage::ValidationVisitor& validator);
 
   const HeaderParser& requestHeaderParser() const {
     if (request_headers_parser_ != nullptr) {
@@ -1524,25 +1553,18 @@ public:
     return HeaderParser::defaultParser();
   }
 
-  bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
-    return route_matcher_->findVirtualHost(headers) != nullptr;
-  }
-
   const RouteSpecificFilterConfig* perFilterConfig(const std::string& name) const {
     return per_filter_configs_.get(name);
   }
 
-  // Router::Config
-  RouteConstSharedPtr route(const Http::RequestHeaderMap& headers,
-                            const StreamInfo::StreamInfo& stream_info,
-                            uint64_t random_value) const override {
-    return route(nullptr, headers, stream_info, random_value);
-  }
+  const std::vector<ShadowPolicyPtr>& shadowPolicies() const { return shadow_policies_; }
 
-  RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
-                            const StreamInfo::StreamInfo& stream_info,
-                            uint64_t random_value) const override;
+  ClusterSpecifierPluginSharedPtr clusterSpecifierPlugin(absl::string_view provider) const;
+  bool ignorePathParametersInPathMatching() const {
+    return ignore_path_parameters_in_path_matching_;
+  }
 
+  // Router::CommonConfig
   const std::list<Http::LowerCaseString>& internalOnlyHeaders() const override {
     return internal_only_headers_;
   }
@@ -1559,15 +1581,7 @@ public:
     return max_direct_response_body_size_bytes_;
   }
 
-  const std::vector<ShadowPolicyPtr>& shadowPolicies() const { return shadow_policies_; }
-
-  ClusterSpecifierPluginSharedPtr clusterSpecifierPlugin(absl::string_view provider) const;
-  bool ignorePathParametersInPathMatching() const {
-    return ignore_path_parameters_in_path_matching_;
-  }
-
 private:
-  std::unique_ptr<RouteMatcher> route_matcher_;
   std::list<Http::LowerCaseString> internal_only_headers_;
   HeaderParserPtr request_headers_parser_;
   HeaderParserPtr response_headers_parser_;
@@ -1584,6 +1598,60 @@ private:
   const bool ignore_path_parameters_in_path_matching_ : 1;
 };
 
+/**
+ * Implementation of Config that reads from a proto file.
+ */
+class ConfigImpl : public Config {
+public:
+  /**
+   * @param previous_config supplies the configuration being replaced, if any. Its virtual hosts
+   *        are reused when neither they nor the settings shared by all virtual hosts changed.
+   */
+  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+             const OptionalHttpFilters& optional_http_filters,
+             Server::Configuration::ServerFactoryContext& factory_context,
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             const ConfigImpl* previous_config = nullptr);
+
+  bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
+    return route_matcher_->findVirtualHost(headers) != nullptr;
+  }
+
+  // Router::Config
+  RouteConstSharedPtr route(const Http::RequestHeaderMap& headers,
+                            const StreamInfo::StreamInfo& stream_info,
+                            uint64_t random_value) const override {
+    return route(nullptr, headers, stream_info, random_value);
+  }
+
+  RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+                            const StreamInfo::StreamInfo& stream_info,
+                            uint64_t random_value) const override;
+
+  const std::list<Http::LowerCaseString>& internalOnlyHeaders() const override {
+    return shared_config_->internalOnlyHeaders();
+  }
+
+  const std::string& name() const override { return shared_config_->name(); }
+
+  bool usesVhds() const override { return shared_config_->usesVhds(); }
+
+  bool mostSpecificHeaderMutationsWins() const override {
+    return shared_config_->mostSpecificHeaderMutationsWins();
+  }
+
+  uint32_t maxDirectResponseBodySizeBytes() const override {
+    return shared_config_->maxDirectResponseBodySizeBytes();
+  }
+
+private:
+  CommonConfigSharedPtr shared_config_;
+  // Hash of the settings the virtual hosts depend on, other than their own config. Only set if the
+  // virtual hosts can be reused by the next version of the route configuration.
+  absl::optional<uint64_t> shared_config_hash_;
+  std::unique_ptr<RouteMatcher> route_matcher_;
+};
+
 /**
  * Implementation of Config that is empty.
  */
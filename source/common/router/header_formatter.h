@@ -83,6 +83,9 @@ public:
     }
     return buf;
   };
+  absl::optional<std::string> constantValue() const override {
+    return formatter_->constantValue();
+  }
 
 private:
   const std::vector<HeaderFormatterPtr> formatters_;
@@ -98,6 +101,12 @@ public:
   virtual const std::string format(const Http::RequestHeaderMap& request_headers,
                                    const Http::ResponseHeaderMap& response_headers,
                                    const Envoy::StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * @return absl::optional<std::string> the formatted value when it is the same for all requests,
+   *         so that it can be formatted once at configuration time.
+   */
+  virtual absl::optional<std::string> constantValue() const { return absl::nullopt; }
 };
 
 using HttpHeaderFormatterPtr = std::unique_ptr<HttpHeaderFormatter>;
@@ -120,6 +129,9 @@ public:
                              *Http::StaticEmptyHeaders::get().response_trailers, stream_info, "");
     return buf;
   };
+  absl::optional<std::string> constantValue() const override {
+    return formatter_->constantValue();
+  }
 
 private:
   const Formatter::FormatterPtr formatter_;
@@ -273,6 +273,7 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_optio
     formatter_ =
         std::make_unique<HttpHeaderFormatterBridge>(parseInternal(header_value_option.header()));
   }
+  constant_value_ = formatter_->constantValue();
 }
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
@@ -284,6 +285,7 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
     // Use "old" implementation of header formatters.
     formatter_ = std::make_unique<HttpHeaderFormatterBridge>(parseInternal(header_value));
   }
+  constant_value_ = formatter_->constantValue();
 }
 
 HeaderParserPtr
@@ -367,11 +369,13 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
   std::string value_buffer;
   for (const auto& [key, entry] : headers_to_add_) {
     absl::string_view value;
-    if (stream_info != nullptr) {
+    if (stream_info == nullptr) {
+      value = entry.original_value_;
+    } else if (entry.constant_value_.has_value()) {
+      value = entry.constant_value_.value();
+    } else {
       value_buffer = entry.formatter_->format(request_headers, response_headers, *stream_info);
       value = value_buffer;
-    } else {
-      value = entry.original_value_;
     }
     if (!value.empty() || entry.add_if_empty_) {
       switch (entry.append_action_) {
@@ -409,8 +413,11 @@ Http::HeaderTransforms HeaderParser::getHeaderTransforms(const StreamInfo::Strea
   for (const auto& [key, entry] : headers_to_add_) {
     if (do_formatting) {
       const std::string value =
-          entry.formatter_->format(*Http::StaticEmptyHeaders::get().request_headers,
-                                   *Http::StaticEmptyHeaders::get().response_headers, stream_info);
+          entry.constant_value_.has_value()
+              ? entry.constant_value_.value()
+              : entry.formatter_->format(*Http::StaticEmptyHeaders::get().request_headers,
+                                         *Http::StaticEmptyHeaders::get().response_headers,
+                                         stream_info);
       if (!value.empty() || entry.add_if_empty_) {
         switch (entry.append_action_) {
         case HeaderValueOption::APPEND_IF_EXISTS_OR_ADD:
@@ -30,6 +30,8 @@ struct HeadersToAddEntry {
   bool add_if_empty_ = false;
 
   HttpHeaderFormatterPtr formatter_;
+  // The value of the header, formatted at configuration time, when it is the same for all requests.
+  absl::optional<std::string> constant_value_;
   HeaderAppendAction append_action_;
 };
 
@@ -110,6 +112,12 @@ public:
   Http::HeaderTransforms getHeaderTransforms(const StreamInfo::StreamInfo& stream_info,
                                              bool do_formatting = true) const;
 
+  /**
+   * @return whether the parser neither adds nor removes any header, in which case evaluating the
+   * headers is a no-op.
+   */
+  bool empty() const { return headers_to_add_.empty() && headers_to_remove_.empty(); }
+
   static std::string translateMetadataFormat(const std::string& header_value);
   static std::string translatePerRequestState(const std::string& header_value);
 
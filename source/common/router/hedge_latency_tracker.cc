@@ -0,0 +1,109 @@
+#include "source/common/router/hedge_latency_tracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Router {
+
+namespace {
+
+// Smallest number of samples between two decays, so that the percentile and the budget account
+// for enough requests to be stable.
+constexpr uint64_t MinSamplesPerDecay = 1000;
+
+// Halves a counter. Concurrent increments are kept, only the value loaded is halved.
+void halve(std::atomic<uint64_t>& counter) {
+  counter.fetch_sub(counter.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+}
+
+} // namespace
+
+HedgeLatencyTrackerImpl::HedgeLatencyTrackerImpl(
+    const envoy::config::route::v3::HedgePolicy::LatencyPercentileHedging& config)
+    : percentile_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, percentile, 95.0)),
+      hedge_budget_percent_(config.has_hedge_budget() ? config.hedge_budget().value() : 10.0),
+      min_samples_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, min_samples, 100)),
+      samples_per_decay_(std::max(MinSamplesPerDecay, 2 * min_samples_)) {}
+
+void HedgeLatencyTrackerImpl::onRequest() {
+  requests_.fetch_add(1, std::memory_order_relaxed);
+  if ((requests_since_decay_.fetch_add(1, std::memory_order_relaxed) + 1) % samples_per_decay_ ==
+      0) {
+    halve(requests_);
+    halve(hedges_);
+  }
+}
+
+void HedgeLatencyTrackerImpl::recordResponseTime(std::chrono::milliseconds response_time) {
+  const uint64_t response_time_ms =
+      std::min<uint64_t>(std::max<int64_t>(response_time.count(), 0), MaxResponseTimeMs);
+  buckets_[bucketIndex(response_time_ms)].fetch_add(1, std::memory_order_relaxed);
+  if ((samples_since_decay_.fetch_add(1, std::memory_order_relaxed) + 1) % samples_per_decay_ ==
+      0) {
+    for (std::atomic<uint64_t>& bucket : buckets_) {
+      halve(bucket);
+    }
+  }
+}
+
+absl::optional<std::chrono::milliseconds> HedgeLatencyTrackerImpl::hedgeDelay() const {
+  uint64_t samples = 0;
+  for (const std::atomic<uint64_t>& bucket : buckets_) {
+    samples += bucket.load(std::memory_order_relaxed);
+  }
+  if (samples < min_samples_) {
+    return absl::nullopt;
+  }
+
+  const uint64_t rank = std::max<uint64_t>(1, std::ceil(samples * percentile_ / 100));
+  uint64_t below = 0;
+  for (uint32_t i = 0; i < NumBuckets; i++) {
+    below += buckets_[i].load(std::memory_order_relaxed);
+    if (below >= rank) {
+      return std::chrono::milliseconds(bucketUpperBoundMs(i));
+    }
+  }
+  // Concurrent decays made the buckets add up to less than they did above.
+  return std::chrono::milliseconds(bucketUpperBoundMs(NumBuckets - 1));
+}
+
+bool HedgeLatencyTrackerImpl::tryAcquireHedge() {
+  // Count the hedge before checking the budget, so that concurrent hedges can't exceed it together.
+  const uint64_t hedges = hedges_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (hedges * 100 > hedge_budget_percent_ * requests_.load(std::memory_order_relaxed)) {
+    hedges_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+uint32_t HedgeLatencyTrackerImpl::bucketIndex(uint64_t response_time_ms) {
+  if (response_time_ms < LinearBuckets) {
+    return response_time_ms;
+  }
+  response_time_ms = std::min(response_time_ms, MaxResponseTimeMs);
+  // The position of the highest bit, at least 4, selects the power of 2; the next SubBucketBits
+  // bits select the bucket within it.
+  const uint32_t exponent = absl::bit_width(response_time_ms) - 1;
+  const uint32_t sub_bucket =
+      (response_time_ms >> (exponent - SubBucketBits)) & ((1U << SubBucketBits) - 1);
+  return LinearBuckets + ((exponent - 4) << SubBucketBits) + sub_bucket;
+}
+
+uint64_t HedgeLatencyTrackerImpl::bucketUpperBoundMs(uint32_t index) {
+  if (index < LinearBuckets) {
+    return index + 1;
+  }
+  const uint32_t exponent = ((index - LinearBuckets) >> SubBucketBits) + 4;
+  const uint64_t sub_bucket = (index - LinearBuckets) & ((1U << SubBucketBits) - 1);
+  const uint64_t width = uint64_t(1) << (exponent - SubBucketBits);
+  return ((1U << SubBucketBits) + sub_bucket) * width + width;
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "envoy/config/route/v3/route_components.pb.h"
+#include "envoy/router/router.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * HedgeLatencyTracker keeping the response times of the route in a histogram with buckets of
+ * logarithmically growing width, 1ms wide up to 16ms and 1/8 of their lower bound wide above. The
+ * percentile is the upper bound of the bucket it falls in, so it overestimates the response time
+ * by at most 12.5%.
+ *
+ * Both the histogram and the hedge budget favour recent requests: every max(1000, 2 * min_samples)
+ * response times the bucket counts are halved, and so are the request and hedge counts every as
+ * many requests. The counters are relaxed atomics updated by all the workers using the route, so
+ * the percentile and the budget are approximate while they are updated concurrently.
+ */
+class HedgeLatencyTrackerImpl : public HedgeLatencyTracker, NonCopyable {
+public:
+  // The response times tracked, longer ones are counted in the last bucket.
+  static constexpr uint64_t MaxResponseTimeMs = (1U << 22) - 1;
+
+  explicit HedgeLatencyTrackerImpl(
+      const envoy::config::route::v3::HedgePolicy::LatencyPercentileHedging& config);
+
+  // Router::HedgeLatencyTracker
+  void onRequest() override;
+  void recordResponseTime(std::chrono::milliseconds response_time) override;
+  absl::optional<std::chrono::milliseconds> hedgeDelay() const override;
+  bool tryAcquireHedge() override;
+
+  // Index of the bucket counting a response time.
+  static uint32_t bucketIndex(uint64_t response_time_ms);
+  // Exclusive upper bound of the response times counted in a bucket.
+  static uint64_t bucketUpperBoundMs(uint32_t index);
+
+private:
+  static constexpr uint32_t LinearBuckets = 16;
+  static constexpr uint32_t SubBucketBits = 3;
+  // The linear buckets, then 8 buckets for each power of 2 from 16 up to MaxResponseTimeMs.
+  static constexpr uint32_t NumBuckets = LinearBuckets + (22 - 4) * (1U << SubBucketBits);
+
+  const double percentile_;
+  const double hedge_budget_percent_;
+  const uint64_t min_samples_;
+  const uint64_t samples_per_decay_;
+  std::array<std::atomic<uint64_t>, NumBuckets> buckets_{};
+  std::atomic<uint64_t> samples_since_decay_{};
+  std::atomic<uint64_t> requests_{};
+  std::atomic<uint64_t> hedges_{};
+  std::atomic<uint64_t> requests_since_decay_{};
+};
+
+using HedgeLatencyTrackerImplPtr = std::unique_ptr<HedgeLatencyTrackerImpl>;
+
+} // namespace Router
+} // namespace Envoy
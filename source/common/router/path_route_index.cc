@@ -0,0 +1,111 @@
+#include "source/common/router/path_route_index.h"
+
+#include <algorithm>
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Router {
+
+PathRouteIndex::PathRouteIndex() = default;
+
+PathRouteIndex::~PathRouteIndex() = default;
+
+void PathRouteIndex::addPrefix(absl::string_view prefix, uint32_t position) {
+  findOrInsert(prefix).prefix_routes_.push_back(position);
+}
+
+void PathRouteIndex::addExact(absl::string_view path, uint32_t position) {
+  findOrInsert(path).exact_routes_.push_back(position);
+}
+
+bool PathRouteIndex::addRegex(const std::string& regex, uint32_t position) {
+  if (regex_set_ == nullptr) {
+    // Anchoring both ends gives the RE2::FullMatch() semantics of the route regex matchers.
+    regex_set_ = std::make_unique<re2::RE2::Set>(re2::RE2::Quiet, re2::RE2::ANCHOR_BOTH);
+  }
+  if (regex_set_->Add(regex, nullptr) < 0) {
+    return false;
+  }
+  regex_routes_.push_back(position);
+  return true;
+}
+
+void PathRouteIndex::addUnindexed(uint32_t position) { unindexed_routes_.push_back(position); }
+
+void PathRouteIndex::compile() {
+  if (regex_set_ != nullptr && !regex_set_->Compile()) {
+    // The combined regexes exceed the RE2 memory budget. Evaluate them one by one instead.
+    unindexed_routes_.insert(unindexed_routes_.end(), regex_routes_.begin(), regex_routes_.end());
+    regex_set_.reset();
+    regex_routes_.clear();
+  }
+}
+
+PathRouteIndex::Node& PathRouteIndex::findOrInsert(absl::string_view literal) {
+  Node* node = &root_;
+  while (!literal.empty()) {
+    std::unique_ptr<Node>& child = node->children_[literal[0]];
+    if (child == nullptr) {
+      child = std::make_unique<Node>();
+      child->label_ = std::string(literal);
+      return *child;
+    }
+
+    const absl::string_view label = child->label_;
+    const size_t common = std::mismatch(label.begin(), label.end(), literal.begin(), literal.end())
+                              .first -
+                          label.begin();
+    if (common < label.size()) {
+      // The literal ends or diverges inside the edge: split it so the literal ends on a node.
+      auto split = std::make_unique<Node>();
+      split->label_ = std::string(label.substr(0, common));
+      child->label_ = std::string(label.substr(common));
+      const char key = child->label_[0];
+      split->children_[key] = std::move(child);
+      child = std::move(split);
+    }
+    node = child.get();
+    literal.remove_prefix(common);
+  }
+  return *node;
+}
+
+PathRouteIndex::Candidates PathRouteIndex::candidates(absl::string_view path) const {
+  const absl::string_view full_path = path;
+  Candidates candidates(unindexed_routes_.begin(), unindexed_routes_.end());
+  const Node* node = &root_;
+  while (true) {
+    candidates.insert(candidates.end(), node->prefix_routes_.begin(), node->prefix_routes_.end());
+    if (path.empty()) {
+      candidates.insert(candidates.end(), node->exact_routes_.begin(), node->exact_routes_.end());
+      break;
+    }
+    const auto it = node->children_.find(path[0]);
+    // Every literal ends on a node, so no route can match once the path leaves the trie.
+    if (it == node->children_.end() || !absl::StartsWith(path, it->second->label_)) {
+      break;
+    }
+    node = it->second.get();
+    path.remove_prefix(node->label_.size());
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> regexes;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(re2::StringPiece(full_path.data(), full_path.size()), &regexes,
+                          &error_info)) {
+      for (const int regex : regexes) {
+        candidates.push_back(regex_routes_[regex]);
+      }
+    } else if (error_info.kind != re2::RE2::Set::kNoError) {
+      // The scan failed, most likely because the DFA ran out of memory: every regex route is a
+      // candidate.
+      candidates.insert(candidates.end(), regex_routes_.begin(), regex_routes_.end());
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the path matchers of an ordered route list, used to avoid evaluating every route of
+ * large virtual hosts. Routes are identified by their position in the list. Prefix and exact path
+ * literals are stored in a compressed trie and RE2 path regexes are compiled into a single
+ * RE2::Set, so a lookup scans the path once for each. Routes whose path matcher can't be indexed
+ * (template, case insensitive, other regex engines, ...) are returned for every path.
+ *
+ * The index only narrows down the routes whose path can match. The candidates are returned in
+ * route order and still have to be fully evaluated, so the first matching route is the same as
+ * with a linear scan.
+ */
+class PathRouteIndex : NonCopyable {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  PathRouteIndex();
+  ~PathRouteIndex();
+
+  /**
+   * Adds a route that can only match paths starting with `prefix`.
+   */
+  void addPrefix(absl::string_view prefix, uint32_t position);
+
+  /**
+   * Adds a route that can only match `path`.
+   */
+  void addExact(absl::string_view path, uint32_t position);
+
+  /**
+   * Adds a route that can only match paths fully matching the RE2 `regex`.
+   * @return false if the regex can't be added to the index, in which case the route must be added
+   *         with addUnindexed().
+   */
+  bool addRegex(const std::string& regex, uint32_t position);
+
+  /**
+   * Adds a route that has to be evaluated for every path.
+   */
+  void addUnindexed(uint32_t position);
+
+  /**
+   * Prepares the index for lookups. It must be called once, after adding all routes.
+   */
+  void compile();
+
+  /**
+   * @param path supplies the path to match, without query, fragment or any other suffix that is
+   *        ignored by the path matchers of the routes.
+   * @return the positions of the routes that may match `path`, in ascending order.
+   */
+  Candidates candidates(absl::string_view path) const;
+
+  /**
+   * @return the number of routes that are returned for every path.
+   */
+  size_t unindexedRoutes() const { return unindexed_routes_.size(); }
+
+private:
+  struct Node {
+    // Literal of the edge leading to this node. It is never empty except for the root.
+    std::string label_;
+    absl::flat_hash_map<char, std::unique_ptr<Node>> children_;
+    std::vector<uint32_t> prefix_routes_;
+    std::vector<uint32_t> exact_routes_;
+  };
+
+  Node& findOrInsert(absl::string_view literal);
+
+  Node root_;
+  std::vector<uint32_t> unindexed_routes_;
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+  // Route positions of the regexes of regex_set_, by regex index.
+  std::vector<uint32_t> regex_routes_;
+};
+
+} // namespace Router
+} // namespace Envoy
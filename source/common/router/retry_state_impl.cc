@@ -76,6 +76,7 @@ RetryStateImpl::RetryStateImpl(const RetryPolicy& route_policy,
       retriable_headers_(route_policy.retriableHeaders()),
       reset_headers_(route_policy.resetHeaders()),
       reset_max_interval_(route_policy.resetMaxInterval()), retry_on_(route_policy.retryOn()),
+      retry_token_bucket_(cluster.resourceManager(priority).retryTokenBucket()),
       retries_remaining_(route_policy.numRetries()), priority_(priority),
       auto_configured_for_http3_(auto_configured_for_http3) {
   if ((cluster.features() & Upstream::ClusterInfo::Features::HTTP3) &&
@@ -160,6 +161,10 @@ RetryStateImpl::RetryStateImpl(const RetryPolicy& route_policy,
           std::make_shared<Http::HeaderUtility::HeaderData>(header_matcher));
     }
   }
+
+  if (retry_on_ != 0 && retry_token_bucket_.has_value()) {
+    retry_token_bucket_->onRequest();
+  }
 }
 
 RetryStateImpl::~RetryStateImpl() { resetRetry(); }
@@ -181,8 +186,13 @@ void RetryStateImpl::enableBackoffTimer() {
     cluster_.trafficStats()->upstream_rq_retry_backoff_ratelimited_.inc();
 
   } else {
-    // Otherwise we use a fully jittered exponential backoff algorithm.
-    retry_timer_->enableTimer(std::chrono::milliseconds(backoff_strategy_->nextBackOffMs()));
+    // Otherwise we use a fully jittered exponential backoff algorithm, which the retry token
+    // bucket of the cluster stretches while its recent attempts fail.
+    uint64_t backoff_ms = backoff_strategy_->nextBackOffMs();
+    if (retry_token_bucket_.has_value()) {
+      backoff_ms *= retry_token_bucket_->backoffMultiplier();
+    }
+    retry_timer_->enableTimer(std::chrono::milliseconds(backoff_ms));
 
     cluster_.trafficStats()->upstream_rq_retry_backoff_exponential_.inc();
   }
@@ -281,6 +291,10 @@ RetryStatus RetryStateImpl::shouldRetry(RetryDecision would_retry, DoRetryCallba
 
   resetRetry();
 
+  if (retry_token_bucket_.has_value()) {
+    retry_token_bucket_->onAttemptComplete(would_retry != RetryDecision::NoRetry);
+  }
+
   if (would_retry == RetryDecision::NoRetry) {
     return RetryStatus::No;
   }
@@ -315,6 +329,19 @@ RetryStatus RetryStateImpl::shouldRetry(RetryDecision would_retry, DoRetryCallba
     return RetryStatus::No;
   }
 
+  if (retry_token_bucket_.has_value() &&
+      !retry_token_bucket_->tryWithdraw(time_source_.monotonicTime())) {
+    cluster_.trafficStats()->upstream_rq_retry_token_bucket_exhausted_.inc();
+    cluster_.trafficStats()->upstream_rq_retry_overflow_.inc();
+    if (vcluster_) {
+      vcluster_->stats().upstream_rq_retry_overflow_.inc();
+    }
+    if (route_stats_context_.has_value()) {
+      route_stats_context_->stats().upstream_rq_retry_overflow_.inc();
+    }
+    return RetryStatus::NoOverflow;
+  }
+
   ASSERT(!backoff_callback_ && !next_loop_callback_);
   cluster_.resourceManager(priority_).retries().inc();
   cluster_.trafficStats()->upstream_rq_retry_.inc();
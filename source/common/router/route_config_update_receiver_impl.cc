@@ -44,9 +44,11 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
                                Server::Configuration::ServerFactoryContext& factory_context,
                                bool validate_clusters_default) const {
   ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
-  return std::make_shared<ConfigImpl>(
+  auto config = std::make_shared<const ConfigImpl>(
       static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc), optional_http_filters_,
-      factory_context, validator_, validate_clusters_default);
+      factory_context, validator_, validate_clusters_default, last_config_.lock().get());
+  last_config_ = config;
+  return config;
 }
 
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "envoy/config/route/v3/route.pb.h"
@@ -32,6 +33,8 @@ public:
 private:
   const OptionalHttpFilters optional_http_filters_;
   ProtobufMessage::ValidationVisitor& validator_;
+  // The last created config, whose unchanged virtual hosts are reused by the next one.
+  mutable std::weak_ptr<const ConfigImpl> last_config_;
 };
 
 class RouteConfigUpdateReceiverImpl : public RouteConfigUpdateReceiver {
@@ -16,6 +16,7 @@
 #include "envoy/upstream/health_check_host_monitor.h"
 #include "envoy/upstream/upstream.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/cleanup.h"
 #include "source/common/common/empty_string.h"
@@ -62,6 +63,37 @@ bool schemeIsHttp(const Http::RequestHeaderMap& downstream_headers,
 
 constexpr uint64_t TimeoutPrecisionFactor = 100;
 
+// A fragment referencing a slice of request data shared by the upstream requests and the shadows.
+class SharedDataFragment : public Buffer::BufferFragment {
+public:
+  SharedDataFragment(std::shared_ptr<const Buffer::Instance> data, Buffer::RawSlice slice)
+      : data_(std::move(data)), slice_(slice) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return slice_.mem_; }
+  size_t size() const override { return slice_.len_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const Buffer::Instance> data_;
+  const Buffer::RawSlice slice_;
+};
+
+// Adds fragments referencing shared to out, instead of copying it.
+void addSharedData(const std::shared_ptr<const Buffer::Instance>& shared, Buffer::Instance& out) {
+  for (const Buffer::RawSlice& slice : shared->getRawSlices()) {
+    out.addBufferFragment(*new SharedDataFragment(shared, slice));
+  }
+}
+
+// Moves the contents of data to immutable storage, leaving fragments referencing it in data.
+std::shared_ptr<const Buffer::Instance> shareData(Buffer::Instance& data) {
+  auto shared = std::make_shared<Buffer::OwnedImpl>();
+  shared->move(data);
+  addSharedData(shared, data);
+  return shared;
+}
+
 } // namespace
 
 // Express percentage as [0, TimeoutPrecisionFactor] because stats do not accept floating point
@@ -262,6 +294,7 @@ FilterUtility::finalHedgingParams(const RouteEntry& route,
                                   Http::RequestHeaderMap& request_headers) {
   HedgingParams hedging_params;
   hedging_params.hedge_on_per_try_timeout_ = route.hedgePolicy().hedgeOnPerTryTimeout();
+  hedging_params.hedge_on_latency_percentile_ = false;
 
   const Http::HeaderEntry* hedge_on_per_try_timeout_entry =
       request_headers.EnvoyHedgeOnPerTryTimeout();
@@ -366,6 +399,7 @@ void Filter::chargeUpstreamCode(uint64_t response_status_code,
     }
     if (upstream_host && Http::CodeUtility::is5xx(response_status_code)) {
       upstream_host->stats().rq_error_.inc();
+      upstream_host->localityLoadStats().incRqError();
     }
   }
 }
@@ -623,6 +657,23 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
   timeout_ = FilterUtility::finalTimeout(*route_entry_, headers, !config_.suppress_envoy_headers_,
                                          grpc_request_, hedging_params_.hedge_on_per_try_timeout_,
                                          config_.respect_expected_rq_timeout_);
+  if (hedging_params_.hedge_on_per_try_timeout_) {
+    hedge_latency_tracker_ = route_entry_->hedgePolicy().latencyTracker();
+  }
+  if (hedge_latency_tracker_ != nullptr) {
+    hedge_latency_tracker_->onRequest();
+    // The percentile replaces the per try timeout when it is shorter, and the remaining timeouts
+    // still bound it.
+    const absl::optional<std::chrono::milliseconds> hedge_delay =
+        hedge_latency_tracker_->hedgeDelay();
+    if (hedge_delay.has_value() &&
+        (timeout_.per_try_timeout_.count() == 0 ||
+         hedge_delay.value() < timeout_.per_try_timeout_) &&
+        (timeout_.global_timeout_.count() == 0 || hedge_delay.value() < timeout_.global_timeout_)) {
+      timeout_.per_try_timeout_ = hedge_delay.value();
+      hedging_params_.hedge_on_latency_percentile_ = true;
+    }
+  }
 
   const Http::HeaderEntry* header_max_stream_duration_entry =
       headers.EnvoyUpstreamStreamDurationMs();
@@ -701,6 +752,7 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
       !transport_socket_options_ || !transport_socket_options_->http11ProxyInfo().has_value();
   UpstreamRequestPtr upstream_request = std::make_unique<UpstreamRequest>(
       *this, std::move(generic_conn_pool), can_send_early_data, can_use_http3);
+  maybeSetStreamDeadline(*upstream_request, end_stream);
   LinkedList::moveIntoList(std::move(upstream_request), upstream_requests_);
   upstream_requests_.front()->acceptHeadersFromRouter(end_stream);
   if (streaming_shadows_) {
@@ -811,6 +863,7 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
     retry_state_.reset();
     buffering = false;
     active_shadow_policies_.clear();
+    shared_request_body_.clear();
     request_buffer_overflowed_ = true;
 
     // If we had to abandon buffering and there's no request in progress, abort the request and
@@ -830,12 +883,30 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
   // already.
   ASSERT(buffering || !upstream_requests_.empty());
 
+  // The data sent to several places is stored once, and referenced by each of them.
+  std::shared_ptr<const Buffer::Instance> shared_data;
+  if ((buffering || !shadow_streams_.empty()) &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_share_request_body")) {
+    shared_data = shareData(data);
+    if (buffering) {
+      shared_request_body_.push_back(shared_data);
+    }
+  }
+  const auto copy_data = [&data, &shared_data](Buffer::Instance& copy) {
+    if (shared_data != nullptr) {
+      addSharedData(shared_data, copy);
+    } else {
+      copy.add(data);
+    }
+  };
+
   for (auto* shadow_stream : shadow_streams_) {
     if (end_stream) {
       shadow_stream->removeDestructorCallback();
       shadow_stream->removeWatermarkCallbacks();
     }
-    Buffer::OwnedImpl copy(data);
+    Buffer::OwnedImpl copy;
+    copy_data(copy);
     shadow_stream->sendData(copy, end_stream);
   }
   if (end_stream) {
@@ -843,7 +914,8 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
   }
   if (buffering) {
     if (!upstream_requests_.empty()) {
-      Buffer::OwnedImpl copy(data);
+      Buffer::OwnedImpl copy;
+      copy_data(copy);
       upstream_requests_.front()->acceptDataFromRouter(copy, end_stream);
     }
 
@@ -959,7 +1031,7 @@ void Filter::maybeDoShadowing() {
     Http::RequestMessagePtr request(new Http::RequestMessageImpl(
         Http::createHeaderMap<Http::RequestHeaderMapImpl>(*shadow_headers_)));
     if (callbacks_->decodingBuffer()) {
-      request->body().add(*callbacks_->decodingBuffer());
+      copyBufferedRequestBody(request->body());
     }
     if (shadow_trailers_) {
       request->trailers(Http::createHeaderMap<Http::RequestTrailerMapImpl>(*shadow_trailers_));
@@ -979,6 +1051,22 @@ void Filter::maybeDoShadowing() {
   }
 }
 
+void Filter::copyBufferedRequestBody(Buffer::Instance& copy) {
+  const Buffer::Instance& buffered = *callbacks_->decodingBuffer();
+  uint64_t shared_length = 0;
+  for (const auto& shared : shared_request_body_) {
+    shared_length += shared->length();
+  }
+  // The buffered body is only made of the shared data if nothing else was added to it.
+  if (shared_length != buffered.length()) {
+    copy.add(buffered);
+    return;
+  }
+  for (const auto& shared : shared_request_body_) {
+    addSharedData(shared, copy);
+  }
+}
+
 void Filter::onRequestComplete() {
   // This should be called exactly once, when the downstream request has been received in full.
   ASSERT(!downstream_end_stream_);
@@ -1063,10 +1151,19 @@ void Filter::onResponseTimeout() {
 // (hedge_on_per_try_timeout enabled).
 void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
   // Track this as a timeout for outlier detection purposes even though we didn't
-  // cancel the request yet and might get a 2xx later.
-  updateOutlierDetection(Upstream::Outlier::Result::LocalOriginTimeout, upstream_request,
-                         absl::optional<uint64_t>(enumToInt(timeout_response_code_)));
-  upstream_request.outlierDetectionTimeoutRecorded(true);
+  // cancel the request yet and might get a 2xx later. A try slower than the hedging percentile
+  // isn't a timeout: the percentile is exceeded by design.
+  if (!hedging_params_.hedge_on_latency_percentile_) {
+    updateOutlierDetection(Upstream::Outlier::Result::LocalOriginTimeout, upstream_request,
+                           absl::optional<uint64_t>(enumToInt(timeout_response_code_)));
+    upstream_request.outlierDetectionTimeoutRecorded(true);
+  }
+
+  if (hedge_latency_tracker_ != nullptr && !downstream_response_started_ && retry_state_ &&
+      !hedge_latency_tracker_->tryAcquireHedge()) {
+    ENVOY_STREAM_LOG(debug, "not hedging the request: hedge budget exceeded", *callbacks_);
+    return;
+  }
 
   if (!downstream_response_started_ && retry_state_) {
     RetryStatus retry_status = retry_state_->shouldHedgeRetryPerTryTimeout(
@@ -1172,6 +1269,7 @@ void Filter::chargeUpstreamAbort(Http::Code code, bool dropped, UpstreamRequest&
   if (downstream_response_started_) {
     if (upstream_request.grpcRqSuccessDeferred()) {
       upstream_request.upstreamHost()->stats().rq_error_.inc();
+      upstream_request.upstreamHost()->localityLoadStats().incRqError();
       stats_.rq_reset_after_downstream_response_started_.inc();
     }
   } else {
@@ -1184,6 +1282,7 @@ void Filter::chargeUpstreamAbort(Http::Code code, bool dropped, UpstreamRequest&
     // assume values such as 204 (NoContent).
     if (upstream_host != nullptr && !Http::CodeUtility::is5xx(enumToInt(code))) {
       upstream_host->stats().rq_error_.inc();
+      upstream_host->localityLoadStats().incRqError();
     }
   }
 }
@@ -1256,6 +1355,7 @@ bool Filter::maybeRetryReset(Http::StreamResetReason reset_reason,
 
     if (upstream_request.upstreamHost()) {
       upstream_request.upstreamHost()->stats().rq_error_.inc();
+      upstream_request.upstreamHost()->localityLoadStats().incRqError();
     }
 
     auto request_ptr = upstream_request.removeFromList(upstream_requests_);
@@ -1368,14 +1468,17 @@ void Filter::handleNon5xxResponseHeaders(absl::optional<Grpc::Status::GrpcStatus
     if (end_stream) {
       if (grpc_status && !Http::CodeUtility::is5xx(grpc_to_http_status)) {
         upstream_request.upstreamHost()->stats().rq_success_.inc();
+        upstream_request.upstreamHost()->localityLoadStats().incRqSuccess();
       } else {
         upstream_request.upstreamHost()->stats().rq_error_.inc();
+        upstream_request.upstreamHost()->localityLoadStats().incRqError();
       }
     } else {
       upstream_request.grpcRqSuccessDeferred(true);
     }
   } else {
     upstream_request.upstreamHost()->stats().rq_success_.inc();
+    upstream_request.upstreamHost()->localityLoadStats().incRqSuccess();
   }
 }
 
@@ -1490,6 +1593,7 @@ void Filter::onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPt
         runRetryOptionsPredicates(upstream_request);
         pending_retries_++;
         upstream_request.upstreamHost()->stats().rq_error_.inc();
+        upstream_request.upstreamHost()->localityLoadStats().incRqError();
         Http::CodeStats& code_stats = httpContext().codeStats();
         code_stats.chargeBasicResponseStat(cluster_->statsScope(), stats_.stat_names_.retry_,
                                            static_cast<Http::Code>(response_code),
@@ -1526,6 +1630,7 @@ void Filter::onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPt
   // chance to return before returning a response downstream.
   if (could_not_retry && (numRequestsAwaitingHeaders() > 0 || pending_retries_ > 0)) {
     upstream_request.upstreamHost()->stats().rq_error_.inc();
+    upstream_request.upstreamHost()->localityLoadStats().incRqError();
 
     // Reset the stream because there are other in-flight requests that we'll
     // wait around for and we're not interested in consuming any body/trailers.
@@ -1597,6 +1702,7 @@ void Filter::onUpstreamData(Buffer::Instance& data, UpstreamRequest& upstream_re
     // gRPC request termination without trailers is an error.
     if (upstream_request.grpcRqSuccessDeferred()) {
       upstream_request.upstreamHost()->stats().rq_error_.inc();
+      upstream_request.upstreamHost()->localityLoadStats().incRqError();
     }
     onUpstreamComplete(upstream_request);
   }
@@ -1616,8 +1722,10 @@ void Filter::onUpstreamTrailers(Http::ResponseTrailerMapPtr&& trailers,
     if (grpc_status &&
         !Http::CodeUtility::is5xx(Grpc::Utility::grpcToHttpStatus(grpc_status.value()))) {
       upstream_request.upstreamHost()->stats().rq_success_.inc();
+      upstream_request.upstreamHost()->localityLoadStats().incRqSuccess();
     } else {
       upstream_request.upstreamHost()->stats().rq_error_.inc();
+      upstream_request.upstreamHost()->localityLoadStats().incRqError();
     }
   }
 
@@ -1644,6 +1752,11 @@ void Filter::onUpstreamComplete(UpstreamRequest& upstream_request) {
         FilterUtility::percentageOfTimeout(response_time, timeout_.global_timeout_));
   }
 
+  if (hedge_latency_tracker_ != nullptr &&
+      DateUtil::timePointValid(downstream_request_complete_time_)) {
+    hedge_latency_tracker_->recordResponseTime(response_time);
+  }
+
   if (config_.emit_dynamic_stats_ && !callbacks_->streamInfo().healthCheck() &&
       DateUtil::timePointValid(downstream_request_complete_time_)) {
     upstream_request.upstreamHost()->outlierDetector().putResponseTime(response_time);
@@ -1792,7 +1905,9 @@ bool Filter::convertRequestHeadersForInternalRedirect(Http::RequestHeaderMap& do
   downstream_headers.setHost(absolute_url.hostAndPort());
 
   auto path_and_query = absolute_url.pathAndQueryParams();
-  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_reject_path_with_fragment")) {
+  static const Runtime::RuntimeFeature reject_path_with_fragment(
+      "envoy.reloadable_features.http_reject_path_with_fragment");
+  if (reject_path_with_fragment.enabled()) {
     // Envoy treats internal redirect as a new request and will reject it if URI path
     // contains #fragment. However the Location header is allowed to have #fragment in URI path. To
     // prevent Envoy from rejecting internal redirect, strip the #fragment from Location URI if it
@@ -1858,6 +1973,23 @@ void Filter::runRetryOptionsPredicates(UpstreamRequest& retriable_request) {
   }
 }
 
+void Filter::maybeSetStreamDeadline(UpstreamRequest& upstream_request, bool end_stream) {
+  static const Runtime::RuntimeFeature deadline_shedding(
+      "envoy.reloadable_features.conn_pool_deadline_shedding");
+  if (timeout_.global_timeout_.count() == 0 || !deadline_shedding.enabled()) {
+    return;
+  }
+  // The global timeout starts when the downstream request is complete, which is right after the
+  // headers are sent upstream for a headers only request.
+  if (downstream_end_stream_) {
+    upstream_request.setStreamDeadline(downstream_request_complete_time_ +
+                                       timeout_.global_timeout_);
+  } else if (end_stream) {
+    upstream_request.setStreamDeadline(callbacks_->dispatcher().timeSource().monotonicTime() +
+                                       timeout_.global_timeout_);
+  }
+}
+
 void Filter::doRetry(bool can_send_early_data, bool can_use_http3, TimeoutRetry is_timeout_retry) {
   ENVOY_STREAM_LOG(debug, "performing retry", *callbacks_);
 
@@ -1882,6 +2014,7 @@ void Filter::doRetry(bool can_send_early_data, bool can_use_http3, TimeoutRetry
   }
   UpstreamRequestPtr upstream_request = std::make_unique<UpstreamRequest>(
       *this, std::move(generic_conn_pool), can_send_early_data, can_use_http3);
+  maybeSetStreamDeadline(*upstream_request, false);
 
   if (include_attempt_count_in_request_) {
     downstream_headers_->setEnvoyAttemptCount(attempt_count_);
@@ -1916,7 +2049,8 @@ void Filter::doRetry(bool can_send_early_data, bool can_use_http3, TimeoutRetry
   if (!upstream_requests_.empty() && (upstream_requests_.front().get() == upstream_request_tmp)) {
     if (callbacks_->decodingBuffer()) {
       // If we are doing a retry we need to make a copy.
-      Buffer::OwnedImpl copy(*callbacks_->decodingBuffer());
+      Buffer::OwnedImpl copy;
+      copyBufferedRequestBody(copy);
       upstream_requests_.front()->acceptDataFromRouter(copy, !downstream_trailers_ &&
                                                                  downstream_end_stream_);
     }
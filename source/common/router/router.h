@@ -63,6 +63,8 @@ public:
 
   struct HedgingParams {
     bool hedge_on_per_try_timeout_ : 1;
+    // Whether the per try timeout is a percentile of the recent response times of the route.
+    bool hedge_on_latency_percentile_ : 1;
   };
 
   class StrictHeaderChecker {
@@ -577,6 +579,9 @@ private:
                                                      const Http::HeaderMap& headers) const;
 
   void maybeDoShadowing();
+  // Copies the request body buffered for retries and shadows to copy, referencing its shared data
+  // rather than copying it when possible.
+  void copyBufferedRequestBody(Buffer::Instance& copy);
   bool maybeRetryReset(Http::StreamResetReason reset_reason, UpstreamRequest& upstream_request,
                        TimeoutRetry is_timeout_retry);
   uint32_t numRequestsAwaitingHeaders();
@@ -607,6 +612,8 @@ private:
   void updateOutlierDetection(Upstream::Outlier::Result result, UpstreamRequest& upstream_request,
                               absl::optional<uint64_t> code);
   void doRetry(bool can_send_early_data, bool can_use_http3, TimeoutRetry is_timeout_retry);
+  // Passes the deadline of the global timeout to the connection pool, once it is known.
+  void maybeSetStreamDeadline(UpstreamRequest& upstream_request, bool end_stream);
   void runRetryOptionsPredicates(UpstreamRequest& retriable_request);
   // Called immediately after a non-5xx header is received from upstream, performs stats accounting
   // and handle difference between gRPC and non-gRPC requests.
@@ -648,6 +655,9 @@ private:
   Network::Socket::OptionsSharedPtr upstream_options_;
   // Set of ongoing shadow streams which have not yet received end stream.
   absl::flat_hash_set<Http::AsyncClient::OngoingRequest*> shadow_streams_;
+  // The immutable data of the request body buffered for retries and shadows, referenced by the
+  // buffered body and by the bodies sent upstream.
+  std::vector<std::shared_ptr<const Buffer::Instance>> shared_request_body_;
 
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   uint32_t retry_shadow_buffer_limit_{std::numeric_limits<uint32_t>::max()};
@@ -655,6 +665,8 @@ private:
   uint32_t pending_retries_{0};
   Http::Code timeout_response_code_ = Http::Code::GatewayTimeout;
   FilterUtility::HedgingParams hedging_params_;
+  // Set if the requests of the route are hedged from the percentiles of its response times.
+  HedgeLatencyTracker* hedge_latency_tracker_{};
   bool grpc_request_ : 1;
   bool exclude_http_code_stats_ : 1;
   bool downstream_1xx_headers_encoded_ : 1;
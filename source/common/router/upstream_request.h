@@ -103,6 +103,9 @@ public:
 
   void resetStream();
   void setupPerTryTimeout();
+  // Sets the time after which the router times out the request, for the connection pool to shed
+  // the stream rather than attach it to a connection past that time.
+  void setStreamDeadline(MonotonicTime deadline) { stream_options_.deadline_ = deadline; }
   void maybeEndDecode(bool end_stream);
   void onUpstreamHostSelected(Upstream::HostDescriptionConstSharedPtr host);
 
@@ -0,0 +1,45 @@
+#include "source/common/runtime/registered_key.h"
+
+#include "source/common/common/macros.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Runtime {
+
+namespace {
+
+class KeyRegistry {
+public:
+  static KeyRegistry& get() { MUTABLE_CONSTRUCT_ON_FIRST_USE(KeyRegistry); }
+
+  uint32_t add(const std::string& name) {
+    absl::MutexLock lock(&mutex_);
+    auto [it, inserted] = indexes_.try_emplace(name, names_.size());
+    if (inserted) {
+      names_.push_back(name);
+    }
+    return it->second;
+  }
+
+  std::vector<std::string> names() {
+    absl::MutexLock lock(&mutex_);
+    return names_;
+  }
+
+private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, uint32_t> indexes_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::string> names_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace
+
+RegisteredKey::RegisteredKey(absl::string_view name)
+    : name_(name), index_(KeyRegistry::get().add(name_)) {}
+
+std::vector<std::string> RegisteredKey::registeredNames() { return KeyRegistry::get().names(); }
+
+} // namespace Runtime
+} // namespace Envoy
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Runtime {
+
+/**
+ * A runtime key registered ahead of the snapshots, which look it up once when they are created
+ * rather than hashing it each time it is read. Intended for the keys read for every request,
+ * declared as statics of the code reading them. Keys registered after a snapshot was created are
+ * looked up by name in that snapshot.
+ */
+class RegisteredKey {
+public:
+  explicit RegisteredKey(absl::string_view name);
+
+  /**
+   * @return const std::string& the name of the key.
+   */
+  const std::string& name() const { return name_; }
+
+  /**
+   * @return uint32_t the index of the key, which registering the same name again reuses.
+   */
+  uint32_t index() const { return index_; }
+
+  /**
+   * @return std::vector<std::string> the names of the keys registered so far, by index.
+   */
+  static std::vector<std::string> registeredNames();
+
+private:
+  const std::string name_;
+  const uint32_t index_;
+};
+
+} // namespace Runtime
+} // namespace Envoy
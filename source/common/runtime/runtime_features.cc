@@ -36,18 +36,23 @@ RUNTIME_GUARD(envoy_reloadable_features_closer_shadow_behavior);
 RUNTIME_GUARD(envoy_reloadable_features_conn_pool_delete_when_idle);
 RUNTIME_GUARD(envoy_reloadable_features_correct_remote_address);
 RUNTIME_GUARD(envoy_reloadable_features_delta_xds_subscription_state_tracking_fix);
+RUNTIME_GUARD(envoy_reloadable_features_direct_json_access_log_formatter);
 RUNTIME_GUARD(envoy_reloadable_features_do_not_count_mapped_pages_as_free);
+RUNTIME_GUARD(envoy_reloadable_features_eds_skip_unchanged_assignments);
 RUNTIME_GUARD(envoy_reloadable_features_enable_compression_bomb_protection);
 RUNTIME_GUARD(envoy_reloadable_features_enable_intermediate_ca);
 RUNTIME_GUARD(envoy_reloadable_features_enable_update_listener_socket_options);
 RUNTIME_GUARD(envoy_reloadable_features_finish_reading_on_decode_trailers);
 RUNTIME_GUARD(envoy_reloadable_features_fix_hash_key);
 RUNTIME_GUARD(envoy_reloadable_features_format_ports_as_numbers);
+RUNTIME_GUARD(envoy_reloadable_features_grpc_json_transcoder_stream_http_body_requests);
+RUNTIME_GUARD(envoy_reloadable_features_http1_release_parser_on_upgrade);
 RUNTIME_GUARD(envoy_reloadable_features_http2_decode_metadata_with_quiche);
 RUNTIME_GUARD(envoy_reloadable_features_http2_validate_authority_with_quiche);
 RUNTIME_GUARD(envoy_reloadable_features_http_filter_avoid_reentrant_local_reply);
 RUNTIME_GUARD(envoy_reloadable_features_http_reject_path_with_fragment);
 RUNTIME_GUARD(envoy_reloadable_features_http_response_half_close);
+RUNTIME_GUARD(envoy_reloadable_features_http_stream_free_list);
 RUNTIME_GUARD(envoy_reloadable_features_http_strip_fragment_from_path_unsafe_if_disabled);
 RUNTIME_GUARD(envoy_reloadable_features_initialize_upstream_filters);
 RUNTIME_GUARD(envoy_reloadable_features_no_extension_lookup_by_name);
@@ -55,20 +60,31 @@ RUNTIME_GUARD(envoy_reloadable_features_no_full_scan_certs_on_sni_mismatch);
 RUNTIME_GUARD(envoy_reloadable_features_oauth_header_passthrough_fix);
 RUNTIME_GUARD(envoy_reloadable_features_oauth_use_url_encoding);
 RUNTIME_GUARD(envoy_reloadable_features_original_dst_rely_on_idle_timeout);
+RUNTIME_GUARD(envoy_reloadable_features_parallel_xds_resource_decoding);
+RUNTIME_GUARD(envoy_reloadable_features_propagate_untraced_context);
+RUNTIME_GUARD(envoy_reloadable_features_quic_batch_packet_processing);
 RUNTIME_GUARD(envoy_reloadable_features_quic_defer_logging_to_ack_listener);
 RUNTIME_GUARD(envoy_reloadable_features_quic_defer_send_in_response_to_packet);
+RUNTIME_GUARD(envoy_reloadable_features_rbac_policy_index);
 RUNTIME_GUARD(envoy_reloadable_features_reject_require_client_certificate_with_quic);
+RUNTIME_GUARD(envoy_reloadable_features_reuse_unchanged_virtual_hosts);
+RUNTIME_GUARD(envoy_reloadable_features_route_path_index);
+RUNTIME_GUARD(envoy_reloadable_features_router_share_request_body);
 RUNTIME_GUARD(envoy_reloadable_features_shard_ringhash);
 RUNTIME_GUARD(envoy_reloadable_features_skip_dns_lookup_for_proxied_requests);
+RUNTIME_GUARD(envoy_reloadable_features_sni_dfp_circuit_breaker_on_cache_load);
 RUNTIME_GUARD(envoy_reloadable_features_successful_active_health_check_uneject_host);
 RUNTIME_GUARD(envoy_reloadable_features_tcp_pool_idle_timeout);
 RUNTIME_GUARD(envoy_reloadable_features_test_feature_true);
 RUNTIME_GUARD(envoy_reloadable_features_thrift_allow_negative_field_ids);
 RUNTIME_GUARD(envoy_reloadable_features_thrift_connection_draining);
 RUNTIME_GUARD(envoy_reloadable_features_tls_async_cert_validation);
+RUNTIME_GUARD(envoy_reloadable_features_tls_client_session_keys_per_server_name);
+RUNTIME_GUARD(envoy_reloadable_features_tls_inspector_native_client_hello_parser);
 RUNTIME_GUARD(envoy_reloadable_features_udp_proxy_connect);
 RUNTIME_GUARD(envoy_reloadable_features_unified_header_formatter);
 RUNTIME_GUARD(envoy_reloadable_features_upstream_wait_for_response_headers_before_disabling_read);
+RUNTIME_GUARD(envoy_reloadable_features_user_space_activate_in_current_iteration);
 RUNTIME_GUARD(envoy_reloadable_features_validate_connect);
 RUNTIME_GUARD(envoy_reloadable_features_validate_detailed_override_host_statuses);
 RUNTIME_GUARD(envoy_restart_features_explicit_wildcard_resource);
@@ -99,6 +115,48 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_always_use_v6);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_no_delay_close_for_upgrades);
 // TODO(pradeepcrao) reset this to true after 2 releases (1.27)
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_enable_include_histograms);
+// Off by default until the extra memory held by long lived streams has been evaluated.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http_header_map_arena);
+// Off by default as the filters skipped on the route first matched by a stream are not added back
+// if its route is recomputed later on.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_skip_route_disabled_http_filters);
+// Off by default until the latency added to streams that encode between dispatches is measured on
+// busy connections.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_coalesce_writes);
+// Off by default until the record packing improvement has been confirmed with
+// tls_throughput_benchmark on production like buffers.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_tls_gather_write_slices);
+// Off by default until the memory used by the per-thread buckets of histograms recorded on many
+// workers has been measured.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_atomic_histogram_buckets);
+// Off by default until stats backends have been checked to handle metrics missing from some
+// flushes.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_delta_stats_flush);
+// Off by default since weighted round robin picks become weighted random with the alias table.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_round_robin_alias_table);
+// Off by default since weighted picks no longer restart from a new schedule after updates.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_edf_lb_incremental_refresh);
+// Off by default since predictive preconnect then keeps more connections open after bursts.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_predictive_preconnect_recent_peak);
+// Off by default since streams past their deadline then fail with an overflow rather than a
+// timeout.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_conn_pool_deadline_shedding);
+// Off by default since the errors of the lazily loaded JSON Objects don't have line numbers.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_lazy_json_loader);
+// Off by default since the traffic stats of a cluster then aren't reported until it sees traffic.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_defer_cluster_traffic_stats);
+// Off by default since the alternate protocols and HTTP/3 status of an origin learned on one worker
+// then apply to all the workers.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_share_http_server_properties_across_workers);
+// Off by default while coalescing the thread local updates of the clusters of a CDS update gets
+// more production time.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_batch_cds_thread_local_updates);
+// Off by default while the lock-free post queue of the dispatchers gets more production time.
+// Dispatchers latch it at creation, so the main dispatcher only sees the default value.
+FALSE_RUNTIME_GUARD(envoy_restart_features_lock_free_dispatcher_post);
+// Off by default while the timer wheel gets more production time. Dispatchers latch it at
+// creation, so the main dispatcher only sees the default value.
+FALSE_RUNTIME_GUARD(envoy_restart_features_scaled_timer_wheel);
 
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
@@ -172,6 +230,17 @@ bool runtimeFeatureEnabled(absl::string_view feature) {
   return flag->TryGet<bool>().value();
 }
 
+RuntimeFeature::RuntimeFeature(absl::string_view feature)
+    : feature_(feature), flag_(RuntimeFeaturesDefaults::get().getFlag(feature)) {}
+
+bool RuntimeFeature::enabled() const {
+  if (flag_ == nullptr) {
+    IS_ENVOY_BUG(absl::StrCat("Unable to find runtime feature ", feature_));
+    return false;
+  }
+  return flag_->TryGet<bool>().value();
+}
+
 uint64_t getInteger(absl::string_view feature, uint64_t default_value) {
   // DO NOT ADD MORE FLAGS HERE. This function deprecated.
   if (absl::StartsWith(feature, "re2.")) {
@@ -16,6 +16,25 @@ namespace Runtime {
 bool hasRuntimePrefix(absl::string_view feature);
 bool isRuntimeFeature(absl::string_view feature);
 bool runtimeFeatureEnabled(absl::string_view feature);
+
+/**
+ * A runtime feature looked up by name once, so that checking it doesn't hash its name. Intended to
+ * be a function local static of the code checking the feature for every request, e.g.
+ *
+ *   static const Runtime::RuntimeFeature feature("envoy.reloadable_features.my_feature_name");
+ *   if (feature.enabled()) {
+ */
+class RuntimeFeature {
+public:
+  explicit RuntimeFeature(absl::string_view feature);
+
+  bool enabled() const;
+
+private:
+  const std::string feature_;
+  absl::CommandLineFlag* const flag_;
+};
+
 uint64_t getInteger(absl::string_view feature, uint64_t default_value);
 
 void markRuntimeInitialized();
@@ -105,8 +105,26 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
 }
 
 bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value) const {
+  return percentEnabled(getInteger(key, default_value));
+}
+
+bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
+                                  uint64_t random_value) const {
+  return featureEnabled(key, default_value, random_value, 100);
+}
+
+bool SnapshotImpl::featureEnabled(const RegisteredKey& key, uint64_t default_value) const {
+  return percentEnabled(getInteger(key, default_value));
+}
+
+bool SnapshotImpl::featureEnabled(const RegisteredKey& key, uint64_t default_value,
+                                  uint64_t random_value) const {
+  return random_value % 100 < std::min(getInteger(key, default_value), static_cast<uint64_t>(100));
+}
+
+bool SnapshotImpl::percentEnabled(uint64_t percent) const {
   // Avoid PRNG if we know we don't need it.
-  uint64_t cutoff = std::min(getInteger(key, default_value), static_cast<uint64_t>(100));
+  uint64_t cutoff = std::min(percent, static_cast<uint64_t>(100));
   if (cutoff == 0) {
     return false;
   } else if (cutoff == 100) {
@@ -116,11 +134,6 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value)
   }
 }
 
-bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
-                                  uint64_t random_value) const {
-  return featureEnabled(key, default_value, random_value, 100);
-}
-
 Snapshot::ConstStringOptRef SnapshotImpl::get(absl::string_view key) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
   auto entry = key.empty() ? values_.end() : values_.find(key);
@@ -177,11 +190,21 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 
 uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
   ASSERT(!isRuntimeFeature(key));
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.uint_value_) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->uint_value_) {
     return default_value;
   } else {
-    return entry->second.uint_value_.value();
+    return entry->uint_value_.value();
+  }
+}
+
+uint64_t SnapshotImpl::getInteger(const RegisteredKey& key, uint64_t default_value) const {
+  ASSERT(!isRuntimeFeature(key.name()));
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->uint_value_) {
+    return default_value;
+  } else {
+    return entry->uint_value_.value();
   }
 }
 
@@ -196,14 +219,39 @@ double SnapshotImpl::getDouble(absl::string_view key, double default_value) cons
 }
 
 bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.bool_value_.has_value()) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
+    return default_value;
+  } else {
+    return entry->bool_value_.value();
+  }
+}
+
+bool SnapshotImpl::getBoolean(const RegisteredKey& key, bool default_value) const {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
     return default_value;
   } else {
-    return entry->second.bool_value_.value();
+    return entry->bool_value_.value();
   }
 }
 
+const Snapshot::Entry* SnapshotImpl::findEntry(absl::string_view key) const {
+  if (key.empty()) {
+    return nullptr;
+  }
+  auto it = values_.find(key);
+  return it != values_.end() ? &it->second : nullptr;
+}
+
+const Snapshot::Entry* SnapshotImpl::findEntry(const RegisteredKey& key) const {
+  if (key.index() < registered_entries_.size()) {
+    return registered_entries_[key.index()];
+  }
+  // The key was registered after the snapshot was created.
+  return findEntry(key.name());
+}
+
 const std::vector<Snapshot::OverrideLayerConstPtr>& SnapshotImpl::getLayers() const {
   return layers_;
 }
@@ -220,6 +268,12 @@ SnapshotImpl::SnapshotImpl(Random::RandomGenerator& generator, RuntimeStats& sta
     }
   }
   stats.num_keys_.set(values_.size());
+
+  const std::vector<std::string> registered_names = RegisteredKey::registeredNames();
+  registered_entries_.reserve(registered_names.size());
+  for (const std::string& name : registered_names) {
+    registered_entries_.push_back(findEntry(name));
+  }
 }
 
 SnapshotImpl::Entry SnapshotImpl::createEntry(const std::string& value) {
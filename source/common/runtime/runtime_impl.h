@@ -83,6 +83,11 @@ public:
   uint64_t getInteger(absl::string_view key, uint64_t default_value) const override;
   double getDouble(absl::string_view key, double default_value) const override;
   bool getBoolean(absl::string_view key, bool value) const override;
+  bool featureEnabled(const RegisteredKey& key, uint64_t default_value) const override;
+  bool featureEnabled(const RegisteredKey& key, uint64_t default_value,
+                      uint64_t random_value) const override;
+  uint64_t getInteger(const RegisteredKey& key, uint64_t default_value) const override;
+  bool getBoolean(const RegisteredKey& key, bool default_value) const override;
   const std::vector<OverrideLayerConstPtr>& getLayers() const override;
 
   const EntryMap& values() const;
@@ -112,8 +117,15 @@ private:
   static bool parseEntryDoubleValue(Entry& entry);
   static void parseEntryFractionalPercentValue(Entry& entry);
 
+  const Entry* findEntry(absl::string_view key) const;
+  const Entry* findEntry(const RegisteredKey& key) const;
+  bool percentEnabled(uint64_t percent) const;
+
   const std::vector<OverrideLayerConstPtr> layers_;
   EntryMap values_;
+  // The entries of the keys registered when the snapshot was created, by index, or nullptr for the
+  // keys it doesn't have. The entries point into values_, which isn't modified once created.
+  std::vector<const Entry*> registered_entries_;
   Random::RandomGenerator& generator_;
   RuntimeStats& stats_;
 };
@@ -42,7 +42,12 @@ CertificateValidationContextConfigImpl::CertificateValidationContextConfigImpl(
       api_(api), only_verify_leaf_cert_crl_(config.only_verify_leaf_cert_crl()),
       max_verify_depth_(config.has_max_verify_depth()
                             ? absl::optional<uint32_t>(config.max_verify_depth().value())
-                            : absl::nullopt) {
+                            : absl::nullopt),
+      async_validation_(
+          config.has_async_validation()
+              ? absl::make_optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>(
+                    config.async_validation())
+              : absl::nullopt) {
   if (ca_cert_.empty() && custom_validator_config_ == absl::nullopt) {
     if (!certificate_revocation_list_.empty()) {
       throw EnvoyException(fmt::format("Failed to load CRL from {} without trusted CA",
@@ -53,6 +53,11 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
 
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>&
+  asyncValidation() const override {
+    return async_validation_;
+  }
+
 private:
   static std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>
   getSubjectAltNameMatchers(
@@ -72,6 +77,8 @@ private:
   Api::Api& api_;
   const bool only_verify_leaf_cert_crl_;
   absl::optional<uint32_t> max_verify_depth_;
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>
+      async_validation_;
 };
 
 } // namespace Ssl
@@ -135,11 +135,42 @@ protected:
   std::atomic<uint16_t> flags_{0};
 };
 
-class CounterImpl : public StatsSharedImpl<Counter> {
+// Value of a counter or gauge held in the stat object.
+class InlineValue {
 public:
+  std::atomic<uint64_t>& get() { return value_; }
+  const std::atomic<uint64_t>& get() const { return value_; }
+
+private:
+  std::atomic<uint64_t> value_{0};
+};
+
+// Value of a counter or gauge held in a slot of a SharedMemoryStatsRegion, where other processes
+// can read it.
+class SharedMemoryValue {
+public:
+  explicit SharedMemoryValue(std::atomic<uint64_t>& value) : value_(value) {}
+
+  std::atomic<uint64_t>& get() { return value_; }
+  const std::atomic<uint64_t>& get() const { return value_; }
+
+private:
+  std::atomic<uint64_t>& value_;
+};
+
+template <class Value> class CounterImpl : public StatsSharedImpl<Counter> {
+public:
+  template <class... ValueArgs>
   CounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
-              const StatNameTagVector& stat_name_tags)
-      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
+              const StatNameTagVector& stat_name_tags, ValueArgs&&... value_args)
+      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags),
+        value_(std::forward<ValueArgs>(value_args)...) {
+    // A counter in shared memory may have been written by the process we were hot restarted
+    // from.
+    if (value_.get() != 0) {
+      flags_ |= Flags::Used;
+    }
+  }
 
   void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
     const size_t count = alloc_.counters_.erase(statName());
@@ -151,25 +182,32 @@ public:
   void add(uint64_t amount) override {
     // Note that a reader may see a new value but an old pending_increment_ or
     // used(). From a system perspective this should be eventually consistent.
-    value_ += amount;
+    value_.get() += amount;
     pending_increment_ += amount;
     flags_ |= Flags::Used;
   }
   void inc() override { add(1); }
   uint64_t latch() override { return pending_increment_.exchange(0); }
-  void reset() override { value_ = 0; }
-  uint64_t value() const override { return value_; }
+  void reset() override { value_.get() = 0; }
+  uint64_t value() const override { return value_.get(); }
 
 private:
-  std::atomic<uint64_t> value_{0};
+  Value value_;
   std::atomic<uint64_t> pending_increment_{0};
 };
 
-class GaugeImpl : public StatsSharedImpl<Gauge> {
+template <class Value> class GaugeImpl : public StatsSharedImpl<Gauge> {
 public:
+  template <class... ValueArgs>
   GaugeImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
-            const StatNameTagVector& stat_name_tags, ImportMode import_mode)
-      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {
+            const StatNameTagVector& stat_name_tags, ImportMode import_mode,
+            ValueArgs&&... value_args)
+      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags),
+        child_value_(std::forward<ValueArgs>(value_args)...) {
+    flags_ |= Flags::Changed;
+    if (child_value_.get() != 0) {
+      flags_ |= Flags::Used;
+    }
     switch (import_mode) {
     case ImportMode::Accumulate:
       flags_ |= Flags::LogicAccumulate;
@@ -194,21 +232,22 @@ public:
 
   // Stats::Gauge
   void add(uint64_t amount) override {
-    child_value_ += amount;
-    flags_ |= Flags::Used;
+    child_value_.get() += amount;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
-    child_value_ = value;
-    flags_ |= Flags::Used;
+    child_value_.get() = value;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void sub(uint64_t amount) override {
-    ASSERT(child_value_ >= amount);
+    ASSERT(child_value_.get() >= amount);
     ASSERT(used() || amount == 0);
-    child_value_ -= amount;
+    child_value_.get() -= amount;
+    flags_ |= Flags::Changed;
   }
-  uint64_t value() const override { return child_value_ + parent_value_; }
+  uint64_t value() const override { return child_value_.get() + parent_value_; }
 
   ImportMode importMode() const override {
     if (flags_ & Flags::NeverImport) {
@@ -246,11 +285,15 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    flags_ |= Flags::Changed;
+  }
+  bool latchChanged() override { return flags_.fetch_and(~Flags::Changed) & Flags::Changed; }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
-  std::atomic<uint64_t> child_value_{0};
+  Value child_value_;
 };
 
 class TextReadoutImpl : public StatsSharedImpl<TextReadout> {
@@ -312,7 +355,7 @@ GaugeSharedPtr AllocatorImpl::makeGauge(StatName name, StatName tag_extracted_na
     return {*iter};
   }
   auto gauge =
-      GaugeSharedPtr(new GaugeImpl(name, *this, tag_extracted_name, stat_name_tags, import_mode));
+      GaugeSharedPtr(makeGaugeInternal(name, tag_extracted_name, stat_name_tags, import_mode));
   gauges_.insert(gauge.get());
   // Add gauge to sinked_gauges_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeGauge(*gauge)) {
@@ -352,7 +395,31 @@ bool AllocatorImpl::isMutexLockedForTest() {
 
 Counter* AllocatorImpl::makeCounterInternal(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
-  return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
+  if (shared_memory_region_ != nullptr) {
+    std::atomic<uint64_t>* value = shared_memory_region_->allocate(
+        symbol_table_.toString(name), SharedMemoryStatsRegion::Type::Counter);
+    if (value != nullptr) {
+      return new CounterImpl<SharedMemoryValue>(name, *this, tag_extracted_name, stat_name_tags,
+                                                *value);
+    }
+  }
+  return new CounterImpl<InlineValue>(name, *this, tag_extracted_name, stat_name_tags);
+}
+
+Gauge* AllocatorImpl::makeGaugeInternal(StatName name, StatName tag_extracted_name,
+                                        const StatNameTagVector& stat_name_tags,
+                                        Gauge::ImportMode import_mode) {
+  // Gauges that are not accumulated are set by each process on its own, so the hot restarted
+  // processes sharing the region can't share their values.
+  if (shared_memory_region_ != nullptr && import_mode == Gauge::ImportMode::Accumulate) {
+    std::atomic<uint64_t>* value = shared_memory_region_->allocate(
+        symbol_table_.toString(name), SharedMemoryStatsRegion::Type::Gauge);
+    if (value != nullptr) {
+      return new GaugeImpl<SharedMemoryValue>(name, *this, tag_extracted_name, stat_name_tags,
+                                              import_mode, *value);
+    }
+  }
+  return new GaugeImpl<InlineValue>(name, *this, tag_extracted_name, stat_name_tags, import_mode);
 }
 
 void AllocatorImpl::forEachCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
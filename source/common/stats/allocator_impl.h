@@ -9,6 +9,7 @@
 
 #include "source/common/common/thread_synchronizer.h"
 #include "source/common/stats/metric_impl.h"
+#include "source/common/stats/shared_memory_stats.h"
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
@@ -20,7 +21,15 @@ class AllocatorImpl : public Allocator {
 public:
   static const char DecrementToZeroSyncPoint[];
 
-  AllocatorImpl(SymbolTable& symbol_table) : symbol_table_(symbol_table) {}
+  /**
+   * @param symbol_table supplies the symbol table of the stat names.
+   * @param shared_memory_region supplies an optional region in which to place the values of
+   *        counters and accumulated gauges, while it has room for them. It must outlive the
+   *        allocator.
+   */
+  AllocatorImpl(SymbolTable& symbol_table,
+                SharedMemoryStatsRegion* shared_memory_region = nullptr)
+      : symbol_table_(symbol_table), shared_memory_region_(shared_memory_region) {}
   ~AllocatorImpl() override;
 
   // Allocator
@@ -66,11 +75,14 @@ public:
 protected:
   virtual Counter* makeCounterInternal(StatName name, StatName tag_extracted_name,
                                        const StatNameTagVector& stat_name_tags);
+  virtual Gauge* makeGaugeInternal(StatName name, StatName tag_extracted_name,
+                                   const StatNameTagVector& stat_name_tags,
+                                   Gauge::ImportMode import_mode);
 
 private:
   template <class BaseClass> friend class StatsSharedImpl;
-  friend class CounterImpl;
-  friend class GaugeImpl;
+  template <class Value> friend class CounterImpl;
+  template <class Value> friend class GaugeImpl;
   friend class TextReadoutImpl;
   friend class NotifyingAllocatorImpl;
 
@@ -93,6 +105,7 @@ private:
   // Predicates used to filter stats to be flushed.
   std::unique_ptr<SinkPredicates> sink_predicates_;
   SymbolTable& symbol_table_;
+  SharedMemoryStatsRegion* const shared_memory_region_;
 
   Thread::ThreadSynchronizer sync_;
 
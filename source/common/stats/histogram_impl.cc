@@ -97,6 +97,62 @@ void HistogramStatisticsImpl::refresh(const histogram_t* new_histogram_ptr) {
   }
 }
 
+AtomicLogLinearBuckets::~AtomicLogLinearBuckets() {
+  for (std::atomic<Decade*>& decade : decades_) {
+    delete decade.load();
+  }
+}
+
+void AtomicLogLinearBuckets::recordValue(uint64_t value) {
+  if (value == 0) {
+    zeros_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    uint32_t decade = 0;
+    uint64_t decade_start = 1;
+    while (decade + 1 < NumDecades && value / 10 >= decade_start) {
+      decade_start *= 10;
+      ++decade;
+    }
+    // The two most significant digits, so that values of the first decade land on bins 10 to 90.
+    const uint64_t bin = decade == 0 ? value * 10 : value / (decade_start / 10);
+
+    Decade* bins = decades_[decade].load(std::memory_order_acquire);
+    if (bins == nullptr) {
+      bins = new Decade();
+      decades_[decade].store(bins, std::memory_order_release);
+    }
+    bins->counts_[bin - 10].fetch_add(1, std::memory_order_relaxed);
+  }
+  pending_.store(true, std::memory_order_release);
+}
+
+bool AtomicLogLinearBuckets::drain(histogram_t* target) {
+  if (!pending_.exchange(false, std::memory_order_acquire)) {
+    return false;
+  }
+  bool drained = false;
+  if (const uint64_t count = zeros_.exchange(0, std::memory_order_relaxed); count != 0) {
+    hist_insert_intscale(target, 0, 0, count);
+    drained = true;
+  }
+  for (uint32_t decade = 0; decade < NumDecades; ++decade) {
+    Decade* bins = decades_[decade].load(std::memory_order_acquire);
+    if (bins == nullptr) {
+      continue;
+    }
+    for (uint32_t i = 0; i < BinsPerDecade; ++i) {
+      if (bins->counts_[i].load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      // Bin b of decade d holds the values [b * 10^(d-1), (b + 1) * 10^(d-1)).
+      const uint64_t count = bins->counts_[i].exchange(0, std::memory_order_relaxed);
+      hist_insert_intscale(target, i + 10, static_cast<int>(decade) - 1, count);
+      drained = true;
+    }
+  }
+  return drained;
+}
+
 HistogramSettingsImpl::HistogramSettingsImpl(const envoy::config::metrics::v3::StatsConfig& config)
     : configs_([&config]() {
         std::vector<Config> configs;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
@@ -73,6 +74,43 @@ private:
   const Histogram::Unit unit_{Histogram::Unit::Unspecified};
 };
 
+/**
+ * Counters for the log-linear bins of circllhist, so that integer values can be recorded with a
+ * single atomic increment and converted to a circllhist only when the recorded values are needed.
+ * As in circllhist, each bin covers the values sharing their two most significant decimal digits.
+ * The bins of a decade are allocated the first time a value of the decade is recorded.
+ *
+ * Values may only be recorded by one thread at a time, but they can be drained concurrently from
+ * any thread.
+ */
+class AtomicLogLinearBuckets : NonCopyable {
+public:
+  AtomicLogLinearBuckets() = default;
+  ~AtomicLogLinearBuckets();
+
+  void recordValue(uint64_t value);
+
+  /**
+   * Adds the values recorded since the last call to `target` and resets their counters.
+   * @return whether any value was added.
+   */
+  bool drain(histogram_t* target);
+
+private:
+  // Bins 10 to 99 of a decade.
+  static constexpr uint32_t BinsPerDecade = 90;
+  // Decade d holds the values with d + 1 decimal digits, up to the 20 digits of uint64_t.
+  static constexpr uint32_t NumDecades = 20;
+
+  struct alignas(64) Decade {
+    std::atomic<uint64_t> counts_[BinsPerDecade]{};
+  };
+
+  std::atomic<Decade*> decades_[NumDecades]{};
+  std::atomic<uint64_t> zeros_{0};
+  std::atomic<bool> pending_{false};
+};
+
 class HistogramImplHelper : public MetricImpl<Histogram> {
 public:
   HistogramImplHelper(StatName name, StatName tag_extracted_name,
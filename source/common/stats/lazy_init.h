@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "envoy/stats/scope.h"
+
+#include "source/common/common/non_copyable.h"
+#include "source/common/common/thread.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Holds a stats struct generated by MAKE_STATS_STRUCT, which is either instantiated upfront or,
+ * when deferred, by its first access. Deferring saves the memory of the stats of the entities which
+ * never use them, e.g. the clusters which never see any traffic, at the cost of an acquire load per
+ * access. The scope must outlive the LazyInit.
+ */
+template <class StatsStructType, class StatNamesType> class LazyInit : NonCopyable {
+public:
+  /**
+   * @param stat_names supplies the names of the stats, which must outlive the LazyInit.
+   * @param scope supplies the scope in which the stats are instantiated.
+   * @param deferred supplies whether to defer the instantiation to the first access.
+   */
+  LazyInit(const StatNamesType& stat_names, Scope& scope, bool deferred)
+      : stat_names_(stat_names), scope_(scope) {
+    if (!deferred) {
+      stats_ = std::make_unique<StatsStructType>(stat_names_, scope_);
+      ptr_.store(stats_.get(), std::memory_order_release);
+    }
+  }
+
+  StatsStructType* operator->() const { return &get(); }
+  StatsStructType& operator*() const { return get(); }
+
+  /**
+   * @return whether the stats have been instantiated.
+   */
+  bool isPresent() const { return ptr_.load(std::memory_order_acquire) != nullptr; }
+
+private:
+  StatsStructType& get() const {
+    StatsStructType* stats = ptr_.load(std::memory_order_acquire);
+    if (stats != nullptr) {
+      return *stats;
+    }
+    absl::MutexLock lock(&mutex_);
+    // Another thread might have raced to instantiate the stats.
+    if (stats_ == nullptr) {
+      stats_ = std::make_unique<StatsStructType>(stat_names_, scope_);
+      ptr_.store(stats_.get(), std::memory_order_release);
+    }
+    return *stats_;
+  }
+
+  const StatNamesType& stat_names_;
+  Scope& scope_;
+  mutable absl::Mutex mutex_;
+  mutable std::unique_ptr<StatsStructType> stats_ ABSL_GUARDED_BY(mutex_);
+  mutable std::atomic<StatsStructType*> ptr_{nullptr};
+};
+
+} // namespace Stats
+} // namespace Envoy
@@ -0,0 +1,199 @@
+#include "source/common/stats/shared_memory_stats.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/utility.h"
+
+namespace Envoy {
+namespace Stats {
+
+struct SharedMemoryStatsRegion::Header {
+  uint64_t magic_;
+  uint32_t version_;
+  uint32_t capacity_;
+  uint32_t name_table_size_;
+  std::atomic<uint32_t> reserved_slots_;
+  std::atomic<uint32_t> name_table_used_;
+  uint32_t padding_;
+};
+
+struct SharedMemoryStatsRegion::Slot {
+  std::atomic<uint64_t> value_;
+  uint32_t name_offset_;
+  uint16_t name_length_;
+  std::atomic<uint8_t> type_;
+  uint8_t padding_;
+};
+
+// The layout is read by other processes, so it must not depend on the compiler.
+static_assert(sizeof(std::atomic<uint64_t>) == 8 && std::atomic<uint64_t>::is_always_lock_free,
+              "shared memory stats require lock-free 64 bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                  std::atomic<uint8_t>::is_always_lock_free,
+              "shared memory stats require lock-free atomics");
+
+namespace {
+constexpr uint64_t HeaderSize = 32;
+constexpr uint64_t SlotSize = 16;
+} // namespace
+
+uint64_t SharedMemoryStatsRegion::size(uint32_t capacity) {
+  return HeaderSize + (SlotSize + NameBytesPerSlot) * capacity;
+}
+
+SharedMemoryStatsRegion::SharedMemoryStatsRegion(const std::string& path, uint32_t capacity,
+                                                 bool attach_existing)
+    : size_(size(capacity)) {
+  static_assert(sizeof(Header) == HeaderSize, "unexpected shared memory stats header size");
+  static_assert(sizeof(Slot) == SlotSize, "unexpected shared memory stats slot size");
+
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallIntResult open_result =
+      os_sys_calls.open(path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP);
+  if (open_result.return_value_ == -1) {
+    throw EnvoyException(fmt::format("cannot open shared memory stats file {}: {}", path,
+                                     errorDetails(open_result.errno_)));
+  }
+  const os_fd_t fd = open_result.return_value_;
+
+  struct stat stat_buf;
+  const bool existing = attach_existing &&
+                        os_sys_calls.fstat(fd, &stat_buf).return_value_ == 0 &&
+                        stat_buf.st_size > 0;
+  if (existing) {
+    if (static_cast<uint64_t>(stat_buf.st_size) != size_) {
+      os_sys_calls.close(fd);
+      throw EnvoyException(fmt::format(
+          "shared memory stats file {} has size {}, expected {} for {} stats", path,
+          stat_buf.st_size, size_, capacity));
+    }
+  } else {
+    // Truncating to zero first discards the stats of any previous region.
+    const Api::SysCallIntResult truncate_result = os_sys_calls.ftruncate(fd, 0);
+    const Api::SysCallIntResult resize_result =
+        truncate_result.return_value_ == -1 ? truncate_result : os_sys_calls.ftruncate(fd, size_);
+    if (resize_result.return_value_ == -1) {
+      os_sys_calls.close(fd);
+      throw EnvoyException(fmt::format("cannot resize shared memory stats file {}: {}", path,
+                                       errorDetails(resize_result.errno_)));
+    }
+  }
+
+  const Api::SysCallPtrResult mmap_result =
+      os_sys_calls.mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  os_sys_calls.close(fd);
+  if (mmap_result.return_value_ == MAP_FAILED) {
+    throw EnvoyException(fmt::format("cannot map shared memory stats file {}: {}", path,
+                                     errorDetails(mmap_result.errno_)));
+  }
+  memory_ = static_cast<char*>(mmap_result.return_value_);
+  header_ = reinterpret_cast<Header*>(memory_);
+  slots_ = reinterpret_cast<Slot*>(memory_ + HeaderSize);
+  name_table_ = memory_ + HeaderSize + SlotSize * capacity;
+
+  if (!existing) {
+    // The file was just truncated, so the remaining fields are already zero.
+    header_->version_ = Version;
+    header_->capacity_ = capacity;
+    header_->name_table_size_ = NameBytesPerSlot * capacity;
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic_ = Magic;
+  } else if (header_->magic_ != Magic || header_->version_ != Version ||
+             header_->capacity_ != capacity) {
+    ::munmap(memory_, size_);
+    throw EnvoyException(
+        fmt::format("shared memory stats file {} has an incompatible layout", path));
+  }
+
+  Thread::LockGuard lock(mutex_);
+  indexNewSlots();
+}
+
+SharedMemoryStatsRegion::~SharedMemoryStatsRegion() { ::munmap(memory_, size_); }
+
+void SharedMemoryStatsRegion::indexNewSlots() {
+  const uint32_t published =
+      std::min(header_->reserved_slots_.load(std::memory_order_acquire), header_->capacity_);
+  for (; indexed_slots_ < published; ++indexed_slots_) {
+    Slot& slot = slots_[indexed_slots_];
+    const uint8_t type = slot.type_.load(std::memory_order_acquire);
+    if (type == 0) {
+      // The slot is still being filled in by another process: try again on the next lookup.
+      break;
+    }
+    // Keep the first slot of a name, as this process only adds to one of them.
+    slot_index_.try_emplace(
+        std::make_pair(std::string(name_table_ + slot.name_offset_, slot.name_length_),
+                       static_cast<Type>(type)),
+        &slot);
+  }
+}
+
+std::atomic<uint64_t>* SharedMemoryStatsRegion::allocate(absl::string_view name, Type type) {
+  Thread::LockGuard lock(mutex_);
+  indexNewSlots();
+  std::pair<std::string, Type> key(std::string(name), type);
+  auto iter = slot_index_.find(key);
+  if (iter != slot_index_.end()) {
+    return &iter->second->value_;
+  }
+
+  if (name.size() > std::numeric_limits<uint16_t>::max()) {
+    return nullptr;
+  }
+  // Other processes may reserve slots concurrently, so always reserve with atomic operations. The
+  // counters are not rolled back on failure: they only grow, and readers clamp them.
+  const uint32_t slot_index = header_->reserved_slots_.fetch_add(1);
+  if (slot_index >= header_->capacity_) {
+    return nullptr;
+  }
+  const uint32_t name_offset = header_->name_table_used_.fetch_add(name.size());
+  Slot& slot = slots_[slot_index];
+  if (name_offset + static_cast<uint64_t>(name.size()) > header_->name_table_size_) {
+    // Leave a placeholder with an empty name so readers don't wait for the slot.
+    slot.name_offset_ = 0;
+    slot.name_length_ = 0;
+    slot.type_.store(static_cast<uint8_t>(type), std::memory_order_release);
+    return nullptr;
+  }
+  memcpy(name_table_ + name_offset, name.data(), name.size());
+  slot.name_offset_ = name_offset;
+  slot.name_length_ = name.size();
+  slot.type_.store(static_cast<uint8_t>(type), std::memory_order_release);
+  return &slot_index_.emplace(std::move(key), &slot).first->second->value_;
+}
+
+bool SharedMemoryStatsRegion::contains(absl::string_view name, Type type) {
+  Thread::LockGuard lock(mutex_);
+  indexNewSlots();
+  return slot_index_.contains(std::make_pair(std::string(name), type));
+}
+
+void SharedMemoryStatsRegion::forEachSlot(
+    const std::function<void(absl::string_view, Type, uint64_t)>& fn) const {
+  const uint32_t published =
+      std::min(header_->reserved_slots_.load(std::memory_order_acquire), header_->capacity_);
+  for (uint32_t i = 0; i < published; ++i) {
+    const Slot& slot = slots_[i];
+    const uint8_t type = slot.type_.load(std::memory_order_acquire);
+    if (type == 0 || slot.name_length_ == 0) {
+      continue;
+    }
+    fn(absl::string_view(name_table_ + slot.name_offset_, slot.name_length_),
+       static_cast<Type>(type), slot.value_.load());
+  }
+}
+
+} // namespace Stats
+} // namespace Envoy
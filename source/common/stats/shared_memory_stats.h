@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "source/common/common/non_copyable.h"
+#include "source/common/common/thread.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Fixed-capacity region of a memory-mapped file holding the values of counters and gauges, so
+ * that other processes can read them with no cooperation from Envoy, and so that they carry over
+ * to the hot restarted processes attaching to the same file.
+ *
+ * The layout of the file is stable across Envoy versions sharing the same Version. All integers
+ * are in host byte order:
+ *
+ *   Header (32 bytes):
+ *     uint64 magic            'EnvoyStM' (0x4d7453796f766e45 read as a little-endian uint64).
+ *     uint32 version          Layout version, currently 1.
+ *     uint32 capacity         Number of slots in the value array.
+ *     uint32 name_table_size  Size of the name table in bytes.
+ *     uint32 reserved_slots   Number of slots handed out so far; may exceed capacity.
+ *     uint32 name_table_used  Number of name table bytes handed out so far; may exceed
+ *                             name_table_size.
+ *     uint32 padding
+ *   Value array: `capacity` slots of 16 bytes:
+ *     uint64 value            Counter or gauge value, updated with atomic operations.
+ *     uint32 name_offset      Offset of the name in the name table.
+ *     uint16 name_length      Length of the name, which is not NUL-terminated.
+ *     uint8  type             0 while the slot is being filled in, then Type.
+ *     uint8  padding
+ *   Name table: `name_table_size` bytes holding the full names of the stats.
+ *
+ * Readers must load reserved_slots, clamp it to capacity, and skip the slots whose type is still
+ * 0. The type is stored with release semantics after the rest of the slot, so a slot with a
+ * non-zero type is complete. Slots are never freed. Processes sharing the region may create the
+ * same stat concurrently, in which case the name appears in several slots of the same type and
+ * the value of the stat is the sum of their values.
+ */
+class SharedMemoryStatsRegion : NonCopyable {
+public:
+  static constexpr uint64_t Magic = 0x4d7453796f766e45;
+  static constexpr uint32_t Version = 1;
+  // Name table bytes reserved for each slot of the value array.
+  static constexpr uint32_t NameBytesPerSlot = 128;
+
+  enum class Type : uint8_t { Counter = 1, Gauge = 2 };
+
+  /**
+   * Maps the region stored in a file.
+   *
+   * @param path supplies the path of the file, which is created if needed.
+   * @param capacity supplies the number of stats the region can hold.
+   * @param attach_existing supplies whether to keep the stats of a region previously stored in
+   *        the file, e.g. by the parent of a hot restarted process, instead of clearing it.
+   * @throw EnvoyException if the file can't be mapped, or if the existing region has a different
+   *        layout.
+   */
+  SharedMemoryStatsRegion(const std::string& path, uint32_t capacity, bool attach_existing);
+  ~SharedMemoryStatsRegion();
+
+  /**
+   * Finds the slot of a stat, allocating it if needed.
+   *
+   * @param name supplies the full name of the stat.
+   * @param type supplies the type of the stat.
+   * @return the value of the stat, or nullptr if the region is full.
+   */
+  std::atomic<uint64_t>* allocate(absl::string_view name, Type type);
+
+  /**
+   * @return whether the region holds a slot for the stat.
+   */
+  bool contains(absl::string_view name, Type type);
+
+  /**
+   * Calls `fn` with the name, type and value of all the complete slots of the region, as a
+   * reader process would see them.
+   */
+  void forEachSlot(const std::function<void(absl::string_view, Type, uint64_t)>& fn) const;
+
+  /**
+   * @return the size in bytes of a region holding `capacity` stats.
+   */
+  static uint64_t size(uint32_t capacity);
+
+private:
+  struct Header;
+  struct Slot;
+
+  // Adds the slots published since the previous call to slot_index_.
+  void indexNewSlots() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint64_t size_;
+  char* memory_;
+  Header* header_;
+  Slot* slots_;
+  char* name_table_;
+
+  Thread::MutexBasicLockable mutex_;
+  // Slots known to this process, keyed by name and type.
+  absl::flat_hash_map<std::pair<std::string, Type>, Slot*> slot_index_ ABSL_GUARDED_BY(mutex_);
+  uint32_t indexed_slots_ ABSL_GUARDED_BY(mutex_){0};
+};
+
+using SharedMemoryStatsRegionPtr = std::unique_ptr<SharedMemoryStatsRegion>;
+
+} // namespace Stats
+} // namespace Envoy
@@ -643,6 +643,40 @@ StatName StatNameDynamicPool::add(absl::string_view str) {
   return StatName(storage_vector_.back().bytes());
 }
 
+StatNameEncodingCache::StatNameEncodingCache(SymbolTable& symbol_table, uint32_t max_entries)
+    : symbol_table_(symbol_table), max_entries_(max_entries) {
+  ASSERT(max_entries_ > 0);
+}
+
+StatName StatNameEncodingCache::get(absl::string_view name) {
+  const auto iter = map_.find(name);
+  if (iter != map_.end()) {
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    return iter->second->storage_.statName();
+  }
+  if (map_.size() >= max_entries_) {
+    evictOldest();
+  }
+  entries_.emplace_front(name, symbol_table_);
+  map_.emplace(entries_.front().name_, entries_.begin());
+  return entries_.front().storage_.statName();
+}
+
+void StatNameEncodingCache::evictOldest() {
+  Entry& oldest = entries_.back();
+  map_.erase(oldest.name_);
+  oldest.storage_.free(symbol_table_);
+  entries_.pop_back();
+}
+
+void StatNameEncodingCache::clear() {
+  map_.clear();
+  for (Entry& entry : entries_) {
+    entry.storage_.free(symbol_table_);
+  }
+  entries_.clear();
+}
+
 StatNameStorageSet::~StatNameStorageSet() {
   // free() must be called before destructing StatNameStorageSet to decrement
   // references to all symbols.
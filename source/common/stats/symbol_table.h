@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <list>
 #include <memory>
 #include <stack>
 #include <string>
@@ -817,6 +818,64 @@ private:
   std::vector<StatNameDynamicStorage> storage_vector_;
 };
 
+/**
+ * Bounded cache from strings to StatNames encoded with the SymbolTable, for
+ * code that repeatedly symbolizes stat names built at runtime, e.g. on every
+ * request. A hit costs one hash lookup and takes no lock; only misses and
+ * evictions acquire the SymbolTable lock. When the cache is full, the least
+ * recently used name is evicted, releasing its references to the symbols.
+ *
+ * The cache is not thread-safe, so that hits don't need any synchronization:
+ * each worker must own its own cache, e.g. in a thread-local slot. The
+ * StatName returned by get() is only valid until the next call to get() or
+ * clear(), which may evict it; callers must use it right away to look up or
+ * create their stats, which copy the name.
+ *
+ * Example usage:
+ *   StatNameEncodingCache cache(symbol_table, 1000);
+ *   Counter& counter = scope.counterFromStatName(cache.get(command_name));
+ */
+class StatNameEncodingCache : NonCopyable {
+public:
+  StatNameEncodingCache(SymbolTable& symbol_table, uint32_t max_entries);
+  ~StatNameEncodingCache() { clear(); }
+
+  /**
+   * @param name the name to encode.
+   * @return the StatName for name, encoded with the symbol table on a miss.
+   */
+  StatName get(absl::string_view name);
+
+  /**
+   * Removes all names from the cache.
+   */
+  void clear();
+
+  /**
+   * @return the number of names held in the cache.
+   */
+  size_t size() const { return map_.size(); }
+
+private:
+  struct Entry {
+    Entry(absl::string_view name, SymbolTable& symbol_table)
+        : name_(name), storage_(name, symbol_table) {}
+
+    const std::string name_;
+    StatNameStorage storage_;
+  };
+  // Entries ordered from the most to the least recently used. The nodes of a
+  // std::list don't move, so the map can key them by a view of their names.
+  using EntryList = std::list<Entry>;
+
+  void evictOldest();
+
+  SymbolTable& symbol_table_;
+  const uint32_t max_entries_;
+  EntryList entries_;
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> map_;
+};
+
 // Represents an ordered container of StatNames. The encoding for each StatName
 // is byte-packed together, so this carries less overhead than allocating the
 // storage separately. The trade-off is there is no random access; you can only
@@ -141,6 +141,11 @@ public:
   bool extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
                   IntervalSet<size_t>& remove_characters) const override;
 
+  /**
+   * @return the regex, which must partially match a stat name for a tag to be extracted.
+   */
+  const std::string& regex() const { return regex_.pattern(); }
+
 private:
   const re2::RE2 regex_;
   const std::string negative_match_;
@@ -8,6 +8,8 @@
 #include "source/common/common/utility.h"
 #include "source/common/stats/tag_extractor_impl.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Stats {
 
@@ -45,6 +47,7 @@ TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v3::StatsConfig&
       addExtractor(std::make_unique<TagExtractorFixedImpl>(name, tag_specifier.fixed_value()));
     }
   }
+  compileRegexPrefilter();
 }
 
 int TagProducerImpl::addExtractorsMatching(absl::string_view name) {
@@ -81,11 +84,59 @@ void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
   }
 }
 
+void TagProducerImpl::compileRegexPrefilter() {
+  auto prefilter =
+      std::make_unique<re2::RE2::Set>(re2::RE2::DefaultOptions, re2::RE2::UNANCHORED);
+  auto add_extractors = [&prefilter, this](const std::vector<TagExtractorPtr>& extractors) {
+    for (const TagExtractorPtr& extractor : extractors) {
+      const auto* re2_extractor = dynamic_cast<const TagExtractorRe2Impl*>(extractor.get());
+      if (re2_extractor != nullptr) {
+        const int index = prefilter->Add(re2_extractor->regex(), nullptr);
+        // The regex was already parsed by the extractor, so it can't be rejected.
+        ASSERT(index >= 0);
+        prefilter_indexes_[extractor.get()] = index;
+      }
+    }
+  };
+  add_extractors(tag_extractors_without_prefix_);
+  for (const auto& prefix_extractors : tag_extractor_prefix_map_) {
+    add_extractors(prefix_extractors.second);
+  }
+  if (prefilter_indexes_.empty() || !prefilter->Compile()) {
+    // Without the prefilter, which only fails to compile if the regexes exceed the RE2 memory
+    // budget, every candidate extractor runs its own regex.
+    prefilter_indexes_.clear();
+    return;
+  }
+  regex_prefilter_ = std::move(prefilter);
+}
+
 void TagProducerImpl::forEachExtractorMatching(
     absl::string_view stat_name, std::function<void(const TagExtractorPtr&)> f) const {
-  IntervalSetImpl<size_t> remove_characters;
-  for (const TagExtractorPtr& tag_extractor : tag_extractors_without_prefix_) {
+  absl::InlinedVector<bool, 32> regex_matched;
+  if (regex_prefilter_ != nullptr) {
+    std::vector<int> matches;
+    re2::RE2::Set::ErrorInfo error_info;
+    regex_prefilter_->Match(re2::StringPiece(stat_name.data(), stat_name.size()), &matches,
+                            &error_info);
+    // If the scan failed, most likely because the DFA ran out of memory, every extractor runs.
+    regex_matched.assign(prefilter_indexes_.size(), error_info.kind != re2::RE2::Set::kNoError);
+    for (const int index : matches) {
+      regex_matched[index] = true;
+    }
+  }
+  auto call_if_regex_matched = [this, &f, &regex_matched](const TagExtractorPtr& tag_extractor) {
+    if (!regex_matched.empty()) {
+      const auto iter = prefilter_indexes_.find(tag_extractor.get());
+      if (iter != prefilter_indexes_.end() && !regex_matched[iter->second]) {
+        return;
+      }
+    }
     f(tag_extractor);
+  };
+
+  for (const TagExtractorPtr& tag_extractor : tag_extractors_without_prefix_) {
+    call_if_regex_matched(tag_extractor);
   }
   const absl::string_view::size_type dot = stat_name.find('.');
   if (dot != std::string::npos) {
@@ -93,7 +144,7 @@ void TagProducerImpl::forEachExtractorMatching(
     const auto iter = tag_extractor_prefix_map_.find(token);
     if (iter != tag_extractor_prefix_map_.end()) {
       for (const TagExtractorPtr& tag_extractor : iter->second) {
-        f(tag_extractor);
+        call_if_regex_matched(tag_extractor);
       }
     }
   }
@@ -18,6 +18,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/strings/string_view.h"
+#include "re2/set.h"
 
 namespace Envoy {
 namespace Stats {
@@ -68,6 +69,12 @@ private:
    */
   void reserveResources(const envoy::config::metrics::v3::StatsConfig& config);
 
+  /**
+   * Compiles the regexes of the RE2 extractors into regex_prefilter_. Must be called after
+   * adding all extractors.
+   */
+  void compileRegexPrefilter();
+
   /**
    * Adds all default extractors from well_known_names.cc into the collection.
    *
@@ -83,7 +90,8 @@ private:
    *   1. Finding the first '.' separated token in stat_name.
    *   2. Collecting the TagExtractors whose regexes have that same prefix "^prefix\\."
    *   3. Collecting also the TagExtractors whose regexes don't start with any prefix.
-   * In the future, we may also do substring searches in some cases.
+   *   4. Skipping the RE2 TagExtractors whose regex was not matched by regex_prefilter_, which
+   *      scans stat_name once for all of them.
    * See DefaultTagRegexTester::produceTagsReverse in test/common/stats/stats_impl_test.cc.
    *
    * @param stat_name const std::string& the stat name.
@@ -94,6 +102,12 @@ private:
 
   std::vector<TagExtractorPtr> tag_extractors_without_prefix_;
 
+  // All the regexes of the RE2 extractors, matched in a single pass over each stat name. An
+  // extractor whose regex does not match can't extract its tag, so it is not called.
+  std::unique_ptr<re2::RE2::Set> regex_prefilter_;
+  // Index of the regex of each RE2 extractor in regex_prefilter_.
+  absl::flat_hash_map<const TagExtractor*, int> prefilter_indexes_;
+
   // Maps a prefix word extracted out of a regex to a vector of TagExtractors. Note that
   // the storage for the prefix string is owned by the TagExtractor, which, depending on
   // implementation, may need make a copy of the prefix.
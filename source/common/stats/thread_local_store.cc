@@ -803,26 +803,43 @@ ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Uni
     : HistogramImplHelper(name, tag_extracted_name, stat_name_tags, symbol_table), unit_(unit),
       current_active_(0), used_(false), created_thread_id_(std::this_thread::get_id()),
       symbol_table_(symbol_table) {
-  histograms_[0] = hist_alloc();
-  histograms_[1] = hist_alloc();
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.atomic_histogram_buckets")) {
+    buckets_ = std::make_unique<AtomicLogLinearBuckets>();
+  } else {
+    histograms_[0] = hist_alloc();
+    histograms_[1] = hist_alloc();
+  }
 }
 
 ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
   MetricImpl::clear(symbol_table_);
-  hist_free(histograms_[0]);
-  hist_free(histograms_[1]);
+  if (buckets_ == nullptr) {
+    hist_free(histograms_[0]);
+    hist_free(histograms_[1]);
+  }
 }
 
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
-  hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  if (buckets_ != nullptr) {
+    buckets_->recordValue(value);
+  } else {
+    hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  }
   used_ = true;
 }
 
-void ThreadLocalHistogramImpl::merge(histogram_t* target) {
+bool ThreadLocalHistogramImpl::merge(histogram_t* target) {
+  if (buckets_ != nullptr) {
+    return buckets_->drain(target);
+  }
   histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
+  if (hist_sample_count(*other_histogram) == 0) {
+    return false;
+  }
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
+  return true;
 }
 
 ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
@@ -914,14 +931,22 @@ void ParentHistogramImpl::merge() {
     // then release the lock before we do the actual merge. However it is not a big deal
     // because the tls_histogram merge is not that expensive as it is a single histogram
     // merge and adding TLS histograms is rare.
+    bool recorded = false;
     for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
-      tls_histogram->merge(interval_histogram_);
+      recorded |= tls_histogram->merge(interval_histogram_);
     }
     // Since TLS merge is done, we can release the lock here.
     lock.release();
-    hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
-    cumulative_statistics_.refresh(cumulative_histogram_);
-    interval_statistics_.refresh(interval_histogram_);
+    // Computing the statistics is the most expensive part of the merge, so skip it when the
+    // histograms didn't change, as is the case for most histograms in a large configuration.
+    if (recorded || !merged_) {
+      hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
+      cumulative_statistics_.refresh(cumulative_histogram_);
+    }
+    if (recorded || !merged_ || !interval_empty_) {
+      interval_statistics_.refresh(interval_histogram_);
+    }
+    interval_empty_ = !recorded;
     merged_ = true;
   }
 }
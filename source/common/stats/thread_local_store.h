@@ -37,13 +37,21 @@ public:
                            const StatNameTagVector& stat_name_tags, SymbolTable& symbol_table);
   ~ThreadLocalHistogramImpl() override;
 
-  void merge(histogram_t* target);
+  /**
+   * Adds the values recorded since the last merge to `target`.
+   * @return whether any value was added.
+   */
+  bool merge(histogram_t* target);
 
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
-   * not have to lock the histogram in high throughput TLS writes.
+   * not have to lock the histogram in high throughput TLS writes. This is not needed when values
+   * are recorded in atomic buckets, which can be merged from any thread.
    */
   void beginMerge() {
+    if (buckets_ != nullptr) {
+      return;
+    }
     // This switches the current_active_ between 1 and 0.
     ASSERT(std::this_thread::get_id() == created_thread_id_);
     current_active_ = otherHistogramIndex();
@@ -65,7 +73,9 @@ private:
   Histogram::Unit unit_;
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_;
-  histogram_t* histograms_[2];
+  histogram_t* histograms_[2]{};
+  // Set instead of histograms_ if values are recorded in atomic log-linear buckets.
+  std::unique_ptr<AtomicLogLinearBuckets> buckets_;
   std::atomic<bool> used_;
   std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -131,6 +141,8 @@ private:
   mutable Thread::MutexBasicLockable merge_lock_;
   std::list<TlsHistogramSharedPtr> tls_histograms_ ABSL_GUARDED_BY(merge_lock_);
   bool merged_;
+  // Whether no value was merged in the last interval.
+  bool interval_empty_{true};
   std::atomic<bool> shutting_down_{false};
   std::atomic<uint32_t> ref_count_{0};
   const uint64_t id_; // Index into TlsCache::histogram_cache_.
@@ -2,9 +2,21 @@
 
 #include "envoy/common/exception.h"
 
+#include "source/common/common/macros.h"
+
 namespace Envoy {
 namespace StreamInfo {
 
+FilterState::Slot FilterStateImpl::registerSlot(absl::string_view data_name) {
+  auto& registry = slotRegistry();
+  const auto it = registry.try_emplace(data_name, registry.size()).first;
+  return {it->first, it->second};
+}
+
+FilterStateImpl::SlotRegistry& FilterStateImpl::slotRegistry() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(SlotRegistry);
+}
+
 void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Object> data,
                               FilterState::StateType state_type, FilterState::LifeSpan life_span,
                               FilterState::StreamSharing stream_sharing) {
@@ -46,6 +58,15 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
   filter_object->data_ = data;
   filter_object->state_type_ = state_type;
   filter_object->stream_sharing_ = stream_sharing;
+  const auto& registry = slotRegistry();
+  if (!registry.empty()) {
+    if (const auto slot = registry.find(data_name); slot != registry.end()) {
+      if (slot->second >= slots_.size()) {
+        slots_.resize(slot->second + 1);
+      }
+      slots_[slot->second] = filter_object.get();
+    }
+  }
   data_storage_[data_name] = std::move(filter_object);
 }
 
@@ -68,6 +89,16 @@ FilterStateImpl::getDataReadOnlyGeneric(absl::string_view data_name) const {
   return current->data_.get();
 }
 
+const FilterState::Object* FilterStateImpl::getDataReadOnlyGeneric(const Slot& slot) const {
+  if (slot.index() < slots_.size() && slots_[slot.index()] != nullptr) {
+    return slots_[slot.index()]->data_.get();
+  }
+  if (parent_) {
+    return parent_->getDataReadOnlyGeneric(slot);
+  }
+  return nullptr;
+}
+
 FilterState::Object* FilterStateImpl::getDataMutableGeneric(absl::string_view data_name) {
   return getDataSharedMutableGeneric(data_name).get();
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -39,6 +41,15 @@ public:
     maybeCreateParent(ParentAccessMode::ReadOnly);
   }
 
+  /**
+   * Registers a data name so that the data stored under it can be looked up by the returned slot.
+   * The registry isn't synchronized, so this must be called during static initialization, e.g. to
+   * initialize a constant at namespace scope. Registering a name again returns the same slot.
+   * @param data_name the name to register.
+   * @return the slot of the name.
+   */
+  static FilterState::Slot registerSlot(absl::string_view data_name);
+
   // FilterState
   void
   setData(absl::string_view data_name, std::shared_ptr<Object> data,
@@ -47,6 +58,7 @@ public:
           FilterState::StreamSharing stream_sharing = FilterState::StreamSharing::None) override;
   bool hasDataWithName(absl::string_view) const override;
   const Object* getDataReadOnlyGeneric(absl::string_view data_name) const override;
+  const Object* getDataReadOnlyGeneric(const Slot& slot) const override;
   Object* getDataMutableGeneric(absl::string_view data_name) override;
   std::shared_ptr<Object> getDataSharedMutableGeneric(absl::string_view data_name) override;
   bool hasDataAtOrAboveLifeSpan(FilterState::LifeSpan life_span) const override;
@@ -60,11 +72,16 @@ private:
   bool hasDataWithNameInternally(absl::string_view data_name) const;
   enum class ParentAccessMode { ReadOnly, ReadWrite };
   void maybeCreateParent(ParentAccessMode parent_access_mode);
+  using SlotRegistry = absl::flat_hash_map<std::string, uint32_t>;
+  static SlotRegistry& slotRegistry();
 
   absl::variant<FilterStateSharedPtr, LazyCreateAncestor> ancestor_;
   FilterStateSharedPtr parent_;
   const FilterState::LifeSpan life_span_;
   absl::flat_hash_map<std::string, std::unique_ptr<FilterObject>> data_storage_;
+  // The objects of data_storage_ stored under registered names, indexed by their slot. Only as
+  // long as the highest slot set so far.
+  std::vector<const FilterObject*> slots_;
 };
 
 } // namespace StreamInfo
@@ -2,6 +2,8 @@
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
+#include <utility>
 
 #include "envoy/common/time.h"
 #include "envoy/config/core/v3/base.pb.h"
@@ -161,13 +163,13 @@ struct StreamInfoImpl : public StreamInfo {
   }
 
   DownstreamTiming& downstreamTiming() override {
-    if (!downstream_timing_.has_value()) {
-      downstream_timing_ = DownstreamTiming();
+    if (downstream_timing_ == nullptr) {
+      downstream_timing_ = std::make_unique<DownstreamTiming>();
     }
-    return downstream_timing_.value();
+    return *downstream_timing_;
   }
   OptRef<const DownstreamTiming> downstreamTiming() const override {
-    if (!downstream_timing_.has_value()) {
+    if (downstream_timing_ == nullptr) {
       return {};
     }
     return {*downstream_timing_};
@@ -242,11 +244,19 @@ struct StreamInfoImpl : public StreamInfo {
 
   Router::RouteConstSharedPtr route() const override { return route_; }
 
-  envoy::config::core::v3::Metadata& dynamicMetadata() override { return metadata_; };
-  const envoy::config::core::v3::Metadata& dynamicMetadata() const override { return metadata_; };
+  envoy::config::core::v3::Metadata& dynamicMetadata() override {
+    if (metadata_ == nullptr) {
+      metadata_ = std::make_unique<envoy::config::core::v3::Metadata>();
+    }
+    return *metadata_;
+  };
+  const envoy::config::core::v3::Metadata& dynamicMetadata() const override {
+    return metadata_ != nullptr ? *metadata_
+                                : envoy::config::core::v3::Metadata::default_instance();
+  };
 
   void setDynamicMetadata(const std::string& name, const ProtobufWkt::Struct& value) override {
-    (*metadata_.mutable_filter_metadata())[name].MergeFrom(value);
+    (*dynamicMetadata().mutable_filter_metadata())[name].MergeFrom(value);
   };
 
   const FilterStateSharedPtr& filterState() override { return filter_state_; }
@@ -328,7 +338,7 @@ struct StreamInfoImpl : public StreamInfo {
   // includes information about the downstream stream, but not the upstream
   // stream.
   void setFromForRecreateStream(StreamInfo& info) {
-    downstream_timing_ = info.downstreamTiming();
+    downstream_timing_ = std::make_unique<DownstreamTiming>(info.downstreamTiming());
     protocol_ = info.protocol();
     bytes_received_ = info.bytesReceived();
     downstream_bytes_meter_ = info.getDownstreamBytesMeter();
@@ -358,7 +368,10 @@ struct StreamInfoImpl : public StreamInfo {
     response_flags_ = info.responseFlags();
     health_check_request_ = info.healthCheck();
     route_ = info.route();
-    metadata_ = info.dynamicMetadata();
+    const envoy::config::core::v3::Metadata& metadata = std::as_const(info).dynamicMetadata();
+    metadata_ = metadata.filter_metadata().empty() && metadata.typed_filter_metadata().empty()
+                    ? nullptr
+                    : std::make_unique<envoy::config::core::v3::Metadata>(metadata);
     filter_state_ = info.filterState();
     request_headers_ = request_headers;
     upstream_cluster_info_ = info.upstreamClusterInfo();
@@ -398,7 +411,9 @@ struct StreamInfoImpl : public StreamInfo {
   uint64_t response_flags_{};
   bool health_check_request_{};
   Router::RouteConstSharedPtr route_;
-  envoy::config::core::v3::Metadata metadata_{};
+  // The dynamic metadata and the downstream timing are only set on some streams, they are allocated
+  // on first write to keep the stream info small.
+  std::unique_ptr<envoy::config::core::v3::Metadata> metadata_;
   FilterStateSharedPtr filter_state_;
   std::string route_name_;
   absl::optional<uint32_t> attempt_count_;
@@ -431,7 +446,7 @@ private:
   const Network::ConnectionInfoProviderSharedPtr downstream_connection_info_provider_;
   const Http::RequestHeaderMap* request_headers_{};
   StreamIdProviderSharedPtr stream_id_provider_;
-  absl::optional<DownstreamTiming> downstream_timing_;
+  std::unique_ptr<DownstreamTiming> downstream_timing_;
   absl::optional<Upstream::ClusterInfoConstSharedPtr> upstream_cluster_info_;
   std::string filter_chain_name_;
   Tracing::Reason trace_reason_;
@@ -0,0 +1,159 @@
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+#if defined(__linux__)
+
+namespace {
+
+// Upper bound of a single splice call. The kernel moves at most a pipe's worth of data at a time
+// anyway, so this only needs to be at least the default pipe capacity.
+constexpr size_t MaxSpliceChunk = 64 * 1024;
+constexpr unsigned int SpliceFlags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+
+} // namespace
+
+SpliceForwarderPtr SpliceForwarder::create(Event::Dispatcher& dispatcher, os_fd_t downstream_fd,
+                                           os_fd_t upstream_fd, Callbacks& callbacks) {
+  SpliceForwarderPtr forwarder(new SpliceForwarder(downstream_fd, upstream_fd, callbacks));
+  if (!forwarder->createPipe(forwarder->upstream_) ||
+      !forwarder->createPipe(forwarder->downstream_)) {
+    return nullptr;
+  }
+
+  // Both sockets are already registered with the dispatcher by their connections, which use edge
+  // triggered events as well. Mixing trigger types on one fd is not supported by libevent.
+  forwarder->downstream_event_ = dispatcher.createFileEvent(
+      downstream_fd, [forwarder = forwarder.get()](uint32_t) { forwarder->onFileEvent(); },
+      Event::FileTriggerType::Edge, Event::FileReadyType::Read | Event::FileReadyType::Write);
+  forwarder->upstream_event_ = dispatcher.createFileEvent(
+      upstream_fd, [forwarder = forwarder.get()](uint32_t) { forwarder->onFileEvent(); },
+      Event::FileTriggerType::Edge, Event::FileReadyType::Read | Event::FileReadyType::Write);
+  // Data may already be waiting in the socket receive buffers, in which case no new edge will be
+  // reported for it.
+  forwarder->downstream_event_->activate(Event::FileReadyType::Read);
+  return forwarder;
+}
+
+SpliceForwarder::SpliceForwarder(os_fd_t downstream_fd, os_fd_t upstream_fd, Callbacks& callbacks)
+    : callbacks_(callbacks), upstream_{downstream_fd, upstream_fd},
+      downstream_{upstream_fd, downstream_fd} {}
+
+SpliceForwarder::~SpliceForwarder() {
+  downstream_event_.reset();
+  upstream_event_.reset();
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  for (Direction* direction : {&upstream_, &downstream_}) {
+    if (direction->pipe_read_end_ != INVALID_SOCKET) {
+      os_sys_calls.close(direction->pipe_read_end_);
+    }
+    if (direction->pipe_write_end_ != INVALID_SOCKET) {
+      os_sys_calls.close(direction->pipe_write_end_);
+    }
+  }
+}
+
+bool SpliceForwarder::createPipe(Direction& direction) {
+  os_fd_t fds[2];
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(debug, "unable to create splice pipe: {}", errorDetails(result.errno_));
+    return false;
+  }
+  direction.pipe_read_end_ = fds[0];
+  direction.pipe_write_end_ = fds[1];
+  return true;
+}
+
+void SpliceForwarder::onFileEvent() {
+  if (finished_) {
+    return;
+  }
+
+  // Readiness of either socket can unblock both directions, e.g. the upstream socket becoming
+  // writable lets the downstream pipe drain, which in turn makes room to read downstream data.
+  const uint64_t upstream_bytes = pump(upstream_);
+  const uint64_t downstream_bytes = pump(downstream_);
+  if (upstream_bytes > 0) {
+    callbacks_.onUpstreamBytesSpliced(upstream_bytes);
+  }
+  if (downstream_bytes > 0) {
+    callbacks_.onDownstreamBytesSpliced(downstream_bytes);
+  }
+
+  if (!reading_ && drained(upstream_) && drained(downstream_)) {
+    finished_ = true;
+    callbacks_.onSpliceFinished();
+  }
+}
+
+uint64_t SpliceForwarder::pump(Direction& direction) {
+  auto& os_sys_calls = Api::LinuxOsSysCallsSingleton::get();
+  uint64_t bytes_written = 0;
+  bool progress = true;
+  while (progress && !direction.failed_) {
+    progress = false;
+
+    if (reading_) {
+      const Api::SysCallSizeResult result =
+          os_sys_calls.splice(direction.source_, nullptr, direction.pipe_write_end_, nullptr,
+                              MaxSpliceChunk, SpliceFlags);
+      if (result.return_value_ > 0) {
+        direction.bytes_in_pipe_ += result.return_value_;
+        progress = true;
+      } else if (result.return_value_ == 0 || result.errno_ != SOCKET_ERROR_AGAIN) {
+        // End of stream or a socket error. Leave whatever is left in the sockets, including the
+        // end of stream itself, to the connections.
+        ENVOY_LOG(trace, "splice stopped reading from fd={}: rc={} errno={}", direction.source_,
+                  result.return_value_, result.errno_);
+        reading_ = false;
+      }
+      // EAGAIN means that either the socket has no data or the pipe is full.
+    }
+
+    if (direction.bytes_in_pipe_ > 0) {
+      const Api::SysCallSizeResult result =
+          os_sys_calls.splice(direction.pipe_read_end_, nullptr, direction.destination_, nullptr,
+                              direction.bytes_in_pipe_, SpliceFlags);
+      if (result.return_value_ > 0) {
+        ASSERT(static_cast<uint64_t>(result.return_value_) <= direction.bytes_in_pipe_);
+        direction.bytes_in_pipe_ -= result.return_value_;
+        bytes_written += result.return_value_;
+        progress = true;
+      } else if (result.return_value_ < 0 && result.errno_ != SOCKET_ERROR_AGAIN) {
+        // The data in the pipe can no longer be delivered. The connections will observe the
+        // error once they resume.
+        ENVOY_LOG(trace, "splice failed writing to fd={}: errno={}", direction.destination_,
+                  result.errno_);
+        direction.failed_ = true;
+        reading_ = false;
+      }
+    }
+  }
+  return bytes_written;
+}
+
+#else
+
+SpliceForwarderPtr SpliceForwarder::create(Event::Dispatcher&, os_fd_t, os_fd_t, Callbacks&) {
+  return nullptr;
+}
+
+SpliceForwarder::~SpliceForwarder() = default;
+
+#endif
+
+} // namespace TcpProxy
+} // namespace Envoy
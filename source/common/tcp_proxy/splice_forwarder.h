@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/common/pure.h"
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/file_event.h"
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+class SpliceForwarder;
+using SpliceForwarderPtr = std::unique_ptr<SpliceForwarder>;
+
+/**
+ * Moves bytes between two connected plaintext sockets with splice(2), through one kernel pipe per
+ * direction, so that the payload is never copied into user space. The amount of data in flight
+ * per direction is bounded by the pipe capacity, so a slow reader applies back pressure on the
+ * other socket through the kernel instead of Envoy's buffers.
+ *
+ * The forwarder stops reading from both sockets as soon as either of them reaches end of stream or
+ * fails. Once the data already held in the pipes has been written out it reports
+ * onSpliceFinished(), after which the owner is expected to resume regular buffered I/O on both
+ * connections; the end of stream or error is then observed by the connections themselves.
+ *
+ * The sockets must not be read or written by their connections while the forwarder exists.
+ */
+class SpliceForwarder : public Event::DeferredDeletable,
+                        protected Logger::Loggable<Logger::Id::filter> {
+public:
+  class Callbacks {
+  public:
+    virtual ~Callbacks() = default;
+
+    /**
+     * Called when bytes received from the downstream socket were written to the upstream socket.
+     * @param bytes supplies the number of bytes written.
+     */
+    virtual void onUpstreamBytesSpliced(uint64_t bytes) PURE;
+
+    /**
+     * Called when bytes received from the upstream socket were written to the downstream socket.
+     * @param bytes supplies the number of bytes written.
+     */
+    virtual void onDownstreamBytesSpliced(uint64_t bytes) PURE;
+
+    /**
+     * Called once both pipes have been flushed after the forwarder stopped reading. No other
+     * callback is invoked afterwards.
+     */
+    virtual void onSpliceFinished() PURE;
+  };
+
+  ~SpliceForwarder() override;
+
+  /**
+   * @return a forwarder splicing between the two sockets, or nullptr if splicing is not supported
+   *         on this platform or the pipes could not be created.
+   */
+  static SpliceForwarderPtr create(Event::Dispatcher& dispatcher, os_fd_t downstream_fd,
+                                   os_fd_t upstream_fd, Callbacks& callbacks);
+
+private:
+  struct Direction {
+    os_fd_t source_;
+    os_fd_t destination_;
+    os_fd_t pipe_read_end_{INVALID_SOCKET};
+    os_fd_t pipe_write_end_{INVALID_SOCKET};
+    uint64_t bytes_in_pipe_{};
+    bool failed_{};
+  };
+
+  SpliceForwarder(os_fd_t downstream_fd, os_fd_t upstream_fd, Callbacks& callbacks);
+
+  bool createPipe(Direction& direction);
+  void onFileEvent();
+  // Moves as much data as possible through `direction`. Returns the number of bytes written to
+  // the destination socket.
+  uint64_t pump(Direction& direction);
+  bool drained(const Direction& direction) const {
+    return direction.failed_ || direction.bytes_in_pipe_ == 0;
+  }
+
+  Callbacks& callbacks_;
+  // Downstream to upstream.
+  Direction upstream_;
+  // Upstream to downstream.
+  Direction downstream_;
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+  bool reading_{true};
+  bool finished_{};
+};
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -9,6 +9,7 @@
 #include "envoy/config/core/v3/base.pb.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
+#include "envoy/network/transport_socket.h"
 #include "envoy/extensions/filters/network/tcp_proxy/v3/tcp_proxy.pb.h"
 #include "envoy/extensions/filters/network/tcp_proxy/v3/tcp_proxy.pb.validate.h"
 #include "envoy/stats/scope.h"
@@ -72,7 +73,8 @@ Config::SharedConfig::SharedConfig(
     Server::Configuration::FactoryContext& context)
     : stats_scope_(context.scope().createScope(fmt::format("tcp.{}", config.stat_prefix()))),
       stats_(generateStats(*stats_scope_)),
-      flush_access_log_on_connected_(config.flush_access_log_on_connected()) {
+      flush_access_log_on_connected_(config.flush_access_log_on_connected()),
+      splice_plaintext_connections_(config.splice_plaintext_connections()) {
   if (config.has_idle_timeout()) {
     const uint64_t timeout = DurationUtil::durationToMilliseconds(config.idle_timeout());
     if (timeout > 0) {
@@ -542,6 +544,101 @@ void Filter::onGenericPoolReady(StreamInfo::StreamInfo* info,
   if (info) {
     upstream_info.setUpstreamFilterState(info->filterState());
   }
+  maybeStartSplicing();
+}
+
+void Filter::maybeStartSplicing() {
+  if (!config_->splicePlaintextConnections() || upstream_ == nullptr) {
+    return;
+  }
+  // Tunneled payloads have to go through the HTTP codec.
+  auto* tcp_upstream = dynamic_cast<TcpUpstream*>(upstream_.get());
+  if (tcp_upstream == nullptr) {
+    return;
+  }
+  Network::Connection& downstream_connection = read_callbacks_->connection();
+  Network::Connection& upstream_connection = tcp_upstream->connection();
+  if (downstream_connection.state() != Network::Connection::State::Open ||
+      upstream_connection.state() != Network::Connection::State::Open) {
+    return;
+  }
+  // Spliced bytes also bypass the transport sockets, so both must pass the payload as is, like
+  // raw_buffer does. TLS, PROXY protocol, tap or ALTS sockets don't.
+  if (!downstream_connection.forwardsPayloadUnchanged() ||
+      !upstream_connection.forwardsPayloadUnchanged()) {
+    return;
+  }
+  // Spliced bytes bypass the network filters, so the connections must have no filter other than
+  // this one downstream and the connection pool's one upstream.
+  if (downstream_connection.numReadFilters() != 1 || downstream_connection.numWriteFilters() != 0 ||
+      upstream_connection.numReadFilters() != 1 || upstream_connection.numWriteFilters() != 0) {
+    ENVOY_CONN_LOG(debug, "not splicing payload of connection with other network filters",
+                   downstream_connection);
+    return;
+  }
+  // Bytes already handed to the connections may still sit in their buffers; splicing now could
+  // reorder them with the spliced ones.
+  if (getStreamInfo().getDownstreamBytesMeter()->wireBytesReceived() != 0 ||
+      getStreamInfo().getUpstreamBytesMeter()->wireBytesReceived() != 0) {
+    return;
+  }
+  // Only connections backed by a socket expose their IoHandle.
+  auto* downstream_socket =
+      dynamic_cast<Network::TransportSocketCallbacks*>(&downstream_connection);
+  auto* upstream_socket = dynamic_cast<Network::TransportSocketCallbacks*>(&upstream_connection);
+  if (downstream_socket == nullptr || upstream_socket == nullptr ||
+      !downstream_socket->ioHandle().isOpen() || !upstream_socket->ioHandle().isOpen()) {
+    return;
+  }
+
+  splice_forwarder_ = SpliceForwarder::create(downstream_connection.dispatcher(),
+                                              downstream_socket->ioHandle().fdDoNotUse(),
+                                              upstream_socket->ioHandle().fdDoNotUse(), *this);
+  if (splice_forwarder_ == nullptr) {
+    return;
+  }
+  ENVOY_CONN_LOG(debug, "splicing payload to upstream connection", downstream_connection);
+  config_->stats().downstream_cx_splice_total_.inc();
+  // The connections must not touch the sockets while the forwarder owns them.
+  downstream_connection.readDisable(true);
+  upstream_->readDisable(true);
+}
+
+void Filter::stopSplicing() {
+  if (splice_forwarder_ != nullptr) {
+    read_callbacks_->connection().dispatcher().deferredDelete(std::move(splice_forwarder_));
+  }
+}
+
+void Filter::onUpstreamBytesSpliced(uint64_t bytes) {
+  config_->stats().downstream_cx_rx_bytes_total_.add(bytes);
+  getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+  getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes);
+  read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_tx_bytes_total_.add(
+      bytes);
+  resetIdleTimer();
+}
+
+void Filter::onDownstreamBytesSpliced(uint64_t bytes) {
+  config_->stats().downstream_cx_tx_bytes_total_.add(bytes);
+  getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+  getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+  read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_rx_bytes_total_.add(
+      bytes);
+  resetIdleTimer();
+}
+
+void Filter::onSpliceFinished() {
+  ENVOY_CONN_LOG(debug, "splicing finished, resuming buffered proxying",
+                 read_callbacks_->connection());
+  stopSplicing();
+  // Let the connections observe the end of stream or the error which stopped the forwarder.
+  if (upstream_ != nullptr) {
+    upstream_->readDisable(false);
+  }
+  if (read_callbacks_->connection().state() == Network::Connection::State::Open) {
+    read_callbacks_->connection().readDisable(false);
+  }
 }
 
 const Router::MetadataMatchCriteria* Filter::metadataMatchCriteria() {
@@ -686,6 +783,7 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
   if (event == Network::ConnectionEvent::LocalClose ||
       event == Network::ConnectionEvent::RemoteClose) {
     downstream_closed_ = true;
+    stopSplicing();
     // Cancel the potential odcds callback.
     cluster_discovery_handle_ = nullptr;
   }
@@ -737,6 +835,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    stopSplicing();
     upstream_.reset();
     disableIdleTimer();
 
@@ -118,6 +118,8 @@ public:
   Tcp::ConnectionPool::ConnectionData* onDownstreamEvent(Network::ConnectionEvent event) override;
   bool startUpstreamSecureTransport() override;
 
+  Network::ClientConnection& connection() { return upstream_conn_data_->connection(); }
+
 private:
   Tcp::ConnectionPool::ConnectionDataPtr upstream_conn_data_;
 };
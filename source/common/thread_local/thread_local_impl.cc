@@ -96,8 +96,9 @@ void InstanceImpl::SlotImpl::set(InitializeCb cb) {
 
   for (Event::Dispatcher& dispatcher : parent_.registered_threads_) {
     // See the header file comments for still_alive_guard_ for why we capture index_.
-    dispatcher.post(wrapCallback(
-        [index = index_, cb, &dispatcher]() -> void { setThreadLocal(index, cb(dispatcher)); }));
+    parent_.post(dispatcher, wrapCallback([index = index_, cb, &dispatcher]() -> void {
+      setThreadLocal(index, cb(dispatcher));
+    }));
   }
 
   // Handle main thread.
@@ -150,7 +151,7 @@ void InstanceImpl::runOnAllThreads(Event::PostCb cb) {
   ASSERT(!shutdown_);
 
   for (Event::Dispatcher& dispatcher : registered_threads_) {
-    dispatcher.post(cb);
+    post(dispatcher, cb);
   }
 
   // Handle main thread.
@@ -172,10 +173,58 @@ void InstanceImpl::runOnAllThreads(Event::PostCb cb, Event::PostCb all_threads_c
                                   });
 
   for (Event::Dispatcher& dispatcher : registered_threads_) {
-    dispatcher.post([cb_guard]() -> void { (*cb_guard)(); });
+    post(dispatcher, [cb_guard]() -> void { (*cb_guard)(); });
   }
 }
 
+void InstanceImpl::post(Event::Dispatcher& dispatcher, Event::PostCb cb) {
+  if (update_batch_depth_ == 0) {
+    dispatcher.post(std::move(cb));
+    return;
+  }
+  pending_posts_[&dispatcher].push_back(std::move(cb));
+}
+
+void InstanceImpl::beginUpdateBatch() {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  ++update_batch_depth_;
+}
+
+uint64_t InstanceImpl::endUpdateBatch() {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  ASSERT(update_batch_depth_ > 0);
+  if (--update_batch_depth_ > 0) {
+    return 0;
+  }
+
+  auto pending_posts = std::move(pending_posts_);
+  pending_posts_.clear();
+  // The workers are gone when shutting down, so are the slots the queued callbacks update.
+  if (shutdown_) {
+    return 0;
+  }
+
+  uint64_t posts_saved = 0;
+  // Post in the registration order of the workers rather than the order of the map, so that the
+  // updates reach the workers in the same order as without batching.
+  for (Event::Dispatcher& dispatcher : registered_threads_) {
+    auto it = pending_posts.find(&dispatcher);
+    if (it == pending_posts.end()) {
+      continue;
+    }
+    posts_saved += it->second.size() - 1;
+    // The callbacks are destroyed with the combined callback, after they all ran. This keeps
+    // the completion callbacks of runOnAllThreads() from being posted before the worker is done
+    // with the whole batch.
+    dispatcher.post([callbacks = std::move(it->second)]() -> void {
+      for (const Event::PostCb& cb : callbacks) {
+        cb();
+      }
+    });
+  }
+  return posts_saved;
+}
+
 void InstanceImpl::setThreadLocal(uint32_t index, ThreadLocalObjectSharedPtr object) {
   if (thread_local_data_.data_.size() <= index) {
     thread_local_data_.data_.resize(index + 1);
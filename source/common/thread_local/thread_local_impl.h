@@ -11,6 +11,8 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/non_copyable.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace ThreadLocal {
 
@@ -28,6 +30,8 @@ public:
   void shutdownThread() override;
   Event::Dispatcher& dispatcher() override;
   bool isShutdown() const override { return shutdown_; }
+  void beginUpdateBatch() override;
+  uint64_t endUpdateBatch() override;
 
 private:
   // On destruction returns the slot index to the deferred delete queue (detaches it). This allows
@@ -72,6 +76,8 @@ private:
   };
 
   void removeSlot(uint32_t slot);
+  // Posts a callback to a worker, or queues it until the end of the current update batch.
+  void post(Event::Dispatcher& dispatcher, Event::PostCb cb);
   void runOnAllThreads(Event::PostCb cb);
   void runOnAllThreads(Event::PostCb cb, Event::PostCb main_callback);
   static void setThreadLocal(uint32_t index, ThreadLocalObjectSharedPtr object);
@@ -85,6 +91,10 @@ private:
   std::list<std::reference_wrapper<Event::Dispatcher>> registered_threads_;
   Event::Dispatcher* main_thread_dispatcher_{};
   std::atomic<bool> shutdown_{};
+  // Nesting depth of the update batches, and the callbacks queued for each worker by the current
+  // batch, in the order they were queued in.
+  uint32_t update_batch_depth_{};
+  absl::flat_hash_map<Event::Dispatcher*, std::vector<Event::PostCb>> pending_posts_;
 
   // Test only.
   friend class ThreadLocalInstanceImplTest;
@@ -2,6 +2,7 @@
 
 #include "envoy/upstream/upstream.h"
 
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/stream_info/utility.h"
 
 #include "absl/strings/str_cat.h"
@@ -139,6 +140,13 @@ TracerImpl::TracerImpl(DriverSharedPtr driver, const LocalInfo::LocalInfo& local
 SpanPtr TracerImpl::startSpan(const Config& config, TraceContext& trace_context,
                               const StreamInfo::StreamInfo& stream_info,
                               const Tracing::Decision tracing_decision) {
+  // Untraced requests don't need a span when the driver can propagate their context as is.
+  if (!tracing_decision.traced &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.propagate_untraced_context") &&
+      driver_->propagateUntracedContext(trace_context)) {
+    return nullptr;
+  }
+
   std::string span_name = TracerUtility::toString(config.operationName());
 
   if (config.operationName() == OperationName::Egress) {
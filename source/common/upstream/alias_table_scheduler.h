@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "envoy/common/random_generator.h"
+#include "envoy/upstream/scheduler.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Upstream {
+
+// Alias Table Scheduler
+// ---------------------
+// This scheduler performs weighted random selection using Vose's alias method
+// (https://en.wikipedia.org/wiki/Alias_method). The objects are laid out in a table with one
+// column per object. Each column holds its own object with some probability, and an alias object
+// otherwise, such that picking a column uniformly and then one of its two objects honors the
+// weights. A pick draws a single random number and is constant time, whatever the number of
+// objects and the distribution of their weights.
+//
+// Adding an object causes the table to be rebuilt on the first pick that follows, which is linear
+// in the number of objects. Expired objects are purged, with a rebuild, when they are picked.
+//
+// NOTE: The weights are fixed when objects are added: the calculate_weight predicate passed to
+// the picks is ignored. This scheduler must therefore not be used where the object weights change
+// over time (like in the least request LB, or during slow start), as those changes would not be
+// honored until the objects are added again.
+template <class C> class AliasTableScheduler : public Scheduler<C> {
+public:
+  AliasTableScheduler(Random::RandomGenerator& random) : random_(random) {}
+
+  std::shared_ptr<C> peekAgain(std::function<double(const C&)>) override {
+    std::shared_ptr<C> picked = pickInternal();
+    if (picked != nullptr) {
+      prepick_queue_.emplace(picked);
+    }
+    return picked;
+  }
+
+  std::shared_ptr<C> pickAndAdd(std::function<double(const C&)>) override {
+    // Burn through the pre-pick queue.
+    while (!prepick_queue_.empty()) {
+      std::shared_ptr<C> prepicked_obj = prepick_queue_.front().lock();
+      prepick_queue_.pop();
+      if (prepicked_obj != nullptr) {
+        return prepicked_obj;
+      }
+    }
+    return pickInternal();
+  }
+
+  void add(double weight, std::shared_ptr<C> entry) override {
+    ASSERT(weight > 0);
+    entries_.push_back({weight, std::move(entry)});
+    rebuild_table_ = true;
+  }
+
+  bool empty() const override { return entries_.empty(); }
+
+private:
+  struct Entry {
+    double weight_;
+    // We only hold a weak pointer, since we don't support a remove operator. This allows entries to
+    // be lazily unloaded from the table.
+    std::weak_ptr<C> entry_;
+  };
+
+  struct Column {
+    // Probability of picking the column's own entry rather than its alias, scaled to 2^32.
+    uint64_t threshold_;
+    uint32_t alias_;
+  };
+
+  // Builds the alias table with Vose's algorithm in linear time.
+  void rebuildTable() {
+    rebuild_table_ = false;
+    const size_t size = entries_.size();
+    table_.assign(size, Column{0, 0});
+    if (size == 0) {
+      return;
+    }
+
+    double weight_sum = 0;
+    for (const Entry& entry : entries_) {
+      weight_sum += entry.weight_;
+    }
+    // Scale the weights so that their average is 1: each column then has a capacity of 1.
+    std::vector<double> scaled(size);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < size; ++i) {
+      scaled[i] = entries_[i].weight_ * size / weight_sum;
+      (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      const uint32_t less = small.back();
+      small.pop_back();
+      const uint32_t more = large.back();
+      table_[less] = {static_cast<uint64_t>(scaled[less] * ColumnScale), more};
+      // The remaining capacity of the column of `less` is filled from `more`.
+      scaled[more] -= 1.0 - scaled[less];
+      if (scaled[more] < 1.0) {
+        large.pop_back();
+        small.push_back(more);
+      }
+    }
+    // The columns left over are full, up to floating point errors.
+    for (const uint32_t i : large) {
+      table_[i] = {ColumnScale, i};
+    }
+    for (const uint32_t i : small) {
+      table_[i] = {ColumnScale, i};
+    }
+  }
+
+  // Removes the expired entries, which requires the table to be rebuilt.
+  void purgeExpired() {
+    std::vector<Entry> live;
+    live.reserve(entries_.size());
+    for (Entry& entry : entries_) {
+      if (!entry.entry_.expired()) {
+        live.push_back(std::move(entry));
+      }
+    }
+    entries_ = std::move(live);
+    rebuild_table_ = true;
+  }
+
+  std::shared_ptr<C> pickInternal() {
+    while (!entries_.empty()) {
+      if (rebuild_table_) {
+        rebuildTable();
+      }
+      // The low bits choose the column, the high bits choose between its entry and its alias.
+      const uint64_t random = random_.random();
+      const uint32_t column = (random & 0xffffffff) % table_.size();
+      const Column& picked = table_[column];
+      const uint32_t index = (random >> 32) < picked.threshold_ ? column : picked.alias_;
+      std::shared_ptr<C> obj = entries_[index].entry_.lock();
+      if (obj != nullptr) {
+        return obj;
+      }
+      purgeExpired();
+    }
+    return nullptr;
+  }
+
+  static constexpr uint64_t ColumnScale = uint64_t(1) << 32;
+
+  Random::RandomGenerator& random_;
+
+  // Objects already picked via peekAgain().
+  std::queue<std::weak_ptr<C>> prepick_queue_;
+
+  // Objects in the order they were added, with one column of table_ per object.
+  std::vector<Entry> entries_;
+  std::vector<Column> table_;
+  bool rebuild_table_{true};
+};
+
+} // namespace Upstream
+} // namespace Envoy
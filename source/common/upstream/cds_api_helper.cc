@@ -28,6 +28,13 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
     maybe_resume_eds_leds_sds = cm_.adsMux()->pause(paused_xds_types);
   }
 
+  // The clusters applied post their thread local updates to the workers once, at the end of the
+  // update.
+  std::unique_ptr<Cleanup> end_thread_local_update_batch;
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.batch_cds_thread_local_updates")) {
+    end_thread_local_update_batch = cm_.batchThreadLocalUpdates();
+  }
+
   ENVOY_LOG(info, "{}: add {} cluster(s), remove {} cluster(s)", name_, added_resources.size(),
             removed_resources.size());
 
@@ -37,14 +44,15 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
   uint32_t added_or_updated = 0;
   uint32_t skipped = 0;
   for (const auto& resource : added_resources) {
-    envoy::config::cluster::v3::Cluster cluster;
+    const auto& cluster =
+        dynamic_cast<const envoy::config::cluster::v3::Cluster&>(resource.get().resource());
     TRY_ASSERT_MAIN_THREAD {
-      cluster = dynamic_cast<const envoy::config::cluster::v3::Cluster&>(resource.get().resource());
       if (!cluster_names.insert(cluster.name()).second) {
         // NOTE: at this point, the first of these duplicates has already been successfully applied.
         throw EnvoyException(fmt::format("duplicate cluster {} found", cluster.name()));
       }
-      if (cm_.addOrUpdateCluster(cluster, resource.get().version())) {
+      if (cm_.addOrUpdateCluster(cluster, resource.get().version(),
+                                 resource.get().resourceHash())) {
         any_applied = true;
         ENVOY_LOG(debug, "{}: add/update cluster '{}'", name_, cluster.name());
         ++added_or_updated;
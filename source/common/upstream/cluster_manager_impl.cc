@@ -5,6 +5,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "envoy/admin/v3/config_dump.pb.h"
@@ -27,6 +28,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/config/custom_config_validators_impl.h"
 #include "source/common/config/new_grpc_mux_impl.h"
+#include "source/common/config/parallel_resource_decoder.h"
 #include "source/common/config/utility.h"
 #include "source/common/config/xds_mux/grpc_mux_impl.h"
 #include "source/common/config/xds_resource.h"
@@ -59,6 +61,13 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
+// How fast the recent peak of streams used by predictive preconnect decays: long enough to span
+// the lulls between bursts, short enough not to keep connections warm long after traffic shifted.
+constexpr std::chrono::milliseconds PreconnectDemandHalfLife{10000};
+
+// Beyond a few threads, the resources the main thread then visits in order become the bottleneck.
+constexpr uint32_t MaxXdsDecodingThreads = 4;
+
 void addOptionsIfNotNull(Network::Socket::OptionsSharedPtr& options,
                          const Network::Socket::OptionsSharedPtr& to_add) {
   if (to_add != nullptr) {
@@ -286,7 +295,7 @@ ClusterManagerImpl::ClusterManagerImpl(
     ProtobufMessage::ValidationContext& validation_context, Api::Api& api,
     Http::Context& http_context, Grpc::Context& grpc_context, Router::Context& router_context,
     const Server::Instance& server)
-    : factory_(factory), runtime_(runtime), stats_(stats), tls_(tls),
+    : factory_(factory), runtime_(runtime), stats_(stats), tls_(tls), thread_local_(tls),
       random_(api.randomGenerator()),
       bind_config_(bootstrap.cluster_manager().has_upstream_bind_config()
                        ? absl::make_optional(bootstrap.cluster_manager().upstream_bind_config())
@@ -436,6 +445,14 @@ ClusterManagerImpl::ClusterManagerImpl(
             std::move(custom_config_validators), makeOptRefFromPtr(xds_config_tracker_.get()),
             xds_delegate_opt_ref, target_xds_authority);
       } else {
+        Config::ParallelResourceDecoderSharedPtr parallel_resource_decoder;
+        if (Runtime::runtimeFeatureEnabled(
+                "envoy.reloadable_features.parallel_xds_resource_decoding")) {
+          // The main thread decodes along with these threads.
+          const uint32_t cpus = std::thread::hardware_concurrency();
+          parallel_resource_decoder = std::make_shared<Config::ParallelResourceDecoder>(
+              api.threadFactory(), cpus > 1 ? std::min(MaxXdsDecodingThreads, cpus - 1) : 0);
+        }
         ads_mux_ = std::make_shared<Config::GrpcMuxImpl>(
             local_info,
             Config::Utility::factoryForGrpcApiConfigSource(
@@ -448,7 +465,7 @@ ClusterManagerImpl::ClusterManagerImpl(
             Envoy::Config::Utility::parseRateLimitSettings(dyn_resources.ads_config()),
             bootstrap.dynamic_resources().ads_config().set_node_on_first_message_only(),
             std::move(custom_config_validators), makeOptRefFromPtr(xds_config_tracker_.get()),
-            xds_delegate_opt_ref, target_xds_authority);
+            xds_delegate_opt_ref, target_xds_authority, std::move(parallel_resource_decoder));
       }
     }
   } else {
@@ -528,7 +545,7 @@ void ClusterManagerImpl::initializeSecondaryClusters(
         Config::Utility::factoryForGrpcApiConfigSource(*async_client_manager_, load_stats_config,
                                                        *stats_.rootScope(), false)
             ->createUncachedRawAsyncClient(),
-        dispatcher_);
+        dispatcher_, cm_config.report_only_changed_localities());
   }
 }
 
@@ -710,7 +727,8 @@ void ClusterManagerImpl::applyUpdates(ClusterManagerCluster& cluster, uint32_t p
 }
 
 bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                                            const std::string& version_info) {
+                                            const std::string& version_info,
+                                            absl::optional<uint64_t> hash) {
   // First we need to see if this new config is new or an update to an existing dynamic cluster.
   // We don't allow updates to statically configured clusters in the main configuration. We check
   // both the warming clusters and the active clusters to see if we need an update or the update
@@ -718,7 +736,7 @@ bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cl
   const std::string& cluster_name = cluster.name();
   const auto existing_active_cluster = active_clusters_.find(cluster_name);
   const auto existing_warming_cluster = warming_clusters_.find(cluster_name);
-  const uint64_t new_hash = MessageUtil::hash(cluster);
+  const uint64_t new_hash = hash.has_value() ? *hash : MessageUtil::hash(cluster);
   if (existing_warming_cluster != warming_clusters_.end()) {
     // If the cluster is the same as the warming cluster of the same name, block the update.
     if (existing_warming_cluster->second->blockUpdate(new_hash)) {
@@ -828,6 +846,12 @@ bool ClusterManagerImpl::removeCluster(const std::string& cluster_name) {
   return removed;
 }
 
+std::unique_ptr<Cleanup> ClusterManagerImpl::batchThreadLocalUpdates() {
+  thread_local_.beginUpdateBatch();
+  return std::make_unique<Cleanup>(
+      [this]() { cm_stats_.tls_update_posts_saved_.add(thread_local_.endUpdateBatch()); });
+}
+
 ClusterManagerImpl::ClusterDataPtr
 ClusterManagerImpl::loadCluster(const envoy::config::cluster::v3::Cluster& cluster,
                                 const uint64_t cluster_hash, const std::string& version_info,
@@ -909,7 +933,8 @@ ClusterManagerImpl::loadCluster(const envoy::config::cluster::v3::Cluster& clust
       cluster_entry_it->second->thread_aware_lb_ = std::make_unique<MaglevLoadBalancer>(
           cluster_reference.prioritySet(), cluster_reference.info()->lbStats(),
           cluster_reference.info()->statsScope(), runtime_, random_,
-          cluster_reference.info()->lbMaglevConfig(), cluster_reference.info()->lbConfig());
+          cluster_reference.info()->lbMaglevConfig(), cluster_reference.info()->lbConfig(),
+          time_source_);
     }
   } else if (cluster_reference.info()->lbType() == LoadBalancerType::ClusterProvided) {
     cluster_entry_it->second->thread_aware_lb_ = std::move(new_cluster_pair.second);
@@ -973,6 +998,17 @@ void ClusterManagerImpl::maybePreconnect(
     return;
   }
 
+  uint32_t pending_streams = state.pending_streams_;
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.predictive_preconnect_recent_peak")) {
+    // Provision for the recent peak of streams rather than for the current ones only, so that
+    // connections to the hosts the load balancer picks next are established ahead of the bursts
+    // following a lull. The streams over the current ones are accounted as pending, and the
+    // incoming stream is anticipated like below.
+    const uint32_t streams = state.pending_streams_ + state.active_streams_ + 1;
+    pending_streams += cluster_entry.updateStreamDemand(streams) - streams;
+  }
+
   // 3 here is arbitrary. Just as in ConnPoolImplBase::tryCreateNewConnections
   // we want to limit the work which can be done on any given preconnect attempt.
   for (int i = 0; i < 3; ++i) {
@@ -982,7 +1018,7 @@ void ClusterManagerImpl::maybePreconnect(
     // We anticipate the incoming stream here, because maybePreconnect is called
     // before a new stream is established.
     if (!ConnectionPool::ConnPoolImplBase::shouldConnect(
-            state.pending_streams_, state.active_streams_,
+            pending_streams, state.active_streams_,
             state.connecting_and_connected_stream_capacity_, peekahead_ratio, true)) {
       return;
     }
@@ -1076,8 +1112,9 @@ void ClusterManagerImpl::checkActiveStaticCluster(const std::string& cluster) {
 void ClusterManagerImpl::postThreadLocalRemoveHosts(const Cluster& cluster,
                                                     const HostVector& hosts_removed) {
   tls_.runOnAllThreads([name = cluster.info()->name(),
-                        hosts_removed](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
-    cluster_manager->removeHosts(name, hosts_removed);
+                        hosts_removed = std::make_shared<const HostVector>(hosts_removed)](
+                           OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+    cluster_manager->removeHosts(name, *hosts_removed);
   });
 }
 
@@ -1104,8 +1141,12 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
 
   HostMapConstSharedPtr host_map = cm_cluster.cluster().prioritySet().crossPriorityHostMap();
 
+  // The update callback is copied for every worker, so the workers share a single immutable
+  // snapshot of the update instead of each copying the added and removed hosts.
+  auto shared_params = std::make_shared<const ThreadLocalClusterUpdateParams>(std::move(params));
+
   pending_cluster_creations_.erase(cm_cluster.cluster().info()->name());
-  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(params),
+  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(shared_params),
                         add_or_update_cluster, load_balancer_factory, map = std::move(host_map)](
                            OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
     ThreadLocalClusterManagerImpl::ClusterEntry* new_cluster = nullptr;
@@ -1121,7 +1162,7 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
       cluster_manager->thread_local_clusters_[info->name()].reset(new_cluster);
     }
 
-    for (const auto& per_priority : params.per_priority_update_params_) {
+    for (const auto& per_priority : params->per_priority_update_params_) {
       cluster_manager->updateClusterMembership(
           info->name(), per_priority.priority_, per_priority.update_hosts_params_,
           per_priority.locality_weights_, per_priority.hosts_added_, per_priority.hosts_removed_,
@@ -1533,7 +1574,8 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
     ThreadLocalClusterManagerImpl& parent, ClusterInfoConstSharedPtr cluster,
     const LoadBalancerFactorySharedPtr& lb_factory)
     : parent_(parent), lb_factory_(lb_factory), cluster_info_(cluster),
-      override_host_statuses_(HostUtility::createOverrideHostStatus(cluster_info_->lbConfig())) {
+      override_host_statuses_(HostUtility::createOverrideHostStatus(cluster_info_->lbConfig())),
+      stream_demand_(parent.thread_local_dispatcher_.timeSource(), PreconnectDemandHalfLife) {
   priority_set_.getOrCreateHostSet(0);
 
   // TODO(mattklein123): Consider converting other LBs over to thread local. All of them could
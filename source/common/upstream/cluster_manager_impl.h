@@ -41,6 +41,7 @@
 #include "source/common/upstream/load_stats_reporter.h"
 #include "source/common/upstream/od_cds_api_impl.h"
 #include "source/common/upstream/priority_conn_pool_map.h"
+#include "source/common/upstream/stream_demand_estimator.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/server/factory_context_base_impl.h"
 
@@ -226,6 +227,7 @@ private:
   COUNTER(cluster_removed)                                                                         \
   COUNTER(cluster_updated)                                                                         \
   COUNTER(cluster_updated_via_merge)                                                               \
+  COUNTER(tls_update_posts_saved)                                                                  \
   COUNTER(update_merge_cancelled)                                                                  \
   COUNTER(update_out_of_merge_window)                                                              \
   GAUGE(active_clusters, NeverImport)                                                              \
@@ -260,7 +262,8 @@ public:
 
   // Upstream::ClusterManager
   bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                          const std::string& version_info) override;
+                          const std::string& version_info,
+                          absl::optional<uint64_t> hash = absl::nullopt) override;
 
   void setPrimaryClustersInitializedCb(PrimaryClustersReadyCallback callback) override {
     init_helper_.setPrimaryClustersInitializedCb(callback);
@@ -295,6 +298,7 @@ public:
   ThreadLocalCluster* getThreadLocalCluster(absl::string_view cluster) override;
 
   bool removeCluster(const std::string& cluster) override;
+  std::unique_ptr<Cleanup> batchThreadLocalUpdates() override;
   void shutdown() override {
     if (resume_cds_ != nullptr) {
       resume_cds_->cancel();
@@ -548,6 +552,10 @@ private:
       void drainConnPools(DrainConnectionsHostPredicate predicate,
                           ConnectionPool::DrainBehavior behavior);
 
+      // Records the current number of streams of the worker for predictive preconnect, and
+      // returns the number of streams to provision for.
+      uint32_t updateStreamDemand(uint32_t streams) { return stream_demand_.update(streams); }
+
     private:
       Http::ConnectionPool::Instance*
       httpConnPoolImpl(ResourcePriority priority,
@@ -595,6 +603,9 @@ private:
       // If multiple bit fields are set, it is acceptable as long as the status of override host is
       // in any of these statuses.
       const HostUtility::HostStatusSet override_host_statuses_{};
+
+      // Recent peak of the number of streams, see updateStreamDemand().
+      StreamDemandEstimator stream_demand_;
     };
 
     using ClusterEntryPtr = std::unique_ptr<ClusterEntry>;
@@ -782,6 +793,7 @@ private:
   Runtime::Loader& runtime_;
   Stats::Store& stats_;
   ThreadLocal::TypedSlot<ThreadLocalClusterManagerImpl> tls_;
+  ThreadLocal::Instance& thread_local_;
   // Contains information about ongoing on-demand cluster discoveries.
   ClusterCreationsMap pending_cluster_creations_;
   Random::RandomGenerator& random_;
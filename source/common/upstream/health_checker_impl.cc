@@ -383,11 +383,15 @@ void HttpHealthCheckerImpl::HttpActiveHealthCheckSession::onInterval() {
       // Here there is no downstream connection so scheme will be based on
       // upstream crypto
       host_->transportSocketFactory().implementsSecureTransport());
-  StreamInfo::StreamInfoImpl stream_info(protocol_, parent_.dispatcher_.timeSource(),
-                                         local_connection_info_provider_);
-  stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
-  stream_info.upstreamInfo()->setUpstreamHost(host_);
-  parent_.request_headers_parser_->evaluateHeaders(*request_headers, stream_info);
+  // The stream info is only needed to format the configured headers, so avoid building it for
+  // every check when there are none.
+  if (!parent_.request_headers_parser_->empty()) {
+    StreamInfo::StreamInfoImpl stream_info(protocol_, parent_.dispatcher_.timeSource(),
+                                           local_connection_info_provider_);
+    stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
+    stream_info.upstreamInfo()->setUpstreamHost(host_);
+    parent_.request_headers_parser_->evaluateHeaders(*request_headers, stream_info);
+  }
   auto status = request_encoder->encodeHeaders(*request_headers, true);
   // Encoding will only fail if required request headers are missing.
   ASSERT(status.ok());
@@ -817,11 +821,13 @@ void GrpcHealthCheckerImpl::GrpcActiveHealthCheckSession::onInterval() {
   headers_message->headers().setReferenceUserAgent(
       Http::Headers::get().UserAgentValues.EnvoyHealthChecker);
 
-  StreamInfo::StreamInfoImpl stream_info(Http::Protocol::Http2, parent_.dispatcher_.timeSource(),
-                                         local_connection_info_provider_);
-  stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
-  stream_info.upstreamInfo()->setUpstreamHost(host_);
-  parent_.request_headers_parser_->evaluateHeaders(headers_message->headers(), stream_info);
+  if (!parent_.request_headers_parser_->empty()) {
+    StreamInfo::StreamInfoImpl stream_info(Http::Protocol::Http2, parent_.dispatcher_.timeSource(),
+                                           local_connection_info_provider_);
+    stream_info.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
+    stream_info.upstreamInfo()->setUpstreamHost(host_);
+    parent_.request_headers_parser_->evaluateHeaders(headers_message->headers(), stream_info);
+  }
 
   Grpc::Common::toGrpcTimeout(parent_.timeout_, headers_message->headers());
 
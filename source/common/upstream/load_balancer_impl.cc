@@ -767,6 +767,8 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
     : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
                                 healthy_panic_threshold, locality_config),
       seed_(random_.random()),
+      incremental_refresh_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.edf_lb_incremental_refresh")),
       slow_start_window_(slow_start_config.has_value()
                              ? std::chrono::milliseconds(DurationUtil::durationToMilliseconds(
                                    slow_start_config.value().slow_start_window()))
@@ -783,9 +785,9 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
                                          : 0.1) {
   // We fully recompute the schedulers for a given host set here on membership change, which is
   // consistent with what other LB implementations do (e.g. thread aware).
-  // The downside of a full recompute is that time complexity is O(n * log n),
-  // so we will need to do better at delta tracking to scale (see
-  // https://github.com/envoyproxy/envoy/issues/2874).
+  // The downside of a full recompute is that time complexity is O(n * log n), so with
+  // incremental_refresh_ the schedulers of the sources whose hosts are unchanged, or were only
+  // added to, are kept instead (see https://github.com/envoyproxy/envoy/issues/2874).
   priority_update_cb_ = priority_set.addPriorityUpdateCb(
       [this](uint32_t priority, const HostVector&, const HostVector&) { refresh(priority); });
   member_update_cb_ = priority_set.addMemberUpdateCb(
@@ -826,10 +828,65 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
   }
 }
 
+bool EdfLoadBalancerBase::refreshIncrementally(const HostsSource& source, Scheduler& scheduler,
+                                               const HostVector& hosts) {
+  // Slow start changes the host weights, and whether a scheduler is needed at all, over time.
+  if (isSlowStartEnabled()) {
+    return false;
+  }
+  // Weight updates of existing hosts are only picked up by a rebuild when the scheduler does not
+  // track them, and they can't be told apart from unchanged hosts.
+  if (scheduler.weighted_ != nullptr && !weightedSchedulerTracksWeights()) {
+    return false;
+  }
+
+  // Host sources keep the order of the hosts of the cluster, so the previous hosts of the source
+  // must show up in the same order in its new hosts. Anything else needs a rebuild.
+  HostVector hosts_added;
+  size_t previous = 0;
+  for (const auto& host : hosts) {
+    if (previous < scheduler.hosts_.size() && scheduler.hosts_[previous] == host) {
+      ++previous;
+    } else {
+      hosts_added.push_back(host);
+    }
+  }
+  if (previous != scheduler.hosts_.size()) {
+    return false;
+  }
+
+  if (scheduler.weighted_ == nullptr) {
+    // Unweighted selection picks directly from the hosts of the source, as long as their weights
+    // are still equal.
+    if (!hostWeightsAreEqual(hosts)) {
+      return false;
+    }
+  } else {
+    for (const auto& host : hosts_added) {
+      scheduler.weighted_->add(hostWeight(*host), host);
+    }
+  }
+  if (!hosts_added.empty()) {
+    refreshHostSource(source);
+    scheduler.hosts_ = hosts;
+  }
+  return true;
+}
+
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
   const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
+    if (incremental_refresh_) {
+      auto it = scheduler_.find(source);
+      if (it != scheduler_.end() && refreshIncrementally(source, it->second, hosts)) {
+        return;
+      }
+    }
+
     // Nuke existing scheduler if it exists.
     auto& scheduler = scheduler_[source] = Scheduler{};
+    if (incremental_refresh_) {
+      scheduler.hosts_ = hosts;
+    }
     refreshHostSource(source);
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
@@ -843,7 +900,7 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
       // Skip edf creation.
       return;
     }
-    scheduler.edf_ = std::make_unique<EdfScheduler<const Host>>();
+    scheduler.weighted_ = createWeightedScheduler();
 
     // Populate scheduler with host list.
     // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
@@ -855,7 +912,7 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
       // notification, this will only be stale until this host is next picked,
       // at which point it is reinserted into the EdfScheduler with its new
       // weight in chooseHost().
-      scheduler.edf_->add(hostWeight(*host), host);
+      scheduler.weighted_->add(hostWeight(*host), host);
     }
 
     // Cycle through hosts to achieve the intended offset behavior.
@@ -864,7 +921,7 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
     if (!hosts.empty()) {
       for (uint32_t i = 0; i < seed_ % hosts.size(); ++i) {
         auto host =
-            scheduler.edf_->pickAndAdd([this](const Host& host) { return hostWeight(host); });
+            scheduler.weighted_->pickAndAdd([this](const Host& host) { return hostWeight(host); });
       }
     }
   };
@@ -923,10 +980,10 @@ HostConstSharedPtr EdfLoadBalancerBase::peekAnotherHost(LoadBalancerContext* con
 
   // As has been commented in both EdfLoadBalancerBase::refresh and
   // BaseDynamicClusterImpl::updateDynamicHostList, we must do a runtime pivot here to determine
-  // whether to use EDF or do unweighted (fast) selection. EDF is non-null iff the original
-  // weights of 2 or more hosts differ.
-  if (scheduler.edf_ != nullptr) {
-    return scheduler.edf_->peekAgain([this](const Host& host) { return hostWeight(host); });
+  // whether to use the weighted scheduler or do unweighted (fast) selection. The weighted
+  // scheduler is non-null iff the original weights of 2 or more hosts differ.
+  if (scheduler.weighted_ != nullptr) {
+    return scheduler.weighted_->peekAgain([this](const Host& host) { return hostWeight(host); });
   } else {
     const HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
     if (hosts_to_use.empty()) {
@@ -949,10 +1006,11 @@ HostConstSharedPtr EdfLoadBalancerBase::chooseHostOnce(LoadBalancerContext* cont
 
   // As has been commented in both EdfLoadBalancerBase::refresh and
   // BaseDynamicClusterImpl::updateDynamicHostList, we must do a runtime pivot here to determine
-  // whether to use EDF or do unweighted (fast) selection. EDF is non-null iff the original
-  // weights of 2 or more hosts differ.
-  if (scheduler.edf_ != nullptr) {
-    auto host = scheduler.edf_->pickAndAdd([this](const Host& host) { return hostWeight(host); });
+  // whether to use the weighted scheduler or do unweighted (fast) selection. The weighted
+  // scheduler is non-null iff the original weights of 2 or more hosts differ.
+  if (scheduler.weighted_ != nullptr) {
+    auto host =
+        scheduler.weighted_->pickAndAdd([this](const Host& host) { return hostWeight(host); });
     return host;
   } else {
     const HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
@@ -24,6 +24,8 @@
 
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_protos.h"
+#include "source/common/runtime/runtime_features.h"
+#include "source/common/upstream/alias_table_scheduler.h"
 #include "source/common/upstream/edf_scheduler.h"
 
 namespace Envoy {
@@ -475,14 +477,30 @@ public:
 
 protected:
   struct Scheduler {
-    // EdfScheduler for weighted LB. The edf_ is only created when the original
-    // host weights of 2 or more hosts differ. When not present, the
-    // implementation of chooseHostOnce falls back to unweightedHostPick.
-    std::unique_ptr<EdfScheduler<const Host>> edf_;
+    // Scheduler for weighted LB, an EdfScheduler unless createWeightedScheduler() is overridden.
+    // The weighted_ scheduler is only created when the original host weights of 2 or more hosts
+    // differ. When not present, the implementation of chooseHostOnce falls back to
+    // unweightedHostPick.
+    std::unique_ptr<Upstream::Scheduler<const Host>> weighted_;
+    // Hosts of the source as of the last refresh, only kept when refreshes are incremental.
+    HostVector hosts_;
   };
 
   void initialize();
 
+  /**
+   * @return a new empty scheduler for weighted host selection.
+   */
+  virtual std::unique_ptr<Upstream::Scheduler<const Host>> createWeightedScheduler() {
+    return std::make_unique<EdfScheduler<const Host>>();
+  }
+
+  /**
+   * @return whether the weighted scheduler honors the weights returned by hostWeight() when a
+   *         host is picked again, rather than only those of the hosts when they were added.
+   */
+  virtual bool weightedSchedulerTracksWeights() const { return true; }
+
   virtual void refresh(uint32_t priority);
 
   bool isSlowStartEnabled();
@@ -509,6 +527,14 @@ private:
   virtual HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                                 const HostsSource& source) PURE;
 
+  // Brings the scheduler of a source up to date with its new hosts without rebuilding it, which
+  // is possible when hosts were only added to the source. Returns false if a rebuild is needed.
+  bool refreshIncrementally(const HostsSource& source, Scheduler& scheduler,
+                            const HostVector& hosts);
+
+  // Whether refresh() applies the changes to the hosts of each source to its existing scheduler
+  // when possible, instead of rebuilding all of the schedulers of the priority.
+  const bool incremental_refresh_;
   // Scheduler for each valid HostsSource.
   absl::node_hash_map<HostsSource, Scheduler, HostsSourceHash> scheduler_;
   Common::CallbackHandlePtr priority_update_cb_;
@@ -527,6 +553,10 @@ protected:
 /**
  * A round robin load balancer. When in weighted mode, EDF scheduling is used. When in not
  * weighted mode, simple RR index selection is used.
+ *
+ * With the envoy.reloadable_features.round_robin_alias_table runtime guard, weighted mode uses an
+ * AliasTableScheduler instead of EDF, unless slow start is configured. Picks are then weighted
+ * random, which keeps the same long term distribution as EDF with O(1) picks and O(n) rebuilds.
  */
 class RoundRobinLoadBalancer : public EdfLoadBalancerBase {
 public:
@@ -544,7 +574,8 @@ public:
             round_robin_config.has_value()
                 ? LoadBalancerConfigHelper::slowStartConfigFromLegacyProto(round_robin_config.ref())
                 : absl::nullopt,
-            time_source) {
+            time_source),
+        use_alias_table_(useAliasTable()) {
     initialize();
   }
 
@@ -557,11 +588,25 @@ public:
       : EdfLoadBalancerBase(
             priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
             LoadBalancerConfigHelper::localityLbConfigFromProto(round_robin_config),
-            LoadBalancerConfigHelper::slowStartConfigFromProto(round_robin_config), time_source) {
+            LoadBalancerConfigHelper::slowStartConfigFromProto(round_robin_config), time_source),
+        use_alias_table_(useAliasTable()) {
     initialize();
   }
 
 private:
+  bool useAliasTable() {
+    // Slow start changes the weights of the hosts between refreshes, which the alias table
+    // does not support.
+    return Runtime::runtimeFeatureEnabled("envoy.reloadable_features.round_robin_alias_table") &&
+           !isSlowStartEnabled();
+  }
+  std::unique_ptr<Upstream::Scheduler<const Host>> createWeightedScheduler() override {
+    if (use_alias_table_) {
+      return std::make_unique<AliasTableScheduler<const Host>>(random_);
+    }
+    return EdfLoadBalancerBase::createWeightedScheduler();
+  }
+  bool weightedSchedulerTracksWeights() const override { return !use_alias_table_; }
   void refreshHostSource(const HostsSource& source) override {
     // insert() is used here on purpose so that we don't overwrite the index if the host source
     // already exists. Note that host sources will never be removed, but given how uncommon this
@@ -599,6 +644,7 @@ private:
     return hosts_to_use[rr_indexes_[source]++ % hosts_to_use.size()];
   }
 
+  const bool use_alias_table_;
   uint64_t peekahead_index_{};
   absl::node_hash_map<HostsSource, uint64_t, HostsSourceHash> rr_indexes_;
 };
@@ -775,6 +821,8 @@ public:
       : default_subset_(subset_config.default_subset()),
         fallback_policy_(subset_config.fallback_policy()),
         metadata_fallback_policy_(subset_config.metadata_fallback_policy()),
+        max_subset_load_balancers_(
+            PROTOBUF_GET_WRAPPED_OR_DEFAULT(subset_config, max_subset_load_balancers, 0)),
         enabled_(!subset_config.subset_selectors().empty()),
         locality_weight_aware_(subset_config.locality_weight_aware()),
         scale_locality_weight_(subset_config.scale_locality_weight()),
@@ -809,6 +857,7 @@ public:
   bool scaleLocalityWeight() const override { return scale_locality_weight_; }
   bool panicModeAny() const override { return panic_mode_any_; }
   bool listAsAny() const override { return list_as_any_; }
+  uint32_t maxSubsetLoadBalancers() const override { return max_subset_load_balancers_; }
 
 private:
   const ProtobufWkt::Struct default_subset_;
@@ -818,6 +867,7 @@ private:
       fallback_policy_;
   const envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetMetadataFallbackPolicy
       metadata_fallback_policy_;
+  const uint32_t max_subset_load_balancers_;
   const bool enabled_ : 1;
   const bool locality_weight_aware_ : 1;
   const bool scale_locality_weight_ : 1;
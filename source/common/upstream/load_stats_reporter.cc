@@ -11,13 +11,15 @@ namespace Upstream {
 LoadStatsReporter::LoadStatsReporter(const LocalInfo::LocalInfo& local_info,
                                      ClusterManager& cluster_manager, Stats::Scope& scope,
                                      Grpc::RawAsyncClientPtr async_client,
-                                     Event::Dispatcher& dispatcher)
+                                     Event::Dispatcher& dispatcher,
+                                     bool report_only_changed_localities)
     : cm_(cluster_manager), stats_{ALL_LOAD_REPORTER_STATS(
                                 POOL_COUNTER_PREFIX(scope, "load_reporter."))},
       async_client_(std::move(async_client)),
       service_method_(*Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
           "envoy.service.load_stats.v3.LoadReportingService.StreamLoadStats")),
-      time_source_(dispatcher.timeSource()) {
+      time_source_(dispatcher.timeSource()),
+      report_only_changed_localities_(report_only_changed_localities) {
   request_.mutable_node()->MergeFrom(local_info.node());
   request_.mutable_node()->add_client_features("envoy.lrs.supports_send_all_clusters");
   retry_timer_ = dispatcher.createTimer([this]() -> void { establishNewStream(); });
@@ -58,6 +60,8 @@ void LoadStatsReporter::sendLoadStatsRequest() {
   // added to the cluster manager. When we get the notification, we record the current time in
   // clusters_ as the start time for the load reporting window for that cluster.
   request_.mutable_cluster_stats()->Clear();
+  // The requests in progress of the localities with load, when only the changed ones are reported.
+  absl::flat_hash_map<const LocalityLoadStats*, uint64_t> rq_active;
   auto all_clusters = cm_.clusters();
   for (const auto& cluster_name_and_timestamp : clusters_) {
     const std::string& cluster_name = cluster_name_and_timestamp.first;
@@ -76,42 +80,35 @@ void LoadStatsReporter::sendLoadStatsRequest() {
       ENVOY_LOG(trace, "Load report locality count {}", host_set->hostsPerLocality().get().size());
       for (const HostVector& hosts : host_set->hostsPerLocality().get()) {
         ASSERT(!hosts.empty());
-        uint64_t rq_success = 0;
-        uint64_t rq_error = 0;
-        uint64_t rq_active = 0;
-        uint64_t rq_issued = 0;
-        LoadMetricStats::StatMap load_metrics;
-        for (const HostSharedPtr& host : hosts) {
-          uint64_t host_rq_success = host->stats().rq_success_.latch();
-          uint64_t host_rq_error = host->stats().rq_error_.latch();
-          uint64_t host_rq_active = host->stats().rq_active_.value();
-          uint64_t host_rq_issued = host->stats().rq_total_.latch();
-          rq_success += host_rq_success;
-          rq_error += host_rq_error;
-          rq_active += host_rq_active;
-          rq_issued += host_rq_issued;
-          if (host_rq_success + host_rq_error + host_rq_active != 0) {
-            const std::unique_ptr<LoadMetricStats::StatMap> latched_stats =
-                host->loadMetricStats().latch();
-            if (latched_stats != nullptr) {
-              for (const auto& metric : *latched_stats) {
-                const std::string& name = metric.first;
-                LoadMetricStats::Stat& stat = load_metrics[name];
-                stat.num_requests_with_metric += metric.second.num_requests_with_metric;
-                stat.total_metric_value += metric.second.total_metric_value;
-              }
-            }
+        // All the hosts of the locality share the aggregated stats.
+        LocalityLoadStats& stats = hosts[0]->localityLoadStats();
+        const LocalityLoadStats::LatchedStats latched = stats.latch();
+        const std::unique_ptr<LoadMetricStats::StatMap> load_metrics =
+            stats.loadMetricStats().latch();
+        if (latched.rq_success_ + latched.rq_error_ + latched.rq_active_ == 0) {
+          continue;
+        }
+        if (report_only_changed_localities_) {
+          // Skip the localities whose only load is the same requests in progress as last time.
+          const auto previous = rq_active_.find(&stats);
+          const bool unchanged = previous != rq_active_.end() &&
+                                 previous->second == latched.rq_active_ &&
+                                 latched.rq_success_ + latched.rq_error_ + latched.rq_total_ == 0 &&
+                                 load_metrics == nullptr;
+          rq_active[&stats] = latched.rq_active_;
+          if (unchanged) {
+            continue;
           }
         }
-        if (rq_success + rq_error + rq_active != 0) {
-          auto* locality_stats = cluster_stats->add_upstream_locality_stats();
-          locality_stats->mutable_locality()->MergeFrom(hosts[0]->locality());
-          locality_stats->set_priority(host_set->priority());
-          locality_stats->set_total_successful_requests(rq_success);
-          locality_stats->set_total_error_requests(rq_error);
-          locality_stats->set_total_requests_in_progress(rq_active);
-          locality_stats->set_total_issued_requests(rq_issued);
-          for (const auto& metric : load_metrics) {
+        auto* locality_stats = cluster_stats->add_upstream_locality_stats();
+        locality_stats->mutable_locality()->MergeFrom(hosts[0]->locality());
+        locality_stats->set_priority(host_set->priority());
+        locality_stats->set_total_successful_requests(latched.rq_success_);
+        locality_stats->set_total_error_requests(latched.rq_error_);
+        locality_stats->set_total_requests_in_progress(latched.rq_active_);
+        locality_stats->set_total_issued_requests(latched.rq_total_);
+        if (load_metrics != nullptr) {
+          for (const auto& metric : *load_metrics) {
             auto* load_metric_stats = locality_stats->add_load_metric_stats();
             load_metric_stats->set_metric_name(metric.first);
             load_metric_stats->set_num_requests_finished_with_metric(
@@ -131,6 +128,8 @@ void LoadStatsReporter::sendLoadStatsRequest() {
     clusters_[cluster_name] = now;
   }
 
+  rq_active_ = std::move(rq_active);
+
   ENVOY_LOG(trace, "Sending LoadStatsRequest: {}", request_.DebugString());
   stream_->sendMessage(request_, false);
   stats_.responses_.inc();
@@ -207,10 +206,11 @@ void LoadStatsReporter::startLoadReportPeriod() {
     }
     auto& cluster = it->second.get();
     for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
-      for (const auto& host : host_set->hosts()) {
-        host->stats().rq_success_.latch();
-        host->stats().rq_error_.latch();
-        host->stats().rq_total_.latch();
+      for (const HostVector& hosts : host_set->hostsPerLocality().get()) {
+        ASSERT(!hosts.empty());
+        LocalityLoadStats& stats = hosts[0]->localityLoadStats();
+        stats.latch();
+        stats.loadMetricStats().latch();
       }
     }
     cluster.info()->loadReportStats().upstream_rq_dropped_.latch();
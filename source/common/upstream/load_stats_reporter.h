@@ -10,6 +10,8 @@
 #include "source/common/grpc/async_client_impl.h"
 #include "source/common/grpc/typed_async_client.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -34,7 +36,7 @@ class LoadStatsReporter
 public:
   LoadStatsReporter(const LocalInfo::LocalInfo& local_info, ClusterManager& cluster_manager,
                     Stats::Scope& scope, Grpc::RawAsyncClientPtr async_client,
-                    Event::Dispatcher& dispatcher);
+                    Event::Dispatcher& dispatcher, bool report_only_changed_localities);
 
   // Grpc::AsyncStreamCallbacks
   void onCreateInitialMetadata(Http::RequestHeaderMap& metadata) override;
@@ -68,6 +70,10 @@ private:
   // Map from cluster name to start of measurement interval.
   absl::node_hash_map<std::string, std::chrono::steady_clock::duration> clusters_;
   TimeSource& time_source_;
+  const bool report_only_changed_localities_;
+  // The requests in progress of the localities in the previous report, when only the changed
+  // localities are reported.
+  absl::flat_hash_map<const LocalityLoadStats*, uint64_t> rq_active_;
 };
 
 using LoadStatsReporterPtr = std::unique_ptr<LoadStatsReporter>;
@@ -2,6 +2,8 @@
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
+#include "source/common/stats/timespan_impl.h"
+
 namespace Envoy {
 namespace Upstream {
 namespace {
@@ -60,9 +62,12 @@ ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
 MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
                                        double /* min_normalized_weight */,
                                        double max_normalized_weight) {
+  Stats::HistogramCompletableTimespanImpl table_build_timespan(stats_.table_build_time_us_,
+                                                               time_source_);
   HashingLoadBalancerSharedPtr maglev_lb =
       MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight, table_size_,
                                        use_hostname_for_hashing_, stats_);
+  table_build_timespan.complete();
 
   if (hash_balance_factor_ == 0) {
     return maglev_lb;
@@ -130,12 +135,12 @@ void OriginalMaglevTable::constructImplementationInternals(
       entry.target_weight_ += max_normalized_weight;
       uint64_t c = permutation(entry);
       while (table_[c] != nullptr) {
-        entry.next_++;
+        advancePermutation(entry);
         c = permutation(entry);
       }
 
       table_[c] = entry.host_;
-      entry.next_++;
+      advancePermutation(entry);
       entry.count_++;
       table_index++;
     }
@@ -162,8 +167,9 @@ void CompactMaglevTable::constructImplementationInternals(
   host_table_.shrink_to_fit();
 
   // Vector to track whether or not a given fixed width bit is set in the
-  // BitArray used as the maglev table.
-  std::vector<bool> occupied(table_size_, false);
+  // BitArray used as the maglev table. Bytes are used rather than a std::vector<bool> as the
+  // probes for free entries dominate the build time of large tables.
+  std::vector<uint8_t> occupied(table_size_, 0);
 
   // Iterate through the table build entries as many times as it takes to fill up the table.
   uint64_t table_index = 0;
@@ -182,15 +188,15 @@ void CompactMaglevTable::constructImplementationInternals(
       // 32-bit, hence static_cast here should be safe.
       uint32_t c = static_cast<uint32_t>(permutation(entry));
       while (occupied[c]) {
-        entry.next_++;
+        advancePermutation(entry);
         c = static_cast<uint32_t>(permutation(entry));
       }
 
       // Record the index of the given host.
       table_.set(c, i);
-      occupied[c] = true;
+      occupied[c] = 1;
 
-      entry.next_++;
+      advancePermutation(entry);
       entry.count_++;
       table_index++;
     }
@@ -253,15 +259,12 @@ HostConstSharedPtr CompactMaglevTable::chooseHost(uint64_t hash, uint32_t attemp
   return host_table_[index];
 }
 
-uint64_t MaglevTable::permutation(const TableBuildEntry& entry) {
-  return (entry.offset_ + (entry.skip_ * entry.next_)) % table_size_;
-}
-
 MaglevLoadBalancer::MaglevLoadBalancer(
     const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
     Runtime::Loader& runtime, Random::RandomGenerator& random,
     OptRef<const envoy::config::cluster::v3::Cluster::MaglevLbConfig> config,
-    const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config)
+    const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config,
+    TimeSource& time_source)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random,
                                   PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(
                                       common_config, healthy_panic_threshold, 100, 50),
@@ -275,7 +278,8 @@ MaglevLoadBalancer::MaglevLoadBalancer(
               ? common_config.consistent_hashing_lb_config().use_hostname_for_hashing()
               : false),
       hash_balance_factor_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
-          common_config.consistent_hashing_lb_config(), hash_balance_factor, 0)) {
+          common_config.consistent_hashing_lb_config(), hash_balance_factor, 0)),
+      time_source_(time_source) {
   ENVOY_LOG(debug, "maglev table size: {}", table_size_);
   // The table size must be prime number.
   if (!Primes::isPrime(table_size_)) {
@@ -286,7 +290,8 @@ MaglevLoadBalancer::MaglevLoadBalancer(
 MaglevLoadBalancer::MaglevLoadBalancer(
     const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
     Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
-    const envoy::extensions::load_balancing_policies::maglev::v3::Maglev& config)
+    const envoy::extensions::load_balancing_policies::maglev::v3::Maglev& config,
+    TimeSource& time_source)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold,
                                   config.has_locality_weighted_lb_config()),
       scope_(scope.createScope("maglev_lb.")), stats_(generateStats(*scope_)),
@@ -297,7 +302,8 @@ MaglevLoadBalancer::MaglevLoadBalancer(
               ? config.consistent_hashing_lb_config().use_hostname_for_hashing()
               : false),
       hash_balance_factor_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.consistent_hashing_lb_config(),
-                                                           hash_balance_factor, 0)) {
+                                                           hash_balance_factor, 0)),
+      time_source_(time_source) {
   ENVOY_LOG(debug, "maglev table size: {}", table_size_);
   // The table size must be prime number.
   if (!Primes::isPrime(table_size_)) {
@@ -306,7 +312,7 @@ MaglevLoadBalancer::MaglevLoadBalancer(
 }
 
 MaglevLoadBalancerStats MaglevLoadBalancer::generateStats(Stats::Scope& scope) {
-  return {ALL_MAGLEV_LOAD_BALANCER_STATS(POOL_GAUGE(scope))};
+  return {ALL_MAGLEV_LOAD_BALANCER_STATS(POOL_GAUGE(scope), POOL_HISTOGRAM(scope))};
 }
 
 } // namespace Upstream
@@ -2,6 +2,7 @@
 
 #include "envoy/common/pure.h"
 #include "envoy/common/random_generator.h"
+#include "envoy/common/time.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/extensions/load_balancing_policies/maglev/v3/maglev.pb.h"
 #include "envoy/extensions/load_balancing_policies/maglev/v3/maglev.pb.validate.h"
@@ -18,15 +19,16 @@ namespace Upstream {
 /**
  * All Maglev load balancer stats. @see stats_macros.h
  */
-#define ALL_MAGLEV_LOAD_BALANCER_STATS(GAUGE)                                                      \
+#define ALL_MAGLEV_LOAD_BALANCER_STATS(GAUGE, HISTOGRAM)                                           \
   GAUGE(max_entries_per_host, Accumulate)                                                          \
-  GAUGE(min_entries_per_host, Accumulate)
+  GAUGE(min_entries_per_host, Accumulate)                                                          \
+  HISTOGRAM(table_build_time_us, Microseconds)
 
 /**
  * Struct definition for all Maglev load balancer stats. @see stats_macros.h
  */
 struct MaglevLoadBalancerStats {
-  ALL_MAGLEV_LOAD_BALANCER_STATS(GENERATE_GAUGE_STRUCT)
+  ALL_MAGLEV_LOAD_BALANCER_STATS(GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 class MaglevTable;
@@ -51,18 +53,31 @@ public:
 protected:
   struct TableBuildEntry {
     TableBuildEntry(const HostConstSharedPtr& host, uint64_t offset, uint64_t skip, double weight)
-        : host_(host), offset_(offset), skip_(skip), weight_(weight) {}
+        : host_(host), offset_(offset), skip_(skip), weight_(weight), permutation_(offset) {}
 
     HostConstSharedPtr host_;
     const uint64_t offset_;
     const uint64_t skip_;
     const double weight_;
     double target_weight_{};
-    uint64_t next_{};
+    // Next table index of the permutation of the host, (offset_ + skip_ * next) % table_size_
+    // where next is the number of indexes tried so far.
+    uint64_t permutation_;
     uint64_t count_{};
   };
 
-  uint64_t permutation(const TableBuildEntry& entry);
+  uint64_t permutation(const TableBuildEntry& entry) const { return entry.permutation_; }
+
+  /**
+   * Moves to the next table index of the permutation of a host. This is equivalent to
+   * incrementing next in the permutation formula, without the cost of a 64-bit modulo.
+   */
+  void advancePermutation(TableBuildEntry& entry) const {
+    entry.permutation_ += entry.skip_;
+    if (entry.permutation_ >= table_size_) {
+      entry.permutation_ -= table_size_;
+    }
+  }
 
   /**
    * Template method for constructing the Maglev table.
@@ -150,12 +165,14 @@ public:
   MaglevLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
                      Runtime::Loader& runtime, Random::RandomGenerator& random,
                      OptRef<const envoy::config::cluster::v3::Cluster::MaglevLbConfig> config,
-                     const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config);
+                     const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config,
+                     TimeSource& time_source);
 
   MaglevLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
                      Runtime::Loader& runtime, Random::RandomGenerator& random,
                      uint32_t healthy_panic_threshold,
-                     const envoy::extensions::load_balancing_policies::maglev::v3::Maglev& config);
+                     const envoy::extensions::load_balancing_policies::maglev::v3::Maglev& config,
+                     TimeSource& time_source);
 
   const MaglevLoadBalancerStats& stats() const { return stats_; }
   uint64_t tableSize() const { return table_size_; }
@@ -172,6 +189,7 @@ private:
   const uint64_t table_size_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  TimeSource& time_source_;
 };
 
 } // namespace Upstream
@@ -23,7 +23,7 @@ OdCdsApiImpl::OdCdsApiImpl(const envoy::config::core::v3::ConfigSource& odcds_co
                            Stats::Scope& scope,
                            ProtobufMessage::ValidationVisitor& validation_visitor)
     : Envoy::Config::SubscriptionBase<envoy::config::cluster::v3::Cluster>(validation_visitor,
-                                                                           "name"),
+                                                                           "name", true),
       helper_(cm, "odcds"), cm_(cm), notifier_(notifier),
       scope_(scope.createScope("cluster_manager.odcds.")), status_(StartStatus::NotStarted) {
   // TODO(krnowak): Move the subscription setup to CdsApiHelper. Maybe make CdsApiHelper a base
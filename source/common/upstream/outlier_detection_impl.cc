@@ -1,6 +1,8 @@
 #include "source/common/upstream/outlier_detection_impl.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -351,8 +353,8 @@ void DetectorImpl::armIntervalTimer() {
       runtime_.snapshot().getInteger(IntervalMsRuntime, config_.intervalMs())));
 }
 
-void DetectorImpl::checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor,
-                                       MonotonicTime now) {
+void DetectorImpl::checkHostForUneject(const HostSharedPtr& host,
+                                       DetectorHostMonitorImpl* monitor, MonotonicTime now) {
   if (!host->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
     // Node seems to be healthy and was not ejected since the last check.
     if (monitor->ejectTimeBackoff() != 0) {
@@ -609,31 +611,30 @@ void DetectorImpl::onConsecutiveErrorWorker(HostSharedPtr host,
 }
 
 DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
-    double success_rate_sum, const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
+    double success_rate_sum, double success_rate_square_sum, size_t valid_success_rate_hosts,
     double success_rate_stdev_factor) {
   // This function is using mean and standard deviation as statistical measures for outlier
   // detection. First the mean is calculated by dividing the sum of success rate data over the
-  // number of data points. Then variance is calculated by taking the mean of the
-  // squared difference of data points to the mean of the data. Then standard deviation is
-  // calculated by taking the square root of the variance. Then the outlier threshold is
-  // calculated as the difference between the mean and the product of the standard
-  // deviation and a constant factor.
+  // number of data points. Then variance is calculated by taking the mean of the squares of the
+  // data points minus the square of the mean, which is the mean of the squared difference of data
+  // points to the mean of the data. Then standard deviation is calculated by taking the square root
+  // of the variance. Then the outlier threshold is calculated as the difference between the mean
+  // and the product of the standard deviation and a constant factor.
   //
   // For example with a data set that looks like success_rate_data = {50, 100, 100, 100, 100} the
   // math would work as follows:
   // success_rate_sum = 450
+  // success_rate_square_sum = 42500
   // mean = 90
-  // variance = 400
+  // variance = 8500 - 8100 = 400
   // stdev = 20
   // threshold returned = 52
-  double mean = success_rate_sum / valid_success_rate_hosts.size();
-  double variance = 0;
-  std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
-                });
-  variance /= valid_success_rate_hosts.size();
-  double stdev = std::sqrt(variance);
+  const double mean = success_rate_sum / valid_success_rate_hosts;
+  // The rates are percentages, so that the rounding of the squares is far below their variance
+  // unless the variance is about 0, which the rounding must not make negative.
+  const double variance =
+      std::max(0.0, success_rate_square_sum / valid_success_rate_hosts - mean * mean);
+  const double stdev = std::sqrt(variance);
 
   return {mean, (mean - (success_rate_stdev_factor * stdev))};
 }
@@ -652,6 +653,7 @@ void DetectorImpl::processSuccessRateEjections(
   std::vector<HostSuccessRatePair> valid_success_rate_hosts;
   std::vector<HostSuccessRatePair> valid_failure_percentage_hosts;
   double success_rate_sum = 0;
+  double success_rate_square_sum = 0;
 
   // Reset the Detector's success rate mean and stdev.
   getSRNums(monitor_type) = {-1, -1};
@@ -686,11 +688,12 @@ void DetectorImpl::processSuccessRateEjections(
       }
 
       if (request_volume >= success_rate_request_volume) {
-        valid_success_rate_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_success_rate_hosts.emplace_back(host.first, host.second, success_rate);
         success_rate_sum += success_rate;
+        success_rate_square_sum += success_rate * success_rate;
       }
       if (request_volume >= failure_percentage_request_volume) {
-        valid_failure_percentage_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_failure_percentage_hosts.emplace_back(host.first, host.second, success_rate);
       }
     }
   }
@@ -701,16 +704,15 @@ void DetectorImpl::processSuccessRateEjections(
         runtime_.snapshot().getInteger(SuccessRateStdevFactorRuntime,
                                        config_.successRateStdevFactor()) /
         1000.0;
-    getSRNums(monitor_type) = successRateEjectionThreshold(
-        success_rate_sum, valid_success_rate_hosts, success_rate_stdev_factor);
+    getSRNums(monitor_type) =
+        successRateEjectionThreshold(success_rate_sum, success_rate_square_sum,
+                                     valid_success_rate_hosts.size(), success_rate_stdev_factor);
     const double success_rate_ejection_threshold = getSRNums(monitor_type).ejection_threshold_;
     for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
       if (host_success_rate_pair.success_rate_ < success_rate_ejection_threshold) {
         stats_.ejections_success_rate_.inc(); // Deprecated.
         const envoy::data::cluster::v3::OutlierEjectionType type =
-            host_monitors_[host_success_rate_pair.host_]
-                ->getSRMonitor(monitor_type)
-                .getEjectionType();
+            host_success_rate_pair.monitor_->getSRMonitor(monitor_type).getEjectionType();
         updateDetectedEjectionStats(type);
         ejectHost(host_success_rate_pair.host_, type);
       }
@@ -742,7 +744,7 @@ void DetectorImpl::processSuccessRateEjections(
 void DetectorImpl::onIntervalTimer() {
   MonotonicTime now = time_source_.monotonicTime();
 
-  for (auto host : host_monitors_) {
+  for (const auto& host : host_monitors_) {
     checkHostForUneject(host.first, host.second, now);
 
     // Need to update the writer bucket to keep the data valid.
@@ -40,13 +40,18 @@ public:
                    EventLoggerSharedPtr event_logger, Random::RandomGenerator& random);
 };
 
+class DetectorHostMonitorImpl;
+
 /**
  * Thin struct to facilitate calculations for success rate outlier detection.
  */
 struct HostSuccessRatePair {
-  HostSuccessRatePair(HostSharedPtr host, double success_rate)
-      : host_(host), success_rate_(success_rate) {}
+  HostSuccessRatePair(const HostSharedPtr& host, DetectorHostMonitorImpl* monitor,
+                      double success_rate)
+      : host_(host), monitor_(monitor), success_rate_(success_rate) {}
   HostSharedPtr host_;
+  // The monitor of the host, so that ejecting the host doesn't need to look it up.
+  DetectorHostMonitorImpl* monitor_;
   double success_rate_;
 };
 
@@ -100,9 +105,15 @@ public:
   void updateCurrentSuccessRateBucket() {
     success_rate_accumulator_bucket_.store(success_rate_accumulator_.updateCurrentWriter());
   }
-  void incTotalReqCounter() { success_rate_accumulator_bucket_.load()->total_request_counter_++; }
+  // The counters are only read once the interval they are written in is over, and don't order
+  // other memory accesses, so that they are updated with relaxed atomics.
+  void incTotalReqCounter() {
+    success_rate_accumulator_bucket_.load(std::memory_order_relaxed)
+        ->total_request_counter_.fetch_add(1, std::memory_order_relaxed);
+  }
   void incSuccessReqCounter() {
-    success_rate_accumulator_bucket_.load()->success_request_counter_++;
+    success_rate_accumulator_bucket_.load(std::memory_order_relaxed)
+        ->success_request_counter_.fetch_add(1, std::memory_order_relaxed);
   }
 
   envoy::data::cluster::v3::OutlierEjectionType getEjectionType() const { return ejection_type_; }
@@ -396,9 +407,10 @@ public:
    * This function returns pair of double values for success rate outlier detection. The pair
    * contains the average success rate of all valid hosts in the cluster and the ejection threshold.
    * If a host's success rate is under this threshold, the host is an outlier.
-   * @param success_rate_sum is the sum of the data in the success_rate_data vector.
-   * @param valid_success_rate_hosts is the vector containing the individual success rate data
-   *        points.
+   * @param success_rate_sum is the sum of the success rates of the valid hosts.
+   * @param success_rate_square_sum is the sum of the squares of the success rates of the valid
+   *        hosts, so that their variance is known without another pass over them.
+   * @param valid_success_rate_hosts is the number of valid hosts.
    * @return EjectionPair
    */
   struct EjectionPair {
@@ -406,9 +418,8 @@ public:
     double ejection_threshold_;   // ejection threshold for the cluster
   };
   static EjectionPair
-  successRateEjectionThreshold(double success_rate_sum,
-                               const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
-                               double success_rate_stdev_factor);
+  successRateEjectionThreshold(double success_rate_sum, double success_rate_square_sum,
+                               size_t valid_success_rate_hosts, double success_rate_stdev_factor);
 
   const absl::node_hash_map<HostSharedPtr, DetectorHostMonitorImpl*>& getHostMonitors() {
     return host_monitors_;
@@ -421,7 +432,8 @@ private:
 
   void addHostMonitor(HostSharedPtr host);
   void armIntervalTimer();
-  void checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor, MonotonicTime now);
+  void checkHostForUneject(const HostSharedPtr& host, DetectorHostMonitorImpl* monitor,
+                           MonotonicTime now);
   void ejectHost(HostSharedPtr host, envoy::data::cluster::v3::OutlierEjectionType type);
   static DetectionStats generateStats(Stats::Scope& scope);
   void initialize(Cluster& cluster);
@@ -12,6 +12,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/basic_resource_impl.h"
+#include "source/common/upstream/retry_token_bucket_impl.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -78,7 +79,8 @@ public:
                       uint64_t max_requests, uint64_t max_retries, uint64_t max_connection_pools,
                       uint64_t max_connections_per_host, ClusterCircuitBreakersStats cb_stats,
                       absl::optional<double> budget_percent,
-                      absl::optional<uint32_t> min_retry_concurrency)
+                      absl::optional<uint32_t> min_retry_concurrency,
+                      RetryTokenBucketImplPtr retry_token_bucket = nullptr)
       : connections_(max_connections, runtime, runtime_key + "max_connections", cb_stats.cx_open_,
                      cb_stats.remaining_cx_),
         pending_requests_(max_pending_requests, runtime, runtime_key + "max_pending_requests",
@@ -91,7 +93,8 @@ public:
         retries_(budget_percent, min_retry_concurrency, max_retries, runtime,
                  runtime_key + "retry_budget.", runtime_key + "max_retries",
                  cb_stats.rq_retry_open_, cb_stats.remaining_retries_, requests_,
-                 pending_requests_) {}
+                 pending_requests_),
+        retry_token_bucket_(std::move(retry_token_bucket)) {}
 
   // Upstream::ResourceManager
   ResourceLimit& connections() override { return connections_; }
@@ -100,6 +103,9 @@ public:
   ResourceLimit& retries() override { return retries_; }
   ResourceLimit& connectionPools() override { return connection_pools_; }
   uint64_t maxConnectionsPerHost() override { return max_connections_per_host_; }
+  OptRef<RetryTokenBucket> retryTokenBucket() override {
+    return makeOptRefFromPtr<RetryTokenBucket>(retry_token_bucket_.get());
+  }
 
 private:
   class RetryBudgetImpl : public ResourceLimit {
@@ -192,6 +198,7 @@ private:
   ManagedResourceImpl connection_pools_;
   uint64_t max_connections_per_host_;
   RetryBudgetImpl retries_;
+  const RetryTokenBucketImplPtr retry_token_bucket_;
 };
 
 using ResourceManagerImplPtr = std::unique_ptr<ResourceManagerImpl>;
@@ -0,0 +1,100 @@
+#include "source/common/upstream/retry_token_bucket_impl.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Upstream {
+
+namespace {
+
+// The tokens are counted in thousandths.
+constexpr int64_t TokenScale = 1000;
+// The attempts between two halvings of the attempt counts.
+constexpr uint64_t AttemptsPerDecay = 1000;
+
+// Halves a counter. Concurrent increments are kept, only the value loaded is halved.
+void halve(std::atomic<uint64_t>& counter) {
+  counter.fetch_sub(counter.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+}
+
+} // namespace
+
+RetryTokenBucketImpl::RetryTokenBucketImpl(
+    const envoy::config::cluster::v3::CircuitBreakers::Thresholds::RetryTokenBucket& config)
+    : request_deposit_(
+          (config.has_retry_percent() ? config.retry_percent().value() : 20.0) * TokenScale / 100),
+      min_retries_per_second_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, min_retries_per_second, 10)),
+      max_balance_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_tokens, 100) * TokenScale),
+      max_backoff_multiplier_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_backoff_multiplier, 4)),
+      balance_(max_balance_) {}
+
+void RetryTokenBucketImpl::onRequest() { deposit(request_deposit_); }
+
+void RetryTokenBucketImpl::onAttemptComplete(bool failed) {
+  attempts_.fetch_add(1, std::memory_order_relaxed);
+  if (failed) {
+    failed_attempts_.fetch_add(1, std::memory_order_relaxed);
+  }
+  if ((attempts_since_decay_.fetch_add(1, std::memory_order_relaxed) + 1) % AttemptsPerDecay ==
+      0) {
+    halve(attempts_);
+    halve(failed_attempts_);
+  }
+}
+
+bool RetryTokenBucketImpl::tryWithdraw(MonotonicTime now) {
+  depositAccruedTokens(now);
+  int64_t balance = balance_.load(std::memory_order_relaxed);
+  do {
+    if (balance < TokenScale) {
+      return false;
+    }
+  } while (!balance_.compare_exchange_weak(balance, balance - TokenScale,
+                                           std::memory_order_relaxed));
+  return true;
+}
+
+double RetryTokenBucketImpl::backoffMultiplier() const {
+  const uint64_t attempts = attempts_.load(std::memory_order_relaxed);
+  if (attempts == 0) {
+    return 1.0;
+  }
+  const double failure_rate =
+      std::min(1.0, double(failed_attempts_.load(std::memory_order_relaxed)) / attempts);
+  return 1.0 + (max_backoff_multiplier_ - 1.0) * failure_rate;
+}
+
+void RetryTokenBucketImpl::deposit(int64_t amount) {
+  int64_t balance = balance_.load(std::memory_order_relaxed);
+  while (balance < max_balance_ &&
+         !balance_.compare_exchange_weak(balance, std::min(max_balance_, balance + amount),
+                                         std::memory_order_relaxed)) {
+  }
+}
+
+void RetryTokenBucketImpl::depositAccruedTokens(MonotonicTime now) {
+  if (min_retries_per_second_ == 0) {
+    return;
+  }
+  const int64_t now_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+  int64_t last_us = last_accrual_us_.load(std::memory_order_relaxed);
+  if (last_us == 0) {
+    last_accrual_us_.compare_exchange_strong(last_us, now_us, std::memory_order_relaxed);
+    return;
+  }
+  // Deposit at most once a millisecond, so that the rounding down of the tokens accrued is at most
+  // a thousandth of a token per deposit. The worker winning the exchange makes the deposit.
+  if (now_us - last_us < 1000 ||
+      !last_accrual_us_.compare_exchange_strong(last_us, now_us, std::memory_order_relaxed)) {
+    return;
+  }
+  deposit(std::min<double>(max_balance_,
+                           double(now_us - last_us) * min_retries_per_second_ * TokenScale / 1e6));
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "envoy/config/cluster/v3/circuit_breaker.pb.h"
+#include "envoy/upstream/resource_manager.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * RetryTokenBucket counting the tokens in thousandths, so that requests can deposit a share of a
+ * token. The tokens accrued at the minimum retry rate are deposited by the withdrawals, based on
+ * the time since the previous such deposit.
+ *
+ * The backoff multiplier follows the share of the attempts which failed, counted such that every
+ * 1000 attempts the counts are halved to favour the recent ones. The counters are relaxed atomics
+ * updated by all the workers, so the balance may briefly exceed the largest number of tokens and
+ * the multiplier is approximate while they are updated concurrently.
+ */
+class RetryTokenBucketImpl : public RetryTokenBucket, NonCopyable {
+public:
+  explicit RetryTokenBucketImpl(
+      const envoy::config::cluster::v3::CircuitBreakers::Thresholds::RetryTokenBucket& config);
+
+  // Upstream::RetryTokenBucket
+  void onRequest() override;
+  void onAttemptComplete(bool failed) override;
+  bool tryWithdraw(MonotonicTime now) override;
+  double backoffMultiplier() const override;
+
+  // The number of tokens in the bucket, in thousandths.
+  int64_t balance() const { return balance_.load(std::memory_order_relaxed); }
+
+private:
+  void deposit(int64_t amount);
+  void depositAccruedTokens(MonotonicTime now);
+
+  const int64_t request_deposit_;
+  const int64_t min_retries_per_second_;
+  const int64_t max_balance_;
+  const double max_backoff_multiplier_;
+  std::atomic<int64_t> balance_;
+  // Microseconds since the epoch of the monotonic clock of the last deposit of the tokens accrued
+  // at the minimum retry rate, 0 until the first withdrawal.
+  std::atomic<int64_t> last_accrual_us_{};
+  std::atomic<uint64_t> attempts_{};
+  std::atomic<uint64_t> failed_attempts_{};
+  std::atomic<uint64_t> attempts_since_decay_{};
+};
+
+using RetryTokenBucketImplPtr = std::unique_ptr<RetryTokenBucketImpl>;
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include "envoy/common/time.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Tracks a decaying peak of the number of streams of a worker, so that predictive preconnect can
+ * provision connections for the demand seen recently rather than only for the current one. This
+ * keeps connections to the hosts the load balancer picks next warm across short lulls, so that
+ * the next burst does not wait for new connections and handshakes.
+ *
+ * The peak halves every half life, and never drops below the current number of streams.
+ */
+class StreamDemandEstimator {
+public:
+  StreamDemandEstimator(TimeSource& time_source, std::chrono::milliseconds half_life)
+      : time_source_(time_source), half_life_(half_life),
+        last_update_time_(time_source_.monotonicTime()) {}
+
+  /**
+   * Records the current number of streams.
+   * @param streams supplies the number of pending, active and anticipated streams.
+   * @return the number of streams to provision for, which is at least `streams`.
+   */
+  uint32_t update(uint32_t streams) {
+    const MonotonicTime now = time_source_.monotonicTime();
+    const std::chrono::duration<double> elapsed = now - last_update_time_;
+    last_update_time_ = now;
+    peak_ = std::max<double>(streams, peak_ * std::exp2(-elapsed / half_life_));
+    return std::max(streams, static_cast<uint32_t>(peak_));
+  }
+
+private:
+  TimeSource& time_source_;
+  const std::chrono::milliseconds half_life_;
+  MonotonicTime last_update_time_;
+  double peak_{};
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -16,12 +16,52 @@
 #include "source/common/upstream/ring_hash_lb.h"
 
 #include "absl/container/node_hash_set.h"
+#include "absl/hash/hash.h"
 
 namespace Envoy {
 namespace Upstream {
 
 using HostPredicate = std::function<bool(const Host&)>;
 
+namespace {
+
+size_t hashKeyValue(size_t hash, absl::string_view name, const HashedValue& value) {
+  return absl::HashOf(hash, name, value.hash());
+}
+
+} // namespace
+
+SubsetLoadBalancer::SubsetKey::SubsetKey(const SubsetMetadata& kvs) : hash_(0) {
+  kvs_.reserve(kvs.size());
+  for (const auto& [name, value] : kvs) {
+    kvs_.emplace_back(name, HashedValue(value));
+    hash_ = hashKeyValue(hash_, name, kvs_.back().second);
+  }
+}
+
+size_t SubsetLoadBalancer::SubsetKeyHash::operator()(
+    const MetadataMatchCriteriaVector& match_criteria) const {
+  size_t hash = 0;
+  for (const auto& match_criterion : match_criteria) {
+    hash = hashKeyValue(hash, match_criterion->name(), match_criterion->value());
+  }
+  return hash;
+}
+
+bool SubsetLoadBalancer::SubsetKeyEqual::operator()(
+    const SubsetKey& key, const MetadataMatchCriteriaVector& match_criteria) const {
+  if (key.kvs_.size() != match_criteria.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < match_criteria.size(); i++) {
+    if (key.kvs_[i].first != match_criteria[i]->name() ||
+        key.kvs_[i].second != match_criteria[i]->value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 SubsetLoadBalancer::SubsetLoadBalancer(
     LoadBalancerType lb_type, PrioritySet& priority_set, const PrioritySet* local_priority_set,
     ClusterLbStats& stats, Stats::Scope& scope, Runtime::Loader& runtime,
@@ -58,8 +98,10 @@ SubsetLoadBalancer::SubsetLoadBalancer(
       default_subset_metadata_(subsets.defaultSubset().fields().begin(),
                                subsets.defaultSubset().fields().end()),
       subset_selectors_(subsets.subsetSelectors()), original_priority_set_(priority_set),
-      original_local_priority_set_(local_priority_set), time_source_(time_source),
-      lb_type_(lb_type), locality_weight_aware_(subsets.localityWeightAware()),
+      original_local_priority_set_(local_priority_set),
+      max_subset_load_balancers_(subsets.maxSubsetLoadBalancers()), time_source_(time_source),
+      lb_type_(lb_type),
+      locality_weight_aware_(subsets.localityWeightAware()),
       scale_locality_weight_(subsets.scaleLocalityWeight()), list_as_any_(subsets.listAsAny()) {
   ASSERT(subsets.isEnabled());
 
@@ -90,13 +132,13 @@ SubsetLoadBalancer::SubsetLoadBalancer(
   original_priority_set_callback_handle_ = priority_set.addPriorityUpdateCb(
       [this](uint32_t priority, const HostVector&, const HostVector&) {
         refreshSubsets(priority);
-        purgeEmptySubsets(subsets_);
+        purgeEmptySubsets();
       });
 }
 
 SubsetLoadBalancer::~SubsetLoadBalancer() {
   // Ensure gauges reflect correct values.
-  forEachSubset(subsets_, [&](LbSubsetEntryPtr entry) {
+  forEachSubset([&](LbSubsetEntryPtr entry) {
     if (entry->active()) {
       stats_.lb_subsets_removed_.inc();
       stats_.lb_subsets_active_.dec();
@@ -119,16 +161,16 @@ void SubsetLoadBalancer::refreshSubsets(uint32_t priority) {
 void SubsetLoadBalancer::initSubsetAnyOnce() {
   if (!subset_any_) {
     subset_any_ = std::make_shared<LbSubsetEntry>();
-    subset_any_->lb_subset_ =
-        std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_, scale_locality_weight_);
+    subset_any_->lb_subset_ = std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_,
+                                                                 scale_locality_weight_, false);
   }
 }
 
 void SubsetLoadBalancer::initSubsetDefaultOnce() {
   if (!subset_default_) {
     subset_default_ = std::make_shared<LbSubsetEntry>();
-    subset_default_->lb_subset_ =
-        std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_, scale_locality_weight_);
+    subset_default_->lb_subset_ = std::make_unique<PriorityLbSubset>(
+        *this, locality_weight_aware_, scale_locality_weight_, false);
   }
 }
 
@@ -363,43 +405,15 @@ HostConstSharedPtr SubsetLoadBalancer::tryChooseHostFromContext(LoadBalancerCont
   return entry->lb_subset_->chooseHost(context);
 }
 
-// Iterates over the given metadata match criteria (which must be lexically sorted by key) and find
-// a matching LbSubsetEntryPtr, if any.
-SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::findSubset(
-    const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& match_criteria) {
-  const LbSubsetMap* subsets = &subsets_;
-
-  // Because the match_criteria and the host metadata used to populate subsets_ are sorted in the
-  // same order, we can iterate over the criteria and perform a lookup for each key and value,
-  // starting with the root LbSubsetMap and using the previous iteration's LbSubsetMap thereafter
-  // (tracked in subsets). If ever a criterion's key or value is not found, there is no subset for
-  // this criteria. If we reach the last criterion, we've found the LbSubsetEntry for the criteria,
-  // which may or may not have a subset attached to it.
-  for (uint32_t i = 0; i < match_criteria.size(); i++) {
-    const Router::MetadataMatchCriterion& match_criterion = *match_criteria[i];
-    const auto& subset_it = subsets->find(match_criterion.name());
-    if (subset_it == subsets->end()) {
-      // No subsets with this key (at this level in the hierarchy).
-      break;
-    }
-
-    const ValueSubsetMap& vs_map = subset_it->second;
-    const auto& vs_it = vs_map.find(match_criterion.value());
-    if (vs_it == vs_map.end()) {
-      // No subsets with this value.
-      break;
-    }
-
-    const LbSubsetEntryPtr& entry = vs_it->second;
-    if (i + 1 == match_criteria.size()) {
-      // We've reached the end of the criteria, and they all matched.
-      return entry;
-    }
-
-    subsets = &entry->children_;
+// Finds the LbSubsetEntryPtr matching the given metadata match criteria (which must be lexically
+// sorted by key), if any.
+SubsetLoadBalancer::LbSubsetEntryPtr
+SubsetLoadBalancer::findSubset(const MetadataMatchCriteriaVector& match_criteria) {
+  const auto it = subsets_.find(match_criteria);
+  if (it == subsets_.end()) {
+    return nullptr;
   }
-
-  return nullptr;
+  return it->second;
 }
 
 void SubsetLoadBalancer::updateFallbackSubset(uint32_t priority, const HostVector& all_hosts) {
@@ -442,7 +456,8 @@ void SubsetLoadBalancer::initLbSubsetEntryOnce(LbSubsetEntryPtr& entry, bool sin
     entry->single_host_subset_ = true;
   } else {
     entry->lb_subset_ =
-        std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_, scale_locality_weight_);
+        std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_, scale_locality_weight_,
+                                           max_subset_load_balancers_ > 0);
     entry->single_host_subset_ = false;
   }
 
@@ -465,7 +480,7 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
       std::vector<SubsetMetadata> all_kvs = extractSubsetMetadata(keys, *host);
       for (const auto& kvs : all_kvs) {
         // The host has metadata for each key, find or create its subset.
-        auto entry = findOrCreateLbSubsetEntry(subsets_, kvs, 0);
+        auto entry = findOrCreateLbSubsetEntry(kvs);
         initLbSubsetEntryOnce(entry, subset_selector->singleHostPerSubset());
 
         if (entry->single_host_subset_) {
@@ -494,7 +509,7 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
   single_duplicate_stat_->set(collision_count_of_single_host_entries);
 
   // Finalize updates after all the hosts are evaluated.
-  forEachSubset(subsets_, [priority](LbSubsetEntryPtr entry) {
+  forEachSubset([priority](LbSubsetEntryPtr entry) {
     if (entry->initialized()) {
       entry->lb_subset_->finalize(priority);
     }
@@ -597,93 +612,134 @@ std::string SubsetLoadBalancer::describeMetadata(const SubsetLoadBalancer::Subse
   return buf.str();
 }
 
-// Given a vector of key-values (from extractSubsetMetadata), recursively finds the matching
-// LbSubsetEntryPtr.
+// Given a vector of key-values (from extractSubsetMetadata), finds the matching LbSubsetEntryPtr,
+// creating an uninitialized one if there is none yet.
 SubsetLoadBalancer::LbSubsetEntryPtr
-SubsetLoadBalancer::findOrCreateLbSubsetEntry(LbSubsetMap& subsets, const SubsetMetadata& kvs,
-                                              uint32_t idx) {
-  ASSERT(idx < kvs.size());
+SubsetLoadBalancer::findOrCreateLbSubsetEntry(const SubsetMetadata& kvs) {
+  ASSERT(!kvs.empty());
 
-  const std::string& name = kvs[idx].first;
-  const ProtobufWkt::Value& pb_value = kvs[idx].second;
-  const HashedValue value(pb_value);
-
-  LbSubsetEntryPtr entry;
+  LbSubsetEntryPtr& entry = subsets_[SubsetKey(kvs)];
+  if (!entry) {
+    // Not found. Create an uninitialized entry.
+    entry = std::make_shared<LbSubsetEntry>();
+  }
+  return entry;
+}
 
-  const auto kv_it = subsets.find(name);
+// Invokes cb for each LbSubsetEntryPtr in subsets_.
+void SubsetLoadBalancer::forEachSubset(std::function<void(LbSubsetEntryPtr&)> cb) {
+  for (auto& [key, entry] : subsets_) {
+    LbSubsetEntryPtr entry_copy = entry;
+    cb(entry_copy);
+  }
+}
 
-  if (kv_it != subsets.end()) {
-    ValueSubsetMap& value_subset_map = kv_it->second;
-    const auto vs_it = value_subset_map.find(value);
-    if (vs_it != value_subset_map.end()) {
-      entry = vs_it->second;
+void SubsetLoadBalancer::purgeEmptySubsets() {
+  for (auto it = subsets_.begin(); it != subsets_.end();) {
+    const LbSubsetEntryPtr& entry = it->second;
+    if (entry->active()) {
+      it++;
+      continue;
     }
-  }
 
-  if (!entry) {
-    // Not found. Create an uninitialized entry.
-    entry = std::make_shared<LbSubsetEntry>();
-    if (kv_it != subsets.end()) {
-      ValueSubsetMap& value_subset_map = kv_it->second;
-      value_subset_map.emplace(value, entry);
-    } else {
-      ValueSubsetMap value_subset_map = {{value, entry}};
-      subsets.emplace(name, value_subset_map);
+    // If it wasn't initialized, it wasn't accounted for.
+    if (entry->initialized()) {
+      stats_.lb_subsets_active_.dec();
+      stats_.lb_subsets_removed_.inc();
     }
+
+    subsets_.erase(it++);
   }
+}
 
-  idx++;
-  if (idx == kvs.size()) {
-    // We've matched all the key-values, return the entry.
-    return entry;
+SubsetLoadBalancer::PriorityLbSubset::PriorityLbSubset(SubsetLoadBalancer& subset_lb,
+                                                       bool locality_weight_aware,
+                                                       bool scale_locality_weight, bool lazy)
+    : subset_lb_(subset_lb), locality_weight_aware_(locality_weight_aware),
+      scale_locality_weight_(scale_locality_weight), lazy_(lazy) {
+  if (!lazy_) {
+    subset_ = std::make_unique<PrioritySubsetImpl>(subset_lb_, locality_weight_aware_,
+                                                   scale_locality_weight_);
   }
+}
 
-  return findOrCreateLbSubsetEntry(entry->children_, kvs, idx);
+SubsetLoadBalancer::PriorityLbSubset::~PriorityLbSubset() {
+  if (lazy_ && subset_ != nullptr) {
+    subset_lb_.lb_subsets_lru_.erase(lru_position_);
+  }
 }
 
-// Invokes cb for each LbSubsetEntryPtr in subsets.
-void SubsetLoadBalancer::forEachSubset(LbSubsetMap& subsets,
-                                       std::function<void(LbSubsetEntryPtr&)> cb) {
-  for (auto& vsm : subsets) {
-    for (auto& em : vsm.second) {
-      LbSubsetEntryPtr entry = em.second;
-      cb(entry);
-      forEachSubset(entry->children_, cb);
+HostConstSharedPtr
+SubsetLoadBalancer::PriorityLbSubset::chooseHost(LoadBalancerContext* context) {
+  if (lazy_) {
+    std::list<PriorityLbSubset*>& lru = subset_lb_.lb_subsets_lru_;
+    if (subset_ != nullptr) {
+      lru.splice(lru.begin(), lru, lru_position_);
+    } else {
+      createSubset();
+      lru_position_ = lru.insert(lru.begin(), this);
+      if (lru.size() > subset_lb_.max_subset_load_balancers_) {
+        // This subset was just put at the front, so it is never the one evicted.
+        ASSERT(lru.back() != this);
+        lru.back()->subset_.reset();
+        lru.pop_back();
+      }
     }
   }
+  return subset_->lb_->chooseHost(context);
 }
 
-void SubsetLoadBalancer::purgeEmptySubsets(LbSubsetMap& subsets) {
-  for (auto subset_it = subsets.begin(); subset_it != subsets.end();) {
-    for (auto it = subset_it->second.begin(); it != subset_it->second.end();) {
-      LbSubsetEntryPtr entry = it->second;
+void SubsetLoadBalancer::PriorityLbSubset::finalize(uint32_t priority) {
+  while (host_sets_.size() <= priority) {
+    host_sets_.push_back({HostHashSet(), HostHashSet()});
+  }
+  auto& [old_hosts, new_hosts] = host_sets_[priority];
 
-      purgeEmptySubsets(entry->children_);
+  // The load balancer of a lazy subset is created from its current hosts when it is selected, so
+  // only the hosts need to be kept up to date while it doesn't exist.
+  if (subset_ != nullptr) {
+    HostVector added;
+    HostVector removed;
 
-      if (entry->active() || entry->hasChildren()) {
-        it++;
-        continue;
+    for (const auto& host : old_hosts) {
+      if (new_hosts.count(host) == 0) {
+        removed.emplace_back(host);
       }
+    }
 
-      // If it wasn't initialized, it wasn't accounted for.
-      if (entry->initialized()) {
-        stats_.lb_subsets_active_.dec();
-        stats_.lb_subsets_removed_.inc();
+    for (const auto& host : new_hosts) {
+      if (old_hosts.count(host) == 0) {
+        added.emplace_back(host);
       }
-
-      auto next_it = std::next(it);
-      subset_it->second.erase(it);
-      it = next_it;
     }
 
-    if (subset_it->second.empty()) {
-      auto next_subset_it = std::next(subset_it);
-      subsets.erase(subset_it);
-      subset_it = next_subset_it;
-    } else {
-      subset_it++;
+    subset_->update(priority, new_hosts, added, removed);
+  }
+
+  old_hosts.swap(new_hosts);
+  new_hosts.clear();
+}
+
+bool SubsetLoadBalancer::PriorityLbSubset::active() const {
+  if (subset_ != nullptr) {
+    return !subset_->empty();
+  }
+  for (const auto& [hosts, new_hosts] : host_sets_) {
+    if (!hosts.empty()) {
+      return true;
     }
   }
+  return false;
+}
+
+void SubsetLoadBalancer::PriorityLbSubset::createSubset() {
+  ASSERT(subset_ == nullptr);
+  subset_ = std::make_unique<PrioritySubsetImpl>(subset_lb_, locality_weight_aware_,
+                                                 scale_locality_weight_);
+  for (uint32_t priority = 0; priority < host_sets_.size(); priority++) {
+    const HostHashSet& hosts = host_sets_[priority].first;
+    subset_->update(priority, hosts, HostVector(hosts.begin(), hosts.end()), {});
+  }
 }
 
 // Initialize a new HostSubsetImpl and LoadBalancer from the SubsetLoadBalancer, filtering hosts
@@ -734,7 +790,7 @@ SubsetLoadBalancer::PrioritySubsetImpl::PrioritySubsetImpl(const SubsetLoadBalan
     // can also use a thread aware sub-LB properly. The following works fine but is not optimal.
     thread_aware_lb_ = std::make_unique<MaglevLoadBalancer>(
         *this, subset_lb.stats_, subset_lb.scope_, subset_lb.runtime_, subset_lb.random_,
-        subset_lb.lbMaglevConfig(), subset_lb.common_config_);
+        subset_lb.lbMaglevConfig(), subset_lb.common_config_, subset_lb.time_source_);
     thread_aware_lb_->initialize();
     lb_ = thread_aware_lb_->factory()->create();
     break;
@@ -3,6 +3,7 @@
 #include <bitset>
 #include <cstdint>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -19,6 +20,7 @@
 #include "source/common/upstream/load_balancer_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -136,14 +138,43 @@ private:
   using PrioritySubsetImplPtr = std::unique_ptr<PrioritySubsetImpl>;
 
   using SubsetMetadata = std::vector<std::pair<std::string, ProtobufWkt::Value>>;
+  using MetadataMatchCriteriaVector = std::vector<Router::MetadataMatchCriterionConstSharedPtr>;
+
+  // The lexically sorted key-values of a subset, hashed once so that a subset is found with a
+  // single lookup of the metadata match criteria of a request.
+  struct SubsetKey {
+    explicit SubsetKey(const SubsetMetadata& kvs);
+
+    std::vector<std::pair<std::string, HashedValue>> kvs_;
+    size_t hash_;
+  };
+
+  struct SubsetKeyHash {
+    using is_transparent = void; // NOLINT(readability-identifier-naming)
+
+    size_t operator()(const SubsetKey& key) const { return key.hash_; }
+    size_t operator()(const MetadataMatchCriteriaVector& match_criteria) const;
+  };
+
+  struct SubsetKeyEqual {
+    using is_transparent = void; // NOLINT(readability-identifier-naming)
+
+    bool operator()(const SubsetKey& lhs, const SubsetKey& rhs) const {
+      return lhs.hash_ == rhs.hash_ && lhs.kvs_ == rhs.kvs_;
+    }
+    bool operator()(const SubsetKey& key, const MetadataMatchCriteriaVector& match_criteria) const;
+    bool operator()(const MetadataMatchCriteriaVector& match_criteria, const SubsetKey& key) const {
+      return (*this)(key, match_criteria);
+    }
+  };
 
   class LbSubsetEntry;
   struct SubsetSelectorMap;
 
   using LbSubsetEntryPtr = std::shared_ptr<LbSubsetEntry>;
   using SubsetSelectorMapPtr = std::shared_ptr<SubsetSelectorMap>;
-  using ValueSubsetMap = absl::node_hash_map<HashedValue, LbSubsetEntryPtr>;
-  using LbSubsetMap = absl::node_hash_map<std::string, ValueSubsetMap>;
+  using LbSubsetMap =
+      absl::flat_hash_map<SubsetKey, LbSubsetEntryPtr, SubsetKeyHash, SubsetKeyEqual>;
   using SubsetSelectorFallbackParamsRef = std::reference_wrapper<SubsetSelectorFallbackParams>;
   using MetadataFallbacks = ProtobufWkt::RepeatedPtrField<ProtobufWkt::Value>;
 
@@ -207,7 +238,7 @@ private:
   class LbSubset {
   public:
     virtual ~LbSubset() = default;
-    virtual HostConstSharedPtr chooseHost(LoadBalancerContext* context) const PURE;
+    virtual HostConstSharedPtr chooseHost(LoadBalancerContext* context) PURE;
     virtual void pushHost(uint32_t priority, HostSharedPtr host) PURE;
     virtual void finalize(uint32_t priority) PURE;
     virtual bool active() const PURE;
@@ -216,14 +247,12 @@ private:
 
   class PriorityLbSubset : public LbSubset {
   public:
-    PriorityLbSubset(const SubsetLoadBalancer& subset_lb, bool locality_weight_aware,
-                     bool scale_locality_weight)
-        : subset_(subset_lb, locality_weight_aware, scale_locality_weight) {}
+    PriorityLbSubset(SubsetLoadBalancer& subset_lb, bool locality_weight_aware,
+                     bool scale_locality_weight, bool lazy);
+    ~PriorityLbSubset() override;
 
     // Subset
-    HostConstSharedPtr chooseHost(LoadBalancerContext* context) const override {
-      return subset_.lb_->chooseHost(context);
-    }
+    HostConstSharedPtr chooseHost(LoadBalancerContext* context) override;
     void pushHost(uint32_t priority, HostSharedPtr host) override {
       while (host_sets_.size() <= priority) {
         host_sets_.push_back({HostHashSet(), HostHashSet()});
@@ -232,42 +261,29 @@ private:
     }
     // Called after pushHost. Update subset by the hosts that pushed in the pushHost. If no any host
     // is pushed then subset_ will be set to empty.
-    void finalize(uint32_t priority) override {
-      while (host_sets_.size() <= priority) {
-        host_sets_.push_back({HostHashSet(), HostHashSet()});
-      }
-      auto& [old_hosts, new_hosts] = host_sets_[priority];
-
-      HostVector added;
-      HostVector removed;
-
-      for (const auto& host : old_hosts) {
-        if (new_hosts.count(host) == 0) {
-          removed.emplace_back(host);
-        }
-      }
+    void finalize(uint32_t priority) override;
+    bool active() const override;
 
-      for (const auto& host : new_hosts) {
-        if (old_hosts.count(host) == 0) {
-          added.emplace_back(host);
-        }
-      }
-
-      subset_.update(priority, new_hosts, added, removed);
-
-      old_hosts.swap(new_hosts);
-      new_hosts.clear();
-    }
+    std::vector<std::pair<HostHashSet, HostHashSet>> host_sets_;
+    // Created with the subset, or when a lazy subset is selected, in which case it is destroyed
+    // again when the subset is evicted from the LRU list of the SubsetLoadBalancer.
+    PrioritySubsetImplPtr subset_;
 
-    bool active() const override { return !subset_.empty(); }
+  private:
+    void createSubset();
 
-    std::vector<std::pair<HostHashSet, HostHashSet>> host_sets_;
-    PrioritySubsetImpl subset_;
+    SubsetLoadBalancer& subset_lb_;
+    const bool locality_weight_aware_;
+    const bool scale_locality_weight_;
+    const bool lazy_;
+    // The position in the LRU list of the SubsetLoadBalancer, only valid when subset_ is set for a
+    // lazy subset.
+    std::list<PriorityLbSubset*>::iterator lru_position_;
   };
 
   class SingleHostLbSubset : public LbSubset {
     // Subset
-    HostConstSharedPtr chooseHost(LoadBalancerContext*) const override { return subset_; }
+    HostConstSharedPtr chooseHost(LoadBalancerContext*) override { return subset_; }
     // This is called at most once for every update for single host subset.
     void pushHost(uint32_t priority, HostSharedPtr host) override {
       new_hosts_[priority] = std::move(host);
@@ -307,9 +323,6 @@ private:
 
     bool initialized() const { return lb_subset_ != nullptr; }
     bool active() const { return initialized() && lb_subset_->active(); }
-    bool hasChildren() const { return !children_.empty(); }
-
-    LbSubsetMap children_;
 
     // Only initialized if a match exists at this level.
     LbSubsetPtr lb_subset_;
@@ -340,13 +353,11 @@ private:
 
   bool hostMatches(const SubsetMetadata& kvs, const Host& host);
 
-  LbSubsetEntryPtr
-  findSubset(const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& matches);
+  LbSubsetEntryPtr findSubset(const MetadataMatchCriteriaVector& matches);
 
-  LbSubsetEntryPtr findOrCreateLbSubsetEntry(LbSubsetMap& subsets, const SubsetMetadata& kvs,
-                                             uint32_t idx);
-  void forEachSubset(LbSubsetMap& subsets, std::function<void(LbSubsetEntryPtr&)> cb);
-  void purgeEmptySubsets(LbSubsetMap& subsets);
+  LbSubsetEntryPtr findOrCreateLbSubsetEntry(const SubsetMetadata& kvs);
+  void forEachSubset(std::function<void(LbSubsetEntryPtr&)> cb);
+  void purgeEmptySubsets();
 
   std::vector<SubsetMetadata> extractSubsetMetadata(const std::set<std::string>& subset_keys,
                                                     const Host& host);
@@ -410,6 +421,11 @@ private:
   const PrioritySet* original_local_priority_set_;
   Common::CallbackHandlePtr original_priority_set_callback_handle_;
 
+  // The lazy subsets whose load balancers exist, the most recently selected first. Declared before
+  // the subsets, which remove themselves from it when destroyed.
+  std::list<PriorityLbSubset*> lb_subsets_lru_;
+  const uint32_t max_subset_load_balancers_;
+
   LbSubsetEntryPtr subset_any_;
   LbSubsetEntryPtr subset_default_;
 
@@ -417,7 +433,7 @@ private:
   LbSubsetEntryPtr fallback_subset_;
   LbSubsetEntryPtr panic_mode_subset_;
 
-  // Forms a trie-like structure. Requires lexically sorted Host and Route metadata.
+  // The subsets by their key-values. Requires lexically sorted Host and Route metadata.
   LbSubsetMap subsets_;
   // Forms a trie-like structure of lexically sorted keys+fallback policy from subset
   // selectors configuration
@@ -224,8 +224,13 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   //
   // If weights are specified on the hosts, they are respected.
   //
-  // This is an O(N) algorithm, unlike other load balancers. Using a lower `hash_balance_factor`
-  // results in more hosts being probed, so use a higher value if you require better performance.
+  // The load of the hosts is read from their rq_active gauges, which are shared by all of the
+  // workers, so that every worker sees the same approximate load and spills the same hot keys.
+  //
+  // This is an O(N) algorithm in the worst case, unlike other load balancers, although the cost
+  // of a pick is proportional to the number of hosts probed rather than to the number of hosts.
+  // Using a lower `hash_balance_factor` results in more hosts being probed, so use a higher value
+  // if you require better performance.
 
   if (normalized_host_weights_.empty()) {
     return nullptr;
@@ -249,10 +254,14 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   // next one in the ring. The random sequence is seeded by the hash, so the same input gets the
   // same sequence of hosts all the time.
   const uint32_t num_hosts = normalized_host_weights_.size();
-  auto host_index = std::vector<uint32_t>(num_hosts);
-  for (uint32_t i = 0; i < num_hosts; i++) {
-    host_index[i] = i;
-  }
+  // The shuffled host indexes, of which only the ones displaced by the shuffle so far are stored:
+  // the pick only pays for the hosts it probes, which is typically a handful, whatever the size of
+  // the cluster.
+  absl::flat_hash_map<uint32_t, uint32_t> displaced_host_index;
+  auto host_index = [&displaced_host_index](uint32_t i) -> uint32_t {
+    const auto it = displaced_host_index.find(i);
+    return it == displaced_host_index.end() ? i : it->second;
+  };
 
   // Not using Random::RandomGenerator as it does not take a seed. Seeded RNG is a requirement
   // here as we need the same shuffle sequence for the same hash every time.
@@ -275,9 +284,11 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   for (uint32_t i = 0; i < num_hosts; i++) {
     // The random shuffle algorithm
     const uint32_t j = uniform_int(random, num_hosts - i);
-    std::swap(host_index[i], host_index[i + j]);
-
-    const uint32_t k = host_index[i];
+    const uint32_t k = host_index(i + j);
+    if (j != 0) {
+      // Position i is never looked at again, so only position i + j needs to be updated.
+      displaced_host_index[i + j] = host_index(i);
+    }
     alt_host = normalized_host_weights_[k].first;
     if (alt_host == host) {
       continue;
@@ -416,6 +416,34 @@ LoadMetricStats::StatMapPtr LoadMetricStatsImpl::latch() {
   return latched;
 }
 
+LocalityLoadStats::LatchedStats LocalityLoadStatsImpl::latch() {
+  LatchedStats latched;
+  for (Shard& shard : shards_) {
+    latched.rq_success_ += shard.rq_success_.exchange(0, std::memory_order_relaxed);
+    latched.rq_error_ += shard.rq_error_.exchange(0, std::memory_order_relaxed);
+    latched.rq_total_ += shard.rq_total_.exchange(0, std::memory_order_relaxed);
+    latched.rq_active_ += shard.rq_active_.load(std::memory_order_relaxed);
+  }
+  return latched;
+}
+
+LocalityLoadStatsImpl::Shard& LocalityLoadStatsImpl::shard() {
+  static std::atomic<uint32_t> next_shard{0};
+  static thread_local const uint32_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % Shards;
+  return shards_[shard];
+}
+
+LocalityLoadStats& LocalityLoadStatsMap::get(const envoy::config::core::v3::Locality& locality,
+                                             uint32_t priority) {
+  absl::MutexLock lock(&mutex_);
+  std::unique_ptr<LocalityLoadStatsImpl>& stats = stats_[locality][priority];
+  if (stats == nullptr) {
+    stats = std::make_unique<LocalityLoadStatsImpl>();
+  }
+  return *stats;
+}
+
 HostDescriptionImpl::HostDescriptionImpl(
     ClusterInfoConstSharedPtr cluster, const std::string& hostname,
     Network::Address::InstanceConstSharedPtr dest_address, MetadataConstSharedPtr metadata,
@@ -430,7 +458,7 @@ HostDescriptionImpl::HostDescriptionImpl(
                   .bool_value()),
       metadata_(metadata), locality_(locality),
       locality_zone_stat_name_(locality.zone(), cluster->statsScope().symbolTable()),
-      priority_(priority),
+      locality_load_stats_(&cluster->localityLoadStats(locality, priority)), priority_(priority),
       socket_factory_(resolveTransportSocketFactory(dest_address, metadata_.get())),
       creation_time_(time_source.monotonicTime()) {
   if (health_check_config.port_value() != 0 && dest_address->type() != Network::Address::Type::Ip) {
@@ -442,6 +470,21 @@ HostDescriptionImpl::HostDescriptionImpl(
   health_check_address_ = resolveHealthCheckAddress(health_check_config, dest_address);
 }
 
+void HostDescriptionImpl::priority(uint32_t priority) {
+  if (priority_.exchange(priority) == priority) {
+    return;
+  }
+  // The requests in progress move along with the host, so that they finish in the stats of the
+  // new priority.
+  LocalityLoadStats& previous_stats = *locality_load_stats_.exchange(
+      &cluster_->localityLoadStats(locality_, priority), std::memory_order_relaxed);
+  LocalityLoadStats& stats = localityLoadStats();
+  for (uint64_t i = stats_.rq_active_.value(); i > 0; --i) {
+    previous_stats.decRqActive();
+    stats.incRqActive();
+  }
+}
+
 Network::UpstreamTransportSocketFactory& HostDescriptionImpl::resolveTransportSocketFactory(
     const Network::Address::InstanceConstSharedPtr& dest_address,
     const envoy::config::core::v3::Metadata* metadata) const {
@@ -848,8 +891,9 @@ void MainPrioritySetImpl::updateCrossPriorityHostMap(const HostVector& hosts_add
 }
 
 LazyClusterTrafficStats ClusterInfoImpl::generateStats(Stats::Scope& scope,
-                                                       const ClusterTrafficStatNames& stat_names) {
-  return std::make_unique<ClusterTrafficStats>(stat_names, scope);
+                                                       const ClusterTrafficStatNames& stat_names,
+                                                       bool deferred) {
+  return LazyClusterTrafficStats(stat_names, scope, deferred);
 }
 
 ClusterRequestResponseSizeStats ClusterInfoImpl::generateRequestResponseSizeStats(
@@ -988,8 +1032,10 @@ ClusterInfoImpl::ClusterInfoImpl(
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
-      traffic_stats_(
-          generateStats(*stats_scope_, factory_context.clusterManager().clusterStatNames())),
+      traffic_stats_(generateStats(*stats_scope_,
+                                   factory_context.clusterManager().clusterStatNames(),
+                                   Runtime::runtimeFeatureEnabled(
+                                       "envoy.reloadable_features.defer_cluster_traffic_stats"))),
       config_update_stats_(factory_context.clusterManager().clusterConfigUpdateStatNames(),
                            *stats_scope_),
       lb_stats_(factory_context.clusterManager().clusterLbStatNames(), *stats_scope_),
@@ -1754,6 +1800,7 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
 
   absl::optional<double> budget_percent;
   absl::optional<uint32_t> min_retry_concurrency;
+  RetryTokenBucketImplPtr retry_token_bucket;
   if (it != thresholds.cend()) {
     max_connections = PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_connections, max_connections);
     max_pending_requests =
@@ -1764,11 +1811,14 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
     max_connection_pools =
         PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_connection_pools, max_connection_pools);
     std::tie(budget_percent, min_retry_concurrency) = ClusterInfoImpl::getRetryBudgetParams(*it);
+    if (it->has_retry_token_bucket()) {
+      retry_token_bucket = std::make_unique<RetryTokenBucketImpl>(it->retry_token_bucket());
+    }
   }
   if (per_host_it != per_host_thresholds.cend()) {
     if (per_host_it->has_max_pending_requests() || per_host_it->has_max_requests() ||
         per_host_it->has_max_retries() || per_host_it->has_max_connection_pools() ||
-        per_host_it->has_retry_budget()) {
+        per_host_it->has_retry_budget() || per_host_it->has_retry_token_bucket()) {
       throw EnvoyException("Unsupported field in per_host_thresholds");
     }
     if (per_host_it->has_max_connections()) {
@@ -1780,7 +1830,7 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
       max_connection_pools, max_connections_per_host,
       ClusterInfoImpl::generateCircuitBreakersStats(stats_scope, priority_stat_name,
                                                     track_remaining, circuit_breakers_stat_names_),
-      budget_percent, min_retry_concurrency);
+      budget_percent, min_retry_concurrency, std::move(retry_token_bucket));
 }
 
 PriorityStateManager::PriorityStateManager(ClusterImplBase& cluster,
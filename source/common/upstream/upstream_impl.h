@@ -61,6 +61,8 @@
 #include "source/extensions/upstreams/tcp/config.h"
 #include "source/server/transport_socket_config_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/synchronization/mutex.h"
 
@@ -123,6 +125,58 @@ private:
   StatMapPtr map_ ABSL_GUARDED_BY(mu_);
 };
 
+/**
+ * Implementation of LocalityLoadStats. The stats are sharded by thread, with the shards in
+ * separate cache lines, so that the workers sending requests to the hosts of a locality don't
+ * contend on the same counters. The threads are assigned shards round robin on first use.
+ */
+class LocalityLoadStatsImpl : public LocalityLoadStats {
+public:
+  static constexpr uint32_t Shards = 16;
+
+  // Upstream::LocalityLoadStats
+  void incRqSuccess() override { shard().rq_success_.fetch_add(1, std::memory_order_relaxed); }
+  void incRqError() override { shard().rq_error_.fetch_add(1, std::memory_order_relaxed); }
+  void incRqTotal() override { shard().rq_total_.fetch_add(1, std::memory_order_relaxed); }
+  void incRqActive() override { shard().rq_active_.fetch_add(1, std::memory_order_relaxed); }
+  // A request may finish on another thread than the one it started on, in which case the active
+  // count of a shard wraps around. Their sum doesn't.
+  void decRqActive() override { shard().rq_active_.fetch_sub(1, std::memory_order_relaxed); }
+  LoadMetricStats& loadMetricStats() override { return load_metric_stats_; }
+  LatchedStats latch() override;
+
+private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> rq_success_{0};
+    std::atomic<uint64_t> rq_error_{0};
+    std::atomic<uint64_t> rq_total_{0};
+    std::atomic<uint64_t> rq_active_{0};
+  };
+
+  Shard& shard();
+
+  std::array<Shard, Shards> shards_;
+  LoadMetricStatsImpl load_metric_stats_;
+};
+
+/**
+ * The LocalityLoadStats of the hosts of a cluster by locality and priority. The stats are created
+ * on first use and kept for the lifetime of the map, so that hosts may refer to them without
+ * owning them.
+ */
+class LocalityLoadStatsMap {
+public:
+  LocalityLoadStats& get(const envoy::config::core::v3::Locality& locality, uint32_t priority);
+
+private:
+  using PriorityStats = absl::flat_hash_map<uint32_t, std::unique_ptr<LocalityLoadStatsImpl>>;
+
+  absl::Mutex mutex_;
+  absl::node_hash_map<envoy::config::core::v3::Locality, PriorityStats, LocalityHash,
+                      LocalityEqualTo>
+      stats_ ABSL_GUARDED_BY(mutex_);
+};
+
 /**
  * Null host monitor implementation.
  */
@@ -209,7 +263,12 @@ public:
     return *null_outlier_detector;
   }
   HostStats& stats() const override { return stats_; }
-  LoadMetricStats& loadMetricStats() const override { return load_metric_stats_; }
+  LoadMetricStats& loadMetricStats() const override {
+    return localityLoadStats().loadMetricStats();
+  }
+  LocalityLoadStats& localityLoadStats() const override {
+    return *locality_load_stats_.load(std::memory_order_relaxed);
+  }
   const std::string& hostnameForHealthChecks() const override { return health_checks_hostname_; }
   const std::string& hostname() const override { return hostname_; }
   Network::Address::InstanceConstSharedPtr address() const override { return address_; }
@@ -224,7 +283,7 @@ public:
     return locality_zone_stat_name_.statName();
   }
   uint32_t priority() const override { return priority_; }
-  void priority(uint32_t priority) override { priority_ = priority; }
+  void priority(uint32_t priority) override;
   Network::UpstreamTransportSocketFactory&
   resolveTransportSocketFactory(const Network::Address::InstanceConstSharedPtr& dest_address,
                                 const envoy::config::core::v3::Metadata* metadata) const;
@@ -266,7 +325,8 @@ private:
   const envoy::config::core::v3::Locality locality_;
   Stats::StatNameDynamicStorage locality_zone_stat_name_;
   mutable HostStats stats_;
-  mutable LoadMetricStatsImpl load_metric_stats_;
+  // Owned by the cluster info. Replaced when the priority of the host changes.
+  std::atomic<LocalityLoadStats*> locality_load_stats_;
   Outlier::DetectorHostMonitorPtr outlier_detector_;
   HealthCheckHostMonitorPtr health_checker_;
   std::atomic<uint32_t> priority_;
@@ -723,7 +783,8 @@ public:
                   Server::Configuration::TransportSocketFactoryContext&);
 
   static LazyClusterTrafficStats generateStats(Stats::Scope& scope,
-                                               const ClusterTrafficStatNames& cluster_stat_names);
+                                               const ClusterTrafficStatNames& cluster_stat_names,
+                                               bool deferred = false);
   static ClusterLoadReportStats
   generateLoadReportStats(Stats::Scope& scope, const ClusterLoadReportStatNames& stat_names);
   static ClusterCircuitBreakersStats
@@ -850,6 +911,10 @@ public:
   }
 
   ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  LocalityLoadStats& localityLoadStats(const envoy::config::core::v3::Locality& locality,
+                                       uint32_t priority) const override {
+    return locality_load_stats_.get(locality, priority);
+  }
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
@@ -971,6 +1036,7 @@ private:
   mutable ClusterEndpointStats endpoint_stats_;
   Stats::IsolatedStoreImpl load_report_stats_store_;
   mutable ClusterLoadReportStats load_report_stats_;
+  mutable LocalityLoadStatsMap locality_load_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
@@ -48,7 +48,8 @@ StrippedMainBase::StrippedMainBase(const Server::Options& options, Event::TimeSy
                                    std::unique_ptr<Random::RandomGenerator>&& random_generator,
                                    std::unique_ptr<ProcessContext> process_context)
     : platform_impl_(std::move(platform_impl)), options_(options),
-      component_factory_(component_factory), stats_allocator_(symbol_table_) {
+      component_factory_(component_factory), stats_region_(createStatsRegion(options)),
+      stats_allocator_(symbol_table_, stats_region_.get()) {
   // Process the option to disable extensions as early as possible,
   // before we do any configuration loading.
   OptionsImpl::disableExtensions(options.disabledExtensions());
@@ -108,6 +109,18 @@ void StrippedMainBase::configureComponentLogLevels() {
   }
 }
 
+Stats::SharedMemoryStatsRegionPtr
+StrippedMainBase::createStatsRegion(const Server::Options& options) {
+  if (options.statsSharedMemoryPath().empty() || options.mode() == Server::Mode::Validate) {
+    return nullptr;
+  }
+  // Hot restarted processes keep the stats of their parent, which still writes to the region
+  // until it terminates.
+  const bool attach_existing = !options.hotRestartDisabled() && options.restartEpoch() > 0;
+  return std::make_unique<Stats::SharedMemoryStatsRegion>(
+      options.statsSharedMemoryPath(), options.statsSharedMemoryMaxStats(), attach_existing);
+}
+
 void StrippedMainBase::configureHotRestarter(Random::RandomGenerator& random_generator) {
 #ifdef ENVOY_HOT_RESTART
   if (!options_.hotRestartDisabled()) {
@@ -142,7 +155,8 @@ void StrippedMainBase::configureHotRestarter(Random::RandomGenerator& random_gen
       restarter_.swap(restarter);
     } else {
       restarter_ = std::make_unique<Server::HotRestartImpl>(
-          base_id, options_.restartEpoch(), options_.socketPath(), options_.socketMode());
+          base_id, options_.restartEpoch(), options_.socketPath(), options_.socketMode(),
+          stats_region_.get());
     }
 
     // Write the base-id to the requested path whether we selected it
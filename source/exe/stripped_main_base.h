@@ -7,6 +7,7 @@
 #include "source/common/common/thread.h"
 #include "source/common/event/real_time_system.h"
 #include "source/common/grpc/google_grpc_context.h"
+#include "source/common/stats/shared_memory_stats.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/thread_local_store.h"
 #include "source/common/thread_local/thread_local_impl.h"
@@ -64,6 +65,7 @@ protected:
   const Envoy::Server::Options& options_;
   Server::ComponentFactory& component_factory_;
   Stats::SymbolTableImpl symbol_table_;
+  Stats::SharedMemoryStatsRegionPtr stats_region_;
   Stats::AllocatorImpl stats_allocator_;
 
   ThreadLocal::InstanceImplPtr tls_;
@@ -74,6 +76,7 @@ protected:
   std::unique_ptr<Server::InstanceImpl> server_;
 
 private:
+  static Stats::SharedMemoryStatsRegionPtr createStatsRegion(const Server::Options& options);
   void configureComponentLogLevels();
   void configureHotRestarter(Random::RandomGenerator& random_generator);
 
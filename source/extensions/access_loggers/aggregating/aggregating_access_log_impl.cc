@@ -0,0 +1,142 @@
+#include "source/extensions/access_loggers/aggregating/aggregating_access_log_impl.h"
+
+#include <array>
+#include <cmath>
+
+#include "source/common/json/json_sanitizer.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Aggregating {
+
+namespace {
+
+constexpr uint64_t DefaultWindowMs = 10000;
+constexpr uint32_t DefaultMaxKeys = 1000;
+constexpr std::array<double, 3> DefaultPercentiles{50, 90, 99};
+
+std::vector<double> percentiles(const AggregatingAccessLogConfig& config) {
+  if (config.percentiles().empty()) {
+    return {DefaultPercentiles.begin(), DefaultPercentiles.end()};
+  }
+  return {config.percentiles().begin(), config.percentiles().end()};
+}
+
+} // namespace
+
+SummaryConfig::SummaryConfig(const AggregatingAccessLogConfig& config,
+                             AccessLog::AccessLogManager& log_manager)
+    : log_file_(log_manager.createAccessLog(
+          Filesystem::FilePathAndType{Filesystem::DestinationType::File, config.path()})),
+      window_(PROTOBUF_GET_MS_OR_DEFAULT(config, window, DefaultWindowMs)),
+      percentiles_(percentiles(config)),
+      max_keys_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_keys, DefaultMaxKeys)) {}
+
+ThreadLocalAggregates::ThreadLocalAggregates(SummaryConfigSharedPtr config,
+                                             Event::Dispatcher& dispatcher)
+    : config_(std::move(config)), window_timer_(dispatcher.createTimer([this]() {
+        flush();
+        window_timer_->enableTimer(config_->window_);
+      })) {
+  window_timer_->enableTimer(config_->window_);
+}
+
+ThreadLocalAggregates::~ThreadLocalAggregates() { flush(); }
+
+bool ThreadLocalAggregates::add(const std::string& key,
+                                absl::optional<std::chrono::nanoseconds> duration) {
+  auto it = aggregates_.find(key);
+  if (it == aggregates_.end()) {
+    if (aggregates_.size() >= config_->max_keys_) {
+      return false;
+    }
+    it = aggregates_.try_emplace(key).first;
+  }
+  Aggregate& aggregate = it->second;
+  aggregate.count_++;
+  if (duration.has_value()) {
+    hist_insert_intscale(aggregate.durations_.get(),
+                         std::chrono::duration_cast<std::chrono::microseconds>(*duration).count(),
+                         0, 1);
+  }
+  return true;
+}
+
+void ThreadLocalAggregates::flush() {
+  if (aggregates_.empty()) {
+    return;
+  }
+  std::string output;
+  for (const auto& [key, aggregate] : aggregates_) {
+    appendSummary(key, aggregate, output);
+  }
+  config_->log_file_->write(output);
+  aggregates_.clear();
+}
+
+void ThreadLocalAggregates::appendSummary(const std::string& key, const Aggregate& aggregate,
+                                          std::string& output) {
+  std::string sanitize_buffer;
+  absl::StrAppend(&output, "{\"key\":\"", Json::sanitize(sanitize_buffer, key),
+                  "\",\"count\":", aggregate.count_, ",\"window_ms\":", config_->window_.count());
+  // The records of requests that aren't complete are counted, without a duration.
+  if (hist_sample_count(aggregate.durations_.get()) > 0) {
+    std::vector<double> quantiles;
+    quantiles.reserve(config_->percentiles_.size());
+    for (const double percentile : config_->percentiles_) {
+      quantiles.push_back(percentile / 100);
+    }
+    std::vector<double> values(quantiles.size());
+    hist_approx_quantile(aggregate.durations_.get(), quantiles.data(), quantiles.size(),
+                         values.data());
+    output.append(",\"duration_us\":{");
+    for (size_t i = 0; i < values.size(); i++) {
+      absl::StrAppend(&output, i == 0 ? "" : ",", "\"p", config_->percentiles_[i],
+                      "\":", static_cast<uint64_t>(std::round(values[i])));
+    }
+    output.push_back('}');
+  }
+  output.append("}\n");
+}
+
+AggregatingAccessLog::AggregatingAccessLog(
+    AccessLog::FilterPtr&& filter, AccessLog::FilterPtr&& aggregate_filter,
+    Formatter::FormatterPtr&& key_formatter,
+    std::vector<AccessLog::InstanceSharedPtr>&& access_logs,
+    const AggregatingAccessLogConfig& config, AccessLog::AccessLogManager& log_manager,
+    ThreadLocal::SlotAllocator& tls)
+    : Common::ImplBase(std::move(filter)), aggregate_filter_(std::move(aggregate_filter)),
+      key_formatter_(std::move(key_formatter)), access_logs_(std::move(access_logs)),
+      tls_slot_(tls.allocateSlot()) {
+  auto summary_config = std::make_shared<const SummaryConfig>(config, log_manager);
+  tls_slot_->set([summary_config](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalAggregates>(summary_config, dispatcher);
+  });
+}
+
+void AggregatingAccessLog::emitLog(const Http::RequestHeaderMap& request_headers,
+                                   const Http::ResponseHeaderMap& response_headers,
+                                   const Http::ResponseTrailerMap& response_trailers,
+                                   const StreamInfo::StreamInfo& stream_info) {
+  if (aggregate_filter_->evaluate(stream_info, request_headers, response_headers,
+                                  response_trailers)) {
+    std::string key;
+    key_formatter_->formatTo(request_headers, response_headers, response_trailers, stream_info,
+                             absl::string_view(), key);
+    if (tls_slot_->getTyped<ThreadLocalAggregates>().add(key, stream_info.requestComplete())) {
+      return;
+    }
+  }
+  for (const AccessLog::InstanceSharedPtr& access_log : access_logs_) {
+    access_log->log(&request_headers, &response_headers, &response_trailers, stream_info);
+  }
+}
+
+} // namespace Aggregating
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/extensions/access_loggers/aggregating/v3/aggregating.pb.h"
+#include "envoy/formatter/substitution_formatter.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/access_loggers/common/access_log_base.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+#include "circllhist.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Aggregating {
+
+using AggregatingAccessLogConfig =
+    envoy::extensions::access_loggers::aggregating::v3::AggregatingAccessLog;
+
+/**
+ * The parts of the config shared by the aggregates of the workers.
+ */
+struct SummaryConfig {
+  SummaryConfig(const AggregatingAccessLogConfig& config, AccessLog::AccessLogManager& log_manager);
+
+  const AccessLog::AccessLogFileSharedPtr log_file_;
+  const std::chrono::milliseconds window_;
+  const std::vector<double> percentiles_;
+  const uint32_t max_keys_;
+};
+
+using SummaryConfigSharedPtr = std::shared_ptr<const SummaryConfig>;
+
+/**
+ * The records aggregated by a worker over the current window. The summaries are written at the end
+ * of every window, and when the log is destroyed.
+ */
+class ThreadLocalAggregates : public ThreadLocal::ThreadLocalObject {
+public:
+  ThreadLocalAggregates(SummaryConfigSharedPtr config, Event::Dispatcher& dispatcher);
+  ~ThreadLocalAggregates() override;
+
+  /**
+   * Aggregates a record.
+   * @param key supplies the key of the record.
+   * @param duration supplies the total duration of the request, if it is complete.
+   * @return whether the record was aggregated, which it isn't once the window has max_keys keys.
+   */
+  bool add(const std::string& key, absl::optional<std::chrono::nanoseconds> duration);
+
+  /**
+   * Writes a summary line per key to the file, and starts a new window.
+   */
+  void flush();
+
+private:
+  struct Aggregate {
+    uint64_t count_{0};
+    // The durations of the requests in microseconds.
+    std::unique_ptr<histogram_t, decltype(&hist_free)> durations_{hist_alloc(), &hist_free};
+  };
+
+  void appendSummary(const std::string& key, const Aggregate& aggregate, std::string& output);
+
+  const SummaryConfigSharedPtr config_;
+  const Event::TimerPtr window_timer_;
+  absl::flat_hash_map<std::string, Aggregate> aggregates_;
+};
+
+/**
+ * Access log Instance that aggregates the records matching a filter into summaries, and passes the
+ * other records to a list of access logs.
+ */
+class AggregatingAccessLog : public Common::ImplBase {
+public:
+  AggregatingAccessLog(AccessLog::FilterPtr&& filter, AccessLog::FilterPtr&& aggregate_filter,
+                       Formatter::FormatterPtr&& key_formatter,
+                       std::vector<AccessLog::InstanceSharedPtr>&& access_logs,
+                       const AggregatingAccessLogConfig& config,
+                       AccessLog::AccessLogManager& log_manager, ThreadLocal::SlotAllocator& tls);
+
+private:
+  // Common::ImplBase
+  void emitLog(const Http::RequestHeaderMap& request_headers,
+               const Http::ResponseHeaderMap& response_headers,
+               const Http::ResponseTrailerMap& response_trailers,
+               const StreamInfo::StreamInfo& stream_info) override;
+
+  const AccessLog::FilterPtr aggregate_filter_;
+  const Formatter::FormatterPtr key_formatter_;
+  const std::vector<AccessLog::InstanceSharedPtr> access_logs_;
+  const ThreadLocal::SlotPtr tls_slot_;
+};
+
+} // namespace Aggregating
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,65 @@
+#include "source/extensions/access_loggers/aggregating/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/access_loggers/aggregating/v3/aggregating.pb.h"
+#include "envoy/extensions/access_loggers/aggregating/v3/aggregating.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/filter_config.h"
+
+#include "source/common/access_log/access_log_impl.h"
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/access_loggers/aggregating/aggregating_access_log_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Aggregating {
+
+AccessLog::InstanceSharedPtr AggregatingAccessLogFactory::createAccessLogInstance(
+    const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+    Server::Configuration::ListenerAccessLogFactoryContext& context) {
+  return createAccessLogInstance(
+      config, std::move(filter),
+      static_cast<Server::Configuration::CommonFactoryContext&>(context));
+}
+
+AccessLog::InstanceSharedPtr AggregatingAccessLogFactory::createAccessLogInstance(
+    const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+    Server::Configuration::CommonFactoryContext& context) {
+  const auto& proto_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::access_loggers::aggregating::v3::AggregatingAccessLog&>(
+      config, context.messageValidationVisitor());
+
+  AccessLog::FilterPtr aggregate_filter = AccessLog::FilterFactory::fromProto(
+      proto_config.aggregate_filter(), context.runtime(), context.api().randomGenerator(),
+      context.messageValidationVisitor());
+  std::vector<AccessLog::InstanceSharedPtr> access_logs;
+  for (const envoy::config::accesslog::v3::AccessLog& access_log : proto_config.access_log()) {
+    access_logs.push_back(AccessLog::AccessLogFactory::fromProto(access_log, context));
+  }
+
+  return std::make_shared<AggregatingAccessLog>(
+      std::move(filter), std::move(aggregate_filter),
+      std::make_unique<Formatter::FormatterImpl>(proto_config.key_format()),
+      std::move(access_logs), proto_config, context.accessLogManager(), context.threadLocal());
+}
+
+ProtobufTypes::MessagePtr AggregatingAccessLogFactory::createEmptyConfigProto() {
+  return std::make_unique<
+      envoy::extensions::access_loggers::aggregating::v3::AggregatingAccessLog>();
+}
+
+std::string AggregatingAccessLogFactory::name() const { return "envoy.access_loggers.aggregating"; }
+
+/**
+ * Static registration for the aggregating access log. @see RegisterFactory.
+ */
+REGISTER_FACTORY(AggregatingAccessLogFactory, Server::Configuration::AccessLogInstanceFactory);
+
+} // namespace Aggregating
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
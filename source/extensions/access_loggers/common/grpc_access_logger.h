@@ -10,6 +10,7 @@
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/grpc/common.h"
 #include "source/common/grpc/typed_async_client.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
@@ -17,6 +18,7 @@
 #include "source/extensions/access_loggers/common/grpc_access_logger_utils.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -79,7 +81,12 @@ template <typename LogRequest, typename LogResponse> class GrpcAccessLogClient {
 public:
   virtual ~GrpcAccessLogClient() = default;
   virtual bool isConnected() PURE;
-  virtual bool log(const LogRequest& request) PURE;
+
+  /**
+   * Sends a request, serialized by serialize_request only once it is known to be sent.
+   * @return false if the request couldn't be sent and should be sent again later.
+   */
+  virtual bool log(absl::FunctionRef<Buffer::InstancePtr()> serialize_request) PURE;
 
 protected:
   GrpcAccessLogClient(const Grpc::RawAsyncClientSharedPtr& client,
@@ -119,10 +126,11 @@ public:
 
   bool isConnected() override { return false; }
 
-  bool log(const LogRequest& request) override {
-    GrpcAccessLogClient<LogRequest, LogResponse>::client_->send(
-        GrpcAccessLogClient<LogRequest, LogResponse>::service_method_, request, request_cb_,
-        Tracing::NullSpan::instance(), GrpcAccessLogClient<LogRequest, LogResponse>::opts_);
+  bool log(absl::FunctionRef<Buffer::InstancePtr()> serialize_request) override {
+    GrpcAccessLogClient<LogRequest, LogResponse>::client_->sendRaw(
+        GrpcAccessLogClient<LogRequest, LogResponse>::service_method_, serialize_request(),
+        request_cb_, Tracing::NullSpan::instance(),
+        GrpcAccessLogClient<LogRequest, LogResponse>::opts_);
     return true;
   }
 
@@ -169,7 +177,7 @@ public:
 
   bool isConnected() override { return stream_ != nullptr && stream_->stream_ != nullptr; }
 
-  bool log(const LogRequest& request) override {
+  bool log(absl::FunctionRef<Buffer::InstancePtr()> serialize_request) override {
     if (!stream_) {
       stream_ = std::make_unique<LocalStream>(*this);
     }
@@ -184,7 +192,7 @@ public:
       if (stream_->stream_->isAboveWriteBufferHighWatermark()) {
         return false;
       }
-      stream_->stream_->sendMessage(request, false);
+      stream_->stream_->sendMessageRaw(serialize_request(), false);
     } else {
       // Clear out the stream data due to stream creation failure.
       stream_.reset();
@@ -273,6 +281,12 @@ private:
   virtual void addEntry(HttpLogProto&& entry) PURE;
   virtual void addEntry(TcpLogProto&& entry) PURE;
   virtual void clearMessage() { message_.Clear(); }
+  // Loggers encoding their entries as they are added override this, along with isEmpty() and
+  // clearMessage(). The sizes of the entries are cached when addEntry() is called, so the entries
+  // can be serialized with their cached sizes.
+  virtual Buffer::InstancePtr serializeMessage() {
+    return Grpc::Common::serializeMessage(message_);
+  }
 
   void flush() {
     if (isEmpty()) {
@@ -284,7 +298,7 @@ private:
       initMessage();
     }
 
-    if (client_->log(message_)) {
+    if (client_->log([this]() { return serializeMessage(); })) {
       // Clear the message regardless of the success.
       approximate_message_size_bytes_ = 0;
       clearMessage();
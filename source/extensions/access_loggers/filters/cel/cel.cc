@@ -9,9 +9,9 @@ namespace CEL {
 namespace Expr = Envoy::Extensions::Filters::Common::Expr;
 
 CELAccessLogExtensionFilter::CELAccessLogExtensionFilter(
-    Expr::Builder& builder, const google::api::expr::v1alpha1::Expr& input_expr)
+    const google::api::expr::v1alpha1::Expr& input_expr)
     : parsed_expr_(input_expr) {
-  compiled_expr_ = Expr::createExpression(builder, parsed_expr_);
+  compiled_expr_ = Expr::getOrCreateExpression(parsed_expr_);
 }
 
 bool CELAccessLogExtensionFilter::evaluate(
@@ -17,8 +17,7 @@ namespace CEL {
 
 class CELAccessLogExtensionFilter : public AccessLog::Filter {
 public:
-  CELAccessLogExtensionFilter(Extensions::Filters::Common::Expr::Builder&,
-                              const google::api::expr::v1alpha1::Expr&);
+  CELAccessLogExtensionFilter(const google::api::expr::v1alpha1::Expr&);
 
   bool evaluate(const StreamInfo::StreamInfo& info, const Http::RequestHeaderMap& request_headers,
                 const Http::ResponseHeaderMap& response_headers,
@@ -26,7 +25,7 @@ public:
 
 private:
   const google::api::expr::v1alpha1::Expr parsed_expr_;
-  Extensions::Filters::Common::Expr::ExpressionPtr compiled_expr_;
+  Extensions::Filters::Common::Expr::ExpressionSharedPtr compiled_expr_;
 };
 
 } // namespace CEL
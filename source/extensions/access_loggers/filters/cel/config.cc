@@ -34,8 +34,7 @@ Envoy::AccessLog::FilterPtr CELAccessLogExtensionFilterFactory::createFilter(
                          parse_status.status().ToString());
   }
 
-  return std::make_unique<CELAccessLogExtensionFilter>(getOrCreateBuilder(),
-                                                       parse_status.value().expr());
+  return std::make_unique<CELAccessLogExtensionFilter>(parse_status.value().expr());
 #else
   throw EnvoyException("CEL is not available for use in this environment.");
 #endif
@@ -45,14 +44,6 @@ ProtobufTypes::MessagePtr CELAccessLogExtensionFilterFactory::createEmptyConfigP
   return std::make_unique<envoy::extensions::access_loggers::filters::cel::v3::ExpressionFilter>();
 }
 
-Extensions::Filters::Common::Expr::Builder&
-CELAccessLogExtensionFilterFactory::getOrCreateBuilder() {
-  if (expr_builder_ == nullptr) {
-    expr_builder_ = Extensions::Filters::Common::Expr::createBuilder(nullptr);
-  }
-  return *expr_builder_;
-}
-
 /**
  * Static registration for the CELAccessLogExtensionFilter. @see RegisterFactory.
  */
@@ -23,10 +23,6 @@ public:
                Random::RandomGenerator&) override;
   ProtobufTypes::MessagePtr createEmptyConfigProto() override;
   std::string name() const override { return "envoy.access_loggers.extension_filters.cel"; }
-
-private:
-  Extensions::Filters::Common::Expr::Builder& getOrCreateBuilder();
-  Extensions::Filters::Common::Expr::BuilderPtr expr_builder_;
 };
 
 } // namespace CEL
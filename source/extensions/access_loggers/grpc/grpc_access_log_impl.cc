@@ -6,7 +6,9 @@
 #include "envoy/local_info/local_info.h"
 
 #include "source/common/config/utility.h"
+#include "source/common/grpc/common.h"
 #include "source/common/grpc/typed_async_client.h"
+#include "source/common/protobuf/protobuf.h"
 
 const char GRPC_LOG_STATS_PREFIX[] = "access_logs.grpc_access_log.";
 
@@ -15,6 +17,37 @@ namespace Extensions {
 namespace AccessLoggers {
 namespace GrpcCommon {
 
+namespace {
+
+// The field numbers of StreamAccessLogsMessage.http_logs and tcp_logs, and of the log_entry field
+// of their messages.
+constexpr uint32_t HttpLogsFieldNumber = 2;
+constexpr uint32_t TcpLogsFieldNumber = 3;
+constexpr uint32_t LogEntryFieldNumber = 1;
+// Embedded messages are length delimited fields (wire type 2).
+constexpr uint32_t ProtobufLengthDelimitedField = 2;
+constexpr uint32_t MaxVarint32Bytes = 5;
+
+// Appends the tag and length of an embedded message field.
+void appendFieldHeader(Buffer::Instance& buffer, uint32_t field_number, uint32_t length) {
+  uint8_t header[2 * MaxVarint32Bytes];
+  uint8_t* end = Protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+      (field_number << 3) | ProtobufLengthDelimitedField, header);
+  end = Protobuf::io::CodedOutputStream::WriteVarint32ToArray(length, end);
+  buffer.add(header, end - header);
+}
+
+// Appends the entry as a log_entry field. The sizes of the entry must be cached.
+void appendEntry(Buffer::Instance& buffer, const Protobuf::MessageLite& entry) {
+  const uint32_t size = entry.GetCachedSize();
+  appendFieldHeader(buffer, LogEntryFieldNumber, size);
+  Buffer::ReservationSingleSlice reservation = buffer.reserveSingleSlice(size);
+  entry.SerializeWithCachedSizesToArray(static_cast<uint8_t*>(reservation.slice().mem_));
+  reservation.commit(size);
+}
+
+} // namespace
+
 GrpcAccessLoggerImpl::GrpcAccessLoggerImpl(
     const Grpc::RawAsyncClientSharedPtr& client,
     const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config,
@@ -25,15 +58,35 @@ GrpcAccessLoggerImpl::GrpcAccessLoggerImpl(
       log_name_(config.log_name()), local_info_(local_info) {}
 
 void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::HTTPAccessLogEntry&& entry) {
-  message_.mutable_http_logs()->mutable_log_entry()->Add(std::move(entry));
+  // Like setting the http_logs of the oneof, which clears the tcp_logs.
+  tcp_entries_.drain(tcp_entries_.length());
+  appendEntry(http_entries_, entry);
 }
 
 void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::TCPAccessLogEntry&& entry) {
-  message_.mutable_tcp_logs()->mutable_log_entry()->Add(std::move(entry));
+  http_entries_.drain(http_entries_.length());
+  appendEntry(tcp_entries_, entry);
 }
 
 bool GrpcAccessLoggerImpl::isEmpty() {
-  return !message_.has_http_logs() && !message_.has_tcp_logs();
+  return http_entries_.length() == 0 && tcp_entries_.length() == 0;
+}
+
+void GrpcAccessLoggerImpl::clearMessage() {
+  message_.Clear();
+  http_entries_.drain(http_entries_.length());
+  tcp_entries_.drain(tcp_entries_.length());
+}
+
+Buffer::InstancePtr GrpcAccessLoggerImpl::serializeMessage() {
+  // The identifier comes first, as in the serialization of the whole message.
+  Buffer::InstancePtr request = Grpc::Common::serializeMessage(message_);
+  Buffer::OwnedImpl& entries = http_entries_.length() > 0 ? http_entries_ : tcp_entries_;
+  appendFieldHeader(*request,
+                    http_entries_.length() > 0 ? HttpLogsFieldNumber : TcpLogsFieldNumber,
+                    entries.length());
+  request->move(entries);
+  return request;
 }
 
 void GrpcAccessLoggerImpl::initMessage() {
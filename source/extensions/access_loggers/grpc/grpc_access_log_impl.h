@@ -10,6 +10,7 @@
 #include "envoy/service/accesslog/v3/als.pb.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger.h"
 
 namespace Envoy {
@@ -34,9 +35,15 @@ private:
   void addEntry(envoy::data::accesslog::v3::TCPAccessLogEntry&& entry) override;
   bool isEmpty() override;
   void initMessage() override;
+  void clearMessage() override;
+  Buffer::InstancePtr serializeMessage() override;
 
   const std::string log_name_;
   const LocalInfo::LocalInfo& local_info_;
+  // The wire format of the log_entry fields of the HTTP or TCP entries of the batch, encoded as the
+  // entries are added. message_ only holds the identifier.
+  Buffer::OwnedImpl http_entries_;
+  Buffer::OwnedImpl tcp_entries_;
 };
 
 class GrpcAccessLoggerCacheImpl
@@ -1,9 +1,12 @@
 #include "source/extensions/access_loggers/grpc/grpc_access_log_utils.h"
 
+#include "envoy/config/core/v3/base.pb.h"
 #include "envoy/data/accesslog/v3/accesslog.pb.h"
 #include "envoy/extensions/access_loggers/grpc/v3/als.pb.h"
 #include "envoy/upstream/upstream.h"
 
+#include "source/common/http/header_utility.h"
+#include "source/common/http/headers.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/utility.h"
 #include "source/common/tracing/custom_tag_impl.h"
@@ -15,6 +18,9 @@ namespace GrpcCommon {
 
 namespace {
 
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    referer_handle(Http::CustomHeaders::get().Referer);
+
 using namespace envoy::data::accesslog::v3;
 
 // Helper function to convert from a BoringSSL textual representation of the
@@ -327,6 +333,144 @@ void Utility::extractCommonAccessLogProperties(
   }
 }
 
+void Utility::extractTcpAccessLogEntry(
+    envoy::data::accesslog::v3::TCPAccessLogEntry& log_entry,
+    const Http::RequestHeaderMap& request_header, const StreamInfo::StreamInfo& stream_info,
+    const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config) {
+  // Common log properties.
+  extractCommonAccessLogProperties(*log_entry.mutable_common_properties(), request_header,
+                                   stream_info, config);
+
+  envoy::data::accesslog::v3::ConnectionProperties& connection_properties =
+      *log_entry.mutable_connection_properties();
+  connection_properties.set_received_bytes(stream_info.bytesReceived());
+  connection_properties.set_sent_bytes(stream_info.bytesSent());
+}
+
+HttpAccessLogEntryBuilder::HttpAccessLogEntryBuilder(
+    const Protobuf::RepeatedPtrField<std::string>& additional_request_headers_to_log,
+    const Protobuf::RepeatedPtrField<std::string>& additional_response_headers_to_log,
+    const Protobuf::RepeatedPtrField<std::string>& additional_response_trailers_to_log) {
+  for (const auto& header : additional_request_headers_to_log) {
+    request_headers_to_log_.emplace_back(header);
+  }
+
+  for (const auto& header : additional_response_headers_to_log) {
+    response_headers_to_log_.emplace_back(header);
+  }
+
+  for (const auto& header : additional_response_trailers_to_log) {
+    response_trailers_to_log_.emplace_back(header);
+  }
+}
+
+void HttpAccessLogEntryBuilder::build(
+    envoy::data::accesslog::v3::HTTPAccessLogEntry& log_entry,
+    const Http::RequestHeaderMap& request_headers, const Http::ResponseHeaderMap& response_headers,
+    const Http::ResponseTrailerMap& response_trailers, const StreamInfo::StreamInfo& stream_info,
+    const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config) const {
+  // Common log properties.
+  Utility::extractCommonAccessLogProperties(*log_entry.mutable_common_properties(),
+                                            request_headers, stream_info, config);
+
+  if (stream_info.protocol()) {
+    switch (stream_info.protocol().value()) {
+    case Http::Protocol::Http10:
+      log_entry.set_protocol_version(envoy::data::accesslog::v3::HTTPAccessLogEntry::HTTP10);
+      break;
+    case Http::Protocol::Http11:
+      log_entry.set_protocol_version(envoy::data::accesslog::v3::HTTPAccessLogEntry::HTTP11);
+      break;
+    case Http::Protocol::Http2:
+      log_entry.set_protocol_version(envoy::data::accesslog::v3::HTTPAccessLogEntry::HTTP2);
+      break;
+    case Http::Protocol::Http3:
+      log_entry.set_protocol_version(envoy::data::accesslog::v3::HTTPAccessLogEntry::HTTP3);
+      break;
+    }
+  }
+
+  // HTTP request properties.
+  // TODO(mattklein123): Populate port field.
+  auto* request_properties = log_entry.mutable_request();
+  if (request_headers.Scheme() != nullptr) {
+    request_properties->set_scheme(std::string(request_headers.getSchemeValue()));
+  }
+  if (request_headers.Host() != nullptr) {
+    request_properties->set_authority(std::string(request_headers.getHostValue()));
+  }
+  if (request_headers.Path() != nullptr) {
+    request_properties->set_path(std::string(request_headers.getPathValue()));
+  }
+  if (request_headers.UserAgent() != nullptr) {
+    request_properties->set_user_agent(std::string(request_headers.getUserAgentValue()));
+  }
+  if (request_headers.getInline(referer_handle.handle()) != nullptr) {
+    request_properties->set_referer(
+        std::string(request_headers.getInlineValue(referer_handle.handle())));
+  }
+  if (request_headers.ForwardedFor() != nullptr) {
+    request_properties->set_forwarded_for(std::string(request_headers.getForwardedForValue()));
+  }
+  if (request_headers.RequestId() != nullptr) {
+    request_properties->set_request_id(std::string(request_headers.getRequestIdValue()));
+  }
+  if (request_headers.EnvoyOriginalPath() != nullptr) {
+    request_properties->set_original_path(std::string(request_headers.getEnvoyOriginalPathValue()));
+  }
+  request_properties->set_request_headers_bytes(request_headers.byteSize());
+  request_properties->set_request_body_bytes(stream_info.bytesReceived());
+  if (request_headers.Method() != nullptr) {
+    envoy::config::core::v3::RequestMethod method = envoy::config::core::v3::METHOD_UNSPECIFIED;
+    envoy::config::core::v3::RequestMethod_Parse(std::string(request_headers.getMethodValue()),
+                                                 &method);
+    request_properties->set_request_method(method);
+  }
+  if (!request_headers_to_log_.empty()) {
+    auto* logged_headers = request_properties->mutable_request_headers();
+
+    for (const auto& header : request_headers_to_log_) {
+      const auto all_values = Http::HeaderUtility::getAllOfHeaderAsString(request_headers, header);
+      if (all_values.result().has_value()) {
+        logged_headers->insert({header.get(), std::string(all_values.result().value())});
+      }
+    }
+  }
+
+  // HTTP response properties.
+  auto* response_properties = log_entry.mutable_response();
+  if (stream_info.responseCode()) {
+    response_properties->mutable_response_code()->set_value(stream_info.responseCode().value());
+  }
+  if (stream_info.responseCodeDetails()) {
+    response_properties->set_response_code_details(stream_info.responseCodeDetails().value());
+  }
+  response_properties->set_response_headers_bytes(response_headers.byteSize());
+  response_properties->set_response_body_bytes(stream_info.bytesSent());
+  if (!response_headers_to_log_.empty()) {
+    auto* logged_headers = response_properties->mutable_response_headers();
+
+    for (const auto& header : response_headers_to_log_) {
+      const auto all_values = Http::HeaderUtility::getAllOfHeaderAsString(response_headers, header);
+      if (all_values.result().has_value()) {
+        logged_headers->insert({header.get(), std::string(all_values.result().value())});
+      }
+    }
+  }
+
+  if (!response_trailers_to_log_.empty()) {
+    auto* logged_headers = response_properties->mutable_response_trailers();
+
+    for (const auto& header : response_trailers_to_log_) {
+      const auto all_values =
+          Http::HeaderUtility::getAllOfHeaderAsString(response_trailers, header);
+      if (all_values.result().has_value()) {
+        logged_headers->insert({header.get(), std::string(all_values.result().value())});
+      }
+    }
+  }
+}
+
 } // namespace GrpcCommon
 } // namespace AccessLoggers
 } // namespace Extensions
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "envoy/data/accesslog/v3/accesslog.pb.h"
 #include "envoy/extensions/access_loggers/grpc/v3/als.pb.h"
+#include "envoy/http/header_map.h"
 #include "envoy/stream_info/stream_info.h"
 
+#include "source/common/protobuf/protobuf.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace AccessLoggers {
@@ -20,6 +26,35 @@ public:
   static void responseFlagsToAccessLogResponseFlags(
       envoy::data::accesslog::v3::AccessLogCommon& common_access_log,
       const StreamInfo::StreamInfo& stream_info);
+
+  static void extractTcpAccessLogEntry(
+      envoy::data::accesslog::v3::TCPAccessLogEntry& log_entry,
+      const Http::RequestHeaderMap& request_header, const StreamInfo::StreamInfo& stream_info,
+      const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config);
+};
+
+/**
+ * Builds the HTTP access log entries of a logger, logging the given additional headers.
+ */
+class HttpAccessLogEntryBuilder {
+public:
+  HttpAccessLogEntryBuilder(
+      const Protobuf::RepeatedPtrField<std::string>& additional_request_headers_to_log,
+      const Protobuf::RepeatedPtrField<std::string>& additional_response_headers_to_log,
+      const Protobuf::RepeatedPtrField<std::string>& additional_response_trailers_to_log);
+
+  void build(envoy::data::accesslog::v3::HTTPAccessLogEntry& log_entry,
+             const Http::RequestHeaderMap& request_headers,
+             const Http::ResponseHeaderMap& response_headers,
+             const Http::ResponseTrailerMap& response_trailers,
+             const StreamInfo::StreamInfo& stream_info,
+             const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config)
+      const;
+
+private:
+  std::vector<Http::LowerCaseString> request_headers_to_log_;
+  std::vector<Http::LowerCaseString> response_headers_to_log_;
+  std::vector<Http::LowerCaseString> response_trailers_to_log_;
 };
 
 } // namespace GrpcCommon
@@ -35,18 +35,9 @@ TcpGrpcAccessLog::TcpGrpcAccessLog(AccessLog::FilterPtr&& filter,
 void TcpGrpcAccessLog::emitLog(const Http::RequestHeaderMap& request_header,
                                const Http::ResponseHeaderMap&, const Http::ResponseTrailerMap&,
                                const StreamInfo::StreamInfo& stream_info) {
-  // Common log properties.
   envoy::data::accesslog::v3::TCPAccessLogEntry log_entry;
-  GrpcCommon::Utility::extractCommonAccessLogProperties(*log_entry.mutable_common_properties(),
-                                                        request_header, stream_info,
-                                                        config_->common_config());
-
-  envoy::data::accesslog::v3::ConnectionProperties& connection_properties =
-      *log_entry.mutable_connection_properties();
-  connection_properties.set_received_bytes(stream_info.bytesReceived());
-  connection_properties.set_sent_bytes(stream_info.bytesSent());
-
-  // request_properties->set_request_body_bytes(stream_info.bytesReceived());
+  GrpcCommon::Utility::extractTcpAccessLogEntry(log_entry, request_header, stream_info,
+                                                config_->common_config());
   tls_slot_->getTyped<ThreadLocalLogger>().logger_->log(std::move(log_entry));
 }
 
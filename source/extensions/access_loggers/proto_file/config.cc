@@ -0,0 +1,53 @@
+#include "source/extensions/access_loggers/proto_file/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/access_loggers/proto_file/v3/proto_file.pb.h"
+#include "envoy/extensions/access_loggers/proto_file/v3/proto_file.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/filter_config.h"
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/access_loggers/proto_file/proto_file_access_log_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ProtoFile {
+
+AccessLog::InstanceSharedPtr ProtoFileAccessLogFactory::createAccessLogInstance(
+    const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+    Server::Configuration::ListenerAccessLogFactoryContext& context) {
+  return createAccessLogInstance(
+      config, std::move(filter),
+      static_cast<Server::Configuration::CommonFactoryContext&>(context));
+}
+
+AccessLog::InstanceSharedPtr ProtoFileAccessLogFactory::createAccessLogInstance(
+    const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+    Server::Configuration::CommonFactoryContext& context) {
+  const auto& proto_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::access_loggers::proto_file::v3::ProtoFileAccessLog&>(
+      config, context.messageValidationVisitor());
+
+  return std::make_shared<ProtoFileAccessLog>(std::move(filter), proto_config,
+                                              context.accessLogManager(), context.threadLocal(),
+                                              context.localInfo());
+}
+
+ProtobufTypes::MessagePtr ProtoFileAccessLogFactory::createEmptyConfigProto() {
+  return std::make_unique<envoy::extensions::access_loggers::proto_file::v3::ProtoFileAccessLog>();
+}
+
+std::string ProtoFileAccessLogFactory::name() const { return "envoy.access_loggers.proto_file"; }
+
+/**
+ * Static registration for the protobuf file access log. @see RegisterFactory.
+ */
+REGISTER_FACTORY(ProtoFileAccessLogFactory, Server::Configuration::AccessLogInstanceFactory);
+
+} // namespace ProtoFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
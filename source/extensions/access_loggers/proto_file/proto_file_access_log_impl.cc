@@ -0,0 +1,154 @@
+#include "source/extensions/access_loggers/proto_file/proto_file_access_log_impl.h"
+
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/data/accesslog/v3/accesslog.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ProtoFile {
+
+namespace {
+
+constexpr uint64_t DefaultBufferFlushIntervalMs = 1000;
+constexpr uint32_t DefaultBufferSizeBytes = 16384;
+// Makes zlib write a gzip header and trailer around the deflate stream.
+constexpr int64_t GzipWindowBits = 15 + 16;
+constexpr uint64_t GzipMemoryLevel = 8;
+
+} // namespace
+
+BatchWriter::BatchWriter(const ProtoFileAccessLogConfig& config,
+                         AccessLog::AccessLogManager& log_manager,
+                         const LocalInfo::LocalInfo& local_info)
+    : log_file_(log_manager.createAccessLog(
+          Filesystem::FilePathAndType{Filesystem::DestinationType::File, config.path()})),
+      compress_(config.compression() == ProtoFileAccessLogConfig::GZIP) {
+  if (!config.log_name().empty()) {
+    identifier_.emplace();
+    *identifier_->mutable_node() = local_info.node();
+    identifier_->set_log_name(config.log_name());
+  }
+}
+
+void BatchWriter::write(envoy::service::accesslog::v3::StreamAccessLogsMessage& message) const {
+  if (identifier_.has_value()) {
+    *message.mutable_identifier() = *identifier_;
+  }
+
+  const uint32_t message_size = message.ByteSizeLong();
+  std::string record(
+      Protobuf::io::CodedOutputStream::VarintSize32(message_size) + message_size, '\0');
+  uint8_t* data = reinterpret_cast<uint8_t*>(record.data());
+  data = Protobuf::io::CodedOutputStream::WriteVarint32ToArray(message_size, data);
+  message.SerializeWithCachedSizesToArray(data);
+
+  if (compress_) {
+    record = compress(record);
+  }
+  // The record is written with a single write, so that the records of the threads don't
+  // interleave.
+  log_file_->write(record);
+}
+
+std::string BatchWriter::compress(const std::string& record) const {
+  Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+  compressor.init(Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+                  Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+                  GzipWindowBits, GzipMemoryLevel);
+  Buffer::OwnedImpl buffer(record);
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  return buffer.toString();
+}
+
+ProtoFileAccessLog::ThreadLocalBatch::ThreadLocalBatch(BatchWriterSharedPtr writer,
+                                                       Event::Dispatcher& dispatcher,
+                                                       std::chrono::milliseconds flush_interval,
+                                                       uint64_t max_size_bytes)
+    : writer_(std::move(writer)), flush_interval_(flush_interval),
+      max_size_bytes_(max_size_bytes), flush_timer_(dispatcher.createTimer([this]() {
+        flush();
+        flush_timer_->enableTimer(flush_interval_);
+      })) {
+  flush_timer_->enableTimer(flush_interval_);
+}
+
+ProtoFileAccessLog::ThreadLocalBatch::~ThreadLocalBatch() { flush(); }
+
+void ProtoFileAccessLog::ThreadLocalBatch::entryAdded(uint64_t size_bytes) {
+  approximate_size_bytes_ += size_bytes;
+  if (approximate_size_bytes_ >= max_size_bytes_) {
+    flush();
+  }
+}
+
+void ProtoFileAccessLog::ThreadLocalBatch::flush() {
+  if (!message_.has_http_logs() && !message_.has_tcp_logs()) {
+    // Nothing to flush.
+    return;
+  }
+  writer_->write(message_);
+  message_.Clear();
+  approximate_size_bytes_ = 0;
+}
+
+ProtoFileAccessLog::ProtoFileAccessLog(AccessLog::FilterPtr&& filter,
+                                       const ProtoFileAccessLogConfig& config,
+                                       AccessLog::AccessLogManager& log_manager,
+                                       ThreadLocal::SlotAllocator& tls,
+                                       const LocalInfo::LocalInfo& local_info)
+    : Common::ImplBase(std::move(filter)), entry_type_(config.entry_type()),
+      entry_builder_(config.additional_request_headers_to_log(),
+                     config.additional_response_headers_to_log(),
+                     config.additional_response_trailers_to_log()),
+      tls_slot_(tls.allocateSlot()) {
+  *common_config_.mutable_filter_state_objects_to_log() = config.filter_state_objects_to_log();
+  *common_config_.mutable_custom_tags() = config.custom_tags();
+
+  auto writer = std::make_shared<const BatchWriter>(config, log_manager, local_info);
+  const std::chrono::milliseconds flush_interval(
+      PROTOBUF_GET_MS_OR_DEFAULT(config, buffer_flush_interval, DefaultBufferFlushIntervalMs));
+  const uint64_t max_size_bytes =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, buffer_size_bytes, DefaultBufferSizeBytes);
+  tls_slot_->set([writer, flush_interval, max_size_bytes](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalBatch>(writer, dispatcher, flush_interval, max_size_bytes);
+  });
+}
+
+void ProtoFileAccessLog::emitLog(const Http::RequestHeaderMap& request_headers,
+                                 const Http::ResponseHeaderMap& response_headers,
+                                 const Http::ResponseTrailerMap& response_trailers,
+                                 const StreamInfo::StreamInfo& stream_info) {
+  ThreadLocalBatch& batch = tls_slot_->getTyped<ThreadLocalBatch>();
+  // The entries are built in place in the batch, so that they are never copied.
+  switch (entry_type_) {
+    PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
+  case ProtoFileAccessLogConfig::HTTP: {
+    envoy::data::accesslog::v3::HTTPAccessLogEntry& log_entry =
+        *batch.message().mutable_http_logs()->add_log_entry();
+    entry_builder_.build(log_entry, request_headers, response_headers, response_trailers,
+                         stream_info, common_config_);
+    batch.entryAdded(log_entry.ByteSizeLong());
+    break;
+  }
+  case ProtoFileAccessLogConfig::TCP: {
+    envoy::data::accesslog::v3::TCPAccessLogEntry& log_entry =
+        *batch.message().mutable_tcp_logs()->add_log_entry();
+    GrpcCommon::Utility::extractTcpAccessLogEntry(log_entry, request_headers, stream_info,
+                                                  common_config_);
+    batch.entryAdded(log_entry.ByteSizeLong());
+    break;
+  }
+  }
+}
+
+} // namespace ProtoFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/extensions/access_loggers/grpc/v3/als.pb.h"
+#include "envoy/extensions/access_loggers/proto_file/v3/proto_file.pb.h"
+#include "envoy/local_info/local_info.h"
+#include "envoy/service/accesslog/v3/als.pb.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/access_loggers/common/access_log_base.h"
+#include "source/extensions/access_loggers/grpc/grpc_access_log_utils.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ProtoFile {
+
+using ProtoFileAccessLogConfig =
+    envoy::extensions::access_loggers::proto_file::v3::ProtoFileAccessLog;
+
+/**
+ * Writes batches of access log entries to a file, each serialized as a length delimited
+ * StreamAccessLogsMessage and optionally compressed as a gzip member.
+ */
+class BatchWriter {
+public:
+  BatchWriter(const ProtoFileAccessLogConfig& config, AccessLog::AccessLogManager& log_manager,
+              const LocalInfo::LocalInfo& local_info);
+
+  /**
+   * Writes the batch of entries to the file. Thread safe.
+   * @param message supplies the batch, which gets the identifier of the log if there is one.
+   */
+  void write(envoy::service::accesslog::v3::StreamAccessLogsMessage& message) const;
+
+private:
+  std::string compress(const std::string& record) const;
+
+  const AccessLog::AccessLogFileSharedPtr log_file_;
+  const bool compress_;
+  absl::optional<envoy::service::accesslog::v3::StreamAccessLogsMessage::Identifier> identifier_;
+};
+
+using BatchWriterSharedPtr = std::shared_ptr<const BatchWriter>;
+
+/**
+ * Access log Instance that writes the entries of the gRPC access log service to a file.
+ */
+class ProtoFileAccessLog : public Common::ImplBase {
+public:
+  ProtoFileAccessLog(AccessLog::FilterPtr&& filter, const ProtoFileAccessLogConfig& config,
+                     AccessLog::AccessLogManager& log_manager, ThreadLocal::SlotAllocator& tls,
+                     const LocalInfo::LocalInfo& local_info);
+
+private:
+  /**
+   * The batch of entries logged by a thread. The batch is written once it reaches the buffer size,
+   * at the flush interval, and when the log is destroyed.
+   */
+  class ThreadLocalBatch : public ThreadLocal::ThreadLocalObject {
+  public:
+    ThreadLocalBatch(BatchWriterSharedPtr writer, Event::Dispatcher& dispatcher,
+                     std::chrono::milliseconds flush_interval, uint64_t max_size_bytes);
+    ~ThreadLocalBatch() override;
+
+    envoy::service::accesslog::v3::StreamAccessLogsMessage& message() { return message_; }
+    void entryAdded(uint64_t size_bytes);
+
+  private:
+    void flush();
+
+    const BatchWriterSharedPtr writer_;
+    const std::chrono::milliseconds flush_interval_;
+    const uint64_t max_size_bytes_;
+    const Event::TimerPtr flush_timer_;
+    envoy::service::accesslog::v3::StreamAccessLogsMessage message_;
+    uint64_t approximate_size_bytes_{0};
+  };
+
+  // Common::ImplBase
+  void emitLog(const Http::RequestHeaderMap& request_headers,
+               const Http::ResponseHeaderMap& response_headers,
+               const Http::ResponseTrailerMap& response_trailers,
+               const StreamInfo::StreamInfo& stream_info) override;
+
+  const ProtoFileAccessLogConfig::EntryType entry_type_;
+  // Holds the parts of the config used by the entry builders.
+  envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig common_config_;
+  const GrpcCommon::HttpAccessLogEntryBuilder entry_builder_;
+  const ThreadLocal::SlotPtr tls_slot_;
+};
+
+} // namespace ProtoFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -40,24 +40,51 @@ AggregateClusterLoadBalancer::AggregateClusterLoadBalancer(
     }
 
     // Add callback for clusters initialized before aggregate cluster.
-    addMemberUpdateCallbackForCluster(*tlc);
+    addPriorityUpdateCallbackForCluster(*tlc);
   }
   refresh();
   handle_ = cluster_manager_.addThreadLocalClusterUpdateCallbacks(*this);
 }
 
-void AggregateClusterLoadBalancer::addMemberUpdateCallbackForCluster(
+void AggregateClusterLoadBalancer::addPriorityUpdateCallbackForCluster(
     Upstream::ThreadLocalCluster& thread_local_cluster) {
-  member_update_cbs_[thread_local_cluster.info()->name()] =
-      thread_local_cluster.prioritySet().addMemberUpdateCb(
-          [this, target_cluster_info = thread_local_cluster.info()](const Upstream::HostVector&,
-                                                                    const Upstream::HostVector&) {
-            ENVOY_LOG(debug, "member update for cluster '{}' in aggregate cluster '{}'",
-                      target_cluster_info->name(), parent_info_->name());
-            refresh();
+  priority_update_cbs_[thread_local_cluster.info()->name()] =
+      thread_local_cluster.prioritySet().addPriorityUpdateCb(
+          [this, &thread_local_cluster](uint32_t priority, const Upstream::HostVector& hosts_added,
+                                        const Upstream::HostVector& hosts_removed) {
+            onClusterPriorityUpdate(thread_local_cluster, priority, hosts_added, hosts_removed);
           });
 }
 
+void AggregateClusterLoadBalancer::onClusterPriorityUpdate(
+    Upstream::ThreadLocalCluster& thread_local_cluster, uint32_t priority,
+    const Upstream::HostVector& hosts_added, const Upstream::HostVector& hosts_removed) {
+  const std::string& cluster_name = thread_local_cluster.info()->name();
+  ENVOY_LOG(debug, "priority {} update for cluster '{}' in aggregate cluster '{}'", priority,
+            cluster_name, parent_info_->name());
+  const Upstream::HostSet& host_set =
+      *thread_local_cluster.prioritySet().hostSetsPerPriority()[priority];
+  const ClusterAndPriorityToLinearizedPriorityMap& linearized_priorities =
+      priority_context_->cluster_and_priority_to_linearized_priority_;
+  const auto it =
+      linearized_priorities.find(std::make_pair(absl::string_view(cluster_name), priority));
+  const bool linearized = it != linearized_priorities.end();
+  if (!linearized || host_set.hosts().empty()) {
+    // A priority gained its first host or lost its last one, which shifts the linearized
+    // priorities that follow it.
+    if (linearized || !host_set.hosts().empty()) {
+      refresh();
+    }
+    return;
+  }
+
+  // Only the linearized priority of the updated priority changes. The load balancer follows the
+  // update of its priority set, so neither the other priorities nor the load balancer are rebuilt.
+  priority_context_->priority_set_.updateHosts(
+      it->second, Upstream::HostSetImpl::updateHostsParams(host_set), host_set.localityWeights(),
+      hosts_added, hosts_removed, host_set.overprovisioningFactor());
+}
+
 PriorityContextPtr
 AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> excluded_cluster) {
   PriorityContextPtr priority_context = std::make_unique<PriorityContext>();
@@ -96,7 +123,8 @@ AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> exc
             std::make_pair(priority_in_current_cluster, tlc));
 
         priority_context->cluster_and_priority_to_linearized_priority_[std::make_pair(
-            cluster, priority_in_current_cluster)] = next_priority_after_linearizing;
+            absl::string_view(cluster), priority_in_current_cluster)] =
+            next_priority_after_linearizing;
         next_priority_after_linearizing++;
       }
       priority_in_current_cluster++;
@@ -122,7 +150,7 @@ void AggregateClusterLoadBalancer::onClusterAddOrUpdate(Upstream::ThreadLocalClu
     ENVOY_LOG(debug, "adding or updating cluster '{}' for aggregate cluster '{}'",
               cluster.info()->name(), parent_info_->name());
     refresh();
-    addMemberUpdateCallbackForCluster(cluster);
+    addPriorityUpdateCallbackForCluster(cluster);
   }
 }
 
@@ -140,7 +168,7 @@ void AggregateClusterLoadBalancer::onClusterRemoval(const std::string& cluster_n
 absl::optional<uint32_t> AggregateClusterLoadBalancer::LoadBalancerImpl::hostToLinearizedPriority(
     const Upstream::HostDescription& host) const {
   auto it = priority_context_.cluster_and_priority_to_linearized_priority_.find(
-      std::make_pair(host.cluster().name(), host.priority()));
+      std::make_pair(absl::string_view(host.cluster().name()), host.priority()));
 
   if (it != priority_context_.cluster_and_priority_to_linearized_priority_.end()) {
     return it->second;
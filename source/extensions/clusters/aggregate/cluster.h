@@ -21,8 +21,9 @@ namespace Aggregate {
 using PriorityToClusterVector = std::vector<std::pair<uint32_t, Upstream::ThreadLocalCluster*>>;
 
 // Maps pair(host_cluster_name, host_priority) to the linearized priority of the Aggregate cluster.
+// The cluster names refer to the ClusterSet of the aggregate cluster, which outlives the map.
 using ClusterAndPriorityToLinearizedPriorityMap =
-    absl::flat_hash_map<std::pair<std::string, uint32_t>, uint32_t>;
+    absl::flat_hash_map<std::pair<absl::string_view, uint32_t>, uint32_t>;
 
 struct PriorityContext {
   Upstream::PrioritySetImpl priority_set_;
@@ -123,7 +124,13 @@ private:
 
   using LoadBalancerImplPtr = std::unique_ptr<LoadBalancerImpl>;
 
-  void addMemberUpdateCallbackForCluster(Upstream::ThreadLocalCluster& thread_local_cluster);
+  void addPriorityUpdateCallbackForCluster(Upstream::ThreadLocalCluster& thread_local_cluster);
+  // Applies an update of a priority of one of the clusters to the linearized priority it maps to,
+  // unless the update adds or removes a linearized priority, in which case the priorities are
+  // linearized again.
+  void onClusterPriorityUpdate(Upstream::ThreadLocalCluster& thread_local_cluster,
+                               uint32_t priority, const Upstream::HostVector& hosts_added,
+                               const Upstream::HostVector& hosts_removed);
   PriorityContextPtr linearizePrioritySet(OptRef<const std::string> excluded_cluster);
   void refresh(OptRef<const std::string> excluded_cluster = OptRef<const std::string>());
 
@@ -135,7 +142,7 @@ private:
   PriorityContextPtr priority_context_;
   const ClusterSetConstSharedPtr clusters_;
   Upstream::ClusterUpdateCallbacksHandlePtr handle_;
-  absl::flat_hash_map<std::string, Envoy::Common::CallbackHandlePtr> member_update_cbs_;
+  absl::flat_hash_map<std::string, Envoy::Common::CallbackHandlePtr> priority_update_cbs_;
 };
 
 // Load balancer factory created by the main thread and will be called in each worker thread to
@@ -101,6 +101,9 @@ public:
   }
   HostStats& stats() const override { return logical_host_->stats(); }
   LoadMetricStats& loadMetricStats() const override { return logical_host_->loadMetricStats(); }
+  LocalityLoadStats& localityLoadStats() const override {
+    return logical_host_->localityLoadStats();
+  }
   const std::string& hostnameForHealthChecks() const override {
     return logical_host_->hostnameForHealthChecks();
   }
@@ -6,9 +6,11 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/thread.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/api_version.h"
 #include "source/common/config/decoded_resource_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -22,13 +24,19 @@ EdsClusterImpl::EdsClusterImpl(
                              std::move(stats_scope), added_via_api,
                              factory_context.mainThreadDispatcher().timeSource()),
       Envoy::Config::SubscriptionBase<envoy::config::endpoint::v3::ClusterLoadAssignment>(
-          factory_context.messageValidationVisitor(), "cluster_name"),
+          factory_context.messageValidationVisitor(), "cluster_name", true),
       factory_context_(factory_context), local_info_(factory_context.localInfo()),
       cluster_name_(cluster.eds_cluster_config().service_name().empty()
                         ? cluster.name()
-                        : cluster.eds_cluster_config().service_name()) {
+                        : cluster.eds_cluster_config().service_name()),
+      assignment_merge_window_(
+          PROTOBUF_GET_MS_OR_DEFAULT(cluster.eds_cluster_config(), assignment_merge_window, 0)) {
   Event::Dispatcher& dispatcher = factory_context.mainThreadDispatcher();
   assignment_timeout_ = dispatcher.createTimer([this]() -> void { onAssignmentTimeout(); });
+  if (assignment_merge_window_.count() > 0) {
+    assignment_merge_timer_ =
+        dispatcher.createTimer([this]() -> void { onAssignmentMergeWindowEnd(); });
+  }
   const auto& eds_config = cluster.eds_cluster_config().eds_config();
   if (Config::SubscriptionFactory::isPathBasedConfigSource(
           eds_config.config_source_specifier_case())) {
@@ -169,6 +177,53 @@ void EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef
     }
   }
 
+  // Management servers may resend unchanged assignments, which would rebuild the same hosts. The
+  // hash is computed at decode time when the resources are decoded on several threads.
+  absl::optional<uint64_t> assignment_hash;
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.eds_skip_unchanged_assignments")) {
+    assignment_hash = resources[0].get().resourceHash();
+    if (!assignment_hash.has_value()) {
+      assignment_hash = MessageUtil::hash(cluster_load_assignment);
+    }
+  }
+
+  if (assignment_merge_timer_ != nullptr) {
+    if (assignment_merge_timer_->enabled()) {
+      ENVOY_LOG(debug, "Merging ClusterLoadAssignment update for cluster {}", cluster_name_);
+      info_->configUpdateStats().update_merged_.inc();
+      pending_assignment_ = PendingAssignment{std::move(cluster_load_assignment), assignment_hash};
+      return;
+    }
+    // Updates received from now on until the window ends are merged.
+    assignment_merge_timer_->enableTimer(assignment_merge_window_);
+  }
+  applyAssignment(std::move(cluster_load_assignment), assignment_hash);
+}
+
+void EdsClusterImpl::onAssignmentMergeWindowEnd() {
+  if (!pending_assignment_.has_value()) {
+    return;
+  }
+  PendingAssignment pending_assignment = std::move(pending_assignment_.value());
+  pending_assignment_ = absl::nullopt;
+  // Keep merging the updates for another window, so that an ongoing burst of updates is applied
+  // at most once per window.
+  assignment_merge_timer_->enableTimer(assignment_merge_window_);
+  // The merged assignment was already acknowledged, so it can't be rejected anymore.
+  TRY_ASSERT_MAIN_THREAD {
+    applyAssignment(std::move(pending_assignment.cluster_load_assignment_),
+                    pending_assignment.assignment_hash_);
+  }
+  END_TRY
+  catch (const EnvoyException& e) {
+    ENVOY_LOG(warn, "Failed to apply the merged ClusterLoadAssignment for cluster {}: {}",
+              cluster_name_, e.what());
+  }
+}
+
+void EdsClusterImpl::applyAssignment(
+    envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment,
+    absl::optional<uint64_t> assignment_hash) {
   // Disable timer (if enabled) as we have received new assignment.
   if (assignment_timeout_->enabled()) {
     assignment_timeout_->disableTimer();
@@ -182,6 +237,13 @@ void EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef
     assignment_timeout_->enableTimer(std::chrono::milliseconds(stale_after_ms));
   }
 
+  if (assignment_hash.has_value() && assignment_hash == last_assignment_hash_) {
+    ENVOY_LOG(debug, "Skipping unchanged ClusterLoadAssignment for cluster {}", cluster_name_);
+    info_->configUpdateStats().update_unchanged_.inc();
+    info_->configUpdateStats().update_no_rebuild_.inc();
+    return;
+  }
+
   // Pause LEDS messages until the EDS config is finished processing.
   Config::ScopedResume maybe_resume_leds;
   if (factory_context_.clusterManager().adsMux()) {
@@ -241,11 +303,14 @@ void EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef
   // If all the LEDS localities are updated, the EDS update can occur. If not, then when the last
   // LEDS locality will be updated, it will trigger the EDS update helper.
   if (!validateAllLedsUpdated()) {
+    last_assignment_hash_ = assignment_hash;
     return;
   }
 
   BatchUpdateHelper helper(*this, *used_load_assignment);
   priority_set_.batchHostUpdate(helper);
+  // Only remember the assignments which were applied, since rejected ones must be rejected again.
+  last_assignment_hash_ = assignment_hash;
 }
 
 void EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_resources,
@@ -272,6 +337,12 @@ bool EdsClusterImpl::validateUpdateSize(int num_resources) {
 }
 
 void EdsClusterImpl::onAssignmentTimeout() {
+  if (pending_assignment_.has_value()) {
+    // A newer assignment is waiting for the end of the merge window, apply it right away instead.
+    assignment_merge_timer_->disableTimer();
+    onAssignmentMergeWindowEnd();
+    return;
+  }
   // We can no longer use the assignments, remove them.
   // TODO(vishalpowar) This is not going to work for incremental updates, and we
   // need to instead change the health status to indicate the assignments are
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -47,6 +48,11 @@ private:
                       const std::string& system_version_info) override;
   void onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason reason,
                             const EnvoyException* e) override;
+  // Applies a validated assignment to the hosts of the cluster.
+  void applyAssignment(envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment,
+                       absl::optional<uint64_t> assignment_hash);
+  // Applies the last assignment merged within the assignment merge window, if any.
+  void onAssignmentMergeWindowEnd();
   using LocalityWeightsMap = absl::node_hash_map<envoy::config::core::v3::Locality, uint32_t,
                                                  LocalityHash, LocalityEqualTo>;
   bool updateHostsPerLocality(const uint32_t priority, const uint32_t overprovisioning_factor,
@@ -104,6 +110,17 @@ private:
   // relevant parts of the config for each locality. Note that this field must
   // be set when LEDS is used.
   absl::optional<envoy::config::endpoint::v3::ClusterLoadAssignment> cluster_load_assignment_;
+  // The hash of the last assignment which wasn't skipped as unchanged.
+  absl::optional<uint64_t> last_assignment_hash_;
+  // Assignments received while assignment_merge_timer_ is enabled are kept in pending_assignment_,
+  // replacing the previous pending one, and the last of them is applied when the timer fires.
+  struct PendingAssignment {
+    envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment_;
+    absl::optional<uint64_t> assignment_hash_;
+  };
+  const std::chrono::milliseconds assignment_merge_window_;
+  Event::TimerPtr assignment_merge_timer_;
+  absl::optional<PendingAssignment> pending_assignment_;
 };
 
 using EdsClusterImplSharedPtr = std::shared_ptr<EdsClusterImpl>;
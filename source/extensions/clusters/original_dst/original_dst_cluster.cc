@@ -1,6 +1,7 @@
 #include "source/extensions/clusters/original_dst/original_dst_cluster.h"
 
 #include <chrono>
+#include <limits>
 #include <list>
 #include <string>
 #include <vector>
@@ -19,9 +20,61 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/hash/hash.h"
+
 namespace Envoy {
 namespace Upstream {
 
+HostMultiMap::HostMultiMap() {
+  for (auto& shard : shards_) {
+    shard = std::make_shared<Shard>();
+  }
+  owned_shards_.set();
+}
+
+HostMultiMap::HostMultiMap(const HostMultiMap& other)
+    : shards_(other.shards_), size_(other.size_) {}
+
+size_t HostMultiMap::shardIndex(absl::string_view address) {
+  // The shards use the low bits of the hash to probe, so the shard is chosen with the high ones.
+  return absl::Hash<absl::string_view>()(address) >>
+         (std::numeric_limits<size_t>::digits - ShardBits);
+}
+
+HostMultiMap::Shard& HostMultiMap::mutableShard(absl::string_view address) {
+  const size_t index = shardIndex(address);
+  if (!owned_shards_.test(index)) {
+    shards_[index] = std::make_shared<Shard>(*shards_[index]);
+    owned_shards_.set(index);
+  }
+  return *shards_[index];
+}
+
+HostsForAddress* HostMultiMap::find(absl::string_view address) const {
+  const Shard& shard = *shards_[shardIndex(address)];
+  const auto it = shard.find(address);
+  return it != shard.end() ? it->second.get() : nullptr;
+}
+
+void HostMultiMap::emplace(absl::string_view address, HostsForAddressSharedPtr hosts) {
+  if (mutableShard(address).emplace(address, std::move(hosts)).second) {
+    size_++;
+  }
+}
+
+void HostMultiMap::erase(absl::string_view address) {
+  size_ -= mutableShard(address).erase(address);
+}
+
+void HostMultiMap::iterate(
+    const std::function<void(const std::string&, HostsForAddress&)>& cb) const {
+  for (const auto& shard : shards_) {
+    for (const auto& [address, hosts] : *shard) {
+      cb(address, *hosts);
+    }
+  }
+}
+
 HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerContext* context) {
   if (context) {
     // Check if filter state override is present, if yes use it before headers and local address.
@@ -47,11 +100,11 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
     if (dst_host) {
       const Network::Address::Instance& dst_addr = *dst_host.get();
       // Check if a host with the destination address is already in the host set.
-      auto it = host_map_->find(dst_addr.asString());
-      if (it != host_map_->end()) {
-        HostConstSharedPtr host = it->second->host_;
+      HostsForAddress* hosts = host_map_->find(dst_addr.asString());
+      if (hosts != nullptr) {
+        HostConstSharedPtr host = hosts->host_;
         ENVOY_LOG(trace, "Using existing host {} {}.", *host, host->address()->asString());
-        it->second->used_ = true;
+        hosts->used_ = true;
         return host;
       }
       // Add a new host
@@ -168,22 +221,24 @@ OriginalDstCluster::OriginalDstCluster(
 
 void OriginalDstCluster::addHost(HostSharedPtr& host) {
   std::string address = host->address()->asString();
-  HostMultiMapSharedPtr new_host_map = std::make_shared<HostMultiMap>(*getCurrentHostMap());
-  auto it = new_host_map->find(address);
-  if (it != new_host_map->end()) {
+  const HostMultiMapConstSharedPtr host_map = getCurrentHostMap();
+  HostsForAddress* hosts = host_map->find(address);
+  if (hosts != nullptr) {
     // If the entry already exists, that means the worker that posted this host
     // had a stale host map. Because the host is potentially in that worker's
     // connection pools, we save the host in the host map hosts_ list and the
     // cluster priority set. Subsequently, the entire hosts_ list and the
     // primary host are removed collectively, once no longer in use.
-    it->second->hosts_.push_back(host);
+    hosts->hosts_.push_back(host);
   } else {
     // The first worker that creates a host for the address defines the primary
-    // host structure.
+    // host structure. The new map shares all the shards of the current one but
+    // the one of the address.
+    HostMultiMapSharedPtr new_host_map = std::make_shared<HostMultiMap>(*host_map);
     new_host_map->emplace(address, std::make_shared<HostsForAddress>(host));
+    setHostMap(new_host_map);
   }
   ENVOY_LOG(debug, "addHost() adding {} {}.", *host, address);
-  setHostMap(new_host_map);
 
   // Given the current config, only EDS clusters support multiple priorities.
   ASSERT(priority_set_.hostSetsPerPriority().size() == 1);
@@ -198,11 +253,13 @@ void OriginalDstCluster::addHost(HostSharedPtr& host) {
 void OriginalDstCluster::cleanup() {
   HostVectorSharedPtr keeping_hosts(new HostVector);
   HostVector to_be_removed;
-  absl::flat_hash_set<absl::string_view> removed_addresses;
+  std::vector<absl::string_view> removed_addresses;
   auto host_map = getCurrentHostMap();
   if (!host_map->empty()) {
     ENVOY_LOG(trace, "Cleaning up stale original dst hosts.");
-    for (const auto& [addr, hosts] : *host_map) {
+    const bool rely_on_idle_timeout = Runtime::runtimeFeatureEnabled(
+        "envoy.reloadable_features.original_dst_rely_on_idle_timeout");
+    host_map->iterate([&](const std::string& addr, HostsForAddress& hosts) {
       // Address is kept in the cluster if either of the two things happen:
       // 1) a host has been recently selected for the address; 2) none of the
       // hosts are currently in any of the connection pools.
@@ -221,17 +278,16 @@ void OriginalDstCluster::cleanup() {
       // 3) will not delete h since it takes at least one cleanup_interval for
       // the host to set used_ bit for h to false.
       bool keep = false;
-      if (hosts->used_) {
+      if (hosts.used_) {
         keep = true;
-        hosts->used_ = false; // Mark to be removed during the next round.
-      } else if (Runtime::runtimeFeatureEnabled(
-                     "envoy.reloadable_features.original_dst_rely_on_idle_timeout")) {
+        hosts.used_ = false; // Mark to be removed during the next round.
+      } else if (rely_on_idle_timeout) {
         // Check that all hosts (first, as well as others that may have been added concurrently)
         // are not in use by any connection pool.
-        if (hosts->host_->used()) {
+        if (hosts.host_->used()) {
           keep = true;
         } else {
-          for (const auto& host : hosts->hosts_) {
+          for (const auto& host : hosts.hosts_) {
             if (host->used()) {
               keep = true;
               break;
@@ -241,21 +297,22 @@ void OriginalDstCluster::cleanup() {
       }
       if (keep) {
         ENVOY_LOG(trace, "Keeping active address {}.", addr);
-        keeping_hosts->emplace_back(hosts->host_);
-        if (!hosts->hosts_.empty()) {
-          keeping_hosts->insert(keeping_hosts->end(), hosts->hosts_.begin(), hosts->hosts_.end());
+        keeping_hosts->emplace_back(hosts.host_);
+        if (!hosts.hosts_.empty()) {
+          keeping_hosts->insert(keeping_hosts->end(), hosts.hosts_.begin(), hosts.hosts_.end());
         }
       } else {
         ENVOY_LOG(trace, "Removing stale address {}.", addr);
-        removed_addresses.insert(addr);
-        to_be_removed.emplace_back(hosts->host_);
-        if (!hosts->hosts_.empty()) {
-          to_be_removed.insert(to_be_removed.end(), hosts->hosts_.begin(), hosts->hosts_.end());
+        removed_addresses.push_back(addr);
+        to_be_removed.emplace_back(hosts.host_);
+        if (!hosts.hosts_.empty()) {
+          to_be_removed.insert(to_be_removed.end(), hosts.hosts_.begin(), hosts.hosts_.end());
         }
       }
-    }
+    });
   }
   if (!to_be_removed.empty()) {
+    // Only the shards of the removed addresses are copied, each at most once.
     HostMultiMapSharedPtr new_host_map = std::make_shared<HostMultiMap>(*host_map);
     for (const auto& addr : removed_addresses) {
       new_host_map->erase(addr);
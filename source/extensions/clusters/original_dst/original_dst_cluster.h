@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <bitset>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -34,7 +36,61 @@ struct HostsForAddress {
 };
 
 using HostsForAddressSharedPtr = std::shared_ptr<HostsForAddress>;
-using HostMultiMap = absl::flat_hash_map<std::string, HostsForAddressSharedPtr>;
+
+/**
+ * The hosts of the cluster by address. The load balancers of the workers share immutable snapshots
+ * of the map, which the main thread replaces on every update. The addresses are split into shards
+ * that the snapshots share copy-on-write, so that an update only copies the shards it changes
+ * rather than the hosts of all the addresses.
+ */
+class HostMultiMap {
+public:
+  using Shard = absl::flat_hash_map<std::string, HostsForAddressSharedPtr>;
+
+  HostMultiMap();
+  /**
+   * Creates a snapshot sharing all the shards of `other`, which are copied as they are modified.
+   */
+  HostMultiMap(const HostMultiMap& other);
+  HostMultiMap& operator=(const HostMultiMap&) = delete;
+
+  /**
+   * @return the hosts for `address`, or nullptr if there are none.
+   */
+  HostsForAddress* find(absl::string_view address) const;
+
+  /**
+   * Adds the hosts for an address that has none yet.
+   */
+  void emplace(absl::string_view address, HostsForAddressSharedPtr hosts);
+
+  /**
+   * Removes the hosts for `address`, if any.
+   */
+  void erase(absl::string_view address);
+
+  /**
+   * Calls `cb` with each address and its hosts, shard by shard.
+   */
+  void iterate(const std::function<void(const std::string&, HostsForAddress&)>& cb) const;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+private:
+  static constexpr size_t ShardBits = 6;
+  static constexpr size_t NumShards = 1 << ShardBits;
+
+  static size_t shardIndex(absl::string_view address);
+  Shard& mutableShard(absl::string_view address);
+
+  std::array<std::shared_ptr<Shard>, NumShards> shards_;
+  // The shards that were created or copied for this map, and so are not shared with any other
+  // snapshot yet.
+  std::bitset<NumShards> owned_shards_;
+  size_t size_{0};
+};
+
 using HostMultiMapSharedPtr = std::shared_ptr<HostMultiMap>;
 using HostMultiMapConstSharedPtr = std::shared_ptr<const HostMultiMap>;
 
@@ -129,6 +129,8 @@ private:
 
   void onClusterSlotUpdate(ClusterSlotsSharedPtr&&);
 
+  void onSlotsMoved(const Common::Redis::MovedSlots& moved_slots);
+
   void reloadHealthyHostsHelper(const Upstream::HostSharedPtr& host) override;
 
   const envoy::config::endpoint::v3::LocalityLbEndpoints& localityLbEndpoint() const {
@@ -30,6 +30,17 @@ bool RedisClusterLoadBalancerFactory::onClusterSlotUpdate(ClusterSlotsSharedPtr&
     return false;
   }
 
+  // The current shards are reused if their hosts don't change, which skips partitioning them.
+  absl::flat_hash_map<std::string, RedisShardSharedPtr> current_shards;
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    if (shard_vector_) {
+      for (const RedisShardSharedPtr& shard : *shard_vector_) {
+        current_shards.emplace(shard->primary()->address()->asString(), shard);
+      }
+    }
+  }
+
   auto updated_slots = std::make_shared<SlotArray>();
   auto shard_vector = std::make_shared<std::vector<RedisShardSharedPtr>>();
   absl::flat_hash_map<std::string, uint64_t> shards;
@@ -56,8 +67,14 @@ bool RedisClusterLoadBalancerFactory::onClusterSlotUpdate(ClusterSlotsSharedPtr&
         primary_and_replicas->push_back(replica_host->second);
       }
 
-      shard_vector->emplace_back(
-          std::make_shared<RedisShard>(primary_host->second, replicas, primary_and_replicas));
+      auto current_shard = current_shards.find(primary_address);
+      if (current_shard != current_shards.end() &&
+          current_shard->second->allHosts().hosts() == *primary_and_replicas) {
+        shard_vector->push_back(current_shard->second);
+      } else {
+        shard_vector->emplace_back(
+            std::make_shared<RedisShard>(primary_host->second, replicas, primary_and_replicas));
+      }
     }
 
     for (auto i = slot.start(); i <= slot.end(); ++i) {
@@ -99,6 +116,51 @@ void RedisClusterLoadBalancerFactory::onHostHealthUpdate() {
   }
 }
 
+bool RedisClusterLoadBalancerFactory::onSlotsMoved(const Common::Redis::MovedSlots& moved_slots) {
+  SlotArraySharedPtr current_slots;
+  ShardVectorSharedPtr current_shard_vector;
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    current_slots = slot_array_;
+    current_shard_vector = shard_vector_;
+  }
+
+  if (!current_slots || !current_shard_vector) {
+    return false;
+  }
+
+  absl::flat_hash_map<std::string, uint64_t> shards;
+  for (uint64_t i = 0; i < current_shard_vector->size(); i++) {
+    shards.emplace((*current_shard_vector)[i]->primary()->address()->asString(), i);
+  }
+
+  // Only the moved slots are patched in a copy of the slot array. A slot moved to a host which
+  // isn't the primary of a shard, such as a new node, waits for the topology refresh.
+  std::shared_ptr<SlotArray> updated_slots;
+  for (const auto& moved_slot : moved_slots) {
+    auto shard = shards.find(moved_slot.second);
+    if (moved_slot.first >= MaxSlot || shard == shards.end() ||
+        (*current_slots)[moved_slot.first] == shard->second) {
+      continue;
+    }
+    if (!updated_slots) {
+      updated_slots = std::make_shared<SlotArray>(*current_slots);
+    }
+    (*updated_slots)[moved_slot.first] = shard->second;
+  }
+
+  if (!updated_slots) {
+    return false;
+  }
+
+  absl::WriterMutexLock lock(&mutex_);
+  if (slot_array_ != current_slots) {
+    return false;
+  }
+  slot_array_ = std::move(updated_slots);
+  return true;
+}
+
 Upstream::LoadBalancerPtr RedisClusterLoadBalancerFactory::create() {
   absl::ReaderMutexLock lock(&mutex_);
   return std::make_unique<RedisClusterLoadBalancer>(slot_array_, shard_vector_, random_);
@@ -11,6 +11,7 @@
 #include "source/common/upstream/load_balancer_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/clusters/redis/crc16.h"
+#include "source/extensions/common/redis/cluster_refresh_manager.h"
 #include "source/extensions/filters/network/common/redis/client.h"
 #include "source/extensions/filters/network/common/redis/codec.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
@@ -130,6 +131,14 @@ public:
    * Callback when a host's health status is updated
    */
   virtual void onHostHealthUpdate() PURE;
+
+  /**
+   * Callback when slots are moved to other hosts by MOVED redirections, before the topology is
+   * refreshed.
+   * @param moved_slots provides the moved slots and the addresses of their new hosts.
+   * @return indicate if the cluster slot is updated or not.
+   */
+  virtual bool onSlotsMoved(const Common::Redis::MovedSlots& moved_slots) PURE;
 };
 
 using ClusterSlotUpdateCallBackSharedPtr = std::shared_ptr<ClusterSlotUpdateCallBack>;
@@ -147,6 +156,7 @@ public:
   bool onClusterSlotUpdate(ClusterSlotsSharedPtr&& slots, Upstream::HostMap& all_hosts) override;
 
   void onHostHealthUpdate() override;
+  bool onSlotsMoved(const Common::Redis::MovedSlots& moved_slots) override;
 
   // Upstream::LoadBalancerFactory
   Upstream::LoadBalancerPtr create() override;
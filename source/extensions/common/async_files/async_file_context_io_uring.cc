@@ -0,0 +1,158 @@
+#include "source/extensions/common/async_files/async_file_context_io_uring.h"
+
+#include <sys/uio.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+#include "source/extensions/common/async_files/status_after_file_error.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+namespace {
+
+template <typename T> class AsyncFileActionIoUringWithResult : public AsyncFileActionIoUring {
+public:
+  AsyncFileActionIoUringWithResult(AsyncFileHandle handle, int fd,
+                                   std::function<void(T)> on_complete)
+      : handle_(std::move(handle)), fd_(fd), on_complete_(std::move(on_complete)) {}
+
+protected:
+  // Calls the callback unless the action was cancelled, as AsyncFileActionWithResult does.
+  void complete(T result) {
+    State expected = State::Executing;
+    if (!state_.compare_exchange_strong(expected, State::InCallback)) {
+      ASSERT(expected == State::Cancelled);
+      return;
+    }
+    on_complete_(std::move(result));
+    state_.store(State::Done);
+  }
+
+  // Keeps the file context alive while its I/O is in flight.
+  const AsyncFileHandle handle_;
+  const int fd_;
+
+private:
+  std::function<void(T)> on_complete_;
+};
+
+class ActionReadFile
+    : public AsyncFileActionIoUringWithResult<absl::StatusOr<Buffer::InstancePtr>> {
+public:
+  ActionReadFile(AsyncFileHandle handle, int fd, off_t offset, size_t length,
+                 std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete)
+      : AsyncFileActionIoUringWithResult(std::move(handle), fd, std::move(on_complete)),
+        offset_(offset), length_(length), buffer_(std::make_unique<Buffer::OwnedImpl>()),
+        reservation_(buffer_->reserveSingleSlice(length)) {
+    iovec_.iov_base = reservation_.slice().mem_;
+    iovec_.iov_len = length_;
+  }
+
+  Io::IoUringResult prepare(Io::IoUring& ring) override {
+    return ring.prepareReadv(fd_, &iovec_, 1, offset_, this);
+  }
+
+  bool onCompletion(int32_t result) override {
+    if (result < 0) {
+      complete(statusAfterFileError(-result));
+      return true;
+    }
+    Buffer::InstancePtr buffer;
+    if (static_cast<size_t>(result) != length_) {
+      buffer = std::make_unique<Buffer::OwnedImpl>(reservation_.slice().mem_, result);
+    } else {
+      reservation_.commit(result);
+      buffer = std::move(buffer_);
+    }
+    complete(std::move(buffer));
+    return true;
+  }
+
+private:
+  const off_t offset_;
+  const size_t length_;
+  // The kernel reads straight into the reserved slice of the returned buffer.
+  Buffer::InstancePtr buffer_;
+  Buffer::ReservationSingleSlice reservation_;
+  struct iovec iovec_;
+};
+
+class ActionWriteFile : public AsyncFileActionIoUringWithResult<absl::StatusOr<size_t>> {
+public:
+  ActionWriteFile(AsyncFileHandle handle, int fd, Buffer::Instance& contents, off_t offset,
+                  std::function<void(absl::StatusOr<size_t>)> on_complete)
+      : AsyncFileActionIoUringWithResult(std::move(handle), fd, std::move(on_complete)),
+        offset_(offset) {
+    contents_.move(contents);
+  }
+
+  Io::IoUringResult prepare(Io::IoUring& ring) override {
+    // The slices of what remains to be written, which stay valid until the write completes.
+    iovecs_.clear();
+    for (const Buffer::RawSlice& slice : contents_.getRawSlices()) {
+      iovecs_.push_back({slice.mem_, slice.len_});
+    }
+    return ring.prepareWritev(fd_, iovecs_.data(), iovecs_.size(), offset_ + bytes_written_, this);
+  }
+
+  bool onCompletion(int32_t result) override {
+    if (result < 0) {
+      complete(statusAfterFileError(-result));
+      return true;
+    }
+    bytes_written_ += result;
+    contents_.drain(result);
+    if (contents_.length() > 0 && result > 0 && state_.load() != State::Cancelled) {
+      // A short write; submit the rest, as the thread pool implementation writes everything.
+      return false;
+    }
+    complete(bytes_written_);
+    return true;
+  }
+
+private:
+  Buffer::OwnedImpl contents_;
+  const off_t offset_;
+  size_t bytes_written_ = 0;
+  std::vector<struct iovec> iovecs_;
+};
+
+} // namespace
+
+AsyncFileContextIoUring::AsyncFileContextIoUring(AsyncFileManagerIoUring& manager, int fd)
+    : AsyncFileContextThreadPool(manager, fd), io_uring_manager_(manager) {}
+
+absl::StatusOr<CancelFunction> AsyncFileContextIoUring::read(
+    off_t offset, size_t length,
+    std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) {
+  if (fileDescriptor() == -1) {
+    return absl::FailedPreconditionError("file was already closed");
+  }
+  auto action = std::make_shared<ActionReadFile>(handle(), fileDescriptor(), offset, length,
+                                                 std::move(on_complete));
+  io_uring_manager_.submit(action);
+  return [action]() { action->cancel(); };
+}
+
+absl::StatusOr<CancelFunction>
+AsyncFileContextIoUring::write(Buffer::Instance& contents, off_t offset,
+                               std::function<void(absl::StatusOr<size_t>)> on_complete) {
+  if (fileDescriptor() == -1) {
+    return absl::FailedPreconditionError("file was already closed");
+  }
+  auto action = std::make_shared<ActionWriteFile>(handle(), fileDescriptor(), contents, offset,
+                                                  std::move(on_complete));
+  io_uring_manager_.submit(action);
+  return [action]() { action->cancel(); };
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
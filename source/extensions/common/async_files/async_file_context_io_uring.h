@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+
+#include "source/extensions/common/async_files/async_file_context_thread_pool.h"
+
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+class AsyncFileManagerIoUring;
+
+// The io_uring implementation of an AsyncFileContext - reads and writes are submitted to the
+// manager's io_uring, and the other actions are performed in the manager's thread pool.
+class AsyncFileContextIoUring final : public AsyncFileContextThreadPool {
+public:
+  AsyncFileContextIoUring(AsyncFileManagerIoUring& manager, int fd);
+
+  absl::StatusOr<CancelFunction>
+  read(off_t offset, size_t length,
+       std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override;
+  absl::StatusOr<CancelFunction>
+  write(Buffer::Instance& contents, off_t offset,
+        std::function<void(absl::StatusOr<size_t>)> on_complete) override;
+
+private:
+  AsyncFileManagerIoUring& io_uring_manager_;
+};
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
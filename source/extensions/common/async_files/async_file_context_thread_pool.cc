@@ -1,7 +1,10 @@
 #include "source/extensions/common/async_files/async_file_context_thread_pool.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -130,6 +133,60 @@ private:
   const size_t length_;
 };
 
+class ActionReadFileMapped
+    : public AsyncFileActionThreadPool<absl::StatusOr<Buffer::InstancePtr>> {
+public:
+  ActionReadFileMapped(AsyncFileHandle handle, off_t offset, size_t length,
+                       std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete)
+      : AsyncFileActionThreadPool<absl::StatusOr<Buffer::InstancePtr>>(handle, on_complete),
+        offset_(offset), length_(length) {}
+
+  absl::StatusOr<Buffer::InstancePtr> executeImpl() override {
+    ASSERT(fileDescriptor() != -1);
+    auto result = std::make_unique<Buffer::OwnedImpl>();
+    // Pages past the end of the file can't be accessed, so the range is truncated like a read.
+    struct stat stat_result;
+    auto stat_status = posix().fstat(fileDescriptor(), &stat_result);
+    if (stat_status.return_value_ != 0) {
+      return statusAfterFileError(stat_status);
+    }
+    if (offset_ >= stat_result.st_size) {
+      return result;
+    }
+    const size_t length =
+        std::min<uint64_t>(length_, static_cast<uint64_t>(stat_result.st_size - offset_));
+    if (length == 0) {
+      return result;
+    }
+
+    // Mappings start on a page boundary.
+    const off_t page_size = sysconf(_SC_PAGESIZE);
+    const off_t map_offset = offset_ - offset_ % page_size;
+    const size_t map_length = length + (offset_ - map_offset);
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // Fault the pages in on this thread rather than on the thread that sends the data.
+    flags |= MAP_POPULATE;
+#endif
+    auto mapped = posix().mmap(nullptr, map_length, PROT_READ, flags, fileDescriptor(), map_offset);
+    if (mapped.return_value_ == MAP_FAILED) {
+      return statusAfterFileError(mapped);
+    }
+    result->addBufferFragment(*new Buffer::BufferFragmentImpl(
+        static_cast<const char*>(mapped.return_value_) + (offset_ - map_offset), length,
+        [map = mapped.return_value_, map_length](const void*, size_t,
+                                                 const Buffer::BufferFragmentImpl* fragment) {
+          ::munmap(map, map_length);
+          delete fragment;
+        }));
+    return result;
+  }
+
+private:
+  const off_t offset_;
+  const size_t length_;
+};
+
 class ActionWriteFile : public AsyncFileActionThreadPool<absl::StatusOr<size_t>> {
 public:
   ActionWriteFile(AsyncFileHandle handle, Buffer::Instance& contents, off_t offset,
@@ -175,7 +232,8 @@ public:
     if (newfd.return_value_ == -1) {
       return statusAfterFileError(newfd);
     }
-    return std::make_shared<AsyncFileContextThreadPool>(context()->manager(), newfd.return_value_);
+    return static_cast<AsyncFileManagerThreadPool&>(context()->manager())
+        .newFileContext(newfd.return_value_);
   }
 
   void onCancelledBeforeCallback(absl::StatusOr<AsyncFileHandle> result) override {
@@ -214,6 +272,13 @@ absl::StatusOr<CancelFunction> AsyncFileContextThreadPool::read(
       std::make_shared<ActionReadFile>(handle(), offset, length, std::move(on_complete)));
 }
 
+absl::StatusOr<CancelFunction> AsyncFileContextThreadPool::readMapped(
+    off_t offset, size_t length,
+    std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) {
+  return checkFileAndEnqueue(
+      std::make_shared<ActionReadFileMapped>(handle(), offset, length, std::move(on_complete)));
+}
+
 absl::StatusOr<CancelFunction>
 AsyncFileContextThreadPool::write(Buffer::Instance& contents, off_t offset,
                                   std::function<void(absl::StatusOr<size_t>)> on_complete) {
@@ -17,7 +17,7 @@ class AsyncFileManager;
 
 // The thread pool implementation of an AsyncFileContext - uses the manager thread pool and
 // old-school synchronous posix file operations.
-class AsyncFileContextThreadPool final : public AsyncFileContextBase {
+class AsyncFileContextThreadPool : public AsyncFileContextBase {
 public:
   explicit AsyncFileContextThreadPool(AsyncFileManager& manager, int fd);
 
@@ -31,6 +31,9 @@ public:
   read(off_t offset, size_t length,
        std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override;
   absl::StatusOr<CancelFunction>
+  readMapped(off_t offset, size_t length,
+             std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override;
+  absl::StatusOr<CancelFunction>
   write(Buffer::Instance& contents, off_t offset,
         std::function<void(absl::StatusOr<size_t>)> on_complete) override;
   absl::StatusOr<CancelFunction>
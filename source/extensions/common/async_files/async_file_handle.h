@@ -48,6 +48,14 @@ public:
   read(off_t offset, size_t length,
        std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) PURE;
 
+  // Enqueues an action like read, except that the buffer passed to on_complete references a
+  // read-only memory mapping of the file instead of a copy of its contents, so that the data can
+  // be sent from the page cache. The mapping is released when the buffer is drained. The range must
+  // not be written to while the buffer exists.
+  virtual absl::StatusOr<CancelFunction>
+  readMapped(off_t offset, size_t length,
+             std::function<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) PURE;
+
   // Enqueues an action to write to the currently open file, at position offset, the bytes contained
   // by contents. It is an error to call write on an AsyncFileContext that does not have a file
   // open.
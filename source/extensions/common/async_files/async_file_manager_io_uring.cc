@@ -0,0 +1,148 @@
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/common/io/io_uring_impl.h"
+#include "source/extensions/common/async_files/async_file_context_io_uring.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+namespace {
+constexpr uint32_t DefaultQueueDepth = 256;
+} // namespace
+
+void AsyncFileActionIoUring::execute() { PANIC("io_uring actions are submitted, not executed"); }
+
+bool AsyncFileActionIoUring::start() {
+  State expected = State::Queued;
+  // Resubmitted actions are already executing.
+  return state_.compare_exchange_strong(expected, State::Executing) ||
+         expected == State::Executing;
+}
+
+AsyncFileManagerIoUring::AsyncFileManagerIoUring(
+    const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+    Api::OsSysCalls& posix)
+    : AsyncFileManagerThreadPool(config.id(), config.io_uring().thread_count(), posix),
+      queue_depth_(config.io_uring().queue_depth() == 0 ? DefaultQueueDepth
+                                                         : config.io_uring().queue_depth()) {
+  if (!Io::isIoUringSupported()) {
+    throw EnvoyException("AsyncFileManagerIoUring: io_uring is not supported by the kernel");
+  }
+  ring_ = std::make_unique<Io::IoUringImpl>(queue_depth_, false);
+  event_fd_ = ring_->registerEventfd();
+  ENVOY_LOG(info, fmt::format("AsyncFileManagerIoUring created with id '{}', queue depth {}",
+                              config.id(), queue_depth_));
+  completion_thread_ = std::thread([this]() { completionThread(); });
+}
+
+AsyncFileManagerIoUring::~AsyncFileManagerIoUring() ABSL_LOCKS_EXCLUDED(mutex_) {
+  {
+    absl::MutexLock lock(&mutex_);
+    terminate_ = true;
+  }
+  // Wakes up the completion thread, which exits once the actions in flight have completed.
+  eventfd_write(event_fd_, 1);
+  completion_thread_.join();
+  ring_->unregisterEventfd();
+  ::close(event_fd_);
+}
+
+std::string AsyncFileManagerIoUring::describe() const {
+  return absl::StrCat("io_uring_queue_depth = ", queue_depth_, ", ",
+                      AsyncFileManagerThreadPool::describe());
+}
+
+AsyncFileHandle AsyncFileManagerIoUring::newFileContext(int fd) {
+  return std::make_shared<AsyncFileContextIoUring>(*this, fd);
+}
+
+void AsyncFileManagerIoUring::submit(std::shared_ptr<AsyncFileActionIoUring> action) {
+  absl::MutexLock lock(&mutex_);
+  if (terminate_) {
+    return;
+  }
+  if (in_flight_.size() >= queue_depth_) {
+    pending_.push_back(std::move(action));
+    return;
+  }
+  submitLocked(std::move(action));
+}
+
+bool AsyncFileManagerIoUring::submitLocked(std::shared_ptr<AsyncFileActionIoUring> action) {
+  if (!action->start()) {
+    return true;
+  }
+  if (action->prepare(*ring_) != Io::IoUringResult::Ok) {
+    // The submission queue is full; try again once some completions have been reaped.
+    pending_.push_front(std::move(action));
+    return false;
+  }
+  AsyncFileActionIoUring* user_data = action.get();
+  in_flight_.emplace(user_data, std::move(action));
+  // If the kernel is busy, the request stays in the submission queue and is submitted along with
+  // the next one, or by the completion thread.
+  ring_->submit();
+  return true;
+}
+
+void AsyncFileManagerIoUring::completionThread() {
+  std::vector<std::pair<void*, int32_t>> results;
+  std::vector<std::pair<std::shared_ptr<AsyncFileActionIoUring>, int32_t>> completed;
+  while (true) {
+    // Blocks until the kernel or the destructor signals the eventfd.
+    ring_->forEveryCompletion([&results](void* user_data, int32_t result) {
+      results.emplace_back(user_data, result);
+    });
+    {
+      absl::MutexLock lock(&mutex_);
+      for (const auto& [user_data, result] : results) {
+        auto it = in_flight_.find(static_cast<AsyncFileActionIoUring*>(user_data));
+        ASSERT(it != in_flight_.end());
+        completed.emplace_back(std::move(it->second), result);
+        in_flight_.erase(it);
+      }
+    }
+    results.clear();
+    // Callbacks are called without holding the lock, as they may submit further actions.
+    for (auto& [action, result] : completed) {
+      if (!action->onCompletion(result)) {
+        absl::MutexLock lock(&mutex_);
+        submitLocked(std::move(action));
+      }
+    }
+    completed.clear();
+    absl::MutexLock lock(&mutex_);
+    if (terminate_) {
+      pending_.clear();
+      if (in_flight_.empty()) {
+        return;
+      }
+      continue;
+    }
+    while (!pending_.empty() && in_flight_.size() < queue_depth_) {
+      std::shared_ptr<AsyncFileActionIoUring> action = std::move(pending_.front());
+      pending_.pop_front();
+      if (!submitLocked(std::move(action))) {
+        break;
+      }
+    }
+    // Also submits the requests left in the submission queue while the kernel was busy.
+    ring_->submit();
+  }
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
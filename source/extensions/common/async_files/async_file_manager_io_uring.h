@@ -0,0 +1,84 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/common/io/io_uring.h"
+#include "source/extensions/common/async_files/async_file_action.h"
+#include "source/extensions/common/async_files/async_file_manager_thread_pool.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+// An action whose I/O is performed by the kernel through the manager's io_uring, rather than
+// executed in a thread. Cancellation behaves as for other actions: a cancelled action's callback
+// isn't called, but the action is kept alive until the kernel is done with its buffers.
+class AsyncFileActionIoUring : public AsyncFileAction {
+public:
+  // AsyncFileAction. Never called, the manager submits the action's I/O instead.
+  void execute() final;
+
+  // Marks the action as executing. Returns false if it was cancelled before its I/O was submitted.
+  bool start();
+
+  // Prepares the submission of the action's I/O, with this as the user data.
+  virtual Io::IoUringResult prepare(Io::IoUring& ring) PURE;
+
+  // Called from the completion thread with the result of the I/O. Returns false if the rest of the
+  // I/O must be submitted again, e.g. after a short write.
+  virtual bool onCompletion(int32_t result) PURE;
+};
+
+// An AsyncFileManager which performs reads and writes through an io_uring. Requests are submitted
+// from the calling thread without blocking, and a single thread reaps the completions and calls
+// the callbacks. Operations the ring doesn't support, such as opening, linking and deleting
+// files, are performed in the thread pool of the base class.
+class AsyncFileManagerIoUring : public AsyncFileManagerThreadPool {
+public:
+  AsyncFileManagerIoUring(
+      const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+      Api::OsSysCalls& posix);
+  ~AsyncFileManagerIoUring() ABSL_LOCKS_EXCLUDED(mutex_) override;
+
+  std::string describe() const override;
+  AsyncFileHandle newFileContext(int fd) override;
+
+  // Submits the I/O of action, or queues it until fewer than queue_depth actions are in flight.
+  void submit(std::shared_ptr<AsyncFileActionIoUring> action) ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  // Returns false if the submission queue is full, in which case action is queued in pending_.
+  bool submitLocked(std::shared_ptr<AsyncFileActionIoUring> action)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void completionThread() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  const uint32_t queue_depth_;
+  std::unique_ptr<Io::IoUring> ring_;
+  os_fd_t event_fd_;
+
+  // Guards the submission queue of ring_. Its completion queue is only used by the completion
+  // thread, which the kernel allows concurrently with submissions.
+  absl::Mutex mutex_;
+  // The actions whose I/O the kernel may be performing, kept alive until their completion.
+  absl::flat_hash_map<AsyncFileActionIoUring*, std::shared_ptr<AsyncFileActionIoUring>>
+      in_flight_ ABSL_GUARDED_BY(mutex_);
+  std::deque<std::shared_ptr<AsyncFileActionIoUring>> pending_ ABSL_GUARDED_BY(mutex_);
+  bool terminate_ ABSL_GUARDED_BY(mutex_) = false;
+
+  std::thread completion_thread_;
+};
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
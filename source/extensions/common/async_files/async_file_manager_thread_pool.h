@@ -43,6 +43,9 @@ public:
   std::string describe() const override;
   Api::OsSysCalls& posix() const { return posix_; }
 
+  // Returns a handle to the file context for an opened file descriptor.
+  virtual AsyncFileHandle newFileContext(int fd);
+
 #ifdef O_TMPFILE
   // The first time we try to open an anonymous file, these values are used to capture whether
   // opening with O_TMPFILE works. If it does not, the first open is retried using 'mkstemp',
@@ -55,6 +58,10 @@ public:
   bool supports_o_tmpfile_;
 #endif // O_TMPFILE
 
+protected:
+  AsyncFileManagerThreadPool(absl::string_view id, unsigned int thread_pool_size,
+                             Api::OsSysCalls& posix);
+
 private:
   std::function<void()> enqueue(std::shared_ptr<AsyncFileAction> action)
       ABSL_LOCKS_EXCLUDED(queue_mutex_) override;
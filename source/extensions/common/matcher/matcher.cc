@@ -171,23 +171,48 @@ void HttpGenericBodyMatcher::onBody(const Buffer::Instance& data, MatchStatusVec
 
   // Iterate through all patterns to be found and check if they are located across body
   // chunks: part of the pattern was in previous body chunk and remaining of the pattern
-  // is in the current body chunk on in the current body chunk.
+  // is in the current body chunk.
   bool resize_required = false;
-  auto body_search_limit = limit_ - ctx->processed_bytes_;
-  auto it = ctx->patterns_index_.begin();
-  while (it != ctx->patterns_index_.end()) {
-    const auto& pattern = patterns_->at(*it);
-    if ((!ctx->overlap_.empty() && (locatePatternAcrossChunks(pattern, data, ctx))) ||
-        (-1 != data.search(static_cast<const void*>(pattern.data()), pattern.length(), 0,
-                           body_search_limit))) {
-      // Pattern found. Remove it from the list of patterns to be found.
-      // If the longest pattern has been found, resize of overlap buffer may be
-      // required.
-      resize_required = resize_required || (ctx->capacity_ == (pattern.length() - 1));
-      it = ctx->patterns_index_.erase(it);
-    } else {
-      it++;
+  if (!ctx->overlap_.empty()) {
+    auto it = ctx->patterns_index_.begin();
+    while (it != ctx->patterns_index_.end()) {
+      const auto& pattern = patterns_->at(*it);
+      if (locatePatternAcrossChunks(pattern, data, ctx)) {
+        // Pattern found. Remove it from the list of patterns to be found.
+        // If the longest pattern has been found, resize of overlap buffer may be
+        // required.
+        resize_required = resize_required || (ctx->capacity_ == (pattern.length() - 1));
+        it = ctx->patterns_index_.erase(it);
+      } else {
+        it++;
+      }
+    }
+  }
+
+  // Then search the current body chunk for all the remaining patterns in a single pass. Each
+  // pattern found is removed and the search resumes where the pattern was found, as other
+  // patterns may start at the same position.
+  std::vector<std::list<uint32_t>::iterator> remaining;
+  std::vector<absl::string_view> searched;
+  for (auto it = ctx->patterns_index_.begin(); it != ctx->patterns_index_.end(); it++) {
+    remaining.push_back(it);
+    searched.push_back(patterns_->at(*it));
+  }
+  const auto body_search_limit = limit_ - ctx->processed_bytes_;
+  size_t start = 0;
+  while (!searched.empty()) {
+    // body_search_limit equal to zero means that there is no limit.
+    const size_t length = (body_search_limit == 0) ? 0 : body_search_limit - start;
+    size_t found;
+    const ssize_t offset = data.searchAny(searched, start, length, found);
+    if (offset == -1) {
+      break;
     }
+    resize_required = resize_required || (ctx->capacity_ == (searched[found].length() - 1));
+    ctx->patterns_index_.erase(remaining[found]);
+    remaining.erase(remaining.begin() + found);
+    searched.erase(searched.begin() + found);
+    start = offset;
   }
 
   if (ctx->patterns_index_.empty()) {
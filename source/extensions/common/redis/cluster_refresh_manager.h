@@ -8,12 +8,17 @@
 
 #include "envoy/common/pure.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
 namespace Redis {
 
 using RefreshCB = std::function<void()>;
+// The slots moved to other hosts by MOVED redirections, mapped to the address of their new host.
+using MovedSlots = absl::flat_hash_map<uint16_t, std::string>;
+using SlotMovedCB = std::function<void(const MovedSlots& moved_slots)>;
 
 /**
  * A manager for tracking events that would trigger a cluster refresh, and calling registered
@@ -55,6 +60,19 @@ public:
    */
   virtual bool onHostDegraded(const std::string& cluster_name) PURE;
 
+  /**
+   * Notifies the manager that a MOVED redirection moved a slot of a given cluster to another host.
+   * The slots moved by all the threads are gathered until the cluster's slot moved callback runs
+   * on the main thread.
+   * @param cluster_name is the name of the cluster.
+   * @param slot is the slot which was moved.
+   * @param host_address is the address of the host the slot was moved to.
+   * @return bool true if the cluster's slot moved callback is scheduled on the main thread by this
+   * call, false otherwise.
+   */
+  virtual bool onSlotMoved(const std::string& cluster_name, uint16_t slot,
+                           const std::string& host_address) PURE;
+
   /**
    * Register a cluster to be tracked by the manager (called by main thread only).
    * @param cluster_name is the name of the cluster.
@@ -63,6 +81,7 @@ public:
    * @param redirects_threshold is the number of redirects that must be reached to consider
    * calling the callback.
    * @param cb is the cluster callback function.
+   * @param slot_moved_cb is the cluster callback function for the moved slots, which may be empty.
    * @return HandlePtr is a smart pointer to an opaque Handle that will unregister the cluster upon
    * destruction.
    */
@@ -70,8 +89,8 @@ public:
                                     std::chrono::milliseconds min_time_between_triggering,
                                     const uint32_t redirects_threshold,
                                     const uint32_t failure_threshold,
-                                    const uint32_t host_degraded_threshold,
-                                    const RefreshCB& cb) PURE;
+                                    const uint32_t host_degraded_threshold, const RefreshCB& cb,
+                                    const SlotMovedCB& slot_moved_cb) PURE;
 };
 
 using ClusterRefreshManagerSharedPtr = std::shared_ptr<ClusterRefreshManager>;
@@ -31,6 +31,47 @@ bool ClusterRefreshManagerImpl::onRedirection(const std::string& cluster_name) {
   return onEvent(cluster_name, EventType::Redirection);
 }
 
+bool ClusterRefreshManagerImpl::onSlotMoved(const std::string& cluster_name, uint16_t slot,
+                                            const std::string& host_address) {
+  ClusterInfoSharedPtr info;
+  {
+    Thread::LockGuard lock(map_mutex_);
+    auto it = info_map_.find(cluster_name);
+    if (it != info_map_.end()) {
+      info = it->second;
+    }
+  }
+  if (!info.get() || !info->slot_moved_cb_) {
+    return false;
+  }
+
+  {
+    // Only the first move since the callback last ran posts it, so that a burst of redirections
+    // on all the threads results in a single update.
+    Thread::LockGuard lock(info->moved_slots_mutex_);
+    const bool post_callback = info->moved_slots_.empty();
+    info->moved_slots_[slot] = host_address;
+    if (!post_callback) {
+      return false;
+    }
+  }
+
+  main_thread_dispatcher_.post([this, cluster_name, info]() {
+    MovedSlots moved_slots;
+    {
+      Thread::LockGuard lock(info->moved_slots_mutex_);
+      moved_slots.swap(info->moved_slots_);
+    }
+    // Ensure that cluster is still active before calling callback.
+    auto maps = cm_.clusters();
+    auto it = maps.active_clusters_.find(cluster_name);
+    if (it != maps.active_clusters_.end()) {
+      info->slot_moved_cb_(moved_slots);
+    }
+  });
+  return true;
+}
+
 bool ClusterRefreshManagerImpl::onEvent(const std::string& cluster_name, EventType event_type) {
   ClusterInfoSharedPtr info;
   {
@@ -149,11 +190,12 @@ bool ClusterRefreshManagerImpl::onEvent(const std::string& cluster_name, EventTy
 ClusterRefreshManagerImpl::HandlePtr ClusterRefreshManagerImpl::registerCluster(
     const std::string& cluster_name, std::chrono::milliseconds min_time_between_triggering,
     const uint32_t redirects_threshold, const uint32_t failure_threshold,
-    const uint32_t host_degraded_threshold, const RefreshCB& cb) {
+    const uint32_t host_degraded_threshold, const RefreshCB& cb,
+    const SlotMovedCB& slot_moved_cb) {
   Thread::LockGuard lock(map_mutex_);
-  ClusterInfoSharedPtr info =
-      std::make_shared<ClusterInfo>(cluster_name, min_time_between_triggering, redirects_threshold,
-                                    failure_threshold, host_degraded_threshold, cb);
+  ClusterInfoSharedPtr info = std::make_shared<ClusterInfo>(
+      cluster_name, min_time_between_triggering, redirects_threshold, failure_threshold,
+      host_degraded_threshold, cb, slot_moved_cb);
   info_map_[cluster_name] = info;
 
   return std::make_unique<ClusterRefreshManagerImpl::HandleImpl>(this, info);
@@ -0,0 +1,203 @@
+#include "source/extensions/common/tap/ring_buffer_file_sink.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Tap {
+
+namespace {
+
+constexpr uint32_t DefaultRecordsPerWorker = 256;
+constexpr uint32_t DefaultMaxRecordBytes = 4096;
+constexpr uint64_t DefaultFlushIntervalMs = 1000;
+
+uint64_t roundUpToPowerOfTwo(uint32_t value) {
+  uint64_t power = 1;
+  while (power < value) {
+    power <<= 1;
+  }
+  return power;
+}
+
+} // namespace
+
+RecordRing::RecordRing(uint32_t records, uint32_t record_bytes)
+    : mask_(roundUpToPowerOfTwo(records) - 1), record_bytes_(record_bytes),
+      slots_(new Slot[mask_ + 1]), records_(new uint8_t[(mask_ + 1) * record_bytes]) {
+  for (uint64_t i = 0; i <= mask_; i++) {
+    slots_[i].sequence_.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool RecordRing::push(uint32_t length, absl::FunctionRef<void(uint8_t*)> write) {
+  ASSERT(length <= record_bytes_);
+  uint64_t position = push_position_.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &slots_[position & mask_];
+    const uint64_t sequence = slot->sequence_.load(std::memory_order_acquire);
+    if (sequence == position) {
+      if (push_position_.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (sequence < position) {
+      // The record of the previous lap hasn't been drained.
+      return false;
+    } else {
+      // Another thread claimed the record.
+      position = push_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  write(record(position));
+  slot->length_ = length;
+  slot->sequence_.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+void RecordRing::drainTo(std::string& output) {
+  while (true) {
+    Slot& slot = slots_[drain_position_ & mask_];
+    if (slot.sequence_.load(std::memory_order_acquire) != drain_position_ + 1) {
+      // The ring is empty, or the next record is still being written.
+      return;
+    }
+    output.append(reinterpret_cast<const char*>(record(drain_position_)), slot.length_);
+    slot.sequence_.store(drain_position_ + mask_ + 1, std::memory_order_release);
+    drain_position_++;
+  }
+}
+
+RingBufferFileSink::RingBufferFileSink(const envoy::config::tap::v3::RingBufferFileSink& config,
+                                       Api::Api& api)
+    : records_per_ring_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, records_per_worker, DefaultRecordsPerWorker)),
+      max_record_bytes_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_record_bytes, DefaultMaxRecordBytes)),
+      flush_interval_(PROTOBUF_GET_MS_OR_DEFAULT(config, flush_interval, DefaultFlushIntervalMs)),
+      ring_count_(std::max(1U, std::thread::hardware_concurrency())),
+      rings_(new std::atomic<RecordRing*>[ring_count_]) {
+  for (uint32_t i = 0; i < ring_count_; i++) {
+    rings_[i].store(nullptr, std::memory_order_relaxed);
+  }
+
+  file_ = api.fileSystem().createFile(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, config.path()});
+  const Api::IoCallBoolResult open_result =
+      file_->open(Filesystem::FlagSet{1 << Filesystem::File::Operation::Write |
+                                      1 << Filesystem::File::Operation::Create |
+                                      1 << Filesystem::File::Operation::Append});
+  if (!open_result.return_value_) {
+    throw EnvoyException(fmt::format("unable to open tap file '{}': {}", config.path(),
+                                     open_result.err_->getErrorDetails()));
+  }
+
+  flush_thread_ = api.threadFactory().createThread([this]() -> void { flushThreadFunc(); },
+                                                   Thread::Options{"TapRingFlush"});
+}
+
+RingBufferFileSink::~RingBufferFileSink() {
+  {
+    Thread::LockGuard lock(flush_lock_);
+    flush_thread_exit_ = true;
+    flush_event_.notifyOne();
+  }
+  // The flush thread drains the rings a last time before exiting.
+  flush_thread_->join();
+
+  for (uint32_t i = 0; i < ring_count_; i++) {
+    delete rings_[i].load(std::memory_order_acquire);
+  }
+  const Api::IoCallBoolResult result = file_->close();
+  if (!result.return_value_) {
+    ENVOY_LOG(warn, "unable to close tap file '{}': {}", file_->path(),
+              result.err_->getErrorDetails());
+  }
+}
+
+void RingBufferFileSink::record(const envoy::data::tap::v3::TraceWrapper& trace) {
+  const uint32_t trace_size = trace.ByteSizeLong();
+  const uint32_t length = Protobuf::io::CodedOutputStream::VarintSize32(trace_size) + trace_size;
+  if (length > max_record_bytes_ ||
+      !ring().push(length, [&trace, trace_size](uint8_t* data) {
+        data = Protobuf::io::CodedOutputStream::WriteVarint32ToArray(trace_size, data);
+        trace.SerializeWithCachedSizesToArray(data);
+      })) {
+    dropped_records_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+RecordRing& RingBufferFileSink::ring() {
+  // The threads are numbered in the order they first record, so that each worker gets a ring of
+  // its own as long as there are enough rings. Threads sharing a ring are still safe.
+  static std::atomic<uint32_t> next_thread_index{0};
+  static thread_local const uint32_t thread_index =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed);
+
+  std::atomic<RecordRing*>& slot = rings_[thread_index % ring_count_];
+  RecordRing* ring = slot.load(std::memory_order_acquire);
+  if (ring == nullptr) {
+    auto new_ring = std::make_unique<RecordRing>(records_per_ring_, max_record_bytes_);
+    if (slot.compare_exchange_strong(ring, new_ring.get(), std::memory_order_acq_rel)) {
+      ring = new_ring.release();
+    }
+  }
+  return *ring;
+}
+
+void RingBufferFileSink::flushThreadFunc() {
+  while (true) {
+    bool exit;
+    {
+      Thread::LockGuard lock(flush_lock_);
+      if (!flush_thread_exit_) {
+        flush_event_.waitFor(flush_lock_, flush_interval_);
+      }
+      exit = flush_thread_exit_;
+    }
+    flush();
+    if (exit) {
+      return;
+    }
+  }
+}
+
+void RingBufferFileSink::flush() {
+  for (uint32_t i = 0; i < ring_count_; i++) {
+    if (RecordRing* ring = rings_[i].load(std::memory_order_acquire); ring != nullptr) {
+      ring->drainTo(write_buffer_);
+    }
+  }
+
+  if (!write_buffer_.empty()) {
+    const Api::IoCallSizeResult result = file_->write(write_buffer_);
+    if (!result.ok() || result.return_value_ != static_cast<ssize_t>(write_buffer_.size())) {
+      // Probably disk full.
+      ENVOY_LOG_EVERY_POW_2(warn, "unable to write tap records to '{}'", file_->path());
+    }
+    write_buffer_.clear();
+  }
+
+  const uint64_t dropped_records = droppedRecords();
+  if (dropped_records != reported_dropped_records_) {
+    ENVOY_LOG_EVERY_POW_2(warn, "dropped {} tap records that didn't fit in the ring buffers",
+                          dropped_records - reported_dropped_records_);
+    reported_dropped_records_ = dropped_records;
+  }
+}
+
+} // namespace Tap
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "envoy/api/api.h"
+#include "envoy/config/tap/v3/common.pb.h"
+#include "envoy/data/tap/v3/wrapper.pb.h"
+#include "envoy/filesystem/filesystem.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/thread.h"
+#include "source/extensions/common/tap/tap.h"
+
+#include "absl/functional/function_ref.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Tap {
+
+/**
+ * A lock free ring buffer of fixed size records, which any number of threads may push records to,
+ * and a single thread drains.
+ */
+class RecordRing {
+public:
+  /**
+   * @param records supplies the number of records, rounded up to a power of two.
+   * @param record_bytes supplies the size of the records.
+   */
+  RecordRing(uint32_t records, uint32_t record_bytes);
+
+  /**
+   * Writes a record of length bytes, unless the ring is full.
+   * @param length supplies the length of the record, which must not exceed the record size.
+   * @param write supplies the function writing the length bytes of the record.
+   * @return whether the record was written.
+   */
+  bool push(uint32_t length, absl::FunctionRef<void(uint8_t*)> write);
+
+  /**
+   * Appends the records to output in the order they were pushed, and frees them. Must not be
+   * called by several threads at once.
+   */
+  void drainTo(std::string& output);
+
+  uint64_t capacity() const { return mask_ + 1; }
+
+private:
+  struct Slot {
+    // The position of the record the slot will hold next, plus one once it has been written. See
+    // the bounded queue of Dmitry Vyukov.
+    std::atomic<uint64_t> sequence_;
+    uint32_t length_;
+  };
+
+  uint8_t* record(uint64_t position) { return records_.get() + (position & mask_) * record_bytes_; }
+
+  const uint64_t mask_;
+  const uint32_t record_bytes_;
+  const std::unique_ptr<Slot[]> slots_;
+  const std::unique_ptr<uint8_t[]> records_;
+  std::atomic<uint64_t> push_position_{0};
+  uint64_t drain_position_{0};
+};
+
+/**
+ * A tap sink that serializes the traces of all the taps into ring buffers, so that the workers
+ * don't lock or access the file system, and appends them to a single file from a background
+ * thread.
+ */
+class RingBufferFileSink : public Sink, Logger::Loggable<Logger::Id::tap> {
+public:
+  RingBufferFileSink(const envoy::config::tap::v3::RingBufferFileSink& config, Api::Api& api);
+  ~RingBufferFileSink() override;
+
+  // Sink
+  PerTapSinkHandlePtr
+  createPerTapSinkHandle(uint64_t,
+                         envoy::config::tap::v3::OutputSink::OutputSinkTypeCase) override {
+    return std::make_unique<RingBufferFileSinkHandle>(*this);
+  }
+
+  /**
+   * @return the number of traces that were dropped because they didn't fit in a record, or the
+   *         ring buffer was full.
+   */
+  uint64_t droppedRecords() const { return dropped_records_.load(std::memory_order_relaxed); }
+
+private:
+  struct RingBufferFileSinkHandle : public PerTapSinkHandle {
+    RingBufferFileSinkHandle(RingBufferFileSink& parent) : parent_(parent) {}
+
+    // PerTapSinkHandle
+    void submitTrace(TraceWrapperPtr&& trace, envoy::config::tap::v3::OutputSink::Format) override {
+      parent_.record(*trace);
+    }
+
+    RingBufferFileSink& parent_;
+  };
+
+  void record(const envoy::data::tap::v3::TraceWrapper& trace);
+  // Returns the ring of the current thread, allocating it on first use.
+  RecordRing& ring();
+  void flushThreadFunc();
+  void flush();
+
+  const uint32_t records_per_ring_;
+  const uint32_t max_record_bytes_;
+  const std::chrono::milliseconds flush_interval_;
+  const uint32_t ring_count_;
+  // Allocated by the threads on first use, since only the workers record.
+  const std::unique_ptr<std::atomic<RecordRing*>[]> rings_;
+  std::atomic<uint64_t> dropped_records_{0};
+  Filesystem::FilePtr file_;
+  // Only used by the flush thread.
+  std::string write_buffer_;
+  uint64_t reported_dropped_records_{0};
+
+  Thread::MutexBasicLockable flush_lock_;
+  Thread::CondVar flush_event_;
+  bool flush_thread_exit_ ABSL_GUARDED_BY(flush_lock_){false};
+  Thread::ThreadPtr flush_thread_;
+};
+
+} // namespace Tap
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -8,6 +8,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/common/matcher/matcher.h"
+#include "source/extensions/common/tap/ring_buffer_file_sink.h"
 
 #include "absl/container/fixed_array.h"
 
@@ -45,7 +46,7 @@ bool Utility::addBufferToProtoBytes(envoy::data::tap::v3::Body& output_body,
 }
 
 TapConfigBaseImpl::TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& proto_config,
-                                     Common::Tap::Sink* admin_streamer)
+                                     Common::Tap::Sink* admin_streamer, Api::Api& api)
     : max_buffered_rx_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
           proto_config.output_config(), max_buffered_rx_bytes, DefaultMaxBufferedBytes)),
       max_buffered_tx_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
@@ -86,6 +87,17 @@ TapConfigBaseImpl::TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& pr
     sink_ = std::make_unique<FilePerTapSink>(sinks[0].file_per_tap());
     sink_to_use_ = sink_.get();
     break;
+  case ProtoOutputSink::OutputSinkTypeCase::kRingBufferFile:
+    if (sink_format_ != ProtoOutputSink::PROTO_BINARY_LENGTH_DELIMITED) {
+      throw EnvoyException(
+          "ring buffer file output only supports the length delimited proto binary format");
+    }
+    sink_ = std::make_unique<RingBufferFileSink>(sinks[0].ring_buffer_file(), api);
+    sink_to_use_ = sink_.get();
+    if (sinks[0].ring_buffer_file().has_sample_rate()) {
+      sample_rate_ = sinks[0].ring_buffer_file().sample_rate();
+    }
+    break;
   case envoy::config::tap::v3::OutputSink::OutputSinkTypeCase::kStreamingGrpc:
     PANIC("not implemented");
   case envoy::config::tap::v3::OutputSink::OutputSinkTypeCase::OUTPUT_SINK_TYPE_NOT_SET:
@@ -113,6 +125,11 @@ const Matcher& TapConfigBaseImpl::rootMatcher() const {
   return *matchers_[0];
 }
 
+bool TapConfigBaseImpl::sampled(uint64_t trace_id) const {
+  return !sample_rate_.has_value() ||
+         ProtobufPercentHelper::evaluateFractionalPercent(*sample_rate_, trace_id);
+}
+
 namespace {
 void swapBytesToString(envoy::data::tap::v3::Body& body) {
   body.set_allocated_as_string(body.release_as_bytes());
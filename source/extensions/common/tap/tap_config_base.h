@@ -2,14 +2,18 @@
 
 #include <fstream>
 
+#include "envoy/api/api.h"
 #include "envoy/buffer/buffer.h"
 #include "envoy/config/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/wrapper.pb.h"
+#include "envoy/type/v3/percent.pb.h"
 
 #include "source/extensions/common/matcher/matcher.h"
 #include "source/extensions/common/tap/tap.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
@@ -101,9 +105,15 @@ public:
   const Matcher& rootMatcher() const override;
   bool streaming() const override { return streaming_; }
 
+  /**
+   * @return whether the stream or connection with the ID is sampled for tapping. The ones that
+   *         aren't sampled should not be matched nor traced.
+   */
+  bool sampled(uint64_t trace_id) const;
+
 protected:
   TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& proto_config,
-                    Common::Tap::Sink* admin_streamer);
+                    Common::Tap::Sink* admin_streamer, Api::Api& api);
 
 private:
   // This is the default setting for both RX/TX max buffered bytes. (This means that per tap, the
@@ -118,6 +128,7 @@ private:
   envoy::config::tap::v3::OutputSink::Format sink_format_;
   envoy::config::tap::v3::OutputSink::OutputSinkTypeCase sink_type_;
   std::vector<MatcherPtr> matchers_;
+  absl::optional<envoy::type::v3::FractionalPercent> sample_rate_;
 };
 
 /**
@@ -715,7 +715,7 @@ WasmResult Context::addHeaderMapValue(WasmHeaderMapType type, std::string_view k
     return WasmResult::BadArgument;
   }
   const Http::LowerCaseString lower_key{std::string(key)};
-  map->addCopy(lower_key, std::string(value));
+  map->addCopy(lower_key, toAbslStringView(value));
   if (type == WasmHeaderMapType::RequestHeaders && decoder_callbacks_) {
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
   }
@@ -778,18 +778,12 @@ WasmResult Context::setHeaderMapPairs(WasmHeaderMapType type, const Pairs& pairs
   if (!map) {
     return WasmResult::BadArgument;
   }
-  std::vector<std::string> keys;
-  map->iterate([&keys](const Http::HeaderEntry& header) -> Http::HeaderMap::Iterate {
-    keys.push_back(std::string(header.key().getStringView()));
-    return Http::HeaderMap::Iterate::Continue;
-  });
-  for (auto& k : keys) {
-    const Http::LowerCaseString lower_key{k};
-    map->remove(lower_key);
-  }
+  // Clearing the map at once, rather than removing the headers one key at a time, avoids a scan of
+  // the map per key.
+  map->clear();
   for (auto& p : pairs) {
     const Http::LowerCaseString lower_key{std::string(p.first)};
-    map->addCopy(lower_key, std::string(p.second));
+    map->addCopy(lower_key, toAbslStringView(p.second));
   }
   if (type == WasmHeaderMapType::RequestHeaders && decoder_callbacks_) {
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
@@ -1219,8 +1213,7 @@ WasmResult Context::defineMetric(uint32_t metric_type, std::string_view name,
   }
   auto type = static_cast<MetricType>(metric_type);
   // TODO: Consider rethinking the scoping policy as it does not help in this case.
-  Stats::StatNameManagedStorage storage(toAbslStringView(name), wasm()->scope_->symbolTable());
-  Stats::StatName stat_name = storage.statName();
+  Stats::StatName stat_name = wasm()->stat_name_cache_.get(toAbslStringView(name));
   // We prefix the given name with custom_stat_name_ so that these user-defined
   // custom metrics can be distinguished from native Envoy metrics.
   if (type == MetricType::Counter) {
@@ -102,6 +102,9 @@ protected:
   Api::Api& api_;
   Stats::StatNamePool stat_name_pool_;
   const Stats::StatName custom_stat_namespace_;
+  // Each Wasm is only used by the thread running its VM, so lookups of the names of the metrics
+  // defined by the plugin don't contend on the symbol table lock.
+  Stats::StatNameEncodingCache stat_name_cache_;
   Upstream::ClusterManager& cluster_manager_;
   Event::Dispatcher& dispatcher_;
   Event::PostCb server_shutdown_post_cb_;
@@ -1,5 +1,6 @@
 #include "source/extensions/compression/brotli/decompressor/brotli_decompressor_impl.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "source/common/runtime/runtime_features.h"
@@ -59,6 +60,61 @@ void BrotliDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
   ctx.finalizeOutput(output_buffer);
 }
 
+bool BrotliDecompressorImpl::decompressBounded(Buffer::Instance& input_buffer,
+                                               Buffer::Instance& output_buffer,
+                                               uint64_t output_limit) {
+  ASSERT(output_limit > 0);
+  Buffer::RawSliceVector input_slices = input_buffer.getRawSlices();
+  if (input_slices.empty()) {
+    // Output left by the previous call is still unfolded without any input.
+    input_slices.push_back({nullptr, 0});
+  }
+
+  uint64_t output_length = 0;
+  uint64_t consumed = 0;
+  for (const Buffer::RawSlice& input_slice : input_slices) {
+    size_t avail_in = input_slice.len_;
+    const uint8_t* next_in = static_cast<const uint8_t*>(input_slice.mem_);
+    bool more_output = true;
+    while (more_output && output_length < output_limit) {
+      // Decompress straight into the output buffer rather than through a BrotliContext chunk.
+      Buffer::ReservationSingleSlice reservation = output_buffer.reserveSingleSlice(
+          std::min<uint64_t>(chunk_size_, output_limit - output_length));
+      size_t avail_out = reservation.slice().len_;
+      uint8_t* next_out = static_cast<uint8_t*>(reservation.slice().mem_);
+      while (avail_out > 0 && more_output) {
+        const BrotliDecoderResult result = BrotliDecoderDecompressStream(
+            state_.get(), &avail_in, &next_in, &avail_out, &next_out, nullptr);
+        if (result == BROTLI_DECODER_RESULT_ERROR) {
+          stats_.brotli_error_.inc();
+        }
+        more_output = result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT;
+      }
+      const uint64_t n_output = reservation.slice().len_ - avail_out;
+      reservation.commit(n_output);
+      output_length += n_output;
+    }
+    // Input left after the end of the stream or an error is dropped, as decompress() does.
+    if (output_length == output_limit) {
+      consumed += input_slice.len_ - avail_in;
+      break;
+    }
+    consumed += input_slice.len_;
+  }
+  input_buffer.drain(consumed);
+  total_in_ += consumed;
+  total_out_ += output_length;
+
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.enable_compression_bomb_protection") &&
+      (total_out_ > MaxInflateRatio * total_in_)) {
+    stats_.brotli_error_.inc();
+    input_buffer.drain(input_buffer.length());
+    return false;
+  }
+  return output_length == output_limit;
+}
+
 bool BrotliDecompressorImpl::process(Common::BrotliContext& ctx, Buffer::Instance& output_buffer) {
   BrotliDecoderResult result;
   result = BrotliDecoderDecompressStream(state_.get(), &ctx.avail_in_, &ctx.next_in_,
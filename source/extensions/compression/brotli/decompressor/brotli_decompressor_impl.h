@@ -43,6 +43,8 @@ public:
 
   // Envoy::Compression::Decompressor::Decompressor
   void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
+  bool decompressBounded(Buffer::Instance& input_buffer, Buffer::Instance& output_buffer,
+                         uint64_t output_limit) override;
 
 private:
   static BrotliDecompressorStats generateStats(const std::string& prefix, Stats::Scope& scope) {
@@ -55,6 +57,9 @@ private:
   const uint32_t chunk_size_;
   std::unique_ptr<BrotliDecoderState, decltype(&BrotliDecoderDestroyInstance)> state_;
   const BrotliDecompressorStats stats_;
+  // Bytes consumed and output by decompressBounded(), to detect compression bombs across calls.
+  uint64_t total_in_{};
+  uint64_t total_out_{};
 };
 
 } // namespace Decompressor
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/thread_local/thread_local.h"
+#include "envoy/thread_local/thread_local_object.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+
+/**
+ * A pool of idle compression contexts, so that a compressor can reuse the context and the memory
+ * allocated by the compressor before it instead of allocating its own. A pool is used by a single
+ * thread: contexts must be released on the thread that got them.
+ */
+template <class Context>
+class ContextPool : public std::enable_shared_from_this<ContextPool<Context>> {
+public:
+  // Releasing the context returns it to the pool it came from, if that pool still exists.
+  using ContextPtr = std::unique_ptr<Context, std::function<void(Context*)>>;
+  using CreateCb = std::function<Context*()>;
+  using FreeCb = std::function<void(Context*)>;
+  // Prepares a released context for its next user, returning false if it can't be reused.
+  using ResetCb = std::function<bool(Context*)>;
+
+  /**
+   * @param max_idle the maximum number of idle contexts kept by the pool. Contexts released while
+   * the pool is full are freed.
+   * @param free_context frees a context.
+   * @param reset_context resets a context before it is returned to the pool.
+   */
+  ContextPool(uint32_t max_idle, FreeCb free_context, ResetCb reset_context)
+      : max_idle_(max_idle), free_context_(std::move(free_context)),
+        reset_context_(std::move(reset_context)) {}
+
+  ~ContextPool() {
+    for (Context* context : idle_) {
+      free_context_(context);
+    }
+  }
+
+  /**
+   * @param create_context creates a context when there is no idle one.
+   * @return ContextPtr an idle context, or else a new one.
+   */
+  ContextPtr get(const CreateCb& create_context) {
+    Context* context;
+    if (idle_.empty()) {
+      context = create_context();
+    } else {
+      context = idle_.back();
+      idle_.pop_back();
+    }
+    return ContextPtr(context,
+                      [weak_pool = this->weak_from_this(), free_context = free_context_](
+                          Context* released) {
+                        if (auto pool = weak_pool.lock(); pool != nullptr) {
+                          pool->release(released);
+                        } else {
+                          free_context(released);
+                        }
+                      });
+  }
+
+  size_t idleCount() const { return idle_.size(); }
+
+private:
+  void release(Context* context) {
+    if (idle_.size() < max_idle_ && reset_context_(context)) {
+      idle_.push_back(context);
+    } else {
+      free_context_(context);
+    }
+  }
+
+  const uint32_t max_idle_;
+  const FreeCb free_context_;
+  const ResetCb reset_context_;
+  std::vector<Context*> idle_;
+};
+
+/**
+ * A ContextPool per worker thread, so that the compressors of a worker share contexts without
+ * locking.
+ */
+template <class Context> class ThreadLocalContextPool {
+public:
+  using Pool = ContextPool<Context>;
+
+  ThreadLocalContextPool(ThreadLocal::SlotAllocator& tls, uint32_t max_idle,
+                         typename Pool::FreeCb free_context, typename Pool::ResetCb reset_context)
+      : slot_(tls) {
+    slot_.set([max_idle, free_context, reset_context](Event::Dispatcher&) {
+      return std::make_shared<ThreadLocalPool>(max_idle, free_context, reset_context);
+    });
+  }
+
+  /**
+   * @return ContextPtr an idle context of the current thread, or else a new one made by
+   * create_context. @see ContextPool::get.
+   */
+  typename Pool::ContextPtr get(const typename Pool::CreateCb& create_context) {
+    return slot_->pool_->get(create_context);
+  }
+
+  size_t idleCount() { return slot_->pool_->idleCount(); }
+
+private:
+  struct ThreadLocalPool : public ThreadLocal::ThreadLocalObject {
+    ThreadLocalPool(uint32_t max_idle, typename Pool::FreeCb free_context,
+                    typename Pool::ResetCb reset_context)
+        : pool_(std::make_shared<Pool>(max_idle, std::move(free_context),
+                                       std::move(reset_context))) {}
+
+    // The contexts handed out only hold a weak reference to the pool, so that the ones released
+    // after the slot is gone are freed.
+    const std::shared_ptr<Pool> pool_;
+  };
+
+  ThreadLocal::TypedSlot<ThreadLocalPool> slot_;
+};
+
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
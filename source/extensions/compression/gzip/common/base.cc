@@ -10,6 +10,10 @@ Base::Base(uint64_t chunk_size, std::function<void(z_stream*)> zstream_deleter)
     : chunk_size_{chunk_size}, chunk_char_ptr_(new unsigned char[chunk_size]),
       zstream_ptr_(new z_stream(), zstream_deleter) {}
 
+Base::Base(uint64_t chunk_size, ZStreamPtr&& zstream)
+    : chunk_size_{chunk_size}, chunk_char_ptr_(new unsigned char[chunk_size]),
+      zstream_ptr_(std::move(zstream)) {}
+
 uint64_t Base::checksum() { return zstream_ptr_->adler; }
 
 void Base::updateOutput(Buffer::Instance& output_buffer) {
@@ -1,5 +1,7 @@
 #include "source/extensions/compression/gzip/compressor/config.h"
 
+#include "source/common/common/assert.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -15,6 +17,23 @@ GzipCompressorFactory::GzipCompressorFactory(
                    GzipHeaderValue),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)) {}
 
+GzipCompressorFactory::GzipCompressorFactory(
+    const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip,
+    ThreadLocal::SlotAllocator& tls)
+    : GzipCompressorFactory(gzip) {
+  if (gzip.max_pooled_contexts() > 0) {
+    zstream_pool_ =
+        std::make_unique<Compression::Common::Compressor::ThreadLocalContextPool<z_stream>>(
+            tls, gzip.max_pooled_contexts(),
+            [](z_stream* z) {
+              deflateEnd(z);
+              delete z;
+            },
+            // Resetting keeps the parameters and the memory of the stream.
+            [](z_stream* z) { return deflateReset(z) == Z_OK; });
+  }
+}
+
 ZlibCompressorImpl::CompressionLevel GzipCompressorFactory::compressionLevelEnum(
     envoy::extensions::compression::gzip::compressor::v3::Gzip::CompressionLevel
         compression_level) {
@@ -59,7 +78,20 @@ ZlibCompressorImpl::CompressionStrategy GzipCompressorFactory::compressionStrate
   }
 }
 
+z_stream* GzipCompressorFactory::createDeflateStream() const {
+  auto zstream = std::make_unique<z_stream>();
+  const int result = deflateInit2(zstream.get(), static_cast<int64_t>(compression_level_),
+                                  Z_DEFLATED, window_bits_, memory_level_,
+                                  static_cast<uint64_t>(compression_strategy_));
+  RELEASE_ASSERT(result >= 0, "");
+  return zstream.release();
+}
+
 Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompressor() {
+  if (zstream_pool_ != nullptr) {
+    return std::make_unique<ZlibCompressorImpl>(
+        chunk_size_, zstream_pool_->get([this]() { return createDeflateStream(); }));
+  }
   auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
   compressor->init(compression_level_, compression_strategy_, window_bits_, memory_level_);
   return compressor;
@@ -68,8 +100,8 @@ Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompr
 Envoy::Compression::Compressor::CompressorFactoryPtr
 GzipCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::compressor::v3::Gzip& proto_config,
-    Server::Configuration::FactoryContext&) {
-  return std::make_unique<GzipCompressorFactory>(proto_config);
+    Server::Configuration::FactoryContext& context) {
+  return std::make_unique<GzipCompressorFactory>(proto_config, context.threadLocal());
 }
 
 /**
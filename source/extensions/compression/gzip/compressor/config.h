@@ -5,6 +5,7 @@
 #include "envoy/extensions/compression/gzip/compressor/v3/gzip.pb.validate.h"
 
 #include "source/common/http/headers.h"
+#include "source/extensions/compression/common/compressor/context_pool.h"
 #include "source/extensions/compression/common/compressor/factory_base.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
@@ -39,6 +40,9 @@ const std::string& gzipExtensionName() {
 class GzipCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
   GzipCompressorFactory(const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip);
+  // Pools the zlib streams of each worker in tls if the config enables pooling.
+  GzipCompressorFactory(const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip,
+                        ThreadLocal::SlotAllocator& tls);
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
@@ -54,12 +58,15 @@ private:
   static ZlibCompressorImpl::CompressionStrategy compressionStrategyEnum(
       envoy::extensions::compression::gzip::compressor::v3::Gzip::CompressionStrategy
           compression_strategy);
+  // Returns a stream initialized for compression with the parameters of this factory.
+  z_stream* createDeflateStream() const;
 
   ZlibCompressorImpl::CompressionLevel compression_level_;
   ZlibCompressorImpl::CompressionStrategy compression_strategy_;
   const int32_t memory_level_;
   const int32_t window_bits_;
   const uint32_t chunk_size_;
+  std::unique_ptr<Compression::Common::Compressor::ThreadLocalContextPool<z_stream>> zstream_pool_;
 };
 
 class GzipCompressorLibraryFactory
@@ -29,6 +29,14 @@ public:
    */
   ZlibCompressorImpl(uint64_t chunk_size);
 
+  /**
+   * Constructor taking a zlib stream already initialized for compression by deflateInit2(), e.g.
+   * one reused from a pool of streams, in which case init() must not be called.
+   * @param chunk_size amount of memory reserved for the compressor output.
+   * @param zstream the initialized stream, released along with the compressor.
+   */
+  ZlibCompressorImpl(uint64_t chunk_size, Common::ZStreamPtr&& zstream);
+
   /**
    * Enum values used to set compression level during initialization.
    * best: gives best compression.
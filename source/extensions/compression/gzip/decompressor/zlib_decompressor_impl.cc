@@ -2,6 +2,7 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "envoy/common/exception.h"
@@ -69,6 +70,60 @@ void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
   updateOutput(output_buffer);
 }
 
+bool ZlibDecompressorImpl::decompressBounded(Buffer::Instance& input_buffer,
+                                             Buffer::Instance& output_buffer,
+                                             uint64_t output_limit) {
+  ASSERT(output_limit > 0);
+  Buffer::RawSliceVector input_slices = input_buffer.getRawSlices();
+  if (input_slices.empty()) {
+    // Output left by the previous call is still inflated without any input.
+    input_slices.push_back({nullptr, 0});
+  }
+
+  uint64_t output_length = 0;
+  uint64_t consumed = 0;
+  for (const Buffer::RawSlice& input_slice : input_slices) {
+    zstream_ptr_->avail_in = input_slice.len_;
+    zstream_ptr_->next_in = static_cast<Bytef*>(input_slice.mem_);
+    bool more_output = true;
+    while (more_output && output_length < output_limit) {
+      // Inflate straight into the output buffer rather than through chunk_char_ptr_.
+      Buffer::ReservationSingleSlice reservation =
+          output_buffer.reserveSingleSlice(std::min(chunk_size_, output_limit - output_length));
+      zstream_ptr_->avail_out = reservation.slice().len_;
+      zstream_ptr_->next_out = static_cast<Bytef*>(reservation.slice().mem_);
+      while (zstream_ptr_->avail_out > 0 && (more_output = inflateNext())) {
+      }
+      const uint64_t n_output = reservation.slice().len_ - zstream_ptr_->avail_out;
+      reservation.commit(n_output);
+      output_length += n_output;
+    }
+    // Input left after the end of the stream or an error is dropped, as decompress() does.
+    if (output_length == output_limit) {
+      consumed += input_slice.len_ - zstream_ptr_->avail_in;
+      break;
+    }
+    consumed += input_slice.len_;
+  }
+  // Leave the stream pointing at the chunk used by decompress().
+  zstream_ptr_->avail_out = chunk_size_;
+  zstream_ptr_->next_out = chunk_char_ptr_.get();
+  input_buffer.drain(consumed);
+
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.enable_compression_bomb_protection") &&
+      (zstream_ptr_->total_out > max_inflate_ratio_ * zstream_ptr_->total_in)) {
+    stats_.zlib_data_error_.inc();
+    ENVOY_LOG(trace,
+              "excessive decompression ratio detected: output "
+              "size {} for input size {}",
+              zstream_ptr_->total_out, zstream_ptr_->total_in);
+    input_buffer.drain(input_buffer.length());
+    return false;
+  }
+  return output_length == output_limit;
+}
+
 bool ZlibDecompressorImpl::inflateNext() {
   const int result = inflate(zstream_ptr_.get(), Z_NO_FLUSH);
   if (result == Z_STREAM_END) {
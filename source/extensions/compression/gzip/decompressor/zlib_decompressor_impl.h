@@ -61,6 +61,8 @@ public:
 
   // Compression::Decompressor::Decompressor
   void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
+  bool decompressBounded(Buffer::Instance& input_buffer, Buffer::Instance& output_buffer,
+                         uint64_t output_limit) override;
 
   // Flag to track whether error occurred during decompression.
   // When an error occurs, the error code (a negative int) will be stored in this variable.
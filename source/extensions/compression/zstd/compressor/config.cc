@@ -22,9 +22,24 @@ ZstdCompressorFactory::ZstdCompressorFactory(
           return ZSTD_createCDict(dict_buffer, dict_size, compression_level_);
         });
   }
+  if (zstd.max_pooled_contexts() > 0) {
+    cctx_pool_ =
+        std::make_unique<Compression::Common::Compressor::ThreadLocalContextPool<ZSTD_CCtx>>(
+            tls, zstd.max_pooled_contexts(), [](ZSTD_CCtx* cctx) { ZSTD_freeCCtx(cctx); },
+            // Drops the dictionary reference, which may not outlive a dictionary update, while
+            // keeping the memory of the context.
+            [](ZSTD_CCtx* cctx) {
+              return !ZSTD_isError(ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters));
+            });
+  }
 }
 
 Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompressor() {
+  if (cctx_pool_ != nullptr) {
+    return std::make_unique<ZstdCompressorImpl>(
+        compression_level_, enable_checksum_, strategy_, cdict_manager_, chunk_size_,
+        cctx_pool_->get([]() { return ZSTD_createCCtx(); }));
+  }
   return std::make_unique<ZstdCompressorImpl>(compression_level_, enable_checksum_, strategy_,
                                               cdict_manager_, chunk_size_);
 }
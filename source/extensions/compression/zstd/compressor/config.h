@@ -5,6 +5,7 @@
 #include "envoy/extensions/compression/zstd/compressor/v3/zstd.pb.validate.h"
 
 #include "source/common/http/headers.h"
+#include "source/extensions/compression/common/compressor/context_pool.h"
 #include "source/extensions/compression/common/compressor/factory_base.h"
 #include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
 
@@ -42,6 +43,7 @@ private:
   const uint32_t strategy_;
   const uint32_t chunk_size_;
   ZstdCDictManagerPtr cdict_manager_{nullptr};
+  std::unique_ptr<Compression::Common::Compressor::ThreadLocalContextPool<ZSTD_CCtx>> cctx_pool_;
 };
 
 class ZstdCompressorLibraryFactory
@@ -11,8 +11,14 @@ namespace Compressor {
 ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum,
                                        uint32_t strategy, const ZstdCDictManagerPtr& cdict_manager,
                                        uint32_t chunk_size)
-    : Common::Base(chunk_size), cctx_(ZSTD_createCCtx(), &ZSTD_freeCCtx),
-      cdict_manager_(cdict_manager), compression_level_(compression_level) {
+    : ZstdCompressorImpl(compression_level, enable_checksum, strategy, cdict_manager, chunk_size,
+                         ZstdCCtxPtr(ZSTD_createCCtx(), &ZSTD_freeCCtx)) {}
+
+ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum,
+                                       uint32_t strategy, const ZstdCDictManagerPtr& cdict_manager,
+                                       uint32_t chunk_size, ZstdCCtxPtr&& cctx)
+    : Common::Base(chunk_size), cctx_(std::move(cctx)), cdict_manager_(cdict_manager),
+      compression_level_(compression_level) {
   size_t result;
   result = ZSTD_CCtx_setParameter(cctx_.get(), ZSTD_c_checksumFlag, enable_checksum);
   RELEASE_ASSERT(!ZSTD_isError(result), "");
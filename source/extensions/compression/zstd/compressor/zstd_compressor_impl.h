@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "envoy/compression/compressor/compressor.h"
 
 #include "source/extensions/compression/zstd/common/base.h"
@@ -14,6 +17,7 @@ namespace Compressor {
 using ZstdCDictManager =
     Common::DictionaryManager<ZSTD_CDict, ZSTD_freeCDict, ZSTD_getDictID_fromCDict>;
 using ZstdCDictManagerPtr = std::unique_ptr<ZstdCDictManager>;
+using ZstdCCtxPtr = std::unique_ptr<ZSTD_CCtx, std::function<void(ZSTD_CCtx*)>>;
 
 /**
  * Implementation of compressor's interface.
@@ -25,13 +29,21 @@ public:
   ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum, uint32_t strategy,
                      const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size);
 
+  /**
+   * Constructor taking the compression context to use, e.g. one reused from a pool of contexts
+   * once reset with ZSTD_reset_session_and_parameters.
+   */
+  ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum, uint32_t strategy,
+                     const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size,
+                     ZstdCCtxPtr&& cctx);
+
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
 
 private:
   void process(Buffer::Instance& output_buffer, ZSTD_EndDirective mode);
 
-  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx_;
+  ZstdCCtxPtr cctx_;
   const ZstdCDictManagerPtr& cdict_manager_;
   const uint32_t compression_level_;
 };
@@ -1,5 +1,7 @@
 #include "source/extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
 
+#include <algorithm>
+
 #include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
@@ -22,7 +24,8 @@ ZstdDecompressorImpl::ZstdDecompressorImpl(Stats::Scope& scope, const std::strin
                                            const ZstdDDictManagerPtr& ddict_manager,
                                            uint32_t chunk_size)
     : Common::Base(chunk_size), dctx_(ZSTD_createDCtx(), &ZSTD_freeDCtx),
-      ddict_manager_(ddict_manager), stats_(generateStats(stats_prefix, scope)) {}
+      ddict_manager_(ddict_manager), stats_(generateStats(stats_prefix, scope)),
+      chunk_size_(chunk_size) {}
 
 void ZstdDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
                                       Buffer::Instance& output_buffer) {
@@ -30,22 +33,8 @@ void ZstdDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
 
   for (const Buffer::RawSlice& input_slice : input_buffer.getRawSlices()) {
     if (input_slice.len_ > 0) {
-      if (ddict_manager_ && !is_dictionary_set_) {
-        is_dictionary_set_ = true;
-        // If id == 0, it means that dictionary id could not be decoded.
-        dictionary_id_ =
-            ZSTD_getDictID_fromFrame(static_cast<uint8_t*>(input_slice.mem_), input_slice.len_);
-        if (dictionary_id_ != 0) {
-          auto dictionary = ddict_manager_->getDictionaryById(dictionary_id_);
-          if (!dictionary) {
-            stats_.zstd_dictionary_error_.inc();
-            return;
-          }
-          const size_t result = ZSTD_DCtx_refDDict(dctx_.get(), dictionary);
-          if (isError(result)) {
-            return;
-          }
-        }
+      if (!maybeSetDictionary(input_slice)) {
+        return;
       }
 
       setInput(input_slice);
@@ -66,6 +55,101 @@ void ZstdDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
   }
 }
 
+bool ZstdDecompressorImpl::decompressBounded(Buffer::Instance& input_buffer,
+                                             Buffer::Instance& output_buffer,
+                                             uint64_t output_limit) {
+  ASSERT(output_limit > 0);
+  Buffer::RawSliceVector input_slices = input_buffer.getRawSlices();
+  if (input_slices.empty()) {
+    // Output left by the previous call is still flushed without any input.
+    input_slices.push_back({nullptr, 0});
+  }
+
+  uint64_t output_length = 0;
+  uint64_t consumed = 0;
+  bool failed = false;
+  for (const Buffer::RawSlice& input_slice : input_slices) {
+    if (input_slice.len_ > 0 && !maybeSetDictionary(input_slice)) {
+      failed = true;
+      break;
+    }
+    setInput(input_slice);
+    bool more_output = true;
+    while (more_output && output_length < output_limit) {
+      // Decompress straight into the output buffer rather than through chunk_ptr_.
+      Buffer::ReservationSingleSlice reservation = output_buffer.reserveSingleSlice(
+          std::min<uint64_t>(chunk_size_, output_limit - output_length));
+      ZSTD_outBuffer output{reservation.slice().mem_, reservation.slice().len_, 0};
+      while (output.pos < output.size) {
+        const size_t result = ZSTD_decompressStream(dctx_.get(), &output, &input_);
+        if (isError(result)) {
+          failed = true;
+          break;
+        }
+        // The decoder has flushed all it could once it leaves room in the output.
+        if (output.pos < output.size && input_.pos == input_.size) {
+          more_output = false;
+          break;
+        }
+      }
+      reservation.commit(output.pos);
+      output_length += output.pos;
+      if (failed) {
+        break;
+      }
+    }
+    if (failed) {
+      break;
+    }
+    if (output_length == output_limit) {
+      consumed += input_.pos;
+      break;
+    }
+    consumed += input_slice.len_;
+  }
+  if (failed) {
+    // Nothing more can be decompressed, as decompress() stops at the first error.
+    consumed = input_buffer.length();
+  }
+  input_buffer.drain(consumed);
+  total_in_ += consumed;
+  total_out_ += output_length;
+
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.enable_compression_bomb_protection") &&
+      (total_out_ > MaxInflateRatio * total_in_)) {
+    stats_.zstd_generic_error_.inc();
+    ENVOY_LOG(trace,
+              "excessive decompression ratio detected: output "
+              "size {} for input size {}",
+              total_out_, total_in_);
+    input_buffer.drain(input_buffer.length());
+    return false;
+  }
+  return !failed && output_length == output_limit;
+}
+
+bool ZstdDecompressorImpl::maybeSetDictionary(const Buffer::RawSlice& input_slice) {
+  if (ddict_manager_ && !is_dictionary_set_) {
+    is_dictionary_set_ = true;
+    // If id == 0, it means that dictionary id could not be decoded.
+    dictionary_id_ =
+        ZSTD_getDictID_fromFrame(static_cast<uint8_t*>(input_slice.mem_), input_slice.len_);
+    if (dictionary_id_ != 0) {
+      auto dictionary = ddict_manager_->getDictionaryById(dictionary_id_);
+      if (!dictionary) {
+        stats_.zstd_dictionary_error_.inc();
+        return false;
+      }
+      const size_t result = ZSTD_DCtx_refDDict(dctx_.get(), dictionary);
+      if (isError(result)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool ZstdDecompressorImpl::process(Buffer::Instance& output_buffer) {
   while (input_.pos < input_.size) {
     const size_t result = ZSTD_decompressStream(dctx_.get(), &output_, &input_);
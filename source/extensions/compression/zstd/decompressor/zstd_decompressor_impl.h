@@ -49,6 +49,8 @@ public:
 
   // Envoy::Compression::Decompressor::Decompressor
   void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
+  bool decompressBounded(Buffer::Instance& input_buffer, Buffer::Instance& output_buffer,
+                         uint64_t output_limit) override;
 
 private:
   static ZstdDecompressorStats generateStats(const std::string& prefix, Stats::Scope& scope) {
@@ -58,11 +60,18 @@ private:
   friend class ZstdDecompressorStatsTest;
   bool process(Buffer::Instance& output_buffer);
   bool isError(size_t result);
+  // Sets the dictionary the first frame was compressed with on the first call, and returns false
+  // if it can't be.
+  bool maybeSetDictionary(const Buffer::RawSlice& input_slice);
 
   std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx_;
   const ZstdDDictManagerPtr& ddict_manager_;
   const ZstdDecompressorStats stats_;
   bool is_dictionary_set_{false};
+  const uint32_t chunk_size_;
+  // Bytes consumed and output by decompressBounded(), to detect compression bombs across calls.
+  uint64_t total_in_{};
+  uint64_t total_out_{};
 };
 
 } // namespace Decompressor
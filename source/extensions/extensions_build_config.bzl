@@ -4,11 +4,13 @@ EXTENSIONS = {
     # Access loggers
     #
 
+    "envoy.access_loggers.aggregating":                 "//source/extensions/access_loggers/aggregating:config",
     "envoy.access_loggers.file":                        "//source/extensions/access_loggers/file:config",
     "envoy.access_loggers.extension_filters.cel":       "//source/extensions/access_loggers/filters/cel:config",
     "envoy.access_loggers.http_grpc":                   "//source/extensions/access_loggers/grpc:http_config",
     "envoy.access_loggers.tcp_grpc":                    "//source/extensions/access_loggers/grpc:tcp_config",
     "envoy.access_loggers.open_telemetry":              "//source/extensions/access_loggers/open_telemetry:config",
+    "envoy.access_loggers.proto_file":                  "//source/extensions/access_loggers/proto_file:config",
     "envoy.access_loggers.stdout":                      "//source/extensions/access_loggers/stream:config",
     "envoy.access_loggers.stderr":                      "//source/extensions/access_loggers/stream:config",
     "envoy.access_loggers.wasm":                        "//source/extensions/access_loggers/wasm:config",
@@ -200,6 +202,8 @@ EXTENSIONS = {
     "envoy.resource_monitors.fixed_heap":               "//source/extensions/resource_monitors/fixed_heap:config",
     "envoy.resource_monitors.injected_resource":        "//source/extensions/resource_monitors/injected_resource:config",
     "envoy.resource_monitors.downstream_connections":   "//source/extensions/resource_monitors/downstream_connections:config",
+    "envoy.resource_monitors.cgroup_memory":            "//source/extensions/resource_monitors/cgroup:config",
+    "envoy.resource_monitors.cgroup_cpu":               "//source/extensions/resource_monitors/cgroup:config",
 
     #
     # Stat sinks
@@ -264,6 +268,7 @@ EXTENSIONS = {
     # CacheFilter plugins
     #
     "envoy.extensions.http.cache.file_system_http_cache": "//source/extensions/http/cache/file_system_http_cache:config",
+    "envoy.extensions.http.cache.in_memory_http_cache":   "//source/extensions/http/cache/in_memory_http_cache:config",
     "envoy.extensions.http.cache.simple":               "//source/extensions/http/cache/simple_http_cache:config",
 
     #
@@ -388,6 +393,12 @@ EXTENSIONS = {
     # getaddrinfo DNS resolver extension can be used when the system resolver is desired (e.g., Android)
     "envoy.network.dns_resolver.getaddrinfo":          "//source/extensions/network/dns_resolver/getaddrinfo:config",
 
+    #
+    # Connection balancers
+    #
+
+    "envoy.network.connection_balance.load_aware":     "//source/extensions/network/connection_balance/load_aware:config",
+
     #
     # Custom matchers
     #
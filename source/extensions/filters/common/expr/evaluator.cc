@@ -2,6 +2,11 @@
 
 #include "envoy/common/exception.h"
 
+#include "source/common/common/macros.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "eval/public/builtin_func_registrar.h"
 #include "eval/public/cel_expr_builder_factory.h"
 
@@ -29,6 +34,60 @@ const ActivationLookupTable& getActivationTokens() {
 #undef _PAIR
 }
 
+// Compiles the expressions shared by the configurations. The expressions keep their compiler
+// alive, as they use the functions registered in its builder and the constants folded in its
+// arena. The compiler, and the constants folded for expressions that are gone, are freed once no
+// expression uses it.
+class ExpressionCompiler : public std::enable_shared_from_this<ExpressionCompiler> {
+public:
+  ExpressionCompiler() : builder_(createBuilder(&constant_arena_)) {}
+
+  ExpressionSharedPtr getOrCreate(const google::api::expr::v1alpha1::Expr& expr) {
+    // Expressions have no map fields, so identical expressions are serialized identically.
+    std::string key = expr.SerializeAsString();
+    absl::MutexLock lock(&mutex_);
+    if (const auto it = expressions_.find(key); it != expressions_.end()) {
+      if (ExpressionSharedPtr expression = it->second.lock(); expression != nullptr) {
+        return expression;
+      }
+    }
+
+    ExpressionSharedPtr expression(
+        createExpression(*builder_, expr).release(),
+        [compiler = shared_from_this(), key](const Expression* expression) {
+          delete expression;
+          compiler->erase(key);
+        });
+    expressions_[std::move(key)] = expression;
+    return expression;
+  }
+
+private:
+  void erase(const std::string& key) {
+    absl::MutexLock lock(&mutex_);
+    // The expression may have been compiled again since it was released.
+    if (const auto it = expressions_.find(key); it != expressions_.end() && it->second.expired()) {
+      expressions_.erase(it);
+    }
+  }
+
+  absl::Mutex mutex_;
+  // Compiling an expression allocates its folded constants in the arena.
+  Protobuf::Arena constant_arena_ ABSL_GUARDED_BY(mutex_);
+  const BuilderPtr builder_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, std::weak_ptr<const Expression>>
+      expressions_ ABSL_GUARDED_BY(mutex_);
+};
+
+struct SharedExpressionCompiler {
+  absl::Mutex mutex_;
+  std::weak_ptr<ExpressionCompiler> compiler_ ABSL_GUARDED_BY(mutex_);
+};
+
+SharedExpressionCompiler& sharedExpressionCompiler() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(SharedExpressionCompiler);
+}
+
 } // namespace
 
 absl::optional<CelValue> StreamActivation::FindValue(absl::string_view name,
@@ -120,13 +179,28 @@ ExpressionPtr createExpression(Builder& builder, const google::api::expr::v1alph
   return std::move(cel_expression_status.value());
 }
 
+ExpressionSharedPtr getOrCreateExpression(const google::api::expr::v1alpha1::Expr& expr) {
+  SharedExpressionCompiler& shared = sharedExpressionCompiler();
+  std::shared_ptr<ExpressionCompiler> compiler;
+  {
+    absl::MutexLock lock(&shared.mutex_);
+    compiler = shared.compiler_.lock();
+    if (compiler == nullptr) {
+      compiler = std::make_shared<ExpressionCompiler>();
+      shared.compiler_ = compiler;
+    }
+  }
+  return compiler->getOrCreate(expr);
+}
+
 absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena,
                                   const StreamInfo::StreamInfo& info,
                                   const Http::RequestHeaderMap* request_headers,
                                   const Http::ResponseHeaderMap* response_headers,
                                   const Http::ResponseTrailerMap* response_trailers) {
-  auto activation = createActivation(info, request_headers, response_headers, response_trailers);
-  auto eval_status = expr.Evaluate(*activation, &arena);
+  // The activation only lives for the evaluation, so it isn't allocated on the heap.
+  const StreamActivation activation(info, request_headers, response_headers, response_trailers);
+  auto eval_status = expr.Evaluate(activation, &arena);
   if (!eval_status.ok()) {
     return {};
   }
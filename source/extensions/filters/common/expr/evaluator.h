@@ -22,6 +22,7 @@ using Builder = google::api::expr::runtime::CelExpressionBuilder;
 using BuilderPtr = std::unique_ptr<Builder>;
 using Expression = google::api::expr::runtime::CelExpression;
 using ExpressionPtr = std::unique_ptr<Expression>;
+using ExpressionSharedPtr = std::shared_ptr<const Expression>;
 
 // Base class for the context used by the CEL evaluator to look up attributes.
 class StreamActivation : public google::api::expr::runtime::BaseActivation {
@@ -66,6 +67,12 @@ BuilderPtr createBuilder(Protobuf::Arena* arena);
 // Throws an exception if fails to construct a runtime expression.
 ExpressionPtr createExpression(Builder& builder, const google::api::expr::v1alpha1::Expr& expr);
 
+// Returns an interpretable expression from a protobuf representation, compiled with a builder
+// shared by the configurations and with constant folding enabled. An identical expression still in
+// use is returned instead of compiling it again.
+// Throws an exception if fails to construct a runtime expression.
+ExpressionSharedPtr getOrCreateExpression(const google::api::expr::v1alpha1::Expr& expr);
+
 // Evaluates an expression for a request. The arena is used to hold intermediate computational
 // results and potentially the final value.
 absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena,
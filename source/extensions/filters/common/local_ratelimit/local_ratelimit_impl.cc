@@ -1,6 +1,7 @@
 #include "source/extensions/filters/common/local_ratelimit/local_ratelimit_impl.h"
 
 #include <chrono>
+#include <limits>
 
 #include "envoy/runtime/runtime.h"
 
@@ -17,8 +18,10 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     const std::chrono::milliseconds fill_interval, const uint32_t max_tokens,
     const uint32_t tokens_per_fill, Event::Dispatcher& dispatcher,
     const Protobuf::RepeatedPtrField<
-        envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors)
-    : fill_timer_(fill_interval > std::chrono::milliseconds(0)
+        envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
+    const bool continuous_refill)
+    : continuous_refill_(continuous_refill),
+      fill_timer_(fill_interval > std::chrono::milliseconds(0) && !continuous_refill
                       ? dispatcher.createTimer([this] { onFillTimer(); })
                       : nullptr),
       time_source_(dispatcher.timeSource()) {
@@ -31,6 +34,7 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
   token_bucket_.fill_interval_ = absl::FromChrono(fill_interval);
   tokens_.tokens_ = max_tokens;
   tokens_.fill_time_ = time_source_.monotonicTime();
+  initializeContinuousRefill(tokens_, token_bucket_);
 
   if (fill_timer_) {
     fill_timer_->enableTimer(fill_interval);
@@ -44,14 +48,17 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     RateLimit::TokenBucket per_descriptor_token_bucket;
     per_descriptor_token_bucket.fill_interval_ =
         absl::Milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(descriptor.token_bucket(), fill_interval, 0));
-    if (per_descriptor_token_bucket.fill_interval_ % token_bucket_.fill_interval_ !=
-        absl::ZeroDuration()) {
-      throw EnvoyException(
-          "local rate descriptor limit is not a multiple of token bucket fill timer");
+    // Continuously refilled descriptors don't depend on the fill timer.
+    if (!continuous_refill_) {
+      if (per_descriptor_token_bucket.fill_interval_ % token_bucket_.fill_interval_ !=
+          absl::ZeroDuration()) {
+        throw EnvoyException(
+            "local rate descriptor limit is not a multiple of token bucket fill timer");
+      }
+      // Save the multiplicative factor to control the descriptor refill frequency.
+      new_descriptor.multiplier_ =
+          per_descriptor_token_bucket.fill_interval_ / token_bucket_.fill_interval_;
     }
-    // Save the multiplicative factor to control the descriptor refill frequency.
-    new_descriptor.multiplier_ =
-        per_descriptor_token_bucket.fill_interval_ / token_bucket_.fill_interval_;
     per_descriptor_token_bucket.max_tokens_ = descriptor.token_bucket().max_tokens();
     per_descriptor_token_bucket.tokens_per_fill_ =
         PROTOBUF_GET_WRAPPED_OR_DEFAULT(descriptor.token_bucket(), tokens_per_fill, 1);
@@ -60,6 +67,7 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     auto token_state = std::make_shared<TokenState>();
     token_state->tokens_ = per_descriptor_token_bucket.max_tokens_;
     token_state->fill_time_ = time_source_.monotonicTime();
+    initializeContinuousRefill(*token_state, per_descriptor_token_bucket);
     new_descriptor.token_state_ = token_state;
 
     auto result = descriptors_.emplace(new_descriptor);
@@ -134,7 +142,56 @@ void LocalRateLimiterImpl::onFillTimerDescriptorHelper() {
   }
 }
 
+void LocalRateLimiterImpl::initializeContinuousRefill(TokenState& tokens,
+                                                      const RateLimit::TokenBucket& bucket) {
+  // A bucket without a fill interval is never refilled, so it just counts its tokens down.
+  if (!continuous_refill_ || bucket.fill_interval_ <= absl::ZeroDuration()) {
+    return;
+  }
+  tokens.emission_interval_ns_ = std::max<int64_t>(
+      absl::ToInt64Nanoseconds(bucket.fill_interval_) / bucket.tokens_per_fill_, 1);
+  // Saturate rather than overflow for buckets with long fill intervals and many tokens.
+  const int64_t max_burst = std::numeric_limits<int64_t>::max();
+  tokens.burst_ns_ =
+      bucket.max_tokens_ > 0 && tokens.emission_interval_ns_ > max_burst / bucket.max_tokens_
+          ? max_burst
+          : tokens.emission_interval_ns_ * bucket.max_tokens_;
+}
+
+int64_t LocalRateLimiterImpl::nowNs() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time_source_.monotonicTime().time_since_epoch())
+      .count();
+}
+
+bool LocalRateLimiterImpl::continuousRefillAllowed(const TokenState& tokens) const {
+  const int64_t now = nowNs();
+  // Relaxed consistency is used for all operations because we don't care about ordering, just the
+  // final atomic correctness.
+  int64_t expected_tat = tokens.tat_ns_.load(std::memory_order_relaxed);
+  int64_t new_tat;
+  do {
+    // expected_tat is either initialized above or reloaded during the CAS failure below. A
+    // theoretical arrival time in the past means that the bucket has been refilled since.
+    new_tat = std::max(expected_tat, now) + tokens.emission_interval_ns_;
+    if (new_tat - now > tokens.burst_ns_) {
+      return false;
+    }
+
+    // Testing hook.
+    synchronizer_.syncPoint("continuous_refill_pre_cas");
+
+    // Loop while the weak CAS fails trying to push the theoretical arrival time.
+  } while (!tokens.tat_ns_.compare_exchange_weak(expected_tat, new_tat, std::memory_order_relaxed));
+
+  return true;
+}
+
 bool LocalRateLimiterImpl::requestAllowedHelper(const TokenState& tokens) const {
+  if (tokens.emission_interval_ns_ > 0) {
+    return continuousRefillAllowed(tokens);
+  }
+
   // Relaxed consistency is used for all operations because we don't care about ordering, just the
   // final atomic correctness.
   uint32_t expected_tokens = tokens.tokens_.load(std::memory_order_relaxed);
@@ -211,9 +268,23 @@ uint32_t LocalRateLimiterImpl::remainingTokens(
     absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const {
   auto descriptor = descriptorHelper(request_descriptors);
 
-  return descriptor.has_value()
-             ? descriptor.value().get().token_state_->tokens_.load(std::memory_order_relaxed)
-             : tokens_.tokens_.load(std::memory_order_relaxed);
+  return descriptor.has_value() ? remainingTokensHelper(*descriptor.value().get().token_state_,
+                                                        descriptor.value().get().token_bucket_)
+                                : remainingTokensHelper(tokens_, token_bucket_);
+}
+
+uint32_t LocalRateLimiterImpl::remainingTokensHelper(const TokenState& tokens,
+                                                     const RateLimit::TokenBucket& bucket) const {
+  if (tokens.emission_interval_ns_ == 0) {
+    return tokens.tokens_.load(std::memory_order_relaxed);
+  }
+  // Each token consumed and not refilled yet holds the theoretical arrival time one emission
+  // interval ahead of the current time.
+  const int64_t backlog =
+      std::max<int64_t>(tokens.tat_ns_.load(std::memory_order_relaxed) - nowNs(), 0);
+  const int64_t consumed = backlog / tokens.emission_interval_ns_ +
+                           (backlog % tokens.emission_interval_ns_ != 0 ? 1 : 0);
+  return consumed >= bucket.max_tokens_ ? 0 : static_cast<uint32_t>(bucket.max_tokens_ - consumed);
 }
 
 int64_t LocalRateLimiterImpl::remainingFillInterval(
@@ -222,6 +293,11 @@ int64_t LocalRateLimiterImpl::remainingFillInterval(
 
   auto current_time = time_source_.monotonicTime();
   auto descriptor = descriptorHelper(request_descriptors);
+  const TokenState& tokens =
+      descriptor.has_value() ? *descriptor.value().get().token_state_ : tokens_;
+  if (tokens.emission_interval_ns_ > 0) {
+    return remainingFillIntervalHelper(tokens);
+  }
   // Remaining time to next fill = fill interval - (current time - last fill time).
   if (descriptor.has_value()) {
     ASSERT(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -235,6 +311,17 @@ int64_t LocalRateLimiterImpl::remainingFillInterval(
                               absl::Seconds((current_time - tokens_.fill_time_) / 1s));
 }
 
+int64_t LocalRateLimiterImpl::remainingFillIntervalHelper(const TokenState& tokens) const {
+  // The next token is refilled when the backlog drops below a multiple of the emission interval.
+  const int64_t backlog = tokens.tat_ns_.load(std::memory_order_relaxed) - nowNs();
+  if (backlog <= 0) {
+    return 0;
+  }
+  const int64_t next_refill = backlog % tokens.emission_interval_ns_;
+  return absl::ToInt64Seconds(
+      absl::Nanoseconds(next_refill == 0 ? tokens.emission_interval_ns_ : next_refill));
+}
+
 } // namespace LocalRateLimit
 } // namespace Common
 } // namespace Filters
@@ -18,11 +18,18 @@ namespace LocalRateLimit {
 
 class LocalRateLimiterImpl {
 public:
+  /**
+   * @param continuous_refill if true, the token buckets are refilled continuously instead of by a
+   * fill timer: a bucket gets a token every fill_interval / tokens_per_fill, and requests are
+   * checked against it with the generic cell rate algorithm (GCRA), using a single atomic
+   * compare-and-swap per bucket.
+   */
   LocalRateLimiterImpl(
       const std::chrono::milliseconds fill_interval, const uint32_t max_tokens,
       const uint32_t tokens_per_fill, Event::Dispatcher& dispatcher,
       const Protobuf::RepeatedPtrField<
-          envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors);
+          envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
+      const bool continuous_refill = false);
   ~LocalRateLimiterImpl();
 
   bool requestAllowed(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
@@ -35,6 +42,14 @@ private:
   struct TokenState {
     mutable std::atomic<uint32_t> tokens_;
     MonotonicTime fill_time_;
+    // The GCRA state of a continuously refilled bucket, in nanoseconds of the monotonic clock:
+    // the bucket is full when the theoretical arrival time of the next request is in the past,
+    // and each allowed request pushes it emission_interval_ns_ further. The emission interval is
+    // zero when the bucket is refilled by the timer, or never.
+    int64_t emission_interval_ns_{0};
+    // How far tat_ns_ may be ahead of the current time, i.e. max_tokens * emission_interval_ns_.
+    int64_t burst_ns_{0};
+    mutable std::atomic<int64_t> tat_ns_{0};
   };
   // Refill counter is incremented per each refill timer hit.
   uint64_t refill_counter_{0};
@@ -74,10 +89,17 @@ private:
   void onFillTimerDescriptorHelper();
   OptRef<const LocalDescriptorImpl>
   descriptorHelper(absl::Span<const RateLimit::LocalDescriptor> request_descriptors) const;
+  void initializeContinuousRefill(TokenState& tokens, const RateLimit::TokenBucket& bucket);
   bool requestAllowedHelper(const TokenState& tokens) const;
+  bool continuousRefillAllowed(const TokenState& tokens) const;
+  uint32_t remainingTokensHelper(const TokenState& tokens,
+                                 const RateLimit::TokenBucket& bucket) const;
+  int64_t remainingFillIntervalHelper(const TokenState& tokens) const;
+  int64_t nowNs() const;
   int tokensFillPerSecond(LocalDescriptorImpl& descriptor);
 
   RateLimit::TokenBucket token_bucket_;
+  const bool continuous_refill_;
   const Event::TimerPtr fill_timer_;
   TimeSource& time_source_;
   TokenState tokens_;
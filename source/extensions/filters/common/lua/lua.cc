@@ -51,6 +51,16 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
   }
 }
 
+bool Coroutine::reusable() {
+  return state_ == State::Finished && lua_status(coroutine_state_.get()) == 0;
+}
+
+void Coroutine::prepareForReuse() {
+  ASSERT(reusable());
+  lua_settop(coroutine_state_.get(), 0);
+  state_ = State::NotStarted;
+}
+
 ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls)
     : tls_slot_(ThreadLocal::TypedSlot<LuaThreadLocal>::makeUnique(tls)) {
 
@@ -93,10 +103,30 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global,
 }
 
 CoroutinePtr ThreadLocalState::createCoroutine() {
+  std::vector<CoroutinePtr>& idle_coroutines = (*tls_slot_)->idle_coroutines_;
+  if (!idle_coroutines.empty()) {
+    CoroutinePtr coroutine = std::move(idle_coroutines.back());
+    idle_coroutines.pop_back();
+    return coroutine;
+  }
+
   lua_State* state = tlsState().get();
   return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
 }
 
+void ThreadLocalState::releaseCoroutine(CoroutinePtr&& coroutine) {
+  std::vector<CoroutinePtr>& idle_coroutines = (*tls_slot_)->idle_coroutines_;
+  // Coroutines that failed or are still suspended can't be started again.
+  if (coroutine == nullptr || !coroutine->reusable() ||
+      idle_coroutines.size() >= MaxIdleCoroutines) {
+    coroutine.reset();
+    return;
+  }
+  // Dropping the stack lets the objects the coroutine was called with be collected.
+  coroutine->prepareForReuse();
+  idle_coroutines.push_back(std::move(coroutine));
+}
+
 ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code)
     : state_(luaL_newstate()) {
 
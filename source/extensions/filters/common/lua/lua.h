@@ -373,6 +373,16 @@ public:
    */
   void resume(int num_args, const std::function<void()>& yield_callback);
 
+  /**
+   * @return whether the coroutine finished without error, and so can be started again.
+   */
+  bool reusable();
+
+  /**
+   * Prepare a reusable coroutine to be started again, dropping the values left on its stack.
+   */
+  void prepareForReuse();
+
 private:
   LuaRef<lua_State> coroutine_state_;
   State state_{State::NotStarted};
@@ -389,13 +399,29 @@ using InitializerList = std::vector<Initializer>;
  */
 class ThreadLocalState : Logger::Loggable<Logger::Id::lua> {
 public:
+  // The maximum number of finished coroutines kept by each worker for reuse.
+  static constexpr size_t MaxIdleCoroutines = 64;
+
   ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
 
   /**
-   * @return CoroutinePtr a new coroutine.
+   * @return CoroutinePtr a coroutine released by a previous user on this thread, or else a new
+   *         one.
    */
   CoroutinePtr createCoroutine();
 
+  /**
+   * Release a coroutine created by this state on this thread, so that it can be reused if it
+   * finished without error. The caller must not hold references to the coroutine anymore.
+   * @param coroutine supplies the coroutine to release.
+   */
+  void releaseCoroutine(CoroutinePtr&& coroutine);
+
+  /**
+   * @return the number of coroutines of this thread waiting to be reused.
+   */
+  size_t idleCoroutines() { return (*tls_slot_)->idle_coroutines_.size(); }
+
   /**
    * @return a global reference previously registered via registerGlobal(). This may return
    *         LUA_REFNIL if there was no such global.
@@ -440,6 +466,8 @@ private:
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
+    // Declared after state_, so that the coroutines are released before the state is closed.
+    std::vector<CoroutinePtr> idle_coroutines_;
   };
 
   CSmartPtr<lua_State, lua_close>& tlsState() { return (*tls_slot_)->state_; }
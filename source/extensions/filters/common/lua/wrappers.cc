@@ -57,7 +57,21 @@ int BufferWrapper::luaGetBytes(lua_State* state) {
     luaL_error(state, "index/length must be >= 0 and (index + length) must be <= buffer size");
   }
 
-  // TODO(mattklein123): Reduce copies here by using Lua direct buffer builds.
+  // Lua has to copy the bytes into its own string, but when they are within a single slice, as
+  // are small ranges, that copy can be made from the slice instead of from a temporary copy.
+  uint64_t offset = index;
+  for (const Buffer::RawSlice& slice : data_.getRawSlices()) {
+    if (offset >= slice.len_) {
+      offset -= slice.len_;
+      continue;
+    }
+    if (offset + length <= slice.len_) {
+      lua_pushlstring(state, static_cast<const char*>(slice.mem_) + offset, length);
+      return 1;
+    }
+    break;
+  }
+
   std::unique_ptr<char[]> data(new char[length]);
   data_.copyOut(index, length, data.get());
   lua_pushlstring(state, data.get(), length);
@@ -15,12 +15,14 @@ struct StatNames {
   explicit StatNames(Stats::SymbolTable& symbol_table)
       : pool_(symbol_table), ok_(pool_.add("ratelimit.ok")), error_(pool_.add("ratelimit.error")),
         failure_mode_allowed_(pool_.add("ratelimit.failure_mode_allowed")),
-        over_limit_(pool_.add("ratelimit.over_limit")) {}
+        over_limit_(pool_.add("ratelimit.over_limit")),
+        lease_hit_(pool_.add("ratelimit.lease_hit")) {}
   Stats::StatNamePool pool_;
   Stats::StatName ok_;
   Stats::StatName error_;
   Stats::StatName failure_mode_allowed_;
   Stats::StatName over_limit_;
+  Stats::StatName lease_hit_;
 };
 
 } // namespace RateLimit
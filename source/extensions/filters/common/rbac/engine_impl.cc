@@ -1,9 +1,12 @@
 #include "source/extensions/filters/common/rbac/engine_impl.h"
 
+#include <algorithm>
+
 #include "envoy/config/rbac/v3/rbac.pb.h"
 #include "envoy/config/rbac/v3/rbac.pb.validate.h"
 
 #include "source/common/http/header_map_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -11,6 +14,149 @@ namespace Filters {
 namespace Common {
 namespace RBAC {
 
+namespace {
+
+// A condition that a permission, principal or policy can't match without: either one of the
+// exact values of a header, or a range of an address of the connection.
+struct PolicyGuard {
+  enum class Kind { None, Header, Address };
+
+  // Returns whether both guards constrain the same header or address.
+  bool sameKey(const PolicyGuard& other) const {
+    return kind_ == other.kind_ &&
+           (kind_ == Kind::Header ? header_ == other.header_ : type_ == other.type_);
+  }
+
+  Kind kind_{Kind::None};
+  std::string header_;
+  std::vector<std::string> values_;
+  IPMatcher::Type type_{IPMatcher::ConnectionRemote};
+  std::vector<Network::Address::CidrRange> ranges_;
+};
+
+PolicyGuard headerGuard(const envoy::config::route::v3::HeaderMatcher& matcher) {
+  PolicyGuard guard;
+  if (matcher.invert_match() || matcher.treat_missing_header_as_empty()) {
+    return guard;
+  }
+  switch (matcher.header_match_specifier_case()) {
+  case envoy::config::route::v3::HeaderMatcher::HeaderMatchSpecifierCase::kExactMatch:
+    // An empty exact_match matches any value.
+    if (matcher.exact_match().empty()) {
+      return guard;
+    }
+    guard.values_.push_back(matcher.exact_match());
+    break;
+  case envoy::config::route::v3::HeaderMatcher::HeaderMatchSpecifierCase::kStringMatch:
+    if (matcher.string_match().match_pattern_case() !=
+            envoy::type::matcher::v3::StringMatcher::MatchPatternCase::kExact ||
+        matcher.string_match().ignore_case()) {
+      return guard;
+    }
+    guard.values_.push_back(matcher.string_match().exact());
+    break;
+  default:
+    return guard;
+  }
+  guard.kind_ = PolicyGuard::Kind::Header;
+  guard.header_ = Http::LowerCaseString(matcher.name()).get();
+  return guard;
+}
+
+PolicyGuard addressGuard(const envoy::config::core::v3::CidrRange& range, IPMatcher::Type type) {
+  PolicyGuard guard;
+  const auto cidr_range = Network::Address::CidrRange::create(range);
+  // Invalid ranges never match, but they are left to the matcher.
+  if (!cidr_range.isValid()) {
+    return guard;
+  }
+  guard.kind_ = PolicyGuard::Kind::Address;
+  guard.type_ = type;
+  guard.ranges_.push_back(cidr_range);
+  return guard;
+}
+
+PolicyGuard policyGuard(const envoy::config::rbac::v3::Permission& permission);
+PolicyGuard policyGuard(const envoy::config::rbac::v3::Principal& principal);
+
+// The guard of rules that must all match is the guard of any of them.
+template <class Rules> PolicyGuard allGuard(const Rules& rules) {
+  for (const auto& rule : rules) {
+    PolicyGuard guard = policyGuard(rule);
+    if (guard.kind_ != PolicyGuard::Kind::None) {
+      return guard;
+    }
+  }
+  return {};
+}
+
+// The guard of rules of which one must match is the union of their guards, if they all constrain
+// the same header or address.
+template <class Rules> PolicyGuard anyGuard(const Rules& rules) {
+  PolicyGuard result;
+  for (const auto& rule : rules) {
+    PolicyGuard guard = policyGuard(rule);
+    if (guard.kind_ == PolicyGuard::Kind::None ||
+        (result.kind_ != PolicyGuard::Kind::None && !result.sameKey(guard))) {
+      return {};
+    }
+    if (result.kind_ == PolicyGuard::Kind::None) {
+      result = std::move(guard);
+      continue;
+    }
+    result.values_.insert(result.values_.end(), guard.values_.begin(), guard.values_.end());
+    result.ranges_.insert(result.ranges_.end(), guard.ranges_.begin(), guard.ranges_.end());
+  }
+  return result;
+}
+
+PolicyGuard policyGuard(const envoy::config::rbac::v3::Permission& permission) {
+  switch (permission.rule_case()) {
+  case envoy::config::rbac::v3::Permission::RuleCase::kAndRules:
+    return allGuard(permission.and_rules().rules());
+  case envoy::config::rbac::v3::Permission::RuleCase::kOrRules:
+    return anyGuard(permission.or_rules().rules());
+  case envoy::config::rbac::v3::Permission::RuleCase::kHeader:
+    return headerGuard(permission.header());
+  case envoy::config::rbac::v3::Permission::RuleCase::kDestinationIp:
+    return addressGuard(permission.destination_ip(), IPMatcher::DownstreamLocal);
+  default:
+    return {};
+  }
+}
+
+PolicyGuard policyGuard(const envoy::config::rbac::v3::Principal& principal) {
+  switch (principal.identifier_case()) {
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kAndIds:
+    return allGuard(principal.and_ids().ids());
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kOrIds:
+    return anyGuard(principal.or_ids().ids());
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kHeader:
+    return headerGuard(principal.header());
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kSourceIp:
+    return addressGuard(principal.source_ip(), IPMatcher::ConnectionRemote);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kDirectRemoteIp:
+    return addressGuard(principal.direct_remote_ip(), IPMatcher::DownstreamDirectRemote);
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kRemoteIp:
+    return addressGuard(principal.remote_ip(), IPMatcher::DownstreamRemote);
+  default:
+    return {};
+  }
+}
+
+// A policy matches if any of its permissions and any of its principals match. Header guards are
+// preferred, as header lookups are cheaper than trie lookups.
+PolicyGuard policyGuard(const envoy::config::rbac::v3::Policy& policy) {
+  PolicyGuard permissions = anyGuard(policy.permissions());
+  if (permissions.kind_ == PolicyGuard::Kind::Header) {
+    return permissions;
+  }
+  PolicyGuard principals = anyGuard(policy.principals());
+  return principals.kind_ != PolicyGuard::Kind::None ? principals : permissions;
+}
+
+} // namespace
+
 Envoy::Matcher::ActionFactoryCb
 ActionFactory::createActionFactoryCb(const Protobuf::Message& config, ActionContext& context,
                                      ProtobufMessage::ValidationVisitor& validation_visitor) {
@@ -44,18 +190,42 @@ RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
     const envoy::config::rbac::v3::RBAC& rules,
     ProtobufMessage::ValidationVisitor& validation_visitor, const EnforcementMode mode)
     : action_(rules.action()), mode_(mode) {
-  // guard expression builder by presence of a condition in policies
   for (const auto& policy : rules.policies()) {
-    if (policy.second.has_condition()) {
-      builder_ = Expr::createBuilder(&constant_arena_);
+    policies_.emplace_back(policy.first,
+                           std::make_unique<PolicyMatcher>(policy.second, validation_visitor));
+  }
+  std::sort(policies_.begin(), policies_.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  if (policies_.size() >= MinPoliciesForPolicyIndex &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.rbac_policy_index")) {
+    buildPolicyIndex(rules);
+  }
+}
+
+void RoleBasedAccessControlEngineImpl::buildPolicyIndex(
+    const envoy::config::rbac::v3::RBAC& rules) {
+  auto index = std::make_unique<PolicyIndex>();
+  for (uint32_t position = 0; position < policies_.size(); position++) {
+    const PolicyGuard guard = policyGuard(rules.policies().at(policies_[position].first));
+    switch (guard.kind_) {
+    case PolicyGuard::Kind::None:
+      index->addUnindexed(position);
+      break;
+    case PolicyGuard::Kind::Header:
+      index->addHeader(Http::LowerCaseString(guard.header_), guard.values_, position);
+      break;
+    case PolicyGuard::Kind::Address:
+      index->addAddress(guard.type_, guard.ranges_, position);
       break;
     }
   }
-
-  for (const auto& policy : rules.policies()) {
-    policies_.emplace(policy.first, std::make_unique<PolicyMatcher>(policy.second, builder_.get(),
-                                                                    validation_visitor));
+  // The index is only worth its lookups if it can skip some policies.
+  if (index->unindexedPolicies() == policies_.size()) {
+    return;
   }
+  index->compile();
+  policy_index_ = std::move(index);
 }
 
 bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& connection,
@@ -89,19 +259,32 @@ bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& c
 bool RoleBasedAccessControlEngineImpl::checkPolicyMatch(
     const Network::Connection& connection, const StreamInfo::StreamInfo& info,
     const Envoy::Http::RequestHeaderMap& headers, std::string* effective_policy_id) const {
-  bool matched = false;
+  const auto policy_matches = [&](const auto& policy) {
+    if (!policy.second->matches(connection, headers, info)) {
+      return false;
+    }
+    if (effective_policy_id != nullptr) {
+      *effective_policy_id = policy.first;
+    }
+    return true;
+  };
 
-  for (const auto& policy : policies_) {
-    if (policy.second->matches(connection, headers, info)) {
-      matched = true;
-      if (effective_policy_id != nullptr) {
-        *effective_policy_id = policy.first;
+  if (policy_index_ != nullptr) {
+    // The candidates are in policy order, so the first match is the one a full scan would find.
+    for (const uint32_t position : policy_index_->candidates(connection, headers, info)) {
+      if (policy_matches(policies_[position])) {
+        return true;
       }
-      break;
     }
+    return false;
   }
 
-  return matched;
+  for (const auto& policy : policies_) {
+    if (policy_matches(policy)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 RoleBasedAccessControlMatcherEngineImpl::RoleBasedAccessControlMatcherEngineImpl(
@@ -6,6 +6,7 @@
 #include "source/common/matcher/matcher.h"
 #include "source/extensions/filters/common/rbac/engine.h"
 #include "source/extensions/filters/common/rbac/matchers.h"
+#include "source/extensions/filters/common/rbac/policy_index.h"
 
 #include "xds/type/matcher/v3/matcher.pb.h"
 
@@ -63,6 +64,9 @@ void generateLog(StreamInfo::StreamInfo& info, EnforcementMode mode, bool log);
 
 class RoleBasedAccessControlEngineImpl : public RoleBasedAccessControlEngine, NonCopyable {
 public:
+  // Engines with fewer policies are evaluated without a PolicyIndex, as a linear scan is as fast.
+  static constexpr size_t MinPoliciesForPolicyIndex = 16;
+
   RoleBasedAccessControlEngineImpl(const envoy::config::rbac::v3::RBAC& rules,
                                    ProtobufMessage::ValidationVisitor& validation_visitor,
                                    const EnforcementMode mode = EnforcementMode::Enforced);
@@ -79,14 +83,15 @@ private:
   bool checkPolicyMatch(const Network::Connection& connection, const StreamInfo::StreamInfo& info,
                         const Envoy::Http::RequestHeaderMap& headers,
                         std::string* effective_policy_id) const;
+  void buildPolicyIndex(const envoy::config::rbac::v3::RBAC& rules);
 
   const envoy::config::rbac::v3::RBAC::Action action_;
   const EnforcementMode mode_;
 
-  std::map<std::string, std::unique_ptr<PolicyMatcher>> policies_;
-
-  Protobuf::Arena constant_arena_;
-  Expr::BuilderPtr builder_;
+  // The policies, sorted by name, which is the order they are evaluated in.
+  std::vector<std::pair<std::string, std::unique_ptr<PolicyMatcher>>> policies_;
+  // Set when the engine has enough policies and some of them can be indexed.
+  std::unique_ptr<PolicyIndex> policy_index_;
 };
 
 class RoleBasedAccessControlMatcherEngineImpl : public RoleBasedAccessControlEngine, NonCopyable {
@@ -0,0 +1,83 @@
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include <algorithm>
+
+#include "source/common/http/header_utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+void PolicyIndex::addHeader(const Http::LowerCaseString& name,
+                            const std::vector<std::string>& values, uint32_t position) {
+  auto it = std::find_if(header_indexes_.begin(), header_indexes_.end(),
+                         [&name](const HeaderIndex& index) { return index.name_ == name; });
+  if (it == header_indexes_.end()) {
+    it = header_indexes_.insert(header_indexes_.end(), HeaderIndex{name, {}});
+  }
+  for (const std::string& value : values) {
+    std::vector<uint32_t>& policies = it->policies_[value];
+    // A policy may require the same value more than once.
+    if (policies.empty() || policies.back() != position) {
+      policies.push_back(position);
+    }
+  }
+}
+
+void PolicyIndex::addAddress(IPMatcher::Type type,
+                             const std::vector<Network::Address::CidrRange>& ranges,
+                             uint32_t position) {
+  auto it = std::find_if(address_indexes_.begin(), address_indexes_.end(),
+                         [type](const AddressIndex& index) { return index.type_ == type; });
+  if (it == address_indexes_.end()) {
+    it = address_indexes_.insert(address_indexes_.end(), AddressIndex{type, {}, nullptr});
+  }
+  it->ranges_.emplace_back(position, ranges);
+}
+
+void PolicyIndex::addUnindexed(uint32_t position) { unindexed_policies_.push_back(position); }
+
+void PolicyIndex::compile() {
+  for (AddressIndex& index : address_indexes_) {
+    index.trie_ = std::make_unique<Network::LcTrie::LcTrie<uint32_t>>(index.ranges_);
+    index.ranges_.clear();
+  }
+}
+
+PolicyIndex::Candidates PolicyIndex::candidates(const Network::Connection& connection,
+                                                const Envoy::Http::RequestHeaderMap& headers,
+                                                const StreamInfo::StreamInfo& info) const {
+  Candidates candidates(unindexed_policies_.begin(), unindexed_policies_.end());
+  for (const HeaderIndex& index : header_indexes_) {
+    const auto value = Http::HeaderUtility::getAllOfHeaderAsString(headers, index.name_);
+    if (!value.result().has_value()) {
+      continue;
+    }
+    const auto it = index.policies_.find(value.result().value());
+    if (it != index.policies_.end()) {
+      candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+  }
+  for (const AddressIndex& index : address_indexes_) {
+    const Network::Address::InstanceConstSharedPtr address =
+        IPMatcher::address(index.type_, connection, info);
+    // Addresses that aren't IP addresses are never in range.
+    if (address == nullptr || address->ip() == nullptr) {
+      continue;
+    }
+    const absl::Span<const uint32_t> policies = index.trie_->getDataView(address);
+    candidates.insert(candidates.end(), policies.begin(), policies.end());
+  }
+  std::sort(candidates.begin(), candidates.end());
+  // A policy is found more than once when several of its ranges contain the address.
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  return candidates;
+}
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "source/common/common/non_copyable.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/lc_trie.h"
+#include "source/extensions/filters/common/rbac/matchers.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+/**
+ * Index over the policies of an RBAC engine, used to avoid evaluating every policy of large
+ * engines. Policies are identified by their position in evaluation order. A policy is indexed by a
+ * condition it can't match without: the exact value of a request header, stored in a hash table
+ * per header, or the CIDR ranges of an address of the connection, stored in an LC trie per
+ * address. Policies without such a condition are returned for every request.
+ *
+ * The index only narrows down the policies that can match. The candidates are returned in policy
+ * order and still have to be fully evaluated, so the first matching policy is the same as with a
+ * linear scan.
+ */
+class PolicyIndex : NonCopyable {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * Adds a policy that can only match requests whose header `name`, with all its values joined
+   * as by the header matchers, is one of `values`.
+   */
+  void addHeader(const Http::LowerCaseString& name, const std::vector<std::string>& values,
+                 uint32_t position);
+
+  /**
+   * Adds a policy that can only match connections whose address of type `type` is in one of
+   * `ranges`.
+   */
+  void addAddress(IPMatcher::Type type, const std::vector<Network::Address::CidrRange>& ranges,
+                  uint32_t position);
+
+  /**
+   * Adds a policy that has to be evaluated for every request.
+   */
+  void addUnindexed(uint32_t position);
+
+  /**
+   * Prepares the index for lookups. It must be called once, after adding all policies.
+   */
+  void compile();
+
+  /**
+   * @return the positions of the policies that may match the request, in ascending order.
+   */
+  Candidates candidates(const Network::Connection& connection,
+                        const Envoy::Http::RequestHeaderMap& headers,
+                        const StreamInfo::StreamInfo& info) const;
+
+  /**
+   * @return the number of policies that are returned for every request.
+   */
+  size_t unindexedPolicies() const { return unindexed_policies_.size(); }
+
+private:
+  struct HeaderIndex {
+    Http::LowerCaseString name_;
+    absl::flat_hash_map<std::string, std::vector<uint32_t>> policies_;
+  };
+
+  struct AddressIndex {
+    IPMatcher::Type type_;
+    std::vector<std::pair<uint32_t, std::vector<Network::Address::CidrRange>>> ranges_;
+    std::unique_ptr<Network::LcTrie::LcTrie<uint32_t>> trie_;
+  };
+
+  std::vector<HeaderIndex> header_indexes_;
+  std::vector<AddressIndex> address_indexes_;
+  std::vector<uint32_t> unindexed_policies_;
+};
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
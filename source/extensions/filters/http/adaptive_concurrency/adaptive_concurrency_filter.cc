@@ -8,6 +8,7 @@
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/adaptive_concurrency/controller/controller.h"
 
@@ -35,6 +36,14 @@ AdaptiveConcurrencyFilterConfig::AdaptiveConcurrencyFilterConfig(
       concurrency_limit_exceeded_status_(
           toErrorCode(proto_config.concurrency_limit_exceeded_status().code())) {}
 
+AdaptiveConcurrencyRouteConfig::~AdaptiveConcurrencyRouteConfig() {
+  // The last reference to the route configuration may be released by a worker, but the timers of
+  // the controller must be destroyed on the main thread.
+  if (controller_ != nullptr && !main_thread_dispatcher_.isThreadSafe()) {
+    main_thread_dispatcher_.post([controller = std::move(controller_)]() {});
+  }
+}
+
 AdaptiveConcurrencyFilter::AdaptiveConcurrencyFilter(
     AdaptiveConcurrencyFilterConfigSharedPtr config, ConcurrencyControllerSharedPtr controller)
     : config_(std::move(config)), controller_(std::move(controller)) {}
@@ -47,6 +56,13 @@ Http::FilterHeadersStatus AdaptiveConcurrencyFilter::decodeHeaders(Http::Request
     return Http::FilterHeadersStatus::Continue;
   }
 
+  const auto* route_config =
+      Http::Utility::resolveMostSpecificPerFilterConfig<AdaptiveConcurrencyRouteConfig>(
+          decoder_callbacks_);
+  if (route_config != nullptr) {
+    controller_ = route_config->controller();
+  }
+
   if (controller_->forwardingDecision() == Controller::RequestForwardingAction::Block) {
     decoder_callbacks_->sendLocalReply(config_->concurrencyLimitExceededStatus(),
                                        "reached concurrency limit", nullptr, absl::nullopt,
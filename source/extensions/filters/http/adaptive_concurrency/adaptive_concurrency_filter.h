@@ -5,8 +5,10 @@
 #include <string>
 
 #include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
 #include "envoy/http/filter.h"
+#include "envoy/router/router.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_macros.h"
@@ -47,6 +49,24 @@ using AdaptiveConcurrencyFilterConfigSharedPtr =
     std::shared_ptr<const AdaptiveConcurrencyFilterConfig>;
 using ConcurrencyControllerSharedPtr = std::shared_ptr<Controller::ConcurrencyController>;
 
+/**
+ * Per-route configuration of the adaptive concurrency limit filter, holding the controller of the
+ * requests to the route.
+ */
+class AdaptiveConcurrencyRouteConfig : public Router::RouteSpecificFilterConfig {
+public:
+  AdaptiveConcurrencyRouteConfig(ConcurrencyControllerSharedPtr controller,
+                                 Event::Dispatcher& main_thread_dispatcher)
+      : controller_(std::move(controller)), main_thread_dispatcher_(main_thread_dispatcher) {}
+  ~AdaptiveConcurrencyRouteConfig() override;
+
+  const ConcurrencyControllerSharedPtr& controller() const { return controller_; }
+
+private:
+  ConcurrencyControllerSharedPtr controller_;
+  Event::Dispatcher& main_thread_dispatcher_;
+};
+
 /**
  * A filter that samples request latencies and dynamically adjusts the request
  * concurrency window.
@@ -66,7 +86,8 @@ public:
 
 private:
   AdaptiveConcurrencyFilterConfigSharedPtr config_;
-  const ConcurrencyControllerSharedPtr controller_;
+  // The controller of the route, if it has one, or else the one of the filter.
+  ConcurrencyControllerSharedPtr controller_;
   std::unique_ptr<Cleanup> deferred_sample_task_;
 };
 
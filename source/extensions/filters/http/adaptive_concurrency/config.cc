@@ -7,6 +7,8 @@
 #include "source/extensions/filters/http/adaptive_concurrency/adaptive_concurrency_filter.h"
 #include "source/extensions/filters/http/adaptive_concurrency/controller/gradient_controller.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -39,6 +41,21 @@ Http::FilterFactoryCb AdaptiveConcurrencyFilterFactory::createFilterFactoryFromP
   };
 }
 
+Router::RouteSpecificFilterConfigConstSharedPtr
+AdaptiveConcurrencyFilterFactory::createRouteSpecificFilterConfigTyped(
+    const envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrencyPerRoute&
+        proto_config,
+    Server::Configuration::ServerFactoryContext& context, ProtobufMessage::ValidationVisitor&) {
+  auto controller = std::make_shared<Controller::GradientController>(
+      Controller::GradientControllerConfig(proto_config.gradient_controller_config(),
+                                           context.runtime()),
+      context.mainThreadDispatcher(), context.runtime(),
+      absl::StrCat("adaptive_concurrency.", proto_config.stat_prefix(), ".gradient_controller."),
+      context.scope(), context.api().randomGenerator(), context.timeSource());
+  return std::make_shared<const AdaptiveConcurrencyRouteConfig>(std::move(controller),
+                                                                context.mainThreadDispatcher());
+}
+
 /**
  * Static registration for the adaptive_concurrency filter. @see RegisterFactory.
  */
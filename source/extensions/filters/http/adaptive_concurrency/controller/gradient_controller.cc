@@ -1,7 +1,9 @@
 #include "source/extensions/filters/http/adaptive_concurrency/controller/gradient_controller.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 
 #include "envoy/common/random_generator.h"
 #include "envoy/event/dispatcher.h"
@@ -42,7 +44,63 @@ GradientControllerConfig::GradientControllerConfig(
       min_concurrency_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config.min_rtt_calc_params(), min_concurrency, 3)),
       min_rtt_buffer_pct_(
-          PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(proto_config.min_rtt_calc_params(), buffer, 25)) {}
+          PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(proto_config.min_rtt_calc_params(), buffer, 25)),
+      continuous_min_rtt_(proto_config.min_rtt_calc_params().has_continuous_percentile()),
+      continuous_min_rtt_percentile_(PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(
+          proto_config.min_rtt_calc_params(), continuous_percentile, 0)) {}
+
+void LatencySampleBins::insert(std::chrono::microseconds latency) {
+  ++sample_count_;
+  ++bins_[binIndex(std::max<int64_t>(0, latency.count()))];
+}
+
+void LatencySampleBins::drainInto(histogram_t* hist) {
+  uint64_t drained = 0;
+  for (uint32_t i = 0; i < NumBins; ++i) {
+    const uint64_t count = bins_[i].exchange(0);
+    if (count > 0) {
+      hist_insert(hist, binLatency(i), count);
+      drained += count;
+    }
+  }
+  sample_count_ -= drained;
+}
+
+void LatencySampleBins::clear() {
+  uint64_t cleared = 0;
+  for (auto& bin : bins_) {
+    cleared += bin.exchange(0);
+  }
+  sample_count_ -= cleared;
+}
+
+uint32_t LatencySampleBins::binIndex(uint64_t latency_us) {
+  if (latency_us == 0) {
+    return 0;
+  }
+  uint32_t exponent = 0;
+  uint64_t scale = 1;
+  while (exponent < MaxExponent && latency_us >= scale * 10) {
+    ++exponent;
+    scale *= 10;
+  }
+  if (latency_us >= scale * 10) {
+    return NumBins - 1;
+  }
+  // The 2 significant digits of the latency, in the range [10, 99].
+  const uint64_t digits = latency_us * 10 / scale;
+  return 1 + exponent * 90 + (digits - 10);
+}
+
+double LatencySampleBins::binLatency(uint32_t index) {
+  if (index == 0) {
+    return 0;
+  }
+  const uint32_t exponent = (index - 1) / 90;
+  const uint32_t digits = (index - 1) % 90 + 10;
+  return (digits + 0.5) * std::pow(10.0, static_cast<double>(exponent) - 1);
+}
+
 GradientController::GradientController(GradientControllerConfig config,
                                        Event::Dispatcher& dispatcher, Runtime::Loader&,
                                        const std::string& stats_prefix, Stats::Scope& scope,
@@ -52,7 +110,13 @@ GradientController::GradientController(GradientControllerConfig config,
       deferred_limit_value_(0), num_rq_outstanding_(0),
       concurrency_limit_(config_.minConcurrency()),
       latency_sample_hist_(hist_fast_alloc(), hist_free) {
-  min_rtt_calc_timer_ = dispatcher_.createTimer([this]() -> void { enterMinRTTSamplingWindow(); });
+  min_rtt_calc_timer_ = dispatcher_.createTimer([this]() -> void {
+    if (config_.continuousMinRTT()) {
+      expireContinuousMinRTT();
+    } else {
+      enterMinRTTSamplingWindow();
+    }
+  });
 
   sample_reset_timer_ = dispatcher_.createTimer([this]() -> void {
     if (inMinRTTSamplingWindow()) {
@@ -70,7 +134,11 @@ GradientController::GradientController(GradientControllerConfig config,
     sample_reset_timer_->enableTimer(config_.sampleRTTCalcInterval());
   });
 
-  enterMinRTTSamplingWindow();
+  if (config_.continuousMinRTT()) {
+    expireContinuousMinRTT();
+  } else {
+    enterMinRTTSamplingWindow();
+  }
   sample_reset_timer_->enableTimer(config_.sampleRTTCalcInterval());
   stats_.concurrency_limit_.set(concurrency_limit_.load());
 }
@@ -102,6 +170,7 @@ void GradientController::enterMinRTTSamplingWindow() {
 
   // Throw away any latency samples from before the recalculation window as it may not represent
   // the minRTT.
+  latency_samples_.clear();
   hist_clear(latency_sample_hist_.get());
 
   min_rtt_epoch_ = time_source_.monotonicTime();
@@ -111,10 +180,11 @@ void GradientController::updateMinRTT() {
   // Only update minRTT when it is in minRTT sampling window and
   // number of samples is greater than or equal to the minRTTAggregateRequestCount.
   if (!inMinRTTSamplingWindow() ||
-      hist_sample_count(latency_sample_hist_.get()) < config_.minRTTAggregateRequestCount()) {
+      latency_samples_.sampleCount() < config_.minRTTAggregateRequestCount()) {
     return;
   }
 
+  latency_samples_.drainInto(latency_sample_hist_.get());
   min_rtt_ = processLatencySamplesAndClear();
   stats_.min_rtt_msecs_.set(
       std::chrono::duration_cast<std::chrono::milliseconds>(min_rtt_).count());
@@ -127,6 +197,29 @@ void GradientController::updateMinRTT() {
   sample_reset_timer_->enableTimer(config_.sampleRTTCalcInterval());
 }
 
+void GradientController::updateContinuousMinRTT() {
+  const std::chrono::microseconds estimate =
+      latencySampleQuantile(config_.continuousMinRTTPercentile());
+  if (!min_rtt_expired_ && estimate >= min_rtt_) {
+    return;
+  }
+
+  min_rtt_ = estimate;
+  min_rtt_expired_ = false;
+  stats_.min_rtt_msecs_.set(
+      std::chrono::duration_cast<std::chrono::milliseconds>(min_rtt_).count());
+}
+
+void GradientController::expireContinuousMinRTT() {
+  {
+    absl::MutexLock ml(&sample_mutation_mtx_);
+    min_rtt_expired_ = true;
+  }
+
+  min_rtt_calc_timer_->enableTimer(
+      applyJitter(config_.minRTTCalcInterval(), config_.jitterPercent()));
+}
+
 std::chrono::milliseconds GradientController::applyJitter(std::chrono::milliseconds interval,
                                                           double jitter_pct) const {
   if (jitter_pct == 0) {
@@ -141,24 +234,35 @@ void GradientController::resetSampleWindow() {
   // The sampling window must not be reset while sampling for the new minRTT value.
   ASSERT(!inMinRTTSamplingWindow());
 
+  latency_samples_.drainInto(latency_sample_hist_.get());
   if (hist_sample_count(latency_sample_hist_.get()) == 0) {
     return;
   }
 
+  if (config_.continuousMinRTT()) {
+    updateContinuousMinRTT();
+  }
   sample_rtt_ = processLatencySamplesAndClear();
   stats_.sample_rtt_msecs_.set(
       std::chrono::duration_cast<std::chrono::milliseconds>(sample_rtt_).count());
   updateConcurrencyLimit(calculateNewLimit());
 }
 
-std::chrono::microseconds GradientController::processLatencySamplesAndClear() {
-  const std::array<double, 1> quantile{config_.sampleAggregatePercentile()};
+std::chrono::microseconds GradientController::latencySampleQuantile(double quantile) {
+  const std::array<double, 1> quantiles{quantile};
   std::array<double, 1> calculated_quantile;
-  hist_approx_quantile(latency_sample_hist_.get(), quantile.data(), 1, calculated_quantile.data());
-  hist_clear(latency_sample_hist_.get());
+  hist_approx_quantile(latency_sample_hist_.get(), quantiles.data(), 1,
+                       calculated_quantile.data());
   return std::chrono::microseconds(static_cast<int>(calculated_quantile[0]));
 }
 
+std::chrono::microseconds GradientController::processLatencySamplesAndClear() {
+  const std::chrono::microseconds sample_quantile =
+      latencySampleQuantile(config_.sampleAggregatePercentile());
+  hist_clear(latency_sample_hist_.get());
+  return sample_quantile;
+}
+
 uint32_t GradientController::calculateNewLimit() {
   ASSERT(sample_rtt_.count() > 0);
 
@@ -210,9 +314,12 @@ void GradientController::recordLatencySample(MonotonicTime rq_send_time) {
       std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() -
                                                             rq_send_time);
   synchronizer_.syncPoint("pre_hist_insert");
-  {
+  latency_samples_.insert(rq_latency);
+
+  // Only the sample completing a minRTT calculation window needs the mutex.
+  if (inMinRTTSamplingWindow() &&
+      latency_samples_.sampleCount() >= config_.minRTTAggregateRequestCount()) {
     absl::MutexLock ml(&sample_mutation_mtx_);
-    hist_insert(latency_sample_hist_.get(), rq_latency.count(), 1);
     updateMinRTT();
   }
 }
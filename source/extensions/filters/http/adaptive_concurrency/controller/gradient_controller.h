@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <vector>
 
@@ -97,6 +99,17 @@ public:
     return std::max(0.0, std::min(val, 100.0)) / 100.0;
   }
 
+  // True if the minRTT is estimated from the latencies sampled in each concurrency update interval
+  // instead of in minRTT calculation windows.
+  bool continuousMinRTT() const { return continuous_min_rtt_; }
+
+  // The percentage is normalized to the range [0.0, 1.0].
+  double continuousMinRTTPercentile() const {
+    const double val = runtime_.snapshot().getDouble(
+        RuntimeKeys::get().ContinuousMinRTTPercentileKey, continuous_min_rtt_percentile_);
+    return std::max(0.0, std::min(val, 100.0)) / 100.0;
+  }
+
 private:
   class RuntimeKeyValues {
   public:
@@ -115,6 +128,8 @@ private:
         "adaptive_concurrency.gradient_controller.min_concurrency";
     const std::string MinRTTBufferPercentKey =
         "adaptive_concurrency.gradient_controller.min_rtt_buffer";
+    const std::string ContinuousMinRTTPercentileKey =
+        "adaptive_concurrency.gradient_controller.continuous_min_rtt_percentile";
   };
 
   using RuntimeKeys = ConstSingleton<RuntimeKeyValues>;
@@ -144,9 +159,48 @@ private:
 
   // The amount added to the measured minRTT as a hedge against natural variability in latency.
   const double min_rtt_buffer_pct_;
+
+  // Whether the minRTT is estimated continuously, and the percentile of the samples it is
+  // estimated from.
+  const bool continuous_min_rtt_;
+  const double continuous_min_rtt_percentile_;
 };
 using GradientControllerConfigSharedPtr = std::shared_ptr<GradientControllerConfig>;
 
+/**
+ * Latency samples recorded without locking. The samples are counted in bins with the boundaries of
+ * the circllhist bins, which keep 2 significant decimal digits, so that moving them to a histogram
+ * yields the same quantiles as inserting them in it one by one.
+ */
+class LatencySampleBins {
+public:
+  void insert(std::chrono::microseconds latency);
+
+  // The number of samples recorded since they were last drained.
+  uint64_t sampleCount() const { return sample_count_.load(); }
+
+  // Moves the samples to hist. The samples recorded concurrently are either moved or kept.
+  void drainInto(histogram_t* hist);
+
+  // Discards the samples.
+  void clear();
+
+private:
+  // The latencies of 10^(MaxExponent + 1) microseconds and more share the last bin.
+  static constexpr uint32_t MaxExponent = 11;
+  // A bin for the latencies of 0, and 90 bins of 2 significant digits per decimal exponent.
+  static constexpr uint32_t NumBins = 1 + (MaxExponent + 1) * 90;
+
+  static uint32_t binIndex(uint64_t latency_us);
+  // A latency in the middle of the bin, which is binned the same by circllhist.
+  static double binLatency(uint32_t index);
+
+  // The count is incremented before the bin and decremented after it, so that it never
+  // underflows.
+  std::atomic<uint64_t> sample_count_{0};
+  std::array<std::atomic<uint64_t>, NumBins> bins_{};
+};
+
 /**
  * A concurrency controller that implements a variation of the Gradient algorithm described in:
  *
@@ -202,12 +256,20 @@ using GradientControllerConfigSharedPtr = std::shared_ptr<GradientControllerConf
  * When not in a sampling window, the controller is simply servicing the adaptive concurrency filter
  * via the public functions.
  *
+ * If the minRTT is configured to be estimated continuously, there are no minRTT sampling windows
+ * and the concurrency limit is never pinned. Instead, each sampleRTT calculation also consolidates
+ * the latency samples into a low quantile value, and the minRTT is the lowest of these values since
+ * the minRTT timer last fired.
+ *
  * Locking:
  * ========
  * There are 2 mutually exclusive calculation windows, so the sample mutation mutex is held to
  * prevent the overlap of these windows. It is necessary for a worker thread to know specifically if
  * the controller is inside of a minRTT recalculation window during the recording of a latency
  * sample, so this extra bit of information is stored in inMinRTTSamplingWindow().
+ *
+ * The latency samples are recorded without locking, and the workers only take the mutex to
+ * complete a minRTT calculation window once enough samples were recorded.
  */
 class GradientController : public ConcurrencyController {
 public:
@@ -231,6 +293,10 @@ private:
   static GradientControllerStats generateStats(Stats::Scope& scope,
                                                const std::string& stats_prefix);
   void updateMinRTT() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
+  void updateContinuousMinRTT() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
+  void expireContinuousMinRTT();
+  std::chrono::microseconds latencySampleQuantile(double quantile)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
   std::chrono::microseconds processLatencySamplesAndClear()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
   uint32_t calculateNewLimit() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
@@ -273,11 +339,18 @@ private:
   // make the forwarding decision without locking.
   std::atomic<uint32_t> concurrency_limit_;
 
-  // Stores all sampled latencies and provides percentile estimations when using the sampled data to
-  // calculate a new concurrency limit.
+  // Records the latencies sampled by the workers, which are moved to latency_sample_hist_ when
+  // processed.
+  LatencySampleBins latency_samples_;
+
+  // Stores the sampled latencies being processed and provides percentile estimations when using
+  // the sampled data to calculate a new concurrency limit.
   std::unique_ptr<histogram_t, decltype(&hist_free)>
       latency_sample_hist_ ABSL_GUARDED_BY(sample_mutation_mtx_);
 
+  // True if the next continuous minRTT estimate replaces the minRTT, even if it is higher.
+  bool min_rtt_expired_ ABSL_GUARDED_BY(sample_mutation_mtx_){true};
+
   // Tracks the number of consecutive times that the concurrency limit is set to the minimum. This
   // is used to determine whether the controller should trigger an additional minRTT measurement
   // after remaining at the minimum limit for too long.
@@ -10,6 +10,7 @@
 
 using envoy::extensions::filters::http::bandwidth_limit::v3::BandwidthLimit;
 using Envoy::Extensions::HttpFilters::Common::StreamRateLimiter;
+using Envoy::Extensions::HttpFilters::Common::StreamRateLimiterScheduler;
 
 namespace Envoy {
 namespace Extensions {
@@ -28,9 +29,12 @@ const Http::LowerCaseString DefaultResponseFilterDelayTrailer =
 } // namespace
 
 FilterConfig::FilterConfig(const BandwidthLimit& config, Stats::Scope& scope,
-                           Runtime::Loader& runtime, TimeSource& time_source, bool per_route)
+                           Runtime::Loader& runtime, TimeSource& time_source, bool per_route,
+                           ThreadLocal::SlotAllocator* tls)
     : runtime_(runtime), time_source_(time_source), enable_mode_(config.enable_mode()),
       limit_kbps_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, limit_kbps, 0)),
+      connection_limit_kbps_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, connection_limit_kbps, 0)),
+      enforce_filter_limit_(config.enforce_filter_limit()), stat_prefix_(config.stat_prefix()),
       fill_interval_(std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
           config, fill_interval, StreamRateLimiter::DefaultFillInterval.count()))),
       enabled_(config.runtime_enabled(), runtime),
@@ -63,9 +67,25 @@ FilterConfig::FilterConfig(const BandwidthLimit& config, Stats::Scope& scope,
   // The token bucket is configured with a max token count of the number of
   // bytes per second, and refills at the same rate, so that we have a per
   // second limit which refills gradually in 1/fill_interval increments.
-  token_bucket_ = std::make_shared<SharedTokenBucketImpl>(
+  token_bucket_ = std::make_shared<AtomicTokenBucketImpl>(
       StreamRateLimiter::kiloBytesToBytes(limit_kbps_), time_source,
       StreamRateLimiter::kiloBytesToBytes(limit_kbps_));
+
+  // Each worker services the limiters of its streams in rounds of one fill interval.
+  if (tls != nullptr) {
+    tls_ = ThreadLocal::TypedSlot<ThreadLocalScheduler>::makeUnique(*tls);
+    tls_->set([fill_interval = fill_interval_](Event::Dispatcher& dispatcher) {
+      return std::make_shared<ThreadLocalScheduler>(
+          std::make_shared<StreamRateLimiterScheduler>(dispatcher, fill_interval));
+    });
+  }
+}
+
+Common::StreamRateLimiterSchedulerSharedPtr FilterConfig::scheduler() const {
+  if (tls_ == nullptr) {
+    return nullptr;
+  }
+  return (*tls_)->scheduler_;
 }
 
 BandwidthLimitStats FilterConfig::generateStats(const std::string& prefix, Stats::Scope& scope) {
@@ -75,6 +95,10 @@ BandwidthLimitStats FilterConfig::generateStats(const std::string& prefix, Stats
                                     POOL_HISTOGRAM_PREFIX(scope, final_prefix))};
 }
 
+std::string ConnectionTokenBucket::key(absl::string_view stat_prefix) {
+  return absl::StrCat("envoy.extensions.filters.http.bandwidth_limit.connection.", stat_prefix);
+}
+
 // BandwidthLimiter members
 
 Http::FilterHeadersStatus BandwidthLimiter::decodeHeaders(Http::RequestHeaderMap&, bool) {
@@ -82,6 +106,7 @@ Http::FilterHeadersStatus BandwidthLimiter::decodeHeaders(Http::RequestHeaderMap
 
   if (config.enabled() && (config.enableMode() & BandwidthLimit::REQUEST)) {
     config.stats().request_enabled_.inc();
+    scheduler_ = config.scheduler();
     request_limiter_ = std::make_unique<StreamRateLimiter>(
         config.limit(), decoder_callbacks_->decoderBufferLimit(),
         [this] { decoder_callbacks_->onDecoderFilterAboveWriteBufferHighWatermark(); },
@@ -105,7 +130,7 @@ Http::FilterHeadersStatus BandwidthLimiter::decodeHeaders(Http::RequestHeaderMap
           }
         },
         const_cast<FilterConfig*>(&config)->timeSource(), decoder_callbacks_->dispatcher(),
-        decoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval());
+        decoder_callbacks_->scope(), tokenBucket(config), config.fillInterval(), scheduler_.get());
   }
 
   return Http::FilterHeadersStatus::Continue;
@@ -148,6 +173,7 @@ Http::FilterHeadersStatus BandwidthLimiter::encodeHeaders(Http::ResponseHeaderMa
 
   if (config.enabled() && (config.enableMode() & BandwidthLimit::RESPONSE)) {
     config.stats().response_enabled_.inc();
+    scheduler_ = config.scheduler();
 
     response_limiter_ = std::make_unique<StreamRateLimiter>(
         config.limit(), encoder_callbacks_->encoderBufferLimit(),
@@ -172,7 +198,7 @@ Http::FilterHeadersStatus BandwidthLimiter::encodeHeaders(Http::ResponseHeaderMa
           }
         },
         const_cast<FilterConfig*>(&config)->timeSource(), encoder_callbacks_->dispatcher(),
-        encoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval());
+        encoder_callbacks_->scope(), tokenBucket(config), config.fillInterval(), scheduler_.get());
   }
 
   return Http::FilterHeadersStatus::Continue;
@@ -261,6 +287,37 @@ void BandwidthLimiter::updateStatsOnEncodeFinish() {
   }
 }
 
+std::shared_ptr<TokenBucket> BandwidthLimiter::tokenBucket(const FilterConfig& config) {
+  std::vector<AtomicTokenBucketImplSharedPtr> buckets;
+  if (config.connectionLimit() > 0) {
+    const std::string key = ConnectionTokenBucket::key(config.statPrefix());
+    const StreamInfo::FilterStateSharedPtr& filter_state =
+        decoder_callbacks_->streamInfo().filterState();
+    const auto* connection_bucket = filter_state->getDataReadOnly<ConnectionTokenBucket>(key);
+    if (connection_bucket == nullptr) {
+      const uint64_t max_tokens = StreamRateLimiter::kiloBytesToBytes(config.connectionLimit());
+      auto state = std::make_shared<ConnectionTokenBucket>(std::make_shared<AtomicTokenBucketImpl>(
+          max_tokens, const_cast<FilterConfig*>(&config)->timeSource(), max_tokens));
+      connection_bucket = state.get();
+      filter_state->setData(key, std::move(state), StreamInfo::FilterState::StateType::ReadOnly,
+                            StreamInfo::FilterState::LifeSpan::Connection);
+    }
+    buckets.push_back(connection_bucket->value());
+  }
+  if (config.limit() > 0 || buckets.empty()) {
+    buckets.push_back(config.tokenBucket());
+  }
+  // The filter chain's bucket is shared by the streams of all the routes.
+  if (&config != config_.get() && config.enforceFilterLimit() && config_->limit() > 0) {
+    buckets.push_back(config_->tokenBucket());
+  }
+
+  if (buckets.size() == 1) {
+    return buckets.front();
+  }
+  return std::make_shared<HierarchicalTokenBucketImpl>(std::move(buckets), config.fillInterval());
+}
+
 const FilterConfig& BandwidthLimiter::getConfig() const {
   const auto* config =
       Http::Utility::resolveMostSpecificPerFilterConfig<FilterConfig>(decoder_callbacks_);
@@ -11,16 +11,16 @@
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_macros.h"
 #include "envoy/stats/timespan.h"
+#include "envoy/stream_info/filter_state.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/assert.h"
-#include "source/common/common/shared_token_bucket_impl.h"
+#include "source/common/common/token_bucket_impl.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/router/header_parser.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/stream_rate_limiter.h"
 
-#include "absl/synchronization/mutex.h"
-
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -65,7 +65,7 @@ public:
 
   FilterConfig(const envoy::extensions::filters::http::bandwidth_limit::v3::BandwidthLimit& config,
                Stats::Scope& scope, Runtime::Loader& runtime, TimeSource& time_source,
-               bool per_route = false);
+               bool per_route = false, ThreadLocal::SlotAllocator* tls = nullptr);
   ~FilterConfig() override = default;
   Runtime::Loader& runtime() { return runtime_; }
   BandwidthLimitStats& stats() const { return stats_; }
@@ -74,8 +74,14 @@ public:
   uint64_t limit() const { return limit_kbps_; }
   bool enabled() const { return enabled_.enabled(); }
   EnableMode enableMode() const { return enable_mode_; };
-  const std::shared_ptr<SharedTokenBucketImpl> tokenBucket() const { return token_bucket_; }
+  const AtomicTokenBucketImplSharedPtr& tokenBucket() const { return token_bucket_; }
   std::chrono::milliseconds fillInterval() const { return fill_interval_; }
+  // The limit of each downstream connection, 0 if there is none.
+  uint64_t connectionLimit() const { return connection_limit_kbps_; }
+  bool enforceFilterLimit() const { return enforce_filter_limit_; }
+  const std::string& statPrefix() const { return stat_prefix_; }
+  // The scheduler of the current worker, null if the limiters use token timers of their own.
+  Common::StreamRateLimiterSchedulerSharedPtr scheduler() const;
   const Http::LowerCaseString& requestDelayTrailer() const { return request_delay_trailer_; }
   const Http::LowerCaseString& responseDelayTrailer() const { return response_delay_trailer_; }
   const Http::LowerCaseString& requestFilterDelayTrailer() const {
@@ -89,17 +95,28 @@ public:
 private:
   friend class FilterTest;
 
+  struct ThreadLocalScheduler : public ThreadLocal::ThreadLocalObject {
+    ThreadLocalScheduler(Common::StreamRateLimiterSchedulerSharedPtr scheduler)
+        : scheduler_(std::move(scheduler)) {}
+
+    const Common::StreamRateLimiterSchedulerSharedPtr scheduler_;
+  };
+
   static BandwidthLimitStats generateStats(const std::string& prefix, Stats::Scope& scope);
 
   Runtime::Loader& runtime_;
   TimeSource& time_source_;
   const EnableMode enable_mode_;
   const uint64_t limit_kbps_;
+  const uint64_t connection_limit_kbps_;
+  const bool enforce_filter_limit_;
+  const std::string stat_prefix_;
   const std::chrono::milliseconds fill_interval_;
   const Runtime::FeatureFlag enabled_;
   mutable BandwidthLimitStats stats_;
   // Filter chain's shared token bucket
-  std::shared_ptr<SharedTokenBucketImpl> token_bucket_;
+  AtomicTokenBucketImplSharedPtr token_bucket_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalScheduler> tls_;
   const Http::LowerCaseString request_delay_trailer_;
   const Http::LowerCaseString response_delay_trailer_;
   const Http::LowerCaseString request_filter_delay_trailer_;
@@ -109,6 +126,20 @@ private:
 
 using FilterConfigSharedPtr = std::shared_ptr<FilterConfig>;
 
+/**
+ * The token bucket of a downstream connection, shared by the streams of the connection.
+ */
+class ConnectionTokenBucket : public StreamInfo::FilterState::Object {
+public:
+  ConnectionTokenBucket(AtomicTokenBucketImplSharedPtr token_bucket)
+      : token_bucket_(std::move(token_bucket)) {}
+  static std::string key(absl::string_view stat_prefix);
+  const AtomicTokenBucketImplSharedPtr& value() const { return token_bucket_; }
+
+private:
+  const AtomicTokenBucketImplSharedPtr token_bucket_;
+};
+
 /**
  * HTTP bandwidth limit filter. Depending on the route configuration, this
  * filter calls consults with local token bucket before allowing further filter
@@ -152,12 +183,17 @@ private:
   const FilterConfig& getConfig() const;
   const std::chrono::milliseconds zero_milliseconds_ = std::chrono::milliseconds(0);
 
+  // The bucket of each limit the stream is subject to, combined if there are several.
+  std::shared_ptr<TokenBucket> tokenBucket(const FilterConfig& config);
+
   void updateStatsOnDecodeFinish();
   void updateStatsOnEncodeFinish();
 
   Http::StreamDecoderFilterCallbacks* decoder_callbacks_{};
   Http::StreamEncoderFilterCallbacks* encoder_callbacks_{};
   FilterConfigSharedPtr config_;
+  // Declared before the limiters, which are serviced by it.
+  Common::StreamRateLimiterSchedulerSharedPtr scheduler_;
   std::unique_ptr<Envoy::Extensions::HttpFilters::Common::StreamRateLimiter> request_limiter_;
   std::unique_ptr<Envoy::Extensions::HttpFilters::Common::StreamRateLimiter> response_limiter_;
   Stats::TimespanPtr request_latency_;
@@ -16,7 +16,8 @@ Http::FilterFactoryCb BandwidthLimitFilterConfig::createFilterFactoryFromProtoTy
     const envoy::extensions::filters::http::bandwidth_limit::v3::BandwidthLimit& proto_config,
     const std::string&, Server::Configuration::FactoryContext& context) {
   FilterConfigSharedPtr filter_config = std::make_shared<FilterConfig>(
-      proto_config, context.scope(), context.runtime(), context.timeSource());
+      proto_config, context.scope(), context.runtime(), context.timeSource(), false,
+      &context.threadLocal());
   return [filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<BandwidthLimiter>(filter_config));
   };
@@ -27,7 +28,7 @@ BandwidthLimitFilterConfig::createRouteSpecificFilterConfigTyped(
     const envoy::extensions::filters::http::bandwidth_limit::v3::BandwidthLimit& proto_config,
     Server::Configuration::ServerFactoryContext& context, ProtobufMessage::ValidationVisitor&) {
   return std::make_shared<const FilterConfig>(proto_config, context.scope(), context.runtime(),
-                                              context.timeSource(), true);
+                                              context.timeSource(), true, &context.threadLocal());
 }
 
 /**
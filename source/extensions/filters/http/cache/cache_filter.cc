@@ -3,6 +3,7 @@
 #include "envoy/http/header_map.h"
 
 #include "source/common/common/enum_to_int.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
 #include "source/extensions/filters/http/cache/cache_custom_headers.h"
@@ -35,10 +36,22 @@ CacheFilter::CacheFilter(const envoy::extensions::filters::http::cache::v3::Cach
                          const std::string&, Stats::Scope&, TimeSource& time_source,
                          OptRef<HttpCache> http_cache)
     : time_source_(time_source), cache_(http_cache),
-      vary_allow_list_(config.allowed_vary_headers()) {}
+      vary_allow_list_(config.allowed_vary_headers()) {
+  if (config.has_collapsed_request_timeout()) {
+    collapsed_request_timeout_ = std::chrono::milliseconds(
+        DurationUtil::durationToMilliseconds(config.collapsed_request_timeout()));
+  }
+}
 
 void CacheFilter::onDestroy() {
   filter_state_ = FilterState::Destroyed;
+  if (collapse_state_ == CollapseState::Waiting) {
+    collapse_state_ = CollapseState::Done;
+    collapse_timer_.reset();
+    cache_->requestCollapser().cancelWait(*collapse_key_, waiter_id_);
+  }
+  // Wake up the requests waiting for this one, whether or not its response was inserted.
+  completeFill();
   if (lookup_) {
     lookup_->onDestroy();
   }
@@ -83,6 +96,9 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
   LookupRequest lookup_request(headers, time_source_.systemTime(), vary_allow_list_);
   request_allows_inserts_ = !lookup_request.requestCacheControl().no_store_;
   is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
+  if (collapsed_request_timeout_.has_value()) {
+    collapse_key_ = lookup_request.key();
+  }
   lookup_ = cache_->makeLookupContext(std::move(lookup_request), *decoder_callbacks_);
 
   ASSERT(lookup_);
@@ -151,6 +167,9 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
   } else {
     insert_status_ = InsertStatus::NoInsertResponseNotCacheable;
   }
+  if (insert_status_.has_value()) {
+    completeFill();
+  }
   filter_state_ = FilterState::NotServingFromCache;
   return Http::FilterHeadersStatus::Continue;
 }
@@ -172,6 +191,7 @@ Http::FilterDataStatus CacheFilter::encodeData(Buffer::Instance& data, bool end_
         data, [](bool) {}, end_stream);
     if (end_stream) {
       insert_status_ = InsertStatus::InsertSucceeded;
+      completeFill();
     }
     // insert_status_ remains absl::nullopt if end_stream == false, as we have not completed the
     // insertion yet.
@@ -195,6 +215,7 @@ Http::FilterTrailersStatus CacheFilter::encodeTrailers(Http::ResponseTrailerMap&
     insert_->insertTrailers(trailers, [](bool) {});
   }
   insert_status_ = InsertStatus::InsertSucceeded;
+  completeFill();
 
   return Http::FilterTrailersStatus::Continue;
 }
@@ -401,6 +422,11 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
     handleCacheHit();
     return;
   case CacheEntryStatus::Unusable:
+    if (waitForFill(request_headers)) {
+      // The lookup is redone once the fill completes, so this one is treated as still outstanding.
+      lookup_result_.reset();
+      return;
+    }
     decoder_callbacks_->continueDecoding();
     return;
   case CacheEntryStatus::LookupError:
@@ -669,6 +695,80 @@ void CacheFilter::encodeCachedResponse() {
   }
 }
 
+bool CacheFilter::waitForFill(Http::RequestHeaderMap& request_headers) {
+  // Only requests whose response may be inserted can fill the cache for the others.
+  if (!collapse_key_.has_value() || collapse_state_ != CollapseState::None ||
+      !request_allows_inserts_ || is_head_request_) {
+    return false;
+  }
+  CacheFilterWeakPtr self = weak_from_this();
+  Event::Dispatcher& dispatcher = decoder_callbacks_->dispatcher();
+  // As in getHeaders, the callback is posted to this worker's dispatcher and may run after the
+  // filter is destroyed, hence the weak_ptr.
+  if (cache_->requestCollapser().startFillOrWait(
+          *collapse_key_, dispatcher,
+          [self, &request_headers]() {
+            if (CacheFilterSharedPtr cache_filter = self.lock()) {
+              cache_filter->onFillComplete(request_headers);
+            }
+          },
+          waiter_id_)) {
+    ENVOY_STREAM_LOG(debug, "CacheFilter::waitForFill filling the cache", *decoder_callbacks_);
+    collapse_state_ = CollapseState::Filling;
+    return false;
+  }
+  ENVOY_STREAM_LOG(debug, "CacheFilter::waitForFill waiting for a fill in progress",
+                   *decoder_callbacks_);
+  collapse_state_ = CollapseState::Waiting;
+  collapse_timer_ = dispatcher.createTimer([this]() { onFillTimeout(); });
+  collapse_timer_->enableTimer(collapsed_request_timeout_.value());
+  return true;
+}
+
+void CacheFilter::onFillComplete(Http::RequestHeaderMap& request_headers) {
+  if (collapse_state_ != CollapseState::Waiting) {
+    // The wait timed out, or the filter is being destroyed.
+    return;
+  }
+  collapse_state_ = CollapseState::Done;
+  collapse_timer_.reset();
+  if (filter_state_ == FilterState::NotServingFromCache) {
+    // A response was injected into the filter chain while waiting.
+    return;
+  }
+  // Look the cache up again, now that the response may be in it. A miss this time is forwarded
+  // upstream without waiting again.
+  ENVOY_STREAM_LOG(debug, "CacheFilter::onFillComplete redoing lookup", *decoder_callbacks_);
+  lookup_->onDestroy();
+  lookup_ = cache_->makeLookupContext(
+      LookupRequest(request_headers, time_source_.systemTime(), vary_allow_list_),
+      *decoder_callbacks_);
+  getHeaders(request_headers);
+}
+
+void CacheFilter::onFillTimeout() {
+  ASSERT(collapse_state_ == CollapseState::Waiting);
+  ENVOY_STREAM_LOG(debug, "CacheFilter::onFillTimeout forwarding request upstream",
+                   *decoder_callbacks_);
+  cache_->requestCollapser().cancelWait(*collapse_key_, waiter_id_);
+  collapse_state_ = CollapseState::Done;
+  collapse_timer_.reset();
+  if (filter_state_ == FilterState::NotServingFromCache) {
+    // A response was injected into the filter chain while waiting.
+    return;
+  }
+  // Proceed as for a miss.
+  lookup_result_ = std::make_unique<LookupResult>();
+  decoder_callbacks_->continueDecoding();
+}
+
+void CacheFilter::completeFill() {
+  if (collapse_state_ == CollapseState::Filling) {
+    collapse_state_ = CollapseState::Done;
+    cache_->requestCollapser().completeFill(*collapse_key_);
+  }
+}
+
 void CacheFilter::finalizeEncodingCachedResponse() {
   if (filter_state_ == FilterState::EncodeServingFromCache) {
     // encodeHeaders returned StopIteration waiting for finishing encoding the cached response --
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "envoy/event/timer.h"
 #include "envoy/extensions/filters/http/cache/v3/cache.pb.h"
 
 #include "source/common/common/logger.h"
@@ -81,6 +83,18 @@ private:
   void onBody(Buffer::InstancePtr&& body);
   void onTrailers(Http::ResponseTrailerMapPtr&& trailers);
 
+  // Precondition: the lookup missed.
+  // If requests are collapsed, either starts filling the cache for the other requests missing the
+  // same key and returns false, or waits for the fill in progress and returns true.
+  bool waitForFill(Http::RequestHeaderMap& request_headers);
+
+  // Callbacks for when the fill the request waits for completes, or the wait times out.
+  void onFillComplete(Http::RequestHeaderMap& request_headers);
+  void onFillTimeout();
+
+  // Wakes up the requests waiting for this one to fill the cache, if any.
+  void completeFill();
+
   // Set required state in the CacheFilter for handling a cache hit.
   void handleCacheHit();
 
@@ -154,6 +168,24 @@ private:
   FilterState filter_state_ = FilterState::Initial;
 
   bool is_head_request_ = false;
+
+  // How this request takes part in collapsing the concurrent misses for its key.
+  enum class CollapseState {
+    None,
+    // This request fills the cache for the others.
+    Filling,
+    // This request waits for another one to fill the cache.
+    Waiting,
+    // The fill completed or the wait timed out; the request won't fill or wait again.
+    Done
+  };
+  // Set if concurrent misses are collapsed.
+  absl::optional<std::chrono::milliseconds> collapsed_request_timeout_;
+  absl::optional<Key> collapse_key_;
+  CollapseState collapse_state_ = CollapseState::None;
+  RequestCollapser::WaiterId waiter_id_ = 0;
+  Event::TimerPtr collapse_timer_;
+
   // The status of the insert operation or header update, or decision not to insert or update.
   // If it's too early to determine the final status, this is empty.
   absl::optional<InsertStatus> insert_status_;
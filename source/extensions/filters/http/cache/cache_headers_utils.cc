@@ -3,9 +3,11 @@
 #include <array>
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include "envoy/http/header_map.h"
 
+#include "source/common/common/utility.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/header_utility.h"
 #include "source/extensions/filters/http/cache/cache_custom_headers.h"
@@ -13,7 +15,10 @@
 #include "absl/algorithm/container.h"
 #include "absl/container/btree_set.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 
 namespace Envoy {
@@ -302,6 +307,33 @@ constexpr absl::string_view headerSeparator = "\n";
 constexpr absl::string_view inValueSeparator = "\r";
 }; // namespace
 
+std::string VaryHeaderUtils::canonicalizeAcceptEncoding(absl::string_view value) {
+  absl::btree_set<std::string> codings;
+  for (absl::string_view token : StringUtil::splitToken(value, ",", /*keep_empty_string=*/false)) {
+    std::vector<absl::string_view> parts = absl::StrSplit(token, ';');
+    std::string coding = absl::AsciiStrToLower(StringUtil::trim(parts[0]));
+    if (coding.empty()) {
+      continue;
+    }
+    for (size_t i = 1; i < parts.size(); i++) {
+      const absl::string_view param = StringUtil::trim(parts[i]);
+      float q_value;
+      if (absl::EqualsIgnoreCase(StringUtil::trim(StringUtil::cropRight(param, "=")), "q") &&
+          absl::SimpleAtof(StringUtil::trim(StringUtil::cropLeft(param, "=")), &q_value)) {
+        // "q=1" is the default, and equivalent spellings such as "q=0.50" and "q=0.5" are
+        // written the same way.
+        if (q_value != 1) {
+          absl::StrAppend(&coding, ";q=", q_value);
+        }
+      } else if (!param.empty()) {
+        absl::StrAppend(&coding, ";", absl::AsciiStrToLower(param));
+      }
+    }
+    codings.insert(std::move(coding));
+  }
+  return absl::StrJoin(codings, ",");
+}
+
 absl::optional<std::string>
 VaryHeaderUtils::createVaryIdentifier(const VaryAllowList& allow_list,
                                       const absl::btree_set<absl::string_view>& vary_header_values,
@@ -332,6 +364,18 @@ VaryHeaderUtils::createVaryIdentifier(const VaryAllowList& allow_list,
     // UserAgent::initializeFromHeaders tries to do that normalization and could
     // be used as an inspiration for some bucketing configuration. The config
     // should enable and control the bucketing wanted.
+    if (value == Http::CustomHeaders::get().AcceptEncoding.get()) {
+      // Multiple accept-encoding headers are equivalent to one with their values joined by
+      // commas, so combine them before canonicalizing.
+      const auto all_values = Http::HeaderUtility::getAllOfHeaderAsString(
+          request_headers, Http::CustomHeaders::get().AcceptEncoding, ",");
+      absl::StrAppend(&vary_identifier, value, inValueSeparator,
+                      all_values.result().has_value()
+                          ? canonicalizeAcceptEncoding(all_values.result().value())
+                          : "",
+                      headerSeparator);
+      continue;
+    }
     const auto all_values = Http::HeaderUtility::getAllOfHeaderAsString(
         request_headers, Http::LowerCaseString(std::string(value)), inValueSeparator);
     absl::StrAppend(&vary_identifier, value, inValueSeparator,
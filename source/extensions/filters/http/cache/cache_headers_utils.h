@@ -145,6 +145,13 @@ bool hasVary(const Http::ResponseHeaderMap& headers);
 // map across all vary header entries.
 absl::btree_set<absl::string_view> getVaryValues(const Envoy::Http::ResponseHeaderMap& headers);
 
+// Returns the given accept-encoding header value in a canonical form: the codings
+// lowercased and without whitespace, their q-values kept only if not 1, sorted and
+// deduplicated. Accept-encoding values that only differ in that form are equivalent, so
+// responses that vary on accept-encoding, such as those from the compressor filter, are
+// cached once per set of accepted codings, rather than once per spelling of the header.
+std::string canonicalizeAcceptEncoding(absl::string_view value);
+
 // Creates a single string combining the values of the varied headers from
 // entry_headers. Returns an absl::nullopt if no valid vary key can be created
 // and the response should not be cached (eg. when disallowed vary headers are
@@ -17,6 +17,7 @@
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/filters/http/cache/key.pb.h"
 #include "source/extensions/filters/http/cache/range_utils.h"
+#include "source/extensions/filters/http/cache/request_collapser.h"
 
 #include "absl/strings/string_view.h"
 
@@ -263,7 +264,14 @@ public:
   // Returns statically known information about a cache.
   virtual CacheInfo cacheInfo() const PURE;
 
+  // Returns the coordinator that cache filters on all workers use to collapse concurrent misses
+  // for the same key into a single fill of this cache.
+  RequestCollapser& requestCollapser() { return request_collapser_; }
+
   virtual ~HttpCache() = default;
+
+private:
+  RequestCollapser request_collapser_;
 };
 
 // Factory interface for cache implementations to implement and register.
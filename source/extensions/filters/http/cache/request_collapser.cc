@@ -0,0 +1,59 @@
+#include "source/extensions/filters/http/cache/request_collapser.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+bool RequestCollapser::startFillOrWait(const Key& key, Event::Dispatcher& dispatcher,
+                                       std::function<void()> on_fill_complete,
+                                       WaiterId& waiter_id) {
+  absl::MutexLock lock(&mutex_);
+  auto [it, inserted] = fills_.try_emplace(key);
+  if (inserted) {
+    return true;
+  }
+  waiter_id = next_waiter_id_++;
+  it->second.push_back(Waiter{waiter_id, &dispatcher, std::move(on_fill_complete)});
+  return false;
+}
+
+void RequestCollapser::completeFill(const Key& key) {
+  std::vector<Waiter> waiters;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = fills_.find(key);
+    ASSERT(it != fills_.end(), "Completing a fill that wasn't started.");
+    if (it == fills_.end()) {
+      return;
+    }
+    waiters = std::move(it->second);
+    fills_.erase(it);
+  }
+  // Post outside of the lock, so that dispatchers aren't posted to while holding it.
+  for (Waiter& waiter : waiters) {
+    waiter.dispatcher_->post(std::move(waiter.on_fill_complete_));
+  }
+}
+
+void RequestCollapser::cancelWait(const Key& key, WaiterId waiter_id) {
+  absl::MutexLock lock(&mutex_);
+  auto it = fills_.find(key);
+  if (it == fills_.end()) {
+    return;
+  }
+  std::vector<Waiter>& waiters = it->second;
+  waiters.erase(
+      std::remove_if(waiters.begin(), waiters.end(),
+                     [waiter_id](const Waiter& waiter) { return waiter.id_ == waiter_id; }),
+      waiters.end());
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/key.pb.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+// Collapses concurrent cache misses for the same key, from any worker, into a single fill: the
+// first request to miss is forwarded upstream and its response inserted in the cache, while the
+// others wait for that fill to complete and then look the cache up again. Thread-safe.
+class RequestCollapser {
+public:
+  using WaiterId = uint64_t;
+
+  // If no fill of key is in progress, starts one for the caller and returns true. Otherwise returns
+  // false, in which case on_fill_complete will be posted to dispatcher once the fill in progress
+  // completes, unless cancelWait(key, waiter_id) is called first.
+  bool startFillOrWait(const Key& key, Event::Dispatcher& dispatcher,
+                       std::function<void()> on_fill_complete, WaiterId& waiter_id);
+
+  // Completes the fill of key started by startFillOrWait, waking up the requests waiting for it.
+  void completeFill(const Key& key);
+
+  // Stops waiting for the fill of key. It's fine to call this after the fill completed.
+  void cancelWait(const Key& key, WaiterId waiter_id);
+
+private:
+  struct Waiter {
+    WaiterId id_;
+    Event::Dispatcher* dispatcher_;
+    std::function<void()> on_fill_complete_;
+  };
+
+  absl::Mutex mutex_;
+  // The requests waiting for each fill in progress.
+  absl::flat_hash_map<Key, std::vector<Waiter>, MessageUtil, MessageUtil>
+      fills_ ABSL_GUARDED_BY(mutex_);
+  WaiterId next_waiter_id_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -6,6 +6,7 @@
 #include "envoy/event/timer.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
 #include "source/common/common/token_bucket_impl.h"
 
 namespace Envoy {
@@ -13,22 +14,86 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Common {
 
+StreamRateLimiterScheduler::StreamRateLimiterScheduler(Event::Dispatcher& dispatcher,
+                                                       std::chrono::milliseconds fill_interval)
+    : dispatcher_(dispatcher), fill_interval_(fill_interval),
+      ready_timer_(dispatcher.createTimer([this] { onReadyTimer(); })),
+      round_timer_(dispatcher.createTimer([this] { onRoundTimer(); })) {}
+
+void StreamRateLimiterScheduler::scheduleNow(StreamRateLimiter& limiter) {
+  schedule(limiter, ready_);
+  if (!ready_timer_->enabled()) {
+    ready_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+}
+
+void StreamRateLimiterScheduler::scheduleNextRound(StreamRateLimiter& limiter) {
+  schedule(limiter, waiting_);
+  if (!round_timer_->enabled()) {
+    round_timer_->enableTimer(fill_interval_);
+  }
+}
+
+void StreamRateLimiterScheduler::schedule(StreamRateLimiter& limiter, EntryList& list) {
+  ASSERT(limiter.scheduled_list_ == nullptr);
+  limiter.scheduled_list_ = &list;
+  limiter.scheduled_entry_ = list.insert(list.end(), {&limiter, round_});
+}
+
+void StreamRateLimiterScheduler::cancel(StreamRateLimiter& limiter) {
+  if (limiter.scheduled_list_ != nullptr) {
+    limiter.scheduled_list_->erase(limiter.scheduled_entry_);
+    limiter.scheduled_list_ = nullptr;
+  }
+}
+
+void StreamRateLimiterScheduler::service(EntryList& list) {
+  StreamRateLimiter& limiter = *list.front().limiter_;
+  list.pop_front();
+  limiter.scheduled_list_ = nullptr;
+  const ScopeTrackerScopeState scope(&limiter.scope_, dispatcher_);
+  limiter.onTokenTimer();
+}
+
+void StreamRateLimiterScheduler::onReadyTimer() {
+  while (!ready_.empty()) {
+    service(ready_);
+  }
+}
+
+void StreamRateLimiterScheduler::onRoundTimer() {
+  // The limiters rescheduled while servicing the round wait for the next one.
+  const uint64_t round = round_++;
+  while (!waiting_.empty() && waiting_.front().round_ <= round) {
+    service(waiting_);
+  }
+  // The first limiter of a round may take all the tokens of a shared bucket, so the next round
+  // starts with the limiter after it.
+  if (waiting_.size() > 1) {
+    waiting_.splice(waiting_.end(), waiting_, waiting_.begin());
+  }
+}
+
 StreamRateLimiter::StreamRateLimiter(
     uint64_t max_kbps, uint64_t max_buffered_data, std::function<void()> pause_data_cb,
     std::function<void()> resume_data_cb,
     std::function<void(Buffer::Instance&, bool)> write_data_cb, std::function<void()> continue_cb,
     std::function<void(uint64_t, bool, std::chrono::milliseconds)> write_stats_cb,
     TimeSource& time_source, Event::Dispatcher& dispatcher, const ScopeTrackedObject& scope,
-    std::shared_ptr<TokenBucket> token_bucket, std::chrono::milliseconds fill_interval)
+    std::shared_ptr<TokenBucket> token_bucket, std::chrono::milliseconds fill_interval,
+    StreamRateLimiterScheduler* scheduler)
     : fill_interval_(std::move(fill_interval)), write_data_cb_(write_data_cb),
       continue_cb_(continue_cb), write_stats_cb_(std::move(write_stats_cb)), scope_(scope),
       token_bucket_(std::move(token_bucket)),
-      token_timer_(dispatcher.createTimer([this] { onTokenTimer(); })),
+      token_timer_(scheduler == nullptr ? dispatcher.createTimer([this] { onTokenTimer(); })
+                                        : nullptr),
+      scheduler_(scheduler),
       buffer_(resume_data_cb, pause_data_cb,
               []() -> void { /* TODO(adisuissa): Handle overflow watermark */ }) {
   ASSERT(max_buffered_data > 0);
   ASSERT(fill_interval_.count() > 0);
   ASSERT(fill_interval_.count() <= 1000);
+  ASSERT(scheduler_ == nullptr || scheduler_->fillInterval() == fill_interval_);
   auto max_tokens = kiloBytesToBytes(max_kbps);
   if (!token_bucket_) {
     // Initialize a  new token bucket if caller didn't provide one.
@@ -74,7 +139,7 @@ void StreamRateLimiter::onTokenTimer() {
               "StreamRateLimiter <onTokenTimer>: scheduling wakeup for {}ms, "
               "buffered={}",
               fill_interval_.count(), buffer_.length());
-    token_timer_->enableTimer(fill_interval_, &scope_);
+    enableTokenTimer(fill_interval_);
   }
 
   // Write the data out, indicating end stream if we saw end stream, there is no further data to
@@ -103,14 +168,14 @@ void StreamRateLimiter::writeData(Buffer::Instance& incoming_buffer, bool end_st
   ENVOY_LOG(debug,
             "StreamRateLimiter <writeData>: got new {} bytes of data. token "
             "timer {} scheduled.",
-            len, !token_timer_->enabled() ? "now" : "already");
-  if (!token_timer_->enabled()) {
+            len, !tokenTimerEnabled() ? "now" : "already");
+  if (!tokenTimerEnabled()) {
     // TODO(mattklein123): In an optimal world we would be able to continue iteration with the data
     // we want in the buffer, but have a way to clear end_stream in case we can't send it all.
     // The filter API does not currently support that and it will not be a trivial change to add.
     // Instead we cheat here by scheduling the token timer to run immediately after the stack is
     // unwound, at which point we can directly called encode/decodeData.
-    token_timer_->enableTimer(std::chrono::milliseconds(0), &scope_);
+    enableTokenTimer(std::chrono::milliseconds(0));
   }
 }
 
@@ -119,6 +184,29 @@ bool StreamRateLimiter::onTrailers() {
   saw_trailers_ = true;
   return buffer_.length() > 0;
 }
+
+void StreamRateLimiter::destroy() {
+  token_timer_.reset();
+  if (scheduler_ != nullptr) {
+    scheduler_->cancel(*this);
+    scheduler_ = nullptr;
+  }
+  destroyed_ = true;
+}
+
+void StreamRateLimiter::enableTokenTimer(std::chrono::milliseconds delay) {
+  if (scheduler_ == nullptr) {
+    token_timer_->enableTimer(delay, &scope_);
+  } else if (delay.count() == 0) {
+    scheduler_->scheduleNow(*this);
+  } else {
+    scheduler_->scheduleNextRound(*this);
+  }
+}
+
+bool StreamRateLimiter::tokenTimerEnabled() const {
+  return scheduler_ == nullptr ? token_timer_->enabled() : scheduled_list_ != nullptr;
+}
 } // namespace Common
 } // namespace HttpFilters
 } // namespace Extensions
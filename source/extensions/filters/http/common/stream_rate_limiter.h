@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,6 +23,57 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Common {
 
+class StreamRateLimiter;
+
+/**
+ * Services the StreamRateLimiters of a worker which wait for tokens in rounds, one every fill
+ * interval, instead of each limiter running its own token timer. The limiters still waiting after
+ * their turn go to the back of the next round, so that the streams sharing a token bucket take
+ * turns being the first to consume from it.
+ */
+class StreamRateLimiterScheduler {
+public:
+  StreamRateLimiterScheduler(Event::Dispatcher& dispatcher,
+                             std::chrono::milliseconds fill_interval);
+
+  std::chrono::milliseconds fillInterval() const { return fill_interval_; }
+
+  /**
+   * @return the number of limiters waiting to be serviced.
+   */
+  size_t scheduledLimiters() const { return ready_.size() + waiting_.size(); }
+
+private:
+  friend class StreamRateLimiter;
+
+  struct Entry {
+    StreamRateLimiter* limiter_;
+    // The round the limiter started waiting in.
+    uint64_t round_;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Services the limiter as soon as the current callback returns.
+  void scheduleNow(StreamRateLimiter& limiter);
+  // Services the limiter in the next round.
+  void scheduleNextRound(StreamRateLimiter& limiter);
+  void cancel(StreamRateLimiter& limiter);
+  void schedule(StreamRateLimiter& limiter, EntryList& list);
+  void service(EntryList& list);
+  void onReadyTimer();
+  void onRoundTimer();
+
+  Event::Dispatcher& dispatcher_;
+  const std::chrono::milliseconds fill_interval_;
+  const Event::TimerPtr ready_timer_;
+  const Event::TimerPtr round_timer_;
+  EntryList ready_;
+  EntryList waiting_;
+  uint64_t round_{};
+};
+
+using StreamRateLimiterSchedulerSharedPtr = std::shared_ptr<StreamRateLimiterScheduler>;
+
 /**
  * A generic HTTP stream rate limiter. It limits the rate of transfer for a stream to the specified
  * max rate. It calls appropriate callbacks when the buffered data crosses certain high and low
@@ -45,6 +97,11 @@ public:
    * @param time_source the time source to run the token bucket with.
    * @param dispatcher the stream's dispatcher to use for creating timers.
    * @param scope the stream's scope
+   * @param token_bucket the token bucket to consume from, a bucket of max_kbps is created if null.
+   * @param fill_interval the interval at which the token bucket is consumed from.
+   * @param scheduler the scheduler of the worker to service the limiter in its rounds, with the
+   *                  same fill interval, instead of a token timer of its own. It must outlive the
+   *                  limiter.
    */
   StreamRateLimiter(uint64_t max_kbps, uint64_t max_buffered_data,
                     std::function<void()> pause_data_cb, std::function<void()> resume_data_cb,
@@ -54,7 +111,9 @@ public:
                     TimeSource& time_source, Event::Dispatcher& dispatcher,
                     const ScopeTrackedObject& scope,
                     std::shared_ptr<TokenBucket> token_bucket = nullptr,
-                    std::chrono::milliseconds fill_interval = DefaultFillInterval);
+                    std::chrono::milliseconds fill_interval = DefaultFillInterval,
+                    StreamRateLimiterScheduler* scheduler = nullptr);
+  ~StreamRateLimiter() { destroy(); }
 
   /**
    * Called by the stream to write data. All data writes happen asynchronously, the stream should
@@ -72,14 +131,17 @@ public:
    * Like the owning filter, we must handle inline destruction, so we have a destroy() method which
    * kills any callbacks.
    */
-  void destroy() { token_timer_.reset(); }
-  bool destroyed() { return token_timer_ == nullptr; }
+  void destroy();
+  bool destroyed() { return destroyed_; }
 
 private:
   friend class StreamRateLimiterTest;
+  friend class StreamRateLimiterScheduler;
   using TimerPtr = std::unique_ptr<Event::Timer>;
 
   void onTokenTimer();
+  void enableTokenTimer(std::chrono::milliseconds delay);
+  bool tokenTimerEnabled() const;
 
   const std::chrono::milliseconds fill_interval_;
   const std::function<void(Buffer::Instance&, bool)> write_data_cb_;
@@ -88,6 +150,11 @@ private:
   const ScopeTrackedObject& scope_;
   std::shared_ptr<TokenBucket> token_bucket_;
   Event::TimerPtr token_timer_;
+  StreamRateLimiterScheduler* scheduler_;
+  // The list of the scheduler the limiter waits in, if any, and its entry in it.
+  StreamRateLimiterScheduler::EntryList* scheduled_list_{};
+  StreamRateLimiterScheduler::EntryList::iterator scheduled_entry_;
+  bool destroyed_{};
   bool saw_end_stream_{};
   bool saw_trailers_{};
   Buffer::WatermarkBuffer buffer_;
@@ -57,7 +57,9 @@ DecompressorFilterConfig::ResponseDirectionConfig::ResponseDirectionConfig(
     const envoy::extensions::filters::http::decompressor::v3::Decompressor::ResponseDirectionConfig&
         proto_config,
     const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime)
-    : DirectionConfig(proto_config.common_config(), stats_prefix + "response.", scope, runtime) {}
+    : DirectionConfig(proto_config.common_config(), stats_prefix + "response.", scope, runtime),
+      max_decompressed_chunk_size_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_decompressed_chunk_size, 0)) {}
 
 DecompressorFilter::DecompressorFilter(DecompressorFilterConfigSharedPtr config)
     : config_(std::move(config)), request_byte_tracker_(config_->trailersCompressedBytesString(),
@@ -65,6 +67,20 @@ DecompressorFilter::DecompressorFilter(DecompressorFilterConfigSharedPtr config)
       response_byte_tracker_(config_->trailersCompressedBytesString(),
                              config_->trailersUncompressedBytesString()) {}
 
+void DecompressorFilter::onDestroy() {
+  if (watermark_callbacks_added_) {
+    decoder_callbacks_->removeDownstreamWatermarkCallbacks(*this);
+    watermark_callbacks_added_ = false;
+  }
+  // Nothing is encoded anymore, even if the stream is destroyed while a chunk is injected.
+  encoding_response_chunks_ = false;
+  response_trailers_ = nullptr;
+  if (response_chunk_timer_ != nullptr) {
+    response_chunk_timer_->disableTimer();
+    response_chunk_timer_.reset();
+  }
+}
+
 Http::FilterHeadersStatus DecompressorFilter::decodeHeaders(Http::RequestHeaderMap& headers,
                                                             bool end_stream) {
   // Two responsibilities on the request side:
@@ -107,7 +123,7 @@ Http::FilterDataStatus DecompressorFilter::decodeData(Buffer::Instance& data, bo
 Http::FilterTrailersStatus DecompressorFilter::decodeTrailers(Http::RequestTrailerMap& trailers) {
   // Only report if the filter has actually decompressed.
   if (request_decompressor_) {
-    request_byte_tracker_.reportTotalBytes(trailers);
+    request_byte_tracker_.reportTotalBytes(config_->requestDirectionConfig(), trailers);
   }
   return Http::FilterTrailersStatus::Continue;
 }
@@ -120,11 +136,23 @@ Http::FilterHeadersStatus DecompressorFilter::encodeHeaders(Http::ResponseHeader
   }
   ENVOY_STREAM_LOG(debug, "DecompressorFilter::encodeHeaders: {}", *encoder_callbacks_, headers);
 
-  return maybeInitDecompress(config_->responseDirectionConfig(), response_decompressor_,
-                             *encoder_callbacks_, headers);
+  const Http::FilterHeadersStatus status = maybeInitDecompress(
+      config_->responseDirectionConfig(), response_decompressor_, *encoder_callbacks_, headers);
+  if (response_decompressor_ && config_->responseDirectionConfig().maxDecompressedChunkSize() > 0) {
+    response_chunk_timer_ =
+        encoder_callbacks_->dispatcher().createTimer([this]() { encodeResponseChunks(); });
+    // The callbacks are immediately notified of the downstream buffers currently above their high
+    // watermark.
+    decoder_callbacks_->addDownstreamWatermarkCallbacks(*this);
+    watermark_callbacks_added_ = true;
+  }
+  return status;
 }
 
 Http::FilterDataStatus DecompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
+  if (response_chunk_timer_ != nullptr) {
+    return decompressResponseInChunks(data, end_stream);
+  }
   if (response_decompressor_) {
     HeaderMapOptRef trailers;
     if (end_stream) {
@@ -138,12 +166,94 @@ Http::FilterDataStatus DecompressorFilter::encodeData(Buffer::Instance& data, bo
 
 Http::FilterTrailersStatus DecompressorFilter::encodeTrailers(Http::ResponseTrailerMap& trailers) {
   // Only report if the filter has actually decompressed.
+  if (encoding_response_chunks_) {
+    // The totals are reported once the chunks left are encoded.
+    response_trailers_ = &trailers;
+    return Http::FilterTrailersStatus::StopIteration;
+  }
   if (response_decompressor_) {
-    response_byte_tracker_.reportTotalBytes(trailers);
+    response_byte_tracker_.reportTotalBytes(config_->responseDirectionConfig(), trailers);
   }
   return Http::FilterTrailersStatus::Continue;
 }
 
+void DecompressorFilter::onAboveWriteBufferHighWatermark() { downstream_high_watermarks_++; }
+
+void DecompressorFilter::onBelowWriteBufferLowWatermark() {
+  ASSERT(downstream_high_watermarks_ > 0);
+  if (--downstream_high_watermarks_ == 0 && encoding_response_chunks_) {
+    response_chunk_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+}
+
+Http::FilterDataStatus DecompressorFilter::decompressResponseInChunks(Buffer::Instance& data,
+                                                                      bool end_stream) {
+  if (end_stream) {
+    response_trailers_ = &encoder_callbacks_->addEncodedTrailers();
+  }
+  response_compressed_data_.move(data);
+  if (encoding_response_chunks_) {
+    // The data is decompressed after the chunks of the previous frames.
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+
+  if (!decompressResponseChunk(data)) {
+    // The frame fits in a single chunk, which continues down the filter chain as usual.
+    if (response_trailers_ != nullptr) {
+      response_byte_tracker_.reportTotalBytes(config_->responseDirectionConfig(),
+                                              *response_trailers_);
+    }
+    return Http::FilterDataStatus::Continue;
+  }
+
+  // Data can only be injected into the filter chain outside of the filter callbacks, so the first
+  // chunk is held until the timer fires along with the others.
+  response_chunk_.move(data);
+  encoding_response_chunks_ = true;
+  if (downstream_high_watermarks_ == 0) {
+    response_chunk_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+  return Http::FilterDataStatus::StopIterationNoBuffer;
+}
+
+void DecompressorFilter::encodeResponseChunks() {
+  // Only a chunk at a time is buffered by the filter; the others stay compressed until the
+  // downstream drains the previous ones.
+  while (encoding_response_chunks_ && downstream_high_watermarks_ == 0) {
+    Buffer::OwnedImpl chunk;
+    if (response_chunk_.length() > 0) {
+      chunk.move(response_chunk_);
+    } else {
+      encoding_response_chunks_ = decompressResponseChunk(chunk);
+    }
+    if (chunk.length() > 0) {
+      encoder_callbacks_->injectEncodedDataToFilterChain(chunk, false);
+    }
+  }
+
+  if (!encoding_response_chunks_ && response_trailers_ != nullptr) {
+    response_byte_tracker_.reportTotalBytes(config_->responseDirectionConfig(),
+                                            *response_trailers_);
+    encoder_callbacks_->continueEncoding();
+  }
+}
+
+bool DecompressorFilter::decompressResponseChunk(Buffer::Instance& chunk) {
+  const DecompressorFilterConfig::ResponseDirectionConfig& direction_config =
+      config_->responseDirectionConfig();
+  const uint64_t compressed_length = response_compressed_data_.length();
+  const bool more = response_decompressor_->decompressBounded(
+      response_compressed_data_, chunk, direction_config.maxDecompressedChunkSize());
+  const uint64_t consumed = compressed_length - response_compressed_data_.length();
+
+  response_byte_tracker_.chargeBytes(consumed, chunk.length());
+  direction_config.stats().total_compressed_bytes_.add(consumed);
+  direction_config.stats().total_uncompressed_bytes_.add(chunk.length());
+  ENVOY_STREAM_LOG(debug, "{} data decompressed from {} bytes to a chunk of {} bytes",
+                   *encoder_callbacks_, direction_config.logString(), consumed, chunk.length());
+  return more;
+}
+
 void DecompressorFilter::decompress(
     const DecompressorFilterConfig::DirectionConfig& direction_config,
     const Compression::Decompressor::DecompressorPtr& decompressor,
@@ -164,7 +274,7 @@ void DecompressorFilter::decompress(
   input_buffer.add(output_buffer);
 
   if (trailers.has_value()) {
-    byte_tracker.reportTotalBytes(trailers.value().get());
+    byte_tracker.reportTotalBytes(direction_config, trailers.value().get());
   }
 }
 
@@ -3,8 +3,11 @@
 #include "envoy/compression/decompressor/config.h"
 #include "envoy/compression/decompressor/decompressor.h"
 #include "envoy/extensions/filters/http/decompressor/v3/decompressor.pb.h"
+#include "envoy/event/timer.h"
 #include "envoy/http/filter.h"
+#include "envoy/stats/stats_macros.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/macros.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
@@ -19,17 +22,18 @@ namespace Decompressor {
 /**
  * All decompressor filter stats. @see stats_macros.h
  */
-#define ALL_DECOMPRESSOR_STATS(COUNTER)                                                            \
+#define ALL_DECOMPRESSOR_STATS(COUNTER, HISTOGRAM)                                                 \
   COUNTER(decompressed)                                                                            \
   COUNTER(not_decompressed)                                                                        \
   COUNTER(total_uncompressed_bytes)                                                                \
-  COUNTER(total_compressed_bytes)
+  COUNTER(total_compressed_bytes)                                                                  \
+  HISTOGRAM(compression_ratio, Percent)
 
 /**
  * Struct definition for decompressor stats. @see stats_macros.h
  */
 struct DecompressorStats {
-  ALL_DECOMPRESSOR_STATS(GENERATE_COUNTER_STRUCT)
+  ALL_DECOMPRESSOR_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 /**
@@ -52,7 +56,8 @@ public:
 
   private:
     static DecompressorStats generateStats(const std::string& prefix, Stats::Scope& scope) {
-      return DecompressorStats{ALL_DECOMPRESSOR_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
+      return DecompressorStats{ALL_DECOMPRESSOR_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                                      POOL_HISTOGRAM_PREFIX(scope, prefix))};
     }
 
     const DecompressorStats stats_;
@@ -89,6 +94,13 @@ public:
     const std::string& logString() const override {
       CONSTRUCT_ON_FIRST_USE(std::string, "response");
     }
+
+    // The size of the chunks the response is decompressed in, or 0 to decompress each data frame
+    // at once.
+    uint32_t maxDecompressedChunkSize() const { return max_decompressed_chunk_size_; }
+
+  private:
+    const uint32_t max_decompressed_chunk_size_;
   };
 
   DecompressorFilterConfig(
@@ -126,10 +138,14 @@ using DecompressorFilterConfigSharedPtr = std::shared_ptr<DecompressorFilterConf
  * A filter that decompresses data bidirectionally.
  */
 class DecompressorFilter : public Http::PassThroughFilter,
+                           public Http::DownstreamWatermarkCallbacks,
                            public Logger::Loggable<Logger::Id::filter> {
 public:
   DecompressorFilter(DecompressorFilterConfigSharedPtr config);
 
+  // Http::StreamFilterBase
+  void onDestroy() override;
+
   // Http::StreamDecoderFilter
   Http::FilterHeadersStatus decodeHeaders(Http::RequestHeaderMap&, bool) override;
   Http::FilterDataStatus decodeData(Buffer::Instance&, bool) override;
@@ -140,6 +156,10 @@ public:
   Http::FilterDataStatus encodeData(Buffer::Instance&, bool) override;
   Http::FilterTrailersStatus encodeTrailers(Http::ResponseTrailerMap&) override;
 
+  // Http::DownstreamWatermarkCallbacks
+  void onAboveWriteBufferHighWatermark() override;
+  void onBelowWriteBufferLowWatermark() override;
+
 private:
   struct ByteTracker {
     ByteTracker(const Http::LowerCaseString& compressed_bytes_trailer,
@@ -150,9 +170,14 @@ private:
       total_compressed_bytes_ += compressed_bytes;
       total_uncompressed_bytes_ += uncompressed_bytes;
     }
-    void reportTotalBytes(Http::HeaderMap& trailers) const {
+    void reportTotalBytes(const DecompressorFilterConfig::DirectionConfig& direction_config,
+                          Http::HeaderMap& trailers) const {
       trailers.addReferenceKey(compressed_bytes_trailer_, total_compressed_bytes_);
       trailers.addReferenceKey(uncompressed_bytes_trailer_, total_uncompressed_bytes_);
+      if (total_uncompressed_bytes_ > 0) {
+        direction_config.stats().compression_ratio_.recordValue(
+            total_compressed_bytes_ * Stats::Histogram::PercentScale / total_uncompressed_bytes_);
+      }
     }
 
   private:
@@ -197,6 +222,14 @@ private:
                   Http::StreamFilterCallbacks& callbacks, Buffer::Instance& input_buffer,
                   ByteTracker& byte_tracker, HeaderMapOptRef trailers) const;
 
+  // Decompresses the response in chunks of at most maxDecompressedChunkSize() bytes. The chunks
+  // left once `data` is processed are encoded by encodeResponseChunks() after the filter callback
+  // returns, while the downstream is below its high watermark.
+  Http::FilterDataStatus decompressResponseInChunks(Buffer::Instance& data, bool end_stream);
+  void encodeResponseChunks();
+  // Decompresses the next chunk of the response, and returns whether more chunks are left.
+  bool decompressResponseChunk(Buffer::Instance& chunk);
+
   // TODO(junr03): These can be shared between compressor and decompressor.
   template <Http::CustomInlineHeaderRegistry::Type Type>
   static Http::CustomInlineHeaderRegistry::Handle<Type> getCacheControlHandle();
@@ -242,6 +275,15 @@ private:
   Compression::Decompressor::DecompressorPtr response_decompressor_{};
   ByteTracker request_byte_tracker_;
   ByteTracker response_byte_tracker_;
+
+  // State of the decompression of the response in chunks.
+  Buffer::OwnedImpl response_compressed_data_;
+  Buffer::OwnedImpl response_chunk_;
+  Http::ResponseTrailerMap* response_trailers_{};
+  Event::TimerPtr response_chunk_timer_;
+  uint32_t downstream_high_watermarks_{};
+  bool encoding_response_chunks_{};
+  bool watermark_callbacks_added_{};
 };
 
 } // namespace Decompressor
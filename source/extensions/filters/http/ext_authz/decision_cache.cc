@@ -0,0 +1,169 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include <algorithm>
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+namespace {
+
+constexpr uint32_t DefaultMaxEntries = 10000;
+
+uint32_t maxEntries(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config) {
+  return PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries);
+}
+
+// Appends value to key, prefixed by its length so that the key can't be ambiguous.
+void appendToKey(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value);
+}
+
+} // namespace
+
+DecisionCache::DecisionCache(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source, Stats::Scope& scope,
+    const std::string& stats_prefix)
+    : key_headers_(config.key_headers().begin(), config.key_headers().end()),
+      ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)),
+      denied_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, denied_ttl, 0)),
+      ttl_metadata_key_(config.ttl_metadata_key()), time_source_(time_source),
+      stats_{ALL_EXT_AUTHZ_DECISION_CACHE_STATS(POOL_COUNTER_PREFIX(scope, stats_prefix))},
+      tls_(tls), shared_(maxEntries(config)) {
+  tls_.set([max_entries = maxEntries(config)](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalLru>(max_entries);
+  });
+}
+
+absl::optional<std::string>
+DecisionCache::key(const Http::RequestHeaderMap& headers,
+                   const envoy::service::auth::v3::CheckRequest& request) const {
+  const auto& http_request = request.attributes().request().http();
+  if (!http_request.body().empty() || !http_request.raw_body().empty()) {
+    // The decision may depend on the body, which isn't part of the key.
+    return absl::nullopt;
+  }
+
+  std::string key;
+  for (const Http::LowerCaseString& name : key_headers_) {
+    const Http::HeaderMap::GetResult values = headers.get(name);
+    // The number of values distinguishes a missing header from an empty one.
+    absl::StrAppend(&key, values.size(), ";");
+    for (size_t i = 0; i < values.size(); i++) {
+      appendToKey(key, values[i]->value().getStringView());
+    }
+  }
+
+  // The context extensions are set by the route, and the decisions may depend on them.
+  const auto& context_extensions = request.attributes().context_extensions();
+  std::vector<std::pair<absl::string_view, absl::string_view>> sorted_extensions(
+      context_extensions.begin(), context_extensions.end());
+  std::sort(sorted_extensions.begin(), sorted_extensions.end());
+  for (const auto& [name, value] : sorted_extensions) {
+    appendToKey(key, name);
+    appendToKey(key, value);
+  }
+  return key;
+}
+
+ResponseSharedPtr DecisionCache::lookup(const std::string& key) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (absl::optional<Decision> decision = tls_->lru_.get(key, now); decision.has_value()) {
+    stats_.hit_.inc();
+    return decision->response_;
+  }
+
+  absl::optional<Decision> decision;
+  {
+    absl::MutexLock lock(&shared_mutex_);
+    decision = shared_.get(key, now);
+  }
+  if (!decision.has_value()) {
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  stats_.hit_.inc();
+  stats_.shared_hit_.inc();
+  stats_.evicted_.add(tls_->lru_.put(key, *decision));
+  return decision->response_;
+}
+
+void DecisionCache::insert(const std::string& key,
+                           const Filters::Common::ExtAuthz::Response& response) {
+  const std::chrono::milliseconds decision_ttl = ttl(response);
+  if (decision_ttl.count() <= 0) {
+    return;
+  }
+
+  const Decision decision{std::make_shared<const Filters::Common::ExtAuthz::Response>(response),
+                          time_source_.monotonicTime() + decision_ttl};
+  stats_.insert_.inc();
+  stats_.evicted_.add(tls_->lru_.put(key, decision));
+  uint64_t shared_evicted;
+  {
+    absl::MutexLock lock(&shared_mutex_);
+    shared_evicted = shared_.put(key, decision);
+  }
+  stats_.evicted_.add(shared_evicted);
+}
+
+std::chrono::milliseconds
+DecisionCache::ttl(const Filters::Common::ExtAuthz::Response& response) const {
+  std::chrono::milliseconds decision_ttl{0};
+  switch (response.status) {
+  case Filters::Common::ExtAuthz::CheckStatus::OK:
+    decision_ttl = ttl_;
+    break;
+  case Filters::Common::ExtAuthz::CheckStatus::Denied:
+    decision_ttl = denied_ttl_;
+    break;
+  case Filters::Common::ExtAuthz::CheckStatus::Error:
+    return std::chrono::milliseconds::zero();
+  }
+
+  if (!ttl_metadata_key_.empty()) {
+    const auto& fields = response.dynamic_metadata.fields();
+    if (const auto it = fields.find(ttl_metadata_key_);
+        it != fields.end() && it->second.kind_case() == ProtobufWkt::Value::kNumberValue) {
+      const auto response_ttl = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::duration<double>(std::max(it->second.number_value(), 0.0)));
+      decision_ttl = std::min(decision_ttl, response_ttl);
+    }
+  }
+  return decision_ttl;
+}
+
+absl::optional<DecisionCache::Decision> DecisionCache::Lru::get(const std::string& key,
+                                                                MonotonicTime now) {
+  const Decision* decision = map_.get(key);
+  if (decision == nullptr) {
+    return absl::nullopt;
+  }
+  if (decision->expiry_ <= now) {
+    map_.erase(key);
+    return absl::nullopt;
+  }
+  return *decision;
+}
+
+uint64_t DecisionCache::Lru::put(const std::string& key, Decision decision) {
+  *map_.getOrInsert(key).first = std::move(decision);
+
+  uint64_t evicted = 0;
+  while (map_.size() > max_entries_) {
+    map_.eraseLeastRecentlyUsed();
+    evicted++;
+  }
+  return evicted;
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
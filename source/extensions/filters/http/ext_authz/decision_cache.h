@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/service/auth/v3/external_auth.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/lru_map.h"
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+/**
+ * All stats for the ext_authz decision cache. @see stats_macros.h
+ */
+#define ALL_EXT_AUTHZ_DECISION_CACHE_STATS(COUNTER)                                                \
+  COUNTER(hit)                                                                                     \
+  COUNTER(shared_hit)                                                                              \
+  COUNTER(miss)                                                                                    \
+  COUNTER(insert)                                                                                  \
+  COUNTER(evicted)
+
+/**
+ * Wrapper struct for ext_authz decision cache stats. @see stats_macros.h
+ */
+struct DecisionCacheStats {
+  ALL_EXT_AUTHZ_DECISION_CACHE_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+using ResponseSharedPtr = std::shared_ptr<const Filters::Common::ExtAuthz::Response>;
+
+/**
+ * A cache of the decisions of the authorization server. Lookups go to the cache of the current
+ * worker first, and then to the cache shared by the workers, whose hits are copied to the cache
+ * of the worker.
+ */
+class DecisionCache {
+public:
+  DecisionCache(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+                ThreadLocal::SlotAllocator& tls, TimeSource& time_source, Stats::Scope& scope,
+                const std::string& stats_prefix);
+
+  /**
+   * @return the key of the decision for the request, or nullopt if it can't be cached.
+   */
+  absl::optional<std::string> key(const Http::RequestHeaderMap& headers,
+                                  const envoy::service::auth::v3::CheckRequest& request) const;
+
+  /**
+   * @return the cached decision for key, or nullptr if there is none.
+   */
+  ResponseSharedPtr lookup(const std::string& key);
+
+  /**
+   * Caches the decision for key, unless it is an error or its TTL is not positive.
+   */
+  void insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response);
+
+  const DecisionCacheStats& stats() const { return stats_; }
+
+private:
+  struct Decision {
+    ResponseSharedPtr response_;
+    MonotonicTime expiry_;
+  };
+
+  // The decisions of one worker, or the ones shared by the workers, evicting the least recently
+  // used decisions beyond max_entries.
+  class Lru {
+  public:
+    explicit Lru(uint32_t max_entries) : max_entries_(max_entries) {}
+
+    // Returns the unexpired decision for key, if any. Expired decisions are removed.
+    absl::optional<Decision> get(const std::string& key, MonotonicTime now);
+    // Returns the number of decisions evicted to make room.
+    uint64_t put(const std::string& key, Decision decision);
+
+  private:
+    const uint32_t max_entries_;
+    LruMap<std::string, Decision> map_;
+  };
+
+  struct ThreadLocalLru : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalLru(uint32_t max_entries) : lru_(max_entries) {}
+    Lru lru_;
+  };
+
+  // Returns how long the response may be cached.
+  std::chrono::milliseconds ttl(const Filters::Common::ExtAuthz::Response& response) const;
+
+  const std::vector<Http::LowerCaseString> key_headers_;
+  const std::chrono::milliseconds ttl_;
+  const std::chrono::milliseconds denied_ttl_;
+  const std::string ttl_metadata_key_;
+  TimeSource& time_source_;
+  DecisionCacheStats stats_;
+  ThreadLocal::TypedSlot<ThreadLocalLru> tls_;
+  absl::Mutex shared_mutex_;
+  Lru shared_ ABSL_GUARDED_BY(shared_mutex_);
+};
+
+using DecisionCacheSharedPtr = std::shared_ptr<DecisionCache>;
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
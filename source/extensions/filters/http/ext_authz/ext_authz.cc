@@ -71,6 +71,25 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
       config_->includePeerCertificate(), config_->destinationLabels(),
       config_->requestHeaderMatchers());
 
+  if (decision_cache_ != nullptr) {
+    decision_cache_key_ = decision_cache_->key(headers, check_request_);
+    if (decision_cache_key_.has_value()) {
+      if (ResponseSharedPtr cached = decision_cache_->lookup(*decision_cache_key_);
+          cached != nullptr) {
+        ENVOY_STREAM_LOG(trace, "ext_authz filter using a cached decision", *decoder_callbacks_);
+        // Resetting the key keeps onComplete() from caching the decision again.
+        decision_cache_key_.reset();
+        state_ = State::Calling;
+        filter_return_ = FilterReturn::StopDecoding;
+        cluster_ = decoder_callbacks_->clusterInfo();
+        initiating_call_ = true;
+        onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(*cached));
+        initiating_call_ = false;
+        return;
+      }
+    }
+  }
+
   ENVOY_STREAM_LOG(trace, "ext_authz filter calling authorization server", *decoder_callbacks_);
   // Store start time of ext_authz filter call
   start_time_ = decoder_callbacks_->dispatcher().timeSource().monotonicTime();
@@ -226,6 +245,10 @@ void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
   using Filters::Common::ExtAuthz::CheckStatus;
   Stats::StatName empty_stat_name;
 
+  if (decision_cache_key_.has_value()) {
+    decision_cache_->insert(*decision_cache_key_, *response);
+  }
+
   if (!response->dynamic_metadata.fields().empty()) {
     // Add duration of call to dynamic metadata if applicable
     if (start_time_.has_value() && response->status == CheckStatus::OK) {
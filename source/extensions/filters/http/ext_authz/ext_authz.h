@@ -24,6 +24,7 @@
 #include "source/extensions/filters/common/ext_authz/ext_authz.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_grpc_impl.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_http_impl.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -263,6 +264,9 @@ public:
 
   bool disabled() const { return disabled_; }
 
+  // Router::RouteSpecificFilterConfig
+  bool disablesFilter() const override { return disabled_; }
+
   bool disableRequestBodyBuffering() const { return disable_request_body_buffering_; }
 
 private:
@@ -281,8 +285,10 @@ class Filter : public Logger::Loggable<Logger::Id::ext_authz>,
                public Http::StreamFilter,
                public Filters::Common::ExtAuthz::RequestCallbacks {
 public:
-  Filter(const FilterConfigSharedPtr& config, Filters::Common::ExtAuthz::ClientPtr&& client)
-      : config_(config), client_(std::move(client)), stats_(config->stats()) {}
+  Filter(const FilterConfigSharedPtr& config, Filters::Common::ExtAuthz::ClientPtr&& client,
+         DecisionCacheSharedPtr decision_cache = nullptr)
+      : config_(config), client_(std::move(client)), decision_cache_(std::move(decision_cache)),
+        stats_(config->stats()) {}
 
   // Http::StreamFilterBase
   void onDestroy() override;
@@ -333,6 +339,9 @@ private:
   Http::HeaderMapPtr getHeaderMap(const Filters::Common::ExtAuthz::ResponsePtr& response);
   FilterConfigSharedPtr config_;
   Filters::Common::ExtAuthz::ClientPtr client_;
+  const DecisionCacheSharedPtr decision_cache_;
+  // The key under which the decision of the authorization server is cached, if any.
+  absl::optional<std::string> decision_cache_key_;
   Http::StreamDecoderFilterCallbacks* decoder_callbacks_{};
   Http::StreamEncoderFilterCallbacks* encoder_callbacks_{};
   Http::RequestHeaderMap* request_headers_;
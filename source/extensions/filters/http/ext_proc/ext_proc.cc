@@ -152,8 +152,28 @@ void Filter::onDestroy() {
   encoding_state_.stopMessageTimer();
 }
 
+void Filter::sendAsyncMessage(ProcessingRequest&& req) {
+  if (processing_complete_ || openStream() != StreamOpenState::Ok) {
+    return;
+  }
+  req.set_async_mode(true);
+  stream_->send(std::move(req), false);
+  stats_.stream_msgs_sent_.inc();
+}
+
 FilterHeadersStatus Filter::onHeaders(ProcessorState& state,
                                       Http::RequestOrResponseHeaderMap& headers, bool end_stream) {
+  if (config_->asyncMode()) {
+    // The headers are only observed by the processor, so there is nothing to wait for.
+    ProcessingRequest req;
+    auto* headers_req = state.mutableHeaders(req);
+    MutationUtils::headersToProto(headers, *headers_req->mutable_headers());
+    headers_req->set_end_of_stream(end_stream);
+    ENVOY_LOG(debug, "Sending async headers message");
+    sendAsyncMessage(std::move(req));
+    return FilterHeadersStatus::Continue;
+  }
+
   switch (openStream()) {
   case StreamOpenState::Error:
     return FilterHeadersStatus::StopIteration;
@@ -209,6 +229,19 @@ FilterDataStatus Filter::onData(ProcessorState& state, Buffer::Instance& data, b
     ENVOY_LOG(trace, "Continuing (processing complete)");
     return FilterDataStatus::Continue;
   }
+  if (config_->asyncMode()) {
+    // In async mode, every body mode other than NONE sends the chunks as they arrive, since the
+    // processor can't modify the body anyway.
+    if (state.bodyMode() != ProcessingMode::NONE) {
+      ProcessingRequest req;
+      auto* body_req = state.mutableBody(req);
+      body_req->set_end_of_stream(end_stream);
+      body_req->set_body(data.toString());
+      ENVOY_LOG(debug, "Sending an async body chunk of {} bytes", data.length());
+      sendAsyncMessage(std::move(req));
+    }
+    return FilterDataStatus::Continue;
+  }
   bool just_added_trailers = false;
   Http::HeaderMap* new_trailers = nullptr;
   if (end_stream && state.sendTrailers()) {
@@ -421,6 +454,15 @@ FilterTrailersStatus Filter::onTrailers(ProcessorState& state, Http::HeaderMap&
     ENVOY_LOG(trace, "trailers: Continue");
     return FilterTrailersStatus::Continue;
   }
+  if (config_->asyncMode()) {
+    if (state.sendTrailers()) {
+      ProcessingRequest req;
+      MutationUtils::headersToProto(trailers, *state.mutableTrailers(req)->mutable_trailers());
+      ENVOY_LOG(debug, "Sending async trailers message");
+      sendAsyncMessage(std::move(req));
+    }
+    return FilterTrailersStatus::Continue;
+  }
 
   bool body_delivered = state.completeBodyAvailable();
   state.setCompleteBodyAvailable(true);
@@ -533,6 +575,16 @@ void Filter::onReceiveMessage(std::unique_ptr<ProcessingResponse>&& r) {
     // Ignore additional messages after we decided we were done with the stream
     return;
   }
+  if (config_->asyncMode()) {
+    // The processor must not respond to async messages, so the stream is out of sync with
+    // the filter. Ignore it for the rest of the request, as for any other spurious message.
+    ENVOY_LOG(warn, "Spurious response message {} received on async gRPC stream",
+              r->response_case());
+    stats_.spurious_msgs_received_.inc();
+    processing_complete_ = true;
+    closeStream();
+    return;
+  }
 
   auto response = std::move(r);
 
@@ -621,7 +673,12 @@ void Filter::onGrpcError(Grpc::Status::GrpcStatus status) {
     return;
   }
 
-  if (config_->failureModeAllow()) {
+  if (config_->asyncMode()) {
+    // The filter never waits for the processor in async mode, so its failure can't affect the
+    // HTTP stream either.
+    onGrpcClose();
+
+  } else if (config_->failureModeAllow()) {
     // Ignore this and treat as a successful close
     onGrpcClose();
     stats_.failure_mode_allowed_.inc();
@@ -70,12 +70,15 @@ public:
   FilterConfig(const envoy::extensions::filters::http::ext_proc::v3::ExternalProcessor& config,
                const std::chrono::milliseconds message_timeout, Stats::Scope& scope,
                const std::string& stats_prefix)
-      : failure_mode_allow_(config.failure_mode_allow()), message_timeout_(message_timeout),
+      : failure_mode_allow_(config.failure_mode_allow()), async_mode_(config.async_mode()),
+        message_timeout_(message_timeout),
         stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
         processing_mode_(config.processing_mode()), mutation_checker_(config.mutation_rules()) {}
 
   bool failureModeAllow() const { return failure_mode_allow_; }
 
+  bool asyncMode() const { return async_mode_; }
+
   const std::chrono::milliseconds& messageTimeout() const { return message_timeout_; }
 
   const ExtProcFilterStats& stats() const { return stats_; }
@@ -96,6 +99,7 @@ private:
   }
 
   const bool failure_mode_allow_;
+  const bool async_mode_;
   const std::chrono::milliseconds message_timeout_;
 
   ExtProcFilterStats stats_;
@@ -196,6 +200,8 @@ private:
   void onFinishProcessorCalls(Grpc::Status::GrpcStatus call_status);
   void clearAsyncState();
   void sendImmediateResponse(const envoy::service::ext_proc::v3::ImmediateResponse& response);
+  // Sends a message in async mode, in which the processor must not respond to it.
+  void sendAsyncMessage(envoy::service::ext_proc::v3::ProcessingRequest&& req);
 
   Http::FilterHeadersStatus onHeaders(ProcessorState& state,
                                       Http::RequestOrResponseHeaderMap& headers, bool end_stream);
@@ -384,7 +384,8 @@ bool FileSystemBufferFilter::maybeStorage(BufferedStreamState& state,
       ENVOY_STREAM_LOG(debug, "retrieving buffer fragment (size={}) from storage", callbacks, size);
       auto queued =
           (**earliest_storage_fragment)
-              .fromStorage(state.async_file_handle_, getSafeDispatch(), getOnFileActionCompleted());
+              .fromStorage(state.async_file_handle_, state.config_->mapStorageReads(),
+                           getSafeDispatch(), getOnFileActionCompleted());
       ASSERT(queued.ok());
       cancel_in_flight_async_action_ = queued.value();
       return true;
@@ -123,6 +123,15 @@ AsyncFileManager* getAsyncFileManager(const FilterConfigVector& configs) {
   return nullptr;
 }
 
+bool getMapStorageReads(const StreamConfigVector& configs) {
+  for (const ProtoStreamConfig& cfg : configs) {
+    if (cfg.has_map_storage_reads()) {
+      return cfg.map_storage_reads().value();
+    }
+  }
+  return false;
+}
+
 const BufferBehavior& getBufferBehavior(const StreamConfigVector& configs) {
   for (const ProtoStreamConfig& cfg : configs) {
     if (cfg.has_behavior()) {
@@ -161,7 +170,7 @@ FileSystemBufferFilterMergedConfig::StreamConfig::StreamConfig(const StreamConfi
     : memory_buffer_bytes_limit_(getMemoryBufferBytesLimit(configs)),
       storage_buffer_bytes_limit_(has_file_manager ? getStorageBufferBytesLimit(configs) : 0),
       storage_buffer_queue_high_watermark_bytes_(getStorageBufferQueueHighWatermarkBytes(configs)),
-      behavior_(getBufferBehavior(configs)) {}
+      map_storage_reads_(getMapStorageReads(configs)), behavior_(getBufferBehavior(configs)) {}
 
 FileSystemBufferFilterConfig::FileSystemBufferFilterConfig(
     std::shared_ptr<AsyncFileManagerFactory> factory,
@@ -75,12 +75,14 @@ public:
     size_t storageBufferQueueHighWatermarkBytes() const {
       return storage_buffer_queue_high_watermark_bytes_;
     }
+    bool mapStorageReads() const { return map_storage_reads_; }
     const BufferBehavior& behavior() const { return behavior_; }
 
   private:
     const size_t memory_buffer_bytes_limit_;
     const size_t storage_buffer_bytes_limit_;
     const size_t storage_buffer_queue_high_watermark_bytes_;
+    const bool map_storage_reads_;
     const BufferBehavior& behavior_;
   };
   // The first config is highest priority, overriding later configs for any value present.
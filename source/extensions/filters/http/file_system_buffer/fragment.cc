@@ -64,31 +64,31 @@ Fragment::toStorage(AsyncFileHandle file, off_t offset,
 }
 
 absl::StatusOr<CancelFunction>
-Fragment::fromStorage(AsyncFileHandle file, std::function<void(std::function<void()>)> dispatch,
+Fragment::fromStorage(AsyncFileHandle file, bool map,
+                      std::function<void(std::function<void()>)> dispatch,
                       std::function<void(absl::Status)> on_done) {
   ASSERT(isStorage());
   off_t offset = absl::get<StorageFragment>(data_).offset();
   data_.emplace<ReadingFragment>();
-  return file->read(
-      offset, size_,
-      [this, dispatch = std::move(dispatch), size = size_,
-       on_done = std::move(on_done)](absl::StatusOr<std::unique_ptr<Buffer::Instance>> result) {
-        // size is captured because we can't safely use 'this' until we're in the dispatch callback.
-        if (!result.ok()) {
-          dispatch([on_done = std::move(on_done), status = result.status()]() { on_done(status); });
-        } else if (result.value()->length() != size) {
-          auto status = absl::AbortedError(
-              fmt::format("buffer read got {} bytes, wanted {}", result.value()->length(), size));
-          dispatch(
-              [on_done = std::move(on_done), status = std::move(status)]() { on_done(status); });
-        } else {
-          auto buffer = std::shared_ptr<Buffer::Instance>(std::move(result.value()));
-          dispatch([this, on_done = std::move(on_done), buffer = std::move(buffer)]() {
-            data_.emplace<MemoryFragment>(*buffer);
-            on_done(absl::OkStatus());
-          });
-        }
+  auto on_read = [this, dispatch = std::move(dispatch), size = size_, on_done = std::move(on_done)](
+                     absl::StatusOr<std::unique_ptr<Buffer::Instance>> result) {
+    // size is captured because we can't safely use 'this' until we're in the dispatch callback.
+    if (!result.ok()) {
+      dispatch([on_done = std::move(on_done), status = result.status()]() { on_done(status); });
+    } else if (result.value()->length() != size) {
+      auto status = absl::AbortedError(
+          fmt::format("buffer read got {} bytes, wanted {}", result.value()->length(), size));
+      dispatch([on_done = std::move(on_done), status = std::move(status)]() { on_done(status); });
+    } else {
+      auto buffer = std::shared_ptr<Buffer::Instance>(std::move(result.value()));
+      dispatch([this, on_done = std::move(on_done), buffer = std::move(buffer)]() {
+        data_.emplace<MemoryFragment>(*buffer);
+        on_done(absl::OkStatus());
       });
+    }
+  };
+  return map ? file->readMapped(offset, size_, std::move(on_read))
+             : file->read(offset, size_, std::move(on_read));
 }
 
 } // namespace FileSystemBuffer
@@ -75,11 +75,14 @@ public:
 
   // Starts the transition for this fragment from storage to memory.
   //
+  // If map is true, the fragment references a memory mapping of the file instead of a copy of its
+  // contents.
+  //
   // The on_done callback is sent to the dispatcher function after the file read completes.
   //
   // When called from a filter, the dispatcher function must abort without calling the
   // callback if the filter or fragment has been destroyed.
-  absl::StatusOr<CancelFunction> fromStorage(AsyncFileHandle file,
+  absl::StatusOr<CancelFunction> fromStorage(AsyncFileHandle file, bool map,
                                              std::function<void(std::function<void()>)> dispatch,
                                              std::function<void(absl::Status)> on_done);
 
@@ -18,6 +18,7 @@
 #include "source/common/runtime/runtime_features.h"
 #include "source/extensions/filters/http/grpc_json_transcoder/http_body_utils.h"
 
+#include "absl/strings/numbers.h"
 #include "google/api/annotations.pb.h"
 #include "google/api/http.pb.h"
 #include "google/api/httpbody.pb.h"
@@ -524,6 +525,7 @@ Http::FilterHeadersStatus JsonTranscoderFilter::decodeHeaders(Http::RequestHeade
     if (checkAndRejectIfRequestTranscoderFailed(RcDetails::get().GrpcTranscodeFailed)) {
       return Http::FilterHeadersStatus::StopIteration;
     }
+    maybeStreamHttpBodyRequest(headers, end_stream);
   }
 
   headers.removeContentLength();
@@ -567,6 +569,10 @@ Http::FilterDataStatus JsonTranscoderFilter::decodeData(Buffer::Instance& data,
     return Http::FilterDataStatus::Continue;
   }
 
+  if (method_->request_type_is_http_body_ && streamed_request_body_remaining_.has_value()) {
+    return streamHttpBodyRequestData(data, end_stream);
+  }
+
   if (method_->request_type_is_http_body_) {
     request_data_.move(data);
     if (decoderBufferLimitReached(request_data_.length())) {
@@ -611,7 +617,12 @@ Http::FilterTrailersStatus JsonTranscoderFilter::decodeTrailers(Http::RequestTra
     return Http::FilterTrailersStatus::Continue;
   }
 
-  if (method_->request_type_is_http_body_) {
+  if (method_->request_type_is_http_body_ && streamed_request_body_remaining_.has_value()) {
+    if (*streamed_request_body_remaining_ > 0) {
+      rejectStreamedHttpBodyRequest();
+      return Http::FilterTrailersStatus::StopIteration;
+    }
+  } else if (method_->request_type_is_http_body_) {
     maybeSendHttpBodyRequestMessage(nullptr);
   } else {
     request_in_.finish();
@@ -879,6 +890,66 @@ void JsonTranscoderFilter::maybeSendHttpBodyRequestMessage(Buffer::Instance* dat
   first_request_sent_ = true;
 }
 
+void JsonTranscoderFilter::maybeStreamHttpBodyRequest(const Http::RequestHeaderMap& headers,
+                                                      bool end_stream) {
+  // The message of a streaming call is sent whenever data arrives, and a request without a body is
+  // sent right away.
+  if (end_stream || method_->descriptor_->client_streaming() ||
+      !Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.grpc_json_transcoder_stream_http_body_requests")) {
+    return;
+  }
+  uint64_t content_length;
+  if (headers.ContentLength() == nullptr ||
+      !absl::SimpleAtoi(headers.getContentLengthValue(), &content_length) || content_length == 0 ||
+      content_length > MaxStreamedHttpBodyRequestLength) {
+    return;
+  }
+  // A configured limit still applies: larger requests are buffered and rejected at the limit.
+  if (per_route_config_->max_request_body_size_.has_value() &&
+      content_length > *per_route_config_->max_request_body_size_) {
+    return;
+  }
+  streamed_request_body_remaining_ = content_length;
+}
+
+Http::FilterDataStatus JsonTranscoderFilter::streamHttpBodyRequestData(Buffer::Instance& data,
+                                                                       bool end_stream) {
+  uint64_t& remaining = *streamed_request_body_remaining_;
+  if (data.length() > remaining || (end_stream && data.length() < remaining)) {
+    rejectStreamedHttpBodyRequest();
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+  remaining -= data.length();
+
+  if (!first_request_sent_) {
+    // The frame header and the envelope use the length of the whole body, so that its data can be
+    // sent as it arrives instead of being buffered until the end of the stream.
+    Buffer::OwnedImpl message_prefix;
+    message_prefix.move(initial_request_data_);
+    HttpBodyUtils::appendHttpBodyEnvelope(message_prefix, method_->request_body_field_path,
+                                          std::move(content_type_), remaining + data.length());
+    content_type_.clear();
+    Envoy::Grpc::Encoder().prependFrameHeader(Envoy::Grpc::GRPC_FH_DEFAULT, message_prefix,
+                                              message_prefix.length() + remaining + data.length());
+    data.prepend(message_prefix);
+    first_request_sent_ = true;
+  }
+
+  ENVOY_STREAM_LOG(debug, "streaming HttpBody request data, remaining body size={}",
+                   *decoder_callbacks_, remaining);
+  return Http::FilterDataStatus::Continue;
+}
+
+void JsonTranscoderFilter::rejectStreamedHttpBodyRequest() {
+  ENVOY_STREAM_LOG(debug, "Request body length doesn't match its content-length",
+                   *decoder_callbacks_);
+  error_ = true;
+  decoder_callbacks_->sendLocalReply(
+      Http::Code::BadRequest, "Bad request", nullptr, absl::nullopt,
+      absl::StrCat(RcDetails::get().GrpcTranscodeFailed, "{BAD_REQUEST}"));
+}
+
 bool JsonTranscoderFilter::buildResponseFromHttpBodyOutput(
     Http::ResponseHeaderMap& response_headers, Buffer::Instance& data) {
   std::vector<Grpc::Frame> frames;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <limits>
+
 #include "envoy/api/api.h"
 #include "envoy/buffer/buffer.h"
 #include "envoy/extensions/filters/http/grpc_json_transcoder/v3/transcoder.pb.h"
@@ -12,6 +14,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/filters/http/grpc_json_transcoder/transcoder_input_stream_impl.h"
 
+#include "absl/types/optional.h"
 #include "google/api/http.pb.h"
 #include "grpc_transcoding/path_matcher.h"
 #include "grpc_transcoding/request_message_translator.h"
@@ -181,10 +184,21 @@ public:
   }
 
 private:
+  // Leaves room for the envelope of the body in the length of the gRPC frame.
+  static constexpr uint64_t MaxStreamedHttpBodyRequestLength =
+      std::numeric_limits<uint32_t>::max() / 2;
+
   bool checkAndRejectIfRequestTranscoderFailed(const std::string& details);
   bool checkAndRejectIfResponseTranscoderFailed();
   bool readToBuffer(Protobuf::io::ZeroCopyInputStream& stream, Buffer::Instance& data);
   void maybeSendHttpBodyRequestMessage(Buffer::Instance* data);
+  /**
+   * Streams the body of a unary HttpBody request whose length is known from its content-length,
+   * instead of buffering it until the end of the stream.
+   */
+  void maybeStreamHttpBodyRequest(const Http::RequestHeaderMap& headers, bool end_stream);
+  Http::FilterDataStatus streamHttpBodyRequestData(Buffer::Instance& data, bool end_stream);
+  void rejectStreamedHttpBodyRequest();
   /**
    * Builds response from HttpBody protobuf.
    * Returns true if at least one gRPC frame has processed.
@@ -223,6 +237,9 @@ private:
   Buffer::OwnedImpl request_data_;
   bool first_request_sent_{false};
   std::string content_type_;
+  // The number of bytes of the body of a streamed HttpBody request still to come, if the request is
+  // streamed.
+  absl::optional<uint64_t> streamed_request_body_remaining_;
 
   bool error_{false};
   bool has_body_{false};
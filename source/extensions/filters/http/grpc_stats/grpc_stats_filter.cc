@@ -4,14 +4,17 @@
 #include "envoy/extensions/filters/http/grpc_stats/v3/config.pb.validate.h"
 #include "envoy/grpc/context.h"
 #include "envoy/registry/registry.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/grpc/codec.h"
 #include "source/common/grpc/common.h"
 #include "source/common/grpc/context_impl.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_impl.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stream_info/utility.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
+#include "source/extensions/filters/http/grpc_stats/method_stats_cache.h"
 #include "source/extensions/filters/http/grpc_stats/response_frame_counter.h"
 
 namespace Envoy {
@@ -90,12 +93,32 @@ private:
   const MapType map_;
 };
 
+// The default number of service/method stats each worker caches.
+constexpr uint32_t DefaultMethodStatsCacheSize = 1024;
+
+struct ThreadLocalMethodStatsCache : public ThreadLocal::ThreadLocalObject {
+  ThreadLocalMethodStatsCache(const MethodStatNames& stat_names, uint32_t max_entries)
+      : cache_(stat_names, max_entries) {}
+  MethodStatsCache cache_;
+};
+
 struct Config {
   Config(const envoy::extensions::filters::http::grpc_stats::v3::FilterConfig& proto_config,
          Server::Configuration::FactoryContext& context)
       : context_(context.grpcContext()), emit_filter_state_(proto_config.emit_filter_state()),
         enable_upstream_stats_(proto_config.enable_upstream_stats()),
-        replace_dots_in_grpc_service_name_(proto_config.replace_dots_in_grpc_service_name()) {
+        replace_dots_in_grpc_service_name_(proto_config.replace_dots_in_grpc_service_name()),
+        method_stat_names_(context.scope().symbolTable()) {
+    const uint32_t method_stats_cache_size = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+        proto_config, method_stats_cache_size, DefaultMethodStatsCacheSize);
+    if (method_stats_cache_size > 0) {
+      method_stats_cache_ =
+          ThreadLocal::TypedSlot<ThreadLocalMethodStatsCache>::makeUnique(context.threadLocal());
+      method_stats_cache_->set([this, method_stats_cache_size](Event::Dispatcher&) {
+        return std::make_shared<ThreadLocalMethodStatsCache>(method_stat_names_,
+                                                             method_stats_cache_size);
+      });
+    }
 
     switch (proto_config.per_method_stat_specifier_case()) {
     case envoy::extensions::filters::http::grpc_stats::v3::FilterConfig::
@@ -142,6 +165,9 @@ struct Config {
   const bool replace_dots_in_grpc_service_name_;
   bool stats_for_all_methods_{false};
   absl::optional<GrpcServiceMethodToRequestNamesMap> allowlist_;
+  const MethodStatNames method_stat_names_;
+  // The stats of the services/methods recently requested on each worker, null if disabled.
+  ThreadLocal::TypedSlotPtr<ThreadLocalMethodStatsCache> method_stats_cache_;
 };
 using ConfigConstSharedPtr = std::shared_ptr<const Config>;
 
@@ -155,7 +181,12 @@ public:
     connect_streaming_request_ = Grpc::Common::isConnectStreamingRequestHeaders(headers);
     if (grpc_request_ || connect_streaming_request_ || connect_unary_) {
       cluster_ = decoder_callbacks_->clusterInfo();
-      if (cluster_) {
+      if (cluster_ && config_->method_stats_cache_ != nullptr) {
+        method_stats_ =
+            (*config_->method_stats_cache_)->cache_.lookup(cluster_, headers.getPathValue());
+        do_stat_tracking_ = method_stats_ != nullptr;
+      }
+      if (cluster_ && method_stats_ == nullptr) {
         if (config_->stats_for_all_methods_) {
           // Get dynamically-allocated Context::RequestStatNames from the context.
           if (config_->replace_dots_in_grpc_service_name_) {
@@ -193,6 +224,12 @@ public:
             }
           }
         }
+
+        // Following requests to the service/method charge the stats resolved for this one.
+        if (do_stat_tracking_ && config_->method_stats_cache_ != nullptr) {
+          method_stats_ = (*config_->method_stats_cache_)
+                              ->cache_.insert(cluster_, headers.getPathValue(), request_names_);
+        }
       }
     }
 
@@ -205,19 +242,19 @@ public:
       if (delta > 0) {
         maybeWriteFilterState();
         if (doStatTracking()) {
-          config_->context_.chargeRequestMessageStat(*cluster_, request_names_, delta);
+          chargeRequestMessageStat(delta);
         }
       }
     } else if (connect_streaming_request_) {
       uint64_t delta = request_counter_.inspect(data);
       if (delta > 0) {
         maybeWriteFilterState();
-        config_->context_.chargeRequestMessageStat(*cluster_, request_names_, delta);
+        chargeRequestMessageStat(delta);
       }
     } else if (connect_unary_ && end_stream) {
       connect_unary_request_body_ = true;
       maybeWriteFilterState();
-      config_->context_.chargeRequestMessageStat(*cluster_, request_names_, 1);
+      chargeRequestMessageStat(1);
     }
     return Http::FilterDataStatus::Continue;
   }
@@ -228,11 +265,9 @@ public:
     connect_streaming_response_ = Grpc::Common::isConnectStreamingResponseHeaders(headers);
     if (doStatTracking()) {
       if (connect_unary_) {
-        config_->context_.chargeStat(*cluster_, Grpc::Context::Protocol::Grpc, request_names_,
-                                     headers.getStatusValue() == "200");
+        chargeStat(headers.getStatusValue() == "200");
       } else if (!connect_streaming_response_) {
-        config_->context_.chargeStat(*cluster_, Grpc::Context::Protocol::Grpc, request_names_,
-                                     headers.GrpcStatus());
+        chargeStat(headers.GrpcStatus());
       }
       if (end_stream) {
         maybeChargeUpstreamStat();
@@ -247,24 +282,23 @@ public:
       if (delta > 0) {
         maybeWriteFilterState();
         if (doStatTracking()) {
-          config_->context_.chargeResponseMessageStat(*cluster_, request_names_, delta);
+          chargeResponseMessageStat(delta);
         }
       }
     } else if (connect_streaming_request_) {
       uint64_t delta = response_counter_.inspect(data);
       if (delta > 0) {
         maybeWriteFilterState();
-        config_->context_.chargeResponseMessageStat(*cluster_, request_names_, delta);
+        chargeResponseMessageStat(delta);
       }
       if (end_stream) {
-        config_->context_.chargeStat(*cluster_, Grpc::Context::Protocol::Grpc, request_names_,
-                                     response_counter_.connectSuccess());
+        chargeStat(response_counter_.connectSuccess());
         maybeChargeUpstreamStat();
       }
     } else if (connect_unary_ && end_stream) {
       connect_unary_response_body_ = true;
       maybeWriteFilterState();
-      config_->context_.chargeResponseMessageStat(*cluster_, request_names_, 1);
+      chargeResponseMessageStat(1);
       maybeChargeUpstreamStat();
     }
     return Http::FilterDataStatus::Continue;
@@ -272,8 +306,7 @@ public:
 
   Http::FilterTrailersStatus encodeTrailers(Http::ResponseTrailerMap& trailers) override {
     if (grpc_request_ && doStatTracking()) {
-      config_->context_.chargeStat(*cluster_, Grpc::Context::Protocol::Grpc, request_names_,
-                                   trailers.GrpcStatus());
+      chargeStat(trailers.GrpcStatus());
       maybeChargeUpstreamStat();
     }
     return Http::FilterTrailersStatus::Continue;
@@ -313,11 +346,54 @@ public:
           std::chrono::duration_cast<std::chrono::milliseconds>(
               timing.lastUpstreamRxByteReceived().value() -
               timing.lastUpstreamTxByteSent().value());
-      config_->context_.chargeUpstreamStat(*cluster_, request_names_, chrono_duration);
+      chargeUpstreamStat(chrono_duration);
     }
   }
 
 private:
+  // The charge functions use the cached stats of the service/method if there are any.
+  void chargeStat(const Http::HeaderEntry* grpc_status) {
+    if (method_stats_ != nullptr) {
+      method_stats_->chargeStat(*cluster_, grpc_status);
+    } else {
+      config_->context_.chargeStat(*cluster_, Grpc::Context::Protocol::Grpc, request_names_,
+                                   grpc_status);
+    }
+  }
+
+  void chargeStat(bool success) {
+    if (method_stats_ != nullptr) {
+      method_stats_->chargeStat(*cluster_, success);
+    } else {
+      config_->context_.chargeStat(*cluster_, Grpc::Context::Protocol::Grpc, request_names_,
+                                   success);
+    }
+  }
+
+  void chargeRequestMessageStat(uint64_t amount) {
+    if (method_stats_ != nullptr) {
+      method_stats_->chargeRequestMessageStat(*cluster_, amount);
+    } else {
+      config_->context_.chargeRequestMessageStat(*cluster_, request_names_, amount);
+    }
+  }
+
+  void chargeResponseMessageStat(uint64_t amount) {
+    if (method_stats_ != nullptr) {
+      method_stats_->chargeResponseMessageStat(*cluster_, amount);
+    } else {
+      config_->context_.chargeResponseMessageStat(*cluster_, request_names_, amount);
+    }
+  }
+
+  void chargeUpstreamStat(std::chrono::milliseconds duration) {
+    if (method_stats_ != nullptr) {
+      method_stats_->chargeUpstreamStat(*cluster_, duration);
+    } else {
+      config_->context_.chargeUpstreamStat(*cluster_, request_names_, duration);
+    }
+  }
+
   ConfigConstSharedPtr config_;
   GrpcStatsObject* filter_object_{};
   bool do_stat_tracking_{false};
@@ -332,6 +408,7 @@ private:
   ResponseFrameCounter response_counter_;
   Upstream::ClusterInfoConstSharedPtr cluster_;
   absl::optional<Grpc::Context::RequestStatNames> request_names_;
+  MethodStatsSharedPtr method_stats_;
 };
 
 } // namespace
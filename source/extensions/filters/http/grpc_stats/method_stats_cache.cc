@@ -0,0 +1,126 @@
+#include "source/extensions/filters/http/grpc_stats/method_stats_cache.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcStats {
+
+MethodStatNames::MethodStatNames(Stats::SymbolTable& symbol_table)
+    : pool_(symbol_table), grpc_(pool_.add("grpc")), success_(pool_.add("success")),
+      failure_(pool_.add("failure")), total_(pool_.add("total")),
+      request_message_count_(pool_.add("request_message_count")),
+      response_message_count_(pool_.add("response_message_count")),
+      upstream_rq_time_(pool_.add("upstream_rq_time")) {
+  for (uint32_t i = 0; i <= Grpc::Status::WellKnownGrpcStatus::MaximumKnown; ++i) {
+    status_[i] = pool_.add(absl::StrCat(i));
+  }
+}
+
+void MethodStats::chargeStat(const Upstream::ClusterInfo& cluster,
+                             const Http::HeaderEntry* grpc_status) {
+  if (!grpc_status) {
+    return;
+  }
+
+  const absl::string_view status_str = grpc_status->value().getStringView();
+  // Only the canonical spelling of the well-known statuses has a symbolized name, anything else is
+  // charged with a dynamic one as by Grpc::ContextImpl.
+  uint32_t status;
+  if (absl::SimpleAtoi(status_str, &status) &&
+      status <= Grpc::Status::WellKnownGrpcStatus::MaximumKnown &&
+      status_str.size() == (status < 10 ? 1 : 2)) {
+    counter(status_[status], cluster, stat_names_.status_[status]).inc();
+  } else {
+    Stats::Utility::counterFromElements(cluster.statsScope(),
+                                        statElements(Stats::DynamicName(status_str)))
+        .inc();
+  }
+  chargeStat(cluster, status_str == "0");
+}
+
+void MethodStats::chargeStat(const Upstream::ClusterInfo& cluster, bool success) {
+  if (success) {
+    counter(success_, cluster, stat_names_.success_).inc();
+  } else {
+    counter(failure_, cluster, stat_names_.failure_).inc();
+  }
+  counter(total_, cluster, stat_names_.total_).inc();
+}
+
+void MethodStats::chargeRequestMessageStat(const Upstream::ClusterInfo& cluster, uint64_t amount) {
+  counter(request_message_count_, cluster, stat_names_.request_message_count_).add(amount);
+}
+
+void MethodStats::chargeResponseMessageStat(const Upstream::ClusterInfo& cluster,
+                                            uint64_t amount) {
+  counter(response_message_count_, cluster, stat_names_.response_message_count_).add(amount);
+}
+
+void MethodStats::chargeUpstreamStat(const Upstream::ClusterInfo& cluster,
+                                     std::chrono::milliseconds duration) {
+  if (upstream_rq_time_ == nullptr) {
+    upstream_rq_time_ = Stats::HistogramSharedPtr(&Stats::Utility::histogramFromElements(
+        cluster.statsScope(), statElements(stat_names_.upstream_rq_time_),
+        Stats::Histogram::Unit::Milliseconds));
+  }
+  upstream_rq_time_->recordValue(duration.count());
+}
+
+Stats::ElementVec MethodStats::statElements(Stats::Element suffix) const {
+  if (request_names_) {
+    return Stats::ElementVec{stat_names_.grpc_, request_names_->service_, request_names_->method_,
+                             suffix};
+  }
+  return Stats::ElementVec{stat_names_.grpc_, suffix};
+}
+
+Stats::Counter& MethodStats::counter(Stats::CounterSharedPtr& counter,
+                                     const Upstream::ClusterInfo& cluster,
+                                     Stats::StatName suffix) {
+  if (counter == nullptr) {
+    counter = Stats::CounterSharedPtr(
+        &Stats::Utility::counterFromElements(cluster.statsScope(), statElements(suffix)));
+  }
+  return *counter;
+}
+
+MethodStatsSharedPtr MethodStatsCache::lookup(const Upstream::ClusterInfoConstSharedPtr& cluster,
+                                              absl::string_view path) {
+  const ViewKey key(cluster.get(), path);
+  const Entry* entry = map_.get(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  if (entry->cluster_.expired()) {
+    // The ClusterInfo the stats were resolved for was destroyed and another took its address.
+    map_.erase(key);
+    return nullptr;
+  }
+  return entry->stats_;
+}
+
+MethodStatsSharedPtr
+MethodStatsCache::insert(const Upstream::ClusterInfoConstSharedPtr& cluster,
+                         absl::string_view path,
+                         absl::optional<Grpc::Context::RequestStatNames> request_names) {
+  auto stats = std::make_shared<MethodStats>(stat_names_, std::move(request_names));
+  if (max_entries_ == 0) {
+    return stats;
+  }
+  Entry& entry = *map_.getOrInsert(OwningKey(cluster.get(), std::string(path))).first;
+  entry.cluster_ = cluster;
+  entry.stats_ = stats;
+
+  while (map_.size() > max_entries_) {
+    map_.eraseLeastRecentlyUsed();
+  }
+  return stats;
+}
+
+} // namespace GrpcStats
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
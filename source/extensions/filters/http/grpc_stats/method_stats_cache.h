@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "envoy/grpc/context.h"
+#include "envoy/grpc/status.h"
+#include "envoy/http/header_map.h"
+#include "envoy/stats/histogram.h"
+#include "envoy/stats/stats.h"
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/common/lru_map.h"
+#include "source/common/grpc/context_impl.h"
+#include "source/common/stats/symbol_table.h"
+#include "source/common/stats/utility.h"
+
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcStats {
+
+/**
+ * The symbolized tokens of the stats charged by MethodStats, matching the ones of
+ * Grpc::ContextImpl.
+ */
+struct MethodStatNames {
+  explicit MethodStatNames(Stats::SymbolTable& symbol_table);
+
+  Stats::StatNamePool pool_;
+  const Stats::StatName grpc_;
+  const Stats::StatName success_;
+  const Stats::StatName failure_;
+  const Stats::StatName total_;
+  const Stats::StatName request_message_count_;
+  const Stats::StatName response_message_count_;
+  const Stats::StatName upstream_rq_time_;
+  std::array<Stats::StatName, Grpc::Status::WellKnownGrpcStatus::MaximumKnown + 1> status_;
+};
+
+/**
+ * The stats of the gRPC requests of a cluster to a service/method, resolved on their first use
+ * and then charged without building their names again. They are the stats
+ * Grpc::Context::chargeStat() and the like charge for the same request names.
+ *
+ * The stats are only used by the worker caching them.
+ */
+class MethodStats {
+public:
+  MethodStats(const MethodStatNames& stat_names,
+              absl::optional<Grpc::Context::RequestStatNames> request_names)
+      : stat_names_(stat_names), request_names_(std::move(request_names)) {}
+
+  const absl::optional<Grpc::Context::RequestStatNames>& requestNames() const {
+    return request_names_;
+  }
+
+  void chargeStat(const Upstream::ClusterInfo& cluster, const Http::HeaderEntry* grpc_status);
+  void chargeStat(const Upstream::ClusterInfo& cluster, bool success);
+  void chargeRequestMessageStat(const Upstream::ClusterInfo& cluster, uint64_t amount);
+  void chargeResponseMessageStat(const Upstream::ClusterInfo& cluster, uint64_t amount);
+  void chargeUpstreamStat(const Upstream::ClusterInfo& cluster,
+                          std::chrono::milliseconds duration);
+
+private:
+  Stats::ElementVec statElements(Stats::Element suffix) const;
+  Stats::Counter& counter(Stats::CounterSharedPtr& counter, const Upstream::ClusterInfo& cluster,
+                          Stats::StatName suffix);
+
+  const MethodStatNames& stat_names_;
+  const absl::optional<Grpc::Context::RequestStatNames> request_names_;
+  Stats::CounterSharedPtr success_;
+  Stats::CounterSharedPtr failure_;
+  Stats::CounterSharedPtr total_;
+  Stats::CounterSharedPtr request_message_count_;
+  Stats::CounterSharedPtr response_message_count_;
+  Stats::HistogramSharedPtr upstream_rq_time_;
+  std::array<Stats::CounterSharedPtr, Grpc::Status::WellKnownGrpcStatus::MaximumKnown + 1> status_;
+};
+
+using MethodStatsSharedPtr = std::shared_ptr<MethodStats>;
+
+/**
+ * The MethodStats of the clusters and :path headers recently seen by a worker, evicting the least
+ * recently used ones beyond max_entries. The entries of a cluster are keyed by the address of its
+ * ClusterInfo and dropped once it is destroyed, as its stats may then be too. The streams keep the
+ * entries they use alive, so an entry may be evicted while a stream still charges it.
+ */
+class MethodStatsCache {
+public:
+  MethodStatsCache(const MethodStatNames& stat_names, uint32_t max_entries)
+      : stat_names_(stat_names), max_entries_(max_entries) {}
+
+  /**
+   * @return the stats of the requests of the cluster to path, or nullptr if there are none cached.
+   */
+  MethodStatsSharedPtr lookup(const Upstream::ClusterInfoConstSharedPtr& cluster,
+                              absl::string_view path);
+
+  /**
+   * Caches the stats of the requests of the cluster to path, charged for request_names.
+   * @return the stats.
+   */
+  MethodStatsSharedPtr insert(const Upstream::ClusterInfoConstSharedPtr& cluster,
+                              absl::string_view path,
+                              absl::optional<Grpc::Context::RequestStatNames> request_names);
+
+  size_t size() const { return map_.size(); }
+
+private:
+  using OwningKey = std::pair<const Upstream::ClusterInfo*, std::string>;
+  using ViewKey = std::pair<const Upstream::ClusterInfo*, absl::string_view>;
+
+  struct KeyHash {
+    using is_transparent = void; // NOLINT(readability-identifier-naming)
+
+    size_t operator()(const OwningKey& key) const { return absl::Hash<ViewKey>()(key); }
+    size_t operator()(const ViewKey& key) const { return absl::Hash<ViewKey>()(key); }
+  };
+
+  struct KeyEq {
+    using is_transparent = void; // NOLINT(readability-identifier-naming)
+
+    bool operator()(const OwningKey& left, const OwningKey& right) const { return left == right; }
+    bool operator()(const OwningKey& left, const ViewKey& right) const {
+      return left.first == right.first && left.second == right.second;
+    }
+  };
+
+  struct Entry {
+    // Tells whether the ClusterInfo of the key is still the one the stats were resolved for.
+    std::weak_ptr<const Upstream::ClusterInfo> cluster_;
+    MethodStatsSharedPtr stats_;
+  };
+
+  const MethodStatNames& stat_names_;
+  const uint32_t max_entries_;
+  LruMap<OwningKey, Entry, KeyHash, KeyEq> map_;
+};
+
+} // namespace GrpcStats
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
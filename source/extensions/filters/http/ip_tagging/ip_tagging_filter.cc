@@ -6,6 +6,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_join.h"
 
 namespace Envoy {
@@ -19,8 +20,7 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
     : request_type_(requestTypeEnum(config.request_type())), scope_(scope), runtime_(runtime),
       stat_name_set_(scope.symbolTable().makeSet("IpTagging")),
       stats_prefix_(stat_name_set_->add(stat_prefix + "ip_tagging")),
-      no_hit_(stat_name_set_->add("no_hit")), total_(stat_name_set_->add("total")),
-      unknown_tag_(stat_name_set_->add("unknown_tag.hit")) {
+      no_hit_(stat_name_set_->add("no_hit")), total_(stat_name_set_->add("total")) {
 
   // Once loading IP tags from a file system is supported, the restriction on the size
   // of the set should be removed and observability into what tags are loaded needs
@@ -31,7 +31,8 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
     throw EnvoyException("HTTP IP Tagging Filter requires ip_tags to be specified.");
   }
 
-  std::vector<std::pair<std::string, std::vector<Network::Address::CidrRange>>> tag_data;
+  absl::flat_hash_map<std::string, uint32_t> tag_ids;
+  std::vector<std::pair<uint32_t, std::vector<Network::Address::CidrRange>>> tag_data;
   tag_data.reserve(config.ip_tags().size());
   for (const auto& ip_tag : config.ip_tags()) {
     std::vector<Network::Address::CidrRange> cidr_set;
@@ -49,10 +50,15 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
       }
     }
 
-    tag_data.emplace_back(ip_tag.ip_tag_name(), cidr_set);
-    stat_name_set_->rememberBuiltin(absl::StrCat(ip_tag.ip_tag_name(), ".hit"));
+    const auto [it, inserted] =
+        tag_ids.try_emplace(ip_tag.ip_tag_name(), static_cast<uint32_t>(tags_.size()));
+    if (inserted) {
+      tags_.push_back(
+          {ip_tag.ip_tag_name(), stat_name_set_->add(absl::StrCat(ip_tag.ip_tag_name(), ".hit"))});
+    }
+    tag_data.emplace_back(it->second, std::move(cidr_set));
   }
-  trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+  trie_ = std::make_unique<Network::LcTrie::LcTrie<uint32_t>>(tag_data);
 }
 
 void IpTaggingFilterConfig::incCounter(Stats::StatName name) {
@@ -77,11 +83,14 @@ Http::FilterHeadersStatus IpTaggingFilter::decodeHeaders(Http::RequestHeaderMap&
     return Http::FilterHeadersStatus::Continue;
   }
 
-  std::vector<std::string> tags =
-      config_->trie().getData(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
+  const absl::Span<const uint32_t> tags = config_->trie().getDataView(
+      callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
 
   if (!tags.empty()) {
-    const std::string tags_join = absl::StrJoin(tags, ",");
+    const std::string tags_join =
+        absl::StrJoin(tags, ",", [this](std::string* out, uint32_t tag_id) {
+          absl::StrAppend(out, config_->tagName(tag_id));
+        });
     headers.appendEnvoyIpTags(tags_join, ",");
 
     // We must clear the route cache or else we can't match on x-envoy-ip-tags.
@@ -90,8 +99,8 @@ Http::FilterHeadersStatus IpTaggingFilter::decodeHeaders(Http::RequestHeaderMap&
     // For a large number(ex > 1000) of tags, stats cardinality will be an issue.
     // If there are use cases with a large set of tags, a way to opt into these stats
     // should be exposed and other observability options like logging tags need to be implemented.
-    for (const std::string& tag : tags) {
-      config_->incHit(tag);
+    for (const uint32_t tag_id : tags) {
+      config_->incHit(tag_id);
     }
   } else {
     config_->incNoHit();
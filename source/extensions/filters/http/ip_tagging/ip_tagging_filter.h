@@ -37,11 +37,11 @@ public:
 
   Runtime::Loader& runtime() { return runtime_; }
   FilterRequestType requestType() const { return request_type_; }
-  const Network::LcTrie::LcTrie<std::string>& trie() const { return *trie_; }
+  // The trie holds the IDs of the tags, distinct tag names have distinct IDs.
+  const Network::LcTrie::LcTrie<uint32_t>& trie() const { return *trie_; }
+  absl::string_view tagName(uint32_t tag_id) const { return tags_[tag_id].name_; }
 
-  void incHit(absl::string_view tag) {
-    incCounter(stat_name_set_->getBuiltin(absl::StrCat(tag, ".hit"), unknown_tag_));
-  }
+  void incHit(uint32_t tag_id) { incCounter(tags_[tag_id].hit_); }
   void incNoHit() { incCounter(no_hit_); }
   void incTotal() { incCounter(total_); }
 
@@ -62,6 +62,11 @@ private:
 
   void incCounter(Stats::StatName name);
 
+  struct Tag {
+    std::string name_;
+    Stats::StatName hit_;
+  };
+
   const FilterRequestType request_type_;
   Stats::Scope& scope_;
   Runtime::Loader& runtime_;
@@ -69,8 +74,9 @@ private:
   const Stats::StatName stats_prefix_;
   const Stats::StatName no_hit_;
   const Stats::StatName total_;
-  const Stats::StatName unknown_tag_;
-  std::unique_ptr<Network::LcTrie::LcTrie<std::string>> trie_;
+  // Indexed by tag ID.
+  std::vector<Tag> tags_;
+  std::unique_ptr<Network::LcTrie::LcTrie<uint32_t>> trie_;
 };
 
 using IpTaggingFilterConfigSharedPtr = std::shared_ptr<IpTaggingFilterConfig>;
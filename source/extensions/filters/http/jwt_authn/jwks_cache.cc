@@ -58,8 +58,12 @@ public:
     audiences_ = std::make_unique<::google::jwt_verify::CheckAudience>(audiences);
     bool enable_jwt_cache = jwt_provider_.has_jwt_cache_config();
     const auto& config = jwt_provider_.jwt_cache_config();
-    tls_.set([enable_jwt_cache, config](Envoy::Event::Dispatcher& dispatcher) {
-      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher.timeSource());
+    SharedJwtCacheSharedPtr shared_jwt_cache =
+        enable_jwt_cache ? SharedJwtCache::create(config, time_source_, stats.jwt_cache_shared_hit_)
+                         : nullptr;
+    tls_.set([enable_jwt_cache, config, shared_jwt_cache](Envoy::Event::Dispatcher& dispatcher) {
+      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher.timeSource(),
+                                                shared_jwt_cache);
     });
 
     const auto inline_jwks =
@@ -108,8 +112,9 @@ private:
   struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
     ThreadLocalCache(bool enable_jwt_cache,
                      const envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig& config,
-                     TimeSource& time_source)
-        : jwt_cache_(JwtCache::create(enable_jwt_cache, config, time_source)) {}
+                     TimeSource& time_source, SharedJwtCacheSharedPtr shared_jwt_cache)
+        : jwt_cache_(JwtCache::create(enable_jwt_cache, config, time_source,
+                                      std::move(shared_jwt_cache))) {}
 
     // The jwks object.
     JwksConstSharedPtr jwks_;
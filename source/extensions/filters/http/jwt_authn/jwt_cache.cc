@@ -2,6 +2,8 @@
 
 #include "source/common/common/assert.h"
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "simple_lru_cache/simple_lru_cache_inl.h"
 
 using ::google::simple_lru_cache::SimpleLRUCache;
@@ -17,10 +19,67 @@ constexpr int kJwtCacheDefaultSize = 100;
 // The maximum size of JWT to be cached.
 constexpr int kMaxJwtSizeForCache = 4 * 1024; // 4KiB
 
+bool isExpired(const ::google::jwt_verify::Jwt& jwt, TimeSource& time_source) {
+  return jwt.verifyTimeConstraint(DateUtil::nowToSeconds(time_source)) ==
+         ::google::jwt_verify::Status::JwtExpired;
+}
+
+class SharedJwtCacheImpl : public SharedJwtCache {
+public:
+  SharedJwtCacheImpl(const JwtCacheConfig& config, TimeSource& time_source,
+                     Stats::Counter& hit_counter)
+      : time_source_(time_source), hit_counter_(hit_counter),
+        jwt_lru_cache_(config.shared_jwt_cache_size()) {}
+
+  ~SharedJwtCacheImpl() override {
+    absl::MutexLock lock(&mutex_);
+    jwt_lru_cache_.clear();
+  }
+
+  std::unique_ptr<::google::jwt_verify::Jwt> lookup(const std::string& token) override {
+    absl::MutexLock lock(&mutex_);
+    std::unique_ptr<::google::jwt_verify::Jwt> copy;
+    {
+      SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>::ScopedLookup lookup(&jwt_lru_cache_,
+                                                                                 token);
+      if (!lookup.found()) {
+        return nullptr;
+      }
+      ASSERT(lookup.value() != nullptr);
+      if (!isExpired(*lookup.value(), time_source_)) {
+        copy = std::make_unique<::google::jwt_verify::Jwt>(*lookup.value());
+      }
+    }
+    if (copy == nullptr) {
+      // Removed once the lookup released the entry.
+      jwt_lru_cache_.remove(token);
+      return nullptr;
+    }
+    hit_counter_.inc();
+    return copy;
+  }
+
+  void insert(const std::string& token, const ::google::jwt_verify::Jwt& jwt) override {
+    if (token.size() > kMaxJwtSizeForCache) {
+      return;
+    }
+    auto copy = std::make_unique<::google::jwt_verify::Jwt>(jwt);
+    absl::MutexLock lock(&mutex_);
+    jwt_lru_cache_.insert(token, copy.release(), 1);
+  }
+
+private:
+  TimeSource& time_source_;
+  Stats::Counter& hit_counter_;
+  absl::Mutex mutex_;
+  SimpleLRUCache<std::string, ::google::jwt_verify::Jwt> jwt_lru_cache_ ABSL_GUARDED_BY(mutex_);
+};
+
 class JwtCacheImpl : public JwtCache {
 public:
-  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source)
-      : time_source_(time_source) {
+  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source,
+               SharedJwtCacheSharedPtr shared_cache)
+      : time_source_(time_source), shared_cache_(std::move(shared_cache)) {
     if (enable_cache) {
       // if cache_size is 0, it is not specified in the config, use default
       auto cache_size =
@@ -45,32 +104,59 @@ public:
     if (lookup.found()) {
       ::google::jwt_verify::Jwt* const found_jwt = lookup.value();
       ASSERT(found_jwt != nullptr);
-      if (found_jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) !=
-          ::google::jwt_verify::Status::JwtExpired) {
+      if (!isExpired(*found_jwt, time_source_)) {
         return found_jwt;
       } else {
         jwt_lru_cache_->remove(token);
       }
     }
-    return nullptr;
+    return lookupShared(token);
   }
 
   void insert(const std::string& token, std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) override {
     if (jwt_lru_cache_ && token.size() <= kMaxJwtSizeForCache) {
+      if (shared_cache_ != nullptr) {
+        shared_cache_->insert(token, *jwt);
+      }
       // pass the ownership of jwt to cache
       jwt_lru_cache_->insert(token, jwt.release(), 1);
     }
   }
 
 private:
+  // Copies the token from the shared cache, if found, into this cache.
+  ::google::jwt_verify::Jwt* lookupShared(const std::string& token) {
+    if (shared_cache_ == nullptr) {
+      return nullptr;
+    }
+    std::unique_ptr<::google::jwt_verify::Jwt> jwt = shared_cache_->lookup(token);
+    if (jwt == nullptr) {
+      return nullptr;
+    }
+    ::google::jwt_verify::Jwt* const found_jwt = jwt.get();
+    jwt_lru_cache_->insert(token, jwt.release(), 1);
+    return found_jwt;
+  }
+
   std::unique_ptr<SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>> jwt_lru_cache_;
   TimeSource& time_source_;
+  const SharedJwtCacheSharedPtr shared_cache_;
 };
 } // namespace
 
+SharedJwtCacheSharedPtr SharedJwtCache::create(const JwtCacheConfig& config,
+                                               TimeSource& time_source,
+                                               Stats::Counter& hit_counter) {
+  if (config.shared_jwt_cache_size() == 0) {
+    return nullptr;
+  }
+  return std::make_shared<SharedJwtCacheImpl>(config, time_source, hit_counter);
+}
+
 JwtCachePtr JwtCache::create(bool enable_cache, const JwtCacheConfig& config,
-                             TimeSource& time_source) {
-  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source);
+                             TimeSource& time_source, SharedJwtCacheSharedPtr shared_cache) {
+  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source,
+                                        std::move(shared_cache));
 }
 
 } // namespace JwtAuthn
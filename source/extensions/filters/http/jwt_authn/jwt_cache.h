@@ -4,6 +4,7 @@
 #include <string>
 
 #include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
+#include "envoy/stats/stats.h"
 
 #include "source/common/common/utility.h"
 
@@ -19,6 +20,28 @@ namespace JwtAuthn {
 
 // Cache key is the JWT string, value is parsed JWT struct.
 
+class SharedJwtCache;
+using SharedJwtCacheSharedPtr = std::shared_ptr<SharedJwtCache>;
+
+// A JWT cache shared by the workers, so that a token verified by one worker doesn't need to be
+// verified again by the others. It is only looked up when the cache of the worker misses.
+class SharedJwtCache {
+public:
+  virtual ~SharedJwtCache() = default;
+
+  // Lookup a JWT token in the cache, if found return a copy of its parsed jwt struct.
+  // If no found, return nullptr.
+  virtual std::unique_ptr<::google::jwt_verify::Jwt> lookup(const std::string& token) PURE;
+
+  // Insert a copy of a JWT token and its parsed JWT struct to the cache.
+  virtual void insert(const std::string& token, const ::google::jwt_verify::Jwt& jwt) PURE;
+
+  // SharedJwtCache factory function. Returns nullptr if the shared cache is not enabled by the
+  // config. Hits are counted by hit_counter.
+  static SharedJwtCacheSharedPtr create(const JwtCacheConfig& config, TimeSource& time_source,
+                                        Stats::Counter& hit_counter);
+};
+
 class JwtCache;
 using JwtCachePtr = std::unique_ptr<JwtCache>;
 
@@ -35,9 +58,11 @@ public:
   virtual void insert(const std::string& token,
                       std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) PURE;
 
-  // JwtCache factory function.
+  // JwtCache factory function. Lookups that miss the cache go to shared_cache, if any, and the
+  // inserted tokens are also inserted to it.
   static JwtCachePtr create(bool enable_cache, const JwtCacheConfig& config,
-                            TimeSource& time_source);
+                            TimeSource& time_source,
+                            SharedJwtCacheSharedPtr shared_cache = nullptr);
 };
 
 } // namespace JwtAuthn
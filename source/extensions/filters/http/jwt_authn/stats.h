@@ -17,7 +17,8 @@ namespace JwtAuthn {
   COUNTER(jwks_fetch_success)                                                                      \
   COUNTER(jwks_fetch_failed)                                                                       \
   COUNTER(jwt_cache_hit)                                                                           \
-  COUNTER(jwt_cache_miss)
+  COUNTER(jwt_cache_miss)                                                                          \
+  COUNTER(jwt_cache_shared_hit)
 
 /**
  * Wrapper struct for jwt_authn filter stats. @see stats_macros.h
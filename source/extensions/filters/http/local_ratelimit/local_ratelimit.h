@@ -53,8 +53,10 @@ public:
       const std::chrono::milliseconds& fill_interval, uint32_t max_tokens, uint32_t tokens_per_fill,
       Envoy::Event::Dispatcher& dispatcher,
       const Protobuf::RepeatedPtrField<
-          envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptor)
-      : rate_limiter_(fill_interval, max_tokens, tokens_per_fill, dispatcher, descriptor) {}
+          envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptor,
+      bool continuous_refill)
+      : rate_limiter_(fill_interval, max_tokens, tokens_per_fill, dispatcher, descriptor,
+                      continuous_refill) {}
   static const std::string& key();
   const Filters::Common::LocalRateLimit::LocalRateLimiterImpl& value() const {
     return rate_limiter_;
@@ -104,6 +106,7 @@ public:
     return descriptors_;
   }
   bool rateLimitPerConnection() const { return rate_limit_per_connection_; }
+  bool continuousRefill() const { return continuous_refill_; }
   bool enableXRateLimitHeaders() const { return enable_x_rate_limit_headers_; }
   envoy::extensions::common::ratelimit::v3::VhRateLimitsOptions virtualHostRateLimits() const {
     return vh_rate_limits_;
@@ -132,6 +135,7 @@ private:
       envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
       descriptors_;
   const bool rate_limit_per_connection_;
+  const bool continuous_refill_;
   std::unique_ptr<Filters::Common::LocalRateLimit::LocalRateLimiterImpl> rate_limiter_;
   const LocalInfo::LocalInfo& local_info_;
   Runtime::Loader& runtime_;
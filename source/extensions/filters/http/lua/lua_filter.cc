@@ -847,20 +847,26 @@ void Filter::onDestroy() {
   if (response_stream_wrapper_.get()) {
     response_stream_wrapper_.get()->onReset();
   }
+  for (StreamCoroutine* coroutine : {&request_coroutine_, &response_coroutine_}) {
+    if (coroutine->coroutine_ != nullptr) {
+      coroutine->setup_->releaseCoroutine(std::move(coroutine->coroutine_));
+    }
+  }
 }
 
 Http::FilterHeadersStatus
-Filter::doHeaders(StreamHandleRef& handle, Filters::Common::Lua::CoroutinePtr& coroutine,
-                  FilterCallbacks& callbacks, int function_ref, PerLuaCodeSetup* setup,
+Filter::doHeaders(StreamHandleRef& handle, StreamCoroutine& coroutine, FilterCallbacks& callbacks,
+                  int function_ref, PerLuaCodeSetup* setup,
                   Http::RequestOrResponseHeaderMap& headers, bool end_stream) {
   if (function_ref == LUA_REFNIL) {
     return Http::FilterHeadersStatus::Continue;
   }
   ASSERT(setup);
-  coroutine = setup->createCoroutine();
+  coroutine.coroutine_ = setup->createCoroutine();
+  coroutine.setup_ = setup;
 
-  handle.reset(StreamHandleWrapper::create(coroutine->luaState(), *coroutine, headers, end_stream,
-                                           *this, callbacks, time_source_),
+  handle.reset(StreamHandleWrapper::create(coroutine.coroutine_->luaState(), *coroutine.coroutine_,
+                                           headers, end_stream, *this, callbacks, time_source_),
                true);
 
   Http::FilterHeadersStatus status = Http::FilterHeadersStatus::Continue;
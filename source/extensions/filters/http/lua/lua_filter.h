@@ -35,6 +35,9 @@ public:
   Extensions::Filters::Common::Lua::CoroutinePtr createCoroutine() {
     return lua_state_.createCoroutine();
   }
+  void releaseCoroutine(Extensions::Filters::Common::Lua::CoroutinePtr&& coroutine) {
+    lua_state_.releaseCoroutine(std::move(coroutine));
+  }
 
   int requestFunctionRef() { return lua_state_.getGlobalRef(request_function_slot_); }
   int responseFunctionRef() { return lua_state_.getGlobalRef(response_function_slot_); }
@@ -578,8 +581,13 @@ private:
 
   using StreamHandleRef = Filters::Common::Lua::LuaDeathRef<StreamHandleWrapper>;
 
-  Http::FilterHeadersStatus doHeaders(StreamHandleRef& handle,
-                                      Filters::Common::Lua::CoroutinePtr& coroutine,
+  // A coroutine along with the code setup that created it, and which it is released to.
+  struct StreamCoroutine {
+    Filters::Common::Lua::CoroutinePtr coroutine_;
+    PerLuaCodeSetup* setup_{};
+  };
+
+  Http::FilterHeadersStatus doHeaders(StreamHandleRef& handle, StreamCoroutine& coroutine,
                                       FilterCallbacks& callbacks, int function_ref,
                                       PerLuaCodeSetup* setup,
                                       Http::RequestOrResponseHeaderMap& headers, bool end_stream);
@@ -607,8 +615,11 @@ private:
   // coroutine at all and it would be taken care of automatically via a runtime internal reference
   // when a yield happens. However, given that I don't fully understand the runtime internals, this
   // seems like a safer fix for now.
-  Filters::Common::Lua::CoroutinePtr request_coroutine_;
-  Filters::Common::Lua::CoroutinePtr response_coroutine_;
+  //
+  // Once the filter is destroyed, the coroutines that finished are released to their code setup
+  // for reuse by the next streams of the worker.
+  StreamCoroutine request_coroutine_;
+  StreamCoroutine response_coroutine_;
 };
 
 } // namespace Lua
@@ -0,0 +1,175 @@
+#include "source/extensions/filters/http/ratelimit/quota_lease.h"
+
+#include <algorithm>
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+
+namespace {
+
+constexpr uint64_t DefaultTtlMs = 1000;
+constexpr uint32_t DefaultMaxLeases = 1000;
+
+// Appends value to key, prefixed by its length so that the key can't be ambiguous.
+void appendToKey(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value);
+}
+
+} // namespace
+
+QuotaLeases::QuotaLeases(
+    const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source)
+    : hits_(config.hits()), ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, ttl, DefaultTtlMs)),
+      max_leases_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_leases, DefaultMaxLeases)),
+      time_source_(time_source), tls_(tls) {
+  tls_.set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalLeases>(); });
+}
+
+std::string QuotaLeases::key(const std::vector<Envoy::RateLimit::Descriptor>& descriptors) {
+  std::string key;
+  for (const Envoy::RateLimit::Descriptor& descriptor : descriptors) {
+    absl::StrAppend(&key, descriptor.entries_.size(), ";");
+    for (const Envoy::RateLimit::DescriptorEntry& entry : descriptor.entries_) {
+      appendToKey(key, entry.key_);
+      appendToKey(key, entry.value_);
+    }
+    if (descriptor.limit_.has_value()) {
+      absl::StrAppend(&key, "limit:", descriptor.limit_->requests_per_unit_, "/",
+                      static_cast<int>(descriptor.limit_->unit_), ";");
+    }
+  }
+  return key;
+}
+
+QuotaLeases::AcquireResult QuotaLeases::acquire(const std::string& key, Waiter& waiter) {
+  ThreadLocalLeases& local = *tls_;
+  if (auto it = local.leases_.find(key); it != local.leases_.end()) {
+    if (it->second.expiry_ > time_source_.monotonicTime()) {
+      if (--it->second.hits_ == 0) {
+        local.leases_.erase(it);
+      }
+      return AcquireResult::Hit;
+    }
+    local.leases_.erase(it);
+  }
+
+  auto [it, inserted] = local.fetches_.try_emplace(key);
+  if (inserted) {
+    it->second.fetcher_ = &waiter;
+    return AcquireResult::Fetch;
+  }
+  // Also wait while the hits of a fetched lease are handed out, since the waiter is then served
+  // by them.
+  it->second.waiters_.push_back(&waiter);
+  return AcquireResult::Wait;
+}
+
+void QuotaLeases::leaseFetched(const std::string& key,
+                               absl::optional<std::chrono::milliseconds> reset) {
+  ThreadLocalLeases& local = *tls_;
+  auto it = local.fetches_.find(key);
+  if (it == local.fetches_.end()) {
+    return;
+  }
+  it->second.fetcher_ = nullptr;
+
+  const std::chrono::milliseconds ttl = reset.has_value() ? std::min(ttl_, *reset) : ttl_;
+  const MonotonicTime expiry = time_source_.monotonicTime() + ttl;
+  // The fetcher used one of the hits.
+  uint32_t hits = hits_ - 1;
+  while (hits > 0) {
+    Waiter* waiter = nextWaiter(key);
+    if (waiter == nullptr) {
+      break;
+    }
+    hits--;
+    waiter->onLeaseHit();
+  }
+
+  if (hits > 0 && ttl.count() > 0) {
+    storeLease(key, {hits, expiry});
+  }
+  handOverFetch(key);
+}
+
+void QuotaLeases::leaseDenied(const std::string& key,
+                              Filters::Common::RateLimit::LimitStatus status,
+                              const Http::ResponseHeaderMap* response_headers_to_add,
+                              const std::string& response_body) {
+  ThreadLocalLeases& local = *tls_;
+  auto it = local.fetches_.find(key);
+  if (it == local.fetches_.end()) {
+    return;
+  }
+  it->second.fetcher_ = nullptr;
+
+  while (Waiter* waiter = nextWaiter(key)) {
+    waiter->onLeaseDenied(status, response_headers_to_add, response_body);
+  }
+  local.fetches_.erase(key);
+}
+
+void QuotaLeases::cancel(const std::string& key, Waiter& waiter) {
+  ThreadLocalLeases& local = *tls_;
+  auto it = local.fetches_.find(key);
+  if (it == local.fetches_.end()) {
+    return;
+  }
+  if (it->second.fetcher_ == &waiter) {
+    it->second.fetcher_ = nullptr;
+    handOverFetch(key);
+  } else {
+    it->second.waiters_.remove(&waiter);
+  }
+}
+
+QuotaLeases::Waiter* QuotaLeases::nextWaiter(const std::string& key) {
+  ThreadLocalLeases& local = *tls_;
+  auto it = local.fetches_.find(key);
+  if (it == local.fetches_.end() || it->second.waiters_.empty()) {
+    return nullptr;
+  }
+  Waiter* waiter = it->second.waiters_.front();
+  it->second.waiters_.pop_front();
+  return waiter;
+}
+
+void QuotaLeases::handOverFetch(const std::string& key) {
+  ThreadLocalLeases& local = *tls_;
+  auto it = local.fetches_.find(key);
+  if (it == local.fetches_.end() || it->second.fetcher_ != nullptr) {
+    return;
+  }
+  if (it->second.waiters_.empty()) {
+    local.fetches_.erase(it);
+    return;
+  }
+  Waiter* fetcher = it->second.waiters_.front();
+  it->second.waiters_.pop_front();
+  it->second.fetcher_ = fetcher;
+  fetcher->onLeaseFetch();
+}
+
+void QuotaLeases::storeLease(const std::string& key, Lease lease) {
+  ThreadLocalLeases& local = *tls_;
+  if (local.leases_.size() >= max_leases_ && !local.leases_.contains(key)) {
+    const MonotonicTime now = time_source_.monotonicTime();
+    absl::erase_if(local.leases_, [now](const auto& entry) { return entry.second.expiry_ <= now; });
+    if (local.leases_.size() >= max_leases_) {
+      return;
+    }
+  }
+  local.leases_[key] = lease;
+}
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/pure.h"
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ratelimit/v3/rate_limit.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/ratelimit/ratelimit.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/filters/common/ratelimit/ratelimit.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+
+/**
+ * Hits leased from the rate limit service in batches, so that the requests of a worker with the
+ * same descriptors are allowed without calling the rate limit service until the leased hits are
+ * used or the lease expires. The requests arriving while a lease is fetched wait for it instead of
+ * calling the rate limit service too.
+ */
+class QuotaLeases {
+public:
+  /**
+   * A request acquiring a hit of a lease.
+   */
+  class Waiter {
+  public:
+    virtual ~Waiter() = default;
+
+    /**
+     * Called when the waiter got a hit of the lease it waited for.
+     */
+    virtual void onLeaseHit() PURE;
+
+    /**
+     * Called when the waiter has to fetch the lease itself, because the lease it waited for had no
+     * hit left for it or its fetch was cancelled.
+     */
+    virtual void onLeaseFetch() PURE;
+
+    /**
+     * Called when the rate limit service didn't grant the lease the waiter waited for.
+     * @param status supplies the status of the response.
+     * @param response_headers_to_add supplies the headers of the response to add to the downstream
+     *        response, if any.
+     * @param response_body supplies the body of the response.
+     */
+    virtual void onLeaseDenied(Filters::Common::RateLimit::LimitStatus status,
+                               const Http::ResponseHeaderMap* response_headers_to_add,
+                               const std::string& response_body) PURE;
+  };
+
+  enum class AcquireResult {
+    // The waiter got a hit of the lease.
+    Hit,
+    // The lease is being fetched, and the waiter will be called back.
+    Wait,
+    // The waiter has to fetch the lease, and then call leaseFetched() or leaseDenied().
+    Fetch,
+  };
+
+  QuotaLeases(const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease& config,
+              ThreadLocal::SlotAllocator& tls, TimeSource& time_source);
+
+  /**
+   * @return the number of hits requested from the rate limit service for a lease.
+   */
+  uint32_t hits() const { return hits_; }
+
+  /**
+   * @return the key of the lease of the descriptors.
+   */
+  static std::string key(const std::vector<Envoy::RateLimit::Descriptor>& descriptors);
+
+  /**
+   * Acquires a hit of the lease of key for waiter.
+   */
+  AcquireResult acquire(const std::string& key, Waiter& waiter);
+
+  /**
+   * Stores the lease of key fetched by its fetcher, which used one of its hits, and hands its hits
+   * to the waiters.
+   * @param reset supplies the time until a limit of the descriptors resets, if known.
+   */
+  void leaseFetched(const std::string& key, absl::optional<std::chrono::milliseconds> reset);
+
+  /**
+   * Passes the response denying the lease of key on to its waiters.
+   */
+  void leaseDenied(const std::string& key, Filters::Common::RateLimit::LimitStatus status,
+                   const Http::ResponseHeaderMap* response_headers_to_add,
+                   const std::string& response_body);
+
+  /**
+   * Removes waiter, which waits for or fetches the lease of key. The fetch of the lease is handed
+   * over to the next waiter, if any.
+   */
+  void cancel(const std::string& key, Waiter& waiter);
+
+private:
+  struct Lease {
+    uint32_t hits_;
+    MonotonicTime expiry_;
+  };
+
+  struct Fetch {
+    // The waiter calling the rate limit service, or nullptr while the lease is handed out.
+    Waiter* fetcher_{};
+    std::list<Waiter*> waiters_;
+  };
+
+  struct ThreadLocalLeases : public ThreadLocal::ThreadLocalObject {
+    absl::flat_hash_map<std::string, Lease> leases_;
+    absl::flat_hash_map<std::string, Fetch> fetches_;
+  };
+
+  // Pops the next waiter of the lease of key. The fetch is looked up every time, since the
+  // callbacks of the waiters may cancel other waiters.
+  Waiter* nextWaiter(const std::string& key);
+  // Makes the next waiter of the lease of key fetch it, or else forgets the fetch.
+  void handOverFetch(const std::string& key);
+  void storeLease(const std::string& key, Lease lease);
+
+  const uint32_t hits_;
+  const std::chrono::milliseconds ttl_;
+  const uint32_t max_leases_;
+  TimeSource& time_source_;
+  ThreadLocal::TypedSlot<ThreadLocalLeases> tls_;
+};
+
+using QuotaLeasesPtr = std::unique_ptr<QuotaLeases>;
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
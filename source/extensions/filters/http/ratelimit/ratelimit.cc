@@ -1,5 +1,7 @@
 #include "source/extensions/filters/http/ratelimit/ratelimit.h"
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -10,6 +12,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/http/codes.h"
 #include "source/common/http/header_utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/router/config_impl.h"
 #include "source/extensions/filters/http/ratelimit/ratelimit_headers.h"
 
@@ -66,12 +69,42 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
     break;
   }
 
-  if (!descriptors.empty()) {
+  if (descriptors.empty()) {
+    return;
+  }
+  if (QuotaLeases* leases = config_->quotaLeases(); leases != nullptr) {
+    acquireLease(*leases, std::move(descriptors));
+  } else {
+    callRateLimitService(descriptors, 0);
+  }
+}
+
+void Filter::callRateLimitService(const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                                  uint32_t hits_addend) {
+  state_ = State::Calling;
+  initiating_call_ = true;
+  client_->limit(*this, config_->domain(), descriptors, callbacks_->activeSpan(),
+                 callbacks_->streamInfo(), hits_addend);
+  initiating_call_ = false;
+}
+
+void Filter::acquireLease(QuotaLeases& leases,
+                          std::vector<Envoy::RateLimit::Descriptor>&& descriptors) {
+  lease_key_ = QuotaLeases::key(descriptors);
+  switch (leases.acquire(lease_key_, *this)) {
+  case QuotaLeases::AcquireResult::Hit:
+    cluster_->statsScope().counterFromStatName(config_->statNames().lease_hit_).inc();
+    break;
+  case QuotaLeases::AcquireResult::Wait:
     state_ = State::Calling;
-    initiating_call_ = true;
-    client_->limit(*this, config_->domain(), descriptors, callbacks_->activeSpan(),
-                   callbacks_->streamInfo());
-    initiating_call_ = false;
+    lease_state_ = LeaseState::Waiting;
+    lease_descriptors_ = std::move(descriptors);
+    break;
+  case QuotaLeases::AcquireResult::Fetch:
+    lease_state_ = LeaseState::Fetching;
+    lease_descriptors_ = std::move(descriptors);
+    callRateLimitService(lease_descriptors_, leases.hits());
+    break;
   }
 }
 
@@ -132,10 +165,68 @@ void Filter::setEncoderFilterCallbacks(Http::StreamEncoderFilterCallbacks&) {}
 void Filter::onDestroy() {
   if (state_ == State::Calling) {
     state_ = State::Complete;
-    client_->cancel();
+    if (lease_state_ != LeaseState::Waiting) {
+      client_->cancel();
+    }
+    if (lease_state_ != LeaseState::None) {
+      lease_state_ = LeaseState::None;
+      config_->quotaLeases()->cancel(lease_key_, *this);
+    }
   }
 }
 
+void Filter::onLeaseHit() {
+  ASSERT(lease_state_ == LeaseState::Waiting);
+  lease_state_ = LeaseState::None;
+  state_ = State::Complete;
+  cluster_->statsScope().counterFromStatName(config_->statNames().lease_hit_).inc();
+  callbacks_->continueDecoding();
+}
+
+void Filter::onLeaseFetch() {
+  ASSERT(lease_state_ == LeaseState::Waiting);
+  lease_state_ = LeaseState::Fetching;
+  // Unlike the calls started when decoding the headers, a response completing this call inline
+  // must continue decoding.
+  client_->limit(*this, config_->domain(), lease_descriptors_, callbacks_->activeSpan(),
+                 callbacks_->streamInfo(), config_->quotaLeases()->hits());
+}
+
+void Filter::onLeaseDenied(Filters::Common::RateLimit::LimitStatus status,
+                           const Http::ResponseHeaderMap* response_headers_to_add,
+                           const std::string& response_body) {
+  ASSERT(lease_state_ == LeaseState::Waiting);
+  lease_state_ = LeaseState::None;
+  complete(status, nullptr,
+           response_headers_to_add != nullptr
+               ? Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*response_headers_to_add)
+               : nullptr,
+           nullptr, response_body, nullptr);
+}
+
+void Filter::completeLease(
+    Filters::Common::RateLimit::LimitStatus status,
+    const Filters::Common::RateLimit::DescriptorStatusList* descriptor_statuses,
+    const std::string& response_body) {
+  QuotaLeases& leases = *config_->quotaLeases();
+  if (status != Filters::Common::RateLimit::LimitStatus::OK) {
+    leases.leaseDenied(lease_key_, status, response_headers_to_add_.get(), response_body);
+    return;
+  }
+
+  absl::optional<std::chrono::milliseconds> reset;
+  if (descriptor_statuses != nullptr) {
+    for (const auto& descriptor_status : *descriptor_statuses) {
+      if (descriptor_status.has_duration_until_reset()) {
+        const std::chrono::milliseconds descriptor_reset(
+            DurationUtil::durationToMilliseconds(descriptor_status.duration_until_reset()));
+        reset = std::min(reset.value_or(descriptor_reset), descriptor_reset);
+      }
+    }
+  }
+  leases.leaseFetched(lease_key_, reset);
+}
+
 void Filter::complete(Filters::Common::RateLimit::LimitStatus status,
                       Filters::Common::RateLimit::DescriptorStatusListPtr&& descriptor_statuses,
                       Http::ResponseHeaderMapPtr&& response_headers_to_add,
@@ -144,6 +235,11 @@ void Filter::complete(Filters::Common::RateLimit::LimitStatus status,
                       Filters::Common::RateLimit::DynamicMetadataPtr&& dynamic_metadata) {
   state_ = State::Complete;
   response_headers_to_add_ = std::move(response_headers_to_add);
+  if (lease_state_ == LeaseState::Fetching) {
+    lease_state_ = LeaseState::None;
+    // The waiters for the lease get the response before headers are added for this request.
+    completeLease(status, descriptor_statuses.get(), response_body);
+  }
   Http::HeaderMapPtr req_headers_to_add = std::move(request_headers_to_add);
   Stats::StatName empty_stat_name;
   Filters::Common::RateLimit::StatNames& stat_names = config_->statNames();
@@ -12,6 +12,7 @@
 #include "envoy/ratelimit/ratelimit.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
+#include "envoy/thread_local/thread_local.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "source/common/common/assert.h"
@@ -19,6 +20,7 @@
 #include "source/common/router/header_parser.h"
 #include "source/extensions/filters/common/ratelimit/ratelimit.h"
 #include "source/extensions/filters/common/ratelimit/stat_names.h"
+#include "source/extensions/filters/http/ratelimit/quota_lease.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -42,7 +44,8 @@ class FilterConfig {
 public:
   FilterConfig(const envoy::extensions::filters::http::ratelimit::v3::RateLimit& config,
                const LocalInfo::LocalInfo& local_info, Stats::Scope& scope,
-               Runtime::Loader& runtime, Http::Context& http_context)
+               Runtime::Loader& runtime, Http::Context& http_context,
+               ThreadLocal::SlotAllocator& tls, TimeSource& time_source)
       : domain_(config.domain()), stage_(static_cast<uint64_t>(config.stage())),
         request_type_(config.request_type().empty() ? stringToType("both")
                                                     : stringToType(config.request_type())),
@@ -59,7 +62,10 @@ public:
         http_context_(http_context), stat_names_(scope.symbolTable()),
         rate_limited_status_(toErrorCode(config.rate_limited_status().code())),
         response_headers_parser_(
-            Envoy::Router::HeaderParser::configure(config.response_headers_to_add())) {}
+            Envoy::Router::HeaderParser::configure(config.response_headers_to_add())),
+        quota_leases_(config.has_quota_lease() ? std::make_unique<QuotaLeases>(
+                                                     config.quota_lease(), tls, time_source)
+                                               : nullptr) {}
   const std::string& domain() const { return domain_; }
   const LocalInfo::LocalInfo& localInfo() const { return local_info_; }
   uint64_t stage() const { return stage_; }
@@ -76,6 +82,8 @@ public:
   Filters::Common::RateLimit::StatNames& statNames() { return stat_names_; }
   Http::Code rateLimitedStatus() { return rate_limited_status_; }
   const Router::HeaderParser& responseHeadersParser() const { return *response_headers_parser_; }
+  // The hits leased from the rate limit service, or nullptr if they aren't leased.
+  QuotaLeases* quotaLeases() { return quota_leases_.get(); }
 
 private:
   static FilterRequestType stringToType(const std::string& request_type) {
@@ -111,6 +119,7 @@ private:
   Filters::Common::RateLimit::StatNames stat_names_;
   const Http::Code rate_limited_status_;
   Router::HeaderParserPtr response_headers_parser_;
+  const QuotaLeasesPtr quota_leases_;
 };
 
 using FilterConfigSharedPtr = std::shared_ptr<FilterConfig>;
@@ -135,7 +144,9 @@ private:
  * HTTP rate limit filter. Depending on the route configuration, this filter calls the global
  * rate limiting service before allowing further filter iteration.
  */
-class Filter : public Http::StreamFilter, public Filters::Common::RateLimit::RequestCallbacks {
+class Filter : public Http::StreamFilter,
+               public Filters::Common::RateLimit::RequestCallbacks,
+               public QuotaLeases::Waiter {
 public:
   Filter(FilterConfigSharedPtr config, Filters::Common::RateLimit::ClientPtr&& client)
       : config_(config), client_(std::move(client)) {}
@@ -167,8 +178,21 @@ public:
                 const std::string& response_body,
                 Filters::Common::RateLimit::DynamicMetadataPtr&& dynamic_metadata) override;
 
+  // QuotaLeases::Waiter
+  void onLeaseHit() override;
+  void onLeaseFetch() override;
+  void onLeaseDenied(Filters::Common::RateLimit::LimitStatus status,
+                     const Http::ResponseHeaderMap* response_headers_to_add,
+                     const std::string& response_body) override;
+
 private:
   void initiateCall(const Http::RequestHeaderMap& headers);
+  void callRateLimitService(const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+                            uint32_t hits_addend);
+  void acquireLease(QuotaLeases& leases, std::vector<Envoy::RateLimit::Descriptor>&& descriptors);
+  void completeLease(Filters::Common::RateLimit::LimitStatus status,
+                     const Filters::Common::RateLimit::DescriptorStatusList* descriptor_statuses,
+                     const std::string& response_body);
   void populateRateLimitDescriptors(const Router::RateLimitPolicy& rate_limit_policy,
                                     std::vector<Envoy::RateLimit::Descriptor>& descriptors,
                                     const Http::RequestHeaderMap& headers) const;
@@ -179,6 +203,8 @@ private:
   Http::Context& httpContext() { return config_->httpContext(); }
 
   enum class State { NotStarted, Calling, Complete, Responded };
+  // Whether the request waits for or fetches a lease while it is calling.
+  enum class LeaseState { None, Waiting, Fetching };
 
   FilterConfigSharedPtr config_;
   Filters::Common::RateLimit::ClientPtr client_;
@@ -189,6 +215,10 @@ private:
   bool initiating_call_{};
   Http::ResponseHeaderMapPtr response_headers_to_add_;
   Http::RequestHeaderMap* request_headers_{};
+  LeaseState lease_state_{LeaseState::None};
+  // The lease the request waits for or fetches, and the descriptors to fetch it with.
+  std::string lease_key_;
+  std::vector<Envoy::RateLimit::Descriptor> lease_descriptors_;
 };
 
 } // namespace RateLimitFilter
@@ -64,7 +64,8 @@ using HttpPerRequestTapperPtr = std::unique_ptr<HttpPerRequestTapper>;
 class HttpTapConfig : public virtual Extensions::Common::Tap::TapConfig {
 public:
   /**
-   * @return a new per-request HTTP tapper which is used to handle tapping of a discrete request.
+   * @return a new per-request HTTP tapper which is used to handle tapping of a discrete request,
+   *         or nullptr if the request isn't sampled.
    * @param stream_id supplies the owning HTTP stream ID.
    */
   virtual HttpPerRequestTapperPtr createPerRequestTapper(uint64_t stream_id) PURE;
@@ -27,10 +27,13 @@ fillHeaderList(Protobuf::RepeatedPtrField<envoy::config::core::v3::HeaderValue>*
 } // namespace
 
 HttpTapConfigImpl::HttpTapConfigImpl(const envoy::config::tap::v3::TapConfig& proto_config,
-                                     Common::Tap::Sink* admin_streamer)
-    : TapCommon::TapConfigBaseImpl(std::move(proto_config), admin_streamer) {}
+                                     Common::Tap::Sink* admin_streamer, Api::Api& api)
+    : TapCommon::TapConfigBaseImpl(std::move(proto_config), admin_streamer, api) {}
 
 HttpPerRequestTapperPtr HttpTapConfigImpl::createPerRequestTapper(uint64_t stream_id) {
+  if (!sampled(stream_id)) {
+    return nullptr;
+  }
   return std::make_unique<HttpPerRequestTapperImpl>(shared_from_this(), stream_id);
 }
 
@@ -47,11 +47,16 @@ namespace Extensions {
 namespace ListenerFilters {
 namespace ProxyProtocol {
 
+namespace {
+constexpr absl::string_view DefaultMetadataNamespace = "envoy.filters.listener.proxy_protocol";
+} // namespace
+
 Config::Config(
     Stats::Scope& scope,
     const envoy::extensions::filters::listener::proxy_protocol::v3::ProxyProtocol& proto_config)
     : stats_{ALL_PROXY_PROTOCOL_STATS(POOL_COUNTER(scope))},
       allow_requests_without_proxy_protocol_(proto_config.allow_requests_without_proxy_protocol()),
+      retain_original_header_(proto_config.retain_original_header()),
       pass_all_tlvs_(proto_config.has_pass_through_tlvs()
                          ? proto_config.pass_through_tlvs().match_type() ==
                                ProxyProtocolPassThroughTLVs::INCLUDE_ALL
@@ -156,11 +161,17 @@ ReadOrParseState Filter::parseBuffer(Network::ListenerFilterBuffer& buffer) {
                              proxy_protocol_header_.value().extensions_length_));
     }
 
+    std::string original_header;
+    if (config_->retainOriginalHeader()) {
+      original_header.assign(static_cast<const char*>(buffer.rawSlice().mem_),
+                             proxy_protocol_header_.value().wholeHeaderLength());
+    }
     cb_->filterState().setData(
         Network::ProxyProtocolFilterState::key(),
         std::make_unique<Network::ProxyProtocolFilterState>(Network::ProxyProtocolData{
             proxy_protocol_header_.value().remote_address_,
-            proxy_protocol_header_.value().local_address_, parsed_tlvs_}),
+            proxy_protocol_header_.value().local_address_, std::move(parsed_tlvs_),
+            std::move(original_header)}),
         StreamInfo::FilterState::StateType::Mutable, StreamInfo::FilterState::LifeSpan::Connection);
   }
 
@@ -375,6 +386,9 @@ bool Filter::parseV1Header(const char* buf, size_t len) {
  *        See https://www.haproxy.org/download/2.1/doc/proxy-protocol.txt for details
  */
 bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
+  // The dynamic metadata of the needed TLVs is collected by namespace and set once per namespace.
+  // The TLVs which aren't needed are only validated, without allocating.
+  absl::flat_hash_map<absl::string_view, ProtobufWkt::Struct> metadata;
   size_t idx{0};
   while (idx < len) {
     const uint8_t tlv_type = buf[idx];
@@ -411,14 +425,10 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
       ProtobufWkt::Value metadata_value;
       metadata_value.set_string_value(tlv_value.data(), tlv_value.size());
 
-      std::string metadata_key = key_value_pair->metadata_namespace().empty()
-                                     ? "envoy.filters.listener.proxy_protocol"
-                                     : key_value_pair->metadata_namespace();
-
-      ProtobufWkt::Struct metadata(
-          (*cb_->dynamicMetadata().mutable_filter_metadata())[metadata_key]);
-      metadata.mutable_fields()->insert({key_value_pair->key(), metadata_value});
-      cb_->setDynamicMetadata(metadata_key, metadata);
+      const absl::string_view metadata_key = key_value_pair->metadata_namespace().empty()
+                                                 ? DefaultMetadataNamespace
+                                                 : key_value_pair->metadata_namespace();
+      metadata[metadata_key].mutable_fields()->insert({key_value_pair->key(), metadata_value});
     } else {
       ENVOY_LOG(trace,
                 "proxy_protocol: Skip TLV of type {} since it's not needed for dynamic metadata",
@@ -434,6 +444,10 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
     idx += tlv_value_length;
     ASSERT(idx <= len);
   }
+
+  for (const auto& [metadata_key, metadata_struct] : metadata) {
+    cb_->setDynamicMetadata(std::string(metadata_key), metadata_struct);
+  }
   return true;
 }
 
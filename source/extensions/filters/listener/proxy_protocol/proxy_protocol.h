@@ -71,9 +71,16 @@ public:
    */
   bool allowRequestsWithoutProxyProtocol() const;
 
+  /**
+   * Return true if the header as received is to be stored in the filter state, for it to be
+   * forwarded upstream verbatim.
+   */
+  bool retainOriginalHeader() const { return retain_original_header_; }
+
 private:
   absl::flat_hash_map<uint8_t, KeyValuePair> tlv_types_;
   const bool allow_requests_without_proxy_protocol_;
+  const bool retain_original_header_;
   const bool pass_all_tlvs_;
   absl::flat_hash_set<uint8_t> pass_through_tlvs_{};
 };
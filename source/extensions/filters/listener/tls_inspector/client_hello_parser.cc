@@ -0,0 +1,194 @@
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include <algorithm>
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+namespace {
+
+constexpr size_t HandshakeHeaderSize = 4;
+
+// The validations below mirror the ones BoringSSL makes on the extensions it parses before the
+// TLS inspector stops the handshake, so that the parser doesn't accept ClientHellos BoringSSL
+// wouldn't find TLS in.
+
+bool parseServerName(CBS contents, absl::string_view& server_name) {
+  CBS server_name_list, host_name;
+  uint8_t name_type;
+  if (!CBS_get_u16_length_prefixed(&contents, &server_name_list) ||
+      !CBS_get_u8(&server_name_list, &name_type) ||
+      !CBS_get_u16_length_prefixed(&server_name_list, &host_name) ||
+      CBS_len(&server_name_list) != 0 || CBS_len(&contents) != 0) {
+    return false;
+  }
+  if (name_type != TLSEXT_NAMETYPE_host_name || CBS_len(&host_name) == 0 ||
+      CBS_len(&host_name) > TLSEXT_MAXLEN_host_name || CBS_contains_zero_byte(&host_name)) {
+    return false;
+  }
+  server_name = absl::string_view(reinterpret_cast<const char*>(CBS_data(&host_name)),
+                                  CBS_len(&host_name));
+  return true;
+}
+
+bool validSupportedGroups(CBS contents) {
+  CBS groups;
+  return CBS_get_u16_length_prefixed(&contents, &groups) && CBS_len(&contents) == 0 &&
+         CBS_len(&groups) != 0 && CBS_len(&groups) % 2 == 0;
+}
+
+bool validEcPointFormats(CBS contents) {
+  CBS formats;
+  if (!CBS_get_u8_length_prefixed(&contents, &formats) || CBS_len(&contents) != 0) {
+    return false;
+  }
+  // The uncompressed point format is mandatory, see RFC 4492 section 5.1.2.
+  const uint8_t* begin = CBS_data(&formats);
+  const uint8_t* end = begin + CBS_len(&formats);
+  return std::find(begin, end, TLSEXT_ECPOINTFORMAT_uncompressed) != end;
+}
+
+// Whether the supported_versions extension offers one of the versions the inspector negotiates.
+bool offersSupportedVersion(CBS contents) {
+  CBS versions;
+  if (!CBS_get_u8_length_prefixed(&contents, &versions) || CBS_len(&contents) != 0 ||
+      CBS_len(&versions) == 0 || CBS_len(&versions) % 2 != 0) {
+    return false;
+  }
+  bool supported = false;
+  uint16_t version;
+  while (CBS_get_u16(&versions, &version)) {
+    supported |= version >= TLS1_VERSION && version <= TLS1_3_VERSION;
+  }
+  return supported;
+}
+
+} // namespace
+
+ClientHelloParseResult ClientHelloParser::parse(absl::Span<const uint8_t> data,
+                                                SSL_CLIENT_HELLO& client_hello,
+                                                absl::string_view& server_name) {
+  CBS input;
+  CBS_init(&input, data.data(), data.size());
+
+  // Each header is checked as soon as it's there, so that data which isn't a ClientHello goes to
+  // BoringSSL without waiting for more.
+  uint8_t content_type;
+  if (!CBS_get_u8(&input, &content_type)) {
+    return ClientHelloParseResult::NeedMoreData;
+  }
+  if (content_type != SSL3_RT_HANDSHAKE) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  uint16_t record_version, record_length;
+  if (!CBS_get_u16(&input, &record_version) || !CBS_get_u16(&input, &record_length)) {
+    return ClientHelloParseResult::NeedMoreData;
+  }
+  if ((record_version >> 8) != SSL3_VERSION_MAJOR || record_length < HandshakeHeaderSize ||
+      record_length > SSL3_RT_MAX_PLAIN_LENGTH) {
+    return ClientHelloParseResult::Unsupported;
+  }
+
+  // Only a ClientHello filling its record entirely is supported.
+  uint8_t message_type;
+  uint32_t message_length;
+  if (!CBS_get_u8(&input, &message_type)) {
+    return ClientHelloParseResult::NeedMoreData;
+  }
+  if (message_type != SSL3_MT_CLIENT_HELLO) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  if (!CBS_get_u24(&input, &message_length)) {
+    return ClientHelloParseResult::NeedMoreData;
+  }
+  if (message_length + HandshakeHeaderSize != record_length) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  CBS message;
+  if (!CBS_get_bytes(&input, &message, message_length)) {
+    return ClientHelloParseResult::NeedMoreData;
+  }
+
+  client_hello = SSL_CLIENT_HELLO{};
+  client_hello.client_hello = CBS_data(&message);
+  client_hello.client_hello_len = CBS_len(&message);
+  CBS random, session_id, cipher_suites, compression_methods;
+  if (!CBS_get_u16(&message, &client_hello.version) ||
+      !CBS_get_bytes(&message, &random, SSL3_RANDOM_SIZE) ||
+      !CBS_get_u8_length_prefixed(&message, &session_id) ||
+      CBS_len(&session_id) > SSL_MAX_SSL_SESSION_ID_LENGTH ||
+      !CBS_get_u16_length_prefixed(&message, &cipher_suites) || CBS_len(&cipher_suites) < 2 ||
+      CBS_len(&cipher_suites) % 2 != 0 ||
+      !CBS_get_u8_length_prefixed(&message, &compression_methods) ||
+      CBS_len(&compression_methods) == 0) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  // The extensions are optional, a ClientHello without them ends after the compression methods.
+  CBS extensions;
+  CBS_init(&extensions, nullptr, 0);
+  if (CBS_len(&message) != 0 &&
+      (!CBS_get_u16_length_prefixed(&message, &extensions) || CBS_len(&message) != 0)) {
+    return ClientHelloParseResult::Unsupported;
+  }
+  // BoringSSL negotiates from the legacy version unless the supported_versions extension is
+  // present; requiring both to be acceptable holds whichever of them it goes by.
+  if (client_hello.version < TLS1_VERSION) {
+    return ClientHelloParseResult::Unsupported;
+  }
+
+  client_hello.random = CBS_data(&random);
+  client_hello.random_len = CBS_len(&random);
+  client_hello.session_id = CBS_data(&session_id);
+  client_hello.session_id_len = CBS_len(&session_id);
+  client_hello.cipher_suites = CBS_data(&cipher_suites);
+  client_hello.cipher_suites_len = CBS_len(&cipher_suites);
+  client_hello.compression_methods = CBS_data(&compression_methods);
+  client_hello.compression_methods_len = CBS_len(&compression_methods);
+  client_hello.extensions = CBS_data(&extensions);
+  client_hello.extensions_len = CBS_len(&extensions);
+
+  server_name = {};
+  absl::InlinedVector<uint16_t, 32> types;
+  while (CBS_len(&extensions) != 0) {
+    uint16_t type;
+    CBS contents;
+    if (!CBS_get_u16(&extensions, &type) || !CBS_get_u16_length_prefixed(&extensions, &contents) ||
+        std::find(types.begin(), types.end(), type) != types.end()) {
+      return ClientHelloParseResult::Unsupported;
+    }
+    types.push_back(type);
+
+    bool valid = true;
+    switch (type) {
+    case TLSEXT_TYPE_server_name:
+      valid = parseServerName(contents, server_name);
+      break;
+    case TLSEXT_TYPE_supported_groups:
+      valid = validSupportedGroups(contents);
+      break;
+    case TLSEXT_TYPE_ec_point_formats:
+      valid = validEcPointFormats(contents);
+      break;
+    case TLSEXT_TYPE_supported_versions:
+      valid = offersSupportedVersion(contents);
+      break;
+    default:
+      // The other extensions are either ignored by the inspector or, like ALPN, checked by
+      // BoringSSL only after the handshake was stopped.
+      break;
+    }
+    if (!valid) {
+      return ClientHelloParseResult::Unsupported;
+    }
+  }
+  return ClientHelloParseResult::Complete;
+}
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
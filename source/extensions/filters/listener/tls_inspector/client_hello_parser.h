@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+enum class ClientHelloParseResult {
+  // The ClientHello was parsed.
+  Complete,
+  // The data is the start of a ClientHello the parser supports, more data is needed.
+  NeedMoreData,
+  // The data isn't a ClientHello the parser supports. It may still be one BoringSSL accepts, or
+  // not TLS at all; only BoringSSL can tell.
+  Unsupported
+};
+
+/**
+ * Parses the TLS ClientHello at the start of a connection in a single pass, without setting up a
+ * BoringSSL handshake for it. The parser only accepts ClientHellos BoringSSL would accept up to the
+ * point where the TLS inspector stops the handshake: a ClientHello in a single record, offering a
+ * TLS version the inspector supports, with well-formed extensions of the kinds the inspector and
+ * BoringSSL read before stopping. Anything else, e.g. a ClientHello fragmented over several
+ * records, is reported as Unsupported so that the caller can leave the decision to BoringSSL.
+ */
+class ClientHelloParser {
+public:
+  /**
+   * @param data the bytes received on the connection so far.
+   * @param client_hello receives the fields of the ClientHello on Complete, pointing into data.
+   *        Its ssl field is null, it can be used with SSL_early_callback_ctx_extension_get().
+   * @param server_name receives the host name of the server_name extension on Complete, or an
+   *        empty view if there is none.
+   * @return ClientHelloParseResult the result of the parse.
+   */
+  static ClientHelloParseResult parse(absl::Span<const uint8_t> data,
+                                      SSL_CLIENT_HELLO& client_hello,
+                                      absl::string_view& server_name);
+};
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
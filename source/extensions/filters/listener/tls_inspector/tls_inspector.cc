@@ -16,6 +16,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/hex.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
 
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -39,7 +41,9 @@ Config::Config(
       ssl_ctx_(SSL_CTX_new(TLS_with_buffers_method())),
       enable_ja3_fingerprinting_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, enable_ja3_fingerprinting, false)),
-      max_client_hello_size_(max_client_hello_size) {
+      max_client_hello_size_(max_client_hello_size),
+      native_client_hello_parser_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.tls_inspector_native_client_hello_parser")) {
 
   if (max_client_hello_size_ > TLS_MAX_CLIENT_HELLO) {
     throw EnvoyException(fmt::format("max_client_hello_size of {} is greater than maximum of {}.",
@@ -53,14 +57,7 @@ Config::Config(
   SSL_CTX_set_select_certificate_cb(
       ssl_ctx_.get(), [](const SSL_CLIENT_HELLO* client_hello) -> ssl_select_cert_result_t {
         Filter* filter = static_cast<Filter*>(SSL_get_app_data(client_hello->ssl));
-        filter->createJA3Hash(client_hello);
-
-        const uint8_t* data;
-        size_t len;
-        if (SSL_early_callback_ctx_extension_get(
-                client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &data, &len)) {
-          filter->onALPN(data, len);
-        }
+        filter->onClientHello(client_hello);
         return ssl_select_cert_success;
       });
   SSL_CTX_set_tlsext_servername_callback(
@@ -77,10 +74,8 @@ Config::Config(
 
 bssl::UniquePtr<SSL> Config::newSsl() { return bssl::UniquePtr<SSL>{SSL_new(ssl_ctx_.get())}; }
 
-Filter::Filter(const ConfigSharedPtr& config) : config_(config), ssl_(config_->newSsl()) {
-  SSL_set_app_data(ssl_.get(), this);
-  SSL_set_accept_state(ssl_.get());
-}
+Filter::Filter(const ConfigSharedPtr& config)
+    : config_(config), native_parser_(config_->nativeClientHelloParser()) {}
 
 Network::FilterStatus Filter::onAccept(Network::ListenerFilterCallbacks& cb) {
   ENVOY_LOG(trace, "tls inspector: new connection accepted");
@@ -89,6 +84,17 @@ Network::FilterStatus Filter::onAccept(Network::ListenerFilterCallbacks& cb) {
   return Network::FilterStatus::StopIteration;
 }
 
+void Filter::onClientHello(const SSL_CLIENT_HELLO* ssl_client_hello) {
+  createJA3Hash(ssl_client_hello);
+
+  const uint8_t* data;
+  size_t len;
+  if (SSL_early_callback_ctx_extension_get(
+          ssl_client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &data, &len)) {
+    onALPN(data, len);
+  }
+}
+
 void Filter::onALPN(const unsigned char* data, unsigned int len) {
   CBS wire, list;
   CBS_init(&wire, reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(len));
@@ -128,10 +134,19 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   // Because we're doing a MSG_PEEK, data we've seen before gets returned every time, so
   // skip over what we've already processed.
   if (static_cast<uint64_t>(raw_slice.len_) > read_) {
-    const uint8_t* data = static_cast<const uint8_t*>(raw_slice.mem_) + read_;
-    const size_t len = raw_slice.len_ - read_;
-    read_ = raw_slice.len_;
-    ParseState parse_state = parseClientHello(data, len);
+    ParseState parse_state = ParseState::Continue;
+    if (native_parser_) {
+      // The native parser doesn't keep state between reads, it parses from the start each time.
+      parse_state =
+          parseClientHelloNatively(static_cast<const uint8_t*>(raw_slice.mem_), raw_slice.len_);
+    }
+    if (!native_parser_) {
+      // If the native parser just gave up, nothing has been read yet and BoringSSL gets it all.
+      const uint8_t* data = static_cast<const uint8_t*>(raw_slice.mem_) + read_;
+      const size_t len = raw_slice.len_ - read_;
+      read_ = raw_slice.len_;
+      parse_state = parseClientHello(data, len);
+    }
     switch (parse_state) {
     case ParseState::Error:
       cb_->socket().ioHandle().close();
@@ -148,7 +163,60 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   return Network::FilterStatus::StopIteration;
 }
 
+ParseState Filter::parseClientHelloNatively(const uint8_t* data, size_t len) {
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  switch (ClientHelloParser::parse(absl::MakeConstSpan(data, len), client_hello, server_name)) {
+  case ClientHelloParseResult::Complete:
+    read_ = len;
+    // The same calls, in the same order, as from the callbacks of BoringSSL.
+    onClientHello(&client_hello);
+    onServername(server_name);
+    return onHandshakeStopped();
+  case ClientHelloParseResult::NeedMoreData:
+    read_ = len;
+    return onNeedMoreData();
+  case ClientHelloParseResult::Unsupported:
+    ENVOY_LOG(trace, "tls inspector: ClientHello not supported by the native parser");
+    native_parser_ = false;
+    read_ = 0;
+    return ParseState::Continue;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+ParseState Filter::onNeedMoreData() {
+  if (read_ == config_->maxClientHelloSize()) {
+    // We've hit the specified size limit. This is an unreasonably large ClientHello;
+    // indicate failure.
+    config_->stats().client_hello_too_large_.inc();
+    return ParseState::Error;
+  }
+  return ParseState::Continue;
+}
+
+ParseState Filter::onHandshakeStopped() {
+  if (clienthello_success_) {
+    config_->stats().tls_found_.inc();
+    if (alpn_found_) {
+      config_->stats().alpn_found_.inc();
+    } else {
+      config_->stats().alpn_not_found_.inc();
+    }
+    cb_->socket().setDetectedTransportProtocol("tls");
+  } else {
+    config_->stats().tls_not_found_.inc();
+  }
+  return ParseState::Done;
+}
+
 ParseState Filter::parseClientHello(const void* data, size_t len) {
+  if (ssl_ == nullptr) {
+    ssl_ = config_->newSsl();
+    SSL_set_app_data(ssl_.get(), this);
+    SSL_set_accept_state(ssl_.get());
+  }
+
   // Ownership is passed to ssl_ in SSL_set_bio()
   bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(data, len));
 
@@ -165,26 +233,9 @@ ParseState Filter::parseClientHello(const void* data, size_t len) {
   ASSERT(ret <= 0);
   switch (SSL_get_error(ssl_.get(), ret)) {
   case SSL_ERROR_WANT_READ:
-    if (read_ == config_->maxClientHelloSize()) {
-      // We've hit the specified size limit. This is an unreasonably large ClientHello;
-      // indicate failure.
-      config_->stats().client_hello_too_large_.inc();
-      return ParseState::Error;
-    }
-    return ParseState::Continue;
+    return onNeedMoreData();
   case SSL_ERROR_SSL:
-    if (clienthello_success_) {
-      config_->stats().tls_found_.inc();
-      if (alpn_found_) {
-        config_->stats().alpn_found_.inc();
-      } else {
-        config_->stats().alpn_not_found_.inc();
-      }
-      cb_->socket().setDetectedTransportProtocol("tls");
-    } else {
-      config_->stats().tls_not_found_.inc();
-    }
-    return ParseState::Done;
+    return onHandshakeStopped();
   default:
     return ParseState::Error;
   }
@@ -56,6 +56,7 @@ public:
   bssl::UniquePtr<SSL> newSsl();
   bool enableJA3Fingerprinting() const { return enable_ja3_fingerprinting_; }
   uint32_t maxClientHelloSize() const { return max_client_hello_size_; }
+  bool nativeClientHelloParser() const { return native_client_hello_parser_; }
 
   static constexpr size_t TLS_MAX_CLIENT_HELLO = 64 * 1024;
   static const unsigned TLS_MIN_SUPPORTED_VERSION;
@@ -66,6 +67,7 @@ private:
   bssl::UniquePtr<SSL_CTX> ssl_ctx_;
   const bool enable_ja3_fingerprinting_;
   const uint32_t max_client_hello_size_;
+  const bool native_client_hello_parser_;
 };
 
 using ConfigSharedPtr = std::shared_ptr<Config>;
@@ -84,7 +86,11 @@ public:
 
 private:
   ParseState parseClientHello(const void* data, size_t len);
+  ParseState parseClientHelloNatively(const uint8_t* data, size_t len);
+  ParseState onNeedMoreData();
+  ParseState onHandshakeStopped();
   ParseState onRead();
+  void onClientHello(const SSL_CLIENT_HELLO* ssl_client_hello);
   void onALPN(const unsigned char* data, unsigned int len);
   void onServername(absl::string_view name);
   void createJA3Hash(const SSL_CLIENT_HELLO* ssl_client_hello);
@@ -92,7 +98,9 @@ private:
   ConfigSharedPtr config_;
   Network::ListenerFilterCallbacks* cb_{};
 
+  // Only created if the native parser is disabled or can't parse the ClientHello.
   bssl::UniquePtr<SSL> ssl_;
+  bool native_parser_;
   uint64_t read_{0};
   bool alpn_found_{false};
   bool clienthello_success_{false};
@@ -247,6 +247,7 @@ struct Transaction {
   void close() {
     active_ = false;
     key_.clear();
+    written_keys_.clear();
     if (connection_established_) {
       client_->close();
       connection_established_ = false;
@@ -258,6 +259,8 @@ struct Transaction {
   bool connection_established_{false};
   bool should_close_{false};
   std::string key_;
+  // The keys written by the commands queued in the transaction, if the local cache is enabled.
+  std::vector<std::string> written_keys_;
   ClientPtr client_;
   Network::ConnectionCallbacks* connection_cb_;
 };
@@ -159,6 +159,7 @@ void ClientImpl::onData(Buffer::Instance& data) {
     putOutlierEvent(Upstream::Outlier::Result::ExtOriginRequestFailed);
     host_->cluster().trafficStats()->upstream_cx_protocol_error_.inc();
     host_->stats().rq_error_.inc();
+    host_->localityLoadStats().incRqError();
     connection_->close(Network::ConnectionCloseType::NoFlush);
   }
 }
@@ -266,13 +267,16 @@ ClientImpl::PendingRequest::PendingRequest(ClientImpl& parent, ClientCallbacks&
   }
   parent.host_->cluster().trafficStats()->upstream_rq_total_.inc();
   parent.host_->stats().rq_total_.inc();
+  parent.host_->localityLoadStats().incRqTotal();
   parent.host_->cluster().trafficStats()->upstream_rq_active_.inc();
   parent.host_->stats().rq_active_.inc();
+  parent.host_->localityLoadStats().incRqActive();
 }
 
 ClientImpl::PendingRequest::~PendingRequest() {
   parent_.host_->cluster().trafficStats()->upstream_rq_active_.dec();
   parent_.host_->stats().rq_active_.dec();
+  parent_.host_->localityLoadStats().decRqActive();
 }
 
 void ClientImpl::PendingRequest::cancel() {
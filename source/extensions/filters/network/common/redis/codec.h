@@ -126,6 +126,16 @@ public:
   CompositeArray& asCompositeArray();
   const CompositeArray& asCompositeArray() const;
 
+  /**
+   * The payload of a large BulkString may be held by the slices of a buffer rather than a string,
+   * so that it can be decoded and encoded again without copying it. asString() copies such a
+   * payload into the string the first time it is called. The non-const asString() also releases
+   * the buffer, as the caller may then modify the string.
+   * @return the buffer holding the payload of a BulkString, or nullptr if the string holds it.
+   */
+  const std::shared_ptr<const Buffer::Instance>& bulkStringBuffer() const;
+  void bulkStringBuffer(std::shared_ptr<const Buffer::Instance>&& buffer);
+
   /**
    * Get/set the type of the RespValue. A RespValue can only be a single type at a time. Each time
    * type() is called the type is changed and then the type specific as* methods can be used.
@@ -136,14 +146,18 @@ public:
 private:
   union {
     std::vector<RespValue> array_;
-    std::string string_;
+    // Mutable so that the const asString() can copy the payload of bulk_string_buffer_ into it.
+    mutable std::string string_;
     int64_t integer_;
     CompositeArray composite_array_;
   };
 
   void cleanup();
+  void copyBulkStringBufferToString() const;
 
   RespType type_{};
+  // Shared by the copies of the value and by the buffers it is encoded into.
+  std::shared_ptr<const Buffer::Instance> bulk_string_buffer_;
 };
 
 using RespValuePtr = std::unique_ptr<RespValue>;
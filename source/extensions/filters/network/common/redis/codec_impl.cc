@@ -7,6 +7,7 @@
 
 #include "envoy/common/platform.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/utility.h"
@@ -68,15 +69,37 @@ const std::vector<RespValue>& RespValue::asArray() const {
 std::string& RespValue::asString() {
   ASSERT(type_ == RespType::BulkString || type_ == RespType::Error ||
          type_ == RespType::SimpleString);
+  if (bulk_string_buffer_ != nullptr) {
+    copyBulkStringBufferToString();
+    bulk_string_buffer_.reset();
+  }
   return string_;
 }
 
 const std::string& RespValue::asString() const {
   ASSERT(type_ == RespType::BulkString || type_ == RespType::Error ||
          type_ == RespType::SimpleString);
+  copyBulkStringBufferToString();
   return string_;
 }
 
+const std::shared_ptr<const Buffer::Instance>& RespValue::bulkStringBuffer() const {
+  ASSERT(type_ == RespType::BulkString);
+  return bulk_string_buffer_;
+}
+
+void RespValue::bulkStringBuffer(std::shared_ptr<const Buffer::Instance>&& buffer) {
+  ASSERT(type_ == RespType::BulkString);
+  string_.clear();
+  bulk_string_buffer_ = std::move(buffer);
+}
+
+void RespValue::copyBulkStringBufferToString() const {
+  if (bulk_string_buffer_ != nullptr && string_.size() != bulk_string_buffer_->length()) {
+    string_ = bulk_string_buffer_->toString();
+  }
+}
+
 int64_t& RespValue::asInteger() {
   ASSERT(type_ == RespType::Integer);
   return integer_;
@@ -98,6 +121,7 @@ const RespValue::CompositeArray& RespValue::asCompositeArray() const {
 }
 
 void RespValue::cleanup() {
+  bulk_string_buffer_.reset();
   // Need to manually delete because of the union.
   switch (type_) {
   case RespType::Array: {
@@ -162,7 +186,8 @@ RespValue::RespValue(const RespValue& other) : type_(RespType::Null) {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    asString() = other.asString();
+    string_ = other.string_;
+    bulk_string_buffer_ = other.bulk_string_buffer_;
     break;
   }
   case RespType::Integer: {
@@ -188,6 +213,7 @@ RespValue::RespValue(RespValue&& other) noexcept : type_(other.type_) {
   case RespType::BulkString:
   case RespType::Error: {
     new (&string_) std::string(std::move(other.string_));
+    bulk_string_buffer_ = std::move(other.bulk_string_buffer_);
     break;
   }
   case RespType::Integer: {
@@ -216,7 +242,8 @@ RespValue& RespValue::operator=(const RespValue& other) {
   case RespType::SimpleString:
   case RespType::BulkString:
   case RespType::Error: {
-    asString() = other.asString();
+    string_ = other.string_;
+    bulk_string_buffer_ = other.bulk_string_buffer_;
     break;
   }
   case RespType::Integer: {
@@ -248,6 +275,7 @@ RespValue& RespValue::operator=(RespValue&& other) noexcept {
   case RespType::BulkString:
   case RespType::Error: {
     string_ = std::move(other.string_);
+    bulk_string_buffer_ = std::move(other.bulk_string_buffer_);
     break;
   }
   case RespType::Integer: {
@@ -330,14 +358,28 @@ RespValue::CompositeArray::CompositeArrayConstIterator::empty() {
 }
 
 void DecoderImpl::decode(Buffer::Instance& data) {
-  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
-    parseSlice(slice);
-  }
+  while (data.length() > 0 || state_ == State::ValueComplete) {
+    if (state_ == State::BulkStringBody && pending_bulk_string_buffer_ != nullptr) {
+      // Move the slices of a large bulk string into its buffer instead of copying them. Only the
+      // slices it shares with the surrounding values are copied.
+      const uint64_t length_to_move = std::min(pending_integer_.integer_, data.length());
+      pending_bulk_string_buffer_->move(data, length_to_move);
+      pending_integer_.integer_ -= length_to_move;
+      if (pending_integer_.integer_ == 0) {
+        ENVOY_LOG(trace, "parse slice: BulkStringBody complete: {} bytes",
+                  pending_bulk_string_buffer_->length());
+        pending_value_stack_.front().value_->bulkStringBuffer(
+            std::move(pending_bulk_string_buffer_));
+        state_ = State::CR;
+      }
+      continue;
+    }
 
-  data.drain(data.length());
+    data.drain(parseSlice(data.frontSlice()));
+  }
 }
 
-void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
+uint64_t DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
   const char* buffer = reinterpret_cast<const char*>(slice.mem_);
   uint64_t remaining = slice.len_;
 
@@ -460,6 +502,12 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
         if (!pending_integer_.negative_) {
           // TODO(mattklein123): reserve and define max length since we don't stream currently.
           state_ = State::BulkStringBody;
+          if (bulk_string_buffer_threshold_ > 0 &&
+              pending_integer_.integer_ >= bulk_string_buffer_threshold_) {
+            // Let decode() move the body out of the input buffer.
+            pending_bulk_string_buffer_ = std::make_shared<Buffer::OwnedImpl>();
+            return slice.len_ - remaining;
+          }
         } else {
           // Null bulk string. Switch type to null and move to value complete.
           current_value.value_->type(RespType::Null);
@@ -547,6 +595,8 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
     }
     }
   }
+
+  return slice.len_;
 }
 
 void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
@@ -564,7 +614,11 @@ void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
     break;
   }
   case RespType::BulkString: {
-    encodeBulkString(value.asString(), out);
+    if (value.bulkStringBuffer() != nullptr) {
+      encodeBulkStringBuffer(value.bulkStringBuffer(), out);
+    } else {
+      encodeBulkString(value.asString(), out);
+    }
     break;
   }
   case RespType::Error: {
@@ -621,6 +675,26 @@ void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance&
   out.add("\r\n", 2);
 }
 
+void EncoderImpl::encodeBulkStringBuffer(const std::shared_ptr<const Buffer::Instance>& payload,
+                                         Buffer::Instance& out) {
+  char buffer[32];
+  char* current = buffer;
+  *current++ = '$';
+  current += StringUtil::itoa(current, 21, payload->length());
+  *current++ = '\r';
+  *current++ = '\n';
+  out.add(buffer, current - buffer);
+  for (const Buffer::RawSlice& slice : payload->getRawSlices()) {
+    // Each fragment references a slice of the payload and keeps the payload alive until it is
+    // drained from the output.
+    auto* fragment = new Buffer::BufferFragmentImpl(
+        slice.mem_, slice.len_,
+        [payload](const void*, size_t, const Buffer::BufferFragmentImpl* self) { delete self; });
+    out.addBufferFragment(*fragment);
+  }
+  out.add("\r\n", 2);
+}
+
 void EncoderImpl::encodeError(const std::string& string, Buffer::Instance& out) {
   out.add("-", 1);
   out.add(string);
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/extensions/filters/network/common/redis/codec.h"
 
@@ -18,10 +19,17 @@ namespace Redis {
  * Decoder implementation of https://redis.io/topics/protocol
  *
  * This implementation buffers when needed and will always consume all bytes passed for decoding.
+ * The bulk strings of at least bulk_string_buffer_threshold bytes are moved out of the decoded
+ * buffer into a buffer of their own rather than copied into a string. @see
+ * RespValue::bulkStringBuffer().
  */
 class DecoderImpl : public Decoder, Logger::Loggable<Logger::Id::redis> {
 public:
-  DecoderImpl(DecoderCallbacks& callbacks) : callbacks_(callbacks) {}
+  static constexpr uint64_t DefaultBulkStringBufferThreshold = 16 * 1024;
+
+  DecoderImpl(DecoderCallbacks& callbacks,
+              uint64_t bulk_string_buffer_threshold = DefaultBulkStringBufferThreshold)
+      : callbacks_(callbacks), bulk_string_buffer_threshold_(bulk_string_buffer_threshold) {}
 
   // RedisProxy::Decoder
   void decode(Buffer::Instance& data) override;
@@ -55,13 +63,17 @@ private:
     uint64_t current_array_element_;
   };
 
-  void parseSlice(const Buffer::RawSlice& slice);
+  // Returns the number of bytes of the slice parsed, which is less than its length when decode()
+  // has to move the body of a bulk string.
+  uint64_t parseSlice(const Buffer::RawSlice& slice);
 
   DecoderCallbacks& callbacks_;
+  const uint64_t bulk_string_buffer_threshold_;
   State state_{State::ValueRootStart};
   PendingInteger pending_integer_;
   RespValuePtr pending_value_root_;
   std::forward_list<PendingValue> pending_value_stack_;
+  std::shared_ptr<Buffer::OwnedImpl> pending_bulk_string_buffer_;
 };
 
 /**
@@ -87,6 +99,8 @@ private:
   void encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out);
   void encodeCompositeArray(const RespValue::CompositeArray& array, Buffer::Instance& out);
   void encodeBulkString(const std::string& string, Buffer::Instance& out);
+  void encodeBulkStringBuffer(const std::shared_ptr<const Buffer::Instance>& payload,
+                              Buffer::Instance& out);
   void encodeError(const std::string& string, Buffer::Instance& out);
   void encodeInteger(int64_t integer, Buffer::Instance& out);
   void encodeSimpleString(const std::string& string, Buffer::Instance& out);
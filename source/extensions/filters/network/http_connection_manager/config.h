@@ -344,6 +344,7 @@ private:
   const Http::HeaderValidatorFactoryPtr header_validator_factory_;
   const bool append_x_forwarded_port_;
   const bool add_proxy_protocol_connection_state_;
+  const Http::HeaderMapLayout header_map_layout_;
 };
 
 /**
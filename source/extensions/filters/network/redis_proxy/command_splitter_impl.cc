@@ -3,6 +3,8 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 
+#include "absl/strings/numbers.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -71,6 +73,36 @@ makeFragmentedRequest(const RouteSharedPtr& route, const std::string& command,
   return handler;
 }
 
+/**
+ * @return the keys written by a request, which are invalidated in the local cache.
+ */
+std::vector<std::string> writtenKeys(const std::string& command_name,
+                                     const Common::Redis::RespValue& request) {
+  const std::vector<Common::Redis::RespValue>& arguments = request.asArray();
+  std::vector<std::string> keys;
+  if (command_name == Common::Redis::SupportedCommands::mset()) {
+    for (size_t i = 1; i < arguments.size(); i += 2) {
+      keys.push_back(arguments[i].asString());
+    }
+  } else if (Common::Redis::SupportedCommands::hashMultipleSumResultCommands().contains(
+                 command_name)) {
+    for (size_t i = 1; i < arguments.size(); i++) {
+      keys.push_back(arguments[i].asString());
+    }
+  } else if (Common::Redis::SupportedCommands::evalCommands().contains(command_name)) {
+    // EVAL looks like: EVAL script numkeys key [key ...] arg [arg ...]
+    uint64_t num_keys;
+    if (arguments.size() > 3 && absl::SimpleAtoi(arguments[2].asString(), &num_keys)) {
+      for (size_t i = 3; i < arguments.size() && i - 3 < num_keys; i++) {
+        keys.push_back(arguments[i].asString());
+      }
+    }
+  } else {
+    keys.push_back(arguments[1].asString());
+  }
+  return keys;
+}
+
 // Send a string response downstream.
 void localResponse(SplitCallbacks& callbacks, std::string response) {
   Common::Redis::RespValuePtr res(new Common::Redis::RespValue());
@@ -175,6 +207,54 @@ SplitRequestPtr SimpleRequest::create(Router& router,
   return request_ptr;
 }
 
+SplitRequestPtr CachedRequest::create(Router& router, LocalCache& cache,
+                                      Common::Redis::RespValuePtr&& incoming_request,
+                                      SplitCallbacks& callbacks, CommandStats& command_stats,
+                                      TimeSource& time_source, bool delay_command_latency) {
+  const std::string& key = incoming_request->asArray()[1].asString();
+  std::string request_key = LocalCache::requestKey(*incoming_request);
+  Common::Redis::RespValuePtr cached_response = cache.lookup(key, request_key);
+  if (cached_response != nullptr) {
+    command_stats.success_.inc();
+    callbacks.onResponse(std::move(cached_response));
+    return nullptr;
+  }
+
+  std::unique_ptr<CachedRequest> request_ptr{new CachedRequest(
+      cache, std::move(request_key), callbacks, command_stats, time_source, delay_command_latency)};
+  const auto route = router.upstreamPool(key);
+  if (route) {
+    // Taken before the request is made, so that a write made meanwhile discards the response.
+    request_ptr->generation_ = cache.generation(key);
+    Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
+    request_ptr->request_ = base_request;
+    request_ptr->handle_ = makeSingleServerRequest(
+        route, base_request->asArray()[0].asString(), base_request->asArray()[1].asString(),
+        base_request, *request_ptr, callbacks.transaction());
+  } else {
+    ENVOY_LOG(debug, "route not found: '{}'", incoming_request->toString());
+  }
+
+  if (!request_ptr->handle_) {
+    command_stats.error_.inc();
+    callbacks.onResponse(Common::Redis::Utility::makeError(Response::get().NoUpstreamHost));
+    return nullptr;
+  }
+
+  return request_ptr;
+}
+
+void CachedRequest::onResponse(Common::Redis::RespValuePtr&& response) {
+  cache_.insert(request_->asArray()[1].asString(), request_key_, generation_, *response);
+  SingleServerRequest::onResponse(std::move(response));
+}
+
+InvalidatingRequest::~InvalidatingRequest() {
+  for (const std::string& key : keys_) {
+    cache_.invalidate(key);
+  }
+}
+
 SplitRequestPtr EvalRequest::create(Router& router, Common::Redis::RespValuePtr&& incoming_request,
                                     SplitCallbacks& callbacks, CommandStats& command_stats,
                                     TimeSource& time_source, bool delay_command_latency) {
@@ -538,15 +618,25 @@ SplitRequestPtr TransactionRequest::create(Router& router,
 
 InstanceImpl::InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                            TimeSource& time_source, bool latency_in_micros,
-                           Common::Redis::FaultManagerPtr&& fault_manager)
-    : router_(std::move(router)), simple_command_handler_(*router_),
+                           Common::Redis::FaultManagerPtr&& fault_manager,
+                           LocalCacheSharedPtr local_cache)
+    : router_(std::move(router)), local_cache_(std::move(local_cache)),
+      simple_command_handler_(*router_),
       eval_command_handler_(*router_), mget_handler_(*router_), mset_handler_(*router_),
       split_keys_sum_result_handler_(*router_),
       transaction_handler_(*router_), stats_{ALL_COMMAND_SPLITTER_STATS(
                                           POOL_COUNTER_PREFIX(scope, stat_prefix + "splitter."))},
       time_source_(time_source), fault_manager_(std::move(fault_manager)) {
+  if (local_cache_ != nullptr) {
+    cached_command_handler_ = std::make_unique<CachedCommandHandler>(*router_, *local_cache_);
+  }
+
   for (const std::string& command : Common::Redis::SupportedCommands::simpleCommands()) {
-    addHandler(scope, stat_prefix, command, latency_in_micros, simple_command_handler_);
+    if (local_cache_ != nullptr && local_cache_->cachesCommand(command)) {
+      addHandler(scope, stat_prefix, command, latency_in_micros, *cached_command_handler_);
+    } else {
+      addHandler(scope, stat_prefix, command, latency_in_micros, simple_command_handler_);
+    }
   }
 
   for (const std::string& command : Common::Redis::SupportedCommands::evalCommands()) {
@@ -663,6 +753,24 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   ENVOY_LOG(debug, "splitting '{}'", request->toString());
   handler->command_stats_.total_.inc();
 
+  // The keys written by the request are invalidated before it is made, and again once it is done.
+  // The writes queued by a transaction are invalidated again once it is executed.
+  std::vector<std::string> written_keys;
+  if (local_cache_ != nullptr) {
+    if (Common::Redis::SupportedCommands::writeCommands().contains(command_name)) {
+      written_keys = writtenKeys(command_name, *request);
+      if (callbacks.transaction().active_) {
+        std::vector<std::string>& transaction_keys = callbacks.transaction().written_keys_;
+        transaction_keys.insert(transaction_keys.end(), written_keys.begin(), written_keys.end());
+      }
+    } else if (command_name == "exec" || command_name == "discard") {
+      written_keys.swap(callbacks.transaction().written_keys_);
+    }
+    for (const std::string& key : written_keys) {
+      local_cache_->invalidate(key);
+    }
+  }
+
   SplitRequestPtr request_ptr;
   if (fault_ptr != nullptr && fault_ptr->faultType() == Common::Redis::FaultType::Error) {
     request_ptr = ErrorFaultRequest::create(has_delay_fault ? *delay_fault_ptr : callbacks,
@@ -676,10 +784,21 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   // Complete delay, if any. The delay fault takes ownership of the wrapped request.
   if (has_delay_fault) {
     delay_fault_ptr->wrapped_request_ptr_ = std::move(request_ptr);
-    return delay_fault_ptr;
-  } else {
-    return request_ptr;
+    request_ptr = std::move(delay_fault_ptr);
   }
+
+  if (!written_keys.empty()) {
+    if (request_ptr == nullptr) {
+      // The request is already done.
+      for (const std::string& key : written_keys) {
+        local_cache_->invalidate(key);
+      }
+    } else {
+      request_ptr = std::make_unique<InvalidatingRequest>(*local_cache_, std::move(written_keys),
+                                                          std::move(request_ptr));
+    }
+  }
+  return request_ptr;
 }
 
 void InstanceImpl::onInvalidRequest(SplitCallbacks& callbacks) {
@@ -16,6 +16,7 @@
 #include "source/extensions/filters/network/common/redis/utility.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
+#include "source/extensions/filters/network/redis_proxy/local_cache.h"
 #include "source/extensions/filters/network/redis_proxy/router.h"
 
 namespace Envoy {
@@ -183,6 +184,54 @@ private:
       : SingleServerRequest(callbacks, command_stats, time_source, delay_command_latency) {}
 };
 
+/**
+ * CachedRequest serves a command from the local cache, or forwards it like a SimpleRequest and
+ * caches its response.
+ */
+class CachedRequest : public SingleServerRequest {
+public:
+  static SplitRequestPtr create(Router& router, LocalCache& cache,
+                                Common::Redis::RespValuePtr&& incoming_request,
+                                SplitCallbacks& callbacks, CommandStats& command_stats,
+                                TimeSource& time_source, bool delay_command_latency);
+
+  // ConnPool::PoolCallbacks
+  void onResponse(Common::Redis::RespValuePtr&& response) override;
+
+private:
+  CachedRequest(LocalCache& cache, std::string&& request_key, SplitCallbacks& callbacks,
+                CommandStats& command_stats, TimeSource& time_source, bool delay_command_latency)
+      : SingleServerRequest(callbacks, command_stats, time_source, delay_command_latency),
+        cache_(cache), request_key_(std::move(request_key)) {}
+
+  LocalCache& cache_;
+  const std::string request_key_;
+  Common::Redis::RespValueConstSharedPtr request_;
+  uint64_t generation_{};
+};
+
+/**
+ * InvalidatingRequest wraps a request writing keys which may be in the local cache. The keys are
+ * invalidated before the request is made, and again once it is done, so that the responses to
+ * the reads made in between aren't cached.
+ */
+class InvalidatingRequest : public SplitRequest {
+public:
+  InvalidatingRequest(LocalCache& cache, std::vector<std::string>&& keys,
+                      SplitRequestPtr&& wrapped_request_ptr)
+      : cache_(cache), keys_(std::move(keys)),
+        wrapped_request_ptr_(std::move(wrapped_request_ptr)) {}
+  ~InvalidatingRequest() override;
+
+  // RedisProxy::CommandSplitter::SplitRequest
+  void cancel() override { wrapped_request_ptr_->cancel(); }
+
+private:
+  LocalCache& cache_;
+  const std::vector<std::string> keys_;
+  SplitRequestPtr wrapped_request_ptr_;
+};
+
 /**
  * EvalRequest hashes the fourth argument as the key.
  */
@@ -336,6 +385,25 @@ public:
   }
 };
 
+/**
+ * CachedCommandHandler is placed in the command lookup map for the commands cached by the local
+ * cache.
+ */
+class CachedCommandHandler : public CommandHandler, CommandHandlerBase {
+public:
+  CachedCommandHandler(Router& router, LocalCache& cache)
+      : CommandHandlerBase(router), cache_(cache) {}
+  SplitRequestPtr startRequest(Common::Redis::RespValuePtr&& request, SplitCallbacks& callbacks,
+                               CommandStats& command_stats, TimeSource& time_source,
+                               bool delay_command_latency) override {
+    return CachedRequest::create(router_, cache_, std::move(request), callbacks, command_stats,
+                                 time_source, delay_command_latency);
+  }
+
+private:
+  LocalCache& cache_;
+};
+
 /**
  * All splitter stats. @see stats_macros.h
  */
@@ -354,7 +422,8 @@ class InstanceImpl : public Instance, Logger::Loggable<Logger::Id::redis> {
 public:
   InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                TimeSource& time_source, bool latency_in_micros,
-               Common::Redis::FaultManagerPtr&& fault_manager);
+               Common::Redis::FaultManagerPtr&& fault_manager,
+               LocalCacheSharedPtr local_cache = nullptr);
 
   // RedisProxy::CommandSplitter::Instance
   SplitRequestPtr makeRequest(Common::Redis::RespValuePtr&& request, SplitCallbacks& callbacks,
@@ -375,6 +444,8 @@ private:
   void onInvalidRequest(SplitCallbacks& callbacks);
 
   RouterPtr router_;
+  LocalCacheSharedPtr local_cache_;
+  std::unique_ptr<CachedCommandHandler> cached_command_handler_;
   CommandHandlerFactory<SimpleRequest> simple_command_handler_;
   CommandHandlerFactory<EvalRequest> eval_command_handler_;
   CommandHandlerFactory<MGETRequest> mget_handler_;
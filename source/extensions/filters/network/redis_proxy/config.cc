@@ -7,11 +7,14 @@
 #include "source/extensions/common/redis/cluster_refresh_manager_impl.h"
 #include "source/extensions/filters/network/common/redis/client_impl.h"
 #include "source/extensions/filters/network/common/redis/fault_impl.h"
+#include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
+#include "source/extensions/filters/network/redis_proxy/local_cache.h"
 #include "source/extensions/filters/network/redis_proxy/proxy_filter.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/ascii.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -83,10 +86,24 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
   auto fault_manager = std::make_unique<Common::Redis::FaultManagerImpl>(
       context.api().randomGenerator(), context.runtime(), proto_config.faults());
 
+  LocalCacheSharedPtr local_cache;
+  if (proto_config.has_local_cache()) {
+    for (const std::string& command : proto_config.local_cache().commands()) {
+      if (!Common::Redis::SupportedCommands::simpleCommands().contains(
+              absl::AsciiStrToLower(command))) {
+        throw EnvoyException(
+            fmt::format("redis-proxy local cache: command '{}' can't be cached", command));
+      }
+    }
+    local_cache = std::make_shared<LocalCache>(proto_config.local_cache(), context.timeSource(),
+                                               context.scope(),
+                                               filter_config->stat_prefix_ + "local_cache.");
+  }
+
   std::shared_ptr<CommandSplitter::Instance> splitter =
       std::make_shared<CommandSplitter::InstanceImpl>(
           std::move(router), context.scope(), filter_config->stat_prefix_, context.timeSource(),
-          proto_config.latency_in_micros(), std::move(fault_manager));
+          proto_config.latency_in_micros(), std::move(fault_manager), std::move(local_cache));
   return [splitter, filter_config](Network::FilterManager& filter_manager) -> void {
     Common::Redis::DecoderFactoryImpl factory;
     filter_manager.addReadFilter(std::make_shared<ProxyFilter>(
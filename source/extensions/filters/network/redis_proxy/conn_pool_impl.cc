@@ -16,6 +16,10 @@
 #include "source/common/stats/utility.h"
 #include "source/extensions/filters/network/redis_proxy/config.h"
 
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -35,6 +39,30 @@ const Common::Redis::RespValue& getRequest(const RespVariant& request) {
 }
 
 static uint16_t default_port = 6379;
+
+constexpr uint64_t DefaultGetCoalescingWindowMs = 1;
+constexpr uint32_t DefaultGetCoalescingMaxBatchSize = 64;
+
+absl::optional<GetCoalescingConfig> getCoalescingConfig(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ConnPoolSettings&
+        config) {
+  if (!config.has_get_coalescing()) {
+    return absl::nullopt;
+  }
+  return GetCoalescingConfig{
+      std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config.get_coalescing(), max_window,
+                                                           DefaultGetCoalescingWindowMs)),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.get_coalescing(), max_batch_size,
+                                      DefaultGetCoalescingMaxBatchSize)};
+}
+
+// Whether the request is a GET, which can be coalesced into an MGET.
+bool isCoalescableGet(const Common::Redis::RespValue& request) {
+  return request.type() == Common::Redis::RespType::Array && request.asArray().size() == 2 &&
+         request.asArray()[0].type() == Common::Redis::RespType::BulkString &&
+         request.asArray()[1].type() == Common::Redis::RespType::BulkString &&
+         absl::EqualsIgnoreCase(request.asArray()[0].asString(), "get");
+}
 } // namespace
 
 InstanceImpl::InstanceImpl(
@@ -51,7 +79,8 @@ InstanceImpl::InstanceImpl(
       stats_scope_(std::move(stats_scope)),
       redis_command_stats_(redis_command_stats), redis_cluster_stats_{REDIS_CLUSTER_STATS(
                                                      POOL_COUNTER(*stats_scope_))},
-      refresh_manager_(std::move(refresh_manager)), dns_cache_(dns_cache) {}
+      refresh_manager_(std::move(refresh_manager)), dns_cache_(dns_cache),
+      get_coalescing_(getCoalescingConfig(config)) {}
 
 void InstanceImpl::init() {
   // Note: `this` and `cluster_name` have a a lifetime of the filter.
@@ -95,7 +124,7 @@ InstanceImpl::ThreadLocalPool::ThreadLocalPool(
       is_redis_cluster_(false), client_factory_(parent->client_factory_), config_(parent->config_),
       stats_scope_(parent->stats_scope_), redis_command_stats_(parent->redis_command_stats_),
       redis_cluster_stats_(parent->redis_cluster_stats_),
-      refresh_manager_(parent->refresh_manager_) {
+      refresh_manager_(parent->refresh_manager_), get_coalescing_(parent->get_coalescing_) {
   cluster_update_handle_ = parent->cm_.addThreadLocalClusterUpdateCallbacks(*this);
   Upstream::ThreadLocalCluster* cluster = parent->cm_.getThreadLocalCluster(cluster_name_);
   if (cluster != nullptr) {
@@ -104,6 +133,10 @@ InstanceImpl::ThreadLocalPool::ThreadLocalPool(
 }
 
 InstanceImpl::ThreadLocalPool::~ThreadLocalPool() {
+  // Fail the GETs which weren't sent first, so that failing the outstanding ones doesn't send them.
+  for (auto& group : get_coalescing_groups_) {
+    group.second->failPending();
+  }
   while (!pending_requests_.empty()) {
     pending_requests_.pop_front();
   }
@@ -215,6 +248,10 @@ void InstanceImpl::ThreadLocalPool::onHostsRemoved(
         it->second->redis_client_->close();
       }
     }
+    auto group = get_coalescing_groups_.find(host);
+    if (group != get_coalescing_groups_.end() && group->second->idle()) {
+      get_coalescing_groups_.erase(group);
+    }
     // There is the possibility that multiple hosts with the same address
     // are registered in host_address_map_ given that hosts may be created
     // upon redirection or supplied as part of the cluster's definition.
@@ -268,6 +305,17 @@ InstanceImpl::ThreadLocalPool::makeRequest(const std::string& key, RespVariant&&
     return nullptr;
   }
 
+  if (get_coalescing_.has_value() && !transaction.active_ &&
+      isCoalescableGet(getRequest(request))) {
+    // The hash key of a Redis Cluster request is its slot.
+    const uint64_t slot = is_redis_cluster_ ? lb_context.computeHashKey().value_or(0) : 0;
+    GetCoalescingGroupPtr& group = get_coalescing_groups_[host];
+    if (group == nullptr) {
+      group = std::make_unique<GetCoalescingGroup>(*this, host);
+    }
+    return group->add(slot, std::move(request), callbacks);
+  }
+
   // If there is an active transaction, establish a new connection if necessary.
   if (transaction.active_ && !transaction.connection_established_) {
     transaction.client_ =
@@ -519,6 +567,15 @@ void InstanceImpl::PendingRequest::doRedirection(Common::Redis::RespValuePtr&& v
       host->cluster().trafficStats()->upstream_internal_redirect_failed_total_.inc();
     } else {
       parent_.refresh_manager_->onRedirection(parent_.cluster_name_);
+      if (!ask_redirection && parent_.is_redis_cluster_) {
+        // MOVED <slot> <host:port>, which patches the slot until the topology is refreshed.
+        const std::vector<absl::string_view> moved = absl::StrSplit(value->asString(), ' ');
+        uint32_t slot;
+        if (moved.size() == 3 && absl::SimpleAtoi(moved[1], &slot) &&
+            slot < Clusters::Redis::MaxSlot) {
+          parent_.refresh_manager_->onSlotMoved(parent_.cluster_name_, slot, host_address);
+        }
+      }
       host->cluster().trafficStats()->upstream_internal_redirect_succeeded_total_.inc();
     }
   }
@@ -530,6 +587,149 @@ void InstanceImpl::PendingRequest::cancel() {
   parent_.onRequestCompleted();
 }
 
+void InstanceImpl::GetBatch::fail() {
+  for (CoalescedGet& get : gets_) {
+    if (!get.cancelled_) {
+      get.callbacks_.onFailure();
+    }
+  }
+}
+
+Common::Redis::RespValueConstSharedPtr InstanceImpl::GetBatch::mget() const {
+  std::vector<Common::Redis::RespValue> values(gets_.size() + 1);
+  values[0].type(Common::Redis::RespType::BulkString);
+  values[0].asString() = "mget";
+  auto value = values.begin() + 1;
+  for (const CoalescedGet& get : gets_) {
+    *value++ = getRequest(get.request_).asArray()[1];
+  }
+  auto mget = std::make_shared<Common::Redis::RespValue>();
+  mget->type(Common::Redis::RespType::Array);
+  mget->asArray().swap(values);
+  return mget;
+}
+
+void InstanceImpl::GetBatch::onResponse(Common::Redis::RespValuePtr&& value) {
+  if (gets_.size() == 1) {
+    if (!gets_.front().cancelled_) {
+      gets_.front().callbacks_.onResponse(std::move(value));
+    }
+  } else if (value->type() == Common::Redis::RespType::Array &&
+             value->asArray().size() == gets_.size()) {
+    auto element = value->asArray().begin();
+    for (CoalescedGet& get : gets_) {
+      if (!get.cancelled_) {
+        get.callbacks_.onResponse(std::make_unique<Common::Redis::RespValue>(std::move(*element)));
+      }
+      ++element;
+    }
+  } else {
+    // An error, which is the response to each of the GETs.
+    for (CoalescedGet& get : gets_) {
+      if (!get.cancelled_) {
+        get.callbacks_.onResponse(std::make_unique<Common::Redis::RespValue>(*value));
+      }
+    }
+  }
+  group_.onBatchCompleted(*this);
+}
+
+void InstanceImpl::GetBatch::onFailure() {
+  fail();
+  group_.onBatchCompleted(*this);
+}
+
+InstanceImpl::GetCoalescingGroup::GetCoalescingGroup(ThreadLocalPool& parent,
+                                                     Upstream::HostConstSharedPtr host)
+    : parent_(parent), host_(std::move(host)),
+      window_timer_(parent.dispatcher_.createTimer([this]() -> void { flush(); })) {}
+
+Common::Redis::Client::PoolRequest*
+InstanceImpl::GetCoalescingGroup::add(uint64_t slot, RespVariant&& request,
+                                      PoolCallbacks& callbacks) {
+  GetBatchPtr& batch = pending_batches_[slot];
+  if (batch == nullptr) {
+    batch = std::make_unique<GetBatch>(*this);
+  }
+  batch->gets_.emplace_back(std::move(request), callbacks);
+  CoalescedGet& get = batch->gets_.back();
+
+  // The GET is sent right away if nothing is outstanding for the host, so that the batches only
+  // form under load.
+  if (in_flight_batches_.empty() ||
+      batch->gets_.size() >= parent_.get_coalescing_->max_batch_size_) {
+    GetBatchPtr full_batch = std::move(batch);
+    pending_batches_.erase(slot);
+    if (!send(std::move(full_batch), &get)) {
+      return nullptr;
+    }
+  } else if (!window_timer_->enabled()) {
+    window_timer_->enableTimer(parent_.get_coalescing_->max_window_);
+  }
+  return &get;
+}
+
+void InstanceImpl::GetCoalescingGroup::flush() {
+  window_timer_->disableTimer();
+  absl::flat_hash_map<uint64_t, GetBatchPtr> batches;
+  batches.swap(pending_batches_);
+  for (auto& batch : batches) {
+    send(std::move(batch.second), nullptr);
+  }
+}
+
+void InstanceImpl::GetCoalescingGroup::failPending() {
+  window_timer_->disableTimer();
+  absl::flat_hash_map<uint64_t, GetBatchPtr> batches;
+  batches.swap(pending_batches_);
+  for (auto& batch : batches) {
+    batch.second->fail();
+  }
+}
+
+void InstanceImpl::GetCoalescingGroup::onBatchCompleted(GetBatch& batch) {
+  in_flight_batches_.remove_if([&batch](const GetBatchPtr& in_flight) {
+    return in_flight.get() == &batch;
+  });
+  if (!pending_batches_.empty()) {
+    flush();
+  }
+}
+
+bool InstanceImpl::GetCoalescingGroup::send(GetBatchPtr&& batch, CoalescedGet* caller) {
+  batch->gets_.remove_if([](const CoalescedGet& get) { return get.cancelled_; });
+  if (batch->gets_.empty()) {
+    return true;
+  }
+
+  RespVariant request = batch->gets_.size() == 1 ? std::move(batch->gets_.front().request_)
+                                                  : RespVariant{batch->mget()};
+
+  if (parent_.cluster_ != nullptr) {
+    parent_.pending_requests_.emplace_back(parent_, std::move(request), *batch, host_);
+    PendingRequest& pending_request = parent_.pending_requests_.back();
+    pending_request.request_handler_ =
+        parent_.threadLocalActiveClient(host_)->redis_client_->makeRequest(
+            getRequest(pending_request.incoming_request_), pending_request);
+    if (pending_request.request_handler_) {
+      if (batch->gets_.size() > 1) {
+        parent_.redis_cluster_stats_.get_coalesced_.add(batch->gets_.size());
+        parent_.redis_cluster_stats_.mget_coalesced_.inc();
+      }
+      in_flight_batches_.push_back(std::move(batch));
+      return true;
+    }
+    parent_.onRequestCompleted();
+  }
+
+  // The caller is told by the return value instead.
+  if (caller != nullptr) {
+    caller->cancelled_ = true;
+  }
+  batch->fail();
+  return false;
+}
+
 } // namespace ConnPool
 } // namespace RedisProxy
 } // namespace NetworkFilters
@@ -28,7 +28,9 @@
 #include "source/extensions/filters/network/common/redis/utility.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -40,6 +42,8 @@ namespace ConnPool {
 // TODO(rshriram): Fault injection
 
 #define REDIS_CLUSTER_STATS(COUNTER)                                                               \
+  COUNTER(get_coalesced)                                                                           \
+  COUNTER(mget_coalesced)                                                                          \
   COUNTER(upstream_cx_drained)                                                                     \
   COUNTER(max_upstream_unknown_connections_reached)
 
@@ -47,6 +51,14 @@ struct RedisClusterStats {
   REDIS_CLUSTER_STATS(GENERATE_COUNTER_STRUCT)
 };
 
+/**
+ * The settings of the coalescing of GET commands into MGET commands.
+ */
+struct GetCoalescingConfig {
+  const std::chrono::milliseconds max_window_;
+  const uint32_t max_batch_size_;
+};
+
 class DoNothingPoolCallbacks : public PoolCallbacks {
 public:
   void onResponse(Common::Redis::RespValuePtr&&) override{};
@@ -142,6 +154,69 @@ private:
         cache_load_handle_;
   };
 
+  struct GetCoalescingGroup;
+
+  // A GET which may be coalesced with others into an MGET.
+  struct CoalescedGet : public Common::Redis::Client::PoolRequest {
+    CoalescedGet(RespVariant&& request, PoolCallbacks& callbacks)
+        : request_(std::move(request)), callbacks_(callbacks) {}
+
+    // PoolRequest
+    void cancel() override { cancelled_ = true; }
+
+    RespVariant request_;
+    PoolCallbacks& callbacks_;
+    bool cancelled_{};
+  };
+
+  // The GETs sent upstream together, either as an MGET or as the GET itself if it is alone.
+  struct GetBatch : public PoolCallbacks {
+    GetBatch(GetCoalescingGroup& group) : group_(group) {}
+
+    // Fails the GETs which weren't cancelled.
+    void fail();
+    // @return the MGET of the keys of the GETs.
+    Common::Redis::RespValueConstSharedPtr mget() const;
+
+    // PoolCallbacks
+    void onResponse(Common::Redis::RespValuePtr&& value) override;
+    void onFailure() override;
+
+    GetCoalescingGroup& group_;
+    // A list, so that the GETs handed to the callers don't move.
+    std::list<CoalescedGet> gets_;
+  };
+
+  using GetBatchPtr = std::unique_ptr<GetBatch>;
+
+  // The GETs to an upstream host. They are gathered while a batch is outstanding for the host, one
+  // batch per slot of a Redis Cluster, since an MGET can't span slots.
+  struct GetCoalescingGroup {
+    GetCoalescingGroup(ThreadLocalPool& parent, Upstream::HostConstSharedPtr host);
+
+    Common::Redis::Client::PoolRequest* add(uint64_t slot, RespVariant&& request,
+                                            PoolCallbacks& callbacks);
+    // Sends the pending batches.
+    void flush();
+    // Fails the pending batches.
+    void failPending();
+    bool idle() const { return pending_batches_.empty() && in_flight_batches_.empty(); }
+    void onBatchCompleted(GetBatch& batch);
+
+  private:
+    // Sends the batch. If it can't be sent, its GETs other than caller are failed and false is
+    // returned.
+    bool send(GetBatchPtr&& batch, CoalescedGet* caller);
+
+    ThreadLocalPool& parent_;
+    Upstream::HostConstSharedPtr host_;
+    absl::flat_hash_map<uint64_t, GetBatchPtr> pending_batches_;
+    std::list<GetBatchPtr> in_flight_batches_;
+    Event::TimerPtr window_timer_;
+  };
+
+  using GetCoalescingGroupPtr = std::unique_ptr<GetCoalescingGroup>;
+
   struct ThreadLocalPool : public ThreadLocal::ThreadLocalObject,
                            public Upstream::ClusterUpdateCallbacks,
                            public Logger::Loggable<Logger::Id::redis> {
@@ -183,6 +258,7 @@ private:
     std::string auth_password_;
     std::list<Upstream::HostSharedPtr> created_via_redirect_hosts_;
     std::list<ThreadLocalActiveClientPtr> clients_to_drain_;
+    absl::node_hash_map<Upstream::HostConstSharedPtr, GetCoalescingGroupPtr> get_coalescing_groups_;
     std::list<PendingRequest> pending_requests_;
 
     /* This timer is used to poll the active clients in clients_to_drain_ to determine whether they
@@ -199,6 +275,7 @@ private:
     Common::Redis::RedisCommandStatsSharedPtr redis_command_stats_;
     RedisClusterStats redis_cluster_stats_;
     const Extensions::Common::Redis::ClusterRefreshManagerSharedPtr refresh_manager_;
+    const absl::optional<GetCoalescingConfig> get_coalescing_;
   };
 
   const std::string cluster_name_;
@@ -212,6 +289,7 @@ private:
   RedisClusterStats redis_cluster_stats_;
   const Extensions::Common::Redis::ClusterRefreshManagerSharedPtr refresh_manager_;
   const Extensions::Common::DynamicForwardProxy::DnsCacheSharedPtr dns_cache_{nullptr};
+  const absl::optional<GetCoalescingConfig> get_coalescing_;
 };
 
 } // namespace ConnPool
@@ -0,0 +1,220 @@
+#include "source/extensions/filters/network/redis_proxy/local_cache.h"
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/hash/hash.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+namespace {
+
+constexpr uint64_t DefaultMaxBytes = 64 * 1024 * 1024;
+// The approximate size of the bookkeeping of a cached response.
+constexpr uint64_t ResponseOverheadBytes = 64;
+
+absl::flat_hash_set<std::string>
+commands(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::LocalCache&
+             config) {
+  if (config.commands().empty()) {
+    return {"get"};
+  }
+  absl::flat_hash_set<std::string> commands;
+  for (const std::string& command : config.commands()) {
+    commands.insert(absl::AsciiStrToLower(command));
+  }
+  return commands;
+}
+
+uint64_t valueBytes(const Common::Redis::RespValue& value) {
+  switch (value.type()) {
+  case Common::Redis::RespType::Array: {
+    uint64_t bytes = 0;
+    for (const Common::Redis::RespValue& element : value.asArray()) {
+      bytes += valueBytes(element);
+    }
+    return bytes + sizeof(Common::Redis::RespValue);
+  }
+  case Common::Redis::RespType::BulkString:
+    if (value.bulkStringBuffer() != nullptr) {
+      return value.bulkStringBuffer()->length() + sizeof(Common::Redis::RespValue);
+    }
+    FALLTHRU;
+  case Common::Redis::RespType::SimpleString:
+  case Common::Redis::RespType::Error:
+    return value.asString().size() + sizeof(Common::Redis::RespValue);
+  case Common::Redis::RespType::Null:
+  case Common::Redis::RespType::Integer:
+  case Common::Redis::RespType::CompositeArray:
+    break;
+  }
+  return sizeof(Common::Redis::RespValue);
+}
+
+// Whether the response is the value of the key, rather than an error.
+bool cacheable(const Common::Redis::RespValue& response) {
+  switch (response.type()) {
+  case Common::Redis::RespType::Error:
+  case Common::Redis::RespType::CompositeArray:
+    return false;
+  case Common::Redis::RespType::Array:
+    for (const Common::Redis::RespValue& element : response.asArray()) {
+      if (!cacheable(element)) {
+        return false;
+      }
+    }
+    return true;
+  case Common::Redis::RespType::Null:
+  case Common::Redis::RespType::SimpleString:
+  case Common::Redis::RespType::BulkString:
+  case Common::Redis::RespType::Integer:
+    break;
+  }
+  return true;
+}
+
+} // namespace
+
+LocalCache::LocalCache(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::LocalCache& config,
+    TimeSource& time_source, Stats::Scope& scope, const std::string& stat_prefix)
+    : commands_(commands(config)), ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)),
+      max_shard_bytes_(
+          std::max<uint64_t>(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_bytes, DefaultMaxBytes) /
+                                 NumShards,
+                             1)),
+      time_source_(time_source),
+      stats_{ALL_REDIS_LOCAL_CACHE_STATS(POOL_COUNTER_PREFIX(scope, stat_prefix),
+                                         POOL_GAUGE_PREFIX(scope, stat_prefix))} {}
+
+std::string LocalCache::requestKey(const Common::Redis::RespValue& request) {
+  // The command and the arguments, each prefixed by its length so that the key can't be
+  // ambiguous. The key itself isn't part of it, as the responses are already grouped by key.
+  const std::vector<Common::Redis::RespValue>& arguments = request.asArray();
+  std::string request_key = absl::AsciiStrToLower(arguments[0].asString());
+  for (size_t i = 2; i < arguments.size(); i++) {
+    const std::string& argument = arguments[i].asString();
+    absl::StrAppend(&request_key, ";", argument.size(), ":", argument);
+  }
+  return request_key;
+}
+
+Common::Redis::RespValuePtr LocalCache::lookup(const std::string& key,
+                                               const std::string& request_key) {
+  const size_t hash = absl::Hash<std::string>()(key);
+  Shard& key_shard = shard(hash);
+  Common::Redis::RespValueConstSharedPtr value;
+  {
+    absl::MutexLock lock(&key_shard.mutex_);
+    KeyEntry* entry = key_shard.keys_.get(key);
+    if (entry != nullptr) {
+      auto response = entry->responses_.find(request_key);
+      if (response != entry->responses_.end()) {
+        if (response->second.expiry_ > time_source_.monotonicTime()) {
+          value = response->second.value_;
+        } else {
+          entry->bytes_ -= response->second.bytes_;
+          key_shard.bytes_ -= response->second.bytes_;
+          stats_.bytes_.sub(response->second.bytes_);
+          entry->responses_.erase(response);
+          if (entry->responses_.empty()) {
+            key_shard.keys_.erase(key);
+          }
+        }
+      }
+    }
+  }
+
+  if (value == nullptr) {
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  stats_.hit_.inc();
+  // The copy shares the payload of the large bulk strings with the cached value.
+  return std::make_unique<Common::Redis::RespValue>(*value);
+}
+
+uint64_t LocalCache::generation(const std::string& key) {
+  const size_t hash = absl::Hash<std::string>()(key);
+  Shard& key_shard = shard(hash);
+  absl::MutexLock lock(&key_shard.mutex_);
+  return generationOf(key_shard, hash);
+}
+
+void LocalCache::insert(const std::string& key, const std::string& request_key,
+                        uint64_t generation, const Common::Redis::RespValue& response) {
+  if (!cacheable(response)) {
+    return;
+  }
+
+  const uint64_t bytes =
+      key.size() + request_key.size() + valueBytes(response) + ResponseOverheadBytes;
+  if (bytes > max_shard_bytes_) {
+    return;
+  }
+  // Copy the response outside of the lock.
+  Response cached{std::make_shared<const Common::Redis::RespValue>(response),
+                  time_source_.monotonicTime() + ttl_, bytes};
+
+  const size_t hash = absl::Hash<std::string>()(key);
+  Shard& key_shard = shard(hash);
+  uint64_t evicted = 0;
+  {
+    absl::MutexLock lock(&key_shard.mutex_);
+    if (generationOf(key_shard, hash) != generation) {
+      // The key was written since the request was sent, so the response may be stale.
+      return;
+    }
+
+    KeyEntry& entry = *key_shard.keys_.getOrInsert(key).first;
+    auto [response_it, response_inserted] = entry.responses_.try_emplace(request_key);
+    if (!response_inserted) {
+      entry.bytes_ -= response_it->second.bytes_;
+      key_shard.bytes_ -= response_it->second.bytes_;
+      stats_.bytes_.sub(response_it->second.bytes_);
+    }
+    response_it->second = std::move(cached);
+    entry.bytes_ += bytes;
+    key_shard.bytes_ += bytes;
+    stats_.bytes_.add(bytes);
+
+    while (key_shard.bytes_ > max_shard_bytes_) {
+      // The least recently used keys go first. The inserted key only goes if its other responses
+      // take the budget.
+      evicted += release(key_shard, key_shard.keys_.leastRecentlyUsed());
+      key_shard.keys_.eraseLeastRecentlyUsed();
+    }
+  }
+  stats_.insert_.inc();
+  stats_.evicted_.add(evicted);
+}
+
+void LocalCache::invalidate(const std::string& key) {
+  const size_t hash = absl::Hash<std::string>()(key);
+  Shard& key_shard = shard(hash);
+  uint64_t invalidated = 0;
+  {
+    absl::MutexLock lock(&key_shard.mutex_);
+    generationOf(key_shard, hash)++;
+    if (const KeyEntry* entry = key_shard.keys_.get(key); entry != nullptr) {
+      invalidated = release(key_shard, *entry);
+      key_shard.keys_.erase(key);
+    }
+  }
+  stats_.invalidated_.add(invalidated);
+}
+
+uint64_t LocalCache::release(Shard& shard, const KeyEntry& entry) {
+  shard.bytes_ -= entry.bytes_;
+  stats_.bytes_.sub(entry.bytes_);
+  return entry.responses_.size();
+}
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
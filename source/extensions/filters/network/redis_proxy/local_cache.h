@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/lru_map.h"
+#include "source/extensions/filters/network/common/redis/codec.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+/**
+ * All stats for the redis local cache. @see stats_macros.h
+ */
+#define ALL_REDIS_LOCAL_CACHE_STATS(COUNTER, GAUGE)                                                \
+  COUNTER(hit)                                                                                     \
+  COUNTER(miss)                                                                                    \
+  COUNTER(insert)                                                                                  \
+  COUNTER(evicted)                                                                                 \
+  COUNTER(invalidated)                                                                             \
+  GAUGE(bytes, Accumulate)
+
+/**
+ * Wrapper struct for redis local cache stats. @see stats_macros.h
+ */
+struct LocalCacheStats {
+  ALL_REDIS_LOCAL_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * A cache of the responses to read commands, shared by the workers. The responses are cached per
+ * key and per request, so that e.g. the responses to ``HGET key field`` are cached for each field.
+ * The cache is split into shards, each with its own lock, byte budget and LRU list of keys.
+ *
+ * A response is only inserted if its key wasn't invalidated since the request was sent, which is
+ * tracked by the generation of the key.
+ */
+class LocalCache {
+public:
+  LocalCache(const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::LocalCache&
+                 config,
+             TimeSource& time_source, Stats::Scope& scope, const std::string& stat_prefix);
+
+  /**
+   * @param command supplies the lower case name of a command.
+   * @return whether the responses to the command are cached.
+   */
+  bool cachesCommand(const std::string& command) const { return commands_.contains(command); }
+
+  /**
+   * @return the key identifying request among the requests for the same key.
+   */
+  static std::string requestKey(const Common::Redis::RespValue& request);
+
+  /**
+   * @return a copy of the cached response, or nullptr if there is none.
+   */
+  Common::Redis::RespValuePtr lookup(const std::string& key, const std::string& request_key);
+
+  /**
+   * @return the generation of key, to be passed to insert() along with the response.
+   */
+  uint64_t generation(const std::string& key);
+
+  /**
+   * Caches the response unless it is an error, or key was invalidated since generation.
+   */
+  void insert(const std::string& key, const std::string& request_key, uint64_t generation,
+              const Common::Redis::RespValue& response);
+
+  /**
+   * Removes the cached responses of key, and prevents the responses already requested from being
+   * inserted.
+   */
+  void invalidate(const std::string& key);
+
+  const LocalCacheStats& stats() const { return stats_; }
+
+private:
+  static constexpr size_t NumShards = 16;
+  static constexpr size_t NumGenerations = 256;
+
+  struct Response {
+    Common::Redis::RespValueConstSharedPtr value_;
+    MonotonicTime expiry_;
+    uint64_t bytes_;
+  };
+
+  struct KeyEntry {
+    absl::flat_hash_map<std::string, Response> responses_;
+    uint64_t bytes_{};
+  };
+
+  struct Shard {
+    absl::Mutex mutex_;
+    LruMap<std::string, KeyEntry> keys_ ABSL_GUARDED_BY(mutex_);
+    uint64_t bytes_ ABSL_GUARDED_BY(mutex_){};
+    // The generations of the keys, bumped by their invalidation. Keys share a generation when
+    // their hashes do, which may only skip some insertions.
+    std::array<uint64_t, NumGenerations> generations_ ABSL_GUARDED_BY(mutex_){};
+  };
+
+  Shard& shard(size_t hash) { return shards_[hash % NumShards]; }
+  static uint64_t& generationOf(Shard& shard, size_t hash) ABSL_EXCLUSIVE_LOCKS_REQUIRED(
+      shard.mutex_) {
+    return shard.generations_[(hash / NumShards) % NumGenerations];
+  }
+  // Accounts for the removal of the responses of entry from shard, which is left to the caller.
+  // Returns the number of responses removed.
+  uint64_t release(Shard& shard, const KeyEntry& entry) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  const absl::flat_hash_set<std::string> commands_;
+  const std::chrono::milliseconds ttl_;
+  const uint64_t max_shard_bytes_;
+  TimeSource& time_source_;
+  LocalCacheStats stats_;
+  std::array<Shard, NumShards> shards_;
+};
+
+using LocalCacheSharedPtr = std::shared_ptr<LocalCache>;
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -7,6 +7,7 @@
 #include "envoy/upstream/thread_local_cluster.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/tcp_proxy/tcp_proxy.h"
 
 namespace Envoy {
@@ -47,12 +48,16 @@ Network::FilterStatus ProxyFilter::onNewConnection() {
     return Network::FilterStatus::Continue;
   }
 
-  circuit_breaker_ = config_->cache().canCreateDnsRequest();
-
-  if (circuit_breaker_ == nullptr) {
-    ENVOY_CONN_LOG(debug, "pending request overflow", read_callbacks_->connection());
-    read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
-    return Network::FilterStatus::StopIteration;
+  // A pending request is only made for hosts the cache has to load, so connections to resolved
+  // hosts, which the cache keeps serving while it refreshes them, don't take a circuit breaker
+  // slot. The cache is looked up first, so that a rejected connection doesn't start a resolution.
+  const bool check_circuit_breaker_on_load = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.sni_dfp_circuit_breaker_on_cache_load");
+  if (!check_circuit_breaker_on_load || !config_->cache().getHost(host).has_value()) {
+    circuit_breaker_ = config_->cache().canCreateDnsRequest();
+    if (circuit_breaker_ == nullptr) {
+      return onPendingRequestOverflow();
+    }
   }
 
   const StreamInfo::UInt32Accessor* dynamic_port_filter_state =
@@ -72,6 +77,14 @@ Network::FilterStatus ProxyFilter::onNewConnection() {
   auto result = config_->cache().loadDnsCacheEntry(host, port, false, *this);
 
   cache_load_handle_ = std::move(result.handle_);
+  if (cache_load_handle_ != nullptr && circuit_breaker_ == nullptr) {
+    // The host was removed from the cache since it was looked up.
+    circuit_breaker_ = config_->cache().canCreateDnsRequest();
+    if (circuit_breaker_ == nullptr) {
+      cache_load_handle_.reset();
+      return onPendingRequestOverflow();
+    }
+  }
   if (cache_load_handle_ == nullptr) {
     circuit_breaker_.reset();
   }
@@ -97,6 +110,12 @@ Network::FilterStatus ProxyFilter::onNewConnection() {
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
+Network::FilterStatus ProxyFilter::onPendingRequestOverflow() {
+  ENVOY_CONN_LOG(debug, "pending request overflow", read_callbacks_->connection());
+  read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+  return Network::FilterStatus::StopIteration;
+}
+
 void ProxyFilter::onLoadDnsCacheComplete(const Common::DynamicForwardProxy::DnsHostInfoSharedPtr&) {
   ENVOY_CONN_LOG(debug, "load DNS cache complete, continuing", read_callbacks_->connection());
   ASSERT(circuit_breaker_ != nullptr);
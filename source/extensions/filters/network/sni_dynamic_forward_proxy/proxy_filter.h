@@ -54,6 +54,8 @@ public:
       const Extensions::Common::DynamicForwardProxy::DnsHostInfoSharedPtr&) override;
 
 private:
+  Network::FilterStatus onPendingRequestOverflow();
+
   const ProxyFilterConfigSharedPtr config_;
   Upstream::ResourceAutoIncDecPtr circuit_breaker_;
   Extensions::Common::DynamicForwardProxy::DnsCache::LoadDnsCacheEntryHandlePtr cache_load_handle_;
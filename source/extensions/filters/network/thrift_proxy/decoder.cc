@@ -6,6 +6,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/macros.h"
 #include "source/extensions/filters/network/thrift_proxy/app_exception_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/passthrough_decoder_event_handler.h"
 #include "source/extensions/filters/network/thrift_proxy/thrift.h"
 
 namespace Envoy {
@@ -13,6 +14,63 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace ThriftProxy {
 
+/**
+ * Skips over the fields of a message body, without dispatching them, to find where the body ends.
+ * The body is scanned in a copy of the data, so that it can then be passed through as is.
+ */
+class DecoderStateMachine::BodyScanner : public DecoderCallbacks {
+public:
+  BodyScanner(Protocol& proto, const DecoderCallbacks& callbacks)
+      : metadata_(std::make_shared<MessageMetadata>(callbacks.isRequest(),
+                                                    callbacks.headerKeysPreserveCase())),
+        is_request_(callbacks.isRequest()),
+        header_keys_preserve_case_(callbacks.headerKeysPreserveCase()),
+        state_machine_(proto, metadata_, handler_, *this) {
+    state_machine_.setCurrentState(ProtocolState::StructBegin);
+    state_machine_.stack_.emplace_back(Frame(ProtocolState::MessageEnd));
+  }
+
+  /**
+   * @param buffer a buffer starting with the body, which grows between calls.
+   * @return the length of the body, or absl::nullopt if its end wasn't received yet.
+   */
+  absl::optional<uint64_t> scan(const Buffer::Instance& buffer) {
+    // Only the data received since the last call is copied.
+    uint64_t offset = copied_bytes_;
+    for (const Buffer::RawSlice& slice : buffer.getRawSlices()) {
+      if (offset >= slice.len_) {
+        offset -= slice.len_;
+        continue;
+      }
+      scan_buffer_.add(static_cast<const uint8_t*>(slice.mem_) + offset, slice.len_ - offset);
+      offset = 0;
+    }
+    copied_bytes_ = buffer.length();
+
+    if (state_machine_.run(scan_buffer_) != ProtocolState::Done) {
+      return absl::nullopt;
+    }
+    return copied_bytes_ - scan_buffer_.length();
+  }
+
+  // DecoderCallbacks
+  DecoderEventHandler& newDecoderEventHandler() override { return handler_; }
+  bool passthroughEnabled() const override { return false; }
+  bool isRequest() const override { return is_request_; }
+  bool headerKeysPreserveCase() const override { return header_keys_preserve_case_; }
+
+private:
+  PassThroughDecoderEventHandler handler_;
+  MessageMetadataSharedPtr metadata_;
+  const bool is_request_;
+  const bool header_keys_preserve_case_;
+  DecoderStateMachine state_machine_;
+  Buffer::OwnedImpl scan_buffer_;
+  uint64_t copied_bytes_{};
+};
+
+DecoderStateMachine::~DecoderStateMachine() = default;
+
 // PassthroughData -> PassthroughData
 // PassthroughData -> MessageEnd (all body bytes received)
 DecoderStateMachine::DecoderStatus DecoderStateMachine::passthroughData(Buffer::Instance& buffer) {
@@ -26,6 +84,23 @@ DecoderStateMachine::DecoderStatus DecoderStateMachine::passthroughData(Buffer::
   return {ProtocolState::MessageEnd, handler_.passthroughData(body)};
 }
 
+// PassthroughScan -> PassthroughScan (the end of the body wasn't received yet)
+// PassthroughScan -> PassthroughData (the end of the body was found)
+DecoderStateMachine::DecoderStatus DecoderStateMachine::passthroughScan(Buffer::Instance& buffer) {
+  if (body_scanner_ == nullptr) {
+    body_scanner_ = std::make_unique<BodyScanner>(proto_, callbacks_);
+  }
+
+  const absl::optional<uint64_t> body_bytes = body_scanner_->scan(buffer);
+  if (!body_bytes.has_value()) {
+    return {ProtocolState::WaitForData};
+  }
+
+  body_scanner_.reset();
+  body_bytes_ = static_cast<uint32_t>(body_bytes.value());
+  return {ProtocolState::PassthroughData, FilterStatus::Continue};
+}
+
 // MessageBegin -> StructBegin
 // MessageBegin -> ReplyPayload (reply received, get reply type)
 DecoderStateMachine::DecoderStatus DecoderStateMachine::messageBegin(Buffer::Instance& buffer) {
@@ -49,6 +124,10 @@ DecoderStateMachine::DecoderStatus DecoderStateMachine::handleMessageBegin() {
   const auto status = handler_.messageBegin(metadata_);
 
   if (callbacks_.passthroughEnabled()) {
+    if (!metadata_->hasFrameSize()) {
+      // Only the method name and the sequence id are decoded, the body is scanned for its end.
+      return {ProtocolState::PassthroughScan, status};
+    }
     body_bytes_ = metadata_->frameSize() - body_start_;
     return {ProtocolState::PassthroughData, status};
   }
@@ -338,6 +417,8 @@ DecoderStateMachine::DecoderStatus DecoderStateMachine::handleState(Buffer::Inst
   switch (state_) {
   case ProtocolState::PassthroughData:
     return passthroughData(buffer);
+  case ProtocolState::PassthroughScan:
+    return passthroughScan(buffer);
   case ProtocolState::MessageBegin:
     return messageBegin(buffer);
   case ProtocolState::ReplyPayload:
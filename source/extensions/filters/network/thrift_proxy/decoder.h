@@ -17,6 +17,7 @@ namespace ThriftProxy {
   FUNCTION(StopIteration)                                                                          \
   FUNCTION(WaitForData)                                                                            \
   FUNCTION(PassthroughData)                                                                        \
+  FUNCTION(PassthroughScan)                                                                        \
   FUNCTION(MessageBegin)                                                                           \
   FUNCTION(MessageEnd)                                                                             \
   FUNCTION(ReplyPayload)                                                                           \
@@ -68,6 +69,7 @@ public:
   DecoderStateMachine(Protocol& proto, MessageMetadataSharedPtr& metadata,
                       DecoderEventHandler& handler, DecoderCallbacks& callbacks)
       : proto_(proto), metadata_(metadata), handler_(handler), callbacks_(callbacks) {}
+  ~DecoderStateMachine();
 
   /**
    * Consumes as much data from the configured Buffer as possible and executes the decoding state
@@ -99,6 +101,8 @@ public:
   void setCurrentState(ProtocolState state) { state_ = state; }
 
 private:
+  class BodyScanner;
+
   /**
    * Frame encodes information about the return state for nested elements, container element types,
    * and the number of remaining container elements.
@@ -139,6 +143,7 @@ private:
   // These functions map directly to the matching ProtocolState values. Each returns the next state
   // or ProtocolState::WaitForData if more data is required.
   DecoderStatus passthroughData(Buffer::Instance& buffer);
+  DecoderStatus passthroughScan(Buffer::Instance& buffer);
   DecoderStatus messageBegin(Buffer::Instance& buffer);
   DecoderStatus messageEnd(Buffer::Instance& buffer);
   DecoderStatus replyPayload(Buffer::Instance& buffer);
@@ -185,6 +190,9 @@ private:
   std::vector<Frame> stack_;
   uint32_t body_start_{};
   uint32_t body_bytes_{};
+  // Finds the end of the body for payload passthrough when the transport doesn't provide the frame
+  // size, e.g. the unframed transport.
+  std::unique_ptr<BodyScanner> body_scanner_;
 };
 
 using DecoderStateMachinePtr = std::unique_ptr<DecoderStateMachine>;
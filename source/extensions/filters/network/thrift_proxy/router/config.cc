@@ -3,7 +3,9 @@
 #include "envoy/extensions/filters/network/thrift_proxy/router/v3/router.pb.h"
 #include "envoy/extensions/filters/network/thrift_proxy/router/v3/router.pb.validate.h"
 #include "envoy/registry/registry.h"
+#include "envoy/thread_local/thread_local.h"
 
+#include "source/extensions/filters/network/thrift_proxy/router/connection_multiplexer.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/router/shadow_writer_impl.h"
 
@@ -16,8 +18,6 @@ namespace Router {
 ThriftFilters::FilterFactoryCb RouterFilterConfig::createFilterFactoryFromProtoTyped(
     const envoy::extensions::filters::network::thrift_proxy::router::v3::Router& proto_config,
     const std::string& stat_prefix, Server::Configuration::FactoryContext& context) {
-  UNREFERENCED_PARAMETER(proto_config);
-
   auto stats =
       std::make_shared<const RouterStats>(stat_prefix, context.scope(), context.localInfo());
   auto shadow_writer = std::make_shared<ShadowWriterImpl>(
@@ -25,11 +25,22 @@ ThriftFilters::FilterFactoryCb RouterFilterConfig::createFilterFactoryFromProtoT
   bool close_downstream_on_error =
       PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, close_downstream_on_upstream_error, true);
 
-  return [&context, stats, shadow_writer, close_downstream_on_error](
+  const uint32_t max_concurrent_requests_per_connection =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_concurrent_requests_per_connection, 1);
+  std::shared_ptr<ThreadLocal::TypedSlot<ConnectionMultiplexer>> multiplexer;
+  if (max_concurrent_requests_per_connection > 1) {
+    multiplexer = ThreadLocal::TypedSlot<ConnectionMultiplexer>::makeUnique(context.threadLocal());
+    multiplexer->set([max_concurrent_requests_per_connection](Event::Dispatcher& dispatcher) {
+      return std::make_shared<ConnectionMultiplexer>(dispatcher,
+                                                     max_concurrent_requests_per_connection);
+    });
+  }
+
+  return [&context, stats, shadow_writer, close_downstream_on_error, multiplexer](
              ThriftFilters::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addDecoderFilter(std::make_shared<Router>(context.clusterManager(), *stats,
-                                                        context.runtime(), *shadow_writer,
-                                                        close_downstream_on_error));
+    callbacks.addDecoderFilter(std::make_shared<Router>(
+        context.clusterManager(), *stats, context.runtime(), *shadow_writer,
+        close_downstream_on_error, multiplexer != nullptr ? &**multiplexer : nullptr));
   };
 }
 
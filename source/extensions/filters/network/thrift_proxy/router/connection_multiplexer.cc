@@ -0,0 +1,353 @@
+#include "source/extensions/filters/network/thrift_proxy/router/connection_multiplexer.h"
+
+#include <algorithm>
+#include <string>
+
+#include "envoy/common/exception.h"
+
+#include "source/extensions/filters/network/thrift_proxy/framed_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/header_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/metadata.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+
+namespace {
+
+// The number of bytes at the start of a response frame first decoded for its sequence id. The
+// message begin of most responses fits in it.
+constexpr uint64_t InitialSequenceIdPeekSize = 256;
+
+} // namespace
+
+MultiplexedConnection::MultiplexedConnection(ConnectionMultiplexer& parent,
+                                             Upstream::HostDescriptionConstSharedPtr host,
+                                             TransportType transport_type,
+                                             ProtocolType protocol_type)
+    : parent_(parent), host_(std::move(host)),
+      transport_(NamedTransportConfigFactory::getFactory(transport_type).createTransport()),
+      protocol_(NamedProtocolConfigFactory::getFactory(protocol_type).createProtocol()) {}
+
+MultiplexedConnection::~MultiplexedConnection() {
+  if (conn_pool_handle_) {
+    conn_pool_handle_->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+  }
+}
+
+void MultiplexedConnection::connect(Upstream::TcpPoolData& pool_data) {
+  ASSERT(pending_requests_.empty());
+  Tcp::ConnectionPool::Cancellable* handle = pool_data.newConnection(*this);
+  if (handle) {
+    conn_pool_handle_ = handle;
+  }
+}
+
+Tcp::ConnectionPool::Cancellable*
+MultiplexedConnection::newRequest(MultiplexedConnectionCallbacks& callbacks) {
+  switch (state_) {
+  case State::Connecting:
+    LinkedList::moveIntoList(std::make_unique<PendingRequest>(*this, callbacks),
+                             pending_requests_);
+    return pending_requests_.front().get();
+  case State::Ready:
+    callbacks.onMultiplexedConnectionReady(*this, host_);
+    return nullptr;
+  case State::Failed:
+    callbacks.onMultiplexedConnectionFailure(failure_reason_, failure_host_);
+    return nullptr;
+  case State::Draining:
+  case State::Closed:
+    break;
+  }
+  PANIC("no request is added to a draining or closed connection");
+}
+
+int32_t MultiplexedConnection::addRequest(Tcp::ConnectionPool::UpstreamCallbacks& callbacks) {
+  ASSERT(state_ == State::Ready);
+  int32_t sequence_id = conn_state_->nextSequenceId();
+  // The sequence ids wrap around, skip the ones of the requests still waiting for their response.
+  while (requests_.contains(sequence_id)) {
+    sequence_id = conn_state_->nextSequenceId();
+  }
+  requests_.emplace(sequence_id, &callbacks);
+  return sequence_id;
+}
+
+void MultiplexedConnection::removeRequest(int32_t sequence_id) {
+  if (requests_.erase(sequence_id) > 0) {
+    maybeRelease();
+  }
+}
+
+void MultiplexedConnection::drain() {
+  if (state_ == State::Ready) {
+    ENVOY_LOG(debug, "draining multiplexed connection with {} requests", requests_.size());
+    state_ = State::Draining;
+  }
+}
+
+void MultiplexedConnection::write(Buffer::Instance& data) {
+  ASSERT(conn_data_ != nullptr);
+  conn_data_->connection().write(data, false);
+}
+
+bool MultiplexedConnection::hasCapacity() const {
+  return (state_ == State::Connecting || state_ == State::Ready) &&
+         requestCount() < parent_.maxRequestsPerConnection();
+}
+
+void MultiplexedConnection::onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                                          absl::string_view,
+                                          Upstream::HostDescriptionConstSharedPtr host) {
+  ENVOY_LOG(debug, "multiplexed connection failure, {} requests waiting", pending_requests_.size());
+  conn_pool_handle_ = nullptr;
+  state_ = State::Failed;
+  failure_reason_ = reason;
+  failure_host_ = host;
+  parent_.remove(*this);
+
+  // The requests are removed one at a time, as failing one may cancel others.
+  while (!pending_requests_.empty()) {
+    PendingRequestPtr request = pending_requests_.back()->removeFromList(pending_requests_);
+    request->callbacks_.onMultiplexedConnectionFailure(reason, host);
+  }
+}
+
+void MultiplexedConnection::onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_data,
+                                        Upstream::HostDescriptionConstSharedPtr host) {
+  // Whether the connection was given inline by connect(), before any request was queued.
+  const bool inline_ready = conn_pool_handle_ == nullptr;
+  conn_pool_handle_ = nullptr;
+
+  host->outlierDetector().putResult(Upstream::Outlier::Result::LocalOriginConnectSuccess);
+
+  conn_data_ = std::move(conn_data);
+  conn_data_->addUpstreamCallbacks(*this);
+  conn_state_ = conn_data_->connectionStateTyped<ThriftConnectionState>();
+  if (conn_state_ == nullptr) {
+    conn_data_->setConnectionState(std::make_unique<ThriftConnectionState>());
+    conn_state_ = conn_data_->connectionStateTyped<ThriftConnectionState>();
+  }
+  state_ = State::Ready;
+
+  if (inline_ready) {
+    return;
+  }
+
+  ENVOY_LOG(debug, "multiplexed connection ready, {} requests waiting", pending_requests_.size());
+  while (!pending_requests_.empty()) {
+    PendingRequestPtr request = pending_requests_.back()->removeFromList(pending_requests_);
+    if (state_ == State::Ready) {
+      request->callbacks_.onMultiplexedConnectionReady(*this, host_);
+    } else {
+      request->callbacks_.onMultiplexedConnectionFailure(
+          ConnectionPool::PoolFailureReason::LocalConnectionFailure, host_);
+    }
+  }
+
+  // All the requests may have been cancelled while connecting.
+  maybeRelease();
+}
+
+void MultiplexedConnection::onUpstreamData(Buffer::Instance& data, bool end_stream) {
+  response_buffer_.move(data);
+  dispatchFrames();
+
+  if (end_stream && (state_ == State::Ready || state_ == State::Draining)) {
+    ENVOY_LOG(debug, "multiplexed connection end of stream, {} requests waiting for a response",
+              requests_.size());
+    close();
+  }
+}
+
+void MultiplexedConnection::onEvent(Network::ConnectionEvent event) {
+  if (event == Network::ConnectionEvent::Connected ||
+      event == Network::ConnectionEvent::ConnectedZeroRtt || state_ == State::Closed) {
+    // Connected is consumed by the connection pool, and the close of a connection released by
+    // closing it was handled by close().
+    return;
+  }
+
+  ENVOY_LOG(debug, "multiplexed connection closed, {} requests waiting for a response",
+            requests_.size());
+  state_ = State::Closed;
+  conn_state_ = nullptr;
+  conn_data_.reset();
+  parent_.remove(*this);
+  resetRequests(event);
+}
+
+void MultiplexedConnection::PendingRequest::cancel(Tcp::ConnectionPool::CancelPolicy) {
+  // The connection is kept and returned to the pool once ready if it has no request left.
+  removeFromList(parent_.pending_requests_);
+}
+
+absl::optional<int32_t> MultiplexedConnection::sequenceId(const Buffer::Instance& frame) {
+  // The transport and the protocol drain what they decode, so they are given a copy of the start
+  // of the frame, grown until it holds the whole message begin.
+  uint64_t size = std::min(frame.length(), InitialSequenceIdPeekSize);
+  while (true) {
+    std::string data(size, '\0');
+    frame.copyOut(0, size, data.data());
+    Buffer::OwnedImpl prefix(data);
+
+    MessageMetadata metadata;
+    if (transport_->decodeFrameStart(prefix, metadata) &&
+        protocol_->readMessageBegin(prefix, metadata)) {
+      if (!metadata.hasSequenceId()) {
+        return absl::nullopt;
+      }
+      return metadata.sequenceId();
+    }
+
+    if (size == frame.length()) {
+      return absl::nullopt;
+    }
+    size = std::min(frame.length(), size * 2);
+  }
+}
+
+void MultiplexedConnection::dispatchFrames() {
+  const int32_t max_frame_size = transport_->type() == TransportType::Header
+                                     ? HeaderTransportImpl::MaxFrameSize
+                                     : FramedTransportImpl::MaxFrameSize;
+
+  // The requests are looked up again for each frame, as handling a response may remove others.
+  while (state_ == State::Ready || state_ == State::Draining) {
+    // Both the framed and the header transports start their frames with their size.
+    if (response_buffer_.length() < sizeof(int32_t)) {
+      return;
+    }
+    const int32_t frame_size = response_buffer_.peekBEInt<int32_t>();
+    if (frame_size <= 0 || frame_size > max_frame_size) {
+      ENVOY_LOG(debug, "multiplexed connection invalid response frame size {}", frame_size);
+      close();
+      return;
+    }
+    const uint64_t frame_length = sizeof(int32_t) + static_cast<uint64_t>(frame_size);
+    if (response_buffer_.length() < frame_length) {
+      return;
+    }
+
+    Buffer::OwnedImpl frame;
+    frame.move(response_buffer_, frame_length);
+
+    absl::optional<int32_t> sequence_id;
+    try {
+      sequence_id = sequenceId(frame);
+    } catch (const EnvoyException& ex) {
+      ENVOY_LOG(debug, "multiplexed connection invalid response: {}", ex.what());
+    }
+    if (!sequence_id.has_value()) {
+      close();
+      return;
+    }
+
+    auto it = requests_.find(sequence_id.value());
+    if (it == requests_.end()) {
+      // The request was reset while waiting for its response.
+      ENVOY_LOG(debug, "multiplexed connection dropping response with sequence id {}",
+                sequence_id.value());
+      continue;
+    }
+
+    // The frame is the whole response, a request that can't decode it has no more data to wait
+    // for.
+    it->second->onUpstreamData(frame, true);
+    removeRequest(sequence_id.value());
+  }
+}
+
+void MultiplexedConnection::maybeRelease() {
+  if (!requests_.empty() || !pending_requests_.empty()) {
+    return;
+  }
+
+  if (state_ == State::Ready && response_buffer_.length() == 0) {
+    ENVOY_LOG(debug, "releasing multiplexed connection");
+    state_ = State::Closed;
+    conn_state_ = nullptr;
+    conn_data_.reset();
+    parent_.remove(*this);
+  } else if (state_ == State::Ready || state_ == State::Draining) {
+    // Bytes no request waits for are left on the connection, it can't be reused.
+    close();
+  }
+}
+
+void MultiplexedConnection::close() {
+  ENVOY_LOG(debug, "closing multiplexed connection with {} requests", requests_.size());
+  state_ = State::Closed;
+  conn_state_ = nullptr;
+
+  // The event triggered by close would also reset the requests, so clear conn_data_ before
+  // closing.
+  auto conn_data = std::move(conn_data_);
+  conn_data->connection().close(Network::ConnectionCloseType::NoFlush);
+  parent_.remove(*this);
+  resetRequests(Network::ConnectionEvent::LocalClose);
+}
+
+void MultiplexedConnection::resetRequests(Network::ConnectionEvent event) {
+  // The requests are removed one at a time, as resetting one may destroy others.
+  while (!requests_.empty()) {
+    auto it = requests_.begin();
+    Tcp::ConnectionPool::UpstreamCallbacks* callbacks = it->second;
+    requests_.erase(it);
+    callbacks->onEvent(event);
+  }
+}
+
+bool ConnectionMultiplexer::supports(TransportType transport, ProtocolType protocol) {
+  return (transport == TransportType::Framed || transport == TransportType::Header) &&
+         protocol != ProtocolType::Twitter;
+}
+
+Tcp::ConnectionPool::Cancellable*
+ConnectionMultiplexer::newRequest(Upstream::TcpPoolData& pool_data, TransportType transport,
+                                  ProtocolType protocol,
+                                  MultiplexedConnectionCallbacks& callbacks) {
+  ASSERT(supports(transport, protocol));
+  Upstream::HostDescriptionConstSharedPtr host = pool_data.host();
+  auto& connections = connections_[Key(host.get(), transport, protocol)];
+  for (auto& connection : connections) {
+    if (connection->hasCapacity()) {
+      return connection->newRequest(callbacks);
+    }
+  }
+
+  LinkedList::moveIntoList(
+      std::make_unique<MultiplexedConnection>(*this, std::move(host), transport, protocol),
+      connections);
+  // The connection stays alive while connecting, even if the connection fails and removes itself
+  // inline, as it is deleted in a later iteration of the dispatcher.
+  MultiplexedConnection& connection = *connections.front();
+  connection.connect(pool_data);
+  return connection.newRequest(callbacks);
+}
+
+void ConnectionMultiplexer::remove(MultiplexedConnection& connection) {
+  auto it = connections_.find(connection.key());
+  ASSERT(it != connections_.end());
+  dispatcher_.deferredDelete(connection.removeFromList(it->second));
+  if (it->second.empty()) {
+    connections_.erase(it);
+  }
+}
+
+size_t ConnectionMultiplexer::connectionCount() const {
+  size_t count = 0;
+  for (const auto& [key, connections] : connections_) {
+    count += connections.size();
+  }
+  return count;
+}
+
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <tuple>
+
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/tcp/conn_pool.h"
+#include "envoy/thread_local/thread_local_object.h"
+#include "envoy/upstream/thread_local_cluster.h"
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/linked_object.h"
+#include "source/common/common/logger.h"
+#include "source/extensions/filters/network/thrift_proxy/conn_state.h"
+#include "source/extensions/filters/network/thrift_proxy/protocol.h"
+#include "source/extensions/filters/network/thrift_proxy/thrift.h"
+#include "source/extensions/filters/network/thrift_proxy/transport.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+
+class MultiplexedConnection;
+
+/**
+ * Callbacks of the requests waiting for a MultiplexedConnection.
+ */
+class MultiplexedConnectionCallbacks {
+public:
+  virtual ~MultiplexedConnectionCallbacks() = default;
+
+  /**
+   * Called when the connection the request waited for could not be established.
+   * @param reason supplies the failure reason.
+   * @param host supplies the host the connection was for.
+   */
+  virtual void onMultiplexedConnectionFailure(ConnectionPool::PoolFailureReason reason,
+                                              Upstream::HostDescriptionConstSharedPtr host) PURE;
+
+  /**
+   * Called when the request can be sent on the connection, after adding itself with
+   * MultiplexedConnection::addRequest().
+   * @param connection supplies the connection.
+   * @param host supplies the host the connection is to.
+   */
+  virtual void onMultiplexedConnectionReady(MultiplexedConnection& connection,
+                                            Upstream::HostDescriptionConstSharedPtr host) PURE;
+};
+
+class ConnectionMultiplexer;
+
+/**
+ * An upstream connection shared by the concurrent requests of a worker to a host. The requests
+ * are given sequence ids that are unique on the connection, and the responses, which the
+ * transport frames, are handed to the request with their sequence id in whatever order they
+ * come in. The response of a request that is gone is dropped.
+ *
+ * The connection is returned to the pool once it has no request left.
+ */
+class MultiplexedConnection : public Tcp::ConnectionPool::Callbacks,
+                              public Tcp::ConnectionPool::UpstreamCallbacks,
+                              public Event::DeferredDeletable,
+                              public LinkedObject<MultiplexedConnection>,
+                              Logger::Loggable<Logger::Id::thrift> {
+public:
+  using Key = std::tuple<const Upstream::HostDescription*, TransportType, ProtocolType>;
+
+  MultiplexedConnection(ConnectionMultiplexer& parent, Upstream::HostDescriptionConstSharedPtr host,
+                        TransportType transport_type, ProtocolType protocol_type);
+  ~MultiplexedConnection() override;
+
+  /**
+   * @return the host, transport and protocol of the connection.
+   */
+  Key key() const { return {host_.get(), transport_->type(), protocol_->type()}; }
+
+  /**
+   * Gets a connection from the pool.
+   */
+  void connect(Upstream::TcpPoolData& pool_data);
+
+  /**
+   * Gets the connection for a request, invoking its callbacks inline if the connection is ready.
+   * @return a handle to cancel the wait for the connection, nullptr if the callbacks were invoked.
+   */
+  Tcp::ConnectionPool::Cancellable* newRequest(MultiplexedConnectionCallbacks& callbacks);
+
+  /**
+   * Adds a request to the connection.
+   * @param callbacks supplies the callbacks the response of the request is handed to.
+   * @return the sequence id of the request on the connection.
+   */
+  int32_t addRequest(Tcp::ConnectionPool::UpstreamCallbacks& callbacks);
+
+  /**
+   * Removes a request from the connection, which no longer receives its response.
+   */
+  void removeRequest(int32_t sequence_id);
+
+  /**
+   * Stops adding requests to the connection and closes it once it has no request left.
+   */
+  void drain();
+
+  void write(Buffer::Instance& data);
+  ThriftConnectionState& connectionState() { return *conn_state_; }
+  bool hasCapacity() const;
+  size_t requestCount() const { return requests_.size() + pending_requests_.size(); }
+
+  // Tcp::ConnectionPool::Callbacks
+  void onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                     absl::string_view transport_failure_reason,
+                     Upstream::HostDescriptionConstSharedPtr host) override;
+  void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_data,
+                   Upstream::HostDescriptionConstSharedPtr host) override;
+
+  // Tcp::ConnectionPool::UpstreamCallbacks
+  void onUpstreamData(Buffer::Instance& data, bool end_stream) override;
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override {}
+  void onBelowWriteBufferLowWatermark() override {}
+
+private:
+  struct PendingRequest : public Tcp::ConnectionPool::Cancellable,
+                          public LinkedObject<PendingRequest> {
+    PendingRequest(MultiplexedConnection& parent, MultiplexedConnectionCallbacks& callbacks)
+        : parent_(parent), callbacks_(callbacks) {}
+
+    // Tcp::ConnectionPool::Cancellable
+    void cancel(Tcp::ConnectionPool::CancelPolicy) override;
+
+    MultiplexedConnection& parent_;
+    MultiplexedConnectionCallbacks& callbacks_;
+  };
+  using PendingRequestPtr = std::unique_ptr<PendingRequest>;
+
+  enum class State : uint8_t { Connecting, Ready, Draining, Failed, Closed };
+
+  absl::optional<int32_t> sequenceId(const Buffer::Instance& frame);
+  void dispatchFrames();
+  void maybeRelease();
+  void close();
+  void resetRequests(Network::ConnectionEvent event);
+
+  ConnectionMultiplexer& parent_;
+  const Upstream::HostDescriptionConstSharedPtr host_;
+  TransportPtr transport_;
+  ProtocolPtr protocol_;
+  State state_{State::Connecting};
+  ConnectionPool::PoolFailureReason failure_reason_{};
+  Upstream::HostDescriptionConstSharedPtr failure_host_;
+
+  Tcp::ConnectionPool::Cancellable* conn_pool_handle_{};
+  Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+  ThriftConnectionState* conn_state_{};
+  std::list<PendingRequestPtr> pending_requests_;
+  absl::flat_hash_map<int32_t, Tcp::ConnectionPool::UpstreamCallbacks*> requests_;
+  Buffer::OwnedImpl response_buffer_;
+};
+
+using MultiplexedConnectionPtr = std::unique_ptr<MultiplexedConnection>;
+
+/**
+ * The multiplexed connections of a worker, shared by the requests to the same host with the same
+ * transport and protocol. A request is added to a connection that has fewer than
+ * max_requests_per_connection requests, or to a new one if there is none.
+ */
+class ConnectionMultiplexer : public ThreadLocal::ThreadLocalObject {
+public:
+  ConnectionMultiplexer(Event::Dispatcher& dispatcher, uint32_t max_requests_per_connection)
+      : dispatcher_(dispatcher), max_requests_per_connection_(max_requests_per_connection) {}
+
+  /**
+   * @return true if the requests of the transport and protocol can share connections, which the
+   *         framed and header transports allow as they tell where each response ends. Protocols
+   *         upgrading their connections can't share them, as their upgrade is per request.
+   */
+  static bool supports(TransportType transport, ProtocolType protocol);
+
+  /**
+   * Gets a connection to the host of the pool for a request.
+   * @return a handle to cancel the wait for the connection, nullptr if the callbacks were invoked.
+   */
+  Tcp::ConnectionPool::Cancellable* newRequest(Upstream::TcpPoolData& pool_data,
+                                               TransportType transport, ProtocolType protocol,
+                                               MultiplexedConnectionCallbacks& callbacks);
+
+  void remove(MultiplexedConnection& connection);
+  uint32_t maxRequestsPerConnection() const { return max_requests_per_connection_; }
+  size_t connectionCount() const;
+
+private:
+  using Key = MultiplexedConnection::Key;
+
+  Event::Dispatcher& dispatcher_;
+  const uint32_t max_requests_per_connection_;
+  absl::flat_hash_map<Key, std::list<MultiplexedConnectionPtr>> connections_;
+};
+
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -212,6 +212,7 @@ public:
     incClusterScopeCounter(cluster, upstream_host, upstream_resp_reply_success_);
     ASSERT(upstream_host != nullptr);
     upstream_host->stats().rq_success_.inc();
+    upstream_host->localityLoadStats().incRqSuccess();
   }
 
   /**
@@ -228,6 +229,7 @@ public:
     // to have semantics matching HTTP 4xx, rather than 5xx. rq_error classification chosen
     // here to match outlier detection external failure in upstream_request.cc.
     upstream_host->stats().rq_error_.inc();
+    upstream_host->localityLoadStats().incRqError();
   }
 
   /**
@@ -241,6 +243,7 @@ public:
     ASSERT(upstream_host != nullptr);
     incClusterScopeCounter(cluster, nullptr, upstream_resp_exception_remote_);
     upstream_host->stats().rq_error_.inc();
+    upstream_host->localityLoadStats().incRqError();
   }
 
   /**
@@ -263,6 +266,7 @@ public:
     incClusterScopeCounter(cluster, upstream_host, upstream_resp_invalid_type_);
     ASSERT(upstream_host != nullptr);
     upstream_host->stats().rq_error_.inc();
+    upstream_host->localityLoadStats().incRqError();
   }
 
   /**
@@ -275,6 +279,7 @@ public:
     incClusterScopeCounter(cluster, upstream_host, upstream_resp_decoding_error_);
     ASSERT(upstream_host != nullptr);
     upstream_host->stats().rq_error_.inc();
+    upstream_host->localityLoadStats().incRqError();
   }
 
   /**
@@ -526,9 +531,8 @@ protected:
               absl::nullopt};
     }
 
+    // The body of unframed messages is scanned for its end, so any transport can pass it through.
     const auto passthrough_supported =
-        (transport == TransportType::Framed || transport == TransportType::Header) &&
-        (final_transport == TransportType::Framed || final_transport == TransportType::Header) &&
         protocol == final_protocol && final_protocol != ProtocolType::Twitter;
     UpstreamRequestInfo result = {passthrough_supported, final_transport, final_protocol,
                                   conn_pool_data};
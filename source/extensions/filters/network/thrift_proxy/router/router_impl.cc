@@ -326,9 +326,13 @@ FilterStatus Router::messageBegin(MessageMetadataSharedPtr metadata) {
     }
   }
 
+  ConnectionMultiplexer* multiplexer =
+      ConnectionMultiplexer::supports(upstream_req_info.transport, upstream_req_info.protocol)
+          ? multiplexer_
+          : nullptr;
   upstream_request_ = std::make_unique<UpstreamRequest>(
       *this, *upstream_req_info.conn_pool_data, metadata, upstream_req_info.transport,
-      upstream_req_info.protocol, close_downstream_on_error_);
+      upstream_req_info.protocol, close_downstream_on_error_, multiplexer);
   return upstream_request_->start();
 }
 
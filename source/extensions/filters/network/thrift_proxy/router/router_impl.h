@@ -14,6 +14,7 @@
 #include "source/common/upstream/load_balancer_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/conn_manager.h"
 #include "source/extensions/filters/network/thrift_proxy/filters/filter.h"
+#include "source/extensions/filters/network/thrift_proxy/router/connection_multiplexer.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router_ratelimit_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/router/upstream_request.h"
@@ -225,10 +226,14 @@ class Router : public Tcp::ConnectionPool::UpstreamCallbacks,
                public RequestOwner,
                public ThriftFilters::DecoderFilter {
 public:
+  // If multiplexer is not null, the requests using a transport and protocol it supports share
+  // their upstream connections.
   Router(Upstream::ClusterManager& cluster_manager, const RouterStats& stats,
-         Runtime::Loader& runtime, ShadowWriter& shadow_writer, bool close_downstream_on_error)
+         Runtime::Loader& runtime, ShadowWriter& shadow_writer, bool close_downstream_on_error,
+         ConnectionMultiplexer* multiplexer = nullptr)
       : RequestOwner(cluster_manager, stats), passthrough_supported_(false), runtime_(runtime),
-        shadow_writer_(shadow_writer), close_downstream_on_error_(close_downstream_on_error) {}
+        shadow_writer_(shadow_writer), multiplexer_(multiplexer),
+        close_downstream_on_error_(close_downstream_on_error) {}
 
   ~Router() override = default;
 
@@ -330,6 +335,7 @@ private:
   Runtime::Loader& runtime_;
   ShadowWriter& shadow_writer_;
   std::vector<std::reference_wrapper<ShadowRouterHandle>> shadow_routers_{};
+  ConnectionMultiplexer* multiplexer_;
 
   bool close_downstream_on_error_;
 };
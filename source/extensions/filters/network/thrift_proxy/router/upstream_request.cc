@@ -10,8 +10,10 @@ namespace Router {
 
 UpstreamRequest::UpstreamRequest(RequestOwner& parent, Upstream::TcpPoolData& pool_data,
                                  MessageMetadataSharedPtr& metadata, TransportType transport_type,
-                                 ProtocolType protocol_type, bool close_downstream_on_error)
+                                 ProtocolType protocol_type, bool close_downstream_on_error,
+                                 ConnectionMultiplexer* multiplexer)
     : parent_(parent), stats_(parent.stats()), conn_pool_data_(pool_data), metadata_(metadata),
+      multiplexer_(multiplexer),
       transport_(NamedTransportConfigFactory::getFactory(transport_type).createTransport()),
       protocol_(NamedProtocolConfigFactory::getFactory(protocol_type).createProtocol()),
       request_complete_(false), response_underflow_(false), charged_response_timing_(false),
@@ -21,10 +23,16 @@ UpstreamRequest::~UpstreamRequest() {
   if (conn_pool_handle_) {
     conn_pool_handle_->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
   }
+  if (multiplexed_connection_) {
+    releaseMultiplexedConnection();
+  }
 }
 
 FilterStatus UpstreamRequest::start() {
-  Tcp::ConnectionPool::Cancellable* handle = conn_pool_data_.newConnection(*this);
+  Tcp::ConnectionPool::Cancellable* handle =
+      multiplexer_ != nullptr
+          ? multiplexer_->newRequest(conn_pool_data_, transport_->type(), protocol_->type(), *this)
+          : conn_pool_data_.newConnection(*this);
   if (handle) {
     // Pause while we wait for a connection.
     conn_pool_handle_ = handle;
@@ -52,6 +60,13 @@ void UpstreamRequest::releaseConnection(const bool close) {
 
   conn_state_ = nullptr;
 
+  if (multiplexed_connection_) {
+    // The connection is shared with other requests, so it is kept open. The response of this
+    // request, if any, is dropped when it comes in.
+    releaseMultiplexedConnection();
+    return;
+  }
+
   // The event triggered by close will also release this connection so clear conn_data_ before
   // closing.
   auto conn_data = std::move(conn_data_);
@@ -108,6 +123,31 @@ void UpstreamRequest::onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_
   onRequestStart(continue_decoding);
 }
 
+void UpstreamRequest::onMultiplexedConnectionFailure(ConnectionPool::PoolFailureReason reason,
+                                                     Upstream::HostDescriptionConstSharedPtr host) {
+  onPoolFailure(reason, "", host);
+}
+
+void UpstreamRequest::onMultiplexedConnectionReady(MultiplexedConnection& connection,
+                                                   Upstream::HostDescriptionConstSharedPtr host) {
+  // Only invoke continueDecoding if we'd previously stopped the filter chain.
+  bool continue_decoding = conn_pool_handle_ != nullptr;
+
+  onUpstreamHostSelected(host);
+  conn_pool_handle_ = nullptr;
+
+  multiplexed_connection_ = &connection;
+  conn_state_ = &connection.connectionState();
+  onRequestStart(continue_decoding);
+}
+
+void UpstreamRequest::releaseMultiplexedConnection() {
+  MultiplexedConnection* connection = multiplexed_connection_;
+  multiplexed_connection_ = nullptr;
+  // Removing the last request may release the connection.
+  connection->removeRequest(multiplexed_sequence_id_);
+}
+
 void UpstreamRequest::handleUpgradeResponse(Buffer::Instance& data) {
   ENVOY_LOG(trace, "reading upgrade response: {} bytes", data.length());
   if (!upgrade_response_->onData(data)) {
@@ -166,6 +206,10 @@ UpstreamRequest::handleRegularResponse(Buffer::Instance& data,
     if (callbacks.responseMetadata()->isDraining()) {
       ENVOY_LOG(debug, "got draining signal");
       stats_.incCloseDrain(cluster);
+      if (multiplexed_connection_) {
+        // The connection is closed once the other requests sharing it got their response.
+        multiplexed_connection_->drain();
+      }
       // ResetStream triggers a local connection failure. However, we want to
       // keep the downstream connection after the upstream connection, i.e.,
       // `conn_data->connection()`, is closed. Therefore, introduce a new state
@@ -247,7 +291,11 @@ uint64_t UpstreamRequest::encodeAndWrite(Buffer::OwnedImpl& request_buffer) {
 
   uint64_t size = transport_buffer.length();
 
-  conn_data_->connection().write(transport_buffer, false);
+  if (multiplexed_connection_) {
+    multiplexed_connection_->write(transport_buffer);
+  } else {
+    conn_data_->connection().write(transport_buffer, false);
+  }
 
   return size;
 }
@@ -256,7 +304,14 @@ void UpstreamRequest::onRequestStart(bool continue_decoding) {
   auto& buffer = parent_.buffer();
   parent_.initProtocolConverter(*protocol_, buffer);
 
-  metadata_->setSequenceId(conn_state_->nextSequenceId());
+  if (multiplexed_connection_) {
+    // The sequence id is unique among the requests sharing the connection, so that the response
+    // is handed to this request.
+    multiplexed_sequence_id_ = multiplexed_connection_->addRequest(parent_.upstreamCallbacks());
+    metadata_->setSequenceId(multiplexed_sequence_id_);
+  } else {
+    metadata_->setSequenceId(conn_state_->nextSequenceId());
+  }
   parent_.convertMessageBegin(metadata_);
 
   if (continue_decoding) {
@@ -276,6 +331,9 @@ void UpstreamRequest::onResponseComplete() {
   chargeResponseTiming();
   response_state_ = ResponseState::ConnectionReleased;
   conn_state_ = nullptr;
+  if (multiplexed_connection_) {
+    releaseMultiplexedConnection();
+  }
   conn_data_.reset();
 }
 
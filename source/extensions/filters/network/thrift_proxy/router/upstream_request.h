@@ -7,6 +7,7 @@
 #include "source/extensions/filters/network/thrift_proxy/decoder_events.h"
 #include "source/extensions/filters/network/thrift_proxy/filters/filter.h"
 #include "source/extensions/filters/network/thrift_proxy/metadata.h"
+#include "source/extensions/filters/network/thrift_proxy/router/connection_multiplexer.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router.h"
 #include "source/extensions/filters/network/thrift_proxy/thrift.h"
 
@@ -27,15 +28,19 @@ public:
 };
 
 struct UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
+                         public MultiplexedConnectionCallbacks,
                          Logger::Loggable<Logger::Id::thrift> {
+  // If multiplexer is not null, the request shares a connection to the host with other requests.
   UpstreamRequest(RequestOwner& parent, Upstream::TcpPoolData& pool_data,
                   MessageMetadataSharedPtr& metadata, TransportType transport_type,
-                  ProtocolType protocol_type, bool close_downstream_on_error);
+                  ProtocolType protocol_type, bool close_downstream_on_error,
+                  ConnectionMultiplexer* multiplexer = nullptr);
   ~UpstreamRequest() override;
 
   FilterStatus start();
   void resetStream();
   void releaseConnection(bool close);
+  void releaseMultiplexedConnection();
 
   // Tcp::ConnectionPool::Callbacks
   void onPoolFailure(ConnectionPool::PoolFailureReason reason,
@@ -44,6 +49,12 @@ struct UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
   void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn,
                    Upstream::HostDescriptionConstSharedPtr host) override;
 
+  // MultiplexedConnectionCallbacks
+  void onMultiplexedConnectionFailure(ConnectionPool::PoolFailureReason reason,
+                                      Upstream::HostDescriptionConstSharedPtr host) override;
+  void onMultiplexedConnectionReady(MultiplexedConnection& connection,
+                                    Upstream::HostDescriptionConstSharedPtr host) override;
+
   bool handleUpstreamData(Buffer::Instance& data, bool end_stream,
                           UpstreamResponseCallbacks& callbacks);
   void handleUpgradeResponse(Buffer::Instance& data);
@@ -65,6 +76,10 @@ struct UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
 
   Tcp::ConnectionPool::Cancellable* conn_pool_handle_{};
   Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+  ConnectionMultiplexer* multiplexer_{};
+  // The connection shared with other requests, when the request is multiplexed.
+  MultiplexedConnection* multiplexed_connection_{};
+  int32_t multiplexed_sequence_id_{};
   Upstream::HostDescriptionConstSharedPtr upstream_host_;
   ThriftConnectionState* conn_state_{};
   TransportPtr transport_;
@@ -16,6 +16,9 @@ namespace DnsFilter {
 
 static constexpr std::chrono::milliseconds DEFAULT_RESOLVER_TIMEOUT{500};
 static constexpr std::chrono::seconds DEFAULT_RESOLVER_TTL{300};
+static constexpr uint64_t DEFAULT_ANSWER_CACHE_MAX_ENTRIES{1024};
+static constexpr std::chrono::seconds DEFAULT_ANSWER_CACHE_MAX_TTL{300};
+static constexpr std::chrono::seconds DEFAULT_ANSWER_CACHE_NEGATIVE_TTL{30};
 
 DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     Server::Configuration::ListenerFactoryContext& context,
@@ -166,6 +169,17 @@ DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     resolver_timeout_ = std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
         client_config, resolver_timeout, DEFAULT_RESOLVER_TIMEOUT.count()));
     max_pending_lookups_ = client_config.max_pending_lookups();
+    if (client_config.has_answer_cache()) {
+      const auto& answer_cache = client_config.answer_cache();
+      cache_config_.max_entries = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          answer_cache, max_entries, DEFAULT_ANSWER_CACHE_MAX_ENTRIES);
+      cache_config_.max_ttl = std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+              answer_cache, max_ttl, DEFAULT_ANSWER_CACHE_MAX_TTL.count() * 1000)));
+      cache_config_.negative_ttl = std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+              answer_cache, negative_ttl, DEFAULT_ANSWER_CACHE_NEGATIVE_TTL.count() * 1000)));
+    }
   } else {
     // In case client_config doesn't exist, create default DNS resolver factory and save it.
     dns_resolver_factory_ = &Network::createDefaultDnsResolverFactory(typed_dns_resolver_config_);
@@ -253,7 +267,10 @@ DnsFilter::DnsFilter(Network::UdpReadFilterCallbacks& callbacks,
   resolver_ = std::make_unique<DnsFilterResolver>(
       resolver_callback_, config->resolverTimeout(), listener_.dispatcher(),
       config->maxPendingLookups(), config->typedDnsResolverConfig(), config->dnsResolverFactory(),
-      config->api());
+      config->api(), config->cacheConfig(),
+      DnsFilterResolverCounters(config->stats().external_cache_hits_,
+                                config->stats().external_cache_negative_hits_,
+                                config->stats().external_coalesced_queries_));
 }
 
 Network::FilterStatus DnsFilter::onData(Network::UdpRecvData& client_request) {
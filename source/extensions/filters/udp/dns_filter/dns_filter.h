@@ -34,6 +34,9 @@ namespace DnsFilter {
   COUNTER(downstream_rx_invalid_queries)                                                           \
   COUNTER(downstream_rx_queries)                                                                   \
   COUNTER(external_a_record_queries)                                                               \
+  COUNTER(external_cache_hits)                                                                     \
+  COUNTER(external_cache_negative_hits)                                                            \
+  COUNTER(external_coalesced_queries)                                                              \
   COUNTER(external_a_record_answers)                                                               \
   COUNTER(external_aaaa_record_answers)                                                            \
   COUNTER(external_aaaa_record_queries)                                                            \
@@ -92,6 +95,7 @@ public:
   uint64_t retryCount() const { return retry_count_; }
   Random::RandomGenerator& random() const { return random_; }
   uint64_t maxPendingLookups() const { return max_pending_lookups_; }
+  const DnsFilterResolverCacheConfig& cacheConfig() const { return cache_config_; }
   const envoy::config::core::v3::TypedExtensionConfig& typedDnsResolverConfig() const {
     return typed_dns_resolver_config_;
   }
@@ -130,6 +134,7 @@ private:
   std::chrono::milliseconds resolver_timeout_;
   Random::RandomGenerator& random_;
   uint64_t max_pending_lookups_;
+  DnsFilterResolverCacheConfig cache_config_;
   envoy::config::core::v3::TypedExtensionConfig typed_dns_resolver_config_;
   Network::DnsResolverFactory* dns_resolver_factory_;
 };
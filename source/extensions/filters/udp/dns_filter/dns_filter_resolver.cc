@@ -2,6 +2,8 @@
 
 #include "source/common/network/utility.h"
 
+#include "absl/strings/ascii.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace UdpFilters {
@@ -38,6 +40,25 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
 
   const DnsQueryRecord* id = domain_query;
 
+  absl::optional<AnswerKey> key;
+  if (cacheEnabled()) {
+    key = answerKey(*domain_query);
+    if (resolveFromCache(ctx.query_context, domain_query, key.value())) {
+      return;
+    }
+
+    // If an identical query is being resolved, wait for its answer.
+    auto pending_lookup = pending_lookup_keys_.find(key.value());
+    if (pending_lookup != pending_lookup_keys_.end()) {
+      auto lookup = lookups_.find(pending_lookup->second);
+      ASSERT(lookup != lookups_.end());
+      ENVOY_LOG(trace, "Coalescing query for [{}] with a pending lookup", domain_query->name_);
+      counters_.coalesced_queries.inc();
+      lookup->second.coalesced_queries.push_back({domain_query, std::move(ctx.query_context)});
+      return;
+    }
+  }
+
   // If we have too many pending lookups, invoke the callback to retry the query.
   if (lookups_.size() > max_pending_lookups_) {
     ENVOY_LOG(
@@ -53,6 +74,9 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
   ctx.timeout_timer->enableTimer(timeout_);
 
   lookups_.emplace(id, std::move(ctx));
+  if (key.has_value()) {
+    pending_lookup_keys_.emplace(std::move(key.value()), id);
+  }
 
   ENVOY_LOG(trace, "Pending queries: {}", lookups_.size());
 
@@ -97,9 +121,12 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
                                      ctx.query_rec->name_);
                            ctx.resolved_hosts.emplace_back(std::move(addrinfo.address_));
                          }
+                         if (cacheEnabled()) {
+                           cacheAnswer(answerKey(*ctx.query_rec), response, ctx.resolved_hosts);
+                         }
                        }
                        // Invoke the filter callback notifying it of resolved addresses
-                       invokeCallback(ctx);
+                       completeLookup(ctx);
                      });
 }
 
@@ -118,10 +145,87 @@ void DnsFilterResolver::onResolveTimeout() {
       ctx.query_context->resolution_status_ = Network::DnsResolver::ResolutionStatus::Failure;
 
       lookups_.erase(ctx_iter.first);
-      callback_(std::move(ctx.query_context), ctx.query_rec, ctx.resolved_hosts);
+      completeLookup(ctx);
+      return;
+    }
+  }
+}
+
+DnsFilterResolver::AnswerKey DnsFilterResolver::answerKey(const DnsQueryRecord& query) {
+  return {absl::AsciiStrToLower(query.name_), query.type_};
+}
+
+bool DnsFilterResolver::resolveFromCache(DnsQueryContextPtr& context,
+                                         const DnsQueryRecord* domain_query,
+                                         const AnswerKey& key) {
+  auto cached = answer_cache_.find(key);
+  if (cached == answer_cache_.end()) {
+    return false;
+  }
+  if (cached->second.expiry <= dispatcher_.timeSource().monotonicTime()) {
+    answer_cache_.erase(cached);
+    return false;
+  }
+
+  ENVOY_LOG(trace, "Answering query for [{}] from the cache. Entries {}", domain_query->name_,
+            cached->second.resolved_hosts.size());
+  if (cached->second.resolved_hosts.empty()) {
+    counters_.cache_negative_hits.inc();
+  } else {
+    counters_.cache_hits.inc();
+  }
+
+  context->resolution_status_ = Network::DnsResolver::ResolutionStatus::Success;
+  AddressConstPtrVec resolved_hosts = cached->second.resolved_hosts;
+  callback_(std::move(context), domain_query, resolved_hosts);
+  return true;
+}
+
+void DnsFilterResolver::cacheAnswer(const AnswerKey& key,
+                                    const std::list<Network::DnsResponse>& response,
+                                    const AddressConstPtrVec& resolved_hosts) {
+  std::chrono::seconds ttl =
+      resolved_hosts.empty() ? cache_config_.negative_ttl : cache_config_.max_ttl;
+  for (const auto& resp : response) {
+    ttl = std::min(ttl, resp.addrInfo().ttl_);
+  }
+  if (ttl.count() <= 0) {
+    return;
+  }
+
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (answer_cache_.size() >= cache_config_.max_entries && !answer_cache_.contains(key)) {
+    // Make room by dropping the expired answers. The answer isn't cached if there is still none.
+    absl::erase_if(answer_cache_, [now](const auto& entry) { return entry.second.expiry <= now; });
+    if (answer_cache_.size() >= cache_config_.max_entries) {
       return;
     }
   }
+  answer_cache_.insert_or_assign(key, CachedAnswer{resolved_hosts, now + ttl});
+}
+
+void DnsFilterResolver::completeLookup(LookupContext& context) {
+  if (cacheEnabled()) {
+    auto pending_lookup = pending_lookup_keys_.find(answerKey(*context.query_rec));
+    if (pending_lookup != pending_lookup_keys_.end() &&
+        pending_lookup->second == context.query_rec) {
+      pending_lookup_keys_.erase(pending_lookup);
+    }
+  }
+
+  // The coalesced queries share the outcome of the lookup, retries included.
+  const Network::DnsResolver::ResolutionStatus status = context.query_context->resolution_status_;
+  const bool in_callback = context.query_context->in_callback_;
+  std::vector<CoalescedQuery> coalesced_queries = std::move(context.coalesced_queries);
+
+  callback_(std::move(context.query_context), context.query_rec, context.resolved_hosts);
+
+  for (CoalescedQuery& coalesced : coalesced_queries) {
+    coalesced.query_context->resolution_status_ = status;
+    coalesced.query_context->in_callback_ = in_callback;
+    AddressConstPtrVec resolved_hosts = context.resolved_hosts;
+    callback_(std::move(coalesced.query_context), coalesced.query_rec, resolved_hosts);
+  }
 }
 } // namespace DnsFilter
 } // namespace UdpFilters
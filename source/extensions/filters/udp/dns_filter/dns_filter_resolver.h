@@ -6,6 +6,8 @@
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 #include "source/extensions/filters/udp/dns_filter/dns_parser.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace UdpFilters {
@@ -13,6 +15,31 @@ namespace DnsFilter {
 
 enum class DnsFilterResolverStatus { Pending, Complete, TimedOut };
 
+/**
+ * Settings of the answer cache of the resolver. The answers aren't cached, nor are the identical
+ * queries coalesced, if max_entries is zero.
+ */
+struct DnsFilterResolverCacheConfig {
+  uint64_t max_entries{};
+  std::chrono::seconds max_ttl{};
+  std::chrono::seconds negative_ttl{};
+};
+
+/**
+ * @brief This struct is used to hold pointers to the counters that are relevant to the
+ * resolver. This is done to prevent dependency loops between the resolver and filter headers
+ */
+struct DnsFilterResolverCounters {
+  Stats::Counter& cache_hits;
+  Stats::Counter& cache_negative_hits;
+  Stats::Counter& coalesced_queries;
+
+  DnsFilterResolverCounters(Stats::Counter& cache_hits, Stats::Counter& cache_negative_hits,
+                            Stats::Counter& coalesced_queries)
+      : cache_hits(cache_hits), cache_negative_hits(cache_negative_hits),
+        coalesced_queries(coalesced_queries) {}
+};
+
 /*
  * This class encapsulates the logic of handling an asynchronous DNS request for the DNS filter.
  * External request timeouts are handled here.
@@ -22,11 +49,14 @@ public:
   DnsFilterResolver(DnsFilterResolverCallback& callback, std::chrono::milliseconds timeout,
                     Event::Dispatcher& dispatcher, uint64_t max_pending_lookups,
                     const envoy::config::core::v3::TypedExtensionConfig& typed_dns_resolver_config,
-                    const Network::DnsResolverFactory& dns_resolver_factory, Api::Api& api)
+                    const Network::DnsResolverFactory& dns_resolver_factory, Api::Api& api,
+                    const DnsFilterResolverCacheConfig& cache_config,
+                    const DnsFilterResolverCounters& counters)
       : timeout_(timeout), dispatcher_(dispatcher),
         resolver_(
             dns_resolver_factory.createDnsResolver(dispatcher, api, typed_dns_resolver_config)),
-        callback_(callback), max_pending_lookups_(max_pending_lookups) {}
+        callback_(callback), max_pending_lookups_(max_pending_lookups),
+        cache_config_(cache_config), counters_(counters) {}
   /**
    * @brief entry point to resolve the name in a DnsQueryRecord
    *
@@ -39,6 +69,19 @@ public:
   void resolveExternalQuery(DnsQueryContextPtr context, const DnsQueryRecord* domain_query);
 
 private:
+  // The lower case name and the type of a query.
+  using AnswerKey = std::pair<std::string, uint16_t>;
+
+  struct CachedAnswer {
+    AddressConstPtrVec resolved_hosts;
+    MonotonicTime expiry;
+  };
+
+  struct CoalescedQuery {
+    const DnsQueryRecord* query_rec;
+    DnsQueryContextPtr query_context;
+  };
+
   struct LookupContext {
     const DnsQueryRecord* query_rec;
     DnsQueryContextPtr query_context;
@@ -46,6 +89,8 @@ private:
     AddressConstPtrVec resolved_hosts;
     DnsFilterResolverStatus resolver_status;
     Event::TimerPtr timeout_timer;
+    // The identical queries waiting for the answer of this lookup.
+    std::vector<CoalescedQuery> coalesced_queries;
   };
   /**
    * @brief invokes the DNS Filter callback only if our state indicates we have not timed out
@@ -64,12 +109,42 @@ private:
    */
   void onResolveTimeout();
 
+  bool cacheEnabled() const { return cache_config_.max_entries > 0; }
+
+  static AnswerKey answerKey(const DnsQueryRecord& query);
+
+  /**
+   * @brief Invokes the DNS Filter callback with the cached answer to the query, if there is one
+   *
+   * @return bool true if the query was answered from the cache
+   */
+  bool resolveFromCache(DnsQueryContextPtr& context, const DnsQueryRecord* domain_query,
+                        const AnswerKey& key);
+
+  /**
+   * @brief Caches the addresses resolved for the query, for the lowest TTL of the records, or for
+   * the negative TTL if there is no record
+   */
+  void cacheAnswer(const AnswerKey& key, const std::list<Network::DnsResponse>& response,
+                   const AddressConstPtrVec& resolved_hosts);
+
+  /**
+   * @brief Invokes the DNS Filter callback for the lookup's query and for the identical queries
+   * coalesced into the lookup, which was removed from the pending lookups
+   */
+  void completeLookup(LookupContext& context);
+
   std::chrono::milliseconds timeout_;
   Event::Dispatcher& dispatcher_;
   const Network::DnsResolverSharedPtr resolver_;
   DnsFilterResolverCallback& callback_;
   absl::flat_hash_map<const DnsQueryRecord*, LookupContext> lookups_;
   uint64_t max_pending_lookups_;
+  const DnsFilterResolverCacheConfig cache_config_;
+  DnsFilterResolverCounters counters_;
+  absl::flat_hash_map<AnswerKey, CachedAnswer> answer_cache_;
+  // The pending lookups by the name and type of their query, to coalesce the identical queries.
+  absl::flat_hash_map<AnswerKey, const DnsQueryRecord*> pending_lookup_keys_;
 };
 
 using DnsFilterResolverPtr = std::unique_ptr<DnsFilterResolver>;
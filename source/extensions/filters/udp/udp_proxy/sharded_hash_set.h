@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "source/common/common/assert.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace UdpFilters {
+namespace UdpProxy {
+
+/**
+ * A hash set split into shards selected by the high bits of the hashes of the elements, so that
+ * each shard grows on its own: the rehash of a shard only moves a fraction of the elements, which
+ * bounds the latency added to the insertions triggering it even when there are millions of
+ * elements. The lookups cost an additional hash computation.
+ */
+template <class Value, class Hash, class Eq, size_t Shards = 64> class ShardedHashSet {
+public:
+  static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0, "Shards must be a power of 2");
+
+  using Set = absl::flat_hash_set<Value, Hash, Eq>;
+
+  ShardedHashSet(const Hash& hash, const Eq& eq) : hash_(hash) {
+    shards_.reserve(Shards);
+    for (size_t i = 0; i < Shards; i++) {
+      shards_.emplace_back(0, hash, eq);
+    }
+  }
+
+  /**
+   * @return the element equal to the key, or nullptr if there is none.
+   */
+  template <class Key> const Value* find(const Key& key) const {
+    const Set& shard = shardFor(key);
+    const auto it = shard.find(key);
+    return it == shard.end() ? nullptr : &*it;
+  }
+
+  template <class Key> size_t count(const Key& key) const { return shardFor(key).count(key); }
+
+  /**
+   * Inserts an element if there is no element equal to it.
+   * @return whether the element was inserted.
+   */
+  template <class V> bool emplace(V&& value) {
+    const bool inserted = shardFor(value).emplace(std::forward<V>(value)).second;
+    size_ += inserted ? 1 : 0;
+    return inserted;
+  }
+
+  /**
+   * @return the number of elements erased.
+   */
+  template <class Key> size_t erase(const Key& key) {
+    const size_t erased = shardFor(key).erase(key);
+    size_ -= erased;
+    return erased;
+  }
+
+  /**
+   * @return an element of the set, which must not be empty.
+   */
+  const Value& any() const {
+    ASSERT(!empty());
+    for (const Set& shard : shards_) {
+      if (!shard.empty()) {
+        return *shard.begin();
+      }
+    }
+    PANIC("not reached");
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+private:
+  // The top bits, as the shards use the bottom ones to select the slots of the elements.
+  static constexpr size_t ShardShift = sizeof(size_t) * 8 - absl::bit_width(Shards - 1);
+
+  template <class Key> Set& shardFor(const Key& key) {
+    return shards_[shardIndex(hash_(key))];
+  }
+  template <class Key> const Set& shardFor(const Key& key) const {
+    return shards_[shardIndex(hash_(key))];
+  }
+  static size_t shardIndex(size_t hash) { return Shards == 1 ? 0 : hash >> ShardShift; }
+
+  const Hash hash_;
+  std::vector<Set> shards_;
+  size_t size_{0};
+};
+
+} // namespace UdpProxy
+} // namespace UdpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -9,9 +9,18 @@ namespace Extensions {
 namespace UdpFilters {
 namespace UdpProxy {
 
+namespace {
+
+// The idle sessions are expired by batches, at most this many times per session timeout, so that
+// the idle timer doesn't fire for each session when there are many of them.
+constexpr uint32_t IdleTimerFiresPerSessionTimeout = 16;
+
+} // namespace
+
 UdpProxyFilter::UdpProxyFilter(Network::UdpReadFilterCallbacks& callbacks,
                                const UdpProxyFilterConfigSharedPtr& config)
     : UdpListenerReadFilter(callbacks), config_(config),
+      idle_timer_(callbacks.udpListener().dispatcher().createTimer([this] { onIdleTimer(); })),
       cluster_update_callbacks_(
           config->clusterManager().addThreadLocalClusterUpdateCallbacks(*this)) {
   for (const auto& entry : config_->allClusterNames()) {
@@ -101,7 +110,7 @@ UdpProxyFilter::ClusterInfo::~ClusterInfo() {
   // Sanity check the session accounting. This is not as fast as a straight teardown, but this is
   // not a performance critical path.
   while (!sessions_.empty()) {
-    removeSession(sessions_.begin()->get());
+    removeSession(sessions_.any().get());
   }
   ASSERT(host_to_sessions_.empty());
 }
@@ -166,19 +175,19 @@ Upstream::HostConstSharedPtr UdpProxyFilter::ClusterInfo::chooseHost(
 UdpProxyFilter::StickySessionClusterInfo::StickySessionClusterInfo(
     UdpProxyFilter& filter, Upstream::ThreadLocalCluster& cluster)
     : ClusterInfo(filter, cluster,
-                  SessionStorageType(1, HeterogeneousActiveSessionHash(false),
+                  SessionStorageType(HeterogeneousActiveSessionHash(false),
                                      HeterogeneousActiveSessionEqual(false))) {}
 
 Network::FilterStatus UdpProxyFilter::StickySessionClusterInfo::onData(Network::UdpRecvData& data) {
-  const auto active_session_it = sessions_.find(data.addresses_);
+  const ActiveSessionPtr* existing_session = sessions_.find(data.addresses_);
   ActiveSession* active_session;
-  if (active_session_it == sessions_.end()) {
+  if (existing_session == nullptr) {
     active_session = createSession(std::move(data.addresses_));
     if (active_session == nullptr) {
       return Network::FilterStatus::StopIteration;
     }
   } else {
-    active_session = active_session_it->get();
+    active_session = existing_session->get();
     if (active_session->host().coarseHealth() == Upstream::Host::Health::Unhealthy) {
       // If a host becomes unhealthy, we optimally would like to replace it with a new session
       // to a healthy host. We may eventually want to make this behavior configurable, but for now
@@ -204,7 +213,7 @@ Network::FilterStatus UdpProxyFilter::StickySessionClusterInfo::onData(Network::
 UdpProxyFilter::PerPacketLoadBalancingClusterInfo::PerPacketLoadBalancingClusterInfo(
     UdpProxyFilter& filter, Upstream::ThreadLocalCluster& cluster)
     : ClusterInfo(filter, cluster,
-                  SessionStorageType(1, HeterogeneousActiveSessionHash(true),
+                  SessionStorageType(HeterogeneousActiveSessionHash(true),
                                      HeterogeneousActiveSessionEqual(true))) {}
 
 Network::FilterStatus
@@ -219,15 +228,15 @@ UdpProxyFilter::PerPacketLoadBalancingClusterInfo::onData(Network::UdpRecvData&
   ENVOY_LOG(debug, "selected {} host as upstream.", host->address()->asStringView());
 
   LocalPeerHostAddresses key{data.addresses_, *host};
-  const auto active_session_it = sessions_.find(key);
+  const ActiveSessionPtr* existing_session = sessions_.find(key);
   ActiveSession* active_session;
-  if (active_session_it == sessions_.end()) {
+  if (existing_session == nullptr) {
     active_session = createSession(std::move(data.addresses_), host);
     if (active_session == nullptr) {
       return Network::FilterStatus::StopIteration;
     }
   } else {
-    active_session = active_session_it->get();
+    active_session = existing_session->get();
     ENVOY_LOG(trace, "found already existing session on host {}.",
               active_session->host().address()->asStringView());
   }
@@ -242,8 +251,10 @@ UdpProxyFilter::ActiveSession::ActiveSession(ClusterInfo& cluster,
                                              const Upstream::HostConstSharedPtr& host)
     : cluster_(cluster), use_original_src_ip_(cluster_.filter_.config_->usingOriginalSrcIp()),
       addresses_(std::move(addresses)), host_(host),
-      idle_timer_(cluster.filter_.read_callbacks_->udpListener().dispatcher().createTimer(
-          [this] { onIdleTimer(); })),
+      last_activity_(
+          cluster.filter_.read_callbacks_->udpListener().dispatcher().approximateMonotonicTime()),
+      idle_sessions_it_(
+          cluster.filter_.idle_sessions_.insert(cluster.filter_.idle_sessions_.end(), this)),
       // NOTE: The socket call can only fail due to memory/fd exhaustion. No local ephemeral port
       //       is bound until the first packet is sent to the upstream host.
       socket_(cluster.filter_.createSocket(host)) {
@@ -256,9 +267,20 @@ UdpProxyFilter::ActiveSession::ActiveSession(ClusterInfo& cluster,
       cluster.filter_.read_callbacks_->udpListener().dispatcher(),
       [this](uint32_t) { onReadReady(); }, Event::PlatformDefaultTriggerType,
       Event::FileReadyType::Read);
+  const uint32_t max_batched_datagrams = cluster_.filter_.config_->maxBatchedUpstreamDatagrams();
+  if (max_batched_datagrams > 0 && socket_->ioHandle().supportsMmsg()) {
+    upstream_batch_ =
+        std::make_unique<Network::UdpDatagramBatch>(socket_->ioHandle(), max_batched_datagrams);
+    upstream_flush_cb_ =
+        cluster.filter_.read_callbacks_->udpListener().dispatcher().createSchedulableCallback(
+            [this]() { flushUpstream(); });
+  }
   ENVOY_LOG(debug, "creating new session: downstream={} local={} upstream={}",
             addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host->address()->asStringView());
+  if (!cluster_.filter_.idle_timer_->enabled()) {
+    cluster_.filter_.idle_timer_->enableTimer(cluster_.filter_.config_->sessionTimeout());
+  }
   cluster_.filter_.config_->stats().downstream_sess_total_.inc();
   cluster_.filter_.config_->stats().downstream_sess_active_.inc();
   cluster_.cluster_.info()
@@ -285,6 +307,10 @@ UdpProxyFilter::ActiveSession::ActiveSession(ClusterInfo& cluster,
 }
 
 UdpProxyFilter::ActiveSession::~ActiveSession() {
+  if (upstream_batch_ != nullptr && !upstream_batch_->empty()) {
+    flushUpstream();
+  }
+  cluster_.filter_.idle_sessions_.erase(idle_sessions_it_);
   ENVOY_LOG(debug, "deleting the session: downstream={} local={} upstream={}",
             addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host_->address()->asStringView());
@@ -341,15 +367,36 @@ void UdpProxyFilter::fillProxyStreamInfo() {
   udp_proxy_stats_.value().setDynamicMetadata("udp.proxy.proxy", stats_obj);
 }
 
-void UdpProxyFilter::ActiveSession::onIdleTimer() {
+void UdpProxyFilter::onIdleTimer() {
+  const MonotonicTime now = read_callbacks_->udpListener().dispatcher().approximateMonotonicTime();
+  const std::chrono::milliseconds timeout = config_->sessionTimeout();
+  while (!idle_sessions_.empty() && idle_sessions_.front()->lastActivity() + timeout <= now) {
+    // Destroys the session, which removes it from the idle sessions.
+    idle_sessions_.front()->onIdleTimeout();
+  }
+  if (!idle_sessions_.empty()) {
+    const auto delay = std::chrono::ceil<std::chrono::milliseconds>(
+        idle_sessions_.front()->lastActivity() + timeout - now);
+    idle_timer_->enableTimer(std::max(delay, timeout / IdleTimerFiresPerSessionTimeout));
+  }
+}
+
+void UdpProxyFilter::ActiveSession::onIdleTimeout() {
   ENVOY_LOG(debug, "session idle timeout: downstream={} local={}", addresses_.peer_->asStringView(),
             addresses_.local_->asStringView());
   cluster_.filter_.config_->stats().idle_timeout_.inc();
   cluster_.removeSession(this);
 }
 
+void UdpProxyFilter::ActiveSession::onActivity() {
+  last_activity_ =
+      cluster_.filter_.read_callbacks_->udpListener().dispatcher().approximateMonotonicTime();
+  std::list<ActiveSession*>& idle_sessions = cluster_.filter_.idle_sessions_;
+  idle_sessions.splice(idle_sessions.end(), idle_sessions, idle_sessions_it_);
+}
+
 void UdpProxyFilter::ActiveSession::onReadReady() {
-  idle_timer_->enableTimer(cluster_.filter_.config_->sessionTimeout());
+  onActivity();
 
   // TODO(mattklein123): We should not be passing *addresses_.local_ to this function as we are
   //                     not trying to populate the local address for received packets.
@@ -378,7 +425,7 @@ void UdpProxyFilter::ActiveSession::write(const Buffer::Instance& buffer) {
   cluster_.filter_.config_->stats().downstream_sess_rx_datagrams_.inc();
   ++session_stats_.downstream_sess_rx_datagrams_;
 
-  idle_timer_->enableTimer(cluster_.filter_.config_->sessionTimeout());
+  onActivity();
 
   // NOTE: On the first write, a local ephemeral port is bound, and thus this write can fail due to
   //       port exhaustion. To avoid exhaustion, UDP sockets will be connected and associated with
@@ -401,8 +448,21 @@ void UdpProxyFilter::ActiveSession::write(const Buffer::Instance& buffer) {
 
     skip_connect_ = true;
   }
+  if (upstream_batch_ != nullptr) {
+    if (!upstream_batch_->add(buffer, local_ip, *host_->address())) {
+      cluster_.cluster_stats_.sess_tx_errors_.inc();
+      return;
+    }
+    if (upstream_batch_->full()) {
+      flushUpstream();
+    } else if (!upstream_flush_cb_->enabled()) {
+      upstream_flush_cb_->scheduleCallbackCurrentIteration();
+    }
+    return;
+  }
   Api::IoCallUint64Result rc =
       Network::Utility::writeToSocket(socket_->ioHandle(), buffer, local_ip, *host_->address());
+  cluster_.cluster_stats_.sess_tx_syscalls_.inc();
   if (!rc.ok()) {
     cluster_.cluster_stats_.sess_tx_errors_.inc();
   } else {
@@ -411,6 +471,18 @@ void UdpProxyFilter::ActiveSession::write(const Buffer::Instance& buffer) {
   }
 }
 
+void UdpProxyFilter::ActiveSession::flushUpstream() {
+  upstream_flush_cb_->cancel();
+  const size_t size = upstream_batch_->size();
+  const Network::UdpDatagramBatch::FlushResult result = upstream_batch_->flush(nullptr);
+  ENVOY_LOG(trace, "flushed {} datagrams upstream with {} syscalls: upstream={}", size,
+            result.syscalls_, host_->address()->asStringView());
+  cluster_.cluster_stats_.sess_tx_syscalls_.add(result.syscalls_);
+  cluster_.cluster_stats_.sess_tx_datagrams_.add(result.datagrams_sent_);
+  cluster_.cluster_stats_.sess_tx_errors_.add(size - result.datagrams_sent_);
+  cluster_.cluster_.info()->trafficStats()->upstream_cx_tx_bytes_total_.add(result.bytes_sent_);
+}
+
 void UdpProxyFilter::ActiveSession::processPacket(Network::Address::InstanceConstSharedPtr,
                                                   Network::Address::InstanceConstSharedPtr,
                                                   Buffer::InstancePtr buffer, MonotonicTime) {
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <list>
+
 #include "envoy/access_log/access_log.h"
 #include "envoy/config/accesslog/v3/accesslog.pb.h"
 #include "envoy/event/file_event.h"
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/network/filter.h"
@@ -15,12 +18,14 @@
 #include "source/common/common/random_generator.h"
 #include "source/common/network/socket_impl.h"
 #include "source/common/network/socket_interface.h"
+#include "source/common/network/udp_packet_writer_handler_impl.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
 #include "source/common/upstream/load_balancer_impl.h"
 #include "source/extensions/filters/udp/udp_proxy/hash_policy_impl.h"
 #include "source/extensions/filters/udp/udp_proxy/router/router_impl.h"
+#include "source/extensions/filters/udp/udp_proxy/sharded_hash_set.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -60,7 +65,8 @@ struct UdpProxyDownstreamStats {
   COUNTER(sess_rx_datagrams_dropped)                                                               \
   COUNTER(sess_rx_errors)                                                                          \
   COUNTER(sess_tx_datagrams)                                                                       \
-  COUNTER(sess_tx_errors)
+  COUNTER(sess_tx_errors)                                                                          \
+  COUNTER(sess_tx_syscalls)
 
 /**
  * Struct definition for all UDP proxy upstream stats. @see stats_macros.h
@@ -78,6 +84,8 @@ public:
         session_timeout_(PROTOBUF_GET_MS_OR_DEFAULT(config, idle_timeout, 60 * 1000)),
         use_original_src_ip_(config.use_original_src_ip()),
         use_per_packet_load_balancing_(config.use_per_packet_load_balancing()),
+        max_batched_upstream_datagrams_(
+            PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_batched_upstream_datagrams, 0)),
         stats_(generateStats(config.stat_prefix(), context.scope())),
         // Default prefer_gro to true for upstream client traffic.
         upstream_socket_config_(config.upstream_socket_config(), true),
@@ -113,6 +121,8 @@ public:
   std::chrono::milliseconds sessionTimeout() const { return session_timeout_; }
   bool usingOriginalSrcIp() const { return use_original_src_ip_; }
   bool usingPerPacketLoadBalancing() const { return use_per_packet_load_balancing_; }
+  // 0 if the datagrams sent upstream aren't batched.
+  uint32_t maxBatchedUpstreamDatagrams() const { return max_batched_upstream_datagrams_; }
   const Udp::HashPolicy* hashPolicy() const { return hash_policy_.get(); }
   UdpProxyDownstreamStats& stats() const { return stats_; }
   TimeSource& timeSource() const { return time_source_; }
@@ -141,6 +151,7 @@ private:
   const std::chrono::milliseconds session_timeout_;
   const bool use_original_src_ip_;
   const bool use_per_packet_load_balancing_;
+  const uint32_t max_batched_upstream_datagrams_;
   std::unique_ptr<const HashPolicyImpl> hash_policy_;
   mutable UdpProxyDownstreamStats stats_;
   const Network::ResolvedUdpSocketConfig upstream_socket_config_;
@@ -200,10 +211,14 @@ private:
     const Network::UdpRecvData::LocalPeerAddresses& addresses() const { return addresses_; }
     const Upstream::Host& host() const { return *host_; }
     void write(const Buffer::Instance& buffer);
+    MonotonicTime lastActivity() const { return last_activity_; }
+    void onIdleTimeout();
 
   private:
-    void onIdleTimer();
+    // Moves the session to the back of the idle sessions of the filter.
+    void onActivity();
     void onReadReady();
+    void flushUpstream();
     void fillSessionStreamInfo();
 
     // Network::UdpPacketProcessor
@@ -237,12 +252,10 @@ private:
     const bool use_original_src_ip_;
     const Network::UdpRecvData::LocalPeerAddresses addresses_;
     const Upstream::HostConstSharedPtr host_;
-    // TODO(mattklein123): Consider replacing an idle timer for each session with a last used
-    // time stamp and a periodic scan of all sessions to look for timeouts. This solution is simple,
-    // though it might not perform well for high volume traffic. Note that this is how TCP proxy
-    // idle timeouts work so we should consider unifying the implementation if we move to a time
-    // stamp and scan approach.
-    const Event::TimerPtr idle_timer_;
+    // The sessions are expired by the idle timer of the filter, rather than a timer each, which
+    // is too expensive with millions of short lived sessions.
+    MonotonicTime last_activity_;
+    std::list<ActiveSession*>::iterator idle_sessions_it_;
     // The socket is used for writing packets to the selected upstream host as well as receiving
     // packets from the upstream host. Note that a a local ephemeral port is bound on the first
     // write to the upstream host.
@@ -251,6 +264,10 @@ private:
     // envoy.reloadable_features.udp_proxy_connect is unset or use_original_src_ip_ is set. If it
     // is true, there will be no calling `connect()` on the socket.
     bool skip_connect_{};
+    // The datagrams sent upstream during the current event loop iteration, only set when they are
+    // batched.
+    std::unique_ptr<Network::UdpDatagramBatch> upstream_batch_;
+    Event::SchedulableCallbackPtr upstream_flush_cb_;
 
     UdpProxySessionStats session_stats_{};
     absl::optional<StreamInfo::StreamInfoImpl> udp_session_stats_;
@@ -327,8 +344,9 @@ private:
    */
   class ClusterInfo {
   protected:
-    using SessionStorageType = absl::flat_hash_set<ActiveSessionPtr, HeterogeneousActiveSessionHash,
-                                                   HeterogeneousActiveSessionEqual>;
+    // Sharded so that adding sessions never rehashes all of them at once.
+    using SessionStorageType = ShardedHashSet<ActiveSessionPtr, HeterogeneousActiveSessionHash,
+                                              HeterogeneousActiveSessionEqual>;
 
   public:
     ClusterInfo(UdpProxyFilter& filter, Upstream::ThreadLocalCluster& cluster,
@@ -392,12 +410,18 @@ private:
   }
 
   void fillProxyStreamInfo();
+  void onIdleTimer();
 
   // Upstream::ClusterUpdateCallbacks
   void onClusterAddOrUpdate(Upstream::ThreadLocalCluster& cluster) final;
   void onClusterRemoval(const std::string& cluster_name) override;
 
   const UdpProxyFilterConfigSharedPtr config_;
+  // The sessions of all the clusters ordered by the time they were last active, the least recently
+  // active first, and the timer expiring them. The sessions remove themselves when destroyed, so
+  // that these must outlive the clusters.
+  std::list<ActiveSession*> idle_sessions_;
+  const Event::TimerPtr idle_timer_;
   const Upstream::ClusterUpdateCallbacksHandlePtr cluster_update_callbacks_;
   // Map for looking up cluster info with its name.
   absl::flat_hash_map<std::string, ClusterInfoPtr> cluster_infos_;
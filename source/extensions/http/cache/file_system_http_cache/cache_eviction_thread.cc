@@ -1,5 +1,8 @@
 #include "source/extensions/http/cache/file_system_http_cache/cache_eviction_thread.h"
 
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
 #include <limits>
 
 #include "envoy/thread/thread.h"
@@ -18,6 +21,14 @@ namespace {
 bool isCacheFile(const Filesystem::DirectoryEntry& entry) {
   return entry.type_ == Filesystem::FileType::Regular && absl::StartsWith(entry.name_, "cache-");
 }
+
+Envoy::SystemTime lastTouch(const struct stat& s) {
+#ifdef _DARWIN_FEATURE_64_BIT_INODE
+  return std::max(timespecToChrono(s.st_atimespec), timespecToChrono(s.st_ctimespec));
+#else
+  return std::max(timespecToChrono(s.st_atim), timespecToChrono(s.st_ctim));
+#endif
+}
 } // namespace
 
 CacheEvictionThread::CacheEvictionThread(Thread::ThreadFactory& thread_factory)
@@ -75,86 +86,95 @@ void CacheShared::initStats() {
   if (config_.has_max_cache_entry_count()) {
     stats_.size_limit_count_.set(config_.max_cache_entry_count().value());
   }
-  // TODO(ravenblack): Add support for directory tree structure.
-  for (const Filesystem::DirectoryEntry& entry : Filesystem::Directory(std::string{cachePath()})) {
-    if (!isCacheFile(entry)) {
-      continue;
+  if (!loadIndexCheckpoint()) {
+    auto os_sys_calls = Api::OsSysCallsSingleton::get();
+    // TODO(ravenblack): Add support for directory tree structure.
+    for (const Filesystem::DirectoryEntry& entry :
+         Filesystem::Directory(std::string{cachePath()})) {
+      if (!isCacheFile(entry)) {
+        continue;
+      }
+      struct stat s;
+      if (os_sys_calls.stat(absl::StrCat(cachePath(), entry.name_).c_str(), &s).return_value_ !=
+          -1) {
+        index_.add(entry.name_, entry.size_bytes_.value_or(0), lastTouch(s));
+      }
     }
-    size_count_++;
-    size_bytes_ += entry.size_bytes_.value_or(0);
   }
-  stats_.size_count_.set(size_count_);
-  stats_.size_bytes_.set(size_bytes_);
+  updateSizeStats();
   needs_init_ = false;
 }
 
-void CacheShared::evict() {
-  stats_.eviction_runs_.add(1);
-  auto os_sys_calls = Api::OsSysCallsSingleton::get();
-  uint64_t size = 0;
-  uint64_t count = 0;
-  struct CacheFile {
-    std::string name_;
-    uint64_t size_;
-    Envoy::SystemTime last_touch_;
-  };
-  std::vector<CacheFile> cache_files;
-
-  // TODO(ravenblack): Add support for directory tree structure.
-  for (const Filesystem::DirectoryEntry& entry : Filesystem::Directory(std::string{cachePath()})) {
-    if (!isCacheFile(entry)) {
-      continue;
+bool CacheShared::loadIndexCheckpoint() {
+  const std::string path = indexCheckpointPath();
+  EvictionIndexCheckpoint checkpoint;
+  bool parsed;
+  {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      return false;
     }
-    count++;
-    size += entry.size_bytes_.value_or(0);
-    struct stat s;
-    if (os_sys_calls.stat(absl::StrCat(cachePath(), entry.name_).c_str(), &s).return_value_ != -1) {
-#ifdef _DARWIN_FEATURE_64_BIT_INODE
-      Envoy::SystemTime last_touch =
-          std::max(timespecToChrono(s.st_atimespec), timespecToChrono(s.st_ctimespec));
-#else
-      Envoy::SystemTime last_touch =
-          std::max(timespecToChrono(s.st_atim), timespecToChrono(s.st_ctim));
-#endif
+    parsed = checkpoint.ParseFromIstream(&file);
+  }
+  // The checkpoint is rewritten by this instance, so a restart that doesn't find one knows
+  // the index may be missing entries added since, and rescans.
+  Api::OsSysCallsSingleton::get().unlink(path.c_str());
+  if (!parsed) {
+    ENVOY_LOG(warn, "ignoring unreadable cache eviction index checkpoint {}", path);
+    return false;
+  }
+  index_.loadCheckpoint(checkpoint);
+  return true;
+}
 
-      cache_files.push_back(CacheFile{entry.name_, entry.size_bytes_.value_or(0), last_touch});
-    }
+void CacheShared::maybeCheckpointIndex(bool force) {
+  absl::MutexLock lock(&checkpoint_mu_);
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (!index_.dirty() || (!force && now - last_checkpoint_ < index_checkpoint_interval_)) {
+    return;
+  }
+  last_checkpoint_ = now;
+  const std::string path = indexCheckpointPath();
+  const std::string temp_path = absl::StrCat(path, ".tmp");
+  const EvictionIndexCheckpoint checkpoint = index_.toCheckpoint();
+  bool written;
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    written = file && checkpoint.SerializeToOstream(&file);
+    file.close();
+    written = written && !file.fail();
+  }
+  // The checkpoint is written to a temporary file and renamed, so that a restart never
+  // loads a partially written checkpoint.
+  if (!written || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    ENVOY_LOG(warn, "failed to write cache eviction index checkpoint {}", path);
+    index_.markDirty();
   }
-  // Sort the vector by last-touch timestamp, highest (i.e. youngest) first.
-  std::sort(cache_files.begin(), cache_files.end(), [](CacheFile& a, CacheFile& b) {
-    return std::tie(a.last_touch_, a.name_) > std::tie(b.last_touch_, b.name_);
-  });
-  size_bytes_ = size;
-  size_count_ = count;
-  uint64_t size_kept = 0;
-  uint64_t count_kept = 0;
+}
+
+void CacheShared::evict() {
+  stats_.eviction_runs_.add(1);
+  auto os_sys_calls = Api::OsSysCallsSingleton::get();
   uint64_t max_size = config_.has_max_cache_size_bytes() ? config_.max_cache_size_bytes().value()
                                                          : std::numeric_limits<uint64_t>::max();
   uint64_t max_count = config_.has_max_cache_entry_count() ? config_.max_cache_entry_count().value()
                                                            : std::numeric_limits<uint64_t>::max();
-  auto it = cache_files.begin();
-  // Keep the youngest files that won't exceed the limit.
-  while (it != cache_files.end() && size_kept + it->size_ <= max_size &&
-         count_kept + 1 <= max_count) {
-    size_kept += it->size_;
-    count_kept++;
-    ++it;
-  }
-  // Evict the rest.
-  while (it != cache_files.end()) {
-    if (os_sys_calls.unlink(absl::StrCat(cachePath(), it->name_).c_str()).return_value_ != -1) {
-      // May want to add logging here for cache eviction failure, but it's expected sometimes,
-      // e.g. if another instance of Envoy is performing cleanup at the same time, or some external
-      // operator deleted the file. If it fails we don't reduce the estimated cache size, so another
-      // eviction run will happen sooner.
-      // TODO(ravenblack): might be worth checking the type of the error, or whether the file is
-      // gone - if there's a permissions issue, for example, then the cache might remain oversized
-      // and the eviction thread will be churning, trying and failing to remove a file, which would
-      // be worth logging a warning, versus if the file is already gone then there's no problem.
-      trackFileRemoved(it->size_);
+  // The index hands out the oldest entries that don't fit within the limits.
+  for (const EvictionIndex::Entry& entry : index_.evictUntilWithin(max_size, max_count)) {
+    const Api::SysCallIntResult result =
+        os_sys_calls.unlink(absl::StrCat(cachePath(), entry.name_).c_str());
+    if (result.return_value_ == -1 && result.errno_ != ENOENT) {
+      // If the file is already gone, e.g. because another instance of Envoy is performing
+      // cleanup at the same time, or some external operator deleted the file, there's no
+      // problem. Otherwise we keep the entry indexed, so another eviction run will happen
+      // sooner.
+      // TODO(ravenblack): if there's a permissions issue, for example, then the cache might
+      // remain oversized and the eviction thread will be churning, trying and failing to remove
+      // a file, which would be worth logging a warning.
+      index_.add(entry.name_, entry.size_bytes_, entry.last_touch_);
     }
-    ++it;
   }
+  updateSizeStats();
 }
 
 void CacheEvictionThread::work() {
@@ -175,6 +195,7 @@ void CacheEvictionThread::work() {
       if (cache->needsEviction()) {
         cache->evict();
       }
+      cache->maybeCheckpointIndex(false);
     }
   }
   ENVOY_LOG(info, "Ending cache eviction thread.");
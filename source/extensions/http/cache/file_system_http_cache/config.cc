@@ -43,9 +43,9 @@ class CacheSingleton : public Envoy::Singleton::Instance {
 public:
   CacheSingleton(
       std::shared_ptr<Common::AsyncFiles::AsyncFileManagerFactory>&& async_file_manager_factory,
-      Thread::ThreadFactory& thread_factory)
+      Thread::ThreadFactory& thread_factory, TimeSource& time_source)
       : async_file_manager_factory_(async_file_manager_factory),
-        cache_eviction_thread_(thread_factory) {}
+        cache_eviction_thread_(thread_factory), time_source_(time_source) {}
 
   std::shared_ptr<FileSystemHttpCache> get(std::shared_ptr<CacheSingleton> singleton,
                                            const ConfigProto& non_normalized_config,
@@ -63,7 +63,8 @@ public:
           async_file_manager_factory_->getAsyncFileManager(config.manager_config());
       cache = std::make_shared<FileSystemHttpCache>(singleton, cache_eviction_thread_,
                                                     std::move(config),
-                                                    std::move(async_file_manager), stats_scope);
+                                                    std::move(async_file_manager), stats_scope,
+                                                    time_source_);
       caches_[key] = cache;
     } else if (!Protobuf::util::MessageDifferencer::Equals(cache->config(), config)) {
       throw EnvoyException(
@@ -76,6 +77,7 @@ public:
 private:
   std::shared_ptr<Common::AsyncFiles::AsyncFileManagerFactory> async_file_manager_factory_;
   CacheEvictionThread cache_eviction_thread_;
+  TimeSource& time_source_;
   absl::Mutex mu_;
   // We keep weak_ptr here so the caches can be destroyed if the config is updated to stop using
   // that config of cache. The caches each keep shared_ptrs to this singleton, which keeps the
@@ -104,7 +106,7 @@ public:
         SINGLETON_MANAGER_REGISTERED_NAME(file_system_http_cache_singleton), [&context] {
           return std::make_shared<CacheSingleton>(
               Common::AsyncFiles::AsyncFileManagerFactory::singleton(&context.singletonManager()),
-              context.api().threadFactory());
+              context.api().threadFactory(), context.api().timeSource());
         });
     return caches->get(caches, config, context.scope());
   }
@@ -0,0 +1,113 @@
+#include "source/extensions/http/cache/file_system_http_cache/eviction_index.h"
+
+#include <chrono>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace FileSystemHttpCache {
+
+void EvictionIndex::add(absl::string_view name, uint64_t size_bytes, SystemTime last_touch) {
+  absl::MutexLock lock(&mu_);
+  addLocked(name, size_bytes, last_touch);
+}
+
+bool EvictionIndex::touch(absl::string_view name, SystemTime last_touch) {
+  absl::MutexLock lock(&mu_);
+  auto it = entries_.find(name);
+  if (it == entries_.end()) {
+    return false;
+  }
+  if (it->second.position_->first < last_touch) {
+    auto node = order_.extract(it->second.position_);
+    node.value().first = last_touch;
+    it->second.position_ = order_.insert(std::move(node)).position;
+    dirty_ = true;
+  }
+  return true;
+}
+
+void EvictionIndex::remove(absl::string_view name) {
+  absl::MutexLock lock(&mu_);
+  auto it = entries_.find(name);
+  if (it != entries_.end()) {
+    eraseLocked(it);
+  }
+}
+
+std::vector<EvictionIndex::Entry> EvictionIndex::evictUntilWithin(uint64_t max_size_bytes,
+                                                                  uint64_t max_count) {
+  std::vector<Entry> evicted;
+  absl::MutexLock lock(&mu_);
+  while (!order_.empty() && (size_bytes_ > max_size_bytes || count_ > max_count)) {
+    auto it = entries_.find(order_.begin()->second);
+    ASSERT(it != entries_.end());
+    evicted.push_back(Entry{it->first, it->second.size_bytes_, it->second.position_->first});
+    eraseLocked(it);
+  }
+  return evicted;
+}
+
+bool EvictionIndex::dirty() const {
+  absl::MutexLock lock(&mu_);
+  return dirty_;
+}
+
+void EvictionIndex::markDirty() {
+  absl::MutexLock lock(&mu_);
+  dirty_ = true;
+}
+
+EvictionIndexCheckpoint EvictionIndex::toCheckpoint() {
+  EvictionIndexCheckpoint checkpoint;
+  absl::MutexLock lock(&mu_);
+  checkpoint.mutable_entries()->Reserve(order_.size());
+  for (const auto& [last_touch, name] : order_) {
+    EvictionIndexCheckpoint::Entry* entry = checkpoint.add_entries();
+    entry->set_name(name);
+    entry->set_size_bytes(entries_.find(name)->second.size_bytes_);
+    entry->set_last_touch_micros(
+        std::chrono::duration_cast<std::chrono::microseconds>(last_touch.time_since_epoch())
+            .count());
+  }
+  dirty_ = false;
+  return checkpoint;
+}
+
+void EvictionIndex::loadCheckpoint(const EvictionIndexCheckpoint& checkpoint) {
+  absl::MutexLock lock(&mu_);
+  for (const EvictionIndexCheckpoint::Entry& entry : checkpoint.entries()) {
+    addLocked(entry.name(), entry.size_bytes(),
+              SystemTime(std::chrono::microseconds(entry.last_touch_micros())));
+  }
+}
+
+void EvictionIndex::addLocked(absl::string_view name, uint64_t size_bytes,
+                              SystemTime last_touch) {
+  auto it = entries_.find(name);
+  if (it != entries_.end()) {
+    eraseLocked(it);
+  }
+  auto position = order_.emplace(last_touch, std::string{name}).first;
+  entries_.emplace(std::string{name}, Slot{size_bytes, position});
+  size_bytes_ += size_bytes;
+  count_++;
+  dirty_ = true;
+}
+
+void EvictionIndex::eraseLocked(absl::flat_hash_map<std::string, Slot>::iterator it) {
+  size_bytes_ -= it->second.size_bytes_;
+  count_--;
+  order_.erase(it->second.position_);
+  entries_.erase(it);
+  dirty_ = true;
+}
+
+} // namespace FileSystemHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
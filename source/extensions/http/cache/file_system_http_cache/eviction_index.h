@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "envoy/common/time.h"
+
+#include "source/extensions/http/cache/file_system_http_cache/eviction_index.pb.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace FileSystemHttpCache {
+
+/**
+ * An in-memory index of the entries of a cache, ordered by last touch time, so that
+ * eviction can pick the least recently used entries without scanning the cache directory.
+ *
+ * All operations are thread-safe; the index is updated from the file action threads as
+ * entries are written, read and removed, and consumed by the CacheEvictionThread.
+ */
+class EvictionIndex {
+public:
+  struct Entry {
+    std::string name_;
+    uint64_t size_bytes_;
+    SystemTime last_touch_;
+  };
+
+  /**
+   * Adds an entry to the index, replacing any existing entry with the same name.
+   * @param name the filename of the cache entry.
+   * @param size_bytes the size of the cache entry file.
+   * @param last_touch the time the entry was last written or read.
+   */
+  void add(absl::string_view name, uint64_t size_bytes, SystemTime last_touch)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * Updates the last touch time of an entry.
+   * @param name the filename of the cache entry.
+   * @param last_touch the time the entry was read.
+   * @return false if the entry is not in the index.
+   */
+  bool touch(absl::string_view name, SystemTime last_touch) ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * Removes an entry from the index, if present.
+   * @param name the filename of the cache entry.
+   */
+  void remove(absl::string_view name) ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * Removes the least recently touched entries from the index until it holds no more than
+   * max_size_bytes and max_count. Each removed entry costs O(log n).
+   * @param max_size_bytes the total size to shrink the index to.
+   * @param max_count the number of entries to shrink the index to.
+   * @return the removed entries, oldest first.
+   */
+  std::vector<Entry> evictUntilWithin(uint64_t max_size_bytes, uint64_t max_count)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * @return the total size of the indexed entries.
+   */
+  uint64_t sizeBytes() const { return size_bytes_; }
+
+  /**
+   * @return the number of indexed entries.
+   */
+  uint64_t count() const { return count_; }
+
+  /**
+   * @return true if the index changed since the last call to toCheckpoint().
+   */
+  bool dirty() const ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * Marks the index as changed, e.g. if writing the last checkpoint failed.
+   */
+  void markDirty() ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * @return a checkpoint of the index, from which loadCheckpoint can restore it.
+   */
+  EvictionIndexCheckpoint toCheckpoint() ABSL_LOCKS_EXCLUDED(mu_);
+
+  /**
+   * Adds the entries of a checkpoint to the index.
+   * @param checkpoint a checkpoint previously returned by toCheckpoint().
+   */
+  void loadCheckpoint(const EvictionIndexCheckpoint& checkpoint) ABSL_LOCKS_EXCLUDED(mu_);
+
+private:
+  // Ordered by last touch then name, so the first element is the least recently used entry.
+  using Order = std::set<std::pair<SystemTime, std::string>>;
+  struct Slot {
+    uint64_t size_bytes_;
+    Order::iterator position_;
+  };
+
+  void addLocked(absl::string_view name, uint64_t size_bytes, SystemTime last_touch)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void eraseLocked(absl::flat_hash_map<std::string, Slot>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  mutable absl::Mutex mu_;
+  absl::flat_hash_map<std::string, Slot> entries_ ABSL_GUARDED_BY(mu_);
+  Order order_ ABSL_GUARDED_BY(mu_);
+  bool dirty_ ABSL_GUARDED_BY(mu_) = false;
+  // Only modified with mu_ held, but readable without it so that workers can check whether
+  // an eviction is needed without contending on the lock.
+  std::atomic<uint64_t> size_bytes_ = 0;
+  std::atomic<uint64_t> count_ = 0;
+};
+
+} // namespace FileSystemHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
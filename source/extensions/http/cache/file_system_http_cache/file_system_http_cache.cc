@@ -79,18 +79,25 @@ absl::string_view FileSystemHttpCache::name() {
 FileSystemHttpCache::FileSystemHttpCache(
     Singleton::InstanceSharedPtr owner, CacheEvictionThread& cache_eviction_thread,
     ConfigProto config, std::shared_ptr<Common::AsyncFiles::AsyncFileManager>&& async_file_manager,
-    Stats::Scope& stats_scope)
+    Stats::Scope& stats_scope, TimeSource& time_source)
     : owner_(owner), async_file_manager_(async_file_manager),
-      shared_(std::make_shared<CacheShared>(config, stats_scope)),
+      shared_(std::make_shared<CacheShared>(config, stats_scope, time_source)),
       cache_eviction_thread_(cache_eviction_thread) {
   cache_eviction_thread_.addCache(shared_);
 }
 
-CacheShared::CacheShared(ConfigProto config, Stats::Scope& stats_scope)
+CacheShared::CacheShared(ConfigProto config, Stats::Scope& stats_scope, TimeSource& time_source)
     : config_(config), stat_names_(stats_scope.symbolTable()),
-      stats_(generateStats(stat_names_, stats_scope, cachePath())) {}
+      stats_(generateStats(stat_names_, stats_scope, cachePath())), time_source_(time_source),
+      last_checkpoint_(time_source.monotonicTime()) {}
 
-FileSystemHttpCache::~FileSystemHttpCache() { cache_eviction_thread_.removeCache(shared_); }
+FileSystemHttpCache::~FileSystemHttpCache() {
+  cache_eviction_thread_.removeCache(shared_);
+  // Keep the index for the next instance of this cache, unless it was never loaded.
+  if (!shared_->needs_init_) {
+    shared_->maybeCheckpointIndex(true);
+  }
+}
 
 CacheInfo FileSystemHttpCache::cacheInfo() const {
   CacheInfo info;
@@ -349,52 +356,49 @@ InsertContextPtr FileSystemHttpCache::makeInsertContext(LookupContextPtr&& looku
   return std::make_unique<FileInsertContext>(shared_from_this(), std::move(file_lookup_context));
 }
 
-void FileSystemHttpCache::trackFileAdded(uint64_t file_size) {
-  shared_->trackFileAdded(file_size);
+void FileSystemHttpCache::trackFileAdded(absl::string_view name, uint64_t file_size) {
+  shared_->trackFileAdded(name, file_size);
   if (shared_->needsEviction()) {
     cache_eviction_thread_.signal();
   }
 }
-void CacheShared::trackFileAdded(uint64_t file_size) {
-  size_count_++;
-  size_bytes_ += file_size;
-  stats_.size_count_.inc();
-  stats_.size_bytes_.add(file_size);
+void CacheShared::trackFileAdded(absl::string_view name, uint64_t file_size) {
+  // Replaces the index entry for a previous file of the same name, if any.
+  index_.add(name, file_size, time_source_.systemTime());
+  updateSizeStats();
 }
 
-void FileSystemHttpCache::trackFileRemoved(uint64_t file_size) {
-  shared_->trackFileRemoved(file_size);
+void FileSystemHttpCache::trackFileAccessed(absl::string_view name, uint64_t file_size) {
+  shared_->trackFileAccessed(name, file_size);
 }
-void CacheShared::trackFileRemoved(uint64_t file_size) {
-  // Atomically decrement-but-clamp-at-zero the count of files in the cache.
-  //
-  // It is an error to try to set a gauge to less than zero, so we must actively
-  // prevent that underflow.
-  //
-  // See comment on size_bytes and size_count in stats.h for explanation of how stat
-  // values can be out of sync with the actionable cache.
-  uint64_t count = size_count_;
-  while (count > 0 && !size_count_.compare_exchange_weak(count, count - 1)) {
-  }
-  stats_.size_count_.set(size_count_);
-  // Atomically decrease-but-clamp-at-zero the size of files in the cache, by file_size.
-  //
-  // See comment above for why; the same rationale applies here.
-  uint64_t size = size_bytes_;
-  while (size >= file_size && !size_bytes_.compare_exchange_weak(size, size - file_size)) {
+void CacheShared::trackFileAccessed(absl::string_view name, uint64_t file_size) {
+  if (!index_.touch(name, time_source_.systemTime())) {
+    // See comment on size_bytes and size_count in stats.h; entries we didn't write or find in
+    // the initial scan are indexed once they are read.
+    trackFileAdded(name, file_size);
   }
-  if (size < file_size) {
-    size_bytes_ = 0;
-  }
-  stats_.size_bytes_.set(size_bytes_);
+}
+
+void FileSystemHttpCache::trackFileRemoved(absl::string_view name) {
+  shared_->trackFileRemoved(name);
+}
+void CacheShared::trackFileRemoved(absl::string_view name) {
+  index_.remove(name);
+  updateSizeStats();
+}
+
+void CacheShared::updateSizeStats() {
+  stats_.size_count_.set(index_.count());
+  stats_.size_bytes_.set(index_.sizeBytes());
 }
 
 bool CacheShared::needsEviction() const {
-  if (config_.has_max_cache_size_bytes() && size_bytes_ > config_.max_cache_size_bytes().value()) {
+  if (config_.has_max_cache_size_bytes() &&
+      index_.sizeBytes() > config_.max_cache_size_bytes().value()) {
     return true;
   }
   if (config_.has_max_cache_entry_count() &&
-      size_count_ > config_.max_cache_entry_count().value()) {
+      index_.count() > config_.max_cache_entry_count().value()) {
     return true;
   }
   return false;
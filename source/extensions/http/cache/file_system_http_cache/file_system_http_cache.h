@@ -1,16 +1,22 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <string>
 
+#include "envoy/common/time.h"
 #include "envoy/extensions/http/cache/file_system_http_cache/v3/file_system_http_cache.pb.h"
 
 #include "source/common/common/logger.h"
 #include "source/extensions/common/async_files/async_file_manager.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/file_system_http_cache/eviction_index.h"
 #include "source/extensions/http/cache/file_system_http_cache/stats.h"
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -39,7 +45,7 @@ public:
   FileSystemHttpCache(Singleton::InstanceSharedPtr owner,
                       CacheEvictionThread& cache_eviction_thread, ConfigProto config,
                       std::shared_ptr<Common::AsyncFiles::AsyncFileManager>&& async_file_manager,
-                      Stats::Scope& stats_scope);
+                      Stats::Scope& stats_scope, TimeSource& time_source);
   ~FileSystemHttpCache() override;
 
   // Overrides for HttpCache
@@ -166,16 +172,25 @@ public:
   }
 
   /**
-   * Updates stats to reflect that a file has been added to the cache.
+   * Updates the eviction index and stats to reflect that a file has been added to the cache.
+   * @param name The filename (path not included) of the file that was added.
    * @param file_size The size in bytes of the file that was added.
    */
-  void trackFileAdded(uint64_t file_size);
+  void trackFileAdded(absl::string_view name, uint64_t file_size);
 
   /**
-   * Updates stats to reflect that a file has been removed from the cache.
-   * @param file_size The size in bytes of the file that was removed.
+   * Updates the eviction index to reflect that a file has been read from the cache.
+   * @param name The filename (path not included) of the file that was read.
+   * @param file_size The size in bytes of the file that was read, used to index it if it
+   *     was not yet indexed, e.g. because it was written by another process.
    */
-  void trackFileRemoved(uint64_t file_size);
+  void trackFileAccessed(absl::string_view name, uint64_t file_size);
+
+  /**
+   * Updates the eviction index and stats to reflect that a file has been removed from the cache.
+   * @param name The filename (path not included) of the file that was removed.
+   */
+  void trackFileRemoved(absl::string_view name);
 
   // UpdateHeaders copies an existing cache entry to a new file. This value is
   // the size of a copy-chunk. It's public for unit tests only, as the chunk size
@@ -230,21 +245,26 @@ private:
 // This part of the cache implementation is shared between CacheEvictionThread and
 // FileSystemHttpCache. The implementation of CacheShared is also split between the
 // two implementation files, accordingly.
-struct CacheShared {
-  CacheShared(ConfigProto config, Stats::Scope& stats_scope);
+struct CacheShared : public Logger::Loggable<Logger::Id::cache_filter> {
+  CacheShared(ConfigProto config, Stats::Scope& stats_scope, TimeSource& time_source);
   const ConfigProto config_;
   CacheStatNames stat_names_;
   CacheStats stats_;
-  // These are part of stats, but we have to track them separately because there is
-  // potential to go "less than zero" due to not having sole control of the file cache;
-  // gauge values don't have fine enough control to prevent that, and aren't allowed to
-  // be negative.
+  TimeSource& time_source_;
+  // The size, count and last touch time of the cache entries, from which eviction picks
+  // its victims and the size stats are updated.
   //
-  // See comment on size_bytes and size_count in stats.h for explanation of how stat
-  // values can be out of sync with the actionable cache.
-  std::atomic<uint64_t> size_count_ = 0;
-  std::atomic<uint64_t> size_bytes_ = 0;
-  bool needs_init_ = true;
+  // See comment on size_bytes and size_count in stats.h for explanation of how the index
+  // can be out of sync with the actionable cache.
+  EvictionIndex index_;
+  std::atomic<bool> needs_init_ = true;
+  // Serializes writes of the index checkpoint, which may happen from the eviction thread
+  // and from the main thread when the cache is destroyed.
+  absl::Mutex checkpoint_mu_;
+  MonotonicTime last_checkpoint_ ABSL_GUARDED_BY(checkpoint_mu_);
+
+  // The shortest time between two checkpoints of the eviction index by the eviction thread.
+  static constexpr std::chrono::seconds index_checkpoint_interval_{60};
 
   /**
    * @return true if the eviction thread should do a pass over this cache.
@@ -258,16 +278,38 @@ struct CacheShared {
   absl::string_view cachePath() const { return config_.cache_path(); }
 
   /**
-   * Updates stats (size and count) to reflect that a file has been added to the cache.
+   * Returns the path of the eviction index checkpoint. The filename doesn't start with
+   * "cache-", so the checkpoint is never mistaken for a cache entry.
+   * @return the path of the eviction index checkpoint for this cache instance.
+   */
+  std::string indexCheckpointPath() const { return absl::StrCat(cachePath(), "eviction-index"); }
+
+  /**
+   * Updates the eviction index and stats (size and count) to reflect that a file has been
+   * added to the cache.
+   * @param name The filename of the file that was added.
    * @param file_size The size in bytes of the file that was added.
    */
-  void trackFileAdded(uint64_t file_size);
+  void trackFileAdded(absl::string_view name, uint64_t file_size);
+
+  /**
+   * Updates the eviction index to reflect that a file has been read from the cache.
+   * @param name The filename of the file that was read.
+   * @param file_size The size in bytes of the file, used if it was not yet indexed.
+   */
+  void trackFileAccessed(absl::string_view name, uint64_t file_size);
 
   /**
-   * Updates stats (size and count) to reflect that a file has been removed from the cache.
-   * @param file_size The size in bytes of the file that was removed.
+   * Updates the eviction index and stats (size and count) to reflect that a file has been
+   * removed from the cache.
+   * @param name The filename of the file that was removed.
    */
-  void trackFileRemoved(uint64_t file_size);
+  void trackFileRemoved(absl::string_view name);
+
+  /**
+   * Sets the size stats from the eviction index.
+   */
+  void updateSizeStats();
 
   /**
    * Performs an eviction pass over this cache. Runs in the CacheEvictionThread.
@@ -275,9 +317,24 @@ struct CacheShared {
   void evict();
 
   /**
-   * Initializes the stats for this cache. Runs in the CacheEvictionThread.
+   * Initializes the eviction index and stats for this cache, from the index checkpoint if
+   * there is one, or else by scanning the cache directory. Runs in the CacheEvictionThread.
    */
   void initStats();
+
+  /**
+   * Loads the eviction index from its checkpoint, and removes the checkpoint so that
+   * a restart before the next checkpoint rescans the cache directory instead.
+   * @return false if there was no usable checkpoint.
+   */
+  bool loadIndexCheckpoint();
+
+  /**
+   * Writes the eviction index checkpoint if the index changed since the last one, and
+   * either force is set or index_checkpoint_interval_ has passed since the last one.
+   * @param force true to ignore index_checkpoint_interval_, e.g. when the cache is destroyed.
+   */
+  void maybeCheckpointIndex(bool force) ABSL_LOCKS_EXCLUDED(checkpoint_mu_);
 };
 
 } // namespace FileSystemHttpCache
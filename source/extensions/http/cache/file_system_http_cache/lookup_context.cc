@@ -78,6 +78,8 @@ void FileLookupContext::getHeadersWithLock(LookupHeadersCallback cb) {
                         cb(LookupResult{});
                         return;
                       }
+                      // Touch the vary entry too, so it isn't evicted before its variants.
+                      trackCacheEntryAccessed();
                       key_ = maybe_vary_key.value();
                       auto fh = std::move(file_handle_);
                       file_handle_ = nullptr;
@@ -91,6 +93,7 @@ void FileLookupContext::getHeadersWithLock(LookupHeadersCallback cb) {
                       ASSERT(queued.ok(), queued.ToString());
                       return;
                     }
+                    trackCacheEntryAccessed();
                     cb(lookup().makeLookupResult(
                         headersFromHeaderProto(header_proto), metadataFromHeaderProto(header_proto),
                         header_block_.bodySize(), header_block_.trailerSize() > 0));
@@ -104,21 +107,20 @@ void FileLookupContext::getHeadersWithLock(LookupHeadersCallback cb) {
 }
 
 void FileLookupContext::invalidateCacheEntry() {
-  cache_.asyncFileManager()->stat(
-      filepath(), [file = filepath(),
-                   cache = cache_.shared_from_this()](absl::StatusOr<struct stat> stat_result) {
-        size_t file_size = 0;
-        if (stat_result.ok()) {
-          file_size = stat_result.value().st_size;
+  cache_.asyncFileManager()->unlink(
+      filepath(), [name = cache_.generateFilename(key_),
+                   cache = cache_.shared_from_this()](absl::Status unlink_result) {
+        if (unlink_result.ok()) {
+          cache->trackFileRemoved(name);
         }
-        cache->asyncFileManager()->unlink(file, [cache, file_size](absl::Status unlink_result) {
-          if (unlink_result.ok()) {
-            cache->trackFileRemoved(file_size);
-          }
-        });
       });
 }
 
+void FileLookupContext::trackCacheEntryAccessed() {
+  cache_.trackFileAccessed(cache_.generateFilename(key_),
+                           header_block_.offsetToTrailers() + header_block_.trailerSize());
+}
+
 void FileLookupContext::getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) {
   absl::MutexLock lock(&mu_);
   ASSERT(!cancel_action_in_flight_);
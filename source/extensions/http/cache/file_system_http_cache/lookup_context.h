@@ -42,6 +42,10 @@ private:
   // cache so we don't keep repeating the same failure.
   void invalidateCacheEntry() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Records the read of the current cache entry in the eviction index, so that recently read
+  // entries are evicted last.
+  void trackCacheEntryAccessed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   std::string filepath() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // We can safely use a reference here, because the shared_ptr to a cache is guaranteed to outlive
@@ -11,13 +11,16 @@ namespace FileSystemHttpCache {
 /**
  * All cache stats. @see stats_macros.h
  *
- * Note that size_bytes and size_count may drift away from true values, due to:
+ * Note that size_bytes and size_count are those of the eviction index, which may drift
+ * away from true values, due to:
  * - Changes to the filesystem may be made outside of the process, which will not be
- *   accounted for. (Including, during hot restart, overlapping envoy processes.)
- * - Files completed while pre-cache-purge measurement is in progress may not be counted.
+ *   accounted for until the affected entries are read or evicted. (Including, during hot
+ *   restart, overlapping envoy processes.)
+ * - Files added after the last index checkpoint are missing from the index after a crash,
+ *   until they are read.
  * - Changes in file size due to header updates are assumed to be negligible, and are ignored.
  *
- * Drift will eventually be reconciled at the next pre-cache-purge measurement.
+ * Drift is reconciled when the cache starts without an index checkpoint, and rescans.
  **/
 
 #define ALL_CACHE_STATS(COUNTER, GAUGE, HISTOGRAM, TEXT_READOUT, STATNAME)                         \
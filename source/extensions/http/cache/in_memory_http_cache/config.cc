@@ -0,0 +1,77 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.h"
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+namespace {
+
+/**
+ * A singleton holding the in-memory caches, so that cache filters with equal configs share the
+ * same cache.
+ */
+class CacheSingleton : public Envoy::Singleton::Instance {
+public:
+  std::shared_ptr<InMemoryHttpCache> get(std::shared_ptr<CacheSingleton> singleton,
+                                         const ConfigProto& config, Stats::Scope& stats_scope) {
+    absl::MutexLock lock(&mu_);
+    std::weak_ptr<InMemoryHttpCache>& weak_cache = caches_[config];
+    std::shared_ptr<InMemoryHttpCache> cache = weak_cache.lock();
+    if (cache == nullptr) {
+      cache = std::make_shared<InMemoryHttpCache>(std::move(singleton), config, stats_scope);
+      weak_cache = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  // We keep weak_ptr here so that the caches are destroyed once no cache filter uses their config
+  // anymore. The caches keep this singleton alive.
+  absl::flat_hash_map<ConfigProto, std::weak_ptr<InMemoryHttpCache>, MessageUtil, MessageUtil>
+      caches_ ABSL_GUARDED_BY(mu_);
+};
+
+SINGLETON_MANAGER_REGISTRATION(in_memory_http_cache_singleton);
+
+class InMemoryHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string{InMemoryHttpCache::name()}; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ConfigProto>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    const auto config = MessageUtil::anyConvertAndValidate<ConfigProto>(
+        filter_config.typed_config(), context.messageValidationVisitor());
+    std::shared_ptr<CacheSingleton> caches = context.singletonManager().getTyped<CacheSingleton>(
+        SINGLETON_MANAGER_REGISTERED_NAME(in_memory_http_cache_singleton),
+        [] { return std::make_shared<CacheSingleton>(); });
+    // The caches outlive the listeners using them, so their stats are kept in the server scope.
+    return caches->get(caches, config, context.serverScope());
+  }
+};
+
+static Registry::RegisterFactory<InMemoryHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
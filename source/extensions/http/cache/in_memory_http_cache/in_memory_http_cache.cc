@@ -0,0 +1,382 @@
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+
+#include <algorithm>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
+
+#include "absl/strings/str_join.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+namespace {
+
+constexpr uint64_t DefaultMaxCacheSizeBytes = 64 << 20;
+constexpr uint32_t DefaultShards = 16;
+// An estimate of the memory used by an entry beyond its key, headers, body and trailers.
+constexpr uint64_t EntryOverheadBytes = 256;
+
+uint64_t entrySize(const HashedKey& key, const Entry& entry) {
+  return EntryOverheadBytes + key.key().ByteSizeLong() + entry.response_headers_->byteSize() +
+         (entry.body_ != nullptr ? entry.body_->size() : 0) +
+         (entry.trailers_ != nullptr ? entry.trailers_->byteSize() : 0);
+}
+
+// Returns a Key with the vary header added to custom_fields, or nullopt if the vary headers in
+// the response are not compatible with the VaryAllowList.
+absl::optional<Key> variedRequestKey(const Key& request_key,
+                                     const Http::RequestHeaderMap& request_headers,
+                                     const VaryAllowList& vary_allow_list,
+                                     const Http::ResponseHeaderMap& response_headers) {
+  absl::btree_set<absl::string_view> vary_header_values =
+      VaryHeaderUtils::getVaryValues(response_headers);
+  ASSERT(!vary_header_values.empty());
+  const absl::optional<std::string> vary_identifier =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, vary_header_values, request_headers);
+  if (!vary_identifier.has_value()) {
+    return absl::nullopt;
+  }
+  Key varied_request_key = request_key;
+  varied_request_key.add_custom_fields(vary_identifier.value());
+  return varied_request_key;
+}
+
+// References a range of a cached body, keeping the body alive until the buffer holding the
+// fragment is done with it.
+class BodyFragment : public Buffer::BufferFragment {
+public:
+  BodyFragment(std::shared_ptr<const std::string> body, uint64_t begin, uint64_t length)
+      : body_(std::move(body)), begin_(begin), length_(length) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return body_->data() + begin_; }
+  size_t size() const override { return length_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> body_;
+  const uint64_t begin_;
+  const uint64_t length_;
+};
+
+class InMemoryLookupContext : public LookupContext {
+public:
+  InMemoryLookupContext(InMemoryHttpCache& cache, LookupRequest&& request)
+      : cache_(cache), request_(std::move(request)) {}
+
+  void getHeaders(LookupHeadersCallback&& cb) override {
+    entry_ = cache_.lookup(request_);
+    if (entry_ == nullptr) {
+      cb(LookupResult{});
+      return;
+    }
+    cb(request_.makeLookupResult(
+        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*entry_->response_headers_),
+        ResponseMetadata(entry_->metadata_), entry_->body_->size(), entry_->trailers_ != nullptr));
+  }
+
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    ASSERT(entry_ != nullptr);
+    ASSERT(range.end() <= entry_->body_->size(), "Attempt to read past end of body.");
+    auto buffer = std::make_unique<Buffer::OwnedImpl>();
+    if (range.length() > 0) {
+      buffer->addBufferFragment(*new BodyFragment(entry_->body_, range.begin(), range.length()));
+    }
+    cb(std::move(buffer));
+  }
+
+  void getTrailers(LookupTrailersCallback&& cb) override {
+    ASSERT(entry_ != nullptr && entry_->trailers_ != nullptr);
+    cb(Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*entry_->trailers_));
+  }
+
+  const LookupRequest& request() const { return request_; }
+  void onDestroy() override {}
+
+private:
+  InMemoryHttpCache& cache_;
+  const LookupRequest request_;
+  // Holds the entry, and so its body, for the duration of the lookup.
+  EntrySharedPtr entry_;
+};
+
+class InMemoryInsertContext : public InsertContext {
+public:
+  InMemoryInsertContext(std::unique_ptr<InMemoryLookupContext>&& lookup_context,
+                        InMemoryHttpCache& cache)
+      : lookup_context_(std::move(lookup_context)), cache_(cache) {}
+
+  void insertHeaders(const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, InsertCallback insert_success,
+                     bool end_stream) override {
+    ASSERT(!committed_);
+    response_headers_ = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers);
+    metadata_ = metadata;
+    insert_success(end_stream ? commit() : true);
+  }
+
+  void insertBody(const Buffer::Instance& chunk, InsertCallback ready_for_next_chunk,
+                  bool end_stream) override {
+    ASSERT(!committed_);
+    ASSERT(ready_for_next_chunk || end_stream);
+    body_.add(chunk);
+    // Give up early on responses that can't fit in the cache.
+    if (body_.length() > cache_.maxEntrySizeBytes()) {
+      cache_.onInsertRejected();
+      ready_for_next_chunk(false);
+      return;
+    }
+    if (end_stream) {
+      ready_for_next_chunk(commit());
+    } else {
+      ready_for_next_chunk(true);
+    }
+  }
+
+  void insertTrailers(const Http::ResponseTrailerMap& trailers,
+                      InsertCallback insert_complete) override {
+    ASSERT(!committed_);
+    trailers_ = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(trailers);
+    insert_complete(commit());
+  }
+
+  void onDestroy() override { lookup_context_->onDestroy(); }
+
+private:
+  bool commit() {
+    committed_ = true;
+    const LookupRequest& request = lookup_context_->request();
+    return cache_.insert(request.key(), std::move(response_headers_), std::move(metadata_),
+                         body_.toString(), std::move(trailers_), request.requestHeaders(),
+                         request.varyAllowList());
+  }
+
+  // Owned for the request headers and vary allow list of the lookup.
+  const std::unique_ptr<InMemoryLookupContext> lookup_context_;
+  InMemoryHttpCache& cache_;
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  Buffer::OwnedImpl body_;
+  Http::ResponseTrailerMapPtr trailers_;
+  bool committed_ = false;
+};
+
+} // namespace
+
+InMemoryHttpCache::InMemoryHttpCache(std::shared_ptr<Singleton::Instance> owner,
+                                     const ConfigProto& config, Stats::Scope& scope)
+    : owner_(std::move(owner)), config_(config), stats_(generateStats(scope)),
+      shards_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, shards, DefaultShards)),
+      shard_budget_bytes_(std::max<uint64_t>(
+          1, PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_cache_size_bytes,
+                                             DefaultMaxCacheSizeBytes) /
+                 shards_.size())),
+      max_entry_size_bytes_(std::min(
+          shard_budget_bytes_, PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entry_size_bytes,
+                                                               shard_budget_bytes_))) {}
+
+InMemoryHttpCache::~InMemoryHttpCache() {
+  for (Shard& shard : shards_) {
+    shard.clear(stats_);
+  }
+}
+
+absl::string_view InMemoryHttpCache::name() {
+  return "envoy.extensions.http.cache.in_memory_http_cache";
+}
+
+CacheInfo InMemoryHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = name();
+  return cache_info;
+}
+
+LookupContextPtr InMemoryHttpCache::makeLookupContext(LookupRequest&& request,
+                                                      Http::StreamDecoderFilterCallbacks&) {
+  return std::make_unique<InMemoryLookupContext>(*this, std::move(request));
+}
+
+InsertContextPtr InMemoryHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                      Http::StreamEncoderFilterCallbacks&) {
+  auto in_memory_lookup_context = std::unique_ptr<InMemoryLookupContext>(
+      dynamic_cast<InMemoryLookupContext*>(lookup_context.release()));
+  ASSERT(in_memory_lookup_context != nullptr);
+  return std::make_unique<InMemoryInsertContext>(std::move(in_memory_lookup_context), *this);
+}
+
+EntrySharedPtr InMemoryHttpCache::find(const Key& key) {
+  const HashedKey hashed_key(key);
+  return shard(hashed_key).find(hashed_key);
+}
+
+EntrySharedPtr InMemoryHttpCache::lookup(const LookupRequest& request) {
+  EntrySharedPtr entry = find(request.key());
+  if (entry != nullptr && VaryHeaderUtils::hasVary(*entry->response_headers_)) {
+    const absl::optional<Key> varied_key =
+        variedRequestKey(request.key(), request.requestHeaders(), request.varyAllowList(),
+                         *entry->response_headers_);
+    entry = varied_key.has_value() ? find(varied_key.value()) : nullptr;
+  }
+  if (entry == nullptr) {
+    stats_.misses_.inc();
+  } else {
+    stats_.hits_.inc();
+  }
+  return entry;
+}
+
+bool InMemoryHttpCache::insert(const Key& request_key,
+                               Http::ResponseHeaderMapPtr&& response_headers,
+                               ResponseMetadata&& metadata, std::string&& body,
+                               Http::ResponseTrailerMapPtr&& trailers,
+                               const Http::RequestHeaderMap& request_headers,
+                               const VaryAllowList& vary_allow_list) {
+  auto entry = std::make_shared<Entry>(Entry{std::move(response_headers), std::move(metadata),
+                                             std::make_shared<const std::string>(std::move(body)),
+                                             std::move(trailers)});
+  absl::optional<HashedKey> vary_key;
+  absl::optional<HashedKey> key;
+  if (VaryHeaderUtils::hasVary(*entry->response_headers_)) {
+    const absl::optional<Key> varied_key = variedRequestKey(
+        request_key, request_headers, vary_allow_list, *entry->response_headers_);
+    if (!varied_key.has_value()) {
+      // Skip the insert if we are unable to create a vary key.
+      return false;
+    }
+    key.emplace(varied_key.value());
+    vary_key.emplace(request_key);
+  } else {
+    key.emplace(request_key);
+  }
+  if (entrySize(*key, *entry) > max_entry_size_bytes_) {
+    onInsertRejected();
+    return false;
+  }
+
+  if (vary_key.has_value()) {
+    // Add a special entry to flag that this request generates varied responses.
+    Http::ResponseHeaderMapPtr vary_only_map =
+        Http::createHeaderMap<Http::ResponseHeaderMapImpl>({});
+    vary_only_map->setCopy(
+        Http::CustomHeaders::get().Vary,
+        absl::StrJoin(VaryHeaderUtils::getVaryValues(*entry->response_headers_), ","));
+    shard(*vary_key)
+        .insert(*vary_key,
+                std::make_shared<Entry>(Entry{std::move(vary_only_map), {},
+                                              std::make_shared<const std::string>(), nullptr}),
+                shard_budget_bytes_, stats_);
+  }
+  shard(*key).insert(*key, std::move(entry), shard_budget_bytes_, stats_);
+  stats_.inserts_.inc();
+  return true;
+}
+
+void InMemoryHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                      const Http::ResponseHeaderMap& response_headers,
+                                      const ResponseMetadata& metadata,
+                                      std::function<void(bool)> on_complete) {
+  const LookupRequest& request =
+      static_cast<const InMemoryLookupContext&>(lookup_context).request();
+  const EntrySharedPtr entry = find(request.key());
+  if (entry == nullptr) {
+    on_complete(false);
+    return;
+  }
+  absl::optional<HashedKey> key;
+  if (VaryHeaderUtils::hasVary(*entry->response_headers_)) {
+    const absl::optional<Key> varied_key =
+        variedRequestKey(request.key(), request.requestHeaders(), request.varyAllowList(),
+                         *entry->response_headers_);
+    if (!varied_key.has_value()) {
+      on_complete(false);
+      return;
+    }
+    key.emplace(varied_key.value());
+  } else {
+    key.emplace(request.key());
+  }
+  on_complete(shard(*key).update(
+      *key,
+      [&response_headers, &metadata](const Entry& old_entry) {
+        Http::ResponseHeaderMapPtr headers =
+            Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*old_entry.response_headers_);
+        applyHeaderUpdate(response_headers, *headers);
+        return std::make_shared<Entry>(Entry{
+            std::move(headers), metadata, old_entry.body_,
+            old_entry.trailers_ != nullptr
+                ? Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*old_entry.trailers_)
+                : nullptr});
+      },
+      shard_budget_bytes_, stats_));
+}
+
+EntrySharedPtr InMemoryHttpCache::Shard::find(const HashedKey& key) {
+  absl::MutexLock lock(&mutex_);
+  const Slot* slot = map_.get(key);
+  return slot != nullptr ? slot->entry_ : nullptr;
+}
+
+void InMemoryHttpCache::Shard::insert(const HashedKey& key, EntrySharedPtr entry, uint64_t budget,
+                                      CacheStats& stats) {
+  const uint64_t size = entrySize(key, *entry);
+  absl::MutexLock lock(&mutex_);
+  auto [slot, inserted] = map_.getOrInsert(key);
+  if (inserted) {
+    stats.size_count_.inc();
+  } else {
+    size_bytes_ -= slot->size_;
+    stats.size_bytes_.sub(slot->size_);
+  }
+  slot->entry_ = std::move(entry);
+  slot->size_ = size;
+  size_bytes_ += size;
+  stats.size_bytes_.add(size);
+  evict(budget, stats);
+}
+
+bool InMemoryHttpCache::Shard::update(const HashedKey& key,
+                                      const std::function<EntrySharedPtr(const Entry&)>& update,
+                                      uint64_t budget, CacheStats& stats) {
+  absl::MutexLock lock(&mutex_);
+  Slot* slot = map_.get(key);
+  if (slot == nullptr) {
+    return false;
+  }
+  EntrySharedPtr entry = update(*slot->entry_);
+  const uint64_t size = entrySize(key, *entry);
+  size_bytes_ = size_bytes_ - slot->size_ + size;
+  stats.size_bytes_.sub(slot->size_);
+  stats.size_bytes_.add(size);
+  slot->entry_ = std::move(entry);
+  slot->size_ = size;
+  evict(budget, stats);
+  return true;
+}
+
+void InMemoryHttpCache::Shard::clear(CacheStats& stats) {
+  absl::MutexLock lock(&mutex_);
+  stats.size_bytes_.sub(size_bytes_);
+  stats.size_count_.sub(map_.size());
+  size_bytes_ = 0;
+  map_.clear();
+}
+
+void InMemoryHttpCache::Shard::evict(uint64_t budget, CacheStats& stats) {
+  while (size_bytes_ > budget) {
+    const uint64_t size = map_.leastRecentlyUsed().size_;
+    size_bytes_ -= size;
+    stats.size_bytes_.sub(size);
+    stats.size_count_.dec();
+    map_.eraseLeastRecentlyUsed();
+    stats.evictions_.inc();
+  }
+}
+
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.h"
+#include "envoy/singleton/instance.h"
+
+#include "source/common/common/lru_map.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/in_memory_http_cache/stats.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+
+using ConfigProto =
+    envoy::extensions::http::cache::in_memory_http_cache::v3::InMemoryHttpCacheConfig;
+
+// A cache key along with its hash, so that the key is hashed once per cache operation, both to
+// pick a shard and to look it up in that shard.
+class HashedKey {
+public:
+  explicit HashedKey(const Key& key) : key_(key), hash_(MessageUtil::hash(key_)) {}
+
+  const Key& key() const { return key_; }
+  uint64_t hash() const { return hash_; }
+
+  bool operator==(const HashedKey& other) const {
+    return hash_ == other.hash_ && MessageUtil()(key_, other.key_);
+  }
+  template <typename H> friend H AbslHashValue(H h, const HashedKey& key) {
+    return H::combine(std::move(h), key.hash_);
+  }
+
+private:
+  Key key_;
+  uint64_t hash_;
+};
+
+// A cached response. Entries are never modified once inserted: header updates replace the entry
+// with one sharing the body, so that lookups can keep using an entry without holding a lock.
+struct Entry {
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  // Served without copies, by adding fragments referencing the body to the response buffers.
+  std::shared_ptr<const std::string> body_;
+  Http::ResponseTrailerMapPtr trailers_;
+};
+using EntrySharedPtr = std::shared_ptr<const Entry>;
+
+// A production-ready in-memory cache backend. The entries are split into independently locked
+// shards, each holding an equal part of the size budget and evicting its least recently used
+// entries when over budget.
+class InMemoryHttpCache : public HttpCache {
+public:
+  // owner is kept alive by the cache, so that the singleton holding the caches lives as long as
+  // any of them.
+  InMemoryHttpCache(std::shared_ptr<Singleton::Instance> owner, const ConfigProto& config,
+                    Stats::Scope& scope);
+  ~InMemoryHttpCache() override;
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamDecoderFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamEncoderFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata,
+                     std::function<void(bool)> on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  // Returns the entry for the request, looking through the vary entry if the response varies, or
+  // nullptr if there is none.
+  EntrySharedPtr lookup(const LookupRequest& request);
+
+  // Inserts the response, keyed by request_key or by the key varied on request_headers if the
+  // response varies. Returns false if the response wasn't inserted.
+  bool insert(const Key& request_key, Http::ResponseHeaderMapPtr&& response_headers,
+              ResponseMetadata&& metadata, std::string&& body,
+              Http::ResponseTrailerMapPtr&& trailers, const Http::RequestHeaderMap& request_headers,
+              const VaryAllowList& vary_allow_list);
+
+  const ConfigProto& config() const { return config_; }
+  // Responses larger than this, as measured for the size budget, aren't inserted.
+  uint64_t maxEntrySizeBytes() const { return max_entry_size_bytes_; }
+  void onInsertRejected() { stats_.inserts_rejected_.inc(); }
+
+  static absl::string_view name();
+
+private:
+  class Shard {
+  public:
+    EntrySharedPtr find(const HashedKey& key);
+    void insert(const HashedKey& key, EntrySharedPtr entry, uint64_t budget, CacheStats& stats);
+    // Replaces the entry of key, if any, with the result of update. Returns false if there was no
+    // entry for key.
+    bool update(const HashedKey& key, const std::function<EntrySharedPtr(const Entry&)>& update,
+                uint64_t budget, CacheStats& stats);
+    void clear(CacheStats& stats);
+
+  private:
+    struct Slot {
+      EntrySharedPtr entry_;
+      uint64_t size_{};
+    };
+
+    // Evicts the least recently used entries until the shard is within budget.
+    void evict(uint64_t budget, CacheStats& stats) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+    absl::Mutex mutex_;
+    LruMap<HashedKey, Slot> map_ ABSL_GUARDED_BY(mutex_);
+    uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){0};
+  };
+
+  Shard& shard(const HashedKey& key) { return shards_[key.hash() % shards_.size()]; }
+  EntrySharedPtr find(const Key& key);
+
+  const std::shared_ptr<Singleton::Instance> owner_;
+  const ConfigProto config_;
+  CacheStats stats_;
+  std::vector<Shard> shards_;
+  uint64_t shard_budget_bytes_;
+  uint64_t max_entry_size_bytes_;
+};
+
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
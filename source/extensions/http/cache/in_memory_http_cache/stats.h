@@ -0,0 +1,43 @@
+#pragma once
+
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+
+/**
+ * All in-memory cache stats. @see stats_macros.h
+ *
+ * The stats of all in-memory caches are added together.
+ **/
+#define ALL_IN_MEMORY_CACHE_STATS(COUNTER, GAUGE)                                                  \
+  COUNTER(evictions)                                                                               \
+  COUNTER(hits)                                                                                    \
+  COUNTER(inserts)                                                                                 \
+  COUNTER(inserts_rejected)                                                                        \
+  COUNTER(misses)                                                                                  \
+  GAUGE(size_bytes, NeverImport)                                                                   \
+  GAUGE(size_count, NeverImport)
+
+/**
+ * Struct definition for all in-memory cache stats. @see stats_macros.h
+ */
+struct CacheStats {
+  ALL_IN_MEMORY_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+inline CacheStats generateStats(Stats::Scope& scope) {
+  const std::string prefix = "cache.in_memory.";
+  return {ALL_IN_MEMORY_CACHE_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                    POOL_GAUGE_PREFIX(scope, prefix))};
+}
+
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -40,15 +40,27 @@ public:
     auto entry = cache_.lookup(request_);
     body_ = std::move(entry.body_);
     trailers_ = std::move(entry.trailers_);
-    cb(entry.response_headers_ ? request_.makeLookupResult(std::move(entry.response_headers_),
-                                                           std::move(entry.metadata_), body_.size(),
-                                                           trailers_ != nullptr)
-                               : LookupResult{});
+    cb(entry.response_headers_
+           ? request_.makeLookupResult(std::move(entry.response_headers_),
+                                       std::move(entry.metadata_), body_->size(),
+                                       trailers_ != nullptr)
+           : LookupResult{});
   }
 
+  // The range is served by reference to the cached body, which the fragment keeps alive, so that
+  // neither the bytes before it nor the range itself are copied.
   void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
-    ASSERT(range.end() <= body_.length(), "Attempt to read past end of body.");
-    cb(std::make_unique<Buffer::OwnedImpl>(&body_[range.begin()], range.length()));
+    ASSERT(body_ != nullptr);
+    ASSERT(range.end() <= body_->length(), "Attempt to read past end of body.");
+    auto buffer = std::make_unique<Buffer::OwnedImpl>();
+    if (range.length() > 0) {
+      buffer->addBufferFragment(*new Buffer::BufferFragmentImpl(
+          body_->data() + range.begin(), range.length(),
+          [body = body_](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+            delete fragment;
+          }));
+    }
+    cb(std::move(buffer));
   }
 
   // The cache must call cb with the cached trailers.
@@ -63,7 +75,7 @@ public:
 private:
   SimpleHttpCache& cache_;
   const LookupRequest request_;
-  std::string body_;
+  std::shared_ptr<const std::string> body_;
   Http::ResponseTrailerMapPtr trailers_;
 };
 
@@ -200,7 +212,8 @@ bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& respon
                              Http::ResponseTrailerMapPtr&& trailers) {
   absl::WriterMutexLock lock(&mutex_);
   map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
-                                     std::move(body), std::move(trailers)};
+                                     std::make_shared<const std::string>(std::move(body)),
+                                     std::move(trailers)};
   return true;
 }
 
@@ -254,7 +267,8 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
 
   varied_request_key.add_custom_fields(vary_identifier.value());
   map_[varied_request_key] = SimpleHttpCache::Entry{
-      std::move(response_headers), std::move(metadata), std::move(body), std::move(trailers)};
+      std::move(response_headers), std::move(metadata),
+      std::make_shared<const std::string>(std::move(body)), std::move(trailers)};
 
   // Add a special entry to flag that this request generates varied responses.
   auto iter = map_.find(request_key);
@@ -268,8 +282,9 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
     // have inserted for that resource. For the first entry simply use vary_identifier as the
     // entry_list; for future entries append vary_identifier to existing list.
     std::string entry_list;
-    map_[request_key] =
-        SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}};
+    map_[request_key] = SimpleHttpCache::Entry{
+        std::move(vary_only_map), {}, std::make_shared<const std::string>(std::move(entry_list)),
+        {}};
   }
   return true;
 }
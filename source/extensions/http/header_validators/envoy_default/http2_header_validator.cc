@@ -2,8 +2,8 @@
 
 #include "envoy/http/header_validator_errors.h"
 
+#include "source/common/http/header_name_scanner.h"
 #include "source/common/http/header_utility.h"
-#include "source/extensions/http/header_validators/envoy_default/character_tables.h"
 
 #include "absl/container/node_hash_map.h"
 #include "absl/container/node_hash_set.h"
@@ -383,31 +383,18 @@ Http2HeaderValidator::validateGenericHeaderName(const HeaderString& name) {
             Http2ResponseCodeDetail::get().ConnectionHeaderSanitization};
   }
 
-  bool is_valid = true;
-  char c = '\0';
-  bool has_underscore = false;
-
   // Verify that the header name is all lowercase. From RFC 9113,
   // https://www.rfc-editor.org/rfc/rfc9113#section-8.2.1:
   //
   // A field name MUST NOT contain characters in the ranges 0x00-0x20, 0x41-0x5a, or 0x7f-0xff (all
   // ranges inclusive). This specifically excludes all non-visible ASCII characters, ASCII SP
   // (0x20), and uppercase characters ('A' to 'Z', ASCII 0x41 to 0x5a).
-  for (auto iter = key_string_view.begin(); iter != key_string_view.end() && is_valid; ++iter) {
-    c = *iter;
-    if (c != '_') {
-      is_valid &= testChar(kGenericHeaderNameCharTable, c) && (c < 'A' || c > 'Z');
-    } else {
-      has_underscore = true;
-    }
-  }
-
-  if (!is_valid) {
+  if (!::Envoy::Http::HeaderNameScanner::isValidLowercase(key_string_view)) {
     return {HeaderEntryValidationResult::Action::Reject,
             UhvResponseCodeDetail::get().InvalidNameCharacters};
   }
 
-  if (has_underscore) {
+  if (key_string_view.find('_') != absl::string_view::npos) {
     if (underscore_action == HeaderValidatorConfig::REJECT_REQUEST) {
       stats_.incRequestsRejectedWithUnderscoresInHeaders();
       return {HeaderEntryValidationResult::Action::Reject,
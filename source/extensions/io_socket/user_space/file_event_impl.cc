@@ -1,6 +1,7 @@
 #include "source/extensions/io_socket/user_space/file_event_impl.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/io_socket/user_space/io_handle.h"
 
 namespace Envoy {
@@ -10,12 +11,21 @@ namespace UserSpace {
 
 FileEventImpl::FileEventImpl(Event::Dispatcher& dispatcher, Event::FileReadyCb cb, uint32_t events,
                              IoHandle& io_source)
-    : schedulable_(dispatcher.createSchedulableCallback([this, cb]() {
+    : dispatcher_(dispatcher), schedulable_(dispatcher.createSchedulableCallback([this, cb]() {
+        // The approximate time is updated once per iteration of the event loop, before it polls.
+        const MonotonicTime iteration = dispatcher_.approximateMonotonicTime();
+        if (iteration != callbacks_iteration_) {
+          callbacks_iteration_ = iteration;
+          iteration_callbacks_ = 0;
+        }
+        iteration_callbacks_++;
         auto ephemeral_events = event_listener_.getAndClearEphemeralEvents();
         ENVOY_LOG(trace, "User space event {} invokes callbacks on events = {}",
                   static_cast<void*>(this), ephemeral_events);
         cb(ephemeral_events);
       })),
+      activate_in_current_iteration_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.user_space_activate_in_current_iteration")),
       io_source_(io_source) {
   setEnabled(events);
 }
@@ -69,7 +79,15 @@ void FileEventImpl::activateIfEnabled(uint32_t events) {
   if (filtered_events == 0) {
     return;
   }
-  activate(filtered_events);
+  if (!activate_in_current_iteration_ || !dispatcher_.isThreadSafe() ||
+      (iteration_callbacks_ >= MaxCallbacksPerIteration &&
+       callbacks_iteration_ == dispatcher_.approximateMonotonicTime())) {
+    activate(filtered_events);
+    return;
+  }
+  event_listener_.onEventActivated(filtered_events);
+  // A callback already scheduled for the next iteration stays there.
+  schedulable_->scheduleCallbackCurrentIteration();
 }
 } // namespace UserSpace
 } // namespace IoSocket
@@ -31,9 +31,17 @@ public:
   void registerEventIfEmulatedEdge(uint32_t) override {}
 
   // Notify events. Unlike activate() method, this method activates the given events only if the
-  // events are enabled.
+  // events are enabled. It is called on behalf of the peer, e.g. when the peer writes data, and
+  // the events are delivered in the current iteration of the event loop if called from the thread
+  // of the dispatcher. A peer on the same dispatcher gets its data without waiting for the next
+  // poll of the event loop.
   void activateIfEnabled(uint32_t events);
 
+  // The number of callbacks after which activateIfEnabled() defers the events to the next iteration
+  // of the event loop. This bounds the callbacks a pair of handles ping-ponging data can run in an
+  // iteration without letting the other events of the dispatcher in.
+  static constexpr uint32_t MaxCallbacksPerIteration = 16;
+
 private:
   // This class maintains the ephemeral events and enabled events.
   class EventListener {
@@ -65,9 +73,18 @@ private:
   // Used to populate the event operations of enable and activate.
   EventListener event_listener_;
 
+  Event::Dispatcher& dispatcher_;
+
   // The handle to registered async callback from dispatcher.
   Event::SchedulableCallbackPtr schedulable_;
 
+  // Whether the peer activated events may be delivered in the current iteration of the event loop.
+  const bool activate_in_current_iteration_;
+  // The iteration of the event loop of the last callback, identified by its approximate time, and
+  // the number of callbacks run in it.
+  MonotonicTime callbacks_iteration_{};
+  uint32_t iteration_callbacks_{};
+
   // Supplies readable and writable status.
   IoHandle& io_source_;
 };
@@ -20,7 +20,8 @@ ActiveTcpListener::ActiveTcpListener(Network::TcpConnectionHandler& parent,
     : OwnedActiveStreamListenerBase(
           parent, parent.dispatcher(),
           parent.dispatcher().createListener(std::move(socket), *this, runtime, config.bindToPort(),
-                                             config.ignoreGlobalConnLimit()),
+                                             config.ignoreGlobalConnLimit(),
+                                             config.maxConnectionsToAcceptPerSocketEvent()),
           config),
       tcp_conn_handler_(parent), connection_balancer_(connection_balancer),
       listen_address_(listen_address) {
@@ -97,6 +98,11 @@ void ActiveTcpListener::onReject(RejectCause cause) {
   case RejectCause::OverloadAction:
     stats_.downstream_cx_overload_reject_.inc();
     break;
+  case RejectCause::ListenerCxLimit:
+    ENVOY_LOG(trace, "closing connection: listener connection limit reached for {}",
+              config_->name());
+    stats_.downstream_cx_overflow_.inc();
+    break;
   }
 }
 
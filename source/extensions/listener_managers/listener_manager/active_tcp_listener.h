@@ -36,7 +36,8 @@ public:
                     Network::ConnectionBalancer& connection_balancer, Runtime::Loader& runtime);
   ~ActiveTcpListener() override;
 
-  bool listenerConnectionLimitReached() const {
+  // Network::TcpListenerCallbacks
+  bool listenerConnectionLimitReached() const override {
     // TODO(tonya11en): Delegate enforcement of per-listener connection limits to overload
     // manager.
     return !config_->openConnections().canCreate();
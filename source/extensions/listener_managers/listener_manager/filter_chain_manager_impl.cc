@@ -216,6 +216,8 @@ void FilterChainManagerImpl::addFilterChains(
       filter_chains;
   uint32_t new_filter_chain_size = 0;
   FilterChainsByName filter_chains_by_name;
+  // Avoid rehashing the map while the filter chains are added.
+  fc_contexts_.reserve(filter_chain_span.size());
 
   for (const auto& filter_chain : filter_chain_span) {
     const auto& filter_chain_match = filter_chain->filter_chain_match();
@@ -240,7 +242,8 @@ void FilterChainManagerImpl::addFilterChains(
     // Reuse created filter chain if possible.
     // FilterChainManager maintains the lifetime of FilterChainFactoryContext
     // ListenerImpl maintains the dependencies of FilterChainFactoryContext
-    auto filter_chain_impl = findExistingFilterChain(*filter_chain);
+    HashedFilterChainMessage filter_chain_message(*filter_chain);
+    auto filter_chain_impl = findExistingFilterChain(filter_chain_message);
     if (filter_chain_impl == nullptr) {
       filter_chain_impl =
           filter_chain_factory_builder.buildFilterChain(*filter_chain, context_creator);
@@ -304,7 +307,7 @@ void FilterChainManagerImpl::addFilterChains(
           filter_chain_impl);
     }
 
-    fc_contexts_[*filter_chain] = filter_chain_impl;
+    fc_contexts_.insert_or_assign(std::move(filter_chain_message), filter_chain_impl);
   }
   convertIPsToTries();
   copyOrRebuildDefaultFilterChain(default_filter_chain, filter_chain_factory_builder,
@@ -527,22 +530,61 @@ namespace {
 
 // Template function for creating a CIDR list entry for either source or destination address.
 template <class T>
-std::pair<T, std::vector<Network::Address::CidrRange>> makeCidrListEntry(const std::string& cidr,
-                                                                         const T& data) {
-  std::vector<Network::Address::CidrRange> subnets;
+std::pair<T, std::vector<Network::Address::CidrRange>>
+makeCidrListEntry(const std::string& cidr, const T& data,
+                  const std::vector<Network::Address::CidrRange>& catch_all_ranges) {
   if (cidr == EMPTY_STRING) {
-    if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET)) {
-      subnets.push_back(
-          Network::Address::CidrRange::create(Network::Utility::getIpv4CidrCatchAllAddress()));
+    return {data, catch_all_ranges};
+  }
+  return {data, {Network::Address::CidrRange::create(cidr)}};
+}
+
+// Template function for creating the trie of the source or destination addresses of a map. The
+// trie isn't built for an empty map, or a map only holding the catch-all entry, which is the case
+// of most maps when filter chains only match on server names or ports.
+template <class T>
+std::unique_ptr<Network::LcTrie::LcTrie<T>>
+makeCidrTrie(const absl::flat_hash_map<std::string, T>& ips_map,
+             const std::vector<Network::Address::CidrRange>& catch_all_ranges) {
+  if (ips_map.empty() || (ips_map.size() == 1 && ips_map.begin()->first == EMPTY_STRING)) {
+    return nullptr;
+  }
+  std::vector<std::pair<T, std::vector<Network::Address::CidrRange>>> ips_list;
+  ips_list.reserve(ips_map.size());
+  for (const auto& [ip, data] : ips_map) {
+    ips_list.push_back(makeCidrListEntry(ip, data, catch_all_ranges));
+  }
+  return std::make_unique<Network::LcTrie::LcTrie<T>>(ips_list, true);
+}
+
+// Template function for matching an address against the map and the trie built by
+// makeCidrTrie(), returning the data of the most specific CIDR range holding the address.
+template <class T>
+const typename T::element_type*
+findCidrRangeData(const absl::flat_hash_map<std::string, T>& ips_map,
+                  const Network::LcTrie::LcTrie<T>* ips_trie,
+                  const Network::Address::InstanceConstSharedPtr& address,
+                  const std::vector<Network::Address::CidrRange>& catch_all_ranges) {
+  if (ips_trie == nullptr) {
+    if (ips_map.empty()) {
+      return nullptr;
     }
-    if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET6)) {
-      subnets.push_back(
-          Network::Address::CidrRange::create(Network::Utility::getIpv6CidrCatchAllAddress()));
+    ASSERT(ips_map.size() == 1);
+    for (const auto& range : catch_all_ranges) {
+      if (range.isInRange(*address)) {
+        return ips_map.begin()->second.get();
+      }
     }
-  } else {
-    subnets.push_back(Network::Address::CidrRange::create(cidr));
+    return nullptr;
+  }
+
+  // Match on both: exact IP and wider CIDR ranges using LcTrie.
+  const auto data = ips_trie->getDataView(address);
+  if (data.empty()) {
+    return nullptr;
   }
-  return std::make_pair<T, std::vector<Network::Address::CidrRange>>(T(data), std::move(subnets));
+  ASSERT(data.size() == 1);
+  return data.back().get();
 }
 
 }; // namespace
@@ -561,7 +603,7 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   if (address->type() == Network::Address::Type::Ip) {
     const auto port_match = destination_ports_map_.find(address->ip()->port());
     if (port_match != destination_ports_map_.end()) {
-      best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+      best_match_filter_chain = findFilterChainForDestinationIP(port_match->second, socket);
       if (best_match_filter_chain != nullptr) {
         return best_match_filter_chain;
       } else {
@@ -574,7 +616,7 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   // Match on catch-all port 0 if there is no specific port sub tree.
   const auto port_match = destination_ports_map_.find(0);
   if (port_match != destination_ports_map_.end()) {
-    best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+    best_match_filter_chain = findFilterChainForDestinationIP(port_match->second, socket);
   }
   return best_match_filter_chain != nullptr
              ? best_match_filter_chain
@@ -598,17 +640,18 @@ FilterChainManagerImpl::findFilterChainUsingMatcher(const Network::ConnectionSoc
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinationIP(
-    const DestinationIPsTrie& destination_ips_trie, const Network::ConnectionSocket& socket) const {
+    const std::pair<DestinationIPsMap, DestinationIPsTriePtr>& destination_ips_pair,
+    const Network::ConnectionSocket& socket) const {
   auto address = socket.connectionInfoProvider().localAddress();
   if (address->type() != Network::Address::Type::Ip) {
     address = FilterChain::fakeAddress();
   }
 
-  // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = destination_ips_trie.getData(address);
-  if (!data.empty()) {
-    ASSERT(data.size() == 1);
-    return findFilterChainForServerName(*data.back(), socket);
+  const ServerNamesMap* server_names_map =
+      findCidrRangeData(destination_ips_pair.first, destination_ips_pair.second.get(), address,
+                        catch_all_ranges_);
+  if (server_names_map != nullptr) {
+    return findFilterChainForServerName(*server_names_map, socket);
   }
 
   return nullptr;
@@ -617,7 +660,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
   ASSERT(absl::AsciiStrToLower(socket.requestedServerName()) == socket.requestedServerName());
-  const std::string server_name(socket.requestedServerName());
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
@@ -628,7 +671,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
   // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
   size_t pos = server_name.find('.', 1);
   while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
+    const absl::string_view wildcard = server_name.substr(pos);
     const auto server_name_wildcard_match = server_names_map.find(wildcard);
     if (server_name_wildcard_match != server_names_map.end()) {
       return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
@@ -648,7 +691,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
+  const absl::string_view transport_protocol = socket.detectedTransportProtocol();
 
   // Match on exact transport protocol, e.g. "tls".
   const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
@@ -672,31 +715,32 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForApplicatio
   for (const auto& application_protocol : socket.requestedApplicationProtocols()) {
     const auto application_protocol_match = application_protocols_map.find(application_protocol);
     if (application_protocol_match != application_protocols_map.end()) {
-      return findFilterChainForDirectSourceIP(*application_protocol_match->second.second, socket);
+      return findFilterChainForDirectSourceIP(application_protocol_match->second, socket);
     }
   }
 
   // Match on a filter chain without application protocol requirements.
   const auto any_protocol_match = application_protocols_map.find(EMPTY_STRING);
   if (any_protocol_match != application_protocols_map.end()) {
-    return findFilterChainForDirectSourceIP(*any_protocol_match->second.second, socket);
+    return findFilterChainForDirectSourceIP(any_protocol_match->second, socket);
   }
 
   return nullptr;
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDirectSourceIP(
-    const DirectSourceIPsTrie& direct_source_ips_trie,
+    const DirectSourceIPsPair& direct_source_ips_pair,
     const Network::ConnectionSocket& socket) const {
   auto address = socket.connectionInfoProvider().directRemoteAddress();
   if (address->type() != Network::Address::Type::Ip) {
     address = FilterChain::fakeAddress();
   }
 
-  const auto& data = direct_source_ips_trie.getData(address);
-  if (!data.empty()) {
-    ASSERT(data.size() == 1);
-    return findFilterChainForSourceTypes(*data.back(), socket);
+  const SourceTypesArray* source_types =
+      findCidrRangeData(direct_source_ips_pair.first, direct_source_ips_pair.second.get(), address,
+                        catch_all_ranges_);
+  if (source_types != nullptr) {
+    return findFilterChainForSourceTypes(*source_types, socket);
   }
 
   return nullptr;
@@ -719,38 +763,38 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceType
 
   if (is_local_connection) {
     if (!filter_chain_local.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_local.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_local, socket);
     }
   } else {
     if (!filter_chain_external.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_external.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_external, socket);
     }
   }
 
   const auto& filter_chain_any = source_types[envoy::config::listener::v3::FilterChainMatch::ANY];
 
   if (!filter_chain_any.first.empty()) {
-    return findFilterChainForSourceIpAndPort(*filter_chain_any.second, socket);
+    return findFilterChainForSourceIpAndPort(filter_chain_any, socket);
   } else {
     return nullptr;
   }
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAndPort(
-    const SourceIPsTrie& source_ips_trie, const Network::ConnectionSocket& socket) const {
+    const std::pair<SourceIPsMap, SourceIPsTriePtr>& source_ips_pair,
+    const Network::ConnectionSocket& socket) const {
   auto address = socket.connectionInfoProvider().remoteAddress();
   if (address->type() != Network::Address::Type::Ip) {
     address = FilterChain::fakeAddress();
   }
 
-  // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = source_ips_trie.getData(address);
-  if (data.empty()) {
+  const SourcePortsMap* source_ports_map_ptr = findCidrRangeData(
+      source_ips_pair.first, source_ips_pair.second.get(), address, catch_all_ranges_);
+  if (source_ports_map_ptr == nullptr) {
     return nullptr;
   }
 
-  ASSERT(data.size() == 1);
-  const auto& source_ports_map = *data.back();
+  const auto& source_ports_map = *source_ports_map_ptr;
   const uint32_t source_port = address->ip()->port();
   const auto port_match = source_ports_map.find(source_port);
 
@@ -771,20 +815,27 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAn
 }
 
 void FilterChainManagerImpl::convertIPsToTries() {
+  // The catch-all entries cover the IP families supported by the host. Probing them opens sockets,
+  // so it is done once rather than for each catch-all entry.
+  catch_all_ranges_.clear();
+  if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET)) {
+    catch_all_ranges_.push_back(
+        Network::Address::CidrRange::create(Network::Utility::getIpv4CidrCatchAllAddress()));
+  }
+  if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET6)) {
+    catch_all_ranges_.push_back(
+        Network::Address::CidrRange::create(Network::Utility::getIpv6CidrCatchAllAddress()));
+  }
+
   for (auto& [destination_port, destination_ips_pair] : destination_ports_map_) {
     UNREFERENCED_PARAMETER(destination_port);
-    // These variables are used as we build up the destination CIDRs used for the trie.
     auto& [destination_ips_map, destination_ips_trie] = destination_ips_pair;
-    std::vector<std::pair<ServerNamesMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-        destination_ips_list;
-    destination_ips_list.reserve(destination_ips_map.size());
 
+    // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
+    // We need to get access to all of the source IP strings so that we can convert them into
+    // a trie like we do for the destination IPs.
     for (const auto& [destination_ip, server_names_map_ptr] : destination_ips_map) {
-      destination_ips_list.push_back(makeCidrListEntry(destination_ip, server_names_map_ptr));
-
-      // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
-      // We need to get access to all of the source IP strings so that we can convert them into
-      // a trie like we did for the destination IPs above.
+      UNREFERENCED_PARAMETER(destination_ip);
       for (auto& [server_name, transport_protocols_map] : *server_names_map_ptr) {
         UNREFERENCED_PARAMETER(server_name);
         for (auto& [transport_protocol, application_protocols_map] : transport_protocols_map) {
@@ -793,41 +844,24 @@ void FilterChainManagerImpl::convertIPsToTries() {
             UNREFERENCED_PARAMETER(application_protocol);
             auto& [direct_source_ips_map, direct_source_ips_trie] = direct_source_ips_pair;
 
-            std::vector<
-                std::pair<SourceTypesArraySharedPtr, std::vector<Network::Address::CidrRange>>>
-                direct_source_ips_list;
-            direct_source_ips_list.reserve(direct_source_ips_map.size());
-
             for (auto& [direct_source_ip, source_arrays_ptr] : direct_source_ips_map) {
-              direct_source_ips_list.push_back(
-                  makeCidrListEntry(direct_source_ip, source_arrays_ptr));
-
+              UNREFERENCED_PARAMETER(direct_source_ip);
               for (auto& [source_ips_map, source_ips_trie] : *source_arrays_ptr) {
-                std::vector<
-                    std::pair<SourcePortsMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-                    source_ips_list;
-                source_ips_list.reserve(source_ips_map.size());
-
-                for (auto& [source_ip, source_port_map_ptr] : source_ips_map) {
-                  source_ips_list.push_back(makeCidrListEntry(source_ip, source_port_map_ptr));
-                }
-
-                source_ips_trie = std::make_unique<SourceIPsTrie>(source_ips_list, true);
+                source_ips_trie = makeCidrTrie(source_ips_map, catch_all_ranges_);
               }
             }
-            direct_source_ips_trie =
-                std::make_unique<DirectSourceIPsTrie>(direct_source_ips_list, true);
+            direct_source_ips_trie = makeCidrTrie(direct_source_ips_map, catch_all_ranges_);
           }
         }
       }
     }
 
-    destination_ips_trie = std::make_unique<DestinationIPsTrie>(destination_ips_list, true);
+    destination_ips_trie = makeCidrTrie(destination_ips_map, catch_all_ranges_);
   }
 }
 
 Network::DrainableFilterChainSharedPtr FilterChainManagerImpl::findExistingFilterChain(
-    const envoy::config::listener::v3::FilterChain& filter_chain_message) {
+    const HashedFilterChainMessage& filter_chain_message) {
   // Origin filter chain manager could be empty if the current is the ancestor.
   const auto* origin = getOriginFilterChainManager();
   if (origin == nullptr) {
@@ -835,8 +869,6 @@ Network::DrainableFilterChainSharedPtr FilterChainManagerImpl::findExistingFilte
   }
   auto iter = origin->fc_contexts_.find(filter_chain_message);
   if (iter != origin->fc_contexts_.end()) {
-    // copy the context to this filter chain manager.
-    fc_contexts_.emplace(filter_chain_message, iter->second);
     return iter->second;
   }
   return nullptr;
@@ -20,6 +20,7 @@
 #include "source/common/init/manager_impl.h"
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/lc_trie.h"
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/listener_managers/listener_manager/filter_chain_factory_context_callback.h"
 #include "source/server/factory_context_impl.h"
 
@@ -143,6 +144,33 @@ private:
   const std::string name_;
 };
 
+/**
+ * A filter chain message along with its hash, computed once when the filter chain is added to a
+ * filter chain manager. Hashing prints the whole message, including any inline certificates, so
+ * the lookups done while reusing and diffing the filter chains of listener updates use the stored
+ * hash instead.
+ */
+class HashedFilterChainMessage {
+public:
+  explicit HashedFilterChainMessage(const envoy::config::listener::v3::FilterChain& message)
+      : message_(message), hash_(MessageUtil::hash(message_)) {}
+
+  const envoy::config::listener::v3::FilterChain& message() const { return message_; }
+  std::size_t hash() const { return hash_; }
+
+  bool operator==(const HashedFilterChainMessage& rhs) const {
+    return hash_ == rhs.hash_ && MessageUtil()(message_, rhs.message_);
+  }
+
+  template <typename H> friend H AbslHashValue(H h, const HashedFilterChainMessage& message) {
+    return H::combine(std::move(h), message.hash_);
+  }
+
+private:
+  envoy::config::listener::v3::FilterChain message_;
+  std::size_t hash_;
+};
+
 /**
  * Implementation of FilterChainManager. It owns and exchange filter chains.
  */
@@ -151,8 +179,7 @@ class FilterChainManagerImpl : public Network::FilterChainManager,
                                Logger::Loggable<Logger::Id::config> {
 public:
   using FcContextMap =
-      absl::flat_hash_map<envoy::config::listener::v3::FilterChain,
-                          Network::DrainableFilterChainSharedPtr, MessageUtil, MessageUtil>;
+      absl::flat_hash_map<HashedFilterChainMessage, Network::DrainableFilterChainSharedPtr>;
   FilterChainManagerImpl(const std::vector<Network::Address::InstanceConstSharedPtr>& addresses,
                          Configuration::FactoryContext& factory_context,
                          Init::Manager& init_manager)
@@ -292,9 +319,9 @@ private:
                                     uint32_t source_port,
                                     const Network::FilterChainSharedPtr& filter_chain);
 
-  const Network::FilterChain*
-  findFilterChainForDestinationIP(const DestinationIPsTrie& destination_ips_trie,
-                                  const Network::ConnectionSocket& socket) const;
+  const Network::FilterChain* findFilterChainForDestinationIP(
+      const std::pair<DestinationIPsMap, DestinationIPsTriePtr>& destination_ips_pair,
+      const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForServerName(const ServerNamesMap& server_names_map,
                                const Network::ConnectionSocket& socket) const;
@@ -305,20 +332,20 @@ private:
   findFilterChainForApplicationProtocols(const ApplicationProtocolsMap& application_protocols_map,
                                          const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
-  findFilterChainForDirectSourceIP(const DirectSourceIPsTrie& direct_source_ips_trie,
+  findFilterChainForDirectSourceIP(const DirectSourceIPsPair& direct_source_ips_pair,
                                    const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForSourceTypes(const SourceTypesArray& source_types,
                                 const Network::ConnectionSocket& socket) const;
 
-  const Network::FilterChain*
-  findFilterChainForSourceIpAndPort(const SourceIPsTrie& source_ips_trie,
-                                    const Network::ConnectionSocket& socket) const;
+  const Network::FilterChain* findFilterChainForSourceIpAndPort(
+      const std::pair<SourceIPsMap, SourceIPsTriePtr>& source_ips_pair,
+      const Network::ConnectionSocket& socket) const;
 
   const FilterChainManagerImpl* getOriginFilterChainManager() { return origin_.value(); }
-  // Duplicate the inherent factory context if any.
+  // Return the filter chain of the origin built from the same message, if any.
   Network::DrainableFilterChainSharedPtr
-  findExistingFilterChain(const envoy::config::listener::v3::FilterChain& filter_chain_message);
+  findExistingFilterChain(const HashedFilterChainMessage& filter_chain_message);
 
   // Mapping from filter chain message to filter chain. This is used by LDS response handler to
   // detect the filter chains in the intersection of existing listener and new listener.
@@ -330,8 +357,10 @@ private:
   Network::DrainableFilterChainSharedPtr default_filter_chain_;
 
   // Mapping of FilterChain's configured destination ports, IPs, server names, transport protocols
-  // and application protocols, using structures defined above.
+  // and application protocols, using structures defined above. The tries are null for the maps
+  // only holding the catch-all entry, which matches the addresses in catch_all_ranges_.
   DestinationPortsMap destination_ports_map_;
+  std::vector<Network::Address::CidrRange> catch_all_ranges_;
 
   const std::vector<Network::Address::InstanceConstSharedPtr>& addresses_;
   // This is the reference to a factory context which all the generations of listener share.
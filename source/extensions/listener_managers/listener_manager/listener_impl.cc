@@ -324,6 +324,9 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
           added_via_api_ ? parent_.server_.messageValidationContext().dynamicValidationVisitor()
                          : parent_.server_.messageValidationContext().staticValidationVisitor()),
       ignore_global_conn_limit_(config.ignore_global_conn_limit()),
+      max_connections_to_accept_per_socket_event_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connections_to_accept_per_socket_event,
+                                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent)),
       listener_init_target_(fmt::format("Listener-init-target {}", name),
                             [this]() { dynamic_init_manager_->initialize(local_init_watcher_); }),
       dynamic_init_manager_(std::make_unique<Init::ManagerImpl>(
@@ -422,6 +425,7 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
     buildOriginalDstListenerFilter();
     buildProxyProtocolListenerFilter();
     buildInternalListener();
+    buildReusePortSteering();
   }
   if (!workers_started_) {
     // Initialize dynamic_init_manager_ from Server's init manager if it's not initialized.
@@ -451,6 +455,9 @@ ListenerImpl::ListenerImpl(ListenerImpl& origin,
           added_via_api_ ? parent_.server_.messageValidationContext().dynamicValidationVisitor()
                          : parent_.server_.messageValidationContext().staticValidationVisitor()),
       ignore_global_conn_limit_(config.ignore_global_conn_limit()),
+      max_connections_to_accept_per_socket_event_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connections_to_accept_per_socket_event,
+                                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent)),
       // listener_init_target_ is not used during in place update because we expect server started.
       listener_init_target_("", nullptr),
       dynamic_init_manager_(std::make_unique<Init::ManagerImpl>(
@@ -488,6 +495,7 @@ ListenerImpl::ListenerImpl(ListenerImpl& origin,
     buildSocketOptions();
     buildOriginalDstListenerFilter();
     buildProxyProtocolListenerFilter();
+    buildReusePortSteering();
     open_connections_ = origin.open_connections_;
   }
 }
@@ -752,6 +760,33 @@ void ListenerImpl::buildFilterChains() {
       *filter_chain_manager_);
 }
 
+void ListenerImpl::buildReusePortSteering() {
+  if (!config_.has_reuse_port_steering()) {
+    return;
+  }
+  const uint32_t concurrency = parent_.server_.options().concurrency();
+  if (!reuse_port_ || !bind_to_port_ || concurrency < 2) {
+    ENVOY_LOG(warn,
+              "listener {}: reuse_port_steering is ignored, as it requires enable_reuse_port, "
+              "bind_to_port and more than one worker",
+              name_);
+    return;
+  }
+  if (concurrency > ReusePortSteering::MaxWorkers) {
+    throw EnvoyException(fmt::format("listener {}: reuse_port_steering supports up to {} workers",
+                                     name_, ReusePortSteering::MaxWorkers));
+  }
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  reuse_port_steering_ = std::make_unique<ReusePortSteering>(
+      parent_.server_.dispatcher(), listenerScope(), concurrency,
+      std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(config_.reuse_port_steering(), update_interval, 1000)),
+      socket_factories_);
+#else
+  ENVOY_LOG(warn, "listener {}: reuse_port_steering is not supported on this platform", name_);
+#endif
+}
+
 void ListenerImpl::buildConnectionBalancer(const Network::Address::Instance& address) {
   auto iter = connection_balancers_.find(address.asString());
   if (iter == connection_balancers_.end() && socket_type_ == Network::Socket::Type::Stream) {
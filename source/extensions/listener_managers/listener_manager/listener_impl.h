@@ -23,6 +23,7 @@
 #include "source/common/init/target_impl.h"
 #include "source/common/quic/quic_stat_names.h"
 #include "source/extensions/listener_managers/listener_manager/filter_chain_manager_impl.h"
+#include "source/extensions/listener_managers/listener_manager/reuse_port_steering.h"
 #include "source/server/transport_socket_config_impl.h"
 
 namespace Envoy {
@@ -379,6 +380,9 @@ public:
   uint32_t tcpBacklogSize() const override { return tcp_backlog_size_; }
   Init::Manager& initManager() override;
   bool ignoreGlobalConnLimit() const override { return ignore_global_conn_limit_; }
+  uint32_t maxConnectionsToAcceptPerSocketEvent() const override {
+    return max_connections_to_accept_per_socket_event_;
+  }
   envoy::config::core::v3::TrafficDirection direction() const override {
     return config().traffic_direction();
   }
@@ -458,6 +462,7 @@ private:
   void validateFilterChains();
   void buildFilterChains();
   void buildConnectionBalancer(const Network::Address::Instance& address);
+  void buildReusePortSteering();
   void buildSocketOptions();
   void buildOriginalDstListenerFilter();
   void buildProxyProtocolListenerFilter();
@@ -487,6 +492,7 @@ private:
   const uint32_t tcp_backlog_size_;
   ProtobufMessage::ValidationVisitor& validation_visitor_;
   const bool ignore_global_conn_limit_;
+  const uint32_t max_connections_to_accept_per_socket_event_;
 
   // A target is added to Server's InitManager if workers_started_ is false.
   Init::TargetImpl listener_init_target_;
@@ -508,6 +514,8 @@ private:
   // The key is the address string, the value is the address specific connection balancer.
   // TODO (soulxu): Add hash support for address, then needn't a string address as key anymore.
   absl::flat_hash_map<std::string, Network::ConnectionBalancerSharedPtr> connection_balancers_;
+  // Refers to socket_factories_, so it must be destroyed first.
+  ReusePortSteeringPtr reuse_port_steering_;
   std::shared_ptr<PerListenerFactoryContextImpl> listener_factory_context_;
   std::unique_ptr<FilterChainManagerImpl> filter_chain_manager_;
   const bool reuse_port_;
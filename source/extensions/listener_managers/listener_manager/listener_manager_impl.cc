@@ -257,12 +257,27 @@ Network::SocketSharedPtr ProdListenerComponentFactory::createListenSocket(
     }
   }
 
+  Network::Socket::OptionsSharedPtr socket_options = options;
+  const std::vector<uint32_t>& worker_cpus = server_.options().workerCpus();
+  if (bind_type == BindType::ReusePort && !worker_cpus.empty()) {
+    // Each worker has its own socket in the reuse_port group. Have the kernel prefer the socket of
+    // the worker pinned to the CPU that received the packet, so that connections stay on the CPU,
+    // and the NUMA node, of the NIC queue they arrived on.
+    socket_options = std::make_shared<Network::Socket::Options>();
+    if (options != nullptr) {
+      Network::Socket::appendOptions(socket_options, options);
+    }
+    Network::Socket::appendOptions(socket_options,
+                                   Network::SocketOptionFactory::buildIncomingCpuOptions(
+                                       worker_cpus[worker_index % worker_cpus.size()]));
+  }
+
   if (socket_type == Network::Socket::Type::Stream) {
     return std::make_shared<Network::TcpListenSocket>(
-        address, options, bind_type != BindType::NoBind, creation_options);
+        address, socket_options, bind_type != BindType::NoBind, creation_options);
   } else {
     return std::make_shared<Network::UdpListenSocket>(
-        address, options, bind_type != BindType::NoBind, creation_options);
+        address, socket_options, bind_type != BindType::NoBind, creation_options);
   }
 }
 
@@ -0,0 +1,103 @@
+#include "source/extensions/listener_managers/listener_manager/reuse_port_steering.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Server {
+
+ReusePortSteering::ReusePortSteering(
+    Event::Dispatcher& dispatcher, Stats::Scope& listener_scope, uint32_t concurrency,
+    std::chrono::milliseconds update_interval,
+    const std::vector<Network::ListenSocketFactoryPtr>& socket_factories)
+    : update_interval_(update_interval), socket_factories_(socket_factories) {
+  ASSERT(concurrency > 1 && concurrency <= MaxWorkers);
+  for (uint32_t i = 0; i < concurrency; ++i) {
+    // The per worker stats of the listener, see ActiveListenerImplBase.
+    active_connections_.push_back(listener_scope.gaugeFromString(
+        absl::StrCat("worker_", i, ".downstream_cx_active"), Stats::Gauge::ImportMode::Accumulate));
+  }
+  update_timer_ = dispatcher.createTimer([this]() { update(); });
+  update_timer_->enableTimer(update_interval_);
+}
+
+std::vector<uint32_t> ReusePortSteering::weights(const std::vector<uint64_t>& active_connections) {
+  ASSERT(!active_connections.empty());
+  const uint64_t min_connections =
+      *std::min_element(active_connections.begin(), active_connections.end());
+  std::vector<uint32_t> weights;
+  weights.reserve(active_connections.size());
+  for (const uint64_t connections : active_connections) {
+    weights.push_back(
+        std::max<uint64_t>(1, WeightScale * (min_connections + 1) / (connections + 1)));
+  }
+  return weights;
+}
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+std::vector<sock_filter> ReusePortSteering::buildProgram(const std::vector<uint32_t>& weights) {
+  const uint32_t num_sockets = weights.size();
+  ASSERT(num_sockets > 0 && num_sockets <= MaxWorkers);
+  uint32_t total_weight = 0;
+  for (const uint32_t weight : weights) {
+    total_weight += weight;
+  }
+
+  // The hash of the connection, modulo the total weight, is compared with the cumulative weights
+  // of the sockets. Each comparison jumps to the return of its socket when the hash is lower: the
+  // returns are laid out in socket order after the comparisons, so that the jumps all have the
+  // same offset.
+  std::vector<sock_filter> program;
+  program.reserve(2 * num_sockets + 1);
+  program.push_back(
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_RXHASH)});
+  program.push_back({BPF_ALU | BPF_MOD | BPF_K, 0, 0, total_weight});
+  uint32_t cumulative_weight = 0;
+  for (uint32_t i = 0; i + 1 < num_sockets; ++i) {
+    cumulative_weight += weights[i];
+    program.push_back(
+        {BPF_JMP | BPF_JGE | BPF_K, 0, static_cast<uint8_t>(num_sockets - 1), cumulative_weight});
+  }
+  program.push_back({BPF_RET | BPF_K, 0, 0, num_sockets - 1});
+  for (uint32_t i = 0; i + 1 < num_sockets; ++i) {
+    program.push_back({BPF_RET | BPF_K, 0, 0, i});
+  }
+  return program;
+}
+#endif
+
+void ReusePortSteering::update() {
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  std::vector<uint64_t> active_connections;
+  active_connections.reserve(active_connections_.size());
+  for (const Stats::Gauge& gauge : active_connections_) {
+    active_connections.push_back(gauge.value());
+  }
+  std::vector<sock_filter> program = buildProgram(weights(active_connections));
+  sock_fprog prog;
+  prog.len = program.size();
+  prog.filter = program.data();
+
+  // The kernel copies the program, and replaces the program of the whole reuse port group.
+  for (const Network::ListenSocketFactoryPtr& socket_factory : socket_factories_) {
+    const Network::SocketSharedPtr socket = socket_factory->getListenSocket(0);
+    const Api::SysCallIntResult result =
+        socket->setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog));
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(warn,
+                "failed to attach the reuse port steering program of listener {}, new connections "
+                "are hashed by the kernel: {}",
+                socket_factory->localAddress()->asString(), errorDetails(result.errno_));
+      return;
+    }
+  }
+  update_timer_->enableTimer(update_interval_);
+#endif
+}
+
+} // namespace Server
+} // namespace Envoy
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/network/listener.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats.h"
+
+#include "source/common/common/logger.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * Steers the new connections of a TCP listener using reuse_port between the sockets of its
+ * workers, in inverse proportion to the active connections of the workers. A classic BPF program
+ * attached to the reuse port group of each listen socket maps the hash of a new connection to the
+ * index of a socket in the group, which is the index of its worker since the sockets are bound in
+ * worker order. The program is rebuilt periodically from the per worker downstream_cx_active
+ * gauges of the listener. If it can't be attached, the kernel hashing is left in place.
+ */
+class ReusePortSteering : Logger::Loggable<Logger::Id::config> {
+public:
+  ReusePortSteering(Event::Dispatcher& dispatcher, Stats::Scope& listener_scope,
+                    uint32_t concurrency, std::chrono::milliseconds update_interval,
+                    const std::vector<Network::ListenSocketFactoryPtr>& socket_factories);
+
+  /**
+   * @return the weight of each worker for new connections, in inverse proportion to its active
+   *         connections. Each weight is between 1 and WeightScale.
+   */
+  static std::vector<uint32_t> weights(const std::vector<uint64_t>& active_connections);
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  /**
+   * @return a program returning the index of a socket of the reuse port group, picked with the
+   *         given weights from the hash of the connection.
+   */
+  static std::vector<sock_filter> buildProgram(const std::vector<uint32_t>& weights);
+#endif
+
+  static constexpr uint32_t WeightScale = 1000;
+  // The program jumps over one instruction per worker, with 8 bit jump offsets.
+  static constexpr uint32_t MaxWorkers = 256;
+
+private:
+  void update();
+
+  const std::chrono::milliseconds update_interval_;
+  const std::vector<Network::ListenSocketFactoryPtr>& socket_factories_;
+  std::vector<std::reference_wrapper<Stats::Gauge>> active_connections_;
+  Event::TimerPtr update_timer_;
+};
+
+using ReusePortSteeringPtr = std::unique_ptr<ReusePortSteering>;
+
+} // namespace Server
+} // namespace Envoy
@@ -12,7 +12,8 @@ namespace Maglev {
 Upstream::ThreadAwareLoadBalancerPtr Factory::create(const Upstream::ClusterInfo& cluster_info,
                                                      const Upstream::PrioritySet& priority_set,
                                                      Runtime::Loader& runtime,
-                                                     Random::RandomGenerator& random, TimeSource&) {
+                                                     Random::RandomGenerator& random,
+                                                     TimeSource& time_source) {
 
   const auto* typed_config =
       dynamic_cast<const envoy::extensions::load_balancing_policies::maglev::v3::Maglev*>(
@@ -27,7 +28,7 @@ Upstream::ThreadAwareLoadBalancerPtr Factory::create(const Upstream::ClusterInfo
       priority_set, cluster_info.lbStats(), cluster_info.statsScope(), runtime, random,
       static_cast<uint32_t>(PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(
           cluster_info.lbConfig(), healthy_panic_threshold, 100, 50)),
-      *typed_config);
+      *typed_config, time_source);
 }
 
 /**
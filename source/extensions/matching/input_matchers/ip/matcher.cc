@@ -39,7 +39,7 @@ bool Matcher::match(absl::optional<absl::string_view> input) {
     ENVOY_LOG(debug, "IP matcher: unable to parse address '{}'", ip_str);
     return false;
   }
-  return !trie_.getData(ip).empty();
+  return !trie_.getDataView(ip).empty();
 }
 
 } // namespace IP
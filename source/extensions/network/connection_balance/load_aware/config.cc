@@ -0,0 +1,42 @@
+#include "source/extensions/network/connection_balance/load_aware/config.h"
+
+#include <algorithm>
+
+#include "envoy/config/core/v3/extension.pb.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/network/connection_balance/load_aware/connection_balancer_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+Envoy::Network::ConnectionBalancerSharedPtr
+LoadAwareConnectionBalanceFactory::createConnectionBalancerFromProto(
+    const Protobuf::Message& config, Server::Configuration::FactoryContext& context) {
+  const auto& typed_config =
+      dynamic_cast<const envoy::config::core::v3::TypedExtensionConfig&>(config);
+  const auto proto_config = MessageUtil::anyConvertAndValidate<
+      envoy::extensions::network::connection_balance::load_aware::v3::LoadAware>(
+      typed_config.typed_config(), context.messageValidationVisitor());
+
+  const std::chrono::microseconds loop_delay_tolerance(
+      proto_config.has_loop_delay_tolerance()
+          ? Protobuf::util::TimeUtil::DurationToMicroseconds(proto_config.loop_delay_tolerance())
+          : 1000);
+
+  // Each worker registers one handler per listener address.
+  return std::make_shared<LoadAwareConnectionBalancerImpl>(
+      std::max(context.options().concurrency(), 1u), context.api().randomGenerator(),
+      std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(proto_config, loop_delay_sample_interval, 100)),
+      loop_delay_tolerance);
+}
+
+REGISTER_FACTORY(LoadAwareConnectionBalanceFactory, Envoy::Network::ConnectionBalanceFactory);
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,138 @@
+#include "source/extensions/network/connection_balance/load_aware/connection_balancer_impl.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/extensions/listener_managers/listener_manager/active_tcp_listener.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(
+    uint32_t max_handlers, Random::RandomGenerator& random,
+    std::chrono::milliseconds sample_interval, std::chrono::microseconds loop_delay_tolerance)
+    : random_(random), sample_interval_(sample_interval),
+      loop_delay_tolerance_us_(loop_delay_tolerance.count()), slots_(max_handlers) {}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(
+    Envoy::Network::BalancedConnectionHandler& handler) {
+  // Only the TCP listeners of the workers are balanced.
+  auto& listener = dynamic_cast<Server::ActiveTcpListener&>(handler);
+  registerHandler(handler, listener.dispatcher());
+}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(
+    Envoy::Network::BalancedConnectionHandler& handler, Event::Dispatcher& dispatcher) {
+  ASSERT(dispatcher.isThreadSafe());
+  Thread::LockGuard lock(registration_lock_);
+  const uint32_t used_slots = used_slots_.load();
+  Slot* slot = nullptr;
+  for (uint32_t i = 0; i < used_slots; ++i) {
+    if (slots_[i].handler_.load() == nullptr) {
+      slot = &slots_[i];
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    if (used_slots == slots_.size()) {
+      // The handler keeps the connections it accepts, but doesn't get rebalanced ones.
+      ENVOY_BUG(false, fmt::format("more than {} handlers registered with the load aware balancer",
+                                   slots_.size()));
+      return;
+    }
+    slot = &slots_[used_slots];
+    used_slots_.store(used_slots + 1);
+  }
+
+  slot->loop_delay_us_.store(0, std::memory_order_relaxed);
+  slot->sample_timer_ =
+      dispatcher.createTimer([this, slot, &dispatcher]() { sample(*slot, dispatcher); });
+  slot->sample_due_ = dispatcher.timeSource().monotonicTime() + sample_interval_;
+  slot->sample_timer_->enableTimer(sample_interval_);
+  slot->handler_.store(&handler);
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(
+    Envoy::Network::BalancedConnectionHandler& handler) {
+  Thread::LockGuard lock(registration_lock_);
+  const uint32_t used_slots = used_slots_.load();
+  for (uint32_t i = 0; i < used_slots; ++i) {
+    if (slots_[i].handler_.load() == &handler) {
+      slots_[i].handler_.store(nullptr);
+      slots_[i].sample_timer_.reset();
+      return;
+    }
+  }
+}
+
+void LoadAwareConnectionBalancerImpl::sample(Slot& slot, Event::Dispatcher& dispatcher) {
+  const MonotonicTime now = dispatcher.timeSource().monotonicTime();
+  const uint64_t delay_us =
+      now > slot.sample_due_
+          ? std::chrono::duration_cast<std::chrono::microseconds>(now - slot.sample_due_).count()
+          : 0;
+  // Smooth the delays with a weight of 1/8 for the new sample, so that a single slow iteration of
+  // the loop doesn't steer connections away from the worker.
+  const uint64_t previous_us = slot.loop_delay_us_.load(std::memory_order_relaxed);
+  slot.loop_delay_us_.store(previous_us - previous_us / 8 + delay_us / 8,
+                            std::memory_order_relaxed);
+  slot.sample_due_ = now + sample_interval_;
+  slot.sample_timer_->enableTimer(sample_interval_);
+}
+
+bool LoadAwareConnectionBalancerImpl::lessLoaded(
+    Slot& a, Envoy::Network::BalancedConnectionHandler& a_handler, Slot& b,
+    Envoy::Network::BalancedConnectionHandler& b_handler) const {
+  const uint64_t a_delay_us = a.loop_delay_us_.load(std::memory_order_relaxed);
+  const uint64_t b_delay_us = b.loop_delay_us_.load(std::memory_order_relaxed);
+  if (a_delay_us + loop_delay_tolerance_us_ < b_delay_us) {
+    return true;
+  }
+  if (b_delay_us + loop_delay_tolerance_us_ < a_delay_us) {
+    return false;
+  }
+  return a_handler.numConnections() < b_handler.numConnections();
+}
+
+Envoy::Network::BalancedConnectionHandler& LoadAwareConnectionBalancerImpl::pickTargetHandler(
+    Envoy::Network::BalancedConnectionHandler& current_handler) {
+  const uint32_t used_slots = used_slots_.load();
+  Envoy::Network::BalancedConnectionHandler* picked = &current_handler;
+  if (used_slots > 1) {
+    // Two distinct random slots: the low bits pick the first one, the high bits its distance to
+    // the second one.
+    const uint64_t random = random_.random();
+    const uint32_t first = (random & 0xffffffff) % used_slots;
+    const uint32_t second = (first + 1 + (random >> 32) % (used_slots - 1)) % used_slots;
+    Envoy::Network::BalancedConnectionHandler* first_handler = slots_[first].handler_.load();
+    Envoy::Network::BalancedConnectionHandler* second_handler = slots_[second].handler_.load();
+    if (first_handler != nullptr && second_handler != nullptr) {
+      picked = lessLoaded(slots_[second], *second_handler, slots_[first], *first_handler)
+                   ? second_handler
+                   : first_handler;
+    } else if (first_handler != nullptr) {
+      picked = first_handler;
+    } else if (second_handler != nullptr) {
+      picked = second_handler;
+    }
+  }
+  picked->incNumConnections();
+  return *picked;
+}
+
+uint64_t LoadAwareConnectionBalancerImpl::loopDelayUs(
+    const Envoy::Network::BalancedConnectionHandler& handler) const {
+  const uint32_t used_slots = used_slots_.load();
+  for (uint32_t i = 0; i < used_slots; ++i) {
+    if (slots_[i].handler_.load() == &handler) {
+      return slots_[i].loop_delay_us_.load(std::memory_order_relaxed);
+    }
+  }
+  return 0;
+}
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
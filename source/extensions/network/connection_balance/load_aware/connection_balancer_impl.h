@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "envoy/common/random_generator.h"
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/network/connection_balancer.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/thread.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+/**
+ * Connection balancer picking the less loaded of two random handlers. The load of a handler is the
+ * delay of the event loop of its worker, measured by a periodic timer on that worker and published
+ * with an atomic. Ties within the tolerance are broken by the connection counts of the handlers.
+ *
+ * Handlers are held in a fixed number of slots, so that picks only read atomics and never take a
+ * lock. Registration and unregistration happen on the worker thread of the handler and are
+ * serialized with a mutex.
+ */
+class LoadAwareConnectionBalancerImpl : public Envoy::Network::ConnectionBalancer,
+                                        Logger::Loggable<Logger::Id::connection> {
+public:
+  LoadAwareConnectionBalancerImpl(uint32_t max_handlers, Random::RandomGenerator& random,
+                                  std::chrono::milliseconds sample_interval,
+                                  std::chrono::microseconds loop_delay_tolerance);
+
+  // Network::ConnectionBalancer
+  void registerHandler(Envoy::Network::BalancedConnectionHandler& handler) override;
+  void unregisterHandler(Envoy::Network::BalancedConnectionHandler& handler) override;
+  Envoy::Network::BalancedConnectionHandler&
+  pickTargetHandler(Envoy::Network::BalancedConnectionHandler& current_handler) override;
+
+  /**
+   * Registers a handler whose worker runs the given dispatcher. This must be called on the thread
+   * of the dispatcher, which samples the load of the handler.
+   */
+  void registerHandler(Envoy::Network::BalancedConnectionHandler& handler,
+                       Event::Dispatcher& dispatcher);
+
+  /**
+   * @return the smoothed loop delay of the worker of a registered handler, in microseconds.
+   */
+  uint64_t loopDelayUs(const Envoy::Network::BalancedConnectionHandler& handler) const;
+
+private:
+  struct Slot {
+    std::atomic<Envoy::Network::BalancedConnectionHandler*> handler_{nullptr};
+    std::atomic<uint64_t> loop_delay_us_{0};
+    // Only used on the worker thread of the handler.
+    Event::TimerPtr sample_timer_;
+    MonotonicTime sample_due_;
+  };
+
+  void sample(Slot& slot, Event::Dispatcher& dispatcher);
+  // Whether a is less loaded than b: a has a lower loop delay, or delays within the tolerance of
+  // each other and fewer connections.
+  bool lessLoaded(Slot& a, Envoy::Network::BalancedConnectionHandler& a_handler, Slot& b,
+                  Envoy::Network::BalancedConnectionHandler& b_handler) const;
+
+  Random::RandomGenerator& random_;
+  const std::chrono::milliseconds sample_interval_;
+  const uint64_t loop_delay_tolerance_us_;
+
+  // Never resized, so that picks can read the slots while handlers register.
+  std::vector<Slot> slots_;
+  // Number of slots that may hold a handler: the slots past it have never been used.
+  std::atomic<uint32_t> used_slots_{0};
+  Thread::MutexBasicLockable registration_lock_;
+};
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -23,10 +23,10 @@ class ExpressionDescriptor : public RateLimit::DescriptorProducer {
 public:
   ExpressionDescriptor(
       const envoy::extensions::rate_limit_descriptors::expr::v3::Descriptor& config,
-      Filters::Common::Expr::Builder& builder, const google::api::expr::v1alpha1::Expr& input_expr)
+      const google::api::expr::v1alpha1::Expr& input_expr)
       : input_expr_(input_expr), descriptor_key_(config.descriptor_key()),
         skip_if_error_(config.skip_if_error()) {
-    compiled_expr_ = Extensions::Filters::Common::Expr::createExpression(builder, input_expr_);
+    compiled_expr_ = Extensions::Filters::Common::Expr::getOrCreateExpression(input_expr_);
   }
 
   // Ratelimit::DescriptorProducer
@@ -50,7 +50,7 @@ private:
   const google::api::expr::v1alpha1::Expr input_expr_;
   const std::string descriptor_key_;
   const bool skip_if_error_;
-  Extensions::Filters::Common::Expr::ExpressionPtr compiled_expr_;
+  Extensions::Filters::Common::Expr::ExpressionSharedPtr compiled_expr_;
 };
 
 } // namespace
@@ -73,24 +73,16 @@ RateLimit::DescriptorProducerPtr ExprDescriptorFactory::createDescriptorProducer
       throw EnvoyException("Unable to parse descriptor expression: " +
                            parse_status.status().ToString());
     }
-    return std::make_unique<ExpressionDescriptor>(config, getOrCreateBuilder(),
-                                                  parse_status.value().expr());
+    return std::make_unique<ExpressionDescriptor>(config, parse_status.value().expr());
   }
 #endif
   case envoy::extensions::rate_limit_descriptors::expr::v3::Descriptor::kParsed:
-    return std::make_unique<ExpressionDescriptor>(config, getOrCreateBuilder(), config.parsed());
+    return std::make_unique<ExpressionDescriptor>(config, config.parsed());
   default:
     return nullptr;
   }
 }
 
-Filters::Common::Expr::Builder& ExprDescriptorFactory::getOrCreateBuilder() {
-  if (expr_builder_ == nullptr) {
-    expr_builder_ = Filters::Common::Expr::createBuilder(nullptr);
-  }
-  return *expr_builder_;
-}
-
 REGISTER_FACTORY(ExprDescriptorFactory, RateLimit::DescriptorProducerFactory);
 
 } // namespace Expr
@@ -0,0 +1,69 @@
+#include "source/extensions/resource_monitors/cgroup/cgroup_cpu_monitor.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+CgroupCpuMonitor::CgroupCpuMonitor(
+    const envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig& config,
+    CgroupStatsReaderPtr reader, TimeSource& time_source, uint32_t host_cpus)
+    : signal_(config.signal()), reader_(std::move(reader)), time_source_(time_source),
+      host_cpus_(std::max<uint32_t>(host_cpus, 1)) {}
+
+void CgroupCpuMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
+  TRY_ASSERT_MAIN_THREAD {
+    const CgroupStatsReader::CpuStats stats = reader_->cpuStats();
+    const MonotonicTime now = time_source_.monotonicTime();
+    Server::ResourceUsage usage;
+    usage.resource_pressure_ = previous_stats_.has_value() ? pressure(stats, now) : 0;
+    previous_stats_ = stats;
+    previous_time_ = now;
+    ENVOY_LOG_MISC(trace, "CgroupCpuMonitor: pressure={}", usage.resource_pressure_);
+    callbacks.onSuccess(usage);
+  }
+  END_TRY
+  catch (const EnvoyException& error) {
+    callbacks.onFailure(error);
+  }
+}
+
+double CgroupCpuMonitor::pressure(const CgroupStatsReader::CpuStats& stats,
+                                  MonotonicTime now) const {
+  switch (signal_) {
+  case envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig::THROTTLING: {
+    const uint64_t periods = stats.periods_ - std::min(stats.periods_, previous_stats_->periods_);
+    if (periods == 0) {
+      return 0;
+    }
+    const uint64_t throttled_periods =
+        stats.throttled_periods_ -
+        std::min(stats.throttled_periods_, previous_stats_->throttled_periods_);
+    return std::min(throttled_periods / static_cast<double>(periods), 1.0);
+  }
+  case envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig::UTILIZATION: {
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - previous_time_);
+    if (elapsed.count() <= 0 || stats.usage_ < previous_stats_->usage_) {
+      return 0;
+    }
+    const double allowed_cpus = stats.quota_cpus_.value_or(host_cpus_);
+    const double used_cpus =
+        (stats.usage_ - previous_stats_->usage_).count() / static_cast<double>(elapsed.count());
+    return allowed_cpus > 0 ? used_cpus / allowed_cpus : 0;
+  }
+  default:
+    break;
+  }
+  return 0;
+}
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
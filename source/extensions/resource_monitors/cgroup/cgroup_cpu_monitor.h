@@ -0,0 +1,42 @@
+#pragma once
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+#include "envoy/server/resource_monitor.h"
+
+#include "source/extensions/resource_monitors/cgroup/cgroup_stats_reader.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+/**
+ * CPU monitor of the cgroup of the process, reporting either its utilization of its quota or the
+ * fraction of its scheduling periods it was throttled in, over the interval since the previous
+ * update. The first update reports no pressure, as there is no interval yet.
+ */
+class CgroupCpuMonitor : public Server::ResourceMonitor {
+public:
+  CgroupCpuMonitor(const envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig& config,
+                   CgroupStatsReaderPtr reader, TimeSource& time_source, uint32_t host_cpus);
+
+  void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
+
+private:
+  double pressure(const CgroupStatsReader::CpuStats& stats, MonotonicTime now) const;
+
+  const envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig::Signal signal_;
+  CgroupStatsReaderPtr reader_;
+  TimeSource& time_source_;
+  const uint32_t host_cpus_;
+  absl::optional<CgroupStatsReader::CpuStats> previous_stats_;
+  MonotonicTime previous_time_;
+};
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,47 @@
+#include "source/extensions/resource_monitors/cgroup/cgroup_memory_monitor.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+CgroupMemoryMonitor::CgroupMemoryMonitor(
+    const envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig& config,
+    CgroupStatsReaderPtr reader)
+    : max_memory_bytes_(config.max_memory_bytes()), reader_(std::move(reader)) {}
+
+void CgroupMemoryMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
+  TRY_ASSERT_MAIN_THREAD {
+    const CgroupStatsReader::MemoryStats stats = reader_->memoryStats();
+    uint64_t limit = stats.limit_bytes_.value_or(max_memory_bytes_);
+    if (max_memory_bytes_ > 0) {
+      limit = std::min(limit, max_memory_bytes_);
+    }
+    if (limit == 0) {
+      throw EnvoyException("the cgroup has no memory limit and max_memory_bytes is not set");
+    }
+
+    // The inactive page cache is reclaimed before the cgroup runs out of memory.
+    const uint64_t working_set = stats.usage_bytes_ - std::min(stats.usage_bytes_,
+                                                               stats.inactive_file_bytes_);
+    Server::ResourceUsage usage;
+    usage.resource_pressure_ = working_set / static_cast<double>(limit);
+    ENVOY_LOG_MISC(trace, "CgroupMemoryMonitor: working_set={}, limit={}, pressure={}",
+                   working_set, limit, usage.resource_pressure_);
+    callbacks.onSuccess(usage);
+  }
+  END_TRY
+  catch (const EnvoyException& error) {
+    callbacks.onFailure(error);
+  }
+}
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
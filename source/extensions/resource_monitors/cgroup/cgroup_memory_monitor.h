@@ -0,0 +1,32 @@
+#pragma once
+
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+#include "envoy/server/resource_monitor.h"
+
+#include "source/extensions/resource_monitors/cgroup/cgroup_stats_reader.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+/**
+ * Working set memory monitor of the cgroup of the process, against the memory limit of the cgroup.
+ */
+class CgroupMemoryMonitor : public Server::ResourceMonitor {
+public:
+  CgroupMemoryMonitor(const envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig&
+                          config,
+                      CgroupStatsReaderPtr reader);
+
+  void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
+
+private:
+  const uint64_t max_memory_bytes_;
+  CgroupStatsReaderPtr reader_;
+};
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
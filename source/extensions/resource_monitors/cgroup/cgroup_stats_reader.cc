@@ -0,0 +1,125 @@
+#include "source/extensions/resource_monitors/cgroup/cgroup_stats_reader.h"
+
+#include <vector>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/fmt.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+namespace {
+
+// The cgroup v1 controllers report the absence of a memory limit as the largest page aligned
+// value instead, which is above this.
+constexpr uint64_t V1UnlimitedMemoryBytes = uint64_t(1) << 62;
+
+uint64_t parseValue(absl::string_view value, absl::string_view path) {
+  uint64_t parsed;
+  if (!absl::SimpleAtoi(absl::StripAsciiWhitespace(value), &parsed)) {
+    throw EnvoyException(fmt::format("invalid value '{}' in {}", value, path));
+  }
+  return parsed;
+}
+
+} // namespace
+
+CgroupStatsReader::CgroupStatsReader(Filesystem::Instance& file_system, absl::string_view root)
+    : file_system_(file_system), root_(root.empty() ? DefaultCgroupRoot : root),
+      v2_(file_system_.fileExists(absl::StrCat(root_, "/cgroup.controllers"))) {}
+
+std::string CgroupStatsReader::readFile(absl::string_view controller, absl::string_view name) {
+  // The files of a cgroup v2 cgroup are all in its directory, while each cgroup v1 controller has
+  // its own hierarchy.
+  const std::string path =
+      v2_ ? absl::StrCat(root_, "/", name) : absl::StrCat(root_, "/", controller, "/", name);
+  return file_system_.fileReadToEnd(path);
+}
+
+uint64_t CgroupStatsReader::readValue(absl::string_view controller, absl::string_view name) {
+  return parseValue(readFile(controller, name), name);
+}
+
+uint64_t CgroupStatsReader::readKeyedValue(absl::string_view controller, absl::string_view name,
+                                           absl::string_view key) {
+  const std::string contents = readFile(controller, name);
+  for (absl::string_view line : absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+    const std::pair<absl::string_view, absl::string_view> entry = absl::StrSplit(line, ' ');
+    if (entry.first == key) {
+      return parseValue(entry.second, name);
+    }
+  }
+  throw EnvoyException(fmt::format("missing {} in {}", key, name));
+}
+
+CgroupStatsReader::MemoryStats CgroupStatsReader::memoryStats() {
+  MemoryStats stats;
+  if (v2_) {
+    stats.usage_bytes_ = readValue("", "memory.current");
+    stats.inactive_file_bytes_ = readKeyedValue("", "memory.stat", "inactive_file");
+    const std::string limit = readFile("", "memory.max");
+    if (absl::StripAsciiWhitespace(limit) != "max") {
+      stats.limit_bytes_ = parseValue(limit, "memory.max");
+    }
+    return stats;
+  }
+
+  stats.usage_bytes_ = readValue("memory", "memory.usage_in_bytes");
+  // The total_ stats include the descendants of the cgroup, like the usage does.
+  stats.inactive_file_bytes_ = readKeyedValue("memory", "memory.stat", "total_inactive_file");
+  const uint64_t limit = readValue("memory", "memory.limit_in_bytes");
+  if (limit < V1UnlimitedMemoryBytes) {
+    stats.limit_bytes_ = limit;
+  }
+  return stats;
+}
+
+CgroupStatsReader::CpuStats CgroupStatsReader::cpuStats() {
+  CpuStats stats;
+  if (v2_) {
+    stats.usage_ = std::chrono::microseconds(readKeyedValue("", "cpu.stat", "usage_usec"));
+    stats.periods_ = readKeyedValue("", "cpu.stat", "nr_periods");
+    stats.throttled_periods_ = readKeyedValue("", "cpu.stat", "nr_throttled");
+    // cpu.max holds the quota, or "max", followed by the period.
+    const std::string max = readFile("", "cpu.max");
+    const std::vector<absl::string_view> fields =
+        absl::StrSplit(absl::StripAsciiWhitespace(max), ' ');
+    if (fields.size() != 2) {
+      throw EnvoyException(fmt::format("invalid value '{}' in cpu.max", max));
+    }
+    if (fields[0] != "max") {
+      const uint64_t period = parseValue(fields[1], "cpu.max");
+      if (period > 0) {
+        stats.quota_cpus_ = static_cast<double>(parseValue(fields[0], "cpu.max")) / period;
+      }
+    }
+    return stats;
+  }
+
+  stats.usage_ = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::nanoseconds(readValue("cpuacct", "cpuacct.usage")));
+  stats.periods_ = readKeyedValue("cpu", "cpu.stat", "nr_periods");
+  stats.throttled_periods_ = readKeyedValue("cpu", "cpu.stat", "nr_throttled");
+  // The quota is -1 if the cgroup has none.
+  const std::string quota = readFile("cpu", "cpu.cfs_quota_us");
+  if (absl::StripAsciiWhitespace(quota) != "-1") {
+    const uint64_t period = readValue("cpu", "cpu.cfs_period_us");
+    if (period > 0) {
+      stats.quota_cpus_ = static_cast<double>(parseValue(quota, "cpu.cfs_quota_us")) / period;
+    }
+  }
+  return stats;
+}
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
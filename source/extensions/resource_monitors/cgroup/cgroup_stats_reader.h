@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "envoy/filesystem/filesystem.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+// The directory of the cgroup of a process running in its own cgroup namespace.
+inline constexpr absl::string_view DefaultCgroupRoot = "/sys/fs/cgroup";
+
+/**
+ * Reads the memory and CPU stats of a cgroup, from its cgroup v2 interface files if root is the
+ * directory of a cgroup v2 cgroup, or else from the files of its cgroup v1 memory, cpu and cpuacct
+ * controllers under root. Throws EnvoyException if the files are missing or malformed.
+ */
+class CgroupStatsReader {
+public:
+  CgroupStatsReader(Filesystem::Instance& file_system, absl::string_view root);
+  virtual ~CgroupStatsReader() = default;
+
+  struct MemoryStats {
+    uint64_t usage_bytes_;
+    // The page cache not used recently, which the kernel reclaims before invoking the OOM killer.
+    uint64_t inactive_file_bytes_;
+    // Unset if the cgroup has no memory limit.
+    absl::optional<uint64_t> limit_bytes_;
+  };
+
+  struct CpuStats {
+    // The CPU time used by the cgroup since its creation.
+    std::chrono::microseconds usage_;
+    // The number of CPUs allowed by the quota of the cgroup, unset if it has none.
+    absl::optional<double> quota_cpus_;
+    // The number of scheduling periods of the cgroup since its creation, and how many of them it
+    // was throttled in.
+    uint64_t periods_;
+    uint64_t throttled_periods_;
+  };
+
+  virtual MemoryStats memoryStats();
+  virtual CpuStats cpuStats();
+
+  bool isV2() const { return v2_; }
+
+private:
+  std::string readFile(absl::string_view controller, absl::string_view name);
+  uint64_t readValue(absl::string_view controller, absl::string_view name);
+  // Reads the value of key from a flat keyed file like memory.stat or cpu.stat.
+  uint64_t readKeyedValue(absl::string_view controller, absl::string_view name,
+                          absl::string_view key);
+
+  Filesystem::Instance& file_system_;
+  const std::string root_;
+  const bool v2_;
+};
+
+using CgroupStatsReaderPtr = std::unique_ptr<CgroupStatsReader>;
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
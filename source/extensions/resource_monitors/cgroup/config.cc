@@ -0,0 +1,50 @@
+#include "source/extensions/resource_monitors/cgroup/config.h"
+
+#include <thread>
+
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/resource_monitors/cgroup/cgroup_cpu_monitor.h"
+#include "source/extensions/resource_monitors/cgroup/cgroup_memory_monitor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+namespace {
+
+CgroupStatsReaderPtr statsReader(const std::string& cgroup_root,
+                                 Server::Configuration::ResourceMonitorFactoryContext& context) {
+  return std::make_unique<CgroupStatsReader>(
+      context.api().fileSystem(), cgroup_root.empty() ? DefaultCgroupRoot : cgroup_root);
+}
+
+} // namespace
+
+Server::ResourceMonitorPtr CgroupMemoryMonitorFactory::createResourceMonitorFromProtoTyped(
+    const envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig& config,
+    Server::Configuration::ResourceMonitorFactoryContext& context) {
+  return std::make_unique<CgroupMemoryMonitor>(config, statsReader(config.cgroup_root(), context));
+}
+
+Server::ResourceMonitorPtr CgroupCpuMonitorFactory::createResourceMonitorFromProtoTyped(
+    const envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig& config,
+    Server::Configuration::ResourceMonitorFactoryContext& context) {
+  return std::make_unique<CgroupCpuMonitor>(config, statsReader(config.cgroup_root(), context),
+                                            context.api().timeSource(),
+                                            std::thread::hardware_concurrency());
+}
+
+/**
+ * Static registration for the cgroup resource monitor factories. @see RegistryFactory.
+ */
+REGISTER_FACTORY(CgroupMemoryMonitorFactory, Server::Configuration::ResourceMonitorFactory);
+REGISTER_FACTORY(CgroupCpuMonitorFactory, Server::Configuration::ResourceMonitorFactory);
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
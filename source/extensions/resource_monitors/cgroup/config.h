@@ -0,0 +1,41 @@
+#pragma once
+
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.validate.h"
+#include "envoy/server/resource_monitor_config.h"
+
+#include "source/extensions/resource_monitors/common/factory_base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+
+class CgroupMemoryMonitorFactory
+    : public Common::FactoryBase<
+          envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig> {
+public:
+  CgroupMemoryMonitorFactory() : FactoryBase("envoy.resource_monitors.cgroup_memory") {}
+
+private:
+  Server::ResourceMonitorPtr createResourceMonitorFromProtoTyped(
+      const envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig& config,
+      Server::Configuration::ResourceMonitorFactoryContext& context) override;
+};
+
+class CgroupCpuMonitorFactory
+    : public Common::FactoryBase<
+          envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig> {
+public:
+  CgroupCpuMonitorFactory() : FactoryBase("envoy.resource_monitors.cgroup_cpu") {}
+
+private:
+  Server::ResourceMonitorPtr createResourceMonitorFromProtoTyped(
+      const envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig& config,
+      Server::Configuration::ResourceMonitorFactoryContext& context) override;
+};
+
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,6 @@
 #include "source/extensions/stat_sinks/common/statsd/statsd.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <string>
@@ -21,6 +22,7 @@
 #include "source/common/network/utility.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 
 namespace Envoy {
@@ -31,7 +33,11 @@ namespace Statsd {
 
 UdpStatsdSink::WriterImpl::WriterImpl(UdpStatsdSink& parent)
     : parent_(parent), io_handle_(Network::ioHandleForAddr(Network::Socket::Type::Datagram,
-                                                           parent_.server_address_, {})) {}
+                                                           parent_.server_address_, {})) {
+  if (io_handle_->supportsMmsg()) {
+    batch_ = std::make_unique<Network::UdpDatagramBatch>(*io_handle_, MaxBatchedDatagrams);
+  }
+}
 
 void UdpStatsdSink::WriterImpl::write(const std::string& message) {
   // TODO(mattklein123): We can avoid this const_cast pattern by having a constant variant of
@@ -41,16 +47,30 @@ void UdpStatsdSink::WriterImpl::write(const std::string& message) {
 }
 
 void UdpStatsdSink::WriterImpl::writeBuffer(Buffer::Instance& data) {
-  Network::Utility::writeToSocket(*io_handle_, data, nullptr, *parent_.server_address_);
+  if (batch_ == nullptr) {
+    Network::Utility::writeToSocket(*io_handle_, data, nullptr, *parent_.server_address_);
+    return;
+  }
+  if (batch_->full()) {
+    flush();
+  }
+  batch_->add(data, nullptr, *parent_.server_address_);
+}
+
+void UdpStatsdSink::WriterImpl::flush() {
+  if (batch_ != nullptr && !batch_->empty()) {
+    batch_->flush(nullptr);
+  }
 }
 
 UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
                              Network::Address::InstanceConstSharedPtr address, const bool use_tag,
                              const std::string& prefix, absl::optional<uint64_t> buffer_size,
-                             const Statsd::TagFormat& tag_format)
+                             const Statsd::TagFormat& tag_format, bool aggregate_histograms)
     : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
       prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
-      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+      aggregate_histograms_(aggregate_histograms) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<WriterImpl>(*this);
   });
@@ -59,23 +79,67 @@ UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
   Writer& writer = tls_->getTyped<Writer>();
   Buffer::OwnedImpl buffer;
+  ++flushes_;
 
   for (const auto& counter : snapshot.counters()) {
     if (counter.counter_.get().used()) {
-      const std::string counter_str = buildMessage(counter.counter_.get(), counter.delta_, "|c");
-      writeBuffer(buffer, writer, counter_str);
+      writeBuffer(buffer, writer,
+                  buildMessage(formattedName(counter.counter_.get()), counter.delta_, "|c"));
     }
   }
 
   for (const auto& gauge : snapshot.gauges()) {
     if (gauge.get().used()) {
-      const std::string gauge_str = buildMessage(gauge.get(), gauge.get().value(), "|g");
-      writeBuffer(buffer, writer, gauge_str);
+      writeBuffer(buffer, writer,
+                  buildMessage(formattedName(gauge.get()), gauge.get().value(), "|g"));
+    }
+  }
+
+  if (aggregate_histograms_) {
+    for (const auto& histogram : snapshot.histograms()) {
+      if (histogram.get().used()) {
+        flushHistogram(buffer, writer, histogram.get());
+      }
     }
   }
 
   flushBuffer(buffer, writer);
+  writer.flush();
   // TODO(efimki): Add support of text readouts stats.
+
+  // Forget the metrics which were not part of this flush, e.g. as they have been deleted.
+  absl::erase_if(formatted_names_,
+                 [this](const auto& entry) { return entry.second.flush_ != flushes_; });
+}
+
+void UdpStatsdSink::flushHistogram(Buffer::OwnedImpl& buffer, Writer& writer,
+                                   const Stats::ParentHistogram& histogram) {
+  const Stats::HistogramStatistics& statistics = histogram.intervalStatistics();
+  const uint64_t sample_count = statistics.sampleCount();
+  if (sample_count == 0) {
+    return;
+  }
+  const FormattedName& name = formattedName(histogram);
+  const bool percent = histogram.unit() == Stats::Histogram::Unit::Percent;
+  Stats::ConstSupportedBuckets& bounds = statistics.supportedBuckets();
+  const std::vector<uint64_t> buckets = statistics.computeDisjointBuckets();
+  // The samples above the largest bound are emitted with the samples of the last bucket.
+  uint64_t remaining = sample_count;
+  for (size_t i = 0; i < buckets.size() && remaining > 0; ++i) {
+    const uint64_t count = i + 1 == buckets.size() ? remaining : std::min(buckets[i], remaining);
+    if (count == 0) {
+      continue;
+    }
+    remaining -= count;
+    // A sample rate of 1/N makes statsd count the value N times.
+    const std::string sample_rate = count == 1 ? "" : absl::StrCat("|@", 1.0 / count);
+    if (percent) {
+      const double value = bounds[i] / Stats::Histogram::PercentScale;
+      writeBuffer(buffer, writer, buildMessage(name, value, "|h", sample_rate));
+    } else {
+      writeBuffer(buffer, writer, buildMessage(name, bounds[i], "|ms", sample_rate));
+    }
+  }
 }
 
 void UdpStatsdSink::writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer,
@@ -106,6 +170,10 @@ void UdpStatsdSink::flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const
 }
 
 void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) {
+  if (aggregate_histograms_) {
+    // The samples are emitted by flush().
+    return;
+  }
   // For statsd histograms are all timers in milliseconds, Envoy histograms are however
   // not necessarily timers in milliseconds, for Envoy histograms suffixed with their corresponding
   // SI unit symbol this is acceptable, but for histograms without a suffix, especially those which
@@ -155,6 +223,38 @@ const std::string UdpStatsdSink::buildMessage(const Stats::Metric& metric, Value
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
+template <typename ValueType>
+const std::string& UdpStatsdSink::buildMessage(const FormattedName& name, ValueType value,
+                                               absl::string_view type,
+                                               absl::string_view sample_rate) {
+  switch (tag_format_.tag_position) {
+  case Statsd::TagPosition::TagAfterValue:
+    message_.assign(name.name_);
+    absl::StrAppend(&message_, ":", value, type, sample_rate, name.tags_);
+    return message_;
+  case Statsd::TagPosition::TagAfterName:
+    message_.assign(name.name_);
+    absl::StrAppend(&message_, name.tags_, ":", value, type, sample_rate);
+    return message_;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+const UdpStatsdSink::FormattedName UdpStatsdSink::formatName(const Stats::Metric& metric) const {
+  return {absl::StrCat(prefix_, ".", getName(metric)), buildTagStr(metric.tags())};
+}
+
+const UdpStatsdSink::FormattedName& UdpStatsdSink::formattedName(const Stats::Metric& metric) {
+  // The tags of a metric are extracted from its name, so the name identifies the tags too.
+  std::string metric_name = metric.name();
+  auto it = formatted_names_.find(metric_name);
+  if (it == formatted_names_.end()) {
+    it = formatted_names_.emplace(std::move(metric_name), formatName(metric)).first;
+  }
+  it->second.flush_ = flushes_;
+  return it->second;
+}
+
 const std::string UdpStatsdSink::getName(const Stats::Metric& metric) const {
   if (use_tag_) {
     return metric.tagExtractedName();
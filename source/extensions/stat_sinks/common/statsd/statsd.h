@@ -15,8 +15,10 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/macros.h"
 #include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/udp_packet_writer_handler_impl.h"
 #include "source/extensions/stat_sinks/common/statsd/tag_formats.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -39,20 +41,27 @@ public:
   public:
     virtual void write(const std::string& message) PURE;
     virtual void writeBuffer(Buffer::Instance& data) PURE;
+    /**
+     * Sends the datagrams of writeBuffer() which the writer may have queued.
+     */
+    virtual void flush() {}
   };
 
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat());
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                bool aggregate_histograms = false);
   // For testing.
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, const std::shared_ptr<Writer>& writer,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat())
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                bool aggregate_histograms = false)
       : tls_(tls.allocateSlot()), use_tag_(use_tag),
         prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
-        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+        aggregate_histograms_(aggregate_histograms) {
     tls_->set(
         [writer](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr { return writer; });
   }
@@ -60,9 +69,13 @@ public:
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  // Counters are sent as deltas and statsd servers keep the last value of gauges.
+  bool acceptsDeltaSnapshots() const override { return true; }
 
   bool getUseTagForTest() { return use_tag_; }
   uint64_t getBufferSizeForTest() { return buffer_size_; }
+  bool getAggregateHistogramsForTest() { return aggregate_histograms_; }
+  size_t formattedNamesForTest() { return formatted_names_.size(); }
   const std::string& getPrefix() { return prefix_; }
 
 private:
@@ -76,18 +89,41 @@ private:
     // Writer
     void write(const std::string& message) override;
     void writeBuffer(Buffer::Instance& data) override;
+    void flush() override;
 
   private:
+    // The most datagrams sent per sendmmsg() call.
+    static constexpr uint32_t MaxBatchedDatagrams = 64;
+
     UdpStatsdSink& parent_;
     const Network::IoHandlePtr io_handle_;
+    // Set if the socket supports sendmmsg(), to send the datagrams of a flush in batches.
+    std::unique_ptr<Network::UdpDatagramBatch> batch_;
+  };
+
+  /**
+   * The name of a metric formatted for statsd, with its prefix and, if tags are used, its tags.
+   */
+  struct FormattedName {
+    std::string name_;
+    std::string tags_;
+    // The flush in which the metric was last seen, to forget the metrics which no longer exist.
+    uint64_t flush_{};
   };
 
   void flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const;
   void writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer, const std::string& data) const;
+  void flushHistogram(Buffer::OwnedImpl& buffer, Writer& writer,
+                      const Stats::ParentHistogram& histogram);
 
   template <typename ValueType>
   const std::string buildMessage(const Stats::Metric& metric, ValueType value,
                                  const std::string& type) const;
+  template <typename ValueType>
+  const std::string& buildMessage(const FormattedName& name, ValueType value,
+                                  absl::string_view type, absl::string_view sample_rate = "");
+  const FormattedName formatName(const Stats::Metric& metric) const;
+  const FormattedName& formattedName(const Stats::Metric& metric);
   const std::string getName(const Stats::Metric& metric) const;
   const std::string buildTagStr(const std::vector<Stats::Tag>& tags) const;
 
@@ -98,6 +134,13 @@ private:
   const std::string prefix_;
   const uint64_t buffer_size_;
   const Statsd::TagFormat tag_format_;
+  // Whether the histograms are emitted once per flush rather than once per sample.
+  const bool aggregate_histograms_;
+  // The formatted names of the metrics flushed, by metric name. Only used by the main thread.
+  absl::flat_hash_map<std::string, FormattedName> formatted_names_;
+  uint64_t flushes_{};
+  // The message last built by flush(), whose memory is reused by the next one.
+  std::string message_;
 };
 
 /**
@@ -112,6 +155,8 @@ public:
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  // Counters are sent as deltas and statsd servers keep the last value of gauges.
+  bool acceptsDeltaSnapshots() const override { return true; }
 
   const std::string& getPrefix() { return prefix_; }
 
@@ -1,6 +1,7 @@
 #include "source/extensions/stat_sinks/metrics_service/grpc_metrics_service_impl.h"
 
 #include <chrono>
+#include <limits>
 
 #include "envoy/common/exception.h"
 #include "envoy/event/dispatcher.h"
@@ -28,9 +29,13 @@ GrpcMetricsStreamerImpl::GrpcMetricsStreamerImpl(Grpc::RawAsyncClientSharedPtr r
 
 void GrpcMetricsStreamerImpl::send(MetricsPtr&& metrics) {
   envoy::service::metrics::v3::StreamMetricsMessage message;
-  message.mutable_envoy_metrics()->Reserve(metrics->size());
-  message.mutable_envoy_metrics()->MergeFrom(*metrics);
+  // Both fields are on the heap, so that this exchanges their elements rather than copying them.
+  message.mutable_envoy_metrics()->Swap(metrics.get());
+  sendBatch(message);
+}
 
+void GrpcMetricsStreamerImpl::sendBatch(
+    envoy::service::metrics::v3::StreamMetricsMessage& message) {
   if (stream_ == nullptr) {
     stream_ = client_->start(service_method_, *this, Http::AsyncClient::StreamOptions());
     // For perf reasons, the identifier is only sent on establishing the stream.
@@ -40,6 +45,7 @@ void GrpcMetricsStreamerImpl::send(MetricsPtr&& metrics) {
   if (stream_ != nullptr) {
     stream_->sendMessage(message, false);
   }
+  message.clear_identifier();
 }
 
 MetricsPtr MetricsFlusher::flush(Stats::MetricSnapshot& snapshot) const {
@@ -51,28 +57,51 @@ MetricsPtr MetricsFlusher::flush(Stats::MetricSnapshot& snapshot) const {
   // preallocating the pointer array).
   metrics->Reserve(snapshot.counters().size() + snapshot.gauges().size() +
                    snapshot.histograms().size());
+  // A single batch holds all metrics.
+  flush(snapshot, std::numeric_limits<uint32_t>::max(), *metrics, []() {});
+  return metrics;
+}
+
+void MetricsFlusher::flush(
+    Stats::MetricSnapshot& snapshot, uint32_t max_metric_families,
+    Envoy::Protobuf::RepeatedPtrField<io::prometheus::client::MetricFamily>& batch,
+    const std::function<void()>& send_batch) const {
   int64_t snapshot_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                                  snapshot.snapshotTime().time_since_epoch())
                                  .count();
+  // Makes room in the batch for the given number of metric families, sending it if it is full.
+  const auto reserve = [max_metric_families, &batch, &send_batch](uint32_t metric_families) {
+    if (!batch.empty() && static_cast<uint64_t>(batch.size()) + metric_families >
+                              static_cast<uint64_t>(max_metric_families)) {
+      send_batch();
+      batch.Clear();
+    }
+  };
+
   for (const auto& counter : snapshot.counters()) {
     if (predicate_(counter.counter_.get())) {
-      flushCounter(*metrics->Add(), counter, snapshot_time_ms);
+      reserve(1);
+      flushCounter(*batch.Add(), counter, snapshot_time_ms);
     }
   }
 
   for (const auto& gauge : snapshot.gauges()) {
     if (predicate_(gauge)) {
-      flushGauge(*metrics->Add(), gauge.get(), snapshot_time_ms);
+      reserve(1);
+      flushGauge(*batch.Add(), gauge.get(), snapshot_time_ms);
     }
   }
 
   for (const auto& histogram : snapshot.histograms()) {
     if (predicate_(histogram.get())) {
-      flushHistogram(*metrics->Add(), *metrics->Add(), histogram.get(), snapshot_time_ms);
+      reserve(2);
+      flushHistogram(*batch.Add(), *batch.Add(), histogram.get(), snapshot_time_ms);
     }
   }
 
-  return metrics;
+  if (!batch.empty()) {
+    send_batch();
+  }
 }
 
 void MetricsFlusher::flushCounter(io::prometheus::client::MetricFamily& metrics_family,
@@ -39,6 +39,13 @@ public:
    */
   virtual void send(MetricsPtr&& metrics) PURE;
 
+  /**
+   * Send a message holding some of the metrics of a flush, the others being sent by the messages
+   * which follow it. The message is only used during the call, so that it can be reused.
+   * @param message supplies the message to send. Its identifier is set if the stream requires it.
+   */
+  virtual void sendBatch(RequestProto& message) PURE;
+
   // Grpc::AsyncStreamCallbacks
   void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
   void onReceiveInitialMetadata(Http::ResponseHeaderMapPtr&&) override {}
@@ -68,6 +75,7 @@ public:
 
   // GrpcMetricsStreamer
   void send(MetricsPtr&& metrics) override;
+  void sendBatch(envoy::service::metrics::v3::StreamMetricsMessage& message) override;
 
   // Grpc::AsyncStreamCallbacks
   void onRemoteClose(Grpc::Status::GrpcStatus, const std::string&) override { stream_ = nullptr; }
@@ -90,6 +98,19 @@ public:
 
   MetricsPtr flush(Stats::MetricSnapshot& snapshot) const;
 
+  /**
+   * Converts the metrics of the snapshot into batches of at most max_metric_families metric
+   * families, histograms being converted into two families that are kept in the same batch.
+   * @param batch supplies the metric families of the batches. Each batch but the first starts by
+   *        clearing it, so that the elements of the previous batch are reused.
+   * @param send_batch supplies the callback called once the batch is filled.
+   */
+  void flush(Stats::MetricSnapshot& snapshot, uint32_t max_metric_families,
+             Envoy::Protobuf::RepeatedPtrField<io::prometheus::client::MetricFamily>& batch,
+             const std::function<void()>& send_batch) const;
+
+  bool reportCountersAsDeltas() const { return report_counters_as_deltas_; }
+
 private:
   void flushCounter(io::prometheus::client::MetricFamily& metrics_family,
                     const Stats::MetricSnapshot::CounterSnapshot& counter_snapshot,
@@ -118,24 +139,51 @@ template <class RequestProto, class ResponseProto> class MetricsServiceSink : pu
 public:
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      bool report_counters_as_deltas, bool emit_labels)
+      bool report_counters_as_deltas, bool emit_labels,
+      uint32_t max_metric_families_per_message = 0, bool report_only_changed_metrics = false)
       : MetricsServiceSink(grpc_metrics_streamer,
-                           MetricsFlusher(report_counters_as_deltas, emit_labels)) {}
+                           MetricsFlusher(report_counters_as_deltas, emit_labels),
+                           max_metric_families_per_message, report_only_changed_metrics) {}
 
+  /**
+   * @param max_metric_families_per_message supplies the most metric families sent per message, or
+   *        0 for all metrics of a flush to be sent in a single message.
+   * @param report_only_changed_metrics supplies whether the metrics which didn't change since the
+   *        previous flush can be omitted, even if the counters are reported as cumulative values.
+   */
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      MetricsFlusher&& flusher)
-      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)) {}
+      MetricsFlusher&& flusher, uint32_t max_metric_families_per_message = 0,
+      bool report_only_changed_metrics = false)
+      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)),
+        max_metric_families_per_message_(max_metric_families_per_message),
+        report_only_changed_metrics_(report_only_changed_metrics) {}
 
   // MetricsService::Sink
   void flush(Stats::MetricSnapshot& snapshot) override {
-    grpc_metrics_streamer_->send(flusher_.flush(snapshot));
+    if (max_metric_families_per_message_ == 0) {
+      grpc_metrics_streamer_->send(flusher_.flush(snapshot));
+      return;
+    }
+    // The messages and their metrics are allocated on an arena, which frees them all at once at the
+    // end of the flush. Each batch reuses the metric families of the previous one.
+    Protobuf::Arena arena;
+    RequestProto* message = Protobuf::Arena::CreateMessage<RequestProto>(&arena);
+    flusher_.flush(snapshot, max_metric_families_per_message_, *message->mutable_envoy_metrics(),
+                   [this, message]() { grpc_metrics_streamer_->sendBatch(*message); });
   }
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+  // Unchanged counters can only be omitted if the service doesn't expect cumulative values, unless
+  // it is configured to only receive the metrics which changed.
+  bool acceptsDeltaSnapshots() const override {
+    return flusher_.reportCountersAsDeltas() || report_only_changed_metrics_;
+  }
 
 private:
   const MetricsFlusher flusher_;
   GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto> grpc_metrics_streamer_;
+  const uint32_t max_metric_families_per_message_;
+  const bool report_only_changed_metrics_;
 };
 
 } // namespace MetricsService
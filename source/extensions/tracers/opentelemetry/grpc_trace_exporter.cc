@@ -9,9 +9,11 @@ namespace Tracers {
 namespace OpenTelemetry {
 
 OpenTelemetryGrpcTraceExporter::OpenTelemetryGrpcTraceExporter(
-    const Grpc::RawAsyncClientSharedPtr& client)
-    : client_(client, *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
-                          "opentelemetry.proto.collector.trace.v1.TraceService.Export")) {}
+    const Grpc::RawAsyncClientSharedPtr& client, absl::optional<uint32_t> max_in_flight_exports)
+    : client_(client,
+              *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
+                  "opentelemetry.proto.collector.trace.v1.TraceService.Export"),
+              max_in_flight_exports) {}
 
 bool OpenTelemetryGrpcTraceExporter::log(const ExportTraceServiceRequest& request) {
   return client_.log(request);
@@ -5,6 +5,8 @@
 #include "source/common/common/logger.h"
 #include "source/common/grpc/typed_async_client.h"
 
+#include "absl/types/optional.h"
+
 #include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
 
 namespace Envoy {
@@ -21,8 +23,10 @@ using opentelemetry::proto::collector::trace::v1::ExportTraceServiceResponse;
 class OpenTelemetryGrpcTraceExporterClient : Logger::Loggable<Logger::Id::tracing> {
 public:
   OpenTelemetryGrpcTraceExporterClient(const Grpc::RawAsyncClientSharedPtr& client,
-                                       const Protobuf::MethodDescriptor& service_method)
-      : client_(client), service_method_(service_method) {}
+                                       const Protobuf::MethodDescriptor& service_method,
+                                       absl::optional<uint32_t> max_in_flight_exports)
+      : client_(client), service_method_(service_method),
+        max_in_flight_exports_(max_in_flight_exports) {}
 
   struct LocalStream : public Grpc::AsyncStreamCallbacks<
                            opentelemetry::proto::collector::trace::v1::ExportTraceServiceResponse> {
@@ -33,10 +37,16 @@ public:
     void onReceiveInitialMetadata(Http::ResponseHeaderMapPtr&&) override {}
     void onReceiveMessage(
         std::unique_ptr<opentelemetry::proto::collector::trace::v1::ExportTraceServiceResponse>&&)
-        override {}
+        override {
+      if (parent_.in_flight_exports_ > 0) {
+        parent_.in_flight_exports_--;
+      }
+    }
     void onReceiveTrailingMetadata(Http::ResponseTrailerMapPtr&&) override {}
     void onRemoteClose(Grpc::Status::GrpcStatus, const std::string&) override {
       ASSERT(parent_.stream_ != nullptr);
+      // The exports of the stream won't be answered anymore.
+      parent_.in_flight_exports_ = 0;
       if (parent_.stream_->stream_ != nullptr) {
         // Only reset if we have a stream. Otherwise we had an inline failure and we will clear the
         // stream data in send().
@@ -50,6 +60,10 @@ public:
   };
 
   bool log(const ExportTraceServiceRequest& request) {
+    if (max_in_flight_exports_.has_value() && in_flight_exports_ >= *max_in_flight_exports_) {
+      return false;
+    }
+
     // If we don't have a stream already, we need to initialize it.
     if (!stream_) {
       stream_ = std::make_unique<LocalStream>(*this);
@@ -69,6 +83,7 @@ public:
         return false;
       }
       stream_->stream_->sendMessage(request, false);
+      in_flight_exports_++;
     } else {
       stream_.reset();
     }
@@ -78,11 +93,20 @@ public:
   Grpc::AsyncClient<ExportTraceServiceRequest, ExportTraceServiceResponse> client_;
   std::unique_ptr<LocalStream> stream_;
   const Protobuf::MethodDescriptor& service_method_;
+  const absl::optional<uint32_t> max_in_flight_exports_;
+  // The exports sent on the stream whose response wasn't received yet.
+  uint32_t in_flight_exports_{0};
 };
 
 class OpenTelemetryGrpcTraceExporter : Logger::Loggable<Logger::Id::tracing> {
 public:
-  OpenTelemetryGrpcTraceExporter(const Grpc::RawAsyncClientSharedPtr& client);
+  /**
+   * @param client supplies the client of the collector.
+   * @param max_in_flight_exports supplies the maximum number of exports without a response, beyond
+   *        which log() drops the requests. Unlimited if not set.
+   */
+  OpenTelemetryGrpcTraceExporter(const Grpc::RawAsyncClientSharedPtr& client,
+                                 absl::optional<uint32_t> max_in_flight_exports = absl::nullopt);
 
   bool log(const ExportTraceServiceRequest& request);
 
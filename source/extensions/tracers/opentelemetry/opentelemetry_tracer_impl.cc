@@ -35,7 +35,12 @@ Driver::Driver(const envoy::config::trace::v3::OpenTelemetryConfig& opentelemetr
               opentelemetry_config.grpc_service(), factory_context.scope(), true);
       const Grpc::RawAsyncClientSharedPtr& async_client_shared_ptr =
           factory->createUncachedRawAsyncClient();
-      exporter = std::make_unique<OpenTelemetryGrpcTraceExporter>(async_client_shared_ptr);
+      absl::optional<uint32_t> max_in_flight_exports;
+      if (opentelemetry_config.has_max_in_flight_exports()) {
+        max_in_flight_exports = opentelemetry_config.max_in_flight_exports().value();
+      }
+      exporter = std::make_unique<OpenTelemetryGrpcTraceExporter>(async_client_shared_ptr,
+                                                                  max_in_flight_exports);
     }
     TracerPtr tracer = std::make_unique<Tracer>(
         std::move(exporter), factory_context.timeSource(), factory_context.api().randomGenerator(),
@@ -70,6 +75,19 @@ Tracing::SpanPtr Driver::startSpan(const Tracing::Config& config,
   }
 }
 
+bool Driver::propagateUntracedContext(Tracing::TraceContext& trace_context) {
+  SpanContextExtractor extractor(trace_context);
+  if (!extractor.propagationHeaderPresent()) {
+    // Tell the upstream services that the request isn't sampled, as a span would.
+    tls_slot_ptr_->getTyped<Driver::TlsTracer>().tracer().injectUnsampledContext(trace_context);
+    return true;
+  }
+  // A request whose propagated context is sampled is traced regardless of the decision. An
+  // invalid context gets no span either way.
+  absl::StatusOr<SpanContext> span_context = extractor.extractSpanContext();
+  return !span_context.ok() || !span_context.value().sampled();
+}
+
 Driver::TlsTracer::TlsTracer(TracerPtr tracer) : tracer_(std::move(tracer)) {}
 
 Tracer& Driver::TlsTracer::tracer() {
@@ -39,6 +39,11 @@ public:
                              const std::string& operation_name, SystemTime start_time,
                              const Tracing::Decision tracing_decision) override;
 
+  /**
+   * Implements the abstract Driver's propagateUntracedContext operation.
+   */
+  bool propagateUntracedContext(Tracing::TraceContext& trace_context) override;
+
 private:
   class TlsTracer : public ThreadLocal::ThreadLocalObject {
   public:
@@ -49,7 +49,8 @@ void Span::finishSpan() {
   span_.set_end_time_unix_nano(
       std::chrono::nanoseconds(time_source_.systemTime().time_since_epoch()).count());
   if (sampled()) {
-    parent_tracer_.sendSpan(span_);
+    // The span is finished, so its proto is handed over to the tracer rather than copied.
+    parent_tracer_.sendSpan(std::move(span_));
   }
 }
 
@@ -100,6 +101,14 @@ Tracer::Tracer(OpenTelemetryGrpcTraceExporterPtr exporter, Envoy::TimeSource& ti
   if (service_name.empty()) {
     service_name_ = std::string{kDefaultServiceName};
   }
+  // A request consists of ResourceSpans.
+  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span =
+      pending_request_.add_resource_spans();
+  opentelemetry::proto::common::v1::KeyValue* key_value =
+      resource_span->mutable_resource()->add_attributes();
+  key_value->set_key(std::string{kServiceNameKey});
+  key_value->mutable_value()->set_string_value(service_name_);
+  pending_spans_ = resource_span->add_scope_spans();
   flush_timer_ = dispatcher.createTimer([this]() -> void {
     tracing_stats_.timer_flushed_.inc();
     flushSpans();
@@ -115,38 +124,30 @@ void Tracer::enableTimer() {
 }
 
 void Tracer::flushSpans() {
-  ExportTraceServiceRequest request;
-  // A request consists of ResourceSpans.
-  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request.add_resource_spans();
-  opentelemetry::proto::common::v1::KeyValue key_value =
-      opentelemetry::proto::common::v1::KeyValue();
-  opentelemetry::proto::common::v1::AnyValue value_proto =
-      opentelemetry::proto::common::v1::AnyValue();
-  value_proto.set_string_value(std::string{service_name_});
-  key_value.set_key(std::string{kServiceNameKey});
-  *key_value.mutable_value() = value_proto;
-  (*resource_span->mutable_resource()->add_attributes()) = key_value;
-  ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span = resource_span->add_scope_spans();
-  for (const auto& pending_span : span_buffer_) {
-    (*scope_span->add_spans()) = pending_span;
+  const int pending_spans = pending_spans_->spans_size();
+  if (pending_spans == 0) {
+    // Nothing to export.
+    return;
   }
   if (exporter_) {
-    tracing_stats_.spans_sent_.add(span_buffer_.size());
-    if (!exporter_->log(request)) {
-      // TODO: should there be any sort of retry or reporting here?
+    if (exporter_->log(pending_request_)) {
+      tracing_stats_.spans_sent_.add(pending_spans);
+    } else {
+      // The collector doesn't keep up, so the spans are dropped rather than buffered.
+      tracing_stats_.spans_dropped_.add(pending_spans);
       ENVOY_LOG(trace, "Unsuccessful log request to OpenTelemetry trace collector.");
     }
   } else {
     ENVOY_LOG(info, "Skipping log request to OpenTelemetry: no exporter configured");
   }
-  span_buffer_.clear();
+  pending_spans_->clear_spans();
 }
 
-void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
-  span_buffer_.push_back(span);
+void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span&& span) {
+  *pending_spans_->add_spans() = std::move(span);
   const uint64_t min_flush_spans =
       runtime_.snapshot().getInteger("tracing.opentelemetry.min_flush_spans", 5U);
-  if (span_buffer_.size() >= min_flush_spans) {
+  if (static_cast<uint64_t>(pending_spans_->spans_size()) >= min_flush_spans) {
     flushSpans();
   }
 }
@@ -186,6 +187,16 @@ Tracing::SpanPtr Tracer::startSpan(const Tracing::Config& config, const std::str
   return std::make_unique<Span>(new_span);
 }
 
+void Tracer::injectUnsampledContext(Tracing::TraceContext& trace_context) {
+  const uint64_t trace_id_high = random_.random();
+  const uint64_t trace_id = random_.random();
+  const uint64_t span_id = random_.random();
+  trace_context.setByReferenceKey(
+      kTraceParent, absl::StrCat(kDefaultVersion, "-", Hex::uint64ToHex(trace_id_high),
+                                 Hex::uint64ToHex(trace_id), "-", Hex::uint64ToHex(span_id),
+                                 "-00"));
+}
+
 } // namespace OpenTelemetry
 } // namespace Tracers
 } // namespace Extensions
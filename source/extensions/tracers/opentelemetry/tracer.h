@@ -21,6 +21,7 @@ namespace Tracers {
 namespace OpenTelemetry {
 
 #define OPENTELEMETRY_TRACER_STATS(COUNTER)                                                        \
+  COUNTER(spans_dropped)                                                                           \
   COUNTER(spans_sent)                                                                              \
   COUNTER(timer_flushed)
 
@@ -37,7 +38,11 @@ public:
          Random::RandomGenerator& random, Runtime::Loader& runtime, Event::Dispatcher& dispatcher,
          OpenTelemetryTracerStats tracing_stats, const std::string& service_name);
 
-  void sendSpan(::opentelemetry::proto::trace::v1::Span& span);
+  /**
+   * Adds a finished span to the pending export request.
+   * @param span supplies the span, which is moved into the request.
+   */
+  void sendSpan(::opentelemetry::proto::trace::v1::Span&& span);
 
   Tracing::SpanPtr startSpan(const Tracing::Config& config, const std::string& operation_name,
                              SystemTime start_time, const Tracing::Decision tracing_decision);
@@ -45,20 +50,28 @@ public:
   Tracing::SpanPtr startSpan(const Tracing::Config& config, const std::string& operation_name,
                              SystemTime start_time, const SpanContext& previous_span_context);
 
+  /**
+   * Sets the traceparent of a new trace that isn't sampled, without creating a span.
+   */
+  void injectUnsampledContext(Tracing::TraceContext& trace_context);
+
 private:
   /**
    * Enables the span-flushing timer.
    */
   void enableTimer();
   /*
-   * Removes all spans from the span buffer and sends them to the collector.
+   * Sends the pending spans to the collector, and removes them from the pending request.
    */
   void flushSpans();
 
   OpenTelemetryGrpcTraceExporterPtr exporter_;
   Envoy::TimeSource& time_source_;
   Random::RandomGenerator& random_;
-  std::vector<::opentelemetry::proto::trace::v1::Span> span_buffer_;
+  // The finished spans are added to the request in place, so that the request is built once and
+  // the spans aren't copied.
+  ExportTraceServiceRequest pending_request_;
+  ::opentelemetry::proto::trace::v1::ScopeSpans* pending_spans_;
   Runtime::Loader& runtime_;
   Event::TimerPtr flush_timer_;
   OpenTelemetryTracerStats tracing_stats_;
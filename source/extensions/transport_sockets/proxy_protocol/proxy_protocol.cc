@@ -32,6 +32,7 @@ UpstreamProxyProtocolSocket::UpstreamProxyProtocolSocket(
     Stats::Scope& scope)
     : PassthroughSocket(std::move(transport_socket)), options_(options), version_(config.version()),
       stats_(GenerateUpstreamProxyProtocolStats(scope)),
+      pass_through_original_header_(config.pass_through_original_header()),
       pass_all_tlvs_(config.has_pass_through_tlvs() ? config.pass_through_tlvs().match_type() ==
                                                           ProxyProtocolPassThroughTLVs::INCLUDE_ALL
                                                     : false) {
@@ -63,6 +64,15 @@ Network::IoResult UpstreamProxyProtocolSocket::doWrite(Buffer::Instance& buffer,
 }
 
 void UpstreamProxyProtocolSocket::generateHeader() {
+  if (pass_through_original_header_ && options_ && options_->proxyProtocolOptions().has_value()) {
+    const auto options = options_->proxyProtocolOptions().value();
+    if (!options.original_header_.empty()) {
+      header_buffer_.add(options.original_header_);
+      ENVOY_LOG(trace, "passing through the original proxy protocol header, length: {}",
+                header_buffer_.length());
+      return;
+    }
+  }
   if (version_ == ProxyProtocolConfig_Version::ProxyProtocolConfig_Version_V1) {
     generateHeaderV1();
   } else {
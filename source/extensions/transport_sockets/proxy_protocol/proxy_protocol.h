@@ -50,6 +50,8 @@ private:
   Buffer::OwnedImpl header_buffer_{};
   ProxyProtocolConfig_Version version_{ProxyProtocolConfig_Version::ProxyProtocolConfig_Version_V1};
   UpstreamProxyProtocolStats stats_;
+  // Whether to write the downstream header as received, if the listener filter kept it.
+  const bool pass_through_original_header_;
   const bool pass_all_tlvs_;
   absl::flat_hash_set<uint8_t> pass_through_tlvs_{};
 };
@@ -17,18 +17,20 @@ namespace Tap {
 
 class SocketTapConfigFactoryImpl : public Extensions::Common::Tap::TapConfigFactory {
 public:
-  SocketTapConfigFactoryImpl(TimeSource& time_source) : time_source_(time_source) {}
+  SocketTapConfigFactoryImpl(TimeSource& time_source, Api::Api& api)
+      : time_source_(time_source), api_(api) {}
 
   // TapConfigFactory
   Extensions::Common::Tap::TapConfigSharedPtr
   createConfigFromProto(const envoy::config::tap::v3::TapConfig& proto_config,
                         Extensions::Common::Tap::Sink* admin_streamer) override {
     return std::make_shared<SocketTapConfigImpl>(std::move(proto_config), admin_streamer,
-                                                 time_source_);
+                                                 time_source_, api_);
   }
 
 private:
   TimeSource& time_source_;
+  Api::Api& api_;
 };
 
 Network::UpstreamTransportSocketFactoryPtr
@@ -46,7 +48,8 @@ UpstreamTapSocketConfigFactory::createTransportSocketFactory(
       inner_config_factory.createTransportSocketFactory(*inner_factory_config, context);
   return std::make_unique<TapSocketFactory>(
       outer_config,
-      std::make_unique<SocketTapConfigFactoryImpl>(context.mainThreadDispatcher().timeSource()),
+      std::make_unique<SocketTapConfigFactoryImpl>(context.mainThreadDispatcher().timeSource(),
+                                                   context.api()),
       context.admin(), context.singletonManager(), context.threadLocal(),
       context.mainThreadDispatcher(), std::move(inner_transport_factory));
 }
@@ -67,7 +70,8 @@ DownstreamTapSocketConfigFactory::createTransportSocketFactory(
       *inner_factory_config, context, server_names);
   return std::make_unique<DownstreamTapSocketFactory>(
       outer_config,
-      std::make_unique<SocketTapConfigFactoryImpl>(context.mainThreadDispatcher().timeSource()),
+      std::make_unique<SocketTapConfigFactoryImpl>(context.mainThreadDispatcher().timeSource(),
+                                                   context.api()),
       context.admin(), context.singletonManager(), context.threadLocal(),
       context.mainThreadDispatcher(), std::move(inner_transport_factory));
 }
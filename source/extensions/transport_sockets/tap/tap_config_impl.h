@@ -51,12 +51,16 @@ class SocketTapConfigImpl : public Extensions::Common::Tap::TapConfigBaseImpl,
                             public std::enable_shared_from_this<SocketTapConfigImpl> {
 public:
   SocketTapConfigImpl(const envoy::config::tap::v3::TapConfig& proto_config,
-                      Extensions::Common::Tap::Sink* admin_streamer, TimeSource& time_system)
-      : Extensions::Common::Tap::TapConfigBaseImpl(std::move(proto_config), admin_streamer),
+                      Extensions::Common::Tap::Sink* admin_streamer, TimeSource& time_system,
+                      Api::Api& api)
+      : Extensions::Common::Tap::TapConfigBaseImpl(std::move(proto_config), admin_streamer, api),
         time_source_(time_system) {}
 
   // SocketTapConfig
   PerSocketTapperPtr createPerSocketTapper(const Network::Connection& connection) override {
+    if (!sampled(connection.id())) {
+      return nullptr;
+    }
     return std::make_unique<PerSocketTapperImpl>(shared_from_this(), connection);
   }
   TimeSource& timeSource() const override { return time_source_; }
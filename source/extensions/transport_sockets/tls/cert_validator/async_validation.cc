@@ -0,0 +1,111 @@
+#include "source/extensions/transport_sockets/tls/cert_validator/async_validation.h"
+
+#include <iterator>
+
+#include "source/common/common/assert.h"
+
+#include "openssl/sha.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+CertValidationThreadPool::CertValidationThreadPool(Thread::ThreadFactory& thread_factory,
+                                                   uint32_t threads)
+    : thread_count_(threads) {
+  ASSERT(thread_count_ > 0);
+  for (uint32_t i = 0; i < thread_count_; i++) {
+    threads_.push_back(thread_factory.createThread([this]() { threadFunc(); },
+                                                   Thread::Options{"TlsCertVerify"}));
+  }
+}
+
+CertValidationThreadPool::~CertValidationThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    exit_ = true;
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void CertValidationThreadPool::post(Validation validation) {
+  absl::MutexLock lock(&mutex_);
+  queue_.push_back(std::move(validation));
+}
+
+void CertValidationThreadPool::threadFunc() {
+  const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || exit_;
+  };
+  std::deque<Validation> batch;
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      if (queue_.empty()) {
+        return;
+      }
+      // Take a share of the queued validations at once, which keeps the lock from being
+      // contended when many handshakes are validated at once, while leaving the other threads
+      // their share.
+      const size_t batch_size = (queue_.size() + thread_count_ - 1) / thread_count_;
+      std::move(queue_.begin(), queue_.begin() + batch_size, std::back_inserter(batch));
+      queue_.erase(queue_.begin(), queue_.begin() + batch_size);
+    }
+    for (Validation& validation : batch) {
+      validation();
+    }
+    batch.clear();
+  }
+}
+
+ValidatedChainCache::ValidatedChainCache(uint32_t max_chains, std::chrono::milliseconds ttl,
+                                         TimeSource& time_source)
+    : max_chains_(max_chains), ttl_(ttl), time_source_(time_source) {}
+
+std::string ValidatedChainCache::key(STACK_OF(X509)& cert_chain, bool is_server) {
+  std::string key(1, is_server ? 's' : 'c');
+  for (const X509* cert : &cert_chain) {
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    unsigned int hash_length = 0;
+    const int rc = X509_digest(cert, EVP_sha256(), hash, &hash_length);
+    RELEASE_ASSERT(rc == 1 && hash_length == SHA256_DIGEST_LENGTH, "");
+    key.append(reinterpret_cast<const char*>(hash), hash_length);
+  }
+  return key;
+}
+
+absl::optional<Envoy::Ssl::ClientValidationStatus>
+ValidatedChainCache::lookup(const std::string& key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = chains_.find(key);
+  if (it == chains_.end()) {
+    return absl::nullopt;
+  }
+  if (it->second.expiry_ <= time_source_.monotonicTime()) {
+    chains_.erase(it);
+    return absl::nullopt;
+  }
+  return it->second.detailed_status_;
+}
+
+void ValidatedChainCache::insert(const std::string& key,
+                                 Envoy::Ssl::ClientValidationStatus detailed_status) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  absl::MutexLock lock(&mutex_);
+  if (chains_.size() >= max_chains_ && !chains_.contains(key)) {
+    absl::erase_if(chains_, [now](const auto& entry) { return entry.second.expiry_ <= now; });
+    if (chains_.size() >= max_chains_) {
+      return;
+    }
+  }
+  chains_[key] = {detailed_status, now + ttl_};
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/ssl/ssl_socket_extended_info.h"
+#include "envoy/thread/thread.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "openssl/x509v3.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A pool of threads validating certificate chains, so that the workers don't stall on chain
+ * building and CRL checks when many peers handshake at once.
+ */
+class CertValidationThreadPool {
+public:
+  using Validation = std::function<void()>;
+
+  CertValidationThreadPool(Thread::ThreadFactory& thread_factory, uint32_t threads);
+  // Runs the validations which are still queued before returning.
+  ~CertValidationThreadPool();
+
+  /**
+   * Queues a validation, which runs on one of the threads of the pool.
+   */
+  void post(Validation validation);
+
+private:
+  void threadFunc();
+
+  const uint32_t thread_count_;
+  absl::Mutex mutex_;
+  std::deque<Validation> queue_ ABSL_GUARDED_BY(mutex_);
+  bool exit_ ABSL_GUARDED_BY(mutex_){false};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+/**
+ * The status of the chains which were recently validated successfully, so that peers reconnecting
+ * with the same chain are accepted without validating it again. Chains are identified by the
+ * SHA-256 fingerprints of their certificates.
+ */
+class ValidatedChainCache {
+public:
+  ValidatedChainCache(uint32_t max_chains, std::chrono::milliseconds ttl, TimeSource& time_source);
+
+  /**
+   * @return the key of cert_chain, validated by a server if is_server is true.
+   */
+  static std::string key(STACK_OF(X509)& cert_chain, bool is_server);
+
+  /**
+   * @return the status of the chain of key if it was validated successfully within the TTL.
+   */
+  absl::optional<Envoy::Ssl::ClientValidationStatus> lookup(const std::string& key);
+
+  /**
+   * Remembers that the chain of key was validated successfully, unless the cache is full of
+   * chains that were validated within the TTL.
+   */
+  void insert(const std::string& key, Envoy::Ssl::ClientValidationStatus detailed_status);
+
+private:
+  struct ValidatedChain {
+    Envoy::Ssl::ClientValidationStatus detailed_status_;
+    MonotonicTime expiry_;
+  };
+
+  const uint32_t max_chains_;
+  const std::chrono::milliseconds ttl_;
+  TimeSource& time_source_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, ValidatedChain> chains_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
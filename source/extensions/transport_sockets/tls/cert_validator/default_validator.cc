@@ -40,6 +40,14 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+namespace {
+
+constexpr uint32_t DefaultAsyncValidationThreads = 1;
+constexpr uint32_t DefaultMaxCachedChains = 1024;
+constexpr uint64_t DefaultCacheTtlMs = 60000;
+
+} // namespace
+
 DefaultCertValidator::DefaultCertValidator(
     const Envoy::Ssl::CertificateValidationContextConfig* config, SslStats& stats,
     TimeSource& time_source)
@@ -48,6 +56,21 @@ DefaultCertValidator::DefaultCertValidator(
     allow_untrusted_certificate_ = config_->trustChainVerification() ==
                                    envoy::extensions::transport_sockets::tls::v3::
                                        CertificateValidationContext::ACCEPT_UNTRUSTED;
+    if (const auto& async_validation = config_->asyncValidation(); async_validation.has_value()) {
+      const uint32_t max_cached_chains = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          *async_validation, max_cached_chains, DefaultMaxCachedChains);
+      if (max_cached_chains > 0) {
+        validated_chains_ = std::make_unique<ValidatedChainCache>(
+            max_cached_chains,
+            std::chrono::milliseconds(
+                PROTOBUF_GET_MS_OR_DEFAULT(*async_validation, cache_ttl, DefaultCacheTtlMs)),
+            time_source_);
+      }
+      validation_thread_pool_ = std::make_unique<CertValidationThreadPool>(
+          config_->api().threadFactory(),
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(*async_validation, threads,
+                                          DefaultAsyncValidationThreads));
+    }
   }
 };
 
@@ -311,7 +334,7 @@ DefaultCertValidator::verifyCertificate(X509* cert, const std::vector<std::strin
 }
 
 ValidationResults DefaultCertValidator::doVerifyCertChain(
-    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr /*callback*/,
+    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
     const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options, SSL_CTX& ssl_ctx,
     const CertValidator::ExtraValidationContext& /*validation_context*/, bool is_server,
     absl::string_view /*host_name*/) {
@@ -322,6 +345,10 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
     return {ValidationResults::ValidationStatus::Failed,
             Envoy::Ssl::ClientValidationStatus::NotValidated, absl::nullopt, error};
   }
+  if (callback != nullptr && validation_thread_pool_ != nullptr) {
+    return verifyCertChainAsync(cert_chain, std::move(callback), transport_socket_options, ssl_ctx,
+                                is_server);
+  }
   Envoy::Ssl::ClientValidationStatus detailed_status =
       Envoy::Ssl::ClientValidationStatus::NotValidated;
   X509* leaf_cert = sk_X509_value(&cert_chain, 0);
@@ -373,6 +400,67 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
                                        tls_alert, error_details};
 }
 
+ValidationResults DefaultCertValidator::verifyCertChainAsync(
+    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
+    const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options, SSL_CTX& ssl_ctx,
+    bool is_server) {
+  // The validation of a chain only depends on its certificates, unless the connection overrides
+  // the SANs to verify.
+  std::string cache_key;
+  if (validated_chains_ != nullptr &&
+      (transport_socket_options == nullptr ||
+       transport_socket_options->verifySubjectAltNameListOverride().empty())) {
+    cache_key = ValidatedChainCache::key(cert_chain, is_server);
+    const absl::optional<Envoy::Ssl::ClientValidationStatus> detailed_status =
+        validated_chains_->lookup(cache_key);
+    if (detailed_status.has_value()) {
+      stats_.async_cert_validation_cache_hit_.inc();
+      return {ValidationResults::ValidationStatus::Successful, detailed_status.value(),
+              absl::nullopt, absl::nullopt};
+    }
+  }
+
+  stats_.async_cert_validation_.inc();
+  // The validation holds references to the chain and the context, since the handshake may be
+  // cancelled meanwhile. The callback outlives the handshake, and ignores the result then.
+  struct PendingValidation {
+    bssl::UniquePtr<STACK_OF(X509)> cert_chain_;
+    bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+    Ssl::ValidateResultCallbackPtr callback_;
+    Network::TransportSocketOptionsConstSharedPtr transport_socket_options_;
+    std::string cache_key_;
+    absl::optional<ValidationResults> results_;
+  };
+  auto pending = std::make_shared<PendingValidation>();
+  pending->cert_chain_.reset(X509_chain_up_ref(&cert_chain));
+  RELEASE_ASSERT(pending->cert_chain_ != nullptr, "");
+  SSL_CTX_up_ref(&ssl_ctx);
+  pending->ssl_ctx_.reset(&ssl_ctx);
+  pending->callback_ = std::move(callback);
+  pending->transport_socket_options_ = transport_socket_options;
+  pending->cache_key_ = std::move(cache_key);
+
+  validation_thread_pool_->post([this, pending, is_server]() {
+    // The pool is destroyed before the other members, so this is still valid.
+    pending->results_ = DefaultCertValidator::doVerifyCertChain(
+        *pending->cert_chain_, nullptr, pending->transport_socket_options_, *pending->ssl_ctx_, {},
+        is_server, "");
+    if (!pending->cache_key_.empty() &&
+        pending->results_->status == ValidationResults::ValidationStatus::Successful) {
+      validated_chains_->insert(pending->cache_key_, pending->results_->detailed_status);
+    }
+    pending->callback_->dispatcher().post([pending]() {
+      const ValidationResults& results = pending->results_.value();
+      pending->callback_->onCertValidationResult(
+          results.status == ValidationResults::ValidationStatus::Successful,
+          results.detailed_status, results.error_details.value_or(""),
+          results.tls_alert.value_or(SSL_AD_CERTIFICATE_UNKNOWN));
+    });
+  });
+  return {ValidationResults::ValidationStatus::Pending,
+          Envoy::Ssl::ClientValidationStatus::NotValidated, absl::nullopt, absl::nullopt};
+}
+
 bool DefaultCertValidator::verifySubjectAltName(X509* cert,
                                                 const std::vector<std::string>& subject_alt_names) {
   bssl::UniquePtr<GENERAL_NAMES> san_names(
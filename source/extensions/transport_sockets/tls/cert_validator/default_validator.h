@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
 #include "source/common/stats/symbol_table.h"
+#include "source/extensions/transport_sockets/tls/cert_validator/async_validation.h"
 #include "source/extensions/transport_sockets/tls/cert_validator/cert_validator.h"
 #include "source/extensions/transport_sockets/tls/cert_validator/san_matcher.h"
 #include "source/extensions/transport_sockets/tls/stats.h"
@@ -107,6 +109,13 @@ public:
                                   const std::vector<SanMatcherPtr>& subject_alt_name_matchers);
 
 private:
+  // Validates cert_chain on the validation thread pool, unless it was validated recently, and
+  // passes the result to callback on its dispatcher.
+  ValidationResults verifyCertChainAsync(
+      STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
+      const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options,
+      SSL_CTX& ssl_ctx, bool is_server);
+
   bool verifyCertAndUpdateStatus(X509* leaf_cert,
                                  const Network::TransportSocketOptions* transport_socket_options,
                                  Envoy::Ssl::ClientValidationStatus& detailed_status,
@@ -123,6 +132,11 @@ private:
   std::vector<std::vector<uint8_t>> verify_certificate_hash_list_;
   std::vector<std::vector<uint8_t>> verify_certificate_spki_list_;
   bool verify_trusted_ca_{false};
+  // Only set when the chains are validated asynchronously.
+  std::unique_ptr<ValidatedChainCache> validated_chains_;
+  // Declared last so that the validations still running are done before the other members are
+  // destroyed.
+  std::unique_ptr<CertValidationThreadPool> validation_thread_pool_;
 };
 
 DECLARE_FACTORY(DefaultCertValidatorFactory);
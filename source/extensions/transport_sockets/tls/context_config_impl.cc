@@ -189,7 +189,8 @@ ContextConfigImpl::ContextConfigImpl(
                                                 default_max_protocol_version)),
       factory_context_(factory_context), tls_keylog_path_(config.key_log().path()),
       tls_keylog_local_(config.key_log().local_address_range()),
-      tls_keylog_remote_(config.key_log().remote_address_range()) {
+      tls_keylog_remote_(config.key_log().remote_address_range()),
+      kernel_tls_tx_(config.enable_kernel_tls_tx()) {
   if (certificate_validation_context_provider_ != nullptr) {
     if (default_cvc_) {
       // We need to validate combined certificate validation context.
@@ -396,7 +397,13 @@ ServerContextConfigImpl::ServerContextConfigImpl(
       full_scan_certs_on_sni_mismatch_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
           config, full_scan_certs_on_sni_mismatch,
           !Runtime::runtimeFeatureEnabled(
-              "envoy.reloadable_features.no_full_scan_certs_on_sni_mismatch"))) {
+              "envoy.reloadable_features.no_full_scan_certs_on_sni_mismatch"))),
+      max_cached_sessions_(config.has_max_cached_sessions()
+                               ? absl::optional<uint32_t>(config.max_cached_sessions().value())
+                               : absl::nullopt),
+      handshake_offload_(config.has_handshake_offload()
+                             ? absl::make_optional(config.handshake_offload())
+                             : absl::nullopt) {
 
   if (session_ticket_keys_provider_ != nullptr) {
     // Validate tls session ticket keys early to reject bad sds updates.
@@ -44,9 +44,11 @@ public:
   const Network::Address::IpList& tlsKeyLogLocal() const override { return tls_keylog_local_; };
   const Network::Address::IpList& tlsKeyLogRemote() const override { return tls_keylog_remote_; };
   const std::string& tlsKeyLogPath() const override { return tls_keylog_path_; };
+  bool kernelTlsTx() const override { return kernel_tls_tx_; }
   AccessLog::AccessLogManager& accessLogManager() const override {
     return factory_context_.accessLogManager();
   }
+  Api::Api& api() const override { return api_; }
 
   bool isReady() const override {
     const bool tls_is_ready =
@@ -111,6 +113,7 @@ private:
   const std::string tls_keylog_path_;
   const Network::Address::IpList tls_keylog_local_;
   const Network::Address::IpList tls_keylog_remote_;
+  const bool kernel_tls_tx_;
 };
 
 class ClientContextConfigImpl : public ContextConfigImpl, public Envoy::Ssl::ClientContextConfig {
@@ -171,6 +174,12 @@ public:
 
   bool fullScanCertsOnSNIMismatch() const override { return full_scan_certs_on_sni_mismatch_; }
 
+  absl::optional<uint32_t> maxCachedSessions() const override { return max_cached_sessions_; }
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::HandshakeOffload>&
+  handshakeOffload() const override {
+    return handshake_offload_;
+  }
+
 private:
   static const unsigned DEFAULT_MIN_VERSION;
   static const unsigned DEFAULT_MAX_VERSION;
@@ -194,6 +203,9 @@ private:
   absl::optional<std::chrono::seconds> session_timeout_;
   const bool disable_stateless_session_resumption_;
   bool full_scan_certs_on_sni_mismatch_;
+  const absl::optional<uint32_t> max_cached_sessions_;
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::HandshakeOffload>
+      handshake_offload_;
 };
 
 } // namespace Tls
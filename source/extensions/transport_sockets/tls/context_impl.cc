@@ -27,6 +27,7 @@
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/utility.h"
 #include "source/extensions/transport_sockets/tls/cert_validator/factory.h"
+#include "source/extensions/transport_sockets/tls/private_key/handshake_offload.h"
 #include "source/extensions/transport_sockets/tls/stats.h"
 #include "source/extensions/transport_sockets/tls/utility.h"
 
@@ -46,6 +47,27 @@ namespace Tls {
 
 namespace {
 
+// The maximum number of server names whose session keys a client context stores.
+constexpr uint32_t MaxSessionKeysServerNames = 1024;
+
+constexpr uint32_t DefaultHandshakeOffloadThreads = 1;
+constexpr uint32_t DefaultHandshakeOffloadMaxPendingOperations = 1024;
+
+// Returns the key of the session keys stored for the connections to server_name.
+std::string sessionKeysKey(absl::string_view server_name) {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.tls_client_session_keys_per_server_name")) {
+    return "";
+  }
+  return std::string(server_name);
+}
+
+absl::string_view sessionId(const SSL_SESSION* session) {
+  unsigned int length = 0;
+  const uint8_t* id = SSL_SESSION_get_id(session, &length);
+  return {reinterpret_cast<const char*>(id), length};
+}
+
 bool cbsContainsU16(CBS& cbs, uint16_t n) {
   while (CBS_len(&cbs) > 0) {
     uint16_t v;
@@ -92,7 +114,8 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
       ssl_versions_(stat_name_set_->add("ssl.versions")),
       ssl_curves_(stat_name_set_->add("ssl.curves")),
       ssl_sigalgs_(stat_name_set_->add("ssl.sigalgs")), capabilities_(config.capabilities()),
-      tls_keylog_local_(config.tlsKeyLogLocal()), tls_keylog_remote_(config.tlsKeyLogRemote()) {
+      tls_keylog_local_(config.tlsKeyLogLocal()), tls_keylog_remote_(config.tlsKeyLogRemote()),
+      kernel_tls_tx_(config.kernelTlsTx()) {
 
   auto cert_validator_name = getCertValidatorName(config.certificateValidationContext());
   auto cert_validator_factory =
@@ -630,7 +653,7 @@ ClientContextImpl::ClientContextImpl(Stats::Scope& scope,
     : ContextImpl(scope, config, time_source),
       server_name_indication_(config.serverNameIndication()),
       allow_renegotiation_(config.allowRenegotiation()),
-      max_session_keys_(config.maxSessionKeys()) {
+      max_session_keys_(config.maxSessionKeys()), session_keys_(MaxSessionKeysServerNames) {
   // This should be guaranteed during configuration ingestion for client contexts.
   ASSERT(tls_contexts_.size() == 1);
   if (!parsed_alpn_protocols_.empty()) {
@@ -660,7 +683,7 @@ ClientContextImpl::ClientContextImpl(Stats::Scope& scope,
               static_cast<ContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
           ClientContextImpl* client_context_impl = dynamic_cast<ClientContextImpl*>(context_impl);
           RELEASE_ASSERT(client_context_impl != nullptr, ""); // for Coverity
-          return client_context_impl->newSessionKey(session);
+          return client_context_impl->newSessionKey(ssl, session);
         });
   }
 }
@@ -717,47 +740,54 @@ ClientContextImpl::newSsl(const Network::TransportSocketOptionsConstSharedPtr& o
   }
 
   if (max_session_keys_ > 0) {
+    bool found = false;
+    // Use the most recently stored session key, since it has the highest probability of still
+    // being recognized/accepted by the server.
+    const auto use_session_key =
+        [&found, &ssl_con](const std::deque<bssl::UniquePtr<SSL_SESSION>>& session_keys) {
+          if (!session_keys.empty()) {
+            SSL_set_session(ssl_con.get(), session_keys.front().get());
+            found = true;
+          }
+        };
+    const std::string session_keys_key = sessionKeysKey(server_name_indication);
     if (session_keys_single_use_) {
       // Stored single-use session keys, use write/write locks.
-      absl::WriterMutexLock l(&session_keys_mu_);
-      if (!session_keys_.empty()) {
-        // Use the most recently stored session key, since it has the highest
-        // probability of still being recognized/accepted by the server.
-        SSL_SESSION* session = session_keys_.front().get();
-        SSL_set_session(ssl_con.get(), session);
-        // Remove single-use session key (TLS 1.3) after first use.
-        if (SSL_SESSION_should_be_single_use(session)) {
-          session_keys_.pop_front();
-        }
-      }
+      session_keys_.modify(session_keys_key,
+                           [&](std::deque<bssl::UniquePtr<SSL_SESSION>>& session_keys) {
+                             use_session_key(session_keys);
+                             // Remove single-use session key (TLS 1.3) after first use.
+                             if (found &&
+                                 SSL_SESSION_should_be_single_use(session_keys.front().get())) {
+                               session_keys.pop_front();
+                             }
+                           });
     } else {
       // Never stored single-use session keys, use read/write locks.
-      absl::ReaderMutexLock l(&session_keys_mu_);
-      if (!session_keys_.empty()) {
-        // Use the most recently stored session key, since it has the highest
-        // probability of still being recognized/accepted by the server.
-        SSL_SESSION* session = session_keys_.front().get();
-        SSL_set_session(ssl_con.get(), session);
-      }
+      session_keys_.read(session_keys_key, use_session_key);
     }
+    (found ? stats_.session_cache_hit_ : stats_.session_cache_miss_).inc();
   }
 
   return ssl_con;
 }
 
-int ClientContextImpl::newSessionKey(SSL_SESSION* session) {
+int ClientContextImpl::newSessionKey(SSL* ssl, SSL_SESSION* session) {
   // In case we ever store single-use session key (TLS 1.3),
   // we need to switch to using write/write locks.
   if (SSL_SESSION_should_be_single_use(session)) {
     session_keys_single_use_ = true;
   }
-  absl::WriterMutexLock l(&session_keys_mu_);
-  // Evict oldest entries.
-  while (session_keys_.size() >= max_session_keys_) {
-    session_keys_.pop_back();
-  }
-  // Add new session key at the front of the queue, so that it's used first.
-  session_keys_.push_front(bssl::UniquePtr<SSL_SESSION>(session));
+  session_keys_.update(
+      sessionKeysKey(absl::NullSafeStringView(SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name))),
+      [this, session](std::deque<bssl::UniquePtr<SSL_SESSION>>& session_keys) {
+        // Evict oldest entries.
+        while (session_keys.size() >= max_session_keys_) {
+          session_keys.pop_back();
+        }
+        // Add new session key at the front of the queue, so that it's used first.
+        session_keys.push_front(bssl::UniquePtr<SSL_SESSION>(session));
+      });
   return 1; // Tell BoringSSL that we took ownership of the session.
 }
 
@@ -782,6 +812,31 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
   if (config.tlsCertificates().empty() && !config.capabilities().provides_certificates) {
     throw EnvoyException("Server TlsCertificates must have a certificate specified");
   }
+  if (config.maxCachedSessions().value_or(0) > 0 &&
+      !config.capabilities().handles_session_resumption) {
+    session_cache_ = std::make_unique<ShardedSessionCache<bssl::UniquePtr<SSL_SESSION>>>(
+        config.maxCachedSessions().value());
+  }
+  if (const auto& offload = config.handshakeOffload();
+      offload.has_value() && !config.capabilities().provides_certificates) {
+    auto pool = std::make_shared<HandshakeThreadPool>(
+        config.api().threadFactory(),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(*offload, threads, DefaultHandshakeOffloadThreads),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(*offload, max_pending_operations,
+                                        DefaultHandshakeOffloadMaxPendingOperations));
+    for (auto& ctx : tls_contexts_) {
+      // The keys of the private key providers are left to them.
+      if (ctx.private_key_method_provider_ != nullptr ||
+          SSL_CTX_get0_privatekey(ctx.ssl_ctx_.get()) == nullptr) {
+        continue;
+      }
+      ctx.private_key_method_provider_ = std::make_shared<HandshakeOffloadPrivateKeyMethodProvider>(
+          pool, stats_.handshake_offload_, stats_.handshake_offload_rejected_);
+      SSL_CTX_set_private_key_method(
+          ctx.ssl_ctx_.get(),
+          ctx.private_key_method_provider_->getBoringSslPrivateKeyMethod().get());
+    }
+  }
 
   for (auto& ctx : tls_contexts_) {
     if (ctx.cert_chain_ == nullptr) {
@@ -850,6 +905,29 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
           });
     }
 
+    if (session_cache_ != nullptr) {
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->newSession(session);
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* id, int id_len, int* out_copy) -> SSL_SESSION* {
+            // The session is returned with a reference of its own.
+            *out_copy = 0;
+            return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                ->getSession(absl::string_view(reinterpret_cast<const char*>(id), id_len));
+          });
+      SSL_CTX_sess_set_remove_cb(ctx.ssl_ctx_.get(), [](SSL_CTX* ssl_ctx, SSL_SESSION* session) {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(ssl_ctx))->removeSession(session);
+      });
+    } else if (config.maxCachedSessions().has_value() &&
+               !config.capabilities().handles_session_resumption) {
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
+    }
+
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
       auto timeout = config.sessionTimeout().value().count();
       SSL_CTX_set_timeout(ctx.ssl_ctx_.get(), uint32_t(timeout));
@@ -1038,6 +1116,32 @@ ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string
   return session_id;
 }
 
+int ServerContextImpl::newSession(SSL_SESSION* session) {
+  const absl::string_view session_id = sessionId(session);
+  if (session_id.empty()) {
+    return 0;
+  }
+  session_cache_->update(session_id, [session](bssl::UniquePtr<SSL_SESSION>& cached_session) {
+    cached_session.reset(session);
+  });
+  return 1; // Tell BoringSSL that we took ownership of the session.
+}
+
+SSL_SESSION* ServerContextImpl::getSession(absl::string_view session_id) {
+  SSL_SESSION* session = nullptr;
+  session_cache_->read(session_id,
+                       [&session](const bssl::UniquePtr<SSL_SESSION>& cached_session) {
+                         SSL_SESSION_up_ref(cached_session.get());
+                         session = cached_session.get();
+                       });
+  (session != nullptr ? stats_.session_cache_hit_ : stats_.session_cache_miss_).inc();
+  return session;
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  session_cache_->erase(sessionId(session));
+}
+
 int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv,
                                             EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
   const EVP_MD* hmac = EVP_sha256();
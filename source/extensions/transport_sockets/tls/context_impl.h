@@ -3,6 +3,7 @@
 #include <openssl/safestack.h>
 
 #include <array>
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -22,6 +23,7 @@
 #include "source/extensions/transport_sockets/tls/cert_validator/cert_validator.h"
 #include "source/extensions/transport_sockets/tls/context_manager_impl.h"
 #include "source/extensions/transport_sockets/tls/ocsp/ocsp.h"
+#include "source/extensions/transport_sockets/tls/session_cache.h"
 #include "source/extensions/transport_sockets/tls/stats.h"
 
 #include "absl/synchronization/mutex.h"
@@ -76,6 +78,12 @@ public:
 
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return whether the encryption of the data sent after the handshake is handed over to the
+   * kernel, see enableKernelTlsTx().
+   */
+  bool kernelTlsTx() const { return kernel_tls_tx_; }
+
   /**
    * The global SSL-library index used for storing a pointer to the SslExtendedSocketInfo
    * class in the SSL instance, for retrieval in callbacks.
@@ -139,9 +147,11 @@ protected:
   // potentially switch to a different CertificateContext based on certificate
   // selection.
   std::vector<TlsContext> tls_contexts_;
-  CertValidatorPtr cert_validator_;
   Stats::Scope& scope_;
   SslStats stats_;
+  // Declared after the stats, which the validations still running may update when the validator
+  // is destroyed.
+  CertValidatorPtr cert_validator_;
   std::vector<uint8_t> parsed_alpn_protocols_;
   bssl::UniquePtr<X509> cert_chain_;
   std::string cert_chain_file_path_;
@@ -160,6 +170,7 @@ protected:
   const Network::Address::IpList tls_keylog_local_;
   const Network::Address::IpList tls_keylog_remote_;
   AccessLog::AccessLogFileSharedPtr tls_keylog_file_;
+  const bool kernel_tls_tx_;
 };
 
 using ContextImplSharedPtr = std::shared_ptr<ContextImpl>;
@@ -173,15 +184,15 @@ public:
   newSsl(const Network::TransportSocketOptionsConstSharedPtr& options) override;
 
 private:
-  int newSessionKey(SSL_SESSION* session);
+  int newSessionKey(SSL* ssl, SSL_SESSION* session);
   uint16_t parseSigningAlgorithmsForTest(const std::string& sigalgs);
 
   const std::string server_name_indication_;
   const bool allow_renegotiation_;
   const size_t max_session_keys_;
-  absl::Mutex session_keys_mu_;
-  std::deque<bssl::UniquePtr<SSL_SESSION>> session_keys_ ABSL_GUARDED_BY(session_keys_mu_);
-  bool session_keys_single_use_{false};
+  // The session keys of each server name, the most recently stored first.
+  ShardedSessionCache<std::deque<bssl::UniquePtr<SSL_SESSION>>> session_keys_;
+  std::atomic<bool> session_keys_single_use_{false};
 };
 
 enum class OcspStapleAction { Staple, NoStaple, Fail, ClientNotCapable };
@@ -213,6 +224,9 @@ private:
                          unsigned int inlen);
   int sessionTicketProcess(SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
                            HMAC_CTX* hmac_ctx, int encrypt);
+  int newSession(SSL_SESSION* session);
+  SSL_SESSION* getSession(absl::string_view session_id);
+  void removeSession(SSL_SESSION* session);
   bool isClientEcdsaCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   bool isClientOcspCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   OcspStapleAction ocspStapleAction(const TlsContext& ctx, bool client_ocsp_capable);
@@ -224,6 +238,8 @@ private:
   ServerNamesMap server_names_map_;
   bool has_rsa_;
   bool full_scan_certs_on_sni_mismatch_;
+  // Only set when Envoy caches the sessions resumed by their session ID.
+  std::unique_ptr<ShardedSessionCache<bssl::UniquePtr<SSL_SESSION>>> session_cache_;
 };
 
 } // namespace Tls
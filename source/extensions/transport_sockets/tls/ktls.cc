@@ -0,0 +1,210 @@
+#include "source/extensions/transport_sockets/tls/ktls.h"
+
+#include <cstring>
+
+#include "envoy/api/os_sys_calls.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+
+#include "absl/strings/string_view.h"
+#include "openssl/hkdf.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#endif
+
+// The TLS 1.3 and AES-256-GCM definitions came with Linux 5.1.
+#if defined(__linux__) && defined(TLS_1_3_VERSION) && defined(TLS_CIPHER_AES_GCM_256)
+#define ENVOY_KERNEL_TLS
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+#ifdef ENVOY_KERNEL_TLS
+
+namespace {
+
+// The size of the nonce of AES-GCM, made of a 4 byte salt and an 8 byte IV.
+constexpr size_t NonceSize = 12;
+constexpr size_t SaltSize = 4;
+constexpr uint8_t AlertRecordType = 21;
+
+struct WriteKeys {
+  uint8_t key[32];
+  size_t key_size;
+  uint8_t nonce[NonceSize];
+};
+
+void storeBigEndian(uint64_t value, uint8_t* out) {
+  for (int i = 7; i >= 0; i--) {
+    out[i] = value & 0xff;
+    value >>= 8;
+  }
+}
+
+// HKDF-Expand-Label of RFC 8446, with an empty context.
+bool expandLabel(const EVP_MD* digest, bssl::Span<const uint8_t> secret, absl::string_view label,
+                 uint8_t* out, size_t out_size) {
+  constexpr absl::string_view Prefix = "tls13 ";
+  uint8_t info[2 + 1 + 255 + 1];
+  size_t info_size = 0;
+  info[info_size++] = out_size >> 8;
+  info[info_size++] = out_size & 0xff;
+  info[info_size++] = Prefix.size() + label.size();
+  memcpy(info + info_size, Prefix.data(), Prefix.size());
+  info_size += Prefix.size();
+  memcpy(info + info_size, label.data(), label.size());
+  info_size += label.size();
+  info[info_size++] = 0;
+  return HKDF_expand(out, out_size, digest, secret.data(), secret.size(), info, info_size) == 1;
+}
+
+bool tls12WriteKeys(const SSL* ssl, size_t key_size, uint64_t sequence, WriteKeys& keys) {
+  // The key block of the AEAD ciphers holds the client and server write keys, followed by the
+  // client and server salts. The explicit part of the nonce is the sequence number.
+  uint8_t key_block[2 * (32 + SaltSize)];
+  const size_t key_block_size = 2 * (key_size + SaltSize);
+  if (SSL_get_key_block_len(ssl) != key_block_size ||
+      !SSL_generate_key_block(ssl, key_block, key_block_size)) {
+    return false;
+  }
+  const size_t index = SSL_is_server(ssl) ? 1 : 0;
+  memcpy(keys.key, key_block + index * key_size, key_size);
+  keys.key_size = key_size;
+  memcpy(keys.nonce, key_block + 2 * key_size + index * SaltSize, SaltSize);
+  storeBigEndian(sequence, keys.nonce + SaltSize);
+  return true;
+}
+
+bool tls13WriteKeys(const SSL* ssl, size_t key_size, const EVP_MD* digest, WriteKeys& keys) {
+  bssl::Span<const uint8_t> read_secret;
+  bssl::Span<const uint8_t> write_secret;
+  if (!bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret)) {
+    return false;
+  }
+  keys.key_size = key_size;
+  return expandLabel(digest, write_secret, "key", keys.key, key_size) &&
+         expandLabel(digest, write_secret, "iv", keys.nonce, NonceSize);
+}
+
+template <class CryptoInfo>
+KernelTlsResult setTx(Network::IoHandle& io_handle, uint16_t version, uint16_t cipher_type,
+                      const WriteKeys& keys, uint64_t sequence) {
+  CryptoInfo crypto_info;
+  memset(&crypto_info, 0, sizeof(crypto_info));
+  crypto_info.info.version = version;
+  crypto_info.info.cipher_type = cipher_type;
+  ASSERT(keys.key_size == sizeof(crypto_info.key));
+  memcpy(crypto_info.key, keys.key, sizeof(crypto_info.key));
+  memcpy(crypto_info.salt, keys.nonce, sizeof(crypto_info.salt));
+  memcpy(crypto_info.iv, keys.nonce + SaltSize, sizeof(crypto_info.iv));
+  storeBigEndian(sequence, crypto_info.rec_seq);
+
+  static constexpr char Ulp[] = "tls";
+  if (io_handle.setOption(IPPROTO_TCP, TCP_ULP, Ulp, sizeof(Ulp)).return_value_ != 0) {
+    return KernelTlsResult::Failed;
+  }
+  const bool enabled =
+      io_handle.setOption(SOL_TLS, TLS_TX, &crypto_info, sizeof(crypto_info)).return_value_ == 0;
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  return enabled ? KernelTlsResult::Enabled : KernelTlsResult::Failed;
+}
+
+} // namespace
+
+KernelTlsResult enableKernelTlsTx(const SSL* ssl, Network::IoHandle& io_handle) {
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) {
+    return KernelTlsResult::Unsupported;
+  }
+  size_t key_size;
+  const EVP_MD* digest;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+    key_size = 16;
+    digest = EVP_sha256();
+    break;
+  case NID_aes_256_gcm:
+    key_size = 32;
+    digest = EVP_sha384();
+    break;
+  default:
+    return KernelTlsResult::Unsupported;
+  }
+
+  const uint64_t sequence = SSL_get_write_sequence(ssl);
+  WriteKeys keys;
+  uint16_t version;
+  switch (SSL_version(ssl)) {
+  case TLS1_2_VERSION:
+    version = TLS_1_2_VERSION;
+    if (!tls12WriteKeys(ssl, key_size, sequence, keys)) {
+      return KernelTlsResult::Unsupported;
+    }
+    break;
+  case TLS1_3_VERSION:
+    version = TLS_1_3_VERSION;
+    if (!tls13WriteKeys(ssl, key_size, digest, keys)) {
+      return KernelTlsResult::Unsupported;
+    }
+    break;
+  default:
+    return KernelTlsResult::Unsupported;
+  }
+
+  const KernelTlsResult result =
+      key_size == 16 ? setTx<tls12_crypto_info_aes_gcm_128>(io_handle, version,
+                                                            TLS_CIPHER_AES_GCM_128, keys, sequence)
+                     : setTx<tls12_crypto_info_aes_gcm_256>(io_handle, version,
+                                                            TLS_CIPHER_AES_GCM_256, keys, sequence);
+  OPENSSL_cleanse(&keys, sizeof(keys));
+  return result;
+}
+
+bool sendKernelTlsCloseNotify(Network::IoHandle& io_handle) {
+  // A warning level close_notify alert, sent as a record of the alert type.
+  uint8_t alert[2] = {1, 0};
+  iovec iov{alert, sizeof(alert)};
+  char control[CMSG_SPACE(sizeof(uint8_t))];
+  memset(control, 0, sizeof(control));
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = AlertRecordType;
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, 0);
+  return result.return_value_ == static_cast<ssize_t>(sizeof(alert));
+}
+
+#else
+
+KernelTlsResult enableKernelTlsTx(const SSL*, Network::IoHandle&) {
+  return KernelTlsResult::Unsupported;
+}
+
+bool sendKernelTlsCloseNotify(Network::IoHandle&) { return false; }
+
+#endif
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
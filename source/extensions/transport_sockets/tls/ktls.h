@@ -0,0 +1,41 @@
+#pragma once
+
+#include "envoy/network/io_handle.h"
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+enum class KernelTlsResult {
+  // The kernel encrypts the data written to the socket from now on.
+  Enabled,
+  // The platform, the protocol version or the cipher of the connection isn't supported.
+  Unsupported,
+  // The kernel refused the keys, e.g. because the tls module isn't loaded. The socket is left as
+  // it was.
+  Failed,
+};
+
+/**
+ * Hands the encryption of the data written to the socket over to the kernel (Linux kTLS), with the
+ * write keys and sequence number of the completed handshake of ssl. Only TLS 1.2 and TLS 1.3 with
+ * AES-GCM ciphers are supported. Once enabled, ssl must not write to the socket anymore.
+ * @param ssl supplies the connection, whose handshake is complete.
+ * @param io_handle supplies the socket of the connection.
+ * @return KernelTlsResult whether the kernel encrypts the data written from now on.
+ */
+KernelTlsResult enableKernelTlsTx(const SSL* ssl, Network::IoHandle& io_handle);
+
+/**
+ * Sends the close_notify alert through a socket whose encryption was handed over to the kernel.
+ * @return whether the alert was sent.
+ */
+bool sendKernelTlsCloseNotify(Network::IoHandle& io_handle);
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,263 @@
+#include "source/extensions/transport_sockets/tls/private_key/handshake_offload.h"
+
+#include <cstring>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+#include "openssl/err.h"
+#include "openssl/evp.h"
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+HandshakeThreadPool::HandshakeThreadPool(Thread::ThreadFactory& thread_factory, uint32_t threads,
+                                         uint32_t max_pending_operations)
+    : max_pending_operations_(max_pending_operations) {
+  ASSERT(threads > 0);
+  for (uint32_t i = 0; i < threads; i++) {
+    threads_.push_back(thread_factory.createThread([this]() { threadFunc(); },
+                                                   Thread::Options{"TlsHandshake"}));
+  }
+}
+
+HandshakeThreadPool::~HandshakeThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    exit_ = true;
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+bool HandshakeThreadPool::tryPost(Operation operation) {
+  absl::MutexLock lock(&mutex_);
+  if (queue_.size() >= max_pending_operations_) {
+    return false;
+  }
+  queue_.push_back(std::move(operation));
+  return true;
+}
+
+void HandshakeThreadPool::threadFunc() {
+  const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || exit_;
+  };
+  while (true) {
+    Operation operation;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      if (queue_.empty()) {
+        return;
+      }
+      // The operations take much longer than locking, so there is no point in taking several at
+      // once.
+      operation = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    operation();
+  }
+}
+
+struct HandshakeOffloadPrivateKeyMethodProvider::Operation {
+  // Performs the operation on a thread of the pool.
+  void run() {
+    succeeded_ = decrypt_ ? runDecrypt() : runSign();
+    if (!succeeded_) {
+      // The errors are queued per thread, and this one doesn't handshake.
+      ERR_clear_error();
+    }
+  }
+
+  bool runSign() {
+    if (SSL_get_signature_algorithm_key_type(signature_algorithm_) != EVP_PKEY_id(pkey_.get())) {
+      return false;
+    }
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pctx;
+    if (!EVP_DigestSignInit(ctx.get(), &pctx,
+                            SSL_get_signature_algorithm_digest(signature_algorithm_), nullptr,
+                            pkey_.get())) {
+      return false;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm_) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1 /* salt length is digest length */))) {
+      return false;
+    }
+    size_t length = EVP_PKEY_size(pkey_.get());
+    output_.resize(length);
+    if (!EVP_DigestSign(ctx.get(), output_.data(), &length, input_.data(), input_.size())) {
+      return false;
+    }
+    output_.resize(length);
+    return true;
+  }
+
+  bool runDecrypt() {
+    RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+    if (rsa == nullptr) {
+      return false;
+    }
+    size_t length = RSA_size(rsa);
+    output_.resize(length);
+    if (!RSA_decrypt(rsa, &length, output_.data(), output_.size(), input_.data(), input_.size(),
+                     RSA_NO_PADDING)) {
+      return false;
+    }
+    output_.resize(length);
+    return true;
+  }
+
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  bool decrypt_{false};
+  uint16_t signature_algorithm_{0};
+  std::vector<uint8_t> input_;
+  // Written by the thread of the pool before completing the operation on the worker.
+  std::vector<uint8_t> output_;
+  bool succeeded_{false};
+  // Only used by the worker.
+  bool completed_{false};
+  bool cancelled_{false};
+};
+
+// The state of a connection, which performs a single operation at once.
+class HandshakeOffloadPrivateKeyMethodProvider::Connection {
+public:
+  Connection(HandshakeOffloadPrivateKeyMethodProvider& provider,
+             Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher)
+      : provider_(provider), cb_(cb), dispatcher_(dispatcher) {}
+  ~Connection() {
+    if (operation_ != nullptr) {
+      operation_->cancelled_ = true;
+    }
+  }
+
+  ssl_private_key_result_t start(SSL* ssl, std::shared_ptr<Operation> operation) {
+    EVP_PKEY* pkey = SSL_get_privatekey(ssl);
+    if (operation_ != nullptr || pkey == nullptr) {
+      return ssl_private_key_failure;
+    }
+    operation->pkey_ = bssl::UpRef(pkey);
+    if (!provider_.pool_->tryPost([operation, &cb = cb_, &dispatcher = dispatcher_]() {
+          operation->run();
+          dispatcher.post([operation, &cb]() {
+            if (!operation->cancelled_) {
+              operation->completed_ = true;
+              cb.onPrivateKeyMethodComplete();
+            }
+          });
+        })) {
+      provider_.rejected_.inc();
+      return ssl_private_key_failure;
+    }
+    provider_.offloaded_.inc();
+    operation_ = std::move(operation);
+    return ssl_private_key_retry;
+  }
+
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out) {
+    if (operation_ == nullptr) {
+      return ssl_private_key_failure;
+    }
+    if (!operation_->completed_) {
+      return ssl_private_key_retry;
+    }
+    const std::shared_ptr<Operation> operation = std::move(operation_);
+    if (!operation->succeeded_ || operation->output_.size() > max_out) {
+      return ssl_private_key_failure;
+    }
+    memcpy(out, operation->output_.data(), operation->output_.size()); // NOLINT(safe-memcpy)
+    *out_len = operation->output_.size();
+    return ssl_private_key_success;
+  }
+
+private:
+  HandshakeOffloadPrivateKeyMethodProvider& provider_;
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  Event::Dispatcher& dispatcher_;
+  std::shared_ptr<Operation> operation_;
+};
+
+HandshakeOffloadPrivateKeyMethodProvider::HandshakeOffloadPrivateKeyMethodProvider(
+    HandshakeThreadPoolSharedPtr pool, Stats::Counter& offloaded, Stats::Counter& rejected)
+    : pool_(std::move(pool)), offloaded_(offloaded), rejected_(rejected),
+      method_(std::make_shared<SSL_PRIVATE_KEY_METHOD>(
+          SSL_PRIVATE_KEY_METHOD{&sign, &decrypt, &complete})) {}
+
+int HandshakeOffloadPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, []() -> int {
+    int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    RELEASE_ASSERT(index >= 0, "");
+    return index;
+  }());
+}
+
+HandshakeOffloadPrivateKeyMethodProvider::Connection*
+HandshakeOffloadPrivateKeyMethodProvider::connection(SSL* ssl) {
+  return static_cast<Connection*>(SSL_get_ex_data(ssl, connectionIndex()));
+}
+
+void HandshakeOffloadPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  // The providers of the certificates of a context share its pool, so that the connection is
+  // registered once for all of them.
+  if (connection(ssl) != nullptr) {
+    return;
+  }
+  SSL_set_ex_data(ssl, connectionIndex(), new Connection(*this, cb, dispatcher));
+}
+
+void HandshakeOffloadPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  Connection* ops = connection(ssl);
+  if (ops == nullptr) {
+    return;
+  }
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete ops;
+}
+
+ssl_private_key_result_t HandshakeOffloadPrivateKeyMethodProvider::sign(
+    SSL* ssl, uint8_t*, size_t*, size_t, uint16_t signature_algorithm, const uint8_t* in,
+    size_t in_len) {
+  Connection* ops = connection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  auto operation = std::make_shared<Operation>();
+  operation->signature_algorithm_ = signature_algorithm;
+  operation->input_.assign(in, in + in_len);
+  return ops->start(ssl, std::move(operation));
+}
+
+ssl_private_key_result_t HandshakeOffloadPrivateKeyMethodProvider::decrypt(SSL* ssl, uint8_t*,
+                                                                          size_t*, size_t,
+                                                                          const uint8_t* in,
+                                                                          size_t in_len) {
+  Connection* ops = connection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  auto operation = std::make_shared<Operation>();
+  operation->decrypt_ = true;
+  operation->input_.assign(in, in + in_len);
+  return ops->start(ssl, std::move(operation));
+}
+
+ssl_private_key_result_t HandshakeOffloadPrivateKeyMethodProvider::complete(SSL* ssl,
+                                                                           uint8_t* out,
+                                                                           size_t* out_len,
+                                                                           size_t max_out) {
+  Connection* ops = connection(ssl);
+  return ops == nullptr ? ssl_private_key_failure : ops->complete(out, out_len, max_out);
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
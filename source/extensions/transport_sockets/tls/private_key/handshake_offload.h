@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_callbacks.h"
+#include "envoy/stats/stats.h"
+#include "envoy/thread/thread.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A pool of threads performing the private key operations of handshakes, with a bounded queue.
+ */
+class HandshakeThreadPool {
+public:
+  using Operation = std::function<void()>;
+
+  HandshakeThreadPool(Thread::ThreadFactory& thread_factory, uint32_t threads,
+                      uint32_t max_pending_operations);
+  // Runs the operations which are still queued before returning.
+  ~HandshakeThreadPool();
+
+  /**
+   * Queues an operation, which runs on one of the threads of the pool.
+   * @return false if the queue is full, in which case the operation is dropped.
+   */
+  bool tryPost(Operation operation);
+
+private:
+  void threadFunc();
+
+  const uint32_t max_pending_operations_;
+  absl::Mutex mutex_;
+  std::deque<Operation> queue_ ABSL_GUARDED_BY(mutex_);
+  bool exit_ ABSL_GUARDED_BY(mutex_){false};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using HandshakeThreadPoolSharedPtr = std::shared_ptr<HandshakeThreadPool>;
+
+/**
+ * A private key method provider performing the operations of the private keys loaded by Envoy on
+ * a HandshakeThreadPool, and resuming the handshakes on their workers once they are done. The key
+ * of an operation is the one of the certificate selected for the connection.
+ */
+class HandshakeOffloadPrivateKeyMethodProvider : public Ssl::PrivateKeyMethodProvider {
+public:
+  /**
+   * @param pool supplies the pool performing the operations.
+   * @param offloaded supplies the counter of the operations queued to the pool.
+   * @param rejected supplies the counter of the operations failed because the queue was full.
+   */
+  HandshakeOffloadPrivateKeyMethodProvider(HandshakeThreadPoolSharedPtr pool,
+                                           Stats::Counter& offloaded, Stats::Counter& rejected);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  // The operations are performed by BoringSSL like those of the workers.
+  bool checkFips() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+private:
+  struct Operation;
+  class Connection;
+
+  static int connectionIndex();
+  static Connection* connection(SSL* ssl);
+  static ssl_private_key_result_t sign(SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                                       uint16_t signature_algorithm, const uint8_t* in,
+                                       size_t in_len);
+  static ssl_private_key_result_t decrypt(SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                                          const uint8_t* in, size_t in_len);
+  static ssl_private_key_result_t complete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                           size_t max_out);
+
+  const HandshakeThreadPoolSharedPtr pool_;
+  Stats::Counter& offloaded_;
+  Stats::Counter& rejected_;
+  const Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
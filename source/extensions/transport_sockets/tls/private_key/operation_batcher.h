@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/common/assert.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * Collects the private key operations of the connections of a worker into batches, for the
+ * providers processing several operations at once, e.g. with multi-buffer instructions. A batch is
+ * flushed as soon as it is full, or else at a deadline adapted to the rate at which the operations
+ * arrive: the time the batch is expected to take to fill, or no time at all when no other
+ * operation is expected within the maximum delay, so that sparse operations aren't delayed for
+ * nothing. Only used by the thread of its dispatcher.
+ */
+template <class Operation> class OperationBatcher {
+public:
+  using FlushCb = std::function<void(std::vector<Operation>& batch)>;
+
+  /**
+   * @param dispatcher supplies the dispatcher of the worker.
+   * @param max_batch_size supplies the number of operations flushed as soon as they are queued.
+   * @param max_delay supplies the maximum time an operation is queued for.
+   * @param flush supplies the callback processing a batch, which is cleared once it returns.
+   */
+  OperationBatcher(Event::Dispatcher& dispatcher, uint32_t max_batch_size,
+                   std::chrono::microseconds max_delay, FlushCb flush)
+      : max_batch_size_(max_batch_size), max_delay_(max_delay), flush_(std::move(flush)),
+        time_source_(dispatcher.timeSource()),
+        timer_(dispatcher.createTimer([this]() { flushBatch(); })) {
+    ASSERT(max_batch_size_ > 0);
+    batch_.reserve(max_batch_size_);
+  }
+
+  /**
+   * Queues an operation, flushing the batch if it is full. The batch is otherwise flushed by a
+   * timer, so that the operation is never processed before this returns unless the batch is full.
+   */
+  void add(Operation operation) {
+    const MonotonicTime now = time_source_.monotonicTime();
+    if (last_arrival_.has_value()) {
+      const auto interval = std::chrono::duration_cast<std::chrono::microseconds>(
+          now - last_arrival_.value());
+      // Weighs the latest interval by 1/8, like the smoothed round trip time of TCP.
+      interval_ = interval_.has_value() ? (interval_.value() * 7 + interval) / 8 : interval;
+    }
+    last_arrival_ = now;
+
+    batch_.push_back(std::move(operation));
+    if (batch_.size() >= max_batch_size_) {
+      timer_->disableTimer();
+      flushBatch();
+    } else if (batch_.size() == 1) {
+      timer_->enableHRTimer(deadline());
+    }
+  }
+
+  /**
+   * @return the time the current batch would be flushed after, if it had a single operation.
+   */
+  std::chrono::microseconds deadline() const {
+    if (!interval_.has_value()) {
+      return max_delay_;
+    }
+    if (interval_.value() >= max_delay_) {
+      return std::chrono::microseconds::zero();
+    }
+    return std::min<std::chrono::microseconds>(max_delay_,
+                                               interval_.value() * (max_batch_size_ - 1));
+  }
+
+  size_t size() const { return batch_.size(); }
+  std::chrono::microseconds maxDelay() const { return max_delay_; }
+
+private:
+  void flushBatch() {
+    if (batch_.empty()) {
+      return;
+    }
+    flush_(batch_);
+    batch_.clear();
+  }
+
+  const uint32_t max_batch_size_;
+  const std::chrono::microseconds max_delay_;
+  const FlushCb flush_;
+  TimeSource& time_source_;
+  std::vector<Operation> batch_;
+  absl::optional<MonotonicTime> last_arrival_;
+  // The smoothed interval between the arrivals of the operations.
+  absl::optional<std::chrono::microseconds> interval_;
+  const Event::TimerPtr timer_;
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
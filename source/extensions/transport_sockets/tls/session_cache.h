@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A size bounded map from strings to values, shared by the workers using a context to cache TLS
+ * sessions. The map is split into shards locked separately, so that the workers seldom contend,
+ * and each shard evicts the entries which were inserted or updated the least recently.
+ */
+template <class Value> class ShardedSessionCache {
+public:
+  /**
+   * @param max_entries supplies the maximum number of entries, which is rounded up to a multiple
+   *        of the number of shards.
+   */
+  explicit ShardedSessionCache(uint32_t max_entries)
+      : max_entries_per_shard_(std::max<uint32_t>(1, (max_entries + Shards - 1) / Shards)) {}
+
+  /**
+   * Calls reader with the value of key while its shard is locked for reading.
+   * @return whether there is a value for key.
+   */
+  bool read(absl::string_view key, absl::FunctionRef<void(const Value&)> reader) {
+    Shard& shard = shardFor(key);
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    auto it = shard.index_.find(key);
+    if (it == shard.index_.end()) {
+      return false;
+    }
+    reader(it->second->second);
+    return true;
+  }
+
+  /**
+   * Calls modifier with the value of key while its shard is locked for writing.
+   * @return whether there is a value for key.
+   */
+  bool modify(absl::string_view key, absl::FunctionRef<void(Value&)> modifier) {
+    Shard& shard = shardFor(key);
+    absl::MutexLock lock(&shard.mutex_);
+    auto it = shard.index_.find(key);
+    if (it == shard.index_.end()) {
+      return false;
+    }
+    modifier(it->second->second);
+    return true;
+  }
+
+  /**
+   * Calls updater with the value of key while its shard is locked for writing, inserting a default
+   * constructed value first if there is none. The entry becomes the last one evicted.
+   */
+  void update(absl::string_view key, absl::FunctionRef<void(Value&)> updater) {
+    Shard& shard = shardFor(key);
+    absl::MutexLock lock(&shard.mutex_);
+    auto it = shard.index_.find(key);
+    if (it != shard.index_.end()) {
+      shard.entries_.splice(shard.entries_.begin(), shard.entries_, it->second);
+    } else {
+      if (shard.index_.size() >= max_entries_per_shard_) {
+        shard.index_.erase(shard.entries_.back().first);
+        shard.entries_.pop_back();
+      }
+      shard.entries_.emplace_front(std::string(key), Value());
+      it = shard.index_.emplace(shard.entries_.front().first, shard.entries_.begin()).first;
+    }
+    updater(it->second->second);
+  }
+
+  /**
+   * Removes the value of key, if there is one.
+   */
+  void erase(absl::string_view key) {
+    Shard& shard = shardFor(key);
+    absl::MutexLock lock(&shard.mutex_);
+    auto it = shard.index_.find(key);
+    if (it != shard.index_.end()) {
+      auto entry = it->second;
+      shard.index_.erase(it);
+      shard.entries_.erase(entry);
+    }
+  }
+
+private:
+  static constexpr uint32_t Shards = 16;
+
+  using Entries = std::list<std::pair<std::string, Value>>;
+
+  struct Shard {
+    absl::Mutex mutex_;
+    // The most recently inserted or updated entries first.
+    Entries entries_ ABSL_GUARDED_BY(mutex_);
+    // The keys point to the entries.
+    absl::flat_hash_map<absl::string_view, typename Entries::iterator>
+        index_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  Shard& shardFor(absl::string_view key) {
+    return shards_[absl::Hash<absl::string_view>()(key) % Shards];
+  }
+
+  const uint32_t max_entries_per_shard_;
+  std::array<Shard, Shards> shards_;
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -8,6 +8,7 @@
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/extensions/transport_sockets/tls/io_handle_bio.h"
+#include "source/extensions/transport_sockets/tls/ktls.h"
 #include "source/extensions/transport_sockets/tls/ssl_handshaker.h"
 #include "source/extensions/transport_sockets/tls/utility.h"
 
@@ -26,6 +27,25 @@ namespace {
 
 constexpr absl::string_view NotReadyReason{"TLS error: Secret is not supplied by SDS"};
 
+// Maximum plaintext size of a TLS record.
+constexpr uint64_t MaxRecordSize = 16384;
+
+// Returns the first `size` bytes of `buffer` as contiguous memory. When they span several slices
+// they are copied into a per-thread scratch buffer, rather than linearizing `buffer`, which
+// allocates a new slice and moves the data of every record built from small slices. A socket only
+// writes from its own thread and its undrained data does not change, so a retried SSL_write() sees
+// the same pointer and contents as the call that returned SSL_ERROR_WANT_WRITE.
+const void* gatherRecord(Buffer::Instance& buffer, uint64_t size) {
+  static thread_local uint8_t scratch[MaxRecordSize];
+  const Buffer::RawSlice front = buffer.frontSlice();
+  if (front.len_ >= size) {
+    return front.mem_;
+  }
+  ASSERT(size <= sizeof(scratch));
+  buffer.copyOut(0, size, scratch);
+  return scratch;
+}
+
 // This SslSocket will be used when SSL secret is not fetched from SDS server.
 class NotReadySslSocket : public Network::TransportSocket {
 public:
@@ -53,7 +73,9 @@ SslSocket::SslSocket(Envoy::Ssl::ContextSharedPtr ctx, InitialState state,
     : transport_socket_options_(transport_socket_options),
       ctx_(std::dynamic_pointer_cast<ContextImpl>(ctx)),
       info_(std::dynamic_pointer_cast<SslHandshakerImpl>(handshaker_factory_cb(
-          ctx_->newSsl(transport_socket_options_), ctx_->sslExtendedSocketInfoIndex(), this))) {
+          ctx_->newSsl(transport_socket_options_), ctx_->sslExtendedSocketInfoIndex(), this))),
+      gather_write_slices_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tls_gather_write_slices")) {
   if (state == InitialState::Client) {
     SSL_set_connect_state(rawSsl());
   } else {
@@ -152,6 +174,15 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
     }
 
     reservation.commit(bytes_read_this_iteration);
+    if (kernel_tls_tx_ && BIO_pending(SSL_get_wbio(rawSsl())) > 0) {
+      // Reading made TLS write a message of its own, such as the reply to a key update, which
+      // can't be encrypted with the keys of the kernel.
+      ENVOY_CONN_LOG(debug, "TLS message can't be sent with kernel TLS", callbacks_->connection());
+      ctx_->stats().ktls_tx_unexpected_write_.inc();
+      failure_reason_ = "TLS error: message can't be sent with kernel TLS";
+      action = PostIoAction::Close;
+      keep_reading = false;
+    }
     if (bytes_read_this_iteration > 0 && callbacks_->shouldDrainReadBuffer()) {
       callbacks_->setTransportSocketIsReadable();
       keep_reading = false;
@@ -194,9 +225,31 @@ void SslSocket::onSuccess(SSL* ssl) {
     callbacks_->connection().streamInfo().downstreamTiming().onDownstreamHandshakeComplete(
         callbacks_->connection().dispatcher().timeSource());
   }
+  if (ctx_->kernelTlsTx()) {
+    maybeEnableKernelTlsTx(ssl);
+  }
   callbacks_->raiseEvent(Network::ConnectionEvent::Connected);
 }
 
+void SslSocket::maybeEnableKernelTlsTx(SSL* ssl) {
+  switch (enableKernelTlsTx(ssl, callbacks_->ioHandle())) {
+  case KernelTlsResult::Enabled:
+    ENVOY_CONN_LOG(debug, "kernel TLS enabled", callbacks_->connection());
+    ctx_->stats().ktls_tx_enabled_.inc();
+    kernel_tls_tx_ = true;
+    // From now on the messages TLS would send itself are kept in memory, see doRead().
+    SSL_set0_wbio(ssl, BIO_new(BIO_s_mem()));
+    return;
+  case KernelTlsResult::Unsupported:
+    ctx_->stats().ktls_tx_unsupported_.inc();
+    return;
+  case KernelTlsResult::Failed:
+    ENVOY_CONN_LOG(debug, "kernel TLS failed, encrypting in user space", callbacks_->connection());
+    ctx_->stats().ktls_tx_failed_.inc();
+    return;
+  }
+}
+
 void SslSocket::onFailure() { drainErrorQueue(); }
 
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
@@ -248,12 +301,16 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (kernel_tls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
     bytes_to_retry_ = 0;
   } else {
-    bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+    bytes_to_write = std::min(write_buffer.length(), MaxRecordSize);
   }
 
   uint64_t total_bytes_written = 0;
@@ -263,15 +320,17 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
 
     // SSL_write() requires that if a previous call returns SSL_ERROR_WANT_WRITE, we need to call
     // it again with the same parameters. This is done by tracking last write size, but not write
-    // data, since linearize() will return the same undrained data anyway.
+    // data, since linearize() and gatherRecord() will return the same undrained data anyway.
     ASSERT(bytes_to_write <= write_buffer.length());
-    int rc = SSL_write(rawSsl(), write_buffer.linearize(bytes_to_write), bytes_to_write);
+    const void* data = gather_write_slices_ ? gatherRecord(write_buffer, bytes_to_write)
+                                            : write_buffer.linearize(bytes_to_write);
+    int rc = SSL_write(rawSsl(), data, bytes_to_write);
     ENVOY_CONN_LOG(trace, "ssl write returns: {}", callbacks_->connection(), rc);
     if (rc > 0) {
       ASSERT(rc == static_cast<int>(bytes_to_write));
       total_bytes_written += rc;
       write_buffer.drain(rc);
-      bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+      bytes_to_write = std::min(write_buffer.length(), MaxRecordSize);
     } else {
       int err = SSL_get_error(rawSsl(), rc);
       ENVOY_CONN_LOG(trace, "ssl error occurred while write: {}", callbacks_->connection(),
@@ -298,6 +357,31 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  // The kernel encrypts the plaintext into records.
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "kernel TLS write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        break;
+      }
+      return {PostIoAction::Close, total_bytes_written, false};
+    }
+    ENVOY_CONN_LOG(trace, "kernel TLS write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -305,7 +389,13 @@ Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
 void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
-      callbacks_->connection().state() != Network::Connection::State::Closed) {
+      callbacks_->connection().state() != Network::Connection::State::Closed && kernel_tls_tx_) {
+    // The close_notify alert must be encrypted by the kernel too.
+    const bool sent = sendKernelTlsCloseNotify(callbacks_->ioHandle());
+    ENVOY_CONN_LOG(debug, "kernel TLS shutdown: sent={}", callbacks_->connection(), sent);
+    info_->setState(Ssl::SocketState::ShutdownSent);
+  } else if (info_->state() != Ssl::SocketState::ShutdownSent &&
+             callbacks_->connection().state() != Network::Connection::State::Closed) {
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
@@ -86,6 +86,9 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  // Hands the encryption of the data written from now on over to the kernel, if configured.
+  void maybeEnableKernelTlsTx(SSL* ssl);
+  Network::IoResult doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
   void drainErrorQueue();
   void shutdownSsl();
   void shutdownBasic();
@@ -95,6 +98,10 @@ private:
   Network::TransportSocketCallbacks* callbacks_{};
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
+  const bool gather_write_slices_;
+  // Whether the kernel encrypts the data written to the socket, in which case SSL_write() and
+  // SSL_shutdown() must not be used anymore.
+  bool kernel_tls_tx_{false};
   std::string failure_reason_;
 
   SslHandshakerImplSharedPtr info_;
@@ -20,7 +20,17 @@ namespace Tls {
   COUNTER(ocsp_staple_failed)                                                                      \
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
-  COUNTER(ocsp_staple_requests)
+  COUNTER(ocsp_staple_requests)                                                                    \
+  COUNTER(ktls_tx_enabled)                                                                         \
+  COUNTER(ktls_tx_unsupported)                                                                     \
+  COUNTER(ktls_tx_failed)                                                                          \
+  COUNTER(ktls_tx_unexpected_write)                                                                \
+  COUNTER(async_cert_validation)                                                                   \
+  COUNTER(async_cert_validation_cache_hit)                                                         \
+  COUNTER(session_cache_hit)                                                                       \
+  COUNTER(session_cache_miss)                                                                      \
+  COUNTER(handshake_offload)                                                                       \
+  COUNTER(handshake_offload_rejected)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
@@ -2,10 +2,21 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Network {
 
+UdpPacketWriterFactoryPtr UdpDefaultWriterFactoryFactory::createUdpPacketWriterFactory(
+    const envoy::config::core::v3::TypedExtensionConfig& config) {
+  const auto writer_config = MessageUtil::anyConvertAndValidate<
+      envoy::extensions::udp_packet_writer::v3::UdpDefaultWriterFactory>(
+      config.typed_config(), ProtobufMessage::getStrictValidationVisitor());
+  return std::make_unique<UdpDefaultWriterFactory>(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(writer_config, max_batched_datagrams, 0));
+}
+
 REGISTER_FACTORY(UdpDefaultWriterFactoryFactory, UdpPacketWriterFactoryFactory);
 
 } // namespace Network
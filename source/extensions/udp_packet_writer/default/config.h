@@ -12,10 +12,8 @@ namespace Network {
 class UdpDefaultWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
 public:
   std::string name() const override { return "envoy.udp_packet_writer.default"; }
-  UdpPacketWriterFactoryPtr
-  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
-    return std::make_unique<UdpDefaultWriterFactory>();
-  }
+  UdpPacketWriterFactoryPtr createUdpPacketWriterFactory(
+      const envoy::config::core::v3::TypedExtensionConfig& config) override;
   ProtobufTypes::MessagePtr createEmptyConfigProto() override {
     return std::make_unique<envoy::extensions::udp_packet_writer::v3::UdpDefaultWriterFactory>();
   }
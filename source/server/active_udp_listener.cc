@@ -62,6 +62,10 @@ void ActiveUdpListenerBase::onData(Network::UdpRecvData&& data) {
   if (dest == worker_index_) {
     onDataWorker(std::move(data));
   } else {
+    // The kernel delivered the datagram to a worker other than the one owning it, e.g. because the
+    // listener routes in userspace or the peer migrated. Count it, as forwarding costs a post to
+    // the other worker.
+    udp_stats_.downstream_rx_datagram_forwarded_.inc();
     udp_listener_worker_router_.deliver(dest, std::move(data));
   }
 }
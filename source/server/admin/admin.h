@@ -248,16 +248,21 @@ private:
    * @param removeable indicates whether the handler can be removed after being added
    * @param mutates_state indicates whether the handler will mutate state and therefore
    *                      must be accessed via HTTP POST rather than GET.
+   * @param params command parameter descriptors.
    * @return the UrlHandler.
    */
   template <class Handler>
   UrlHandler makeStreamingHandler(const std::string& prefix, const std::string& help_text,
-                                  Handler& handler, bool removable, bool mutates_state) {
-    return {prefix, help_text,
+                                  Handler& handler, bool removable, bool mutates_state,
+                                  const ParamDescriptorVec& params = {}) {
+    return {prefix,
+            help_text,
             [&handler](AdminStream& admin_stream) -> Admin::RequestPtr {
               return handler.makeRequest(admin_stream);
             },
-            removable, mutates_state};
+            removable,
+            mutates_state,
+            params};
   }
 
   /**
@@ -414,6 +419,9 @@ private:
     uint32_t tcpBacklogSize() const override { return ENVOY_TCP_BACKLOG_SIZE; }
     Init::Manager& initManager() override { return *init_manager_; }
     bool ignoreGlobalConnLimit() const override { return ignore_global_conn_limit_; }
+    uint32_t maxConnectionsToAcceptPerSocketEvent() const override {
+      return Network::DefaultMaxConnectionsToAcceptPerSocketEvent;
+    }
 
     AdminImpl& parent_;
     const std::string name_;
@@ -18,15 +18,40 @@ class ClustersHandler : public HandlerContextBase {
 public:
   ClustersHandler(Server::Instance& server);
 
-  Http::Code handlerClusters(Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
-                             AdminStream&);
+  Admin::RequestPtr makeRequest(AdminStream& admin_stream);
+};
+
+// Streams the /clusters output one cluster at a time, so that the output for all the clusters is
+// never built at once.
+class ClustersRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  ClustersRequest(Upstream::ClusterManager& cluster_manager, bool json);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
 
 private:
+  void addClusterAsJson(const Upstream::Cluster& cluster, Buffer::Instance& response);
+  void addClusterAsText(const Upstream::Cluster& cluster, Buffer::Instance& response);
   void addOutlierInfo(const std::string& cluster_name,
                       const Upstream::Outlier::Detector* outlier_detector,
                       Buffer::Instance& response);
-  void writeClustersAsJson(Buffer::Instance& response);
-  void writeClustersAsText(Buffer::Instance& response);
+
+  Upstream::ClusterManager& cluster_manager_;
+  const bool json_;
+  // The clusters are snapshotted in start(). The admin filter pulls all the chunks within one
+  // dispatcher iteration, so that none of the clusters can be removed while they are streamed.
+  // TODO(mattklein123): Add ability to see warming clusters in admin output.
+  Upstream::ClusterManager::ClusterInfoMap clusters_;
+  Upstream::ClusterManager::ClusterInfoMap::const_iterator next_cluster_;
+  bool clusters_added_{};
+  uint64_t chunk_size_{DefaultChunkSize};
 };
 
 } // namespace Server
@@ -6,6 +6,7 @@
 #include "source/common/common/matchers.h"
 #include "source/common/common/regex.h"
 #include "source/common/common/statusor.h"
+#include "source/common/config/resource_name.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
 #include "source/common/network/utility.h"
@@ -157,6 +158,10 @@ buildNameMatcher(const Http::Utility::QueryParams& params) {
 ConfigDumpHandler::ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server)
     : HandlerContextBase(server), config_tracker_(config_tracker) {}
 
+Admin::RequestPtr ConfigDumpHandler::makeRequest(AdminStream& admin_stream) const {
+  return std::make_unique<ConfigDumpRequest>(*this, admin_stream);
+}
+
 Http::Code ConfigDumpHandler::handlerConfigDump(Http::ResponseHeaderMap& response_headers,
                                                 Buffer::Instance& response,
                                                 AdminStream& admin_stream) const {
@@ -298,61 +303,72 @@ ConfigDumpHandler::dumpEndpointConfigs(const Matchers::StringMatcher& name_match
   for (const auto& [name, cluster_ref] : all_clusters.active_clusters_) {
     UNREFERENCED_PARAMETER(name);
     const Upstream::Cluster& cluster = cluster_ref.get();
-    Upstream::ClusterInfoConstSharedPtr cluster_info = cluster.info();
-    envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
-
-    if (cluster_info->edsServiceName().has_value()) {
-      cluster_load_assignment.set_cluster_name(cluster_info->edsServiceName().value());
-    } else {
-      cluster_load_assignment.set_cluster_name(cluster_info->name());
-    }
-    if (!name_matcher.match(cluster_load_assignment.cluster_name())) {
+    absl::optional<envoy::config::endpoint::v3::ClusterLoadAssignment> cluster_load_assignment =
+        dumpEndpointConfig(cluster, name_matcher);
+    if (!cluster_load_assignment.has_value()) {
       continue;
     }
-    auto& policy = *cluster_load_assignment.mutable_policy();
-
-    for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
-      policy.mutable_overprovisioning_factor()->set_value(host_set->overprovisioningFactor());
-
-      if (!host_set->hostsPerLocality().get().empty()) {
-        for (int index = 0; index < static_cast<int>(host_set->hostsPerLocality().get().size());
-             index++) {
-          auto locality_host_set = host_set->hostsPerLocality().get()[index];
-
-          if (!locality_host_set.empty()) {
-            auto& locality_lb_endpoint = *cluster_load_assignment.mutable_endpoints()->Add();
-            locality_lb_endpoint.mutable_locality()->MergeFrom(locality_host_set[0]->locality());
-            locality_lb_endpoint.set_priority(locality_host_set[0]->priority());
-            if (host_set->localityWeights() != nullptr && !host_set->localityWeights()->empty()) {
-              locality_lb_endpoint.mutable_load_balancing_weight()->set_value(
-                  (*host_set->localityWeights())[index]);
-            }
-
-            for (auto& host : locality_host_set) {
-              addLbEndpoint(host, locality_lb_endpoint);
-            }
-          }
-        }
-      } else {
-        for (auto& host : host_set->hosts()) {
-          auto& locality_lb_endpoint = *cluster_load_assignment.mutable_endpoints()->Add();
-          locality_lb_endpoint.mutable_locality()->MergeFrom(host->locality());
-          locality_lb_endpoint.set_priority(host->priority());
-          addLbEndpoint(host, locality_lb_endpoint);
-        }
-      }
-    }
-    if (cluster_info->addedViaApi()) {
+    if (cluster.info()->addedViaApi()) {
       auto& dynamic_endpoint = *endpoint_config_dump->mutable_dynamic_endpoint_configs()->Add();
-      dynamic_endpoint.mutable_endpoint_config()->PackFrom(cluster_load_assignment);
+      dynamic_endpoint.mutable_endpoint_config()->PackFrom(*cluster_load_assignment);
     } else {
       auto& static_endpoint = *endpoint_config_dump->mutable_static_endpoint_configs()->Add();
-      static_endpoint.mutable_endpoint_config()->PackFrom(cluster_load_assignment);
+      static_endpoint.mutable_endpoint_config()->PackFrom(*cluster_load_assignment);
     }
   }
   return endpoint_config_dump;
 }
 
+absl::optional<envoy::config::endpoint::v3::ClusterLoadAssignment>
+ConfigDumpHandler::dumpEndpointConfig(const Upstream::Cluster& cluster,
+                                      const Matchers::StringMatcher& name_matcher) const {
+  Upstream::ClusterInfoConstSharedPtr cluster_info = cluster.info();
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+
+  if (cluster_info->edsServiceName().has_value()) {
+    cluster_load_assignment.set_cluster_name(cluster_info->edsServiceName().value());
+  } else {
+    cluster_load_assignment.set_cluster_name(cluster_info->name());
+  }
+  if (!name_matcher.match(cluster_load_assignment.cluster_name())) {
+    return absl::nullopt;
+  }
+  auto& policy = *cluster_load_assignment.mutable_policy();
+
+  for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
+    policy.mutable_overprovisioning_factor()->set_value(host_set->overprovisioningFactor());
+
+    if (!host_set->hostsPerLocality().get().empty()) {
+      for (int index = 0; index < static_cast<int>(host_set->hostsPerLocality().get().size());
+           index++) {
+        auto locality_host_set = host_set->hostsPerLocality().get()[index];
+
+        if (!locality_host_set.empty()) {
+          auto& locality_lb_endpoint = *cluster_load_assignment.mutable_endpoints()->Add();
+          locality_lb_endpoint.mutable_locality()->MergeFrom(locality_host_set[0]->locality());
+          locality_lb_endpoint.set_priority(locality_host_set[0]->priority());
+          if (host_set->localityWeights() != nullptr && !host_set->localityWeights()->empty()) {
+            locality_lb_endpoint.mutable_load_balancing_weight()->set_value(
+                (*host_set->localityWeights())[index]);
+          }
+
+          for (auto& host : locality_host_set) {
+            addLbEndpoint(host, locality_lb_endpoint);
+          }
+        }
+      }
+    } else {
+      for (auto& host : host_set->hosts()) {
+        auto& locality_lb_endpoint = *cluster_load_assignment.mutable_endpoints()->Add();
+        locality_lb_endpoint.mutable_locality()->MergeFrom(host->locality());
+        locality_lb_endpoint.set_priority(host->priority());
+        addLbEndpoint(host, locality_lb_endpoint);
+      }
+    }
+  }
+  return cluster_load_assignment;
+}
+
 void ConfigDumpHandler::addLbEndpoint(
     const Upstream::HostSharedPtr& host,
     envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint) const {
@@ -386,5 +402,195 @@ void ConfigDumpHandler::addLbEndpoint(
   }
 }
 
+ConfigDumpRequest::ConfigDumpRequest(const ConfigDumpHandler& handler, AdminStream& admin_stream)
+    : handler_(handler), admin_stream_(admin_stream) {}
+
+Http::Code ConfigDumpRequest::start(Http::ResponseHeaderMap& response_headers) {
+  const Http::Utility::QueryParams query_params = admin_stream_.queryParams();
+  absl::StatusOr<Matchers::StringMatcherPtr> name_matcher = buildNameMatcher(query_params);
+  if (maskParam(query_params).has_value() || !name_matcher.ok()) {
+    buffered_ = true;
+    return handler_.handlerConfigDump(response_headers, response_, admin_stream_);
+  }
+  name_matcher_ = std::move(*name_matcher);
+
+  callbacks_map_ = handler_.config_tracker_.getCallbacksMap();
+  if (shouldIncludeEdsInDump(query_params)) {
+    clusters_ = handler_.server_.clusterManager().clusters().active_clusters_;
+    if (!clusters_.empty()) {
+      // The endpoint configs are streamed one cluster at a time by addNextEndpointConfig(), and
+      // only built whole when selected with the resource parameter. As in the whole dump, a
+      // config tracker already named endpoint takes precedence.
+      stream_endpoints_ = callbacks_map_.count("endpoint") == 0;
+      callbacks_map_.emplace("endpoint", [this](const Matchers::StringMatcher& name_matcher) {
+        return handler_.dumpEndpointConfigs(name_matcher);
+      });
+    }
+  }
+  next_callback_ = callbacks_map_.begin();
+
+  const auto resource = resourceParam(query_params);
+  if (resource.has_value()) {
+    for (const auto& [name, callback] : callbacks_map_) {
+      UNREFERENCED_PARAMETER(name);
+      ProtobufTypes::MessagePtr message = callback(*name_matcher_);
+      ASSERT(message);
+      const Protobuf::FieldDescriptor* field_descriptor =
+          message->GetDescriptor()->FindFieldByName(*resource);
+      if (field_descriptor == nullptr) {
+        continue;
+      }
+      if (!field_descriptor->is_repeated()) {
+        return error(response_headers, Http::Code::BadRequest,
+                     fmt::format("{} is not a repeated field. Use ?mask={} to get only this field",
+                                 field_descriptor->name(), field_descriptor->name()));
+      }
+      // We found the desired resource so there is no need to continue iterating over the other
+      // keys.
+      resource_message_ = std::move(message);
+      resource_field_ = field_descriptor;
+      break;
+    }
+    if (resource_message_ == nullptr) {
+      return error(response_headers, Http::Code::NotFound,
+                   fmt::format("{} not found in config dump", *resource));
+    }
+  }
+
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  return Http::Code::OK;
+}
+
+bool ConfigDumpRequest::nextChunk(Buffer::Instance& response) {
+  if (buffered_) {
+    response.move(response_);
+    return false;
+  }
+
+  // nextChunk's contract is to add up to chunk_size_ additional bytes. The
+  // caller is not required to drain the bytes after each call to nextChunk.
+  const uint64_t starting_response_length = response.length();
+  while (response.length() - starting_response_length < chunk_size_) {
+    if (!addNext(response)) {
+      // Close the envoy::admin::v3::ConfigDump message, laid out as when it's rendered whole.
+      response.add(configs_added_ ? "\n ]\n}\n" : "{}\n");
+      return false;
+    }
+  }
+  return true;
+}
+
+Http::Code ConfigDumpRequest::error(Http::ResponseHeaderMap& response_headers, Http::Code code,
+                                    absl::string_view message) {
+  buffered_ = true;
+  response_headers.addReference(Http::Headers::get().XContentTypeOptions,
+                                Http::Headers::get().XContentTypeOptionValues.Nosniff);
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
+  response_.add(message);
+  return code;
+}
+
+bool ConfigDumpRequest::addNext(Buffer::Instance& response) {
+  if (resource_message_ != nullptr) {
+    const Protobuf::Reflection* reflection = resource_message_->GetReflection();
+    if (next_resource_index_ == reflection->FieldSize(*resource_message_, resource_field_)) {
+      return false;
+    }
+    addConfig(*reflection->MutableRepeatedMessage(resource_message_.get(), resource_field_,
+                                                  next_resource_index_++),
+              response);
+    return true;
+  }
+
+  if (endpoints_phase_ != EndpointsPhase::None) {
+    addNextEndpointConfig(response);
+    return true;
+  }
+  if (next_callback_ == callbacks_map_.end()) {
+    return false;
+  }
+  const auto& [name, callback] = *next_callback_++;
+  if (stream_endpoints_ && name == "endpoint") {
+    // Open the Any holding the envoy::admin::v3::EndpointsConfigDump, whose repeated fields are
+    // added one cluster at a time.
+    startConfig(response);
+    response.add(absl::StrCat("  {\n   \"@type\": \"",
+                              Config::getTypeUrl<envoy::admin::v3::EndpointsConfigDump>(), "\""));
+    endpoints_phase_ = EndpointsPhase::Static;
+    next_cluster_ = clusters_.begin();
+    phase_endpoint_configs_ = 0;
+    return true;
+  }
+  ProtobufTypes::MessagePtr message = callback(*name_matcher_);
+  ASSERT(message);
+  addConfig(*message, response);
+  return true;
+}
+
+void ConfigDumpRequest::addNextEndpointConfig(Buffer::Instance& response) {
+  const bool dynamic = endpoints_phase_ == EndpointsPhase::Dynamic;
+  while (next_cluster_ != clusters_.end()) {
+    const Upstream::Cluster& cluster = next_cluster_->second.get();
+    ++next_cluster_;
+    if (cluster.info()->addedViaApi() != dynamic) {
+      continue;
+    }
+    absl::optional<envoy::config::endpoint::v3::ClusterLoadAssignment> cluster_load_assignment =
+        handler_.dumpEndpointConfig(cluster, *name_matcher_);
+    if (!cluster_load_assignment.has_value()) {
+      continue;
+    }
+
+    std::string json;
+    if (dynamic) {
+      envoy::admin::v3::EndpointsConfigDump::DynamicEndpointConfig endpoint_config;
+      endpoint_config.mutable_endpoint_config()->PackFrom(*cluster_load_assignment);
+      MessageUtil::redact(endpoint_config);
+      json = MessageUtil::getJsonStringFromMessageOrError(endpoint_config, true);
+    } else {
+      envoy::admin::v3::EndpointsConfigDump::StaticEndpointConfig endpoint_config;
+      endpoint_config.mutable_endpoint_config()->PackFrom(*cluster_load_assignment);
+      MessageUtil::redact(endpoint_config);
+      json = MessageUtil::getJsonStringFromMessageOrError(endpoint_config, true);
+    }
+    if (phase_endpoint_configs_++ == 0) {
+      response.add(absl::StrCat(",\n   \"",
+                                dynamic ? "dynamic_endpoint_configs" : "static_endpoint_configs",
+                                "\": [\n"));
+    } else {
+      response.add(",\n");
+    }
+    Utility::addIndentedJson(json, 4, response);
+    return;
+  }
+
+  // All the clusters were visited, close the repeated field of the phase if any config was added.
+  if (phase_endpoint_configs_ > 0) {
+    response.add("\n   ]");
+  }
+  if (dynamic) {
+    response.add("\n  }");
+    endpoints_phase_ = EndpointsPhase::None;
+  } else {
+    endpoints_phase_ = EndpointsPhase::Dynamic;
+    next_cluster_ = clusters_.begin();
+    phase_endpoint_configs_ = 0;
+  }
+}
+
+void ConfigDumpRequest::addConfig(Protobuf::Message& message, Buffer::Instance& response) {
+  MessageUtil::redact(message);
+  ProtobufWkt::Any config;
+  config.PackFrom(message);
+  startConfig(response);
+  Utility::addIndentedJson(MessageUtil::getJsonStringFromMessageOrError(config, true), 2,
+                           response);
+}
+
+void ConfigDumpRequest::startConfig(Buffer::Instance& response) {
+  response.add(configs_added_ ? ",\n" : "{\n \"configs\": [\n");
+  configs_added_ = true;
+}
+
 } // namespace Server
 } // namespace Envoy
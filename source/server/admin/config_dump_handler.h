@@ -3,12 +3,14 @@
 
 #include "envoy/admin/v3/config_dump.pb.h"
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/matchers.h"
 #include "envoy/config/endpoint/v3/endpoint_components.pb.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/header_map.h"
 #include "envoy/server/admin.h"
 #include "envoy/server/instance.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/server/admin/config_tracker_impl.h"
 #include "source/server/admin/handler_ctx.h"
 
@@ -17,15 +19,22 @@
 namespace Envoy {
 namespace Server {
 
+class ConfigDumpRequest;
+
 class ConfigDumpHandler : public HandlerContextBase {
 
 public:
   ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server);
 
+  Admin::RequestPtr makeRequest(AdminStream& admin_stream) const;
+
+  // Builds the whole config dump before responding, used for masked dumps.
   Http::Code handlerConfigDump(Http::ResponseHeaderMap& response_headers,
                                Buffer::Instance& response, AdminStream&) const;
 
 private:
+  friend class ConfigDumpRequest;
+
   absl::optional<std::pair<Http::Code, std::string>>
   addAllConfigToDump(envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
                      const Matchers::StringMatcher& name_matcher, bool include_eds) const;
@@ -47,8 +56,72 @@ private:
 
   ProtobufTypes::MessagePtr dumpEndpointConfigs(const Matchers::StringMatcher& name_matcher) const;
 
+  /**
+   * @return the endpoints of a cluster, or absl::nullopt if its name doesn't match name_matcher.
+   */
+  absl::optional<envoy::config::endpoint::v3::ClusterLoadAssignment>
+  dumpEndpointConfig(const Upstream::Cluster& cluster,
+                     const Matchers::StringMatcher& name_matcher) const;
+
   ConfigTracker& config_tracker_;
 };
 
+// Streams the config dump one config at a time, or one element of the repeated field selected by
+// the resource parameter at a time. The endpoint configs added with include_eds are streamed one
+// cluster at a time. The output is the same as when the whole config dump is rendered at once.
+// Masked dumps are still built whole, as the mask may only apply to some of the configs.
+class ConfigDumpRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  ConfigDumpRequest(const ConfigDumpHandler& handler, AdminStream& admin_stream);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  enum class EndpointsPhase { None, Static, Dynamic };
+
+  // Sets a text error response.
+  Http::Code error(Http::ResponseHeaderMap& response_headers, Http::Code code,
+                   absl::string_view message);
+  // Adds the next config, resource or endpoint config to the response.
+  // @return false once there is nothing left to add.
+  bool addNext(Buffer::Instance& response);
+  // Adds the configs of the next cluster of the current endpoints phase, or ends the phase.
+  void addNextEndpointConfig(Buffer::Instance& response);
+  // Adds a message as the next element of envoy::admin::v3::ConfigDump.configs.
+  void addConfig(Protobuf::Message& message, Buffer::Instance& response);
+  void startConfig(Buffer::Instance& response);
+
+  const ConfigDumpHandler& handler_;
+  AdminStream& admin_stream_;
+  // Set when the response is built whole in start().
+  bool buffered_{};
+  Buffer::OwnedImpl response_;
+  Matchers::StringMatcherPtr name_matcher_;
+  ConfigTracker::CbsMap callbacks_map_;
+  ConfigTracker::CbsMap::const_iterator next_callback_;
+  // Set when the resource parameter selects a repeated field of one of the configs.
+  ProtobufTypes::MessagePtr resource_message_;
+  const Protobuf::FieldDescriptor* resource_field_{};
+  int next_resource_index_{};
+  // The endpoint configs are streamed in two passes over the clusters, for the static and the
+  // dynamic endpoint configs. The clusters are snapshotted in start(). The admin filter pulls all
+  // the chunks within one dispatcher iteration, so that none of them can be removed meanwhile.
+  // TODO(mattklein123): Add ability to see warming clusters in admin output.
+  bool stream_endpoints_{};
+  Upstream::ClusterManager::ClusterInfoMap clusters_;
+  Upstream::ClusterManager::ClusterInfoMap::const_iterator next_cluster_;
+  EndpointsPhase endpoints_phase_{EndpointsPhase::None};
+  uint64_t phase_endpoint_configs_{};
+  bool configs_added_{};
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
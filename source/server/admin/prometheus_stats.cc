@@ -1,5 +1,7 @@
 #include "source/server/admin/prometheus_stats.h"
 
+#include <limits>
+
 #include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
 #include "source/common/common/regex.h"
@@ -73,89 +75,144 @@ struct MetricLessThan {
   }
 };
 
+} // namespace
+
+/**
+ * Processes a stat type (counter, gauge, histogram) by grouping the metrics by tag-extracted
+ * metric name, and then outputting the groups in the correct sorted order into the response, a
+ * few groups at a time.
+ */
+class PrometheusStatsRequest::TypeRender {
+public:
+  virtual ~TypeRender() = default;
+
+  /**
+   * Outputs groups of metrics until the response grew by at least `limit` bytes. A group is
+   * never split across calls.
+   *
+   * @param response The buffer to put the output into.
+   * @param limit The number of bytes after which to stop adding groups.
+   * @return true if there are more groups to output.
+   */
+  virtual bool render(Buffer::Instance& response, uint64_t limit) PURE;
+
+  /**
+   * @return uint64_t the number of metric names for which output was generated so far.
+   */
+  uint64_t metricNameCount() const { return metric_name_count_; }
+
+protected:
+  uint64_t metric_name_count_{0};
+};
+
+namespace {
+
 /**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
+ * Renders the metrics of one stat type.
  *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
+ * @param params Filters on which stats to output.
  * @param metrics The metrics to output stats for. This must contain all stats of the given type
  *        to be included in the same output.
  * @param generate_output A function which returns the output text for this metric.
  * @param type The name of the prometheus metric type for used in TYPE annotations.
  */
-template <class StatType>
-uint64_t outputStatType(
-    Buffer::Instance& response, const StatsParams& params,
-    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-    const std::function<std::string(
-        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
-    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
+template <class StatType> class TypeRenderImpl : public PrometheusStatsRequest::TypeRender {
+public:
+  using GenerateFn = std::function<std::string(const StatType& metric,
+                                               const std::string& prefixed_tag_extracted_name)>;
+
+  TypeRenderImpl(const Stats::SymbolTable& symbol_table, const StatsParams& params,
+                 std::vector<Stats::RefcountPtr<StatType>>&& metrics, GenerateFn generate_output,
+                 absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces)
+      : symbol_table_(symbol_table), metrics_(std::move(metrics)),
+        generate_output_(generate_output), type_(type), custom_namespaces_(custom_namespaces),
+        groups_(symbol_table) {
+    /*
+     * From
+     * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
+     *
+     * All lines for a given metric must be provided as one single group, with the optional HELP
+     * and TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
+     * expositions is preferred but not required, i.e. do not sort if the computational cost is
+     * prohibitive.
+     */
+    for (const auto& metric : metrics_) {
+      // There should only be one symbol table for all of the stats in the admin
+      // interface. If this assumption changes, the name comparisons in this class
+      // will have to change to compare to convert all StatNames to strings before
+      // comparison.
+      ASSERT(&symbol_table_ == &metric->constSymbolTable());
+      if (!shouldShowMetric(*metric, params)) {
+        continue;
+      }
+      groups_[metric->tagExtractedStatName()].push_back(metric.get());
+    }
+  }
 
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
+  // PrometheusStatsRequest::TypeRender
+  bool render(Buffer::Instance& response, uint64_t limit) override {
+    const uint64_t starting_response_length = response.length();
+    while (!groups_.empty() && response.length() - starting_response_length < limit) {
+      // Erase each group once it is output, so that the memory held by the groups shrinks as
+      // the output proceeds.
+      auto group = groups_.begin();
+      const absl::optional<std::string> prefixed_tag_extracted_name =
+          PrometheusStatsFormatter::metricName(symbol_table_.toString(group->first),
+                                               custom_namespaces_);
+      if (prefixed_tag_extracted_name.has_value()) {
+        ++metric_name_count_;
+        response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type_));
+
+        // Sort before producing the final output to satisfy the "preferred" ordering from the
+        // prometheus spec: metrics will be sorted by their tags' textual representation, which
+        // will be consistent across calls.
+        std::sort(group->second.begin(), group->second.end(), MetricLessThan());
+
+        for (const StatType* metric : group->second) {
+          response.add(generate_output_(*metric, prefixed_tag_extracted_name.value()));
+        }
+      }
+      groups_.erase(group);
+    }
+    return !groups_.empty();
+  }
 
+private:
   // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
+  // refcount; ownership is held throughout by `metrics_`). It is unsorted for efficiency, but
+  // will be sorted before producing the final output.
   using StatTypeUnsortedCollection = std::vector<const StatType*>;
 
+  const Stats::SymbolTable& symbol_table_;
+  const std::vector<Stats::RefcountPtr<StatType>> metrics_;
+  const GenerateFn generate_output_;
+  const absl::string_view type_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  // Metrics sorted by their tagExtractedName, to satisfy the requirements of the exposition
+  // format.
+  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups_;
+};
+
+/**
+ * Outputs all the metrics of a stat type into response.
+ *
+ * @return uint64_t the number of metric names for which output was generated.
+ */
+template <class StatType>
+uint64_t outputStatType(
+    Buffer::Instance& response, const StatsParams& params,
+    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+    const typename TypeRenderImpl<StatType>::GenerateFn& generate_output, absl::string_view type,
+    const Stats::CustomStatNamespaces& custom_namespaces) {
   // Return early to avoid crashing when getting the symbol table from the first metric.
   if (metrics.empty()) {
     return 0;
   }
-
-  // There should only be one symbol table for all of the stats in the admin
-  // interface. If this assumption changes, the name comparisons in this function
-  // will have to change to compare to convert all StatNames to strings before
-  // comparison.
-  const Stats::SymbolTable& global_symbol_table = metrics.front()->constSymbolTable();
-
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups(
-      global_symbol_table);
-
-  for (const auto& metric : metrics) {
-    ASSERT(&global_symbol_table == &metric->constSymbolTable());
-    if (!shouldShowMetric(*metric, params)) {
-      continue;
-    }
-    groups[metric->tagExtractedStatName()].push_back(metric.get());
-  }
-
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
-                                             custom_namespaces);
-    if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
-    }
-    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
-
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
-
-    for (const auto& metric : group.second) {
-      response.add(generate_output(*metric, prefixed_tag_extracted_name.value()));
-    }
-  }
-  return result;
+  TypeRenderImpl<StatType> render(metrics.front()->constSymbolTable(), params,
+                                  std::vector<Stats::RefcountPtr<StatType>>(metrics),
+                                  generate_output, type, custom_namespaces);
+  render.render(response, std::numeric_limits<uint64_t>::max());
+  return render.metricNameCount();
 }
 
 /*
@@ -281,5 +338,82 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   return metric_name_count;
 }
 
+PrometheusStatsRequest::PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                                               const Stats::CustomStatNamespaces& custom_namespaces)
+    : stats_(stats), params_(params), custom_namespaces_(custom_namespaces) {}
+
+PrometheusStatsRequest::~PrometheusStatsRequest() = default;
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) {
+  phase_ = Phase::Counters;
+  startPhase();
+  return Http::Code::OK;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // nextChunk's contract is to add up to chunk_size_ additional bytes. The
+  // caller is not required to drain the bytes after each call to nextChunk.
+  const uint64_t starting_response_length = response.length();
+  while (phase_ != Phase::Done) {
+    const uint64_t chunk_length = response.length() - starting_response_length;
+    if (chunk_length >= chunk_size_) {
+      return true;
+    }
+    if (type_render_ != nullptr && type_render_->render(response, chunk_size_ - chunk_length)) {
+      return true;
+    }
+    switch (phase_) {
+    case Phase::Counters:
+      phase_ = Phase::Gauges;
+      break;
+    case Phase::Gauges:
+      phase_ = Phase::TextReadouts;
+      break;
+    case Phase::TextReadouts:
+      phase_ = Phase::Histograms;
+      break;
+    case Phase::Histograms:
+    case Phase::Done:
+      phase_ = Phase::Done;
+      break;
+    }
+    startPhase();
+  }
+  return false;
+}
+
+void PrometheusStatsRequest::startPhase() {
+  // Release the metrics of the previous phase before collecting the next ones.
+  type_render_.reset();
+  const Stats::SymbolTable& symbol_table = stats_.constSymbolTable();
+  switch (phase_) {
+  case Phase::Counters:
+    type_render_ = std::make_unique<TypeRenderImpl<Stats::Counter>>(
+        symbol_table, params_, stats_.counters(), generateNumericOutput<Stats::Counter>, "counter",
+        custom_namespaces_);
+    break;
+  case Phase::Gauges:
+    type_render_ = std::make_unique<TypeRenderImpl<Stats::Gauge>>(
+        symbol_table, params_, stats_.gauges(), generateNumericOutput<Stats::Gauge>, "gauge",
+        custom_namespaces_);
+    break;
+  case Phase::TextReadouts:
+    // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+    if (params_.prometheus_text_readouts_) {
+      type_render_ = std::make_unique<TypeRenderImpl<Stats::TextReadout>>(
+          symbol_table, params_, stats_.textReadouts(), generateTextReadoutOutput, "gauge",
+          custom_namespaces_);
+    }
+    break;
+  case Phase::Histograms:
+    type_render_ = std::make_unique<TypeRenderImpl<Stats::ParentHistogram>>(
+        symbol_table, params_, stats_.histograms(), generateHistogramOutput, "histogram",
+        custom_namespaces_);
+    break;
+  case Phase::Done:
+    break;
+  }
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -4,9 +4,11 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
 #include "source/server/admin/stats_params.h"
 
@@ -47,5 +49,43 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Streams the Prometheus exposition of a stats store in chunks. Stat types are rendered one after
+ * the other, so only the metrics of the current type are held and grouped by tag-extracted name,
+ * and each chunk is handed to the client as soon as it reaches the chunk size instead of
+ * buffering the whole response.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  // Renders the metrics of a single stat type, one tag-extracted name group at a time.
+  class TypeRender;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Stats::CustomStatNamespaces& custom_namespaces);
+  ~PrometheusStatsRequest() override;
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, Done };
+
+  // Collects the metrics rendered in the current phase.
+  void startPhase();
+
+  Stats::Store& stats_;
+  const StatsParams params_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  Phase phase_{Phase::Counters};
+  std::unique_ptr<TypeRender> type_render_;
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
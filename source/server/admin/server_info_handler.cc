@@ -3,6 +3,7 @@
 #include "envoy/admin/v3/memory.pb.h"
 
 #include "source/common/http/headers.h"
+#include "source/common/memory/heap_breakdown.h"
 #include "source/common/memory/stats.h"
 #include "source/common/version/version.h"
 #include "source/server/utils.h"
@@ -54,6 +55,24 @@ Http::Code ServerInfoHandler::handlerMemory(Http::ResponseHeaderMap& response_he
   return Http::Code::OK;
 }
 
+Http::Code ServerInfoHandler::handlerMemoryBreakdown(Http::ResponseHeaderMap& response_headers,
+                                                     Buffer::Instance& response, AdminStream&) {
+  if (!Memory::HeapBreakdown::supported()) {
+    response.add("The current build does not sample heap allocations");
+    return Http::Code::NotImplemented;
+  }
+
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  envoy::admin::v3::MemoryBreakdown breakdown;
+  breakdown.set_allocated(Memory::Stats::totalCurrentlyAllocated());
+  for (const auto& [subsystem, bytes] :
+       Memory::HeapBreakdown::sampledBytesBySubsystem(Memory::HeapBreakdown::defaultRules())) {
+    (*breakdown.mutable_sampled_bytes())[subsystem] = bytes;
+  }
+  response.add(MessageUtil::getJsonStringFromMessageOrError(breakdown, true, true));
+  return Http::Code::OK;
+}
+
 Http::Code ServerInfoHandler::handlerReady(Http::ResponseHeaderMap&, Buffer::Instance& response,
                                            AdminStream&) {
   const envoy::admin::v3::ServerInfo::State state =
@@ -8,12 +8,14 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/event/slow_callback_tracker.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
 #include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
 
 namespace Envoy {
 namespace Server {
@@ -71,6 +73,38 @@ Http::Code StatsHandler::handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap
   return Http::Code::OK;
 }
 
+Http::Code StatsHandler::handlerStatsSlowCallbacks(Http::ResponseHeaderMap&,
+                                                   Buffer::Instance& response, AdminStream&) {
+  bool found = false;
+  Event::SlowCallbackRegistry::get().forEach(
+      [&response, &found](Event::SlowCallbackTracker& tracker) {
+        found = true;
+        response.add(absl::StrCat(tracker.name(), ":\n"));
+        for (const Event::SlowCallback& callback : tracker.slowest()) {
+          response.add(fmt::format("  {:10d}us {}\n", callback.duration_.count(),
+                                   Event::callbackCategoryName(callback.category_)));
+          // Indent the context below its callback.
+          for (absl::string_view line :
+               absl::StrSplit(callback.context_, '\n', absl::SkipEmpty())) {
+            response.add(absl::StrCat("      ", line, "\n"));
+          }
+        }
+      });
+  if (!found) {
+    response.add("Slow callback tracking is not enabled. To enable, set enable_dispatcher_stats "
+                 "in the bootstrap.\n");
+  }
+  return Http::Code::OK;
+}
+
+Http::Code StatsHandler::handlerStatsSlowCallbacksClear(Http::ResponseHeaderMap&,
+                                                        Buffer::Instance& response, AdminStream&) {
+  Event::SlowCallbackRegistry::get().forEach(
+      [](Event::SlowCallbackTracker& tracker) { tracker.clear(); });
+  response.add("OK\n");
+  return Http::Code::OK;
+}
+
 Admin::RequestPtr StatsHandler::makeRequest(AdminStream& admin_stream) {
   StatsParams params;
   Buffer::OwnedImpl response;
@@ -80,16 +114,7 @@ Admin::RequestPtr StatsHandler::makeRequest(AdminStream& admin_stream) {
   }
 
   if (params.format_ == StatsFormat::Prometheus) {
-    // TODO(#16139): modify streaming algorithm to cover Prometheus.
-    //
-    // This may be easiest to accomplish by populating the set
-    // with tagExtractedName(), and allowing for vectors of
-    // stats as multiples will have the same tag-extracted names.
-    // Ideally we'd find a way to do this without slowing down
-    // the non-Prometheus implementations.
-    Buffer::OwnedImpl response;
-    prometheusFlushAndRender(params, response);
-    return Admin::makeStaticTextRequest(response, code);
+    return makePrometheusRequest(params);
   }
 
   if (server_.statsConfig().flushOnAdmin()) {
@@ -112,44 +137,28 @@ Admin::RequestPtr StatsHandler::makeRequest(Stats::Store& stats, const StatsPara
   return std::make_unique<StatsRequest>(stats, params, url_handler_fn);
 }
 
-Http::Code StatsHandler::handlerPrometheusStats(Http::ResponseHeaderMap&,
-                                                Buffer::Instance& response,
-                                                AdminStream& admin_stream) {
-  return prometheusStats(admin_stream.getRequestHeaders().getPathValue(), response);
-}
-
-Http::Code StatsHandler::prometheusStats(absl::string_view path_and_query,
-                                         Buffer::Instance& response) {
+Admin::RequestPtr StatsHandler::makePrometheusRequest(AdminStream& admin_stream) {
   StatsParams params;
-  Http::Code code = params.parse(path_and_query, response);
+  Buffer::OwnedImpl response;
+  Http::Code code = params.parse(admin_stream.getRequestHeaders().getPathValue(), response);
   if (code != Http::Code::OK) {
-    return code;
-  }
-
-  if (server_.statsConfig().flushOnAdmin()) {
-    server_.flushStats();
+    return Admin::makeStaticTextRequest(response, code);
   }
-
-  prometheusFlushAndRender(params, response);
-  return Http::Code::OK;
+  return makePrometheusRequest(params);
 }
 
-void StatsHandler::prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response) {
+Admin::RequestPtr StatsHandler::makePrometheusRequest(const StatsParams& params) {
   if (server_.statsConfig().flushOnAdmin()) {
     server_.flushStats();
   }
-  prometheusRender(server_.stats(), server_.api().customStatNamespaces(), params, response);
+  return makePrometheusRequest(server_.stats(), server_.api().customStatNamespaces(), params);
 }
 
-void StatsHandler::prometheusRender(Stats::Store& stats,
+Admin::RequestPtr
+StatsHandler::makePrometheusRequest(Stats::Store& stats,
                                     const Stats::CustomStatNamespaces& custom_namespaces,
-                                    const StatsParams& params, Buffer::Instance& response) {
-  const std::vector<Stats::TextReadoutSharedPtr>& text_readouts_vec =
-      params.prometheus_text_readouts_ ? stats.textReadouts()
-                                       : std::vector<Stats::TextReadoutSharedPtr>();
-  PrometheusStatsFormatter::statsAsPrometheus(stats.counters(), stats.gauges(), stats.histograms(),
-                                              text_readouts_vec, response, params,
-                                              custom_namespaces);
+                                    const StatsParams& params) {
+  return std::make_unique<PrometheusStatsRequest>(stats, params, custom_namespaces);
 }
 
 Http::Code StatsHandler::handlerContention(Http::ResponseHeaderMap& response_headers,
@@ -204,5 +213,22 @@ Admin::UrlHandler StatsHandler::statsHandler(bool active_mode) {
       params};
 }
 
+Admin::UrlHandler StatsHandler::prometheusHandler() {
+  return {"/stats/prometheus",
+          "print server stats in prometheus format",
+          [this](AdminStream& admin_stream) -> Admin::RequestPtr {
+            return makePrometheusRequest(admin_stream);
+          },
+          false,
+          false,
+          {{Admin::ParamDescriptor::Type::Boolean, "usedonly",
+            "Only include stats that have been written by system since restart"},
+           {Admin::ParamDescriptor::Type::Boolean, "text_readouts",
+            "Render text_readouts as new gaugues with value 0 (increases Prometheus "
+            "data size)"},
+           {Admin::ParamDescriptor::Type::String, "filter",
+            "Regular expression (Google re2) for filtering stats"}}};
+}
+
 } // namespace Server
 } // namespace Envoy
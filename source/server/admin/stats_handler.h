@@ -33,44 +33,12 @@ public:
                                               Buffer::Instance& response, AdminStream&);
   Http::Code handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
-
-  /**
-   * Parses and executes a prometheus stats request.
-   *
-   * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
-   */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
-
-  /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
-   */
-  void prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
-
-  /**
-   * Renders the stats as prometheus. This is broken out as a separately
-   * callable API to facilitate the benchmark
-   * (test/server/admin/stats_handler_speed_test.cc) which does not have a
-   * server object.
-   *
-   * @params stats the stats store to read
-   * @param custom_namespaces namespace mappings used for prometheus
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
-   */
-  static void prometheusRender(Stats::Store& stats,
-                               const Stats::CustomStatNamespaces& custom_namespaces,
-                               const StatsParams& params, Buffer::Instance& response);
-
   Http::Code handlerContention(Http::ResponseHeaderMap& response_headers,
                                Buffer::Instance& response, AdminStream&);
+  Http::Code handlerStatsSlowCallbacks(Http::ResponseHeaderMap& response_headers,
+                                       Buffer::Instance& response, AdminStream&);
+  Http::Code handlerStatsSlowCallbacksClear(Http::ResponseHeaderMap& response_headers,
+                                            Buffer::Instance& response, AdminStream&);
 
   /**
    * When stats are rendered in HTML mode, we want users to be able to tweak
@@ -86,6 +54,26 @@ public:
    */
   Admin::UrlHandler statsHandler(bool active_mode);
 
+  /**
+   * @return a URL handler streaming the stats in the prometheus exposition format.
+   */
+  Admin::UrlHandler prometheusHandler();
+
+  /**
+   * Makes a request streaming the stats as prometheus. This is broken out as a
+   * separately callable API to facilitate the benchmark
+   * (test/server/admin/stats_handler_speed_test.cc) which does not have a
+   * server object.
+   *
+   * @param stats the stats store to read
+   * @param custom_namespaces namespace mappings used for prometheus
+   * @param params the already-parsed parameters.
+   * @return the request.
+   */
+  static Admin::RequestPtr
+  makePrometheusRequest(Stats::Store& stats, const Stats::CustomStatNamespaces& custom_namespaces,
+                        const StatsParams& params);
+
   static Admin::RequestPtr makeRequest(Stats::Store& stats, const StatsParams& params,
                                        StatsRequest::UrlHandlerFn url_handler_fn = nullptr);
   Admin::RequestPtr makeRequest(AdminStream&);
@@ -93,9 +81,11 @@ public:
   //                                     StatsRequest::UrlHandlerFn url_handler_fn);
 
 private:
-  static Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response,
-                                    Stats::Store& stats,
-                                    Stats::CustomStatNamespaces& custom_namespaces);
+  Admin::RequestPtr makePrometheusRequest(AdminStream& admin_stream);
+
+  // Checks the server_ to see if a flush is needed, and then makes the
+  // prometheus stats request.
+  Admin::RequestPtr makePrometheusRequest(const StatsParams& params);
 };
 
 } // namespace Server
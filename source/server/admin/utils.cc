@@ -3,6 +3,10 @@
 #include "source/common/common/enum_to_int.h"
 #include "source/common/http/headers.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/strip.h"
+
 namespace Envoy {
 namespace Server {
 namespace Utility {
@@ -62,6 +66,14 @@ absl::optional<std::string> queryParam(const Http::Utility::QueryParams& params,
   return absl::nullopt;
 }
 
+void addIndentedJson(absl::string_view json, uint32_t depth, Buffer::Instance& response) {
+  // Pretty-printed JSON is indented by one space per level, and has no newlines within strings.
+  const std::string indent(depth, ' ');
+  absl::ConsumeSuffix(&json, "\n");
+  response.add(indent);
+  response.add(absl::StrReplaceAll(json, {{"\n", absl::StrCat("\n", indent)}}));
+}
+
 } // namespace Utility
 } // namespace Server
 } // namespace Envoy
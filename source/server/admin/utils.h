@@ -28,6 +28,16 @@ absl::optional<std::string> formatParam(const Http::Utility::QueryParams& params
 absl::optional<std::string> queryParam(const Http::Utility::QueryParams& params,
                                        const std::string& key);
 
+/**
+ * Adds the pretty-printed JSON of a message to `response`, indented as when the message is nested
+ * `depth` levels deep in a pretty-printed message. This lets streaming handlers render a large
+ * message one element at a time, with the same output as when rendering the message whole.
+ * @param json the output of MessageUtil::getJsonStringFromMessageOrError with pretty-printing.
+ * @param depth the nesting depth of the message.
+ * @param response the buffer to which the indented JSON is added, without a trailing newline.
+ */
+void addIndentedJson(absl::string_view json, uint32_t depth, Buffer::Instance& response);
+
 } // namespace Utility
 } // namespace Server
 } // namespace Envoy
@@ -103,6 +103,8 @@ protected:
         IS_ENVOY_BUG("Unexpected function call");
       }
       bool initializeReadFilters() override { return true; }
+      uint32_t numReadFilters() const override { return 0; }
+      uint32_t numWriteFilters() const override { return 0; }
 
       // Network::Connection
       void addConnectionCallbacks(Network::ConnectionCallbacks& cb) override {
@@ -148,6 +150,7 @@ protected:
       }
       void setConnectionStats(const Network::Connection::ConnectionStats&) override {}
       Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
+      bool forwardsPayloadUnchanged() const override { return false; }
       absl::string_view requestedServerName() const override { return EMPTY_STRING; }
       State state() const override { return Network::Connection::State::Open; }
       bool connecting() const override { return false; }
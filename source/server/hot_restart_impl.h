@@ -98,7 +98,7 @@ private:
 class HotRestartImpl : public HotRestart {
 public:
   HotRestartImpl(uint32_t base_id, uint32_t restart_epoch, const std::string& socket_path,
-                 mode_t socket_mode);
+                 mode_t socket_mode, Stats::SharedMemoryStatsRegion* stats_region = nullptr);
 
   // Server::HotRestart
   void drainParentListeners() override;
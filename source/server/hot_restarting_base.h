@@ -27,6 +27,10 @@ namespace Server {
  */
 class HotRestartingBase : public Logger::Loggable<Logger::Id::main> {
 protected:
+  static constexpr uint64_t MaxSendmsgSize = 4096;
+  // The most fds a PassListenSockets reply carries. The reply must fit in a single sendmsg().
+  static constexpr uint32_t MaxPassedFds = 64;
+
   HotRestartingBase(uint64_t base_id) : base_id_(base_id) {}
   ~HotRestartingBase();
 
@@ -68,7 +72,7 @@ protected:
   static Stats::Gauge& hotRestartGeneration(Stats::Scope& scope);
 
 private:
-  void getPassedFdIfPresent(envoy::HotRestartMessage* out, msghdr* message);
+  void getPassedFdsIfPresent(envoy::HotRestartMessage* out, msghdr* message);
   std::unique_ptr<envoy::HotRestartMessage> parseProtoAndResetState();
   void initRecvBufIfNewMessage();
 
@@ -1,5 +1,6 @@
 #include "source/server/hot_restarting_child.h"
 
+#include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/utility.h"
 
 namespace Envoy {
@@ -8,8 +9,9 @@ namespace Server {
 using HotRestartMessage = envoy::HotRestartMessage;
 
 HotRestartingChild::HotRestartingChild(int base_id, int restart_epoch,
-                                       const std::string& socket_path, mode_t socket_mode)
-    : HotRestartingBase(base_id), restart_epoch_(restart_epoch) {
+                                       const std::string& socket_path, mode_t socket_mode,
+                                       Stats::SharedMemoryStatsRegion* stats_region)
+    : HotRestartingBase(base_id), restart_epoch_(restart_epoch), stats_region_(stats_region) {
   initDomainSocketAddress(&parent_address_);
   if (restart_epoch_ != 0) {
     parent_address_ =
@@ -18,12 +20,25 @@ HotRestartingChild::HotRestartingChild(int base_id, int restart_epoch,
   bindDomainSocket(restart_epoch_, "child", socket_path, socket_mode);
 }
 
+HotRestartingChild::~HotRestartingChild() { closeUnusedParentListenSockets(); }
+
 int HotRestartingChild::duplicateParentListenSocket(const std::string& address,
                                                     uint32_t worker_index) {
   if (restart_epoch_ == 0 || parent_terminated_) {
     return -1;
   }
 
+  if (!parent_listen_sockets_requested_) {
+    getAllParentListenSockets();
+  }
+  auto it = parent_listen_sockets_.find(std::make_pair(address, worker_index));
+  if (it != parent_listen_sockets_.end()) {
+    const int fd = it->second;
+    parent_listen_sockets_.erase(it);
+    return fd;
+  }
+
+  // The listener may have been added to the parent since it passed its sockets.
   HotRestartMessage wrapped_request;
   wrapped_request.mutable_request()->mutable_pass_listen_socket()->set_address(address);
   wrapped_request.mutable_request()->mutable_pass_listen_socket()->set_worker_index(worker_index);
@@ -36,6 +51,46 @@ int HotRestartingChild::duplicateParentListenSocket(const std::string& address,
   return wrapped_reply->reply().pass_listen_socket().fd();
 }
 
+void HotRestartingChild::getAllParentListenSockets() {
+  parent_listen_sockets_requested_ = true;
+  uint32_t first_socket = 0;
+  bool more = true;
+  while (more) {
+    HotRestartMessage wrapped_request;
+    wrapped_request.mutable_request()->mutable_pass_listen_sockets()->set_first_socket(
+        first_socket);
+    sendHotRestartMessage(parent_address_, wrapped_request);
+
+    std::unique_ptr<HotRestartMessage> wrapped_reply = receiveHotRestartMessage(Blocking::Yes);
+    if (!replyIsExpectedType(wrapped_reply.get(), HotRestartMessage::Reply::kPassListenSockets)) {
+      // The parent doesn't know the request, so the sockets are asked for one at a time.
+      ENVOY_LOG(debug, "hot restart parent did not pass all its listen sockets at once");
+      return;
+    }
+    const auto& reply = wrapped_reply->reply().pass_listen_sockets();
+    for (const auto& socket : reply.sockets()) {
+      auto [it, inserted] = parent_listen_sockets_.try_emplace(
+          std::make_pair(socket.address(), socket.worker_index()), socket.fd());
+      if (!inserted) {
+        // The listeners of the parent changed in between two replies.
+        Api::OsSysCallsSingleton::get().close(socket.fd());
+      }
+    }
+    first_socket += reply.sockets_size();
+    more = reply.more();
+  }
+  ENVOY_LOG(debug, "hot restart parent passed {} listen sockets", parent_listen_sockets_.size());
+}
+
+void HotRestartingChild::closeUnusedParentListenSockets() {
+  // Otherwise the sockets of the listeners the child doesn't have would stay bound after the
+  // parent exits.
+  for (const auto& socket : parent_listen_sockets_) {
+    Api::OsSysCallsSingleton::get().close(socket.second);
+  }
+  parent_listen_sockets_.clear();
+}
+
 std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentStats() {
   if (restart_epoch_ == 0 || parent_terminated_) {
     return nullptr;
@@ -52,6 +107,8 @@ std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentStats() {
 }
 
 void HotRestartingChild::drainParentListeners() {
+  // The listeners of the child are all up, so the sockets they didn't ask for aren't needed.
+  closeUnusedParentListenSockets();
   if (restart_epoch_ == 0 || parent_terminated_) {
     return;
   }
@@ -119,7 +176,26 @@ void HotRestartingChild::mergeParentStats(Stats::Store& stats_store,
       spans.push_back(Stats::DynamicSpan(span_proto.first(), span_proto.last()));
     }
   }
-  stat_merger_->mergeStats(stats_proto.counter_deltas(), stats_proto.gauges(), dynamics);
+  if (stats_region_ == nullptr) {
+    stat_merger_->mergeStats(stats_proto.counter_deltas(), stats_proto.gauges(), dynamics);
+    return;
+  }
+
+  // The values of the stats held in the shared memory region are written by both processes, so
+  // they already include the contributions of the parent.
+  Protobuf::Map<std::string, uint64_t> counter_deltas;
+  for (const auto& counter : stats_proto.counter_deltas()) {
+    if (!stats_region_->contains(counter.first, Stats::SharedMemoryStatsRegion::Type::Counter)) {
+      counter_deltas.insert(counter);
+    }
+  }
+  Protobuf::Map<std::string, uint64_t> gauges;
+  for (const auto& gauge : stats_proto.gauges()) {
+    if (!stats_region_->contains(gauge.first, Stats::SharedMemoryStatsRegion::Type::Gauge)) {
+      gauges.insert(gauge);
+    }
+  }
+  stat_merger_->mergeStats(counter_deltas, gauges, dynamics);
 }
 
 } // namespace Server
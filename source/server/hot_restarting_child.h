@@ -1,8 +1,13 @@
 #pragma once
 
+#include <utility>
+
+#include "source/common/stats/shared_memory_stats.h"
 #include "source/common/stats/stat_merger.h"
 #include "source/server/hot_restarting_base.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -11,8 +16,13 @@ namespace Server {
  */
 class HotRestartingChild : HotRestartingBase {
 public:
+  /**
+   * @param stats_region supplies the shared memory region of the stats, if any. The stats it
+   *        holds are shared with the parent, so they are not merged from the parent stats.
+   */
   HotRestartingChild(int base_id, int restart_epoch, const std::string& socket_path,
-                     mode_t socket_mode);
+                     mode_t socket_mode, Stats::SharedMemoryStatsRegion* stats_region = nullptr);
+  ~HotRestartingChild();
 
   int duplicateParentListenSocket(const std::string& address, uint32_t worker_index);
   std::unique_ptr<envoy::HotRestartMessage> getParentStats();
@@ -23,11 +33,21 @@ public:
                         const envoy::HotRestartMessage::Reply::Stats& stats_proto);
 
 private:
+  // Gets all the listen sockets of the parent at once, unless the parent is too old to pass them
+  // that way.
+  void getAllParentListenSockets();
+  void closeUnusedParentListenSockets();
+
   const int restart_epoch_;
+  Stats::SharedMemoryStatsRegion* const stats_region_;
   bool parent_terminated_{};
   sockaddr_un parent_address_;
   std::unique_ptr<Stats::StatMerger> stat_merger_{};
   Stats::StatName hot_restart_generation_stat_name_;
+  bool parent_listen_sockets_requested_{};
+  // The fds of the listen sockets passed by the parent, by address and worker index, until the
+  // listener manager asks for them.
+  absl::flat_hash_map<std::pair<std::string, uint32_t>, int> parent_listen_sockets_;
 };
 
 } // namespace Server
@@ -8,6 +8,8 @@
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -53,6 +55,12 @@ void HotRestartingParent::onSocketEvent() {
       break;
     }
 
+    case HotRestartMessage::Request::kPassListenSockets: {
+      sendHotRestartMessage(child_address_,
+                            internal_->getAllListenSocketsForChild(wrapped_request->request()));
+      break;
+    }
+
     case HotRestartMessage::Request::kStats: {
       HotRestartMessage wrapped_reply;
       internal_->exportStatsToChild(wrapped_reply.mutable_reply()->mutable_stats());
@@ -131,6 +139,58 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
   return wrapped_reply;
 }
 
+HotRestartMessage HotRestartingParent::Internal::getAllListenSocketsForChild(
+    const HotRestartMessage::Request& request) {
+  HotRestartMessage wrapped_reply;
+  HotRestartMessage::Reply::PassListenSockets* reply =
+      wrapped_reply.mutable_reply()->mutable_pass_listen_sockets();
+  const uint32_t first_socket = request.pass_listen_sockets().first_socket();
+  const uint32_t concurrency = server_->options().concurrency();
+  uint32_t socket_index = 0;
+
+  for (const auto& listener : server_->listenerManager().listeners()) {
+    if (!listener.get().bindToPort()) {
+      continue;
+    }
+    for (auto& socket_factory : listener.get().listenSocketFactories()) {
+      // The address is formatted the way the listener manager of the child asks for it.
+      const Network::Address::Instance& local_address = *socket_factory->localAddress();
+      std::string address;
+      if (local_address.type() == Network::Address::Type::Pipe) {
+        address = absl::StrCat(Network::Utility::UNIX_SCHEME, local_address.asString());
+      } else if (local_address.type() == Network::Address::Type::Ip) {
+        address = absl::StrCat(socket_factory->socketType() == Network::Socket::Type::Stream
+                                   ? Network::Utility::TCP_SCHEME
+                                   : Network::Utility::UDP_SCHEME,
+                               local_address.asString());
+      } else {
+        continue;
+      }
+
+      for (uint32_t worker_index = 0; worker_index < concurrency; worker_index++) {
+        if (socket_index++ < first_socket) {
+          continue;
+        }
+        if (static_cast<uint32_t>(reply->sockets_size()) == MaxPassedFds) {
+          reply->set_more(true);
+          return wrapped_reply;
+        }
+        HotRestartMessage::Reply::PassListenSockets::Socket* socket = reply->add_sockets();
+        socket->set_address(address);
+        socket->set_worker_index(worker_index);
+        socket->set_fd(socket_factory->getListenSocket(worker_index)->ioHandle().fdDoNotUse());
+        // The fds are passed with a single sendmsg(), so the reply must fit in one.
+        if (sizeof(uint64_t) + wrapped_reply.ByteSizeLong() > MaxSendmsgSize) {
+          reply->mutable_sockets()->RemoveLast();
+          reply->set_more(true);
+          return wrapped_reply;
+        }
+      }
+    }
+  }
+  return wrapped_reply;
+}
+
 // TODO(fredlas) if there are enough stats for stat name length to become an issue, this current
 // implementation can negate the benefit of symbolized stat names by periodically reaching the
 // magnitude of memory usage that they are meant to avoid, since this map holds full-string
@@ -28,6 +28,10 @@ public:
     // Return value is the response to return to the child.
     envoy::HotRestartMessage
     getListenSocketsForChild(const envoy::HotRestartMessage::Request& request);
+    // Return value is the response to return to the child, passing as many of the listen sockets
+    // of the workers as fit in a single message, starting at the requested one.
+    envoy::HotRestartMessage
+    getAllListenSocketsForChild(const envoy::HotRestartMessage::Request& request);
     // 'stats' is a field in the reply protobuf to be sent to the child, which we should populate.
     void exportStatsToChild(envoy::HotRestartMessage::Reply::Stats* stats);
     void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
@@ -15,6 +15,7 @@
 #include "source/common/version/version.h"
 #include "source/server/options_impl_platform.h"
 
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_replace.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
@@ -111,6 +112,11 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "Logger mode: enable file level log control (Fine-Grain Logger) or not", cmd, false);
   TCLAP::ValueArg<std::string> log_path("", "log-path", "Path to logfile", false, "", "string",
                                         cmd);
+  TCLAP::ValueArg<uint64_t> log_async_buffer_size(
+      "", "log-async-buffer-size",
+      "Size in bytes of the per-thread buffers of the log lines written by a background thread, "
+      "0 to write them synchronously",
+      false, 0, "uint64_t", cmd);
   TCLAP::ValueArg<uint32_t> restart_epoch("", "restart-epoch", "hot restart epoch #", false, 0,
                                           "uint32_t", cmd);
   TCLAP::SwitchArg hot_restart_version_option("", "hot-restart-version",
@@ -144,6 +150,10 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "", "enable-mutex-tracing", "Enable mutex contention tracing functionality", cmd, false);
   TCLAP::SwitchArg cpuset_threads(
       "", "cpuset-threads", "Get the default # of worker threads from cpuset size", cmd, false);
+  TCLAP::ValueArg<std::string> worker_cpus(
+      "", "worker-cpus",
+      "Comma-separated list of CPUs and CPU ranges (e.g. '0-3,8-11') to pin the worker threads to",
+      false, "", "string", cmd);
 
   TCLAP::ValueArg<std::string> disable_extensions("", "disable-extensions",
                                                   "Comma-separated list of extensions to disable",
@@ -164,6 +174,16 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       "set multiple universal tags. Multiple values for the same tag name are not allowed.",
       false, "string", cmd);
 
+  TCLAP::ValueArg<std::string> stats_shared_memory_path(
+      "", "stats-shared-memory-path",
+      "Path of a file in which to place the values of counters and gauges, for other processes "
+      "to read",
+      false, "", "string", cmd);
+  TCLAP::ValueArg<uint32_t> stats_shared_memory_max_stats(
+      "", "stats-shared-memory-max-stats",
+      "Maximum number of stats placed in the stats shared memory file", false, 16384, "uint32_t",
+      cmd);
+
   cmd.setExceptionHandling(false);
   TRY_ASSERT_MAIN_THREAD {
     cmd.parse(args);
@@ -190,6 +210,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   core_dump_enabled_ = enable_core_dump.getValue();
 
   cpuset_threads_ = cpuset_threads.getValue();
+  worker_cpus_ = parseCpuList(worker_cpus.getValue());
 
   if (log_level.isSet()) {
     log_level_ = parseAndValidateLogLevel(log_level.getValue());
@@ -234,7 +255,10 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
     throw MalformedArgvException(message);
   }
 
-  if (!concurrency.isSet() && cpuset_threads_) {
+  if (!concurrency.isSet() && !worker_cpus_.empty()) {
+    // Run one worker per CPU the workers are pinned to.
+    concurrency_ = worker_cpus_.size();
+  } else if (!concurrency.isSet() && cpuset_threads_) {
     // The 'concurrency' command line option wasn't set but the 'cpuset-threads'
     // option was set. Use the number of CPUs assigned to the process cpuset, if
     // that can be known.
@@ -259,6 +283,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   ignore_unknown_dynamic_fields_ = ignore_unknown_dynamic_fields.getValue();
   admin_address_path_ = admin_address_path.getValue();
   log_path_ = log_path.getValue();
+  log_async_buffer_size_ = log_async_buffer_size.getValue();
   service_cluster_ = service_cluster.getValue();
   service_node_ = service_node.getValue();
   service_zone_ = service_zone.getValue();
@@ -323,6 +348,12 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       stats_tags_.emplace_back(Stats::Tag{std::string(name), std::string(value)});
     }
   }
+
+  stats_shared_memory_path_ = stats_shared_memory_path.getValue();
+  stats_shared_memory_max_stats_ = stats_shared_memory_max_stats.getValue();
+  if (!stats_shared_memory_path_.empty() && stats_shared_memory_max_stats_ == 0) {
+    throw MalformedArgvException("error: stats-shared-memory-max-stats must be greater than 0");
+  }
 }
 
 spdlog::level::level_enum OptionsImpl::parseAndValidateLogLevel(absl::string_view log_level) {
@@ -378,6 +409,28 @@ void OptionsImpl::parseComponentLogLevels(const std::string& component_log_level
   }
 }
 
+std::vector<uint32_t> OptionsImpl::parseCpuList(absl::string_view cpu_list) {
+  std::vector<uint32_t> cpus;
+  if (cpu_list.empty()) {
+    return cpus;
+  }
+  for (const absl::string_view entry : absl::StrSplit(cpu_list, ',')) {
+    const std::vector<absl::string_view> bounds = absl::StrSplit(entry, absl::MaxSplits('-', 1));
+    uint32_t first;
+    uint32_t last;
+    if (!absl::SimpleAtoi(bounds[0], &first) ||
+        !absl::SimpleAtoi(bounds.size() == 2 ? bounds[1] : bounds[0], &last) || last < first ||
+        last >= MaxCpus) {
+      throw MalformedArgvException(
+          fmt::format("error: invalid CPU list '{}' at '{}'", cpu_list, entry));
+    }
+    for (uint32_t cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
 uint32_t OptionsImpl::count() const { return count_; }
 
 void OptionsImpl::logError(const std::string& error) { throw MalformedArgvException(error); }
@@ -402,6 +455,7 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_log_format_escaped(logFormatEscaped());
   command_line_options->set_enable_fine_grain_logging(enableFineGrainLogging());
   command_line_options->set_log_path(logPath());
+  command_line_options->set_log_async_buffer_size(logAsyncBufferSize());
   command_line_options->set_service_cluster(serviceClusterName());
   command_line_options->set_service_node(serviceNodeName());
   command_line_options->set_service_zone(serviceZone());
@@ -431,6 +485,9 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_disable_hot_restart(hotRestartDisabled());
   command_line_options->set_enable_mutex_tracing(mutexTracingEnabled());
   command_line_options->set_cpuset_threads(cpusetThreadsEnabled());
+  for (const uint32_t cpu : workerCpus()) {
+    command_line_options->add_worker_cpus(cpu);
+  }
   command_line_options->set_restart_epoch(restartEpoch());
   for (const auto& e : disabledExtensions()) {
     command_line_options->add_disabled_extensions(e);
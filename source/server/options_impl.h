@@ -84,6 +84,9 @@ public:
   void setLogLevel(spdlog::level::level_enum log_level) { log_level_ = log_level; }
   void setLogFormat(const std::string& log_format) { log_format_ = log_format; }
   void setLogPath(const std::string& log_path) { log_path_ = log_path; }
+  void setLogAsyncBufferSize(uint64_t log_async_buffer_size) {
+    log_async_buffer_size_ = log_async_buffer_size;
+  }
   void setRestartEpoch(uint64_t restart_epoch) { restart_epoch_ = restart_epoch; }
   void setMode(Server::Mode mode) { mode_ = mode; }
   void setFileFlushIntervalMsec(std::chrono::milliseconds file_flush_interval_msec) {
@@ -101,6 +104,7 @@ public:
     signal_handling_enabled_ = signal_handling_enabled;
   }
   void setCpusetThreads(bool cpuset_threads_enabled) { cpuset_threads_ = cpuset_threads_enabled; }
+  void setWorkerCpus(const std::vector<uint32_t>& worker_cpus) { worker_cpus_ = worker_cpus; }
   void setAllowUnknownFields(bool allow_unknown_static_fields) {
     allow_unknown_static_fields_ = allow_unknown_static_fields;
   }
@@ -116,6 +120,10 @@ public:
   void setSocketMode(mode_t socket_mode) { socket_mode_ = socket_mode; }
 
   void setStatsTags(const Stats::TagVector& stats_tags) { stats_tags_ = stats_tags; }
+  void setStatsSharedMemoryPath(const std::string& path) { stats_shared_memory_path_ = path; }
+  void setStatsSharedMemoryMaxStats(uint32_t max_stats) {
+    stats_shared_memory_max_stats_ = max_stats;
+  }
 
   void setListenerManager(absl::string_view manager) { listener_manager_ = std::string(manager); }
 
@@ -149,6 +157,7 @@ public:
   bool logFormatEscaped() const override { return log_format_escaped_; }
   bool enableFineGrainLogging() const override { return enable_fine_grain_logging_; }
   const std::string& logPath() const override { return log_path_; }
+  uint64_t logAsyncBufferSize() const override { return log_async_buffer_size_; }
   uint64_t restartEpoch() const override { return restart_epoch_; }
   Server::Mode mode() const override { return mode_; }
   std::chrono::milliseconds fileFlushIntervalMsec() const override {
@@ -162,9 +171,12 @@ public:
   bool mutexTracingEnabled() const override { return mutex_tracing_enabled_; }
   bool coreDumpEnabled() const override { return core_dump_enabled_; }
   const Stats::TagVector& statsTags() const override { return stats_tags_; }
+  const std::string& statsSharedMemoryPath() const override { return stats_shared_memory_path_; }
+  uint32_t statsSharedMemoryMaxStats() const override { return stats_shared_memory_max_stats_; }
   Server::CommandLineOptionsPtr toCommandLineOptions() const override;
   void parseComponentLogLevels(const std::string& component_log_levels);
   bool cpusetThreadsEnabled() const override { return cpuset_threads_; }
+  const std::vector<uint32_t>& workerCpus() const override { return worker_cpus_; }
   const std::vector<std::string>& disabledExtensions() const override {
     return disabled_extensions_;
   }
@@ -188,6 +200,15 @@ public:
    */
   static spdlog::level::level_enum parseAndValidateLogLevel(absl::string_view log_level);
 
+  /**
+   * Parses a comma-separated list of CPUs and inclusive CPU ranges, such as "0-3,8,10-11".
+   * @throws MalformedArgvException if the list is malformed.
+   */
+  static std::vector<uint32_t> parseCpuList(absl::string_view cpu_list);
+
+  // The largest CPU number accepted by parseCpuList(), exclusive.
+  static constexpr uint32_t MaxCpus = 1024;
+
 private:
   static void logError(const std::string& error);
 
@@ -210,6 +231,7 @@ private:
   std::string log_format_{Logger::Logger::DEFAULT_LOG_FORMAT};
   bool log_format_escaped_{false};
   std::string log_path_;
+  uint64_t log_async_buffer_size_{0};
   uint64_t restart_epoch_{0};
   std::string service_cluster_;
   std::string service_node_;
@@ -224,8 +246,11 @@ private:
   bool mutex_tracing_enabled_{false};
   bool core_dump_enabled_{false};
   bool cpuset_threads_{false};
+  std::vector<uint32_t> worker_cpus_;
   std::vector<std::string> disabled_extensions_;
   Stats::TagVector stats_tags_;
+  std::string stats_shared_memory_path_;
+  uint32_t stats_shared_memory_max_stats_{16384};
   uint32_t count_{0};
 
   // Initialization added here to avoid integration_admin_test failure caused by uninitialized
@@ -7,6 +7,7 @@
 #include "envoy/config/overload/v3/overload.pb.validate.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/common/fmt.h"
 #include "source/common/config/utility.h"
 #include "source/common/event/scaled_range_timer_manager_impl.h"
@@ -312,6 +313,9 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
               absl::node_hash_map<OverloadProactiveResourceName, ProactiveResource>>()) {
   Configuration::ResourceMonitorFactoryContextImpl context(dispatcher, options, api,
                                                            validation_visitor);
+  Buffer::SlicePool::setMaxBytesPerThread(
+      config.buffer_factory_config().slice_pool_max_bytes_per_thread());
+
   // We should hide impl details from users, for them there should be no distinction between
   // proactive and regular resource monitors in configuration API. But internally we will maintain
   // two distinct collections of proactive and regular resources. Proactive resources are not
@@ -374,6 +378,13 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
             fmt::format("Overload action \"{}\" requires buffer_factory_config.", name));
       }
       makeCounter(api.rootScope(), OverloadActionStatsNames::get().ResetStreamsCount);
+    } else if (name == OverloadActionNames::get().CloseConnections) {
+      if (!config.buffer_factory_config().track_connections()) {
+        throw EnvoyException(fmt::format(
+            "Overload action \"{}\" requires buffer_factory_config with track_connections.",
+            name));
+      }
+      makeCounter(api.rootScope(), OverloadActionStatsNames::get().CloseConnectionsCount);
     } else if (action.has_typed_config()) {
       throw EnvoyException(fmt::format(
           "Overload action \"{}\" has an unexpected value for the typed_config field", name));
@@ -1,5 +1,6 @@
 #include "source/server/server.h"
 
+#include <algorithm>
 #include <csignal>
 #include <cstdint>
 #include <ctime>
@@ -26,6 +27,7 @@
 
 #include "source/common/api/api_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/mutex_tracer_impl.h"
 #include "source/common/common/utility.h"
@@ -46,6 +48,7 @@
 #include "source/common/network/tcp_listener_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/rds_impl.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/runtime/runtime_impl.h"
 #include "source/common/signal/fatal_error_handler.h"
 #include "source/common/singleton/manager_impl.h"
@@ -100,8 +103,8 @@ InstanceImpl::InstanceImpl(
       access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
                           store),
       singleton_manager_(new Singleton::ManagerImpl(api_->threadFactory())),
-      handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
-      terminated_(false),
+      handler_(getHandler(*dispatcher_)),
+      worker_factory_(thread_local_, *api_, hooks, options.workerCpus()), terminated_(false),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
       grpc_context_(store.symbolTable()), http_context_(store.symbolTable()),
@@ -120,6 +123,10 @@ InstanceImpl::InstanceImpl(
             fmt::format("Failed to open log-file '{}'. e.what(): {}", options.logPath(), e.what()));
       }
     }
+    if (options.logAsyncBufferSize() > 0) {
+      async_logger_ = std::make_unique<Logger::AsyncSinkDelegate>(
+          options.logAsyncBufferSize(), api_->threadFactory(), Logger::Registry::getSink());
+    }
 
     restarter_.initialize(*dispatcher_, *this);
     drain_manager_ = component_factory.createDrainManager(*this);
@@ -148,7 +155,9 @@ InstanceImpl::~InstanceImpl() {
   terminate();
 
   // Stop logging to file before all the AccessLogManager and its dependencies are
-  // destructed to avoid crashing at shutdown.
+  // destructed to avoid crashing at shutdown. The async logger writes its last lines to the file
+  // logger first.
+  async_logger_.reset();
   file_logger_.reset();
 
   // Destruct the ListenerManager explicitly, before InstanceImpl's local init_manager_ is
@@ -197,34 +206,54 @@ void InstanceImpl::failHealthcheck(bool fail) {
   server_stats_->live_.set(live_.load());
 }
 
-MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store, TimeSource& time_source) {
+MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store, TimeSource& time_source, bool delta) {
+  // Delta snapshots usually hold a small fraction of the metrics, so they are not reserved for all
+  // of them.
   store.forEachSinkedCounter(
-      [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
+      [this, delta](std::size_t size) {
+        if (!delta) {
+          snapped_counters_.reserve(size);
+          counters_.reserve(size);
+        }
       },
-      [this](Stats::Counter& counter) {
+      [this, delta](Stats::Counter& counter) {
+        const uint64_t value = counter.latch();
+        if (delta && value == 0) {
+          return;
+        }
         snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
+        counters_.push_back({value, counter});
       });
 
   store.forEachSinkedGauge(
-      [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
+      [this, delta](std::size_t size) {
+        if (!delta) {
+          snapped_gauges_.reserve(size);
+          gauges_.reserve(size);
+        }
       },
-      [this](Stats::Gauge& gauge) {
+      [this, delta](Stats::Gauge& gauge) {
         ASSERT(gauge.importMode() != Stats::Gauge::ImportMode::Uninitialized);
+        // The changed state is latched by full snapshots too, so that a later delta snapshot does
+        // not include the gauges that didn't change since.
+        if (!gauge.latchChanged() && delta) {
+          return;
+        }
         snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
         gauges_.push_back(gauge);
       });
 
   store.forEachSinkedHistogram(
-      [this](std::size_t size) {
-        snapped_histograms_.reserve(size);
-        histograms_.reserve(size);
+      [this, delta](std::size_t size) {
+        if (!delta) {
+          snapped_histograms_.reserve(size);
+          histograms_.reserve(size);
+        }
       },
-      [this](Stats::ParentHistogram& histogram) {
+      [this, delta](Stats::ParentHistogram& histogram) {
+        if (delta && histogram.intervalStatistics().sampleCount() == 0) {
+          return;
+        }
         snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
         histograms_.push_back(histogram);
       });
@@ -248,7 +277,12 @@ void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, S
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, time_source);
+  const bool delta =
+      !sinks.empty() &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.delta_stats_flush") &&
+      std::all_of(sinks.begin(), sinks.end(),
+                  [](const Stats::SinkPtr& sink) { return sink->acceptsDeltaSnapshots(); });
+  MetricSnapshotImpl snapshot(store, time_source, delta);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -286,6 +320,15 @@ void InstanceImpl::updateServerStats() {
                                        parent_stats.parent_memory_allocated_);
   server_stats_->memory_heap_size_.set(Memory::Stats::totalCurrentlyReserved());
   server_stats_->memory_physical_size_.set(Memory::Stats::totalPhysicalBytes());
+  const Buffer::SlicePoolStats slice_pool_stats = Buffer::SlicePool::stats();
+  server_stats_->memory_slice_pool_bytes_held_.set(slice_pool_stats.bytes_held_);
+  server_stats_->memory_slice_pool_hits_.add(slice_pool_stats.hits_ - slice_pool_hits_);
+  server_stats_->memory_slice_pool_misses_.add(slice_pool_stats.misses_ - slice_pool_misses_);
+  slice_pool_hits_ = slice_pool_stats.hits_;
+  slice_pool_misses_ = slice_pool_stats.misses_;
+  if (async_logger_ != nullptr) {
+    server_stats_->log_messages_dropped_.set(async_logger_->droppedMessages());
+  }
   server_stats_->parent_connections_.set(parent_stats.parent_connections_);
   server_stats_->total_connections_.set(listener_manager_->numConnections() +
                                         parent_stats.parent_connections_);
@@ -400,6 +443,13 @@ void InstanceUtil::loadBootstrapConfig(envoy::config::bootstrap::v3::Bootstrap&
 
 void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_address,
                               ComponentFactory& component_factory) {
+  startup_profiler_ = std::make_unique<StartupProfiler>(time_source_, *stats_store_.rootScope());
+  startup_profiler_->startPhase("load_bootstrap");
+  init_manager_.trackTargetDurations(
+      time_source_, [this](absl::string_view target_name, std::chrono::milliseconds duration) {
+        startup_profiler_->onInitTargetReady(target_name, duration);
+      });
+
   ENVOY_LOG(info, "initializing epoch {} (base id={}, hot restart version={})",
             options_.restartEpoch(), restarter_.baseId(), restarter_.version());
 
@@ -412,6 +462,7 @@ void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_add
   InstanceUtil::loadBootstrapConfig(bootstrap_, options_,
                                     messageValidationContext().staticValidationVisitor(), *api_);
   bootstrap_config_update_time_ = time_source_.systemTime();
+  startup_profiler_->startPhase("initialize_server");
 
 #ifdef ENVOY_PERFETTO
   perfetto::TracingInitArgs args;
@@ -692,6 +743,16 @@ void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_add
   if (admin_) {
     config_tracker_entry_ = admin_->getConfigTracker().add(
         "bootstrap", [this](const Matchers::StringMatcher&) { return dumpBootstrapConfig(); });
+    admin_->addHandler(
+        "/startup_profile", "print the time spent in each phase of the server startup",
+        [this](Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
+               AdminStream& admin_stream) {
+          return startup_profiler_->handlerStartupProfile(response_headers, response,
+                                                          admin_stream);
+        },
+        false, false,
+        {{Admin::ParamDescriptor::Type::String, "init_targets",
+          "Number of the slowest init targets to report, 10 by default"}});
   }
   if (initial_config.admin().address()) {
     admin_->addListenerToHandler(handler_.get());
@@ -707,6 +768,8 @@ void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_add
       messageValidationContext(), *api_, http_context_, grpc_context_, router_context_,
       access_log_manager_, *singleton_manager_, options_, quic_stat_names_, *this);
 
+  startup_profiler_->startPhase("load_static_config");
+
   // Now the configuration gets parsed. The configuration may start setting
   // thread local data per above. See MainImpl::initialize() for why ConfigImpl
   // is constructed as part of the InstanceImpl and then populated once
@@ -731,6 +794,7 @@ void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_add
   // instantiated (which in turn relies on runtime...).
   runtime().initialize(clusterManager());
 
+  startup_profiler_->startPhase("primary_clusters_init");
   clusterManager().setPrimaryClustersInitializedCb(
       [this]() { onClusterManagerPrimaryInitializationComplete(); });
 
@@ -759,11 +823,13 @@ void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_add
 }
 
 void InstanceImpl::onClusterManagerPrimaryInitializationComplete() {
+  startup_profiler_->startPhase("rtds_init");
   // If RTDS was not configured the `onRuntimeReady` callback is immediately invoked.
   runtime().startRtdsSubscriptions([this]() { onRuntimeReady(); });
 }
 
 void InstanceImpl::onRuntimeReady() {
+  startup_profiler_->startPhase("secondary_clusters_init");
   // Begin initializing secondary clusters after RTDS configuration has been applied.
   // Initializing can throw exceptions, so catch these.
   TRY_ASSERT_MAIN_THREAD { clusterManager().initializeSecondaryClusters(bootstrap_); }
@@ -804,6 +870,7 @@ void InstanceImpl::onRuntimeReady() {
 }
 
 void InstanceImpl::startWorkers() {
+  startup_profiler_->startPhase("start_workers");
   // The callback will be called after workers are started.
   listener_manager_->startWorkers(*worker_guard_dog_, [this]() {
     if (isShutdown()) {
@@ -811,6 +878,7 @@ void InstanceImpl::startWorkers() {
     }
 
     initialization_timer_->complete();
+    startup_profiler_->complete();
     // Update server stats as soon as initialization is done.
     updateServerStats();
     workers_started_ = true;
@@ -846,7 +914,7 @@ void InstanceImpl::loadServerFlags(const absl::optional<std::string>& flags_path
 RunHelper::RunHelper(Instance& instance, const Options& options, Event::Dispatcher& dispatcher,
                      Upstream::ClusterManager& cm, AccessLog::AccessLogManager& access_log_manager,
                      Init::Manager& init_manager, OverloadManager& overload_manager,
-                     std::function<void()> post_init_cb)
+                     StartupProfiler& startup_profiler, std::function<void()> post_init_cb)
     : init_watcher_("RunHelper", [&instance, post_init_cb]() {
         if (!instance.isShutdown()) {
           post_init_cb();
@@ -887,10 +955,11 @@ RunHelper::RunHelper(Instance& instance, const Options& options, Event::Dispatch
   // this can fire immediately if all clusters have already initialized. Also note that we need
   // to guard against shutdown at two different levels since SIGTERM can come in once the run loop
   // starts.
-  cm.setInitializedCb([&instance, &init_manager, &cm, this]() {
+  cm.setInitializedCb([&instance, &init_manager, &cm, &startup_profiler, this]() {
     if (instance.isShutdown()) {
       return;
     }
+    startup_profiler.startPhase("init_manager");
 
     const auto type_url = Config::getTypeUrl<envoy::config::route::v3::RouteConfiguration>();
     // Pause RDS to ensure that we don't send any requests until we've
@@ -914,7 +983,8 @@ void InstanceImpl::run() {
   // RunHelper exists primarily to facilitate testing of how we respond to early shutdown during
   // startup (see RunHelperTest in server_test.cc).
   const auto run_helper = RunHelper(*this, options_, *dispatcher_, clusterManager(),
-                                    access_log_manager_, init_manager_, overloadManager(), [this] {
+                                    access_log_manager_, init_manager_, overloadManager(),
+                                    *startup_profiler_, [this] {
                                       notifyCallbacksForStage(Stage::PostInit);
                                       startWorkers();
                                     });
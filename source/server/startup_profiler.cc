@@ -0,0 +1,138 @@
+#include "source/server/startup_profiler.h"
+
+#include <algorithm>
+
+#include "source/common/http/headers.h"
+#include "source/common/http/utility.h"
+#include "source/common/protobuf/utility.h"
+#include "source/common/stats/utility.h"
+#include "source/server/admin/utils.h"
+
+#include "absl/strings/numbers.h"
+
+namespace Envoy {
+namespace Server {
+
+namespace {
+
+constexpr uint32_t DefaultMaxInitTargets = 10;
+
+std::chrono::microseconds cpuTimeSince(std::clock_t start) {
+  return std::chrono::microseconds(
+      static_cast<int64_t>(static_cast<double>(std::clock() - start) * 1000000 / CLOCKS_PER_SEC));
+}
+
+} // namespace
+
+StartupProfiler::StartupProfiler(TimeSource& time_source, Stats::Scope& scope)
+    : time_source_(time_source), scope_(scope), stat_name_pool_(scope.symbolTable()),
+      startup_(stat_name_pool_.add("server.startup")),
+      wall_time_ms_(stat_name_pool_.add("wall_time_ms")),
+      cpu_time_ms_(stat_name_pool_.add("cpu_time_ms")) {}
+
+void StartupProfiler::startPhase(absl::string_view name) {
+  if (complete_) {
+    return;
+  }
+  endPhase();
+  phases_.push_back({std::string(name), time_source_.monotonicTime(), std::clock()});
+  phase_running_ = true;
+}
+
+void StartupProfiler::complete() {
+  endPhase();
+  complete_ = true;
+}
+
+void StartupProfiler::endPhase() {
+  if (!phase_running_) {
+    return;
+  }
+  Phase& phase = phases_.back();
+  phase.wall_time_ = wallTime(phase);
+  phase.cpu_time_ = cpuTime(phase);
+  phase_running_ = false;
+
+  const Stats::DynamicName name(phase.name_);
+  Stats::Utility::gaugeFromElements(scope_, {startup_, name, wall_time_ms_},
+                                    Stats::Gauge::ImportMode::NeverImport)
+      .set(std::chrono::duration_cast<std::chrono::milliseconds>(phase.wall_time_).count());
+  Stats::Utility::gaugeFromElements(scope_, {startup_, name, cpu_time_ms_},
+                                    Stats::Gauge::ImportMode::NeverImport)
+      .set(std::chrono::duration_cast<std::chrono::milliseconds>(phase.cpu_time_).count());
+}
+
+std::chrono::microseconds StartupProfiler::wallTime(const Phase& phase) const {
+  if (phase_running_ && &phase == &phases_.back()) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() -
+                                                                 phase.start_);
+  }
+  return phase.wall_time_;
+}
+
+std::chrono::microseconds StartupProfiler::cpuTime(const Phase& phase) const {
+  if (phase_running_ && &phase == &phases_.back()) {
+    return cpuTimeSince(phase.cpu_start_);
+  }
+  return phase.cpu_time_;
+}
+
+void StartupProfiler::onInitTargetReady(absl::string_view name,
+                                        std::chrono::milliseconds duration) {
+  init_targets_.push_back({std::string(name), duration});
+}
+
+envoy::admin::v3::StartupProfile StartupProfiler::profile(uint32_t max_init_targets) const {
+  envoy::admin::v3::StartupProfile profile;
+  for (const Phase& phase : phases_) {
+    auto& phase_proto = *profile.add_phases();
+    phase_proto.set_name(phase.name_);
+    *phase_proto.mutable_start() = Protobuf::util::TimeUtil::MicrosecondsToDuration(
+        std::chrono::duration_cast<std::chrono::microseconds>(phase.start_ -
+                                                              phases_.front().start_)
+            .count());
+    *phase_proto.mutable_wall_time() =
+        Protobuf::util::TimeUtil::MicrosecondsToDuration(wallTime(phase).count());
+    *phase_proto.mutable_cpu_time() =
+        Protobuf::util::TimeUtil::MicrosecondsToDuration(cpuTime(phase).count());
+  }
+
+  std::vector<const InitTarget*> slowest;
+  slowest.reserve(init_targets_.size());
+  for (const InitTarget& target : init_targets_) {
+    slowest.push_back(&target);
+  }
+  const size_t count = std::min<size_t>(max_init_targets, slowest.size());
+  std::partial_sort(slowest.begin(), slowest.begin() + count, slowest.end(),
+                    [](const InitTarget* lhs, const InitTarget* rhs) {
+                      return lhs->duration_ > rhs->duration_;
+                    });
+  for (size_t i = 0; i < count; i++) {
+    auto& target_proto = *profile.add_slowest_init_targets();
+    target_proto.set_name(slowest[i]->name_);
+    *target_proto.mutable_duration() =
+        Protobuf::util::TimeUtil::MillisecondsToDuration(slowest[i]->duration_.count());
+  }
+
+  profile.set_complete(complete_);
+  return profile;
+}
+
+Http::Code StartupProfiler::handlerStartupProfile(Http::ResponseHeaderMap& response_headers,
+                                                  Buffer::Instance& response,
+                                                  AdminStream& admin_stream) const {
+  uint32_t max_init_targets = DefaultMaxInitTargets;
+  const absl::optional<std::string> init_targets =
+      Utility::queryParam(admin_stream.queryParams(), "init_targets");
+  if (init_targets.has_value() && !absl::SimpleAtoi(init_targets.value(), &max_init_targets)) {
+    response.add("usage: /startup_profile?init_targets=<number of init targets to report>\n");
+    return Http::Code::BadRequest;
+  }
+
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  response.add(MessageUtil::getJsonStringFromMessageOrError(profile(max_init_targets), true));
+  return Http::Code::OK;
+}
+
+} // namespace Server
+} // namespace Envoy
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "envoy/admin/v3/startup_profile.pb.h"
+#include "envoy/buffer/buffer.h"
+#include "envoy/common/time.h"
+#include "envoy/http/codes.h"
+#include "envoy/http/header_map.h"
+#include "envoy/server/admin.h"
+#include "envoy/stats/scope.h"
+
+#include "source/common/stats/symbol_table.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * Records the timeline of the server startup: the wall clock and CPU time spent in each of its
+ * phases, and how long the targets of the server init manager took to become ready. The timeline
+ * is served by the /startup_profile admin endpoint, and the time spent in each phase is also
+ * reported by the server.startup.<phase>.wall_time_ms and cpu_time_ms gauges once it ends.
+ */
+class StartupProfiler {
+public:
+  StartupProfiler(TimeSource& time_source, Stats::Scope& scope);
+
+  /**
+   * Ends the current phase, if any, and starts the named one. Does nothing once the startup is
+   * complete.
+   * @param name supplies the name of the phase, which must be a valid stat name element.
+   */
+  void startPhase(absl::string_view name);
+
+  /**
+   * Ends the current phase, which completes the startup.
+   */
+  void complete();
+
+  /**
+   * Records how long an init target of the server took to become ready. Matches
+   * Init::Manager::TargetReadyCb.
+   */
+  void onInitTargetReady(absl::string_view name, std::chrono::milliseconds duration);
+
+  /**
+   * @param max_init_targets supplies the number of the slowest init targets to report.
+   * @return the timeline of the startup so far.
+   */
+  envoy::admin::v3::StartupProfile profile(uint32_t max_init_targets) const;
+
+  /**
+   * Handler of the /startup_profile admin endpoint.
+   */
+  Http::Code handlerStartupProfile(Http::ResponseHeaderMap& response_headers,
+                                   Buffer::Instance& response, AdminStream& admin_stream) const;
+
+  bool isComplete() const { return complete_; }
+
+private:
+  struct Phase {
+    std::string name_;
+    MonotonicTime start_;
+    std::clock_t cpu_start_;
+    std::chrono::microseconds wall_time_{};
+    std::chrono::microseconds cpu_time_{};
+  };
+
+  struct InitTarget {
+    std::string name_;
+    std::chrono::milliseconds duration_;
+  };
+
+  void endPhase();
+  // Returns the wall and CPU time spent in the phase so far if it's still running.
+  std::chrono::microseconds wallTime(const Phase& phase) const;
+  std::chrono::microseconds cpuTime(const Phase& phase) const;
+
+  TimeSource& time_source_;
+  Stats::Scope& scope_;
+  Stats::StatNamePool stat_name_pool_;
+  const Stats::StatName startup_;
+  const Stats::StatName wall_time_ms_;
+  const Stats::StatName cpu_time_ms_;
+  std::vector<Phase> phases_;
+  bool phase_running_{false};
+  bool complete_{false};
+  std::vector<InitTarget> init_targets_;
+};
+
+} // namespace Server
+} // namespace Envoy
@@ -31,17 +31,25 @@ WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overl
   Event::DispatcherPtr dispatcher(
       api_.allocateDispatcher(worker_name, overload_manager.scaledTimerFactory()));
   auto conn_handler = getHandler(*dispatcher, index);
+  std::vector<uint32_t> cpus;
+  if (!worker_cpus_.empty()) {
+    cpus.push_back(worker_cpus_[index % worker_cpus_.size()]);
+    ENVOY_LOG(debug, "pinning {} to CPU {}", worker_name, cpus.back());
+  }
   return std::make_unique<WorkerImpl>(tls_, hooks_, std::move(dispatcher), std::move(conn_handler),
-                                      overload_manager, api_, stat_names_);
+                                      overload_manager, api_, stat_names_, std::move(cpus));
 }
 
 WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        Event::DispatcherPtr&& dispatcher, Network::ConnectionHandlerPtr handler,
                        OverloadManager& overload_manager, Api::Api& api,
-                       WorkerStatNames& stat_names)
+                       WorkerStatNames& stat_names, std::vector<uint32_t> cpus)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      close_connections_counter_(
+          api_.rootScope().counterFromStatName(stat_names.close_high_memory_connections_)),
+      cpus_(std::move(cpus)) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -52,6 +60,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
   overload_manager.registerForAction(
       OverloadActionNames::get().ResetStreams, *dispatcher_,
       [this](OverloadActionState state) { resetStreamsUsingExcessiveMemory(state); });
+  overload_manager.registerForAction(
+      OverloadActionNames::get().CloseConnections, *dispatcher_,
+      [this](OverloadActionState state) { closeConnectionsUsingExcessiveMemory(state); });
 }
 
 void WorkerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -106,7 +117,7 @@ void WorkerImpl::start(GuardDog& guard_dog, const Event::PostCb& cb) {
   //
   // TODO(jmarantz): consider refactoring how this naming works so this naming
   // architecture is centralized, resulting in clearer names.
-  Thread::Options options{absl::StrCat("wrk:", dispatcher_->name())};
+  Thread::Options options{absl::StrCat("wrk:", dispatcher_->name()), cpus_};
   thread_ = api_.threadFactory().createThread(
       [this, &guard_dog, cb]() -> void { threadRoutine(guard_dog, cb); }, options);
 }
@@ -172,5 +183,11 @@ void WorkerImpl::resetStreamsUsingExcessiveMemory(OverloadActionState state) {
   reset_streams_counter_.add(streams_reset_count);
 }
 
+void WorkerImpl::closeConnectionsUsingExcessiveMemory(OverloadActionState state) {
+  uint64_t connections_closed_count =
+      dispatcher_->getWatermarkFactory().closeConnectionsGivenPressure(state.value().value());
+  close_connections_counter_.add(connections_closed_count);
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "envoy/api/api.h"
 #include "envoy/network/connection_handler.h"
@@ -20,16 +21,21 @@ namespace Server {
 struct WorkerStatNames {
   explicit WorkerStatNames(Stats::SymbolTable& symbol_table)
       : pool_(symbol_table),
-        reset_high_memory_stream_(pool_.add(OverloadActionStatsNames::get().ResetStreamsCount)) {}
+        reset_high_memory_stream_(pool_.add(OverloadActionStatsNames::get().ResetStreamsCount)),
+        close_high_memory_connections_(
+            pool_.add(OverloadActionStatsNames::get().CloseConnectionsCount)) {}
 
   Stats::StatNamePool pool_;
   Stats::StatName reset_high_memory_stream_;
+  Stats::StatName close_high_memory_connections_;
 };
 
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
 public:
-  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
-      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks) {}
+  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks,
+                    const std::vector<uint32_t>& worker_cpus)
+      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks),
+        worker_cpus_(worker_cpus) {}
 
   // Server::WorkerFactory
   WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
@@ -40,6 +46,8 @@ private:
   Api::Api& api_;
   WorkerStatNames stat_names_;
   ListenerHooks& hooks_;
+  // Worker i is pinned to worker_cpus_[i % worker_cpus_.size()], if any.
+  const std::vector<uint32_t> worker_cpus_;
 };
 
 /**
@@ -49,7 +57,7 @@ class WorkerImpl : public Worker, Logger::Loggable<Logger::Id::main> {
 public:
   WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks, Event::DispatcherPtr&& dispatcher,
              Network::ConnectionHandlerPtr handler, OverloadManager& overload_manager,
-             Api::Api& api, WorkerStatNames& stat_names);
+             Api::Api& api, WorkerStatNames& stat_names, std::vector<uint32_t> cpus = {});
 
   // Server::Worker
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
@@ -70,6 +78,7 @@ private:
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
+  void closeConnectionsUsingExcessiveMemory(OverloadActionState state);
 
   ThreadLocal::Instance& tls_;
   ListenerHooks& hooks_;
@@ -77,6 +86,9 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  Stats::Counter& close_connections_counter_;
+  // The CPUs the worker thread is pinned to. Empty if it isn't pinned.
+  const std::vector<uint32_t> cpus_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
 };
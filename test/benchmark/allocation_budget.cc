@@ -0,0 +1,37 @@
+#include "test/benchmark/allocation_budget.h"
+
+#include <string>
+
+#include "source/common/memory/allocation_counter.h"
+
+#include "test/benchmark/main.h"
+
+#include "fmt/format.h"
+
+namespace Envoy {
+
+void AllocationBudget::check(::benchmark::State& state, const std::function<void()>& body) const {
+  const absl::optional<Memory::AllocationCounter::Allocations> allocations =
+      Memory::AllocationCounter::count([&body]() {
+        for (uint64_t i = 0; i < CountedIterations; i++) {
+          body();
+        }
+      });
+  if (!allocations.has_value()) {
+    return;
+  }
+
+  const double allocs_per_iteration = static_cast<double>(allocations->count_) / CountedIterations;
+  const double bytes_per_iteration = static_cast<double>(allocations->bytes_) / CountedIterations;
+  state.counters["allocs_per_iteration"] = allocs_per_iteration;
+  state.counters["alloc_bytes_per_iteration"] = bytes_per_iteration;
+  if (allocs_per_iteration > allocs_per_iteration_ || bytes_per_iteration > bytes_per_iteration_) {
+    const std::string error = fmt::format(
+        "{} allocations of {} bytes per iteration exceed the budget of {} allocations of {} bytes",
+        allocs_per_iteration, bytes_per_iteration, allocs_per_iteration_, bytes_per_iteration_);
+    state.SkipWithError(error.c_str());
+    benchmark::setFailed();
+  }
+}
+
+} // namespace Envoy
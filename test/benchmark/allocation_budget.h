@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+
+/**
+ * The heap allocations a benchmark may make per iteration, checked in next to the benchmark so that
+ * changes adding allocations to a hot path fail its benchmark test. The allocations are counted on
+ * builds using tcmalloc only, see Memory::AllocationCounter; elsewhere the budgets aren't checked.
+ */
+class AllocationBudget {
+public:
+  // The iterations run with the allocations counted. Counting makes allocations much slower, so
+  // this is kept small; budgets aren't meaningful for bodies that only allocate every so many
+  // iterations, e.g. when a buffer grows.
+  static constexpr uint64_t CountedIterations = 100;
+
+  constexpr AllocationBudget(double allocs_per_iteration, double bytes_per_iteration)
+      : allocs_per_iteration_(allocs_per_iteration), bytes_per_iteration_(bytes_per_iteration) {}
+
+  /**
+   * Runs `body`, one iteration of the benchmark, CountedIterations times with its allocations
+   * counted, and reports their averages as the "allocs_per_iteration" and
+   * "alloc_bytes_per_iteration" counters of the benchmark. Exceeding the budget fails the
+   * benchmark and makes the benchmark binary exit with an error once all benchmarks have run.
+   * This is meant to be called after the timed loop, so that the caches of the body are warm.
+   */
+  void check(::benchmark::State& state, const std::function<void()>& body) const;
+
+private:
+  const double allocs_per_iteration_;
+  const double bytes_per_iteration_;
+};
+
+} // namespace Envoy
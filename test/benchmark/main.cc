@@ -14,6 +14,7 @@
 using namespace Envoy;
 
 static bool skip_expensive_benchmarks = false;
+static bool failed = false;
 
 // Boilerplate main(), which discovers benchmarks and runs them. This uses two
 // different flag parsers, so the order of flags matters: flags defined here
@@ -103,6 +104,9 @@ int main(int argc, char** argv) {
         "Expensive benchmarks are being skipped; see test/README.md for more information");
   }
   ::benchmark::RunSpecifiedBenchmarks();
+  return failed ? 1 : 0;
 }
 
 bool Envoy::benchmark::skipExpensiveBenchmarks() { return skip_expensive_benchmarks; }
+
+void Envoy::benchmark::setFailed() { failed = true; }
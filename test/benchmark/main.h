@@ -9,5 +9,11 @@ namespace benchmark {
 
 bool skipExpensiveBenchmarks();
 
+/**
+ * Makes the benchmark binary exit with an error once all benchmarks have run. Benchmarks checking
+ * their results, e.g. against an AllocationBudget, call this on failure.
+ */
+void setFailed();
+
 }
 } // namespace Envoy
@@ -1,4 +1,5 @@
 #include <memory>
+#include <vector>
 
 #include "source/common/access_log/access_log_manager_impl.h"
 #include "source/common/filesystem/file_shared_impl.h"
@@ -9,11 +10,16 @@
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/filesystem/mocks.h"
 #include "test/test_common/test_time.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+
 using testing::_;
 using testing::ByMove;
 using testing::Invoke;
@@ -486,6 +492,54 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+// Verifies that the data written by several threads is all flushed, the data of each thread in the
+// order it was written.
+TEST_F(AccessLogManagerImplTest, WritesOfEachThreadStayInOrder) {
+  constexpr uint32_t Threads = 4;
+  constexpr uint32_t WritesPerThread = 1000;
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  // write_() is called under the write mutex of the file.
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&written](absl::string_view data) -> Api::IoCallSizeResult {
+        written.append(data.data(), data.size());
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t thread = 0; thread < Threads; thread++) {
+    threads.push_back(thread_factory_.createThread([&log_file, thread]() {
+      for (uint32_t i = 0; i < WritesPerThread; i++) {
+        log_file->write(absl::StrCat(thread, " ", i, "\n"));
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+
+  Thread::LockGuard lock(file_->write_mutex_);
+  std::vector<uint32_t> next(Threads, 0);
+  for (absl::string_view line : absl::StrSplit(written, '\n', absl::SkipEmpty())) {
+    std::vector<absl::string_view> fields = absl::StrSplit(line, ' ');
+    ASSERT_EQ(2, fields.size());
+    uint32_t thread;
+    uint32_t i;
+    ASSERT_TRUE(absl::SimpleAtoi(fields[0], &thread));
+    ASSERT_TRUE(absl::SimpleAtoi(fields[1], &i));
+    ASSERT_LT(thread, Threads);
+    EXPECT_EQ(next[thread]++, i);
+  }
+  EXPECT_EQ(std::vector<uint32_t>(Threads, WritesPerThread), next);
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
@@ -6,6 +6,7 @@
 #include "source/common/buffer/buffer_impl.h"
 
 #include "test/integration/tracked_watermark_buffer.h"
+#include "test/mocks/buffer/mocks.h"
 #include "test/mocks/http/stream_reset_handler.h"
 
 #include "gmock/gmock.h"
@@ -677,6 +678,157 @@ TEST(WatermarkBufferFactoryTest,
   }
 }
 
+class ConnectionAccountTest : public testing::Test {
+protected:
+  ConnectionAccountTest()
+      : factory_([]() {
+          envoy::config::overload::v3::BufferFactoryConfig config;
+          config.set_minimum_account_to_track_power_of_two(absl::bit_width(kMinimumBalanceToTrack));
+          config.set_track_connections(true);
+          return config;
+        }()) {}
+
+  WatermarkBufferFactory factory_;
+};
+
+TEST(WatermarkBufferFactoryTest, DoesNotCreateConnectionAccountsUnlessTrackingConnections) {
+  MockConnectionCloseHandler close_handler;
+  auto config = envoy::config::overload::v3::BufferFactoryConfig();
+  config.set_minimum_account_to_track_power_of_two(20);
+  WatermarkBufferFactory factory(config);
+  EXPECT_EQ(factory.createConnectionAccount(close_handler), nullptr);
+
+  // Connections aren't tracked when accounts aren't.
+  config.clear_minimum_account_to_track_power_of_two();
+  config.set_track_connections(true);
+  WatermarkBufferFactory not_tracking_factory(config);
+  EXPECT_EQ(not_tracking_factory.createConnectionAccount(close_handler), nullptr);
+}
+
+TEST_F(ConnectionAccountTest, AccountCanCloseConnection) {
+  MockConnectionCloseHandler close_handler;
+  auto account = factory_.createConnectionAccount(close_handler);
+  ASSERT_NE(account, nullptr);
+  EXPECT_TRUE(static_cast<BufferMemoryAccountImpl*>(account.get())->isConnectionAccount());
+
+  EXPECT_CALL(close_handler, closeConnection());
+  account->resetDownstream();
+  account->clearDownstream();
+
+  // No-op once cleared.
+  account->resetDownstream();
+}
+
+// Connection accounts are tracked apart from stream accounts, so that closing connections doesn't
+// reset streams and vice versa.
+TEST_F(ConnectionAccountTest, ConnectionAndStreamAccountsAreTrackedApart) {
+  MockConnectionCloseHandler close_handler;
+  Http::MockStreamResetHandler reset_handler;
+  auto connection_account = factory_.createConnectionAccount(close_handler);
+  auto stream_account = factory_.createAccount(reset_handler);
+  connection_account->charge(kThresholdForFinalBucket);
+  stream_account->charge(kThresholdForFinalBucket);
+
+  EXPECT_CALL(reset_handler, resetStream(_)).Times(0);
+  EXPECT_CALL(close_handler, closeConnection()).WillOnce(Invoke([&]() {
+    connection_account->clearDownstream();
+  }));
+  EXPECT_EQ(factory_.closeConnectionsGivenPressure(1.0), 1);
+  EXPECT_EQ(factory_.closeConnectionsGivenPressure(1.0), 0);
+  testing::Mock::VerifyAndClearExpectations(&close_handler);
+
+  EXPECT_CALL(reset_handler, resetStream(_)).WillOnce(Invoke([&]() {
+    stream_account->clearDownstream();
+  }));
+  EXPECT_EQ(factory_.resetAccountsGivenPressure(1.0), 1);
+
+  connection_account->credit(kThresholdForFinalBucket);
+  stream_account->credit(kThresholdForFinalBucket);
+}
+
+TEST_F(ConnectionAccountTest, ClosesLargestConnectionsGivenPressure) {
+  MockConnectionCloseHandler largest_connection;
+  MockConnectionCloseHandler connection;
+  MockConnectionCloseHandler smallest_connection;
+  auto largest_account = factory_.createConnectionAccount(largest_connection);
+  auto account = factory_.createConnectionAccount(connection);
+  auto smallest_account = factory_.createConnectionAccount(smallest_connection);
+  largest_account->charge(kThresholdForFinalBucket);
+  account->charge(2 * kMinimumBalanceToTrack);
+  smallest_account->charge(kMinimumBalanceToTrack);
+
+  // Only the last bucket is closed at the lowest pressure.
+  EXPECT_CALL(largest_connection, closeConnection()).WillOnce(Invoke([&]() {
+    largest_account->clearDownstream();
+  }));
+  EXPECT_EQ(factory_.closeConnectionsGivenPressure(0.0), 1);
+
+  // Every bucket >= 1.
+  EXPECT_CALL(connection, closeConnection()).WillOnce(Invoke([&]() {
+    account->clearDownstream();
+  }));
+  EXPECT_CALL(smallest_connection, closeConnection()).Times(0);
+  EXPECT_EQ(factory_.closeConnectionsGivenPressure(0.85), 1);
+
+  largest_account->credit(kThresholdForFinalBucket);
+  account->credit(2 * kMinimumBalanceToTrack);
+  smallest_account->credit(kMinimumBalanceToTrack);
+  smallest_account->clearDownstream();
+}
+
+// Closing a connection can close other connections picked by the same invocation, e.g. the upstream
+// connection proxied to.
+TEST_F(ConnectionAccountTest, ConnectionsClosedByOtherConnectionsAreSkipped) {
+  MockConnectionCloseHandler downstream;
+  MockConnectionCloseHandler upstream;
+  auto downstream_account = factory_.createConnectionAccount(downstream);
+  auto upstream_account = factory_.createConnectionAccount(upstream);
+  downstream_account->charge(kThresholdForFinalBucket);
+  upstream_account->charge(kThresholdForFinalBucket);
+
+  const auto close_both = [&]() {
+    downstream_account->clearDownstream();
+    upstream_account->clearDownstream();
+  };
+  // Whichever is closed first closes the other one.
+  uint32_t closed = 0;
+  EXPECT_CALL(downstream, closeConnection()).WillRepeatedly(Invoke([&]() {
+    ++closed;
+    close_both();
+  }));
+  EXPECT_CALL(upstream, closeConnection()).WillRepeatedly(Invoke([&]() {
+    ++closed;
+    close_both();
+  }));
+  EXPECT_EQ(factory_.closeConnectionsGivenPressure(1.0), 1);
+  EXPECT_EQ(closed, 1);
+
+  downstream_account->credit(kThresholdForFinalBucket);
+  upstream_account->credit(kThresholdForFinalBucket);
+}
+
+TEST_F(ConnectionAccountTest, LimitsNumberOfConnectionsClosedPerInvocation) {
+  std::vector<std::unique_ptr<MockConnectionCloseHandler>> close_handlers;
+  std::vector<BufferMemoryAccountSharedPtr> accounts;
+  uint32_t closed = 0;
+  for (int i = 0; i < 2 * kMaxStreamsResetPerCall; ++i) {
+    close_handlers.push_back(std::make_unique<MockConnectionCloseHandler>());
+    accounts.push_back(factory_.createConnectionAccount(*close_handlers.back()));
+    accounts.back()->charge(kThresholdForFinalBucket);
+    EXPECT_CALL(*close_handlers.back(), closeConnection())
+        .WillOnce(Invoke([&closed, account = accounts.back()]() {
+          account->credit(kThresholdForFinalBucket);
+          account->clearDownstream();
+          ++closed;
+        }));
+  }
+
+  EXPECT_EQ(factory_.closeConnectionsGivenPressure(1.0), kMaxStreamsResetPerCall);
+  EXPECT_EQ(closed, kMaxStreamsResetPerCall);
+  EXPECT_EQ(factory_.closeConnectionsGivenPressure(1.0), kMaxStreamsResetPerCall);
+  EXPECT_EQ(closed, 2 * kMaxStreamsResetPerCall);
+}
+
 } // namespace
 } // namespace Buffer
 } // namespace Envoy
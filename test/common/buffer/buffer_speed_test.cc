@@ -5,6 +5,9 @@
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/assert.h"
 
+#include "test/benchmark/allocation_budget.h"
+
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 
@@ -24,11 +27,15 @@ void deleteFragment(const void*, size_t, const Buffer::BufferFragmentImpl* self)
 // Test the creation of an empty OwnedImpl.
 static void bufferCreateEmpty(benchmark::State& state) {
   uint64_t length = 0;
-  for (auto _ : state) {
-    UNREFERENCED_PARAMETER(_);
+  auto create = [&length]() {
     Buffer::OwnedImpl buffer;
     length += buffer.length();
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    create();
   }
+  AllocationBudget(0, 0).check(state, create);
   benchmark::DoNotOptimize(length);
 }
 BENCHMARK(bufferCreateEmpty);
@@ -114,11 +121,16 @@ static void bufferCreate(benchmark::State& state) {
   const std::string data(state.range(0), 'a');
   const absl::string_view input(data);
   uint64_t length = 0;
-  for (auto _ : state) {
-    UNREFERENCED_PARAMETER(_);
+  auto create = [&]() {
     Buffer::OwnedImpl buffer(input);
     length += buffer.length();
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    create();
   }
+  // At most the storage of a single slice, which may be reused from the slice pool instead.
+  AllocationBudget(1, Buffer::Slice::sliceSize(data.size())).check(state, create);
   benchmark::DoNotOptimize(length);
 }
 BENCHMARK(bufferCreate)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
@@ -391,10 +403,12 @@ static void bufferSearch(benchmark::State& state) {
   const absl::string_view input(data);
   Buffer::OwnedImpl buffer(input);
   ssize_t result = 0;
+  auto search = [&]() { result += buffer.search(Pattern.c_str(), Pattern.length(), 0, 0); };
   for (auto _ : state) {
     UNREFERENCED_PARAMETER(_);
-    result += buffer.search(Pattern.c_str(), Pattern.length(), 0, 0);
+    search();
   }
+  AllocationBudget(0, 0).check(state, search);
   benchmark::DoNotOptimize(result);
 }
 BENCHMARK(bufferSearch)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
@@ -415,14 +429,96 @@ static void bufferSearchPartialMatch(benchmark::State& state) {
   const absl::string_view input(data);
   Buffer::OwnedImpl buffer(input);
   ssize_t result = 0;
+  auto search = [&]() { result += buffer.search(Pattern.c_str(), Pattern.length(), 0, 0); };
   for (auto _ : state) {
     UNREFERENCED_PARAMETER(_);
-    result += buffer.search(Pattern.c_str(), Pattern.length(), 0, 0);
+    search();
   }
+  AllocationBudget(0, 0).check(state, search);
   benchmark::DoNotOptimize(result);
 }
 BENCHMARK(bufferSearchPartialMatch)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
 
+// Test buffer search over a body of text held in 1KB slices, where the first byte of the pattern is
+// frequent and the pattern spans two slices.
+static void bufferSearchMultiSlice(benchmark::State& state) {
+  const std::string Pattern("</body>");
+  const std::string Text("<p>Lorem ipsum dolor sit amet, <b>consectetur</b> adipiscing.</p>\n");
+  const size_t SliceSize = 1024;
+  std::string data;
+  while (data.size() < static_cast<size_t>(state.range(0))) {
+    data += Text;
+  }
+  data.resize(state.range(0));
+  // Start the pattern 2 bytes before the end of a slice.
+  data.resize((data.size() / SliceSize + 1) * SliceSize - 2, ' ');
+  data += Pattern;
+
+  Buffer::OwnedImpl buffer;
+  for (size_t offset = 0; offset < data.size(); offset += SliceSize) {
+    const absl::string_view slice = absl::string_view(data).substr(offset, SliceSize);
+    auto fragment =
+        std::make_unique<Buffer::BufferFragmentImpl>(slice.data(), slice.size(), deleteFragment);
+    buffer.addBufferFragment(*fragment.release());
+  }
+  ssize_t result = 0;
+  auto search = [&]() { result += buffer.search(Pattern.c_str(), Pattern.length(), 0, 0); };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    search();
+  }
+  AllocationBudget(0, 0).check(state, search);
+  benchmark::DoNotOptimize(result);
+}
+BENCHMARK(bufferSearchMultiSlice)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
+
+// Test buffer searchAny for several patterns found at the end of the buffer, compared to
+// bufferSearchSeveralPatterns searching each pattern on its own.
+static void bufferSearchAny(benchmark::State& state) {
+  const std::vector<absl::string_view> Patterns = {"bbbbbbbbbbbbbbbb", "cccc", "dddddddd", "e"};
+  std::string data(state.range(0), 'a');
+  for (const absl::string_view pattern : Patterns) {
+    absl::StrAppend(&data, pattern);
+  }
+
+  Buffer::OwnedImpl buffer(data);
+  ssize_t result = 0;
+  auto search = [&]() {
+    size_t pattern_index = 0;
+    result += buffer.searchAny(Patterns, 0, 0, pattern_index);
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    search();
+  }
+  AllocationBudget(0, 0).check(state, search);
+  benchmark::DoNotOptimize(result);
+}
+BENCHMARK(bufferSearchAny)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
+
+static void bufferSearchSeveralPatterns(benchmark::State& state) {
+  const std::vector<absl::string_view> Patterns = {"bbbbbbbbbbbbbbbb", "cccc", "dddddddd", "e"};
+  std::string data(state.range(0), 'a');
+  for (const absl::string_view pattern : Patterns) {
+    absl::StrAppend(&data, pattern);
+  }
+
+  Buffer::OwnedImpl buffer(data);
+  ssize_t result = 0;
+  auto search = [&]() {
+    for (const absl::string_view pattern : Patterns) {
+      result += buffer.search(pattern.data(), pattern.length(), 0, 0);
+    }
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    search();
+  }
+  AllocationBudget(0, 0).check(state, search);
+  benchmark::DoNotOptimize(result);
+}
+BENCHMARK(bufferSearchSeveralPatterns)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
+
 // Test buffer startsWith, for the simple case where there is no match for the pattern at the start
 // of the buffer.
 static void bufferStartsWith(benchmark::State& state) {
@@ -435,12 +531,16 @@ static void bufferStartsWith(benchmark::State& state) {
   const absl::string_view input(data);
   Buffer::OwnedImpl buffer(input);
   ssize_t result = 0;
-  for (auto _ : state) {
-    UNREFERENCED_PARAMETER(_);
+  auto starts_with = [&]() {
     if (!buffer.startsWith({Pattern.c_str(), Pattern.length()})) {
       result++;
     }
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    starts_with();
   }
+  AllocationBudget(0, 0).check(state, starts_with);
   benchmark::DoNotOptimize(result);
 }
 BENCHMARK(bufferStartsWith)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
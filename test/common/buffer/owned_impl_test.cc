@@ -962,6 +962,91 @@ TEST_F(OwnedImplTest, SearchWithLengthLimit) {
   EXPECT_EQ(12, buffer.search("ba", 2, 11, 10e6));
 }
 
+// Slices longer than the vector width, with matches in them and across their boundaries.
+TEST_F(OwnedImplTest, SearchLargeSlices) {
+  const std::string filler(100, 'a');
+  Buffer::OwnedImpl buffer;
+  buffer.appendSliceForTest(filler + "xyz" + filler + "xy");
+  buffer.appendSliceForTest("");
+  buffer.appendSliceForTest("z" + filler + "x");
+  buffer.appendSliceForTest("y");
+  buffer.appendSliceForTest("z");
+  ASSERT_EQ(309, buffer.length());
+
+  EXPECT_EQ(100, buffer.search("xyz", 3, 0, 0));
+  EXPECT_EQ(99, buffer.search("axyz", 4, 99, 0));
+  // Matches spanning two and three slices.
+  EXPECT_EQ(203, buffer.search("xyz", 3, 101, 0));
+  EXPECT_EQ(203, buffer.search("xyza", 4, 101, 0));
+  EXPECT_EQ(306, buffer.search("xyz", 3, 204, 0));
+  EXPECT_EQ(305, buffer.search("axyz", 4, 204, 0));
+  // The match ends past the searched range.
+  EXPECT_EQ(-1, buffer.search("xyz", 3, 101, 104));
+  EXPECT_EQ(203, buffer.search("xyz", 3, 101, 105));
+  EXPECT_EQ(-1, buffer.search("xyz", 3, 204, 104));
+  EXPECT_EQ(306, buffer.search("xyz", 3, 204, 105));
+  EXPECT_EQ(-1, buffer.search("xyzx", 4, 0, 0));
+}
+
+TEST_F(OwnedImplTest, SearchAny) {
+  static const char* Inputs[] = {"ab", "a", "", "aaa", "b", "a", "aaa", "ab", "a"};
+  Buffer::OwnedImpl buffer;
+  for (const auto& input : Inputs) {
+    buffer.appendSliceForTest(input);
+  }
+  EXPECT_STREQ("abaaaabaaaaaba", buffer.toString().c_str());
+
+  size_t pattern_index = 0;
+  const std::vector<absl::string_view> missing = {"c", "bb", "abaaaabaaaaabaa"};
+  EXPECT_EQ(-1, buffer.searchAny(missing, 0, 0, pattern_index));
+  EXPECT_EQ(-1, buffer.searchAny({}, 0, 0, pattern_index));
+  // Empty patterns are not found.
+  EXPECT_EQ(-1, buffer.searchAny({""}, 0, 0, pattern_index));
+  EXPECT_EQ(-1, buffer.searchAny({"ab", ""}, 0, 0, pattern_index));
+
+  const std::vector<absl::string_view> patterns = {"aaaab", "ba", "c", "aab"};
+  EXPECT_EQ(1, buffer.searchAny(patterns, 0, 0, pattern_index));
+  EXPECT_EQ(1, pattern_index);
+  EXPECT_EQ(2, buffer.searchAny(patterns, 2, 0, pattern_index));
+  EXPECT_EQ(0, pattern_index);
+  EXPECT_EQ(4, buffer.searchAny(patterns, 3, 0, pattern_index));
+  EXPECT_EQ(3, pattern_index);
+  // The first of the patterns starting at the same index is reported.
+  const std::vector<absl::string_view> same_start = {"aaab", "aab", "a"};
+  EXPECT_EQ(3, buffer.searchAny(same_start, 3, 0, pattern_index));
+  EXPECT_EQ(0, pattern_index);
+  EXPECT_EQ(4, buffer.searchAny({"aab", "aaab"}, 4, 0, pattern_index));
+  EXPECT_EQ(0, pattern_index);
+  EXPECT_EQ(8, buffer.searchAny(patterns, 7, 0, pattern_index));
+  EXPECT_EQ(0, pattern_index);
+  EXPECT_EQ(10, buffer.searchAny(patterns, 9, 0, pattern_index));
+  EXPECT_EQ(3, pattern_index);
+  EXPECT_EQ(12, buffer.searchAny(patterns, 11, 0, pattern_index));
+  EXPECT_EQ(1, pattern_index);
+  EXPECT_EQ(-1, buffer.searchAny(patterns, 13, 0, pattern_index));
+  EXPECT_EQ(-1, buffer.searchAny(patterns, buffer.length() + 1, 0, pattern_index));
+}
+
+TEST_F(OwnedImplTest, SearchAnyWithLengthLimit) {
+  static const char* Inputs[] = {"ab", "a", "", "aaa", "b", "a", "aaa", "ab", "a"};
+  Buffer::OwnedImpl buffer;
+  for (const auto& input : Inputs) {
+    buffer.appendSliceForTest(input);
+  }
+  EXPECT_STREQ("abaaaabaaaaaba", buffer.toString().c_str());
+
+  size_t pattern_index = 0;
+  const std::vector<absl::string_view> patterns = {"aaaab", "aab"};
+  // Only the shorter pattern fits in the range.
+  EXPECT_EQ(4, buffer.searchAny(patterns, 3, 4, pattern_index));
+  EXPECT_EQ(1, pattern_index);
+  EXPECT_EQ(2, buffer.searchAny(patterns, 2, 6, pattern_index));
+  EXPECT_EQ(0, pattern_index);
+  EXPECT_EQ(-1, buffer.searchAny(patterns, 3, 3, pattern_index));
+  EXPECT_EQ(8, buffer.searchAny(patterns, 5, 10e6, pattern_index));
+  EXPECT_EQ(0, pattern_index);
+}
+
 TEST_F(OwnedImplTest, StartsWith) {
   // Populate a buffer with a string split across many small slices, to
   // exercise edge cases in the startsWith implementation.
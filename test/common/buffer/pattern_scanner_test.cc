@@ -0,0 +1,78 @@
+#include <string>
+
+#include "source/common/buffer/pattern_scanner.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+TEST(PatternScannerTest, ImplementationName) {
+  EXPECT_FALSE(PatternScanner::implementationName().empty());
+}
+
+TEST(PatternScannerTest, Empty) {
+  EXPECT_EQ(absl::string_view::npos, PatternScanner::find("", "a"));
+  EXPECT_EQ(absl::string_view::npos, PatternScanner::find("a", "ab"));
+  EXPECT_EQ(absl::string_view::npos, PatternScanner::findFirstOf("", "ab"));
+}
+
+// The pattern is placed at every offset of haystacks spanning several vector widths, after
+// partial matches of its first and last bytes, so that both the vectorized loop and the scalar
+// tail are exercised.
+TEST(PatternScannerTest, FindMatchesStdFindForEveryLengthAndOffset) {
+  for (const std::string pattern :
+       {"x", "xy", "xay", "xaaaaaay", "xyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyz"}) {
+    for (size_t length = 0; length <= 100; ++length) {
+      const std::string filler = std::string(length, 'a');
+      for (size_t offset = 0; offset + pattern.size() <= length; ++offset) {
+        std::string haystack = filler;
+        // Decoys only matching the first or the last byte of the pattern.
+        for (size_t i = 0; i < offset; i += 3) {
+          haystack[i] = (i % 2 == 0) ? pattern.front() : pattern.back();
+        }
+        haystack.replace(offset, pattern.size(), pattern);
+        const size_t expected = absl::string_view(haystack).find(pattern);
+        ASSERT_EQ(expected, PatternScanner::findScalar(haystack, pattern))
+            << "pattern=" << pattern << " length=" << length << " offset=" << offset;
+        ASSERT_EQ(expected, PatternScanner::find(haystack, pattern))
+            << "pattern=" << pattern << " length=" << length << " offset=" << offset;
+      }
+      ASSERT_EQ(absl::string_view::npos, PatternScanner::find(filler, pattern));
+    }
+  }
+}
+
+TEST(PatternScannerTest, FindFirstOfMatchesStdFindFirstOfForEveryCharacterAndOffset) {
+  // Byte sets compared with vector instructions, and one looked up in a table.
+  for (const std::string bytes : {"x", "\r\n", "xyz\xff", "0123456789abcdefghij"}) {
+    for (size_t length = 1; length <= 100; ++length) {
+      const std::string filler(length, '-');
+      ASSERT_EQ(absl::string_view::npos, PatternScanner::findFirstOf(filler, bytes));
+      for (size_t offset = 0; offset < length; ++offset) {
+        for (const char c : bytes) {
+          std::string haystack = filler;
+          haystack[offset] = c;
+          ASSERT_EQ(offset, PatternScanner::findFirstOfScalar(haystack, bytes))
+              << "length=" << length << " offset=" << offset << " c=" << c;
+          ASSERT_EQ(offset, PatternScanner::findFirstOf(haystack, bytes))
+              << "length=" << length << " offset=" << offset << " c=" << c;
+        }
+      }
+    }
+  }
+}
+
+TEST(PatternScannerTest, ReportsFirstOfSeveralMatches) {
+  std::string haystack(64, 'a');
+  haystack.replace(40, 3, "xyz");
+  haystack.replace(20, 3, "xyz");
+  haystack[10] = 'z';
+  EXPECT_EQ(20, PatternScanner::find(haystack, "xyz"));
+  EXPECT_EQ(10, PatternScanner::findFirstOf(haystack, "yz"));
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,109 @@
+#include <thread>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SlicePoolTest : public testing::Test {
+protected:
+  SlicePoolTest() { SlicePool::setMaxBytesPerThread(64 * 1024); }
+  ~SlicePoolTest() override { SlicePool::setMaxBytesPerThread(0); }
+};
+
+TEST_F(SlicePoolTest, DisabledByDefault) {
+  SlicePool::setMaxBytesPerThread(0);
+  const SlicePoolStats before = SlicePool::stats();
+  { Slice slice(4096, nullptr); }
+  { Slice slice(4096, nullptr); }
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.hits_, after.hits_);
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(before.bytes_held_, after.bytes_held_);
+}
+
+TEST_F(SlicePoolTest, ReusesStorageOfSameSize) {
+  const SlicePoolStats before = SlicePool::stats();
+  const uint8_t* first_storage;
+  {
+    Slice slice(Slice::default_slice_size_, nullptr);
+    first_storage = slice.data();
+  }
+  EXPECT_EQ(Slice::default_slice_size_, SlicePool::stats().bytes_held_);
+
+  // A different size class is not served from the 16KiB free list.
+  { Slice slice(4096, nullptr); }
+
+  Slice slice(Slice::default_slice_size_, nullptr);
+  EXPECT_EQ(first_storage, slice.data());
+
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.hits_ + 1, after.hits_);
+  EXPECT_EQ(before.misses_ + 2, after.misses_);
+  EXPECT_EQ(4096, after.bytes_held_);
+}
+
+TEST_F(SlicePoolTest, LargeSlicesAreNotPooled) {
+  const SlicePoolStats before = SlicePool::stats();
+  { Slice slice(2 * Slice::default_slice_size_, nullptr); }
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(before.bytes_held_, after.bytes_held_);
+}
+
+TEST_F(SlicePoolTest, BoundedByMaxBytes) {
+  {
+    std::vector<Slice> slices;
+    for (int i = 0; i < 8; ++i) {
+      slices.emplace_back(Slice::default_slice_size_, nullptr);
+    }
+  }
+  EXPECT_EQ(64 * 1024, SlicePool::stats().bytes_held_);
+}
+
+TEST_F(SlicePoolTest, ReleaseAll) {
+  { Slice slice(Slice::default_slice_size_, nullptr); }
+  EXPECT_EQ(Slice::default_slice_size_, SlicePool::stats().bytes_held_);
+
+  SlicePool::releaseAll();
+  const SlicePoolStats before = SlicePool::stats();
+  { Slice slice(Slice::default_slice_size_, nullptr); }
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  EXPECT_EQ(Slice::default_slice_size_, after.bytes_held_);
+}
+
+TEST_F(SlicePoolTest, OwnedImplSteadyState) {
+  const SlicePoolStats before = SlicePool::stats();
+  for (int i = 0; i < 10; ++i) {
+    OwnedImpl buffer;
+    buffer.add(std::string(8000, 'a'));
+    buffer.drain(buffer.length());
+  }
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  EXPECT_EQ(before.hits_ + 9, after.hits_);
+}
+
+TEST_F(SlicePoolTest, PerThreadPools) {
+  { Slice slice(Slice::default_slice_size_, nullptr); }
+  const SlicePoolStats before = SlicePool::stats();
+  std::thread thread([]() {
+    // The main thread's cached storage is not visible here.
+    { Slice slice(Slice::default_slice_size_, nullptr); }
+    EXPECT_EQ(2 * Slice::default_slice_size_, SlicePool::stats().bytes_held_);
+  });
+  thread.join();
+  const SlicePoolStats after = SlicePool::stats();
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  // The exited thread's storage was freed.
+  EXPECT_EQ(Slice::default_slice_size_, after.bytes_held_);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
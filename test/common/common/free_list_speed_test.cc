@@ -0,0 +1,49 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+#include <vector>
+
+#include "source/common/common/free_list.h"
+#include "source/common/common/macros.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+// An object about as large as the streams of the HTTP connection manager.
+template <bool Pooled> class StreamLikeObject {
+public:
+  static void* operator new(size_t size) {
+    return Pooled ? FreeList::allocate(size) : ::operator new(size);
+  }
+  static void operator delete(void* ptr, size_t size) {
+    if (Pooled) {
+      FreeList::deallocate(ptr, size);
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+
+  using FreeList = ThreadLocalFreeList<StreamLikeObject, 128>;
+
+  char data_[4096];
+};
+
+// The streams of a worker come and go with a number of them in flight, given by state.range(0).
+template <bool Pooled> void bmStreamChurn(benchmark::State& state) {
+  std::vector<std::unique_ptr<StreamLikeObject<Pooled>>> streams(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    auto& stream = streams[i++ % streams.size()];
+    stream = std::make_unique<StreamLikeObject<Pooled>>();
+    benchmark::DoNotOptimize(stream->data_);
+  }
+}
+BENCHMARK_TEMPLATE(bmStreamChurn, false)->Arg(1)->Arg(16)->Arg(256)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(bmStreamChurn, true)->Arg(1)->Arg(16)->Arg(256)->ThreadRange(1, 8);
+
+} // namespace
+} // namespace Envoy
@@ -0,0 +1,110 @@
+#include <memory>
+#include <thread>
+
+#include "source/common/common/free_list.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+class PooledObject {
+public:
+  explicit PooledObject(uint64_t value) : value_(value) {}
+  virtual ~PooledObject() = default;
+
+  static void* operator new(size_t size) { return FreeList::allocate(size); }
+  static void operator delete(void* ptr, size_t size) { FreeList::deallocate(ptr, size); }
+
+  using FreeList = ThreadLocalFreeList<PooledObject, 2>;
+
+  uint64_t value_;
+};
+
+class LargerPooledObject : public PooledObject {
+public:
+  LargerPooledObject() : PooledObject(0) {}
+
+  char padding_[64]{};
+};
+
+// Empties the free list of the calling thread, which the other tests may have filled.
+void drainFreeList() {
+  while (PooledObject::FreeList::freeBlocks() > 0) {
+    ::operator delete(PooledObject::FreeList::allocate(sizeof(PooledObject)));
+  }
+}
+
+#ifndef ENVOY_THREAD_LOCAL_FREE_LIST_DISABLED
+TEST(ThreadLocalFreeListTest, ReusesFreedStorage) {
+  drainFreeList();
+  auto object = std::make_unique<PooledObject>(1);
+  void* storage = object.get();
+  object.reset();
+  EXPECT_EQ(1, PooledObject::FreeList::freeBlocks());
+
+  object = std::make_unique<PooledObject>(2);
+  EXPECT_EQ(storage, object.get());
+  EXPECT_EQ(2, object->value_);
+  EXPECT_EQ(0, PooledObject::FreeList::freeBlocks());
+}
+
+TEST(ThreadLocalFreeListTest, KeepsUpToMaxFreeBlocks) {
+  drainFreeList();
+  auto object1 = std::make_unique<PooledObject>(1);
+  auto object2 = std::make_unique<PooledObject>(2);
+  auto object3 = std::make_unique<PooledObject>(3);
+  object1.reset();
+  object2.reset();
+  object3.reset();
+  EXPECT_EQ(2, PooledObject::FreeList::freeBlocks());
+}
+
+TEST(ThreadLocalFreeListTest, SubclassesUseTheHeap) {
+  drainFreeList();
+  const size_t free_blocks = PooledObject::FreeList::freeBlocks();
+
+  std::unique_ptr<PooledObject> larger = std::make_unique<LargerPooledObject>();
+  EXPECT_EQ(free_blocks, PooledObject::FreeList::freeBlocks());
+  larger.reset();
+  EXPECT_EQ(free_blocks, PooledObject::FreeList::freeBlocks());
+}
+
+TEST(ThreadLocalFreeListTest, FreeListsArePerThread) {
+  drainFreeList();
+  auto object = std::make_unique<PooledObject>(1);
+  const size_t free_blocks = PooledObject::FreeList::freeBlocks();
+
+  // The storage moves to the free list of the thread that frees the object.
+  std::thread thread([&object]() {
+    EXPECT_EQ(0, PooledObject::FreeList::freeBlocks());
+    object.reset();
+    EXPECT_EQ(1, PooledObject::FreeList::freeBlocks());
+  });
+  thread.join();
+  EXPECT_EQ(free_blocks, PooledObject::FreeList::freeBlocks());
+}
+
+TEST(ThreadLocalFreeListTest, ReleaseAll) {
+  drainFreeList();
+  auto object1 = std::make_unique<PooledObject>(1);
+  auto object2 = std::make_unique<PooledObject>(2);
+  object1.reset();
+  EXPECT_EQ(1, PooledObject::FreeList::freeBlocks());
+
+  // The blocks kept before the request are released, and the list keeps recycling afterwards.
+  ThreadLocalFreeLists::releaseAll();
+  EXPECT_EQ(0, PooledObject::FreeList::freeBlocks());
+  object2.reset();
+  EXPECT_EQ(1, PooledObject::FreeList::freeBlocks());
+}
+#else
+TEST(ThreadLocalFreeListTest, SanitizerBuildsUseTheHeap) {
+  auto object = std::make_unique<PooledObject>(1);
+  object.reset();
+  EXPECT_EQ(0, PooledObject::FreeList::freeBlocks());
+}
+#endif
+
+} // namespace
+} // namespace Envoy
@@ -3,6 +3,9 @@
 
 #include "source/common/common/fine_grain_logger.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/logger_delegates.h"
+
+#include "test/test_common/thread_factory_for_test.h"
 
 #include "benchmark/benchmark.h"
 
@@ -111,6 +114,68 @@ static void envoyLevelSetting(benchmark::State& state) {
   }
 }
 
+/**
+ * A sink dropping the log lines, to measure the cost of logging up to the sink.
+ */
+class NullSinkDelegate : public Logger::SinkDelegate {
+public:
+  explicit NullSinkDelegate(Logger::DelegatingLogSinkSharedPtr log_sink) : SinkDelegate(log_sink) {
+    setDelegate();
+  }
+  ~NullSinkDelegate() override { restoreDelegate(); }
+
+  // SinkDelegate
+  void log(absl::string_view, const spdlog::details::log_msg&) override {}
+  void flush() override {}
+};
+
+// The sinks are stacked on first use and never unstacked, as the benchmarks run in turn.
+static void stackNullSink() {
+  static NullSinkDelegate* sink = new NullSinkDelegate(Logger::Registry::getSink());
+  UNREFERENCED_PARAMETER(sink);
+}
+
+static Logger::AsyncSinkDelegate& asyncSink() {
+  stackNullSink();
+  static Logger::AsyncSinkDelegate* sink = new Logger::AsyncSinkDelegate(
+      1 << 20, Thread::threadFactoryForTest(), Logger::Registry::getSink());
+  return *sink;
+}
+
+/**
+ * Benchmark for ENVOY_LOG writing synchronously to a sink dropping the lines.
+ */
+static void envoySyncSink(benchmark::State& state) {
+  stackNullSink();
+  std::string msg(100, '.');
+  GET_MISC_LOGGER().set_level(spdlog::level::info);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int i = 0; i < state.range(0); i++) {
+      ENVOY_LOG_MISC(info, "Sink: {}", msg);
+    }
+  }
+}
+
+/**
+ * Benchmark for ENVOY_LOG handing the lines over to the writer thread of an AsyncSinkDelegate,
+ * which writes them to the same sink. The threads only contend when their buffer is full.
+ */
+static void envoyAsyncSink(benchmark::State& state) {
+  Logger::AsyncSinkDelegate& sink = asyncSink();
+  std::string msg(100, '.');
+  GET_MISC_LOGGER().set_level(spdlog::level::info);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int i = 0; i < state.range(0); i++) {
+      ENVOY_LOG_MISC(info, "Sink: {}", msg);
+    }
+  }
+  if (state.thread_index() == 0) {
+    state.counters["dropped"] = sink.droppedMessages();
+  }
+}
+
 /**
  * Benchmarks in detail starts.
  */
@@ -136,4 +201,10 @@ BENCHMARK(envoyNormal)->Args({1 << 10, 1})->Threads(200)->MeasureProcessCPUTime(
 BENCHMARK(fineGrainLogLevelSetting)->Arg(1 << 10);
 BENCHMARK(envoyLevelSetting)->Arg(1 << 10);
 
+// The synchronous sink goes first, as the asynchronous one stays stacked on it.
+BENCHMARK(envoySyncSink)->Arg(1 << 10);
+BENCHMARK(envoySyncSink)->Arg(1 << 10)->Threads(20)->MeasureProcessCPUTime();
+BENCHMARK(envoyAsyncSink)->Arg(1 << 10);
+BENCHMARK(envoyAsyncSink)->Arg(1 << 10)->Threads(20)->MeasureProcessCPUTime();
+
 } // namespace Envoy
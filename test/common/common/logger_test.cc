@@ -1,10 +1,15 @@
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "source/common/common/json_escape_string.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/logger_delegates.h"
 
 #include "test/test_common/environment.h"
+#include "test/test_common/thread_factory_for_test.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -269,6 +274,120 @@ TEST(LoggerTest, LogWithLogDetails) {
   ENVOY_LOG_MISC(info, "hello");
 }
 
+// Records the lines written by an AsyncSinkDelegate stacked on it, from its writer thread.
+class RecordingLogSink : public SinkDelegate {
+public:
+  explicit RecordingLogSink(DelegatingLogSinkSharedPtr log_sink) : SinkDelegate(log_sink) {
+    setDelegate();
+  }
+  ~RecordingLogSink() override { restoreDelegate(); }
+
+  void log(absl::string_view msg, const spdlog::details::log_msg& log_msg) override {
+    absl::MutexLock lock(&mutex_);
+    lines_.emplace_back(std::string(log_msg.logger_name.data(), log_msg.logger_name.size()),
+                        std::string(msg));
+  }
+  void flush() override {}
+
+  std::vector<std::pair<std::string, std::string>> lines() {
+    absl::MutexLock lock(&mutex_);
+    return lines_;
+  }
+
+private:
+  absl::Mutex mutex_;
+  std::vector<std::pair<std::string, std::string>> lines_ ABSL_GUARDED_BY(mutex_);
+};
+
+TEST(AsyncSinkDelegateTest, WritesTheLinesOfEachThreadInOrder) {
+  Envoy::Logger::Registry::setLogLevel(spdlog::level::info);
+  RecordingLogSink sink(Envoy::Logger::Registry::getSink());
+  constexpr int NumThreads = 4;
+  constexpr int NumLines = 100;
+  {
+    AsyncSinkDelegate async_sink(64 * 1024, Thread::threadFactoryForTest(),
+                                 Envoy::Logger::Registry::getSink());
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NumThreads; i++) {
+      threads.emplace_back([i]() {
+        for (int line = 0; line < NumLines; line++) {
+          ENVOY_LOG_MISC(info, "thread {} line {}", i, line);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    async_sink.flush();
+    EXPECT_EQ(0, async_sink.droppedMessages());
+  }
+
+  const auto lines = sink.lines();
+  ASSERT_EQ(NumThreads * NumLines, lines.size());
+  std::vector<int> next_line(NumThreads, 0);
+  for (const auto& [logger_name, msg] : lines) {
+    EXPECT_EQ("misc", logger_name);
+    int thread;
+    int line;
+    ASSERT_EQ(2, sscanf(msg.c_str() + msg.find("thread "), "thread %d line %d", &thread, &line));
+    EXPECT_EQ(next_line[thread]++, line);
+  }
+}
+
+TEST(AsyncSinkDelegateTest, DropsTheLinesThatDontFit) {
+  Envoy::Logger::Registry::setLogLevel(spdlog::level::info);
+  RecordingLogSink sink(Envoy::Logger::Registry::getSink());
+  constexpr int NumLines = 100;
+  uint64_t dropped;
+  {
+    // The writer thread doesn't write the lines before they are flushed.
+    AsyncSinkDelegate async_sink(1024, Thread::threadFactoryForTest(),
+                                 Envoy::Logger::Registry::getSink(), std::chrono::hours(1));
+    const std::string msg(100, '.');
+    for (int line = 0; line < NumLines; line++) {
+      ENVOY_LOG_MISC(info, "{}", msg);
+    }
+    dropped = async_sink.droppedMessages();
+    EXPECT_GT(dropped, 0);
+    async_sink.flush();
+    EXPECT_EQ(NumLines - dropped, sink.lines().size());
+
+    // The flush made room for more lines.
+    ENVOY_LOG_MISC(info, "after flush");
+    EXPECT_EQ(dropped, async_sink.droppedMessages());
+  }
+
+  // The remaining lines are written on destruction.
+  const auto lines = sink.lines();
+  ASSERT_EQ(NumLines - dropped + 1, lines.size());
+  EXPECT_THAT(lines.back().second, HasSubstr("after flush"));
+}
+
+TEST(AsyncSinkDelegateTest, WritesFineGrainLogs) {
+  RecordingLogSink sink(Envoy::Logger::Registry::getSink());
+  std::atomic<spdlog::logger*> logger{nullptr};
+  getFineGrainLogContext().initFineGrainLogger(__FILE__, logger);
+  getFineGrainLogContext().setFineGrainLogger(__FILE__, spdlog::level::info);
+  {
+    AsyncSinkDelegate async_sink(64 * 1024, Thread::threadFactoryForTest(),
+                                 Envoy::Logger::Registry::getSink());
+    FINE_GRAIN_LOG(info, "fine grain line");
+  }
+
+  const auto lines = sink.lines();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_EQ(__FILE__, lines[0].first);
+  EXPECT_THAT(lines[0].second, HasSubstr("fine grain line"));
+}
+
+TEST(AsyncSinkDelegateTest, PassesNamedLogsOnSynchronously) {
+  MockLogSink sink(Envoy::Logger::Registry::getSink());
+  AsyncSinkDelegate async_sink(64 * 1024, Thread::threadFactoryForTest(),
+                               Envoy::Logger::Registry::getSink());
+  EXPECT_CALL(sink, logWithStableName("foo", "level", "bar", "msg"));
+  Registry::getSink()->logWithStableName("foo", "level", "bar", "msg");
+}
+
 } // namespace
 } // namespace Logger
 } // namespace Envoy
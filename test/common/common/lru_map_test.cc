@@ -0,0 +1,109 @@
+#include <string>
+
+#include "source/common/common/lru_map.h"
+
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(LruMapTest, GetOrInsert) {
+  LruMap<std::string, int> map;
+  EXPECT_TRUE(map.empty());
+
+  auto [value, inserted] = map.getOrInsert("a");
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(0, *value);
+  *value = 1;
+
+  std::tie(value, inserted) = map.getOrInsert("a");
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(1, *value);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_FALSE(map.empty());
+}
+
+TEST(LruMapTest, Get) {
+  LruMap<std::string, int> map;
+  EXPECT_EQ(nullptr, map.get("a"));
+  *map.getOrInsert("a").first = 1;
+  ASSERT_NE(nullptr, map.get("a"));
+  EXPECT_EQ(1, *map.get("a"));
+}
+
+TEST(LruMapTest, LeastRecentlyUsed) {
+  LruMap<std::string, int> map;
+  *map.getOrInsert("a").first = 1;
+  *map.getOrInsert("b").first = 2;
+  *map.getOrInsert("c").first = 3;
+  EXPECT_EQ(1, map.leastRecentlyUsed());
+
+  // Both lookups and insertions make an entry the most recently used.
+  map.get("a");
+  EXPECT_EQ(2, map.leastRecentlyUsed());
+  map.getOrInsert("b");
+  EXPECT_EQ(3, map.leastRecentlyUsed());
+
+  map.eraseLeastRecentlyUsed();
+  EXPECT_EQ(nullptr, map.get("c"));
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(1, map.leastRecentlyUsed());
+  map.eraseLeastRecentlyUsed();
+  EXPECT_EQ(2, map.leastRecentlyUsed());
+  map.eraseLeastRecentlyUsed();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(LruMapTest, Erase) {
+  LruMap<std::string, int> map;
+  *map.getOrInsert("a").first = 1;
+  *map.getOrInsert("b").first = 2;
+  EXPECT_FALSE(map.erase("c"));
+  EXPECT_TRUE(map.erase("a"));
+  EXPECT_EQ(nullptr, map.get("a"));
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ(2, map.leastRecentlyUsed());
+
+  // An erased key can be inserted again.
+  EXPECT_TRUE(map.getOrInsert("a").second);
+  EXPECT_EQ(2, map.leastRecentlyUsed());
+}
+
+TEST(LruMapTest, Clear) {
+  LruMap<std::string, int> map;
+  map.getOrInsert("a");
+  map.getOrInsert("b");
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(nullptr, map.get("a"));
+  *map.getOrInsert("b").first = 2;
+  EXPECT_EQ(2, map.leastRecentlyUsed());
+}
+
+struct TransparentHash {
+  using is_transparent = void; // NOLINT(readability-identifier-naming)
+
+  size_t operator()(absl::string_view key) const { return absl::Hash<absl::string_view>()(key); }
+};
+
+struct TransparentEq {
+  using is_transparent = void; // NOLINT(readability-identifier-naming)
+
+  bool operator()(absl::string_view left, absl::string_view right) const { return left == right; }
+};
+
+TEST(LruMapTest, TransparentLookups) {
+  LruMap<std::string, int, TransparentHash, TransparentEq> map;
+  *map.getOrInsert(std::string("a")).first = 1;
+  *map.getOrInsert(std::string("b")).first = 2;
+  const absl::string_view key = "a";
+  ASSERT_NE(nullptr, map.get(key));
+  EXPECT_EQ(1, *map.get(key));
+  EXPECT_EQ(2, map.leastRecentlyUsed());
+  EXPECT_TRUE(map.erase(key));
+  EXPECT_EQ(1u, map.size());
+}
+
+} // namespace
+} // namespace Envoy
@@ -0,0 +1,134 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "source/common/common/mpsc_queue.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(MpscQueueTest, PushAndPopAll) {
+  MpscQueue<int> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.popAll().empty());
+
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_FALSE(queue.push(2));
+  EXPECT_FALSE(queue.push(3));
+  EXPECT_FALSE(queue.empty());
+  EXPECT_EQ(3, queue.size());
+
+  MpscQueue<int>::Batch batch = queue.popAll();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0, queue.size());
+  // Pushing after the values were taken wakes the consumer up again.
+  EXPECT_TRUE(queue.push(4));
+
+  std::vector<int> values;
+  while (!batch.empty()) {
+    values.push_back(batch.front());
+    batch.popFront();
+  }
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), values);
+  EXPECT_EQ(4, queue.popAll().front());
+}
+
+// Values are destroyed when popped, and when the batches or the queue holding them are destroyed.
+TEST(MpscQueueTest, DestroysValues) {
+  auto value = std::make_shared<int>(0);
+  {
+    MpscQueue<std::shared_ptr<int>> queue;
+    queue.push(value);
+    queue.push(value);
+    queue.push(value);
+    EXPECT_EQ(4, value.use_count());
+
+    MpscQueue<std::shared_ptr<int>>::Batch batch = queue.popAll();
+    batch.popFront();
+    EXPECT_EQ(3, value.use_count());
+
+    queue.push(value);
+    { MpscQueue<std::shared_ptr<int>>::Batch discarded = std::move(batch); }
+    EXPECT_EQ(2, value.use_count());
+  }
+  EXPECT_EQ(1, value.use_count());
+}
+
+// Values pushed by each producer are consumed in the order they were pushed.
+TEST(MpscQueueTest, ConcurrentProducers) {
+  constexpr uint32_t num_producers = 4;
+  constexpr uint32_t values_per_producer = 10000;
+  MpscQueue<std::pair<uint32_t, uint32_t>> queue;
+
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < num_producers; ++producer) {
+    producers.emplace_back([&queue, producer]() {
+      for (uint32_t i = 0; i < values_per_producer; ++i) {
+        queue.push({producer, i});
+      }
+    });
+  }
+
+  std::vector<uint32_t> next(num_producers, 0);
+  uint32_t consumed = 0;
+  while (consumed < num_producers * values_per_producer) {
+    MpscQueue<std::pair<uint32_t, uint32_t>>::Batch batch = queue.popAll();
+    while (!batch.empty()) {
+      const auto [producer, i] = batch.front();
+      EXPECT_EQ(next[producer]++, i);
+      ++consumed;
+      batch.popFront();
+    }
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+// Every value pushed while the consumer drains the queue concurrently is consumed, which takes a
+// wakeup each time push() reports that the queue was empty: a lost wakeup leaves values that are
+// never consumed, and the test then hangs.
+TEST(MpscQueueTest, ConcurrentProducersAndConsumer) {
+  constexpr uint32_t num_producers = 8;
+  constexpr uint32_t values_per_producer = 50000;
+  MpscQueue<uint32_t> queue;
+  std::atomic<uint32_t> wakeups{0};
+
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < num_producers; ++producer) {
+    producers.emplace_back([&queue, &wakeups]() {
+      for (uint32_t i = 0; i < values_per_producer; ++i) {
+        if (queue.push(i)) {
+          wakeups.fetch_add(1);
+        }
+      }
+    });
+  }
+
+  uint32_t consumed = 0;
+  uint32_t handled_wakeups = 0;
+  while (consumed < num_producers * values_per_producer) {
+    if (wakeups.load() == handled_wakeups) {
+      std::this_thread::yield();
+      continue;
+    }
+    ++handled_wakeups;
+    MpscQueue<uint32_t>::Batch batch = queue.popAll();
+    while (!batch.empty()) {
+      ++consumed;
+      batch.popFront();
+    }
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(num_producers * values_per_producer, consumed);
+  EXPECT_TRUE(queue.empty());
+}
+
+} // namespace
+} // namespace Envoy
@@ -4,6 +4,7 @@
 #include <regex>
 
 #include "source/common/common/assert.h"
+#include "source/common/common/regex.h"
 
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
@@ -126,3 +127,57 @@ static void BM_RE2_AltPattern(benchmark::State& state) {
   RELEASE_ASSERT(passes > 0, "");
 }
 BENCHMARK(BM_RE2_AltPattern);
+
+static const char ClusterFullMatchPattern[] = "cluster\\.match\\..*";
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_FullMatch(benchmark::State& state) {
+  re2::RE2 re(ClusterFullMatchPattern);
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const char* cluster_input : ClusterInputs) {
+      if (re2::RE2::FullMatch(cluster_input, re)) {
+        ++passes;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_FullMatch);
+
+// The same matches, rejecting the inputs that don't start with the literal prefix of the regex
+// without running it.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CompiledGoogleReMatcher(benchmark::State& state) {
+  Envoy::Regex::CompiledGoogleReMatcher matcher(ClusterFullMatchPattern, false);
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const char* cluster_input : ClusterInputs) {
+      if (matcher.match(cluster_input)) {
+        ++passes;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_CompiledGoogleReMatcher);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_Compile(benchmark::State& state) {
+  for (auto _ : state) { // NOLINT
+    re2::RE2 re(ClusterReAltPattern);
+    benchmark::DoNotOptimize(re.ok());
+  }
+}
+BENCHMARK(BM_RE2_Compile);
+
+// The construction of a matcher of a regex that another matcher already compiled.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CompiledGoogleReMatcherShared(benchmark::State& state) {
+  Envoy::Regex::CompiledGoogleReMatcher first(ClusterReAltPattern, false);
+  for (auto _ : state) { // NOLINT
+    Envoy::Regex::CompiledGoogleReMatcher matcher(ClusterReAltPattern, false);
+    benchmark::DoNotOptimize(&matcher.regex());
+  }
+}
+BENCHMARK(BM_CompiledGoogleReMatcherShared);
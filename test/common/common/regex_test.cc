@@ -154,6 +154,60 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(SharedRegexCache, IdenticalPatternsShareRegex) {
+  const size_t cached = SharedRegexCache::size();
+  {
+    CompiledGoogleReMatcher first("/shared/[a-z]+", false);
+    CompiledGoogleReMatcher second("/shared/[a-z]+", false);
+    CompiledGoogleReMatcher other("/other/[a-z]+", false);
+    EXPECT_EQ(&first.regex(), &second.regex());
+    EXPECT_NE(&first.regex(), &other.regex());
+    EXPECT_EQ(cached + 2, SharedRegexCache::size());
+  }
+  // The regexes leave the cache with their last matcher.
+  EXPECT_EQ(cached, SharedRegexCache::size());
+}
+
+TEST(SharedRegexCache, InvalidPatternIsNotCached) {
+  const size_t cached = SharedRegexCache::size();
+  EXPECT_THROW_WITH_MESSAGE(CompiledGoogleReMatcher("(+invalid)", false), EnvoyException,
+                            "no argument for repetition operator: +");
+  EXPECT_EQ(cached, SharedRegexCache::size());
+}
+
+TEST(SharedRegexCache, LiteralPrefix) {
+  EXPECT_EQ("/api/v1/", SharedRegexCache::get("/api/v1/.*")->literal_prefix_);
+  EXPECT_EQ("abc", SharedRegexCache::get("abc")->literal_prefix_);
+  EXPECT_EQ("", SharedRegexCache::get("foo|bar")->literal_prefix_);
+  EXPECT_EQ("", SharedRegexCache::get("(?i)abc")->literal_prefix_);
+  EXPECT_EQ("", SharedRegexCache::get(".*/api")->literal_prefix_);
+}
+
+TEST(CompiledGoogleReMatcher, MatchWithLiteralPrefix) {
+  {
+    CompiledGoogleReMatcher matcher("/api/v1/.*", false);
+    EXPECT_TRUE(matcher.match("/api/v1/"));
+    EXPECT_TRUE(matcher.match("/api/v1/foo"));
+    EXPECT_FALSE(matcher.match("/api/v2/foo"));
+    EXPECT_FALSE(matcher.match("/api"));
+    EXPECT_FALSE(matcher.match(""));
+  }
+
+  // The patterns without a literal prefix still match.
+  {
+    CompiledGoogleReMatcher matcher("(?i)/API/.*", false);
+    EXPECT_TRUE(matcher.match("/api/foo"));
+    EXPECT_TRUE(matcher.match("/Api/foo"));
+    EXPECT_FALSE(matcher.match("/apx/foo"));
+  }
+  {
+    CompiledGoogleReMatcher matcher("foo|bar", false);
+    EXPECT_TRUE(matcher.match("foo"));
+    EXPECT_TRUE(matcher.match("bar"));
+    EXPECT_FALSE(matcher.match("foobar"));
+  }
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
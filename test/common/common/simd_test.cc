@@ -0,0 +1,59 @@
+#include "source/common/common/simd.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Simd {
+namespace {
+
+struct TestImplementation {
+  int id_;
+  InstructionSet instruction_set_;
+};
+
+TEST(SimdTest, Supports) {
+  EXPECT_TRUE(supports(InstructionSet::Scalar));
+#if defined(ENVOY_SIMD_X86)
+  EXPECT_TRUE(supports(InstructionSet::Sse2));
+  EXPECT_FALSE(supports(InstructionSet::Neon));
+#elif defined(ENVOY_SIMD_NEON)
+  EXPECT_TRUE(supports(InstructionSet::Neon));
+  EXPECT_FALSE(supports(InstructionSet::Avx2));
+#else
+  EXPECT_FALSE(supports(InstructionSet::Sse2));
+  EXPECT_FALSE(supports(InstructionSet::Neon));
+#endif
+}
+
+TEST(SimdTest, Name) {
+  EXPECT_EQ("scalar", name(InstructionSet::Scalar));
+  EXPECT_EQ("sse2", name(InstructionSet::Sse2));
+  EXPECT_EQ("ssse3", name(InstructionSet::Ssse3));
+  EXPECT_EQ("avx2", name(InstructionSet::Avx2));
+  EXPECT_EQ("neon", name(InstructionSet::Neon));
+}
+
+TEST(SimdTest, Select) {
+  // The first supported candidate is selected, the scalar one if no other is.
+  const TestImplementation selected = select<TestImplementation>({
+      {1, InstructionSet::Avx2},
+      {2, InstructionSet::Sse2},
+      {3, InstructionSet::Neon},
+      {4, InstructionSet::Scalar},
+  });
+  if (supports(InstructionSet::Avx2)) {
+    EXPECT_EQ(1, selected.id_);
+  } else if (supports(InstructionSet::Sse2)) {
+    EXPECT_EQ(2, selected.id_);
+  } else if (supports(InstructionSet::Neon)) {
+    EXPECT_EQ(3, selected.id_);
+  } else {
+    EXPECT_EQ(4, selected.id_);
+  }
+
+  EXPECT_EQ(5, select<TestImplementation>({{5, InstructionSet::Scalar}}).id_);
+}
+
+} // namespace
+} // namespace Simd
+} // namespace Envoy
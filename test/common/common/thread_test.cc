@@ -1,5 +1,9 @@
 #include <functional>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "source/common/common/thread.h"
 #include "source/common/common/thread_synchronizer.h"
 
@@ -231,6 +235,25 @@ TEST_F(ThreadAsyncPtrTest, TruncateNoWait) {
   thread->join();
 }
 
+#ifdef __linux__
+TEST_F(ThreadAsyncPtrTest, CpuAffinity) {
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  uint32_t cpu = CPU_SETSIZE;
+  while (!CPU_ISSET(--cpu, &allowed)) {
+  }
+
+  cpu_set_t thread_cpus;
+  CPU_ZERO(&thread_cpus);
+  auto thread = thread_factory_.createThread(
+      [&thread_cpus]() { sched_getaffinity(0, sizeof(thread_cpus), &thread_cpus); },
+      Options{"affinity", {cpu}});
+  thread->join();
+  EXPECT_EQ(1, CPU_COUNT(&thread_cpus));
+  EXPECT_TRUE(CPU_ISSET(cpu, &thread_cpus));
+}
+#endif
+
 TEST_F(ThreadAsyncPtrTest, NameNotSpecifiedWait) {
   absl::Notification notify;
   auto thread = thread_factory_.createThread([&notify]() { notify.WaitForNotification(); });
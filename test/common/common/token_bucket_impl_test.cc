@@ -1,4 +1,7 @@
+#include <atomic>
 #include <chrono>
+#include <thread>
+#include <vector>
 
 #include "source/common/common/token_bucket_impl.h"
 
@@ -110,4 +113,92 @@ TEST_F(TokenBucketImplTest, ConsumeAndNextToken) {
   EXPECT_EQ(time_to_next_token, token_bucket.nextTokenAvailable());
 }
 
+class AtomicTokenBucketImplTest : public testing::Test {
+protected:
+  Event::SimulatedTimeSystem time_system_;
+};
+
+// Verifies that the bucket starts full, is capped at its maximum and refills at its fill rate.
+TEST_F(AtomicTokenBucketImplTest, ConsumeAndRefill) {
+  AtomicTokenBucketImpl token_bucket{10, time_system_, 5};
+  EXPECT_EQ(0, token_bucket.consume(11, false));
+  EXPECT_EQ(10, token_bucket.consume(11, true));
+  EXPECT_EQ(0, token_bucket.consume(1, true));
+  EXPECT_EQ(std::chrono::milliseconds(200), token_bucket.nextTokenAvailable());
+
+  time_system_.advanceTimeWait(std::chrono::milliseconds(600));
+  std::chrono::milliseconds time_to_next_token(0);
+  EXPECT_EQ(3, token_bucket.consume(5, true, time_to_next_token));
+  EXPECT_EQ(std::chrono::milliseconds(200), time_to_next_token);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(10, token_bucket.remainingTokens());
+  EXPECT_EQ(std::chrono::milliseconds(0), token_bucket.nextTokenAvailable());
+}
+
+// Only the first reset of a shared bucket is honoured.
+TEST_F(AtomicTokenBucketImplTest, ResetOnce) {
+  AtomicTokenBucketImpl token_bucket{16, time_system_, 16};
+  token_bucket.maybeReset(1);
+  token_bucket.maybeReset(16);
+  EXPECT_EQ(1, token_bucket.consume(2, true));
+  EXPECT_EQ(std::chrono::milliseconds(63), token_bucket.nextTokenAvailable());
+}
+
+TEST_F(AtomicTokenBucketImplTest, ReturnTokens) {
+  AtomicTokenBucketImpl token_bucket{10, time_system_, 1};
+  EXPECT_EQ(10, token_bucket.consume(10, false));
+  token_bucket.returnTokens(4);
+  EXPECT_EQ(4, token_bucket.consume(10, true));
+}
+
+TEST_F(AtomicTokenBucketImplTest, ZeroFillRate) {
+  AtomicTokenBucketImpl token_bucket{10, time_system_, 0};
+  EXPECT_EQ(0, token_bucket.consume(1, true));
+  EXPECT_EQ(std::chrono::milliseconds::max(), token_bucket.nextTokenAvailable());
+}
+
+// Consumes concurrently from several threads, which must not hand out more tokens than available.
+TEST_F(AtomicTokenBucketImplTest, ConcurrentConsume) {
+  AtomicTokenBucketImpl token_bucket{100000, time_system_, 1};
+  std::atomic<uint64_t> consumed{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 50000; j++) {
+        consumed += token_bucket.consume(1, false);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(100000, consumed);
+  EXPECT_EQ(0, token_bucket.consume(1, true));
+}
+
+// The tokens handed out are limited by the least specific bucket too, and the tokens it doesn't
+// match are returned to the more specific ones.
+TEST_F(AtomicTokenBucketImplTest, Hierarchical) {
+  auto connection = std::make_shared<AtomicTokenBucketImpl>(100, time_system_, 100);
+  auto route = std::make_shared<AtomicTokenBucketImpl>(40, time_system_, 40);
+  HierarchicalTokenBucketImpl token_bucket{{connection, route}, std::chrono::milliseconds(500)};
+  token_bucket.maybeReset(0);
+  EXPECT_EQ(50, connection->remainingTokens());
+  EXPECT_EQ(20, route->remainingTokens());
+
+  EXPECT_EQ(0, token_bucket.consume(30, false));
+  EXPECT_NEAR(50, connection->remainingTokens(), 0.001);
+  EXPECT_EQ(20, token_bucket.consume(30, true));
+  EXPECT_NEAR(30, connection->remainingTokens(), 0.001);
+  EXPECT_EQ(0, route->remainingTokens());
+  EXPECT_EQ(std::chrono::milliseconds(25), token_bucket.nextTokenAvailable());
+
+  // Another stream of the route, on another connection, takes from the route first.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(250));
+  EXPECT_EQ(10, route->consume(10, true));
+  EXPECT_EQ(0, token_bucket.consume(10, true));
+  EXPECT_NEAR(55, connection->remainingTokens(), 0.001);
+}
+
 } // namespace Envoy
@@ -0,0 +1,134 @@
+#include "envoy/config/endpoint/v3/endpoint.pb.h"
+#include "envoy/config/endpoint/v3/endpoint.pb.validate.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/opaque_resource_decoder_impl.h"
+#include "source/common/config/parallel_resource_decoder.h"
+#include "source/common/protobuf/message_validator_impl.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+class ParallelResourceDecoderTest : public testing::Test {
+protected:
+  void addResource(const std::string& name) {
+    envoy::config::endpoint::v3::ClusterLoadAssignment resource;
+    resource.set_cluster_name(name);
+    resources_.Add()->PackFrom(resource);
+  }
+
+  void addResources(int count) {
+    for (int i = 0; i < count; i++) {
+      addResource(absl::StrCat("cluster_", resources_.size()));
+    }
+  }
+
+  ProtobufMessage::StrictValidationVisitorImpl validation_visitor_;
+  OpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment> resource_decoder_{
+      validation_visitor_, "cluster_name"};
+  ParallelResourceDecoder decoder_{Thread::threadFactoryForTest(), 3};
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources_;
+};
+
+// Verifies that the resources are returned in order, whether they are decoded by several threads
+// or only by the calling one.
+TEST_F(ParallelResourceDecoderTest, DecodesInOrder) {
+  for (int count : {ParallelResourceDecoder::MinParallelResources - 1, 1000}) {
+    resources_.Clear();
+    addResources(count / 2);
+    envoy::service::discovery::v3::Resource wrapper;
+    wrapper.set_name("wrapped");
+    envoy::config::endpoint::v3::ClusterLoadAssignment wrapped;
+    wrapped.set_cluster_name("inner");
+    wrapper.mutable_resource()->PackFrom(wrapped);
+    resources_.Add()->PackFrom(wrapper);
+    addResources(count - count / 2 - 1);
+
+    std::vector<DecodedResourceImplPtr> decoded =
+        decoder_.decode(resource_decoder_, resources_, "1");
+    ASSERT_EQ(count, decoded.size());
+    for (int i = 0; i < count; i++) {
+      EXPECT_EQ(i == count / 2 ? "wrapped" : absl::StrCat("cluster_", i), decoded[i]->name());
+      EXPECT_EQ("1", decoded[i]->version());
+    }
+  }
+}
+
+// Verifies that the resources are hashed by the threads when the decoder asks for it.
+TEST_F(ParallelResourceDecoderTest, HashesResources) {
+  addResources(100);
+  std::vector<DecodedResourceImplPtr> decoded =
+      decoder_.decode(resource_decoder_, resources_, "1");
+  EXPECT_FALSE(decoded[0]->resourceHash().has_value());
+
+  OpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment> hashing_decoder{
+      validation_visitor_, "cluster_name", true};
+  decoded = decoder_.decode(hashing_decoder, resources_, "1");
+  for (const DecodedResourceImplPtr& resource : decoded) {
+    EXPECT_EQ(MessageUtil::hash(resource->resource()), resource->resourceHash());
+  }
+}
+
+// Verifies that the error of the first resource that can't be decoded is thrown.
+TEST_F(ParallelResourceDecoderTest, ThrowsFirstError) {
+  addResources(100);
+  resources_.Add()->set_type_url("huh");
+  addResources(100);
+  // Fails the type constraints.
+  addResource("");
+  EXPECT_THROW_WITH_REGEX(decoder_.decode(resource_decoder_, resources_, "1"), EnvoyException,
+                          "Unable to unpack");
+
+  // The decoder is still usable.
+  resources_.DeleteSubrange(100, 1);
+  EXPECT_THROW(decoder_.decode(resource_decoder_, resources_, "1"), ProtoValidationException);
+}
+
+// Verifies that the validation visitor still checks the resources decoded by the threads.
+TEST_F(ParallelResourceDecoderTest, VisitsResources) {
+  addResources(100);
+  envoy::config::endpoint::v3::ClusterLoadAssignment strange_resource;
+  strange_resource.set_cluster_name("strange");
+  strange_resource.GetReflection()->MutableUnknownFields(&strange_resource)->AddFixed32(1000, 1);
+  resources_.Add()->PackFrom(strange_resource);
+  EXPECT_THROW_WITH_REGEX(decoder_.decode(resource_decoder_, resources_, "1"), EnvoyException,
+                          "unknown fields");
+}
+
+// Verifies that the resources of decoders which don't support decoding off the main thread are
+// decoded by the calling thread.
+TEST_F(ParallelResourceDecoderTest, DecoderWithoutSupport) {
+  class MainThreadDecoder : public OpaqueResourceDecoder {
+  public:
+    MainThreadDecoder(OpaqueResourceDecoder& parent) : parent_(parent) {}
+
+    ProtobufTypes::MessagePtr decodeResource(const ProtobufWkt::Any& resource) override {
+      decoded_++;
+      return parent_.decodeResource(resource);
+    }
+    std::string resourceName(const Protobuf::Message& resource) override {
+      return parent_.resourceName(resource);
+    }
+
+    OpaqueResourceDecoder& parent_;
+    int decoded_{0};
+  };
+
+  addResources(100);
+  MainThreadDecoder resource_decoder(resource_decoder_);
+  std::vector<DecodedResourceImplPtr> decoded =
+      decoder_.decode(resource_decoder, resources_, "1");
+  EXPECT_EQ(100, resource_decoder.decoded_);
+  ASSERT_EQ(100, decoded.size());
+  EXPECT_EQ("cluster_99", decoded[99]->name());
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
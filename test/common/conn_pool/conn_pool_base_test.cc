@@ -16,6 +16,7 @@ using testing::AnyNumber;
 using testing::HasSubstr;
 using testing::Invoke;
 using testing::InvokeWithoutArgs;
+using testing::Ref;
 using testing::Return;
 
 class TestActiveClient : public ActiveClient {
@@ -671,5 +672,62 @@ TEST_F(ConnPoolImplDispatcherBaseTest, PoolDrainsWithEarlyDataStreams) {
   closeStream();
 }
 
+// Pending streams are attached earliest deadline first, and streams with no deadline last.
+TEST_F(ConnPoolImplDispatcherBaseTest, PendingStreamsServedByDeadline) {
+  concurrent_streams_ = 4;
+  const MonotonicTime now = dispatcher_->timeSource().monotonicTime();
+  AttachContext contexts[4];
+
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(contexts[0], false, now + std::chrono::seconds(3));
+  pool_.newStreamImpl(contexts[1], false, now + std::chrono::seconds(1));
+  pool_.newStreamImpl(contexts[2], false);
+  pool_.newStreamImpl(contexts[3], false, now + std::chrono::seconds(2));
+  ASSERT_EQ(1, clients_.size());
+  CHECK_STATE(0 /*active*/, 4 /*pending*/, 4 /*connecting capacity*/);
+
+  std::vector<AttachContext*> attached;
+  EXPECT_CALL(pool_, onPoolReady)
+      .Times(4)
+      .WillRepeatedly(Invoke([&](ActiveClient& client, AttachContext& context) {
+        TestActiveClient::incrementActiveStreams(client);
+        attached.push_back(&context);
+      }));
+  clients_.back()->onEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(std::vector<AttachContext*>({&contexts[1], &contexts[3], &contexts[0], &contexts[2]}),
+            attached);
+
+  // Clean up.
+  closeStreamAndDrainClient();
+}
+
+// Streams past their deadline are failed rather than queued or attached.
+TEST_F(ConnPoolImplDispatcherBaseTest, PendingStreamsShedPastDeadline) {
+  concurrent_streams_ = 2;
+  const MonotonicTime now = dispatcher_->timeSource().monotonicTime();
+  AttachContext contexts[3];
+
+  EXPECT_CALL(pool_, onPoolFailure(_, "deadline exceeded", PoolFailureReason::Overflow,
+                                   Ref(contexts[0])));
+  EXPECT_EQ(nullptr, pool_.newStreamImpl(contexts[0], false, now));
+  EXPECT_TRUE(clients_.empty());
+
+  EXPECT_CALL(pool_, instantiateActiveClient);
+  pool_.newStreamImpl(contexts[1], false, now + std::chrono::seconds(1));
+  pool_.newStreamImpl(contexts[2], false, now + std::chrono::seconds(5));
+  CHECK_STATE(0 /*active*/, 2 /*pending*/, 2 /*connecting capacity*/);
+
+  time_system_.setMonotonicTime(now + std::chrono::seconds(2));
+  EXPECT_CALL(pool_, onPoolFailure(_, "deadline exceeded", PoolFailureReason::Overflow,
+                                   Ref(contexts[1])));
+  EXPECT_CALL(pool_, onPoolReady(_, Ref(contexts[2])));
+  clients_.back()->onEvent(Network::ConnectionEvent::Connected);
+  CHECK_STATE(1 /*active*/, 0 /*pending*/, 1 /*connecting capacity*/);
+  EXPECT_EQ(2U, cluster_->traffic_stats_->upstream_rq_pending_shed_.value());
+
+  // Clean up.
+  closeStreamAndDrainClient();
+}
+
 } // namespace ConnectionPool
 } // namespace Envoy
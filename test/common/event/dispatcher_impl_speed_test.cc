@@ -0,0 +1,56 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <vector>
+
+#include "source/common/api/api_impl.h"
+#include "source/common/event/dispatcher_impl.h"
+
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+// Posts callbacks to a dispatcher from state.range(0) threads while the dispatcher runs them, with
+// the post queue selected by state.range(1): the mutex protected list (0) or the lock-free queue
+// (1).
+void bmCrossThreadPost(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.restart_features.lock_free_dispatcher_post",
+                               state.range(1) ? "true" : "false"}});
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+
+  const uint32_t num_producers = state.range(0);
+  constexpr uint32_t posts_per_producer = 1000;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    uint32_t ran = 0;
+    std::vector<Thread::ThreadPtr> producers;
+    for (uint32_t i = 0; i < num_producers; ++i) {
+      producers.push_back(api->threadFactory().createThread([&dispatcher, &ran]() {
+        for (uint32_t j = 0; j < posts_per_producer; ++j) {
+          dispatcher->post([&ran]() { ++ran; });
+        }
+      }));
+    }
+    while (ran < num_producers * posts_per_producer) {
+      dispatcher->run(Dispatcher::RunType::NonBlock);
+    }
+    for (Thread::ThreadPtr& producer : producers) {
+      producer->join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_producers * posts_per_producer);
+}
+BENCHMARK(bmCrossThreadPost)
+    ->ArgsProduct({{1, 4, 16}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -21,16 +21,19 @@
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::AnyNumber;
 using testing::ByMove;
 using testing::InSequence;
 using testing::MockFunction;
 using testing::NiceMock;
+using testing::Property;
 using testing::Return;
 
 namespace Envoy {
@@ -386,10 +389,18 @@ protected:
 // TODO(mergeconflict): We also need integration testing to validate that the expected histograms
 // are written when `enable_dispatcher_stats` is true. See issue #6582.
 TEST_F(DispatcherImplTest, InitializeStats) {
+  EXPECT_CALL(store_, histogram("test.dispatcher.deferred_delete_duration_us",
+                                Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_, histogram("test.dispatcher.file_event_duration_us",
+                                Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.loop_duration_us", Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.poll_delay_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_, histogram("test.dispatcher.post_callback_duration_us",
+                                Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.timer_duration_us", Stats::Histogram::Unit::Microseconds));
   dispatcher_->initializeStats(scope_, "test.");
 }
 
@@ -589,6 +600,77 @@ TEST_F(DispatcherShutdownTest, DestroyClearAllList) {
   }
 }
 
+class LockFreePostDispatcherTest : public testing::Test {
+protected:
+  LockFreePostDispatcherTest() : api_(Api::createApiForTest()) {
+    scoped_runtime_.mergeValues({{"envoy.restart_features.lock_free_dispatcher_post", "true"}});
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+  }
+
+  TestScopedRuntime scoped_runtime_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+// Callbacks posted from several threads all run, in the order each thread posted them.
+TEST_F(LockFreePostDispatcherTest, PostFromThreads) {
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t num_posts = 1000;
+  std::vector<std::vector<uint32_t>> runs(num_threads);
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    threads.push_back(api_->threadFactory().createThread([this, &runs, t]() {
+      for (uint32_t i = 0; i < num_posts; ++i) {
+        dispatcher_->post([&runs, t, i]() { runs[t].push_back(i); });
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    ASSERT_EQ(num_posts, runs[t].size());
+    for (uint32_t i = 0; i < num_posts; ++i) {
+      EXPECT_EQ(i, runs[t][i]);
+    }
+  }
+}
+
+// Each callback is destroyed before the next one runs, and pending callbacks are destroyed with
+// the dispatcher.
+TEST_F(LockFreePostDispatcherTest, PostExecuteAndDestructOrder) {
+  ReadyWatcher run_watcher1;
+  ReadyWatcher delete_watcher1;
+  ReadyWatcher run_watcher2;
+  ReadyWatcher delete_watcher2;
+  ReadyWatcher delete_watcher3;
+
+  InSequence s;
+  EXPECT_CALL(run_watcher1, ready());
+  EXPECT_CALL(delete_watcher1, ready());
+  EXPECT_CALL(run_watcher2, ready());
+  EXPECT_CALL(delete_watcher2, ready());
+  auto on_delete_task1 =
+      std::make_shared<RunOnDelete>([&delete_watcher1]() { delete_watcher1.ready(); });
+  dispatcher_->post([&run_watcher1, on_delete_task1]() { run_watcher1.ready(); });
+  auto on_delete_task2 =
+      std::make_shared<RunOnDelete>([&delete_watcher2]() { delete_watcher2.ready(); });
+  dispatcher_->post([&run_watcher2, on_delete_task2]() { run_watcher2.ready(); });
+  on_delete_task1.reset();
+  on_delete_task2.reset();
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+
+  auto on_delete_task3 =
+      std::make_shared<RunOnDelete>([&delete_watcher3]() { delete_watcher3.ready(); });
+  dispatcher_->post([on_delete_task3]() {});
+  on_delete_task3.reset();
+  EXPECT_CALL(delete_watcher3, ready());
+  dispatcher_->shutdown();
+  dispatcher_.reset();
+}
+
 TEST_F(DispatcherImplTest, Timer) {
   timerTest([](Timer& timer) { timer.enableTimer(std::chrono::milliseconds(0)); });
   timerTest([](Timer& timer) { timer.enableTimer(std::chrono::milliseconds(50)); });
@@ -1553,6 +1635,120 @@ TEST_F(DispatcherWithWatchdogTest, TouchBeforeFdEvent) {
   dispatcher_->run(Dispatcher::RunType::NonBlock);
 }
 
+class DispatcherCallbackStatsTest : public testing::Test {
+protected:
+  DispatcherCallbackStatsTest()
+      : api_(Api::createApiForTest(time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")) {
+    EXPECT_CALL(stats_store_, deliverHistogramToSinks(_, _)).Times(AnyNumber());
+    dispatcher_->initializeStats(*stats_store_.rootScope(), "test.");
+    // The stats are initialized on the dispatcher thread.
+    dispatcher_->run(Dispatcher::RunType::NonBlock);
+  }
+
+  void expectDuration(const std::string& name, std::chrono::microseconds duration) {
+    EXPECT_CALL(stats_store_, deliverHistogramToSinks(
+                                  Property(&Stats::Metric::name, "test.dispatcher." + name),
+                                  duration.count()));
+  }
+
+  std::vector<SlowCallback> slowCallbacks() {
+    std::vector<SlowCallback> callbacks;
+    SlowCallbackRegistry::get().forEach([&callbacks](SlowCallbackTracker& tracker) {
+      if (tracker.name() == "test.dispatcher") {
+        callbacks = tracker.slowest();
+      }
+    });
+    return callbacks;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Stats::MockIsolatedStatsStore> stats_store_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+// Each kind of callback is recorded in its own histogram.
+TEST_F(DispatcherCallbackStatsTest, DurationPerCategory) {
+  expectDuration("post_callback_duration_us", std::chrono::milliseconds(5));
+  dispatcher_->post([this]() { time_system_.advanceTimeAsync(std::chrono::milliseconds(5)); });
+
+  expectDuration("post_callback_duration_us", std::chrono::milliseconds(4));
+  auto schedulable_cb = dispatcher_->createSchedulableCallback(
+      [this]() { time_system_.advanceTimeAsync(std::chrono::milliseconds(4)); });
+  schedulable_cb->scheduleCallbackCurrentIteration();
+
+  expectDuration("timer_duration_us", std::chrono::milliseconds(3));
+  auto timer = dispatcher_->createTimer(
+      [this]() { time_system_.advanceTimeAsync(std::chrono::milliseconds(3)); });
+  timer->enableTimer(std::chrono::milliseconds(0));
+
+  expectDuration("deferred_delete_duration_us", std::chrono::milliseconds(2));
+  DeferredTaskUtil::deferredRun(
+      *dispatcher_, [this]() { time_system_.advanceTimeAsync(std::chrono::milliseconds(2)); });
+
+  expectDuration("file_event_duration_us", std::chrono::milliseconds(1));
+  os_fd_t fd = Api::OsSysCallsSingleton::get().socket(AF_INET6, SOCK_DGRAM, 0).return_value_;
+  ASSERT_TRUE(SOCKET_VALID(fd));
+  Event::FileEventPtr file_event = dispatcher_->createFileEvent(
+      fd, [this](uint32_t) { time_system_.advanceTimeAsync(std::chrono::milliseconds(1)); },
+      Event::PlatformDefaultTriggerType, FileReadyType::Read);
+  file_event->activate(FileReadyType::Read);
+
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  file_event.reset();
+  Api::OsSysCallsSingleton::get().close(fd);
+
+  const std::vector<SlowCallback> callbacks = slowCallbacks();
+  ASSERT_EQ(5, callbacks.size());
+  EXPECT_EQ(CallbackCategory::PostCallback, callbacks[0].category_);
+  EXPECT_EQ(std::chrono::milliseconds(5), callbacks[0].duration_);
+  EXPECT_EQ(CallbackCategory::FileEvent, callbacks[4].category_);
+  EXPECT_EQ(std::chrono::milliseconds(1), callbacks[4].duration_);
+}
+
+// Callbacks run from a measured callback are accounted for in the outer one.
+TEST_F(DispatcherCallbackStatsTest, NestedCallbacks) {
+  expectDuration("timer_duration_us", std::chrono::milliseconds(3));
+  auto timer = dispatcher_->createTimer([this]() {
+    time_system_.advanceTimeAsync(std::chrono::milliseconds(1));
+    DeferredTaskUtil::deferredRun(
+        *dispatcher_, [this]() { time_system_.advanceTimeAsync(std::chrono::milliseconds(2)); });
+    dispatcher_->clearDeferredDeleteList();
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+
+  const std::vector<SlowCallback> callbacks = slowCallbacks();
+  ASSERT_EQ(1, callbacks.size());
+  EXPECT_EQ(CallbackCategory::Timer, callbacks[0].category_);
+}
+
+// Slow callbacks are listed with the state of their outermost tracked object.
+TEST_F(DispatcherCallbackStatsTest, SlowCallbackContext) {
+  MessageTrackedObject outer("outer");
+  MessageTrackedObject inner("inner");
+  dispatcher_->post([&]() {
+    ScopeTrackerScopeState outer_scope(&outer, *dispatcher_);
+    {
+      ScopeTrackerScopeState inner_scope(&inner, *dispatcher_);
+    }
+    time_system_.advanceTimeAsync(std::chrono::milliseconds(5));
+  });
+  dispatcher_->post([]() {});
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+
+  const std::vector<SlowCallback> callbacks = slowCallbacks();
+  ASSERT_EQ(2, callbacks.size());
+  EXPECT_EQ(std::chrono::milliseconds(5), callbacks[0].duration_);
+  EXPECT_EQ("outer", callbacks[0].context_);
+  EXPECT_EQ("", callbacks[1].context_);
+
+  // The slow callbacks of a dispatcher are dropped along with it.
+  dispatcher_.reset();
+  EXPECT_TRUE(slowCallbacks().empty());
+}
+
 class DispatcherConnectionTest : public testing::Test {
 protected:
   DispatcherConnectionTest()
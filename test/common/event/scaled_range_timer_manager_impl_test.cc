@@ -9,6 +9,7 @@
 #include "test/mocks/common.h"
 #include "test/mocks/event/wrapped_dispatcher.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -706,6 +707,71 @@ TEST_F(ScaledRangeTimerManagerTest, LooksUpConfiguredMinimums) {
   }
 }
 
+class ScaledRangeTimerManagerWheelTest : public ScaledRangeTimerManagerTest {
+public:
+  ScaledRangeTimerManagerWheelTest() {
+    scoped_runtime_.mergeValues({{"envoy.restart_features.scaled_timer_wheel", "true"}});
+  }
+
+  TestScopedRuntime scoped_runtime_;
+};
+
+// The min durations tracked by the timer wheel are followed by the scaled part of the durations.
+TEST_F(ScaledRangeTimerManagerWheelTest, MultipleTimersWithScaling) {
+  ScaledRangeTimerManagerImpl manager(dispatcher_);
+  const MonotonicTime start = simTime().monotonicTime();
+
+  std::vector<TrackedRangeTimer> timers;
+  timers.reserve(3);
+  timers.emplace_back(AbsoluteMinimum(std::chrono::seconds(5)), manager, simTime());
+  timers.emplace_back(AbsoluteMinimum(std::chrono::seconds(10)), manager, simTime());
+  timers.emplace_back(ScaledMinimum(UnitFloat(1.0)), manager, simTime());
+
+  timers[0].timer->enableTimer(std::chrono::seconds(15));
+  timers[1].timer->enableTimer(std::chrono::seconds(30));
+  timers[2].timer->enableTimer(std::chrono::milliseconds(1500));
+  manager.setScaleFactor(UnitFloat(0.5));
+
+  for (int i = 0; i < 30; ++i) {
+    simTime().advanceTimeAndRun(std::chrono::seconds(1), dispatcher_, Dispatcher::RunType::Block);
+  }
+
+  // The fire times are 0: start+5+5, 1: start+10+10, 2: start+1.5, which the 1s steps round up.
+  EXPECT_THAT(*timers[0].trigger_times, ElementsAre(start + std::chrono::seconds(10)));
+  EXPECT_THAT(*timers[1].trigger_times, ElementsAre(start + std::chrono::seconds(20)));
+  EXPECT_THAT(*timers[2].trigger_times, ElementsAre(start + std::chrono::seconds(2)));
+}
+
+TEST_F(ScaledRangeTimerManagerWheelTest, DisableWhileWaitingForMin) {
+  ScaledRangeTimerManagerImpl manager(dispatcher_);
+
+  MockFunction<TimerCb> callback;
+  auto timer =
+      manager.createTimer(AbsoluteMinimum(std::chrono::seconds(10)), callback.AsStdFunction());
+  timer->enableTimer(std::chrono::seconds(100));
+  EXPECT_TRUE(timer->enabled());
+
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+  simTime().advanceTimeAndRun(std::chrono::seconds(100), dispatcher_, Dispatcher::RunType::Block);
+}
+
+TEST_F(ScaledRangeTimerManagerWheelTest, ScopeDuringCallback) {
+  ScaledRangeTimerManagerImpl manager(dispatcher_);
+  MockScopeTrackedObject scope;
+
+  MockFunction<TimerCb> callback;
+  auto timer =
+      manager.createTimer(AbsoluteMinimum(std::chrono::seconds(1)), callback.AsStdFunction());
+  EXPECT_CALL(callback, Call).WillOnce([&] { EXPECT_EQ(dispatcher_.scope_, &scope); });
+
+  timer->enableTimer(std::chrono::seconds(2), &scope);
+  simTime().advanceTimeAndRun(std::chrono::seconds(1), dispatcher_, Dispatcher::RunType::Block);
+  simTime().advanceTimeAndRun(std::chrono::seconds(1), dispatcher_, Dispatcher::RunType::Block);
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(dispatcher_.scope_, nullptr);
+}
+
 } // namespace
 } // namespace Event
 } // namespace Envoy
@@ -0,0 +1,78 @@
+#include "source/common/event/slow_callback_tracker.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+std::vector<int64_t> durations(const SlowCallbackTracker& tracker) {
+  std::vector<int64_t> result;
+  for (const SlowCallback& callback : tracker.slowest()) {
+    result.push_back(callback.duration_.count());
+  }
+  return result;
+}
+
+TEST(SlowCallbackTrackerTest, KeepsSlowest) {
+  SlowCallbackTracker tracker("test");
+  EXPECT_TRUE(tracker.isSlow(std::chrono::microseconds(0)));
+  for (int64_t i = 1; i <= 20; ++i) {
+    // Interleave fast and slow callbacks.
+    const int64_t duration = i % 2 == 0 ? i : 100 - i;
+    tracker.record(CallbackCategory::Timer, std::chrono::microseconds(duration), "");
+  }
+  EXPECT_EQ(std::vector<int64_t>({99, 97, 95, 93, 91, 89, 87, 85, 83, 81}), durations(tracker));
+
+  // Only callbacks slower than the fastest one kept are recorded.
+  EXPECT_FALSE(tracker.isSlow(std::chrono::microseconds(81)));
+  EXPECT_TRUE(tracker.isSlow(std::chrono::microseconds(82)));
+  tracker.record(CallbackCategory::Timer, std::chrono::microseconds(50), "");
+  tracker.record(CallbackCategory::FileEvent, std::chrono::microseconds(90), "context");
+  EXPECT_EQ(std::vector<int64_t>({99, 97, 95, 93, 91, 90, 89, 87, 85, 83}), durations(tracker));
+  const SlowCallback callback = tracker.slowest()[5];
+  EXPECT_EQ(CallbackCategory::FileEvent, callback.category_);
+  EXPECT_EQ("context", callback.context_);
+
+  tracker.clear();
+  EXPECT_TRUE(tracker.slowest().empty());
+  EXPECT_TRUE(tracker.isSlow(std::chrono::microseconds(0)));
+}
+
+TEST(SlowCallbackTrackerTest, TruncatesContext) {
+  SlowCallbackTracker tracker("test");
+  tracker.record(CallbackCategory::PostCallback, std::chrono::microseconds(1),
+                 std::string(SlowCallbackTracker::MaxContextLength + 1, 'a'));
+  EXPECT_EQ(std::string(SlowCallbackTracker::MaxContextLength, 'a'),
+            tracker.slowest()[0].context_);
+}
+
+TEST(SlowCallbackTrackerTest, CategoryNames) {
+  EXPECT_EQ("file_event", callbackCategoryName(CallbackCategory::FileEvent));
+  EXPECT_EQ("timer", callbackCategoryName(CallbackCategory::Timer));
+  EXPECT_EQ("post_callback", callbackCategoryName(CallbackCategory::PostCallback));
+  EXPECT_EQ("deferred_delete", callbackCategoryName(CallbackCategory::DeferredDelete));
+}
+
+TEST(SlowCallbackRegistryTest, SortedByName) {
+  SlowCallbackTracker worker("worker_0.dispatcher");
+  SlowCallbackTracker main("server.dispatcher");
+  SlowCallbackRegistry::get().add(worker);
+  SlowCallbackRegistry::get().add(main);
+
+  std::vector<std::string> names;
+  SlowCallbackRegistry::get().forEach(
+      [&names](SlowCallbackTracker& tracker) { names.push_back(tracker.name()); });
+  EXPECT_EQ(std::vector<std::string>({"server.dispatcher", "worker_0.dispatcher"}), names);
+
+  SlowCallbackRegistry::get().remove(worker);
+  SlowCallbackRegistry::get().remove(main);
+  names.clear();
+  SlowCallbackRegistry::get().forEach(
+      [&names](SlowCallbackTracker& tracker) { names.push_back(tracker.name()); });
+  EXPECT_TRUE(names.empty());
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
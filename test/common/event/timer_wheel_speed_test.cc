@@ -0,0 +1,62 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "source/common/api/api_impl.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/timer_wheel.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+// Enables state.range(0) timers with idle-timeout like durations, then re-enables each of them as
+// on connection activity, and finally disables them. The timers are those of the dispatcher (0)
+// or of a timer wheel (1).
+void bmEnableTimers(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  TimerWheel wheel(*dispatcher);
+
+  const uint32_t num_timers = state.range(0);
+  const bool use_wheel = state.range(1);
+  std::vector<TimerPtr> timers;
+  timers.reserve(num_timers);
+  for (uint32_t i = 0; i < num_timers; ++i) {
+    timers.push_back(use_wheel ? wheel.createTimer([]() {}) : dispatcher->createTimer([]() {}));
+  }
+  std::mt19937 random(42);
+  std::vector<std::chrono::milliseconds> durations;
+  durations.reserve(num_timers);
+  for (uint32_t i = 0; i < num_timers; ++i) {
+    durations.push_back(std::chrono::milliseconds(60000 + random() % 240000));
+  }
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    for (uint32_t i = 0; i < num_timers; ++i) {
+      timers[i]->enableTimer(durations[i]);
+    }
+    for (uint32_t i = 0; i < num_timers; ++i) {
+      timers[i]->enableTimer(durations[num_timers - 1 - i]);
+    }
+    for (uint32_t i = 0; i < num_timers; ++i) {
+      timers[i]->disableTimer();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_timers * 3);
+  timers.clear();
+}
+BENCHMARK(bmEnableTimers)
+    ->ArgsProduct({{10000, 100000, 1000000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,192 @@
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/timer_wheel.h"
+
+#include "test/mocks/common.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::MockFunction;
+
+class TimerWheelTest : public testing::Test {
+protected:
+  TimerWheelTest()
+      : api_(Api::createApiForTest(time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")), wheel_(*dispatcher_),
+        start_(time_system_.monotonicTime()) {}
+
+  void advance(std::chrono::milliseconds duration) {
+    time_system_.advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  std::chrono::milliseconds elapsed() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time_system_.monotonicTime() -
+                                                                 start_);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  TimerWheel wheel_;
+  const MonotonicTime start_;
+};
+
+TEST_F(TimerWheelTest, EnableAndFire) {
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_.createTimer(callback.AsStdFunction());
+  EXPECT_FALSE(timer->enabled());
+
+  timer->enableTimer(std::chrono::milliseconds(10));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_EQ(1, wheel_.size());
+  advance(std::chrono::milliseconds(9));
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, wheel_.size());
+}
+
+TEST_F(TimerWheelTest, Disable) {
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_.createTimer(callback.AsStdFunction());
+  timer->enableTimer(std::chrono::milliseconds(10));
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, wheel_.size());
+  advance(std::chrono::milliseconds(20));
+
+  // Destroying an enabled timer removes it from the wheel.
+  timer->enableTimer(std::chrono::milliseconds(10));
+  timer.reset();
+  EXPECT_EQ(0, wheel_.size());
+  advance(std::chrono::milliseconds(20));
+}
+
+TEST_F(TimerWheelTest, Reenable) {
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_.createTimer(callback.AsStdFunction());
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(5));
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(9));
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+}
+
+// Sub-millisecond durations are rounded up.
+TEST_F(TimerWheelTest, HighResolutionDuration) {
+  MockFunction<TimerCb> callback;
+  TimerPtr timer = wheel_.createTimer(callback.AsStdFunction());
+  timer->enableHRTimer(std::chrono::microseconds(1500));
+  advance(std::chrono::milliseconds(1));
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+}
+
+// Timers of every wheel fire on time, including those too far away for the wheels.
+TEST_F(TimerWheelTest, UpperWheels) {
+  const std::vector<std::chrono::milliseconds> durations{
+      std::chrono::milliseconds(300), std::chrono::seconds(20), std::chrono::minutes(30),
+      std::chrono::hours(20), std::chrono::hours(40)};
+  std::vector<std::chrono::milliseconds> fire_times;
+  std::vector<TimerPtr> timers;
+  for (const std::chrono::milliseconds duration : durations) {
+    timers.push_back(wheel_.createTimer([this, &fire_times] { fire_times.push_back(elapsed()); }));
+    timers.back()->enableTimer(duration);
+  }
+
+  for (size_t i = 0; i < durations.size(); ++i) {
+    // Get close in large steps, then move to the expiry.
+    while (elapsed() + std::chrono::minutes(1) < durations[i]) {
+      advance(std::chrono::minutes(1));
+    }
+    advance(durations[i] - elapsed() - std::chrono::milliseconds(1));
+    EXPECT_EQ(i, fire_times.size());
+    advance(std::chrono::milliseconds(1));
+    ASSERT_EQ(i + 1, fire_times.size());
+  }
+  EXPECT_EQ(durations, fire_times);
+}
+
+TEST_F(TimerWheelTest, DisableFromCallback) {
+  MockFunction<TimerCb> callback;
+  TimerPtr first;
+  TimerPtr second = wheel_.createTimer(callback.AsStdFunction());
+  first = wheel_.createTimer([&] { second.reset(); });
+  first->enableTimer(std::chrono::milliseconds(10));
+  second->enableTimer(std::chrono::milliseconds(10));
+
+  // Both timers expire together, one of them destroys the other.
+  EXPECT_CALL(callback, Call()).Times(testing::AtMost(1));
+  advance(std::chrono::milliseconds(10));
+  EXPECT_EQ(0, wheel_.size());
+}
+
+// A timer enabled for 0ms from its callback fires again at the next millisecond.
+TEST_F(TimerWheelTest, ReenableFromCallback) {
+  int fired = 0;
+  TimerPtr timer;
+  timer = wheel_.createTimer([&] {
+    if (++fired < 3) {
+      timer->enableTimer(std::chrono::milliseconds(0));
+    }
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+  advance(std::chrono::milliseconds(1));
+  EXPECT_EQ(1, fired);
+  advance(std::chrono::milliseconds(1));
+  EXPECT_EQ(2, fired);
+  advance(std::chrono::milliseconds(1));
+  EXPECT_EQ(3, fired);
+  EXPECT_FALSE(timer->enabled());
+}
+
+TEST_F(TimerWheelTest, ScopeTrackedObject) {
+  MockScopeTrackedObject scope;
+  TimerPtr timer =
+      wheel_.createTimer([this] { EXPECT_FALSE(dispatcher_->trackedObjectStackIsEmpty()); });
+  timer->enableTimer(std::chrono::milliseconds(1), &scope);
+  advance(std::chrono::milliseconds(1));
+  EXPECT_TRUE(dispatcher_->trackedObjectStackIsEmpty());
+}
+
+// Many timers with random durations fire at their expiry, after the wheel caught up with time
+// jumps of various lengths.
+TEST_F(TimerWheelTest, RandomTimers) {
+  std::mt19937 random(42);
+  constexpr uint32_t num_timers = 1000;
+  std::vector<std::chrono::milliseconds> expiries(num_timers);
+  std::vector<std::chrono::milliseconds> fire_times(num_timers);
+  std::vector<TimerPtr> timers;
+  for (uint32_t i = 0; i < num_timers; ++i) {
+    timers.push_back(wheel_.createTimer([this, &fire_times, i] { fire_times[i] = elapsed(); }));
+    expiries[i] = std::chrono::milliseconds(random() % 100000);
+    timers[i]->enableTimer(expiries[i]);
+  }
+
+  while (wheel_.size() > 0) {
+    advance(std::chrono::milliseconds(random() % 1000));
+  }
+  for (uint32_t i = 0; i < num_timers; ++i) {
+    // The timers fire in the first wheel run after their expiry.
+    EXPECT_LE(expiries[i], fire_times[i]);
+    EXPECT_GT(expiries[i] + std::chrono::seconds(1), fire_times[i]);
+  }
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
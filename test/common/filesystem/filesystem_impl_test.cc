@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/cleanup.h"
@@ -351,6 +352,22 @@ TEST_F(FileSystemImplTest, PwriteWritesTheSpecifiedRange) {
   EXPECT_EQ(contents, "01BOOPS789");
 }
 
+TEST_F(FileSystemImplTest, WritevWritesTheBuffersInOrder) {
+  const std::string file_path = TestEnvironment::writeStringToFileForTest("test_envoy", "start ");
+  {
+    FilePathAndType file_info{Filesystem::DestinationType::File, file_path};
+    FilePtr file = file_system_.createFile(file_info);
+    const Api::IoCallBoolResult open_result = file->open(DefaultFlags);
+    EXPECT_TRUE(open_result.return_value_) << open_result.err_->getErrorDetails();
+    const std::vector<absl::string_view> buffers{"first ", "", "second ", "third"};
+    const Api::IoCallSizeResult write_result = file->writev(buffers);
+    EXPECT_EQ(write_result.return_value_, 18) << write_result.err_->getErrorDetails();
+    EXPECT_THAT(write_result.err_, ::testing::IsNull());
+  }
+  auto contents = TestEnvironment::readFileToStringForTest(file_path);
+  EXPECT_EQ(contents, "start first second third");
+}
+
 TEST_F(FileSystemImplTest, StatOnDirectoryReturnsDirectoryType) {
   const std::string new_dir_path = TestEnvironment::temporaryPath("envoy_test_dir");
   TestEnvironment::createPath(new_dir_path);
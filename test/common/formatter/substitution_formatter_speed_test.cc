@@ -53,6 +53,34 @@ std::unique_ptr<Envoy::TestStreamInfo> makeStreamInfo(TimeSource& time_source) {
   return stream_info;
 }
 
+// A format with 25 fields, most of them the fields of common access logs.
+constexpr char WideLogFormat[] =
+    "[%START_TIME%] \"%REQ(:METHOD)% %REQ(X-ENVOY-ORIGINAL-PATH?:PATH)% %PROTOCOL%\" "
+    "%RESPONSE_CODE% %RESPONSE_FLAGS% %RESPONSE_CODE_DETAILS% %BYTES_RECEIVED% %BYTES_SENT% "
+    "%DURATION% %REQUEST_DURATION% %RESPONSE_DURATION% %RESP(X-ENVOY-UPSTREAM-SERVICE-TIME)% "
+    "\"%REQ(X-FORWARDED-FOR)%\" \"%REQ(USER-AGENT)%\" \"%REQ(X-REQUEST-ID)%\" "
+    "\"%REQ(:AUTHORITY)%\" \"%UPSTREAM_HOST%\" %UPSTREAM_CLUSTER% %DOWNSTREAM_REMOTE_ADDRESS% "
+    "%DOWNSTREAM_LOCAL_ADDRESS% %REQ(REFERER)% %RESP(CONTENT-TYPE)% %RESP(CONTENT-LENGTH)% "
+    "%TRAILER(GRPC-STATUS)% %LOCAL_REPLY_BODY%\n";
+
+std::unique_ptr<Envoy::TestStreamInfo> makeWideStreamInfo(TimeSource& time_source) {
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_source);
+  stream_info->downstream_connection_info_provider_->setLocalAddress(
+      std::make_shared<Envoy::Network::Address::Ipv4Instance>("198.51.100.1", 443));
+  stream_info->setResponseCode(200);
+  return stream_info;
+}
+
+Http::TestRequestHeaderMapImpl makeWideRequestHeaders() {
+  return {{":method", "GET"},
+          {":path", "/api/v1/resources?page=2"},
+          {":authority", "service.example.com"},
+          {"x-forwarded-for", "203.0.113.1"},
+          {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)"},
+          {"x-request-id", "8e5f5a3c-1d2b-4f5e-9a7b-0c1d2e3f4a5b"},
+          {"referer", "https://service.example.com/"}};
+}
+
 } // namespace
 
 // Test measures how fast Formatters are constructed from
@@ -99,6 +127,79 @@ static void BM_AccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_AccessLogFormatter);
 
+// Formats the wide format the way the formatter did before the providers could append their
+// values to the line, as the baseline of the benchmarks below.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_WideAccessLogFormatterCopyingProviders(benchmark::State& state) {
+  MockTimeSystem time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeWideStreamInfo(time_system);
+  const std::vector<Formatter::FormatterProviderPtr> providers =
+      Formatter::SubstitutionFormatParser::parse(WideLogFormat);
+
+  size_t output_bytes = 0;
+  Http::TestRequestHeaderMapImpl request_headers = makeWideRequestHeaders();
+  Http::TestResponseHeaderMapImpl response_headers{{"content-type", "application/json"}};
+  Http::TestResponseTrailerMapImpl response_trailers;
+  const std::string empty_value = "-";
+  std::string body;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    std::string log_line;
+    log_line.reserve(256);
+    for (const Formatter::FormatterProviderPtr& provider : providers) {
+      log_line += provider
+                      ->format(request_headers, response_headers, response_trailers, *stream_info,
+                               body)
+                      .value_or(empty_value);
+    }
+    output_bytes += log_line.length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_WideAccessLogFormatterCopyingProviders);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_WideAccessLogFormatter(benchmark::State& state) {
+  MockTimeSystem time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeWideStreamInfo(time_system);
+  Envoy::Formatter::FormatterImpl formatter(WideLogFormat, false);
+
+  size_t output_bytes = 0;
+  Http::TestRequestHeaderMapImpl request_headers = makeWideRequestHeaders();
+  Http::TestResponseHeaderMapImpl response_headers{{"content-type", "application/json"}};
+  Http::TestResponseTrailerMapImpl response_trailers;
+  std::string body;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    output_bytes +=
+        formatter.format(request_headers, response_headers, response_trailers, *stream_info, body)
+            .length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_WideAccessLogFormatter);
+
+// Appends the lines to a reused buffer, which saves the allocation of the line as well.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_WideAccessLogFormatterToBuffer(benchmark::State& state) {
+  MockTimeSystem time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeWideStreamInfo(time_system);
+  Envoy::Formatter::FormatterImpl formatter(WideLogFormat, false);
+
+  size_t output_bytes = 0;
+  Http::TestRequestHeaderMapImpl request_headers = makeWideRequestHeaders();
+  Http::TestResponseHeaderMapImpl response_headers{{"content-type", "application/json"}};
+  Http::TestResponseTrailerMapImpl response_trailers;
+  std::string body;
+  std::string buffer;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    buffer.clear();
+    formatter.formatTo(request_headers, response_headers, response_trailers, *stream_info, body,
+                       buffer);
+    output_bytes += buffer.length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_WideAccessLogFormatterToBuffer);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_StructAccessLogFormatter(benchmark::State& state) {
   MockTimeSystem time_system;
@@ -3630,6 +3630,100 @@ TEST(SubstitutionFormatterTest, JsonFormatterTest) {
   EXPECT_TRUE(TestUtility::jsonStringEqual(out_json, expected));
 }
 
+// Verifies that the JSON written directly is the serialization of the Struct that StructFormatter
+// builds, with typed and string values, and with and without the empty values.
+TEST(SubstitutionFormatterTest, JsonFormatterDirectOutputTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"x-escaped", "quote\" backslash\\ tab\t"},
+                                                {"x-number", "42"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body = "local reply";
+
+  envoy::config::core::v3::Metadata metadata;
+  populateMetadataTestData(metadata);
+  EXPECT_CALL(stream_info, dynamicMetadata()).WillRepeatedly(ReturnRef(metadata));
+  EXPECT_CALL(Const(stream_info), dynamicMetadata()).WillRepeatedly(ReturnRef(metadata));
+  EXPECT_CALL(stream_info, bytesSent()).WillRepeatedly(Return(123));
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(absl::nullopt));
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    escaped: '%REQ(X-ESCAPED)%'
+    "key \"quoted\"": plain
+    bytes_sent: '%BYTES_SENT%'
+    number: 1.5
+    large_number: 12345678901234567890
+    protocol: '%PROTOCOL%'
+    missing: '%REQ(X-MISSING)%'
+    concatenated: '%REQ(X-NUMBER)% %REQ(X-MISSING)% %LOCAL_REPLY_BODY%'
+    metadata: '%DYNAMIC_METADATA(com.test)%'
+    nested:
+      missing: '%RESP(X-MISSING)%'
+      list: ['%BYTES_SENT%', '%REQ(X-MISSING)%', [1, '%PROTOCOL%']]
+    all_missing:
+      missing: '%REQ(X-MISSING)%'
+  )EOF",
+                            key_mapping);
+
+  for (const bool preserve_types : {false, true}) {
+    for (const bool omit_empty_values : {false, true}) {
+      StructFormatter struct_formatter(key_mapping, preserve_types, omit_empty_values);
+      const std::string expected = MessageUtil::getJsonStringFromMessageOrDie(
+          struct_formatter.format(request_header, response_header, response_trailer, stream_info,
+                                  body),
+          false, true);
+
+      JsonFormatterImpl formatter(key_mapping, preserve_types, omit_empty_values);
+      std::string output = "prefix ";
+      formatter.formatTo(request_header, response_header, response_trailer, stream_info, body,
+                         output);
+      ASSERT_TRUE(absl::StartsWith(output, "prefix "));
+      ASSERT_TRUE(absl::EndsWith(output, "\n"));
+      EXPECT_TRUE(TestUtility::jsonStringEqual(output.substr(7), expected))
+          << output << " != " << expected;
+      EXPECT_EQ(output.substr(7), formatter.format(request_header, response_header,
+                                                   response_trailer, stream_info, body));
+    }
+  }
+
+  // All the fields being omitted leaves an empty object.
+  TestUtility::loadFromYaml(R"EOF(
+    missing: '%REQ(X-MISSING)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false, true);
+  EXPECT_EQ("{}\n",
+            formatter.format(request_header, response_header, response_trailer, stream_info, body));
+}
+
+TEST(SubstitutionFormatterTest, JsonFormatterStructFallbackTest) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.direct_json_access_log_formatter", "false"}});
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"x-header", "value"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body;
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    header: '%REQ(X-HEADER)%'
+    nested:
+      number: 2
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, true, false);
+
+  std::string output;
+  formatter.formatTo(request_header, response_header, response_trailer, stream_info, body, output);
+  EXPECT_TRUE(TestUtility::jsonStringEqual(output, R"EOF({
+    "header": "value",
+    "nested": {"number": 2}
+  })EOF"));
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
@@ -3914,6 +4008,70 @@ TEST(SubstitutionFormatterTest, CompositeFormatterEmpty) {
   }
 }
 
+// Verifies that formatTo() appends the values the providers return from format(), also for the
+// providers appending their values to the line directly.
+TEST(SubstitutionFormatterTest, CompositeFormatterFormatTo) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{":method", "GET"}, {":path", "/"}};
+  Http::TestResponseHeaderMapImpl response_header{{"x-response", "value"}};
+  Http::TestResponseTrailerMapImpl response_trailer{{"x-trailer", "trailer"}};
+  std::string body = "body";
+  EXPECT_CALL(stream_info, bytesSent()).WillRepeatedly(Return(42));
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(absl::nullopt));
+
+  const std::string format =
+      "%REQ(:METHOD)% %REQ(:PATH):1% %REQ(X-MISSING)% %RESP(X-RESPONSE)% %TRAILER(X-TRAILER):3% "
+      "%BYTES_SENT% %DURATION% %PROTOCOL% %DOWNSTREAM_REMOTE_ADDRESS% "
+      "%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT% %LOCAL_REPLY_BODY%";
+  for (const bool omit_empty_values : {false, true}) {
+    std::string expected = "prefix ";
+    for (const FormatterProviderPtr& provider : SubstitutionFormatParser::parse(format)) {
+      expected += provider->format(request_header, response_header, response_trailer, stream_info,
+                                   body)
+                      .value_or(omit_empty_values ? "" : "-");
+    }
+
+    FormatterImpl formatter(format, omit_empty_values);
+    std::string output = "prefix ";
+    formatter.formatTo(request_header, response_header, response_trailer, stream_info, body,
+                       output);
+    EXPECT_EQ(expected, output);
+  }
+
+  FormatterImpl formatter("%REQ(:METHOD)% %REQ(:PATH):1% %REQ(X-MISSING)% %RESP(X-RESPONSE)% "
+                          "%TRAILER(X-TRAILER):3% %BYTES_SENT% %PROTOCOL% %LOCAL_REPLY_BODY%",
+                          false);
+  EXPECT_EQ("GET / - value tra 42 - body",
+            formatter.format(request_header, response_header, response_trailer, stream_info, body));
+}
+
+// Formats only depending on literals and the environment are formatted once, when created.
+TEST(SubstitutionFormatterTest, CompositeFormatterConstantValue) {
+  TestEnvironment::setEnvVar("ENVOY_TEST_ENV", "test", 1);
+  Envoy::Cleanup cleanup([]() { TestEnvironment::unsetEnvVar("ENVOY_TEST_ENV"); });
+
+  EXPECT_EQ("", FormatterImpl("", false).constantValue());
+  EXPECT_EQ("plain", FormatterImpl("plain", false).constantValue());
+  EXPECT_EQ("100%", FormatterImpl("100%%", false).constantValue());
+  EXPECT_EQ("env test, te", FormatterImpl("env %ENVIRONMENT(ENVOY_TEST_ENV)%, "
+                                          "%ENVIRONMENT(ENVOY_TEST_ENV):2%",
+                                          false)
+                                .constantValue());
+  EXPECT_EQ("-", FormatterImpl("%ENVIRONMENT(ENVOY_TEST_MISSING_ENV)%", true).constantValue());
+
+  // The constant parts of other formats are still formatted as before.
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{":method", "GET"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(Http::Protocol::Http11));
+  FormatterImpl formatter(
+      "[%ENVIRONMENT(ENVOY_TEST_ENV)% %PROTOCOL%] %REQ(:METHOD)%%REQ(X-MISSING)%", false);
+  EXPECT_FALSE(formatter.constantValue().has_value());
+  EXPECT_EQ("[test HTTP/1.1] GET-",
+            formatter.format(request_header, response_header, response_trailer, stream_info, ""));
+}
+
 TEST(SubstitutionFormatterTest, ParserFailures) {
   SubstitutionFormatParser parser;
 
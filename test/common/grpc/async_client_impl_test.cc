@@ -116,6 +116,39 @@ TEST_F(EnvoyAsyncClientImplTest, HostIsOverrideByConfig) {
   EXPECT_EQ(grpc_stream, nullptr);
 }
 
+// Validate that the streams of a method share the request headers prepared for it.
+TEST_F(EnvoyAsyncClientImplTest, MethodHeadersAreShared) {
+  NiceMock<MockAsyncStreamCallbacks<helloworld::HelloReply>> grpc_callbacks;
+  Http::AsyncClient::StreamCallbacks* http_callbacks;
+
+  Http::MockAsyncClientStream http_stream;
+  EXPECT_CALL(http_client_, start(_, _))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&http_callbacks, &http_stream](Http::AsyncClient::StreamCallbacks& callbacks,
+                                                 const Http::AsyncClient::StreamOptions&) {
+            http_callbacks = &callbacks;
+            return &http_stream;
+          }));
+
+  std::vector<const char*> paths;
+  EXPECT_CALL(http_stream, sendHeaders(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&http_callbacks, &paths](Http::RequestHeaderMap& headers, bool) {
+        EXPECT_EQ("/helloworld.Greeter/SayHello", headers.getPathValue());
+        EXPECT_EQ("test_cluster", headers.getHostValue());
+        paths.push_back(headers.getPathValue().data());
+        http_callbacks->onReset();
+      }));
+  for (int i = 0; i < 2; ++i) {
+    auto grpc_stream = grpc_client_->start(*method_descriptor_, grpc_callbacks,
+                                           Http::AsyncClient::StreamOptions());
+    EXPECT_EQ(grpc_stream, nullptr);
+  }
+  ASSERT_EQ(2, paths.size());
+  EXPECT_EQ(paths[0], paths[1]);
+}
+
 // Validate that the metadata header is the initial metadata in gRPC service config and the value is
 // interpolated.
 TEST_F(EnvoyAsyncClientImplTest, MetadataIsInitialized) {
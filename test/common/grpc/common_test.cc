@@ -240,6 +240,23 @@ TEST(GrpcContextTest, PrepareHeaders) {
   }
 }
 
+TEST(GrpcContextTest, PrepareHeadersInPlace) {
+  const std::string host_name = "cluster";
+  const std::string path = "/service_name/method_name";
+  Http::TestRequestHeaderMapImpl headers;
+  Common::prepareHeaders(headers, host_name, path, absl::optional<std::chrono::milliseconds>(1));
+
+  EXPECT_EQ("POST", headers.getMethodValue());
+  EXPECT_EQ(path, headers.getPathValue());
+  EXPECT_EQ(host_name, headers.getHostValue());
+  EXPECT_EQ("trailers", headers.getTEValue());
+  EXPECT_EQ("application/grpc", headers.getContentTypeValue());
+  EXPECT_EQ("1m", headers.getGrpcTimeoutValue());
+  // The path and host name are referenced rather than copied.
+  EXPECT_EQ(path.data(), headers.getPathValue().data());
+  EXPECT_EQ(host_name.data(), headers.getHostValue().data());
+}
+
 TEST(GrpcContextTest, GrpcToHttpStatus) {
   const std::vector<std::pair<Status::GrpcStatus, uint64_t>> test_set = {
       {Status::WellKnownGrpcStatus::Ok, 200},
@@ -405,5 +422,16 @@ TEST(GrpcContextTest, PrependGrpcFrameHeader) {
   EXPECT_EQ(buffer->toString(), header_string + "test");
 }
 
+// The frame header of a serialized message is written into the BufferFragment of the message.
+TEST(GrpcContextTest, SerializeMessageWithRoomForFrameHeader) {
+  helloworld::HelloRequest request;
+  request.set_name("hello");
+  Buffer::InstancePtr buffer = Common::serializeMessage(request);
+  EXPECT_EQ(request.SerializeAsString(), buffer->toString());
+  Common::prependGrpcFrameHeader(*buffer);
+  EXPECT_EQ(1, buffer->getRawSlices().size());
+  EXPECT_EQ(Common::serializeToGrpcFrame(request)->toString(), buffer->toString());
+}
+
 } // namespace Grpc
 } // namespace Envoy
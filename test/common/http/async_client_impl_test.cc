@@ -1837,7 +1837,8 @@ TEST_F(AsyncClientImplTest, RdsGettersTest) {
   auto& path_match_criterion = route_entry->pathMatchCriterion();
   EXPECT_EQ("", path_match_criterion.matcher());
   EXPECT_EQ(Router::PathMatchType::None, path_match_criterion.matchType());
-  const auto& route_config = route_entry->virtualHost().routeConfig();
+  const auto& route_config =
+      dynamic_cast<const Router::Config&>(route_entry->virtualHost().routeConfig());
   EXPECT_EQ("", route_config.name());
   EXPECT_EQ(0, route_config.internalOnlyHeaders().size());
   EXPECT_EQ(nullptr, route_config.route(headers_, stream_info_, 0));
@@ -305,7 +305,8 @@ public:
         socket->connectionInfoProvider().localAddress(), source_address_,
         Network::Test::createRawBufferSocket(), nullptr, nullptr);
     upstream_listener_ =
-        dispatcher_->createListener(std::move(socket), listener_callbacks_, runtime_, true, false);
+        dispatcher_->createListener(std::move(socket), listener_callbacks_, runtime_, true, false,
+                                    Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
     client_connection_ = client_connection.get();
     client_connection_->addConnectionCallbacks(client_callbacks_);
 
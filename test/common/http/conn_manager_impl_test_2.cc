@@ -493,6 +493,67 @@ TEST_F(HttpConnectionManagerImplTest, DoubleBuffering) {
   filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+TEST_F(HttpConnectionManagerImplTest, BufferedBodyStats) {
+  setup(false, "");
+
+  std::shared_ptr<MockStreamDecoderFilter> first(new NiceMock<MockStreamDecoderFilter>());
+  std::shared_ptr<MockStreamDecoderFilter> second(new NiceMock<MockStreamDecoderFilter>());
+  std::shared_ptr<MockStreamEncoderFilter> third(new NiceMock<MockStreamEncoderFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        auto first_factory = createDecoderFilterFactoryCb(first);
+        manager.applyFilterFactoryCb({"first", "envoy.filters.http.first"}, first_factory);
+        auto second_factory = createDecoderFilterFactoryCb(second);
+        manager.applyFilterFactoryCb({"", "envoy.filters.http.second"}, second_factory);
+        auto third_factory = createEncoderFilterFactoryCb(third);
+        manager.applyFilterFactoryCb({"third", "envoy.filters.http.third"}, third_factory);
+        return true;
+      }));
+
+  // The first filter buffers the request body.
+  EXPECT_CALL(*first, decodeHeaders(_, false))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  EXPECT_CALL(*first, decodeData(_, true))
+      .WillOnce(Return(FilterDataStatus::StopIterationAndBuffer));
+  startRequest(true, "hello");
+
+  // The second filter stops on the body that is already buffered, and so doesn't buffer it again,
+  // then adds to it.
+  EXPECT_CALL(*second, decodeHeaders(_, false))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  EXPECT_CALL(*second, decodeData(_, true))
+      .WillOnce(Invoke([&](Buffer::Instance&, bool) -> FilterDataStatus {
+        Buffer::OwnedImpl data(" world");
+        second->callbacks_->addDecodedData(data, false);
+        return FilterDataStatus::StopIterationAndBuffer;
+      }));
+  first->callbacks_->continueDecoding();
+
+  // The encoder filter buffers the response body.
+  EXPECT_CALL(*third, encodeHeaders(_, false))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  EXPECT_CALL(*third, encodeData(_, true))
+      .WillOnce(Return(FilterDataStatus::StopIterationAndBuffer));
+  ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{{":status", "200"}}};
+  second->callbacks_->streamInfo().setResponseCodeDetails("");
+  second->callbacks_->encodeHeaders(std::move(response_headers), false, "details");
+  Buffer::OwnedImpl response_data("response");
+  second->callbacks_->encodeData(response_data, true);
+
+  EXPECT_CALL(response_encoder_, encodeHeaders(_, false));
+  EXPECT_CALL(response_encoder_, encodeData(_, true));
+  expectOnDestroy();
+  third->callbacks_->continueEncoding();
+
+  EXPECT_EQ(5U, TestUtility::findCounter(fake_stats_, "filter.first.rq_body_buffered_bytes")
+                    ->value());
+  EXPECT_EQ(6U, TestUtility::findCounter(fake_stats_,
+                                         "filter.envoy.filters.http.second.rq_body_buffered_bytes")
+                    ->value());
+  EXPECT_EQ(8U, TestUtility::findCounter(fake_stats_, "filter.third.rs_body_buffered_bytes")
+                    ->value());
+}
+
 TEST_F(HttpConnectionManagerImplTest, ZeroByteDataFiltering) {
   setup(false, "");
   setupFilterChain(2, 0);
@@ -15,6 +15,7 @@
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/local_reply/mocks.h"
 #include "test/mocks/network/mocks.h"
+#include "test/test_common/test_runtime.h"
 
 #include "gtest/gtest.h"
 
@@ -432,6 +433,81 @@ TEST_F(FilterManagerTest, GetRouteLevelFilterConfigForNullRoute) {
   filter_manager_->destroyFilters();
 }
 
+
+class DisablingRouteConfig : public Router::RouteSpecificFilterConfig {
+public:
+  bool disablesFilter() const override { return true; }
+};
+
+// Verifies that the filters disabled on the route of the stream are not created.
+TEST_F(FilterManagerTest, SkipRouteDisabledFilters) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.skip_route_disabled_http_filters", "true"}});
+  initialize();
+
+  std::shared_ptr<Router::MockRoute> route(new NiceMock<Router::MockRoute>());
+  auto disabling_config = std::make_shared<DisablingRouteConfig>();
+  auto route_config = std::make_shared<Router::RouteSpecificFilterConfig>();
+  NiceMock<MockDownstreamStreamFilterCallbacks> downstream_callbacks;
+  ON_CALL(filter_manager_callbacks_, downstreamCallbacks)
+      .WillByDefault(Return(OptRef<DownstreamStreamFilterCallbacks>{downstream_callbacks}));
+  ON_CALL(downstream_callbacks, route(_)).WillByDefault(Return(route));
+  ON_CALL(*route, mostSpecificPerFilterConfig(testing::Eq("disabled")))
+      .WillByDefault(Return(disabling_config.get()));
+  ON_CALL(*route, mostSpecificPerFilterConfig(testing::Eq("enabled")))
+      .WillByDefault(Return(route_config.get()));
+
+  std::shared_ptr<MockStreamDecoderFilter> disabled_filter(
+      new NiceMock<MockStreamDecoderFilter>());
+  std::shared_ptr<MockStreamDecoderFilter> enabled_filter(new NiceMock<MockStreamDecoderFilter>());
+  std::shared_ptr<MockStreamDecoderFilter> unconfigured_filter(
+      new NiceMock<MockStreamDecoderFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        auto disabled_factory = createDecoderFilterFactoryCb(disabled_filter);
+        manager.applyFilterFactoryCb({"disabled", "filter-name"}, disabled_factory);
+        auto enabled_factory = createDecoderFilterFactoryCb(enabled_filter);
+        manager.applyFilterFactoryCb({"enabled", "filter-name"}, enabled_factory);
+        auto unconfigured_factory = createDecoderFilterFactoryCb(unconfigured_filter);
+        manager.applyFilterFactoryCb({"unconfigured", "filter-name"}, unconfigured_factory);
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  EXPECT_EQ(nullptr, disabled_filter->callbacks_);
+  EXPECT_NE(nullptr, enabled_filter->callbacks_);
+  EXPECT_NE(nullptr, unconfigured_filter->callbacks_);
+
+  filter_manager_->destroyFilters();
+}
+
+// Verifies that the filters disabled on the route are created when the runtime guard is off.
+TEST_F(FilterManagerTest, RouteDisabledFiltersCreatedByDefault) {
+  initialize();
+
+  std::shared_ptr<Router::MockRoute> route(new NiceMock<Router::MockRoute>());
+  auto disabling_config = std::make_shared<DisablingRouteConfig>();
+  NiceMock<MockDownstreamStreamFilterCallbacks> downstream_callbacks;
+  ON_CALL(filter_manager_callbacks_, downstreamCallbacks)
+      .WillByDefault(Return(OptRef<DownstreamStreamFilterCallbacks>{downstream_callbacks}));
+  ON_CALL(downstream_callbacks, route(_)).WillByDefault(Return(route));
+  ON_CALL(*route, mostSpecificPerFilterConfig(testing::Eq("disabled")))
+      .WillByDefault(Return(disabling_config.get()));
+
+  std::shared_ptr<MockStreamDecoderFilter> filter(new NiceMock<MockStreamDecoderFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        auto factory = createDecoderFilterFactoryCb(filter);
+        manager.applyFilterFactoryCb({"disabled", "filter-name"}, factory);
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  EXPECT_NE(nullptr, filter->callbacks_);
+
+  filter_manager_->destroyFilters();
+}
 } // namespace
 } // namespace Http
 } // namespace Envoy
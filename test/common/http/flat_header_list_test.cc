@@ -0,0 +1,101 @@
+#include <string>
+#include <vector>
+
+#include "source/common/http/flat_header_list.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+struct TestEntry {
+  TestEntry(std::string value, int& live) : value_(std::move(value)), live_(live) { live_++; }
+  ~TestEntry() { live_--; }
+
+  std::string value_;
+  int& live_;
+};
+
+using TestList = FlatHeaderList<TestEntry, 4>;
+
+std::vector<std::string> values(const TestList& list) {
+  std::vector<std::string> ret;
+  for (const TestEntry* entry : list.entries()) {
+    ret.push_back(entry->value_);
+  }
+  return ret;
+}
+
+TEST(FlatHeaderListTest, KeepsInsertionPosition) {
+  int live = 0;
+  TestList list;
+  list.emplace(0, "b", live);
+  list.emplace(1, "d", live);
+  list.emplace(0, "a", live);
+  list.emplace(2, "c", live);
+  EXPECT_EQ(std::vector<std::string>({"a", "b", "c", "d"}), values(list));
+  EXPECT_EQ(4, live);
+
+  list.erase(list.indexOf(list.entries()[1]));
+  EXPECT_EQ(std::vector<std::string>({"a", "c", "d"}), values(list));
+  EXPECT_EQ(3, live);
+}
+
+// Entries do not move when the list grows past its inline capacity.
+TEST(FlatHeaderListTest, StableAddresses) {
+  int live = 0;
+  TestList list;
+  std::vector<const TestEntry*> inserted;
+  for (int i = 0; i < 100; i++) {
+    inserted.push_back(list.emplace(list.size(), std::to_string(i), live));
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(inserted[i], list.entries()[i]);
+    EXPECT_EQ(std::to_string(i), inserted[i]->value_);
+  }
+}
+
+TEST(FlatHeaderListTest, ReusesErasedSlots) {
+  int live = 0;
+  TestList list;
+  list.emplace(0, "a", live);
+  TestEntry* erased = list.emplace(1, "b", live);
+  list.erase(1);
+  EXPECT_EQ(erased, list.emplace(1, "c", live));
+}
+
+TEST(FlatHeaderListTest, RemoveIf) {
+  int live = 0;
+  TestList list;
+  for (int i = 0; i < 10; i++) {
+    list.emplace(list.size(), std::to_string(i), live);
+  }
+  list.removeIf([](const TestEntry& entry) { return std::stoi(entry.value_) % 2 == 0; });
+  EXPECT_EQ(std::vector<std::string>({"1", "3", "5", "7", "9"}), values(list));
+  EXPECT_EQ(5, live);
+}
+
+TEST(FlatHeaderListTest, ClearAndDestroy) {
+  int live = 0;
+  {
+    TestList list;
+    for (int i = 0; i < 10; i++) {
+      list.emplace(list.size(), std::to_string(i), live);
+    }
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(0, live);
+
+    for (int i = 0; i < 10; i++) {
+      list.emplace(list.size(), std::to_string(i), live);
+    }
+    EXPECT_EQ(10, list.size());
+    EXPECT_EQ(10, live);
+  }
+  EXPECT_EQ(0, live);
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
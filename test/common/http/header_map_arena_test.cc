@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "source/common/http/header_map_arena.h"
+#include "source/common/http/header_map_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+bool isAligned(const void* ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(HeaderMapArenaTest, AlignsAllocations) {
+  HeaderMapArena arena;
+  for (size_t alignment : {1, 2, 4, 8, 16}) {
+    arena.allocate(1, 1);
+    EXPECT_TRUE(isAligned(arena.allocate(24, alignment), alignment));
+  }
+  EXPECT_EQ(HeaderMapArena::InitialBlockSize, arena.reservedBytes());
+}
+
+TEST(HeaderMapArenaTest, ReusesMostRecentAllocation) {
+  HeaderMapArena arena;
+  void* first = arena.allocate(64, 8);
+  void* second = arena.allocate(64, 8);
+  arena.deallocate(second, 64);
+  EXPECT_EQ(second, arena.allocate(64, 8));
+
+  // Only the most recent allocation can be undone.
+  arena.deallocate(first, 64);
+  EXPECT_NE(first, arena.allocate(64, 8));
+}
+
+TEST(HeaderMapArenaTest, GrowsInBlocks) {
+  HeaderMapArena arena;
+  arena.allocate(HeaderMapArena::InitialBlockSize, 8);
+  EXPECT_EQ(HeaderMapArena::InitialBlockSize, arena.reservedBytes());
+
+  arena.allocate(1, 1);
+  EXPECT_EQ(HeaderMapArena::InitialBlockSize * 3, arena.reservedBytes());
+
+  // Allocations larger than the next block get a block of their own.
+  arena.allocate(HeaderMapArena::MaxBlockSize * 2, 8);
+  EXPECT_EQ(HeaderMapArena::InitialBlockSize * 3 + HeaderMapArena::MaxBlockSize * 2,
+            arena.reservedBytes());
+  EXPECT_EQ(0, arena.heapAllocations());
+}
+
+TEST(HeaderMapArenaTest, FallsBackToHeapWhenFull) {
+  HeaderMapArena arena;
+  while (arena.reservedBytes() < HeaderMapArena::MaxArenaBytes) {
+    arena.allocate(1024, 8);
+  }
+  const size_t reserved_bytes = arena.reservedBytes();
+
+  // Allocations that no longer fit in the last block come from the heap and are freed
+  // individually; ASAN builds check that they do not leak.
+  std::list<void*> heap_allocations;
+  for (int i = 0; i < 100; ++i) {
+    heap_allocations.push_back(arena.allocate(1024, 8));
+  }
+  EXPECT_EQ(reserved_bytes, arena.reservedBytes());
+  EXPECT_LT(0, arena.heapAllocations());
+  for (void* ptr : heap_allocations) {
+    arena.deallocate(ptr, 1024);
+  }
+}
+
+TEST(HeaderMapArenaTest, AllocatorsCompareByArena) {
+  HeaderMapArena arena;
+  HeaderMapArena other_arena;
+  HeaderMapArenaAllocator<int> allocator(&arena);
+  EXPECT_EQ(allocator, HeaderMapArenaAllocator<std::string>(&arena));
+  EXPECT_NE(allocator, HeaderMapArenaAllocator<int>(&other_arena));
+  EXPECT_NE(allocator, HeaderMapArenaAllocator<int>());
+}
+
+TEST(HeaderMapArenaTest, HeapAllocatorWithoutArena) {
+  std::list<std::string, HeaderMapArenaAllocator<std::string>> list;
+  list.emplace_back("hello");
+  list.emplace_back("world");
+  EXPECT_EQ(2, list.size());
+  EXPECT_EQ(nullptr, list.get_allocator().arena());
+}
+
+// Header maps keep their arena alive, so the maps of a stream can outlive the codec stream that
+// created them.
+TEST(HeaderMapArenaTest, HeaderMapsShareArena) {
+  auto arena = std::make_shared<HeaderMapArena>();
+  auto request_headers = RequestHeaderMapImpl::create(arena);
+  auto response_headers = ResponseHeaderMapImpl::create(arena);
+  HeaderMapArena* raw_arena = arena.get();
+  arena.reset();
+
+  for (int i = 0; i < 200; ++i) {
+    request_headers->addCopy(LowerCaseString("x-header-" + std::to_string(i)), "value");
+  }
+  request_headers->setPath("/");
+  response_headers->setStatus(200);
+  EXPECT_EQ(201, request_headers->size());
+  EXPECT_LT(HeaderMapArena::InitialBlockSize, raw_arena->reservedBytes());
+
+  request_headers->removePrefix(LowerCaseString("x-header-"));
+  EXPECT_EQ(1, request_headers->size());
+  EXPECT_EQ("/", request_headers->getPathValue());
+
+  // Copies are independent of the arena of the source map.
+  auto copy = createHeaderMap<RequestHeaderMapImpl>(*request_headers);
+  request_headers.reset();
+  EXPECT_EQ("/", copy->getPathValue());
+  EXPECT_EQ("200", response_headers->getStatusValue());
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -1,6 +1,9 @@
+#include "source/common/http/header_map_arena.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
+#include "test/benchmark/allocation_budget.h"
+
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -21,10 +24,15 @@ static void addDummyHeaders(HeaderMap& headers, size_t num_headers,
 static void headerMapImplCreate(benchmark::State& state) {
   // Make sure first time construction is not counted.
   Http::ResponseHeaderMapImpl::create();
-  for (auto _ : state) { // NOLINT
+  auto create = []() {
     auto headers = Http::ResponseHeaderMapImpl::create();
     benchmark::DoNotOptimize(headers->size());
+  };
+  for (auto _ : state) { // NOLINT
+    create();
   }
+  // The map and its inline headers are a single allocation.
+  AllocationBudget(1, 4096).check(state, create);
 }
 BENCHMARK(headerMapImplCreate);
 
@@ -40,9 +48,12 @@ static void headerMapImplSetReference(benchmark::State& state) {
   const std::string value("01234567890123456789");
   auto headers = Http::ResponseHeaderMapImpl::create();
   addDummyHeaders(*headers, state.range(0));
+  auto set_reference = [&]() { headers->setReference(key, value); };
   for (auto _ : state) { // NOLINT
-    headers->setReference(key, value);
+    set_reference();
   }
+  // Setting a header that isn't inline replaces its entry.
+  AllocationBudget(1, 1024).check(state, set_reference);
   benchmark::DoNotOptimize(headers->size());
 }
 BENCHMARK(headerMapImplSetReference)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -62,9 +73,11 @@ static void headerMapImplGet(benchmark::State& state) {
   addDummyHeaders(*headers, state.range(0));
   headers->setReference(key, value);
   size_t successes = 0;
+  auto get = [&]() { successes += !headers->get(key).empty(); };
   for (auto _ : state) { // NOLINT
-    successes += !headers->get(key).empty();
+    get();
   }
+  AllocationBudget(0, 0).check(state, get);
   benchmark::DoNotOptimize(successes);
 }
 BENCHMARK(headerMapImplGet)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -79,9 +92,11 @@ static void headerMapImplGetInline(benchmark::State& state) {
   addDummyHeaders(*headers, state.range(0));
   headers->setReferenceConnection(value);
   size_t size = 0;
+  auto get = [&]() { size += headers->Connection()->value().size(); };
   for (auto _ : state) { // NOLINT
-    size += headers->Connection()->value().size();
+    get();
   }
+  AllocationBudget(0, 0).check(state, get);
   benchmark::DoNotOptimize(size);
 }
 BENCHMARK(headerMapImplGetInline)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -94,9 +109,11 @@ static void headerMapImplSetInlineMacro(benchmark::State& state) {
   const std::string value("01234567890123456789");
   auto headers = Http::ResponseHeaderMapImpl::create();
   addDummyHeaders(*headers, state.range(0));
+  auto set = [&]() { headers->setReferenceConnection(value); };
   for (auto _ : state) { // NOLINT
-    headers->setReferenceConnection(value);
+    set();
   }
+  AllocationBudget(0, 0).check(state, set);
   benchmark::DoNotOptimize(headers->size());
 }
 BENCHMARK(headerMapImplSetInlineMacro)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -109,9 +126,11 @@ static void headerMapImplSetInlineInteger(benchmark::State& state) {
   uint64_t value = 12345;
   auto headers = Http::ResponseHeaderMapImpl::create();
   addDummyHeaders(*headers, state.range(0));
+  auto set = [&]() { headers->setContentLength(value++); };
   for (auto _ : state) { // NOLINT
-    headers->setContentLength(value++);
+    set();
   }
+  AllocationBudget(0, 0).check(state, set);
   benchmark::DoNotOptimize(headers->size());
 }
 BENCHMARK(headerMapImplSetInlineInteger)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -121,9 +140,11 @@ static void headerMapImplGetByteSize(benchmark::State& state) {
   auto headers = Http::ResponseHeaderMapImpl::create();
   addDummyHeaders(*headers, state.range(0));
   uint64_t size = 0;
+  auto byte_size = [&]() { size += headers->byteSize(); };
   for (auto _ : state) { // NOLINT
-    size += headers->byteSize();
+    byte_size();
   }
+  AllocationBudget(0, 0).check(state, byte_size);
   benchmark::DoNotOptimize(size);
 }
 BENCHMARK(headerMapImplGetByteSize)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -137,9 +158,11 @@ static void headerMapImplIterate(benchmark::State& state) {
     num_callbacks++;
     return HeaderMap::Iterate::Continue;
   };
+  auto iterate = [&]() { headers->iterate(counting_callback); };
   for (auto _ : state) { // NOLINT
-    headers->iterate(counting_callback);
+    iterate();
   }
+  AllocationBudget(0, 0).check(state, iterate);
   benchmark::DoNotOptimize(num_callbacks);
 }
 BENCHMARK(headerMapImplIterate)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -154,10 +177,15 @@ static void headerMapImplRemove(benchmark::State& state) {
   const std::string value("01234567890123456789");
   auto headers = Http::ResponseHeaderMapImpl::create();
   addDummyHeaders(*headers, state.range(0));
-  for (auto _ : state) { // NOLINT
+  auto add_remove = [&]() {
     headers->addReference(key, value);
     headers->remove(key);
+  };
+  for (auto _ : state) { // NOLINT
+    add_remove();
   }
+  // The entry of the added header.
+  AllocationBudget(1, 1024).check(state, add_remove);
   benchmark::DoNotOptimize(headers->size());
 }
 BENCHMARK(headerMapImplRemove)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -173,10 +201,15 @@ static void headerMapImplRemoveInline(benchmark::State& state) {
   const std::string value("01234567890123456789");
   auto headers = Http::ResponseHeaderMapImpl::create();
   addDummyHeaders(*headers, state.range(0));
-  for (auto _ : state) { // NOLINT
+  auto add_remove = [&]() {
     headers->addReference(key, value);
     headers->remove(key);
+  };
+  for (auto _ : state) { // NOLINT
+    add_remove();
   }
+  // The entry of the added header.
+  AllocationBudget(1, 1024).check(state, add_remove);
   benchmark::DoNotOptimize(headers->size());
 }
 BENCHMARK(headerMapImplRemoveInline)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -198,13 +231,18 @@ static void headerMapImplPopulate(benchmark::State& state) {
       {LowerCaseString("set-cookie"), "_cookie1=12345678; path = /; secure"},
       {LowerCaseString("set-cookie"), "_cookie2=12345678; path = /; secure"},
   };
-  for (auto _ : state) { // NOLINT
+  auto populate = [&headers_to_add]() {
     auto headers = Http::ResponseHeaderMapImpl::create();
     for (const auto& key_value : headers_to_add) {
       headers->addReference(key_value.first, key_value.second);
     }
     benchmark::DoNotOptimize(headers->size());
+  };
+  for (auto _ : state) { // NOLINT
+    populate();
   }
+  // The map and the entries of the 10 headers.
+  AllocationBudget(11, 4096 + 10 * 1024).check(state, populate);
 }
 BENCHMARK(headerMapImplPopulate);
 
@@ -295,5 +333,88 @@ static void headerMapImplRemovePrefix(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplRemovePrefix)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
 
+/**
+ * Measure the cost of the header maps of a single stream: request headers decoded with a varying
+ * number of headers (set by the benchmark's argument) and a response with as many headers, both
+ * destroyed at the end of the stream. The second argument selects whether the maps are backed by
+ * a HeaderMapArena.
+ */
+static void headerMapImplStreamLifetime(benchmark::State& state) {
+  const size_t num_headers = state.range(0);
+  const bool use_arena = state.range(1) != 0;
+  std::vector<std::string> request_keys;
+  for (size_t i = 0; i < num_headers; i++) {
+    request_keys.push_back("x-request-header-" + std::to_string(i));
+  }
+  for (auto _ : state) { // NOLINT
+    HeaderMapArenaSharedPtr arena = use_arena ? std::make_shared<HeaderMapArena>() : nullptr;
+    auto request = Http::RequestHeaderMapImpl::create(arena);
+    // Emulate the codecs, which decode into owned header strings.
+    for (const std::string& request_key : request_keys) {
+      HeaderString key;
+      key.setCopy(request_key);
+      HeaderString value;
+      value.setCopy("abcd");
+      request->addViaMove(std::move(key), std::move(value));
+    }
+    auto response = Http::ResponseHeaderMapImpl::create(arena);
+    addDummyHeaders(*response, num_headers);
+    benchmark::DoNotOptimize(request->size() + response->size());
+  }
+}
+BENCHMARK(headerMapImplStreamLifetime)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({10, 0})
+    ->Args({10, 1})
+    ->Args({30, 0})
+    ->Args({30, 1})
+    ->Args({100, 0})
+    ->Args({100, 1});
+
+/**
+ * Measure decoding request headers, iterating over them twice and removing a header, as done by
+ * the connection manager for every request, with a varying number of headers (set by the first
+ * argument). The second argument selects the FlatVector layout instead of LinkedList.
+ */
+static void headerMapImplRequestLayout(benchmark::State& state) {
+  const size_t num_headers = state.range(0);
+  const HeaderMapLayout layout =
+      state.range(1) != 0 ? HeaderMapLayout::FlatVector : HeaderMapLayout::LinkedList;
+  std::vector<std::string> request_keys;
+  for (size_t i = 0; i < num_headers; i++) {
+    request_keys.push_back("x-request-header-" + std::to_string(i));
+  }
+  const LowerCaseString removed_key("x-request-header-0");
+  size_t total_size = 0;
+  auto sum_size = [&total_size](const HeaderEntry& header) -> HeaderMap::Iterate {
+    total_size += header.value().size();
+    return HeaderMap::Iterate::Continue;
+  };
+  for (auto _ : state) { // NOLINT
+    auto request = Http::RequestHeaderMapImpl::create(nullptr, layout);
+    for (const std::string& request_key : request_keys) {
+      HeaderString key;
+      key.setCopy(request_key);
+      HeaderString value;
+      value.setCopy("abcd");
+      request->addViaMove(std::move(key), std::move(value));
+    }
+    request->iterate(sum_size);
+    request->remove(removed_key);
+    request->iterate(sum_size);
+  }
+  benchmark::DoNotOptimize(total_size);
+}
+BENCHMARK(headerMapImplRequestLayout)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({10, 0})
+    ->Args({10, 1})
+    ->Args({30, 0})
+    ->Args({30, 1})
+    ->Args({100, 0})
+    ->Args({100, 1});
+
 } // namespace Http
 } // namespace Envoy
@@ -1104,5 +1104,60 @@ TEST(HeaderMapImplTest, HttpTraceContextTest) {
   }
 }
 
+// The flat vector layout must be indistinguishable from the linked list layout through the
+// HeaderMap interface.
+TEST(HeaderMapImplTest, FlatVectorLayout) {
+  auto headers = RequestHeaderMapImpl::create(nullptr, HeaderMapLayout::FlatVector);
+  for (int i = 0; i < 40; ++i) {
+    headers->addCopy(LowerCaseString("x-header-" + std::to_string(i)), "value");
+  }
+  headers->addCopy(LowerCaseString("hello"), "world");
+  headers->setMethod("GET");
+  headers->setPath("/");
+  headers->addCopy(LowerCaseString(":custom"), "pseudo");
+  EXPECT_EQ(44, headers->size());
+  EXPECT_EQ("/", headers->getPathValue());
+  EXPECT_EQ("world", headers->get(LowerCaseString("hello"))[0]->value().getStringView());
+  EXPECT_EQ("value", headers->get(LowerCaseString("x-header-7"))[0]->value().getStringView());
+
+  // Pseudo headers are kept in front of the other headers.
+  std::vector<std::string> keys;
+  headers->iterate([&keys](const HeaderEntry& header) -> HeaderMap::Iterate {
+    keys.emplace_back(header.key().getStringView());
+    return HeaderMap::Iterate::Continue;
+  });
+  EXPECT_EQ(":method", keys[0]);
+  EXPECT_EQ(":path", keys[1]);
+  EXPECT_EQ(":custom", keys[2]);
+  EXPECT_EQ("x-header-0", keys[3]);
+  EXPECT_EQ("hello", keys.back());
+
+  std::string last_key;
+  headers->iterateReverse([&last_key](const HeaderEntry& header) -> HeaderMap::Iterate {
+    last_key = std::string(header.key().getStringView());
+    return HeaderMap::Iterate::Break;
+  });
+  EXPECT_EQ("hello", last_key);
+
+  EXPECT_EQ(1, headers->remove(LowerCaseString("x-header-3")));
+  EXPECT_EQ(0, headers->remove(LowerCaseString("x-header-3")));
+  EXPECT_EQ(39, headers->removePrefix(LowerCaseString("x-header-")));
+  headers->removePath();
+  EXPECT_EQ(3, headers->size());
+  EXPECT_TRUE(headers->get(LowerCaseString("x-header-7")).empty());
+  EXPECT_EQ(nullptr, headers->Path());
+  EXPECT_EQ(7 + 3 + 5 + 5 + 7 + 6, headers->byteSize());
+  headers->verifyByteSizeInternalForTest();
+
+  auto copy = createHeaderMap<RequestHeaderMapImpl>(*headers);
+  EXPECT_EQ(*copy, *headers);
+
+  headers->clear();
+  EXPECT_TRUE(headers->empty());
+  EXPECT_EQ(nullptr, headers->Method());
+  headers->setMethod("POST");
+  EXPECT_EQ("POST", headers->getMethodValue());
+}
+
 } // namespace Http
 } // namespace Envoy
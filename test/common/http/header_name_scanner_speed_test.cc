@@ -0,0 +1,70 @@
+// Compares the header name validation of the envoy_default header validator before and after
+// vectorization. The argument is the length of the header name; most header names are shorter
+// than 32 bytes, and the names of some custom headers are longer.
+
+#include <string>
+
+#include "source/common/http/header_name_scanner.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+
+static std::string makeHeaderName(size_t length) {
+  static constexpr absl::string_view alphabet = "abcdefghijklmnopqrstuvwxyz0123456789-";
+  std::string name;
+  name.reserve(length);
+  for (size_t i = 0; i < length; ++i) {
+    name.push_back(alphabet[i % alphabet.size()]);
+  }
+  return name;
+}
+
+// The bit table lookup of the envoy_default header validator.
+static bool testChar(const uint32_t table[8], char c) {
+  uint8_t uc = static_cast<uint8_t>(c);
+  return (table[uc >> 5] & (0x80000000 >> (uc & 0x1f))) != 0;
+}
+
+static constexpr uint32_t GenericHeaderNameCharTable[] = {
+    0b00000000000000000000000000000000, 0b01011111001101101111111111000000,
+    0b01111111111111111111111111100011, 0b11111111111111111111111111101010,
+    0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
+};
+
+static void headerNameValidationBitTable(benchmark::State& state) {
+  const std::string name = makeHeaderName(state.range(0));
+  for (auto _ : state) { // NOLINT
+    bool is_valid = true;
+    for (auto iter = name.begin(); iter != name.end() && is_valid; ++iter) {
+      is_valid &= testChar(GenericHeaderNameCharTable, *iter);
+    }
+    benchmark::DoNotOptimize(is_valid);
+  }
+  state.SetBytesProcessed(state.iterations() * name.size());
+}
+BENCHMARK(headerNameValidationBitTable)->Arg(8)->Arg(16)->Arg(32)->Arg(128);
+
+static void headerNameValidationScalar(benchmark::State& state) {
+  const std::string name = makeHeaderName(state.range(0));
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(HeaderNameScanner::findFirstInvalidScalar(name));
+  }
+  state.SetBytesProcessed(state.iterations() * name.size());
+}
+BENCHMARK(headerNameValidationScalar)->Arg(8)->Arg(16)->Arg(32)->Arg(128);
+
+static void headerNameValidationVectorized(benchmark::State& state) {
+  const std::string name = makeHeaderName(state.range(0));
+  state.SetLabel(std::string(HeaderNameScanner::implementationName()));
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(HeaderNameScanner::findFirstInvalid(name));
+  }
+  state.SetBytesProcessed(state.iterations() * name.size());
+}
+BENCHMARK(headerNameValidationVectorized)->Arg(8)->Arg(16)->Arg(32)->Arg(128);
+
+} // namespace Http
+} // namespace Envoy
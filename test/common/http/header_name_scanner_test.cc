@@ -0,0 +1,82 @@
+#include <string>
+
+#include "source/common/http/header_name_scanner.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+bool isTokenChar(uint8_t c) {
+  return absl::ascii_isalnum(c) || absl::StrContains("!#$%&'*+-.^_`|~", static_cast<char>(c));
+}
+
+bool isLowercaseTokenChar(uint8_t c) { return isTokenChar(c) && !absl::ascii_isupper(c); }
+
+TEST(HeaderNameScannerTest, ImplementationName) {
+  EXPECT_FALSE(HeaderNameScanner::implementationName().empty());
+}
+
+TEST(HeaderNameScannerTest, Empty) {
+  EXPECT_EQ(0, HeaderNameScanner::findFirstInvalid(""));
+  EXPECT_EQ(0, HeaderNameScanner::findFirstInvalidLowercase(""));
+  EXPECT_TRUE(HeaderNameScanner::isValid(""));
+  EXPECT_TRUE(HeaderNameScanner::isValidLowercase(""));
+}
+
+TEST(HeaderNameScannerTest, CommonNames) {
+  for (absl::string_view name : {"content-type", "x-forwarded-for", "x_custom", "accept-encoding",
+                                 "x-envoy-upstream-service-time"}) {
+    EXPECT_TRUE(HeaderNameScanner::isValid(name)) << name;
+    EXPECT_TRUE(HeaderNameScanner::isValidLowercase(name)) << name;
+  }
+  EXPECT_TRUE(HeaderNameScanner::isValid("Content-Type"));
+  EXPECT_FALSE(HeaderNameScanner::isValidLowercase("Content-Type"));
+  EXPECT_FALSE(HeaderNameScanner::isValid("content type"));
+  EXPECT_FALSE(HeaderNameScanner::isValid("content-type:"));
+  EXPECT_FALSE(HeaderNameScanner::isValid(":path"));
+}
+
+// Every character is checked at every offset of names spanning several vector widths, so that
+// both the vectorized loop and the scalar tail are exercised.
+TEST(HeaderNameScannerTest, MatchesScalarForEveryCharacterAndOffset) {
+  for (size_t length = 1; length <= 100; ++length) {
+    const std::string valid(length, 'a');
+    ASSERT_EQ(length, HeaderNameScanner::findFirstInvalid(valid));
+    ASSERT_EQ(length, HeaderNameScanner::findFirstInvalidLowercase(valid));
+    for (size_t offset = 0; offset < length; ++offset) {
+      for (int c = 0; c < 256; ++c) {
+        std::string name = valid;
+        name[offset] = static_cast<char>(c);
+        const size_t expected = isTokenChar(c) ? length : offset;
+        ASSERT_EQ(expected, HeaderNameScanner::findFirstInvalidScalar(name))
+            << "length=" << length << " offset=" << offset << " c=" << c;
+        ASSERT_EQ(expected, HeaderNameScanner::findFirstInvalid(name))
+            << "length=" << length << " offset=" << offset << " c=" << c;
+        const size_t expected_lowercase = isLowercaseTokenChar(c) ? length : offset;
+        ASSERT_EQ(expected_lowercase, HeaderNameScanner::findFirstInvalidLowercaseScalar(name))
+            << "length=" << length << " offset=" << offset << " c=" << c;
+        ASSERT_EQ(expected_lowercase, HeaderNameScanner::findFirstInvalidLowercase(name))
+            << "length=" << length << " offset=" << offset << " c=" << c;
+      }
+    }
+  }
+}
+
+TEST(HeaderNameScannerTest, ReportsFirstOfSeveralInvalidCharacters) {
+  std::string name(64, 'a');
+  name[40] = ' ';
+  name[20] = ':';
+  name[50] = 'A';
+  EXPECT_EQ(20, HeaderNameScanner::findFirstInvalid(name));
+  name[10] = 'A';
+  EXPECT_EQ(20, HeaderNameScanner::findFirstInvalid(name));
+  EXPECT_EQ(10, HeaderNameScanner::findFirstInvalidLowercase(name));
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -1117,6 +1117,14 @@ TEST(HeaderIsValidTest, ValidHeaderValuesAreAccepted) {
   EXPECT_TRUE(HeaderUtility::headerValueIsValid("Some Other Value"));
 }
 
+TEST(HeaderIsValidTest, HeaderNameIsValid) {
+  EXPECT_TRUE(HeaderUtility::headerNameIsValid("x-custom_header"));
+  EXPECT_TRUE(HeaderUtility::headerNameIsValid("Content-Type"));
+  EXPECT_FALSE(HeaderUtility::headerNameIsValid("x custom"));
+  EXPECT_FALSE(HeaderUtility::headerNameIsValid("x-custom:"));
+  EXPECT_FALSE(HeaderUtility::headerNameIsValid("x-custom\r\n"));
+}
+
 TEST(HeaderIsValidTest, AuthorityIsValid) {
   EXPECT_TRUE(HeaderUtility::authorityIsValid("strangebutlegal$-%&'"));
   EXPECT_FALSE(HeaderUtility::authorityIsValid("illegal{}"));
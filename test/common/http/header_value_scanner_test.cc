@@ -0,0 +1,64 @@
+#include <string>
+
+#include "source/common/http/header_value_scanner.h"
+
+#include "gtest/gtest.h"
+#include "quiche/http2/adapter/header_validator.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+bool isAllowed(uint8_t c) { return c == '\t' || (c >= 0x20 && c != 0x7f); }
+
+TEST(HeaderValueScannerTest, ImplementationName) {
+  EXPECT_FALSE(HeaderValueScanner::implementationName().empty());
+}
+
+TEST(HeaderValueScannerTest, Empty) {
+  EXPECT_EQ(0, HeaderValueScanner::findFirstInvalid(""));
+  EXPECT_TRUE(HeaderValueScanner::isValid(""));
+}
+
+// Every character is checked at every offset of values spanning several vector widths, so that
+// both the vectorized loop and the scalar tail are exercised.
+TEST(HeaderValueScannerTest, MatchesScalarForEveryCharacterAndOffset) {
+  for (size_t length = 1; length <= 100; ++length) {
+    const std::string valid(length, 'a');
+    ASSERT_EQ(length, HeaderValueScanner::findFirstInvalid(valid));
+    for (size_t offset = 0; offset < length; ++offset) {
+      for (int c = 0; c < 256; ++c) {
+        std::string value = valid;
+        value[offset] = static_cast<char>(c);
+        const size_t expected = isAllowed(c) ? length : offset;
+        ASSERT_EQ(expected, HeaderValueScanner::findFirstInvalidScalar(value))
+            << "length=" << length << " offset=" << offset << " c=" << c;
+        ASSERT_EQ(expected, HeaderValueScanner::findFirstInvalid(value))
+            << "length=" << length << " offset=" << offset << " c=" << c;
+      }
+    }
+  }
+}
+
+TEST(HeaderValueScannerTest, ReportsFirstOfSeveralInvalidCharacters) {
+  std::string value(64, 'a');
+  value[40] = '\n';
+  value[20] = '\r';
+  value[50] = '\0';
+  EXPECT_EQ(20, HeaderValueScanner::findFirstInvalid(value));
+}
+
+// The previous implementation of HeaderUtility::headerValueIsValid().
+TEST(HeaderValueScannerTest, MatchesQuicheValidator) {
+  for (int c = 0; c < 256; ++c) {
+    const std::string value = std::string(33, 'x') + static_cast<char>(c);
+    EXPECT_EQ(http2::adapter::HeaderValidator::IsValidHeaderValue(
+                  value, http2::adapter::ObsTextOption::kAllow),
+              HeaderValueScanner::isValid(value))
+        << "c=" << c;
+  }
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,79 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/common/http/http1/codec_impl.h"
+
+#include "test/benchmark/allocation_budget.h"
+#include "test/benchmark/main.h"
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Http {
+
+// Serving a request and encoding a header-only response with as many headers as a typical
+// upstream response, which the codec serializes into a single reserved slice.
+static void http1ServerEncodeResponseHeaders(benchmark::State& state) {
+  Stats::TestUtil::TestStore store;
+  Http1::CodecStats::AtomicPtr stats;
+  Http1Settings settings;
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<MockServerConnectionCallbacks> callbacks;
+  NiceMock<MockRequestDecoder> decoder;
+  ResponseEncoder* encoder = nullptr;
+  ON_CALL(connection, write(_, _))
+      .WillByDefault(Invoke([](Buffer::Instance& data, bool) { data.drain(data.length()); }));
+  ON_CALL(callbacks, newStream(_, _))
+      .WillByDefault(Invoke([&](ResponseEncoder& response_encoder, bool) -> RequestDecoder& {
+        encoder = &response_encoder;
+        return decoder;
+      }));
+  Http1::ServerConnectionImpl codec(connection,
+                                    Http1::CodecStats::atomicGet(stats, *store.rootScope()),
+                                    callbacks, settings, Http::DEFAULT_MAX_REQUEST_HEADERS_KB,
+                                    Http::DEFAULT_MAX_HEADERS_COUNT,
+                                    envoy::config::core::v3::HttpProtocolOptions::ALLOW);
+
+  TestResponseHeaderMapImpl headers{{":status", "200"},
+                                    {"content-type", "application/json"},
+                                    {"content-length", "0"},
+                                    {"date", "Wed, 14 Oct 2026 00:00:00 GMT"},
+                                    {"server", "envoy"},
+                                    {"x-envoy-upstream-service-time", "12"},
+                                    {"cache-control", "no-cache, no-store, must-revalidate"},
+                                    {"vary", "accept-encoding"},
+                                    {"etag", "\"33a64df551425fcc55e4d42a148795d9f25f89d4\""},
+                                    {"x-request-id", "5b2c1e6a-2f7e-4b8c-9a3d-1f0e2d3c4b5a"}};
+  for (int i = 0; i < 10; i++) {
+    headers.addCopy(LowerCaseString(absl::StrCat("x-custom-header-", i)), "some value");
+  }
+  const auto serve = [&]() {
+    Buffer::OwnedImpl request("GET / HTTP/1.1\r\nhost: example.com\r\n\r\n");
+    const Http::Status status = codec.dispatch(request);
+    RELEASE_ASSERT(status.ok() && encoder != nullptr, "");
+    encoder->encodeHeaders(headers, true);
+    connection.dispatcher_.to_delete_.clear();
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    serve();
+  }
+  // The allocations are the request buffer, the stream and the request headers; encoding the
+  // response headers adds at most the slice they are written to.
+  AllocationBudget(40, 8192).check(state, serve);
+}
+BENCHMARK(http1ServerEncodeResponseHeaders);
+
+} // namespace Http
+} // namespace Envoy
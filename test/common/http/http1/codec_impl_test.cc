@@ -1664,6 +1664,32 @@ TEST_P(Http1ServerConnectionImplTest, HeaderOnlyResponse) {
   EXPECT_EQ(Protocol::Http11, codec_->protocol());
 }
 
+TEST_P(Http1ServerConnectionImplTest, ResponseStatusLines) {
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillRepeatedly(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+  for (const auto& [status, status_line] : std::vector<std::pair<std::string, std::string>>{
+           {"429", "HTTP/1.1 429 Too Many Requests\r\n"},
+           {"599", "HTTP/1.1 599 Unknown\r\n"},
+           {"503", "HTTP/1.1 503 Service Unavailable\r\n"}}) {
+    Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+    EXPECT_TRUE(codec_->dispatch(buffer).ok());
+    output.clear();
+    TestResponseHeaderMapImpl headers{{":status", status}};
+    response_encoder->encodeHeaders(headers, true);
+    EXPECT_EQ(status_line, output.substr(0, status_line.size()));
+  }
+}
+
 // As with Http1ClientConnectionImplTest.LargeHeaderRequestEncode but validate
 // the response encoder instead of request encoder.
 TEST_P(Http1ServerConnectionImplTest, LargeHeaderResponseEncode) {
@@ -2037,6 +2063,47 @@ TEST_P(Http1ServerConnectionImplTest, RequestWithTrailersDropped) { expectTraile
 
 TEST_P(Http1ServerConnectionImplTest, RequestWithTrailersKept) { expectTrailersTest(true); }
 
+// With header map arenas enabled the decoded headers and trailers stay valid after the codec moved
+// on to the next request.
+TEST_P(Http1ServerConnectionImplTest, HeaderMapArenaOutlivesRequest) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_header_map_arena", "true"}});
+  codec_settings_.enable_trailers_ = true;
+  initialize();
+
+  NiceMock<MockRequestDecoder> first_decoder;
+  NiceMock<MockRequestDecoder> second_decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return first_decoder;
+      }))
+      .WillOnce(ReturnRef(second_decoder));
+
+  RequestHeaderMapSharedPtr headers;
+  RequestTrailerMapPtr trailers;
+  EXPECT_CALL(first_decoder, decodeHeaders_(_, false))
+      .WillOnce(Invoke([&](RequestHeaderMapSharedPtr& decoded, bool) { headers = decoded; }));
+  EXPECT_CALL(first_decoder, decodeTrailers_(_))
+      .WillOnce(Invoke([&](RequestTrailerMapPtr& decoded) { trailers = std::move(decoded); }));
+
+  Buffer::OwnedImpl buffer("POST /first HTTP/1.1\r\ntransfer-encoding: chunked\r\n\r\n"
+                           "5\r\nHello\r\n"
+                           "0\r\nhello: world\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer).ok());
+  response_encoder->encodeHeaders(TestResponseHeaderMapImpl{{":status", "200"}}, true);
+  connection_.dispatcher_.clearDeferredDeleteList();
+
+  EXPECT_CALL(second_decoder, decodeHeaders_(_, true));
+  Buffer::OwnedImpl second_buffer("GET /second HTTP/1.1\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(second_buffer).ok());
+
+  EXPECT_EQ("/first", headers->getPathValue());
+  EXPECT_EQ("chunked", headers->getTransferEncodingValue());
+  EXPECT_EQ("world", trailers->get(LowerCaseString("hello"))[0]->value().getStringView());
+}
+
 TEST_P(Http1ServerConnectionImplTest, IgnoreUpgradeH2c) {
   initialize();
 
@@ -2100,6 +2167,28 @@ TEST_P(Http1ServerConnectionImplTest, UpgradeRequest) {
   EXPECT_TRUE(status.ok());
 }
 
+TEST_P(Http1ServerConnectionImplTest, UpgradeRequestParserNotReleased) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.http1_release_parser_on_upgrade", "false"}});
+  initialize();
+
+  InSequence sequence;
+  NiceMock<MockRequestDecoder> decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).WillOnce(ReturnRef(decoder));
+
+  EXPECT_CALL(decoder, decodeHeaders_(_, false));
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\nConnection: upgrade\r\nUpgrade: foo\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+
+  Buffer::OwnedImpl expected_data("abcd");
+  Buffer::OwnedImpl websocket_payload("abcd");
+  EXPECT_CALL(decoder, decodeData(BufferEqual(&expected_data), false));
+  status = codec_->dispatch(websocket_payload);
+  EXPECT_TRUE(status.ok());
+}
+
 TEST_P(Http1ServerConnectionImplTest, UpgradeRequestWithEarlyData) {
   initialize();
 
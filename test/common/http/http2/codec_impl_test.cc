@@ -551,6 +551,124 @@ TEST_P(Http2CodecImplTest, ShutdownNotice) {
   driveToCompletion();
 }
 
+// With write coalescing, frames submitted by streams outside of dispatch are sent once per event
+// loop iteration in a single write.
+TEST_P(Http2CodecImplTest, CoalescedWrites) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.http2_coalesce_writes", "true"}});
+  initialize();
+  auto* client_send_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&client_connection_.dispatcher_);
+  auto* server_send_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+
+  MockResponseDecoder response_decoder2;
+  RequestEncoder* request_encoder2 = &client_->newStream(response_decoder2);
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  Buffer::OwnedImpl request_body("hello");
+
+  EXPECT_CALL(client_connection_, write(_, _)).Times(0);
+  EXPECT_CALL(*client_send_callback, scheduleCallbackCurrentIteration());
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  request_encoder_->encodeData(request_body, true);
+  EXPECT_TRUE(request_encoder2->encodeHeaders(request_headers, true).ok());
+  testing::Mock::VerifyAndClearExpectations(&client_connection_);
+
+  EXPECT_CALL(client_connection_, write(_, _));
+  client_send_callback->invokeCallback();
+  testing::Mock::VerifyAndClearExpectations(&client_connection_);
+
+  std::vector<ResponseEncoder*> response_encoders;
+  EXPECT_CALL(server_callbacks_, newStream(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoders.push_back(&encoder);
+        return request_decoder_;
+      }));
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(request_decoder_, decodeData(_, true));
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  driveToCompletion();
+  ASSERT_EQ(2, response_encoders.size());
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(server_connection_, write(_, _)).Times(0);
+  EXPECT_CALL(*server_send_callback, scheduleCallbackCurrentIteration());
+  response_encoders[0]->encodeHeaders(response_headers, true);
+  response_encoders[1]->encodeHeaders(response_headers, true);
+  testing::Mock::VerifyAndClearExpectations(&server_connection_);
+
+  EXPECT_CALL(server_connection_, write(_, _));
+  server_send_callback->invokeCallback();
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, true));
+  EXPECT_CALL(response_decoder2, decodeHeaders_(_, true));
+  driveToCompletion();
+}
+
+// Connection level frames are not deferred, and also send the frames deferred by streams.
+TEST_P(Http2CodecImplTest, CoalescedWritesFlushedByGoAway) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.http2_coalesce_writes", "true"}});
+  initialize();
+  auto* server_send_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  auto* client_send_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&client_connection_.dispatcher_);
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  client_send_callback->invokeCallback();
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, true);
+  EXPECT_TRUE(server_send_callback->enabled());
+
+  EXPECT_CALL(server_connection_, write(_, _));
+  server_->goAway();
+  EXPECT_FALSE(server_send_callback->enabled());
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, true));
+  EXPECT_CALL(client_callbacks_, onGoAway(_));
+  driveToCompletion();
+}
+
+// The server advertises a larger HPACK table to a client that keeps sending the same headers.
+TEST_P(Http2CodecImplTest, HpackTableSizeTuning) {
+  server_http2_options_.mutable_hpack_table_size_tuning()->mutable_max_table_size()->set_value(
+      65536);
+  initialize();
+  EXPECT_EQ(4096, server_stats_store_
+                      .gauge("http2.hpack_table_size_advertised",
+                             Stats::Gauge::ImportMode::Accumulate)
+                      .value());
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  request_headers.addCopy("x-repeated", std::string(100, 'a'));
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true))
+      .Times(HpackTableSizeTuner::SampleHeaderBlocks);
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, true))
+      .Times(HpackTableSizeTuner::SampleHeaderBlocks);
+  for (uint32_t i = 0; i < HpackTableSizeTuner::SampleHeaderBlocks; ++i) {
+    RequestEncoder* request_encoder =
+        i == 0 ? request_encoder_ : &client_->newStream(response_decoder_);
+    EXPECT_TRUE(request_encoder->encodeHeaders(request_headers, true).ok());
+    driveToCompletion();
+    response_encoder_->encodeHeaders(response_headers, true);
+    driveToCompletion();
+  }
+
+  EXPECT_EQ(1, server_stats_store_.counter("http2.hpack_table_size_increased").value());
+  EXPECT_EQ(8192, server_stats_store_
+                      .gauge("http2.hpack_table_size_advertised",
+                             Stats::Gauge::ImportMode::Accumulate)
+                      .value());
+  EXPECT_TRUE(client_wrapper_->status_.ok());
+  EXPECT_TRUE(server_wrapper_->status_.ok());
+}
+
 TEST_P(Http2CodecImplTest, ProtocolErrorForTest) {
   initialize();
   EXPECT_EQ(absl::nullopt, request_encoder_->http1StreamEncoderOptions());
@@ -1885,6 +2003,34 @@ TEST_P(Http2CodecImplFlowControlTest, EarlyResetRestoresWindow) {
   EXPECT_EQ(initial_connection_window, getSendWindowSize(client_));
 }
 
+// The server grows the stream-level window it advertises once a bandwidth-delay product sample
+// shows that its initial window limits the client.
+TEST_P(Http2CodecImplFlowControlTest, AdaptiveFlowControl) {
+  server_http2_options_.mutable_adaptive_flow_control()
+      ->mutable_max_stream_window_size()
+      ->set_value(1024 * 1024);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  request_headers.setMethod("POST");
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+
+  const uint32_t initial_stream_window = getStreamReceiveWindowLimit(server_, 1);
+  ASSERT_EQ(65535, initial_stream_window);
+  EXPECT_CALL(request_decoder_, decodeData(_, false)).Times(AnyNumber());
+  Buffer::OwnedImpl data(std::string(60000, 'a'));
+  request_encoder_->encodeData(data, false);
+  driveToCompletion();
+
+  EXPECT_EQ(1, server_stats_store_.counter("http2.flow_control_window_increased").value());
+  EXPECT_EQ(120000, getStreamReceiveWindowLimit(server_, 1));
+  EXPECT_TRUE(client_wrapper_->status_.ok());
+  EXPECT_TRUE(server_wrapper_->status_.ok());
+}
+
 // Test the HTTP2 pending_recv_data_ buffer going over and under watermark limits.
 TEST_P(Http2CodecImplFlowControlTest, FlowControlInPendingRecvData) {
   initialize();
@@ -0,0 +1,116 @@
+#include "source/common/http/http2/flow_control_window_tuner.h"
+
+#include "test/common/stats/stat_test_utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+class FlowControlWindowTunerTest : public ::testing::Test {
+protected:
+  FlowControlWindowTunerTest() {
+    options_.mutable_initial_stream_window_size()->set_value(65536);
+    options_.mutable_initial_connection_window_size()->set_value(1048576);
+    options_.mutable_adaptive_flow_control()->mutable_max_stream_window_size()->set_value(1048576);
+  }
+
+  Http::Http2::CodecStats& http2CodecStats() {
+    return Http::Http2::CodecStats::atomicGet(http2_codec_stats_, *stats_store_.rootScope());
+  }
+
+  // Receives `bytes` of DATA between a sampling PING and its ACK.
+  absl::optional<FlowControlWindowTuner::WindowUpdate> sample(FlowControlWindowTuner& tuner,
+                                                               uint64_t bytes) {
+    EXPECT_TRUE(tuner.onData(bytes / 2));
+    EXPECT_FALSE(tuner.onData(bytes - bytes / 2));
+    return tuner.onPingAck();
+  }
+
+  envoy::config::core::v3::Http2ProtocolOptions options_;
+  Stats::TestUtil::TestStore stats_store_;
+  Http::Http2::CodecStats::AtomicPtr http2_codec_stats_;
+};
+
+TEST_F(FlowControlWindowTunerTest, InitialWindow) {
+  FlowControlWindowTuner tuner(http2CodecStats(), options_);
+  EXPECT_EQ(65536, tuner.streamWindowSize());
+}
+
+// A sample well below the window leaves the window unchanged.
+TEST_F(FlowControlWindowTunerTest, SmallSample) {
+  FlowControlWindowTuner tuner(http2CodecStats(), options_);
+  EXPECT_FALSE(sample(tuner, 16384).has_value());
+  EXPECT_EQ(65536, tuner.streamWindowSize());
+  EXPECT_EQ(0, stats_store_.counter("http2.flow_control_window_increased").value());
+}
+
+// A sample close to the window grows both windows, up to the configured maximum.
+TEST_F(FlowControlWindowTunerTest, Grow) {
+  FlowControlWindowTuner tuner(http2CodecStats(), options_);
+  absl::optional<FlowControlWindowTuner::WindowUpdate> update = sample(tuner, 60000);
+  ASSERT_TRUE(update.has_value());
+  EXPECT_EQ(120000, update->stream_window_size_);
+  EXPECT_EQ(120000 - 65536, update->connection_window_increment_);
+  EXPECT_EQ(120000, tuner.streamWindowSize());
+
+  update = sample(tuner, 800000);
+  ASSERT_TRUE(update.has_value());
+  EXPECT_EQ(1048576, update->stream_window_size_);
+  EXPECT_EQ(1048576 - 120000, update->connection_window_increment_);
+  EXPECT_EQ(2, stats_store_.counter("http2.flow_control_window_increased").value());
+
+  // No more samples are taken once the window is at its maximum.
+  EXPECT_FALSE(tuner.onData(1000));
+  EXPECT_FALSE(tuner.onPingAck().has_value());
+}
+
+// Receive buffers over their limit halve the stream-level window down to the initial window. The
+// connection-level window only grows again past the largest window advertised.
+TEST_F(FlowControlWindowTunerTest, ShrinkOnReceiveBufferOverLimit) {
+  FlowControlWindowTuner tuner(http2CodecStats(), options_);
+  EXPECT_FALSE(tuner.onReceiveBufferOverLimit().has_value());
+
+  ASSERT_TRUE(sample(tuner, 200000).has_value());
+  EXPECT_EQ(400000, tuner.streamWindowSize());
+
+  absl::optional<FlowControlWindowTuner::WindowUpdate> update = tuner.onReceiveBufferOverLimit();
+  ASSERT_TRUE(update.has_value());
+  EXPECT_EQ(200000, update->stream_window_size_);
+  EXPECT_EQ(0, update->connection_window_increment_);
+  update = tuner.onReceiveBufferOverLimit();
+  ASSERT_TRUE(update.has_value());
+  EXPECT_EQ(100000, update->stream_window_size_);
+  update = tuner.onReceiveBufferOverLimit();
+  ASSERT_TRUE(update.has_value());
+  EXPECT_EQ(65536, update->stream_window_size_);
+  EXPECT_FALSE(tuner.onReceiveBufferOverLimit().has_value());
+  EXPECT_EQ(3, stats_store_.counter("http2.flow_control_window_decreased").value());
+
+  update = sample(tuner, 250000);
+  ASSERT_TRUE(update.has_value());
+  EXPECT_EQ(500000, update->stream_window_size_);
+  EXPECT_EQ(100000, update->connection_window_increment_);
+}
+
+// The connection-level window doesn't grow past the largest window allowed by HTTP/2.
+TEST_F(FlowControlWindowTunerTest, ConnectionWindowLimit) {
+  options_.mutable_initial_connection_window_size()->set_value((1U << 31) - 1000);
+  FlowControlWindowTuner tuner(http2CodecStats(), options_);
+  absl::optional<FlowControlWindowTuner::WindowUpdate> update = sample(tuner, 60000);
+  ASSERT_TRUE(update.has_value());
+  EXPECT_EQ(120000, update->stream_window_size_);
+  EXPECT_EQ(999, update->connection_window_increment_);
+}
+
+// An unsolicited ACK doesn't complete a sample.
+TEST_F(FlowControlWindowTunerTest, UnsolicitedPingAck) {
+  FlowControlWindowTuner tuner(http2CodecStats(), options_);
+  EXPECT_FALSE(tuner.onPingAck().has_value());
+  EXPECT_TRUE(tuner.onData(1000));
+}
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,105 @@
+#include "source/common/http/http2/hpack_table_size_tuner.h"
+
+#include "test/common/stats/stat_test_utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+
+class HpackTableSizeTunerTest : public ::testing::Test {
+protected:
+  HpackTableSizeTunerTest() {
+    options_.mutable_hpack_table_size()->set_value(4096);
+    options_.mutable_hpack_table_size_tuning()->mutable_min_table_size()->set_value(1024);
+    options_.mutable_hpack_table_size_tuning()->mutable_max_table_size()->set_value(65536);
+  }
+
+  Http::Http2::CodecStats& http2CodecStats() {
+    return Http::Http2::CodecStats::atomicGet(http2_codec_stats_, *stats_store_.rootScope());
+  }
+
+  // Feeds one sampling window of header blocks that encode `decoded_bytes` per block into
+  // `wire_bytes` per block.
+  absl::optional<uint32_t> sampleWindow(HpackTableSizeTuner& tuner, uint64_t wire_bytes,
+                                        uint64_t decoded_bytes) {
+    absl::optional<uint32_t> table_size;
+    for (uint32_t i = 0; i < HpackTableSizeTuner::SampleHeaderBlocks; ++i) {
+      EXPECT_FALSE(table_size.has_value());
+      tuner.onHeaderBlockFragment(wire_bytes);
+      tuner.onHeader(decoded_bytes / 2, decoded_bytes - decoded_bytes / 2);
+      table_size = tuner.onHeaderBlockEnd();
+    }
+    return table_size;
+  }
+
+  uint64_t advertisedGauge() {
+    return stats_store_.gauge("http2.hpack_table_size_advertised",
+                              Stats::Gauge::ImportMode::Accumulate)
+        .value();
+  }
+
+  Stats::TestUtil::TestStore stats_store_;
+  Http::Http2::CodecStats::AtomicPtr http2_codec_stats_;
+  envoy::config::core::v3::Http2ProtocolOptions options_;
+};
+
+TEST_F(HpackTableSizeTunerTest, ClampsInitialTableSize) {
+  options_.mutable_hpack_table_size()->set_value(1 << 20);
+  HpackTableSizeTuner tuner(http2CodecStats(), options_);
+  EXPECT_EQ(65536, tuner.tableSize());
+  EXPECT_EQ(65536, advertisedGauge());
+}
+
+TEST_F(HpackTableSizeTunerTest, GrowsWhileCompressionImproves) {
+  HpackTableSizeTuner tuner(http2CodecStats(), options_);
+  EXPECT_EQ(8192, sampleWindow(tuner, 40, 100));
+  EXPECT_EQ(16384, sampleWindow(tuner, 20, 100));
+  // Growing did not help further.
+  EXPECT_EQ(absl::nullopt, sampleWindow(tuner, 18, 100));
+  EXPECT_EQ(16384, tuner.tableSize());
+  EXPECT_EQ(2, stats_store_.counter("http2.hpack_table_size_increased").value());
+  EXPECT_EQ(16384, advertisedGauge());
+}
+
+TEST_F(HpackTableSizeTunerTest, GrowsUpToMax) {
+  options_.mutable_hpack_table_size()->set_value(32768);
+  HpackTableSizeTuner tuner(http2CodecStats(), options_);
+  EXPECT_EQ(65536, sampleWindow(tuner, 40, 100));
+  EXPECT_EQ(absl::nullopt, sampleWindow(tuner, 20, 100));
+  EXPECT_EQ(65536, tuner.tableSize());
+}
+
+TEST_F(HpackTableSizeTunerTest, ShrinksDownToMin) {
+  HpackTableSizeTuner tuner(http2CodecStats(), options_);
+  EXPECT_EQ(2048, sampleWindow(tuner, 90, 100));
+  EXPECT_EQ(1024, sampleWindow(tuner, 90, 100));
+  EXPECT_EQ(absl::nullopt, sampleWindow(tuner, 90, 100));
+  EXPECT_EQ(2, stats_store_.counter("http2.hpack_table_size_decreased").value());
+  EXPECT_EQ(1024, advertisedGauge());
+
+  // The table grows again from the minimum once the peer reuses it.
+  EXPECT_EQ(4096, sampleWindow(tuner, 40, 100));
+}
+
+TEST_F(HpackTableSizeTunerTest, KeepsSizeForModerateCompression) {
+  HpackTableSizeTuner tuner(http2CodecStats(), options_);
+  EXPECT_EQ(absl::nullopt, sampleWindow(tuner, 65, 100));
+  EXPECT_EQ(absl::nullopt, sampleWindow(tuner, 0, 0));
+  EXPECT_EQ(4096, tuner.tableSize());
+}
+
+TEST_F(HpackTableSizeTunerTest, ReleasesGaugeOnDestruction) {
+  {
+    HpackTableSizeTuner tuner(http2CodecStats(), options_);
+    HpackTableSizeTuner other_tuner(http2CodecStats(), options_);
+    EXPECT_EQ(8192, sampleWindow(tuner, 40, 100));
+    EXPECT_EQ(8192 + 4096, advertisedGauge());
+  }
+  EXPECT_EQ(0, advertisedGauge());
+}
+
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
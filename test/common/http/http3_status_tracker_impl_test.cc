@@ -193,6 +193,45 @@ TEST_F(Http3StatusTrackerImplTest, MarkFailedRecentlyAndThenBroken) {
   EXPECT_FALSE(tracker_.hasHttp3FailedRecently());
 }
 
+TEST(Http3StatusTrackerImplMarkCallbackTest, MarksAreReported) {
+  NiceMock<Event::MockDispatcher> dispatcher;
+  new NiceMock<MockTimer>(&dispatcher);
+  std::vector<Http3StatusTrackerImpl::Mark> marks;
+  Http3StatusTrackerImpl tracker(
+      dispatcher, [&marks](Http3StatusTrackerImpl::Mark mark) { marks.push_back(mark); });
+
+  tracker.markHttp3Broken();
+  tracker.markHttp3FailedRecently();
+  tracker.markHttp3Confirmed();
+  EXPECT_EQ((std::vector<Http3StatusTrackerImpl::Mark>{Http3StatusTrackerImpl::Mark::Broken,
+                                                       Http3StatusTrackerImpl::Mark::FailedRecently,
+                                                       Http3StatusTrackerImpl::Mark::Confirmed}),
+            marks);
+}
+
+// Marks applied from another tracker have the same effect as local ones, but aren't reported.
+TEST(Http3StatusTrackerImplMarkCallbackTest, AppliedMarksAreNotReported) {
+  NiceMock<Event::MockDispatcher> dispatcher;
+  MockTimer* timer = new MockTimer(&dispatcher);
+  int reported = 0;
+  Http3StatusTrackerImpl tracker(dispatcher,
+                                 [&reported](Http3StatusTrackerImpl::Mark) { reported++; });
+
+  EXPECT_CALL(*timer, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(5 * 60 * 1000), nullptr));
+  tracker.applyMark(Http3StatusTrackerImpl::Mark::Broken);
+  EXPECT_TRUE(tracker.isHttp3Broken());
+
+  EXPECT_CALL(*timer, enabled()).WillOnce(Return(true));
+  EXPECT_CALL(*timer, disableTimer());
+  tracker.applyMark(Http3StatusTrackerImpl::Mark::Confirmed);
+  EXPECT_TRUE(tracker.isHttp3Confirmed());
+
+  tracker.applyMark(Http3StatusTrackerImpl::Mark::FailedRecently);
+  EXPECT_TRUE(tracker.hasHttp3FailedRecently());
+  EXPECT_EQ(0, reported);
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
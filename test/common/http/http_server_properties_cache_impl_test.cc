@@ -8,6 +8,7 @@
 
 using testing::Invoke;
 using testing::NiceMock;
+using testing::StrictMock;
 
 namespace Envoy {
 namespace Http {
@@ -15,6 +16,17 @@ namespace Http {
 namespace {
 
 static const absl::optional<std::chrono::seconds> kNoTtl = absl::nullopt;
+
+class MockUpdateCallbacks : public HttpServerPropertiesCacheImpl::UpdateCallbacks {
+public:
+  MOCK_METHOD(void, onAlternativesSet,
+              (const HttpServerPropertiesCache::Origin& origin,
+               const std::vector<HttpServerPropertiesCache::AlternateProtocol>& protocols));
+  MOCK_METHOD(void, onHttp3StatusMarked,
+              (const HttpServerPropertiesCache::Origin& origin,
+               Http3StatusTrackerImpl::Mark mark));
+};
+
 class HttpServerPropertiesCacheImplTest : public testing::Test {
 public:
   HttpServerPropertiesCacheImplTest()
@@ -373,6 +385,29 @@ TEST_F(HttpServerPropertiesCacheImplTest, GetOrCreateHttp3StatusTracker) {
   EXPECT_FALSE(protocols_->getOrCreateHttp3StatusTracker(origin1_).isHttp3Broken());
 }
 
+// Updates made on the cache are reported to the update callbacks, updates applied from the caches
+// of other workers aren't.
+TEST_F(HttpServerPropertiesCacheImplTest, UpdateCallbacks) {
+  initialize();
+  auto callbacks = std::make_unique<StrictMock<MockUpdateCallbacks>>();
+  StrictMock<MockUpdateCallbacks>& callbacks_ref = *callbacks;
+  protocols_->setUpdateCallbacks(std::move(callbacks));
+
+  EXPECT_CALL(callbacks_ref, onAlternativesSet(origin1_, protocols1_));
+  protocols_->setAlternatives(origin1_, protocols1_);
+  protocols_->applyAlternatives(origin2_, protocols2_);
+  EXPECT_EQ(protocols2_, protocols_->findAlternatives(origin2_).ref());
+
+  EXPECT_CALL(callbacks_ref, onHttp3StatusMarked(origin1_, Http3StatusTrackerImpl::Mark::Broken));
+  protocols_->getOrCreateHttp3StatusTracker(origin1_).markHttp3Broken();
+  protocols_->applyHttp3StatusMark(origin2_, Http3StatusTrackerImpl::Mark::Broken);
+  EXPECT_TRUE(protocols_->getOrCreateHttp3StatusTracker(origin2_).isHttp3Broken());
+
+  EXPECT_CALL(callbacks_ref,
+              onHttp3StatusMarked(origin2_, Http3StatusTrackerImpl::Mark::Confirmed));
+  protocols_->getOrCreateHttp3StatusTracker(origin2_).markHttp3Confirmed();
+}
+
 TEST_F(HttpServerPropertiesCacheImplTest, CanonicalSuffix) {
   std::string suffix = ".example.com";
   std::string host1 = "first.example.com";
@@ -5,9 +5,11 @@
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 
 #include "gtest/gtest.h"
 
+using testing::_;
 using testing::Return;
 
 namespace Envoy {
@@ -125,6 +127,41 @@ TEST_F(HttpServerPropertiesCacheManagerTest, GetCacheForConflictingOptions) {
       "options specified alternate protocols cache 'name1' with different settings.*");
 }
 
+// With more than one worker, the updates made on a cache are posted to the main thread, which
+// applies them to the caches of the other threads.
+TEST_F(HttpServerPropertiesCacheManagerTest, ShareUpdatesAcrossWorkers) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.share_http_server_properties_across_workers", "true"}});
+  context_.options_.concurrency_ = 2;
+  initialize();
+  HttpServerPropertiesCacheSharedPtr cache = manager_->getCache(options1_, dispatcher_);
+
+  const HttpServerPropertiesCacheImpl::Origin origin = {"https", "hostname", 1};
+  std::vector<HttpServerPropertiesCacheImpl::AlternateProtocol> protocols = {
+      {"h3", "hostname", 1, dispatcher_.timeSource().monotonicTime() + std::chrono::hours(1)}};
+  EXPECT_CALL(context_.dispatcher_, post(_));
+  EXPECT_CALL(tls_, runOnAllThreads(_));
+  cache->setAlternatives(origin, protocols);
+
+  EXPECT_CALL(context_.dispatcher_, post(_));
+  EXPECT_CALL(tls_, runOnAllThreads(_));
+  cache->getOrCreateHttp3StatusTracker(origin).markHttp3FailedRecently();
+  EXPECT_TRUE(cache->getOrCreateHttp3StatusTracker(origin).hasHttp3FailedRecently());
+}
+
+TEST_F(HttpServerPropertiesCacheManagerTest, DoNotShareUpdatesWithSingleWorker) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.share_http_server_properties_across_workers", "true"}});
+  initialize();
+  HttpServerPropertiesCacheSharedPtr cache = manager_->getCache(options1_, dispatcher_);
+
+  const HttpServerPropertiesCacheImpl::Origin origin = {"https", "hostname", 1};
+  EXPECT_CALL(context_.dispatcher_, post(_)).Times(0);
+  cache->getOrCreateHttp3StatusTracker(origin).markHttp3FailedRecently();
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
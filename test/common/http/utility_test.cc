@@ -6,6 +6,7 @@
 #include "envoy/config/core/v3/protocol.pb.h"
 #include "envoy/config/core/v3/protocol.pb.validate.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/fmt.h"
 #include "source/common/http/exception.h"
 #include "source/common/http/header_map_impl.h"
@@ -547,6 +548,28 @@ initial_connection_window_size: 65535
   }
 }
 
+TEST(HttpUtility, ValidateHpackTableSizeTuning) {
+  const std::string yaml = R"EOF(
+hpack_table_size_tuning:
+  min_table_size: 8192
+  max_table_size: 4096
+  )EOF";
+  EXPECT_THROW_WITH_MESSAGE(
+      parseHttp2OptionsFromV3Yaml(yaml), EnvoyException,
+      "the HPACK table size tuning min_table_size must not be larger than max_table_size");
+}
+
+TEST(HttpUtility, ValidateAdaptiveFlowControl) {
+  const std::string yaml = R"EOF(
+initial_stream_window_size: 1048576
+adaptive_flow_control:
+  max_stream_window_size: 65536
+  )EOF";
+  EXPECT_THROW_WITH_MESSAGE(parseHttp2OptionsFromV3Yaml(yaml), EnvoyException,
+                            "the adaptive flow control max_stream_window_size must not be smaller "
+                            "than initial_stream_window_size");
+}
+
 TEST(HttpUtility, ValidateStreamErrors) {
   // Both false, the result should be false.
   envoy::config::core::v3::Http2ProtocolOptions http2_options;
@@ -909,6 +932,27 @@ TEST(HttpUtility, SendLocalReply) {
       Utility::LocalReplyData{false, Http::Code::PayloadTooLarge, "large", absl::nullopt, false});
 }
 
+// Bodies larger than a slice are moved into the buffer rather than copied.
+TEST(HttpUtility, SendLocalReplyLargeBody) {
+  MockStreamDecoderFilterCallbacks callbacks;
+  bool is_reset = false;
+  const std::string body(3 * Buffer::Slice::default_slice_size_, 'a');
+
+  EXPECT_CALL(callbacks, encodeHeaders_(_, false))
+      .WillOnce(Invoke([&](const ResponseHeaderMap& headers, bool) -> void {
+        EXPECT_EQ(std::to_string(body.size()), headers.getContentLengthValue());
+      }));
+  EXPECT_CALL(callbacks, encodeData(_, true))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) -> void {
+        EXPECT_EQ(1, data.getRawSlices().size());
+        EXPECT_EQ(body, data.toString());
+      }));
+  EXPECT_CALL(callbacks, streamInfo());
+  sendLocalReplyTestHelper(
+      is_reset, callbacks,
+      Utility::LocalReplyData{false, Http::Code::OK, body, absl::nullopt, false});
+}
+
 TEST(HttpUtility, SendLocalGrpcReply) {
   MockStreamDecoderFilterCallbacks callbacks;
   bool is_reset = false;
@@ -1,10 +1,12 @@
 #include "source/common/init/manager_impl.h"
 
 #include "test/mocks/init/mocks.h"
+#include "test/test_common/simulated_time_system.h"
 
 #include "gtest/gtest.h"
 
 using ::testing::InSequence;
+using ::testing::MockFunction;
 
 namespace Envoy {
 namespace Init {
@@ -120,6 +122,42 @@ TEST(InitManagerImplTest, AddImmediateTargetWhenInitializing) {
   expectInitialized(m);
 }
 
+// Tracked targets are measured from when the manager started initializing them.
+TEST(InitManagerImplTest, TrackTargetDurations) {
+  Event::SimulatedTimeSystem time_system;
+  MockFunction<void(absl::string_view, std::chrono::milliseconds)> target_ready;
+
+  ManagerImpl m("test");
+  m.trackTargetDurations(time_system, target_ready.AsStdFunction());
+
+  ExpectableTargetImpl t1("t1");
+  m.add(t1);
+  ExpectableTargetImpl t2("t2");
+  m.add(t2);
+
+  ExpectableWatcherImpl w;
+  t1.expectInitialize();
+  t2.expectInitialize();
+  m.initialize(w);
+
+  time_system.advanceTimeWait(std::chrono::milliseconds(10));
+  ExpectableTargetImpl t3("t3");
+  t3.expectInitialize();
+  m.add(t3);
+
+  time_system.advanceTimeWait(std::chrono::milliseconds(20));
+  EXPECT_CALL(target_ready, Call("target t2", std::chrono::milliseconds(30)));
+  t2.ready();
+  EXPECT_CALL(target_ready, Call("target t3", std::chrono::milliseconds(20)));
+  t3.ready();
+
+  time_system.advanceTimeWait(std::chrono::milliseconds(5));
+  EXPECT_CALL(target_ready, Call("target t1", std::chrono::milliseconds(35)));
+  w.expectReady();
+  t1.ready();
+  expectInitialized(m);
+}
+
 TEST(InitManagerImplTest, UnavailableTarget) {
   InSequence s;
 
@@ -0,0 +1,145 @@
+#include <sys/socket.h>
+
+#include "source/common/io/io_uring_worker_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+class TestRequest : public IoUringRequest {
+public:
+  void onCompletion(int32_t result) override { results_.push_back(result); }
+
+  std::vector<int32_t> results_;
+};
+
+class IoUringWorkerImplTest : public ::testing::Test {
+public:
+  IoUringWorkerImplTest() : api_(Api::createApiForTest()) {
+    if (isIoUringSupported()) {
+      dispatcher_ = api_->allocateDispatcher("test_thread");
+      worker_ = std::make_unique<IoUringWorkerImpl>(8, false, *dispatcher_);
+      RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds_) == 0, "");
+    } else {
+      should_skip_ = true;
+    }
+  }
+
+  ~IoUringWorkerImplTest() override {
+    worker_.reset();
+    if (!should_skip_) {
+      ::close(fds_[0]);
+      ::close(fds_[1]);
+    }
+  }
+
+  void SetUp() override {
+    if (should_skip_) {
+      GTEST_SKIP();
+    }
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  std::unique_ptr<IoUringWorkerImpl> worker_;
+  int fds_[2]{};
+  bool should_skip_{};
+};
+
+TEST_F(IoUringWorkerImplTest, SubmitsOncePerLoopIteration) {
+  char data[] = "hello";
+  struct iovec write_iov {
+    data, 5
+  };
+  TestRequest first;
+  TestRequest second;
+  EXPECT_EQ(IoUringResult::Ok, worker_->submitWritev(fds_[0], &write_iov, 1, first));
+  EXPECT_EQ(IoUringResult::Ok, worker_->submitWritev(fds_[0], &write_iov, 1, second));
+
+  // Nothing reaches the kernel until the event loop runs.
+  char buffer[16];
+  EXPECT_EQ(-1, ::recv(fds_[1], buffer, sizeof(buffer), MSG_DONTWAIT));
+
+  while (first.results_.empty() || second.results_.empty()) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  EXPECT_EQ(std::vector<int32_t>{5}, first.results_);
+  EXPECT_EQ(std::vector<int32_t>{5}, second.results_);
+  EXPECT_EQ(10, ::recv(fds_[1], buffer, sizeof(buffer), MSG_DONTWAIT));
+}
+
+TEST_F(IoUringWorkerImplTest, ReadvAndCancel) {
+  char buffer[16];
+  struct iovec read_iov {
+    buffer, sizeof(buffer)
+  };
+  TestRequest read;
+  TestRequest cancel;
+  EXPECT_EQ(IoUringResult::Ok, worker_->submitReadv(fds_[1], &read_iov, 1, read));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_TRUE(read.results_.empty());
+
+  EXPECT_EQ(IoUringResult::Ok, worker_->submitCancel(read, cancel));
+  while (read.results_.empty() || cancel.results_.empty()) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  EXPECT_EQ(std::vector<int32_t>{-ECANCELED}, read.results_);
+  EXPECT_EQ(std::vector<int32_t>{0}, cancel.results_);
+}
+
+TEST_F(IoUringWorkerImplTest, QueueOverflowFlushesSubmissions) {
+  char data[] = "a";
+  struct iovec write_iov {
+    data, 1
+  };
+  // More requests than the ring has entries for.
+  std::vector<TestRequest> requests(20);
+  for (auto& request : requests) {
+    EXPECT_EQ(IoUringResult::Ok, worker_->submitWritev(fds_[0], &write_iov, 1, request));
+  }
+  auto done = [&requests]() {
+    for (const auto& request : requests) {
+      if (request.results_.empty()) {
+        return false;
+      }
+    }
+    return true;
+  };
+  while (!done()) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+}
+
+class TestSocket : public IoUringSocket {
+public:
+  explicit TestSocket(bool& destroyed) : destroyed_(destroyed) {}
+  ~TestSocket() override { destroyed_ = true; }
+
+  bool& destroyed_;
+};
+
+TEST_F(IoUringWorkerImplTest, AdoptedSocketIsDeferredDeleted) {
+  bool destroyed = false;
+  auto socket = std::make_unique<TestSocket>(destroyed);
+  TestSocket& ref = *socket;
+  worker_->adoptSocket(std::move(socket));
+  worker_->destroySocket(ref);
+  EXPECT_FALSE(destroyed);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_TRUE(destroyed);
+}
+
+TEST_F(IoUringWorkerImplTest, AdoptedSocketsDestroyedWithWorker) {
+  bool destroyed = false;
+  worker_->adoptSocket(std::make_unique<TestSocket>(destroyed));
+  worker_.reset();
+  EXPECT_TRUE(destroyed);
+}
+
+} // namespace
+} // namespace Io
+} // namespace Envoy
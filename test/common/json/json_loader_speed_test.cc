@@ -0,0 +1,50 @@
+#include <string>
+
+#include "source/common/json/json_internal.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+// NOLINT(namespace-envoy)
+
+namespace {
+
+// Returns a document shaped like a large config: an array of objects, each with a few scalars and
+// nested objects.
+std::string makeDocument(int64_t entries) {
+  std::string json = "{\"resources\": [";
+  for (int64_t i = 0; i < entries; i++) {
+    absl::StrAppend(&json, i == 0 ? "" : ",", "{\"name\": \"cluster_", i,
+                    "\", \"connect_timeout\": 0.25, \"lb_policy\": \"ROUND_ROBIN\", "
+                    "\"load_assignment\": {\"endpoints\": [{\"lb_endpoints\": [{\"endpoint\": "
+                    "{\"address\": {\"socket_address\": {\"address\": \"10.0.0.1\", "
+                    "\"port_value\": ",
+                    i % 65536, "}}}}]}]}, \"tags\": [\"a\", \"b\", \"c\"]}");
+  }
+  absl::StrAppend(&json, "]}");
+  return json;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_LoadFromString(benchmark::State& state) {
+  const std::string json = makeDocument(state.range(0));
+
+  for (auto _ : state) { // NOLINT
+    Envoy::Json::ObjectSharedPtr object = Envoy::Json::Nlohmann::Factory::loadFromString(json);
+    benchmark::DoNotOptimize(object->getObjectArray("resources")[0]->getString("name"));
+  }
+}
+BENCHMARK(BM_LoadFromString)->Arg(100)->Arg(10000);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_LoadFromStringLazy(benchmark::State& state) {
+  const std::string json = makeDocument(state.range(0));
+
+  for (auto _ : state) { // NOLINT
+    Envoy::Json::ObjectSharedPtr object = Envoy::Json::Nlohmann::Factory::loadFromStringLazy(json);
+    benchmark::DoNotOptimize(object->getObjectArray("resources")[0]->getString("name"));
+  }
+}
+BENCHMARK(BM_LoadFromStringLazy)->Arg(100)->Arg(10000);
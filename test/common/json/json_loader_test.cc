@@ -1,9 +1,11 @@
 #include <string>
 #include <vector>
 
+#include "source/common/json/json_internal.h"
 #include "source/common/json/json_loader.h"
 #include "source/common/stats/isolated_store_impl.h"
 
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -346,6 +348,90 @@ TEST_F(JsonLoaderTest, AsString) {
   });
 }
 
+class LazyJsonLoaderTest : public testing::Test {
+protected:
+  LazyJsonLoaderTest() {
+    scoped_runtime_.mergeValues({{"envoy.reloadable_features.lazy_json_loader", "true"}});
+  }
+
+  TestScopedRuntime scoped_runtime_;
+};
+
+TEST_F(LazyJsonLoaderTest, Basic) {
+  EXPECT_THROW(Factory::loadFromString("{"), Exception);
+
+  ObjectSharedPtr json = Factory::loadFromString(R"EOF(
+    {
+      "integer": 123,
+      "double": 1.5,
+      "boolean": true,
+      "string": "value",
+      "strings": ["a", "b"],
+      "objects": [{"name": "first"}, {"name": "second"}],
+      "object": {"nested": {"leaf": 1}}
+    }
+    )EOF");
+  EXPECT_TRUE(json->isObject());
+  EXPECT_FALSE(json->empty());
+  EXPECT_EQ(123, json->getInteger("integer"));
+  EXPECT_EQ(42, json->getInteger("missing", 42));
+  EXPECT_EQ(1.5, json->getDouble("double"));
+  EXPECT_TRUE(json->getBoolean("boolean"));
+  EXPECT_EQ("value", json->getString("string"));
+  EXPECT_EQ("default", json->getString("missing", "default"));
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), json->getStringArray("strings"));
+  EXPECT_TRUE(json->getStringArray("missing", true).empty());
+
+  std::vector<ObjectSharedPtr> objects = json->getObjectArray("objects");
+  ASSERT_EQ(2, objects.size());
+  EXPECT_EQ("second", objects[1]->getString("name"));
+  EXPECT_TRUE(json->getObjectArray("missing", true).empty());
+
+  ObjectSharedPtr nested = json->getObject("object")->getObject("nested");
+  // The nested objects keep the document alive.
+  json.reset();
+  EXPECT_EQ(1, nested->getInteger("leaf"));
+  EXPECT_TRUE(nested->getObject("missing", true)->empty());
+}
+
+TEST_F(LazyJsonLoaderTest, Errors) {
+  ObjectSharedPtr json =
+      Factory::loadFromString("{\"hello\": 123, \"strings\": [\"a\", 1], \"big\": "
+                              "9223372036854775808}");
+  EXPECT_THROW_WITH_MESSAGE(json->getString("hello"), Exception,
+                            "key 'hello' missing or not a string");
+  EXPECT_THROW_WITH_MESSAGE(json->getObject("hello"), Exception, "key 'hello' not an object");
+  EXPECT_THROW_WITH_MESSAGE(json->getObject("world"), Exception, "key 'world' missing");
+  EXPECT_THROW(json->getDouble("hello"), Exception);
+  EXPECT_THROW(json->getBoolean("hello"), Exception);
+  EXPECT_THROW(json->getObjectArray("hello", true), Exception);
+  EXPECT_THROW_WITH_MESSAGE(json->getStringArray("strings"), Exception,
+                            "JSON array 'strings' does not contain all strings");
+  EXPECT_THROW_WITH_MESSAGE(json->getInteger("big"), Exception,
+                            "key 'big' is larger than int64_t (not supported)");
+  EXPECT_THROW(json->asObjectArray(), Exception);
+  EXPECT_THROW(json->asString(), Exception);
+  EXPECT_THROW_WITH_MESSAGE(json->validateSchema(""), Exception, "not implemented");
+}
+
+// Verifies that both loaders serialize and hash the same documents the same way.
+TEST_F(LazyJsonLoaderTest, SameAsEagerLoader) {
+  const std::string json_string =
+      "{\"b\": [1.5, 22, \"cat\", null, {\"y\": false, \"x\": true}], \"a\": {\"c\": 3}}";
+  ObjectSharedPtr lazy = Factory::loadFromString(json_string);
+  ObjectSharedPtr eager = Nlohmann::Factory::loadFromString(json_string);
+  EXPECT_EQ(eager->asJsonString(), lazy->asJsonString());
+  EXPECT_EQ(eager->hash(), lazy->hash());
+
+  std::vector<std::string> keys;
+  lazy->iterate([&keys](const std::string& key, const Object& value) {
+    keys.push_back(key);
+    EXPECT_EQ(key == "b", value.isArray());
+    return false;
+  });
+  EXPECT_EQ(std::vector<std::string>{"a"}, keys);
+}
+
 } // namespace
 } // namespace Json
 } // namespace Envoy
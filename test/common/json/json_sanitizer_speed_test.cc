@@ -50,3 +50,34 @@ static void BM_NlohmannWithEscape(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_NlohmannWithEscape);
+
+// A string longer than a few vectors, such as a URL or user agent in an access log.
+constexpr absl::string_view long_pass_through_encoding =
+    "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/108.0 "
+    "Safari/537.36 https://www.example.com/some/long/path?with=query&parameters=true";
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_NeedsSlowSanitizerScalar(benchmark::State& state) {
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Envoy::Json::needsSlowSanitizerScalar(long_pass_through_encoding));
+  }
+}
+BENCHMARK(BM_NeedsSlowSanitizerScalar);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_NeedsSlowSanitizer(benchmark::State& state) {
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Envoy::Json::needsSlowSanitizer(long_pass_through_encoding));
+  }
+}
+BENCHMARK(BM_NeedsSlowSanitizer);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_NlohmannLongNoEscape(benchmark::State& state) {
+  std::string buffer;
+
+  for (auto _ : state) { // NOLINT
+    Envoy::Json::sanitize(buffer, long_pass_through_encoding);
+  }
+}
+BENCHMARK(BM_NlohmannLongNoEscape);
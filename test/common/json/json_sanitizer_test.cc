@@ -291,6 +291,23 @@ TEST_F(JsonSanitizerTest, InvalidUtf8) {
   EXPECT_FALSE(TestUtil::isProtoSerializableUtf8("\020\377\377\376\000"));
 }
 
+// Verifies that the vectorized scan agrees with the byte-at-a-time one for any character at any
+// position, including the remainders shorter than a vector.
+TEST_F(JsonSanitizerTest, NeedsSlowSanitizerMatchesScalar) {
+  for (size_t size = 1; size <= 70; ++size) {
+    std::string str(size, 'a');
+    EXPECT_FALSE(needsSlowSanitizer(str));
+    for (size_t position = 0; position < size; ++position) {
+      for (uint32_t c = 0; c < 256; ++c) {
+        str[position] = static_cast<char>(c);
+        ASSERT_EQ(needsSlowSanitizerScalar(str), needsSlowSanitizer(str))
+            << "size=" << size << " position=" << position << " c=" << c;
+      }
+      str[position] = 'a';
+    }
+  }
+}
+
 } // namespace
 } // namespace Json
 } // namespace Envoy
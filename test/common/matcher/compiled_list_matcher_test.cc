@@ -0,0 +1,110 @@
+#include "envoy/matcher/matcher.h"
+
+#include "source/common/matcher/compiled_list_matcher.h"
+
+#include "test/common/matcher/test_utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Matcher {
+namespace {
+
+// A TestInput that counts how many times it is read.
+struct CountingInput : public TestInput {
+  CountingInput(DataInputGetResult result, uint32_t& gets) : TestInput(result), gets_(gets) {}
+  DataInputGetResult get(const TestData& data) const override {
+    gets_++;
+    return TestInput::get(data);
+  }
+
+  uint32_t& gets_;
+};
+
+class CompiledListMatcherTest : public ::testing::Test {
+public:
+  using Op = FieldPredicateInstruction::Op;
+
+  // Creates a list matcher reading a single input, which evaluates the predicates of program.
+  std::unique_ptr<CompiledListMatcher<TestData>>
+  createMatcher(FieldPredicateProgram program, std::vector<bool> input_matcher_results,
+                DataInputGetResult::DataAvailability availability =
+                    DataInputGetResult::DataAvailability::AllDataAvailable) {
+    std::vector<DataInputPtr<TestData>> data_inputs;
+    data_inputs.push_back(
+        std::make_unique<CountingInput>(DataInputGetResult{availability, "string"}, gets_));
+    std::vector<InputMatcherPtr> input_matchers;
+    for (const bool result : input_matcher_results) {
+      input_matchers.push_back(std::make_unique<BoolMatcher>(result));
+    }
+    return std::make_unique<CompiledListMatcher<TestData>>(
+        std::move(data_inputs), std::move(input_matchers),
+        std::make_shared<const FieldPredicateProgram>(std::move(program)),
+        stringOnMatch<TestData>("no_match"));
+  }
+
+  uint32_t gets_{};
+};
+
+TEST_F(CompiledListMatcherTest, SingleInputReadOnce) {
+  // Two matchers, each a single predicate on the same input.
+  auto matcher = createMatcher({{Op::Single, 0, 0, 1}, {Op::Single, 0, 1, 2}}, {false, true});
+  matcher->addMatcher(0, stringOnMatch<TestData>("first"));
+  matcher->addMatcher(1, stringOnMatch<TestData>("second"));
+
+  verifyImmediateMatch(matcher->match(TestData()), "second");
+  EXPECT_EQ(1, gets_);
+}
+
+TEST_F(CompiledListMatcherTest, AllAnyNot) {
+  // all(any(not(true), false), true)
+  auto matcher = createMatcher({{Op::All, 0, 0, 6},
+                                {Op::Any, 0, 0, 5},
+                                {Op::Not, 0, 0, 4},
+                                {Op::Single, 0, 0, 4},
+                                {Op::Single, 0, 1, 5},
+                                {Op::Single, 0, 2, 6},
+                                // not(false)
+                                {Op::Not, 0, 0, 8},
+                                {Op::Single, 0, 1, 8}},
+                               {true, false, true});
+  matcher->addMatcher(0, stringOnMatch<TestData>("all"));
+  matcher->addMatcher(6, stringOnMatch<TestData>("not"));
+
+  verifyImmediateMatch(matcher->match(TestData()), "not");
+  EXPECT_EQ(1, gets_);
+}
+
+TEST_F(CompiledListMatcherTest, NoMatch) {
+  auto matcher = createMatcher({{Op::Any, 0, 0, 3}, {Op::Single, 0, 0, 2}, {Op::Single, 0, 0, 3}},
+                               {false});
+  matcher->addMatcher(0, stringOnMatch<TestData>("any"));
+
+  verifyImmediateMatch(matcher->match(TestData()), "no_match");
+}
+
+TEST_F(CompiledListMatcherTest, MissingData) {
+  auto matcher = createMatcher({{Op::Not, 0, 0, 2}, {Op::Single, 0, 0, 2}}, {true},
+                               DataInputGetResult::DataAvailability::NotAvailable);
+  matcher->addMatcher(0, stringOnMatch<TestData>("not"));
+
+  EXPECT_EQ(matcher->match(TestData()).match_state_, MatchState::UnableToMatch);
+}
+
+TEST_F(CompiledListMatcherTest, MoreDataMightBeAvailable) {
+  // Any predicate that doesn't match yet defers the result, unless another one matches.
+  auto matcher = createMatcher({{Op::Any, 0, 0, 3}, {Op::Single, 0, 0, 2}, {Op::Single, 0, 1, 3}},
+                               {false, true},
+                               DataInputGetResult::DataAvailability::MoreDataMightBeAvailable);
+  matcher->addMatcher(0, stringOnMatch<TestData>("any"));
+  verifyImmediateMatch(matcher->match(TestData()), "any");
+
+  matcher = createMatcher({{Op::Single, 0, 0, 1}}, {false},
+                          DataInputGetResult::DataAvailability::MoreDataMightBeAvailable);
+  matcher->addMatcher(0, stringOnMatch<TestData>("single"));
+  EXPECT_EQ(matcher->match(TestData()).match_state_, MatchState::UnableToMatch);
+}
+
+} // namespace
+} // namespace Matcher
+} // namespace Envoy
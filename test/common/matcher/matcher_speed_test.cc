@@ -0,0 +1,90 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+#include <vector>
+
+#include "source/common/matcher/compiled_list_matcher.h"
+#include "source/common/matcher/list_matcher.h"
+
+#include "test/common/matcher/test_utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Matcher {
+namespace {
+
+// Each matcher is the conjunction of a few predicates reading the same input.
+constexpr uint32_t PredicatesPerMatcher = 4;
+
+DataInputPtr<TestData> createInput() {
+  return std::make_unique<TestInput>(
+      DataInputGetResult{DataInputGetResult::DataAvailability::AllDataAvailable, "value"});
+}
+
+// Only the last predicate of the last matcher decides the match, so that every predicate is
+// evaluated.
+InputMatcherPtr createInputMatcher(uint32_t matcher, uint32_t predicate, uint32_t matchers) {
+  return std::make_unique<BoolMatcher>(predicate + 1 < PredicatesPerMatcher ||
+                                       matcher + 1 == matchers);
+}
+
+std::unique_ptr<MatchTree<TestData>> createListMatcher(uint32_t matchers) {
+  auto list_matcher = std::make_unique<ListMatcher<TestData>>(absl::nullopt);
+  for (uint32_t i = 0; i < matchers; i++) {
+    std::vector<FieldMatcherPtr<TestData>> predicates;
+    for (uint32_t j = 0; j < PredicatesPerMatcher; j++) {
+      predicates.push_back(std::make_unique<SingleFieldMatcher<TestData>>(
+          createInput(), createInputMatcher(i, j, matchers)));
+    }
+    list_matcher->addMatcher(std::make_unique<AllFieldMatcher<TestData>>(std::move(predicates)),
+                             stringOnMatch<TestData>("match"));
+  }
+  return list_matcher;
+}
+
+// The same matchers, compiled like MatchTreeFactory does: the inputs are deduplicated.
+std::unique_ptr<MatchTree<TestData>> createCompiledListMatcher(uint32_t matchers) {
+  std::vector<DataInputPtr<TestData>> data_inputs;
+  data_inputs.push_back(createInput());
+  std::vector<InputMatcherPtr> input_matchers;
+  FieldPredicateProgram program;
+  std::vector<uint32_t> predicates;
+  for (uint32_t i = 0; i < matchers; i++) {
+    const uint32_t pc = program.size();
+    predicates.push_back(pc);
+    program.push_back({FieldPredicateInstruction::Op::All, 0, 0, pc + 1 + PredicatesPerMatcher});
+    for (uint32_t j = 0; j < PredicatesPerMatcher; j++) {
+      input_matchers.push_back(createInputMatcher(i, j, matchers));
+      program.push_back({FieldPredicateInstruction::Op::Single, 0,
+                         static_cast<uint32_t>(input_matchers.size() - 1), pc + 2 + j});
+    }
+  }
+
+  auto list_matcher = std::make_unique<CompiledListMatcher<TestData>>(
+      std::move(data_inputs), std::move(input_matchers),
+      std::make_shared<const FieldPredicateProgram>(std::move(program)), absl::nullopt);
+  for (const uint32_t predicate : predicates) {
+    list_matcher->addMatcher(predicate, stringOnMatch<TestData>("match"));
+  }
+  return list_matcher;
+}
+
+template <bool compiled> void bmListMatcher(benchmark::State& state) {
+  const uint32_t matchers = state.range(0);
+  auto list_matcher = compiled ? createCompiledListMatcher(matchers) : createListMatcher(matchers);
+  uint64_t matches = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    matches += list_matcher->match(TestData()).on_match_.has_value();
+  }
+  benchmark::DoNotOptimize(matches);
+}
+
+BENCHMARK_TEMPLATE(bmListMatcher, false)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK_TEMPLATE(bmListMatcher, true)->RangeMultiplier(4)->Range(1, 64);
+
+} // namespace
+} // namespace Matcher
+} // namespace Envoy
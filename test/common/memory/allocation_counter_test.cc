@@ -0,0 +1,48 @@
+#include <memory>
+#include <vector>
+
+#include "source/common/memory/allocation_counter.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+TEST(AllocationCounterTest, CountsAllocations) {
+  std::vector<std::unique_ptr<char[]>> allocations;
+  allocations.reserve(3);
+  const absl::optional<AllocationCounter::Allocations> counted =
+      AllocationCounter::count([&allocations]() {
+        for (int i = 0; i < 3; i++) {
+          allocations.push_back(std::make_unique<char[]>(1000));
+        }
+      });
+  if (!AllocationCounter::supported()) {
+    EXPECT_FALSE(counted.has_value());
+    return;
+  }
+  ASSERT_TRUE(counted.has_value());
+  // With every allocation sampled the estimates are exact, up to the rounding of their weights.
+  EXPECT_GE(counted->count_, 3);
+  EXPECT_GE(counted->bytes_, 3000);
+}
+
+TEST(AllocationCounterTest, NoAllocations) {
+  int sum = 0;
+  const absl::optional<AllocationCounter::Allocations> counted =
+      AllocationCounter::count([&sum]() {
+        for (int i = 0; i < 3; i++) {
+          sum += i;
+        }
+      });
+  EXPECT_EQ(3, sum);
+  if (AllocationCounter::supported()) {
+    ASSERT_TRUE(counted.has_value());
+    EXPECT_EQ(0, counted->count_);
+  }
+}
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
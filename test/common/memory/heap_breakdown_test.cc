@@ -0,0 +1,57 @@
+#include <memory>
+#include <vector>
+
+#include "source/common/memory/heap_breakdown.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+TEST(HeapBreakdownTest, ClassifiesByInnermostMatchingFrame) {
+  const std::vector<HeapBreakdown::Rule>& rules = HeapBreakdown::defaultRules();
+  std::vector<absl::string_view> stack{"operator new()", "std::vector<>::reserve()",
+                                       "Envoy::Buffer::OwnedImpl::add()",
+                                       "Envoy::Network::ConnectionImpl::onRead()"};
+  EXPECT_EQ("buffers", HeapBreakdown::classify(stack, rules));
+
+  stack = {"operator new()", "Envoy::Upstream::ClusterManagerImpl::addOrUpdateCluster()",
+           "Envoy::Stats::ThreadLocalStoreImpl::counterFromString()"};
+  EXPECT_EQ("clusters", HeapBreakdown::classify(stack, rules));
+
+  stack = {"operator new()", "Envoy::Router::ConfigImpl::ConfigImpl()"};
+  EXPECT_EQ("routes", HeapBreakdown::classify(stack, rules));
+}
+
+TEST(HeapBreakdownTest, UnmatchedStacksAreOther) {
+  std::vector<absl::string_view> stack{"operator new()", "main", ""};
+  EXPECT_EQ(HeapBreakdown::OtherSubsystem,
+            HeapBreakdown::classify(stack, HeapBreakdown::defaultRules()));
+  EXPECT_EQ(HeapBreakdown::OtherSubsystem, HeapBreakdown::classify({}, {}));
+}
+
+TEST(HeapBreakdownTest, CustomRules) {
+  const std::vector<HeapBreakdown::Rule> rules{{"lua", "lua_"}};
+  std::vector<absl::string_view> stack{"operator new()", "lua_newstate"};
+  EXPECT_EQ("lua", HeapBreakdown::classify(stack, rules));
+}
+
+TEST(HeapBreakdownTest, SampledBytes) {
+  // Keep a large allocation live, so that it is likely to be sampled.
+  auto allocation = std::make_unique<std::vector<char>>(16 * 1024 * 1024);
+  const auto bytes = HeapBreakdown::sampledBytesBySubsystem(HeapBreakdown::defaultRules());
+  if (!HeapBreakdown::supported()) {
+    EXPECT_TRUE(bytes.empty());
+    return;
+  }
+  uint64_t total = 0;
+  for (const auto& subsystem : bytes) {
+    total += subsystem.second;
+  }
+  EXPECT_GT(total, 0);
+}
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
@@ -1,3 +1,4 @@
+#include "source/common/common/free_list.h"
 #include "source/common/event/dispatcher_impl.h"
 #include "source/common/memory/heap_shrinker.h"
 #include "source/common/memory/stats.h"
@@ -61,9 +62,12 @@ TEST_F(HeapShrinkerTest, ShrinkWhenTriggered) {
 
   Envoy::Stats::Counter& shrink_count =
       stats_.counter("overload.envoy.overload_actions.shrink_heap.shrink_count");
+  const uint64_t free_list_generation = ThreadLocalFreeLists::generation();
   action_cb(Server::OverloadActionState::saturated());
   step();
   EXPECT_EQ(1, shrink_count.value());
+  // The free lists of the threads are asked to release their blocks.
+  EXPECT_NE(free_list_generation, ThreadLocalFreeLists::generation());
 
   const uint64_t physical_mem_after_shrink =
       Stats::totalCurrentlyReserved() - Stats::totalPageHeapUnmapped();
@@ -83,6 +87,46 @@ TEST_F(HeapShrinkerTest, ShrinkWhenTriggered) {
   EXPECT_EQ(2, shrink_count.value());
 }
 
+TEST_F(HeapShrinkerTest, ShrinkGraduallyWhenScaled) {
+  Server::OverloadActionCb action_cb;
+  EXPECT_CALL(overload_manager_, registerForAction(_, _, _))
+      .WillOnce(Invoke([&](const std::string&, Event::Dispatcher&, Server::OverloadActionCb cb) {
+        action_cb = cb;
+        return true;
+      }));
+
+  HeapShrinker h(dispatcher_, overload_manager_, *stats_.rootScope());
+
+  auto data = std::make_unique<char[]>(5000000);
+  const uint64_t physical_mem_before_shrink =
+      Stats::totalCurrentlyReserved() - Stats::totalPageHeapUnmapped();
+  data.reset();
+
+  Envoy::Stats::Counter& shrink_count =
+      stats_.counter("overload.envoy.overload_actions.shrink_heap.shrink_count");
+  Envoy::Stats::Counter& released_bytes =
+      stats_.counter("overload.envoy.overload_actions.shrink_heap.released_bytes");
+  action_cb(Server::OverloadActionState(UnitFloat(0.5)));
+  step();
+  // Only full releases are counted as shrinks.
+  EXPECT_EQ(0, shrink_count.value());
+
+  const uint64_t physical_mem_after_shrink =
+      Stats::totalCurrentlyReserved() - Stats::totalPageHeapUnmapped();
+#if defined(TCMALLOC) || defined(GPERFTOOLS_TCMALLOC)
+  EXPECT_GE(physical_mem_before_shrink, physical_mem_after_shrink);
+#else
+  EXPECT_EQ(physical_mem_before_shrink, physical_mem_after_shrink);
+  EXPECT_EQ(0, released_bytes.value());
+#endif
+
+  action_cb(Server::OverloadActionState::inactive());
+  const uint64_t released_before_inactive = released_bytes.value();
+  step();
+  EXPECT_EQ(released_before_inactive, released_bytes.value());
+  EXPECT_EQ(0, shrink_count.value());
+}
+
 } // namespace
 } // namespace Memory
 } // namespace Envoy
@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "source/common/common/fmt.h"
 #include "source/common/network/address_impl.h"
 
@@ -35,6 +37,56 @@ static void ipv6InstanceCreate(benchmark::State& state) {
 }
 BENCHMARK(ipv6InstanceCreate);
 
+// The names of an address are formatted on first use, this measures creating and printing one.
+static void ipv4InstanceCreateAndFormat(benchmark::State& state) {
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(443);
+  static constexpr uint32_t Addr = 0xc00002ff; // From the RFC 5737 example range.
+  addr.sin_addr.s_addr = htonl(Addr);
+  for (auto _ : state) {
+    Ipv4Instance address(&addr);
+    benchmark::DoNotOptimize(address.asString().size());
+  }
+}
+BENCHMARK(ipv4InstanceCreateAndFormat);
+
+static void ipv6InstanceCreateAndFormat(benchmark::State& state) {
+  sockaddr_in6 addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin6_family = AF_INET6;
+  addr.sin6_port = htons(443);
+  static const char* Addr = "2001:DB8::1234"; // From the RFC 3849 example range.
+  inet_pton(AF_INET6, Addr, &addr.sin6_addr);
+  for (auto _ : state) {
+    Ipv6Instance address(addr);
+    benchmark::DoNotOptimize(address.asString().size());
+  }
+}
+BENCHMARK(ipv6InstanceCreateAndFormat);
+
+// Interns the addresses of datagrams from state.range(0) peers taking turns, as a UDP listener
+// sees them. 1024 peers are more than the table holds.
+static void instanceInternTableIntern(benchmark::State& state) {
+  std::vector<sockaddr_storage> peers(state.range(0));
+  for (size_t i = 0; i < peers.size(); i++) {
+    memset(&peers[i], 0, sizeof(peers[i]));
+    auto& addr = reinterpret_cast<sockaddr_in&>(peers[i]);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(10000 + i);
+    addr.sin_addr.s_addr = htonl(0xc0000200 + i % 256); // From the RFC 5737 example range.
+  }
+  InstanceInternTable table;
+  size_t i = 0;
+  for (auto _ : state) {
+    InstanceConstSharedPtr address = table.intern(peers[i], sizeof(sockaddr_in), -1);
+    benchmark::DoNotOptimize(address.get());
+    i = (i + 1) % peers.size();
+  }
+}
+BENCHMARK(instanceInternTableIntern)->Arg(1)->Arg(16)->Arg(1024);
+
 } // namespace Address
 } // namespace Network
 } // namespace Envoy
@@ -164,6 +164,22 @@ TEST(Ipv4InstanceTest, SocketAddress) {
   EXPECT_EQ(nullptr, address.envoyInternalAddress());
 }
 
+// The names of an address are formatted once, on first use.
+TEST(Ipv4InstanceTest, FriendlyNamesFormattedOnFirstUse) {
+  sockaddr_in addr4;
+  memset(&addr4, 0, sizeof(addr4));
+  addr4.sin_family = AF_INET;
+  EXPECT_EQ(1, inet_pton(AF_INET, "255.255.255.254", &addr4.sin_addr));
+  addr4.sin_port = htons(65535);
+
+  Ipv4Instance address(&addr4);
+  const std::string& address_as_string = address.ip()->addressAsString();
+  EXPECT_EQ("255.255.255.254", address_as_string);
+  EXPECT_EQ("255.255.255.254:65535", address.asString());
+  EXPECT_EQ(&address_as_string, &address.ip()->addressAsString());
+  EXPECT_EQ(address.asString().data(), address.asStringView().data());
+}
+
 TEST(Ipv4InstanceTest, AddressOnly) {
   Ipv4Instance address("3.4.5.6");
   EXPECT_EQ("3.4.5.6:0", address.asString());
@@ -571,6 +587,78 @@ TEST(AddressFromSockAddrDeathTest, Pipe) {
 #endif
 }
 
+TEST(InstanceInternTableTest, Ipv4) {
+  sockaddr_storage ss;
+  memset(&ss, 0, sizeof(ss));
+  auto& sin = reinterpret_cast<sockaddr_in&>(ss);
+  sin.sin_family = AF_INET;
+  EXPECT_EQ(1, inet_pton(AF_INET, "1.2.3.4", &sin.sin_addr));
+  sin.sin_port = htons(6502);
+
+  InstanceInternTable table;
+  const InstanceConstSharedPtr address = table.intern(ss, sizeof(sockaddr_in), -1);
+  EXPECT_EQ("1.2.3.4:6502", address->asString());
+  EXPECT_EQ(address, table.intern(ss, sizeof(sockaddr_in), -1));
+
+  sin.sin_port = htons(6503);
+  const InstanceConstSharedPtr other_port = table.intern(ss, sizeof(sockaddr_in), -1);
+  EXPECT_EQ("1.2.3.4:6503", other_port->asString());
+  EXPECT_EQ(other_port, table.intern(ss, sizeof(sockaddr_in), -1));
+
+  // A length of 0 isn't validated against the address, so such addresses aren't interned.
+  EXPECT_NE(other_port, table.intern(ss, 0, -1));
+  EXPECT_EQ("1.2.3.4:6503", table.intern(ss, 0, -1)->asString());
+}
+
+TEST(InstanceInternTableTest, Ipv6) {
+  sockaddr_storage ss;
+  memset(&ss, 0, sizeof(ss));
+  auto& sin6 = reinterpret_cast<sockaddr_in6&>(ss);
+  sin6.sin6_family = AF_INET6;
+  EXPECT_EQ(1, inet_pton(AF_INET6, "1:23::ef", &sin6.sin6_addr));
+  sin6.sin6_port = htons(32000);
+
+  InstanceInternTable table;
+  const InstanceConstSharedPtr address = table.intern(ss, sizeof(sockaddr_in6), -1);
+  EXPECT_EQ("[1:23::ef]:32000", address->asString());
+  EXPECT_EQ(address, table.intern(ss, sizeof(sockaddr_in6), -1));
+
+  sin6.sin6_scope_id = 1;
+  EXPECT_EQ("[1:23::ef%1]:32000", table.intern(ss, sizeof(sockaddr_in6), -1)->asString());
+}
+
+TEST(InstanceInternTableTest, Pipe) {
+  sockaddr_storage ss;
+  memset(&ss, 0, sizeof(ss));
+  auto& sun = reinterpret_cast<sockaddr_un&>(ss);
+  sun.sun_family = AF_UNIX;
+  StringUtil::strlcpy(sun.sun_path, "/some/path", sizeof sun.sun_path);
+  const socklen_t ss_len = offsetof(struct sockaddr_un, sun_path) + 1 + strlen(sun.sun_path);
+
+  InstanceInternTable table;
+  const InstanceConstSharedPtr address = table.intern(ss, ss_len, -1);
+  EXPECT_EQ("/some/path", address->asString());
+  EXPECT_NE(address, table.intern(ss, ss_len, -1));
+}
+
+// More addresses than the table holds replace each other, but are still the addresses asked for.
+TEST(InstanceInternTableTest, Replacement) {
+  sockaddr_storage ss;
+  memset(&ss, 0, sizeof(ss));
+  auto& sin = reinterpret_cast<sockaddr_in&>(ss);
+  sin.sin_family = AF_INET;
+  EXPECT_EQ(1, inet_pton(AF_INET, "1.2.3.4", &sin.sin_addr));
+
+  InstanceInternTable table;
+  for (int round = 0; round < 2; round++) {
+    for (uint16_t port = 1; port <= 1000; port++) {
+      sin.sin_port = htons(port);
+      EXPECT_EQ(absl::StrCat("1.2.3.4:", port),
+                table.intern(ss, sizeof(sockaddr_in), -1)->asString());
+    }
+  }
+}
+
 // Test comparisons between all the different (known) test classes.
 struct TestCase {
   enum InstanceType { Ipv4, Ipv6, Pipe, Internal };
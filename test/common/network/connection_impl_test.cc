@@ -4,12 +4,14 @@
 
 #include "envoy/common/platform.h"
 #include "envoy/config/core/v3/base.pb.h"
+#include "envoy/config/overload/v3/overload.pb.h"
 #include "envoy/event/scaled_range_timer_manager.h"
 #include "envoy/network/address.h"
 #include "envoy/network/listener.h"
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/utility.h"
@@ -158,7 +160,8 @@ protected:
       dispatcher_ = api_->allocateDispatcher("test_thread");
     }
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(address);
-    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false,
+                                            Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
     client_connection_ = std::make_unique<Network::TestClientConnectionImpl>(
         *dispatcher_, socket_->connectionInfoProvider().localAddress(), source_address_,
         createTransportSocket(), socket_options_, transport_socket_options_);
@@ -219,6 +222,7 @@ protected:
 
     MockBufferFactory* factory = new StrictMock<MockBufferFactory>;
     dispatcher_ = api_->allocateDispatcher("test_thread", Buffer::WatermarkFactoryPtr{factory});
+    EXPECT_CALL(*factory, createConnectionAccount(_)).Times(AnyNumber());
     // The first call to create a client session will get a MockBuffer.
     // Other calls for server sessions will by default get a normal OwnedImpl.
     EXPECT_CALL(*factory, createBuffer_(_, _, _))
@@ -343,6 +347,41 @@ TEST_P(ConnectionImplTest, GetCongestionWindow) {
   disconnect(true);
 }
 
+// When connections are tracked, the data held in the buffers of a connection is charged to its
+// account, which closes the connection under memory pressure.
+TEST_P(ConnectionImplTest, CloseConnectionUsingExcessiveMemory) {
+  envoy::config::overload::v3::BufferFactoryConfig config;
+  config.set_minimum_account_to_track_power_of_two(10);
+  config.set_track_connections(true);
+  auto* factory = new Buffer::WatermarkBufferFactory(config);
+  dispatcher_ = api_->allocateDispatcher("test_thread", Buffer::WatermarkFactoryPtr{factory});
+  setUpBasicConnection();
+  connect();
+
+  // The slices read by the server connection stay charged to its account while held.
+  Buffer::OwnedImpl held_data;
+  EXPECT_CALL(*read_filter_, onData(_, false))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) -> FilterStatus {
+        held_data.move(data);
+        dispatcher_->exit();
+        return FilterStatus::StopIteration;
+      }));
+  Buffer::OwnedImpl data(std::string(4096, 'a'));
+  client_connection_->write(data, false);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(0, factory->closeConnectionsGivenPressure(0.0));
+
+  EXPECT_CALL(server_callbacks_, onEvent(ConnectionEvent::LocalClose));
+  EXPECT_EQ(1, factory->closeConnectionsGivenPressure(1.0));
+  EXPECT_EQ(server_connection_->state(), Connection::State::Closed);
+  EXPECT_EQ(server_connection_->localCloseReason(),
+            StreamInfo::LocalCloseReasons::get().OverloadManagerCloseHighMemoryConnection);
+
+  EXPECT_CALL(client_callbacks_, onEvent(ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { dispatcher_->exit(); }));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
 TEST_P(ConnectionImplTest, CloseDuringConnectCallback) {
   setUpBasicConnection();
 
@@ -1426,7 +1465,8 @@ TEST_P(ConnectionImplTest, BindFailureTest) {
   dispatcher_ = api_->allocateDispatcher("test_thread");
   socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(GetParam()));
-  listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+  listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false,
+                                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   client_connection_ = dispatcher_->createClientConnection(
       socket_->connectionInfoProvider().localAddress(), source_address_,
@@ -2913,7 +2953,8 @@ public:
     dispatcher_ = api_->allocateDispatcher("test_thread");
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
         Network::Test::getCanonicalLoopbackAddress(GetParam()));
-    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false,
+                                            Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
     client_connection_ = dispatcher_->createClientConnection(
         socket_->connectionInfoProvider().localAddress(),
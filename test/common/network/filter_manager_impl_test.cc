@@ -111,6 +111,23 @@ TEST_F(NetworkFilterManagerTest, All) {
   manager.onWrite();
 }
 
+TEST_F(NetworkFilterManagerTest, NumFilters) {
+  FilterManagerImpl manager(connection_, socket_);
+  EXPECT_EQ(0U, manager.numReadFilters());
+  EXPECT_EQ(0U, manager.numWriteFilters());
+
+  ReadFilterSharedPtr read_filter(new MockReadFilter());
+  manager.addReadFilter(read_filter);
+  manager.addWriteFilter(WriteFilterSharedPtr{new MockWriteFilter()});
+  manager.addFilter(FilterSharedPtr{new LocalMockFilter()});
+  EXPECT_EQ(2U, manager.numReadFilters());
+  EXPECT_EQ(2U, manager.numWriteFilters());
+
+  manager.removeReadFilter(read_filter);
+  EXPECT_EQ(1U, manager.numReadFilters());
+  EXPECT_EQ(2U, manager.numWriteFilters());
+}
+
 TEST_F(NetworkFilterManagerTest, ConnectionClosedBeforeRunningFilter) {
   InSequence s;
 
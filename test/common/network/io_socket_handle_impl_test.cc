@@ -171,6 +171,23 @@ TEST_P(IoSocketHandleImplTest, InterfaceNameForLoopback) {
   }
 }
 
+// The datagrams of a peer share its address.
+TEST_P(IoSocketHandleImplTest, ReceivedAddressesAreInterned) {
+  Network::Test::UdpSyncPeer server(GetParam());
+  Network::Test::UdpSyncPeer client(GetParam());
+  client.write("hello", *server.localAddress());
+  client.write("world", *server.localAddress());
+
+  Network::UdpRecvData first;
+  server.recv(first);
+  Network::UdpRecvData second;
+  server.recv(second);
+  EXPECT_EQ(first.buffer_->toString(), "hello");
+  EXPECT_EQ(second.buffer_->toString(), "world");
+  EXPECT_EQ(*client.localAddress(), *first.addresses_.peer_);
+  EXPECT_EQ(first.addresses_.peer_, second.addresses_.peer_);
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
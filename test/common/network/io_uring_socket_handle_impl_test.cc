@@ -0,0 +1,216 @@
+#include <sys/socket.h>
+
+#include "envoy/extensions/network/socket_interface/v3/default_socket_interface.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_uring_socket_handle_impl.h"
+#include "source/common/network/socket_interface_impl.h"
+#include "source/common/thread_local/thread_local_impl.h"
+
+#include "test/mocks/server/instance.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class IoUringSocketHandleImplTest : public ::testing::Test {
+public:
+  IoUringSocketHandleImplTest() : api_(Api::createApiForTest()) {
+    if (!Io::isIoUringSupported()) {
+      should_skip_ = true;
+      return;
+    }
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+    tls_.registerThread(*dispatcher_, true);
+    factory_ = std::make_unique<Io::IoUringWorkerFactoryImpl>(16, false, tls_);
+    factory_->onServerInitialized();
+    int fds[2];
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0, "");
+    handle_ = std::make_unique<IoUringSocketHandleImpl>(*factory_, 8192, fds[0]);
+    peer_fd_ = fds[1];
+  }
+
+  ~IoUringSocketHandleImplTest() override {
+    if (should_skip_) {
+      tls_.shutdownGlobalThreading();
+      tls_.shutdownThread();
+      return;
+    }
+    handle_.reset();
+    if (peer_fd_ >= 0) {
+      ::close(peer_fd_);
+    }
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    tls_.shutdownGlobalThreading();
+    tls_.shutdownThread();
+    factory_.reset();
+  }
+
+  void SetUp() override {
+    if (should_skip_) {
+      GTEST_SKIP();
+    }
+  }
+
+  void initializeFileEvent(uint32_t events) {
+    handle_->initializeFileEvent(
+        *dispatcher_, [this](uint32_t events) { events_ |= events; },
+        Event::FileTriggerType::Edge, events);
+  }
+
+  void runUntil(std::function<bool()> condition) {
+    while (!condition()) {
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+
+  std::string readPeer() {
+    char buffer[4096];
+    std::string result;
+    ssize_t rc;
+    while ((rc = ::recv(peer_fd_, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+      result.append(buffer, rc);
+    }
+    return result;
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  ThreadLocal::InstanceImpl tls_;
+  std::unique_ptr<Io::IoUringWorkerFactoryImpl> factory_;
+  std::unique_ptr<IoUringSocketHandleImpl> handle_;
+  int peer_fd_{-1};
+  uint32_t events_{0};
+  bool should_skip_{};
+};
+
+TEST_F(IoUringSocketHandleImplTest, ReadAndWrite) {
+  initializeFileEvent(Event::FileReadyType::Read | Event::FileReadyType::Write);
+  EXPECT_TRUE(handle_->usingIoUring());
+
+  Buffer::OwnedImpl buffer;
+  auto result = handle_->read(buffer, absl::nullopt);
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+
+  Buffer::OwnedImpl request("hello");
+  result = handle_->write(request);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(5, result.return_value_);
+  EXPECT_EQ(0, request.length());
+  std::string received;
+  runUntil([&]() {
+    received += readPeer();
+    return received == "hello";
+  });
+
+  events_ = 0;
+  EXPECT_EQ(5, ::send(peer_fd_, "world", 5, 0));
+  runUntil([&]() { return (events_ & Event::FileReadyType::Read) != 0; });
+  result = handle_->read(buffer, absl::nullopt);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ("world", buffer.toString());
+}
+
+TEST_F(IoUringSocketHandleImplTest, PeekThenRead) {
+  initializeFileEvent(Event::FileReadyType::Read);
+  EXPECT_EQ(4, ::send(peer_fd_, "data", 4, 0));
+  runUntil([&]() { return (events_ & Event::FileReadyType::Read) != 0; });
+
+  char peeked[4];
+  auto result = handle_->recv(peeked, sizeof(peeked), MSG_PEEK);
+  EXPECT_EQ(4, result.return_value_);
+  EXPECT_EQ("data", absl::string_view(peeked, 4));
+
+  Buffer::OwnedImpl buffer;
+  result = handle_->read(buffer, absl::nullopt);
+  EXPECT_EQ("data", buffer.toString());
+}
+
+TEST_F(IoUringSocketHandleImplTest, RemoteClose) {
+  initializeFileEvent(Event::FileReadyType::Read | Event::FileReadyType::Closed);
+  ::close(peer_fd_);
+  peer_fd_ = -1;
+  runUntil([&]() { return (events_ & Event::FileReadyType::Closed) != 0; });
+  Buffer::OwnedImpl buffer;
+  auto result = handle_->read(buffer, absl::nullopt);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(0, result.return_value_);
+}
+
+TEST_F(IoUringSocketHandleImplTest, CloseFlushesPendingWrites) {
+  initializeFileEvent(Event::FileReadyType::Read | Event::FileReadyType::Write);
+  const std::string data(256 * 1024, 'a');
+  Buffer::OwnedImpl request(data);
+  EXPECT_EQ(data.size(), handle_->write(request).return_value_);
+  handle_->close();
+  EXPECT_FALSE(handle_->isOpen());
+
+  std::string received;
+  char buffer[4096];
+  while (true) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    const ssize_t rc = ::recv(peer_fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (rc == 0) {
+      break;
+    }
+    if (rc > 0) {
+      received.append(buffer, rc);
+    }
+  }
+  EXPECT_EQ(data, received);
+}
+
+TEST_F(IoUringSocketHandleImplTest, WriteBackpressure) {
+  initializeFileEvent(Event::FileReadyType::Write);
+  Buffer::OwnedImpl request(std::string(IoUringSocketHandleImpl::WriteBufferLimit, 'a'));
+  EXPECT_TRUE(handle_->write(request).ok());
+  Buffer::OwnedImpl more("b");
+  // The peer is not reading, so the kernel buffer fills up and the handle stops accepting data.
+  runUntil([&]() {
+    auto result = handle_->write(more);
+    return !result.ok() && result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again;
+  });
+  events_ = 0;
+  readPeer();
+  runUntil([&]() { return (events_ & Event::FileReadyType::Write) != 0; });
+}
+
+TEST_F(IoUringSocketHandleImplTest, NoWorkerUsesSystemCalls) {
+  auto other_api = Api::createApiForTest();
+  auto other_dispatcher = other_api->allocateDispatcher("other");
+  handle_->initializeFileEvent(
+      *other_dispatcher, [](uint32_t) {}, Event::FileTriggerType::Edge,
+      Event::FileReadyType::Read);
+  EXPECT_FALSE(handle_->usingIoUring());
+  handle_.reset();
+}
+
+// The io_uring workers stop being used for new sockets once the bootstrap extension that owns
+// them is gone, as their thread local slot goes away with the server.
+TEST_F(IoUringSocketHandleImplTest, SocketInterfaceDoesNotOutliveExtension) {
+  testing::NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  ON_CALL(context, threadLocal()).WillByDefault(testing::ReturnRef(tls_));
+  envoy::extensions::network::socket_interface::v3::DefaultSocketInterface config;
+  config.mutable_io_uring_options();
+
+  SocketInterfaceImpl sock_interface;
+  Server::BootstrapExtensionPtr extension =
+      sock_interface.createBootstrapExtension(config, context);
+  IoHandlePtr io_handle = sock_interface.socket(Socket::Type::Stream, Address::Type::Ip,
+                                                Address::IpVersion::v4, false, {});
+  EXPECT_NE(nullptr, dynamic_cast<IoUringSocketHandleImpl*>(io_handle.get()));
+  io_handle->close();
+
+  extension.reset();
+  io_handle = sock_interface.socket(Socket::Type::Stream, Address::Type::Ip,
+                                    Address::IpVersion::v4, false, {});
+  EXPECT_EQ(nullptr, dynamic_cast<IoUringSocketHandleImpl*>(io_handle.get()));
+  io_handle->close();
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -1,6 +1,10 @@
+#include "source/common/common/macros.h"
 #include "source/common/network/lc_trie.h"
 #include "source/common/network/utility.h"
 
+#include "test/benchmark/allocation_budget.h"
+#include "test/benchmark/main.h"
+
 #include "benchmark/benchmark.h"
 
 namespace {
@@ -50,6 +54,54 @@ struct CidrInputs {
       tag_data_minimal_;
 };
 
+// A table the size of a geolocation or ASN database: the IPv4 address space partitioned into
+// about 1.3M /20 and /21 prefixes over 4,096 tags, and 1,024 addresses to look up in it.
+struct LargeCidrInputs {
+  LargeCidrInputs() {
+    static constexpr uint32_t NumTags = 4096;
+    for (uint32_t i = 0; i < NumTags; i++) {
+      tag_data_.emplace_back(fmt::format("tag_{}", i),
+                             std::vector<Envoy::Network::Address::CidrRange>());
+      tag_ids_.emplace_back(i, std::vector<Envoy::Network::Address::CidrRange>());
+    }
+    const auto add_prefix = [this](uint32_t address, int length) {
+      // Spread the tags over the address space, like the countries or networks of a real table.
+      const uint32_t tag = ((address >> 11) * 2654435761U >> 8) % NumTags;
+      tag_data_[tag].second.push_back(Envoy::Network::Address::CidrRange::create(
+          fmt::format("{}.{}.{}.{}/{}", address >> 24, (address >> 16) & 0xff,
+                      (address >> 8) & 0xff, address & 0xff, length)));
+      tag_ids_[tag].second.push_back(tag_data_[tag].second.back());
+    };
+    for (uint32_t block = 0; block < (1U << 20); block++) {
+      const uint32_t address = block << 12;
+      // Split every fourth /20 in two /21s.
+      if ((block * 2654435761U >> 30) == 0) {
+        add_prefix(address, 21);
+        add_prefix(address | (1U << 11), 21);
+      } else {
+        add_prefix(address, 20);
+      }
+    }
+
+    uint32_t address = 1;
+    for (int i = 0; i < 1024; i++) {
+      address = address * 1664525U + 1013904223U;
+      addresses_.push_back(Envoy::Network::Utility::parseInternetAddressNoThrow(
+          fmt::format("{}.{}.{}.{}", address >> 24, (address >> 16) & 0xff, (address >> 8) & 0xff,
+                      address & 0xff)));
+    }
+  }
+
+  std::vector<std::pair<std::string, std::vector<Envoy::Network::Address::CidrRange>>> tag_data_;
+  // The same prefixes, tagged with interned tag IDs like the IP tagging filter does.
+  std::vector<std::pair<uint32_t, std::vector<Envoy::Network::Address::CidrRange>>> tag_ids_;
+  std::vector<Envoy::Network::Address::InstanceConstSharedPtr> addresses_;
+};
+
+const LargeCidrInputs& largeCidrInputs() {
+  CONSTRUCT_ON_FIRST_USE(LargeCidrInputs);
+}
+
 } // namespace
 
 namespace Envoy {
@@ -146,4 +198,68 @@ static void lcTrieLookupMinimal(benchmark::State& state) {
 
 BENCHMARK(lcTrieLookupMinimal);
 
+static void lcTrieConstructLarge(benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks()) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+  const LargeCidrInputs& inputs = largeCidrInputs();
+
+  std::unique_ptr<Envoy::Network::LcTrie::LcTrie<uint32_t>> trie;
+  for (auto _ : state) {
+    trie = std::make_unique<Envoy::Network::LcTrie::LcTrie<uint32_t>>(inputs.tag_ids_);
+  }
+  benchmark::DoNotOptimize(trie);
+}
+
+BENCHMARK(lcTrieConstructLarge)->Unit(benchmark::kMillisecond);
+
+static void lcTrieLookupLarge(benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks()) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+  const LargeCidrInputs& inputs = largeCidrInputs();
+  std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> lc_trie =
+      std::make_unique<Envoy::Network::LcTrie::LcTrie<std::string>>(inputs.tag_data_);
+
+  static size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    i++;
+    i %= inputs.addresses_.size();
+    output_tags += lc_trie->getData(inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(lcTrieLookupLarge);
+
+// Looks up the interned tag IDs of an address in place, the way the IP tagging filter does.
+static void lcTrieLookupLargeTagIds(benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks()) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+  const LargeCidrInputs& inputs = largeCidrInputs();
+  std::unique_ptr<Envoy::Network::LcTrie::LcTrie<uint32_t>> lc_trie =
+      std::make_unique<Envoy::Network::LcTrie::LcTrie<uint32_t>>(inputs.tag_ids_);
+
+  size_t i = 0;
+  size_t output_tags = 0;
+  auto lookup = [&]() {
+    i++;
+    i %= inputs.addresses_.size();
+    output_tags += lc_trie->getDataView(inputs.addresses_[i]).size();
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    lookup();
+  }
+  AllocationBudget(0, 0).check(state, lookup);
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(lcTrieLookupLargeTagIds);
+
 } // namespace Envoy
@@ -40,9 +40,14 @@ public:
     for (const auto& kv : test_output) {
       std::vector<std::string> expected(kv.second);
       std::sort(expected.begin(), expected.end());
-      std::vector<std::string> actual(trie_->getData(Utility::parseInternetAddress(kv.first)));
+      const auto address = Utility::parseInternetAddress(kv.first);
+      std::vector<std::string> actual(trie_->getData(address));
       std::sort(actual.begin(), actual.end());
       EXPECT_EQ(expected, actual);
+      const absl::Span<const std::string> view = trie_->getDataView(address);
+      std::vector<std::string> viewed(view.begin(), view.end());
+      std::sort(viewed.begin(), viewed.end());
+      EXPECT_EQ(expected, viewed);
     }
   }
 
@@ -325,10 +330,52 @@ TEST_F(LcTrieTest, ExclusiveNestedPrefixesWithCatchAll) {
   expectIPAndTags(test_case);
 }
 
-// Ensure the trie will reject inputs that would cause it to exceed the maximum 2^20 nodes
+// Ranges with the same data share a single copy of it.
+TEST_F(LcTrieTest, SharedData) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"10.0.0.0/8", "12.0.0.0/8", "2001:db8::/64"}, // tag_0
+      {"11.0.0.0/8"},                                // tag_1
+      {"0.0.0.0/0"},                                 // tag_2
+  };
+  for (const bool exclusive : {false, true}) {
+    setup(cidr_range_strings, exclusive);
+    const auto first = trie_->getDataView(Utility::parseInternetAddress("10.0.0.1"));
+    const auto second = trie_->getDataView(Utility::parseInternetAddress("12.0.0.1"));
+    EXPECT_EQ(exclusive ? 1 : 2, first.size());
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_NE(first.data(),
+              trie_->getDataView(Utility::parseInternetAddress("11.0.0.1")).data());
+    EXPECT_EQ(1, trie_->getDataView(Utility::parseInternetAddress("2001:db8::1")).size());
+    EXPECT_TRUE(trie_->getDataView(Utility::parseInternetAddress("2001:db9::1")).empty());
+  }
+}
+
+// More prefixes than the 20-bit node addresses of earlier versions of the trie could hold.
+TEST_F(LcTrieTest, LargeTable) {
+  static const size_t num_prefixes = 300000;
+  std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input(16);
+  for (size_t i = 0; i < ip_tags_input.size(); i++) {
+    ip_tags_input[i].first = fmt::format("tag_{}", i);
+  }
+  for (size_t i = 0; i < num_prefixes; i++) {
+    ip_tags_input[i % ip_tags_input.size()].second.push_back(Address::CidrRange::create(
+        fmt::format("10.{}.{}.{}/32", i >> 16, (i >> 8) & 0xff, i & 0xff)));
+  }
+  trie_ = std::make_unique<LcTrie<std::string>>(ip_tags_input);
+
+  for (size_t i = 0; i < num_prefixes; i += 997) {
+    const auto data = trie_->getDataView(Utility::parseInternetAddress(
+        fmt::format("10.{}.{}.{}", i >> 16, (i >> 8) & 0xff, i & 0xff)));
+    ASSERT_EQ(1, data.size());
+    EXPECT_EQ(fmt::format("tag_{}", i % ip_tags_input.size()), data[0]);
+  }
+  EXPECT_TRUE(trie_->getDataView(Utility::parseInternetAddress("10.255.0.0")).empty());
+}
+
+// Ensure the trie will reject inputs that would cause it to exceed the maximum 2^23 nodes
 // when using the default fill factor.
 TEST_F(LcTrieTest, MaximumEntriesExceptionDefault) {
-  static const size_t num_prefixes = 1 << 19;
+  static const size_t num_prefixes = (1 << 21) + 1;
   Address::CidrRange address = Address::CidrRange::create("10.0.0.1/8");
   std::vector<Address::CidrRange> prefixes;
   prefixes.reserve(num_prefixes);
@@ -337,16 +384,15 @@ TEST_F(LcTrieTest, MaximumEntriesExceptionDefault) {
   }
   EXPECT_EQ(num_prefixes, prefixes.size());
 
-  std::pair<std::string, std::vector<Address::CidrRange>> ip_tag =
-      std::make_pair("bad_tag", prefixes);
-  std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input{ip_tag};
+  std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input;
+  ip_tags_input.emplace_back("bad_tag", std::move(prefixes));
   EXPECT_THROW_WITH_MESSAGE(new LcTrie<std::string>(ip_tags_input), EnvoyException,
-                            "The input vector has '524288' CIDR range entries. "
-                            "LC-Trie can only support '262144' CIDR ranges with "
+                            "The input vector has '2097153' CIDR range entries. "
+                            "LC-Trie can only support '2097152' CIDR ranges with "
                             "the specified fill factor.");
 }
 
-// Ensure the trie will reject inputs that would cause it to exceed the maximum 2^20 nodes
+// Ensure the trie will reject inputs that would cause it to exceed the maximum 2^23 nodes
 // when using a fill factor override.
 TEST_F(LcTrieTest, MaximumEntriesExceptionOverride) {
   static const size_t num_prefixes = 8192;
@@ -364,9 +410,10 @@ TEST_F(LcTrieTest, MaximumEntriesExceptionOverride) {
   std::pair<std::string, std::vector<Address::CidrRange>> ip_tag =
       std::make_pair("bad_tag", prefixes);
   std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input{ip_tag};
-  EXPECT_THROW_WITH_MESSAGE(new LcTrie<std::string>(ip_tags_input, false, 0.01), EnvoyException,
+  EXPECT_THROW_WITH_MESSAGE(new LcTrie<std::string>(ip_tags_input, false, 0.001),
+                            EnvoyException,
                             "The input vector has '8192' CIDR range entries. "
-                            "LC-Trie can only support '5242' CIDR ranges with "
+                            "LC-Trie can only support '4194' CIDR ranges with "
                             "the specified fill factor.");
 }
 
@@ -38,7 +38,8 @@ static void errorCallbackTest(Address::IpVersion version) {
       Network::Test::getCanonicalLoopbackAddress(version));
   Network::MockTcpListenerCallbacks listener_callbacks;
   Network::ListenerPtr listener =
-      dispatcher->createListener(socket, listener_callbacks, runtime, true, false);
+      dispatcher->createListener(socket, listener_callbacks, runtime, true, false,
+                                 Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   Network::ClientConnectionPtr client_connection = dispatcher->createClientConnection(
       socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
@@ -70,9 +71,11 @@ class TestTcpListenerImpl : public TcpListenerImpl {
 public:
   TestTcpListenerImpl(Event::DispatcherImpl& dispatcher, Random::RandomGenerator& random_generator,
                       Runtime::Loader& runtime, SocketSharedPtr socket, TcpListenerCallbacks& cb,
-                      bool bind_to_port, bool ignore_global_conn_limit)
+                      bool bind_to_port, bool ignore_global_conn_limit,
+                      uint32_t max_connections_to_accept_per_socket_event =
+                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent)
       : TcpListenerImpl(dispatcher, random_generator, runtime, std::move(socket), cb, bind_to_port,
-                        ignore_global_conn_limit) {}
+                        ignore_global_conn_limit, max_connections_to_accept_per_socket_event) {}
 
   MOCK_METHOD(Address::InstanceConstSharedPtr, getLocalAddress, (os_fd_t fd));
 };
@@ -129,7 +132,8 @@ TEST_P(TcpListenerImplTest, GlobalConnectionLimitEnforcement) {
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
   Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, false);
+      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, false,
+                                  Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   std::vector<Network::ClientConnectionPtr> client_connections;
   std::vector<Network::ConnectionPtr> server_connections;
@@ -194,7 +198,8 @@ TEST_P(TcpListenerImplTest, GlobalConnectionLimitListenerOptOut) {
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
   Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, true);
+      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, true,
+                                  Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   std::vector<Network::ClientConnectionPtr> client_connections;
   std::vector<Network::ConnectionPtr> server_connections;
@@ -232,6 +237,30 @@ TEST_P(TcpListenerImplTest, GlobalConnectionLimitListenerOptOut) {
   EXPECT_EQ(2, server_connections.size());
 }
 
+TEST_P(TcpListenerImplTest, ListenerConnectionLimitReject) {
+  NiceMock<Runtime::MockLoader> runtime;
+  auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
+      Network::Test::getCanonicalLoopbackAddress(version_));
+  Network::MockTcpListenerCallbacks listener_callbacks;
+  Network::ListenerPtr listener =
+      dispatcher_->createListener(socket, listener_callbacks, runtime, true, false,
+                                  Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
+
+  Network::ClientConnectionPtr client_connection = dispatcher_->createClientConnection(
+      socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
+      Network::Test::createRawBufferSocket(), nullptr, nullptr);
+  client_connection->connect();
+
+  // The connection is closed without being handed to the callbacks.
+  EXPECT_CALL(listener_callbacks, listenerConnectionLimitReached()).WillOnce(Return(true));
+  EXPECT_CALL(listener_callbacks, onAccept_(_)).Times(0);
+  EXPECT_CALL(listener_callbacks, onReject(TcpListenerCallbacks::RejectCause::ListenerCxLimit))
+      .WillOnce(Invoke([&](TcpListenerCallbacks::RejectCause) { dispatcher_->exit(); }));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  client_connection->close(ConnectionCloseType::NoFlush);
+}
+
 TEST_P(TcpListenerImplTest, WildcardListenerUseActualDst) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
@@ -360,6 +389,72 @@ TEST_P(TcpListenerImplTest, DisableAndEnableListener) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+// Accepts the connections pending on the listener with the given limit per socket event, and
+// returns the order in which the accepts and the callbacks they posted ran.
+std::vector<std::string> acceptOrder(Event::DispatcherImpl& dispatcher, Address::IpVersion version,
+                                     uint32_t max_connections_to_accept_per_socket_event) {
+  auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
+      Network::Test::getCanonicalLoopbackAddress(version));
+  MockTcpListenerCallbacks listener_callbacks;
+  NiceMock<MockConnectionCallbacks> connection_callbacks;
+  Random::MockRandomGenerator random_generator;
+  NiceMock<Runtime::MockLoader> runtime;
+  TestTcpListenerImpl listener(dispatcher, random_generator, runtime, socket, listener_callbacks,
+                               true, false, max_connections_to_accept_per_socket_event);
+
+  // Queue the connections in the backlog of the listen socket.
+  listener.disable();
+  constexpr uint32_t num_connections = 3;
+  std::vector<ClientConnectionPtr> client_connections;
+  uint32_t connected = 0;
+  ON_CALL(connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+      .WillByDefault(Invoke([&](Network::ConnectionEvent) -> void {
+        if (++connected == num_connections) {
+          dispatcher.exit();
+        }
+      }));
+  for (uint32_t i = 0; i < num_connections; ++i) {
+    client_connections.push_back(dispatcher.createClientConnection(
+        socket->connectionInfoProvider().localAddress(), Address::InstanceConstSharedPtr(),
+        Network::Test::createRawBufferSocket(), nullptr, nullptr));
+    client_connections.back()->addConnectionCallbacks(connection_callbacks);
+    client_connections.back()->connect();
+  }
+  dispatcher.run(Event::Dispatcher::RunType::Block);
+
+  std::vector<std::string> order;
+  EXPECT_CALL(listener_callbacks, onAccept_(_))
+      .Times(num_connections)
+      .WillRepeatedly(Invoke([&](ConnectionSocketPtr&) -> void {
+        order.push_back("accept");
+        dispatcher.post([&]() {
+          order.push_back("post");
+          if (order.size() == 2 * num_connections) {
+            dispatcher.exit();
+          }
+        });
+      }));
+  listener.enable();
+  dispatcher.run(Event::Dispatcher::RunType::Block);
+
+  for (const ClientConnectionPtr& client_connection : client_connections) {
+    client_connection->close(ConnectionCloseType::NoFlush);
+  }
+  return order;
+}
+
+TEST_P(TcpListenerImplTest, AcceptAllPendingConnections) {
+  EXPECT_EQ(std::vector<std::string>({"accept", "accept", "accept", "post", "post", "post"}),
+            acceptOrder(dispatcherImpl(), version_,
+                        Network::DefaultMaxConnectionsToAcceptPerSocketEvent));
+}
+
+// The callbacks posted by the first accept run before the next connection is accepted.
+TEST_P(TcpListenerImplTest, MaxConnectionsToAcceptPerSocketEvent) {
+  EXPECT_EQ(std::vector<std::string>({"accept", "post", "accept", "post", "accept", "post"}),
+            acceptOrder(dispatcherImpl(), version_, 1));
+}
+
 TEST_P(TcpListenerImplTest, SetListenerRejectFractionZero) {
   auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(version_));
@@ -19,5 +19,10 @@ TEST(RawBufferSocketFactory, RawBufferSocketFactory) {
   EXPECT_GT(keys.size(), 0);
 }
 
+TEST(RawBufferSocket, ForwardsPayloadUnchanged) {
+  RawBufferSocket socket;
+  EXPECT_TRUE(socket.forwardsPayloadUnchanged());
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -0,0 +1,58 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/network/transport_socket_options_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestTransportSocketFactory : public CommonUpstreamTransportSocketFactory {
+public:
+  TransportSocketPtr
+  createTransportSocket(TransportSocketOptionsConstSharedPtr,
+                        std::shared_ptr<const Upstream::HostDescription>) const override {
+    return nullptr;
+  }
+  absl::string_view defaultServerNameIndication() const override { return ""; }
+  bool implementsSecureTransport() const override { return false; }
+};
+
+// Options with a per-request SNI and ALPN, like the ones set by the auto_sni and auto_http
+// cluster options.
+TransportSocketOptionsConstSharedPtr makeOptions() {
+  return std::make_shared<TransportSocketOptionsImpl>(
+      "backend-0123.service.example.com", std::vector<std::string>{},
+      std::vector<std::string>{"h2", "http/1.1"}, std::vector<std::string>{"h2"});
+}
+
+// Hashes the options as the connection pools do for every request.
+void bmHashKeyPrecomputed(benchmark::State& state) {
+  const TestTransportSocketFactory factory;
+  const TransportSocketOptionsConstSharedPtr options = makeOptions();
+  std::vector<uint8_t> key;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    key.clear();
+    factory.hashKey(key, options);
+    benchmark::DoNotOptimize(key.data());
+  }
+}
+BENCHMARK(bmHashKeyPrecomputed);
+
+// Hashes the strings of the options on every call, as done for options with no precomputed key.
+void bmHashKeyComputed(benchmark::State& state) {
+  const TransportSocketOptionsConstSharedPtr options = makeOptions();
+  std::vector<uint8_t> key;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    key.clear();
+    CommonUpstreamTransportSocketFactory::computeHashKey(key, *options);
+    benchmark::DoNotOptimize(key.data());
+  }
+}
+BENCHMARK(bmHashKeyComputed);
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -128,6 +128,38 @@ TEST_F(TransportSocketOptionsImplTest, FilterStateNonHashable) {
   EXPECT_EQ(keys.size(), 0);
 }
 
+// The hash key precomputed by the options is the one the factory would compute.
+TEST_F(TransportSocketOptionsImplTest, PrecomputedHashKey) {
+  filter_state_.setData("hashable", std::make_shared<HashableObj>(),
+                        StreamInfo::FilterState::StateType::ReadOnly,
+                        StreamInfo::FilterState::LifeSpan::FilterChain,
+                        StreamInfo::FilterState::StreamSharing::SharedWithUpstreamConnection);
+  auto transport_socket_options = std::make_shared<TransportSocketOptionsImpl>(
+      "www.example.com", std::vector<std::string>{"san"}, std::vector<std::string>{"h2"},
+      std::vector<std::string>{"http/1.1"}, absl::nullopt,
+      filter_state_.objectsSharedWithUpstreamConnection());
+  ASSERT_TRUE(transport_socket_options->precomputedHashKey().has_value());
+
+  std::vector<uint8_t> computed;
+  CommonUpstreamTransportSocketFactory::computeHashKey(computed, *transport_socket_options);
+  EXPECT_EQ(5 * sizeof(uint64_t), computed.size());
+  EXPECT_EQ(computed, transport_socket_options->precomputedHashKey().ref());
+
+  TestTransportSocketFactory factory;
+  std::vector<uint8_t> keys{1, 2};
+  factory.hashKey(keys, transport_socket_options);
+  computed.insert(computed.begin(), {1, 2});
+  EXPECT_EQ(computed, keys);
+
+  // Decorated options are hashed by the factory, with their own ALPN fallback.
+  auto decorated = std::make_shared<AlpnDecoratingTransportSocketOptions>(
+      std::vector<std::string>{"h2", "http/1.1"}, transport_socket_options);
+  EXPECT_FALSE(decorated->precomputedHashKey().has_value());
+  keys.clear();
+  factory.hashKey(keys, decorated);
+  EXPECT_EQ(6 * sizeof(uint64_t), keys.size());
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
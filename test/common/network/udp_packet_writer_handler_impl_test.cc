@@ -0,0 +1,149 @@
+#include <string>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/udp_packet_writer_handler_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class UdpBatchWriterTest : public testing::Test {
+protected:
+  UdpBatchWriterTest() {
+    ON_CALL(io_handle_, supportsMmsg()).WillByDefault(Return(true));
+    ON_CALL(io_handle_, fdDoNotUse()).WillByDefault(Return(10));
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(store_, "udp_batch_writer." + name)->value();
+  }
+
+  Api::MockOsSysCalls os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<MockIoHandle> io_handle_;
+  Stats::IsolatedStoreImpl store_;
+  const Address::Ipv4Instance peer_address_{"10.0.0.1", 1000};
+};
+
+// Verifies that the packets are queued until the writer is flushed or full.
+TEST_F(UdpBatchWriterTest, QueuesUntilFlushed) {
+  UdpBatchWriter writer(io_handle_, 3, *store_.rootScope());
+  EXPECT_TRUE(writer.isBatchMode());
+
+  Buffer::OwnedImpl hello("hello");
+  Buffer::OwnedImpl world("world!");
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, _, _)).Times(0);
+  EXPECT_EQ(5U, writer.writePacket(hello, nullptr, peer_address_).return_value_);
+  EXPECT_EQ(6U, writer.writePacket(world, nullptr, peer_address_).return_value_);
+
+  EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, 2, 0))
+      .WillOnce(Invoke([](os_fd_t, struct mmsghdr* messages, unsigned int,
+                          int) -> Api::SysCallIntResult {
+        for (const absl::string_view data : {"hello", "world!"}) {
+          const iovec& iov = messages->msg_hdr.msg_iov[0];
+          EXPECT_EQ(data,
+                    absl::string_view(static_cast<const char*>(iov.iov_base), iov.iov_len));
+          const auto* peer = static_cast<const sockaddr_in*>(messages->msg_hdr.msg_name);
+          EXPECT_EQ(1000, ntohs(peer->sin_port));
+          messages++;
+        }
+        return {2, 0};
+      }));
+  const Api::IoCallUint64Result result = writer.flush();
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(11U, result.return_value_);
+  EXPECT_EQ(2U, counter("datagrams_sent"));
+  EXPECT_EQ(1U, counter("send_syscalls"));
+
+  // A full batch is sent at once.
+  EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, 3, 0)).WillOnce(Return(Api::SysCallIntResult{3, 0}));
+  for (int i = 0; i < 3; i++) {
+    Buffer::OwnedImpl buffer("hello");
+    EXPECT_TRUE(writer.writePacket(buffer, nullptr, peer_address_).ok());
+  }
+  EXPECT_EQ(5U, counter("datagrams_sent"));
+  EXPECT_EQ(2U, counter("send_syscalls"));
+}
+
+#if ENVOY_MMSG_MORE
+// Verifies that the local IPs of the packets are sent as their packet info.
+TEST_F(UdpBatchWriterTest, LocalIp) {
+  UdpBatchWriter writer(io_handle_, 3, *store_.rootScope());
+  const Address::Ipv4Instance local_address("10.0.0.2", 80);
+  Buffer::OwnedImpl hello("hello");
+  writer.writePacket(hello, local_address.ip(), peer_address_);
+
+  EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, 1, 0))
+      .WillOnce(Invoke([&](os_fd_t, struct mmsghdr* messages, unsigned int,
+                           int) -> Api::SysCallIntResult {
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&messages->msg_hdr);
+        EXPECT_EQ(IPPROTO_IP, cmsg->cmsg_level);
+        EXPECT_EQ(IP_PKTINFO, cmsg->cmsg_type);
+        EXPECT_EQ(local_address.ip()->ipv4()->address(),
+                  reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg))->ipi_spec_dst.s_addr);
+        return {1, 0};
+      }));
+  EXPECT_TRUE(writer.flush().ok());
+}
+#endif
+
+// Verifies that the queued packets are dropped once the socket would block, and that the writer
+// is then blocked.
+TEST_F(UdpBatchWriterTest, DropsOnceBlocked) {
+  UdpBatchWriter writer(io_handle_, 3, *store_.rootScope());
+  Buffer::OwnedImpl hello("hello");
+  Buffer::OwnedImpl world("world");
+  writer.writePacket(hello, nullptr, peer_address_);
+  writer.writePacket(world, nullptr, peer_address_);
+
+  EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, 2, 0))
+      .WillOnce(Return(Api::SysCallIntResult{-1, SOCKET_ERROR_AGAIN}));
+  const Api::IoCallUint64Result result = writer.flush();
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+  EXPECT_TRUE(writer.isWriteBlocked());
+  EXPECT_EQ(0U, counter("datagrams_sent"));
+  EXPECT_EQ(2U, counter("datagrams_dropped"));
+
+  Buffer::OwnedImpl again("again");
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again,
+            writer.writePacket(again, nullptr, peer_address_).err_->getErrorCode());
+  writer.setWritable();
+  EXPECT_TRUE(writer.writePacket(again, nullptr, peer_address_).ok());
+}
+
+// Verifies that the packets are sent at once when the IO handle doesn't support sendmmsg().
+TEST_F(UdpBatchWriterTest, NoMmsgSupport) {
+  EXPECT_CALL(io_handle_, supportsMmsg()).WillOnce(Return(false));
+  UdpBatchWriter writer(io_handle_, 3, *store_.rootScope());
+  EXPECT_FALSE(writer.isBatchMode());
+
+  Buffer::OwnedImpl hello("hello");
+  EXPECT_CALL(io_handle_, sendmsg(_, _, 0, nullptr, _))
+      .WillOnce(Invoke([](const Buffer::RawSlice*, uint64_t, int, const Address::Ip*,
+                          const Address::Instance&) -> Api::IoCallUint64Result {
+        return {5, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError)};
+      }));
+  EXPECT_EQ(5U, writer.writePacket(hello, nullptr, peer_address_).return_value_);
+  EXPECT_EQ(1U, counter("datagrams_sent"));
+  EXPECT_EQ(1U, counter("send_syscalls"));
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,97 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+// Returns a bootstrap with the given number of static clusters, shaped like a large config.
+std::string makeBootstrapYaml(int64_t clusters) {
+  std::string yaml = "static_resources:\n  clusters:\n";
+  for (int64_t i = 0; i < clusters; i++) {
+    absl::StrAppend(&yaml, "  - name: cluster_", i, R"EOF(
+    connect_timeout: 0.25s
+    type: STATIC
+    lb_policy: ROUND_ROBIN
+    load_assignment:
+      cluster_name: cluster_)EOF",
+                    i, R"EOF(
+      endpoints:
+      - lb_endpoints:
+        - endpoint:
+            address:
+              socket_address:
+                address: 10.0.0.1
+                port_value: )EOF",
+                    i % 65536, R"EOF(
+    metadata:
+      filter_metadata:
+        envoy.lb:
+          canary: false
+          version: v1
+)EOF");
+  }
+  return yaml;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_LoadBootstrapFromYaml(benchmark::State& state) {
+  const std::string yaml = makeBootstrapYaml(state.range(0));
+
+  for (auto _ : state) { // NOLINT
+    envoy::config::bootstrap::v3::Bootstrap bootstrap;
+    MessageUtil::loadFromYaml(yaml, bootstrap, ProtobufMessage::getNullValidationVisitor());
+    benchmark::DoNotOptimize(bootstrap.static_resources().clusters_size());
+  }
+}
+BENCHMARK(BM_LoadBootstrapFromYaml)->Arg(10)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ValueFromYamlOnHeap(benchmark::State& state) {
+  const std::string yaml = makeBootstrapYaml(state.range(0));
+
+  for (auto _ : state) { // NOLINT
+    ProtobufWkt::Value value = ValueUtil::loadFromYaml(yaml);
+    benchmark::DoNotOptimize(value.struct_value().fields_size());
+  }
+}
+BENCHMARK(BM_ValueFromYamlOnHeap)->Arg(10)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ValueFromYamlOnArena(benchmark::State& state) {
+  const std::string yaml = makeBootstrapYaml(state.range(0));
+
+  for (auto _ : state) { // NOLINT
+    Protobuf::Arena arena;
+    ProtobufWkt::Value& value = *Protobuf::Arena::CreateMessage<ProtobufWkt::Value>(&arena);
+    ValueUtil::loadFromYaml(yaml, value);
+    benchmark::DoNotOptimize(value.struct_value().fields_size());
+  }
+}
+BENCHMARK(BM_ValueFromYamlOnArena)->Arg(10)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CheckForUnexpectedFields(benchmark::State& state) {
+  envoy::config::bootstrap::v3::Bootstrap bootstrap;
+  MessageUtil::loadFromYaml(makeBootstrapYaml(state.range(0)), bootstrap,
+                            ProtobufMessage::getNullValidationVisitor());
+  ProtobufMessage::WarningValidationVisitorImpl validation_visitor;
+
+  for (auto _ : state) { // NOLINT
+    MessageUtil::checkForUnexpectedFields(bootstrap, validation_visitor);
+  }
+}
+BENCHMARK(BM_CheckForUnexpectedFields)->Arg(10)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+} // namespace Envoy
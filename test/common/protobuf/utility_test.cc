@@ -15,6 +15,7 @@
 #include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/protobuf/visitor.h"
 #include "source/common/runtime/runtime_impl.h"
 
 #include "test/common/protobuf/utility_test_file_wip.pb.h"
@@ -1304,6 +1305,21 @@ TEST_F(ProtobufUtilityTest, ValueUtilLoadFromYamlObjectWithIgnoredEntries) {
       "struct_value { fields { key: \"baz\" value { string_value: \"qux\" } } }"));
 }
 
+// The nested values are parsed in place, also when the value is allocated on an arena.
+TEST_F(ProtobufUtilityTest, ValueUtilLoadFromYamlOnArena) {
+  Protobuf::Arena arena;
+  ProtobufWkt::Value& value = *Protobuf::Arena::CreateMessage<ProtobufWkt::Value>(&arena);
+  ValueUtil::loadFromYaml("foo: [bar, {baz: 1}]\nqux: {a: b}", value);
+  EXPECT_TRUE(checkProtoEquality(ValueUtil::loadFromYaml("foo: [bar, {baz: 1}]\nqux: {a: b}"),
+                                 value.DebugString()));
+  EXPECT_EQ("b",
+            value.struct_value().fields().at("qux").struct_value().fields().at("a").string_value());
+
+  // The previous contents are cleared.
+  ValueUtil::loadFromYaml("[foo]", value);
+  EXPECT_TRUE(checkProtoEquality(value, "list_value { values { string_value: \"foo\" } }"));
+}
+
 TEST(LoadFromYamlExceptionTest, BadConversion) {
   std::string bad_yaml = R"EOF(
 admin:
@@ -1745,6 +1761,44 @@ TEST_F(ProtobufUtilityTest, MessageWip) {
   EXPECT_EQ(2, wip_counter.value());
 }
 
+class AnnotatedFieldsVisitor : public ProtobufMessage::ConstProtoVisitor {
+public:
+  void onField(const Protobuf::Message&, const Protobuf::FieldDescriptor& field) override {
+    fields_.push_back(field.name());
+  }
+  void onMessage(const Protobuf::Message& message, absl::Span<const Protobuf::Message* const>,
+                 bool) override {
+    messages_.push_back(message.GetDescriptor()->name());
+  }
+  bool annotatedFieldsOnly() const override { return true; }
+
+  std::vector<std::string> fields_;
+  std::vector<std::string> messages_;
+};
+
+// Verifies that a visitor of the annotated fields is only told about them, and still visits the
+// messages held by the other fields.
+TEST(ProtobufVisitorTest, AnnotatedFieldsOnly) {
+  envoy::test::deprecation_test::Base base;
+  base.set_not_deprecated("foo");
+  base.mutable_not_deprecated_message()->set_inner_not_deprecated("bar");
+  base.add_repeated_message();
+  base.mutable_enum_container();
+
+  for (int i = 0; i < 2; i++) {
+    AnnotatedFieldsVisitor visitor;
+    ProtobufMessage::traverseMessage(visitor, base, true);
+    EXPECT_THAT(visitor.fields_,
+                testing::ElementsAre("is_deprecated", "is_deprecated_fatal", "deprecated_message",
+                                     "inner_deprecated", "inner_deprecated_fatal",
+                                     "inner_deprecated", "inner_deprecated_fatal",
+                                     "deprecated_repeated_message", "deprecated_enum"));
+    EXPECT_THAT(visitor.messages_,
+                testing::ElementsAre("Base", "InnerMessage", "InnerMessage",
+                                     "InnerMessageWithDeprecationEnum"));
+  }
+}
+
 class DeprecatedFieldsTest : public testing::Test, protected RuntimeStatsHelper {
 protected:
   void checkForDeprecation(const Protobuf::Message& message) {
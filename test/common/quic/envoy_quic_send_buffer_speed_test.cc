@@ -0,0 +1,87 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/quic/envoy_quic_utils.h"
+
+#include "benchmark/benchmark.h"
+#include "quiche/common/simple_buffer_allocator.h"
+#include "quiche/quic/core/quic_data_writer.h"
+#include "quiche/quic/core/quic_stream_send_buffer.h"
+
+namespace Envoy {
+namespace Quic {
+namespace {
+
+// The size of the slices read from upstream.
+constexpr uint64_t SliceSize = 16 * 1024;
+// The stream frame payload written into each packet.
+constexpr uint64_t PacketPayloadSize = 1350;
+
+// Fills `buffer` with `length` bytes in slices of SliceSize bytes, like a body read from upstream.
+void fillBody(Buffer::Instance& buffer, uint64_t length) {
+  const std::string slice(SliceSize, 'a');
+  for (uint64_t added = 0; added < length; added += SliceSize) {
+    buffer.add(slice.data(), std::min(SliceSize, length - added));
+  }
+}
+
+// Writes the data saved in `send_buffer` into packet sized frames and acknowledges it.
+void writeAndAckStreamData(quic::QuicStreamSendBuffer& send_buffer, uint64_t length) {
+  char packet[PacketPayloadSize];
+  for (uint64_t offset = 0; offset < length; offset += PacketPayloadSize) {
+    const uint64_t payload = std::min(PacketPayloadSize, length - offset);
+    quic::QuicDataWriter writer(sizeof(packet), packet);
+    send_buffer.WriteStreamData(offset, payload, &writer);
+    send_buffer.OnStreamDataConsumed(payload);
+    quic::QuicByteCount newly_acked_length = 0;
+    send_buffer.OnStreamDataAcked(offset, payload, &newly_acked_length);
+  }
+  benchmark::DoNotOptimize(packet);
+}
+
+// Sends a large download through the QUICHE stream send buffer by handing the slices of the body
+// over as mem slices, as the HTTP/3 codec does.
+void bmSendBodyMoveSlices(benchmark::State& state) {
+  const uint64_t length = state.range(0);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    Buffer::OwnedImpl body;
+    fillBody(body, length);
+    state.ResumeTiming();
+
+    quic::QuicStreamSendBuffer send_buffer(quiche::SimpleBufferAllocator::Get());
+    QuicheMemSliceVector slices = moveBufferToQuicheMemSlices(body);
+    send_buffer.SaveMemSliceSpan(absl::MakeSpan(slices));
+    writeAndAckStreamData(send_buffer, length);
+  }
+  state.SetBytesProcessed(state.iterations() * length);
+}
+BENCHMARK(bmSendBodyMoveSlices)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(16 * 1024 * 1024);
+
+// Same as above, but copies the body into the QUICHE stream send buffer.
+void bmSendBodyCopy(benchmark::State& state) {
+  const uint64_t length = state.range(0);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    Buffer::OwnedImpl body;
+    fillBody(body, length);
+    state.ResumeTiming();
+
+    quic::QuicStreamSendBuffer send_buffer(quiche::SimpleBufferAllocator::Get());
+    for (const Buffer::RawSlice& slice : body.getRawSlices()) {
+      send_buffer.SaveStreamData(
+          absl::string_view(static_cast<const char*>(slice.mem_), slice.len_));
+    }
+    body.drain(length);
+    writeAndAckStreamData(send_buffer, length);
+  }
+  state.SetBytesProcessed(state.iterations() * length);
+}
+BENCHMARK(bmSendBodyCopy)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(16 * 1024 * 1024);
+
+} // namespace
+} // namespace Quic
+} // namespace Envoy
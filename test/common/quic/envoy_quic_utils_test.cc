@@ -1,3 +1,4 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/quic/envoy_quic_utils.h"
 
 #include "test/mocks/api/mocks.h"
@@ -200,5 +201,22 @@ TEST(EnvoyQuicUtilsTest, ConvertQuicConfig) {
   EXPECT_EQ(3, quic_config.GetInitialMaxStreamDataBytesIncomingBidirectionalToSend());
 }
 
+TEST(EnvoyQuicUtilsTest, MoveBufferToQuicheMemSlices) {
+  Buffer::OwnedImpl buffer;
+  const std::string first(16384, 'a');
+  const std::string second(100, 'b');
+  buffer.appendSliceForTest(first);
+  buffer.appendSliceForTest(second);
+  const void* first_slice_data = buffer.frontSlice().mem_;
+
+  QuicheMemSliceVector slices = moveBufferToQuicheMemSlices(buffer);
+  EXPECT_EQ(0, buffer.length());
+  ASSERT_EQ(2, slices.size());
+  EXPECT_EQ(first, absl::string_view(slices[0].data(), slices[0].length()));
+  EXPECT_EQ(second, absl::string_view(slices[1].data(), slices[1].length()));
+  // The data of the slices is moved rather than copied.
+  EXPECT_EQ(first_slice_data, slices[0].data());
+}
+
 } // namespace Quic
 } // namespace Envoy
@@ -14,6 +14,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "quiche/quic/test_tools/quic_test_utils.h"
 
 using testing::_;
 using testing::Return;
@@ -137,5 +138,32 @@ TEST_F(EnvoyQuicWriterTest, SendFailureMessageTooBig) {
   EXPECT_FALSE(envoy_quic_writer_.IsWriteBlocked());
 }
 
+// Verifies that the flushes are deferred until the end of the deferral, and that the packets left
+// by a blocked flush are reported until they are flushed.
+TEST(EnvoyQuicDeferredFlushPacketWriterTest, DefersFlush) {
+  auto* writer = new testing::StrictMock<quic::test::MockPacketWriter>();
+  EnvoyQuicDeferredFlushPacketWriter deferred_flush_writer(writer);
+
+  EXPECT_CALL(*writer, Flush()).WillOnce(Return(quic::WriteResult(quic::WRITE_STATUS_OK, 0)));
+  EXPECT_EQ(quic::WRITE_STATUS_OK, deferred_flush_writer.Flush().status);
+
+  deferred_flush_writer.startDeferringFlush();
+  EXPECT_EQ(quic::WRITE_STATUS_OK, deferred_flush_writer.Flush().status);
+  EXPECT_EQ(quic::WRITE_STATUS_OK, deferred_flush_writer.Flush().status);
+  EXPECT_TRUE(deferred_flush_writer.flushPending());
+  EXPECT_CALL(*writer, Flush())
+      .WillOnce(Return(quic::WriteResult(quic::WRITE_STATUS_BLOCKED, EAGAIN)));
+  deferred_flush_writer.stopDeferringFlush();
+  EXPECT_TRUE(deferred_flush_writer.flushPending());
+
+  EXPECT_CALL(*writer, Flush()).WillOnce(Return(quic::WriteResult(quic::WRITE_STATUS_OK, 0)));
+  EXPECT_EQ(quic::WRITE_STATUS_OK, deferred_flush_writer.Flush().status);
+  EXPECT_FALSE(deferred_flush_writer.flushPending());
+
+  // Nothing is flushed if no flush was deferred.
+  deferred_flush_writer.startDeferringFlush();
+  deferred_flush_writer.stopDeferringFlush();
+}
+
 } // namespace Quic
 } // namespace Envoy
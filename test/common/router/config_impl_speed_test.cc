@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -136,6 +137,128 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Generates an API gateway like route table of `num_routes` routes. Most routes are exact path or
+ * prefix matches on a per service path, some also match a header and every tenth route is a regex:
+ * - /api/service_0/resource (exact)
+ * - /api/service_1/ (prefix, x-tenant: tenant_1)
+ * - /api/service_2/resource (exact)
+ * - /api/service_3/ (prefix)
+ * - ...
+ * - ^/api/v[0-9]+/service_10$ (regex)
+ */
+static RouteConfiguration genLargeRouteConfig(int num_routes) {
+  RouteConfiguration route_config;
+  VirtualHost* v_host = route_config.add_virtual_hosts();
+  v_host->set_name("default");
+  v_host->add_domains("*");
+
+  for (int i = 0; i < num_routes; ++i) {
+    Route* route = v_host->add_routes();
+    route->mutable_direct_response()->set_status(200);
+    RouteMatch* match = route->mutable_match();
+    if (i % 10 == 0) {
+      envoy::type::matcher::v3::RegexMatcher* regex = match->mutable_safe_regex();
+      regex->mutable_google_re2();
+      regex->set_regex(absl::StrCat("^/api/v[0-9]+/service_", i, "$"));
+    } else if (i % 2 == 0) {
+      match->set_path(absl::StrCat("/api/service_", i, "/resource"));
+    } else {
+      match->set_prefix(absl::StrCat("/api/service_", i, "/"));
+      if (i % 4 == 1) {
+        auto* header = match->add_headers();
+        header->set_name("x-tenant");
+        header->mutable_string_match()->set_exact(absl::StrCat("tenant_", i));
+      }
+    }
+  }
+
+  return route_config;
+}
+
+/**
+ * Measure the speed of matching requests against large route tables, with and without the path
+ * route index. Requests are spread over the routes of the table so that the cost of matching
+ * early and late routes is averaged.
+ */
+static void bmLargeRouteTable(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.route_path_index", state.range(1) ? "true" : "false"}});
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  const int num_routes = state.range(0);
+  ConfigImpl config(genLargeRouteConfig(num_routes), OptionalHttpFilters(), factory_context,
+                    ProtobufMessage::getNullValidationVisitor(), true);
+
+  std::vector<Http::TestRequestHeaderMapImpl> requests;
+  for (int i = 3; i < num_routes; i += num_routes / 16) {
+    // Odd routes without a header matcher are prefix routes.
+    const int route_num = i % 4 == 3 ? i : i - i % 4 + 3;
+    requests.push_back({{":authority", "www.google.com"},
+                        {":method", "GET"},
+                        {":path", absl::StrCat("/api/service_", route_num, "/resource?query=1")},
+                        {"x-forwarded-proto", "http"}});
+  }
+
+  size_t request_num = 0;
+  for (auto _ : state) { // NOLINT
+    const auto route = config.route(requests[request_num++ % requests.size()], stream_info, 0);
+    RELEASE_ASSERT(route != nullptr, "request did not match a route");
+  }
+}
+
+BENCHMARK(bmLargeRouteTable)->ArgsProduct({{100, 3000, 8000}, {0, 1}});
+
+/**
+ * Measure the speed of selecting a virtual host among many wildcard domains, as in multi-tenant
+ * ingress configurations. Three quarters of the virtual hosts have a suffix wildcard domain and
+ * the others a prefix wildcard domain:
+ * - tenant-0.example.*
+ * - *.tenant-1.example.com
+ * - ...
+ */
+static void bmWildcardVirtualHosts(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  const int num_virtual_hosts = state.range(0);
+  RouteConfiguration route_config;
+  for (int i = 0; i < num_virtual_hosts; ++i) {
+    VirtualHost* v_host = route_config.add_virtual_hosts();
+    v_host->set_name(absl::StrCat("tenant-", i));
+    v_host->add_domains(i % 4 == 0 ? absl::StrCat("tenant-", i, ".example.*")
+                                   : absl::StrCat("*.tenant-", i, ".example.com"));
+    Route* route = v_host->add_routes();
+    route->mutable_match()->set_prefix("/");
+    route->mutable_direct_response()->set_status(200);
+  }
+  ConfigImpl config(route_config, OptionalHttpFilters(), factory_context,
+                    ProtobufMessage::getNullValidationVisitor(), true);
+
+  std::vector<Http::TestRequestHeaderMapImpl> requests;
+  for (int i = 0; i < num_virtual_hosts; i += std::max(1, num_virtual_hosts / 16)) {
+    requests.push_back({{":authority", i % 4 == 0 ? absl::StrCat("tenant-", i, ".example.org")
+                                                  : absl::StrCat("api.tenant-", i, ".example.com")},
+                        {":method", "GET"},
+                        {":path", "/"},
+                        {"x-forwarded-proto", "http"}});
+  }
+
+  size_t request_num = 0;
+  for (auto _ : state) { // NOLINT
+    const auto route = config.route(requests[request_num++ % requests.size()], stream_info, 0);
+    RELEASE_ASSERT(route != nullptr, "request did not match a virtual host");
+  }
+}
+
+BENCHMARK(bmWildcardVirtualHosts)->Arg(100)->Arg(1000)->Arg(40000);
+
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
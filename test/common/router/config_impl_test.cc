@@ -64,9 +64,11 @@ public:
   TestConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                  Server::Configuration::ServerFactoryContext& factory_context,
                  bool validate_clusters_default,
-                 const OptionalHttpFilters& optional_http_filters = OptionalHttpFilters())
+                 const OptionalHttpFilters& optional_http_filters = OptionalHttpFilters(),
+                 const ConfigImpl* previous_config = nullptr)
       : ConfigImpl(config, optional_http_filters, factory_context,
-                   ProtobufMessage::getNullValidationVisitor(), validate_clusters_default),
+                   ProtobufMessage::getNullValidationVisitor(), validate_clusters_default,
+                   previous_config),
         config_(config) {}
 
   void setupRouteConfig(const Http::RequestHeaderMap& headers, uint64_t random_value) const {
@@ -789,6 +791,8 @@ virtual_hosts:
   // Wildcards
   EXPECT_EQ("wildcard",
             config.route(genHeaders("www.foo.com", "/", "GET"), 0)->routeEntry()->clusterName());
+  EXPECT_EQ("wildcard",
+            config.route(genHeaders("WWW.Foo.com", "/", "GET"), 0)->routeEntry()->clusterName());
   EXPECT_EQ(
       "wildcard",
       config.route(genHeaders("foo-bar.baz.com", "/", "GET"), 0)->routeEntry()->clusterName());
@@ -2307,6 +2311,143 @@ virtual_hosts:
   }
 }
 
+// Virtual hosts with many routes are matched through the path route index, which must select the
+// same route as the linear scan.
+TEST_F(RouteMatcherTest, PathRouteIndex) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: local_service
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/api/v1/", headers: [{ name: x-tenant, string_match: { exact: a } }] }
+    name: tenant-a
+    route: { cluster: www2 }
+  - match: { safe_regex: { regex: "^/api/v[0-9]+/regex$" } }
+    name: regex
+    route: { cluster: www2 }
+  - match: { path: "/api/v1/exact" }
+    name: exact
+    route: { cluster: www2 }
+  - match: { path: "/API/V1/IGNORE-CASE", case_sensitive: false }
+    name: ignore-case
+    route: { cluster: www2 }
+  - match: { path_separated_prefix: "/api/v1/separated" }
+    name: separated
+    route: { cluster: www2 }
+  - match: { prefix: "/api/v1/exact/", query_parameters: [{ name: debug, present_match: true }] }
+    name: debug
+    route: { cluster: www2 }
+  - match: { prefix: "/api/v1/" }
+    name: v1
+    route: { cluster: www2 }
+  - match: { prefix: "/api/v2/" }
+    name: v2
+    route: { cluster: www2 }
+  - match: { prefix: "/", case_sensitive: false }
+    name: catchall
+    route: { cluster: www2 }
+  )EOF";
+  auto route_configuration = parseRouteConfigurationFromYaml(yaml);
+  // Pad the virtual host with routes that never match so that it gets an index.
+  for (int i = 0; i < 20; ++i) {
+    auto* route = route_configuration.mutable_virtual_hosts(0)->mutable_routes()->Add();
+    route->mutable_match()->set_path(absl::StrCat("/unused/", i));
+    route->mutable_route()->set_cluster("www2");
+  }
+  factory_context_.cluster_manager_.initializeClusters({"www2"}, {});
+
+  const std::vector<std::pair<std::string, std::string>> expected_routes = {
+      {"/api/v1/exact", "exact"},
+      {"/api/v1/exact?debug=1", "exact"},
+      {"/api/v1/exact/foo?debug=1", "debug"},
+      {"/api/v1/exact/foo", "v1"},
+      {"/api/v1/exactly", "v1"},
+      {"/api/v2/regex", "regex"},
+      {"/api/v1/ignore-case", "ignore-case"},
+      {"/api/v1/separated/foo", "separated"},
+      {"/api/v1/separated#foo", "separated"},
+      {"/api/v1/separatedfoo", "v1"},
+      {"/api/v2/foo", "v2"},
+      {"/api/v3/foo", "catchall"},
+      {"/API/V2/FOO", "catchall"},
+  };
+  for (const bool enabled : {false, true}) {
+    mergeValues({{"envoy.reloadable_features.route_path_index", enabled ? "true" : "false"}});
+    TestConfigImpl config(route_configuration, factory_context_, true);
+    for (const auto& [path, route_name] : expected_routes) {
+      EXPECT_EQ(route_name, config.route(genHeaders("www.lyft.com", path, "GET"), 0)
+                                ->routeEntry()
+                                ->routeName())
+          << path;
+    }
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/api/v1/exact/", "GET");
+    headers.addCopy("x-tenant", "a");
+    EXPECT_EQ("tenant-a", config.route(headers, 0)->routeEntry()->routeName());
+  }
+}
+
+// Unchanged virtual hosts are shared with the previous version of the route configuration, as long
+// as the settings common to all virtual hosts didn't change either.
+TEST_F(RouteMatcherTest, ReuseUnchangedVirtualHosts) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: foo
+  domains: ["foo.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: foo }
+- name: bar
+  domains: ["bar.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: bar }
+  )EOF";
+  factory_context_.cluster_manager_.initializeClusters({"foo", "bar", "baz"}, {});
+  const auto virtual_host = [](const TestConfigImpl& config, const std::string& host) {
+    return &config.route(genHeaders(host, "/", "GET"), 0)->virtualHost();
+  };
+
+  const auto route_configuration = parseRouteConfigurationFromYaml(yaml);
+  TestConfigImpl config(route_configuration, factory_context_, false);
+
+  // Only the changed virtual host is rebuilt.
+  auto changed_vhost = route_configuration;
+  changed_vhost.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster("baz");
+  TestConfigImpl config2(changed_vhost, factory_context_, false, OptionalHttpFilters(), &config);
+  EXPECT_EQ(virtual_host(config, "foo.com"), virtual_host(config2, "foo.com"));
+  EXPECT_NE(virtual_host(config, "bar.com"), virtual_host(config2, "bar.com"));
+  EXPECT_EQ("baz",
+            config2.route(genHeaders("bar.com", "/", "GET"), 0)->routeEntry()->clusterName());
+
+  // A virtual host can also be reused from an older version if it was carried over.
+  TestConfigImpl config3(route_configuration, factory_context_, false, OptionalHttpFilters(),
+                         &config2);
+  EXPECT_EQ(virtual_host(config, "foo.com"), virtual_host(config3, "foo.com"));
+  EXPECT_NE(virtual_host(config, "bar.com"), virtual_host(config3, "bar.com"));
+  EXPECT_EQ("bar",
+            config3.route(genHeaders("bar.com", "/", "GET"), 0)->routeEntry()->clusterName());
+
+  // Virtual hosts depend on the common settings of the route configuration.
+  auto changed_common = route_configuration;
+  changed_common.add_internal_only_headers("x-internal");
+  TestConfigImpl config4(changed_common, factory_context_, false, OptionalHttpFilters(), &config3);
+  EXPECT_NE(virtual_host(config3, "foo.com"), virtual_host(config4, "foo.com"));
+  EXPECT_EQ(1, virtual_host(config4, "foo.com")->routeConfig().internalOnlyHeaders().size());
+
+  // Virtual hosts validated against the clusters are never reused.
+  TestConfigImpl config5(route_configuration, factory_context_, true, OptionalHttpFilters(),
+                         &config4);
+  TestConfigImpl config6(route_configuration, factory_context_, true, OptionalHttpFilters(),
+                         &config5);
+  EXPECT_NE(virtual_host(config5, "foo.com"), virtual_host(config6, "foo.com"));
+
+  mergeValues({{"envoy.reloadable_features.reuse_unchanged_virtual_hosts", "false"}});
+  TestConfigImpl config7(route_configuration, factory_context_, false);
+  TestConfigImpl config8(route_configuration, factory_context_, false, OptionalHttpFilters(),
+                         &config7);
+  EXPECT_NE(virtual_host(config7, "foo.com"), virtual_host(config8, "foo.com"));
+}
+
 // Tests that when 'ignore_port_in_host_matching' is true, port from host header
 // is ignored in host matching.
 TEST_F(RouteMatcherTest, IgnorePortInHostMatching) {
@@ -5046,6 +5187,51 @@ virtual_hosts:
   EXPECT_EQ(100, ProtobufPercentHelper::fractionalPercentDenominatorToInt(percent.denominator()));
 }
 
+// Each route hedging on the latency percentile tracks its own response times, including the
+// routes inheriting the hedge policy of their virtual host.
+TEST_F(RouteMatcherTest, HedgeOnLatencyPercentile) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- domains: [www.lyft.com]
+  name: www
+  hedge_policy:
+    hedge_on_per_try_timeout: true
+    latency_percentile_hedging: {percentile: 90, min_samples: 1}
+  routes:
+  - match: {prefix: /foo}
+    route: {cluster: www}
+  - match: {prefix: /bar}
+    route:
+      cluster: www
+      hedge_policy: {hedge_on_per_try_timeout: true}
+  - match: {prefix: /}
+    route: {cluster: www}
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"www"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  HedgeLatencyTracker* foo_tracker = config.route(genHeaders("www.lyft.com", "/foo", "GET"), 0)
+                                         ->routeEntry()
+                                         ->hedgePolicy()
+                                         .latencyTracker();
+  HedgeLatencyTracker* default_tracker = config.route(genHeaders("www.lyft.com", "/", "GET"), 0)
+                                             ->routeEntry()
+                                             ->hedgePolicy()
+                                             .latencyTracker();
+  ASSERT_NE(nullptr, foo_tracker);
+  ASSERT_NE(nullptr, default_tracker);
+  EXPECT_NE(foo_tracker, default_tracker);
+  EXPECT_EQ(nullptr, config.route(genHeaders("www.lyft.com", "/bar", "GET"), 0)
+                         ->routeEntry()
+                         ->hedgePolicy()
+                         .latencyTracker());
+
+  foo_tracker->recordResponseTime(std::chrono::milliseconds(5));
+  EXPECT_EQ(std::chrono::milliseconds(6), foo_tracker->hedgeDelay());
+  EXPECT_FALSE(default_tracker->hedgeDelay().has_value());
+}
+
 TEST_F(RouteMatcherTest, HedgeVirtualHostLevel) {
   const std::string yaml = R"EOF(
 virtual_hosts:
@@ -38,6 +38,7 @@ using ::testing::Pair;
 using ::testing::Return;
 using ::testing::ReturnPointee;
 using ::testing::ReturnRef;
+using ::testing::StrictMock;
 
 static envoy::config::route::v3::Route parseRouteFromV3Yaml(const std::string& yaml) {
   envoy::config::route::v3::Route route;
@@ -1472,6 +1473,25 @@ request_headers_to_add:
   EXPECT_FALSE(header_map.has("x-key"));
 }
 
+TEST(HeaderParserTest, Empty) {
+  EXPECT_TRUE(HeaderParser::defaultParser().empty());
+  EXPECT_TRUE(HeaderParser::configure(Protobuf::RepeatedPtrField<HeaderValueOption>(),
+                                      Protobuf::RepeatedPtrField<std::string>())
+                  ->empty());
+
+  Protobuf::RepeatedPtrField<std::string> headers_to_remove;
+  headers_to_remove.Add("x-remove");
+  EXPECT_FALSE(HeaderParser::configure(Protobuf::RepeatedPtrField<HeaderValueOption>(),
+                                       headers_to_remove)
+                   ->empty());
+
+  Protobuf::RepeatedPtrField<HeaderValueOption> headers_to_add;
+  auto* header = headers_to_add.Add()->mutable_header();
+  header->set_key("x-add");
+  header->set_value("value");
+  EXPECT_FALSE(HeaderParser::configure(headers_to_add)->empty());
+}
+
 TEST(HeaderParserTest, EvaluateStaticHeaders) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
@@ -1494,6 +1514,36 @@ request_headers_to_add:
   EXPECT_EQ("static-value", header_map.get_("static-header"));
 }
 
+// Constant header values are formatted when the parser is configured, not for each request.
+TEST(HeaderParserTest, EvaluateConstantHeaders) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: "www2"
+request_headers_to_add:
+  - header:
+      key: "static-header"
+      value: "100%% static"
+    append_action: APPEND_IF_EXISTS_OR_ADD
+  - header:
+      key: "empty-header"
+      value: ""
+    keep_empty_value: true
+)EOF";
+
+  HeaderParserPtr req_header_parser =
+      HeaderParser::configure(parseRouteFromV3Yaml(yaml).request_headers_to_add());
+  Http::TestRequestHeaderMapImpl header_map{{":method", "POST"}};
+  StrictMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  req_header_parser->evaluateHeaders(header_map, stream_info);
+  EXPECT_EQ("100% static", header_map.get_("static-header"));
+  EXPECT_TRUE(header_map.has("empty-header"));
+
+  Http::HeaderTransforms transforms = req_header_parser->getHeaderTransforms(stream_info);
+  ASSERT_EQ(1, transforms.headers_to_append_or_add.size());
+  EXPECT_EQ("100% static", transforms.headers_to_append_or_add[0].second);
+}
+
 TEST(HeaderParserTest, EvaluateCompoundHeaders) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
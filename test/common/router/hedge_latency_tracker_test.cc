@@ -0,0 +1,117 @@
+#include <chrono>
+
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/router/hedge_latency_tracker.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using envoy::config::route::v3::HedgePolicy;
+
+TEST(HedgeLatencyTrackerImplTest, Buckets) {
+  for (uint64_t ms : {0, 1, 15, 16, 17, 18, 100, 1000, 123456}) {
+    const uint32_t index = HedgeLatencyTrackerImpl::bucketIndex(ms);
+    EXPECT_LT(ms, HedgeLatencyTrackerImpl::bucketUpperBoundMs(index)) << ms;
+    if (index > 0) {
+      EXPECT_GE(ms, HedgeLatencyTrackerImpl::bucketUpperBoundMs(index - 1)) << ms;
+    }
+    // The buckets are at most 1/8 of their lower bound wide.
+    EXPECT_LE(HedgeLatencyTrackerImpl::bucketUpperBoundMs(index), ms + ms / 8 + 1) << ms;
+  }
+  EXPECT_EQ(16, HedgeLatencyTrackerImpl::bucketIndex(16));
+  EXPECT_EQ(18, HedgeLatencyTrackerImpl::bucketUpperBoundMs(16));
+  EXPECT_EQ(HedgeLatencyTrackerImpl::bucketIndex(HedgeLatencyTrackerImpl::MaxResponseTimeMs),
+            HedgeLatencyTrackerImpl::bucketIndex(HedgeLatencyTrackerImpl::MaxResponseTimeMs * 4));
+  EXPECT_EQ(HedgeLatencyTrackerImpl::MaxResponseTimeMs + 1,
+            HedgeLatencyTrackerImpl::bucketUpperBoundMs(
+                HedgeLatencyTrackerImpl::bucketIndex(HedgeLatencyTrackerImpl::MaxResponseTimeMs)));
+}
+
+// The percentile isn't used until enough response times are recorded.
+TEST(HedgeLatencyTrackerImplTest, MinSamples) {
+  HedgePolicy::LatencyPercentileHedging config;
+  config.mutable_min_samples()->set_value(10);
+  HedgeLatencyTrackerImpl tracker(config);
+  for (int i = 0; i < 9; i++) {
+    tracker.recordResponseTime(std::chrono::milliseconds(5));
+  }
+  EXPECT_FALSE(tracker.hedgeDelay().has_value());
+  tracker.recordResponseTime(std::chrono::milliseconds(5));
+  EXPECT_EQ(std::chrono::milliseconds(6), tracker.hedgeDelay());
+}
+
+TEST(HedgeLatencyTrackerImplTest, Percentile) {
+  HedgePolicy::LatencyPercentileHedging config;
+  HedgeLatencyTrackerImpl tracker(config);
+  // 95 fast responses and 5 slow ones: the 95th percentile is the slowest fast response.
+  for (int i = 0; i < 95; i++) {
+    tracker.recordResponseTime(std::chrono::milliseconds(i % 10));
+  }
+  for (int i = 0; i < 5; i++) {
+    tracker.recordResponseTime(std::chrono::milliseconds(1000));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(10), tracker.hedgeDelay());
+
+  config.mutable_percentile()->set_value(99);
+  HedgeLatencyTrackerImpl tracker99(config);
+  for (int i = 0; i < 95; i++) {
+    tracker99.recordResponseTime(std::chrono::milliseconds(i % 10));
+  }
+  for (int i = 0; i < 5; i++) {
+    tracker99.recordResponseTime(std::chrono::milliseconds(1000));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(HedgeLatencyTrackerImpl::bucketUpperBoundMs(
+                HedgeLatencyTrackerImpl::bucketIndex(1000))),
+            tracker99.hedgeDelay());
+}
+
+// Older response times weigh less once the histogram decays, so the percentile follows a latency
+// shift.
+TEST(HedgeLatencyTrackerImplTest, Decay) {
+  HedgePolicy::LatencyPercentileHedging config;
+  HedgeLatencyTrackerImpl tracker(config);
+  for (int i = 0; i < 1000; i++) {
+    tracker.recordResponseTime(std::chrono::milliseconds(100));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(104), tracker.hedgeDelay());
+  for (int i = 0; i < 5000; i++) {
+    tracker.recordResponseTime(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(std::chrono::milliseconds(11), tracker.hedgeDelay());
+}
+
+TEST(HedgeLatencyTrackerImplTest, HedgeBudget) {
+  HedgePolicy::LatencyPercentileHedging config;
+  config.mutable_hedge_budget()->set_value(20);
+  HedgeLatencyTrackerImpl tracker(config);
+  EXPECT_FALSE(tracker.tryAcquireHedge());
+  for (int i = 0; i < 10; i++) {
+    tracker.onRequest();
+  }
+  EXPECT_TRUE(tracker.tryAcquireHedge());
+  EXPECT_TRUE(tracker.tryAcquireHedge());
+  EXPECT_FALSE(tracker.tryAcquireHedge());
+  for (int i = 0; i < 5; i++) {
+    tracker.onRequest();
+  }
+  EXPECT_TRUE(tracker.tryAcquireHedge());
+  EXPECT_FALSE(tracker.tryAcquireHedge());
+}
+
+TEST(HedgeLatencyTrackerImplTest, ZeroHedgeBudget) {
+  HedgePolicy::LatencyPercentileHedging config;
+  config.mutable_hedge_budget()->set_value(0);
+  HedgeLatencyTrackerImpl tracker(config);
+  for (int i = 0; i < 100; i++) {
+    tracker.onRequest();
+  }
+  EXPECT_FALSE(tracker.tryAcquireHedge());
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
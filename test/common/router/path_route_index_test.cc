@@ -0,0 +1,117 @@
+#include "source/common/router/path_route_index.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using Candidates = PathRouteIndex::Candidates;
+
+TEST(PathRouteIndexTest, Empty) {
+  PathRouteIndex index;
+  index.compile();
+  EXPECT_EQ(Candidates(), index.candidates(""));
+  EXPECT_EQ(Candidates(), index.candidates("/foo"));
+}
+
+TEST(PathRouteIndexTest, PrefixAndExact) {
+  PathRouteIndex index;
+  index.addPrefix("/foo/", 0);
+  index.addExact("/foo/bar", 1);
+  index.addPrefix("/foo/bar", 2);
+  index.addPrefix("/", 3);
+  index.addExact("/foo", 4);
+  index.addPrefix("", 5);
+  index.compile();
+
+  EXPECT_EQ(Candidates({0, 1, 2, 3, 5}), index.candidates("/foo/bar"));
+  EXPECT_EQ(Candidates({0, 2, 3, 5}), index.candidates("/foo/barbaz"));
+  EXPECT_EQ(Candidates({0, 3, 5}), index.candidates("/foo/ba"));
+  EXPECT_EQ(Candidates({3, 4, 5}), index.candidates("/foo"));
+  EXPECT_EQ(Candidates({3, 5}), index.candidates("/fo"));
+  EXPECT_EQ(Candidates({3, 5}), index.candidates("/other"));
+  EXPECT_EQ(Candidates({5}), index.candidates("other"));
+  EXPECT_EQ(Candidates({5}), index.candidates(""));
+}
+
+// Literals that end or diverge inside an existing edge of the trie split it.
+TEST(PathRouteIndexTest, SplitsEdges) {
+  PathRouteIndex index;
+  index.addPrefix("/api/service_1/", 0);
+  index.addPrefix("/api/service_2/", 1);
+  index.addExact("/api/", 2);
+  index.addPrefix("/api/service_1", 3);
+  index.addExact("/api/service_11/resource", 4);
+  index.compile();
+
+  EXPECT_EQ(Candidates({0, 3}), index.candidates("/api/service_1/resource"));
+  EXPECT_EQ(Candidates({3, 4}), index.candidates("/api/service_11/resource"));
+  EXPECT_EQ(Candidates({3}), index.candidates("/api/service_11/resourc"));
+  EXPECT_EQ(Candidates({1}), index.candidates("/api/service_2/"));
+  EXPECT_EQ(Candidates({2}), index.candidates("/api/"));
+  EXPECT_EQ(Candidates(), index.candidates("/api"));
+  EXPECT_EQ(Candidates(), index.candidates("/api/service_3/"));
+}
+
+TEST(PathRouteIndexTest, DuplicateLiterals) {
+  PathRouteIndex index;
+  index.addExact("/foo", 0);
+  index.addPrefix("/foo", 1);
+  index.addExact("/foo", 2);
+  index.addPrefix("/foo", 3);
+  index.compile();
+
+  EXPECT_EQ(Candidates({0, 1, 2, 3}), index.candidates("/foo"));
+  EXPECT_EQ(Candidates({1, 3}), index.candidates("/foobar"));
+}
+
+// Unindexed routes are candidates for every path, in route order.
+TEST(PathRouteIndexTest, Unindexed) {
+  PathRouteIndex index;
+  index.addUnindexed(0);
+  index.addPrefix("/foo", 1);
+  index.addUnindexed(2);
+  index.addExact("/bar", 3);
+  index.addUnindexed(4);
+  index.compile();
+
+  EXPECT_EQ(3, index.unindexedRoutes());
+  EXPECT_EQ(Candidates({0, 1, 2, 4}), index.candidates("/foo"));
+  EXPECT_EQ(Candidates({0, 2, 3, 4}), index.candidates("/bar"));
+  EXPECT_EQ(Candidates({0, 2, 4}), index.candidates("/baz"));
+}
+
+// Regexes must match the whole path, like the RE2 route matchers.
+TEST(PathRouteIndexTest, Regex) {
+  PathRouteIndex index;
+  EXPECT_TRUE(index.addRegex("/shelves/[^/]+/books", 0));
+  index.addPrefix("/shelves/", 1);
+  EXPECT_TRUE(index.addRegex("/shelves/[0-9]+/.*", 2));
+  EXPECT_TRUE(index.addRegex("^/shelves/1/books$", 3));
+  EXPECT_TRUE(index.addRegex("/other", 4));
+  index.compile();
+
+  EXPECT_EQ(0, index.unindexedRoutes());
+  EXPECT_EQ(Candidates({0, 1, 2, 3}), index.candidates("/shelves/1/books"));
+  EXPECT_EQ(Candidates({0, 1}), index.candidates("/shelves/a/books"));
+  EXPECT_EQ(Candidates({1, 2}), index.candidates("/shelves/12/books/1"));
+  EXPECT_EQ(Candidates({1}), index.candidates("/shelves/a/books/1"));
+  EXPECT_EQ(Candidates({4}), index.candidates("/other"));
+  EXPECT_EQ(Candidates(), index.candidates("/other/books"));
+}
+
+TEST(PathRouteIndexTest, InvalidRegex) {
+  PathRouteIndex index;
+  EXPECT_FALSE(index.addRegex("/shelves/(", 0));
+  index.addUnindexed(0);
+  EXPECT_TRUE(index.addRegex("/shelves", 1));
+  index.compile();
+
+  EXPECT_EQ(Candidates({0, 1}), index.candidates("/shelves"));
+  EXPECT_EQ(Candidates({0}), index.candidates("/books"));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
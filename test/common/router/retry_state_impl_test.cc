@@ -1394,6 +1394,71 @@ TEST_F(RouterRetryStateImplTest, BudgetNoAvailableRetries) {
             state_->shouldRetryHeaders(response_headers, request_headers, header_callback_));
 }
 
+// Retries withdraw the tokens deposited by the requests, and aren't done once the bucket is empty.
+TEST_F(RouterRetryStateImplTest, RetryTokenBucketExhausted) {
+  envoy::config::cluster::v3::CircuitBreakers::Thresholds::RetryTokenBucket config;
+  config.mutable_retry_percent()->set_value(50);
+  config.mutable_min_retries_per_second()->set_value(0);
+  config.mutable_max_tokens()->set_value(1);
+  cluster_.resetResourceManagerWithRetryTokenBucket(5 /* rq_retry */, config);
+
+  Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-retry-on", "5xx"}};
+  setup(request_headers);
+  expectTimerCreateAndEnable();
+  Http::TestResponseHeaderMapImpl response_headers{{":status", "500"}};
+  EXPECT_EQ(RetryStatus::Yes,
+            state_->shouldRetryHeaders(response_headers, request_headers, header_callback_));
+
+  // The request only deposited half a token, so the next retry is denied.
+  setup(request_headers);
+  EXPECT_EQ(RetryStatus::NoOverflow,
+            state_->shouldRetryHeaders(response_headers, request_headers, header_callback_));
+  EXPECT_EQ(1UL, cluster_.trafficStats()->upstream_rq_retry_token_bucket_exhausted_.value());
+  EXPECT_EQ(1UL, cluster_.trafficStats()->upstream_rq_retry_overflow_.value());
+  EXPECT_EQ(1UL, virtual_cluster_.stats().upstream_rq_retry_overflow_.value());
+
+  // Another request completes the token.
+  setup(request_headers);
+  expectTimerCreateAndEnable();
+  EXPECT_EQ(RetryStatus::Yes,
+            state_->shouldRetryHeaders(response_headers, request_headers, header_callback_));
+}
+
+// The backoff grows with the share of the recent attempts of the cluster which failed.
+TEST_F(RouterRetryStateImplTest, RetryTokenBucketBackoffMultiplier) {
+  envoy::config::cluster::v3::CircuitBreakers::Thresholds::RetryTokenBucket config;
+  config.mutable_max_backoff_multiplier()->set_value(3);
+  cluster_.resetResourceManagerWithRetryTokenBucket(5 /* rq_retry */, config);
+  Upstream::RetryTokenBucket& bucket =
+      cluster_.resourceManager(Upstream::ResourcePriority::Default).retryTokenBucket().ref();
+
+  policy_.num_retries_ = 5;
+  policy_.retry_on_ = RetryPolicy::RETRY_ON_CONNECT_FAILURE;
+  setup();
+
+  // One attempt which failed: the backoff is tripled.
+  EXPECT_CALL(random_, random()).WillOnce(Return(190));
+  retry_timer_ = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*retry_timer_, enableTimer(std::chrono::milliseconds(45), _));
+  EXPECT_EQ(
+      RetryStatus::Yes,
+      state_->shouldRetryReset(connect_failure_, RetryState::Http3Used::Unknown, reset_callback_));
+  EXPECT_CALL(callback_ready_, ready());
+  retry_timer_->invokeCallback();
+
+  // Half of the six attempts, including the one retried below, failed: the backoff is doubled.
+  bucket.onAttemptComplete(false);
+  bucket.onAttemptComplete(false);
+  EXPECT_DOUBLE_EQ(5.0 / 3, bucket.backoffMultiplier());
+  bucket.onAttemptComplete(true);
+  bucket.onAttemptComplete(false);
+  EXPECT_CALL(random_, random()).WillOnce(Return(190));
+  EXPECT_CALL(*retry_timer_, enableTimer(std::chrono::milliseconds(80), _));
+  EXPECT_EQ(
+      RetryStatus::Yes,
+      state_->shouldRetryReset(connect_failure_, RetryState::Http3Used::Unknown, reset_callback_));
+}
+
 TEST_F(RouterRetryStateImplTest, BudgetVerifyMinimumConcurrency) {
   // Expect no available retries from resource manager.
   cluster_.resetResourceManagerWithRetryBudget(
@@ -1321,6 +1321,55 @@ TEST_F(RouterTest, TimeoutBudgetHistogramStatOnlyGlobal) {
   response_decoder->decodeData(data, true);
 }
 
+// With deadline shedding enabled, the connection pool is given the deadline of the global timeout
+// once the downstream request is complete.
+TEST_F(RouterTest, StreamDeadline) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.conn_pool_deadline_shedding", "true"}});
+
+  absl::optional<MonotonicTime> deadline;
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_, newStream(_, _, _))
+      .WillOnce(Invoke([&](Http::ResponseDecoder&, Http::ConnectionPool::Callbacks&,
+                           const Http::ConnectionPool::Instance::StreamOptions& options)
+                           -> Http::ConnectionPool::Cancellable* {
+        deadline = options.deadline_;
+        return &cancellable_;
+      }));
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers{{"x-envoy-upstream-rq-timeout-ms", "200"}};
+  HttpTestUtility::addDefaultHeaders(headers);
+  const MonotonicTime now = callbacks_.dispatcher_.timeSource().monotonicTime();
+  router_->decodeHeaders(headers, true);
+  EXPECT_EQ(now + std::chrono::milliseconds(200), deadline);
+
+  EXPECT_CALL(cancellable_, cancel(_));
+  router_->onDestroy();
+}
+
+// The deadline is not known while the downstream request is still being received.
+TEST_F(RouterTest, NoStreamDeadlineBeforeRequestComplete) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.conn_pool_deadline_shedding", "true"}});
+
+  absl::optional<MonotonicTime> deadline;
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_, newStream(_, _, _))
+      .WillOnce(Invoke([&](Http::ResponseDecoder&, Http::ConnectionPool::Callbacks&,
+                           const Http::ConnectionPool::Instance::StreamOptions& options)
+                           -> Http::ConnectionPool::Cancellable* {
+        deadline = options.deadline_;
+        return &cancellable_;
+      }));
+
+  Http::TestRequestHeaderMapImpl headers{{"x-envoy-upstream-rq-timeout-ms", "200"}};
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, false);
+  EXPECT_FALSE(deadline.has_value());
+
+  EXPECT_CALL(cancellable_, cancel(_));
+  router_->onDestroy();
+}
+
 // Verify the timeout budget histograms are filled out correctly across retries.
 TEST_F(RouterTest, TimeoutBudgetHistogramStatDuringRetries) {
   NiceMock<Http::MockRequestEncoder> encoder1;
@@ -2090,6 +2139,65 @@ TEST_F(RouterTest, HedgedPerTryTimeoutFirstRequestSucceeds) {
   // TODO: Verify hedge stats here once they are implemented.
 }
 
+// A route hedging on the latency percentile uses the percentile as the per try timeout, and
+// doesn't hedge the request once its hedge budget is used up.
+TEST_F(RouterTest, HedgedOnLatencyPercentileOverBudget) {
+  enableHedgeOnPerTryTimeout();
+  envoy::config::route::v3::HedgePolicy::LatencyPercentileHedging config;
+  config.mutable_hedge_budget()->set_value(0);
+  HedgeLatencyTrackerImpl tracker(config);
+  for (int i = 0; i < 100; i++) {
+    tracker.recordResponseTime(std::chrono::milliseconds(10));
+  }
+  callbacks_.route_->route_entry_.hedge_policy_.latency_tracker_ = &tracker;
+
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder1 = nullptr;
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_, newStream(_, _, _))
+      .WillOnce(
+          Invoke([&](Http::ResponseDecoder& decoder, Http::ConnectionPool::Callbacks& callbacks,
+                     const Http::ConnectionPool::Instance::StreamOptions&)
+                     -> Http::ConnectionPool::Cancellable* {
+            response_decoder1 = &decoder;
+            EXPECT_CALL(*router_->retry_state_, onHostAttempted(_));
+            callbacks.onPoolReady(encoder1, cm_.thread_local_cluster_.conn_pool_.host_,
+                                  upstream_stream_info_, Http::Protocol::Http10);
+            return nullptr;
+          }));
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+              putResult(Upstream::Outlier::Result::LocalOriginConnectSuccess,
+                        absl::optional<uint64_t>(absl::nullopt)));
+  per_try_timeout_ = new Event::MockTimer(&callbacks_.dispatcher_);
+  EXPECT_CALL(*per_try_timeout_, enableTimer(std::chrono::milliseconds(11), _));
+  EXPECT_CALL(*per_try_timeout_, disableTimer());
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+
+  // Exceeding the percentile is neither a timeout for outlier detection nor, without budget, a
+  // reason to hedge.
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+              putResult(Upstream::Outlier::Result::LocalOriginTimeout, _))
+      .Times(0);
+  EXPECT_CALL(*router_->retry_state_, shouldHedgeRetryPerTryTimeout(_)).Times(0);
+  EXPECT_CALL(encoder1.stream_, resetStream(_)).Times(0);
+  per_try_timeout_->invokeCallback();
+  EXPECT_EQ(1U, router_->upstreamRequests().size());
+
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  EXPECT_CALL(*router_->retry_state_, wouldRetryFromHeaders(_, _, _))
+      .WillOnce(Return(RetryState::RetryDecision::NoRetry));
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+              putHttpResponseCode(200));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  ASSERT(response_decoder1);
+  response_decoder1->decodeHeaders(std::move(response_headers), true);
+  EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
+}
+
 // Tests that an upstream request is reset even if it can't be retried as long as there is
 // another in-flight request we're waiting on.
 // Sequence:
@@ -2583,6 +2691,55 @@ TEST_F(RouterTest, RetryRequestDuringBody) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 1));
 }
 
+// Test that retries reference the buffered request body rather than copying it.
+TEST_F(RouterTest, RetryRequestSharesBufferedBody) {
+  Buffer::OwnedImpl decoding_buffer;
+  EXPECT_CALL(callbacks_, decodingBuffer()).WillRepeatedly(Return(&decoding_buffer));
+  EXPECT_CALL(callbacks_, addDecodedData(_, true))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) { decoding_buffer.move(data); }));
+
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers{{"x-envoy-retry-on", "5xx"}, {"x-envoy-internal", "true"}};
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, false);
+  const void* first_attempt_data = nullptr;
+  EXPECT_CALL(encoder1, encodeData(BufferStringEqual("body"), false))
+      .WillOnce(Invoke(
+          [&](Buffer::Instance& data, bool) { first_attempt_data = data.frontSlice().mem_; }));
+  Buffer::OwnedImpl body("body");
+  EXPECT_CALL(*router_->retry_state_, enabled()).WillOnce(Return(true));
+  router_->decodeData(body, false);
+  EXPECT_EQ(first_attempt_data, decoding_buffer.frontSlice().mem_);
+
+  router_->retry_state_->expectResetRetry();
+  encoder1.stream_.resetStream(Http::StreamResetReason::RemoteReset);
+
+  NiceMock<Http::MockRequestEncoder> encoder2;
+  expectNewStreamWithImmediateEncoder(encoder2, &response_decoder, Http::Protocol::Http10);
+  EXPECT_CALL(encoder2, encodeData(BufferStringEqual("body"), false))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) {
+        EXPECT_EQ(first_attempt_data, data.frontSlice().mem_);
+      }));
+  router_->retry_state_->callback_();
+
+  // Data added to the buffered body by someone else is copied.
+  decoding_buffer.add("more");
+  NiceMock<Http::MockRequestEncoder> encoder3;
+  router_->retry_state_->expectResetRetry();
+  encoder2.stream_.resetStream(Http::StreamResetReason::RemoteReset);
+  expectNewStreamWithImmediateEncoder(encoder3, &response_decoder, Http::Protocol::Http10);
+  EXPECT_CALL(encoder3, encodeData(BufferStringEqual("bodymore"), false))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) {
+        EXPECT_NE(first_attempt_data, data.frontSlice().mem_);
+      }));
+  router_->retry_state_->callback_();
+  router_->onDestroy();
+}
+
 // Test retrying a request, when the first attempt fails while the client
 // is sending the body, with more data arriving in between upstream attempts
 // (which would normally happen during the backoff timer interval), but not end_stream.
@@ -0,0 +1,84 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/common/random_generator.h"
+#include "source/common/runtime/runtime_features.h"
+#include "source/common/runtime/runtime_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Runtime {
+namespace {
+
+constexpr absl::string_view Key = "upstream.healthy_panic_threshold";
+
+// A snapshot holding the key among as many other keys as a large runtime config.
+class SnapshotForBenchmark {
+public:
+  SnapshotForBenchmark() {
+    ProtobufWkt::Struct values;
+    for (int i = 0; i < 1000; i++) {
+      (*values.mutable_fields())[absl::StrCat("some.runtime.key_", i)].set_number_value(i);
+    }
+    (*values.mutable_fields())[std::string(Key)].set_number_value(50);
+    std::vector<Snapshot::OverrideLayerConstPtr> layers;
+    layers.push_back(std::make_unique<const ProtoLayer>("base", values));
+    snapshot_ = std::make_unique<SnapshotImpl>(generator_, stats_, std::move(layers));
+  }
+
+  const Snapshot& snapshot() const { return *snapshot_; }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  RuntimeStats stats_{ALL_RUNTIME_STATS(POOL_COUNTER(store_), POOL_GAUGE(store_))};
+  Random::RandomGeneratorImpl generator_;
+  std::unique_ptr<SnapshotImpl> snapshot_;
+};
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_GetIntegerByName(benchmark::State& state) {
+  SnapshotForBenchmark snapshot;
+
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(snapshot.snapshot().getInteger(Key, 0));
+  }
+}
+BENCHMARK(BM_GetIntegerByName);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_GetIntegerByRegisteredKey(benchmark::State& state) {
+  static const RegisteredKey key(Key);
+  SnapshotForBenchmark snapshot;
+
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(snapshot.snapshot().getInteger(key, 0));
+  }
+}
+BENCHMARK(BM_GetIntegerByRegisteredKey);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RuntimeFeatureEnabledByName(benchmark::State& state) {
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(
+        runtimeFeatureEnabled("envoy.reloadable_features.conn_pool_deadline_shedding"));
+  }
+}
+BENCHMARK(BM_RuntimeFeatureEnabledByName);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RuntimeFeatureEnabledByHandle(benchmark::State& state) {
+  static const RuntimeFeature feature("envoy.reloadable_features.conn_pool_deadline_shedding");
+
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(feature.enabled());
+  }
+}
+BENCHMARK(BM_RuntimeFeatureEnabledByHandle);
+
+} // namespace Runtime
+} // namespace Envoy
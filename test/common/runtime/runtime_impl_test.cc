@@ -545,6 +545,38 @@ TEST_F(StaticLoaderImplTest, All) {
   testNewOverrides(*loader_, store_);
 }
 
+// Verifies that the registered keys read the same values as their names, including the keys
+// registered after the snapshot was created.
+TEST_F(StaticLoaderImplTest, RegisteredKeys) {
+  base_ = TestUtility::parseYaml<ProtobufWkt::Struct>(R"EOF(
+    registered_integer: 42
+    registered_percent: 30
+    registered_boolean: false
+  )EOF");
+  const RegisteredKey integer("registered_integer");
+  const RegisteredKey percent("registered_percent");
+  const RegisteredKey missing("registered_missing");
+  setup();
+  const RegisteredKey boolean("registered_boolean");
+  const RegisteredKey same_integer("registered_integer");
+  EXPECT_EQ(integer.index(), same_integer.index());
+
+  const Snapshot& snapshot = loader_->snapshot();
+  EXPECT_EQ(42, snapshot.getInteger(integer, 1));
+  EXPECT_EQ(42, snapshot.getInteger(same_integer, 1));
+  EXPECT_EQ(1, snapshot.getInteger(missing, 1));
+  EXPECT_FALSE(snapshot.getBoolean(boolean, true));
+  EXPECT_TRUE(snapshot.getBoolean(missing, true));
+  EXPECT_TRUE(snapshot.featureEnabled(percent, 0, 29));
+  EXPECT_FALSE(snapshot.featureEnabled(percent, 100, 30));
+  EXPECT_CALL(generator_, random()).WillOnce(Return(31));
+  EXPECT_FALSE(snapshot.featureEnabled(percent, 100));
+  EXPECT_TRUE(snapshot.featureEnabled(missing, 100));
+
+  loader_->mergeValues({{"registered_missing", "7"}});
+  EXPECT_EQ(7, loader_->snapshot().getInteger(missing, 1));
+}
+
 #ifdef ENVOY_ENABLE_QUIC
 TEST_F(StaticLoaderImplTest, QuicheReloadableFlags) {
   // Test that Quiche flags can be overwritten via Envoy runtime config.
@@ -839,6 +871,10 @@ TEST(NoRuntime, FeatureEnabled) {
   // Feature defaults should still work.
   EXPECT_EQ(false, runtimeFeatureEnabled("envoy.reloadable_features.test_feature_false"));
   EXPECT_EQ(true, runtimeFeatureEnabled("envoy.reloadable_features.test_feature_true"));
+  EXPECT_FALSE(RuntimeFeature("envoy.reloadable_features.test_feature_false").enabled());
+  EXPECT_TRUE(RuntimeFeature("envoy.reloadable_features.test_feature_true").enabled());
+  EXPECT_ENVOY_BUG(EXPECT_FALSE(RuntimeFeature("envoy.reloadable_features.removed_foo").enabled()),
+                   "Unable to find runtime feature");
 }
 
 TEST(NoRuntime, DefaultIntValues) {
@@ -7,6 +7,7 @@
 #include "source/common/stats/allocator_impl.h"
 
 #include "test/common/stats/stat_test_utility.h"
+#include "test/test_common/environment.h"
 #include "test/test_common/logging.h"
 #include "test/test_common/thread_factory_for_test.h"
 
@@ -86,6 +87,26 @@ TEST_F(AllocatorImplTest, GaugesWithSameName) {
   EXPECT_EQ(0, g2->value());
 }
 
+TEST_F(AllocatorImplTest, GaugeLatchChanged) {
+  GaugeSharedPtr gauge =
+      alloc_.makeGauge(makeStat("gauge.name"), StatName(), {}, Gauge::ImportMode::Accumulate);
+  // New gauges are considered changed.
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->set(3);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+  gauge->inc();
+  EXPECT_TRUE(gauge->latchChanged());
+  gauge->dec();
+  EXPECT_TRUE(gauge->latchChanged());
+  gauge->setParentValue(1);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+  EXPECT_EQ(4, gauge->value());
+}
+
 // Test for a race-condition where we may decrement the ref-count of a stat to
 // zero at the same time as we are allocating another instance of that
 // stat. This test reproduces that race organically by having a 12 threads each
@@ -552,6 +573,43 @@ TEST_F(AllocatorImplTest, ForEachSinkedTextReadout) {
   EXPECT_EQ(num_iterations, 0);
 }
 
+// Counters and accumulated gauges are placed in the shared memory region while it has room.
+TEST_F(AllocatorImplTest, SharedMemoryRegion) {
+  const std::string path = TestEnvironment::temporaryPath("allocator_shared_memory_stats");
+  SharedMemoryStatsRegion region(path, 2, false);
+  {
+    AllocatorImpl alloc(symbol_table_, &region);
+    CounterSharedPtr counter = alloc.makeCounter(makeStat("counter"), StatName(), {});
+    counter->add(3);
+    GaugeSharedPtr accumulated = alloc.makeGauge(makeStat("accumulated"), StatName(), {},
+                                                 Gauge::ImportMode::Accumulate);
+    accumulated->set(4);
+    GaugeSharedPtr never_import = alloc.makeGauge(makeStat("never_import"), StatName(), {},
+                                                  Gauge::ImportMode::NeverImport);
+    never_import->set(5);
+    // The region is full, so this counter is kept in process memory.
+    CounterSharedPtr overflow = alloc.makeCounter(makeStat("overflow"), StatName(), {});
+    overflow->inc();
+    EXPECT_EQ(1, overflow->value());
+
+    std::vector<std::string> slots;
+    region.forEachSlot(
+        [&slots](absl::string_view name, SharedMemoryStatsRegion::Type, uint64_t value) {
+          slots.push_back(absl::StrCat(name, "=", value));
+        });
+    EXPECT_THAT(slots, testing::ElementsAre("counter=3", "accumulated=4"));
+    EXPECT_EQ(3, counter->latch());
+  }
+
+  // Stats created again, e.g. after a hot restart, start from the value in the region.
+  AllocatorImpl alloc(symbol_table_, &region);
+  CounterSharedPtr counter = alloc.makeCounter(makeStat("counter"), StatName(), {});
+  EXPECT_EQ(3, counter->value());
+  EXPECT_TRUE(counter->used());
+  EXPECT_EQ(0, counter->latch());
+  TestEnvironment::removePath(path);
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
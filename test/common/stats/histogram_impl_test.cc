@@ -107,5 +107,37 @@ TEST_F(HistogramSettingsImplTest, ScaledPercent) {
   EXPECT_EQ(settings_->buckets("abcd"), ConstSupportedBuckets({0.1, 2}));
 }
 
+// Values recorded by AtomicLogLinearBuckets land in the same circllhist bins as when they are
+// inserted directly.
+TEST(AtomicLogLinearBucketsTest, SameBinsAsCircllhist) {
+  histogram_t* expected = hist_alloc();
+  histogram_t* drained = hist_alloc();
+  AtomicLogLinearBuckets buckets;
+  EXPECT_FALSE(buckets.drain(drained));
+
+  for (const uint64_t value : {0UL, 0UL, 1UL, 5UL, 9UL, 10UL, 11UL, 99UL, 100UL, 101UL, 999UL,
+                               12345UL, 12399UL, 987654321UL, 1000000000000000000UL}) {
+    buckets.recordValue(value);
+    hist_insert_intscale(expected, value, 0, 1);
+  }
+  EXPECT_TRUE(buckets.drain(drained));
+  // Everything was drained.
+  EXPECT_FALSE(buckets.drain(drained));
+
+  buckets.recordValue(12);
+  hist_insert_intscale(expected, 12, 0, 1);
+  EXPECT_TRUE(buckets.drain(drained));
+
+  HistogramStatisticsImpl expected_statistics(expected);
+  HistogramStatisticsImpl drained_statistics(drained);
+  EXPECT_EQ(16, drained_statistics.sampleCount());
+  EXPECT_EQ(expected_statistics.sampleCount(), drained_statistics.sampleCount());
+  EXPECT_DOUBLE_EQ(expected_statistics.sampleSum(), drained_statistics.sampleSum());
+  EXPECT_EQ(expected_statistics.quantileSummary(), drained_statistics.quantileSummary());
+  EXPECT_EQ(expected_statistics.bucketSummary(), drained_statistics.bucketSummary());
+  hist_free(expected);
+  hist_free(drained);
+}
+
 } // namespace Stats
 } // namespace Envoy
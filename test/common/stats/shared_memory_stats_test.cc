@@ -0,0 +1,111 @@
+#include <map>
+#include <string>
+
+#include "source/common/stats/shared_memory_stats.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+using Type = SharedMemoryStatsRegion::Type;
+
+class SharedMemoryStatsRegionTest : public testing::Test {
+protected:
+  SharedMemoryStatsRegionTest()
+      : path_(TestEnvironment::temporaryPath("shared_memory_stats")) {}
+  ~SharedMemoryStatsRegionTest() override { TestEnvironment::removePath(path_); }
+
+  // Sums the values of the slots of the region by name, as a reader process would.
+  static std::map<std::string, uint64_t> read(const SharedMemoryStatsRegion& region) {
+    std::map<std::string, uint64_t> values;
+    region.forEachSlot([&values](absl::string_view name, Type type, uint64_t value) {
+      values[absl::StrCat(type == Type::Counter ? "counter:" : "gauge:", name)] += value;
+    });
+    return values;
+  }
+
+  const std::string path_;
+};
+
+TEST_F(SharedMemoryStatsRegionTest, AllocateAndRead) {
+  SharedMemoryStatsRegion region(path_, 10, false);
+  std::atomic<uint64_t>* counter = region.allocate("cluster.foo.upstream_rq_total", Type::Counter);
+  ASSERT_NE(nullptr, counter);
+  EXPECT_EQ(counter, region.allocate("cluster.foo.upstream_rq_total", Type::Counter));
+  std::atomic<uint64_t>* gauge = region.allocate("cluster.foo.upstream_rq_total", Type::Gauge);
+  ASSERT_NE(nullptr, gauge);
+  EXPECT_NE(counter, gauge);
+  *counter += 5;
+  *gauge = 3;
+
+  EXPECT_TRUE(region.contains("cluster.foo.upstream_rq_total", Type::Counter));
+  EXPECT_FALSE(region.contains("cluster.bar.upstream_rq_total", Type::Counter));
+  EXPECT_EQ((std::map<std::string, uint64_t>{{"counter:cluster.foo.upstream_rq_total", 5},
+                                             {"gauge:cluster.foo.upstream_rq_total", 3}}),
+            read(region));
+  EXPECT_EQ(SharedMemoryStatsRegion::size(10),
+            TestEnvironment::readFileToStringForTest(path_).size());
+}
+
+TEST_F(SharedMemoryStatsRegionTest, Full) {
+  SharedMemoryStatsRegion region(path_, 2, false);
+  EXPECT_NE(nullptr, region.allocate("a", Type::Counter));
+  EXPECT_NE(nullptr, region.allocate("b", Type::Counter));
+  EXPECT_EQ(nullptr, region.allocate("c", Type::Counter));
+  EXPECT_NE(nullptr, region.allocate("a", Type::Counter));
+  EXPECT_EQ(2, read(region).size());
+}
+
+// Names can't use more than their share of the name table.
+TEST_F(SharedMemoryStatsRegionTest, NameTableFull) {
+  SharedMemoryStatsRegion region(path_, 1, false);
+  const std::string name(SharedMemoryStatsRegion::NameBytesPerSlot + 1, 'a');
+  EXPECT_EQ(nullptr, region.allocate(name, Type::Counter));
+  EXPECT_TRUE(read(region).empty());
+}
+
+// A hot restarted process attaching to the region shares the slots of its parent.
+TEST_F(SharedMemoryStatsRegionTest, AttachExisting) {
+  {
+    SharedMemoryStatsRegion parent(path_, 10, false);
+    *parent.allocate("counter", Type::Counter) += 7;
+
+    SharedMemoryStatsRegion child(path_, 10, true);
+    EXPECT_TRUE(child.contains("counter", Type::Counter));
+    std::atomic<uint64_t>* counter = child.allocate("counter", Type::Counter);
+    EXPECT_EQ(7, *counter);
+    *counter += 1;
+
+    // Slots allocated by the parent after the child attached are found too.
+    *parent.allocate("new_counter", Type::Counter) += 2;
+    EXPECT_EQ(2, *child.allocate("new_counter", Type::Counter));
+
+    EXPECT_EQ(
+        (std::map<std::string, uint64_t>{{"counter:counter", 8}, {"counter:new_counter", 2}}),
+        read(parent));
+  }
+
+  // Not attaching clears the region.
+  SharedMemoryStatsRegion fresh(path_, 10, false);
+  EXPECT_TRUE(read(fresh).empty());
+}
+
+TEST_F(SharedMemoryStatsRegionTest, AttachIncompatible) {
+  { SharedMemoryStatsRegion region(path_, 10, false); }
+  EXPECT_THROW_WITH_REGEX(SharedMemoryStatsRegion(path_, 20, true), EnvoyException,
+                          "has size .*, expected .* for 20 stats");
+}
+
+TEST_F(SharedMemoryStatsRegionTest, CannotOpen) {
+  EXPECT_THROW_WITH_REGEX(SharedMemoryStatsRegion("/nonexistent/dir/stats", 10, false),
+                          EnvoyException, "cannot open shared memory stats file");
+}
+
+} // namespace
+} // namespace Stats
+} // namespace Envoy
@@ -169,6 +169,32 @@ TEST_F(StatNameTest, TestDynamicPools) {
   EXPECT_NE(dynamic2.data(), dynamic.data());
 }
 
+TEST_F(StatNameTest, EncodingCache) {
+  StatNameEncodingCache cache(table_, 2);
+  const StatName a = cache.get("a.b");
+  EXPECT_EQ("a.b", table_.toString(a));
+  EXPECT_EQ(a.data(), cache.get("a.b").data());
+  EXPECT_EQ(makeStat("a.b"), a);
+
+  // Cached names share their symbols with the other names of the table.
+  const StatName c = cache.get("c.b");
+  EXPECT_EQ("c.b", table_.toString(c));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(3, table_.numSymbols());
+
+  // "a.b" was used more recently than "c.b", which is evicted.
+  EXPECT_EQ(a.data(), cache.get("a.b").data());
+  EXPECT_EQ("d", table_.toString(cache.get("d")));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(3, table_.numSymbols());
+  EXPECT_EQ(a.data(), cache.get("a.b").data());
+
+  cache.clear();
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(2, table_.numSymbols());
+  EXPECT_EQ("a.b", table_.toString(cache.get("a.b")));
+}
+
 TEST_F(StatNameTest, TestDynamicHash) {
   StatNameDynamicPool dynamic(table_);
   const StatName d1 = dynamic.add("dynamic");
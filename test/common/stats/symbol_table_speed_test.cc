@@ -212,3 +212,52 @@ static void bmSetStrings(benchmark::State& state) {
   }
 }
 BENCHMARK(bmSetStrings);
+
+// Encodes the same dynamically built names from several threads, either
+// directly with the symbol table, or through a per-thread
+// StatNameEncodingCache when state.range(0) is 1.
+//
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeContention(benchmark::State& state) {
+  const bool use_cache = state.range(0) == 1;
+  Envoy::Stats::SymbolTableImpl symbol_table;
+  Envoy::Stats::StatNamePool pool(symbol_table);
+  std::vector<std::string> names;
+  for (Envoy::Stats::StatName stat_name : prepareNames(pool, 64)) {
+    names.emplace_back(symbol_table.toString(stat_name));
+  }
+  Envoy::Thread::ThreadFactory& thread_factory = Envoy::Thread::threadFactoryForTest();
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    constexpr int num_threads = 8;
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    threads.reserve(num_threads);
+    Envoy::ConditionalInitializer access;
+    absl::BlockingCounter accesses(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(
+          thread_factory.createThread([&access, &accesses, &symbol_table, &names, use_cache]() {
+            Envoy::Stats::StatNameEncodingCache cache(symbol_table, names.size());
+            access.wait();
+            for (int count = 0; count < 1000; ++count) {
+              for (const std::string& name : names) {
+                if (use_cache) {
+                  benchmark::DoNotOptimize(cache.get(name).data());
+                } else {
+                  Envoy::Stats::StatNameManagedStorage storage(name, symbol_table);
+                  benchmark::DoNotOptimize(storage.statName().data());
+                }
+              }
+            }
+            accesses.DecrementCount();
+          }));
+    }
+    access.setReady();
+    accesses.Wait();
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+}
+BENCHMARK(bmEncodeContention)->Arg(0)->Arg(1)->Unit(::benchmark::kMillisecond);
@@ -46,6 +46,7 @@
 #include "source/common/config/well_known_names.h"
 #include "source/common/stats/tag_producer_impl.h"
 
+#include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -106,6 +107,55 @@ void BM_ExtractTags(benchmark::State& state) {
 }
 BENCHMARK(BM_ExtractTags)->DenseRange(0, 26, 1);
 
+// Extracts the tags of the stats created for a burst of new clusters, as after a CDS update
+// adding state.range(0) clusters.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_ExtractTagsCdsBurst(benchmark::State& state) {
+  TagProducerImpl tag_extractors{envoy::config::metrics::v3::StatsConfig()};
+  const std::vector<std::string> cluster_stats = {
+      "assignment_stale",
+      "bind_errors",
+      "lb_healthy_panic",
+      "membership_change",
+      "membership_healthy",
+      "update_success",
+      "upstream_cx_active",
+      "upstream_cx_connect_fail",
+      "upstream_cx_destroy_local_with_active_rq",
+      "upstream_cx_http2_total",
+      "upstream_cx_total",
+      "upstream_rq_200",
+      "upstream_rq_2xx",
+      "upstream_rq_503",
+      "upstream_rq_5xx",
+      "upstream_rq_pending_overflow",
+      "upstream_rq_retry",
+      "upstream_rq_timeout",
+      "upstream_rq_total",
+      "circuit_breakers.default.cx_open",
+      "circuit_breakers.high.rq_pending_open",
+      "ext_authz.authpfx.ok",
+      "grpc.grpc_service_1.grpc_method_1.success",
+      "ssl.ciphers.ECDHE-RSA-AES128-GCM-SHA256",
+      "ssl.handshake",
+  };
+  std::vector<std::string> names;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    for (const std::string& stat : cluster_stats) {
+      names.push_back(absl::StrCat("cluster.outbound|8080||service_", i, ".default.svc.", stat));
+    }
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const std::string& name : names) {
+      TagVector tags;
+      benchmark::DoNotOptimize(tag_extractors.produceTags(name, tags));
+    }
+  }
+}
+BENCHMARK(BM_ExtractTagsCdsBurst)->Arg(100)->Arg(1000)->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
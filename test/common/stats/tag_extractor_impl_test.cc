@@ -150,6 +150,18 @@ public:
     return StringUtil::removeCharacters(metric_name, remove_characters);
   }
 
+  /**
+   * @return the names of the extractors that produceTags would try on metric_name.
+   */
+  std::vector<std::string> candidateExtractors(absl::string_view metric_name) const {
+    std::vector<std::string> names;
+    tag_extractors_.forEachExtractorMatching(metric_name,
+                                             [&names](const TagExtractorPtr& tag_extractor) {
+                                               names.emplace_back(tag_extractor->name());
+                                             });
+    return names;
+  }
+
   SymbolTableImpl symbol_table_;
   TagProducerImpl tag_extractors_;
 };
@@ -455,6 +467,23 @@ TEST(TagExtractorTest, ExtAuthzTagExtractors) {
                          {grpc_cluster, ext_authz_prefix});
 }
 
+// The RE2 extractors whose regex does not match the name are skipped by the prefilter.
+TEST(TagExtractorTest, RegexPrefilter) {
+  const auto& tag_names = Config::TagNames::get();
+  DefaultTagRegexTester regex_tester;
+
+  std::vector<std::string> candidates =
+      regex_tester.candidateExtractors("cluster.ratelimit.ssl.ciphers.AES256-SHA");
+  EXPECT_THAT(candidates, testing::Contains(tag_names.SSL_CIPHER_SUITE));
+  EXPECT_THAT(candidates, testing::Contains(tag_names.CLUSTER_NAME));
+  EXPECT_THAT(candidates, testing::Not(testing::Contains(tag_names.RESPONSE_CODE)));
+
+  candidates = regex_tester.candidateExtractors("cluster.ratelimit.upstream_rq_200");
+  EXPECT_THAT(candidates, testing::Not(testing::Contains(tag_names.SSL_CIPHER_SUITE)));
+  EXPECT_THAT(candidates, testing::Contains(tag_names.CLUSTER_NAME));
+  EXPECT_THAT(candidates, testing::Contains(tag_names.RESPONSE_CODE));
+}
+
 TEST(TagExtractorTest, ExtractRegexPrefix) {
   TagExtractorPtr tag_extractor; // Keep tag_extractor in this scope to prolong prefix lifetime.
   auto extractRegexPrefix = [&tag_extractor](const std::string& regex) -> absl::string_view {
@@ -25,6 +25,7 @@
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/logging.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_split.h"
@@ -1521,6 +1522,33 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+// Same as above, with values recorded in atomic log-linear buckets.
+TEST_F(HistogramTest, AtomicBucketsMultipleMerges) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.atomic_histogram_buckets", "true"}});
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+  Histogram& h2 = scope_.histogramFromString("h2", Histogram::Unit::Unspecified);
+
+  expectCallAndAccumulate(h1, 1);
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h2, 0);
+  expectCallAndAccumulate(h2, 1234);
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h1, 2);
+  expectCallAndAccumulate(h1, 2);
+  expectCallAndAccumulate(h1, 987654);
+  EXPECT_EQ(2, validateMerge());
+
+  // Nothing recorded: the intervals are empty and the cumulative histograms unchanged.
+  EXPECT_EQ(2, validateMerge());
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h2, 3);
+  EXPECT_EQ(2, validateMerge());
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
@@ -44,6 +44,9 @@ private:
   int value_;
 };
 
+const FilterState::Slot TestSlot = FilterStateImpl::registerSlot("test_slot");
+const FilterState::Slot OtherTestSlot = FilterStateImpl::registerSlot("other_test_slot");
+
 class FilterStateImplTest : public testing::Test {
 public:
   FilterStateImplTest() {
@@ -454,5 +457,40 @@ TEST_F(FilterStateImplTest, SetSameDataWithDifferentLifeSpan) {
   EXPECT_EQ(2, filterState().getDataMutable<SimpleType>("test_2")->access());
 }
 
+TEST_F(FilterStateImplTest, RegisterSlot) {
+  EXPECT_EQ("test_slot", TestSlot.name());
+  EXPECT_NE(TestSlot.index(), OtherTestSlot.index());
+  const FilterState::Slot again = FilterStateImpl::registerSlot("test_slot");
+  EXPECT_EQ(TestSlot.index(), again.index());
+}
+
+TEST_F(FilterStateImplTest, GetDataBySlot) {
+  EXPECT_EQ(nullptr, filterState().getDataReadOnly<SimpleType>(TestSlot));
+
+  filterState().setData("other_test_slot", std::make_unique<SimpleType>(1),
+                        FilterState::StateType::Mutable);
+  EXPECT_EQ(nullptr, filterState().getDataReadOnly<SimpleType>(TestSlot));
+  EXPECT_EQ(1, filterState().getDataReadOnly<SimpleType>(OtherTestSlot)->access());
+
+  filterState().setData("test_slot", std::make_unique<SimpleType>(2),
+                        FilterState::StateType::Mutable);
+  EXPECT_EQ(2, filterState().getDataReadOnly<SimpleType>(TestSlot)->access());
+  EXPECT_EQ(nullptr, filterState().getDataReadOnly<TestStoredTypeTracking>(TestSlot));
+
+  // Replacing the data updates the slot.
+  filterState().setData("test_slot", std::make_unique<SimpleType>(3),
+                        FilterState::StateType::Mutable);
+  EXPECT_EQ(3, filterState().getDataReadOnly<SimpleType>(TestSlot)->access());
+  EXPECT_EQ(filterState().getDataReadOnlyGeneric("test_slot"),
+            filterState().getDataReadOnlyGeneric(TestSlot));
+}
+
+TEST_F(FilterStateImplTest, GetDataBySlotFromParent) {
+  filterState().setData("test_slot", std::make_unique<SimpleType>(1),
+                        FilterState::StateType::ReadOnly, FilterState::LifeSpan::Connection);
+  EXPECT_EQ(1, filterState().getDataReadOnly<SimpleType>(TestSlot)->access());
+  EXPECT_EQ(nullptr, filterState().getDataReadOnly<SimpleType>(OtherTestSlot));
+}
+
 } // namespace StreamInfo
 } // namespace Envoy
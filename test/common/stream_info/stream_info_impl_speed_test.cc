@@ -0,0 +1,47 @@
+#include "source/common/common/macros.h"
+#include "source/common/common/utility.h"
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/stream_info/stream_info_impl.h"
+
+#include "test/benchmark/allocation_budget.h"
+#include "test/benchmark/main.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace StreamInfo {
+
+// Constructing and destroying the stream info of a stream that writes none of the sections
+// allocated on first write. The allocations are the filter state and the upstream bytes meter.
+static void streamInfoImplConstruct(benchmark::State& state) {
+  RealTimeSource time_source;
+  const auto construct = [&time_source]() {
+    StreamInfoImpl stream_info(Http::Protocol::Http11, time_source, nullptr);
+    benchmark::DoNotOptimize(&stream_info);
+  };
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    construct();
+  }
+  state.counters["sizeof"] = sizeof(StreamInfoImpl);
+  AllocationBudget(2, 512).check(state, construct);
+}
+BENCHMARK(streamInfoImplConstruct);
+
+// Constructing the stream info of a stream that sets dynamic metadata and downstream timing.
+static void streamInfoImplConstructWithSections(benchmark::State& state) {
+  RealTimeSource time_source;
+  ProtobufWkt::Struct metadata;
+  (*metadata.mutable_fields())["key"].set_string_value("value");
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    StreamInfoImpl stream_info(Http::Protocol::Http11, time_source, nullptr);
+    stream_info.setDynamicMetadata("envoy.test", metadata);
+    stream_info.downstreamTiming().onLastDownstreamRxByteReceived(time_source);
+    benchmark::DoNotOptimize(&stream_info);
+  }
+}
+BENCHMARK(streamInfoImplConstructWithSections);
+
+} // namespace StreamInfo
+} // namespace Envoy
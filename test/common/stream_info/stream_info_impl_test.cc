@@ -1,5 +1,6 @@
 #include <chrono>
 #include <functional>
+#include <utility>
 
 #include "envoy/http/protocol.h"
 #include "envoy/stream_info/filter_state.h"
@@ -385,6 +386,34 @@ TEST_F(StreamInfoImplTest, DynamicMetadataTest) {
   EXPECT_TRUE(json.find("\"another_key\":\"another_value\"") != std::string::npos);
 }
 
+// The dynamic metadata and the downstream timing are only allocated once written.
+TEST_F(StreamInfoImplTest, LazilyAllocatedSections) {
+  StreamInfoImpl stream_info(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
+  const StreamInfoImpl& const_stream_info = stream_info;
+
+  EXPECT_EQ(&envoy::config::core::v3::Metadata::default_instance(),
+            &const_stream_info.dynamicMetadata());
+  EXPECT_FALSE(const_stream_info.downstreamTiming().has_value());
+
+  stream_info.setDynamicMetadata("com.test", MessageUtil::keyValueStruct("test_key", "test_value"));
+  EXPECT_NE(&envoy::config::core::v3::Metadata::default_instance(),
+            &const_stream_info.dynamicMetadata());
+  EXPECT_EQ(1, const_stream_info.dynamicMetadata().filter_metadata_size());
+
+  stream_info.downstreamTiming().onLastDownstreamRxByteReceived(test_time_.timeSystem());
+  ASSERT_TRUE(const_stream_info.downstreamTiming().has_value());
+  EXPECT_TRUE(const_stream_info.downstreamTiming()->lastDownstreamRxByteReceived().has_value());
+
+  // Copying from a stream info without dynamic metadata doesn't allocate it.
+  StreamInfoImpl copy(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
+  StreamInfoImpl empty(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
+  copy.setFrom(empty, nullptr);
+  EXPECT_EQ(&envoy::config::core::v3::Metadata::default_instance(),
+            &std::as_const(copy).dynamicMetadata());
+  copy.setFrom(stream_info, nullptr);
+  EXPECT_EQ(1, std::as_const(copy).dynamicMetadata().filter_metadata_size());
+}
+
 TEST_F(StreamInfoImplTest, DumpStateTest) {
   StreamInfoImpl stream_info(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
   std::string prefix = "";
@@ -0,0 +1,148 @@
+#include <sys/socket.h>
+
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+class TestCallbacks : public SpliceForwarder::Callbacks {
+public:
+  void onUpstreamBytesSpliced(uint64_t bytes) override { upstream_bytes_ += bytes; }
+  void onDownstreamBytesSpliced(uint64_t bytes) override { downstream_bytes_ += bytes; }
+  void onSpliceFinished() override { finished_ = true; }
+
+  uint64_t upstream_bytes_{};
+  uint64_t downstream_bytes_{};
+  bool finished_{};
+};
+
+class SpliceForwarderTest : public testing::Test {
+public:
+  SpliceForwarderTest() : api_(Api::createApiForTest()) {
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, downstream_fds_) == 0, "");
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, upstream_fds_) == 0, "");
+  }
+
+  ~SpliceForwarderTest() override {
+    forwarder_.reset();
+    for (int fd : {downstream_fds_[0], downstream_fds_[1], upstream_fds_[0], upstream_fds_[1]}) {
+      ::close(fd);
+    }
+  }
+
+  void createForwarder() {
+    // The forwarder sits between the second end of each pair; the first ends act as the peers.
+    forwarder_ = SpliceForwarder::create(*dispatcher_, downstream_fds_[1], upstream_fds_[1],
+                                         callbacks_);
+    ASSERT_NE(nullptr, forwarder_);
+  }
+
+  void runUntil(std::function<bool()> condition) {
+    for (int i = 0; i < 1000 && !condition(); ++i) {
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    }
+    ASSERT_TRUE(condition());
+  }
+
+  std::string readAll(int fd) {
+    std::string data;
+    char buffer[16 * 1024];
+    ssize_t rc;
+    while ((rc = ::read(fd, buffer, sizeof(buffer))) > 0) {
+      data.append(buffer, rc);
+    }
+    return data;
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  int downstream_fds_[2]{};
+  int upstream_fds_[2]{};
+  TestCallbacks callbacks_;
+  SpliceForwarderPtr forwarder_;
+};
+
+TEST_F(SpliceForwarderTest, ForwardsBothDirections) {
+  createForwarder();
+
+  ASSERT_EQ(5, ::write(downstream_fds_[0], "hello", 5));
+  std::string received;
+  runUntil([&]() {
+    received += readAll(upstream_fds_[0]);
+    return received.size() == 5;
+  });
+  EXPECT_EQ("hello", received);
+  EXPECT_EQ(5, callbacks_.upstream_bytes_);
+
+  ASSERT_EQ(5, ::write(upstream_fds_[0], "world", 5));
+  received.clear();
+  runUntil([&]() {
+    received += readAll(downstream_fds_[0]);
+    return received.size() == 5;
+  });
+  EXPECT_EQ("world", received);
+  EXPECT_EQ(5, callbacks_.downstream_bytes_);
+  EXPECT_FALSE(callbacks_.finished_);
+}
+
+TEST_F(SpliceForwarderTest, ForwardsDataPendingBeforeCreation) {
+  ASSERT_EQ(5, ::write(downstream_fds_[0], "hello", 5));
+  createForwarder();
+
+  std::string received;
+  runUntil([&]() {
+    received += readAll(upstream_fds_[0]);
+    return received.size() == 5;
+  });
+  EXPECT_EQ("hello", received);
+}
+
+// Nothing is read from the source socket while the pipe to a blocked destination is full.
+TEST_F(SpliceForwarderTest, AppliesBackPressure) {
+  createForwarder();
+
+  const std::string chunk(16 * 1024, 'a');
+  uint64_t written = 0;
+  for (int i = 0; i < 100; ++i) {
+    ssize_t rc;
+    while ((rc = ::write(downstream_fds_[0], chunk.data(), chunk.size())) > 0) {
+      written += rc;
+    }
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  // The writer stays blocked as the data in flight is bounded by the socket buffers and the pipe.
+  EXPECT_EQ(-1, ::write(downstream_fds_[0], chunk.data(), chunk.size()));
+  EXPECT_EQ(EAGAIN, errno);
+  EXPECT_LE(callbacks_.upstream_bytes_, written);
+
+  uint64_t received = 0;
+  runUntil([&]() {
+    received += readAll(upstream_fds_[0]).size();
+    return received == written;
+  });
+  EXPECT_EQ(written, callbacks_.upstream_bytes_);
+}
+
+TEST_F(SpliceForwarderTest, FinishesOnEndOfStream) {
+  createForwarder();
+
+  ASSERT_EQ(5, ::write(downstream_fds_[0], "hello", 5));
+  ASSERT_EQ(0, ::shutdown(downstream_fds_[0], SHUT_WR));
+  runUntil([&]() { return callbacks_.finished_; });
+
+  EXPECT_EQ("hello", readAll(upstream_fds_[0]));
+  // The end of stream is left in the socket for the connection to observe.
+  char buffer[1];
+  EXPECT_EQ(0, ::read(downstream_fds_[1], buffer, sizeof(buffer)));
+}
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
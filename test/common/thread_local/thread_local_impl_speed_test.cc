@@ -0,0 +1,74 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/common/macros.h"
+#include "source/common/thread_local/thread_local_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace ThreadLocal {
+
+// Updates state.range(0) slots on state.range(1) workers, then runs the callbacks posted to the
+// workers. The worker threads aren't started, their dispatchers are run on this thread.
+static void updateSlots(benchmark::State& state, bool batch) {
+  Api::ApiPtr api = Api::createApiForTest();
+  InstanceImpl tls;
+  Event::DispatcherPtr main_dispatcher = api->allocateDispatcher("test_main_thread");
+  tls.registerThread(*main_dispatcher, true);
+  std::vector<Event::DispatcherPtr> workers;
+  for (int64_t i = 0; i < state.range(1); i++) {
+    workers.push_back(api->allocateDispatcher(fmt::format("test_worker_thread_{}", i)));
+    tls.registerThread(*workers.back(), false);
+  }
+
+  std::vector<TypedSlotPtr<>> slots;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    slots.push_back(TypedSlot<>::makeUnique(tls));
+    slots.back()->set([](Event::Dispatcher&) -> ThreadLocalObjectSharedPtr { return nullptr; });
+  }
+  for (Event::DispatcherPtr& worker : workers) {
+    worker->run(Event::Dispatcher::RunType::NonBlock);
+  }
+
+  uint64_t posts_saved = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    if (batch) {
+      tls.beginUpdateBatch();
+    }
+    for (TypedSlotPtr<>& slot : slots) {
+      slot->runOnAllThreads([](OptRef<ThreadLocalObject>) {});
+    }
+    if (batch) {
+      posts_saved += tls.endUpdateBatch();
+    }
+    for (Event::DispatcherPtr& worker : workers) {
+      worker->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+  state.counters["posts_saved"] =
+      benchmark::Counter(posts_saved, benchmark::Counter::kAvgIterations);
+
+  tls.shutdownGlobalThreading();
+  tls.shutdownThread();
+}
+
+// Each slot update is posted to each worker.
+static void bmUpdateSlots(benchmark::State& state) { updateSlots(state, false); }
+
+BENCHMARK(bmUpdateSlots)
+    ->ArgsProduct({{100, 1000, 5000}, {4, 16}})
+    ->Unit(benchmark::kMicrosecond);
+
+// The slot updates are coalesced into a single post per worker.
+static void bmUpdateSlotsBatch(benchmark::State& state) { updateSlots(state, true); }
+
+BENCHMARK(bmUpdateSlotsBatch)
+    ->ArgsProduct({{100, 1000, 5000}, {4, 16}})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace ThreadLocal
+} // namespace Envoy
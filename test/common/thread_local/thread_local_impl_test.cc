@@ -290,6 +290,57 @@ TEST_F(ThreadLocalInstanceImplTest, RunOnAllThreads) {
   tls_.shutdownThread();
 }
 
+// Validate that the slot updates made during an update batch reach the worker in a single post,
+// in the order they were made in.
+TEST_F(ThreadLocalInstanceImplTest, UpdateBatch) {
+  TypedSlotPtr<StringSlotObject> slot = TypedSlot<StringSlotObject>::makeUnique(tls_);
+  std::vector<std::string> updates;
+  ThreadStatus thread_status;
+
+  tls_.beginUpdateBatch();
+  tls_.beginUpdateBatch();
+  slot->set([](Event::Dispatcher&) -> std::shared_ptr<StringSlotObject> {
+    auto s = std::make_shared<StringSlotObject>();
+    s->str_ = "hello";
+    return s;
+  });
+  slot->runOnAllThreads([&updates](OptRef<StringSlotObject> s) {
+    updates.push_back(s->str_);
+    s->str_ = "goodbye";
+  });
+  slot->runOnAllThreads(
+      [&updates](OptRef<StringSlotObject> s) { updates.push_back(s->str_); },
+      [&thread_status]() { thread_status.all_threads_complete_ = true; });
+  // The nested batch doesn't post anything, and only the main thread is updated so far.
+  EXPECT_EQ(0, tls_.endUpdateBatch());
+  EXPECT_EQ((std::vector<std::string>{"hello", "goodbye"}), updates);
+
+  // The worker and the main thread share the thread local data in this test, so the worker
+  // updates restart from a new object.
+  EXPECT_CALL(thread_dispatcher_, post(_));
+  EXPECT_CALL(main_dispatcher_, post(_));
+  EXPECT_EQ(2, tls_.endUpdateBatch());
+  EXPECT_EQ((std::vector<std::string>{"hello", "goodbye", "hello", "goodbye"}), updates);
+  EXPECT_TRUE(thread_status.all_threads_complete_);
+
+  // Slot removals are batched too.
+  TypedSlotPtr<> slot2 = TypedSlot<>::makeUnique(tls_);
+  tls_.beginUpdateBatch();
+  slot.reset();
+  slot2.reset();
+  EXPECT_EQ(freeSlotIndexesListSize(), 2);
+  EXPECT_CALL(thread_dispatcher_, post(_));
+  EXPECT_EQ(1, tls_.endUpdateBatch());
+
+  // Nothing is posted when the batch ends after shutting down global threading.
+  TypedSlot<> slot3(tls_);
+  tls_.beginUpdateBatch();
+  slot3.runOnAllThreads([](OptRef<ThreadLocalObject>) {});
+  tls_.shutdownGlobalThreading();
+  EXPECT_EQ(0, tls_.endUpdateBatch());
+  tls_.shutdownThread();
+}
+
 // Validate ThreadLocal::InstanceImpl's dispatcher() behavior.
 TEST(ThreadLocalInstanceImplDispatcherTest, Dispatcher) {
   InstanceImpl tls;
@@ -12,6 +12,7 @@
 #include "test/mocks/tracing/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -294,6 +295,39 @@ TEST_F(TracerImplTest, BasicFunctionalityNullSpan) {
   tracer_->startSpan(config_, request_headers_, stream_info_, {Reason::Sampling, true});
 }
 
+// Verifies that no span is created for an untraced request whose context the driver propagates.
+TEST_F(TracerImplTest, UntracedRequestWithoutSpan) {
+  EXPECT_CALL(*driver_, propagateUntracedContext(_)).WillOnce(Return(true));
+  EXPECT_CALL(*driver_, startSpan_(_, _, _, _, _)).Times(0);
+  EXPECT_EQ(nullptr,
+            tracer_->startSpan(config_, request_headers_, stream_info_, {Reason::Sampling, false})
+                .get());
+
+  // The driver may still need a span, and traced requests always get one.
+  NiceMock<MockSpan>* span = new NiceMock<MockSpan>();
+  EXPECT_CALL(*driver_, propagateUntracedContext(_)).WillOnce(Return(false));
+  EXPECT_CALL(*driver_, startSpan_(_, _, _, _, _)).WillOnce(Return(span));
+  EXPECT_NE(nullptr,
+            tracer_->startSpan(config_, request_headers_, stream_info_, {Reason::Sampling, false})
+                .get());
+  span = new NiceMock<MockSpan>();
+  EXPECT_CALL(*driver_, startSpan_(_, _, _, _, _)).WillOnce(Return(span));
+  EXPECT_NE(nullptr,
+            tracer_->startSpan(config_, request_headers_, stream_info_, {Reason::Sampling, true})
+                .get());
+}
+
+TEST_F(TracerImplTest, UntracedRequestWithSpanWhenDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.propagate_untraced_context", "false"}});
+  NiceMock<MockSpan>* span = new NiceMock<MockSpan>();
+  EXPECT_CALL(*driver_, propagateUntracedContext(_)).Times(0);
+  EXPECT_CALL(*driver_, startSpan_(_, _, _, _, _)).WillOnce(Return(span));
+  EXPECT_NE(nullptr,
+            tracer_->startSpan(config_, request_headers_, stream_info_, {Reason::Sampling, false})
+                .get());
+}
+
 TEST_F(TracerImplTest, BasicFunctionalityNodeSet) {
   EXPECT_CALL(stream_info_, startTime());
   EXPECT_CALL(local_info_, nodeName());
@@ -0,0 +1,149 @@
+#include "source/common/upstream/alias_table_scheduler.h"
+
+#include "test/mocks/common.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+// Returns the random number picking the entry or alias of a column of the table.
+uint64_t randomFor(uint32_t column, bool alias) {
+  return (static_cast<uint64_t>(alias ? 0xffffffff : 0) << 32) | column;
+}
+
+TEST(AliasTableSchedulerTest, Empty) {
+  NiceMock<Random::MockRandomGenerator> random;
+  AliasTableScheduler<uint32_t> sched(random);
+  EXPECT_TRUE(sched.empty());
+  EXPECT_EQ(nullptr, sched.peekAgain({}));
+  EXPECT_EQ(nullptr, sched.pickAndAdd({}));
+}
+
+// With equal weights, every column holds its own entry.
+TEST(AliasTableSchedulerTest, Unweighted) {
+  Random::MockRandomGenerator random;
+  AliasTableScheduler<uint32_t> sched(random);
+  constexpr uint32_t num_entries = 8;
+  std::shared_ptr<uint32_t> entries[num_entries];
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+  EXPECT_FALSE(sched.empty());
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    EXPECT_CALL(random, random()).WillOnce(Return(randomFor(i, true)));
+    EXPECT_EQ(i, *sched.pickAndAdd({}));
+  }
+}
+
+// Validate selection probabilities by sampling every column at evenly spaced points.
+TEST(AliasTableSchedulerTest, ProbabilityVerification) {
+  Random::MockRandomGenerator random;
+  AliasTableScheduler<uint32_t> sched(random);
+  constexpr uint32_t num_entries = 16;
+  std::shared_ptr<uint32_t> entries[num_entries];
+  uint32_t pick_count[num_entries] = {};
+
+  uint32_t weight_sum = 0;
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(i + 1, entries[i]);
+    weight_sum += i + 1;
+  }
+
+  // Sampling weight_sum points of each column picks each entry num_entries times its weight.
+  for (uint32_t column = 0; column < num_entries; ++column) {
+    for (uint32_t k = 0; k < weight_sum; ++k) {
+      const uint64_t high = ((static_cast<uint64_t>(k) << 32) + (1 << 31)) / weight_sum;
+      EXPECT_CALL(random, random()).WillOnce(Return((high << 32) | column));
+      ++pick_count[*sched.pickAndAdd({})];
+    }
+  }
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    EXPECT_NEAR((i + 1) * num_entries, pick_count[i], 1);
+  }
+}
+
+// The peeked entries are the next ones picked.
+TEST(AliasTableSchedulerTest, Peekahead) {
+  Random::MockRandomGenerator random;
+  AliasTableScheduler<uint32_t> sched(random);
+  auto first_entry = std::make_shared<uint32_t>(37);
+  auto second_entry = std::make_shared<uint32_t>(42);
+  sched.add(1, first_entry);
+  sched.add(1, second_entry);
+
+  EXPECT_CALL(random, random())
+      .WillOnce(Return(randomFor(1, false)))
+      .WillOnce(Return(randomFor(0, false)))
+      .WillOnce(Return(randomFor(0, false)));
+  EXPECT_EQ(42, *sched.peekAgain({}));
+  EXPECT_EQ(37, *sched.peekAgain({}));
+  EXPECT_EQ(42, *sched.pickAndAdd({}));
+  EXPECT_EQ(37, *sched.pickAndAdd({}));
+  EXPECT_EQ(37, *sched.pickAndAdd({}));
+}
+
+// Weights are fixed when the entries are added.
+TEST(AliasTableSchedulerTest, IgnoresWeightUpdates) {
+  Random::MockRandomGenerator random;
+  AliasTableScheduler<uint32_t> sched(random);
+  auto entry = std::make_shared<uint32_t>(37);
+  sched.add(1, entry);
+
+  EXPECT_CALL(random, random()).WillOnce(Return(randomFor(0, false)));
+  EXPECT_EQ(37, *sched.pickAndAdd([](const uint32_t&) { return 100; }));
+}
+
+// Validate that expired entries are purged and not picked.
+TEST(AliasTableSchedulerTest, Expired) {
+  Random::MockRandomGenerator random;
+  AliasTableScheduler<uint32_t> sched(random);
+
+  auto second_entry = std::make_shared<uint32_t>(42);
+  {
+    auto first_entry = std::make_shared<uint32_t>(37);
+    auto third_entry = std::make_shared<uint32_t>(22);
+    sched.add(1000, first_entry);
+    sched.add(1, second_entry);
+    sched.add(100, third_entry);
+  }
+
+  // The first pick hits an expired entry, which purges both of them.
+  EXPECT_CALL(random, random())
+      .WillOnce(Return(randomFor(0, false)))
+      .WillOnce(Return(randomFor(2, true)))
+      .WillOnce(Return(randomFor(7, false)));
+  EXPECT_EQ(42, *sched.pickAndAdd({}));
+  EXPECT_EQ(42, *sched.pickAndAdd({}));
+  EXPECT_FALSE(sched.empty());
+}
+
+// Expire all objects and verify nullptr is returned.
+TEST(AliasTableSchedulerTest, ExpireAll) {
+  NiceMock<Random::MockRandomGenerator> random;
+  AliasTableScheduler<uint32_t> sched(random);
+  {
+    auto first_entry = std::make_shared<uint32_t>(37);
+    auto second_entry = std::make_shared<uint32_t>(42);
+    sched.add(2, first_entry);
+    sched.add(1, second_entry);
+    EXPECT_TRUE(sched.peekAgain({}) != nullptr);
+  }
+
+  EXPECT_TRUE(sched.pickAndAdd({}) == nullptr);
+  EXPECT_TRUE(sched.peekAgain({}) == nullptr);
+  EXPECT_TRUE(sched.empty());
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -16,6 +16,7 @@
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/mocks/upstream/cluster_priority_set.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -46,11 +47,12 @@ protected:
   }
 
   void expectAdd(const std::string& cluster_name, const std::string& version = std::string("")) {
-    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), version)).WillOnce(Return(true));
+    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), version, _))
+        .WillOnce(Return(true));
   }
 
   void expectAddToThrow(const std::string& cluster_name, const std::string& exception_msg) {
-    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), _))
+    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), _, _))
         .WillOnce(Throw(EnvoyException(exception_msg)));
   }
 
@@ -172,6 +174,48 @@ TEST_F(CdsApiImplTest, ConfigUpdateWith2ValidClusters) {
   cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "");
 }
 
+// The thread local updates of all the clusters of a config update are coalesced.
+TEST_F(CdsApiImplTest, ConfigUpdateBatchesThreadLocalUpdates) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.batch_cds_thread_local_updates", "true"}});
+  {
+    InSequence s;
+    setup();
+  }
+
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterInfoMaps({})));
+  EXPECT_CALL(initialized_, ready());
+
+  envoy::config::cluster::v3::Cluster cluster_1;
+  cluster_1.set_name("cluster_1");
+  envoy::config::cluster::v3::Cluster cluster_2;
+  cluster_2.set_name("cluster_2");
+
+  bool batching = false;
+  {
+    InSequence s;
+    EXPECT_CALL(cm_, batchThreadLocalUpdates()).WillOnce(testing::Invoke([&batching]() {
+      batching = true;
+      return std::make_unique<Cleanup>([&batching]() { batching = false; });
+    }));
+    EXPECT_CALL(cm_, addOrUpdateCluster(WithName("cluster_1"), _, _))
+        .WillOnce(testing::InvokeWithoutArgs([&batching]() {
+          EXPECT_TRUE(batching);
+          return true;
+        }));
+    EXPECT_CALL(cm_, addOrUpdateCluster(WithName("cluster_2"), _, _))
+        .WillOnce(testing::InvokeWithoutArgs([&batching]() {
+          EXPECT_TRUE(batching);
+          return true;
+        }));
+  }
+
+  const auto decoded_resources = TestUtility::decodeResources({cluster_1, cluster_2});
+  cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "");
+  EXPECT_FALSE(batching);
+}
+
 TEST_F(CdsApiImplTest, DeltaConfigUpdate) {
   {
     InSequence s;
@@ -15,6 +15,7 @@
 #include "test/common/upstream/utility.h"
 #include "test/mocks/upstream/cluster_info.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 
 #include "absl/types/optional.h"
 #include "benchmark/benchmark.h"
@@ -151,9 +152,54 @@ BENCHMARK(benchmarkRoundRobinLoadBalancerBuild)
     ->Args({50000, 100, 50})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkRoundRobinLoadBalancerChooseHost(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const bool use_alias_table = state.range(1) != 0;
+  const uint64_t keys_to_simulate = 100000;
+
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.round_robin_alias_table",
+                               use_alias_table ? "true" : "false"}});
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    // Half of the hosts are weighted, so that picks go through the weighted scheduler.
+    RoundRobinTester tester(num_hosts, 50, 4);
+    state.ResumeTiming();
+
+    // Time the build along with the picks, as the alias table is linear to build but constant
+    // time to pick from.
+    tester.initialize();
+    for (uint64_t i = 0; i < keys_to_simulate; ++i) {
+      tester.lb_->chooseHost(nullptr);
+    }
+  }
+}
+BENCHMARK(benchmarkRoundRobinLoadBalancerChooseHost)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({10000, 0})
+    ->Args({10000, 1})
+    ->Args({25000, 0})
+    ->Args({25000, 1})
+    ->Args({50000, 0})
+    ->Args({50000, 1})
+    ->Unit(::benchmark::kMillisecond);
+
 class RingHashTester : public BaseTester {
 public:
-  RingHashTester(uint64_t num_hosts, uint64_t min_ring_size) : BaseTester(num_hosts) {
+  RingHashTester(uint64_t num_hosts, uint64_t min_ring_size, uint32_t hash_balance_factor = 0)
+      : BaseTester(num_hosts) {
+    if (hash_balance_factor > 0) {
+      common_config_.mutable_consistent_hashing_lb_config()
+          ->mutable_hash_balance_factor()
+          ->set_value(hash_balance_factor);
+    }
     config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
     config_.value().mutable_minimum_ring_size()->set_value(min_ring_size);
     ring_hash_lb_ = std::make_unique<RingHashLoadBalancer>(
@@ -171,14 +217,20 @@ public:
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               uint32_t hash_balance_factor = 0)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
+    if (hash_balance_factor > 0) {
+      common_config_.mutable_consistent_hashing_lb_config()
+          ->mutable_hash_balance_factor()
+          ->set_value(hash_balance_factor);
+    }
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(
         priority_set_, stats_, stats_scope_, runtime_, random_,
         config_.has_value()
             ? makeOptRef<const envoy::config::cluster::v3::Cluster::MaglevLbConfig>(config_.value())
             : absl::nullopt,
-        common_config_);
+        common_config_, simTime());
   }
 
   absl::optional<envoy::config::cluster::v3::Cluster::MaglevLbConfig> config_;
@@ -384,6 +436,79 @@ BENCHMARK(benchmarkMaglevLoadBalancerChooseHost)
     ->Args({500, 100000})
     ->Unit(::benchmark::kMillisecond);
 
+// Simulates requests which all stay active, half of them for the same hot key, so that the hot
+// key spills over to other hosts once its host reaches the bounded load.
+void simulateBoundedLoad(::benchmark::State& state, LoadBalancer& lb, uint64_t keys_to_simulate) {
+  absl::node_hash_map<std::string, uint64_t> hit_counter;
+  TestLoadBalancerContext context;
+  uint64_t hot_key_hits = 0;
+  HostConstSharedPtr hot_key_host;
+  for (uint64_t i = 0; i < keys_to_simulate; i++) {
+    const bool hot_key = i % 2 == 0;
+    context.hash_key_ = hashInt(hot_key ? 0 : i);
+    HostConstSharedPtr host = lb.chooseHost(&context);
+    if (hot_key && i == 0) {
+      hot_key_host = host;
+    }
+    if (hot_key && host == hot_key_host) {
+      hot_key_hits++;
+    }
+    host->stats().rq_active_.inc();
+    host->cluster().trafficStats()->upstream_rq_active_.inc();
+    hit_counter[host->address()->asString()] += 1;
+  }
+
+  // Do not time computation of mean, standard deviation, and relative standard deviation.
+  state.PauseTiming();
+  computeHitStats(state, hit_counter);
+  state.counters["hot_key_sticky_percent"] = 200.0 * hot_key_hits / keys_to_simulate;
+  state.ResumeTiming();
+}
+
+void benchmarkRingHashLoadBalancerChooseHostBoundedLoad(::benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Do not time the creation of the ring.
+    state.PauseTiming();
+    const uint64_t num_hosts = state.range(0);
+    const uint64_t hash_balance_factor = state.range(1);
+    const uint64_t keys_to_simulate = state.range(2);
+    RingHashTester tester(num_hosts, 65536, hash_balance_factor);
+    tester.ring_hash_lb_->initialize();
+    LoadBalancerPtr lb = tester.ring_hash_lb_->factory()->create();
+    state.ResumeTiming();
+
+    simulateBoundedLoad(state, *lb, keys_to_simulate);
+  }
+}
+BENCHMARK(benchmarkRingHashLoadBalancerChooseHostBoundedLoad)
+    ->Args({100, 125, 100000})
+    ->Args({500, 125, 100000})
+    ->Args({2500, 125, 100000})
+    ->Args({2500, 200, 100000})
+    ->Unit(::benchmark::kMillisecond);
+
+void benchmarkMaglevLoadBalancerChooseHostBoundedLoad(::benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Do not time the creation of the table.
+    state.PauseTiming();
+    const uint64_t num_hosts = state.range(0);
+    const uint64_t hash_balance_factor = state.range(1);
+    const uint64_t keys_to_simulate = state.range(2);
+    MaglevTester tester(num_hosts, 0, 0, hash_balance_factor);
+    tester.maglev_lb_->initialize();
+    LoadBalancerPtr lb = tester.maglev_lb_->factory()->create();
+    state.ResumeTiming();
+
+    simulateBoundedLoad(state, *lb, keys_to_simulate);
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerChooseHostBoundedLoad)
+    ->Args({100, 125, 100000})
+    ->Args({500, 125, 100000})
+    ->Args({2500, 125, 100000})
+    ->Args({2500, 200, 100000})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkRingHashLoadBalancerHostLoss(::benchmark::State& state) {
   const uint64_t num_hosts = state.range(0);
   const uint64_t min_ring_size = state.range(1);
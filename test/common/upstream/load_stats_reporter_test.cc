@@ -35,7 +35,7 @@ public:
       : retry_timer_(new Event::MockTimer()), response_timer_(new Event::MockTimer()),
         async_client_(new Grpc::MockAsyncClient()) {}
 
-  void createLoadStatsReporter() {
+  void createLoadStatsReporter(bool report_only_changed_localities = false) {
     InSequence s;
     EXPECT_CALL(dispatcher_, createTimer_(_)).WillOnce(Invoke([this](Event::TimerCb timer_cb) {
       retry_timer_cb_ = timer_cb;
@@ -47,7 +47,8 @@ public:
     }));
     load_stats_reporter_ =
         std::make_unique<LoadStatsReporter>(local_info_, cm_, *stats_store_.rootScope(),
-                                            Grpc::RawAsyncClientPtr(async_client_), dispatcher_);
+                                            Grpc::RawAsyncClientPtr(async_client_), dispatcher_,
+                                            report_only_changed_localities);
   }
 
   void expectSendMessage(
@@ -224,24 +225,27 @@ TEST_F(LoadStatsReporterTest, ExistingClusters) {
 }
 
 HostSharedPtr makeTestHost(const std::string& hostname,
-                           const ::envoy::config::core::v3::Locality& locality) {
+                           const ::envoy::config::core::v3::Locality& locality,
+                           LocalityLoadStats& locality_load_stats) {
   const auto host = std::make_shared<NiceMock<::Envoy::Upstream::MockHost>>();
   ON_CALL(*host, hostname()).WillByDefault(::testing::ReturnRef(hostname));
   ON_CALL(*host, locality()).WillByDefault(::testing::ReturnRef(locality));
+  ON_CALL(*host, localityLoadStats()).WillByDefault(::testing::ReturnRef(locality_load_stats));
   return host;
 }
 
 void addStats(const HostSharedPtr& host, double a, double b = 0, double c = 0, double d = 0) {
-  host->stats().rq_success_.inc();
-  host->loadMetricStats().add("metric_a", a);
+  host->localityLoadStats().incRqSuccess();
+  LoadMetricStats& load_metric_stats = host->localityLoadStats().loadMetricStats();
+  load_metric_stats.add("metric_a", a);
   if (b != 0) {
-    host->loadMetricStats().add("metric_b", b);
+    load_metric_stats.add("metric_b", b);
   }
   if (c != 0) {
-    host->loadMetricStats().add("metric_c", c);
+    load_metric_stats.add("metric_c", c);
   }
   if (d != 0) {
-    host->loadMetricStats().add("metric_d", d);
+    load_metric_stats.add("metric_d", d);
   }
 }
 
@@ -268,8 +272,10 @@ TEST_F(LoadStatsReporterTest, UpstreamLocalityStats) {
   ::envoy::config::core::v3::Locality locality0, locality1;
   locality0.set_region("mars");
   locality1.set_region("jupiter");
-  HostSharedPtr host0 = makeTestHost("host0", locality0), host1 = makeTestHost("host1", locality0),
-                host2 = makeTestHost("host2", locality1);
+  LocalityLoadStatsImpl locality0_stats, locality1_stats;
+  HostSharedPtr host0 = makeTestHost("host0", locality0, locality0_stats),
+                host1 = makeTestHost("host1", locality0, locality0_stats),
+                host2 = makeTestHost("host2", locality1, locality1_stats);
   host_set_.hosts_per_locality_ = makeHostsPerLocality({{host0, host1}, {host2}});
 
   addStats(host0, 0.11111, 1.0);
@@ -310,9 +316,9 @@ TEST_F(LoadStatsReporterTest, UpstreamLocalityStats) {
   response_timer_cb_();
 
   // Traffic between previous request and next response. Previous latched metrics are cleared.
-  host1->stats().rq_success_.inc();
-  host1->loadMetricStats().add("metric_a", 1.41421);
-  host1->loadMetricStats().add("metric_e", 2.71828);
+  host1->localityLoadStats().incRqSuccess();
+  host1->localityLoadStats().loadMetricStats().add("metric_a", 1.41421);
+  host1->localityLoadStats().loadMetricStats().add("metric_e", 2.71828);
 
   time_system_.setMonotonicTime(std::chrono::microseconds(6));
   deliverLoadStatsResponse({"foo"});
@@ -338,6 +344,86 @@ TEST_F(LoadStatsReporterTest, UpstreamLocalityStats) {
   response_timer_cb_();
 }
 
+// Validate that the localities whose only load is an unchanged number of requests in progress are
+// left out of the load reports when only the changed localities are reported.
+TEST_F(LoadStatsReporterTest, ReportOnlyChangedLocalities) {
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage({});
+  createLoadStatsReporter(true);
+  time_system_.setMonotonicTime(std::chrono::microseconds(3));
+
+  NiceMock<MockClusterMockPrioritySet> cluster;
+  MockHostSet& host_set = *cluster.prioritySet().getMockHostSet(0);
+  ::envoy::config::core::v3::Locality locality0, locality1;
+  locality0.set_region("mars");
+  locality1.set_region("jupiter");
+  LocalityLoadStatsImpl locality0_stats, locality1_stats;
+  HostSharedPtr host0 = makeTestHost("host0", locality0, locality0_stats),
+                host1 = makeTestHost("host1", locality1, locality1_stats);
+  host_set.hosts_per_locality_ = makeHostsPerLocality({{host0}, {host1}});
+
+  MockClusterManager::ClusterInfoMaps cluster_info{{{"foo", cluster}}, {}, {}};
+  ON_CALL(cm_, clusters()).WillByDefault(Return(cluster_info));
+  deliverLoadStatsResponse({"foo"});
+
+  // A long lived request to each locality.
+  host0->localityLoadStats().incRqTotal();
+  host0->localityLoadStats().incRqActive();
+  host1->localityLoadStats().incRqTotal();
+  host1->localityLoadStats().incRqActive();
+  time_system_.setMonotonicTime(std::chrono::microseconds(4));
+  {
+    envoy::config::endpoint::v3::ClusterStats expected_cluster_stats;
+    expected_cluster_stats.set_cluster_name("foo");
+    expected_cluster_stats.mutable_load_report_interval()->MergeFrom(
+        Protobuf::util::TimeUtil::MicrosecondsToDuration(1));
+    for (const std::string& region : {"mars", "jupiter"}) {
+      auto* expected_locality_stats = expected_cluster_stats.add_upstream_locality_stats();
+      expected_locality_stats->mutable_locality()->set_region(region);
+      expected_locality_stats->set_total_requests_in_progress(1);
+      expected_locality_stats->set_total_issued_requests(1);
+    }
+    expectSendMessage({expected_cluster_stats});
+  }
+  EXPECT_CALL(*response_timer_, enableTimer(std::chrono::milliseconds(42000), _));
+  response_timer_cb_();
+
+  // Only the request to the second locality completes.
+  host1->localityLoadStats().incRqSuccess();
+  host1->localityLoadStats().decRqActive();
+  time_system_.setMonotonicTime(std::chrono::microseconds(5));
+  {
+    envoy::config::endpoint::v3::ClusterStats expected_cluster_stats;
+    expected_cluster_stats.set_cluster_name("foo");
+    expected_cluster_stats.mutable_load_report_interval()->MergeFrom(
+        Protobuf::util::TimeUtil::MicrosecondsToDuration(1));
+    auto* expected_locality_stats = expected_cluster_stats.add_upstream_locality_stats();
+    expected_locality_stats->mutable_locality()->set_region("jupiter");
+    expected_locality_stats->set_total_successful_requests(1);
+    expectSendMessage({expected_cluster_stats});
+  }
+  EXPECT_CALL(*response_timer_, enableTimer(std::chrono::milliseconds(42000), _));
+  response_timer_cb_();
+
+  // Another request to the first locality changes its load.
+  host0->localityLoadStats().incRqTotal();
+  host0->localityLoadStats().incRqActive();
+  time_system_.setMonotonicTime(std::chrono::microseconds(6));
+  {
+    envoy::config::endpoint::v3::ClusterStats expected_cluster_stats;
+    expected_cluster_stats.set_cluster_name("foo");
+    expected_cluster_stats.mutable_load_report_interval()->MergeFrom(
+        Protobuf::util::TimeUtil::MicrosecondsToDuration(1));
+    auto* expected_locality_stats = expected_cluster_stats.add_upstream_locality_stats();
+    expected_locality_stats->mutable_locality()->set_region("mars");
+    expected_locality_stats->set_total_requests_in_progress(2);
+    expected_locality_stats->set_total_issued_requests(1);
+    expectSendMessage({expected_cluster_stats});
+  }
+  EXPECT_CALL(*response_timer_, enableTimer(std::chrono::milliseconds(42000), _));
+  response_timer_cb_();
+}
+
 // Validate that the client can recover from a remote stream closure via retry.
 TEST_F(LoadStatsReporterTest, RemoteStreamClose) {
   EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
@@ -60,7 +60,7 @@ public:
         config_.has_value()
             ? makeOptRef<const envoy::config::cluster::v3::Cluster::MaglevLbConfig>(config_.value())
             : absl::nullopt,
-        common_config_);
+        common_config_, simTime());
   }
 
   void init(uint64_t table_size, bool locality_weighted_balancing = false) {
@@ -143,6 +143,7 @@ TEST_P(MaglevLoadBalancerTest, Basic) {
 
   EXPECT_EQ("maglev_lb.min_entries_per_host", lb_->stats().min_entries_per_host_.name());
   EXPECT_EQ("maglev_lb.max_entries_per_host", lb_->stats().max_entries_per_host_.name());
+  EXPECT_EQ("maglev_lb.table_build_time_us", lb_->stats().table_build_time_us_.name());
   EXPECT_EQ(1, lb_->stats().min_entries_per_host_.value());
   EXPECT_EQ(2, lb_->stats().max_entries_per_host_.value());
 
@@ -0,0 +1,107 @@
+// Usage: bazel run //test/common/upstream:outlier_detection_benchmark
+
+#include <memory>
+#include <string>
+
+#include "envoy/config/cluster/v3/outlier_detection.pb.h"
+
+#include "source/common/common/fmt.h"
+#include "source/common/upstream/outlier_detection_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/common/upstream/utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/cluster_priority_set.h"
+#include "test/mocks/upstream/host_set.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Upstream {
+namespace Outlier {
+namespace {
+
+// The requests reported per host and interval, which are enough for the success rate of the hosts
+// to be evaluated.
+constexpr uint32_t RequestsPerInterval = 20;
+
+class OutlierDetectorTester : public Event::TestUsingSimulatedTime {
+public:
+  OutlierDetectorTester(uint64_t num_hosts) {
+    HostVector& hosts = cluster_.prioritySet().getMockHostSet(0)->hosts_;
+    for (uint64_t i = 0; i < num_hosts; i++) {
+      const std::string url =
+          fmt::format("tcp://10.{}.{}.{}:80", i / 65536, (i / 256) % 256, i % 256);
+      hosts.push_back(makeTestHost(cluster_.info_, url, simTime()));
+    }
+
+    envoy::config::cluster::v3::OutlierDetection config;
+    config.mutable_success_rate_request_volume()->set_value(RequestsPerInterval);
+    config.mutable_failure_percentage_request_volume()->set_value(RequestsPerInterval);
+    detector_ = DetectorImpl::create(cluster_, config, dispatcher_, runtime_, simTime(), nullptr,
+                                     random_);
+  }
+
+  // Reports the requests of an interval, 1% of the hosts failing half of them.
+  void reportRequests() {
+    const HostVector& hosts = cluster_.prioritySet().getMockHostSet(0)->hosts_;
+    for (size_t i = 0; i < hosts.size(); i++) {
+      for (uint32_t request = 0; request < RequestsPerInterval; request++) {
+        const bool failure = i % 100 == 0 && request % 2 == 0;
+        hosts[i]->outlierDetector().putHttpResponseCode(failure ? 503 : 200);
+      }
+    }
+  }
+
+  // Runs the evaluation of an interval, as the main thread does when the interval timer fires.
+  void evaluateInterval() { interval_timer_->invokeCallback(); }
+
+  HostSharedPtr host() { return cluster_.prioritySet().getMockHostSet(0)->hosts_[0]; }
+
+private:
+  NiceMock<MockClusterMockPrioritySet> cluster_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<Event::MockTimer>* interval_timer_ = new NiceMock<Event::MockTimer>(&dispatcher_);
+  std::shared_ptr<DetectorImpl> detector_;
+};
+
+// The main thread time taken by the success rate and failure percentage evaluation of an interval.
+void bmEvaluateInterval(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  OutlierDetectorTester tester(num_hosts);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    tester.reportRequests();
+    state.ResumeTiming();
+    tester.evaluateInterval();
+  }
+}
+BENCHMARK(bmEvaluateInterval)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(::benchmark::kMillisecond);
+
+// The bookkeeping of each request, done by the workers.
+void bmPutHttpResponseCode(::benchmark::State& state) {
+  OutlierDetectorTester tester(1);
+  HostSharedPtr host = tester.host();
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    host->outlierDetector().putHttpResponseCode(200);
+  }
+}
+BENCHMARK(bmPutHttpResponseCode);
+
+} // namespace
+} // namespace Outlier
+} // namespace Upstream
+} // namespace Envoy
@@ -2340,19 +2340,31 @@ TEST(OutlierDetectionEventLoggerImplTest, All) {
 }
 
 TEST(OutlierUtility, SRThreshold) {
-  std::vector<HostSuccessRatePair> data = {
-      HostSuccessRatePair(nullptr, 50),  HostSuccessRatePair(nullptr, 100),
-      HostSuccessRatePair(nullptr, 100), HostSuccessRatePair(nullptr, 100),
-      HostSuccessRatePair(nullptr, 100),
-  };
+  // The success rates are {50, 100, 100, 100, 100}.
   double sum = 450;
+  double square_sum = 42500;
 
   DetectorImpl::EjectionPair success_rate_nums =
-      DetectorImpl::successRateEjectionThreshold(sum, data, 1.9);
+      DetectorImpl::successRateEjectionThreshold(sum, square_sum, 5, 1.9);
   EXPECT_EQ(90.0, success_rate_nums.success_rate_average_); // average success rate
   EXPECT_EQ(52.0, success_rate_nums.ejection_threshold_);   //  ejection threshold
 }
 
+// The rounding of the squares of equal success rates must not make their variance negative.
+TEST(OutlierUtility, SRThresholdEqualSuccessRates) {
+  double sum = 0;
+  double square_sum = 0;
+  for (size_t i = 0; i < 1000; i++) {
+    sum += 99.7;
+    square_sum += 99.7 * 99.7;
+  }
+
+  DetectorImpl::EjectionPair success_rate_nums =
+      DetectorImpl::successRateEjectionThreshold(sum, square_sum, 1000, 1.9);
+  EXPECT_NEAR(99.7, success_rate_nums.success_rate_average_, 1e-6);
+  EXPECT_NEAR(99.7, success_rate_nums.ejection_threshold_, 1e-3);
+}
+
 } // namespace
 } // namespace Outlier
 } // namespace Upstream
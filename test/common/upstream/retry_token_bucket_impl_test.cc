@@ -0,0 +1,103 @@
+#include <chrono>
+
+#include "source/common/upstream/retry_token_bucket_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+using RetryTokenBucketConfig =
+    envoy::config::cluster::v3::CircuitBreakers::Thresholds::RetryTokenBucket;
+
+TEST(RetryTokenBucketImplTest, Defaults) {
+  RetryTokenBucketImpl bucket(RetryTokenBucketConfig{});
+  // The bucket starts full.
+  EXPECT_EQ(100000, bucket.balance());
+  EXPECT_EQ(1.0, bucket.backoffMultiplier());
+}
+
+// Each request deposits a share of a token, and the balance never exceeds the largest number of
+// tokens.
+TEST(RetryTokenBucketImplTest, DepositAndWithdraw) {
+  RetryTokenBucketConfig config;
+  config.mutable_retry_percent()->set_value(25);
+  config.mutable_min_retries_per_second()->set_value(0);
+  config.mutable_max_tokens()->set_value(2);
+  RetryTokenBucketImpl bucket(config);
+  const MonotonicTime now;
+
+  bucket.onRequest();
+  EXPECT_EQ(2000, bucket.balance());
+  EXPECT_TRUE(bucket.tryWithdraw(now));
+  EXPECT_TRUE(bucket.tryWithdraw(now));
+  EXPECT_FALSE(bucket.tryWithdraw(now));
+
+  for (int i = 0; i < 3; i++) {
+    bucket.onRequest();
+  }
+  EXPECT_EQ(750, bucket.balance());
+  EXPECT_FALSE(bucket.tryWithdraw(now));
+  bucket.onRequest();
+  EXPECT_TRUE(bucket.tryWithdraw(now));
+  EXPECT_EQ(0, bucket.balance());
+}
+
+// Tokens accrue at the minimum retry rate between withdrawals.
+TEST(RetryTokenBucketImplTest, MinRetriesPerSecond) {
+  RetryTokenBucketConfig config;
+  config.mutable_retry_percent()->set_value(0);
+  config.mutable_min_retries_per_second()->set_value(2);
+  config.mutable_max_tokens()->set_value(2);
+  RetryTokenBucketImpl bucket(config);
+  MonotonicTime now = MonotonicTime() + std::chrono::seconds(1);
+
+  EXPECT_TRUE(bucket.tryWithdraw(now));
+  EXPECT_TRUE(bucket.tryWithdraw(now));
+  EXPECT_FALSE(bucket.tryWithdraw(now));
+
+  // Deposits are made at most once a millisecond.
+  now += std::chrono::microseconds(999);
+  EXPECT_FALSE(bucket.tryWithdraw(now));
+  EXPECT_EQ(0, bucket.balance());
+
+  now += std::chrono::microseconds(249001);
+  EXPECT_FALSE(bucket.tryWithdraw(now));
+  EXPECT_EQ(500, bucket.balance());
+  now += std::chrono::milliseconds(250);
+  EXPECT_TRUE(bucket.tryWithdraw(now));
+
+  // The accrued tokens don't exceed the largest number of tokens.
+  now += std::chrono::hours(1);
+  EXPECT_TRUE(bucket.tryWithdraw(now));
+  EXPECT_EQ(1000, bucket.balance());
+}
+
+// The backoff multiplier follows the share of the recent attempts which failed.
+TEST(RetryTokenBucketImplTest, BackoffMultiplier) {
+  RetryTokenBucketConfig config;
+  config.mutable_max_backoff_multiplier()->set_value(5);
+  RetryTokenBucketImpl bucket(config);
+
+  bucket.onAttemptComplete(true);
+  EXPECT_DOUBLE_EQ(5.0, bucket.backoffMultiplier());
+  bucket.onAttemptComplete(false);
+  bucket.onAttemptComplete(false);
+  bucket.onAttemptComplete(false);
+  EXPECT_DOUBLE_EQ(2.0, bucket.backoffMultiplier());
+
+  // Older attempts weigh less once the counts decay, so the multiplier follows a recovery.
+  for (int i = 0; i < 996; i++) {
+    bucket.onAttemptComplete(true);
+  }
+  EXPECT_GT(bucket.backoffMultiplier(), 4.9);
+  for (int i = 0; i < 5000; i++) {
+    bucket.onAttemptComplete(false);
+  }
+  EXPECT_LT(bucket.backoffMultiplier(), 1.1);
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -4,6 +4,7 @@
 #include <random>
 
 #include "source/common/common/random_generator.h"
+#include "source/common/upstream/alias_table_scheduler.h"
 #include "source/common/upstream/edf_scheduler.h"
 #include "source/common/upstream/wrsq_scheduler.h"
 
@@ -159,6 +160,46 @@ void uniqueWeightPickWRSQ(::benchmark::State& state) {
                             });
 }
 
+void splitWeightAddAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupSplitWeights(alias, num_objs, state);
+  }
+}
+
+void uniqueWeightAddAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupUniqueWeights(alias, num_objs, state);
+  }
+}
+
+void splitWeightPickAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(alias, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupSplitWeights(sched, num_objs, state);
+                            });
+}
+
+void uniqueWeightPickAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasTableScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(alias, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupUniqueWeights(sched, num_objs, state);
+                            });
+}
+
 BENCHMARK(splitWeightAddEdf)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
@@ -180,6 +221,20 @@ BENCHMARK(uniqueWeightAddWRSQ)
 BENCHMARK(uniqueWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickWRSQ)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 
+// The alias table is meant for large clusters: also cover 100k objects or so.
+BENCHMARK(splitWeightAddAlias)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 17);
+BENCHMARK(uniqueWeightAddAlias)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 17);
+BENCHMARK(splitWeightPickAlias)->RangeMultiplier(8)->Range(1 << 6, 1 << 17);
+BENCHMARK(uniqueWeightPickAlias)->RangeMultiplier(8)->Range(1 << 6, 1 << 17);
+BENCHMARK(splitWeightPickEdf)->Arg(1 << 17);
+BENCHMARK(uniqueWeightPickEdf)->Arg(1 << 17);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -0,0 +1,42 @@
+#include "source/common/upstream/stream_demand_estimator.h"
+
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class StreamDemandEstimatorTest : public Event::TestUsingSimulatedTime, public testing::Test {
+public:
+  StreamDemandEstimator estimator_{simTime(), std::chrono::seconds(10)};
+};
+
+TEST_F(StreamDemandEstimatorTest, FollowsIncreasingDemand) {
+  EXPECT_EQ(1, estimator_.update(1));
+  EXPECT_EQ(5, estimator_.update(5));
+  EXPECT_EQ(20, estimator_.update(20));
+}
+
+// The peak is kept across a lull, and decays with time.
+TEST_F(StreamDemandEstimatorTest, PeakDecays) {
+  EXPECT_EQ(16, estimator_.update(16));
+  EXPECT_EQ(16, estimator_.update(1));
+
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(8, estimator_.update(1));
+  simTime().advanceTimeWait(std::chrono::seconds(20));
+  EXPECT_EQ(2, estimator_.update(1));
+  simTime().advanceTimeWait(std::chrono::seconds(60));
+  EXPECT_EQ(1, estimator_.update(1));
+
+  // A new burst resets the peak.
+  EXPECT_EQ(12, estimator_.update(12));
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(7, estimator_.update(7));
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -1394,6 +1394,45 @@ TEST_F(HostImplTest, HostnameCanaryAndLocality) {
   EXPECT_EQ(1, host.priority());
 }
 
+// The hosts of a locality and priority share their load report stats, which move along with the
+// requests in progress when the priority of a host changes.
+TEST_F(HostImplTest, LocalityLoadStats) {
+  MockClusterMockPrioritySet cluster;
+  envoy::config::core::v3::Locality locality;
+  locality.set_region("oceania");
+  auto make_host = [&](uint32_t priority) {
+    return std::make_shared<HostImpl>(
+        cluster.info_, "", Network::Utility::resolveUrl("tcp://10.0.0.1:1234"), nullptr, 1,
+        locality, envoy::config::endpoint::v3::Endpoint::HealthCheckConfig::default_instance(),
+        priority, envoy::config::core::v3::UNKNOWN, simTime());
+  };
+  HostSharedPtr host0 = make_host(0);
+  HostSharedPtr host1 = make_host(0);
+  HostSharedPtr host2 = make_host(1);
+  EXPECT_EQ(&host0->localityLoadStats(), &host1->localityLoadStats());
+  EXPECT_NE(&host0->localityLoadStats(), &host2->localityLoadStats());
+  EXPECT_EQ(&host0->localityLoadStats().loadMetricStats(), &host1->loadMetricStats());
+
+  host0->stats().rq_active_.inc();
+  host0->localityLoadStats().incRqActive();
+  host0->localityLoadStats().incRqSuccess();
+  host1->localityLoadStats().incRqError();
+  LocalityLoadStats::LatchedStats latched = host0->localityLoadStats().latch();
+  EXPECT_EQ(1, latched.rq_success_);
+  EXPECT_EQ(1, latched.rq_error_);
+  EXPECT_EQ(1, latched.rq_active_);
+  latched = host0->localityLoadStats().latch();
+  EXPECT_EQ(0, latched.rq_success_);
+  EXPECT_EQ(0, latched.rq_error_);
+  EXPECT_EQ(1, latched.rq_active_);
+
+  LocalityLoadStats& previous_stats = host0->localityLoadStats();
+  host0->priority(1);
+  EXPECT_EQ(&host2->localityLoadStats(), &host0->localityLoadStats());
+  EXPECT_EQ(0, previous_stats.latch().rq_active_);
+  EXPECT_EQ(1, host2->localityLoadStats().latch().rq_active_);
+}
+
 TEST_F(HostImplTest, CreateConnection) {
   MockClusterMockPrioritySet cluster;
   envoy::config::core::v3::Metadata metadata;
@@ -3652,6 +3691,32 @@ TEST_F(ClusterInfoImplTest, Metadata) {
   EXPECT_EQ(LoadBalancerType::Maglev, cluster->info()->lbType());
 }
 
+// The traffic stats are only instantiated by their first access when deferred.
+TEST_F(ClusterInfoImplTest, DeferredTrafficStats) {
+  const std::string yaml = R"EOF(
+    name: {}
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+  )EOF";
+
+  {
+    auto cluster = makeCluster(fmt::format(yaml, "name"));
+    EXPECT_TRUE(cluster->info()->trafficStats().isPresent());
+    EXPECT_TRUE(stats_.findCounterByString("cluster.name.upstream_rq_total").has_value());
+  }
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.defer_cluster_traffic_stats", "true"}});
+  auto cluster = makeCluster(fmt::format(yaml, "deferred"));
+  EXPECT_FALSE(cluster->info()->trafficStats().isPresent());
+  EXPECT_FALSE(stats_.findCounterByString("cluster.deferred.upstream_rq_total").has_value());
+
+  cluster->info()->trafficStats()->upstream_rq_total_.inc();
+  EXPECT_TRUE(cluster->info()->trafficStats().isPresent());
+  EXPECT_EQ(1, stats_.counterFromString("cluster.deferred.upstream_rq_total").value());
+}
+
 // Verify retry budget default values are honored.
 TEST_F(ClusterInfoImplTest, RetryBudgetDefaultPopulation) {
   std::string yaml = R"EOF(
@@ -0,0 +1,186 @@
+#include <string>
+#include <vector>
+
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/aggregating/v3/aggregating.pb.h"
+
+#include "source/common/access_log/access_log_impl.h"
+#include "source/common/json/json_loader.h"
+
+#include "test/mocks/access_log/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_split.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Aggregating {
+namespace {
+
+class AggregatingAccessLogTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::access_loggers::aggregating::v3::AggregatingAccessLog proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+    envoy::config::accesslog::v3::AccessLog config;
+    config.set_name("envoy.access_loggers.aggregating");
+    config.mutable_typed_config()->PackFrom(proto_config);
+
+    expectFile("/tmp/summaries.log", summary_file_, summaries_);
+    expectFile("/tmp/errors.log", error_file_, errors_);
+    window_timer_ = new NiceMock<Event::MockTimer>(&context_.thread_local_.dispatcher_);
+    logger_ = AccessLog::AccessLogFactory::fromProto(config, context_);
+  }
+
+  void expectFile(const std::string& path, std::shared_ptr<AccessLog::MockAccessLogFile>& file,
+                  std::string& written) {
+    file = std::make_shared<NiceMock<AccessLog::MockAccessLogFile>>();
+    EXPECT_CALL(context_.access_log_manager_,
+                createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File,
+                                                            path}))
+        .WillOnce(Return(file));
+    ON_CALL(*file, write(_)).WillByDefault(Invoke([&written](absl::string_view data) {
+      written.append(data);
+    }));
+  }
+
+  void log(const std::string& route_name, uint32_t response_code,
+           std::chrono::milliseconds duration) {
+    stream_info_.route_name_ = route_name;
+    stream_info_.response_code_ = response_code;
+    stream_info_.end_time_ = duration;
+    logger_->log(&request_headers_, &response_headers_, &response_trailers_, stream_info_);
+  }
+
+  // Returns the summary lines written so far, by key.
+  absl::flat_hash_map<std::string, Json::ObjectSharedPtr> summaries() {
+    absl::flat_hash_map<std::string, Json::ObjectSharedPtr> summaries;
+    for (absl::string_view line : absl::StrSplit(summaries_, '\n', absl::SkipEmpty())) {
+      Json::ObjectSharedPtr summary = Json::Factory::loadFromString(std::string(line));
+      EXPECT_TRUE(summaries.emplace(summary->getString("key"), summary).second);
+    }
+    return summaries;
+  }
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+  std::shared_ptr<AccessLog::MockAccessLogFile> summary_file_;
+  std::shared_ptr<AccessLog::MockAccessLogFile> error_file_;
+  std::string summaries_;
+  std::string errors_;
+  Event::MockTimer* window_timer_;
+  AccessLog::InstanceSharedPtr logger_;
+  Http::TestRequestHeaderMapImpl request_headers_{{":method", "GET"}, {":path", "/"}};
+  Http::TestResponseHeaderMapImpl response_headers_;
+  Http::TestResponseTrailerMapImpl response_trailers_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+};
+
+const std::string DefaultConfig = R"EOF(
+aggregate_filter:
+  status_code_filter:
+    comparison:
+      op: LE
+      value:
+        default_value: 399
+        runtime_key: aggregating.max_status
+access_log:
+- name: envoy.access_loggers.file
+  typed_config:
+    "@type": type.googleapis.com/envoy.extensions.access_loggers.file.v3.FileAccessLog
+    path: /tmp/errors.log
+    log_format:
+      text_format_source:
+        inline_string: "%ROUTE_NAME% %RESPONSE_CODE%\n"
+key_format: "%ROUTE_NAME% %RESPONSE_CODE%"
+path: /tmp/summaries.log
+window: 5s
+)EOF";
+
+// Verifies that the records matching the filter are summarized by key at the end of the window,
+// and that the others are logged individually.
+TEST_F(AggregatingAccessLogTest, SummarizesMatchingRecordsAtEndOfWindow) {
+  initialize(DefaultConfig);
+
+  for (int i = 0; i < 10; i++) {
+    log("a", 200, std::chrono::milliseconds(1));
+  }
+  log("a", 404, std::chrono::milliseconds(2));
+  log("b", 200, std::chrono::milliseconds(5));
+  log("b", 503, std::chrono::milliseconds(5));
+  EXPECT_EQ("a 404\nb 503\n", errors_);
+  EXPECT_EQ("", summaries_);
+
+  EXPECT_CALL(*window_timer_, enableTimer(std::chrono::milliseconds(5000), _));
+  window_timer_->invokeCallback();
+  auto lines = summaries();
+  ASSERT_EQ(2, lines.size());
+  EXPECT_EQ(10, lines["a 200"]->getInteger("count"));
+  EXPECT_EQ(5000, lines["a 200"]->getInteger("window_ms"));
+  Json::ObjectSharedPtr durations = lines["a 200"]->getObject("duration_us");
+  // The durations are binned with two significant digits.
+  for (const char* percentile : {"p50", "p90", "p99"}) {
+    EXPECT_GE(durations->getInteger(percentile), 1000);
+    EXPECT_LE(durations->getInteger(percentile), 1100);
+  }
+  EXPECT_EQ(1, lines["b 200"]->getInteger("count"));
+
+  // The next window starts empty.
+  summaries_.clear();
+  window_timer_->invokeCallback();
+  EXPECT_EQ("", summaries_);
+}
+
+// Verifies that the records of the keys beyond max_keys are logged individually, and that the
+// pending summaries are written when the log is destroyed.
+TEST_F(AggregatingAccessLogTest, MaxKeysAndDestruction) {
+  initialize(DefaultConfig + R"EOF(
+max_keys: 1
+percentiles: [99.9]
+)EOF");
+
+  log("a", 200, std::chrono::milliseconds(10));
+  log("b", 200, std::chrono::milliseconds(10));
+  log("a", 200, std::chrono::milliseconds(10));
+  EXPECT_EQ("b 200\n", errors_);
+
+  logger_.reset();
+  auto lines = summaries();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_EQ(2, lines["a 200"]->getInteger("count"));
+  EXPECT_TRUE(lines["a 200"]->getObject("duration_us")->hasObject("p99.9"));
+}
+
+// Verifies that the records of requests that aren't complete are counted without a duration, and
+// that keys are escaped.
+TEST_F(AggregatingAccessLogTest, IncompleteRequestsAndEscapedKeys) {
+  initialize(DefaultConfig);
+
+  stream_info_.route_name_ = "\"quoted\"";
+  stream_info_.response_code_ = 200;
+  stream_info_.end_time_.reset();
+  logger_->log(&request_headers_, &response_headers_, &response_trailers_, stream_info_);
+
+  window_timer_->invokeCallback();
+  auto lines = summaries();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_EQ(1, lines["\"quoted\" 200"]->getInteger("count"));
+  EXPECT_FALSE(lines["\"quoted\" 200"]->hasObject("duration_us"));
+}
+
+} // namespace
+} // namespace Aggregating
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -60,6 +60,17 @@ public:
         }));
   }
 
+  // Expects the bytes of the message to be those of the serialization of the expected message.
+  void expectSerializedStreamMessage(const std::string& expected_message_yaml) {
+    envoy::service::accesslog::v3::StreamAccessLogsMessage expected_message;
+    TestUtility::loadFromYaml(expected_message_yaml, expected_message);
+    EXPECT_CALL(stream_, isAboveWriteBufferHighWatermark()).WillOnce(Return(false));
+    EXPECT_CALL(stream_, sendMessageRaw_(_, false))
+        .WillOnce(Invoke([expected_message](Buffer::InstancePtr& request, bool) {
+          EXPECT_EQ(expected_message.SerializeAsString(), request->toString());
+        }));
+  }
+
 private:
   MockAccessLogStream stream_;
   AccessLogCallbacks* callbacks_;
@@ -67,12 +78,15 @@ private:
 
 class GrpcAccessLoggerImplTest : public testing::Test {
 public:
-  GrpcAccessLoggerImplTest()
+  GrpcAccessLoggerImplTest() : GrpcAccessLoggerImplTest(BUFFER_SIZE_BYTES) {}
+
+protected:
+  explicit GrpcAccessLoggerImplTest(uint32_t buffer_size_bytes)
       : async_client_(new Grpc::MockAsyncClient), timer_(new Event::MockTimer(&dispatcher_)),
         grpc_access_logger_impl_test_helper_(local_info_, async_client_) {
     EXPECT_CALL(*timer_, enableTimer(_, _));
     *config_.mutable_log_name() = "test_log_name";
-    config_.mutable_buffer_size_bytes()->set_value(BUFFER_SIZE_BYTES);
+    config_.mutable_buffer_size_bytes()->set_value(buffer_size_bytes);
     config_.mutable_buffer_flush_interval()->set_nanos(
         std::chrono::duration_cast<std::chrono::nanoseconds>(FlushInterval).count());
     logger_ =
@@ -128,6 +142,42 @@ tcp_logs:
   logger_->log(envoy::data::accesslog::v3::TCPAccessLogEntry(tcp_entry));
 }
 
+class GrpcAccessLoggerImplBatchingTest : public GrpcAccessLoggerImplTest {
+public:
+  GrpcAccessLoggerImplBatchingTest() : GrpcAccessLoggerImplTest(1000) {}
+};
+
+// Verifies that the entries encoded as they are added are sent as the serialization of the whole
+// batch would be.
+TEST_F(GrpcAccessLoggerImplBatchingTest, BatchedEntriesMatchSerializedMessage) {
+  for (absl::string_view path : {"/first", "/second", ""}) {
+    envoy::data::accesslog::v3::HTTPAccessLogEntry entry;
+    if (!path.empty()) {
+      entry.mutable_request()->set_path(std::string(path));
+    }
+    logger_->log(std::move(entry));
+  }
+
+  grpc_access_logger_impl_test_helper_.expectSerializedStreamMessage(R"EOF(
+identifier:
+  node:
+    id: node_name
+    cluster: cluster_name
+    locality:
+      zone: zone_name
+  log_name: test_log_name
+http_logs:
+  log_entry:
+  - request:
+      path: /first
+  - request:
+      path: /second
+  - {}
+)EOF");
+  EXPECT_CALL(*timer_, enableTimer(_, _));
+  timer_->invokeCallback();
+}
+
 class GrpcAccessLoggerCacheImplTest : public testing::Test {
 public:
   GrpcAccessLoggerCacheImplTest()
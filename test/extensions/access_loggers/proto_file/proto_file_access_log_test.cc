@@ -0,0 +1,170 @@
+#include <string>
+#include <vector>
+
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/proto_file/v3/proto_file.pb.h"
+#include "envoy/service/accesslog/v3/als.pb.h"
+
+#include "source/common/access_log/access_log_impl.h"
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/compression/gzip/decompressor/zlib_decompressor_impl.h"
+
+#include "test/mocks/access_log/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace ProtoFile {
+namespace {
+
+using envoy::service::accesslog::v3::StreamAccessLogsMessage;
+
+std::vector<StreamAccessLogsMessage> parseRecords(const std::string& data) {
+  std::vector<StreamAccessLogsMessage> messages;
+  Protobuf::io::ArrayInputStream stream(data.data(), data.size());
+  Protobuf::io::CodedInputStream coded_stream(&stream);
+  uint32_t message_size;
+  while (coded_stream.ReadVarint32(&message_size)) {
+    messages.emplace_back();
+    auto limit = coded_stream.PushLimit(message_size);
+    EXPECT_TRUE(messages.back().ParseFromCodedStream(&coded_stream));
+    coded_stream.PopLimit(limit);
+  }
+  return messages;
+}
+
+class ProtoFileAccessLogTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::access_loggers::proto_file::v3::ProtoFileAccessLog proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+    envoy::config::accesslog::v3::AccessLog config;
+    config.set_name("envoy.access_loggers.proto_file");
+    config.mutable_typed_config()->PackFrom(proto_config);
+
+    EXPECT_CALL(context_.access_log_manager_,
+                createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File,
+                                                            "/tmp/access.pb"}))
+        .WillOnce(Return(file_));
+    ON_CALL(*file_, write(_)).WillByDefault(Invoke([this](absl::string_view data) {
+      written_.push_back(std::string(data));
+    }));
+    context_.local_info_.node_.set_id("node");
+
+    flush_timer_ = new NiceMock<Event::MockTimer>(&context_.thread_local_.dispatcher_);
+    logger_ = AccessLog::AccessLogFactory::fromProto(config, context_);
+  }
+
+  void log(const std::string& path) {
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"}, {":path", path}};
+    logger_->log(&request_headers, &response_headers_, &response_trailers_, stream_info_);
+  }
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+  std::shared_ptr<AccessLog::MockAccessLogFile> file_{
+      std::make_shared<NiceMock<AccessLog::MockAccessLogFile>>()};
+  std::vector<std::string> written_;
+  Event::MockTimer* flush_timer_;
+  AccessLog::InstanceSharedPtr logger_;
+  Http::TestResponseHeaderMapImpl response_headers_{{"x-response", "value"}};
+  Http::TestResponseTrailerMapImpl response_trailers_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+};
+
+// Verifies that the entries are batched until the flush interval, and written as a single length
+// delimited message with the identifier of the log.
+TEST_F(ProtoFileAccessLogTest, BatchesHttpEntriesUntilFlushInterval) {
+  initialize(R"EOF(
+path: /tmp/access.pb
+log_name: test_log
+additional_response_headers_to_log: ["x-response"]
+)EOF");
+
+  log("/first");
+  log("/second");
+  EXPECT_TRUE(written_.empty());
+
+  flush_timer_->invokeCallback();
+  ASSERT_EQ(1, written_.size());
+  const std::vector<StreamAccessLogsMessage> messages = parseRecords(written_[0]);
+  ASSERT_EQ(1, messages.size());
+  EXPECT_EQ("node", messages[0].identifier().node().id());
+  EXPECT_EQ("test_log", messages[0].identifier().log_name());
+  ASSERT_EQ(2, messages[0].http_logs().log_entry_size());
+  EXPECT_EQ("/first", messages[0].http_logs().log_entry(0).request().path());
+  EXPECT_EQ("/second", messages[0].http_logs().log_entry(1).request().path());
+  EXPECT_EQ("value",
+            messages[0].http_logs().log_entry(0).response().response_headers().at("x-response"));
+
+  // Nothing is written when the batch is empty.
+  flush_timer_->invokeCallback();
+  EXPECT_EQ(1, written_.size());
+}
+
+// Verifies that a batch is written once it reaches the buffer size, and that the last batch is
+// written when the log is destroyed.
+TEST_F(ProtoFileAccessLogTest, WritesFullBatchesAndLastBatchOnDestruction) {
+  initialize(R"EOF(
+path: /tmp/access.pb
+entry_type: TCP
+buffer_size_bytes: 1
+)EOF");
+
+  log("/");
+  log("/");
+  EXPECT_EQ(2, written_.size());
+  for (const std::string& record : written_) {
+    const std::vector<StreamAccessLogsMessage> messages = parseRecords(record);
+    ASSERT_EQ(1, messages.size());
+    EXPECT_FALSE(messages[0].has_identifier());
+    EXPECT_EQ(1, messages[0].tcp_logs().log_entry_size());
+  }
+
+  logger_.reset();
+  EXPECT_EQ(2, written_.size());
+}
+
+// Verifies that compressed batches are gzip members holding the length delimited message.
+TEST_F(ProtoFileAccessLogTest, CompressesBatches) {
+  initialize(R"EOF(
+path: /tmp/access.pb
+compression: GZIP
+)EOF");
+
+  log("/compressed");
+  logger_.reset();
+  ASSERT_EQ(1, written_.size());
+
+  Stats::IsolatedStoreImpl stats_store;
+  Compression::Gzip::Decompressor::ZlibDecompressorImpl decompressor{*stats_store.rootScope(),
+                                                                     "test.", 4096, 100};
+  decompressor.init(15 + 16);
+  Buffer::OwnedImpl compressed(written_[0]);
+  Buffer::OwnedImpl decompressed;
+  decompressor.decompress(compressed, decompressed);
+
+  const std::vector<StreamAccessLogsMessage> messages = parseRecords(decompressed.toString());
+  ASSERT_EQ(1, messages.size());
+  ASSERT_EQ(1, messages[0].http_logs().log_entry_size());
+  EXPECT_EQ("/compressed", messages[0].http_logs().log_entry(0).request().path());
+}
+
+} // namespace
+} // namespace ProtoFile
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
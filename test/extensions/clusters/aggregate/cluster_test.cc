@@ -226,6 +226,51 @@ TEST_F(AggregateClusterTest, LoadBalancerTest) {
   }
 }
 
+TEST_F(AggregateClusterTest, ChildPriorityUpdatesTest) {
+  initialize(default_yaml_config_);
+  Upstream::HostSharedPtr host =
+      Upstream::makeTestHost(primary_info_, "tcp://127.0.0.1:80", simTime());
+  auto expectPrimaryUpTo = [&](int last_primary) {
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_CALL(random_, random()).WillOnce(Return(i));
+      EXPECT_CALL(i <= last_primary ? primary_load_balancer_ : secondary_load_balancer_,
+                  chooseHost(_))
+          .WillOnce(Return(host));
+      EXPECT_EQ(host.get(), lb_->chooseHost(nullptr).get());
+    }
+  };
+
+  // Updating a priority that already has hosts only updates its linearized priority.
+  setupPrimary(0, 3, 0, 0);
+  // Health value:
+  // Cluster 1:
+  //     Priority 0: 100%
+  //     Priority 1: 33.3%
+  // Cluster 2:
+  //     Priority 0: 33.3%
+  //     Priority 1: 33.3%
+  expectPrimaryUpTo(99);
+
+  // Removing the last host of a priority linearizes the priorities again.
+  const Upstream::HostVector removed = primary_ps_.hostSetsPerPriority()[0]->hosts();
+  primary_ps_.updateHosts(
+      0,
+      Upstream::HostSetImpl::partitionHosts(std::make_shared<Upstream::HostVector>(),
+                                            Upstream::HostsPerLocalityImpl::empty()),
+      nullptr, {}, removed, 100);
+  // Health value:
+  // Cluster 1:
+  //     Priority 1: 33.3%
+  // Cluster 2:
+  //     Priority 0: 33.3%
+  //     Priority 1: 33.3%
+  expectPrimaryUpTo(32);
+
+  // So does adding the first host of a priority.
+  setupPrimary(0, 3, 0, 0);
+  expectPrimaryUpTo(99);
+}
+
 TEST_F(AggregateClusterTest, AllHostAreUnhealthyTest) {
   initialize(default_yaml_config_);
   Upstream::HostSharedPtr host =
@@ -43,7 +43,7 @@ namespace Upstream {
 
 class EdsSpeedTest {
 public:
-  EdsSpeedTest(State& state, bool use_unified_mux)
+  EdsSpeedTest(State& state, bool use_unified_mux, bool merge_updates = false)
       : state_(state), use_unified_mux_(use_unified_mux),
         type_url_("type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment"),
         subscription_stats_(Config::Utility::generateStats(scope_)),
@@ -67,18 +67,20 @@ public:
           /*xds_resources_delegate=*/Config::XdsResourcesDelegateOptRef(),
           /*target_xds_authority=*/""));
     }
-    resetCluster(R"EOF(
+    resetCluster(fmt::format(R"EOF(
       name: name
       connect_timeout: 0.25s
       type: EDS
       eds_cluster_config:
         service_name: fare
+        assignment_merge_window: {}
         eds_config:
           api_config_source:
             cluster_names:
             - eds
             refresh_delay: 1s
     )EOF",
+                             merge_updates ? "1s" : "0s"),
                  Envoy::Upstream::Cluster::InitializePhase::Secondary);
 
     EXPECT_CALL(*server_context_.cluster_manager_.subscription_factory_.subscription_, start(_));
@@ -238,3 +240,43 @@ static void healthOnlyUpdate(State& state) {
 }
 
 BENCHMARK(healthOnlyUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Measures the updates resending an unchanged assignment, which are skipped by their hash.
+static void unchangedUpdates(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Envoy::Upstream::EdsSpeedTest speed_test(state, state.range(1));
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true);
+    for (int i = 0; i < 10; ++i) {
+      speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true);
+    }
+  }
+}
+
+BENCHMARK(unchangedUpdates)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Measures a burst of assignments flipping the health of all the hosts, which are all applied
+// unless they are merged within the assignment merge window. The merged assignment applied when the
+// window ends costs as much as one of the updates.
+static void burstOfUpdates(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Envoy::Upstream::EdsSpeedTest speed_test(state, state.range(1), state.range(2));
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true);
+    for (int i = 0; i < 10; ++i) {
+      speed_test.priorityAndLocalityWeightedHelper(true, endpoints, i % 2 == 1);
+    }
+  }
+}
+
+BENCHMARK(burstOfUpdates)
+    ->Ranges({{1, 100000}, {false, true}, {false, true}})
+    ->Unit(benchmark::kMillisecond);
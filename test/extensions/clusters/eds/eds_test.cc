@@ -303,6 +303,41 @@ TEST_F(EdsTest, OnConfigUpdateSuccess) {
             stats_.findCounterByString("cluster.name.update_no_rebuild").value().get().value());
 }
 
+// Validate that an unchanged assignment is skipped, while a changed one is applied.
+TEST_F(EdsTest, OnConfigUpdateUnchanged) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+  cluster_load_assignment.set_cluster_name("fare");
+  auto* socket_address = cluster_load_assignment.add_endpoints()
+                             ->add_lb_endpoints()
+                             ->mutable_endpoint()
+                             ->mutable_address()
+                             ->mutable_socket_address();
+  socket_address->set_address("1.2.3.4");
+  socket_address->set_port_value(80);
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_TRUE(initialized_);
+  const HostSharedPtr host = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts()[0];
+
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1UL, stats_.findCounterByString("cluster.name.update_unchanged").value().get().value());
+  EXPECT_EQ(1UL,
+            stats_.findCounterByString("cluster.name.update_no_rebuild").value().get().value());
+  EXPECT_EQ(host, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts()[0]);
+
+  socket_address->set_port_value(81);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1UL, stats_.findCounterByString("cluster.name.update_unchanged").value().get().value());
+  EXPECT_EQ(81,
+            cluster_->prioritySet().hostSetsPerPriority()[0]->hosts()[0]->address()->ip()->port());
+
+  runtime_.mergeValues({{"envoy.reloadable_features.eds_skip_unchanged_assignments", "false"}});
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1UL, stats_.findCounterByString("cluster.name.update_unchanged").value().get().value());
+  EXPECT_EQ(2UL,
+            stats_.findCounterByString("cluster.name.update_no_rebuild").value().get().value());
+}
+
 // Validate that delta-style onConfigUpdate() with the expected cluster accepts config.
 TEST_F(EdsTest, DeltaOnConfigUpdateSuccess) {
   envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
@@ -2509,6 +2544,101 @@ TEST_F(EdsAssignmentTimeoutTest, AssignmentLeaseExpired) {
 
 // Validate that onConfigUpdate() with a config that contains both LEDS config
 // source and explicit list of endpoints is rejected.
+class EdsAssignmentMergeWindowTest : public EdsTest {
+public:
+  EdsAssignmentMergeWindowTest() {
+    EXPECT_CALL(server_context_.dispatcher_, createTimer_(_))
+        .WillOnce(Invoke([](Event::TimerCb) { return new NiceMock<Event::MockTimer>(); }))
+        .WillOnce(Invoke([this](Event::TimerCb cb) {
+          merge_timer_ = new NiceMock<Event::MockTimer>();
+          merge_timer_->callback_ = cb;
+          return merge_timer_;
+        }))
+        .WillRepeatedly(Invoke([](Event::TimerCb) { return new Event::MockTimer(); }));
+
+    resetCluster(R"EOF(
+      name: name
+      connect_timeout: 0.25s
+      type: EDS
+      lb_policy: ROUND_ROBIN
+      eds_cluster_config:
+        service_name: fare
+        assignment_merge_window: 0.1s
+        eds_config:
+          api_config_source:
+            api_type: REST
+            cluster_names:
+            - eds
+            refresh_delay: 1s
+    )EOF",
+                 Cluster::InitializePhase::Secondary);
+    cluster_load_assignment_.set_cluster_name("fare");
+    socket_address_ = cluster_load_assignment_.add_endpoints()
+                          ->add_lb_endpoints()
+                          ->mutable_endpoint()
+                          ->mutable_address()
+                          ->mutable_socket_address();
+    socket_address_->set_address("1.2.3.4");
+    initialize();
+  }
+
+  void updatePort(uint32_t port) {
+    socket_address_->set_port_value(port);
+    doOnConfigUpdateVerifyNoThrow(cluster_load_assignment_);
+  }
+
+  uint32_t hostPort() {
+    return cluster_->prioritySet().hostSetsPerPriority()[0]->hosts()[0]->address()->ip()->port();
+  }
+
+  uint64_t mergedUpdates() {
+    return stats_.findCounterByString("cluster.name.update_merged").value().get().value();
+  }
+
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment_;
+  envoy::config::core::v3::SocketAddress* socket_address_;
+  NiceMock<Event::MockTimer>* merge_timer_{nullptr};
+};
+
+// The assignments received within the merge window are merged, the last one being applied when the
+// window ends.
+TEST_F(EdsAssignmentMergeWindowTest, MergeUpdates) {
+  EXPECT_CALL(*merge_timer_, enableTimer(std::chrono::milliseconds(100), _));
+  updatePort(80);
+  EXPECT_TRUE(initialized_);
+  EXPECT_EQ(80, hostPort());
+  EXPECT_TRUE(merge_timer_->enabled_);
+
+  updatePort(81);
+  updatePort(82);
+  EXPECT_EQ(80, hostPort());
+  EXPECT_EQ(2UL, mergedUpdates());
+
+  // The window is restarted when a merged assignment is applied.
+  EXPECT_CALL(*merge_timer_, enableTimer(std::chrono::milliseconds(100), _));
+  merge_timer_->invokeCallback();
+  EXPECT_EQ(82, hostPort());
+  EXPECT_TRUE(merge_timer_->enabled_);
+
+  // The window ends when no assignment was merged, so that the next one is applied immediately.
+  merge_timer_->invokeCallback();
+  EXPECT_FALSE(merge_timer_->enabled_);
+  EXPECT_CALL(*merge_timer_, enableTimer(std::chrono::milliseconds(100), _));
+  updatePort(83);
+  EXPECT_EQ(83, hostPort());
+  EXPECT_EQ(2UL, mergedUpdates());
+}
+
+// A merged assignment which fails to apply is dropped.
+TEST_F(EdsAssignmentMergeWindowTest, MergedUpdateFailure) {
+  updatePort(80);
+  socket_address_->set_address("foo.bar.com");
+  updatePort(81);
+  EXPECT_EQ(1UL, mergedUpdates());
+  EXPECT_NO_THROW(merge_timer_->invokeCallback());
+  EXPECT_EQ(80, hostPort());
+}
+
 TEST_F(EdsTest, OnConfigUpdateLedsAndEndpoints) {
   envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
   cluster_load_assignment.set_cluster_name("fare");
@@ -62,6 +62,46 @@ public:
   Http::RequestHeaderMapPtr downstream_headers_;
 };
 
+class HostMultiMapTest : public Event::TestUsingSimulatedTime, public testing::Test {};
+
+TEST_F(HostMultiMapTest, SnapshotsShareUnmodifiedShards) {
+  auto info = std::make_shared<NiceMock<MockClusterInfo>>();
+  auto makeHosts = [&](const std::string& address) {
+    HostSharedPtr host = makeTestHost(info, "tcp://" + address, simTime());
+    return std::make_shared<HostsForAddress>(host);
+  };
+
+  HostMultiMap first;
+  EXPECT_TRUE(first.empty());
+  for (int i = 0; i < 100; i++) {
+    first.emplace(fmt::format("10.0.0.{}:80", i), makeHosts(fmt::format("10.0.0.{}:80", i)));
+  }
+  EXPECT_EQ(100, first.size());
+
+  HostMultiMap second(first);
+  second.emplace("10.0.1.0:80", makeHosts("10.0.1.0:80"));
+  second.erase("10.0.0.0:80");
+  second.erase("10.0.2.0:80");
+  EXPECT_EQ(100, second.size());
+
+  // The snapshot that was copied is left as it was.
+  EXPECT_EQ(100, first.size());
+  EXPECT_NE(nullptr, first.find("10.0.0.0:80"));
+  EXPECT_EQ(nullptr, first.find("10.0.1.0:80"));
+  EXPECT_EQ(nullptr, second.find("10.0.0.0:80"));
+  ASSERT_NE(nullptr, second.find("10.0.1.0:80"));
+  EXPECT_EQ("10.0.1.0:80", second.find("10.0.1.0:80")->host_->address()->asString());
+  // The hosts of the addresses that were not modified are shared.
+  EXPECT_EQ(first.find("10.0.0.1:80"), second.find("10.0.0.1:80"));
+
+  size_t addresses = 0;
+  second.iterate([&addresses](const std::string& address, HostsForAddress& hosts) {
+    EXPECT_EQ(address, hosts.host_->address()->asString());
+    addresses++;
+  });
+  EXPECT_EQ(100, addresses);
+}
+
 class OriginalDstClusterTest : public Event::TestUsingSimulatedTime, public testing::Test {
 public:
   // cleanup timer must be created before the cluster (in setup()), so that we can set expectations
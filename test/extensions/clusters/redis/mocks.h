@@ -23,6 +23,7 @@ public:
 
   MOCK_METHOD(bool, onClusterSlotUpdate, (ClusterSlotsSharedPtr&&, Upstream::HostMap&));
   MOCK_METHOD(void, onHostHealthUpdate, ());
+  MOCK_METHOD(bool, onSlotsMoved, (const Common::Redis::MovedSlots&));
 };
 
 } // namespace Redis
@@ -395,6 +395,31 @@ TEST_F(RedisClusterLoadBalancerTest, ClusterSlotNoUpdate) {
   validateAssignment(hosts, expected_assignments);
 }
 
+TEST_F(RedisClusterLoadBalancerTest, SlotsMoved) {
+  Upstream::HostVector hosts{Upstream::makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                             Upstream::makeTestHost(info_, "tcp://127.0.0.1:91", simTime())};
+  Upstream::HostMap all_hosts{{hosts[0]->address()->asString(), hosts[0]},
+                              {hosts[1]->address()->asString(), hosts[1]}};
+  init();
+
+  // Without a slot map, there is nothing to patch.
+  EXPECT_FALSE(factory_->onSlotsMoved({{100, hosts[1]->address()->asString()}}));
+
+  ClusterSlotsPtr slots = std::make_unique<std::vector<ClusterSlot>>(std::vector<ClusterSlot>{
+      ClusterSlot(0, 1000, hosts[0]->address()), ClusterSlot(1001, 16383, hosts[1]->address())});
+  EXPECT_TRUE(factory_->onClusterSlotUpdate(std::move(slots), all_hosts));
+  validateAssignment(hosts, {{100, 0}, {101, 0}, {1100, 1}});
+
+  // Only the moved slot is patched.
+  EXPECT_TRUE(factory_->onSlotsMoved({{100, hosts[1]->address()->asString()}}));
+  validateAssignment(hosts, {{100, 1}, {101, 0}, {1100, 1}});
+
+  // A slot already served by the host, or moved to a host which isn't a primary, isn't patched.
+  EXPECT_FALSE(factory_->onSlotsMoved(
+      {{100, hosts[1]->address()->asString()}, {101, "127.0.0.1:92"}}));
+  validateAssignment(hosts, {{100, 1}, {101, 0}, {1100, 1}});
+}
+
 TEST_F(RedisLoadBalancerContextImplTest, Basic) {
   // Simple read command
   std::vector<NetworkFilters::Common::Redis::RespValue> get_foo(2);
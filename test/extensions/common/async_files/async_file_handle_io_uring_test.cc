@@ -0,0 +1,169 @@
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager.h"
+#include "source/extensions/common/async_files/async_file_manager_factory.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/test_common/status_utility.h"
+#include "test/test_common/utility.h"
+
+#include "absl/status/statusor.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+namespace {
+
+using StatusHelpers::IsOkAndHolds;
+
+class AsyncFileHandleIoUringTest : public testing::Test {
+public:
+  void SetUp() override {
+    if (!Io::isIoUringSupported()) {
+      GTEST_SKIP() << "io_uring is not supported";
+    }
+    singleton_manager_ = std::make_unique<Singleton::ManagerImpl>(Thread::threadFactoryForTest());
+    factory_ = AsyncFileManagerFactory::singleton(singleton_manager_.get());
+    envoy::extensions::common::async_files::v3::AsyncFileManagerConfig config;
+    // A small queue depth, so that actions get queued behind the ones in flight.
+    config.mutable_io_uring()->set_queue_depth(2);
+    config.mutable_io_uring()->set_thread_count(1);
+    manager_ = factory_->getAsyncFileManager(config);
+  }
+
+  AsyncFileHandle createAnonymousFile() {
+    std::promise<AsyncFileHandle> create_result;
+    manager_->createAnonymousFile(tmpdir_, [&](absl::StatusOr<AsyncFileHandle> result) {
+      create_result.set_value(result.value());
+    });
+    return create_result.get_future().get();
+  }
+
+  void close(AsyncFileHandle& handle) {
+    std::promise<absl::Status> close_result;
+    EXPECT_OK(handle->close([&](absl::Status status) { close_result.set_value(status); }));
+    EXPECT_OK(close_result.get_future().get());
+  }
+
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  std::string tmpdir_ = test_tmpdir ? test_tmpdir : "/tmp";
+
+  std::unique_ptr<Singleton::ManagerImpl> singleton_manager_;
+  std::shared_ptr<AsyncFileManagerFactory> factory_;
+  std::shared_ptr<AsyncFileManager> manager_;
+};
+
+TEST_F(AsyncFileHandleIoUringTest, Describe) {
+  EXPECT_EQ(manager_->describe(), "io_uring_queue_depth = 2, thread_pool_size = 1");
+}
+
+TEST_F(AsyncFileHandleIoUringTest, WriteReadClose) {
+  auto handle = createAnonymousFile();
+  absl::StatusOr<size_t> write_status, second_write_status;
+  absl::StatusOr<Buffer::InstancePtr> read_status, second_read_status;
+  Buffer::OwnedImpl hello("hello");
+  std::promise<absl::Status> close_status;
+  EXPECT_OK(handle->write(hello, 0, [&](absl::StatusOr<size_t> status) {
+    write_status = std::move(status);
+    Buffer::OwnedImpl two_chars("p!");
+    EXPECT_OK(handle->write(two_chars, 3, [&](absl::StatusOr<size_t> status) {
+      second_write_status = std::move(status);
+      EXPECT_OK(handle->read(0, 5, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+        read_status = std::move(status);
+        EXPECT_OK(handle->read(2, 3, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+          second_read_status = std::move(status);
+          EXPECT_OK(handle->close(
+              [&](absl::Status status) { close_status.set_value(std::move(status)); }));
+        }));
+      }));
+    }));
+  }));
+  ASSERT_OK(close_status.get_future().get());
+  EXPECT_THAT(write_status, IsOkAndHolds(5U));
+  EXPECT_THAT(second_write_status, IsOkAndHolds(2U));
+  ASSERT_OK(read_status);
+  EXPECT_THAT(*read_status.value(), BufferStringEqual("help!"));
+  ASSERT_OK(second_read_status);
+  EXPECT_THAT(*second_read_status.value(), BufferStringEqual("lp!"));
+}
+
+TEST_F(AsyncFileHandleIoUringTest, ShortReadAtEndOfFile) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl hello("hello");
+  std::promise<absl::StatusOr<size_t>> write_status;
+  EXPECT_OK(handle->write(hello, 0, [&](absl::StatusOr<size_t> status) {
+    write_status.set_value(std::move(status));
+  }));
+  EXPECT_THAT(write_status.get_future().get(), IsOkAndHolds(5U));
+  std::promise<absl::StatusOr<Buffer::InstancePtr>> read_status;
+  EXPECT_OK(handle->read(3, 100, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+    read_status.set_value(std::move(status));
+  }));
+  absl::StatusOr<Buffer::InstancePtr> read = read_status.get_future().get();
+  ASSERT_OK(read);
+  EXPECT_THAT(*read.value(), BufferStringEqual("lo"));
+  close(handle);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, MoreActionsThanQueueDepth) {
+  auto handle = createAnonymousFile();
+  constexpr int kWrites = 16;
+  std::vector<std::promise<absl::StatusOr<size_t>>> write_statuses(kWrites);
+  for (int i = 0; i < kWrites; i++) {
+    Buffer::OwnedImpl data(std::string(1, 'a' + i));
+    EXPECT_OK(handle->write(data, i, [&write_statuses, i](absl::StatusOr<size_t> status) {
+      write_statuses[i].set_value(std::move(status));
+    }));
+  }
+  for (auto& write_status : write_statuses) {
+    EXPECT_THAT(write_status.get_future().get(), IsOkAndHolds(1U));
+  }
+  std::promise<absl::StatusOr<Buffer::InstancePtr>> read_status;
+  EXPECT_OK(handle->read(0, kWrites, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+    read_status.set_value(std::move(status));
+  }));
+  absl::StatusOr<Buffer::InstancePtr> read = read_status.get_future().get();
+  ASSERT_OK(read);
+  EXPECT_THAT(*read.value(), BufferStringEqual("abcdefghijklmnop"));
+  close(handle);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, ReadErrorIsReported) {
+  // Anonymous files are opened read-write, so use a write-only file to make the read fail.
+  char filename[1024];
+  snprintf(filename, sizeof(filename), "%s/async_io_uring_test.XXXXXX", tmpdir_.c_str());
+  Api::OsSysCalls& posix = Api::OsSysCallsSingleton().get();
+  int fd = posix.mkstemp(filename).return_value_;
+  ASSERT_NE(-1, fd);
+  posix.close(fd);
+  std::promise<AsyncFileHandle> open_result;
+  manager_->openExistingFile(filename, AsyncFileManager::Mode::WriteOnly,
+                             [&](absl::StatusOr<AsyncFileHandle> result) {
+                               open_result.set_value(result.value());
+                             });
+  AsyncFileHandle handle = open_result.get_future().get();
+  std::promise<absl::StatusOr<Buffer::InstancePtr>> read_status;
+  EXPECT_OK(handle->read(0, 5, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+    read_status.set_value(std::move(status));
+  }));
+  EXPECT_FALSE(read_status.get_future().get().ok());
+  close(handle);
+  posix.unlink(filename);
+}
+
+} // namespace
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -1,3 +1,5 @@
+#include <sys/mman.h>
+
 #include <future>
 #include <memory>
 #include <string>
@@ -138,6 +140,36 @@ TEST_F(AsyncFileHandleTest, WriteReadClose) {
   EXPECT_THAT(*second_read_status.value(), BufferStringEqual("lp!"));
 }
 
+TEST_F(AsyncFileHandleTest, WriteReadMappedClose) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl hello("hello world");
+  std::promise<absl::StatusOr<size_t>> write_status;
+  EXPECT_OK(handle->write(
+      hello, 0, [&](absl::StatusOr<size_t> status) { write_status.set_value(std::move(status)); }));
+  EXPECT_THAT(write_status.get_future().get(), IsOkAndHolds(11U));
+
+  auto read_mapped = [&handle](off_t offset, size_t length) {
+    std::promise<absl::StatusOr<Buffer::InstancePtr>> read_status;
+    EXPECT_OK(handle->readMapped(offset, length, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+      read_status.set_value(std::move(status));
+    }));
+    return read_status.get_future().get();
+  };
+  absl::StatusOr<Buffer::InstancePtr> world = read_mapped(6, 5);
+  // Reads past the end of the file are truncated.
+  absl::StatusOr<Buffer::InstancePtr> truncated = read_mapped(9, 10);
+  absl::StatusOr<Buffer::InstancePtr> past_end = read_mapped(20, 5);
+  close(handle);
+
+  // The mappings outlive the file handle.
+  ASSERT_OK(world);
+  EXPECT_THAT(*world.value(), BufferStringEqual("world"));
+  ASSERT_OK(truncated);
+  EXPECT_THAT(*truncated.value(), BufferStringEqual("ld"));
+  ASSERT_OK(past_end);
+  EXPECT_EQ(0, past_end.value()->length());
+}
+
 TEST_F(AsyncFileHandleTest, LinkCreatesNamedFile) {
   auto handle = createAnonymousFile();
   std::promise<absl::StatusOr<size_t>> write_status_promise;
@@ -330,6 +362,23 @@ TEST_F(AsyncFileHandleWithMockPosixTest, PartialReadReturnsPartialResult) {
   close(handle);
 }
 
+TEST_F(AsyncFileHandleWithMockPosixTest, ReadMappedFailureReportsError) {
+  auto handle = createAnonymousFile();
+  EXPECT_CALL(mock_posix_file_operations_, fstat(_, _)).WillOnce([](int, struct stat* buffer) {
+    buffer->st_size = 100;
+    return Api::SysCallIntResult{0, 0};
+  });
+  EXPECT_CALL(mock_posix_file_operations_, mmap(_, _, _, _, _, _))
+      .WillOnce(Return(Api::SysCallPtrResult{MAP_FAILED, ENOMEM}));
+  std::promise<absl::StatusOr<Buffer::InstancePtr>> read_status_promise;
+  EXPECT_OK(handle->readMapped(10, 5, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+    read_status_promise.set_value(std::move(status));
+  }));
+  EXPECT_THAT(read_status_promise.get_future().get(),
+              StatusIs(absl::StatusCode::kResourceExhausted));
+  close(handle);
+}
+
 MATCHER_P(IsMemoryMatching, str, "") {
   absl::string_view expected{str};
   *result_listener << "is memory matching " << expected;
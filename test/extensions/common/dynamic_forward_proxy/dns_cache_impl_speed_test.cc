@@ -0,0 +1,114 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/extensions/common/dynamic_forward_proxy/v3/dns_cache.pb.h"
+
+#include "source/common/common/macros.h"
+#include "source/extensions/common/dynamic_forward_proxy/dns_cache_impl.h"
+
+#include "test/extensions/common/dynamic_forward_proxy/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/registry.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace DynamicForwardProxy {
+namespace {
+
+constexpr size_t NumHosts = 256;
+
+// A cache shared by the benchmark threads, like the cache of the dynamic forward proxy is shared
+// by the workers. Its hosts are all resolved on construction, and there is no room for more, so
+// that the lookups of other hosts overflow after taking the lock of the primary hosts.
+class ResolvedDnsCache {
+public:
+  ResolvedDnsCache() : registered_dns_factory_(dns_resolver_factory_) {
+    ON_CALL(context_.dispatcher_, isThreadSafe()).WillByDefault(Return(true));
+    ON_CALL(dns_resolver_factory_, createDnsResolver(_, _, _)).WillByDefault(Return(resolver_));
+    ON_CALL(*resolver_, resolve(_, _, _))
+        .WillByDefault(Invoke([](const std::string&, Network::DnsLookupFamily,
+                                 Network::DnsResolver::ResolveCb callback)
+                                  -> Network::ActiveDnsQuery* {
+          callback(Network::DnsResolver::ResolutionStatus::Success,
+                   TestUtility::makeDnsResponse({"10.0.0.1"}));
+          return nullptr;
+        }));
+
+    envoy::extensions::common::dynamic_forward_proxy::v3::DnsCacheConfig config;
+    config.set_name("foo");
+    config.set_dns_lookup_family(envoy::config::cluster::v3::Cluster::V4_ONLY);
+    config.mutable_max_hosts()->set_value(NumHosts);
+    dns_cache_ = std::make_unique<DnsCacheImpl>(context_, config);
+
+    // The mock dispatcher runs the posted loads, and so the resolutions, inline.
+    for (size_t i = 0; i < NumHosts; i++) {
+      hosts_.push_back(absl::StrCat("host", i, ".example.com"));
+      dns_cache_->loadDnsCacheEntry(hosts_.back(), 443, false, callbacks_);
+    }
+  }
+
+  bool inCache(const std::string& host) {
+    return dns_cache_->loadDnsCacheEntry(host, 443, false, callbacks_).status_ ==
+           DnsCache::LoadDnsCacheEntryStatus::InCache;
+  }
+
+  const std::string& host(size_t i) const { return hosts_[i % NumHosts]; }
+
+private:
+  NiceMock<Server::Configuration::MockFactoryContext> context_;
+  std::shared_ptr<NiceMock<Network::MockDnsResolver>> resolver_{
+      std::make_shared<NiceMock<Network::MockDnsResolver>>()};
+  NiceMock<Network::MockDnsResolverFactory> dns_resolver_factory_;
+  Registry::InjectFactory<Network::DnsResolverFactory> registered_dns_factory_;
+  NiceMock<MockLoadDnsCacheEntryCallbacks> callbacks_;
+  std::unique_ptr<DnsCacheImpl> dns_cache_;
+  std::vector<std::string> hosts_;
+};
+
+ResolvedDnsCache& resolvedDnsCache() { MUTABLE_CONSTRUCT_ON_FIRST_USE(ResolvedDnsCache); }
+
+// The lookups of resolved hosts, which are answered from the copy of the hosts of the worker.
+void bmCacheHit(benchmark::State& state) {
+  ResolvedDnsCache& dns_cache = resolvedDnsCache();
+  size_t i = state.thread_index();
+  uint64_t hits = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    hits += dns_cache.inCache(dns_cache.host(i++));
+  }
+  benchmark::DoNotOptimize(hits);
+}
+BENCHMARK(bmCacheHit)->ThreadRange(1, 16)->UseRealTime();
+
+// The lookups of unknown hosts, which take the lock of the primary hosts.
+void bmCacheMiss(benchmark::State& state) {
+  ResolvedDnsCache& dns_cache = resolvedDnsCache();
+  const std::string host = "unknown.example.com";
+  uint64_t hits = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    hits += dns_cache.inCache(host);
+  }
+  benchmark::DoNotOptimize(hits);
+}
+BENCHMARK(bmCacheMiss)->ThreadRange(1, 16)->UseRealTime();
+
+} // namespace
+} // namespace DynamicForwardProxy
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
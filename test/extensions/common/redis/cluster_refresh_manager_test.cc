@@ -17,6 +17,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
 using testing::Return;
 
 namespace Envoy {
@@ -121,7 +122,7 @@ public:
 // invalid unregistered cluster names.
 TEST_F(ClusterRefreshManagerTest, Basic) {
   handle_ = refresh_manager_->registerCluster(cluster_name_, std::chrono::milliseconds(1000), 1, 1,
-                                              1, [&]() { callback_count_++; });
+                                              1, [&]() { callback_count_++; }, nullptr);
   ClusterRefreshManagerImpl::ClusterInfoSharedPtr cluster_info = clusterInfo(cluster_name_);
 
   Thread::ThreadPtr thread_1 = platform_.threadFactory().createThread([&]() {
@@ -165,7 +166,7 @@ TEST_F(ClusterRefreshManagerTest, Basic) {
 // invalid unregistered cluster names.
 TEST_F(ClusterRefreshManagerTest, BasicFailureEvents) {
   handle_ = refresh_manager_->registerCluster(cluster_name_, std::chrono::milliseconds(1000), 1, 1,
-                                              1, [&]() { callback_count_++; });
+                                              1, [&]() { callback_count_++; }, nullptr);
   ClusterRefreshManagerImpl::ClusterInfoSharedPtr cluster_info = clusterInfo(cluster_name_);
 
   Thread::ThreadPtr thread_1 = platform_.threadFactory().createThread([&]() {
@@ -209,7 +210,7 @@ TEST_F(ClusterRefreshManagerTest, BasicFailureEvents) {
 // invalid unregistered cluster names.
 TEST_F(ClusterRefreshManagerTest, BasicDegradedEvents) {
   handle_ = refresh_manager_->registerCluster(cluster_name_, std::chrono::milliseconds(1000), 1, 1,
-                                              1, [&]() { callback_count_++; });
+                                              1, [&]() { callback_count_++; }, nullptr);
   ClusterRefreshManagerImpl::ClusterInfoSharedPtr cluster_info = clusterInfo(cluster_name_);
 
   Thread::ThreadPtr thread_1 = platform_.threadFactory().createThread([&]() {
@@ -253,7 +254,7 @@ TEST_F(ClusterRefreshManagerTest, BasicDegradedEvents) {
 // to simulate possible thread timing issues.
 TEST_F(ClusterRefreshManagerTest, HighVolume) {
   handle_ = refresh_manager_->registerCluster(cluster_name_, std::chrono::seconds(2), 1000, 1000,
-                                              1000, [&]() { callback_count_++; });
+                                              1000, [&]() { callback_count_++; }, nullptr);
   ClusterRefreshManagerImpl::ClusterInfoSharedPtr cluster_info = clusterInfo(cluster_name_);
   uint32_t thread1_callback_count = 0;
   uint32_t thread2_callback_count = 0;
@@ -298,7 +299,7 @@ TEST_F(ClusterRefreshManagerTest, HighVolume) {
 // degraded events are disabled by setting the threshold to 0
 TEST_F(ClusterRefreshManagerTest, FeatureDisabled) {
   handle_ = refresh_manager_->registerCluster(cluster_name_, std::chrono::milliseconds(1000), 0, 0,
-                                              0, [&]() { callback_count_++; });
+                                              0, [&]() { callback_count_++; }, nullptr);
   ClusterRefreshManagerImpl::ClusterInfoSharedPtr cluster_info = clusterInfo(cluster_name_);
 
   EXPECT_FALSE(refresh_manager_->onRedirection(cluster_name_));
@@ -316,6 +317,33 @@ TEST_F(ClusterRefreshManagerTest, FeatureDisabled) {
   EXPECT_EQ(cluster_info->host_degraded_threshold_, 0);
 }
 
+// The slots moved by a burst of redirections are handed to the cluster in a single callback.
+TEST_F(ClusterRefreshManagerTest, SlotMoved) {
+  std::vector<MovedSlots> moves;
+  handle_ = refresh_manager_->registerCluster(
+      cluster_name_, std::chrono::milliseconds(1000), 0, 0, 0, [&]() { callback_count_++; },
+      [&](const MovedSlots& moved_slots) { moves.push_back(moved_slots); });
+
+  std::function<void()> post_cb;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce(testing::SaveArg<0>(&post_cb));
+  EXPECT_TRUE(refresh_manager_->onSlotMoved(cluster_name_, 1, "10.0.0.1:6379"));
+  EXPECT_FALSE(refresh_manager_->onSlotMoved(cluster_name_, 2, "10.0.0.1:6379"));
+  EXPECT_FALSE(refresh_manager_->onSlotMoved(cluster_name_, 1, "10.0.0.2:6379"));
+  EXPECT_FALSE(refresh_manager_->onSlotMoved("unknown_cluster", 1, "10.0.0.2:6379"));
+
+  post_cb();
+  ASSERT_EQ(1, moves.size());
+  EXPECT_EQ((MovedSlots{{1, "10.0.0.2:6379"}, {2, "10.0.0.1:6379"}}), moves[0]);
+  EXPECT_EQ(0, callback_count_);
+
+  // The next move posts the callback again.
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce(testing::SaveArg<0>(&post_cb));
+  EXPECT_TRUE(refresh_manager_->onSlotMoved(cluster_name_, 3, "10.0.0.1:6379"));
+  post_cb();
+  ASSERT_EQ(2, moves.size());
+  EXPECT_EQ((MovedSlots{{3, "10.0.0.1:6379"}}), moves[1]);
+}
+
 } // namespace Redis
 } // namespace Common
 } // namespace Extensions
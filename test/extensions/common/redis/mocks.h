@@ -17,11 +17,14 @@ public:
   MOCK_METHOD(bool, onRedirection, (const std::string& cluster_name));
   MOCK_METHOD(bool, onFailure, (const std::string& cluster_name));
   MOCK_METHOD(bool, onHostDegraded, (const std::string& cluster_name));
+  MOCK_METHOD(bool, onSlotMoved,
+              (const std::string& cluster_name, uint16_t slot, const std::string& host_address));
   MOCK_METHOD(HandlePtr, registerCluster,
               (const std::string& cluster_name,
                std::chrono::milliseconds min_time_between_triggering,
                const uint32_t redirects_threshold, const uint32_t failure_threshold,
-               const uint32_t host_degraded_threshold, const RefreshCB& cb));
+               const uint32_t host_degraded_threshold, const RefreshCB& cb,
+               const SlotMovedCB& slot_moved_cb));
 };
 
 } // namespace Redis
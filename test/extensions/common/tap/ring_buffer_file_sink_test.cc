@@ -0,0 +1,202 @@
+#include <cstring>
+#include <vector>
+
+#include "envoy/config/tap/v3/common.pb.h"
+#include "envoy/data/tap/v3/wrapper.pb.h"
+
+#include "source/extensions/common/tap/ring_buffer_file_sink.h"
+
+#include "test/extensions/common/tap/common.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Tap {
+namespace {
+
+bool pushString(RecordRing& ring, const std::string& value) {
+  return ring.push(value.size(),
+                   [&value](uint8_t* record) { memcpy(record, value.data(), value.size()); });
+}
+
+// Verifies that the records are drained in order, and that a full ring drops records until it is
+// drained.
+TEST(RecordRingTest, PushAndDrain) {
+  RecordRing ring(3, 8);
+  EXPECT_EQ(4, ring.capacity());
+
+  std::string output;
+  ring.drainTo(output);
+  EXPECT_EQ("", output);
+
+  EXPECT_TRUE(pushString(ring, "a"));
+  EXPECT_TRUE(pushString(ring, "bb"));
+  EXPECT_TRUE(pushString(ring, "ccc"));
+  EXPECT_TRUE(pushString(ring, "dddddddd"));
+  EXPECT_FALSE(pushString(ring, "e"));
+  ring.drainTo(output);
+  EXPECT_EQ("abbcccdddddddd", output);
+
+  output.clear();
+  EXPECT_TRUE(pushString(ring, "f"));
+  EXPECT_TRUE(pushString(ring, "g"));
+  ring.drainTo(output);
+  EXPECT_EQ("fg", output);
+}
+
+// Verifies that the records pushed concurrently by several threads are drained once each, in the
+// order each thread pushed them.
+TEST(RecordRingTest, ConcurrentPushes) {
+  constexpr uint32_t Threads = 4;
+  constexpr uint32_t RecordsPerThread = 10000;
+  RecordRing ring(64, 2 * sizeof(uint32_t));
+
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t thread = 0; thread < Threads; thread++) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([&ring, thread]() {
+      for (uint32_t i = 0; i < RecordsPerThread;) {
+        if (ring.push(2 * sizeof(uint32_t), [thread, i](uint8_t* record) {
+              memcpy(record, &thread, sizeof(thread));
+              memcpy(record + sizeof(thread), &i, sizeof(i));
+            })) {
+          i++;
+        }
+      }
+    }));
+  }
+
+  std::vector<uint32_t> next(Threads, 0);
+  uint32_t drained = 0;
+  std::string output;
+  while (drained < Threads * RecordsPerThread) {
+    output.clear();
+    ring.drainTo(output);
+    ASSERT_EQ(0, output.size() % (2 * sizeof(uint32_t)));
+    for (size_t offset = 0; offset < output.size(); offset += 2 * sizeof(uint32_t)) {
+      uint32_t thread;
+      uint32_t i;
+      memcpy(&thread, output.data() + offset, sizeof(thread));
+      memcpy(&i, output.data() + offset + sizeof(thread), sizeof(i));
+      ASSERT_LT(thread, Threads);
+      EXPECT_EQ(next[thread]++, i);
+      drained++;
+    }
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  EXPECT_EQ(std::vector<uint32_t>(Threads, RecordsPerThread), next);
+}
+
+class RingBufferFileSinkTest : public testing::Test {
+protected:
+  RingBufferFileSinkTest() {
+    if (api_->fileSystem().fileExists(path_)) {
+      TestEnvironment::removePath(path_);
+    }
+  }
+
+  void initialize(const std::string& yaml) {
+    envoy::config::tap::v3::RingBufferFileSink config;
+    TestUtility::loadFromYaml(yaml, config);
+    config.set_path(path_);
+    sink_ = std::make_unique<RingBufferFileSink>(config, *api_);
+  }
+
+  void submit(const std::string& yaml) {
+    TraceWrapperPtr trace = makeTraceWrapper();
+    TestUtility::loadFromYaml(yaml, *trace);
+    sink_
+        ->createPerTapSinkHandle(0,
+                                 envoy::config::tap::v3::OutputSink::OutputSinkTypeCase::
+                                     kRingBufferFile)
+        ->submitTrace(std::move(trace),
+                      envoy::config::tap::v3::OutputSink::PROTO_BINARY_LENGTH_DELIMITED);
+  }
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+  const std::string path_{TestEnvironment::temporaryPath("tap_ring_buffer_file_sink")};
+  std::unique_ptr<RingBufferFileSink> sink_;
+};
+
+// Verifies that the traces are written to the file when the sink is destroyed, and that the traces
+// that don't fit in a record are dropped.
+TEST_F(RingBufferFileSinkTest, WritesRecordsOnDestruction) {
+  initialize(R"EOF(
+  max_record_bytes: 64
+  flush_interval: 3600s
+  )EOF");
+
+  const std::string first = R"EOF(
+http_buffered_trace:
+  request:
+    headers:
+      - key: ":path"
+        value: "/first"
+)EOF";
+  const std::string second = R"EOF(
+http_buffered_trace:
+  request:
+    headers:
+      - key: ":path"
+        value: "/second"
+)EOF";
+  submit(first);
+  submit(fmt::format(R"EOF(
+http_buffered_trace:
+  request:
+    body:
+      as_bytes: {}
+)EOF",
+                     std::string(100, 'a')));
+  submit(second);
+  EXPECT_EQ(1, sink_->droppedRecords());
+
+  sink_.reset();
+  std::vector<envoy::data::tap::v3::TraceWrapper> traces = readTracesFromFile(path_);
+  ASSERT_EQ(2, traces.size());
+  EXPECT_THAT(traces[0], TraceEqual(first));
+  EXPECT_THAT(traces[1], TraceEqual(second));
+}
+
+// Verifies that the records beyond the capacity of the ring are dropped until the flush thread
+// drains it.
+TEST_F(RingBufferFileSinkTest, DropsRecordsWhenFull) {
+  initialize(R"EOF(
+  records_per_worker: 2
+  flush_interval: 3600s
+  )EOF");
+
+  const std::string trace = R"EOF(
+http_buffered_trace:
+  request:
+    headers:
+      - key: ":path"
+        value: "/"
+)EOF";
+  for (int i = 0; i < 3; i++) {
+    submit(trace);
+  }
+  EXPECT_EQ(1, sink_->droppedRecords());
+
+  sink_.reset();
+  EXPECT_EQ(2, readTracesFromFile(path_).size());
+}
+
+TEST_F(RingBufferFileSinkTest, UnableToOpenFile) {
+  envoy::config::tap::v3::RingBufferFileSink config;
+  config.set_path(TestEnvironment::temporaryPath("missing_directory/tap"));
+  EXPECT_THROW_WITH_REGEX(RingBufferFileSink(config, *api_), EnvoyException,
+                          "unable to open tap file");
+}
+
+} // namespace
+} // namespace Tap
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -7,6 +7,9 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/common/tap/tap_config_base.h"
 
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -160,6 +163,46 @@ TEST(TrimSlice, All) {
   }
 }
 
+class TestTapConfig : public TapConfigBaseImpl {
+public:
+  TestTapConfig(const envoy::config::tap::v3::TapConfig& proto_config, Api::Api& api)
+      : TapConfigBaseImpl(proto_config, nullptr, api) {}
+};
+
+// Verifies that the ring buffer file sink samples the traces by their ID, and only supports the
+// length delimited proto binary format.
+TEST(TapConfigBaseImpl, RingBufferFileSink) {
+  Api::ApiPtr api = Api::createApiForTest();
+  envoy::config::tap::v3::TapConfig proto_config;
+  TestUtility::loadFromYaml(fmt::format(R"EOF(
+match:
+  any_match: true
+output_config:
+  sinks:
+    - format: PROTO_BINARY_LENGTH_DELIMITED
+      ring_buffer_file:
+        path: {}
+)EOF",
+                                        TestEnvironment::temporaryPath("tap_config_base_ring")),
+                            proto_config);
+  EXPECT_TRUE(TestTapConfig(proto_config, *api).sampled(1));
+
+  auto& sink = *proto_config.mutable_output_config()->mutable_sinks(0);
+  sink.mutable_ring_buffer_file()->mutable_sample_rate()->set_numerator(25);
+  {
+    TestTapConfig config(proto_config, *api);
+    EXPECT_TRUE(config.sampled(0));
+    EXPECT_TRUE(config.sampled(124));
+    EXPECT_FALSE(config.sampled(25));
+    EXPECT_FALSE(config.sampled(199));
+  }
+
+  sink.set_format(envoy::config::tap::v3::OutputSink::JSON_BODY_AS_BYTES);
+  EXPECT_THROW_WITH_MESSAGE(
+      TestTapConfig(proto_config, *api), EnvoyException,
+      "ring buffer file output only supports the length delimited proto binary format");
+}
+
 } // namespace
 } // namespace Tap
 } // namespace Common
@@ -5,6 +5,7 @@
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
 
 #include "eval/public/cel_value.h"
 #include "gmock/gmock.h"
@@ -29,6 +30,8 @@ public:
     decoder_callbacks_ = cb;
   }
 
+  void setRequestHeadersPtr(Http::RequestHeaderMap* headers) { request_headers_ = headers; }
+
   void setAccessLogStreamInfoPtr(StreamInfo::StreamInfo* stream_info) {
     access_log_stream_info_ = stream_info;
   }
@@ -77,6 +80,25 @@ TEST_F(ContextTest, StubFunctionsTest) {
   EXPECT_EQ(ctx_.FindFunctionOverloads("function").size(), 0);
 }
 
+// setHeaderMapPairs replaces all the headers, including the pseudo headers and repeated ones.
+TEST_F(ContextTest, SetHeaderMapPairsTest) {
+  Http::TestRequestHeaderMapImpl headers{
+      {":path", "/"}, {"x-repeated", "a"}, {"x-repeated", "b"}, {"x-removed", "c"}};
+  ctx_.setRequestHeadersPtr(&headers);
+
+  const Pairs pairs{{":path", "/new"}, {"x-repeated", "d"}, {"X-Added", "e"}, {"x-added", "f"}};
+  EXPECT_EQ(WasmResult::Ok, ctx_.setHeaderMapPairs(WasmHeaderMapType::RequestHeaders, pairs));
+  EXPECT_EQ((Http::TestRequestHeaderMapImpl{
+                {":path", "/new"}, {"x-repeated", "d"}, {"x-added", "e"}, {"x-added", "f"}}),
+            headers);
+
+  Pairs result;
+  EXPECT_EQ(WasmResult::Ok, ctx_.getHeaderMapPairs(WasmHeaderMapType::RequestHeaders, &result));
+  EXPECT_EQ(4, result.size());
+  EXPECT_EQ(WasmResult::BadArgument,
+            ctx_.setHeaderMapPairs(WasmHeaderMapType::ResponseHeaders, pairs));
+}
+
 // getConstRequestStreamInfo and getRequestStreamInfo should return
 // the stream info from encoder_callbacks_, decoder_callbacks_,
 // access_log_stream_info_, network_read_filter_callbacks_, or
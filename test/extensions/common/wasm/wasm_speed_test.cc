@@ -63,6 +63,72 @@ void bmWasmSpeedTest(benchmark::State& state) {
 
 BENCHMARK(bmWasmSpeedTest);
 
+namespace {
+
+// A context of a stream whose request headers are the given ones.
+class HeaderContext : public Envoy::Extensions::Common::Wasm::Context {
+public:
+  explicit HeaderContext(Envoy::Http::RequestHeaderMap& headers) { request_headers_ = &headers; }
+};
+
+// Generates request headers with `num_headers` headers besides the pseudo headers.
+Envoy::Http::TestRequestHeaderMapImpl genRequestHeaders(int num_headers) {
+  Envoy::Http::TestRequestHeaderMapImpl headers{
+      {":authority", "www.example.com"}, {":method", "GET"}, {":path", "/api/resource"}};
+  for (int i = 0; i < num_headers; ++i) {
+    headers.addCopy(absl::StrCat("x-header-", i), absl::StrCat("value-", i));
+  }
+  return headers;
+}
+
+} // namespace
+
+/**
+ * Measure the host side of the header calls made by a plugin rewriting the request headers: it
+ * reads all the headers, then looks up, replaces, adds and removes a header.
+ */
+void bmWasmHeaderRewrite(benchmark::State& state) {
+  Envoy::Http::TestRequestHeaderMapImpl headers = genRequestHeaders(state.range(0));
+  HeaderContext context(headers);
+  const auto type = proxy_wasm::WasmHeaderMapType::RequestHeaders;
+
+  for (auto _ : state) { // NOLINT
+    proxy_wasm::Pairs pairs;
+    context.getHeaderMapPairs(type, &pairs);
+    benchmark::DoNotOptimize(pairs);
+    std::string_view value;
+    context.getHeaderMapValue(type, "x-header-0", &value);
+    context.replaceHeaderMapValue(type, "x-header-0", "rewritten");
+    context.addHeaderMapValue(type, "x-added", "added");
+    context.removeHeaderMapValue(type, "x-added");
+  }
+}
+
+BENCHMARK(bmWasmHeaderRewrite)->Arg(10)->Arg(50);
+
+/**
+ * Measure replacing all the request headers at once, as plugins setting the header map pairs do.
+ */
+void bmWasmSetHeaderMapPairs(benchmark::State& state) {
+  Envoy::Http::TestRequestHeaderMapImpl headers = genRequestHeaders(state.range(0));
+  HeaderContext context(headers);
+  const auto type = proxy_wasm::WasmHeaderMapType::RequestHeaders;
+
+  // The pairs must not refer to the headers they replace.
+  std::vector<std::pair<std::string, std::string>> storage;
+  headers.iterate([&storage](const Envoy::Http::HeaderEntry& header) {
+    storage.emplace_back(header.key().getStringView(), header.value().getStringView());
+    return Envoy::Http::HeaderMap::Iterate::Continue;
+  });
+  proxy_wasm::Pairs pairs(storage.begin(), storage.end());
+
+  for (auto _ : state) { // NOLINT
+    context.setHeaderMapPairs(type, pairs);
+  }
+}
+
+BENCHMARK(bmWasmSetHeaderMapPairs)->Arg(10)->Arg(50);
+
 } // namespace Envoy
 
 int main(int argc, char** argv) {
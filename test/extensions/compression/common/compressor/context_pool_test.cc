@@ -0,0 +1,124 @@
+#include "source/extensions/compression/common/compressor/context_pool.h"
+
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+namespace {
+
+using testing::NiceMock;
+
+struct TestContext {
+  int resets_{0};
+};
+
+class ContextPoolTest : public testing::Test {
+protected:
+  std::shared_ptr<ContextPool<TestContext>> makePool(uint32_t max_idle) {
+    return std::make_shared<ContextPool<TestContext>>(
+        max_idle,
+        [this](TestContext* context) {
+          freed_++;
+          delete context;
+        },
+        [this](TestContext* context) {
+          context->resets_++;
+          return reset_result_;
+        });
+  }
+
+  TestContext* createContext() {
+    created_++;
+    return new TestContext();
+  }
+
+  ContextPool<TestContext>::CreateCb create_{[this]() { return createContext(); }};
+  int created_{0};
+  int freed_{0};
+  bool reset_result_{true};
+};
+
+TEST_F(ContextPoolTest, ReusesReleasedContexts) {
+  auto pool = makePool(2);
+  TestContext* first = pool->get(create_).get();
+  EXPECT_EQ(1, created_);
+  EXPECT_EQ(1, pool->idleCount());
+
+  auto context = pool->get(create_);
+  EXPECT_EQ(first, context.get());
+  EXPECT_EQ(1, context->resets_);
+  EXPECT_EQ(1, created_);
+  EXPECT_EQ(0, pool->idleCount());
+}
+
+TEST_F(ContextPoolTest, FreesContextsReleasedWhilePoolIsFull) {
+  auto pool = makePool(1);
+  auto first = pool->get(create_);
+  auto second = pool->get(create_);
+  EXPECT_EQ(2, created_);
+
+  first.reset();
+  second.reset();
+  EXPECT_EQ(1, pool->idleCount());
+  EXPECT_EQ(1, freed_);
+
+  pool.reset();
+  EXPECT_EQ(2, freed_);
+}
+
+TEST_F(ContextPoolTest, FreesContextsThatFailToReset) {
+  auto pool = makePool(1);
+  reset_result_ = false;
+  pool->get(create_).reset();
+  EXPECT_EQ(0, pool->idleCount());
+  EXPECT_EQ(1, freed_);
+}
+
+TEST_F(ContextPoolTest, FreesContextsReleasedAfterThePool) {
+  auto pool = makePool(1);
+  auto context = pool->get(create_);
+  pool.reset();
+  EXPECT_EQ(0, freed_);
+
+  context.reset();
+  EXPECT_EQ(1, freed_);
+}
+
+TEST(ThreadLocalContextPoolTest, ReusesReleasedContexts) {
+  NiceMock<ThreadLocal::MockInstance> tls;
+  int freed = 0;
+  {
+    ThreadLocalContextPool<int> pool(
+        tls, 1,
+        [&freed](int* context) {
+          freed++;
+          delete context;
+        },
+        [](int* context) {
+          *context = 0;
+          return true;
+        });
+    auto context = pool.get([]() { return new int(0); });
+    *context = 1;
+    int* first = context.get();
+    context.reset();
+    EXPECT_EQ(1, pool.idleCount());
+
+    context = pool.get([]() { return new int(0); });
+    EXPECT_EQ(first, context.get());
+    EXPECT_EQ(0, *context);
+  }
+  EXPECT_EQ(1, freed);
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
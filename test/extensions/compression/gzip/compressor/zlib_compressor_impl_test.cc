@@ -3,6 +3,7 @@
 #include "source/extensions/compression/gzip/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "absl/container/fixed_array.h"
@@ -15,6 +16,8 @@ namespace Gzip {
 namespace Compressor {
 namespace {
 
+using testing::NiceMock;
+
 // Test helpers
 
 void expectValidFlushedBuffer(const Buffer::OwnedImpl& output_buffer) {
@@ -159,6 +162,22 @@ TEST_P(ZlibCompressorImplFactoryTest, CreateCompressorTest) {
   drainBuffer(buffer);
 }
 
+TEST(ZlibCompressorImplPoolTest, PooledStreamsAreReused) {
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  TestUtility::loadFromJson(R"EOF({"max_pooled_contexts": 1})EOF", gzip);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  GzipCompressorFactory factory(gzip, tls);
+
+  // The second compressor reuses the stream of the first one, which must be reset correctly.
+  for (int i = 0; i < 2; i++) {
+    Buffer::OwnedImpl buffer;
+    Envoy::Compression::Compressor::CompressorPtr compressor = factory.createCompressor();
+    TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+    compressor->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    expectValidFinishedBuffer(buffer, 4096);
+  }
+}
+
 // Exercises death by passing bad initialization params or by calling
 // compress before init.
 TEST_F(ZlibCompressorImplDeathTest, CompressorDeathTest) {
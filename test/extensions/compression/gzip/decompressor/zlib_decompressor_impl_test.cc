@@ -258,6 +258,51 @@ TEST_F(ZlibDecompressorImplTest, DecompressWithSmallOutputBuffer) {
   ASSERT_EQ(0, decompressor.decompression_error_);
 }
 
+// Exercises decompression in chunks of bounded size, fed a slice of the compressed data at a time.
+TEST_F(ZlibDecompressorImplTest, DecompressBounded) {
+  Buffer::OwnedImpl buffer;
+  Buffer::OwnedImpl accumulation_buffer;
+
+  Envoy::Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+  compressor.init(
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+      gzip_window_bits, memory_level);
+
+  std::string original_text{};
+  for (uint64_t i = 0; i < 20; ++i) {
+    TestUtility::feedBufferWithRandomCharacters(buffer, default_input_size * i, i);
+    original_text.append(buffer.toString());
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Flush);
+    accumulation_buffer.add(buffer);
+    drainBuffer(buffer);
+  }
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  accumulation_buffer.move(buffer);
+
+  ZlibDecompressorImpl decompressor{stats_scope_, "test.", 4096, 100};
+  decompressor.init(gzip_window_bits);
+
+  std::string decompressed_text{};
+  Buffer::OwnedImpl input_buffer;
+  while (accumulation_buffer.length() > 0) {
+    input_buffer.move(accumulation_buffer, 100);
+    bool more;
+    do {
+      more = decompressor.decompressBounded(input_buffer, buffer, 1000);
+      ASSERT_GE(1000, buffer.length());
+      ASSERT_EQ(more, buffer.length() == 1000);
+      decompressed_text.append(buffer.toString());
+      drainBuffer(buffer);
+    } while (more);
+    ASSERT_EQ(0, input_buffer.length());
+  }
+
+  ASSERT_EQ(compressor.checksum(), decompressor.checksum());
+  EXPECT_EQ(original_text, decompressed_text);
+  ASSERT_EQ(0, decompressor.decompression_error_);
+}
+
 // Exercises decompression with other supported zlib initialization params.
 TEST_F(ZlibDecompressorImplTest, CompressDecompressWithUncommonParams) {
   // Test with different memory levels.
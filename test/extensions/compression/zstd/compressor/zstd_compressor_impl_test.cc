@@ -105,6 +105,25 @@ TEST_F(ZstdCompressorImplTest, CompressWitHugeBuffer) {
   verifyWithDecompressor(std::move(compressor));
 }
 
+TEST_F(ZstdCompressorImplTest, PooledContextsAreReused) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+  TestUtility::loadFromJson(R"EOF({
+  "compression_level": 7,
+  "enable_checksum": true,
+  "max_pooled_contexts": 1
+})EOF",
+                            zstd);
+  Envoy::Compression::Compressor::CompressorFactoryPtr factory =
+      lib_factory.createCompressorFactoryFromProto(zstd, mock_context);
+
+  // The second compressor reuses the context of the first one, which must be reset correctly.
+  for (int i = 0; i < 2; i++) {
+    verifyWithDecompressor(factory->createCompressor());
+  }
+}
+
 TEST_F(ZstdCompressorImplTest, IllegalConfig) {
   envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
   Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
@@ -63,6 +63,49 @@ TEST_F(ZstdDecompressorImplTest, DecompressWithSmallOutputBuffer) {
   EXPECT_EQ(0, stats_store.counterFromString("test.zstd_generic_error").value());
 }
 
+// Exercises decompression in chunks of bounded size, fed a slice of the compressed data at a time.
+TEST_F(ZstdDecompressorImplTest, DecompressBounded) {
+  Buffer::OwnedImpl buffer;
+  Buffer::OwnedImpl accumulation_buffer;
+
+  Zstd::Compressor::ZstdCompressorImpl compressor{default_compression_level_,
+                                                  default_enable_checksum_, default_strategy_,
+                                                  default_cdict_manager_, 4096};
+
+  std::string original_text{};
+  for (uint64_t i = 0; i < 20; ++i) {
+    TestUtility::feedBufferWithRandomCharacters(buffer, default_input_size_ * i, i);
+    original_text.append(buffer.toString());
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Flush);
+    accumulation_buffer.add(buffer);
+    drainBuffer(buffer);
+  }
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  accumulation_buffer.move(buffer);
+
+  Stats::IsolatedStoreImpl stats_store{};
+  ZstdDecompressorImpl decompressor{*stats_store.rootScope(), "test.", default_ddict_manager_,
+                                    4096};
+
+  std::string decompressed_text{};
+  Buffer::OwnedImpl input_buffer;
+  while (accumulation_buffer.length() > 0) {
+    input_buffer.move(accumulation_buffer, 100);
+    bool more;
+    do {
+      more = decompressor.decompressBounded(input_buffer, buffer, 1000);
+      ASSERT_GE(1000, buffer.length());
+      ASSERT_EQ(more, buffer.length() == 1000);
+      decompressed_text.append(buffer.toString());
+      drainBuffer(buffer);
+    } while (more);
+    ASSERT_EQ(0, input_buffer.length());
+  }
+
+  EXPECT_EQ(original_text, decompressed_text);
+  EXPECT_EQ(0, stats_store.counterFromString("test.zstd_generic_error").value());
+}
+
 TEST_F(ZstdDecompressorImplTest, WrongInput) {
   Buffer::OwnedImpl buffer;
   Buffer::OwnedImpl output_buffer;
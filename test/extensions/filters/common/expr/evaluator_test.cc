@@ -1,5 +1,6 @@
 #include "source/extensions/filters/common/expr/evaluator.h"
 
+#include "test/mocks/stream_info/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "absl/time/time.h"
@@ -40,6 +41,49 @@ TEST(Evaluator, Print) {
   EXPECT_EQ(print(CelValue::CreateError(&status)), "CelError value");
 }
 
+// request.headers['x-tenant'] == tenant
+google::api::expr::v1alpha1::Expr tenantExpr(const std::string& tenant) {
+  return TestUtility::parseYaml<google::api::expr::v1alpha1::Expr>(fmt::format(R"EOF(
+call_expr:
+  function: _==_
+  args:
+  - call_expr:
+      function: _[_]
+      args:
+      - select_expr: {{ operand: {{ ident_expr: {{ name: request }} }}, field: headers }}
+      - const_expr: {{ string_value: x-tenant }}
+  - const_expr: {{ string_value: {} }}
+)EOF",
+                                                                               tenant));
+}
+
+// Verifies that identical expressions are only compiled once while they are in use.
+TEST(Evaluator, GetOrCreateExpression) {
+  ExpressionSharedPtr first = getOrCreateExpression(tenantExpr("a"));
+  ExpressionSharedPtr second = getOrCreateExpression(tenantExpr("a"));
+  ExpressionSharedPtr other = getOrCreateExpression(tenantExpr("b"));
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, other);
+
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  const Http::TestRequestHeaderMapImpl headers{{"x-tenant", "a"}};
+  EXPECT_TRUE(matches(*first, info, headers));
+  EXPECT_FALSE(matches(*other, info, headers));
+
+  // The expressions are compiled again once released.
+  first.reset();
+  second.reset();
+  other.reset();
+  ExpressionSharedPtr again = getOrCreateExpression(tenantExpr("a"));
+  EXPECT_TRUE(matches(*again, info, headers));
+}
+
+TEST(Evaluator, GetOrCreateInvalidExpression) {
+  google::api::expr::v1alpha1::Expr expr;
+  expr.mutable_call_expr()->set_function("undefined_function");
+  EXPECT_THROW(getOrCreateExpression(expr), CelException);
+}
+
 } // namespace
 } // namespace Expr
 } // namespace Common
@@ -0,0 +1,85 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "envoy/extensions/common/ratelimit/v3/ratelimit.pb.h"
+
+#include "source/extensions/filters/common/local_ratelimit/local_ratelimit_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace LocalRateLimit {
+namespace {
+
+// A limiter shared by all the benchmark threads, like the limiter of the HTTP filter is shared by
+// the workers. The buckets hold enough tokens for the requests to be allowed, so that every
+// iteration updates the buckets of the descriptor and of the limiter.
+class SharedRateLimiter {
+public:
+  explicit SharedRateLimiter(bool continuous_refill)
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        descriptors_(makeDescriptors()),
+        rate_limiter_(std::chrono::seconds(1), std::numeric_limits<uint32_t>::max(), 1000000000,
+                      *dispatcher_, descriptors_, continuous_refill) {}
+
+  bool requestAllowed() const { return rate_limiter_.requestAllowed(request_descriptors_); }
+
+private:
+  static Protobuf::RepeatedPtrField<
+      envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
+  makeDescriptors() {
+    Protobuf::RepeatedPtrField<envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
+        descriptors;
+    TestUtility::loadFromYaml(R"EOF(
+  entries:
+  - key: foo
+    value: bar
+  token_bucket:
+    max_tokens: 4000000000
+    tokens_per_fill: 1000000000
+    fill_interval: 1s
+  )EOF",
+                              *descriptors.Add());
+    return descriptors;
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  const Protobuf::RepeatedPtrField<
+      envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
+      descriptors_;
+  const std::vector<RateLimit::LocalDescriptor> request_descriptors_{{{{"foo", "bar"}}}};
+  const LocalRateLimiterImpl rate_limiter_;
+};
+
+template <bool continuous_refill> void bmRequestAllowed(benchmark::State& state) {
+  static const SharedRateLimiter rate_limiter(continuous_refill);
+  uint64_t allowed = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    allowed += rate_limiter.requestAllowed();
+  }
+  benchmark::DoNotOptimize(allowed);
+}
+
+// The buckets refilled by a fill timer.
+BENCHMARK_TEMPLATE(bmRequestAllowed, false)->ThreadRange(1, 16)->UseRealTime();
+// The buckets refilled continuously with GCRA.
+BENCHMARK_TEMPLATE(bmRequestAllowed, true)->ThreadRange(1, 16)->UseRealTime();
+
+} // namespace
+} // namespace LocalRateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
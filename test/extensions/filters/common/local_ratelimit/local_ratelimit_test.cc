@@ -1,6 +1,7 @@
 #include "source/extensions/filters/common/local_ratelimit/local_ratelimit_impl.h"
 
 #include "test/mocks/event/mocks.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -557,6 +558,126 @@ TEST_F(LocalRateLimiterDescriptorImplTest, TokenBucketDifferentDescriptorStatus)
   EXPECT_EQ(rate_limiter_->remainingFillInterval(descriptor_), 3);
 }
 
+class LocalRateLimiterContinuousRefillTest : public Event::TestUsingSimulatedTime,
+                                             public LocalRateLimiterDescriptorImplTest {
+public:
+  void initializeContinuousRefill(const std::chrono::milliseconds fill_interval,
+                                  const uint32_t max_tokens, const uint32_t tokens_per_fill) {
+    // The buckets are refilled without any timer.
+    EXPECT_CALL(dispatcher_, createTimer_(_)).Times(0);
+    rate_limiter_ = std::make_shared<LocalRateLimiterImpl>(
+        fill_interval, max_tokens, tokens_per_fill, dispatcher_, descriptors_, true);
+  }
+};
+
+// Verify that the tokens are refilled continuously, one per emission interval, up to max tokens.
+TEST_F(LocalRateLimiterContinuousRefillTest, TokenBucket) {
+  initializeContinuousRefill(std::chrono::milliseconds(200), 2, 1);
+
+  // 2 -> 0 tokens
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+
+  // 0 -> 0 tokens
+  simTime().advanceTimeWait(std::chrono::milliseconds(199));
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+
+  // 0 -> 1 -> 0 tokens
+  simTime().advanceTimeWait(std::chrono::milliseconds(1));
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+
+  // 0 -> 2 tokens, since the bucket is capped at max tokens.
+  simTime().advanceTimeWait(std::chrono::milliseconds(1000));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 2);
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+}
+
+// Verify that fill intervals below the 50ms of the fill timer are allowed.
+TEST_F(LocalRateLimiterContinuousRefillTest, FastFillRate) {
+  initializeContinuousRefill(std::chrono::milliseconds(10), 1, 10);
+
+  // A token per millisecond.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+  simTime().advanceTimeWait(std::chrono::milliseconds(1));
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+}
+
+// Verify max tokens, remaining tokens and remaining fill interval.
+TEST_F(LocalRateLimiterContinuousRefillTest, TokenBucketStatus) {
+  // A token every 3 seconds.
+  initializeContinuousRefill(std::chrono::milliseconds(6000), 2, 2);
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 2);
+  EXPECT_EQ(rate_limiter_->remainingFillInterval(route_descriptors_), 0);
+
+  // 2 -> 1 tokens
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_EQ(rate_limiter_->maxTokens(route_descriptors_), 2);
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 1);
+  EXPECT_EQ(rate_limiter_->remainingFillInterval(route_descriptors_), 3);
+
+  // 1 -> 0 tokens
+  simTime().advanceTimeWait(std::chrono::milliseconds(1000));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 1);
+  EXPECT_EQ(rate_limiter_->remainingFillInterval(route_descriptors_), 2);
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 0);
+  EXPECT_EQ(rate_limiter_->remainingFillInterval(route_descriptors_), 2);
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_));
+
+  // 0 -> 1 tokens
+  simTime().advanceTimeWait(std::chrono::milliseconds(2000));
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 1);
+  EXPECT_EQ(rate_limiter_->remainingFillInterval(route_descriptors_), 3);
+}
+
+// Verify that descriptors are refilled continuously too, with fill intervals that don't need to be
+// multiples of the one of the token bucket.
+TEST_F(LocalRateLimiterContinuousRefillTest, TokenBucketDescriptor) {
+  TestUtility::loadFromYaml(fmt::format(fmt::runtime(single_descriptor_config_yaml), 1, 1, "0.07s"),
+                            *descriptors_.Add());
+  initializeContinuousRefill(std::chrono::milliseconds(50), 10, 10);
+
+  // 1 -> 0 tokens for descriptor_
+  EXPECT_TRUE(rate_limiter_->requestAllowed(descriptor_));
+  EXPECT_FALSE(rate_limiter_->requestAllowed(descriptor_));
+  EXPECT_EQ(rate_limiter_->maxTokens(descriptor_), 1);
+  EXPECT_EQ(rate_limiter_->remainingTokens(descriptor_), 0);
+  // The global bucket is only consumed by the allowed request.
+  EXPECT_EQ(rate_limiter_->remainingTokens(route_descriptors_), 9);
+
+  // 0 -> 1 tokens for descriptor_
+  simTime().advanceTimeWait(std::chrono::milliseconds(70));
+  EXPECT_EQ(rate_limiter_->remainingTokens(descriptor_), 1);
+  EXPECT_TRUE(rate_limiter_->requestAllowed(descriptor_));
+}
+
+// Verify that a request racing with another one for the last token is limited.
+TEST_F(LocalRateLimiterContinuousRefillTest, CasEdgeCases) {
+  initializeContinuousRefill(std::chrono::milliseconds(1000), 1, 1);
+
+  synchronizer().enable();
+
+  // Start a thread checking a request. This will wait pre-CAS.
+  synchronizer().waitOn("continuous_refill_pre_cas");
+  std::thread t1([&] { EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_)); });
+  // Wait until the thread is actually waiting.
+  synchronizer().barrierOn("continuous_refill_pre_cas");
+
+  // This should succeed.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_));
+
+  // Now signal the thread to continue which should cause a CAS failure, and the retry to find the
+  // bucket empty.
+  synchronizer().signal("continuous_refill_pre_cas");
+  t1.join();
+}
+
 } // Namespace LocalRateLimit
 } // namespace Common
 } // namespace Filters
@@ -178,6 +178,82 @@ TEST_F(LuaTest, MarkDead) {
   lua_gc(cr1->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// Finished coroutines are reused, while failed and suspended ones are not.
+TEST_F(LuaTest, CoroutineReuse) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      object:testCall()
+    end
+
+    function yieldMe()
+      coroutine.yield()
+    end
+
+    function failMe()
+      error("failed")
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+  const int yield_me = state_->getGlobalRef(state_->registerGlobal("yieldMe", initializers_));
+  const int fail_me = state_->getGlobalRef(state_->registerGlobal("failMe", initializers_));
+
+  CoroutinePtr cr(state_->createCoroutine());
+  const Coroutine* first = cr.get();
+  LuaRef<TestObject> ref1(TestObject::create(cr->luaState()), true);
+  EXPECT_CALL(*ref1.get(), doTestCall(_));
+  cr->start(call_me, 1, yield_callback_);
+  state_->releaseCoroutine(std::move(cr));
+  EXPECT_EQ(1, state_->idleCoroutines());
+
+  // The coroutine is started again with a new object.
+  cr = state_->createCoroutine();
+  EXPECT_EQ(first, cr.get());
+  EXPECT_EQ(0, state_->idleCoroutines());
+  EXPECT_EQ(cr->state(), Coroutine::State::NotStarted);
+  LuaRef<TestObject> ref2(TestObject::create(cr->luaState()), true);
+  EXPECT_CALL(*ref2.get(), doTestCall(_));
+  cr->start(call_me, 1, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+
+  EXPECT_CALL(*ref1.get(), onDestroy());
+  EXPECT_CALL(*ref2.get(), onDestroy());
+  ref1.reset();
+  ref2.reset();
+  lua_gc(cr->luaState(), LUA_GCCOLLECT, 0);
+
+  EXPECT_THROW(cr->start(fail_me, 0, yield_callback_), LuaException);
+  state_->releaseCoroutine(std::move(cr));
+  EXPECT_EQ(0, state_->idleCoroutines());
+
+  cr = state_->createCoroutine();
+  EXPECT_CALL(on_yield_, ready());
+  cr->start(yield_me, 0, yield_callback_);
+  state_->releaseCoroutine(std::move(cr));
+  EXPECT_EQ(0, state_->idleCoroutines());
+}
+
+// The number of coroutines kept for reuse is bounded.
+TEST_F(LuaTest, CoroutineReuseLimit) {
+  const std::string SCRIPT{R"EOF(
+    function callMe()
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+  std::vector<CoroutinePtr> coroutines;
+  for (size_t i = 0; i < ThreadLocalState::MaxIdleCoroutines + 1; i++) {
+    coroutines.push_back(state_->createCoroutine());
+    coroutines.back()->start(call_me, 0, yield_callback_);
+  }
+  for (CoroutinePtr& coroutine : coroutines) {
+    state_->releaseCoroutine(std::move(coroutine));
+  }
+  EXPECT_EQ(ThreadLocalState::MaxIdleCoroutines, state_->idleCoroutines());
+}
+
 class ThreadSafeTest : public testing::Test {
 public:
   ThreadSafeTest()
@@ -92,6 +92,32 @@ TEST_F(LuaBufferWrapperTest, Methods) {
   start("callMe");
 }
 
+// getBytes() with ranges within a single slice and across slices.
+TEST_F(LuaBufferWrapperTest, GetBytesAcrossSlices) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      testPrint(object:getBytes(0, 5))
+      testPrint(object:getBytes(6, 5))
+      testPrint(object:getBytes(3, 5))
+      testPrint(object:getBytes(0, 11))
+      testPrint(object:getBytes(11, 0))
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  Buffer::OwnedImpl data;
+  data.appendSliceForTest("hello ");
+  data.appendSliceForTest("world");
+  Http::TestRequestHeaderMapImpl headers;
+  BufferWrapper::create(coroutine_->luaState(), headers, data);
+  EXPECT_CALL(printer_, testPrint("hello"));
+  EXPECT_CALL(printer_, testPrint("world"));
+  EXPECT_CALL(printer_, testPrint("lo wo"));
+  EXPECT_CALL(printer_, testPrint("hello world"));
+  EXPECT_CALL(printer_, testPrint(""));
+  start("callMe");
+}
+
 // Invalid params for the buffer wrapper getBytes() call.
 TEST_F(LuaBufferWrapperTest, GetBytesInvalidParams) {
   const std::string SCRIPT{R"EOF(
@@ -84,7 +84,7 @@ TEST_F(RateLimitGrpcClientTest, Basic) {
             }));
 
     client_.limit(request_callbacks_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
-                  stream_info_);
+                  stream_info_, 0);
 
     client_.onCreateInitialMetadata(headers);
     EXPECT_EQ(nullptr, headers.RequestId());
@@ -104,7 +104,7 @@ TEST_F(RateLimitGrpcClientTest, Basic) {
         .WillOnce(Return(&async_request_));
 
     client_.limit(request_callbacks_, "foo", {{{{"foo", "bar"}, {"bar", "baz"}}}},
-                  Tracing::NullSpan::instance(), stream_info_);
+                  Tracing::NullSpan::instance(), stream_info_, 0);
 
     client_.onCreateInitialMetadata(headers);
 
@@ -125,7 +125,7 @@ TEST_F(RateLimitGrpcClientTest, Basic) {
 
     client_.limit(request_callbacks_, "foo",
                   {{{{"foo", "bar"}, {"bar", "baz"}}}, {{{"foo2", "bar2"}, {"bar2", "baz2"}}}},
-                  Tracing::NullSpan::instance(), stream_info_);
+                  Tracing::NullSpan::instance(), stream_info_, 0);
 
     response = std::make_unique<envoy::service::ratelimit::v3::RateLimitResponse>();
     EXPECT_CALL(request_callbacks_, complete_(LimitStatus::Error, _, _, _, _, _));
@@ -144,7 +144,7 @@ TEST_F(RateLimitGrpcClientTest, Basic) {
     client_.limit(
         request_callbacks_, "foo",
         {{{{"foo", "bar"}, {"bar", "baz"}}, {{42, envoy::type::v3::RateLimitUnit::MINUTE}}}},
-        Tracing::NullSpan::instance(), stream_info_);
+        Tracing::NullSpan::instance(), stream_info_, 0);
 
     client_.onCreateInitialMetadata(headers);
 
@@ -162,7 +162,7 @@ TEST_F(RateLimitGrpcClientTest, Cancel) {
   EXPECT_CALL(*async_client_, sendRaw(_, _, _, _, _, _)).WillOnce(Return(&async_request_));
 
   client_.limit(request_callbacks_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
-                stream_info_);
+                stream_info_, 0);
 
   EXPECT_CALL(async_request_, cancel());
   client_.cancel();
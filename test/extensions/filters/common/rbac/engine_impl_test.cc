@@ -12,6 +12,7 @@
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/ssl/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -655,6 +656,127 @@ TEST(RoleBasedAccessControlMatcherEngineImpl, LogIfMatched) {
   checkMatcherEngine(engine, true, RBAC::LogResult::No, info, conn, headers);
 }
 
+// Policies covering the ways a policy can be indexed, and the ways it can't, with enough of them
+// for the engine to build a PolicyIndex.
+envoy::config::rbac::v3::RBAC indexedPolicies() {
+  envoy::config::rbac::v3::RBAC rbac;
+  TestUtility::loadFromYaml(R"EOF(
+action: ALLOW
+policies:
+  a-and:
+    permissions:
+    - and_rules:
+        rules:
+        - header: { name: x-tenant, string_match: { exact: tenant-05 } }
+        - header: { name: x-role, string_match: { exact: admin } }
+    principals: [ { any: true } ]
+  ignore-case:
+    permissions:
+    - header: { name: x-tenant, string_match: { exact: Tenant-50, ignore_case: true } }
+    principals: [ { any: true } ]
+  ip-a:
+    permissions: [ { any: true } ]
+    principals: [ { source_ip: { address_prefix: 10.0.0.0, prefix_len: 8 } } ]
+  ip-b:
+    permissions: [ { any: true } ]
+    principals:
+    - or_ids:
+        ids:
+        - remote_ip: { address_prefix: 10.1.0.0, prefix_len: 16 }
+        - remote_ip: { address_prefix: 10.2.0.0, prefix_len: 16 }
+  mixed-or:
+    permissions:
+    - or_rules:
+        rules:
+        - header: { name: x-tenant, string_match: { exact: tenant-40 } }
+        - header: { name: x-other, string_match: { prefix: a } }
+    principals: [ { any: true } ]
+  or-tenants:
+    permissions:
+    - header: { name: X-Tenant, exact_match: tenant-30 }
+    - header: { name: x-tenant, exact_match: tenant-31 }
+    principals: [ { any: true } ]
+  z-inverted:
+    permissions:
+    - header: { name: x-tenant, string_match: { exact: tenant-60 }, invert_match: true }
+    principals: [ { any: true } ]
+)EOF",
+                            rbac);
+  for (int i = 0; i < 20; i++) {
+    envoy::config::rbac::v3::Policy policy;
+    auto* header = policy.add_permissions()->mutable_header();
+    header->set_name("x-tenant");
+    header->mutable_string_match()->set_exact(fmt::format("tenant-{:02}", i));
+    policy.add_principals()->set_any(true);
+    (*rbac.mutable_policies())[fmt::format("header-{:02}", i)] = policy;
+  }
+  return rbac;
+}
+
+class PolicyIndexTest : public testing::TestWithParam<bool> {
+protected:
+  PolicyIndexTest() {
+    scoped_runtime_.mergeValues(
+        {{"envoy.reloadable_features.rbac_policy_index", GetParam() ? "true" : "false"}});
+  }
+
+  // Returns the effective policy of the request, or "" if no policy matches it.
+  std::string effectivePolicy(const Envoy::Http::TestRequestHeaderMapImpl& headers,
+                              const std::string& source = "192.168.0.1",
+                              const std::string& remote = "192.168.0.1") {
+    NiceMock<Envoy::Network::MockConnection> conn;
+    conn.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+        Envoy::Network::Utility::parseInternetAddress(source, 123, false));
+    NiceMock<StreamInfo::MockStreamInfo> info;
+    info.downstream_connection_info_provider_->setRemoteAddress(
+        Envoy::Network::Utility::parseInternetAddress(remote, 123, false));
+
+    std::string effective_policy_id;
+    if (!engine_.handleAction(conn, headers, info, &effective_policy_id)) {
+      return "";
+    }
+    return effective_policy_id;
+  }
+
+  TestScopedRuntime scoped_runtime_;
+  RBAC::RoleBasedAccessControlEngineImpl engine_{indexedPolicies(),
+                                                 ProtobufMessage::getStrictValidationVisitor()};
+};
+
+INSTANTIATE_TEST_SUITE_P(IndexEnabled, PolicyIndexTest, testing::Bool());
+
+// Verifies that the first matching policy by name is the effective one, whether or not the
+// policies are indexed.
+TEST_P(PolicyIndexTest, FirstMatchingPolicy) {
+  EXPECT_EQ("a-and", effectivePolicy({{"x-tenant", "tenant-05"}, {"x-role", "admin"}}));
+  EXPECT_EQ("header-05", effectivePolicy({{"x-tenant", "tenant-05"}}));
+  EXPECT_EQ("header-19", effectivePolicy({{"x-tenant", "tenant-19"}}));
+  EXPECT_EQ("or-tenants", effectivePolicy({{"x-tenant", "tenant-30"}}));
+  EXPECT_EQ("or-tenants", effectivePolicy({{"x-tenant", "tenant-31"}}));
+  EXPECT_EQ("mixed-or", effectivePolicy({{"x-tenant", "tenant-40"}}));
+  EXPECT_EQ("mixed-or", effectivePolicy({{"x-tenant", "tenant-60"}, {"x-other", "abc"}}));
+  EXPECT_EQ("ignore-case", effectivePolicy({{"x-tenant", "tenant-50"}}));
+  EXPECT_EQ("z-inverted", effectivePolicy({{"x-tenant", "tenant-99"}}));
+  EXPECT_EQ("", effectivePolicy({{"x-tenant", "tenant-60"}}));
+  EXPECT_EQ("", effectivePolicy({}));
+}
+
+// Verifies that policies requiring an address range match the connections in range.
+TEST_P(PolicyIndexTest, AddressRanges) {
+  const Envoy::Http::TestRequestHeaderMapImpl headers{{"x-tenant", "tenant-60"}};
+  EXPECT_EQ("ip-a", effectivePolicy(headers, "10.0.0.1"));
+  EXPECT_EQ("ip-a", effectivePolicy(headers, "10.1.0.1", "10.1.0.1"));
+  EXPECT_EQ("ip-b", effectivePolicy(headers, "192.168.0.1", "10.1.0.1"));
+  EXPECT_EQ("ip-b", effectivePolicy(headers, "192.168.0.1", "10.2.255.255"));
+  EXPECT_EQ("", effectivePolicy(headers, "192.168.0.1", "10.3.0.1"));
+  EXPECT_EQ("", effectivePolicy(headers, "::1", "::1"));
+}
+
+// Verifies that the values of a repeated header are matched joined, as by the header matchers.
+TEST_P(PolicyIndexTest, RepeatedHeader) {
+  EXPECT_EQ("z-inverted", effectivePolicy({{"x-tenant", "tenant-05"}, {"x-tenant", "tenant-05"}}));
+}
+
 } // namespace
 } // namespace RBAC
 } // namespace Common
@@ -0,0 +1,104 @@
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/network/utility.h"
+#include "source/extensions/filters/common/rbac/engine_impl.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+using testing::NiceMock;
+
+/**
+ * Generates `num_policies` policies as used to give tenants access to their services. Most
+ * policies allow a tenant, identified by a header, to use any method; every fourth policy allows
+ * a range of source addresses instead, and every tenth one is matched on a header prefix and
+ * can't be indexed:
+ * - tenant-0: x-tenant prefix "tenant-0/"
+ * - tenant-1: x-tenant: tenant-1
+ * - tenant-3: source_ip 10.0.3.0/24
+ * - ...
+ */
+envoy::config::rbac::v3::RBAC genPolicies(int num_policies) {
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+  for (int i = 0; i < num_policies; ++i) {
+    envoy::config::rbac::v3::Policy policy;
+    auto* permission = policy.add_permissions();
+    auto* principal = policy.add_principals();
+    if (i % 10 == 0) {
+      auto* header = permission->mutable_header();
+      header->set_name("x-tenant");
+      header->mutable_string_match()->set_prefix(absl::StrCat("tenant-", i, "/"));
+      principal->set_any(true);
+    } else if (i % 4 == 3) {
+      permission->set_any(true);
+      auto* range = principal->mutable_source_ip();
+      range->set_address_prefix(absl::StrCat("10.", i / 256, ".", i % 256, ".0"));
+      range->mutable_prefix_len()->set_value(24);
+    } else {
+      auto* header = permission->mutable_header();
+      header->set_name("x-tenant");
+      header->mutable_string_match()->set_exact(absl::StrCat("tenant-", i));
+      principal->set_any(true);
+    }
+    (*rbac.mutable_policies())[absl::StrCat("tenant-", i)] = policy;
+  }
+  return rbac;
+}
+
+/**
+ * Measure the speed of evaluating requests against engines of varying sizes, with and without the
+ * policy index. Requests are spread over the policies, so that the cost of matching early and late
+ * policies is averaged.
+ */
+static void bmLargePolicySet(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.rbac_policy_index", state.range(1) ? "true" : "false"}});
+
+  const int num_policies = state.range(0);
+  RoleBasedAccessControlEngineImpl engine(genPolicies(num_policies),
+                                          ProtobufMessage::getNullValidationVisitor());
+
+  NiceMock<Network::MockConnection> connection;
+  connection.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+      Network::Utility::parseInternetAddress("192.168.0.1", 123, false));
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  std::vector<Http::TestRequestHeaderMapImpl> requests;
+  for (int i = 1; i < num_policies; i += std::max(1, num_policies / 16)) {
+    // Skip the policies which aren't matched on an exact header.
+    if (i % 10 == 0 || i % 4 == 3) {
+      continue;
+    }
+    requests.push_back({{"x-tenant", absl::StrCat("tenant-", i)}});
+  }
+
+  size_t request_num = 0;
+  for (auto _ : state) { // NOLINT
+    const bool allowed =
+        engine.handleAction(connection, requests[request_num++ % requests.size()], info, nullptr);
+    RELEASE_ASSERT(allowed, "request did not match a policy");
+  }
+}
+
+BENCHMARK(bmLargePolicySet)->ArgsProduct({{20, 200, 2000}, {0, 1}});
+
+} // namespace
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -6,6 +6,7 @@
 #include "source/extensions/filters/http/adaptive_concurrency/adaptive_concurrency_filter.h"
 #include "source/extensions/filters/http/adaptive_concurrency/controller/controller.h"
 
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
 #include "test/test_common/simulated_time_system.h"
@@ -245,6 +246,31 @@ TEST_F(AdaptiveConcurrencyFilterTest, DecodeHeadersTestForwarding) {
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
+// Verify that the requests to a route with a controller of its own are controlled by it.
+TEST_F(AdaptiveConcurrencyFilterTest, RouteController) {
+  NiceMock<Event::MockDispatcher> main_thread_dispatcher;
+  auto route_controller = std::make_shared<MockConcurrencyController>();
+  auto route_config =
+      std::make_unique<AdaptiveConcurrencyRouteConfig>(route_controller, main_thread_dispatcher);
+  ON_CALL(decoder_callbacks_, mostSpecificPerFilterConfig())
+      .WillByDefault(Return(route_config.get()));
+  Http::TestRequestHeaderMapImpl request_headers;
+
+  EXPECT_CALL(*controller_, forwardingDecision()).Times(0);
+  EXPECT_CALL(*route_controller, forwardingDecision())
+      .WillOnce(Return(RequestForwardingAction::Forward));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+
+  EXPECT_CALL(*controller_, recordLatencySample(_)).Times(0);
+  EXPECT_CALL(*route_controller, recordLatencySample(_));
+  filter_->encodeComplete();
+
+  // The controller of a route configuration released by a worker is released on the main thread.
+  EXPECT_CALL(main_thread_dispatcher, isThreadSafe()).WillOnce(Return(false));
+  EXPECT_CALL(main_thread_dispatcher, post(_));
+  route_config.reset();
+}
+
 TEST_F(AdaptiveConcurrencyFilterTest, DecodeHeadersTestBlock) {
   Http::TestRequestHeaderMapImpl request_headers;
 
@@ -142,6 +142,32 @@ min_rtt_calc_params:
   EXPECT_EQ(config.minConcurrency(), 8);
 }
 
+TEST_F(GradientControllerConfigTest, ContinuousMinRTT) {
+  const std::string yaml = R"EOF(
+concurrency_limit_params:
+  concurrency_update_interval: 0.1s
+min_rtt_calc_params:
+  interval: 30s
+  continuous_percentile:
+    value: 5
+)EOF";
+
+  auto config = makeConfig(yaml, runtime_);
+  EXPECT_TRUE(config.continuousMinRTT());
+  EXPECT_EQ(config.continuousMinRTTPercentile(), .05);
+
+  EXPECT_CALL(runtime_.snapshot_, getDouble(_, 5)).WillOnce(Return(10));
+  EXPECT_EQ(config.continuousMinRTTPercentile(), .1);
+
+  const std::string default_yaml = R"EOF(
+concurrency_limit_params:
+  concurrency_update_interval: 0.1s
+min_rtt_calc_params:
+  interval: 30s
+)EOF";
+  EXPECT_FALSE(makeConfig(default_yaml, runtime_).continuousMinRTT());
+}
+
 TEST_F(GradientControllerConfigTest, Clamping) {
   const std::string yaml = R"EOF(
 sample_aggregate_percentile:
@@ -844,6 +870,99 @@ min_rtt_calc_params:
   EXPECT_FALSE(controller->inMinRTTSamplingWindow());
 }
 
+// Verify that the latency samples recorded without locking yield the quantiles of a histogram
+// they are inserted in directly.
+TEST(LatencySampleBinsTest, SameQuantilesAsHistogram) {
+  LatencySampleBins bins;
+  std::unique_ptr<histogram_t, decltype(&hist_free)> hist(hist_fast_alloc(), hist_free);
+  std::unique_ptr<histogram_t, decltype(&hist_free)> drained(hist_fast_alloc(), hist_free);
+  for (const int64_t latency_us : {0, 1, 9, 10, 15, 99, 100, 1337, 1337, 99999, 12345678}) {
+    bins.insert(std::chrono::microseconds(latency_us));
+    hist_insert(hist.get(), latency_us, 1);
+  }
+  EXPECT_EQ(11, bins.sampleCount());
+
+  bins.drainInto(drained.get());
+  EXPECT_EQ(0, bins.sampleCount());
+  EXPECT_EQ(11, hist_sample_count(drained.get()));
+
+  const std::array<double, 7> quantiles{0, 0.1, 0.25, 0.5, 0.75, 0.9, 1};
+  std::array<double, 7> expected;
+  std::array<double, 7> actual;
+  hist_approx_quantile(hist.get(), quantiles.data(), quantiles.size(), expected.data());
+  hist_approx_quantile(drained.get(), quantiles.data(), quantiles.size(), actual.data());
+  for (size_t i = 0; i < quantiles.size(); ++i) {
+    EXPECT_DOUBLE_EQ(expected[i], actual[i]);
+  }
+
+  // Latencies too large for the bins are still counted.
+  bins.insert(std::chrono::hours(24 * 365 * 100));
+  bins.insert(std::chrono::microseconds(42));
+  EXPECT_EQ(2, bins.sampleCount());
+  bins.clear();
+  EXPECT_EQ(0, bins.sampleCount());
+}
+
+TEST_F(GradientControllerTest, ContinuousMinRTT) {
+  const std::string yaml = R"EOF(
+sample_aggregate_percentile:
+  value: 50
+concurrency_limit_params:
+  max_concurrency_limit:
+  concurrency_update_interval: 0.1s
+min_rtt_calc_params:
+  jitter:
+    value: 0.0
+  interval: 30s
+  request_count: 50
+  continuous_percentile:
+    value: 10
+)EOF";
+
+  auto controller = makeController(yaml);
+  const auto sample_window = [this, &controller](std::vector<std::chrono::milliseconds> latencies) {
+    for (const auto latency : latencies) {
+      tryForward(controller, true);
+      sampleLatency(controller, latency);
+    }
+    time_system_.advanceTimeAndRun(std::chrono::milliseconds(101), *dispatcher_,
+                                   Event::Dispatcher::RunType::Block);
+  };
+
+  // There is no minRTT calculation window pinning the concurrency limit.
+  EXPECT_FALSE(controller->inMinRTTSamplingWindow());
+  verifyMinRTTInactive();
+  EXPECT_EQ(3, controller->concurrencyLimit());
+
+  // The minRTT is estimated from the low percentile of the first samples.
+  sample_window({std::chrono::milliseconds(2), std::chrono::milliseconds(2),
+                 std::chrono::milliseconds(10), std::chrono::milliseconds(10),
+                 std::chrono::milliseconds(10), std::chrono::milliseconds(10),
+                 std::chrono::milliseconds(10), std::chrono::milliseconds(10),
+                 std::chrono::milliseconds(10), std::chrono::milliseconds(10)});
+  verifyMinRTTValue(std::chrono::milliseconds(2));
+
+  // The minRTT follows lower estimates, but not higher ones until the minRTT interval elapses.
+  sample_window(std::vector<std::chrono::milliseconds>(5, std::chrono::milliseconds(1)));
+  verifyMinRTTValue(std::chrono::milliseconds(1));
+  sample_window(std::vector<std::chrono::milliseconds>(5, std::chrono::milliseconds(4)));
+  verifyMinRTTValue(std::chrono::milliseconds(1));
+
+  time_system_.advanceTimeAndRun(std::chrono::seconds(30), *dispatcher_,
+                                 Event::Dispatcher::RunType::Block);
+  sample_window(std::vector<std::chrono::milliseconds>(5, std::chrono::milliseconds(4)));
+  verifyMinRTTValue(std::chrono::milliseconds(4));
+  verifyMinRTTInactive();
+
+  // Steady latencies let the concurrency limit grow without ever measuring at min_concurrency.
+  for (int recalcs = 0; recalcs < 5; ++recalcs) {
+    const auto last_concurrency = controller->concurrencyLimit();
+    sample_window(std::vector<std::chrono::milliseconds>(5, std::chrono::milliseconds(4)));
+    EXPECT_GT(controller->concurrencyLimit(), last_concurrency);
+    EXPECT_FALSE(controller->inMinRTTSamplingWindow());
+  }
+}
+
 } // namespace
 } // namespace Controller
 } // namespace AdaptiveConcurrency
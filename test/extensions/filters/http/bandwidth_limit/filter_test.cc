@@ -3,6 +3,7 @@
 #include "source/extensions/filters/http/bandwidth_limit/bandwidth_limit.h"
 
 #include "test/mocks/http/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -22,11 +23,11 @@ class FilterTest : public testing::Test {
 public:
   FilterTest() = default;
 
-  void setup(const std::string& yaml) {
+  void setup(const std::string& yaml, ThreadLocal::SlotAllocator* tls = nullptr) {
     envoy::extensions::filters::http::bandwidth_limit::v3::BandwidthLimit config;
     TestUtility::loadFromYaml(yaml, config);
-    config_ =
-        std::make_shared<FilterConfig>(config, *stats_.rootScope(), runtime_, time_system_, true);
+    config_ = std::make_shared<FilterConfig>(config, *stats_.rootScope(), runtime_, time_system_,
+                                             true, tls);
     filter_ = std::make_shared<BandwidthLimiter>(config_);
     filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
     filter_->setEncoderFilterCallbacks(encoder_filter_callbacks_);
@@ -284,7 +285,7 @@ TEST_F(FilterTest, LimitOnEncode) {
   EXPECT_CALL(encoder_filter_callbacks_,
               injectEncodedDataToFilterChain(BufferStringEqual(std::string(51, 'a')), false));
   token_timer->invokeCallback();
-  EXPECT_EQ(2, findCounter("test.http_bandwidth_limit.response_enforced"));
+  EXPECT_EQ(3, findCounter("test.http_bandwidth_limit.response_enforced"));
   EXPECT_EQ(51, findGauge("test.http_bandwidth_limit.response_allowed_size"));
   EXPECT_EQ(1080, findCounter("test.http_bandwidth_limit.response_allowed_total_size"));
 
@@ -628,6 +629,150 @@ TEST_F(FilterTest, WithTrailersNoEndStream) {
   EXPECT_EQ("50", response_trailers_.get_("bandwidth-response-filter-delay-ms"));
 }
 
+// The streams of a connection share the bucket of its limit.
+TEST_F(FilterTest, ConnectionLimit) {
+  const std::string config_yaml = R"(
+  stat_prefix: test
+  runtime_enabled:
+    default_value: true
+    runtime_key: foo_key
+  enable_mode: RESPONSE
+  limit_kbps: 10
+  connection_limit_kbps: 1
+  )";
+  setup(config_yaml);
+  EXPECT_EQ(1UL, config_->connectionLimit());
+
+  auto filter2 = std::make_shared<BandwidthLimiter>(config_);
+  filter2->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  filter2->setEncoderFilterCallbacks(encoder_filter_callbacks_);
+  ON_CALL(encoder_filter_callbacks_, encoderBufferLimit()).WillByDefault(Return(1100));
+
+  Event::MockTimer* token_timer =
+      new NiceMock<Event::MockTimer>(&encoder_filter_callbacks_.dispatcher_);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+  Event::MockTimer* token_timer2 =
+      new NiceMock<Event::MockTimer>(&encoder_filter_callbacks_.dispatcher_);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter2->encodeHeaders(response_headers_, false));
+
+  // The first stream takes the fill interval worth of tokens of the connection.
+  Buffer::OwnedImpl data1(std::string(100, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data1, false));
+  EXPECT_CALL(*token_timer, enableTimer(std::chrono::milliseconds(50), _));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(std::string(51, 'a')), false));
+  token_timer->invokeCallback();
+
+  // The second stream waits for the connection's bucket to refill, even though the filter's one
+  // isn't empty.
+  Buffer::OwnedImpl data2(std::string(100, 'b'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter2->encodeData(data2, false));
+  EXPECT_CALL(*token_timer2, enableTimer(std::chrono::milliseconds(50), _));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(""), false));
+  token_timer2->invokeCallback();
+
+  time_system_.advanceTimeWait(std::chrono::milliseconds(50));
+  EXPECT_CALL(*token_timer2, enableTimer(std::chrono::milliseconds(50), _));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(std::string(51, 'b')), false));
+  token_timer2->invokeCallback();
+  EXPECT_EQ(3, findCounter("test.http_bandwidth_limit.response_enforced"));
+
+  filter_->onDestroy();
+  filter2->onDestroy();
+}
+
+// A route enforcing the filter limit is limited by the smaller of the two.
+TEST_F(FilterTest, EnforceFilterLimit) {
+  const std::string config_yaml = R"(
+  stat_prefix: test
+  limit_kbps: 1
+  )";
+  setup(config_yaml);
+
+  const std::string route_config_yaml = R"(
+  stat_prefix: route
+  runtime_enabled:
+    default_value: true
+    runtime_key: foo_key
+  enable_mode: RESPONSE
+  limit_kbps: 10
+  enforce_filter_limit: true
+  )";
+  envoy::extensions::filters::http::bandwidth_limit::v3::BandwidthLimit route_proto_config;
+  TestUtility::loadFromYaml(route_config_yaml, route_proto_config);
+  const auto route_config = std::make_shared<FilterConfig>(
+      route_proto_config, *stats_.rootScope(), runtime_, time_system_, true);
+  ON_CALL(decoder_filter_callbacks_, mostSpecificPerFilterConfig())
+      .WillByDefault(Return(route_config.get()));
+  ON_CALL(encoder_filter_callbacks_, encoderBufferLimit()).WillByDefault(Return(1100));
+
+  Event::MockTimer* token_timer =
+      new NiceMock<Event::MockTimer>(&encoder_filter_callbacks_.dispatcher_);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+  EXPECT_EQ(1U, findCounter("route.http_bandwidth_limit.response_enabled"));
+
+  Buffer::OwnedImpl data(std::string(100, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data, false));
+  EXPECT_CALL(*token_timer, enableTimer(std::chrono::milliseconds(50), _));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(std::string(51, 'a')), false));
+  token_timer->invokeCallback();
+
+  time_system_.advanceTimeWait(std::chrono::milliseconds(50));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(std::string(49, 'a')), false));
+  token_timer->invokeCallback();
+  EXPECT_EQ(1, findCounter("route.http_bandwidth_limit.response_enforced"));
+
+  filter_->onDestroy();
+}
+
+// With a thread local scheduler, the limiters are serviced by the timers of the worker instead of
+// timers of their own.
+TEST_F(FilterTest, Scheduler) {
+  const std::string config_yaml = R"(
+  stat_prefix: test
+  runtime_enabled:
+    default_value: true
+    runtime_key: foo_key
+  enable_mode: RESPONSE
+  limit_kbps: 1
+  )";
+  NiceMock<ThreadLocal::MockInstance> tls;
+  // The scheduler creates its ready timer first.
+  Event::MockTimer* round_timer = new NiceMock<Event::MockTimer>(&tls.dispatcher_);
+  Event::MockTimer* ready_timer = new NiceMock<Event::MockTimer>(&tls.dispatcher_);
+  setup(config_yaml, &tls);
+  ASSERT_NE(nullptr, config_->scheduler());
+  ON_CALL(encoder_filter_callbacks_, encoderBufferLimit()).WillByDefault(Return(1100));
+
+  EXPECT_CALL(encoder_filter_callbacks_.dispatcher_, createTimer_(_)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+
+  Buffer::OwnedImpl data(std::string(100, 'a'));
+  EXPECT_CALL(*ready_timer, enableTimer(std::chrono::milliseconds(0), _));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data, false));
+  EXPECT_EQ(1U, config_->scheduler()->scheduledLimiters());
+
+  EXPECT_CALL(*round_timer, enableTimer(std::chrono::milliseconds(50), _));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(std::string(51, 'a')), false));
+  ready_timer->invokeCallback();
+
+  time_system_.advanceTimeWait(std::chrono::milliseconds(50));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(std::string(49, 'a')), false));
+  round_timer->invokeCallback();
+  EXPECT_EQ(0U, config_->scheduler()->scheduledLimiters());
+
+  filter_->onDestroy();
+  // The slot of the config must not outlive the thread local instance.
+  filter_.reset();
+  config_.reset();
+}
+
 } // namespace BandwidthLimitFilter
 } // namespace HttpFilters
 } // namespace Extensions
@@ -769,6 +769,109 @@ TEST_F(CacheFilterTest, FilterDeletedBeforePostedCallbackExecuted) {
   }
 }
 
+TEST_F(CacheFilterTest, CollapsedRequestWaitsForFill) {
+  request_headers_.setHost("CollapsedRequestWaitsForFill");
+  config_.mutable_collapsed_request_timeout()->set_seconds(10);
+
+  // Request 1 misses and fills the cache.
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(filler);
+
+  // Request 2 misses too, but waits for request 1 instead of going upstream.
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_);
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_).Times(0);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  // Once request 1's response is inserted, request 2 is served from cache.
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_(IsSupersetOfHeaders(response_headers_), true));
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_EQ(filler->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  waiter->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheHit));
+  filler->onDestroy();
+  waiter->onDestroy();
+}
+
+TEST_F(CacheFilterTest, CollapsedRequestMissesAgainAfterUncacheableFill) {
+  request_headers_.setHost("CollapsedRequestMissesAgainAfterUncacheableFill");
+  config_.mutable_collapsed_request_timeout()->set_seconds(10);
+  response_headers_.setReferenceKey(Http::CustomHeaders::get().CacheControl, "no-store");
+
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(filler);
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // Request 1's response isn't cacheable, so request 2 goes upstream after looking up again.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding);
+  EXPECT_EQ(filler->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  EXPECT_EQ(waiter->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  waiter->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheMiss));
+  filler->onDestroy();
+  waiter->onDestroy();
+}
+
+TEST_F(CacheFilterTest, CollapsedRequestTimesOut) {
+  request_headers_.setHost("CollapsedRequestTimesOut");
+  config_.mutable_collapsed_request_timeout()->set_seconds(10);
+
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(filler);
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // Request 2 gives up waiting and goes upstream.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding);
+  time_source_.advanceTimeAndRun(std::chrono::seconds(10), *dispatcher_,
+                                 Event::Dispatcher::RunType::NonBlock);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  // Completing the fill afterwards doesn't wake request 2 up again.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_).Times(0);
+  EXPECT_EQ(filler->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  filler->onDestroy();
+  waiter->onDestroy();
+}
+
+TEST_F(CacheFilterTest, DestroyedFillerWakesUpCollapsedRequest) {
+  request_headers_.setHost("DestroyedFillerWakesUpCollapsedRequest");
+  config_.mutable_collapsed_request_timeout()->set_seconds(10);
+
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(filler);
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // Request 1 is reset before its response arrives, so request 2 goes upstream.
+  EXPECT_CALL(decoder_callbacks_, continueDecoding);
+  filler->onDestroy();
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+
+  waiter->onDestroy();
+}
+
 TEST_F(CacheFilterTest, LocalReplyDuringLookup) {
   request_headers_.setHost("LocalReplyDuringLookup");
   {
@@ -648,6 +648,52 @@ TEST(CreateVaryIdentifier, IsStableForAllowListOrder) {
   EXPECT_EQ(vary_identifier1.value(), vary_identifier2.value());
 }
 
+TEST(CreateVaryIdentifier, IsStableForEquivalentAcceptEncodings) {
+  VaryAllowList vary_allow_list(toStringMatchers({"accept-encoding"}));
+
+  Http::TestRequestHeaderMapImpl request_headers1{{"accept-encoding", "gzip, br;q=0.5"}};
+  Http::TestRequestHeaderMapImpl request_headers2{{"accept-encoding", "BR; q=0.50,gzip;q=1"}};
+  Http::TestRequestHeaderMapImpl request_headers3{{"accept-encoding", "br;q=0.5"},
+                                                  {"accept-encoding", "gzip"}};
+
+  absl::optional<std::string> vary_identifier1 =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"}, request_headers1);
+  absl::optional<std::string> vary_identifier2 =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"}, request_headers2);
+  absl::optional<std::string> vary_identifier3 =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"}, request_headers3);
+
+  ASSERT_TRUE(vary_identifier1.has_value());
+  EXPECT_EQ(vary_identifier1, vary_identifier2);
+  EXPECT_EQ(vary_identifier1, vary_identifier3);
+}
+
+TEST(CreateVaryIdentifier, DistinguishesDifferentAcceptEncodings) {
+  VaryAllowList vary_allow_list(toStringMatchers({"accept-encoding"}));
+
+  Http::TestRequestHeaderMapImpl request_headers1{{"accept-encoding", "gzip, br"}};
+  Http::TestRequestHeaderMapImpl request_headers2{{"accept-encoding", "gzip, br;q=0"}};
+
+  absl::optional<std::string> vary_identifier1 =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"}, request_headers1);
+  absl::optional<std::string> vary_identifier2 =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"}, request_headers2);
+
+  ASSERT_TRUE(vary_identifier1.has_value());
+  EXPECT_NE(vary_identifier1, vary_identifier2);
+}
+
+TEST(CanonicalizeAcceptEncoding, Canonicalizes) {
+  EXPECT_EQ(VaryHeaderUtils::canonicalizeAcceptEncoding(""), "");
+  EXPECT_EQ(VaryHeaderUtils::canonicalizeAcceptEncoding("gzip"), "gzip");
+  EXPECT_EQ(VaryHeaderUtils::canonicalizeAcceptEncoding(" gzip , deflate,br "), "br,deflate,gzip");
+  EXPECT_EQ(VaryHeaderUtils::canonicalizeAcceptEncoding("GZip;Q=1"), "gzip");
+  EXPECT_EQ(VaryHeaderUtils::canonicalizeAcceptEncoding("gzip;q=0.500, br;q=0"),
+            "br;q=0,gzip;q=0.5");
+  EXPECT_EQ(VaryHeaderUtils::canonicalizeAcceptEncoding("gzip,,gzip"), "gzip");
+  EXPECT_EQ(VaryHeaderUtils::canonicalizeAcceptEncoding("*;q=bad"), "*;q=bad");
+}
+
 TEST(GetVaryValues, noVary) {
   Http::TestResponseHeaderMapImpl headers;
   EXPECT_EQ(0, VaryHeaderUtils::getVaryValues(headers).size());
@@ -286,6 +286,26 @@ TEST_P(HttpCacheImplementationTest, PutGet) {
   EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(lookup(request_path1).get(), new_body1));
 }
 
+// Ranges are read directly, in any order, without reading the body before them.
+TEST_P(HttpCacheImplementationTest, GetBodyRanges) {
+  const std::string request_path("/name");
+  Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"},
+      {"date", formatter_.fromTime(time_system_.systemTime())},
+      {"cache-control", "public,max-age=3600"}};
+  const std::string body("0123456789abcdefghijklmnopqrstuvwxyz");
+  ASSERT_THAT(insert(lookup(request_path), response_headers, body), IsOk());
+
+  LookupContextPtr name_lookup = lookup(request_path);
+  ASSERT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_);
+  ASSERT_EQ(body.size(), lookup_result_.content_length_);
+  EXPECT_EQ("uvwxyz", getBody(*name_lookup, 30, 36));
+  EXPECT_EQ("abc", getBody(*name_lookup, 10, 13));
+  EXPECT_EQ("9", getBody(*name_lookup, 9, 10));
+  EXPECT_EQ(body, getBody(*name_lookup, 0, body.size()));
+  name_lookup->onDestroy();
+}
+
 TEST_P(HttpCacheImplementationTest, PrivateResponse) {
   Http::TestResponseHeaderMapImpl response_headers{
       {":status", "200"},
@@ -2,6 +2,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/common/token_bucket_impl.h"
 #include "source/extensions/filters/http/common/stream_rate_limiter.h"
 
 #include "test/common/http/common.h"
@@ -12,6 +13,7 @@
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -146,6 +148,58 @@ TEST_F(StreamRateLimiterTest, RateLimitOnSingleStream) {
   EXPECT_EQ(limiter_->destroyed(), true);
 }
 
+// Streams sharing a token bucket are serviced in rounds by the scheduler of the worker, taking turns
+// to consume first.
+TEST_F(StreamRateLimiterTest, SchedulerRounds) {
+  EXPECT_CALL(decoder_callbacks_.dispatcher_, pushTrackedObject(_)).Times(AnyNumber());
+  EXPECT_CALL(decoder_callbacks_.dispatcher_, popTrackedObject(_)).Times(AnyNumber());
+  // The timers are handed out in reverse order of their creation.
+  Event::MockTimer* round_timer = new NiceMock<Event::MockTimer>(&decoder_callbacks_.dispatcher_);
+  Event::MockTimer* ready_timer = new NiceMock<Event::MockTimer>(&decoder_callbacks_.dispatcher_);
+  StreamRateLimiterScheduler scheduler(decoder_callbacks_.dispatcher_,
+                                       std::chrono::milliseconds(50));
+  auto token_bucket = std::make_shared<AtomicTokenBucketImpl>(1024, time_system_, 1024);
+
+  std::vector<std::string> writes;
+  auto make_limiter = [&](const std::string& name) {
+    return std::make_unique<StreamRateLimiter>(
+        1, 10000, [] {}, [] {},
+        [&writes, name](Buffer::Instance& data, bool) {
+          writes.push_back(absl::StrCat(name, data.length()));
+        },
+        [] {}, [](uint64_t, bool, std::chrono::milliseconds) {}, time_system_,
+        decoder_callbacks_.dispatcher_, decoder_callbacks_.scope(), token_bucket,
+        std::chrono::milliseconds(50), &scheduler);
+  };
+  std::unique_ptr<StreamRateLimiter> limiter_a = make_limiter("a");
+  std::unique_ptr<StreamRateLimiter> limiter_b = make_limiter("b");
+
+  // The bucket is reset to a fill interval worth of tokens, 51, which the first stream takes.
+  Buffer::OwnedImpl data_a(std::string(200, 'a'));
+  limiter_a->writeData(data_a, false);
+  Buffer::OwnedImpl data_b(std::string(200, 'b'));
+  limiter_b->writeData(data_b, false);
+  EXPECT_EQ(2, scheduler.scheduledLimiters());
+  ready_timer->invokeCallback();
+  EXPECT_EQ((std::vector<std::string>{"a51", "b0"}), writes);
+  EXPECT_TRUE(round_timer->enabled());
+
+  time_system_.advanceTimeWait(std::chrono::milliseconds(50));
+  round_timer->invokeCallback();
+  EXPECT_EQ((std::vector<std::string>{"a51", "b0", "a51", "b0"}), writes);
+
+  // The next round starts with the other stream.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(50));
+  round_timer->invokeCallback();
+  EXPECT_EQ((std::vector<std::string>{"a51", "b0", "a51", "b0", "b51", "a0"}), writes);
+  EXPECT_TRUE(round_timer->enabled());
+
+  limiter_a->destroy();
+  EXPECT_EQ(1, scheduler.scheduledLimiters());
+  limiter_b.reset();
+  EXPECT_EQ(0, scheduler.scheduledLimiters());
+}
+
 } // namespace Common
 } // namespace HttpFilters
 } // namespace Extensions
@@ -6,6 +6,7 @@
 
 #include "test/mocks/buffer/mocks.h"
 #include "test/mocks/compression/decompressor/mocks.h"
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/protobuf/mocks.h"
 #include "test/mocks/runtime/mocks.h"
@@ -602,6 +603,162 @@ decompressor_library:
                EnvoyException);
 }
 
+class DecompressorFilterChunkedResponseTest : public testing::Test {
+public:
+  DecompressorFilterChunkedResponseTest() {
+    envoy::extensions::filters::http::decompressor::v3::Decompressor decompressor;
+    TestUtility::loadFromYaml(R"EOF(
+decompressor_library:
+  name: testlib
+  typed_config:
+    "@type": "type.googleapis.com/envoy.extensions.compression.gzip.decompressor.v3.Gzip"
+response_direction_config:
+  max_decompressed_chunk_size: 4096
+)EOF",
+                              decompressor);
+    auto decompressor_factory =
+        std::make_unique<NiceMock<Compression::Decompressor::MockDecompressorFactory>>();
+    auto mock_decompressor =
+        std::make_unique<NiceMock<Compression::Decompressor::MockDecompressor>>();
+    // Expands the input 3 times, handing out at most output_limit bytes per call.
+    ON_CALL(*mock_decompressor, decompressBounded(_, _, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& input_buffer,
+                                     Buffer::Instance& output_buffer, uint64_t output_limit) {
+          pending_output_ += 3 * input_buffer.length();
+          input_buffer.drain(input_buffer.length());
+          const uint64_t length = std::min(pending_output_, output_limit);
+          output_buffer.add(std::string(length, 'a'));
+          pending_output_ -= length;
+          return length == output_limit;
+        }));
+    EXPECT_CALL(*decompressor_factory, createDecompressor(_))
+        .WillOnce(Return(ByMove(std::move(mock_decompressor))));
+    config_ = std::make_shared<DecompressorFilterConfig>(decompressor, "test.", *stats_.rootScope(),
+                                                         runtime_, std::move(decompressor_factory));
+    filter_ = std::make_unique<DecompressorFilter>(config_);
+    filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+
+    timer_ = new NiceMock<Event::MockTimer>(&encoder_callbacks_.dispatcher_);
+    EXPECT_CALL(decoder_callbacks_, addDownstreamWatermarkCallbacks(_));
+    Http::TestResponseHeaderMapImpl headers{{"content-encoding", "mock"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+    ON_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool end_stream) {
+          EXPECT_FALSE(end_stream);
+          injected_.push_back(data.length());
+          data.drain(data.length());
+          if (back_up_on_inject_) {
+            back_up_on_inject_ = false;
+            filter_->onAboveWriteBufferHighWatermark();
+          }
+        }));
+  }
+
+  ~DecompressorFilterChunkedResponseTest() override {
+    EXPECT_CALL(decoder_callbacks_, removeDownstreamWatermarkCallbacks(_));
+    filter_->onDestroy();
+  }
+
+  Http::FilterDataStatus encodeData(uint64_t length, bool end_stream) {
+    Buffer::OwnedImpl data(std::string(length, 'c'));
+    const Http::FilterDataStatus status = filter_->encodeData(data, end_stream);
+    decoded_ += data.length();
+    return status;
+  }
+
+  void expectTotals(const Http::TestResponseTrailerMapImpl& trailers, uint64_t compressed_bytes) {
+    EXPECT_EQ(std::to_string(compressed_bytes),
+              trailers.get_("x-envoy-decompressor-testlib-compressed-bytes"));
+    EXPECT_EQ(std::to_string(3 * compressed_bytes),
+              trailers.get_("x-envoy-decompressor-testlib-uncompressed-bytes"));
+    EXPECT_EQ(3 * compressed_bytes,
+              config_->responseDirectionConfig().stats().total_uncompressed_bytes_.value());
+    EXPECT_EQ(compressed_bytes,
+              config_->responseDirectionConfig().stats().total_compressed_bytes_.value());
+    EXPECT_EQ(std::vector<uint64_t>{Stats::Histogram::PercentScale / 3},
+              stats_.histogramValues(
+                  config_->responseDirectionConfig().stats().compression_ratio_.name(), false));
+  }
+
+  uint64_t pending_output_{};
+  bool back_up_on_inject_{};
+  uint64_t decoded_{};
+  std::vector<uint64_t> injected_;
+  DecompressorFilterConfigSharedPtr config_;
+  std::unique_ptr<DecompressorFilter> filter_;
+  Stats::TestUtil::TestStore stats_;
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
+  NiceMock<Event::MockTimer>* timer_;
+};
+
+// Frames decompressing to a single chunk continue down the filter chain.
+TEST_F(DecompressorFilterChunkedResponseTest, SingleChunk) {
+  EXPECT_EQ(Http::FilterDataStatus::Continue, encodeData(1000, false));
+  EXPECT_EQ(3000, decoded_);
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_CALL(encoder_callbacks_, addEncodedTrailers()).WillOnce(ReturnRef(trailers));
+  EXPECT_EQ(Http::FilterDataStatus::Continue, encodeData(300, true));
+  EXPECT_EQ(3900, decoded_);
+  EXPECT_FALSE(timer_->enabled());
+  expectTotals(trailers, 1300);
+}
+
+TEST_F(DecompressorFilterChunkedResponseTest, EndWithData) {
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, encodeData(2000, false));
+  EXPECT_TRUE(timer_->enabled());
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_CALL(encoder_callbacks_, addEncodedTrailers()).WillOnce(ReturnRef(trailers));
+  // The frame is decompressed after the chunks left of the previous one.
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, encodeData(1000, true));
+  EXPECT_EQ(0, decoded_);
+
+  EXPECT_CALL(encoder_callbacks_, continueEncoding());
+  timer_->invokeCallback();
+  EXPECT_EQ((std::vector<uint64_t>{4096, 4096, 808}), injected_);
+  expectTotals(trailers, 3000);
+}
+
+TEST_F(DecompressorFilterChunkedResponseTest, EndWithTrailers) {
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, encodeData(3000, false));
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_->encodeTrailers(trailers));
+
+  EXPECT_CALL(encoder_callbacks_, continueEncoding());
+  timer_->invokeCallback();
+  EXPECT_EQ((std::vector<uint64_t>{4096, 4096, 808}), injected_);
+  expectTotals(trailers, 3000);
+}
+
+// The chunks are only decompressed while the downstream is below its high watermark.
+TEST_F(DecompressorFilterChunkedResponseTest, DownstreamWatermarks) {
+  filter_->onAboveWriteBufferHighWatermark();
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, encodeData(3000, false));
+  EXPECT_FALSE(timer_->enabled());
+  EXPECT_EQ(3000 * 3 - 4096, pending_output_);
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_->encodeTrailers(trailers));
+
+  // Injecting the first chunk backs the downstream up again.
+  filter_->onBelowWriteBufferLowWatermark();
+  EXPECT_TRUE(timer_->enabled());
+  back_up_on_inject_ = true;
+  EXPECT_CALL(encoder_callbacks_, continueEncoding()).Times(0);
+  timer_->invokeCallback();
+  EXPECT_EQ(std::vector<uint64_t>{4096}, injected_);
+  // The chunks not encoded yet are still compressed.
+  EXPECT_EQ(3000 * 3 - 4096, pending_output_);
+
+  filter_->onBelowWriteBufferLowWatermark();
+  EXPECT_TRUE(timer_->enabled());
+  EXPECT_CALL(encoder_callbacks_, continueEncoding());
+  timer_->invokeCallback();
+  EXPECT_EQ((std::vector<uint64_t>{4096, 4096, 808}), injected_);
+  expectTotals(trailers, 3000);
+}
+
 } // namespace
 } // namespace Decompressor
 } // namespace HttpFilters
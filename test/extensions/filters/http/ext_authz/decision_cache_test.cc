@@ -0,0 +1,208 @@
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/service/auth/v3/external_auth.pb.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+using Filters::Common::ExtAuthz::CheckStatus;
+using Filters::Common::ExtAuthz::Response;
+
+class DecisionCacheTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::http::ext_authz::v3::DecisionCache config;
+    TestUtility::loadFromYaml(yaml, config);
+    cache_ = std::make_unique<DecisionCache>(config, tls_, time_system_, *store_.rootScope(),
+                                             "decision_cache");
+  }
+
+  static Response response(CheckStatus status) {
+    Response response{};
+    response.status = status;
+    return response;
+  }
+
+  std::string key(const Http::TestRequestHeaderMapImpl& headers) {
+    return cache_->key(headers, check_request_).value();
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(store_, "decision_cache." + name)->value();
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl store_;
+  envoy::service::auth::v3::CheckRequest check_request_;
+  std::unique_ptr<DecisionCache> cache_;
+};
+
+const std::string DefaultConfig = R"EOF(
+  key_headers: ["authorization", "x-tenant"]
+  ttl: 10s
+)EOF";
+
+// Verifies that the key distinguishes missing, empty and repeated headers, and ignores the headers
+// that aren't key headers.
+TEST_F(DecisionCacheTest, KeyFromHeaders) {
+  initialize(DefaultConfig);
+
+  const std::string missing = key({});
+  const std::string empty = key({{"authorization", ""}});
+  const std::string value = key({{"authorization", "a"}});
+  const std::string repeated = key({{"authorization", "a"}, {"authorization", "a"}});
+  const std::string moved = key({{"x-tenant", "a"}});
+  EXPECT_NE(missing, empty);
+  EXPECT_NE(empty, value);
+  EXPECT_NE(value, repeated);
+  EXPECT_NE(value, moved);
+  EXPECT_EQ(value, key({{"authorization", "a"}, {"x-other", "b"}}));
+}
+
+// Verifies that the key depends on the context extensions of the route.
+TEST_F(DecisionCacheTest, KeyFromContextExtensions) {
+  initialize(DefaultConfig);
+  const Http::TestRequestHeaderMapImpl headers{{"authorization", "a"}};
+  const std::string without_extensions = key(headers);
+
+  auto& extensions = *check_request_.mutable_attributes()->mutable_context_extensions();
+  extensions["route"] = "one";
+  extensions["tenant"] = "two";
+  const std::string with_extensions = key(headers);
+  EXPECT_NE(without_extensions, with_extensions);
+
+  extensions["route"] = "two";
+  extensions["tenant"] = "one";
+  EXPECT_NE(with_extensions, key(headers));
+}
+
+// Verifies that requests whose body is sent to the authorization server aren't cached.
+TEST_F(DecisionCacheTest, NoKeyWithBody) {
+  initialize(DefaultConfig);
+  const Http::TestRequestHeaderMapImpl headers{{"authorization", "a"}};
+  check_request_.mutable_attributes()->mutable_request()->mutable_http()->set_body("body");
+  EXPECT_FALSE(cache_->key(headers, check_request_).has_value());
+
+  check_request_.mutable_attributes()->mutable_request()->mutable_http()->clear_body();
+  check_request_.mutable_attributes()->mutable_request()->mutable_http()->set_raw_body("body");
+  EXPECT_FALSE(cache_->key(headers, check_request_).has_value());
+}
+
+TEST_F(DecisionCacheTest, AllowedDecisionsExpire) {
+  initialize(DefaultConfig);
+  EXPECT_EQ(nullptr, cache_->lookup("key"));
+
+  cache_->insert("key", response(CheckStatus::OK));
+  ResponseSharedPtr cached = cache_->lookup("key");
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(CheckStatus::OK, cached->status);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(nullptr, cache_->lookup("key"));
+  EXPECT_EQ(1, counter("insert"));
+  EXPECT_EQ(1, counter("hit"));
+  EXPECT_EQ(2, counter("miss"));
+}
+
+// Verifies that denied decisions are only cached with a denied_ttl, and errors never are.
+TEST_F(DecisionCacheTest, DeniedAndErrorDecisions) {
+  initialize(DefaultConfig);
+  cache_->insert("denied", response(CheckStatus::Denied));
+  cache_->insert("error", response(CheckStatus::Error));
+  EXPECT_EQ(nullptr, cache_->lookup("denied"));
+  EXPECT_EQ(nullptr, cache_->lookup("error"));
+  EXPECT_EQ(0, counter("insert"));
+
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  denied_ttl: 1s
+  )EOF");
+  cache_->insert("denied", response(CheckStatus::Denied));
+  cache_->insert("error", response(CheckStatus::Error));
+  ResponseSharedPtr cached = cache_->lookup("denied");
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(CheckStatus::Denied, cached->status);
+  EXPECT_EQ(nullptr, cache_->lookup("error"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(nullptr, cache_->lookup("denied"));
+}
+
+// Verifies that the TTL of the response can shorten the configured TTL, but not extend it.
+TEST_F(DecisionCacheTest, TtlFromMetadata) {
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  ttl_metadata_key: cache_ttl
+  )EOF");
+
+  Response shorter = response(CheckStatus::OK);
+  (*shorter.dynamic_metadata.mutable_fields())["cache_ttl"] = ValueUtil::numberValue(2);
+  cache_->insert("shorter", shorter);
+  Response longer = response(CheckStatus::OK);
+  (*longer.dynamic_metadata.mutable_fields())["cache_ttl"] = ValueUtil::numberValue(60);
+  cache_->insert("longer", longer);
+  Response zero = response(CheckStatus::OK);
+  (*zero.dynamic_metadata.mutable_fields())["cache_ttl"] = ValueUtil::numberValue(0);
+  cache_->insert("zero", zero);
+  Response not_a_number = response(CheckStatus::OK);
+  (*not_a_number.dynamic_metadata.mutable_fields())["cache_ttl"] = ValueUtil::stringValue("2");
+  cache_->insert("not_a_number", not_a_number);
+
+  EXPECT_EQ(nullptr, cache_->lookup("zero"));
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_EQ(nullptr, cache_->lookup("shorter"));
+  EXPECT_NE(nullptr, cache_->lookup("not_a_number"));
+  time_system_.advanceTimeWait(std::chrono::seconds(8));
+  EXPECT_EQ(nullptr, cache_->lookup("longer"));
+  EXPECT_EQ(nullptr, cache_->lookup("not_a_number"));
+}
+
+// Verifies that the least recently used decisions are evicted, and that a decision evicted from
+// the cache of the worker can still be found in the shared cache.
+TEST_F(DecisionCacheTest, EvictionAndSharedHits) {
+  initialize(R"EOF(
+  key_headers: ["authorization"]
+  ttl: 10s
+  max_entries: 2
+  )EOF");
+
+  cache_->insert("a", response(CheckStatus::OK));
+  cache_->insert("b", response(CheckStatus::OK));
+  // Only the cache of the worker sees the lookup, so the caches now disagree on the least
+  // recently used decision.
+  EXPECT_NE(nullptr, cache_->lookup("a"));
+  cache_->insert("c", response(CheckStatus::OK));
+  EXPECT_EQ(2, counter("evicted"));
+
+  // "b" was evicted from the cache of the worker, and "a" from the shared cache. Copying "b" back
+  // to the cache of the worker evicts "a" from it too.
+  EXPECT_NE(nullptr, cache_->lookup("b"));
+  EXPECT_EQ(1, counter("shared_hit"));
+  EXPECT_EQ(3, counter("evicted"));
+  EXPECT_EQ(nullptr, cache_->lookup("a"));
+  EXPECT_NE(nullptr, cache_->lookup("c"));
+  EXPECT_EQ(1, counter("shared_hit"));
+}
+
+} // namespace
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
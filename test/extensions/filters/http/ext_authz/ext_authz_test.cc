@@ -24,6 +24,7 @@
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/router/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/tracing/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/proto/helloworld.pb.h"
@@ -217,6 +218,17 @@ TEST_F(HttpFilterTest, MergeConfig) {
   EXPECT_EQ("value", merged_extensions.at("key"));
 }
 
+// Test that the routes on which the filter is disabled don't need the filter to be created.
+TEST_F(HttpFilterTest, DisabledConfigDisablesFilter) {
+  envoy::extensions::filters::http::ext_authz::v3::ExtAuthzPerRoute settings;
+  settings.mutable_check_settings()->set_disable_request_body_buffering(true);
+  EXPECT_FALSE(FilterConfigPerRoute(settings).disablesFilter());
+
+  settings.Clear();
+  settings.set_disabled(true);
+  EXPECT_TRUE(FilterConfigPerRoute(settings).disablesFilter());
+}
+
 // Test that defining stat_prefix appends an additional prefix to the emitted statistics names.
 TEST_F(HttpFilterTest, StatsWithPrefix) {
   const std::string stat_prefix = "with_stat_prefix";
@@ -712,6 +724,60 @@ TEST_F(HttpFilterTest, HeaderOnlyRequest) {
   // decodeData() and decodeTrailers() will not be called since request is header only.
 }
 
+// Checks that a decision cached by one filter is used by the next one instead of calling the
+// authorization server.
+TEST_F(HttpFilterTest, CachedDecision) {
+  const std::string yaml = R"EOF(
+  transport_api_version: V3
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  decision_cache:
+    key_headers: ["authorization"]
+    ttl: 10s
+  )EOF";
+  initialize(yaml);
+  envoy::extensions::filters::http::ext_authz::v3::ExtAuthz proto_config{};
+  TestUtility::loadFromYaml(yaml, proto_config);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  auto decision_cache = std::make_shared<DecisionCache>(
+      proto_config.decision_cache(), tls, decoder_filter_callbacks_.dispatcher_.timeSource(),
+      *stats_store_.rootScope(), "decision_cache");
+  filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_},
+                                     decision_cache);
+  filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  prepareCheck();
+  request_headers_.addCopy(Http::LowerCaseString("authorization"), "token");
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  EXPECT_CALL(*client_, check(_, _, _, _))
+      .WillOnce(Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                           const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                           const StreamInfo::StreamInfo&) -> void {
+        callbacks.onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+      }));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, true));
+  EXPECT_EQ(1U, decoder_filter_callbacks_.clusterInfo()
+                    ->statsScope()
+                    .counterFromString("ext_authz.ok")
+                    .value());
+
+  // The second filter finds the decision of the first one.
+  client_ = new Filters::Common::ExtAuthz::MockClient();
+  filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_},
+                                     decision_cache);
+  filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  EXPECT_CALL(*client_, check(_, _, _, _)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, true));
+  EXPECT_EQ(2U, decoder_filter_callbacks_.clusterInfo()
+                    ->statsScope()
+                    .counterFromString("ext_authz.ok")
+                    .value());
+  EXPECT_EQ(1U, decision_cache->stats().insert_.value());
+  EXPECT_EQ(1U, decision_cache->stats().hit_.value());
+}
+
 // Checks that filter does not buffer data on upgrade WebSocket request.
 TEST_F(HttpFilterTest, UpgradeWebsocketRequest) {
   InSequence s;
@@ -217,6 +217,43 @@ TEST_F(BenchmarkTest, AddResponseHeaderAndClose) {
   measureHttpGets("add-response-header-close");
 }
 
+// Observe the request and response headers in async mode, without ever responding.
+TEST_F(BenchmarkTest, ObserveHeadersAsync) {
+  proto_config_.set_async_mode(true);
+  test_processor_.start(
+      ipVersion(), [](grpc::ServerReaderWriter<ProcessingResponse, ProcessingRequest>* stream) {
+        ProcessingRequest request_in;
+        while (stream->Read(&request_in)) {
+          ASSERT_TRUE(request_in.async_mode());
+        }
+      });
+  initialize();
+  measureHttpGets("observe-headers-async");
+}
+
+// Respond to the request and response headers without changes, as a baseline for the
+// overhead of waiting for the processor compared to ObserveHeadersAsync.
+TEST_F(BenchmarkTest, ProcessHeadersSync) {
+  test_processor_.start(
+      ipVersion(), [](grpc::ServerReaderWriter<ProcessingResponse, ProcessingRequest>* stream) {
+        ProcessingRequest request_in;
+        ASSERT_TRUE(stream->Read(&request_in));
+        ASSERT_TRUE(request_in.has_request_headers());
+        ProcessingResponse request_out;
+        request_out.mutable_request_headers();
+        stream->Write(request_out);
+
+        ProcessingRequest response_in;
+        ASSERT_TRUE(stream->Read(&response_in));
+        ASSERT_TRUE(response_in.has_response_headers());
+        ProcessingResponse response_out;
+        response_out.mutable_response_headers();
+        stream->Write(response_out);
+      });
+  initialize();
+  measureHttpGets("process-headers-sync");
+}
+
 // Process the response body in buffered mode.
 TEST_F(BenchmarkTest, ProcessBufferedResponseBody) {
   proto_config_.mutable_processing_mode()->set_response_body_mode(ProcessingMode::BUFFERED);
@@ -1625,6 +1625,101 @@ TEST_F(HttpFilterTest, PostAndFail) {
   expectGrpcCalls(envoy::config::core::v3::TrafficDirection::INBOUND, Grpc::Status::Internal, 1);
 }
 
+// In async mode, test that every configured part of the request and response is sent
+// without stopping filter iteration.
+TEST_F(HttpFilterTest, AsyncModeObservesWithoutWaiting) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  async_mode: true
+  processing_mode:
+    request_body_mode: "BUFFERED"
+    request_trailer_mode: "SEND"
+  )EOF");
+
+  EXPECT_TRUE(config_->asyncMode());
+
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  EXPECT_TRUE(last_request_.async_mode());
+  EXPECT_TRUE(last_request_.has_request_headers());
+
+  Buffer::OwnedImpl req_data("foo");
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->decodeData(req_data, false));
+  EXPECT_TRUE(last_request_.async_mode());
+  ASSERT_TRUE(last_request_.has_request_body());
+  EXPECT_EQ("foo", last_request_.request_body().body());
+  EXPECT_FALSE(last_request_.request_body().end_of_stream());
+  EXPECT_EQ("foo", req_data.toString());
+
+  request_trailers_.addCopy(LowerCaseString("x-trailer"), "yes");
+  EXPECT_EQ(FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers_));
+  EXPECT_TRUE(last_request_.async_mode());
+  EXPECT_TRUE(last_request_.has_request_trailers());
+
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+  EXPECT_TRUE(last_request_.async_mode());
+  EXPECT_TRUE(last_request_.has_response_headers());
+
+  Buffer::OwnedImpl resp_data("bar");
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->encodeData(resp_data, true));
+  filter_->onDestroy();
+
+  EXPECT_EQ(1, config_->stats().streams_started_.value());
+  EXPECT_EQ(4, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(0, config_->stats().stream_msgs_received_.value());
+  EXPECT_EQ(1, config_->stats().streams_closed_.value());
+}
+
+// In async mode, test that a response from the processor is ignored, along with the rest of
+// the stream.
+TEST_F(HttpFilterTest, AsyncModeIgnoresResponses) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  async_mode: true
+  )EOF");
+
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(_, _, _, _, _)).Times(0);
+  auto response = std::make_unique<ProcessingResponse>();
+  response->mutable_immediate_response();
+  stream_callbacks_->onReceiveMessage(std::move(response));
+
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, true));
+  filter_->onDestroy();
+
+  EXPECT_EQ(1, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(1, config_->stats().spurious_msgs_received_.value());
+}
+
+// In async mode, test that a gRPC error doesn't fail the request, even though failure mode is
+// not allowed.
+TEST_F(HttpFilterTest, AsyncModeIgnoresErrors) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  async_mode: true
+  )EOF");
+
+  EXPECT_FALSE(config_->failureModeAllow());
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(_, _, _, _, _)).Times(0);
+  server_closed_stream_ = true;
+  stream_callbacks_->onGrpcError(Grpc::Status::Internal);
+
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, true));
+  filter_->onDestroy();
+
+  EXPECT_EQ(1, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(1, config_->stats().streams_failed_.value());
+  EXPECT_EQ(0, config_->stats().failure_mode_allowed_.value());
+}
+
 // Using the default configuration, test the filter with a processor that
 // returns an error from from the gRPC stream during response header processing.
 TEST_F(HttpFilterTest, PostAndFailOnResponse) {
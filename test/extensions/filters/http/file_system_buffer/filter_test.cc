@@ -64,6 +64,9 @@ protected:
   void expectRead(MockAsyncFileHandle handle, off_t offset, size_t size) {
     EXPECT_CALL(*handle, read(offset, size, _));
   }
+  void expectReadMapped(MockAsyncFileHandle handle, off_t offset, size_t size) {
+    EXPECT_CALL(*handle, readMapped(offset, size, _));
+  }
   void completeRead(absl::string_view content) {
     mock_async_file_manager_->nextActionCompletes(absl::StatusOr<std::unique_ptr<Buffer::Instance>>{
         std::make_unique<Buffer::OwnedImpl>(content)});
@@ -365,6 +368,31 @@ TEST_F(FileSystemBufferFilterTest,
   EXPECT_EQ(response_sent_on_, "hello world");
 }
 
+TEST_F(FileSystemBufferFilterTest, MapsResponseFragmentsFromDiskWhenConfigured) {
+  createFilterFromYaml(R"(
+    manager_config:
+      thread_pool:
+        thread_count: 1
+    response:
+      memory_buffer_bytes_limit: 6
+      map_storage_reads: true
+  )");
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+  Buffer::OwnedImpl data1("hello ");
+  Buffer::OwnedImpl data2("world");
+  sendResponseHighWatermark();
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data1, false));
+  expectAsyncFileCreated();
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data2, true));
+  auto handle = completeCreateFileAndExpectWrite("world");
+  completeWriteOfSize(5);
+  expectReadMapped(handle, 0, 5);
+  sendResponseLowWatermark();
+  EXPECT_EQ(response_sent_on_, "hello ");
+  completeRead("world");
+  EXPECT_EQ(response_sent_on_, "hello world");
+}
+
 TEST_F(FileSystemBufferFilterTest, RequestErrorsWhenManagerNotConfigured) {
   createFilterFromYaml(R"(
     request:
@@ -105,7 +105,7 @@ TEST_F(FileSystemBufferFilterFragmentTest, WritesAndReadsBack) {
             return []() {};
           });
   // Request the fragment be moved from storage.
-  EXPECT_OK(frag.fromStorage(handle_, &dispatchImmediately, storageSuccessCallback()));
+  EXPECT_OK(frag.fromStorage(handle_, false, &dispatchImmediately, storageSuccessCallback()));
   // Before the file confirms read, the state should be neither in memory nor storage.
   EXPECT_FALSE(frag.isMemory());
   EXPECT_FALSE(frag.isStorage());
@@ -119,6 +119,27 @@ TEST_F(FileSystemBufferFilterFragmentTest, WritesAndReadsBack) {
   EXPECT_EQ(out->toString(), "hello");
 }
 
+TEST_F(FileSystemBufferFilterFragmentTest, ReadsBackMapped) {
+  Buffer::OwnedImpl input("hello");
+  Fragment frag(input);
+  moveFragmentToStorage(&frag);
+  std::function<void(absl::StatusOr<std::unique_ptr<Buffer::Instance>>)> captured_read_callback;
+  EXPECT_CALL(*handle_, readMapped(123, 5, _))
+      .WillOnce(
+          [&captured_read_callback](
+              off_t, size_t,
+              std::function<void(absl::StatusOr<std::unique_ptr<Buffer::Instance>>)> callback) {
+            captured_read_callback = std::move(callback);
+            return []() {};
+          });
+  EXPECT_OK(frag.fromStorage(handle_, true, &dispatchImmediately, storageSuccessCallback()));
+  EXPECT_FALSE(frag.isMemory());
+  EXPECT_FALSE(frag.isStorage());
+  captured_read_callback(std::make_unique<Buffer::OwnedImpl>("hello"));
+  EXPECT_TRUE(frag.isMemory());
+  EXPECT_EQ(frag.extract()->toString(), "hello");
+}
+
 TEST_F(FileSystemBufferFilterFragmentTest, ReturnsErrorOnWriteError) {
   Buffer::OwnedImpl input("hello");
   Fragment frag(input);
@@ -174,8 +195,8 @@ TEST_F(FileSystemBufferFilterFragmentTest, ReturnsErrorOnReadError) {
             return []() {};
           });
   // Request the fragment be moved from storage.
-  EXPECT_OK(
-      frag.fromStorage(handle_, &dispatchImmediately, storageFailureCallback(Eq(read_error))));
+  EXPECT_OK(frag.fromStorage(handle_, false, &dispatchImmediately,
+                             storageFailureCallback(Eq(read_error))));
   // Fake file system declares a read error. This should
   // provoke the expected error in the callback above.
   captured_read_callback(read_error);
@@ -196,7 +217,7 @@ TEST_F(FileSystemBufferFilterFragmentTest, ReturnsErrorOnReadIncomplete) {
           });
   // Request the fragment be moved from storage.
   EXPECT_OK(frag.fromStorage(
-      handle_, &dispatchImmediately,
+      handle_, false, &dispatchImmediately,
       storageFailureCallback(HasStatusMessage(HasSubstr("read got 2 bytes, wanted 5")))));
 
   // Fake file system declares a read error. This should
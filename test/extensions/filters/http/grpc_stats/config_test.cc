@@ -27,18 +27,22 @@ class GrpcStatsFilterConfigTest : public testing::Test {
 protected:
   void initialize() {
     GrpcStatsFilterConfigFactory factory;
-    Http::FilterFactoryCb cb = factory.createFilterFactoryFromProto(config_, "stats", context_);
-    Http::MockFilterChainFactoryCallbacks filter_callback;
-
-    ON_CALL(filter_callback, addStreamFilter(_)).WillByDefault(testing::SaveArg<0>(&filter_));
-    EXPECT_CALL(filter_callback, addStreamFilter(_));
-    cb(filter_callback);
+    cb_ = factory.createFilterFactoryFromProto(config_, "stats", context_);
 
     ON_CALL(decoder_callbacks_, streamInfo()).WillByDefault(testing::ReturnRef(stream_info_));
 
     ON_CALL(*decoder_callbacks_.cluster_info_, statsScope())
         .WillByDefault(testing::ReturnRef(scope_));
 
+    createFilter();
+  }
+
+  void createFilter() {
+    Http::MockFilterChainFactoryCallbacks filter_callback;
+    ON_CALL(filter_callback, addStreamFilter(_)).WillByDefault(testing::SaveArg<0>(&filter_));
+    EXPECT_CALL(filter_callback, addStreamFilter(_));
+    cb_(filter_callback);
+
     filter_->setDecoderFilterCallbacks(decoder_callbacks_);
   }
 
@@ -64,6 +68,7 @@ protected:
 
   envoy::extensions::filters::http::grpc_stats::v3::FilterConfig config_;
   NiceMock<Server::Configuration::MockFactoryContext> context_;
+  Http::FilterFactoryCb cb_;
   Http::StreamFilterSharedPtr filter_;
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
   NiceMock<StreamInfo::MockStreamInfo> stream_info_;
@@ -699,6 +704,82 @@ TEST_F(GrpcStatsFilterConfigTest, UpstreamStatsWithTrailersOnly) {
   EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers, true));
 }
 
+// The requests following the first one to a service/method charge the stats it cached.
+TEST_F(GrpcStatsFilterConfigTest, MethodStatsCache) {
+  config_.mutable_stats_for_all_methods()->set_value(true);
+  initialize();
+  Http::TestRequestHeaderMapImpl request_headers{
+      {"content-type", "application/grpc"},
+      {":path", "/lyft.users.BadCompanions/GetBadCompanions"}};
+
+  doRequestResponse(request_headers);
+  createFilter();
+  doRequestResponse(request_headers);
+  // The stats are charged for the :path the request was received with.
+  createFilter();
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
+  request_headers.setPath("/lyft.users.BadCompanions/AnotherMethod");
+  Http::TestResponseHeaderMapImpl response_headers{{":status", "200"}, {"grpc-status", "1"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers, true));
+
+  EXPECT_EQ(2UL, decoder_callbacks_.clusterInfo()
+                     ->statsScope()
+                     .counterFromString("grpc.lyft.users.BadCompanions.GetBadCompanions.success")
+                     .value());
+  EXPECT_EQ(1UL, decoder_callbacks_.clusterInfo()
+                     ->statsScope()
+                     .counterFromString("grpc.lyft.users.BadCompanions.GetBadCompanions.failure")
+                     .value());
+  EXPECT_EQ(3UL, decoder_callbacks_.clusterInfo()
+                     ->statsScope()
+                     .counterFromString("grpc.lyft.users.BadCompanions.GetBadCompanions.total")
+                     .value());
+  EXPECT_EQ(2UL, decoder_callbacks_.clusterInfo()
+                     ->statsScope()
+                     .counterFromString("grpc.lyft.users.BadCompanions.GetBadCompanions.0")
+                     .value());
+}
+
+TEST_F(GrpcStatsFilterConfigTest, MethodStatsCacheDisabled) {
+  config_.mutable_stats_for_all_methods()->set_value(true);
+  config_.mutable_method_stats_cache_size()->set_value(0);
+  initialize();
+  Http::TestRequestHeaderMapImpl request_headers{
+      {"content-type", "application/grpc"},
+      {":path", "/lyft.users.BadCompanions/GetBadCompanions"}};
+
+  doRequestResponse(request_headers);
+  createFilter();
+  doRequestResponse(request_headers);
+
+  EXPECT_EQ(2UL, decoder_callbacks_.clusterInfo()
+                     ->statsScope()
+                     .counterFromString("grpc.lyft.users.BadCompanions.GetBadCompanions.success")
+                     .value());
+  EXPECT_EQ(2UL, decoder_callbacks_.clusterInfo()
+                     ->statsScope()
+                     .counterFromString("grpc.lyft.users.BadCompanions.GetBadCompanions.total")
+                     .value());
+}
+
+// Requests outside of the allowlist share the cached stats without service/method.
+TEST_F(GrpcStatsFilterConfigTest, MethodStatsCacheAllowlistMismatch) {
+  addAllowlistEntry();
+  initialize();
+  Http::TestRequestHeaderMapImpl request_headers{{"content-type", "application/grpc"},
+                                                 {":path", "/BadCompanions/GetGoodCompanions"}};
+
+  doRequestResponse(request_headers);
+  createFilter();
+  doRequestResponse(request_headers);
+
+  EXPECT_EQ(
+      2UL,
+      decoder_callbacks_.clusterInfo()->statsScope().counterFromString("grpc.success").value());
+  EXPECT_FALSE(
+      stats_store_.findCounterByString("grpc.BadCompanions.GetGoodCompanions.success"));
+}
+
 } // namespace
 } // namespace GrpcStats
 } // namespace HttpFilters
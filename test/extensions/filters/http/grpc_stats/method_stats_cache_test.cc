@@ -0,0 +1,125 @@
+#include <memory>
+
+#include "source/common/grpc/context_impl.h"
+#include "source/extensions/filters/http/grpc_stats/method_stats_cache.h"
+
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcStats {
+namespace {
+
+class MethodStatsCacheTest : public testing::Test {
+protected:
+  absl::optional<Grpc::Context::RequestStatNames> requestNames(absl::string_view path) {
+    Http::TestRequestHeaderMapImpl headers{{":path", std::string(path)}};
+    return context_.resolveDynamicServiceAndMethod(headers.Path());
+  }
+
+  uint64_t counterValue(Upstream::MockClusterInfo& cluster, const std::string& name) {
+    return cluster.statsScope().counterFromString(name).value();
+  }
+
+  std::shared_ptr<NiceMock<Upstream::MockClusterInfo>> cluster_{
+      std::make_shared<NiceMock<Upstream::MockClusterInfo>>()};
+  Stats::SymbolTable& symbol_table_{cluster_->stats_store_.symbolTable()};
+  Grpc::ContextImpl context_{symbol_table_};
+  MethodStatNames stat_names_{symbol_table_};
+};
+
+// The cached stats are the ones the context charges.
+TEST_F(MethodStatsCacheTest, ChargeStats) {
+  MethodStatsCache cache(stat_names_, 16);
+  const std::string path = "/lyft.users.BadCompanions/GetBadCompanions";
+  EXPECT_EQ(nullptr, cache.lookup(cluster_, path));
+  MethodStatsSharedPtr stats = cache.insert(cluster_, path, requestNames(path));
+  EXPECT_EQ(stats, cache.lookup(cluster_, path));
+
+  Http::TestResponseTrailerMapImpl ok{{"grpc-status", "0"}};
+  Http::TestResponseTrailerMapImpl unavailable{{"grpc-status", "14"}};
+  Http::TestResponseTrailerMapImpl unknown{{"grpc-status", "014"}};
+  stats->chargeStat(*cluster_, ok.GrpcStatus());
+  stats->chargeStat(*cluster_, unavailable.GrpcStatus());
+  stats->chargeStat(*cluster_, unknown.GrpcStatus());
+  stats->chargeStat(*cluster_, nullptr);
+  stats->chargeRequestMessageStat(*cluster_, 2);
+  stats->chargeResponseMessageStat(*cluster_, 3);
+
+  const std::string prefix = "grpc.lyft.users.BadCompanions.GetBadCompanions.";
+  EXPECT_EQ(1U, counterValue(*cluster_, prefix + "0"));
+  EXPECT_EQ(1U, counterValue(*cluster_, prefix + "14"));
+  EXPECT_EQ(1U, counterValue(*cluster_, prefix + "014"));
+  EXPECT_EQ(1U, counterValue(*cluster_, prefix + "success"));
+  EXPECT_EQ(2U, counterValue(*cluster_, prefix + "failure"));
+  EXPECT_EQ(3U, counterValue(*cluster_, prefix + "total"));
+  EXPECT_EQ(2U, counterValue(*cluster_, prefix + "request_message_count"));
+  EXPECT_EQ(3U, counterValue(*cluster_, prefix + "response_message_count"));
+
+  // Without request names, the stats have no service/method.
+  MethodStatsSharedPtr other = cache.insert(cluster_, "/other/method", absl::nullopt);
+  other->chargeStat(*cluster_, true);
+  EXPECT_EQ(1U, counterValue(*cluster_, "grpc.success"));
+  EXPECT_EQ(1U, counterValue(*cluster_, "grpc.total"));
+}
+
+TEST_F(MethodStatsCacheTest, Eviction) {
+  MethodStatsCache cache(stat_names_, 2);
+  MethodStatsSharedPtr a = cache.insert(cluster_, "/s/a", requestNames("/s/a"));
+  cache.insert(cluster_, "/s/b", requestNames("/s/b"));
+  // Looking a up makes b the least recently used.
+  EXPECT_EQ(a, cache.lookup(cluster_, "/s/a"));
+  cache.insert(cluster_, "/s/c", requestNames("/s/c"));
+  EXPECT_EQ(2U, cache.size());
+  EXPECT_EQ(nullptr, cache.lookup(cluster_, "/s/b"));
+  EXPECT_EQ(a, cache.lookup(cluster_, "/s/a"));
+  EXPECT_NE(nullptr, cache.lookup(cluster_, "/s/c"));
+
+  // Evicted stats can still be charged.
+  cache.insert(cluster_, "/s/d", requestNames("/s/d"));
+  cache.insert(cluster_, "/s/e", requestNames("/s/e"));
+  EXPECT_EQ(nullptr, cache.lookup(cluster_, "/s/a"));
+  a->chargeStat(*cluster_, true);
+  EXPECT_EQ(1U, counterValue(*cluster_, "grpc.s.a.success"));
+}
+
+TEST_F(MethodStatsCacheTest, Clusters) {
+  MethodStatsCache cache(stat_names_, 16);
+  auto cluster2 = std::make_shared<NiceMock<Upstream::MockClusterInfo>>();
+  MethodStatsSharedPtr stats = cache.insert(cluster_, "/s/a", requestNames("/s/a"));
+  EXPECT_EQ(nullptr, cache.lookup(cluster2, "/s/a"));
+  EXPECT_NE(stats, cache.insert(cluster2, "/s/a", requestNames("/s/a")));
+  EXPECT_EQ(stats, cache.lookup(cluster_, "/s/a"));
+  EXPECT_EQ(2U, cache.size());
+}
+
+// The stats of a destroyed ClusterInfo aren't used for another one at the same address.
+TEST_F(MethodStatsCacheTest, DestroyedCluster) {
+  MethodStatsCache cache(stat_names_, 16);
+  auto owner = std::make_shared<int>(0);
+  cache.insert(Upstream::ClusterInfoConstSharedPtr(owner, cluster_.get()), "/s/a",
+               requestNames("/s/a"));
+  EXPECT_NE(nullptr, cache.lookup(cluster_, "/s/a"));
+  owner.reset();
+  EXPECT_EQ(nullptr, cache.lookup(cluster_, "/s/a"));
+  EXPECT_EQ(0U, cache.size());
+}
+
+TEST_F(MethodStatsCacheTest, Disabled) {
+  MethodStatsCache cache(stat_names_, 0);
+  EXPECT_NE(nullptr, cache.insert(cluster_, "/s/a", requestNames("/s/a")));
+  EXPECT_EQ(nullptr, cache.lookup(cluster_, "/s/a"));
+  EXPECT_EQ(0U, cache.size());
+}
+
+} // namespace
+} // namespace GrpcStats
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
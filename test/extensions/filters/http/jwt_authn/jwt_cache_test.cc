@@ -3,6 +3,7 @@
 #include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
 
 #include "source/common/protobuf/utility.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
 
 #include "test/extensions/filters/http/jwt_authn/test_common.h"
@@ -31,7 +32,17 @@ public:
     EXPECT_EQ(status, Status::Ok);
   }
 
+  void setupSharedCache(uint32_t shared_cache_size) {
+    envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+    config.set_shared_jwt_cache_size(shared_cache_size);
+    shared_cache_ = SharedJwtCache::create(config, time_system_, shared_hit_);
+    cache_ = JwtCache::create(true, config, time_system_, shared_cache_);
+  }
+
   Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl stats_store_;
+  Stats::Counter& shared_hit_{stats_store_.rootScope()->counterFromString("shared_hit")};
+  SharedJwtCacheSharedPtr shared_cache_;
   JwtCachePtr cache_;
   std::unique_ptr<::google::jwt_verify::Jwt> jwt_;
 };
@@ -80,6 +91,45 @@ TEST_F(JwtCacheTest, TestExpiredToken) {
   EXPECT_TRUE(jwt == nullptr);
 }
 
+TEST_F(JwtCacheTest, TestSharedCacheDisabled) {
+  setupSharedCache(0);
+  EXPECT_EQ(shared_cache_, nullptr);
+}
+
+// A token inserted by the cache of one worker is found by the cache of another one.
+TEST_F(JwtCacheTest, TestSharedCache) {
+  setupSharedCache(10);
+  ASSERT_NE(shared_cache_, nullptr);
+  loadJwt(GoodToken);
+  auto* origin_jwt = jwt_.get();
+  cache_->insert(GoodToken, std::move(jwt_));
+
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  JwtCachePtr other_cache = JwtCache::create(true, config, time_system_, shared_cache_);
+  auto* jwt = other_cache->lookup(GoodToken);
+  ASSERT_TRUE(jwt != nullptr);
+  // It is a copy of the token of the other cache.
+  EXPECT_NE(jwt, origin_jwt);
+  EXPECT_EQ(jwt->iss_, origin_jwt->iss_);
+  EXPECT_EQ(jwt->payload_str_, origin_jwt->payload_str_);
+  EXPECT_EQ(1U, shared_hit_.value());
+
+  // The copy is now in the cache of the other worker.
+  EXPECT_EQ(other_cache->lookup(GoodToken), jwt);
+  EXPECT_EQ(1U, shared_hit_.value());
+  EXPECT_TRUE(other_cache->lookup(OtherGoodToken) == nullptr);
+}
+
+TEST_F(JwtCacheTest, TestSharedCacheExpiredToken) {
+  setupSharedCache(10);
+  loadJwt(ExpiredToken);
+  cache_->insert(ExpiredToken, std::move(jwt_));
+
+  EXPECT_TRUE(cache_->lookup(ExpiredToken) == nullptr);
+  EXPECT_TRUE(shared_cache_->lookup(ExpiredToken) == nullptr);
+  EXPECT_EQ(0U, shared_hit_.value());
+}
+
 } // namespace
 } // namespace JwtAuthn
 } // namespace HttpFilters
@@ -460,7 +460,7 @@ TEST_F(LuaStreamInfoWrapperTest, GetDynamicMetadataBinaryData) {
   setup(SCRIPT);
 
   StreamInfo::StreamInfoImpl stream_info(Http::Protocol::Http2, test_time_.timeSystem(), nullptr);
-  (*stream_info.metadata_.mutable_filter_metadata())["envoy.pp"] = metadata;
+  (*stream_info.dynamicMetadata().mutable_filter_metadata())["envoy.pp"] = metadata;
   Filters::Common::Lua::LuaDeathRef<StreamInfoWrapper> wrapper(
       StreamInfoWrapper::create(coroutine_->luaState(), stream_info), true);
 
@@ -0,0 +1,187 @@
+#include "envoy/extensions/filters/http/ratelimit/v3/rate_limit.pb.h"
+
+#include "source/extensions/filters/http/ratelimit/quota_lease.h"
+
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+namespace {
+
+using Filters::Common::RateLimit::LimitStatus;
+
+class MockWaiter : public QuotaLeases::Waiter {
+public:
+  MOCK_METHOD(void, onLeaseHit, ());
+  MOCK_METHOD(void, onLeaseFetch, ());
+  MOCK_METHOD(void, onLeaseDenied,
+              (LimitStatus status, const Http::ResponseHeaderMap* response_headers_to_add,
+               const std::string& response_body));
+};
+
+class QuotaLeasesTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease config;
+    TestUtility::loadFromYaml(yaml, config);
+    leases_ = std::make_unique<QuotaLeases>(config, tls_, time_system_);
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  Event::SimulatedTimeSystem time_system_;
+  QuotaLeasesPtr leases_;
+};
+
+const std::string DefaultConfig = R"EOF(
+  hits: 3
+  ttl: 10s
+)EOF";
+
+// Verifies that the key distinguishes the entries of the descriptors and their limit overrides.
+TEST_F(QuotaLeasesTest, Key) {
+  const std::string key = QuotaLeases::key({{{{"a", "bc"}}}, {{{"d", "e"}}}});
+  EXPECT_NE(key, QuotaLeases::key({{{{"ab", "c"}}}, {{{"d", "e"}}}}));
+  EXPECT_NE(key, QuotaLeases::key({{{{"a", "bc"}, {"d", "e"}}}}));
+  EXPECT_EQ(key, QuotaLeases::key({{{{"a", "bc"}}}, {{{"d", "e"}}}}));
+
+  Envoy::RateLimit::Descriptor overridden{{{"a", "bc"}}};
+  overridden.limit_ = {42, envoy::type::v3::RateLimitUnit::MINUTE};
+  EXPECT_NE(QuotaLeases::key({{{{"a", "bc"}}}}), QuotaLeases::key({overridden}));
+}
+
+// Verifies that the hits of a fetched lease go to the waiters first, and then to the next
+// requests until they are used.
+TEST_F(QuotaLeasesTest, FetchedLeaseIsShared) {
+  initialize(DefaultConfig);
+  NiceMock<MockWaiter> fetcher, waiter, next, last;
+
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", fetcher));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Wait, leases_->acquire("key", waiter));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("other", next));
+
+  EXPECT_CALL(waiter, onLeaseHit());
+  leases_->leaseFetched("key", absl::nullopt);
+  EXPECT_EQ(QuotaLeases::AcquireResult::Hit, leases_->acquire("key", next));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", last));
+}
+
+// Verifies that the waiters beyond the hits of a lease fetch the next lease one at a time.
+TEST_F(QuotaLeasesTest, WaitersBeyondLeaseFetchAgain) {
+  initialize(DefaultConfig);
+  NiceMock<MockWaiter> fetcher, first, second, third, fourth;
+
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", fetcher));
+  for (MockWaiter* waiter : {&first, &second, &third, &fourth}) {
+    EXPECT_EQ(QuotaLeases::AcquireResult::Wait, leases_->acquire("key", *waiter));
+  }
+
+  EXPECT_CALL(first, onLeaseHit());
+  EXPECT_CALL(second, onLeaseHit());
+  EXPECT_CALL(third, onLeaseFetch());
+  EXPECT_CALL(fourth, onLeaseHit()).Times(0);
+  leases_->leaseFetched("key", absl::nullopt);
+
+  EXPECT_CALL(fourth, onLeaseHit());
+  leases_->leaseFetched("key", absl::nullopt);
+  // One hit of the second lease is left.
+  EXPECT_EQ(QuotaLeases::AcquireResult::Hit, leases_->acquire("key", first));
+}
+
+// Verifies that leases expire after their TTL, or sooner when the limit resets sooner.
+TEST_F(QuotaLeasesTest, LeasesExpire) {
+  initialize(DefaultConfig);
+  NiceMock<MockWaiter> waiter;
+
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", waiter));
+  leases_->leaseFetched("key", absl::nullopt);
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("reset", waiter));
+  leases_->leaseFetched("reset", std::chrono::milliseconds(1000));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Hit, leases_->acquire("key", waiter));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("reset", waiter));
+  leases_->leaseDenied("reset", LimitStatus::OverLimit, nullptr, "");
+
+  time_system_.advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", waiter));
+}
+
+// Verifies that a denied lease is passed on to all its waiters, and isn't stored.
+TEST_F(QuotaLeasesTest, DeniedLeaseIsShared) {
+  initialize(DefaultConfig);
+  NiceMock<MockWaiter> fetcher, first, second;
+
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", fetcher));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Wait, leases_->acquire("key", first));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Wait, leases_->acquire("key", second));
+
+  Http::TestResponseHeaderMapImpl headers{{"x-denied", "true"}};
+  EXPECT_CALL(first, onLeaseDenied(LimitStatus::OverLimit, &headers, "denied"));
+  EXPECT_CALL(second, onLeaseDenied(LimitStatus::OverLimit, &headers, "denied"));
+  leases_->leaseDenied("key", LimitStatus::OverLimit, &headers, "denied");
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", fetcher));
+}
+
+// Verifies that cancelling the fetcher hands the fetch over to the next waiter, and that waiters
+// cancelled by the callbacks of other waiters aren't called.
+TEST_F(QuotaLeasesTest, Cancel) {
+  initialize(DefaultConfig);
+  NiceMock<MockWaiter> fetcher, first, second, third, fourth;
+
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", fetcher));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Wait, leases_->acquire("key", first));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Wait, leases_->acquire("key", second));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Wait, leases_->acquire("key", third));
+
+  EXPECT_CALL(first, onLeaseFetch());
+  leases_->cancel("key", fetcher);
+
+  EXPECT_CALL(second, onLeaseHit()).WillOnce(Invoke([&]() { leases_->cancel("key", third); }));
+  EXPECT_CALL(third, onLeaseHit()).Times(0);
+  leases_->leaseFetched("key", absl::nullopt);
+  EXPECT_EQ(QuotaLeases::AcquireResult::Hit, leases_->acquire("key", fourth));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", fourth));
+
+  // The fetcher cancelling without waiters forgets the fetch.
+  leases_->cancel("key", fourth);
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("key", first));
+}
+
+// Verifies that no more than max_leases are stored, expired leases making room for new ones.
+TEST_F(QuotaLeasesTest, MaxLeases) {
+  initialize(R"EOF(
+  hits: 3
+  ttl: 10s
+  max_leases: 1
+  )EOF");
+  NiceMock<MockWaiter> waiter;
+
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("a", waiter));
+  leases_->leaseFetched("a", absl::nullopt);
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("b", waiter));
+  leases_->leaseFetched("b", absl::nullopt);
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("b", waiter));
+  leases_->leaseDenied("b", LimitStatus::OverLimit, nullptr, "");
+  EXPECT_EQ(QuotaLeases::AcquireResult::Hit, leases_->acquire("a", waiter));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(QuotaLeases::AcquireResult::Fetch, leases_->acquire("b", waiter));
+  leases_->leaseFetched("b", absl::nullopt);
+  EXPECT_EQ(QuotaLeases::AcquireResult::Hit, leases_->acquire("b", waiter));
+}
+
+} // namespace
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
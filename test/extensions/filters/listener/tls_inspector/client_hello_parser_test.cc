@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include "test/extensions/filters/listener/tls_inspector/tls_utility.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+namespace {
+
+ClientHelloParseResult parse(const std::vector<uint8_t>& data, size_t len,
+                             absl::string_view& server_name) {
+  SSL_CLIENT_HELLO client_hello;
+  return ClientHelloParser::parse(absl::MakeConstSpan(data.data(), len), client_hello,
+                                  server_name);
+}
+
+ClientHelloParseResult parse(const std::vector<uint8_t>& data) {
+  absl::string_view server_name;
+  return parse(data, data.size(), server_name);
+}
+
+TEST(ClientHelloParserTest, ParsesClientHello) {
+  const std::vector<uint8_t> data = Tls::Test::generateClientHello(
+      TLS1_VERSION, TLS1_3_VERSION, "example.com", "\x02h2\x08http/1.1");
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  ASSERT_EQ(ClientHelloParseResult::Complete,
+            ClientHelloParser::parse(data, client_hello, server_name));
+  EXPECT_EQ("example.com", server_name);
+  EXPECT_EQ(nullptr, client_hello.ssl);
+  EXPECT_EQ(TLS1_2_VERSION, client_hello.version);
+  EXPECT_EQ(SSL3_RANDOM_SIZE, client_hello.random_len);
+  EXPECT_NE(0, client_hello.cipher_suites_len);
+
+  const uint8_t* alpn;
+  size_t alpn_len;
+  ASSERT_TRUE(SSL_early_callback_ctx_extension_get(
+      &client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &alpn, &alpn_len));
+  EXPECT_EQ(std::string("\x00\x0c\x02h2\x08http/1.1", 14),
+            std::string(reinterpret_cast<const char*>(alpn), alpn_len));
+}
+
+TEST(ClientHelloParserTest, NoServerName) {
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(TLS1_VERSION, TLS1_VERSION, "", "");
+  absl::string_view server_name = "stale";
+  EXPECT_EQ(ClientHelloParseResult::Complete, parse(data, data.size(), server_name));
+  EXPECT_TRUE(server_name.empty());
+}
+
+// Every prefix of a supported ClientHello needs more data.
+TEST(ClientHelloParserTest, Prefixes) {
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(TLS1_VERSION, TLS1_3_VERSION, "example.com", "\x02h2");
+  absl::string_view server_name;
+  for (size_t len = 0; len < data.size(); len++) {
+    EXPECT_EQ(ClientHelloParseResult::NeedMoreData, parse(data, len, server_name)) << len;
+  }
+}
+
+TEST(ClientHelloParserTest, NotTls) {
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse({'G', 'E', 'T', ' '}));
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(std::vector<uint8_t>(100)));
+  // A handshake record with another handshake message.
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parse({0x16, 0x03, 0x01, 0x00, 0x04, SSL3_MT_SERVER_HELLO}));
+}
+
+TEST(ClientHelloParserTest, FragmentedClientHello) {
+  std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(TLS1_VERSION, TLS1_3_VERSION, "example.com", "");
+  // Shorten the first record to a part of the ClientHello; the rest would follow in other records.
+  const uint16_t record_length = ((data[3] << 8) | data[4]) - 1;
+  data[3] = record_length >> 8;
+  data[4] = record_length & 0xff;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(data));
+}
+
+TEST(ClientHelloParserTest, UnsupportedVersion) {
+  // SSLv3, in both the record and the ClientHello.
+  std::vector<uint8_t> data =
+      Tls::Test::generateClientHelloFromJA3Fingerprint("768,47-53,0-10-11,23-24,0");
+  data[2] = 0x00;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(data));
+}
+
+TEST(ClientHelloParserTest, MalformedExtensions) {
+  // The server name extension of generateClientHelloFromJA3Fingerprint() names www.envoyproxy.io.
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHelloFromJA3Fingerprint("771,47-53,0-10-11,23-24,0");
+  ASSERT_EQ(ClientHelloParseResult::Complete, parse(data));
+
+  // A NUL byte in the host name.
+  std::vector<uint8_t> bad = data;
+  const std::string host_name = "www.envoyproxy.io";
+  const auto name = std::search(bad.begin(), bad.end(), host_name.begin(), host_name.end());
+  ASSERT_NE(bad.end(), name);
+  *name = '\0';
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(bad));
+
+  // Point formats without the uncompressed one.
+  bad = data;
+  ASSERT_EQ(0, bad.back());
+  bad.back() = 1;
+  EXPECT_EQ(ClientHelloParseResult::Unsupported, parse(bad));
+
+  // The same extension twice.
+  EXPECT_EQ(ClientHelloParseResult::Unsupported,
+            parse(Tls::Test::generateClientHelloFromJA3Fingerprint("771,47-53,10-10,23-24,0")));
+}
+
+} // namespace
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
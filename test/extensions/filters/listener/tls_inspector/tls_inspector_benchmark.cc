@@ -11,6 +11,7 @@
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "benchmark/benchmark.h"
@@ -65,7 +66,11 @@ public:
   const std::vector<uint8_t> client_hello_;
 };
 
+// Args: whether the native ClientHello parser is enabled.
 static void BM_TlsInspector(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.tls_inspector_native_client_hello_parser",
+                               state.range(0) != 0 ? "true" : "false"}});
   NiceMock<FastMockOsSysCalls> os_sys_calls(Tls::Test::generateClientHello(
       Config::TLS_MIN_SUPPORTED_VERSION, Config::TLS_MAX_SUPPORTED_VERSION, "example.com",
       "\x02h2\x08http/1.1"));
@@ -100,7 +105,7 @@ static void BM_TlsInspector(benchmark::State& state) {
   }
 }
 
-BENCHMARK(BM_TlsInspector)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TlsInspector)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
 
 } // namespace TlsInspector
 } // namespace ListenerFilters
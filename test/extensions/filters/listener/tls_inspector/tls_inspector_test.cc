@@ -8,6 +8,7 @@
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "absl/strings/str_format.h"
@@ -210,6 +211,64 @@ TEST_P(TlsInspectorTest, MultipleReads) {
   EXPECT_EQ(1, cfg_->stats().alpn_found_.value());
 }
 
+// Test with a ClientHello fragmented over two records, which the native parser leaves to
+// BoringSSL.
+TEST_P(TlsInspectorTest, FragmentedClientHello) {
+  init();
+  const auto alpn_protos = std::vector<absl::string_view>{Http::Utility::AlpnNames::get().Http2};
+  const std::string servername("example.com");
+  const std::vector<uint8_t> record = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), servername, "\x02h2");
+  const size_t header_size = 5;
+  const size_t first_size = (record.size() - header_size) / 2;
+  const size_t second_size = record.size() - header_size - first_size;
+  std::vector<uint8_t> client_hello(record.begin(), record.begin() + header_size + first_size);
+  client_hello[3] = first_size >> 8;
+  client_hello[4] = first_size & 0xff;
+  client_hello.insert(client_hello.end(),
+                      {record[0], record[1], record[2], static_cast<uint8_t>(second_size >> 8),
+                       static_cast<uint8_t>(second_size & 0xff)});
+  client_hello.insert(client_hello.end(), record.begin() + header_size + first_size, record.end());
+  mockSysCallForPeek(client_hello);
+  EXPECT_CALL(socket_, setRequestedServerName(Eq(servername)));
+  EXPECT_CALL(socket_, setRequestedApplicationProtocols(alpn_protos));
+  EXPECT_CALL(socket_, setDetectedTransportProtocol(absl::string_view("tls")));
+  EXPECT_CALL(socket_, detectedTransportProtocol()).Times(::testing::AnyNumber());
+  // trigger the event to copy the client hello message into buffer
+  file_event_callback_(Event::FileReadyType::Read);
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_found_.value());
+  EXPECT_EQ(1, cfg_->stats().sni_found_.value());
+  EXPECT_EQ(1, cfg_->stats().alpn_found_.value());
+}
+
+// Test that the ClientHello is inspected the same with the native parser disabled.
+TEST_P(TlsInspectorTest, NativeParserDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.tls_inspector_native_client_hello_parser", "false"}});
+  cfg_ = std::make_shared<Config>(
+      *store_.rootScope(), envoy::extensions::filters::listener::tls_inspector::v3::TlsInspector());
+  init();
+  const auto alpn_protos = std::vector<absl::string_view>{Http::Utility::AlpnNames::get().Http2};
+  const std::string servername("example.com");
+  std::vector<uint8_t> client_hello = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), servername, "\x02h2");
+  mockSysCallForPeek(client_hello);
+  EXPECT_CALL(socket_, setRequestedServerName(Eq(servername)));
+  EXPECT_CALL(socket_, setRequestedApplicationProtocols(alpn_protos));
+  EXPECT_CALL(socket_, setDetectedTransportProtocol(absl::string_view("tls")));
+  EXPECT_CALL(socket_, detectedTransportProtocol()).Times(::testing::AnyNumber());
+  // trigger the event to copy the client hello message into buffer
+  file_event_callback_(Event::FileReadyType::Read);
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_found_.value());
+  EXPECT_EQ(1, cfg_->stats().sni_found_.value());
+  EXPECT_EQ(1, cfg_->stats().alpn_found_.value());
+}
+
 // Test that the filter correctly handles a ClientHello with no extensions present.
 TEST_P(TlsInspectorTest, NoExtensions) {
   init();
@@ -275,6 +275,52 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+TEST_F(RedisEncoderDecoderImplTest, LargeBulkString) {
+  RespValue value;
+  value.type(RespType::BulkString);
+  value.asString() = std::string(DecoderImpl::DefaultBulkStringBufferThreshold * 4, 'v');
+  encoder_.encode(value, buffer_);
+  const std::string encoded = buffer_.toString();
+
+  // Decode the value in two parts, the first ending in the middle of the bulk string body.
+  Buffer::OwnedImpl first_part;
+  first_part.move(buffer_, DecoderImpl::DefaultBulkStringBufferThreshold);
+  decoder_.decode(first_part);
+  EXPECT_EQ(0UL, first_part.length());
+  EXPECT_TRUE(decoded_values_.empty());
+  decoder_.decode(buffer_);
+  EXPECT_EQ(0UL, buffer_.length());
+  ASSERT_EQ(1UL, decoded_values_.size());
+
+  // The body is held by a buffer, and is encoded again from its slices.
+  const RespValue& decoded = *decoded_values_[0];
+  ASSERT_NE(nullptr, decoded.bulkStringBuffer());
+  EXPECT_EQ(value.asString().size(), decoded.bulkStringBuffer()->length());
+  Buffer::OwnedImpl reencoded;
+  encoder_.encode(decoded, reencoded);
+  EXPECT_EQ(encoded, reencoded.toString());
+  EXPECT_EQ(value, decoded);
+
+  // The non-const accessor releases the buffer.
+  RespValue copy = decoded;
+  EXPECT_EQ(decoded.bulkStringBuffer(), copy.bulkStringBuffer());
+  copy.asString().push_back('w');
+  EXPECT_EQ(nullptr, copy.bulkStringBuffer());
+  EXPECT_NE(nullptr, decoded.bulkStringBuffer());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, LargeBulkStringDisabled) {
+  DecoderImpl decoder(*this, 0);
+  RespValue value;
+  value.type(RespType::BulkString);
+  value.asString() = std::string(DecoderImpl::DefaultBulkStringBufferThreshold * 4, 'v');
+  encoder_.encode(value, buffer_);
+  decoder.decode(buffer_);
+  ASSERT_EQ(1UL, decoded_values_.size());
+  EXPECT_EQ(nullptr, decoded_values_[0]->bulkStringBuffer());
+  EXPECT_EQ(value, *decoded_values_[0]);
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
@@ -136,7 +136,7 @@ TEST_F(RateLimitFilterTest, OK) {
   EXPECT_CALL(*client_, limit(_, "foo",
                               testing::ContainerEq(std::vector<RateLimit::Descriptor>{
                                   {{{"hello", "world"}, {"foo", "bar"}}}, {{{"foo2", "bar2"}}}}),
-                              testing::A<Tracing::Span&>(), _))
+                              testing::A<Tracing::Span&>(), _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -173,7 +173,7 @@ TEST_F(RateLimitFilterTest, SubstitutionFormatterTest1) {
   EXPECT_CALL(*client_, limit(_, "foo",
                               testing::ContainerEq(std::vector<RateLimit::Descriptor>{
                                   {{{"remote_address", "8.8.8.8"}, {"hello", "HTTP/1.1"}}}}),
-                              testing::A<Tracing::Span&>(), _))
+                              testing::A<Tracing::Span&>(), _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -224,7 +224,7 @@ TEST_F(RateLimitFilterTest, SubstitutionFormatterTest2) {
   EXPECT_CALL(*client_, limit(_, "foo",
                               testing::ContainerEq(std::vector<RateLimit::Descriptor>{
                                   {{{"remote_address", "8.8.8.8"}, {"hello", "world"}}}}),
-                              testing::A<Tracing::Span&>(), _))
+                              testing::A<Tracing::Span&>(), _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -254,7 +254,7 @@ TEST_F(RateLimitFilterTest, OverLimit) {
   InSequence s;
   setUpTest(filter_config_);
 
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -280,7 +280,7 @@ TEST_F(RateLimitFilterTest, OverLimitWithDynamicMetadata) {
   InSequence s;
   setUpTest(filter_config_);
 
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -320,7 +320,7 @@ TEST_F(RateLimitFilterTest, OverLimitNotEnforcing) {
   InSequence s;
   setUpTest(filter_config_);
 
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -349,7 +349,7 @@ TEST_F(RateLimitFilterTest, Error) {
   InSequence s;
   setUpTest(filter_config_);
 
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -377,7 +377,7 @@ TEST_F(RateLimitFilterTest, Disconnect) {
   InSequence s;
   setUpTest(filter_config_);
 
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -398,7 +398,7 @@ TEST_F(RateLimitFilterTest, ImmediateOK) {
   setUpTest(filter_config_);
 
   EXPECT_CALL(filter_callbacks_, continueReading()).Times(0);
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             callbacks.complete(Filters::Common::RateLimit::LimitStatus::OK, nullptr, nullptr,
@@ -422,7 +422,7 @@ TEST_F(RateLimitFilterTest, ImmediateError) {
   setUpTest(filter_config_);
 
   EXPECT_CALL(filter_callbacks_, continueReading()).Times(0);
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             callbacks.complete(Filters::Common::RateLimit::LimitStatus::Error, nullptr, nullptr,
@@ -448,7 +448,7 @@ TEST_F(RateLimitFilterTest, RuntimeDisable) {
 
   EXPECT_CALL(runtime_.snapshot_, featureEnabled("ratelimit.tcp_filter_enabled", 100))
       .WillOnce(Return(false));
-  EXPECT_CALL(*client_, limit(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(*client_, limit(_, _, _, _, _, _)).Times(0);
 
   EXPECT_EQ(Network::FilterStatus::Continue, filter_->onNewConnection());
   Buffer::OwnedImpl data("hello");
@@ -459,7 +459,7 @@ TEST_F(RateLimitFilterTest, ErrorResponseWithFailureModeAllowOff) {
   InSequence s;
   setUpTest(fail_close_config_);
 
-  EXPECT_CALL(*client_, limit(_, "foo", _, _, _))
+  EXPECT_CALL(*client_, limit(_, "foo", _, _, _, _))
       .WillOnce(
           WithArgs<0>(Invoke([&](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks_ = &callbacks;
@@ -548,7 +548,7 @@ stat_prefix: name
   EXPECT_CALL(*rl_client, limit(_, "foo",
                                 testing::ContainerEq(
                                     std::vector<RateLimit::Descriptor>{{{{"hello", "world"}}}}),
-                                testing::A<Tracing::Span&>(), _))
+                                testing::A<Tracing::Span&>(), _, _))
       .WillOnce(WithArgs<0>(
           Invoke([&](Extensions::Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
             request_callbacks = &callbacks;
@@ -8,6 +8,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/network/common/redis/client_impl.h"
+#include "source/extensions/filters/network/common/redis/codec_impl.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
@@ -83,6 +84,52 @@ public:
     }
   }
 };
+
+// Decodes SET requests received from downstream and encodes them again to forward them, as done
+// for each request sent upstream.
+class ForwardSpeedTest : public Common::Redis::DecoderCallbacks {
+public:
+  ForwardSpeedTest(uint64_t value_size, uint64_t bulk_string_buffer_threshold)
+      : decoder_(*this, bulk_string_buffer_threshold) {
+    Common::Redis::RespValue request;
+    std::vector<Common::Redis::RespValue> values(3);
+    for (auto& value : values) {
+      value.type(Common::Redis::RespType::BulkString);
+    }
+    values[0].asString() = "set";
+    values[1].asString() = std::string(36, 'k');
+    values[2].asString() = std::string(value_size, 'v');
+    request.type(Common::Redis::RespType::Array);
+    request.asArray().swap(values);
+    encoder_.encode(request, encoded_request_);
+  }
+
+  void forward() {
+    // Slice the request as read from a socket.
+    Buffer::OwnedImpl downstream;
+    for (const Buffer::RawSlice& slice : encoded_request_.getRawSlices()) {
+      for (uint64_t offset = 0; offset < slice.len_; offset += ReadSize) {
+        downstream.appendSliceForTest(static_cast<const char*>(slice.mem_) + offset,
+                                      std::min(ReadSize, slice.len_ - offset));
+      }
+    }
+    decoder_.decode(downstream);
+    Buffer::OwnedImpl upstream;
+    encoder_.encode(*request_, upstream);
+    upstream.drain(upstream.length());
+  }
+
+  // Common::Redis::DecoderCallbacks
+  void onRespValue(Common::Redis::RespValuePtr&& value) override { request_ = std::move(value); }
+
+private:
+  static constexpr uint64_t ReadSize = 16 * 1024;
+
+  Common::Redis::DecoderImpl decoder_;
+  Common::Redis::EncoderImpl encoder_;
+  Buffer::OwnedImpl encoded_request_;
+  Common::Redis::RespValuePtr request_;
+};
 } // namespace RedisProxy
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -129,3 +176,23 @@ static void BM_Split_CreateVariant(benchmark::State& state) {
   state.counters["use_count"] = request.use_count();
 }
 BENCHMARK(BM_Split_CreateVariant)->Ranges({{1, 100}, {64, 8 << 14}});
+
+static void BM_Forward_BulkStringCopy(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::ForwardSpeedTest context(state.range(0), 0);
+  for (auto _ : state) {
+    context.forward();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Forward_BulkStringCopy)->Range(1 << 10, 1 << 20);
+
+static void BM_Forward_BulkStringBuffer(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::ForwardSpeedTest context(
+      state.range(0),
+      Envoy::Extensions::NetworkFilters::Common::Redis::DecoderImpl::DefaultBulkStringBufferThreshold);
+  for (auto _ : state) {
+    context.forward();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Forward_BulkStringBuffer)->Range(1 << 10, 1 << 20);
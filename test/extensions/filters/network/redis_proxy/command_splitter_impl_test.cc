@@ -15,6 +15,7 @@
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
 
 using testing::_;
 using testing::DoAll;
@@ -1162,6 +1163,117 @@ INSTANTIATE_TEST_SUITE_P(RedisSingleServerRequestWithDelayFaultTest,
                          RedisSingleServerRequestWithDelayFaultTest,
                          testing::ValuesIn(Common::Redis::SupportedCommands::simpleCommands()));
 
+class RedisLocalCacheTest : public testing::Test {
+public:
+  RedisLocalCacheTest() {
+    TestUtility::loadFromYaml("ttl: 10s", cache_config_);
+    cache_ = std::make_shared<LocalCache>(cache_config_, time_system_, *store_.rootScope(),
+                                          "redis.foo.local_cache.");
+    splitter_ = std::make_unique<InstanceImpl>(
+        std::make_unique<NiceMock<MockRouter>>(route_), *store_.rootScope(), "redis.foo.",
+        time_system_, false, std::make_unique<NiceMock<MockFaultManager>>(), cache_);
+  }
+
+  Common::Redis::RespValuePtr makeBulkStringArray(const std::vector<std::string>& strings) {
+    Common::Redis::RespValuePtr value{new Common::Redis::RespValue()};
+    std::vector<Common::Redis::RespValue> values(strings.size());
+    for (uint64_t i = 0; i < strings.size(); i++) {
+      values[i].type(Common::Redis::RespType::BulkString);
+      values[i].asString() = strings[i];
+    }
+    value->type(Common::Redis::RespType::Array);
+    value->asArray().swap(values);
+    return value;
+  }
+
+  Common::Redis::RespValuePtr makeBulkString(const std::string& string) {
+    Common::Redis::RespValuePtr value{new Common::Redis::RespValue()};
+    value->type(Common::Redis::RespType::BulkString);
+    value->asString() = string;
+    return value;
+  }
+
+  // Makes a request which is forwarded to the upstream and responds to it.
+  void forward(const std::vector<std::string>& request, const std::string& response) {
+    ConnPool::PoolCallbacks* pool_callbacks;
+    EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+    EXPECT_CALL(*conn_pool_, makeRequest_(request[1], _, _))
+        .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks)), Return(&pool_request_)));
+    SplitRequestPtr handle = splitter_->makeRequest(makeBulkStringArray(request), callbacks_,
+                                                    dispatcher_);
+    EXPECT_NE(nullptr, handle);
+
+    Common::Redis::RespValuePtr upstream_response = makeBulkString(response);
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(upstream_response.get())));
+    pool_callbacks->onResponse(std::move(upstream_response));
+  }
+
+  envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::LocalCache cache_config_;
+  ConnPool::MockInstance* conn_pool_{new ConnPool::MockInstance()};
+  std::shared_ptr<NiceMock<MockRoute>> route_{
+      new NiceMock<MockRoute>(ConnPool::InstanceSharedPtr{conn_pool_})};
+  NiceMock<Stats::MockIsolatedStatsStore> store_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Event::SimulatedTimeSystem time_system_;
+  LocalCacheSharedPtr cache_;
+  std::unique_ptr<InstanceImpl> splitter_;
+  MockSplitCallbacks callbacks_;
+  Common::Redis::Client::MockPoolRequest pool_request_;
+};
+
+TEST_F(RedisLocalCacheTest, HitAndInvalidation) {
+  InSequence s;
+
+  forward({"get", "hello"}, "world");
+  EXPECT_EQ(1UL, store_.counter("redis.foo.local_cache.miss").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.local_cache.insert").value());
+
+  // Served from the cache, without an upstream request.
+  Common::Redis::RespValuePtr cached_response = makeBulkString("world");
+  EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(cached_response.get())));
+  EXPECT_EQ(nullptr,
+            splitter_->makeRequest(makeBulkStringArray({"get", "hello"}), callbacks_, dispatcher_));
+  EXPECT_EQ(1UL, store_.counter("redis.foo.local_cache.hit").value());
+  EXPECT_EQ(2UL, store_.counter("redis.foo.command.get.success").value());
+
+  // A write through the filter invalidates the key.
+  forward({"set", "hello", "again"}, "OK");
+  EXPECT_EQ(1UL, store_.counter("redis.foo.local_cache.invalidated").value());
+
+  forward({"get", "hello"}, "again");
+  EXPECT_EQ(2UL, store_.counter("redis.foo.local_cache.miss").value());
+}
+
+TEST_F(RedisLocalCacheTest, WriteDuringRead) {
+  InSequence s;
+
+  ConnPool::PoolCallbacks* pool_callbacks;
+  EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+  EXPECT_CALL(*conn_pool_, makeRequest_("hello", _, _))
+      .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks)), Return(&pool_request_)));
+  SplitRequestPtr handle =
+      splitter_->makeRequest(makeBulkStringArray({"get", "hello"}), callbacks_, dispatcher_);
+  EXPECT_NE(nullptr, handle);
+
+  // The write is made while the read is pending, so the read may return the old value.
+  forward({"set", "hello", "again"}, "OK");
+
+  EXPECT_CALL(callbacks_, onResponse_(_));
+  pool_callbacks->onResponse(makeBulkString("world"));
+  EXPECT_EQ(0UL, store_.counter("redis.foo.local_cache.insert").value());
+}
+
+TEST_F(RedisLocalCacheTest, Expiry) {
+  InSequence s;
+
+  forward({"get", "hello"}, "world");
+  time_system_.advanceTimeWait(std::chrono::seconds(11));
+  forward({"get", "hello"}, "again");
+  EXPECT_EQ(2UL, store_.counter("redis.foo.local_cache.miss").value());
+  EXPECT_EQ(0UL, store_.counter("redis.foo.local_cache.hit").value());
+}
+
 } // namespace CommandSplitter
 } // namespace RedisProxy
 } // namespace NetworkFilters
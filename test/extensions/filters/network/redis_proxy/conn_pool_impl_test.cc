@@ -18,6 +18,7 @@
 #include "test/extensions/filters/network/common/redis/test_utils.h"
 #include "test/extensions/filters/network/redis_proxy/mocks.h"
 #include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/upstream/cluster.h"
 #include "test/mocks/upstream/cluster_manager.h"
@@ -35,6 +36,7 @@ using testing::DoAll;
 using testing::Eq;
 using testing::InSequence;
 using testing::Invoke;
+using testing::Pointee;
 using testing::Ref;
 using testing::Return;
 using testing::ReturnNew;
@@ -82,11 +84,15 @@ public:
         std::make_shared<NiceMock<Extensions::Common::Redis::MockClusterRefreshManager>>();
     auto redis_command_stats =
         Common::Redis::RedisCommandStats::createRedisCommandStats(store_.symbolTable());
+    auto settings = Common::Redis::Client::createConnPoolSettings(20, hashtagging, true,
+                                                                  max_unknown_conns, read_policy_);
+    if (get_coalescing_max_batch_size_ > 0) {
+      settings.mutable_get_coalescing()->mutable_max_batch_size()->set_value(
+          get_coalescing_max_batch_size_);
+    }
     std::shared_ptr<InstanceImpl> conn_pool_impl = std::make_shared<InstanceImpl>(
-        cluster_name_, cm_, *this, tls_,
-        Common::Redis::Client::createConnPoolSettings(20, hashtagging, true, max_unknown_conns,
-                                                      read_policy_),
-        api_, store_.rootScope(), redis_command_stats, cluster_refresh_manager_, dns_cache);
+        cluster_name_, cm_, *this, tls_, settings, api_, store_.rootScope(), redis_command_stats,
+        cluster_refresh_manager_, dns_cache);
     conn_pool_impl->init();
     // Set the authentication password for this connection pool.
     conn_pool_impl->tls_->getTyped<InstanceImpl::ThreadLocalPool>().auth_username_ = auth_username_;
@@ -315,6 +321,7 @@ public:
   std::shared_ptr<NiceMock<Extensions::Common::Redis::MockClusterRefreshManager>>
       cluster_refresh_manager_;
   Common::Redis::Client::NoOpTransaction transaction_;
+  uint32_t get_coalescing_max_batch_size_{};
 };
 
 TEST_F(RedisConnPoolImplTest, Basic) {
@@ -1107,6 +1114,43 @@ TEST_F(RedisConnPoolImplTest, MovedRedirectionSuccess) {
   tls_.shutdownThread();
 }
 
+TEST_F(RedisConnPoolImplTest, MovedRedirectionPatchesRedisClusterSlot) {
+  envoy::config::cluster::v3::Cluster::CustomClusterType cluster_type;
+  cluster_type.set_name("envoy.clusters.redis");
+  EXPECT_CALL(*cm_.thread_local_cluster_.cluster_.info_, clusterType())
+      .WillOnce(Return(
+          makeOptRef<const envoy::config::cluster::v3::Cluster::CustomClusterType>(cluster_type)));
+  EXPECT_CALL(*cm_.thread_local_cluster_.cluster_.info_, lbType())
+      .WillOnce(Return(Upstream::LoadBalancerType::ClusterProvided));
+
+  setup();
+
+  Common::Redis::RespValueSharedPtr request_value = std::make_shared<Common::Redis::RespValue>();
+  Common::Redis::Client::MockPoolRequest active_request;
+  MockPoolCallbacks callbacks;
+  Common::Redis::Client::MockClient* client = new NiceMock<Common::Redis::Client::MockClient>();
+  makeRequest(client, request_value, callbacks, active_request);
+
+  Common::Redis::Client::MockPoolRequest active_request2;
+  Common::Redis::Client::MockClient* client2 = new NiceMock<Common::Redis::Client::MockClient>();
+
+  Common::Redis::RespValuePtr moved_response{new Common::Redis::RespValue()};
+  moved_response->type(Common::Redis::RespType::Error);
+  moved_response->asString() = "MOVED 1111 10.1.2.3:4000";
+
+  EXPECT_CALL(*this, create_(_)).WillOnce(Return(client2));
+  EXPECT_CALL(*client2, makeRequest_(Ref(*request_value), _)).WillOnce(Return(&active_request2));
+  EXPECT_CALL(*cluster_refresh_manager_, onRedirection("fake_cluster"));
+  EXPECT_CALL(*cluster_refresh_manager_, onSlotMoved("fake_cluster", 1111, "10.1.2.3:4000"));
+  client->client_callbacks_.back()->onRedirection(std::move(moved_response), "10.1.2.3:4000",
+                                                  false);
+
+  respond(callbacks, client2);
+
+  EXPECT_CALL(*client, close());
+  tls_.shutdownThread();
+}
+
 TEST_F(RedisConnPoolImplTest, MovedRedirectionSuccessWithDNSEntryCached) {
   InSequence s;
 
@@ -1503,6 +1547,113 @@ TEST_F(RedisConnPoolImplTest, MakeRequestAndRedirectFollowedByDelete) {
   tls_.shutdownThread();
 }
 
+Common::Redis::RespValue makeCommand(const std::vector<std::string>& strings) {
+  std::vector<Common::Redis::RespValue> values(strings.size());
+  for (uint64_t i = 0; i < strings.size(); i++) {
+    values[i].type(Common::Redis::RespType::BulkString);
+    values[i].asString() = strings[i];
+  }
+  Common::Redis::RespValue value;
+  value.type(Common::Redis::RespType::Array);
+  value.asArray().swap(values);
+  return value;
+}
+
+TEST_F(RedisConnPoolImplTest, GetCoalescing) {
+  get_coalescing_max_batch_size_ = 3;
+  setup();
+
+  Common::Redis::Client::MockClient* client = new NiceMock<Common::Redis::Client::MockClient>();
+  Common::Redis::Client::MockPoolRequest active_request;
+  EXPECT_CALL(cm_.thread_local_cluster_.lb_, chooseHost(_))
+      .WillRepeatedly(Return(cm_.thread_local_cluster_.lb_.host_));
+  EXPECT_CALL(*cm_.thread_local_cluster_.lb_.host_, address())
+      .WillRepeatedly(Return(test_address_));
+  EXPECT_CALL(*this, create_(_)).WillOnce(Return(client));
+  Event::MockTimer* window_timer = new NiceMock<Event::MockTimer>(&tls_.dispatcher_);
+
+  // Nothing is outstanding, so the first GET is sent right away.
+  MockPoolCallbacks callbacks_a;
+  EXPECT_CALL(*client, makeRequest_(Eq(makeCommand({"GET", "a"})), _))
+      .WillOnce(Return(&active_request));
+  EXPECT_NE(nullptr,
+            conn_pool_->makeRequest("a", Common::Redis::RespValue(makeCommand({"GET", "a"})),
+                                    callbacks_a, transaction_));
+
+  // The next ones wait for it.
+  MockPoolCallbacks callbacks_b, callbacks_c;
+  EXPECT_CALL(*window_timer, enableTimer(std::chrono::milliseconds(1), _));
+  EXPECT_NE(nullptr,
+            conn_pool_->makeRequest("b", Common::Redis::RespValue(makeCommand({"get", "b"})),
+                                    callbacks_b, transaction_));
+  EXPECT_NE(nullptr,
+            conn_pool_->makeRequest("c", Common::Redis::RespValue(makeCommand({"get", "c"})),
+                                    callbacks_c, transaction_));
+
+  // Once the first one completes, they're sent as an MGET.
+  Common::Redis::Client::ClientCallbacks* get_callbacks = client->client_callbacks_.back();
+  EXPECT_CALL(callbacks_a, onResponse_(_));
+  EXPECT_CALL(*client, makeRequest_(Eq(makeCommand({"mget", "b", "c"})), _))
+      .WillOnce(Return(&active_request));
+  get_callbacks->onResponse(std::make_unique<Common::Redis::RespValue>());
+
+  Common::Redis::RespValue value_b;
+  value_b.type(Common::Redis::RespType::BulkString);
+  value_b.asString() = "B";
+  Common::Redis::RespValue value_c;
+  value_c.type(Common::Redis::RespType::Null);
+  auto mget_response = std::make_unique<Common::Redis::RespValue>();
+  mget_response->type(Common::Redis::RespType::Array);
+  mget_response->asArray() = {value_b, value_c};
+  EXPECT_CALL(callbacks_b, onResponse_(Pointee(Eq(value_b))));
+  EXPECT_CALL(callbacks_c, onResponse_(Pointee(Eq(value_c))));
+  client->client_callbacks_.back()->onResponse(std::move(mget_response));
+  EXPECT_EQ(0, threadLocalPool().pending_requests_.size());
+
+  EXPECT_CALL(*client, close());
+  tls_.shutdownThread();
+}
+
+TEST_F(RedisConnPoolImplTest, GetCoalescingCancelAndWindow) {
+  get_coalescing_max_batch_size_ = 3;
+  setup();
+
+  Common::Redis::Client::MockClient* client = new NiceMock<Common::Redis::Client::MockClient>();
+  Common::Redis::Client::MockPoolRequest active_request, window_request;
+  EXPECT_CALL(cm_.thread_local_cluster_.lb_, chooseHost(_))
+      .WillRepeatedly(Return(cm_.thread_local_cluster_.lb_.host_));
+  EXPECT_CALL(*cm_.thread_local_cluster_.lb_.host_, address())
+      .WillRepeatedly(Return(test_address_));
+  EXPECT_CALL(*this, create_(_)).WillOnce(Return(client));
+  Event::MockTimer* window_timer = new NiceMock<Event::MockTimer>(&tls_.dispatcher_);
+
+  MockPoolCallbacks callbacks_a, callbacks_b, callbacks_c;
+  EXPECT_CALL(*client, makeRequest_(Eq(makeCommand({"get", "a"})), _))
+      .WillOnce(Return(&active_request));
+  EXPECT_NE(nullptr,
+            conn_pool_->makeRequest("a", Common::Redis::RespValue(makeCommand({"get", "a"})),
+                                    callbacks_a, transaction_));
+  Common::Redis::Client::PoolRequest* request_b = conn_pool_->makeRequest(
+      "b", Common::Redis::RespValue(makeCommand({"get", "b"})), callbacks_b, transaction_);
+  EXPECT_NE(nullptr,
+            conn_pool_->makeRequest("c", Common::Redis::RespValue(makeCommand({"get", "c"})),
+                                    callbacks_c, transaction_));
+
+  // The cancelled GET isn't sent, and the other one is sent alone once the window elapses.
+  request_b->cancel();
+  EXPECT_CALL(*client, makeRequest_(Eq(makeCommand({"get", "c"})), _))
+      .WillOnce(Return(&window_request));
+  window_timer->invokeCallback();
+
+  EXPECT_CALL(active_request, cancel());
+  EXPECT_CALL(window_request, cancel());
+  EXPECT_CALL(callbacks_a, onFailure_());
+  EXPECT_CALL(callbacks_b, onFailure_()).Times(0);
+  EXPECT_CALL(callbacks_c, onFailure_());
+  EXPECT_CALL(*client, close());
+  tls_.shutdownThread();
+}
+
 } // namespace ConnPool
 } // namespace RedisProxy
 } // namespace NetworkFilters
@@ -0,0 +1,142 @@
+#include <string>
+#include <vector>
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/network/redis_proxy/local_cache.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+class RedisLocalCacheTest : public testing::Test {
+public:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::LocalCache config;
+    TestUtility::loadFromYaml(yaml, config);
+    cache_ = std::make_unique<LocalCache>(config, time_system_, *store_.rootScope(),
+                                          "local_cache.");
+  }
+
+  static Common::Redis::RespValue makeBulkString(const std::string& string) {
+    Common::Redis::RespValue value;
+    value.type(Common::Redis::RespType::BulkString);
+    value.asString() = string;
+    return value;
+  }
+
+  static Common::Redis::RespValue makeRequest(const std::vector<std::string>& strings) {
+    Common::Redis::RespValue value;
+    std::vector<Common::Redis::RespValue> values;
+    for (const std::string& string : strings) {
+      values.push_back(makeBulkString(string));
+    }
+    value.type(Common::Redis::RespType::Array);
+    value.asArray().swap(values);
+    return value;
+  }
+
+  void insert(const std::string& key, const std::string& value) {
+    cache_->insert(key, "get", cache_->generation(key), makeBulkString(value));
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(store_, "local_cache." + name)->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl store_;
+  std::unique_ptr<LocalCache> cache_;
+};
+
+TEST_F(RedisLocalCacheTest, Commands) {
+  initialize("ttl: 1s");
+  EXPECT_TRUE(cache_->cachesCommand("get"));
+  EXPECT_FALSE(cache_->cachesCommand("hget"));
+
+  initialize(R"EOF(
+ttl: 1s
+commands: ["HGET", "strlen"]
+)EOF");
+  EXPECT_FALSE(cache_->cachesCommand("get"));
+  EXPECT_TRUE(cache_->cachesCommand("hget"));
+  EXPECT_TRUE(cache_->cachesCommand("strlen"));
+}
+
+TEST_F(RedisLocalCacheTest, RequestKey) {
+  EXPECT_EQ("get", LocalCache::requestKey(makeRequest({"GET", "key"})));
+  EXPECT_EQ("hget;5:field", LocalCache::requestKey(makeRequest({"hget", "key", "field"})));
+  EXPECT_NE(LocalCache::requestKey(makeRequest({"getrange", "key", "1", "23"})),
+            LocalCache::requestKey(makeRequest({"getrange", "key", "12", "3"})));
+}
+
+TEST_F(RedisLocalCacheTest, LookupAndExpiry) {
+  initialize("ttl: 1s");
+  EXPECT_EQ(nullptr, cache_->lookup("key", "get"));
+
+  insert("key", "value");
+  Common::Redis::RespValuePtr response = cache_->lookup("key", "get");
+  ASSERT_NE(nullptr, response);
+  EXPECT_EQ(makeBulkString("value"), *response);
+  EXPECT_EQ(nullptr, cache_->lookup("key", "strlen"));
+  EXPECT_EQ(1UL, counter("hit"));
+  EXPECT_EQ(2UL, counter("miss"));
+  EXPECT_GT(TestUtility::findGauge(store_, "local_cache.bytes")->value(), 0UL);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(nullptr, cache_->lookup("key", "get"));
+  EXPECT_EQ(0UL, TestUtility::findGauge(store_, "local_cache.bytes")->value());
+}
+
+TEST_F(RedisLocalCacheTest, ErrorsNotCached) {
+  initialize("ttl: 1s");
+  Common::Redis::RespValue error;
+  error.type(Common::Redis::RespType::Error);
+  error.asString() = "WRONGTYPE";
+  cache_->insert("key", "get", cache_->generation("key"), error);
+  EXPECT_EQ(nullptr, cache_->lookup("key", "get"));
+  EXPECT_EQ(0UL, counter("insert"));
+}
+
+TEST_F(RedisLocalCacheTest, Invalidation) {
+  initialize("ttl: 1s");
+  insert("key", "value");
+  cache_->invalidate("key");
+  EXPECT_EQ(nullptr, cache_->lookup("key", "get"));
+  EXPECT_EQ(1UL, counter("invalidated"));
+
+  // A response requested before the invalidation isn't inserted.
+  const uint64_t generation = cache_->generation("key");
+  cache_->invalidate("key");
+  cache_->insert("key", "get", generation, makeBulkString("value"));
+  EXPECT_EQ(nullptr, cache_->lookup("key", "get"));
+  EXPECT_EQ(1UL, counter("insert"));
+}
+
+TEST_F(RedisLocalCacheTest, Eviction) {
+  // Small enough for each shard to only hold one of the values.
+  initialize(R"EOF(
+ttl: 100s
+max_bytes: 6400
+)EOF");
+  const std::string value(100, 'v');
+  for (int i = 0; i < 100; i++) {
+    insert(absl::StrCat("key", i), value);
+  }
+  EXPECT_GT(counter("evicted"), 0UL);
+  EXPECT_LE(TestUtility::findGauge(store_, "local_cache.bytes")->value(), 6400);
+  // The last inserted key is the most recently used one of its shard.
+  EXPECT_NE(nullptr, cache_->lookup("key99", "get"));
+}
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
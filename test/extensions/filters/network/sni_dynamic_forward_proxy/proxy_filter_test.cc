@@ -11,6 +11,7 @@
 #include "test/mocks/upstream/basic_resource_limit.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/mocks/upstream/transport_socket_match.h"
+#include "test/test_common/test_runtime.h"
 
 using testing::AtLeast;
 using testing::Eq;
@@ -28,6 +29,7 @@ using LoadDnsCacheEntryStatus =
     Extensions::Common::DynamicForwardProxy::DnsCache::LoadDnsCacheEntryStatus;
 using MockLoadDnsCacheEntryResult =
     Extensions::Common::DynamicForwardProxy::MockDnsCache::MockLoadDnsCacheEntryResult;
+using MockDnsHostInfo = Extensions::Common::DynamicForwardProxy::MockDnsHostInfo;
 
 class SniDynamicProxyFilterTest
     : public testing::Test,
@@ -211,10 +213,8 @@ TEST_F(SniDynamicProxyFilterTest, LoadDnsCacheWithPortAboveLimitFromFilterState)
 
 TEST_F(SniDynamicProxyFilterTest, LoadDnsInCache) {
   EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
-  Upstream::ResourceAutoIncDec* circuit_breakers_{
-      new Upstream::ResourceAutoIncDec(pending_requests_)};
-  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_())
-      .WillOnce(Return(circuit_breakers_));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo")))
+      .WillOnce(Return(std::make_shared<MockDnsHostInfo>()));
   EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 443, _, _))
       .WillOnce(Return(
           MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::InCache, nullptr, absl::nullopt}));
@@ -225,10 +225,8 @@ TEST_F(SniDynamicProxyFilterTest, LoadDnsInCache) {
 TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithHostFromFilterState) {
   EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return(""));
   setFilterStateHost("foo");
-  Upstream::ResourceAutoIncDec* circuit_breakers_{
-      new Upstream::ResourceAutoIncDec(pending_requests_)};
-  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_())
-      .WillOnce(Return(circuit_breakers_));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo")))
+      .WillOnce(Return(std::make_shared<MockDnsHostInfo>()));
   EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 443, _, _))
       .WillOnce(Return(
           MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::InCache, nullptr, absl::nullopt}));
@@ -239,10 +237,8 @@ TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithHostFromFilterState) {
 TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithPortFromFilterState) {
   EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
   setFilterStatePort(553);
-  Upstream::ResourceAutoIncDec* circuit_breakers_{
-      new Upstream::ResourceAutoIncDec(pending_requests_)};
-  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_())
-      .WillOnce(Return(circuit_breakers_));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo")))
+      .WillOnce(Return(std::make_shared<MockDnsHostInfo>()));
   EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 553, _, _))
       .WillOnce(Return(
           MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::InCache, nullptr, absl::nullopt}));
@@ -254,10 +250,8 @@ TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithHostAndPortFromFilterState)
   EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return(""));
   setFilterStateHost("foo");
   setFilterStatePort(553);
-  Upstream::ResourceAutoIncDec* circuit_breakers_{
-      new Upstream::ResourceAutoIncDec(pending_requests_)};
-  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_())
-      .WillOnce(Return(circuit_breakers_));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo")))
+      .WillOnce(Return(std::make_shared<MockDnsHostInfo>()));
   EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 553, _, _))
       .WillOnce(Return(
           MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::InCache, nullptr, absl::nullopt}));
@@ -268,10 +262,8 @@ TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithHostAndPortFromFilterState)
 TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithPort0FromFilterState) {
   EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
   setFilterStatePort(0);
-  Upstream::ResourceAutoIncDec* circuit_breakers_{
-      new Upstream::ResourceAutoIncDec(pending_requests_)};
-  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_())
-      .WillOnce(Return(circuit_breakers_));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo")))
+      .WillOnce(Return(std::make_shared<MockDnsHostInfo>()));
   EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 443, _, _))
       .WillOnce(Return(
           MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::InCache, nullptr, absl::nullopt}));
@@ -282,10 +274,8 @@ TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithPort0FromFilterState) {
 TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheWithPortAboveLimitFromFilterState) {
   EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
   setFilterStatePort(99999);
-  Upstream::ResourceAutoIncDec* circuit_breakers_{
-      new Upstream::ResourceAutoIncDec(pending_requests_)};
-  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_())
-      .WillOnce(Return(circuit_breakers_));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo")))
+      .WillOnce(Return(std::make_shared<MockDnsHostInfo>()));
   EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 443, _, _))
       .WillOnce(Return(
           MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::InCache, nullptr, absl::nullopt}));
@@ -307,13 +297,60 @@ TEST_F(SniDynamicProxyFilterTest, CacheOverflow) {
   EXPECT_EQ(Network::FilterStatus::StopIteration, filter_->onNewConnection());
 }
 
+// A connection rejected by the circuit breaker doesn't start a resolution.
 TEST_F(SniDynamicProxyFilterTest, CircuitBreakerInvoked) {
   EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo"))).WillOnce(Return(absl::nullopt));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_()).WillOnce(Return(nullptr));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(_, _, _, _)).Times(0);
+  EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_EQ(Network::FilterStatus::StopIteration, filter_->onNewConnection());
+}
+
+// A host removed from the cache after it was looked up is still subject to the circuit breaker.
+TEST_F(SniDynamicProxyFilterTest, CircuitBreakerInvokedForHostRemovedFromCache) {
+  EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, getHost(Eq("foo")))
+      .WillOnce(Return(std::make_shared<MockDnsHostInfo>()));
+  Extensions::Common::DynamicForwardProxy::MockLoadDnsCacheEntryHandle* handle =
+      new Extensions::Common::DynamicForwardProxy::MockLoadDnsCacheEntryHandle();
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 443, _, _))
+      .WillOnce(Return(
+          MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::Loading, handle, absl::nullopt}));
   EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_()).WillOnce(Return(nullptr));
+  EXPECT_CALL(*handle, onDestroy());
   EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush));
   EXPECT_EQ(Network::FilterStatus::StopIteration, filter_->onNewConnection());
 }
 
+// With the circuit breaker checked before the cache load, hosts in the cache are subject to it too.
+TEST_F(SniDynamicProxyFilterTest, CircuitBreakerInvokedBeforeCacheLoad) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.sni_dfp_circuit_breaker_on_cache_load", "false"}});
+  EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_()).WillOnce(Return(nullptr));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(_, _, _, _)).Times(0);
+  EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_EQ(Network::FilterStatus::StopIteration, filter_->onNewConnection());
+}
+
+TEST_F(SniDynamicProxyFilterTest, LoadDnsInCacheBeforeCacheLoadCircuitBreaker) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.sni_dfp_circuit_breaker_on_cache_load", "false"}});
+  EXPECT_CALL(connection_, requestedServerName()).WillRepeatedly(Return("foo"));
+  Upstream::ResourceAutoIncDec* circuit_breakers_{
+      new Upstream::ResourceAutoIncDec(pending_requests_)};
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, canCreateDnsRequest_())
+      .WillOnce(Return(circuit_breakers_));
+  EXPECT_CALL(*dns_cache_manager_->dns_cache_, loadDnsCacheEntry_(Eq("foo"), 443, _, _))
+      .WillOnce(Return(
+          MockLoadDnsCacheEntryResult{LoadDnsCacheEntryStatus::InCache, nullptr, absl::nullopt}));
+
+  EXPECT_EQ(Network::FilterStatus::Continue, filter_->onNewConnection());
+}
+
 } // namespace
 
 } // namespace SniDynamicForwardProxy
@@ -0,0 +1,354 @@
+#include <memory>
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/binary_protocol_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/framed_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/header_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/router/connection_multiplexer.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/tcp/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Ref;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+namespace {
+
+class TestRequest : public MultiplexedConnectionCallbacks {
+public:
+  // MultiplexedConnectionCallbacks
+  MOCK_METHOD(void, onMultiplexedConnectionFailure,
+              (ConnectionPool::PoolFailureReason reason,
+               Upstream::HostDescriptionConstSharedPtr host));
+  void onMultiplexedConnectionReady(MultiplexedConnection& connection,
+                                    Upstream::HostDescriptionConstSharedPtr) override {
+    connection_ = &connection;
+    sequence_id_ = connection.addRequest(upstream_callbacks_);
+  }
+
+  MultiplexedConnection* connection_{};
+  int32_t sequence_id_{-1};
+  NiceMock<Tcp::ConnectionPool::MockUpstreamCallbacks> upstream_callbacks_;
+};
+
+class ConnectionMultiplexerTest : public testing::Test {
+public:
+  void initialize(uint32_t max_requests_per_connection) {
+    multiplexer_ =
+        std::make_unique<ConnectionMultiplexer>(dispatcher_, max_requests_per_connection);
+  }
+
+  Tcp::ConnectionPool::Cancellable* newRequest(TestRequest& request,
+                                               TransportType transport = TransportType::Framed) {
+    return multiplexer_->newRequest(pool_data_, transport, ProtocolType::Binary, request);
+  }
+
+  void poolReady(NiceMock<Network::MockClientConnection>& connection) {
+    auto& conn_data = *conn_pool_.connection_data_;
+    EXPECT_CALL(conn_data, addUpstreamCallbacks(_))
+        .WillOnce(Invoke([this](Tcp::ConnectionPool::UpstreamCallbacks& callbacks) -> void {
+          upstream_callbacks_ = &callbacks;
+        }));
+    ON_CALL(conn_data, connectionState())
+        .WillByDefault(Invoke(
+            [this]() -> Tcp::ConnectionPool::ConnectionState* { return conn_state_.get(); }));
+    ON_CALL(conn_data, setConnectionState_(_))
+        .WillByDefault(Invoke([this](Tcp::ConnectionPool::ConnectionStatePtr& state) -> void {
+          conn_state_.swap(state);
+        }));
+    conn_pool_.poolReady(connection);
+  }
+
+  void addResponse(Buffer::Instance& buffer, int32_t sequence_id,
+                   const std::string& method = "method",
+                   TransportType transport_type = TransportType::Framed) {
+    MessageMetadata metadata;
+    metadata.setMethodName(method);
+    metadata.setMessageType(MessageType::Reply);
+    metadata.setSequenceId(sequence_id);
+    metadata.setProtocol(ProtocolType::Binary);
+
+    Buffer::OwnedImpl message;
+    BinaryProtocolImpl protocol;
+    protocol.writeMessageBegin(message, metadata);
+    protocol.writeStructBegin(message, "");
+    protocol.writeFieldBegin(message, "", FieldType::Stop, 0);
+    protocol.writeStructEnd(message);
+    protocol.writeMessageEnd(message);
+
+    if (transport_type == TransportType::Header) {
+      HeaderTransportImpl().encodeFrame(buffer, metadata, message);
+    } else {
+      FramedTransportImpl().encodeFrame(buffer, metadata, message);
+    }
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Tcp::ConnectionPool::MockInstance> conn_pool_;
+  Upstream::TcpPoolData pool_data_{[]() {}, &conn_pool_};
+  NiceMock<Network::MockClientConnection> upstream_connection_;
+  Tcp::ConnectionPool::ConnectionStatePtr conn_state_;
+  Tcp::ConnectionPool::UpstreamCallbacks* upstream_callbacks_{};
+  std::unique_ptr<ConnectionMultiplexer> multiplexer_;
+};
+
+TEST_F(ConnectionMultiplexerTest, Supports) {
+  EXPECT_TRUE(ConnectionMultiplexer::supports(TransportType::Framed, ProtocolType::Binary));
+  EXPECT_TRUE(ConnectionMultiplexer::supports(TransportType::Header, ProtocolType::Compact));
+  EXPECT_FALSE(ConnectionMultiplexer::supports(TransportType::Unframed, ProtocolType::Binary));
+  EXPECT_FALSE(ConnectionMultiplexer::supports(TransportType::Framed, ProtocolType::Twitter));
+}
+
+// The requests share connections up to the limit, and get the responses with their sequence id
+// in any order.
+TEST_F(ConnectionMultiplexerTest, ShareConnections) {
+  initialize(2);
+  TestRequest request1, request2, request3;
+
+  EXPECT_CALL(conn_pool_, newConnection(_)).Times(2);
+  EXPECT_NE(nullptr, newRequest(request1));
+  EXPECT_NE(nullptr, newRequest(request2));
+  EXPECT_NE(nullptr, newRequest(request3));
+  EXPECT_EQ(2U, multiplexer_->connectionCount());
+
+  poolReady(upstream_connection_);
+  ASSERT_NE(nullptr, request1.connection_);
+  EXPECT_EQ(request1.connection_, request2.connection_);
+  EXPECT_EQ(nullptr, request3.connection_);
+  EXPECT_NE(request1.sequence_id_, request2.sequence_id_);
+
+  Buffer::OwnedImpl request_data("request");
+  EXPECT_CALL(upstream_connection_, write(_, false));
+  request1.connection_->write(request_data);
+
+  Buffer::OwnedImpl response;
+  addResponse(response, request2.sequence_id_);
+  const uint64_t response2_length = response.length();
+  addResponse(response, request1.sequence_id_);
+  const uint64_t response1_length = response.length() - response2_length;
+
+  {
+    testing::InSequence s;
+    EXPECT_CALL(request2.upstream_callbacks_, onUpstreamData(_, true))
+        .WillOnce(Invoke([&](Buffer::Instance& data, bool) -> void {
+          EXPECT_EQ(response2_length, data.length());
+        }));
+    EXPECT_CALL(request1.upstream_callbacks_, onUpstreamData(_, true))
+        .WillOnce(Invoke([&](Buffer::Instance& data, bool) -> void {
+          EXPECT_EQ(response1_length, data.length());
+        }));
+    // The connection has no request left and goes back to the pool.
+    EXPECT_CALL(conn_pool_, released(Ref(upstream_connection_)));
+  }
+  upstream_callbacks_->onUpstreamData(response, false);
+  EXPECT_EQ(1U, multiplexer_->connectionCount());
+
+  // A request now gets the connection of the third one.
+  TestRequest request4;
+  EXPECT_CALL(conn_pool_, newConnection(_)).Times(0);
+  EXPECT_NE(nullptr, newRequest(request4));
+}
+
+// A ready connection is given inline.
+TEST_F(ConnectionMultiplexerTest, ReadyConnection) {
+  initialize(2);
+  TestRequest request1, request2;
+
+  EXPECT_NE(nullptr, newRequest(request1));
+  poolReady(upstream_connection_);
+  EXPECT_EQ(nullptr, newRequest(request2));
+  EXPECT_EQ(request1.connection_, request2.connection_);
+
+  // The requests of other transports don't share the connection.
+  TestRequest request3;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newRequest(request3, TransportType::Header));
+  EXPECT_EQ(2U, multiplexer_->connectionCount());
+}
+
+TEST_F(ConnectionMultiplexerTest, InlinePoolReady) {
+  initialize(2);
+  TestRequest request;
+
+  EXPECT_CALL(conn_pool_, newConnection(_))
+      .WillOnce(Invoke([&](Tcp::ConnectionPool::Callbacks& callbacks)
+                           -> Tcp::ConnectionPool::Cancellable* {
+        conn_pool_.newConnectionImpl(callbacks);
+        poolReady(upstream_connection_);
+        return nullptr;
+      }));
+  EXPECT_EQ(nullptr, newRequest(request));
+  EXPECT_NE(nullptr, request.connection_);
+}
+
+TEST_F(ConnectionMultiplexerTest, PoolFailure) {
+  initialize(2);
+  TestRequest request1, request2;
+
+  EXPECT_NE(nullptr, newRequest(request1));
+  EXPECT_NE(nullptr, newRequest(request2));
+
+  EXPECT_CALL(request1, onMultiplexedConnectionFailure(ConnectionPool::PoolFailureReason::Timeout,
+                                                       Upstream::HostDescriptionConstSharedPtr(
+                                                           conn_pool_.host_)));
+  EXPECT_CALL(request2, onMultiplexedConnectionFailure(ConnectionPool::PoolFailureReason::Timeout,
+                                                       Upstream::HostDescriptionConstSharedPtr(
+                                                           conn_pool_.host_)));
+  conn_pool_.poolFailure(ConnectionPool::PoolFailureReason::Timeout);
+  EXPECT_EQ(0U, multiplexer_->connectionCount());
+}
+
+TEST_F(ConnectionMultiplexerTest, InlinePoolFailure) {
+  initialize(2);
+  TestRequest request;
+
+  EXPECT_CALL(conn_pool_, newConnection(_))
+      .WillOnce(Invoke([&](Tcp::ConnectionPool::Callbacks& callbacks)
+                           -> Tcp::ConnectionPool::Cancellable* {
+        conn_pool_.newConnectionImpl(callbacks);
+        conn_pool_.poolFailure(ConnectionPool::PoolFailureReason::Overflow);
+        return nullptr;
+      }));
+  EXPECT_CALL(request, onMultiplexedConnectionFailure(ConnectionPool::PoolFailureReason::Overflow,
+                                                      _));
+  EXPECT_EQ(nullptr, newRequest(request));
+  EXPECT_EQ(0U, multiplexer_->connectionCount());
+}
+
+// A connection whose requests were all cancelled while connecting goes back to the pool.
+TEST_F(ConnectionMultiplexerTest, CancelPendingRequest) {
+  initialize(2);
+  TestRequest request;
+
+  Tcp::ConnectionPool::Cancellable* handle = newRequest(request);
+  ASSERT_NE(nullptr, handle);
+  handle->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+
+  EXPECT_CALL(conn_pool_, released(Ref(upstream_connection_)));
+  poolReady(upstream_connection_);
+  EXPECT_EQ(nullptr, request.connection_);
+  EXPECT_EQ(0U, multiplexer_->connectionCount());
+}
+
+// The response of a removed request is dropped, and partial frames wait for more data.
+TEST_F(ConnectionMultiplexerTest, DropResponseOfRemovedRequest) {
+  initialize(3);
+  TestRequest request1, request2;
+
+  newRequest(request1);
+  newRequest(request2);
+  poolReady(upstream_connection_);
+  request1.connection_->removeRequest(request1.sequence_id_);
+
+  Buffer::OwnedImpl response;
+  addResponse(response, request1.sequence_id_);
+  addResponse(response, request2.sequence_id_, std::string(1000, 'm'));
+
+  EXPECT_CALL(request1.upstream_callbacks_, onUpstreamData(_, _)).Times(0);
+  EXPECT_CALL(request2.upstream_callbacks_, onUpstreamData(_, _)).Times(0);
+  Buffer::OwnedImpl partial;
+  partial.move(response, response.length() - 1);
+  upstream_callbacks_->onUpstreamData(partial, false);
+
+  EXPECT_CALL(request2.upstream_callbacks_, onUpstreamData(_, true));
+  EXPECT_CALL(conn_pool_, released(Ref(upstream_connection_)));
+  upstream_callbacks_->onUpstreamData(response, false);
+}
+
+TEST_F(ConnectionMultiplexerTest, HeaderTransport) {
+  initialize(2);
+  TestRequest request1, request2;
+
+  EXPECT_NE(nullptr, newRequest(request1, TransportType::Header));
+  EXPECT_NE(nullptr, newRequest(request2, TransportType::Header));
+  poolReady(upstream_connection_);
+
+  Buffer::OwnedImpl response;
+  addResponse(response, request2.sequence_id_, "method", TransportType::Header);
+  EXPECT_CALL(request1.upstream_callbacks_, onUpstreamData(_, _)).Times(0);
+  EXPECT_CALL(request2.upstream_callbacks_, onUpstreamData(_, true));
+  upstream_callbacks_->onUpstreamData(response, false);
+}
+
+// The requests are reset when the connection closes.
+TEST_F(ConnectionMultiplexerTest, RemoteClose) {
+  initialize(2);
+  TestRequest request1, request2;
+
+  newRequest(request1);
+  newRequest(request2);
+  poolReady(upstream_connection_);
+
+  EXPECT_CALL(request1.upstream_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose));
+  EXPECT_CALL(request2.upstream_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose));
+  upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
+  EXPECT_EQ(0U, multiplexer_->connectionCount());
+}
+
+TEST_F(ConnectionMultiplexerTest, InvalidResponse) {
+  initialize(2);
+  TestRequest request;
+
+  newRequest(request);
+  poolReady(upstream_connection_);
+
+  Buffer::OwnedImpl response;
+  response.writeBEInt<int32_t>(4);
+  response.writeBEInt<int32_t>(0);
+  EXPECT_CALL(upstream_connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(request.upstream_callbacks_, onEvent(Network::ConnectionEvent::LocalClose));
+  upstream_callbacks_->onUpstreamData(response, false);
+  EXPECT_EQ(0U, multiplexer_->connectionCount());
+}
+
+TEST_F(ConnectionMultiplexerTest, EndStream) {
+  initialize(2);
+  TestRequest request;
+
+  newRequest(request);
+  poolReady(upstream_connection_);
+
+  Buffer::OwnedImpl response;
+  EXPECT_CALL(upstream_connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(request.upstream_callbacks_, onEvent(Network::ConnectionEvent::LocalClose));
+  upstream_callbacks_->onUpstreamData(response, true);
+}
+
+// A draining connection takes no new request, and is closed once its requests got a response.
+TEST_F(ConnectionMultiplexerTest, Drain) {
+  initialize(2);
+  TestRequest request1, request2, request3;
+
+  newRequest(request1);
+  poolReady(upstream_connection_);
+  request1.connection_->drain();
+
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newRequest(request2));
+
+  Buffer::OwnedImpl response;
+  addResponse(response, request1.sequence_id_);
+  EXPECT_CALL(request1.upstream_callbacks_, onUpstreamData(_, true));
+  EXPECT_CALL(upstream_connection_, close(Network::ConnectionCloseType::NoFlush));
+  upstream_callbacks_->onUpstreamData(response, false);
+  EXPECT_EQ(1U, multiplexer_->connectionCount());
+}
+
+} // namespace
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,6 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/app_exception_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/binary_protocol_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/decoder.h"
 
 #include "test/extensions/filters/network/thrift_proxy/mocks.h"
@@ -1339,6 +1340,74 @@ TEST(DecoderTest, OnDataPassthroughResumes) {
   EXPECT_FALSE(underflow); // buffer.length() == 1
 }
 
+TEST(DecoderTest, OnDataPassthroughScansUnframedBody) {
+  NiceMock<MockTransport> transport;
+  BinaryProtocolImpl proto;
+  NiceMock<MockDecoderCallbacks> callbacks;
+  NiceMock<MockDecoderEventHandler> handler;
+  ON_CALL(callbacks, newDecoderEventHandler()).WillByDefault(ReturnRef(handler));
+  ON_CALL(callbacks, passthroughEnabled()).WillByDefault(Return(true));
+  // Without a frame size, the body is scanned for its end.
+  ON_CALL(transport, decodeFrameStart(_, _)).WillByDefault(Return(true));
+  ON_CALL(transport, decodeFrameEnd(_)).WillByDefault(Return(true));
+
+  MessageMetadata metadata;
+  metadata.setMethodName("name");
+  metadata.setMessageType(MessageType::Call);
+  metadata.setSequenceId(100);
+  Buffer::OwnedImpl message_begin;
+  proto.writeMessageBegin(message_begin, metadata);
+
+  Buffer::OwnedImpl body;
+  proto.writeStructBegin(body, "");
+  proto.writeFieldBegin(body, "", FieldType::String, 1);
+  proto.writeString(body, std::string(100, 'a'));
+  proto.writeFieldEnd(body);
+  proto.writeFieldBegin(body, "", FieldType::List, 2);
+  proto.writeListBegin(body, FieldType::I32, 2);
+  proto.writeInt32(body, 1);
+  proto.writeInt32(body, 2);
+  proto.writeListEnd(body);
+  proto.writeFieldEnd(body);
+  proto.writeFieldBegin(body, "", FieldType::Stop, 0);
+  proto.writeStructEnd(body);
+  proto.writeMessageEnd(body);
+  const std::string body_string = body.toString();
+
+  Decoder decoder(transport, proto, callbacks);
+  Buffer::OwnedImpl buffer;
+  buffer.move(message_begin);
+  buffer.add(body_string.substr(0, 50));
+
+  EXPECT_CALL(handler, messageBegin(_))
+      .WillOnce(Invoke([&](MessageMetadataSharedPtr metadata) -> FilterStatus {
+        EXPECT_EQ("name", metadata->methodName());
+        EXPECT_EQ(100U, metadata->sequenceId());
+        return FilterStatus::Continue;
+      }));
+  EXPECT_CALL(handler, structBegin(_)).Times(0);
+  EXPECT_CALL(handler, passthroughData(_)).Times(0);
+
+  bool underflow = false;
+  EXPECT_EQ(FilterStatus::Continue, decoder.onData(buffer, underflow));
+  EXPECT_TRUE(underflow);
+  EXPECT_EQ(50, buffer.length());
+
+  buffer.add(body_string.substr(50));
+  buffer.add("x");
+  EXPECT_CALL(handler, passthroughData(_))
+      .WillOnce(Invoke([&](Buffer::Instance& data) -> FilterStatus {
+        EXPECT_EQ(body_string, data.toString());
+        return FilterStatus::Continue;
+      }));
+  EXPECT_CALL(handler, messageEnd()).WillOnce(Return(FilterStatus::Continue));
+  EXPECT_CALL(handler, transportEnd()).WillOnce(Return(FilterStatus::Continue));
+
+  EXPECT_EQ(FilterStatus::Continue, decoder.onData(buffer, underflow));
+  EXPECT_FALSE(underflow); // buffer.length() == 1
+  EXPECT_EQ("x", buffer.toString());
+}
+
 TEST(DecoderTest, OnDataPassthroughResumesTransportFrameStart) {
   StrictMock<MockTransport> transport;
   StrictMock<MockProtocol> proto;
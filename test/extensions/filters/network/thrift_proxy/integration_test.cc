@@ -234,9 +234,7 @@ TEST_P(ThriftConnManagerIntegrationTest, Success) {
   counter = test_server_->counter(
       fmt::format("cluster.cluster_{}.thrift.upstream_rq_call", upstream_idx));
   EXPECT_EQ(1U, counter->value());
-  if (payload_passthrough_ &&
-      (transport_ == TransportType::Framed || transport_ == TransportType::Header) &&
-      protocol_ != ProtocolType::Twitter) {
+  if (payload_passthrough_ && protocol_ != ProtocolType::Twitter) {
     counter = test_server_->counter("thrift.thrift_stats.response_passthrough");
     EXPECT_EQ(1U, counter->value());
   } else {
@@ -282,9 +280,7 @@ TEST_P(ThriftConnManagerIntegrationTest, IDLException) {
   int upstream_idx = getExpectedUpstreamIdx(false);
   counter = test_server_->counter(
       fmt::format("cluster.cluster_{}.thrift.upstream_rq_call", upstream_idx));
-  if (payload_passthrough_ &&
-      (transport_ == TransportType::Framed || transport_ == TransportType::Header) &&
-      protocol_ != ProtocolType::Twitter) {
+  if (payload_passthrough_ && protocol_ != ProtocolType::Twitter) {
     counter = test_server_->counter("thrift.thrift_stats.response_passthrough");
     EXPECT_EQ(1U, counter->value());
   } else {
@@ -706,9 +706,11 @@ static std::string downstreamUpstreamTypesToString(
 
 INSTANTIATE_TEST_SUITE_P(DownstreamUpstreamTypes, ThriftRouterPassthroughTest,
                          Combine(Values(TransportType::Framed, TransportType::Unframed),
-                                 Values(ProtocolType::Binary, ProtocolType::Twitter),
+                                 Values(ProtocolType::Binary, ProtocolType::Compact,
+                                        ProtocolType::Twitter),
                                  Values(TransportType::Framed, TransportType::Unframed),
-                                 Values(ProtocolType::Binary, ProtocolType::Twitter)),
+                                 Values(ProtocolType::Binary, ProtocolType::Compact,
+                                        ProtocolType::Twitter)),
                          downstreamUpstreamTypesToString);
 
 class ThriftRouterRainidayTest : public testing::TestWithParam<bool>,
@@ -1707,9 +1709,7 @@ TEST_P(ThriftRouterPassthroughTest, PassthroughEnable) {
                downstream_protocol_type);
 
   bool passthroughSupported = false;
-  if (downstream_transport_type == upstream_transport_type &&
-      downstream_transport_type == TransportType::Framed &&
-      downstream_protocol_type == upstream_protocol_type &&
+  if (downstream_protocol_type == upstream_protocol_type &&
       downstream_protocol_type != ProtocolType::Twitter) {
     passthroughSupported = true;
   }
@@ -157,12 +157,8 @@ TEST_P(ThriftTranslationIntegrationTest, Translates) {
   EXPECT_EQ(1U, counter->value());
   counter = test_server_->counter("cluster.cluster_0.thrift.upstream_rq_call");
   EXPECT_EQ(1U, counter->value());
-  if (passthrough_ &&
-      (downstream_transport_ == TransportType::Framed ||
-       downstream_transport_ == TransportType::Header) &&
-      (upstream_transport_ == TransportType::Framed ||
-       upstream_transport_ == TransportType::Header) &&
-      downstream_protocol_ == upstream_protocol_ && downstream_protocol_ != ProtocolType::Twitter) {
+  if (passthrough_ && downstream_protocol_ == upstream_protocol_ &&
+      downstream_protocol_ != ProtocolType::Twitter) {
     counter = test_server_->counter("thrift.thrift_stats.request_passthrough");
     EXPECT_EQ(1U, counter->value());
     counter = test_server_->counter("thrift.thrift_stats.response_passthrough");
@@ -219,6 +219,33 @@ server_config:
             - "10.0.0.1"
 )EOF";
 
+  const std::string forward_query_with_answer_cache_config = R"EOF(
+stat_prefix: "my_prefix"
+client_config:
+  resolver_timeout: 1s
+  typed_dns_resolver_config:
+    name: envoy.network.dns_resolver.cares
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.network.dns_resolver.cares.v3.CaresDnsResolverConfig
+      resolvers:
+      - socket_address:
+          address: "1.1.1.1"
+          port_value: 53
+  max_pending_lookups: 4
+  answer_cache:
+    max_entries: 2
+    negative_ttl: 10s
+server_config:
+  inline_dns_table:
+    external_retry_count: 0
+    virtual_domains:
+      - name: "www.foo1.com"
+        endpoint:
+          address_list:
+            address:
+            - "10.0.0.1"
+)EOF";
+
   static constexpr absl::string_view external_dns_table_config = R"EOF(
 stat_prefix: "my_prefix"
 client_config:
@@ -1070,6 +1097,134 @@ TEST_F(DnsFilterTest, ExternalResolutionExceedMaxPendingLookups) {
   EXPECT_EQ(1, config_->stats().unanswered_queries_.value());
 }
 
+TEST_F(DnsFilterTest, ExternalResolutionCachedAnswer) {
+  const std::string expected_address("130.207.244.251");
+  const std::string domain("www.foobaz.com");
+  setup(forward_query_with_answer_cache_config);
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success,
+             TestUtility::makeDnsResponse({expected_address}, std::chrono::seconds(5)));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // The same query, with a differently cased name, is answered from the cache.
+  const std::string cased_query =
+      Utils::buildQueryForDomain("WWW.FooBaz.com", DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(cased_query.empty());
+  EXPECT_CALL(*resolver_, resolve(_, _, _)).Times(0);
+  sendQueryFromClient("10.0.0.1:1000", cased_query);
+
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response_ctx_->getQueryResponseCode());
+  ASSERT_EQ(1, response_ctx_->answers_.size());
+  std::list<std::string> expected{expected_address};
+  Utils::verifyAddress(expected, response_ctx_->answers_.begin()->second);
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // Once the TTL of the answer has elapsed, the query is resolved again.
+  simTime().advanceTimeWait(std::chrono::seconds(6));
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  EXPECT_EQ(3, config_->stats().downstream_rx_queries_.value());
+  EXPECT_EQ(1, config_->stats().external_cache_hits_.value());
+  EXPECT_EQ(0, config_->stats().external_cache_negative_hits_.value());
+  EXPECT_EQ(2, config_->stats().external_a_record_answers_.value());
+}
+
+TEST_F(DnsFilterTest, ExternalResolutionCachedNegativeAnswer) {
+  const std::string domain("www.foobaz.com");
+  setup(forward_query_with_answer_cache_config);
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_AAAA, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success, TestUtility::makeDnsResponse({}));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // The name doesn't exist for the negative TTL.
+  EXPECT_CALL(*resolver_, resolve(_, _, _)).Times(0);
+  simTime().advanceTimeWait(std::chrono::seconds(9));
+  sendQueryFromClient("10.0.0.1:1000", query);
+
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NAME_ERROR, response_ctx_->getQueryResponseCode());
+  EXPECT_EQ(0, response_ctx_->answers_.size());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  simTime().advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  EXPECT_EQ(0, config_->stats().external_cache_hits_.value());
+  EXPECT_EQ(1, config_->stats().external_cache_negative_hits_.value());
+  EXPECT_EQ(2, config_->stats().unanswered_queries_.value());
+}
+
+TEST_F(DnsFilterTest, ExternalResolutionCoalescedQueries) {
+  const std::string expected_address("130.207.244.251");
+  const std::string domain("www.foobaz.com");
+  setup(forward_query_with_answer_cache_config);
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  // The second query waits for the resolution of the first one.
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  sendQueryFromClient("10.0.0.2:1000", query);
+  EXPECT_EQ(0, udp_response_.buffer_->length());
+  EXPECT_EQ(1, config_->stats().external_coalesced_queries_.value());
+
+  // Each query gets its own response from the single resolution.
+  std::vector<DnsQueryContextPtr> responses;
+  EXPECT_CALL(callbacks_.udp_listener_, send(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](const Network::UdpSendData& send_data) -> Api::IoCallUint64Result {
+        const uint64_t length = send_data.buffer_.length();
+        udp_response_.buffer_->drain(udp_response_.buffer_->length());
+        udp_response_.buffer_->move(send_data.buffer_);
+        responses.push_back(ResponseValidator::createResponseContext(udp_response_, counters_));
+        return makeNoError(length);
+      }));
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Success,
+             TestUtility::makeDnsResponse({expected_address}));
+
+  ASSERT_EQ(2, responses.size());
+  std::list<std::string> expected{expected_address};
+  for (const DnsQueryContextPtr& response : responses) {
+    EXPECT_TRUE(response->parse_status_);
+    EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response->getQueryResponseCode());
+    ASSERT_EQ(1, response->answers_.size());
+    Utils::verifyAddress(expected, response->answers_.begin()->second);
+  }
+
+  EXPECT_EQ(2, config_->stats().downstream_rx_queries_.value());
+  EXPECT_EQ(2, config_->stats().external_a_record_answers_.value());
+  EXPECT_EQ(0, config_->stats().external_cache_hits_.value());
+}
+
 TEST_F(DnsFilterTest, ConsumeExternalJsonTableTest) {
   InSequence s;
 
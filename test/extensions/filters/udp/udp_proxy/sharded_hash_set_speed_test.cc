@@ -0,0 +1,83 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+#include "source/extensions/filters/udp/udp_proxy/sharded_hash_set.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace UdpFilters {
+namespace UdpProxy {
+namespace {
+
+using Hash = absl::Hash<uint64_t>;
+using Eq = std::equal_to<uint64_t>;
+
+// Adapts the flat hash set to the interface of the sharded one.
+class FlatHashSet {
+public:
+  FlatHashSet(const Hash& hash, const Eq& eq) : set_(0, hash, eq) {}
+  bool emplace(uint64_t value) { return set_.emplace(value).second; }
+  size_t erase(uint64_t value) { return set_.erase(value); }
+
+private:
+  absl::flat_hash_set<uint64_t, Hash, Eq> set_;
+};
+
+// Simulates the churn of short lived sessions: the sessions are created until there are
+// state.range(0) of them, each new session then replacing the oldest one, so that the table keeps
+// growing and shrinking through its rehashes. Reports the worst latency of a session creation.
+template <class Table> void sessionChurn(benchmark::State& state) {
+  const uint64_t sessions = state.range(0);
+  std::chrono::nanoseconds max_latency{0};
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Table table{Hash(), Eq()};
+    std::deque<uint64_t> live;
+    for (uint64_t i = 0; i < sessions * 2; i++) {
+      const auto start = std::chrono::steady_clock::now();
+      table.emplace(i);
+      max_latency = std::max<std::chrono::nanoseconds>(max_latency,
+                                                       std::chrono::steady_clock::now() - start);
+      live.push_back(i);
+      if (live.size() > sessions) {
+        table.erase(live.front());
+        live.pop_front();
+      }
+    }
+    while (!live.empty()) {
+      table.erase(live.front());
+      live.pop_front();
+    }
+  }
+  state.counters["max_insert_us"] = max_latency.count() / 1000.0;
+}
+
+void bmFlatHashSetSessionChurn(benchmark::State& state) { sessionChurn<FlatHashSet>(state); }
+BENCHMARK(bmFlatHashSetSessionChurn)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+void bmShardedHashSetSessionChurn(benchmark::State& state) {
+  sessionChurn<ShardedHashSet<uint64_t, Hash, Eq>>(state);
+}
+BENCHMARK(bmShardedHashSetSessionChurn)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace UdpProxy
+} // namespace UdpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <functional>
+
+#include "source/extensions/filters/udp/udp_proxy/sharded_hash_set.h"
+
+#include "absl/hash/hash.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace UdpFilters {
+namespace UdpProxy {
+namespace {
+
+using Set = ShardedHashSet<uint64_t, absl::Hash<uint64_t>, std::equal_to<uint64_t>, 4>;
+
+TEST(ShardedHashSetTest, Basic) {
+  Set set{absl::Hash<uint64_t>(), std::equal_to<uint64_t>()};
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(nullptr, set.find(1));
+
+  for (uint64_t i = 0; i < 1000; i++) {
+    EXPECT_TRUE(set.emplace(i));
+  }
+  EXPECT_FALSE(set.emplace(1));
+  EXPECT_EQ(1000U, set.size());
+  for (uint64_t i = 0; i < 1000; i++) {
+    ASSERT_NE(nullptr, set.find(i));
+    EXPECT_EQ(i, *set.find(i));
+    EXPECT_EQ(1U, set.count(i));
+  }
+  EXPECT_EQ(0U, set.count(1000));
+
+  EXPECT_EQ(1U, set.erase(1));
+  EXPECT_EQ(0U, set.erase(1));
+  EXPECT_EQ(nullptr, set.find(1));
+  EXPECT_EQ(999U, set.size());
+
+  while (!set.empty()) {
+    const uint64_t value = set.any();
+    EXPECT_EQ(1U, set.erase(value));
+  }
+  EXPECT_EQ(0U, set.size());
+}
+
+} // namespace
+} // namespace UdpProxy
+} // namespace UdpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -30,6 +30,7 @@ using testing::InSequence;
 using testing::InvokeWithoutArgs;
 using testing::Return;
 using testing::ReturnNew;
+using testing::ReturnPointee;
 using testing::SaveArg;
 
 namespace Envoy {
@@ -93,7 +94,6 @@ public:
     void expectWriteToUpstream(const std::string& data, int sys_errno = 0,
                                const Network::Address::Ip* local_ip = nullptr,
                                bool expect_connect = false, int connect_sys_errno = 0) {
-      EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
       if (expect_connect) {
         EXPECT_CALL(*socket_->io_handle_, connect(_))
             .WillOnce(Invoke([connect_sys_errno]() -> Api::SysCallIntResult {
@@ -134,8 +134,6 @@ public:
 
     void recvDataFromUpstream(const std::string& data, int recv_sys_errno = 0,
                               int send_sys_errno = 0) {
-      EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
-
       if (parent_.expect_gro_) {
         EXPECT_CALL(*socket_->io_handle_, supportsUdpGro());
       }
@@ -183,7 +181,6 @@ public:
 
     UdpProxyFilterTest& parent_;
     const Network::Address::InstanceConstSharedPtr upstream_address_;
-    Event::MockTimer* idle_timer_{};
     NiceMock<Network::MockSocket>* socket_;
     std::map<int, std::map<int, int>> sock_opts_;
     Event::FileReadyCb file_event_cb_;
@@ -203,6 +200,9 @@ public:
     ON_CALL(os_sys_calls_, supportsIpTransparent()).WillByDefault(Return(true));
     EXPECT_CALL(os_sys_calls_, supportsUdpGro()).Times(AtLeast(0)).WillRepeatedly(Return(true));
     EXPECT_CALL(callbacks_, udpListener()).Times(AtLeast(0));
+    EXPECT_CALL(callbacks_.udp_listener_.dispatcher_, approximateMonotonicTime())
+        .Times(AtLeast(0))
+        .WillRepeatedly(ReturnPointee(&now_));
     EXPECT_CALL(*factory_context_.cluster_manager_.thread_local_cluster_.lb_.host_, address())
         .WillRepeatedly(Return(upstream_address_));
     EXPECT_CALL(*factory_context_.cluster_manager_.thread_local_cluster_.lb_.host_, coarseHealth())
@@ -214,6 +214,7 @@ public:
   void setup(const envoy::extensions::filters::udp::udp_proxy::v3::UdpProxyConfig& config,
              bool has_cluster = true, bool expect_gro = true) {
     config_ = std::make_shared<UdpProxyFilterConfig>(factory_context_, config);
+    idle_timer_ = new NiceMock<Event::MockTimer>(&callbacks_.udp_listener_.dispatcher_);
     EXPECT_CALL(factory_context_.cluster_manager_, addThreadLocalClusterUpdateCallbacks_(_))
         .WillOnce(DoAll(SaveArgAddress(&cluster_update_callbacks_),
                         ReturnNew<Upstream::MockClusterUpdateCallbacksHandle>()));
@@ -238,7 +239,6 @@ public:
   void expectSessionCreate(const Network::Address::InstanceConstSharedPtr& address) {
     test_sessions_.emplace_back(*this, address);
     TestSession& new_session = test_sessions_.back();
-    new_session.idle_timer_ = new Event::MockTimer(&callbacks_.udp_listener_.dispatcher_);
     EXPECT_CALL(*filter_, createSocket(_))
         .WillOnce(Return(ByMove(Network::SocketPtr{test_sessions_.back().socket_})));
     EXPECT_CALL(
@@ -259,6 +259,12 @@ public:
     return host;
   }
 
+  // Expires the sessions which weren't active in the last session timeout.
+  void expireIdleSessions() {
+    now_ += config_->sessionTimeout();
+    idle_timer_->invokeCallback();
+  }
+
   void checkTransferStats(uint64_t rx_bytes, uint64_t rx_datagrams, uint64_t tx_bytes,
                           uint64_t tx_datagrams) {
     EXPECT_EQ(rx_bytes, config_->stats().downstream_sess_rx_bytes_.value());
@@ -358,6 +364,8 @@ use_original_src_ip: true
   Network::MockUdpReadFilterCallbacks callbacks_;
   Upstream::ClusterUpdateCallbacks* cluster_update_callbacks_{};
   std::unique_ptr<TestUdpProxyFilter> filter_;
+  Event::MockTimer* idle_timer_{};
+  MonotonicTime now_;
   std::vector<TestSession> test_sessions_;
   StringViewSaver access_log_data_;
   std::vector<std::string> output_;
@@ -500,7 +508,7 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 
-  test_sessions_[0].idle_timer_->invokeCallback();
+  expireIdleSessions();
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
 
@@ -542,7 +550,7 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 
-  test_sessions_[0].idle_timer_->invokeCallback();
+  expireIdleSessions();
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
 
@@ -557,6 +565,60 @@ matcher:
   EXPECT_EQ(output_.front(), "2 1");
 }
 
+// Verifies that the idle timer shared by the sessions expires them in the order they were last
+// active, and is then armed for the next one to expire.
+TEST_F(UdpProxyFilterTest, IdleTimerExpiresLeastRecentlyActiveSessions) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+idle_timeout: 60s
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  test_sessions_[0].expectWriteToUpstream("hello", 0, nullptr, true);
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(60000), nullptr));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+
+  now_ += std::chrono::seconds(20);
+  expectSessionCreate(upstream_address_);
+  test_sessions_[1].expectWriteToUpstream("hello", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.3:1000", "10.0.0.2:80", "hello");
+
+  // The first session is active again, so that the second one is the first to expire.
+  now_ += std::chrono::seconds(20);
+  test_sessions_[0].expectWriteToUpstream("hello2");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+
+  now_ += std::chrono::seconds(20);
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(20000), nullptr));
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(2, config_->stats().downstream_sess_active_.value());
+
+  now_ += std::chrono::seconds(20);
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(20000), nullptr));
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(1, config_->stats().idle_timeout_.value());
+
+  // The timer doesn't fire more often than a fraction of the idle timeout.
+  now_ += std::chrono::milliseconds(19999);
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(3750), nullptr));
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
+
+  now_ += std::chrono::seconds(4);
+  EXPECT_CALL(*idle_timer_, enableTimer(_, _)).Times(0);
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(2, config_->stats().idle_timeout_.value());
+}
+
 // Verify downstream send and receive error handling.
 TEST_F(UdpProxyFilterTest, SendReceiveErrorHandling) {
   InSequence s;
@@ -805,7 +867,7 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 
   // Timing out the 1st session should allow us to create another.
-  test_sessions_[0].idle_timer_->invokeCallback();
+  expireIdleSessions();
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
   expectSessionCreate(upstream_address_);
@@ -1414,6 +1476,93 @@ hash_policies:
   test_sessions_[0].recvDataFromUpstream("world");
 }
 
+
+// Verifies that the datagrams forwarded to an upstream host during an event loop iteration are
+// sent together once it completes, and that the datagrams which can't be sent are dropped.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamDatagrams) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+max_batched_upstream_datagrams: 3
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  EXPECT_CALL(*session.socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(*flush_cb, scheduleCallbackCurrentIteration());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+  EXPECT_TRUE(flush_cb->enabled_);
+
+  // The first datagram is sent, and the second is too large.
+  EXPECT_CALL(*session.socket_->io_handle_, fdDoNotUse()).WillRepeatedly(Return(10));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, 2, 0))
+      .WillOnce(Invoke([](os_fd_t, struct mmsghdr* messages, unsigned int,
+                          int) -> Api::SysCallIntResult {
+        const iovec& iov = messages[0].msg_hdr.msg_iov[0];
+        EXPECT_EQ("hello", absl::string_view(static_cast<const char*>(iov.iov_base), iov.iov_len));
+        EXPECT_EQ(nullptr, messages[0].msg_hdr.msg_control);
+        return {1, 0};
+      }));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, 1, 0))
+      .WillOnce(Return(Api::SysCallIntResult{-1, SOCKET_ERROR_MSG_SIZE}));
+  flush_cb->invokeCallback();
+
+  Stats::Store& stats_store =
+      factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(1, TestUtility::findCounter(stats_store, "udp.sess_tx_datagrams")->value());
+  EXPECT_EQ(1, TestUtility::findCounter(stats_store, "udp.sess_tx_errors")->value());
+  EXPECT_EQ(2, TestUtility::findCounter(stats_store, "udp.sess_tx_syscalls")->value());
+  EXPECT_EQ(5, factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_
+                   ->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+}
+
+// Verifies that a full batch of datagrams is sent at once.
+TEST_F(UdpProxyFilterTest, FullBatchOfUpstreamDatagrams) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+max_batched_upstream_datagrams: 2
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  EXPECT_CALL(*session.socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+
+  EXPECT_CALL(*session.socket_->io_handle_, fdDoNotUse()).WillRepeatedly(Return(10));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, 2, 0)).WillOnce(Return(Api::SysCallIntResult{2, 0}));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+  EXPECT_FALSE(flush_cb->enabled_);
+
+  Stats::Store& stats_store =
+      factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(2, TestUtility::findCounter(stats_store, "udp.sess_tx_datagrams")->value());
+  EXPECT_EQ(1, TestUtility::findCounter(stats_store, "udp.sess_tx_syscalls")->value());
+  EXPECT_EQ(11, factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_
+                    ->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+}
 } // namespace
 } // namespace UdpProxy
 } // namespace UdpFilters
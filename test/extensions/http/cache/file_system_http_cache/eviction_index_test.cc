@@ -0,0 +1,132 @@
+#include <chrono>
+
+#include "source/extensions/http/cache/file_system_http_cache/eviction_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace FileSystemHttpCache {
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::IsEmpty;
+
+SystemTime at(int seconds) { return SystemTime(std::chrono::seconds(seconds)); }
+
+std::vector<std::string> names(const std::vector<EvictionIndex::Entry>& entries) {
+  std::vector<std::string> result;
+  for (const EvictionIndex::Entry& entry : entries) {
+    result.push_back(entry.name_);
+  }
+  return result;
+}
+
+TEST(EvictionIndexTest, TracksSizeAndCount) {
+  EvictionIndex index;
+  index.add("cache-a", 5, at(1));
+  index.add("cache-b", 7, at(2));
+  EXPECT_EQ(index.sizeBytes(), 12);
+  EXPECT_EQ(index.count(), 2);
+  index.remove("cache-a");
+  EXPECT_EQ(index.sizeBytes(), 7);
+  EXPECT_EQ(index.count(), 1);
+  // Removing something not indexed changes nothing.
+  index.remove("cache-a");
+  EXPECT_EQ(index.sizeBytes(), 7);
+  EXPECT_EQ(index.count(), 1);
+}
+
+TEST(EvictionIndexTest, AddReplacesEntryOfTheSameName) {
+  EvictionIndex index;
+  index.add("cache-a", 5, at(1));
+  index.add("cache-a", 9, at(2));
+  EXPECT_EQ(index.sizeBytes(), 9);
+  EXPECT_EQ(index.count(), 1);
+}
+
+TEST(EvictionIndexTest, EvictsOldestEntriesUntilWithinCount) {
+  EvictionIndex index;
+  index.add("cache-c", 1, at(3));
+  index.add("cache-a", 1, at(1));
+  index.add("cache-b", 1, at(2));
+  EXPECT_THAT(names(index.evictUntilWithin(100, 1)), ElementsAre("cache-a", "cache-b"));
+  EXPECT_EQ(index.count(), 1);
+  EXPECT_THAT(index.evictUntilWithin(100, 1), IsEmpty());
+}
+
+TEST(EvictionIndexTest, EvictsOldestEntriesUntilWithinSize) {
+  EvictionIndex index;
+  index.add("cache-a", 10, at(1));
+  index.add("cache-b", 10, at(2));
+  index.add("cache-c", 10, at(3));
+  EXPECT_THAT(index.evictUntilWithin(15, 100),
+              ElementsAre(Field(&EvictionIndex::Entry::name_, "cache-a"),
+                          Field(&EvictionIndex::Entry::name_, "cache-b")));
+  EXPECT_EQ(index.sizeBytes(), 10);
+}
+
+TEST(EvictionIndexTest, TouchMakesEntryYoungest) {
+  EvictionIndex index;
+  index.add("cache-a", 1, at(1));
+  index.add("cache-b", 1, at(2));
+  EXPECT_TRUE(index.touch("cache-a", at(3)));
+  EXPECT_FALSE(index.touch("cache-z", at(3)));
+  EXPECT_THAT(names(index.evictUntilWithin(100, 1)), ElementsAre("cache-b"));
+}
+
+TEST(EvictionIndexTest, TouchNeverMakesEntryOlder) {
+  EvictionIndex index;
+  index.add("cache-a", 1, at(2));
+  index.add("cache-b", 1, at(3));
+  EXPECT_TRUE(index.touch("cache-b", at(1)));
+  EXPECT_THAT(names(index.evictUntilWithin(100, 1)), ElementsAre("cache-a"));
+}
+
+TEST(EvictionIndexTest, CheckpointRoundTrips) {
+  EvictionIndex index;
+  index.add("cache-a", 5, at(2));
+  index.add("cache-b", 7, at(1));
+  EXPECT_TRUE(index.dirty());
+  EvictionIndexCheckpoint checkpoint = index.toCheckpoint();
+  EXPECT_FALSE(index.dirty());
+  EvictionIndex reloaded;
+  reloaded.loadCheckpoint(checkpoint);
+  EXPECT_EQ(reloaded.sizeBytes(), 12);
+  EXPECT_EQ(reloaded.count(), 2);
+  std::vector<EvictionIndex::Entry> evicted = reloaded.evictUntilWithin(0, 0);
+  ASSERT_EQ(evicted.size(), 2);
+  EXPECT_EQ(evicted[0].name_, "cache-b");
+  EXPECT_EQ(evicted[0].size_bytes_, 7);
+  EXPECT_EQ(evicted[0].last_touch_, at(1));
+  EXPECT_EQ(evicted[1].name_, "cache-a");
+  EXPECT_EQ(evicted[1].last_touch_, at(2));
+}
+
+TEST(EvictionIndexTest, ChangesMarkIndexDirty) {
+  EvictionIndex index;
+  EXPECT_FALSE(index.dirty());
+  index.add("cache-a", 5, at(1));
+  index.toCheckpoint();
+  index.touch("cache-a", at(2));
+  EXPECT_TRUE(index.dirty());
+  index.toCheckpoint();
+  index.remove("cache-a");
+  EXPECT_TRUE(index.dirty());
+  index.toCheckpoint();
+  index.markDirty();
+  EXPECT_TRUE(index.dirty());
+}
+
+} // namespace
+
+} // namespace FileSystemHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -93,7 +93,7 @@ public:
 protected:
   void deleteCacheFiles(std::string path) {
     for (const auto& it : ::Envoy::Filesystem::Directory(path)) {
-      if (absl::StartsWith(it.name_, "cache-")) {
+      if (absl::StartsWith(it.name_, "cache-") || it.name_ == "eviction-index") {
         env_.removePath(absl::StrCat(path, it.name_));
       }
     }
@@ -147,8 +147,8 @@ TEST_F(FileSystemHttpCacheTestWithNoDefaultCache, EvictsOldestFilesUntilUnderCou
   EXPECT_EQ(cache_->stats().size_count_.value(), 2);
   env_.writeStringToFileForTest(absl::StrCat(cache_path_, "cache-c"), file_contents, true);
   env_.writeStringToFileForTest(absl::StrCat(cache_path_, "cache-d"), file_contents, true);
-  cache_->trackFileAdded(file_contents.size());
-  cache_->trackFileAdded(file_contents.size());
+  cache_->trackFileAdded("cache-c", file_contents.size());
+  cache_->trackFileAdded("cache-d", file_contents.size());
   waitForEvictionThreadIdle();
   EXPECT_EQ(cache_->stats().size_bytes_.value(), file_contents.size() * 2);
   EXPECT_EQ(cache_->stats().size_count_.value(), 2);
@@ -179,7 +179,7 @@ TEST_F(FileSystemHttpCacheTestWithNoDefaultCache, EvictsOldestFilesUntilUnderSiz
   env_.writeStringToFileForTest(absl::StrCat(cache_path_, "cache-c"), large_file_contents, true);
   EXPECT_EQ(cache_->stats().size_bytes_.value(), file_contents.size() * 2);
   EXPECT_EQ(cache_->stats().size_count_.value(), 2);
-  cache_->trackFileAdded(large_file_contents.size());
+  cache_->trackFileAdded("cache-c", large_file_contents.size());
   waitForEvictionThreadIdle();
   EXPECT_EQ(cache_->stats().size_bytes_.value(), large_file_contents.size());
   EXPECT_EQ(cache_->stats().size_count_.value(), 1);
@@ -189,6 +189,60 @@ TEST_F(FileSystemHttpCacheTestWithNoDefaultCache, EvictsOldestFilesUntilUnderSiz
   EXPECT_EQ(cache_->stats().eviction_runs_.value(), 1);
 }
 
+TEST_F(FileSystemHttpCacheTestWithNoDefaultCache, IndexIsReloadedFromCheckpoint) {
+  initCache();
+  waitForEvictionThreadIdle();
+  // No such file exists, so a rescan wouldn't find it; only the checkpoint knows of it.
+  cache_->trackFileAdded("cache-a", 5);
+  // Destroying the cache writes the checkpoint.
+  cache_.reset();
+  const std::string checkpoint_path = absl::StrCat(cache_path_, "eviction-index");
+  EXPECT_TRUE(Filesystem::fileSystemForTest().fileExists(checkpoint_path));
+  initCache();
+  waitForEvictionThreadIdle();
+  EXPECT_EQ(cache_->stats().size_bytes_.value(), 5);
+  EXPECT_EQ(cache_->stats().size_count_.value(), 1);
+  // The checkpoint is consumed, so a restart without a new checkpoint rescans.
+  EXPECT_FALSE(Filesystem::fileSystemForTest().fileExists(checkpoint_path));
+}
+
+TEST_F(FileSystemHttpCacheTestWithNoDefaultCache, UnreadableCheckpointFallsBackToScan) {
+  const std::string file_contents = "XXXXX";
+  env_.writeStringToFileForTest(absl::StrCat(cache_path_, "cache-a"), file_contents, true);
+  env_.writeStringToFileForTest(absl::StrCat(cache_path_, "eviction-index"), "not a checkpoint",
+                                true);
+  initCache();
+  waitForEvictionThreadIdle();
+  EXPECT_EQ(cache_->stats().size_bytes_.value(), file_contents.size());
+  EXPECT_EQ(cache_->stats().size_count_.value(), 1);
+}
+
+TEST_F(FileSystemHttpCacheTestWithNoDefaultCache, EvictsLeastRecentlyAccessedFiles) {
+  const std::string file_contents = "XXXXX";
+  const uint64_t max_count = 2;
+  ConfigProto cfg = testConfig();
+  cfg.mutable_max_cache_entry_count()->set_value(max_count);
+  cache_ = std::dynamic_pointer_cast<FileSystemHttpCache>(
+      http_cache_factory_->getCache(cacheConfig(cfg), context_));
+  waitForEvictionThreadIdle();
+  env_.writeStringToFileForTest(absl::StrCat(cache_path_, "cache-a"), file_contents, true);
+  cache_->trackFileAdded("cache-a", file_contents.size());
+  env_.writeStringToFileForTest(absl::StrCat(cache_path_, "cache-b"), file_contents, true);
+  // TODO(#24994): replace this with a simulated time source.
+  sleep(1); // NO_CHECK_FORMAT(real_time)
+  cache_->trackFileAdded("cache-b", file_contents.size());
+  sleep(1); // NO_CHECK_FORMAT(real_time)
+  // Reading cache-a makes cache-b the least recently used entry.
+  cache_->trackFileAccessed("cache-a", file_contents.size());
+  env_.writeStringToFileForTest(absl::StrCat(cache_path_, "cache-c"), file_contents, true);
+  cache_->trackFileAdded("cache-c", file_contents.size());
+  waitForEvictionThreadIdle();
+  EXPECT_EQ(cache_->stats().size_count_.value(), 2);
+  EXPECT_TRUE(Filesystem::fileSystemForTest().fileExists(absl::StrCat(cache_path_, "cache-a")));
+  EXPECT_FALSE(Filesystem::fileSystemForTest().fileExists(absl::StrCat(cache_path_, "cache-b")));
+  EXPECT_TRUE(Filesystem::fileSystemForTest().fileExists(absl::StrCat(cache_path_, "cache-c")));
+}
+
 class FileSystemHttpCacheTest : public FileSystemCacheTestContext, public ::testing::Test {
   void SetUp() override { initCache(); }
 };
@@ -216,19 +270,36 @@ TEST_F(FileSystemHttpCacheTest, StatsAreConstructedCorrectly) {
               ::testing::ElementsAre(IsStatTag("cache_path", cache_path_no_periods)));
 }
 
-TEST_F(FileSystemHttpCacheTest, TrackFileRemovedClampsAtZero) {
-  cache_->trackFileAdded(1);
+TEST_F(FileSystemHttpCacheTest, TrackFileRemovedOnlyRemovesIndexedFiles) {
+  cache_->trackFileAdded("cache-a", 1);
   EXPECT_EQ(cache_->stats().size_bytes_.value(), 1);
   EXPECT_EQ(cache_->stats().size_count_.value(), 1);
-  cache_->trackFileRemoved(8);
+  cache_->trackFileRemoved("cache-b");
+  EXPECT_EQ(cache_->stats().size_bytes_.value(), 1);
+  EXPECT_EQ(cache_->stats().size_count_.value(), 1);
+  cache_->trackFileRemoved("cache-a");
   EXPECT_EQ(cache_->stats().size_bytes_.value(), 0);
   EXPECT_EQ(cache_->stats().size_count_.value(), 0);
-  // Remove a second time to ensure that count going below zero also clamps at zero.
-  cache_->trackFileRemoved(8);
+  // Remove a second time to ensure that count doesn't go below zero.
+  cache_->trackFileRemoved("cache-a");
   EXPECT_EQ(cache_->stats().size_bytes_.value(), 0);
   EXPECT_EQ(cache_->stats().size_count_.value(), 0);
 }
 
+TEST_F(FileSystemHttpCacheTest, TrackFileAddedReplacesFileOfTheSameName) {
+  cache_->trackFileAdded("cache-a", 5);
+  cache_->trackFileAdded("cache-a", 8);
+  EXPECT_EQ(cache_->stats().size_bytes_.value(), 8);
+  EXPECT_EQ(cache_->stats().size_count_.value(), 1);
+}
+
+TEST_F(FileSystemHttpCacheTest, TrackFileAccessedIndexesUnknownFiles) {
+  cache_->trackFileAccessed("cache-a", 5);
+  cache_->trackFileAccessed("cache-a", 5);
+  EXPECT_EQ(cache_->stats().size_bytes_.value(), 5);
+  EXPECT_EQ(cache_->stats().size_count_.value(), 1);
+}
+
 TEST_F(FileSystemHttpCacheTest, ExceptionOnTryingToCreateCachesWithDistinctConfigsOnSamePath) {
   ConfigProto cfg = testConfig();
   cfg.mutable_manager_config()->mutable_thread_pool()->set_thread_count(2);
@@ -486,7 +557,6 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, InsertWithMultipleChunksBeforeCallb
   inserter->insertTrailers(response_trailers_, expect_true_callback_);
   EXPECT_EQ(0, true_callbacks_called_);
   EXPECT_CALL(*mock_async_file_handle_, write(_, _, _)).Times(6);
-  EXPECT_CALL(*mock_async_file_manager_, stat(_, _));
   EXPECT_CALL(*mock_async_file_manager_, unlink(_, _));
   EXPECT_CALL(*mock_async_file_handle_, createHardLink(_, _));
   // Open file
@@ -503,12 +573,9 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, InsertWithMultipleChunksBeforeCallb
   mock_async_file_manager_->nextActionCompletes(absl::StatusOr<size_t>(body2.size()));
   // Trailers
   mock_async_file_manager_->nextActionCompletes(absl::StatusOr<size_t>(trailers_size_));
-  // Updated pre-header (which triggers stat/unlink/createHardLink sequence)
+  // Updated pre-header (which triggers unlink/createHardLink sequence)
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<size_t>(CacheFileFixedBlock::size()));
-  // Stat
-  mock_async_file_manager_->nextActionCompletes(
-      absl::StatusOr<struct stat>{absl::UnknownError("intentionally failed stat")});
   // Unlink
   mock_async_file_manager_->nextActionCompletes(absl::UnknownError("intentionally failed unlink"));
   // createHardLink
@@ -535,8 +602,8 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedOpenForReadReturnsMiss) {
 
 TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfHeaderBlockInvalidatesTheCacheEntry) {
   // Fake-add two files of size 12345, so we can validate the stats decrease of removing a file.
-  cache_->trackFileAdded(12345);
-  cache_->trackFileAdded(12345);
+  cache_->trackFileAdded(cache_->generateFilename(key_), 12345);
+  cache_->trackFileAdded("cache-other", 12345);
   EXPECT_EQ(cache_->stats().size_bytes_.value(), 2 * 12345);
   EXPECT_EQ(cache_->stats().size_count_.value(), 2);
   auto lookup = testLookupContext();
@@ -547,14 +614,9 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfHeaderBlockInvalidatesT
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<AsyncFileHandle>(mock_async_file_handle_));
-  EXPECT_CALL(*mock_async_file_manager_, stat(_, _));
   EXPECT_CALL(*mock_async_file_manager_, unlink(_, _));
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<Buffer::InstancePtr>(absl::UnknownError("intentional failure to read")));
-  struct stat stat_result = {};
-  stat_result.st_size = 12345;
-  // stat
-  mock_async_file_manager_->nextActionCompletes(absl::StatusOr<struct stat>{stat_result});
   // unlink
   mock_async_file_manager_->nextActionCompletes(absl::OkStatus());
   EXPECT_EQ(result.cache_entry_status_, CacheEntryStatus::Unusable);
@@ -585,12 +647,9 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, ReadWithInvalidHeaderBlockInvalidat
   lookup->getHeaders([&](LookupResult&& r) { result = std::move(r); });
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<AsyncFileHandle>(mock_async_file_handle_));
-  EXPECT_CALL(*mock_async_file_manager_, stat(_, _));
   EXPECT_CALL(*mock_async_file_manager_, unlink(_, _));
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<Buffer::InstancePtr>(invalidHeaderBlock()));
-  mock_async_file_manager_->nextActionCompletes(absl::StatusOr<struct stat>{
-      absl::UnknownError("intentionally failed to stat, for coverage")});
   mock_async_file_manager_->nextActionCompletes(
       absl::UnknownError("intentionally failed to unlink, for coverage"));
   EXPECT_EQ(result.cache_entry_status_, CacheEntryStatus::Unusable);
@@ -608,12 +667,9 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfHeaderProtoInvalidatesT
       absl::StatusOr<AsyncFileHandle>(mock_async_file_handle_));
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<Buffer::InstancePtr>(testHeaderBlock(0)));
-  EXPECT_CALL(*mock_async_file_manager_, stat(_, _));
   EXPECT_CALL(*mock_async_file_manager_, unlink(_, _));
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<Buffer::InstancePtr>(absl::UnknownError("intentional failure to read")));
-  mock_async_file_manager_->nextActionCompletes(absl::StatusOr<struct stat>{
-      absl::UnknownError("intentionally failed to stat, for coverage")});
   mock_async_file_manager_->nextActionCompletes(
       absl::UnknownError("intentionally failed to unlink, for coverage"));
   EXPECT_EQ(result.cache_entry_status_, CacheEntryStatus::Unusable);
@@ -638,12 +694,9 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfBodyInvalidatesTheCache
   EXPECT_CALL(*mock_async_file_handle_, read(_, _, _));
   lookup->getBody(AdjustedByteRange(0, 8),
                   [&](Buffer::InstancePtr body) { EXPECT_EQ(body.get(), nullptr); });
-  EXPECT_CALL(*mock_async_file_manager_, stat(_, _));
   EXPECT_CALL(*mock_async_file_manager_, unlink(_, _));
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<Buffer::InstancePtr>(absl::UnknownError("intentional failure to read")));
-  mock_async_file_manager_->nextActionCompletes(absl::StatusOr<struct stat>{
-      absl::UnknownError("intentionally failed to stat, for coverage")});
   mock_async_file_manager_->nextActionCompletes(
       absl::UnknownError("intentionally failed to unlink, for coverage"));
 }
@@ -673,12 +726,9 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfTrailersInvalidatesTheC
   // No point validating that the trailers are empty since that's not even particularly
   // desirable behavior - it's a quirk of the filter that we can't properly signify an error.
   lookup->getTrailers([&](Http::ResponseTrailerMapPtr) {});
-  EXPECT_CALL(*mock_async_file_manager_, stat(_, _));
   EXPECT_CALL(*mock_async_file_manager_, unlink(_, _));
   mock_async_file_manager_->nextActionCompletes(absl::StatusOr<Buffer::InstancePtr>(
       absl::UnknownError("intentional failure to read trailers")));
-  mock_async_file_manager_->nextActionCompletes(absl::StatusOr<struct stat>{
-      absl::UnknownError("intentionally failed to stat, for coverage")});
   mock_async_file_manager_->nextActionCompletes(
       absl::UnknownError("intentionally failed to unlink, for coverage"));
 }
@@ -838,7 +888,6 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, InsertAbortsOnFailureToLinkFile) {
   absl::Cleanup destroy_inserter([&inserter]() { inserter->onDestroy(); });
   EXPECT_CALL(*mock_async_file_manager_, createAnonymousFile(_, _));
   EXPECT_CALL(*mock_async_file_handle_, write(_, _, _)).Times(5);
-  EXPECT_CALL(*mock_async_file_manager_, stat(_, _));
   EXPECT_CALL(*mock_async_file_manager_, unlink(_, _));
   EXPECT_CALL(*mock_async_file_handle_, createHardLink(_, _));
   inserter->insertHeaders(response_headers_, metadata_, expect_true_callback_, false);
@@ -854,8 +903,6 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, InsertAbortsOnFailureToLinkFile) {
   mock_async_file_manager_->nextActionCompletes(absl::StatusOr<size_t>(trailers_size_));
   mock_async_file_manager_->nextActionCompletes(
       absl::StatusOr<size_t>(CacheFileFixedBlock::size()));
-  mock_async_file_manager_->nextActionCompletes(absl::StatusOr<struct stat>{
-      absl::UnknownError("intentionally failed to stat, for coverage")});
   mock_async_file_manager_->nextActionCompletes(absl::OkStatus());
   mock_async_file_manager_->nextActionCompletes(
       absl::UnknownError("intentionally failed to link cache file"));
@@ -0,0 +1,161 @@
+#include "envoy/extensions/http/cache/in_memory_http_cache/v3/in_memory_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/http/cache/in_memory_http_cache/in_memory_http_cache.h"
+
+#include "test/extensions/filters/http/cache/common.h"
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace InMemoryHttpCache {
+namespace {
+
+MATCHER(IsOk, "") { return arg.ok(); }
+
+class InMemoryHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  explicit InMemoryHttpCacheTestDelegate(const ConfigProto& config = {})
+      : cache_(std::make_shared<InMemoryHttpCache>(nullptr, config, *store_.rootScope())) {}
+
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+  uint64_t counter(absl::string_view name) {
+    return TestUtility::findCounter(store_, absl::StrCat("cache.in_memory.", name))->value();
+  }
+  uint64_t gauge(absl::string_view name) {
+    return TestUtility::findGauge(store_, absl::StrCat("cache.in_memory.", name))->value();
+  }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  std::shared_ptr<InMemoryHttpCache> cache_;
+};
+
+INSTANTIATE_TEST_SUITE_P(InMemoryHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values([] {
+                           return std::make_unique<InMemoryHttpCacheTestDelegate>();
+                         }),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "InMemoryHttpCache";
+                         });
+
+// A single shard, with room for two of the responses below but not three.
+ConfigProto smallConfig() {
+  ConfigProto config;
+  config.mutable_max_cache_size_bytes()->set_value(2500);
+  config.mutable_shards()->set_value(1);
+  return config;
+}
+
+class InMemoryHttpCacheTest : public HttpCacheImplementationTest {
+protected:
+  InMemoryHttpCacheTestDelegate& delegate() {
+    return static_cast<InMemoryHttpCacheTestDelegate&>(*delegate_);
+  }
+
+  const Http::TestResponseHeaderMapImpl response_headers_{
+      {":status", "200"},
+      {"date", formatter_.fromTime(time_system_.systemTime())},
+      {"cache-control", "public,max-age=3600"}};
+  const std::string body_ = std::string(500, 'a');
+};
+
+INSTANTIATE_TEST_SUITE_P(InMemoryHttpCacheTest, InMemoryHttpCacheTest,
+                         testing::Values([] {
+                           return std::make_unique<InMemoryHttpCacheTestDelegate>(smallConfig());
+                         }));
+
+TEST_P(InMemoryHttpCacheTest, EvictsLeastRecentlyUsed) {
+  ASSERT_THAT(insert("/a", response_headers_, body_), IsOk());
+  ASSERT_THAT(insert("/b", response_headers_, body_), IsOk());
+  EXPECT_EQ(2, delegate().gauge("size_count"));
+
+  // Using /a makes /b the least recently used entry.
+  lookup("/a");
+  EXPECT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_);
+  ASSERT_THAT(insert("/c", response_headers_, body_), IsOk());
+  EXPECT_EQ(1, delegate().counter("evictions"));
+  EXPECT_EQ(2, delegate().gauge("size_count"));
+  EXPECT_LE(delegate().gauge("size_bytes"), 2500);
+
+  lookup("/b");
+  EXPECT_EQ(CacheEntryStatus::Unusable, lookup_result_.cache_entry_status_);
+  lookup("/a");
+  EXPECT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_);
+  lookup("/c");
+  EXPECT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_);
+}
+
+TEST_P(InMemoryHttpCacheTest, CountsHitsAndMisses) {
+  lookup("/a");
+  ASSERT_THAT(insert("/a", response_headers_, body_), IsOk());
+  lookup("/a");
+  lookup("/a");
+  EXPECT_EQ(2, delegate().counter("misses"));
+  EXPECT_EQ(2, delegate().counter("hits"));
+  EXPECT_EQ(1, delegate().counter("inserts"));
+}
+
+TEST_P(InMemoryHttpCacheTest, RejectsTooLargeEntries) {
+  EXPECT_FALSE(insert("/a", response_headers_, std::string(3000, 'a')).ok());
+  EXPECT_EQ(1, delegate().counter("inserts_rejected"));
+  EXPECT_EQ(0, delegate().counter("inserts"));
+  EXPECT_EQ(0, delegate().gauge("size_count"));
+  lookup("/a");
+  EXPECT_EQ(CacheEntryStatus::Unusable, lookup_result_.cache_entry_status_);
+}
+
+TEST_P(InMemoryHttpCacheTest, ServesBodyWithoutCopies) {
+  ASSERT_THAT(insert("/a", response_headers_, body_), IsOk());
+  LookupContextPtr first = lookup("/a");
+  LookupContextPtr second = lookup("/a");
+  Buffer::InstancePtr first_body;
+  Buffer::InstancePtr second_body;
+  first->getBody({0, body_.size()},
+                 [&first_body](Buffer::InstancePtr&& body) { first_body = std::move(body); });
+  second->getBody({0, body_.size()},
+                  [&second_body](Buffer::InstancePtr&& body) { second_body = std::move(body); });
+  ASSERT_NE(first_body, nullptr);
+  ASSERT_NE(second_body, nullptr);
+  EXPECT_EQ(body_, first_body->toString());
+  // Both bodies reference the cached copy.
+  EXPECT_EQ(first_body->frontSlice().mem_, second_body->frontSlice().mem_);
+  first->onDestroy();
+  second->onDestroy();
+}
+
+TEST(Registration, GetFactory) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.in_memory_http_cache.v3.InMemoryHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  config.mutable_typed_config()->PackFrom(*factory->createEmptyConfigProto());
+  std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+  EXPECT_EQ(cache->cacheInfo().name_, "envoy.extensions.http.cache.in_memory_http_cache");
+  // Filters with equal configs share the cache.
+  EXPECT_EQ(cache, factory->getCache(config, factory_context));
+
+  ConfigProto other_config;
+  other_config.mutable_shards()->set_value(1);
+  config.mutable_typed_config()->PackFrom(other_config);
+  EXPECT_NE(cache, factory->getCache(config, factory_context));
+}
+
+} // namespace
+} // namespace InMemoryHttpCache
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
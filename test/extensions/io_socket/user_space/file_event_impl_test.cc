@@ -385,6 +385,54 @@ TEST_F(FileEventImplTest, ActivateIfEnabledTriggerOnlyEnabled) {
   }
 }
 
+// Events activated on behalf of the peer from the dispatcher are delivered in the same iteration of
+// the event loop.
+TEST_F(FileEventImplTest, ActivateIfEnabledDeliversInCurrentIteration) {
+  user_file_event_ = std::make_unique<FileEventImpl>(
+      *dispatcher_, [this](uint32_t arg) { ready_cb_.called(arg); }, event_rw, io_source_);
+  auto peer_write = dispatcher_->createSchedulableCallback(
+      [this]() { user_file_event_->activateIfEnabled(Event::FileReadyType::Read); });
+  peer_write->scheduleCallbackCurrentIteration();
+  EXPECT_CALL(ready_cb_, called(Event::FileReadyType::Read));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+}
+
+TEST_F(FileEventImplTest, ActivateIfEnabledDeliversInNextIterationWhenDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.user_space_activate_in_current_iteration", "false"}});
+  user_file_event_ = std::make_unique<FileEventImpl>(
+      *dispatcher_, [this](uint32_t arg) { ready_cb_.called(arg); }, event_rw, io_source_);
+  auto peer_write = dispatcher_->createSchedulableCallback(
+      [this]() { user_file_event_->activateIfEnabled(Event::FileReadyType::Read); });
+  peer_write->scheduleCallbackCurrentIteration();
+  {
+    EXPECT_CALL(ready_cb_, called(_)).Times(0);
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  {
+    EXPECT_CALL(ready_cb_, called(Event::FileReadyType::Read));
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+}
+
+// A callback activating its own events again doesn't keep the dispatcher in the same iteration.
+TEST_F(FileEventImplTest, CurrentIterationCallbacksAreBounded) {
+  uint32_t callbacks = 0;
+  user_file_event_ = std::make_unique<FileEventImpl>(
+      *dispatcher_,
+      [this, &callbacks](uint32_t) {
+        callbacks++;
+        user_file_event_->activateIfEnabled(Event::FileReadyType::Read);
+      },
+      Event::FileReadyType::Read, io_source_);
+  user_file_event_->activate(Event::FileReadyType::Read);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(FileEventImpl::MaxCallbacksPerIteration, callbacks);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(2 * FileEventImpl::MaxCallbacksPerIteration, callbacks);
+}
+
 TEST_F(FileEventImplTest, EventClosedIsTriggeredBySetWriteEnd) {
   setWriteEnd();
   user_file_event_ = std::make_unique<FileEventImpl>(
@@ -634,7 +634,7 @@ TEST_F(IoHandleImplTest, ReadAndWriteAreEdgeTriggered) {
   schedulable_cb->invokeCallback();
 
   Buffer::OwnedImpl buf("abcd");
-  EXPECT_CALL(*schedulable_cb, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb, scheduleCallbackCurrentIteration());
   io_handle_peer_->write(buf);
 
   EXPECT_CALL(cb_, called(Event::FileReadyType::Read));
@@ -708,7 +708,7 @@ TEST_F(IoHandleImplTest, DrainToLowWaterMarkTriggerReadEvent) {
   }
   {
     SCOPED_TRACE("drain to low watermark.");
-    EXPECT_CALL(*schedulable_cb, scheduleCallbackNextIteration());
+    EXPECT_CALL(*schedulable_cb, scheduleCallbackCurrentIteration());
     auto result = io_handle_->recv(buf_.data(), 232, 0);
     EXPECT_TRUE(io_handle_->isWritable());
     EXPECT_CALL(cb_, called(Event::FileReadyType::Write));
@@ -716,7 +716,7 @@ TEST_F(IoHandleImplTest, DrainToLowWaterMarkTriggerReadEvent) {
   }
   {
     SCOPED_TRACE("clean up.");
-    EXPECT_CALL(*schedulable_cb, scheduleCallbackNextIteration());
+    EXPECT_CALL(*schedulable_cb, scheduleCallbackCurrentIteration());
     // Important: close before peer.
     io_handle_->close();
   }
@@ -767,7 +767,7 @@ TEST_F(IoHandleImplTest, Close) {
   // Not closed yet.
   ASSERT_FALSE(should_close);
 
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->close();
 
   ASSERT_TRUE(schedulable_cb_->enabled());
@@ -811,7 +811,7 @@ TEST_F(IoHandleImplTest, ShutDownRaiseEvent) {
   // Not closed yet.
   ASSERT_FALSE(should_close);
 
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->shutdown(ENVOY_SHUT_WR);
 
   ASSERT_TRUE(schedulable_cb_->enabled());
@@ -850,7 +850,7 @@ TEST_F(IoHandleImplTest, WriteScheduleWritableEvent) {
   EXPECT_FALSE(schedulable_cb_->enabled());
 
   Buffer::OwnedImpl data_to_write("0123456789");
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->write(data_to_write);
   EXPECT_EQ(0, data_to_write.length());
 
@@ -891,7 +891,7 @@ TEST_F(IoHandleImplTest, WritevScheduleWritableEvent) {
 
   std::string raw_data("0123456789");
   Buffer::RawSlice slice{static_cast<void*>(raw_data.data()), raw_data.size()};
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_peer_->writev(&slice, 1);
 
   EXPECT_TRUE(schedulable_cb_->enabled());
@@ -935,7 +935,7 @@ TEST_F(IoHandleImplTest, ReadAfterShutdownWrite) {
   EXPECT_FALSE(schedulable_cb_->enabled());
   std::string raw_data("0123456789");
   Buffer::RawSlice slice{static_cast<void*>(raw_data.data()), raw_data.size()};
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_->writev(&slice, 1);
   EXPECT_TRUE(schedulable_cb_->enabled());
 
@@ -943,7 +943,7 @@ TEST_F(IoHandleImplTest, ReadAfterShutdownWrite) {
   EXPECT_FALSE(schedulable_cb_->enabled());
   EXPECT_EQ(raw_data, accumulator);
 
-  EXPECT_CALL(*schedulable_cb_, scheduleCallbackNextIteration());
+  EXPECT_CALL(*schedulable_cb_, scheduleCallbackCurrentIteration());
   io_handle_->close();
   io_handle_->resetFileEvents();
 }
@@ -178,6 +178,10 @@ const char YamlSingleServer[] = R"EOF(
 const char YamlSingleDstPortTop[] = R"EOF(
     - filter_chain_match:
         destination_port: )EOF";
+const char YamlSingleServerNameTop[] = R"EOF(
+    - filter_chain_match:
+        transport_protocol: "tls"
+        server_names: )EOF";
 const char YamlSingleDstPortBottom[] = R"EOF(
       transport_socket:
         name: "envoy.transport_sockets.tls"
@@ -190,19 +194,28 @@ const char YamlSingleDstPortBottom[] = R"EOF(
           session_ticket_keys:
             keys:
             - filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/ticket_key_a")EOF";
+
+std::string serverName(int i) { return absl::StrCat("server", i, ".example.org"); }
 } // namespace
 
+// The filter chains of the benchmarks match on state.range(0) destination ports if state.range(1)
+// is 0, or on as many server names otherwise.
 class FilterChainBenchmarkFixture : public ::benchmark::Fixture {
 public:
   void initialize(::benchmark::State& state) {
     int64_t input_size = state.range(0);
-    std::vector<std::string> port_chains;
-    port_chains.reserve(input_size);
+    std::vector<std::string> chains;
+    chains.reserve(input_size);
     for (int i = 0; i < input_size; i++) {
-      port_chains.push_back(absl::StrCat(YamlSingleDstPortTop, 10000 + i, YamlSingleDstPortBottom));
+      if (state.range(1) == 0) {
+        chains.push_back(absl::StrCat(YamlSingleDstPortTop, 10000 + i, YamlSingleDstPortBottom));
+      } else {
+        chains.push_back(absl::StrCat(YamlSingleServerNameTop, "\"", serverName(i), "\"",
+                                      YamlSingleDstPortBottom));
+      }
     }
     listener_yaml_config_ = TestEnvironment::substitute(
-        absl::StrCat(YamlHeader, YamlSingleServer, absl::StrJoin(port_chains, "")),
+        absl::StrCat(YamlHeader, YamlSingleServer, absl::StrJoin(chains, "")),
         Network::Address::IpVersion::v4);
     TestUtility::loadFromYaml(listener_yaml_config_, listener_config_);
     filter_chains_ = listener_config_.filter_chains();
@@ -249,8 +262,12 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
   std::vector<MockConnectionSocket> sockets;
   sockets.reserve(state.range(0));
   for (int i = 0; i < state.range(0); i++) {
-    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
-        10000 + i, "127.0.0.1", "", "", "tls", {}, "8.8.8.8", 111)));
+    sockets.push_back(std::move(
+        state.range(1) == 0
+            ? *MockConnectionSocket::createMockConnectionSocket(10000 + i, "127.0.0.1", "", "",
+                                                                "tls", {}, "8.8.8.8", 111)
+            : *MockConnectionSocket::createMockConnectionSocket(1234, "127.0.0.1", serverName(i),
+                                                                "", "tls", {}, "8.8.8.8", 111)));
   }
   NiceMock<Server::Configuration::MockFactoryContext> factory_context;
   std::vector<Network::Address::InstanceConstSharedPtr> addresses;
@@ -267,16 +284,51 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     }
   }
 }
+// The update of a listener whose filter chains are all unchanged, with every filter chain being
+// reused from the origin filter chain manager.
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainManagerUpdateTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initialize(state);
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  FilterChainManagerImpl origin{addresses, factory_context, init_manager_};
+  origin.addFilterChains(nullptr, filter_chains_, nullptr, dummy_builder_, origin);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_, origin};
+    filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr, dummy_builder_,
+                                         filter_chain_manager);
+  }
+}
+
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
     ->Ranges({
         // scale of the chains
-        {1, 4096},
+        {1, 16384},
+        // destination ports or server names
+        {0, 1},
+    })
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerUpdateTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 16384},
+        // destination ports or server names
+        {0, 1},
     })
     ->Unit(::benchmark::kMillisecond);
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     ->Ranges({
         // scale of the chains
-        {1, 4096},
+        {1, 16384},
+        // destination ports or server names
+        {0, 1},
     })
     ->Unit(::benchmark::kMillisecond);
 
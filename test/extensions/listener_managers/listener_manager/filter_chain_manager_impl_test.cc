@@ -254,6 +254,12 @@ TEST_P(FilterChainManagerImplTest, DuplicateContextsAreNotBuilt) {
       std::vector<const envoy::config::listener::v3::FilterChain*>{
           &filter_chain_messages[0], &filter_chain_messages[1], &filter_chain_messages[2]},
       nullptr, filter_chain_factory_builder_, new_filter_chain_manager);
+
+  // The filter chain built by the origin is shared with the new filter chain manager.
+  const HashedFilterChainMessage reused_message(filter_chain_messages[0]);
+  EXPECT_EQ(3, new_filter_chain_manager.filterChainsByMessage().size());
+  EXPECT_EQ(filter_chain_manager_->filterChainsByMessage().at(reused_message),
+            new_filter_chain_manager.filterChainsByMessage().at(reused_message));
 }
 
 TEST_P(FilterChainManagerImplTest, CreatedFilterChainFactoryContextHasIndependentDrainClose) {
@@ -287,6 +293,45 @@ TEST_P(FilterChainManagerImplTest, CreatedFilterChainFactoryContextHasIndependen
   EXPECT_FALSE(context1->drainDecision().drainClose());
 }
 
+// The address levels only holding the catch-all entry are matched without building tries, and
+// still match the addresses of all the supported families, as well as non-IP addresses.
+TEST_P(FilterChainManagerImplTest, CatchAllAddresses) {
+  envoy::config::listener::v3::FilterChain catch_all_filter_chain = filter_chain_template_;
+  catch_all_filter_chain.set_name("catch_all");
+  catch_all_filter_chain.mutable_filter_chain_match()->clear_destination_port();
+  catch_all_filter_chain.mutable_filter_chain_match()->add_server_names("a.example.com");
+  envoy::config::listener::v3::FilterChain source_filter_chain = catch_all_filter_chain;
+  source_filter_chain.set_name("source");
+  source_filter_chain.mutable_filter_chain_match()->set_server_names(0, "b.example.com");
+  auto* source_range = source_filter_chain.mutable_filter_chain_match()->add_source_prefix_ranges();
+  source_range->set_address_prefix("10.0.0.0");
+  source_range->mutable_prefix_len()->set_value(8);
+
+  auto catch_all = std::make_shared<Network::MockFilterChain>();
+  auto source = std::make_shared<Network::MockFilterChain>();
+  EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _))
+      .WillOnce(Return(catch_all))
+      .WillOnce(Return(source));
+  filter_chain_manager_->addFilterChains(
+      nullptr,
+      std::vector<const envoy::config::listener::v3::FilterChain*>{&catch_all_filter_chain,
+                                                                   &source_filter_chain},
+      nullptr, filter_chain_factory_builder_, *filter_chain_manager_);
+
+  EXPECT_EQ(catch_all.get(),
+            findFilterChainHelper(10000, "127.0.0.1", "a.example.com", "tls", {}, "8.8.8.8", 111));
+  EXPECT_EQ(catch_all.get(),
+            findFilterChainHelper(0, "/pipe/dst", "a.example.com", "tls", {}, "/pipe/src", 0));
+  if (TestEnvironment::shouldRunTestForIpVersion(Network::Address::IpVersion::v6)) {
+    EXPECT_EQ(catch_all.get(),
+              findFilterChainHelper(10000, "::1", "a.example.com", "tls", {}, "2001::1", 111));
+  }
+  EXPECT_EQ(source.get(),
+            findFilterChainHelper(10000, "127.0.0.1", "b.example.com", "tls", {}, "10.1.2.3", 111));
+  EXPECT_EQ(nullptr,
+            findFilterChainHelper(10000, "127.0.0.1", "b.example.com", "tls", {}, "8.8.8.8", 111));
+}
+
 INSTANTIATE_TEST_SUITE_P(Matcher, FilterChainManagerImplTest, ::testing::Values(true, false));
 
 } // namespace Server
@@ -7992,6 +7992,40 @@ TEST_P(ListenerManagerImplTest, TcpBacklogCustomConfig) {
   EXPECT_EQ(100U, manager_->listeners().back().get().tcpBacklogSize());
 }
 
+TEST_P(ListenerManagerImplTest, MaxConnectionsToAcceptPerSocketEventConfig) {
+  const std::string yaml = TestEnvironment::substitute(R"EOF(
+    name: foo
+    address:
+      socket_address: { address: 127.0.0.1, port_value: 1111 }
+    max_connections_to_accept_per_socket_event: 8
+    filter_chains:
+    - filters:
+  )EOF",
+                                                       Network::Address::IpVersion::v4);
+
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, _, _, _));
+  addOrUpdateListener(parseListenerFromV3Yaml(yaml));
+  EXPECT_EQ(1U, manager_->listeners().size());
+  EXPECT_EQ(8U, manager_->listeners().back().get().maxConnectionsToAcceptPerSocketEvent());
+}
+
+TEST_P(ListenerManagerImplTest, MaxConnectionsToAcceptPerSocketEventDefault) {
+  const std::string yaml = TestEnvironment::substitute(R"EOF(
+    name: foo
+    address:
+      socket_address: { address: 127.0.0.1, port_value: 1111 }
+    filter_chains:
+    - filters:
+  )EOF",
+                                                       Network::Address::IpVersion::v4);
+
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, _, _, _));
+  addOrUpdateListener(parseListenerFromV3Yaml(yaml));
+  EXPECT_EQ(1U, manager_->listeners().size());
+  EXPECT_EQ(Network::DefaultMaxConnectionsToAcceptPerSocketEvent,
+            manager_->listeners().back().get().maxConnectionsToAcceptPerSocketEvent());
+}
+
 TEST_P(ListenerManagerImplTest, WorkersStartedCallbackCalled) {
   InSequence s;
 
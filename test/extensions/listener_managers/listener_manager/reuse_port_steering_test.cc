@@ -0,0 +1,132 @@
+#include "source/common/network/utility.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/listener_managers/listener_manager/reuse_port_steering.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::ElementsAre;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+TEST(ReusePortSteeringTest, Weights) {
+  EXPECT_THAT(ReusePortSteering::weights({0, 0, 0}), ElementsAre(1000, 1000, 1000));
+  EXPECT_THAT(ReusePortSteering::weights({0, 1, 3}), ElementsAre(1000, 500, 250));
+  EXPECT_THAT(ReusePortSteering::weights({9, 19, 99}), ElementsAre(1000, 500, 100));
+  // Workers keep a share of the new connections, however loaded.
+  EXPECT_THAT(ReusePortSteering::weights({0, 1000000}), ElementsAre(1000, 1));
+}
+
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+// Runs the instructions emitted by buildProgram() for a connection hash.
+uint32_t runProgram(const std::vector<sock_filter>& program, uint32_t hash) {
+  uint32_t a = 0;
+  for (size_t pc = 0; pc < program.size(); ++pc) {
+    const sock_filter& insn = program[pc];
+    switch (insn.code) {
+    case BPF_LD | BPF_W | BPF_ABS:
+      EXPECT_EQ(static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_RXHASH), insn.k);
+      a = hash;
+      break;
+    case BPF_ALU | BPF_MOD | BPF_K:
+      a %= insn.k;
+      break;
+    case BPF_JMP | BPF_JGE | BPF_K:
+      pc += a >= insn.k ? insn.jt : insn.jf;
+      break;
+    case BPF_RET | BPF_K:
+      return insn.k;
+    default:
+      ADD_FAILURE() << "unexpected instruction " << insn.code;
+      return 0;
+    }
+  }
+  ADD_FAILURE() << "no return";
+  return 0;
+}
+
+TEST(ReusePortSteeringTest, Program) {
+  const std::vector<sock_filter> program = ReusePortSteering::buildProgram({1000, 500, 250, 250});
+  EXPECT_EQ(9, program.size());
+
+  std::vector<uint32_t> picks(4);
+  for (uint32_t hash = 0; hash < 2000; ++hash) {
+    ++picks[runProgram(program, hash)];
+  }
+  EXPECT_THAT(picks, ElementsAre(1000, 500, 250, 250));
+  EXPECT_EQ(0, runProgram(program, 2000));
+  EXPECT_EQ(3, runProgram(program, 1999));
+
+  EXPECT_EQ(3, ReusePortSteering::buildProgram({1000}).size());
+}
+
+class ReusePortSteeringUpdateTest : public testing::Test {
+protected:
+  ReusePortSteeringUpdateTest() {
+    auto socket_factory = std::make_unique<NiceMock<Network::MockListenSocketFactory>>();
+    ON_CALL(*socket_factory, getListenSocket(0)).WillByDefault(Return(socket_));
+    ON_CALL(*socket_factory, localAddress()).WillByDefault(ReturnRef(address_));
+    socket_factories_.push_back(std::move(socket_factory));
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Stats::IsolatedStoreImpl store_;
+  Network::Address::InstanceConstSharedPtr address_{
+      Network::Utility::parseInternetAddress("127.0.0.1", 10000)};
+  std::shared_ptr<NiceMock<Network::MockListenSocket>> socket_{
+      std::make_shared<NiceMock<Network::MockListenSocket>>()};
+  std::vector<Network::ListenSocketFactoryPtr> socket_factories_;
+};
+
+TEST_F(ReusePortSteeringUpdateTest, AttachProgram) {
+  auto* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(500), _));
+  ReusePortSteering steering(dispatcher_, *store_.rootScope(), 2, std::chrono::milliseconds(500),
+                             socket_factories_);
+
+  store_.rootScope()
+      ->gaugeFromString("worker_1.downstream_cx_active", Stats::Gauge::ImportMode::Accumulate)
+      .set(3);
+  EXPECT_CALL(*socket_, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, _))
+      .WillOnce(Invoke([](int, int, const void* optval, socklen_t) -> Api::SysCallIntResult {
+        const auto* prog = static_cast<const sock_fprog*>(optval);
+        const std::vector<sock_filter> program(prog->filter, prog->filter + prog->len);
+        // The weights are 1000 and 250.
+        EXPECT_EQ(0, runProgram(program, 999));
+        EXPECT_EQ(1, runProgram(program, 1000));
+        EXPECT_EQ(1, runProgram(program, 1249));
+        EXPECT_EQ(0, runProgram(program, 1250));
+        return {0, 0};
+      }));
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(500), _));
+  timer->invokeCallback();
+}
+
+// The updates stop if the kernel rejects the program.
+TEST_F(ReusePortSteeringUpdateTest, AttachFailure) {
+  auto* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(500), _));
+  ReusePortSteering steering(dispatcher_, *store_.rootScope(), 2, std::chrono::milliseconds(500),
+                             socket_factories_);
+
+  EXPECT_CALL(*socket_, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EINVAL}));
+  EXPECT_CALL(*timer, enableTimer(_, _)).Times(0);
+  EXPECT_LOG_CONTAINS("warn", "new connections are hashed by the kernel", timer->invokeCallback());
+}
+#endif
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
@@ -0,0 +1,50 @@
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/extensions/network/connection_balance/load_aware/v3/load_aware.pb.h"
+
+#include "source/extensions/network/connection_balance/load_aware/config.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+namespace {
+
+TEST(LoadAwareConnectionBalanceFactoryTest, CreateBalancer) {
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  typed_config.set_name("envoy.network.connection_balance.load_aware");
+  envoy::extensions::network::connection_balance::load_aware::v3::LoadAware config;
+  typed_config.mutable_typed_config()->PackFrom(config);
+
+  auto* factory =
+      Registry::FactoryRegistry<Envoy::Network::ConnectionBalanceFactory>::getFactoryByType(
+          "envoy.extensions.network.connection_balance.load_aware.v3.LoadAware");
+  ASSERT_NE(nullptr, factory);
+  EXPECT_EQ("envoy.network.connection_balance.load_aware", factory->name());
+  EXPECT_NE(nullptr, factory->createConnectionBalancerFromProto(typed_config, context));
+}
+
+TEST(LoadAwareConnectionBalanceFactoryTest, InvalidSampleInterval) {
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  envoy::extensions::network::connection_balance::load_aware::v3::LoadAware config;
+  config.mutable_loop_delay_sample_interval()->set_nanos(1000);
+  typed_config.mutable_typed_config()->PackFrom(config);
+
+  LoadAwareConnectionBalanceFactory factory;
+  EXPECT_THROW(factory.createConnectionBalancerFromProto(typed_config, context),
+               ProtoValidationException);
+}
+
+} // namespace
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,155 @@
+#include "source/extensions/network/connection_balance/load_aware/connection_balancer_impl.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+namespace {
+
+class TestHandler : public Envoy::Network::BalancedConnectionHandler {
+public:
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(Envoy::Network::ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(Envoy::Network::ConnectionSocketPtr&&, bool, bool) override {}
+
+  uint64_t num_connections_{};
+};
+
+class LoadAwareConnectionBalancerTest : public testing::Test {
+protected:
+  // Registers a handler and returns the timer sampling its loop delay.
+  Event::MockTimer* registerHandler(TestHandler& handler) {
+    auto* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+    EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(100), _));
+    balancer_.registerHandler(handler, dispatcher_);
+    return timer;
+  }
+
+  // Fires the sample timer of a handler `delay` after it was due.
+  void sample(Event::MockTimer& timer, std::chrono::milliseconds delay) {
+    time_system_.advanceTimeWait(std::chrono::milliseconds(100) + delay);
+    timer.invokeCallback();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  LoadAwareConnectionBalancerImpl balancer_{4, random_, std::chrono::milliseconds(100),
+                                            std::chrono::microseconds(1000)};
+};
+
+TEST_F(LoadAwareConnectionBalancerTest, NoOtherHandler) {
+  TestHandler current;
+  EXPECT_EQ(&current, &balancer_.pickTargetHandler(current));
+  EXPECT_EQ(1, current.num_connections_);
+
+  registerHandler(current);
+  EXPECT_EQ(&current, &balancer_.pickTargetHandler(current));
+  EXPECT_EQ(2, current.num_connections_);
+}
+
+// With no loop delay, the handler with the fewest connections is picked.
+TEST_F(LoadAwareConnectionBalancerTest, FewestConnections) {
+  TestHandler first;
+  TestHandler second;
+  registerHandler(first);
+  registerHandler(second);
+  first.num_connections_ = 5;
+
+  for (const uint64_t random : {0UL, 1UL, 0x100000000UL}) {
+    EXPECT_CALL(random_, random()).WillOnce(Return(random));
+    EXPECT_EQ(&second, &balancer_.pickTargetHandler(first));
+  }
+  EXPECT_EQ(3, second.num_connections_);
+  EXPECT_EQ(5, first.num_connections_);
+}
+
+// A handler whose loop runs late is avoided, even with fewer connections.
+TEST_F(LoadAwareConnectionBalancerTest, LowerLoopDelay) {
+  TestHandler first;
+  TestHandler second;
+  Event::MockTimer* first_timer = registerHandler(first);
+  registerHandler(second);
+  second.num_connections_ = 5;
+
+  EXPECT_CALL(*first_timer, enableTimer(std::chrono::milliseconds(100), _));
+  sample(*first_timer, std::chrono::milliseconds(48));
+  // The first sample is weighted by 1/8.
+  EXPECT_EQ(6000, balancer_.loopDelayUs(first));
+  EXPECT_EQ(0, balancer_.loopDelayUs(second));
+  EXPECT_EQ(&second, &balancer_.pickTargetHandler(first));
+
+  // The delay decays as the loop catches up.
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_CALL(*first_timer, enableTimer(std::chrono::milliseconds(100), _));
+    sample(*first_timer, std::chrono::milliseconds(0));
+  }
+  EXPECT_GT(1000, balancer_.loopDelayUs(first));
+  EXPECT_EQ(&first, &balancer_.pickTargetHandler(first));
+}
+
+// Loop delays within the tolerance are considered equal.
+TEST_F(LoadAwareConnectionBalancerTest, LoopDelayWithinTolerance) {
+  TestHandler first;
+  TestHandler second;
+  Event::MockTimer* first_timer = registerHandler(first);
+  registerHandler(second);
+  second.num_connections_ = 5;
+
+  EXPECT_CALL(*first_timer, enableTimer(std::chrono::milliseconds(100), _));
+  sample(*first_timer, std::chrono::milliseconds(8));
+  EXPECT_EQ(1000, balancer_.loopDelayUs(first));
+  EXPECT_EQ(&first, &balancer_.pickTargetHandler(second));
+}
+
+// Unregistered handlers are not picked, and their slots are reused.
+TEST_F(LoadAwareConnectionBalancerTest, Unregister) {
+  TestHandler first;
+  TestHandler second;
+  TestHandler third;
+  registerHandler(first);
+  registerHandler(second);
+  balancer_.unregisterHandler(first);
+
+  EXPECT_EQ(&second, &balancer_.pickTargetHandler(second));
+  EXPECT_EQ(&second, &balancer_.pickTargetHandler(third));
+
+  second.num_connections_ = 5;
+  registerHandler(third);
+  EXPECT_EQ(&third, &balancer_.pickTargetHandler(second));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, TooManyHandlers) {
+  TestHandler handlers[5];
+  for (int i = 0; i < 4; ++i) {
+    registerHandler(handlers[i]);
+  }
+  EXPECT_ENVOY_BUG(balancer_.registerHandler(handlers[4], dispatcher_),
+                   "more than 4 handlers registered");
+
+  // The handler that didn't fit keeps its own connections.
+  handlers[0].num_connections_ = 1;
+  handlers[1].num_connections_ = 1;
+  handlers[2].num_connections_ = 1;
+  handlers[3].num_connections_ = 1;
+  EXPECT_NE(&handlers[4], &balancer_.pickTargetHandler(handlers[4]));
+}
+
+} // namespace
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,178 @@
+#include "envoy/extensions/resource_monitors/cgroup/v3/cgroup.pb.h"
+
+#include "source/extensions/resource_monitors/cgroup/cgroup_cpu_monitor.h"
+#include "source/extensions/resource_monitors/cgroup/cgroup_memory_monitor.h"
+
+#include "test/test_common/file_system_for_test.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/types/optional.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+namespace {
+
+using testing::Return;
+
+class MockCgroupStatsReader : public CgroupStatsReader {
+public:
+  MockCgroupStatsReader() : CgroupStatsReader(Filesystem::fileSystemForTest(), "/nonexistent") {}
+
+  MOCK_METHOD(MemoryStats, memoryStats, ());
+  MOCK_METHOD(CpuStats, cpuStats, ());
+};
+
+class ResourcePressure : public Server::ResourceUpdateCallbacks {
+public:
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+  }
+
+  void onFailure(const EnvoyException& error) override { error_ = error; }
+
+  bool hasPressure() const { return pressure_.has_value(); }
+  bool hasError() const { return error_.has_value(); }
+
+  double pressure() const { return *pressure_; }
+
+private:
+  absl::optional<double> pressure_;
+  absl::optional<EnvoyException> error_;
+};
+
+CgroupStatsReader::MemoryStats memoryStats(uint64_t usage, uint64_t inactive_file,
+                                           absl::optional<uint64_t> limit) {
+  return {usage, inactive_file, limit};
+}
+
+CgroupStatsReader::CpuStats cpuStats(uint64_t usage_usec, absl::optional<double> quota_cpus,
+                                     uint64_t periods, uint64_t throttled_periods) {
+  return {std::chrono::microseconds(usage_usec), quota_cpus, periods, throttled_periods};
+}
+
+TEST(CgroupMemoryMonitorTest, ComputesWorkingSetPressure) {
+  envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig config;
+  auto stats_reader = std::make_unique<MockCgroupStatsReader>();
+  EXPECT_CALL(*stats_reader, memoryStats()).WillOnce(Return(memoryStats(900, 400, 1000)));
+  CgroupMemoryMonitor monitor(config, std::move(stats_reader));
+
+  ResourcePressure resource;
+  monitor.updateResourceUsage(resource);
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_FALSE(resource.hasError());
+  EXPECT_DOUBLE_EQ(0.5, resource.pressure());
+}
+
+TEST(CgroupMemoryMonitorTest, MaxMemoryBytesCapsTheLimit) {
+  envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig config;
+  config.set_max_memory_bytes(500);
+  auto stats_reader = std::make_unique<MockCgroupStatsReader>();
+  EXPECT_CALL(*stats_reader, memoryStats())
+      .WillOnce(Return(memoryStats(400, 0, 1000)))
+      .WillOnce(Return(memoryStats(400, 0, absl::nullopt)));
+  CgroupMemoryMonitor monitor(config, std::move(stats_reader));
+
+  ResourcePressure resource;
+  monitor.updateResourceUsage(resource);
+  EXPECT_DOUBLE_EQ(0.8, resource.pressure());
+  monitor.updateResourceUsage(resource);
+  EXPECT_DOUBLE_EQ(0.8, resource.pressure());
+}
+
+TEST(CgroupMemoryMonitorTest, FailsWithoutLimit) {
+  envoy::extensions::resource_monitors::cgroup::v3::CgroupMemoryConfig config;
+  auto stats_reader = std::make_unique<MockCgroupStatsReader>();
+  EXPECT_CALL(*stats_reader, memoryStats())
+      .WillOnce(Return(memoryStats(400, 0, absl::nullopt)))
+      .WillOnce([]() -> CgroupStatsReader::MemoryStats { throw EnvoyException("unreadable"); });
+  CgroupMemoryMonitor monitor(config, std::move(stats_reader));
+
+  ResourcePressure resource;
+  monitor.updateResourceUsage(resource);
+  EXPECT_FALSE(resource.hasPressure());
+  EXPECT_TRUE(resource.hasError());
+
+  ResourcePressure unreadable;
+  monitor.updateResourceUsage(unreadable);
+  EXPECT_FALSE(unreadable.hasPressure());
+  EXPECT_TRUE(unreadable.hasError());
+}
+
+class CgroupCpuMonitorTest : public testing::Test {
+protected:
+  std::unique_ptr<CgroupCpuMonitor>
+  createMonitor(envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig::Signal signal) {
+    envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig config;
+    config.set_signal(signal);
+    auto stats_reader = std::make_unique<MockCgroupStatsReader>();
+    stats_reader_ = stats_reader.get();
+    return std::make_unique<CgroupCpuMonitor>(config, std::move(stats_reader), time_system_, 4);
+  }
+
+  double update(CgroupCpuMonitor& monitor) {
+    ResourcePressure resource;
+    monitor.updateResourceUsage(resource);
+    EXPECT_TRUE(resource.hasPressure());
+    return resource.pressure();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  MockCgroupStatsReader* stats_reader_{};
+};
+
+TEST_F(CgroupCpuMonitorTest, UtilizationOfQuota) {
+  auto monitor = createMonitor(envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig::
+                                   UTILIZATION);
+  EXPECT_CALL(*stats_reader_, cpuStats())
+      .WillOnce(Return(cpuStats(1000000, 2, 0, 0)))
+      .WillOnce(Return(cpuStats(2000000, 2, 0, 0)))
+      .WillOnce(Return(cpuStats(2500000, absl::nullopt, 0, 0)));
+
+  // There is no interval to compute the utilization over yet.
+  EXPECT_DOUBLE_EQ(0, update(*monitor));
+  // One CPU second in one second, of two CPUs.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_DOUBLE_EQ(0.5, update(*monitor));
+  // Without a quota the cgroup may use the CPUs of the host.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_DOUBLE_EQ(0.125, update(*monitor));
+}
+
+TEST_F(CgroupCpuMonitorTest, ThrottledPeriods) {
+  auto monitor = createMonitor(envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig::
+                                   THROTTLING);
+  EXPECT_CALL(*stats_reader_, cpuStats())
+      .WillOnce(Return(cpuStats(0, 2, 100, 10)))
+      .WillOnce(Return(cpuStats(0, 2, 110, 14)))
+      .WillOnce(Return(cpuStats(0, 2, 110, 14)));
+
+  EXPECT_DOUBLE_EQ(0, update(*monitor));
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_DOUBLE_EQ(0.4, update(*monitor));
+  // No period elapsed.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_DOUBLE_EQ(0, update(*monitor));
+}
+
+TEST_F(CgroupCpuMonitorTest, ReportsReadFailures) {
+  auto monitor = createMonitor(envoy::extensions::resource_monitors::cgroup::v3::CgroupCpuConfig::
+                                   UTILIZATION);
+  EXPECT_CALL(*stats_reader_, cpuStats()).WillOnce([]() -> CgroupStatsReader::CpuStats {
+    throw EnvoyException("unreadable");
+  });
+
+  ResourcePressure resource;
+  monitor->updateResourceUsage(resource);
+  EXPECT_FALSE(resource.hasPressure());
+  EXPECT_TRUE(resource.hasError());
+}
+
+} // namespace
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
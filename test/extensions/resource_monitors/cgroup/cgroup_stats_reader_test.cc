@@ -0,0 +1,127 @@
+#include "source/extensions/resource_monitors/cgroup/cgroup_stats_reader.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace Cgroup {
+namespace {
+
+class CgroupStatsReaderTest : public testing::Test {
+protected:
+  CgroupStatsReaderTest() : api_(Api::createApiForTest()) {}
+
+  void TearDown() override { TestEnvironment::removePath(root_); }
+
+  void writeFile(const std::string& name, const std::string& contents) {
+    const std::string path = absl::StrCat(root_, "/", name);
+    TestEnvironment::createPath(path.substr(0, path.rfind('/')));
+    TestEnvironment::writeStringToFileForTest(path, contents, true);
+  }
+
+  CgroupStatsReader reader() { return {api_->fileSystem(), root_}; }
+
+  void writeV2Files() {
+    writeFile("cgroup.controllers", "cpu memory\n");
+    writeFile("memory.current", "1000\n");
+    writeFile("memory.stat", "anon 600\nfile 400\ninactive_file 300\n");
+    writeFile("memory.max", "2000\n");
+    writeFile("cpu.stat", "usage_usec 5000\nuser_usec 4000\nsystem_usec 1000\n"
+                          "nr_periods 10\nnr_throttled 3\nthrottled_usec 200\n");
+    writeFile("cpu.max", "150000 100000\n");
+  }
+
+  void writeV1Files() {
+    writeFile("memory/memory.usage_in_bytes", "1000\n");
+    writeFile("memory/memory.stat", "inactive_file 100\ntotal_inactive_file 300\n");
+    writeFile("memory/memory.limit_in_bytes", "2000\n");
+    writeFile("cpuacct/cpuacct.usage", "5000000\n");
+    writeFile("cpu/cpu.stat", "nr_periods 10\nnr_throttled 3\nthrottled_time 200000\n");
+    writeFile("cpu/cpu.cfs_quota_us", "50000\n");
+    writeFile("cpu/cpu.cfs_period_us", "100000\n");
+  }
+
+  Api::ApiPtr api_;
+  const std::string root_{TestEnvironment::temporaryPath("cgroup")};
+};
+
+TEST_F(CgroupStatsReaderTest, V2) {
+  writeV2Files();
+  CgroupStatsReader stats_reader = reader();
+  EXPECT_TRUE(stats_reader.isV2());
+
+  const CgroupStatsReader::MemoryStats memory = stats_reader.memoryStats();
+  EXPECT_EQ(1000, memory.usage_bytes_);
+  EXPECT_EQ(300, memory.inactive_file_bytes_);
+  EXPECT_EQ(2000, memory.limit_bytes_);
+
+  const CgroupStatsReader::CpuStats cpu = stats_reader.cpuStats();
+  EXPECT_EQ(std::chrono::microseconds(5000), cpu.usage_);
+  EXPECT_EQ(10, cpu.periods_);
+  EXPECT_EQ(3, cpu.throttled_periods_);
+  EXPECT_DOUBLE_EQ(1.5, *cpu.quota_cpus_);
+}
+
+TEST_F(CgroupStatsReaderTest, V2Unlimited) {
+  writeV2Files();
+  writeFile("memory.max", "max\n");
+  writeFile("cpu.max", "max 100000\n");
+  CgroupStatsReader stats_reader = reader();
+  EXPECT_FALSE(stats_reader.memoryStats().limit_bytes_.has_value());
+  EXPECT_FALSE(stats_reader.cpuStats().quota_cpus_.has_value());
+}
+
+TEST_F(CgroupStatsReaderTest, V1) {
+  writeV1Files();
+  CgroupStatsReader stats_reader = reader();
+  EXPECT_FALSE(stats_reader.isV2());
+
+  const CgroupStatsReader::MemoryStats memory = stats_reader.memoryStats();
+  EXPECT_EQ(1000, memory.usage_bytes_);
+  EXPECT_EQ(300, memory.inactive_file_bytes_);
+  EXPECT_EQ(2000, memory.limit_bytes_);
+
+  const CgroupStatsReader::CpuStats cpu = stats_reader.cpuStats();
+  EXPECT_EQ(std::chrono::microseconds(5000), cpu.usage_);
+  EXPECT_EQ(10, cpu.periods_);
+  EXPECT_EQ(3, cpu.throttled_periods_);
+  EXPECT_DOUBLE_EQ(0.5, *cpu.quota_cpus_);
+}
+
+TEST_F(CgroupStatsReaderTest, V1Unlimited) {
+  writeV1Files();
+  writeFile("memory/memory.limit_in_bytes", "9223372036854771712\n");
+  writeFile("cpu/cpu.cfs_quota_us", "-1\n");
+  CgroupStatsReader stats_reader = reader();
+  EXPECT_FALSE(stats_reader.memoryStats().limit_bytes_.has_value());
+  EXPECT_FALSE(stats_reader.cpuStats().quota_cpus_.has_value());
+}
+
+TEST_F(CgroupStatsReaderTest, MissingOrMalformedFiles) {
+  writeV2Files();
+  writeFile("memory.current", "lots\n");
+  writeFile("cpu.max", "150000\n");
+  CgroupStatsReader stats_reader = reader();
+  EXPECT_THROW_WITH_MESSAGE(stats_reader.memoryStats(), EnvoyException,
+                            "invalid value 'lots\n' in memory.current");
+  EXPECT_THROW_WITH_MESSAGE(stats_reader.cpuStats(), EnvoyException,
+                            "invalid value '150000\n' in cpu.max");
+
+  writeFile("memory.current", "1000\n");
+  writeFile("memory.stat", "anon 600\n");
+  EXPECT_THROW_WITH_MESSAGE(stats_reader.memoryStats(), EnvoyException,
+                            "missing inactive_file in memory.stat");
+
+  TestEnvironment::removePath(absl::StrCat(root_, "/memory.stat"));
+  EXPECT_THROW(stats_reader.memoryStats(), EnvoyException);
+}
+
+} // namespace
+} // namespace Cgroup
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -33,6 +33,7 @@ class MockWriter : public UdpStatsdSink::Writer {
 public:
   MOCK_METHOD(void, write, (const std::string& message));
   MOCK_METHOD(void, writeBuffer, (Buffer::Instance & buffer));
+  MOCK_METHOD(void, flush, ());
 
   void delegateBufferFake() {
     ON_CALL(*this, writeBuffer).WillByDefault([this](Buffer::Instance& buffer) {
@@ -43,6 +44,32 @@ public:
   std::vector<std::string> buffer_writes;
 };
 
+// Interval statistics with fixed buckets, the samples above the largest bound being the difference
+// between the sample count and the samples of the buckets.
+class FixedHistogramStatistics : public Stats::HistogramStatistics {
+public:
+  FixedHistogramStatistics(std::vector<double> bounds, std::vector<uint64_t> buckets,
+                           uint64_t sample_count)
+      : bounds_(std::move(bounds)), buckets_(std::move(buckets)), sample_count_(sample_count) {}
+
+  // Stats::HistogramStatistics
+  std::string quantileSummary() const override { return ""; }
+  std::string bucketSummary() const override { return ""; }
+  const std::vector<double>& supportedQuantiles() const override { return quantiles_; }
+  const std::vector<double>& computedQuantiles() const override { return quantiles_; }
+  Stats::ConstSupportedBuckets& supportedBuckets() const override { return bounds_; }
+  const std::vector<uint64_t>& computedBuckets() const override { return buckets_; }
+  std::vector<uint64_t> computeDisjointBuckets() const override { return buckets_; }
+  uint64_t sampleCount() const override { return sample_count_; }
+  double sampleSum() const override { return 0; }
+
+private:
+  const std::vector<double> quantiles_;
+  const std::vector<double> bounds_;
+  const std::vector<uint64_t> buckets_;
+  const uint64_t sample_count_;
+};
+
 // Skipping this test as Datagram sockets are not currently supported by UDS on Windows
 #ifndef WIN32
 // Regression test for https://github.com/envoyproxy/envoy/issues/8911
@@ -513,6 +540,96 @@ TEST(UdpStatsdSinkWithTagsTest, GraphiteTagSyntax) {
   tls_.shutdownThread();
 }
 
+TEST(UdpStatsdSinkTest, FormattedNamesOfUnflushedMetricsAreForgotten) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  writer_ptr->delegateBufferFake();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, writer_ptr, true, getDefaultPrefix(), 1024);
+
+  NiceMock<Stats::MockCounter> counter;
+  counter.name_ = "test_counter";
+  counter.used_ = true;
+  counter.setTags({Stats::Tag{"key1", "value1"}});
+  snapshot.counters_.push_back({1, counter});
+
+  NiceMock<Stats::MockGauge> gauge;
+  gauge.name_ = "test_gauge";
+  gauge.value_ = 1;
+  gauge.used_ = true;
+  snapshot.gauges_.push_back(gauge);
+
+  EXPECT_CALL(*writer_ptr, flush()).Times(3);
+  sink.flush(snapshot);
+  EXPECT_EQ(2, sink.formattedNamesForTest());
+  snapshot.counters_.front().delta_ = 2;
+  sink.flush(snapshot);
+  EXPECT_EQ(2, sink.formattedNamesForTest());
+  ASSERT_EQ(2, writer_ptr->buffer_writes.size());
+  EXPECT_EQ("envoy.test_counter:1|c|#key1:value1\nenvoy.test_gauge:1|g",
+            writer_ptr->buffer_writes.at(0));
+  EXPECT_EQ("envoy.test_counter:2|c|#key1:value1\nenvoy.test_gauge:1|g",
+            writer_ptr->buffer_writes.at(1));
+
+  counter.used_ = false;
+  sink.flush(snapshot);
+  EXPECT_EQ(1, sink.formattedNamesForTest());
+
+  tls_.shutdownThread();
+}
+
+TEST(UdpStatsdSinkTest, AggregatedHistograms) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  writer_ptr->delegateBufferFake();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, writer_ptr, true, getDefaultPrefix(), 1024, getDefaultTagFormat(),
+                     true);
+  EXPECT_TRUE(sink.getAggregateHistogramsForTest());
+
+  // 1 sample of at most 1ms, 4 of at most 10ms, and 2 above 50ms.
+  FixedHistogramStatistics timer_statistics({1, 5, 10, 50}, {1, 0, 4, 0}, 7);
+  NiceMock<Stats::MockParentHistogram> timer;
+  timer.name_ = "test_timer";
+  timer.used_ = true;
+  timer.setTags({Stats::Tag{"key1", "value1"}});
+  ON_CALL(timer, intervalStatistics()).WillByDefault(testing::ReturnRef(timer_statistics));
+  snapshot.histograms_.push_back(timer);
+
+  // 2 samples of at most 50%.
+  FixedHistogramStatistics percent_statistics({0.5 * Stats::Histogram::PercentScale}, {2}, 2);
+  NiceMock<Stats::MockParentHistogram> percent;
+  percent.name_ = "test_percent";
+  percent.used_ = true;
+  percent.unit_ = Stats::Histogram::Unit::Percent;
+  ON_CALL(percent, intervalStatistics()).WillByDefault(testing::ReturnRef(percent_statistics));
+  snapshot.histograms_.push_back(percent);
+
+  // Histograms without samples in the interval are not emitted.
+  FixedHistogramStatistics empty_statistics({1}, {0}, 0);
+  NiceMock<Stats::MockParentHistogram> empty;
+  empty.name_ = "test_empty";
+  empty.used_ = true;
+  ON_CALL(empty, intervalStatistics()).WillByDefault(testing::ReturnRef(empty_statistics));
+  snapshot.histograms_.push_back(empty);
+
+  sink.flush(snapshot);
+  ASSERT_EQ(1, writer_ptr->buffer_writes.size());
+  EXPECT_EQ("envoy.test_timer:1|ms|#key1:value1\n"
+            "envoy.test_timer:10|ms|@0.25|#key1:value1\n"
+            "envoy.test_timer:50|ms|@0.5|#key1:value1\n"
+            "envoy.test_percent:0.5|h|@0.5",
+            writer_ptr->buffer_writes.at(0));
+
+  // The samples are no longer written as they are recorded.
+  NiceMock<Stats::MockHistogram> sample;
+  sample.name_ = "test_timer";
+  EXPECT_CALL(*writer_ptr, write(_)).Times(0);
+  sink.onHistogramComplete(sample, 5);
+
+  tls_.shutdownThread();
+}
+
 } // namespace
 } // namespace Statsd
 } // namespace Common
@@ -85,6 +85,24 @@ TEST_F(GrpcMetricsStreamerImplTest, StreamFailure) {
   streamer_->send(std::move(metrics));
 }
 
+// Test that the identifier is only sent with the first batch of the stream.
+TEST_F(GrpcMetricsStreamerImplTest, SendBatches) {
+  InSequence s;
+
+  MockMetricsStream stream;
+  MetricsServiceCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+  EXPECT_CALL(local_info_, node());
+  EXPECT_CALL(stream, sendMessageRaw_(_, false)).Times(2);
+
+  envoy::service::metrics::v3::StreamMetricsMessage message;
+  message.add_envoy_metrics()->set_name("test_counter");
+  streamer_->sendBatch(message);
+  EXPECT_FALSE(message.has_identifier());
+  EXPECT_EQ(1, message.envoy_metrics().size());
+  streamer_->sendBatch(message);
+}
+
 class MockGrpcMetricsStreamer
     : public GrpcMetricsStreamer<envoy::service::metrics::v3::StreamMetricsMessage,
                                  envoy::service::metrics::v3::StreamMetricsResponse> {
@@ -95,6 +113,7 @@ public:
 
   // GrpcMetricsStreamer
   MOCK_METHOD(void, send, (MetricsPtr && metrics));
+  MOCK_METHOD(void, sendBatch, (envoy::service::metrics::v3::StreamMetricsMessage & message));
 };
 
 class MetricsServiceSinkTest : public testing::Test {
@@ -316,6 +335,56 @@ TEST_F(MetricsServiceSinkTest, FlushPredicate) {
   EXPECT_EQ(0, metrics->size());
 }
 
+// Test that the metrics are sent in batches of bounded size when configured to do so, the two
+// metric families of a histogram being sent together.
+TEST_F(MetricsServiceSinkTest, MaxMetricFamiliesPerMessage) {
+  MetricsServiceSink<envoy::service::metrics::v3::StreamMetricsMessage,
+                     envoy::service::metrics::v3::StreamMetricsResponse>
+      sink(streamer_, false, false, 2);
+
+  addCounterToSnapshot("test_counter1", 1, 1);
+  addCounterToSnapshot("test_counter2", 1, 1);
+  addGaugeToSnapshot("test_gauge", 1);
+  addGaugeToSnapshot("unused_gauge", 1, false);
+  addHistogramToSnapshot("test_histogram");
+
+  std::vector<std::vector<std::string>> batches;
+  EXPECT_CALL(*streamer_, send(_)).Times(0);
+  EXPECT_CALL(*streamer_, sendBatch(_))
+      .Times(3)
+      .WillRepeatedly(
+          Invoke([&batches](envoy::service::metrics::v3::StreamMetricsMessage& message) {
+            std::vector<std::string> names;
+            for (const auto& metrics_family : message.envoy_metrics()) {
+              names.push_back(metrics_family.name());
+            }
+            batches.push_back(std::move(names));
+          }));
+  sink.flush(snapshot_);
+
+  EXPECT_THAT(batches, testing::ElementsAre(
+                           testing::ElementsAre("test_counter1", "test_counter2"),
+                           testing::ElementsAre("test_gauge"),
+                           testing::ElementsAre("test_histogram", "test_histogram")));
+}
+
+// Test that unchanged metrics can be omitted from the snapshots if configured, even when the
+// counters are reported as their current value.
+TEST_F(MetricsServiceSinkTest, ReportOnlyChangedMetrics) {
+  {
+    MetricsServiceSink<envoy::service::metrics::v3::StreamMetricsMessage,
+                       envoy::service::metrics::v3::StreamMetricsResponse>
+        sink(streamer_, false, false);
+    EXPECT_FALSE(sink.acceptsDeltaSnapshots());
+  }
+  {
+    MetricsServiceSink<envoy::service::metrics::v3::StreamMetricsMessage,
+                       envoy::service::metrics::v3::StreamMetricsResponse>
+        sink(streamer_, false, false, 0, true);
+    EXPECT_TRUE(sink.acceptsDeltaSnapshots());
+  }
+}
+
 } // namespace
 } // namespace MetricsService
 } // namespace StatSinks
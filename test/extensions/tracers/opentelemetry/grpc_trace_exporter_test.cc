@@ -131,6 +131,36 @@ TEST_F(OpenTelemetryGrpcTraceExporterTest, ExportWithNoopCallbacks) {
       std::make_unique<opentelemetry::proto::collector::trace::v1::ExportTraceServiceResponse>());
 }
 
+// Verifies that the exports beyond max_in_flight_exports are dropped until a response is received
+// or the stream is closed.
+TEST_F(OpenTelemetryGrpcTraceExporterTest, MaxInFlightExports) {
+  OpenTelemetryGrpcTraceExporter exporter(Grpc::RawAsyncClientPtr{async_client_}, 1);
+  const std::string request_yaml = R"EOF(
+    resource_spans:
+      scope_spans:
+        - spans:
+          - name: "test"
+  )EOF";
+  opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest request;
+  TestUtility::loadFromYaml(request_yaml, request);
+
+  expectStreamMessage(request_yaml);
+  EXPECT_TRUE(exporter.log(request));
+  EXPECT_CALL(stream_, sendMessageRaw_(_, _)).Times(0);
+  EXPECT_FALSE(exporter.log(request));
+
+  callbacks_->onReceiveMessage(
+      std::make_unique<opentelemetry::proto::collector::trace::v1::ExportTraceServiceResponse>());
+  expectStreamMessage(request_yaml);
+  EXPECT_TRUE(exporter.log(request));
+  EXPECT_FALSE(exporter.log(request));
+
+  callbacks_->onRemoteClose(Grpc::Status::Internal, "bad");
+  expectStreamStart();
+  expectStreamMessage(request_yaml);
+  EXPECT_TRUE(exporter.log(request));
+}
+
 } // namespace OpenTelemetry
 } // namespace Tracers
 } // namespace Extensions
@@ -414,6 +414,53 @@ resource_spans:
   EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_sent").value());
 }
 
+// Verifies that the spans of the exports the exporter can't send are counted as dropped.
+TEST_F(OpenTelemetryDriverTest, DroppedSpans) {
+  setupValidDriver();
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+  Tracing::SpanPtr span =
+      driver_->startSpan(mock_tracing_config_, request_headers, operation_name_,
+                         time_system_.systemTime(), {Tracing::Reason::Sampling, true});
+  EXPECT_NE(span.get(), nullptr);
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .WillOnce(Return(1));
+  EXPECT_CALL(*mock_stream_ptr_, isAboveWriteBufferHighWatermark()).WillOnce(Return(true));
+  EXPECT_CALL(*mock_stream_ptr_, sendMessageRaw_(_, _)).Times(0);
+  span->finishSpan();
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_dropped").value());
+}
+
+// Verifies that the context of untraced requests is propagated without a span, unless the
+// propagated context is sampled.
+TEST_F(OpenTelemetryDriverTest, PropagateUntracedContext) {
+  setupValidDriver();
+  NiceMock<Random::MockRandomGenerator>& mock_random_generator_ =
+      context_.server_factory_context_.api_.random_;
+  ON_CALL(mock_random_generator_, random()).WillByDefault(Return(1));
+
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+  EXPECT_TRUE(driver_->propagateUntracedContext(request_headers));
+  EXPECT_EQ("00-00000000000000010000000000000001-0000000000000001-00",
+            request_headers.get_(OpenTelemetryConstants::get().TRACE_PARENT));
+
+  const std::string unsampled = "00-00000000000000000000000000000001-0000000000000002-00";
+  Http::TestRequestHeaderMapImpl unsampled_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}, {"traceparent", unsampled}};
+  EXPECT_TRUE(driver_->propagateUntracedContext(unsampled_headers));
+  EXPECT_EQ(unsampled, unsampled_headers.get_(OpenTelemetryConstants::get().TRACE_PARENT));
+
+  Http::TestRequestHeaderMapImpl sampled_headers{
+      {":authority", "test.com"},
+      {":path", "/"},
+      {":method", "GET"},
+      {"traceparent", "00-00000000000000000000000000000001-0000000000000002-01"}};
+  EXPECT_FALSE(driver_->propagateUntracedContext(sampled_headers));
+}
+
 TEST_F(OpenTelemetryDriverTest, IgnoreNotSampledSpan) {
   setupValidDriver();
   Http::TestRequestHeaderMapImpl request_headers{
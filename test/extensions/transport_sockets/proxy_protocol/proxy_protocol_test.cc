@@ -511,6 +511,70 @@ TEST_F(ProxyProtocolTest, V2IPV4DownstreamAddressesAndTLVs) {
   proxy_protocol_socket_->doWrite(msg, false);
 }
 
+// Test writes the downstream PROXY protocol header as received, rather than a generated one.
+TEST_F(ProxyProtocolTest, PassThroughOriginalHeader) {
+  auto src_addr =
+      Network::Address::InstanceConstSharedPtr(new Network::Address::Ipv4Instance("1.2.3.4", 773));
+  auto dst_addr =
+      Network::Address::InstanceConstSharedPtr(new Network::Address::Ipv4Instance("0.1.1.2", 513));
+  Buffer::OwnedImpl original_header{};
+  Common::ProxyProtocol::generateV1Header("5.6.7.8", "0.1.1.2", 1000, 513,
+                                          Network::Address::IpVersion::v4, original_header);
+  Network::ProxyProtocolData proxy_proto_data{src_addr, dst_addr, {}, original_header.toString()};
+  Network::TransportSocketOptionsConstSharedPtr socket_options =
+      std::make_shared<Network::TransportSocketOptionsImpl>(
+          "", std::vector<std::string>{}, std::vector<std::string>{}, std::vector<std::string>{},
+          absl::optional<Network::ProxyProtocolData>(proxy_proto_data));
+
+  ProxyProtocolConfig config;
+  config.set_version(ProxyProtocolConfig_Version::ProxyProtocolConfig_Version_V2);
+  config.set_pass_through_original_header(true);
+  initialize(config, socket_options);
+
+  EXPECT_CALL(io_handle_, write(BufferStringEqual(original_header.toString())))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer) -> Api::IoCallUint64Result {
+        auto length = buffer.length();
+        buffer.drain(length);
+        return Api::IoCallUint64Result(length, Api::IoErrorPtr(nullptr, [](Api::IoError*) {}));
+      }));
+  auto msg = Buffer::OwnedImpl("some data");
+  EXPECT_CALL(*inner_socket_, doWrite(BufferEqual(&msg), false));
+
+  proxy_protocol_socket_->doWrite(msg, false);
+}
+
+// Test generates the header as configured when there is no original header to pass through.
+TEST_F(ProxyProtocolTest, PassThroughOriginalHeaderWithoutOne) {
+  auto src_addr =
+      Network::Address::InstanceConstSharedPtr(new Network::Address::Ipv4Instance("1.2.3.4", 773));
+  auto dst_addr =
+      Network::Address::InstanceConstSharedPtr(new Network::Address::Ipv4Instance("0.1.1.2", 513));
+  Network::ProxyProtocolData proxy_proto_data{src_addr, dst_addr};
+  Network::TransportSocketOptionsConstSharedPtr socket_options =
+      std::make_shared<Network::TransportSocketOptionsImpl>(
+          "", std::vector<std::string>{}, std::vector<std::string>{}, std::vector<std::string>{},
+          absl::optional<Network::ProxyProtocolData>(proxy_proto_data));
+  Buffer::OwnedImpl expected_buff{};
+  Common::ProxyProtocol::generateV2Header("1.2.3.4", "0.1.1.2", 773, 513,
+                                          Network::Address::IpVersion::v4, expected_buff);
+
+  ProxyProtocolConfig config;
+  config.set_version(ProxyProtocolConfig_Version::ProxyProtocolConfig_Version_V2);
+  config.set_pass_through_original_header(true);
+  initialize(config, socket_options);
+
+  EXPECT_CALL(io_handle_, write(BufferStringEqual(expected_buff.toString())))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer) -> Api::IoCallUint64Result {
+        auto length = buffer.length();
+        buffer.drain(length);
+        return Api::IoCallUint64Result(length, Api::IoErrorPtr(nullptr, [](Api::IoError*) {}));
+      }));
+  auto msg = Buffer::OwnedImpl("some data");
+  EXPECT_CALL(*inner_socket_, doWrite(BufferEqual(&msg), false));
+
+  proxy_protocol_socket_->doWrite(msg, false);
+}
+
 // Test injects V2 PROXY protocol for downstream IPV4 addresses and TLVs with passing specific TLV.
 TEST_F(ProxyProtocolTest, V2IPV4PassSpecificTLVs) {
   auto src_addr =
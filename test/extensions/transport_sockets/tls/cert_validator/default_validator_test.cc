@@ -7,6 +7,7 @@
 #include "test/extensions/transport_sockets/tls/cert_validator/test_common.h"
 #include "test/extensions/transport_sockets/tls/ssl_test_utility.h"
 #include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
@@ -289,6 +290,119 @@ TEST(DefaultCertValidatorTest, WithVerifyDepth) {
   EXPECT_EQ(X509_STORE_CTX_get_error(store_ctx.get()), X509_V_OK);
 }
 
+struct AsyncValidationResult {
+  absl::optional<bool> succeeded_;
+  Ssl::ClientValidationStatus detailed_status_{Ssl::ClientValidationStatus::NotValidated};
+};
+
+class TestValidateResultCallback : public Ssl::ValidateResultCallback {
+public:
+  TestValidateResultCallback(Event::Dispatcher& dispatcher, AsyncValidationResult& result)
+      : dispatcher_(dispatcher), result_(result) {}
+
+  Event::Dispatcher& dispatcher() override { return dispatcher_; }
+  void onCertValidationResult(bool succeeded, Ssl::ClientValidationStatus detailed_status,
+                              const std::string&, uint8_t) override {
+    EXPECT_TRUE(dispatcher_.isThreadSafe());
+    result_.succeeded_ = succeeded;
+    result_.detailed_status_ = detailed_status;
+    dispatcher_.exit();
+  }
+
+private:
+  Event::Dispatcher& dispatcher_;
+  AsyncValidationResult& result_;
+};
+
+// Verifies that the chains are validated on the validation threads, and that the chains validated
+// successfully are accepted without validating them again.
+TEST(DefaultCertValidatorTest, AsyncValidation) {
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+  auto test_data = [](absl::string_view name) {
+    return TestEnvironment::substitute(
+        absl::StrCat("{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/", name));
+  };
+
+  auto test_config = std::make_unique<TestCertificateValidationContextConfig>(
+      typed_conf, false,
+      std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>{},
+      TestEnvironment::readFileToStringForTest(test_data("ca_cert.pem")));
+  envoy::extensions::transport_sockets::tls::v3::AsyncValidation async_validation;
+  async_validation.mutable_threads()->set_value(2);
+  test_config->setAsyncValidation(async_validation);
+  auto default_validator = std::make_unique<DefaultCertValidator>(
+      test_config.get(), stats, Event::GlobalTimeSystem().timeSystem());
+  SSLContextPtr ssl_ctx = SSL_CTX_new(TLS_method());
+  default_validator->initializeSslContexts({ssl_ctx.get()}, false);
+
+  bssl::UniquePtr<STACK_OF(X509)> cert_chain =
+      readCertChainFromFile(test_data("test_long_cert_chain.pem"));
+  ASSERT_TRUE(sk_X509_insert(cert_chain.get(),
+                             readCertFromFile(test_data("test_random_cert.pem")).release(), 0));
+  bssl::UniquePtr<STACK_OF(X509)> untrusted_chain(sk_X509_new_null());
+  ASSERT_TRUE(bssl::PushToStack(untrusted_chain.get(),
+                                readCertFromFile(test_data("selfsigned_cert.pem"))));
+
+  auto validate = [&](STACK_OF(X509)& chain, AsyncValidationResult& result) {
+    return default_validator->doVerifyCertChain(
+        chain, std::make_unique<TestValidateResultCallback>(*dispatcher, result),
+        /*transport_socket_options=*/nullptr, *ssl_ctx, {}, false, "");
+  };
+
+  AsyncValidationResult result;
+  EXPECT_EQ(ValidationResults::ValidationStatus::Pending, validate(*cert_chain, result).status);
+  dispatcher->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(true, result.succeeded_);
+  EXPECT_EQ(Ssl::ClientValidationStatus::Validated, result.detailed_status_);
+
+  AsyncValidationResult cached_result;
+  ValidationResults results = validate(*cert_chain, cached_result);
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+  EXPECT_EQ(Ssl::ClientValidationStatus::Validated, results.detailed_status);
+  EXPECT_FALSE(cached_result.succeeded_.has_value());
+  EXPECT_EQ(1, stats.async_cert_validation_cache_hit_.value());
+
+  // Failures aren't cached.
+  for (int i = 0; i < 2; i++) {
+    AsyncValidationResult untrusted_result;
+    EXPECT_EQ(ValidationResults::ValidationStatus::Pending,
+              validate(*untrusted_chain, untrusted_result).status);
+    dispatcher->run(Event::Dispatcher::RunType::Block);
+    EXPECT_EQ(false, untrusted_result.succeeded_);
+    EXPECT_EQ(Ssl::ClientValidationStatus::Failed, untrusted_result.detailed_status_);
+  }
+  EXPECT_EQ(3, stats.async_cert_validation_.value());
+  EXPECT_EQ(2, stats.fail_verify_error_.value());
+
+  // Without a callback, the chains are validated synchronously.
+  EXPECT_EQ(ValidationResults::ValidationStatus::Failed,
+            default_validator
+                ->doVerifyCertChain(*untrusted_chain, /*callback=*/nullptr,
+                                    /*transport_socket_options=*/nullptr, *ssl_ctx, {}, false, "")
+                .status);
+  EXPECT_EQ(3, stats.async_cert_validation_.value());
+}
+
+// Verifies that the cached chains are forgotten after the TTL, and that chains aren't cached
+// beyond the maximum unless others expired.
+TEST(ValidatedChainCacheTest, TtlAndMaxChains) {
+  Event::SimulatedTimeSystem time_system;
+  ValidatedChainCache cache(1, std::chrono::seconds(10), time_system);
+  cache.insert("a", Ssl::ClientValidationStatus::Validated);
+  cache.insert("b", Ssl::ClientValidationStatus::NotValidated);
+  EXPECT_EQ(Ssl::ClientValidationStatus::Validated, cache.lookup("a"));
+  EXPECT_EQ(absl::nullopt, cache.lookup("b"));
+
+  time_system.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(absl::nullopt, cache.lookup("a"));
+  cache.insert("b", Ssl::ClientValidationStatus::NotValidated);
+  EXPECT_EQ(Ssl::ClientValidationStatus::NotValidated, cache.lookup("b"));
+}
+
 class MockCertificateValidationContextConfig : public Ssl::CertificateValidationContextConfig {
 public:
   MockCertificateValidationContextConfig() {
@@ -317,11 +431,17 @@ public:
   MOCK_METHOD(Api::Api&, api, (), (const override));
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>&
+  asyncValidation() const override {
+    return async_validation_;
+  }
 
 private:
   std::string s_;
   std::vector<std::string> strs_;
   std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher> matchers_;
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>
+      async_validation_;
 };
 
 TEST(DefaultCertValidatorTest, TestUnexpectedSanMatcherType) {
@@ -89,6 +89,15 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
 
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>&
+  asyncValidation() const override {
+    return async_validation_;
+  }
+
+  void setAsyncValidation(envoy::extensions::transport_sockets::tls::v3::AsyncValidation config) {
+    async_validation_ = std::move(config);
+  }
+
 private:
   bool allow_expired_certificate_{false};
   Api::ApiPtr api_;
@@ -98,6 +107,7 @@ private:
   const std::string ca_cert_;
   const std::string ca_cert_path_{"TEST_CA_CERT_PATH"};
   const absl::optional<uint32_t> max_verify_depth_{absl::nullopt};
+  absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation> async_validation_;
 };
 
 } // namespace Tls
@@ -0,0 +1,39 @@
+#include "source/extensions/transport_sockets/tls/private_key/handshake_offload.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+// Verifies that the operations beyond the maximum number of pending operations are rejected, and
+// that the pending operations are run before the pool is destroyed.
+TEST(HandshakeThreadPoolTest, BoundedQueue) {
+  absl::Notification started;
+  absl::Notification release;
+  bool queued_ran = false;
+  {
+    HandshakeThreadPool pool(Thread::threadFactoryForTest(), 1, 1);
+    EXPECT_TRUE(pool.tryPost([&]() {
+      started.Notify();
+      release.WaitForNotification();
+    }));
+    started.WaitForNotification();
+
+    EXPECT_TRUE(pool.tryPost([&]() { queued_ran = true; }));
+    EXPECT_FALSE(pool.tryPost([]() {}));
+    release.Notify();
+  }
+  EXPECT_TRUE(queued_ran);
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
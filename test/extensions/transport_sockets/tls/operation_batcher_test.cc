@@ -0,0 +1,93 @@
+#include <chrono>
+#include <vector>
+
+#include "source/extensions/transport_sockets/tls/private_key/operation_batcher.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class OperationBatcherTest : public testing::Test {
+protected:
+  OperationBatcherTest()
+      : api_(Api::createApiForTest(time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")),
+        batcher_(*dispatcher_, 4, std::chrono::milliseconds(100),
+                 [this](std::vector<int>& batch) { batches_.push_back(batch); }) {}
+
+  void advance(std::chrono::milliseconds duration) {
+    time_system_.advanceTimeAndRun(duration, *dispatcher_, Event::Dispatcher::RunType::NonBlock);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  std::vector<std::vector<int>> batches_;
+  OperationBatcher<int> batcher_;
+};
+
+// Verifies that a full batch is flushed at once.
+TEST_F(OperationBatcherTest, FlushesFullBatchAtOnce) {
+  batcher_.add(1);
+  batcher_.add(2);
+  batcher_.add(3);
+  EXPECT_TRUE(batches_.empty());
+  batcher_.add(4);
+  ASSERT_EQ(1U, batches_.size());
+  EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), batches_[0]);
+  EXPECT_EQ(0U, batcher_.size());
+
+  // The timer armed for the batch was disabled.
+  advance(std::chrono::milliseconds(100));
+  EXPECT_EQ(1U, batches_.size());
+}
+
+// Verifies that a partial batch is flushed at the time it is expected to take to fill.
+TEST_F(OperationBatcherTest, AdaptiveDeadline) {
+  for (int i = 1; i <= 4; i++) {
+    batcher_.add(i);
+    advance(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(1U, batches_.size());
+
+  // Three more operations are expected within 30ms.
+  batcher_.add(5);
+  EXPECT_EQ(std::chrono::milliseconds(30), batcher_.deadline());
+  advance(std::chrono::milliseconds(29));
+  EXPECT_EQ(1U, batches_.size());
+  advance(std::chrono::milliseconds(1));
+  ASSERT_EQ(2U, batches_.size());
+  EXPECT_EQ((std::vector<int>{5}), batches_[1]);
+}
+
+// Verifies that sparse operations are flushed at once when no other operation is expected within
+// the maximum delay.
+TEST_F(OperationBatcherTest, SparseOperationsAreNotDelayed) {
+  // The first operation waits for the maximum delay, since the arrival rate isn't known yet.
+  batcher_.add(1);
+  EXPECT_EQ(std::chrono::milliseconds(100), batcher_.deadline());
+  advance(std::chrono::milliseconds(99));
+  EXPECT_TRUE(batches_.empty());
+  advance(std::chrono::milliseconds(901));
+  ASSERT_EQ(1U, batches_.size());
+
+  batcher_.add(2);
+  EXPECT_EQ(std::chrono::microseconds::zero(), batcher_.deadline());
+  EXPECT_EQ(1U, batches_.size());
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  ASSERT_EQ(2U, batches_.size());
+  EXPECT_EQ((std::vector<int>{2}), batches_[1]);
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#include <string>
+
+#include "source/extensions/transport_sockets/tls/session_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+int valueOf(ShardedSessionCache<int>& cache, const std::string& key) {
+  int value = -1;
+  cache.read(key, [&value](const int& cached) { value = cached; });
+  return value;
+}
+
+// Verifies that values are inserted by updates only, and that erased values are gone.
+TEST(ShardedSessionCacheTest, ReadModifyUpdateErase) {
+  ShardedSessionCache<int> cache(100);
+  EXPECT_FALSE(cache.read("a", [](const int&) { FAIL(); }));
+  EXPECT_FALSE(cache.modify("a", [](int&) { FAIL(); }));
+
+  cache.update("a", [](int& value) { value += 1; });
+  cache.update("a", [](int& value) { value += 1; });
+  EXPECT_EQ(2, valueOf(cache, "a"));
+  EXPECT_TRUE(cache.modify("a", [](int& value) { value = 5; }));
+  EXPECT_EQ(5, valueOf(cache, "a"));
+
+  cache.erase("a");
+  cache.erase("b");
+  EXPECT_EQ(-1, valueOf(cache, "a"));
+}
+
+// Verifies that each shard evicts the entries updated the least recently beyond its share of the
+// maximum number of entries.
+TEST(ShardedSessionCacheTest, EvictsLeastRecentlyUpdated) {
+  // A single entry per shard.
+  ShardedSessionCache<int> cache(1);
+  for (int i = 0; i < 1000; i++) {
+    cache.update(std::to_string(i), [i](int& value) { value = i; });
+  }
+  size_t entries = 0;
+  for (int i = 0; i < 1000; i++) {
+    entries += valueOf(cache, std::to_string(i)) == i;
+  }
+  EXPECT_LE(entries, 16U);
+  EXPECT_EQ(999, valueOf(cache, "999"));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
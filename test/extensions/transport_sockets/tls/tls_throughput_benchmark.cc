@@ -113,6 +113,7 @@ static void testThroughput(benchmark::State& state) {
   unsigned num_short_slices = state.range(1);
   unsigned align_to_16kb = state.range(2);
   unsigned move_slices = state.range(3);
+  unsigned gather_slices = state.range(4);
 
   uint64_t bytes_written = 0;
   for (auto _ : state) {
@@ -149,13 +150,26 @@ static void testThroughput(benchmark::State& state) {
     state.ResumeTiming();
     uint32_t num_writes = 0;
     uint32_t num_times_linearize_did_something = 0;
+    uint32_t num_gathered = 0;
     while (write_buf.length() > 0) {
       const Buffer::RawSlice initial = write_buf.frontSlice();
-      void* mem;
+      const void* mem;
       size_t len = std::min<uint64_t>(write_buf.length(), 16384);
-      mem = write_buf.linearize(len);
-      if (write_buf.frontSlice() != initial) {
-        ++num_times_linearize_did_something;
+      if (gather_slices) {
+        // Mirrors SslSocket with envoy.reloadable_features.tls_gather_write_slices enabled.
+        static uint8_t scratch[16384];
+        if (initial.len_ >= len) {
+          mem = initial.mem_;
+        } else {
+          write_buf.copyOut(0, len, scratch);
+          mem = scratch;
+          ++num_gathered;
+        }
+      } else {
+        mem = write_buf.linearize(len);
+        if (write_buf.frontSlice() != initial) {
+          ++num_times_linearize_did_something;
+        }
       }
 
       err = SSL_write(client_ssl.get(), mem, len);
@@ -167,6 +181,7 @@ static void testThroughput(benchmark::State& state) {
 
     state.counters["writes_per_iteration"] = num_writes;
     state.counters["num_linearized"] = num_times_linearize_did_something;
+    state.counters["num_gathered"] = num_gathered;
   }
   state.counters["throughput"] = benchmark::Counter(bytes_written, benchmark::Counter::kIsRate);
 
@@ -175,15 +190,24 @@ static void testThroughput(benchmark::State& state) {
 }
 
 static void testParams(benchmark::internal::Benchmark* b) {
-  for (auto move_slices : {false, true}) {
-    for (auto align_to_16kb : {false, true}) {
-      // Add a single case of no short slices; don't iterate over the sizes
-      // which duplicates test cases when count is zero.
-      b->Args({0, 0, align_to_16kb, move_slices});
-
-      for (auto short_slice_size : {1, 128, 4095, 4096, 4097}) {
-        for (auto num_short_slices : {1, 2, 3}) {
-          b->Args({short_slice_size, num_short_slices, align_to_16kb, move_slices});
+  for (auto gather_slices : {false, true}) {
+    for (auto move_slices : {false, true}) {
+      for (auto align_to_16kb : {false, true}) {
+        // Add a single case of no short slices; don't iterate over the sizes
+        // which duplicates test cases when count is zero.
+        b->Args({0, 0, align_to_16kb, move_slices, gather_slices});
+
+        for (auto short_slice_size : {1, 128, 4095, 4096, 4097}) {
+          for (auto num_short_slices : {1, 2, 3}) {
+            b->Args(
+                {short_slice_size, num_short_slices, align_to_16kb, move_slices, gather_slices});
+          }
+        }
+
+        // Many small slices, as produced by HTTP/2 frames or small response bodies, which is where
+        // packing slices into full records matters the most.
+        for (auto num_short_slices : {16, 64}) {
+          b->Args({100, num_short_slices, align_to_16kb, move_slices, gather_slices});
         }
       }
     }
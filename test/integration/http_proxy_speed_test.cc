@@ -0,0 +1,178 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// Measures the whole request path of an in-process Envoy: downstream codec, HTTP connection
+// manager, router, connection pool and upstream codec. The upstream of the router is an internal
+// listener of the same Envoy answering with a direct response, so the upstream connections are
+// user space socket pairs and no fake upstream thread takes part in the measurements.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+#include "envoy/config/listener/v3/listener.pb.h"
+
+#include "source/common/memory/stats.h"
+
+#include "test/benchmark/main.h"
+#include "test/integration/http_integration.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+#include "fmt/format.h"
+
+namespace Envoy {
+namespace {
+
+constexpr uint64_t ResponseBodySize = 1024;
+
+class ProxyThroughputTest : public HttpIntegrationTest {
+public:
+  ProxyThroughputTest(Http::CodecType downstream_protocol, Http::CodecType upstream_protocol)
+      : HttpIntegrationTest(
+            downstream_protocol, TestEnvironment::getIpVersionsForTest().front(),
+            ConfigHelper::httpProxyConfig(downstream_protocol == Http::CodecType::HTTP3)) {
+    setUpstreamCount(0);
+    setUpstreamProtocol(upstream_protocol);
+  }
+
+  void initialize() override {
+    config_helper_.addBootstrapExtension(R"EOF(
+name: envoy.bootstrap.internal_listener
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.bootstrap.internal_listener.v3.InternalListener
+)EOF");
+    config_helper_.addConfigModifier([](envoy::config::bootstrap::v3::Bootstrap& bootstrap) {
+      auto* static_resources = bootstrap.mutable_static_resources();
+      auto* load_assignment = static_resources->mutable_clusters(0)->mutable_load_assignment();
+      load_assignment->clear_endpoints();
+      load_assignment->add_endpoints()
+          ->add_lb_endpoints()
+          ->mutable_endpoint()
+          ->mutable_address()
+          ->mutable_envoy_internal_address()
+          ->set_server_listener_name("backend");
+      TestUtility::loadFromYaml(backendListener(), *static_resources->add_listeners());
+    });
+    HttpIntegrationTest::initialize();
+    codec_client_ = makeHttpConnection(lookupPort("http"));
+  }
+
+  // Sends concurrent_requests requests at once, with a response body if with_body is set, and
+  // waits for all of them to complete, appending their latencies to latencies_us.
+  void sendRequests(uint32_t concurrent_requests, bool with_body,
+                    std::vector<double>& latencies_us) {
+    Http::TestRequestHeaderMapImpl headers{default_request_headers_};
+    headers.setPath(with_body ? "/body" : "/");
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<IntegrationStreamDecoderPtr> responses;
+    responses.reserve(concurrent_requests);
+    for (uint32_t i = 0; i < concurrent_requests; i++) {
+      responses.push_back(codec_client_->makeHeaderOnlyRequest(headers));
+    }
+    for (const auto& response : responses) {
+      RELEASE_ASSERT(response->waitForEndStream(), "request timed out");
+      RELEASE_ASSERT(response->headers().getStatusValue() == "200", "unexpected response status");
+      latencies_us.push_back(std::chrono::duration<double, std::micro>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count());
+    }
+  }
+
+private:
+  static std::string backendListener() {
+    return fmt::format(R"EOF(
+name: backend
+internal_listener: {{}}
+filter_chains:
+- filters:
+  - name: envoy.filters.network.http_connection_manager
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.filters.network.http_connection_manager.v3.HttpConnectionManager
+      stat_prefix: backend
+      codec_type: AUTO
+      http_filters:
+      - name: envoy.filters.http.router
+        typed_config:
+          "@type": type.googleapis.com/envoy.extensions.filters.http.router.v3.Router
+      route_config:
+        virtual_hosts:
+        - name: backend
+          domains: ["*"]
+          routes:
+          - match: {{ prefix: "/body" }}
+            direct_response: {{ status: 200, body: {{ inline_string: "{}" }} }}
+          - match: {{ prefix: "/" }}
+            direct_response: {{ status: 200 }}
+)EOF",
+                       std::string(ResponseBodySize, 'a'));
+  }
+};
+
+// Args: downstream codec, upstream codec, concurrent requests, whether the responses have a body.
+void bmProxyRequests(::benchmark::State& state) {
+  const auto downstream_protocol = static_cast<Http::CodecType>(state.range(0));
+  const auto upstream_protocol = static_cast<Http::CodecType>(state.range(1));
+  const uint32_t concurrent_requests = state.range(2);
+  const bool with_body = state.range(3) != 0;
+  if (downstream_protocol == Http::CodecType::HTTP1 && concurrent_requests > 1) {
+    state.SkipWithError("HTTP/1 connections have a single request in flight");
+    return;
+  }
+  if (benchmark::skipExpensiveBenchmarks() && concurrent_requests > 1) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  // The integration test framework reads the Envoy options of tests, which benchmarks don't have.
+  static char envoy[] = "envoy";
+  static char* argv[] = {envoy, nullptr};
+  TestEnvironment::initializeOptions(1, argv);
+
+  ProxyThroughputTest test(downstream_protocol, upstream_protocol);
+  test.initialize();
+
+  // Warm up the connections and the allocator caches outside of the measurements.
+  std::vector<double> latencies_us;
+  test.sendRequests(concurrent_requests, with_body, latencies_us);
+  latencies_us.clear();
+
+  const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    test.sendRequests(concurrent_requests, with_body, latencies_us);
+  }
+  const size_t end_mem = Memory::Stats::totalCurrentlyAllocated();
+
+  const uint64_t requests = latencies_us.size();
+  std::sort(latencies_us.begin(), latencies_us.end());
+  state.counters["requests_per_second"] =
+      ::benchmark::Counter(requests, ::benchmark::Counter::kIsRate);
+  state.counters["p99_latency_us"] = latencies_us[std::min(requests - 1, requests * 99 / 100)];
+  // The heap growth over the run, which is non-zero if requests leave memory behind.
+  state.counters["retained_memory_per_request"] =
+      end_mem > start_mem ? static_cast<double>(end_mem - start_mem) / requests : 0;
+}
+
+constexpr int64_t Http1 = static_cast<int64_t>(Http::CodecType::HTTP1);
+constexpr int64_t Http2 = static_cast<int64_t>(Http::CodecType::HTTP2);
+#ifdef ENVOY_ENABLE_QUIC
+constexpr int64_t Http3 = static_cast<int64_t>(Http::CodecType::HTTP3);
+#endif
+
+BENCHMARK(bmProxyRequests)
+    ->ArgsProduct({{Http1, Http2}, {Http1, Http2}, {1, 16}, {0, 1}})
+    ->Unit(::benchmark::kMicrosecond)
+    ->UseRealTime();
+#ifdef ENVOY_ENABLE_QUIC
+BENCHMARK(bmProxyRequests)
+    ->ArgsProduct({{Http3}, {Http1, Http2}, {1, 16}, {0, 1}})
+    ->Unit(::benchmark::kMicrosecond)
+    ->UseRealTime();
+#endif
+
+} // namespace
+} // namespace Envoy
@@ -26,4 +26,7 @@ template <> MockBufferBase<Buffer::OwnedImpl>::MockBufferBase() {}
 MockBufferFactory::MockBufferFactory() = default;
 MockBufferFactory::~MockBufferFactory() = default;
 
+MockConnectionCloseHandler::MockConnectionCloseHandler() = default;
+MockConnectionCloseHandler::~MockConnectionCloseHandler() = default;
+
 } // namespace Envoy
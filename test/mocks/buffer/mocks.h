@@ -89,7 +89,18 @@ public:
                std::function<void()> above_overflow));
 
   MOCK_METHOD(Buffer::BufferMemoryAccountSharedPtr, createAccount, (Http::StreamResetHandler&));
+  MOCK_METHOD(Buffer::BufferMemoryAccountSharedPtr, createConnectionAccount,
+              (Buffer::ConnectionCloseHandler&));
   MOCK_METHOD(uint64_t, resetAccountsGivenPressure, (float));
+  MOCK_METHOD(uint64_t, closeConnectionsGivenPressure, (float));
+};
+
+class MockConnectionCloseHandler : public Buffer::ConnectionCloseHandler {
+public:
+  MockConnectionCloseHandler();
+  ~MockConnectionCloseHandler() override;
+
+  MOCK_METHOD(void, closeConnection, ());
 };
 
 MATCHER_P(BufferEqual, rhs, testing::PrintToString(*rhs)) {
@@ -17,6 +17,9 @@ public:
   // Decompressor::Decompressor
   MOCK_METHOD(void, decompress,
               (const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer));
+  MOCK_METHOD(bool, decompressBounded,
+              (Buffer::Instance& input_buffer, Buffer::Instance& output_buffer,
+               uint64_t output_limit));
 };
 
 class MockDecompressorFactory : public DecompressorFactory {
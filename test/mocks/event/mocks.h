@@ -72,7 +72,8 @@ public:
 
   Network::ListenerPtr createListener(Network::SocketSharedPtr&& socket,
                                       Network::TcpListenerCallbacks& cb, Runtime::Loader& runtime,
-                                      bool bind_to_port, bool ignore_global_conn_limit) override {
+                                      bool bind_to_port, bool ignore_global_conn_limit,
+                                      uint32_t) override {
     return Network::ListenerPtr{
         createListener_(std::move(socket), cb, runtime, bind_to_port, ignore_global_conn_limit)};
   }
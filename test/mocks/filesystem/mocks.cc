@@ -33,6 +33,19 @@ Api::IoCallSizeResult MockFile::write(absl::string_view buffer) {
   return result;
 }
 
+Api::IoCallSizeResult MockFile::writev(absl::Span<const absl::string_view> buffers) {
+  ssize_t written = 0;
+  for (const absl::string_view buffer : buffers) {
+    Api::IoCallSizeResult result = write(buffer);
+    if (!result.ok()) {
+      return result;
+    }
+    written += result.return_value_;
+  }
+  return {written,
+          Api::IoErrorPtr(nullptr, [](Api::IoError*) { PANIC("reached unexpected code"); })};
+}
+
 Api::IoCallSizeResult MockFile::pread(void* buf, uint64_t count, uint64_t offset) {
   Thread::LockGuard lock(pread_mutex_);
   if (!is_open_) {
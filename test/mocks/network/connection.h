@@ -62,6 +62,8 @@ public:
   MOCK_METHOD(uint64_t, id, (), (const));                                                          \
   MOCK_METHOD(void, hashKey, (std::vector<uint8_t>&), (const));                                    \
   MOCK_METHOD(bool, initializeReadFilters, ());                                                    \
+  MOCK_METHOD(uint32_t, numReadFilters, (), (const));                                              \
+  MOCK_METHOD(uint32_t, numWriteFilters, (), (const));                                             \
   MOCK_METHOD(std::string, nextProtocol, (), (const));                                             \
   MOCK_METHOD(void, noDelay, (bool enable));                                                       \
   MOCK_METHOD(void, readDisable, (bool disable));                                                  \
@@ -74,6 +76,7 @@ public:
               unixSocketPeerCredentials, (), (const));                                             \
   MOCK_METHOD(void, setConnectionStats, (const ConnectionStats& stats));                           \
   MOCK_METHOD(Ssl::ConnectionInfoConstSharedPtr, ssl, (), (const));                                \
+  MOCK_METHOD(bool, forwardsPayloadUnchanged, (), (const));                                        \
   MOCK_METHOD(absl::string_view, requestedServerName, (), (const));                                \
   MOCK_METHOD(absl::string_view, ja3Hash, (), (const));                                            \
   MOCK_METHOD(State, state, (), (const));                                                          \
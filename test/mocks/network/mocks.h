@@ -52,6 +52,8 @@ public:
   MOCK_METHOD(void, addReadFilter, (ReadFilterSharedPtr filter));
   MOCK_METHOD(void, removeReadFilter, (ReadFilterSharedPtr filter));
   MOCK_METHOD(bool, initializeReadFilters, ());
+  MOCK_METHOD(uint32_t, numReadFilters, (), (const));
+  MOCK_METHOD(uint32_t, numWriteFilters, (), (const));
 };
 
 class MockDnsResolver : public DnsResolver {
@@ -170,6 +172,7 @@ public:
 
   MOCK_METHOD(void, onAccept_, (ConnectionSocketPtr & socket));
   MOCK_METHOD(void, onReject, (RejectCause), (override));
+  MOCK_METHOD(bool, listenerConnectionLimitReached, (), (const, override));
 };
 
 class MockUdpListenerCallbacks : public UdpListenerCallbacks {
@@ -447,6 +450,7 @@ public:
   MOCK_METHOD(uint32_t, tcpBacklogSize, (), (const));
   MOCK_METHOD(Init::Manager&, initManager, ());
   MOCK_METHOD(bool, ignoreGlobalConnLimit, (), (const));
+  MOCK_METHOD(uint32_t, maxConnectionsToAcceptPerSocketEvent, (), (const));
 
   envoy::config::core::v3::TrafficDirection direction() const override {
     return envoy::config::core::v3::UNSPECIFIED;
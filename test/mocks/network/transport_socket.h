@@ -29,6 +29,7 @@ public:
   MOCK_METHOD(IoResult, doWrite, (Buffer::Instance & buffer, bool end_stream));
   MOCK_METHOD(void, onConnected, ());
   MOCK_METHOD(Ssl::ConnectionInfoConstSharedPtr, ssl, (), (const));
+  MOCK_METHOD(bool, forwardsPayloadUnchanged, (), (const));
   MOCK_METHOD(bool, startSecureTransport, ());
   MOCK_METHOD(void, configureInitialCongestionWindow,
               (uint64_t bandwidth_bits_per_sec, std::chrono::microseconds rtt));
@@ -97,10 +97,12 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  HedgeLatencyTracker* latencyTracker() const override { return latency_tracker_; }
 
   uint32_t initial_requests_{};
   envoy::type::v3::FractionalPercent additional_request_chance_{};
   bool hedge_on_per_try_timeout_{};
+  HedgeLatencyTracker* latency_tracker_{};
 };
 
 class TestRetryPolicy : public RetryPolicy {
@@ -54,6 +54,11 @@ public:
   MOCK_METHOD(double, getDouble, (absl::string_view key, double default_value), (const));
   MOCK_METHOD(bool, getBoolean, (absl::string_view key, bool default_value), (const));
   MOCK_METHOD(const std::vector<OverrideLayerConstPtr>&, getLayers, (), (const));
+
+  // The registered key variants read the keys by name, through the above.
+  using Snapshot::featureEnabled;
+  using Snapshot::getBoolean;
+  using Snapshot::getInteger;
 };
 
 class MockLoader : public Loader {
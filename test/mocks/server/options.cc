@@ -35,12 +35,14 @@ MockOptions::MockOptions(const std::string& config_path) : config_path_(config_p
   ON_CALL(*this, serviceZone()).WillByDefault(ReturnRef(service_zone_name_));
   ON_CALL(*this, logLevel()).WillByDefault(Return(log_level_));
   ON_CALL(*this, logPath()).WillByDefault(ReturnRef(log_path_));
+  ON_CALL(*this, logAsyncBufferSize()).WillByDefault(ReturnPointee(&log_async_buffer_size_));
   ON_CALL(*this, restartEpoch()).WillByDefault(ReturnPointee(&hot_restart_epoch_));
   ON_CALL(*this, hotRestartDisabled()).WillByDefault(ReturnPointee(&hot_restart_disabled_));
   ON_CALL(*this, signalHandlingEnabled()).WillByDefault(ReturnPointee(&signal_handling_enabled_));
   ON_CALL(*this, mutexTracingEnabled()).WillByDefault(ReturnPointee(&mutex_tracing_enabled_));
   ON_CALL(*this, coreDumpEnabled()).WillByDefault(ReturnPointee(&core_dump_enabled_));
   ON_CALL(*this, cpusetThreadsEnabled()).WillByDefault(ReturnPointee(&cpuset_threads_enabled_));
+  ON_CALL(*this, workerCpus()).WillByDefault(ReturnRef(worker_cpus_));
   ON_CALL(*this, disabledExtensions()).WillByDefault(ReturnRef(disabled_extensions_));
   ON_CALL(*this, toCommandLineOptions()).WillByDefault(Invoke([] {
     return std::make_unique<envoy::admin::v3::CommandLineOptions>();
@@ -48,6 +50,9 @@ MockOptions::MockOptions(const std::string& config_path) : config_path_(config_p
   ON_CALL(*this, socketPath()).WillByDefault(ReturnRef(socket_path_));
   ON_CALL(*this, socketMode()).WillByDefault(ReturnPointee(&socket_mode_));
   ON_CALL(*this, statsTags()).WillByDefault(ReturnRef(stats_tags_));
+  ON_CALL(*this, statsSharedMemoryPath()).WillByDefault(ReturnRef(stats_shared_memory_path_));
+  ON_CALL(*this, statsSharedMemoryMaxStats())
+      .WillByDefault(ReturnPointee(&stats_shared_memory_max_stats_));
   ON_CALL(*this, listenerManager())
       .WillByDefault(ReturnRef(Config::ServerExtensionValues::get().DEFAULT_LISTENER));
 }
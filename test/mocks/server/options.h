@@ -37,6 +37,7 @@ public:
   MOCK_METHOD(bool, logFormatEscaped, (), (const));
   MOCK_METHOD(bool, enableFineGrainLogging, (), (const));
   MOCK_METHOD(const std::string&, logPath, (), (const));
+  MOCK_METHOD(uint64_t, logAsyncBufferSize, (), (const));
   MOCK_METHOD(uint64_t, restartEpoch, (), (const));
   MOCK_METHOD(std::chrono::milliseconds, fileFlushIntervalMsec, (), (const));
   MOCK_METHOD(Mode, mode, (), (const));
@@ -48,11 +49,14 @@ public:
   MOCK_METHOD(bool, mutexTracingEnabled, (), (const));
   MOCK_METHOD(bool, coreDumpEnabled, (), (const));
   MOCK_METHOD(bool, cpusetThreadsEnabled, (), (const));
+  MOCK_METHOD(const std::vector<uint32_t>&, workerCpus, (), (const));
   MOCK_METHOD(const std::vector<std::string>&, disabledExtensions, (), (const));
   MOCK_METHOD(Server::CommandLineOptionsPtr, toCommandLineOptions, (), (const));
   MOCK_METHOD(const std::string&, socketPath, (), (const));
   MOCK_METHOD(mode_t, socketMode, (), (const));
   MOCK_METHOD((const Stats::TagVector&), statsTags, (), (const));
+  MOCK_METHOD(const std::string&, statsSharedMemoryPath, (), (const));
+  MOCK_METHOD(uint32_t, statsSharedMemoryMaxStats, (), (const));
   MOCK_METHOD(const std::string&, listenerManager, (), (const));
 
   std::string config_path_;
@@ -68,6 +72,7 @@ public:
   std::string service_zone_name_;
   spdlog::level::level_enum log_level_{spdlog::level::trace};
   std::string log_path_;
+  uint64_t log_async_buffer_size_{};
   uint32_t concurrency_{1};
   uint64_t hot_restart_epoch_{};
   bool hot_restart_disabled_{};
@@ -75,10 +80,13 @@ public:
   bool mutex_tracing_enabled_{};
   bool core_dump_enabled_{};
   bool cpuset_threads_enabled_{};
+  std::vector<uint32_t> worker_cpus_;
   std::vector<std::string> disabled_extensions_;
   std::string socket_path_;
   mode_t socket_mode_;
   Stats::TagVector stats_tags_;
+  std::string stats_shared_memory_path_;
+  uint32_t stats_shared_memory_max_stats_{16384};
 };
 } // namespace Server
 } // namespace Envoy
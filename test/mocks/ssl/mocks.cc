@@ -25,9 +25,16 @@ MockClientContextConfig::MockClientContextConfig() {
 }
 MockClientContextConfig::~MockClientContextConfig() = default;
 
-MockServerContextConfig::MockServerContextConfig() = default;
+MockServerContextConfig::MockServerContextConfig() {
+  ON_CALL(*this, handshakeOffload()).WillByDefault(testing::ReturnRef(handshake_offload_));
+}
 MockServerContextConfig::~MockServerContextConfig() = default;
 
+MockCertificateValidationContextConfig::MockCertificateValidationContextConfig() {
+  ON_CALL(*this, asyncValidation()).WillByDefault(testing::ReturnRef(async_validation_));
+}
+MockCertificateValidationContextConfig::~MockCertificateValidationContextConfig() = default;
+
 MockPrivateKeyMethodManager::MockPrivateKeyMethodManager() = default;
 MockPrivateKeyMethodManager::~MockPrivateKeyMethodManager() = default;
 
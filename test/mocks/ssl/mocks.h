@@ -103,7 +103,9 @@ public:
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
+  MOCK_METHOD(bool, kernelTlsTx, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
+  MOCK_METHOD(Api::Api&, api, (), (const));
   Ssl::HandshakerCapabilities capabilities_;
   std::string sni_{"default_sni.example.com"};
   std::string ciphers_{"RSA"};
@@ -115,6 +117,8 @@ public:
 
 class MockServerContextConfig : public ServerContextConfig {
 public:
+  using HandshakeOffload = envoy::extensions::transport_sockets::tls::v3::HandshakeOffload;
+
   MockServerContextConfig();
   ~MockServerContextConfig() override;
 
@@ -138,11 +142,17 @@ public:
   MOCK_METHOD(OcspStaplePolicy, ocspStaplePolicy, (), (const));
   MOCK_METHOD(const std::vector<SessionTicketKey>&, sessionTicketKeys, (), (const));
   MOCK_METHOD(bool, disableStatelessSessionResumption, (), (const));
+  MOCK_METHOD(absl::optional<uint32_t>, maxCachedSessions, (), (const));
+  MOCK_METHOD(const absl::optional<HandshakeOffload>&, handshakeOffload, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
+  MOCK_METHOD(bool, kernelTlsTx, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
+  MOCK_METHOD(Api::Api&, api, (), (const));
   MOCK_METHOD(bool, fullScanCertsOnSNIMismatch, (), (const));
+
+  absl::optional<HandshakeOffload> handshake_offload_;
 };
 
 class MockTlsCertificateConfig : public TlsCertificateConfig {
@@ -165,6 +175,9 @@ public:
 
 class MockCertificateValidationContextConfig : public CertificateValidationContextConfig {
 public:
+  MockCertificateValidationContextConfig();
+  ~MockCertificateValidationContextConfig() override;
+
   MOCK_METHOD(const std::string&, caCert, (), (const));
   MOCK_METHOD(const std::string&, caCertPath, (), (const));
   MOCK_METHOD(const std::string&, certificateRevocationList, (), (const));
@@ -183,6 +196,10 @@ public:
               trustChainVerification, (), (const));
   MOCK_METHOD(bool, onlyVerifyLeafCertificateCrl, (), (const));
   MOCK_METHOD(absl::optional<uint32_t>, maxVerifyDepth, (), (const));
+  MOCK_METHOD(const absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation>&,
+              asyncValidation, (), (const));
+
+  absl::optional<envoy::extensions::transport_sockets::tls::v3::AsyncValidation> async_validation_;
 };
 
 class MockPrivateKeyMethodManager : public PrivateKeyMethodManager {
@@ -161,6 +161,7 @@ public:
   MOCK_METHOD(void, setParentValue, (uint64_t parent_value));
   MOCK_METHOD(void, sub, (uint64_t amount));
   MOCK_METHOD(void, mergeImportMode, (ImportMode));
+  MOCK_METHOD(bool, latchChanged, ());
   MOCK_METHOD(bool, used, (), (const));
   MOCK_METHOD(uint64_t, value, (), (const));
   MOCK_METHOD(absl::optional<bool>, cachedShouldImport, (), (const));
@@ -261,6 +262,7 @@ public:
 
   MOCK_METHOD(void, flush, (MetricSnapshot & snapshot));
   MOCK_METHOD(void, onHistogramComplete, (const Histogram& histogram, uint64_t value));
+  MOCK_METHOD(bool, acceptsDeltaSnapshots, (), (const));
 };
 
 class MockSinkPredicates : public SinkPredicates {
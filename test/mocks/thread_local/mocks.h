@@ -26,6 +26,8 @@ public:
   MOCK_METHOD(void, shutdownThread, ());
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
   bool isShutdown() const override { return shutdown_; }
+  void beginUpdateBatch() override {}
+  uint64_t endUpdateBatch() override { return 0; }
 
   SlotPtr allocateSlotMock() { return SlotPtr{new SlotImpl(*this, current_slot_++)}; }
   void runOnAllThreads1(Event::PostCb cb) { cb(); }
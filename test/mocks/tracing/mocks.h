@@ -84,6 +84,7 @@ public:
   MOCK_METHOD(Span*, startSpan_,
               (const Config& config, TraceContext& trace_context, const std::string& operation_name,
                SystemTime start_time, const Tracing::Decision tracing_decision));
+  MOCK_METHOD(bool, propagateUntracedContext, (TraceContext & trace_context));
 };
 
 class MockTracerManager : public TracerManager {
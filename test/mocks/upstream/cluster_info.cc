@@ -62,8 +62,7 @@ MockClusterInfo::MockClusterInfo()
       cluster_circuit_breakers_stat_names_(stats_store_.symbolTable()),
       cluster_request_response_size_stat_names_(stats_store_.symbolTable()),
       cluster_timeout_budget_stat_names_(stats_store_.symbolTable()),
-      traffic_stats_(
-          std::make_unique<ClusterTrafficStats>(traffic_stat_names_, *stats_store_.rootScope())),
+      traffic_stats_(traffic_stat_names_, *stats_store_.rootScope(), false),
       config_update_stats_(config_update_stats_names_, *stats_store_.rootScope()),
       lb_stats_(lb_stat_names_, *stats_store_.rootScope()),
       endpoint_stats_(endpoint_stat_names_, *stats_store_.rootScope()),
@@ -115,6 +114,11 @@ MockClusterInfo::MockClusterInfo()
       .WillByDefault(
           Invoke([this]() -> TransportSocketMatcher& { return *transport_socket_matcher_; }));
   ON_CALL(*this, loadReportStats()).WillByDefault(ReturnRef(load_report_stats_));
+  ON_CALL(*this, localityLoadStats(_, _))
+      .WillByDefault(Invoke([this](const envoy::config::core::v3::Locality& locality,
+                                   uint32_t priority) -> LocalityLoadStats& {
+        return locality_load_stats_.get(locality, priority);
+      }));
   ON_CALL(*this, requestResponseSizeStats())
       .WillByDefault(Return(
           std::reference_wrapper<ClusterRequestResponseSizeStats>(*request_response_size_stats_)));
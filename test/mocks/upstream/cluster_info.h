@@ -52,6 +52,7 @@ public:
   MOCK_METHOD(bool, scaleLocalityWeight, (), (const));
   MOCK_METHOD(bool, panicModeAny, (), (const));
   MOCK_METHOD(bool, listAsAny, (), (const));
+  MOCK_METHOD(uint32_t, maxSubsetLoadBalancers, (), (const));
 
   std::vector<SubsetSelectorPtr> subset_selectors_;
 };
@@ -105,6 +106,14 @@ public:
         circuit_breakers_stats_, budget_percent, min_retry_concurrency);
   }
 
+  void resetResourceManagerWithRetryTokenBucket(
+      uint64_t rq_retry,
+      const envoy::config::cluster::v3::CircuitBreakers::Thresholds::RetryTokenBucket& config) {
+    resource_manager_ = std::make_unique<ResourceManagerImpl>(
+        runtime_, name_, 0, 0, 0, rq_retry, 0, 100, circuit_breakers_stats_, absl::nullopt,
+        absl::nullopt, std::make_unique<RetryTokenBucketImpl>(config));
+  }
+
   // Upstream::ClusterInfo
   MOCK_METHOD(bool, addedViaApi, (), (const));
   MOCK_METHOD(std::chrono::milliseconds, connectTimeout, (), (const));
@@ -158,6 +167,8 @@ public:
   MOCK_METHOD(ClusterConfigUpdateStats&, configUpdateStats, (), (const));
   MOCK_METHOD(Stats::Scope&, statsScope, (), (const));
   MOCK_METHOD(ClusterLoadReportStats&, loadReportStats, (), (const));
+  MOCK_METHOD(LocalityLoadStats&, localityLoadStats,
+              (const envoy::config::core::v3::Locality& locality, uint32_t priority), (const));
   MOCK_METHOD(ClusterRequestResponseSizeStatsOptRef, requestResponseSizeStats, (), (const));
   MOCK_METHOD(ClusterTimeoutBudgetStatsOptRef, timeoutBudgetStats, (), (const));
   MOCK_METHOD(std::shared_ptr<UpstreamLocalAddressSelector>, getUpstreamLocalAddressSelector, (),
@@ -218,6 +229,7 @@ public:
   Upstream::TransportSocketMatcherPtr transport_socket_matcher_;
   NiceMock<Stats::MockIsolatedStatsStore> load_report_stats_store_;
   ClusterLoadReportStats load_report_stats_;
+  LocalityLoadStatsMap locality_load_stats_;
   NiceMock<Stats::MockIsolatedStatsStore> request_response_size_stats_store_;
   ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
   NiceMock<Stats::MockIsolatedStatsStore> timeout_budget_stats_store_;
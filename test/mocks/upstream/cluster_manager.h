@@ -36,8 +36,8 @@ public:
 
   // Upstream::ClusterManager
   MOCK_METHOD(bool, addOrUpdateCluster,
-              (const envoy::config::cluster::v3::Cluster& cluster,
-               const std::string& version_info));
+              (const envoy::config::cluster::v3::Cluster& cluster, const std::string& version_info,
+               absl::optional<uint64_t> hash));
   MOCK_METHOD(void, setPrimaryClustersInitializedCb, (PrimaryClustersReadyCallback));
   MOCK_METHOD(void, setInitializedCb, (InitializationCompleteCallback));
   MOCK_METHOD(void, initializeSecondaryClusters,
@@ -47,6 +47,7 @@ public:
   MOCK_METHOD(const ClusterSet&, primaryClusters, ());
   MOCK_METHOD(ThreadLocalCluster*, getThreadLocalCluster, (absl::string_view cluster));
   MOCK_METHOD(bool, removeCluster, (const std::string& cluster));
+  MOCK_METHOD(std::unique_ptr<Cleanup>, batchThreadLocalUpdates, ());
   MOCK_METHOD(void, shutdown, ());
   MOCK_METHOD(const absl::optional<envoy::config::core::v3::BindConfig>&, bindConfig, (), (const));
   MOCK_METHOD(Config::GrpcMuxSharedPtr, adsMux, ());
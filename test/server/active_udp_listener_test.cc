@@ -221,6 +221,7 @@ TEST_P(ActiveUdpListenerTest, UdpListenerWorkerRouterTest) {
 
   Network::UdpRecvData data;
   active_listener_->onData(std::move(data));
+  EXPECT_EQ(1, scope_.counterFromString("udp.downstream_rx_datagram_forwarded").value());
 
   EXPECT_CALL(*another_udp_listener, onDestroy());
 }
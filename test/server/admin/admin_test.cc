@@ -160,6 +160,7 @@ TEST_P(AdminInstanceTest, Help) {
       paths: Change multiple logging levels by setting to <logger_name1>:<desired_level1>,<logger_name2>:<desired_level2>.
       level: desired logging level; One of (, trace, debug, info, warning, error, critical, off)
   /memory: print current allocation/heap usage
+  /memory/breakdown: print the heap usage of the subsystems, estimated from sampled allocations
   /quitquitquit (POST): exit the server
   /ready: print server state, return 200 if LIVE, otherwise return 503
   /reopen_logs (POST): reopen access logs
@@ -181,6 +182,8 @@ TEST_P(AdminInstanceTest, Help) {
   /stats/recentlookups/clear (POST): clear list of stat-name lookups and counter
   /stats/recentlookups/disable (POST): disable recording of reset stat-name lookup names
   /stats/recentlookups/enable (POST): enable recording of reset stat-name lookup names
+  /stats/slow_callbacks: show the slowest event loop callbacks of each dispatcher (if enabled)
+  /stats/slow_callbacks/clear (POST): clear the slowest event loop callbacks
 )EOF";
   EXPECT_EQ(expected, response.toString());
 }
@@ -240,5 +240,58 @@ fake_cluster::1.2.3.4:80::local_origin_success_rate::93.2
   EXPECT_EQ(expected_text, response2.toString());
 }
 
+// The clusters are streamed one at a time, laid out as when the whole output is rendered at once.
+TEST_P(AdminInstanceTest, ClustersStreamedInChunks) {
+  Upstream::ClusterManager::ClusterInfoMaps cluster_maps;
+  ON_CALL(server_.cluster_manager_, clusters()).WillByDefault(ReturnPointee(&cluster_maps));
+
+  NiceMock<Upstream::MockClusterMockPrioritySet> cluster_1;
+  cluster_maps.active_clusters_.emplace(cluster_1.info_->name_, cluster_1);
+  NiceMock<Upstream::MockClusterMockPrioritySet> cluster_2;
+  cluster_2.info_->name_ = "fake_cluster_2";
+  cluster_maps.active_clusters_.emplace(cluster_2.info_->name_, cluster_2);
+  auto host = std::make_shared<NiceMock<Upstream::MockHost>>();
+  cluster_2.priority_set_.getMockHostSet(0)->hosts_.emplace_back(host);
+  envoy::config::core::v3::Locality locality;
+  const std::string hostname = "foo.com";
+  ON_CALL(*host, locality()).WillByDefault(ReturnRef(locality));
+  ON_CALL(*host, hostname()).WillByDefault(ReturnRef(hostname));
+  ON_CALL(*host, address())
+      .WillByDefault(Return(Network::Utility::resolveUrl("tcp://1.2.3.4:80")));
+
+  for (const bool json : {false, true}) {
+    ClustersRequest whole_request(server_.cluster_manager_, json);
+    Http::TestResponseHeaderMapImpl whole_headers;
+    EXPECT_EQ(Http::Code::OK, whole_request.start(whole_headers));
+    Buffer::OwnedImpl whole;
+    EXPECT_FALSE(whole_request.nextChunk(whole));
+
+    ClustersRequest request(server_.cluster_manager_, json);
+    request.setChunkSize(1);
+    Http::TestResponseHeaderMapImpl streamed_headers;
+    EXPECT_EQ(Http::Code::OK, request.start(streamed_headers));
+    Buffer::OwnedImpl streamed;
+    EXPECT_TRUE(request.nextChunk(streamed));
+    EXPECT_TRUE(request.nextChunk(streamed));
+    EXPECT_FALSE(request.nextChunk(streamed));
+    EXPECT_EQ(whole.toString(), streamed.toString());
+    EXPECT_EQ(whole_headers.getContentTypeValue(), streamed_headers.getContentTypeValue());
+
+    if (json) {
+      envoy::admin::v3::Clusters clusters;
+      TestUtility::loadFromJson(streamed.toString(), clusters);
+      EXPECT_EQ(2, clusters.cluster_statuses_size());
+      EXPECT_EQ(MessageUtil::getJsonStringFromMessageOrError(clusters, true), streamed.toString());
+    }
+  }
+}
+
+TEST_P(AdminInstanceTest, ClustersJsonEmpty) {
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::OK, getCallback("/clusters?format=json", header_map, response));
+  EXPECT_EQ("{}\n", response.toString());
+}
+
 } // namespace Server
 } // namespace Envoy
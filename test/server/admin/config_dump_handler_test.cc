@@ -1,4 +1,5 @@
 #include "test/integration/filters/test_listener_filter.pb.h"
+#include "test/mocks/server/admin_stream.h"
 #include "test/server/admin/admin_instance.h"
 
 using testing::HasSubstr;
@@ -858,5 +859,80 @@ TEST_P(AdminInstanceTest, ConfigDumpEcdsByResourceAndMask) {
   EXPECT_EQ(expected_json, output);
 }
 
+// The streamed config dump is the same as the whole one, whatever the chunk size.
+TEST_P(AdminInstanceTest, ConfigDumpStreamedInChunks) {
+  Upstream::ClusterManager::ClusterInfoMaps cluster_maps;
+  ON_CALL(server_.cluster_manager_, clusters()).WillByDefault(ReturnPointee(&cluster_maps));
+  envoy::config::core::v3::Locality locality;
+  const std::string hostname_for_healthcheck = "test_hostname_healthcheck";
+  const std::string hostname = "foo.com";
+
+  NiceMock<Upstream::MockClusterMockPrioritySet> cluster_1;
+  cluster_maps.active_clusters_.emplace(cluster_1.info_->name_, cluster_1);
+  ON_CALL(*cluster_1.info_, addedViaApi()).WillByDefault(Return(true));
+  auto host_1 = std::make_shared<NiceMock<Upstream::MockHost>>();
+  cluster_1.priority_set_.getMockHostSet(0)->hosts_.emplace_back(host_1);
+  addHostInfo(*host_1, hostname, "tcp://1.2.3.4:80", locality, hostname_for_healthcheck,
+              "tcp://1.2.3.5:90", 5, 6);
+
+  NiceMock<Upstream::MockClusterMockPrioritySet> cluster_2;
+  cluster_2.info_->name_ = "fake_cluster_2";
+  cluster_maps.active_clusters_.emplace(cluster_2.info_->name_, cluster_2);
+  ON_CALL(*cluster_2.info_, addedViaApi()).WillByDefault(Return(false));
+  auto host_2 = std::make_shared<NiceMock<Upstream::MockHost>>();
+  cluster_2.priority_set_.getMockHostSet(0)->hosts_.emplace_back(host_2);
+  addHostInfo(*host_2, hostname, "tcp://1.2.3.5:8", locality, hostname_for_healthcheck,
+              "tcp://1.2.3.4:1", 3, 4);
+
+  auto listeners = admin_.getConfigTracker().add("listeners", [](const Matchers::StringMatcher&) {
+    auto msg = std::make_unique<envoy::admin::v3::ListenersConfigDump>();
+    msg->add_static_listeners()->mutable_listener()->PackFrom(ProtobufWkt::StringValue());
+    msg->add_dynamic_listeners()->set_name("foo");
+    msg->add_dynamic_listeners()->set_name("bar");
+    return msg;
+  });
+  auto strings = admin_.getConfigTracker().add("strings", [](const Matchers::StringMatcher&) {
+    auto msg = std::make_unique<ProtobufWkt::StringValue>();
+    msg->set_value("bar");
+    return msg;
+  });
+
+  ConfigDumpHandler handler(admin_.getConfigTracker(), server_);
+  for (absl::string_view url :
+       {"/config_dump", "/config_dump?include_eds", "/config_dump?include_eds&name_regex=.*2",
+        "/config_dump?resource=dynamic_listeners",
+        "/config_dump?include_eds&resource=static_endpoint_configs"}) {
+    NiceMock<MockAdminStream> admin_stream;
+    ON_CALL(admin_stream, queryParams())
+        .WillByDefault(Return(Http::Utility::parseQueryString(url)));
+
+    Http::TestResponseHeaderMapImpl whole_headers;
+    Buffer::OwnedImpl whole;
+    EXPECT_EQ(Http::Code::OK, handler.handlerConfigDump(whole_headers, whole, admin_stream))
+        << url;
+
+    ConfigDumpRequest request(handler, admin_stream);
+    request.setChunkSize(1);
+    Http::TestResponseHeaderMapImpl streamed_headers;
+    EXPECT_EQ(Http::Code::OK, request.start(streamed_headers)) << url;
+    Buffer::OwnedImpl streamed;
+    uint32_t chunks = 1;
+    while (request.nextChunk(streamed)) {
+      ++chunks;
+    }
+    EXPECT_LT(1, chunks) << url;
+    EXPECT_EQ(whole.toString(), streamed.toString()) << url;
+    EXPECT_EQ(whole_headers.getContentTypeValue(), streamed_headers.getContentTypeValue()) << url;
+  }
+}
+
+// An empty config dump is streamed as an empty message.
+TEST_P(AdminInstanceTest, ConfigDumpStreamedEmpty) {
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::OK, getCallback("/config_dump", header_map, response));
+  EXPECT_EQ("{}\n", response.toString());
+}
+
 } // namespace Server
 } // namespace Envoy
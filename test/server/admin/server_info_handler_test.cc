@@ -1,5 +1,6 @@
 #include "envoy/admin/v3/memory.pb.h"
 
+#include "source/common/memory/heap_breakdown.h"
 #include "source/extensions/transport_sockets/tls/context_config_impl.h"
 
 #include "test/server/admin/admin_instance.h"
@@ -62,6 +63,19 @@ TEST_P(AdminInstanceTest, Memory) {
                                   Property(&envoy::admin::v3::Memory::total_thread_cache, Ge(0))));
 }
 
+TEST_P(AdminInstanceTest, MemoryBreakdown) {
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  if (!Memory::HeapBreakdown::supported()) {
+    EXPECT_EQ(Http::Code::NotImplemented, getCallback("/memory/breakdown", header_map, response));
+    return;
+  }
+  EXPECT_EQ(Http::Code::OK, getCallback("/memory/breakdown", header_map, response));
+  envoy::admin::v3::MemoryBreakdown output_proto;
+  TestUtility::loadFromJson(response.toString(), output_proto);
+  EXPECT_GT(output_proto.allocated(), 0);
+}
+
 TEST_P(AdminInstanceTest, GetReadyRequest) {
   NiceMock<Init::MockManager> initManager;
   ON_CALL(server_, initManager()).WillByDefault(ReturnRef(initManager));
@@ -5,6 +5,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 
 #include "benchmark/benchmark.h"
@@ -35,14 +36,13 @@ public:
    * Issues an admin request against the stats saved in store_.
    */
   uint64_t handlerStats(const StatsParams& params) {
-    Buffer::OwnedImpl data;
-    if (params.format_ == Envoy::Server::StatsFormat::Prometheus) {
-      Envoy::Server::StatsHandler::prometheusRender(store_, custom_namespaces_, params, data);
-      return data.length();
-    }
-    Admin::RequestPtr request = StatsHandler::makeRequest(store_, params);
+    Admin::RequestPtr request =
+        params.format_ == Envoy::Server::StatsFormat::Prometheus
+            ? StatsHandler::makePrometheusRequest(store_, custom_namespaces_, params)
+            : StatsHandler::makeRequest(store_, params);
     auto response_headers = Http::ResponseHeaderMapImpl::create();
     request->start(*response_headers);
+    Buffer::OwnedImpl data;
     uint64_t count = 0;
     bool more = true;
     do {
@@ -53,6 +53,20 @@ public:
     return count;
   }
 
+  /**
+   * Issues an admin request against the stats saved in store_, returning only
+   * the first chunk of the response.
+   */
+  uint64_t firstChunk(const StatsParams& params) {
+    Admin::RequestPtr request =
+        StatsHandler::makePrometheusRequest(store_, custom_namespaces_, params);
+    auto response_headers = Http::ResponseHeaderMapImpl::create();
+    request->start(*response_headers);
+    Buffer::OwnedImpl data;
+    request->nextChunk(data);
+    return data.length();
+  }
+
   Stats::SymbolTableImpl symbol_table_;
   Stats::AllocatorImpl alloc_;
   Stats::ThreadLocalStoreImpl store_;
@@ -193,3 +207,20 @@ static void BM_FilteredCountersPrometheus(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_FilteredCountersPrometheus)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FirstChunkPrometheus(benchmark::State& state) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext();
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus", response);
+
+  for (auto _ : state) { // NOLINT
+    uint64_t count = test_context.firstChunk(params);
+    RELEASE_ASSERT(count >= Envoy::Server::PrometheusStatsRequest::DefaultChunkSize,
+                   "expected a full chunk");
+    RELEASE_ASSERT(count < 2 * Envoy::Server::PrometheusStatsRequest::DefaultChunkSize,
+                   "expected a single chunk");
+  }
+}
+BENCHMARK(BM_FirstChunkPrometheus)->Unit(benchmark::kMillisecond);
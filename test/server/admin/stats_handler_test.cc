@@ -2,8 +2,10 @@
 #include <string>
 
 #include "source/common/common/regex.h"
+#include "source/common/event/slow_callback_tracker.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 #include "source/server/admin/stats_request.h"
 
@@ -1266,6 +1268,34 @@ TEST_P(AdminInstanceTest, RecentLookups) {
   EXPECT_THAT(body, HasSubstr("       1 gamma\n       2 beta\n       3 alpha\n"));
 }
 
+TEST_P(AdminInstanceTest, SlowCallbacks) {
+  Http::TestResponseHeaderMapImpl response_headers;
+  std::string body;
+
+  // Slow callbacks are only tracked by the dispatchers with stats enabled.
+  EXPECT_EQ(Http::Code::OK, admin_.request("/stats/slow_callbacks", "GET", response_headers, body));
+  EXPECT_THAT(body, HasSubstr("Slow callback tracking is not enabled"));
+
+  Event::SlowCallbackTracker tracker("worker_0.dispatcher");
+  Event::SlowCallbackRegistry::get().add(tracker);
+  tracker.record(Event::CallbackCategory::Timer, std::chrono::microseconds(1500), "");
+  tracker.record(Event::CallbackCategory::FileEvent, std::chrono::microseconds(2500),
+                 "ConnectionImpl 0x1234:\n  connecting_: 0\n");
+  EXPECT_EQ(Http::Code::OK, admin_.request("/stats/slow_callbacks", "GET", response_headers, body));
+  EXPECT_EQ("worker_0.dispatcher:\n"
+            "        2500us file_event\n"
+            "      ConnectionImpl 0x1234:\n"
+            "        connecting_: 0\n"
+            "        1500us timer\n",
+            body);
+
+  EXPECT_EQ(Http::Code::OK,
+            admin_.request("/stats/slow_callbacks/clear", "POST", response_headers, body));
+  EXPECT_EQ(Http::Code::OK, admin_.request("/stats/slow_callbacks", "GET", response_headers, body));
+  EXPECT_EQ("worker_0.dispatcher:\n", body);
+  Event::SlowCallbackRegistry::get().remove(tracker);
+}
+
 class StatsHandlerPrometheusTest : public StatsHandlerTest {
 public:
   void createTestStats() {
@@ -1355,5 +1385,40 @@ envoy_control_plane_identifier{cluster="c1",text_value="cp-1"} 0
   EXPECT_THAT(expected_response, code_response.second);
 }
 
+// The prometheus output is streamed in chunks of whole tag-extracted name groups, and the
+// concatenated chunks match the buffered rendering.
+TEST_F(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusChunked) {
+  createTestStats();
+  for (uint32_t i = 0; i < 100; ++i) {
+    store_->rootScope()->counterFromString(absl::StrCat("chunked.counter_", i)).inc();
+  }
+
+  StatsParams params;
+  Buffer::OwnedImpl buffered;
+  PrometheusStatsFormatter::statsAsPrometheus(store_->counters(), store_->gauges(),
+                                              store_->histograms(), {}, buffered, params,
+                                              custom_namespaces_);
+
+  PrometheusStatsRequest request(*store_, params, custom_namespaces_);
+  request.setChunkSize(100);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+  std::string streamed;
+  uint32_t num_chunks = 0;
+  bool more;
+  do {
+    Buffer::OwnedImpl chunk;
+    more = request.nextChunk(chunk);
+    if (chunk.length() > 0) {
+      ++num_chunks;
+      EXPECT_TRUE(absl::StartsWith(chunk.toString(), "# TYPE ")) << chunk.toString();
+    }
+    streamed += chunk.toString();
+  } while (more);
+
+  EXPECT_LE(20, num_chunks);
+  EXPECT_EQ(buffered.toString(), streamed);
+}
+
 } // namespace Server
 } // namespace Envoy
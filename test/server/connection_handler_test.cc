@@ -158,6 +158,9 @@ public:
     uint32_t tcpBacklogSize() const override { return tcp_backlog_size_; }
     Init::Manager& initManager() override { return *init_manager_; }
     bool ignoreGlobalConnLimit() const override { return ignore_global_conn_limit_; }
+    uint32_t maxConnectionsToAcceptPerSocketEvent() const override {
+      return Network::DefaultMaxConnectionsToAcceptPerSocketEvent;
+    }
     void setMaxConnections(const uint32_t num_connections) {
       open_connections_.setMax(num_connections);
     }
@@ -2599,6 +2602,20 @@ TEST_F(ConnectionHandlerTest, TcpListenerOverloadActionReject) {
   EXPECT_CALL(*listener, onDestroy());
 }
 
+TEST_F(ConnectionHandlerTest, TcpListenerListenerCxLimitReject) {
+  Network::TcpListenerCallbacks* listener_callbacks;
+  auto listener = new NiceMock<Network::MockListener>();
+  TestListener* test_listener =
+      addListener(1, true, false, "test_listener", listener, &listener_callbacks);
+  handler_->addListener(absl::nullopt, *test_listener, runtime_);
+
+  listener_callbacks->onReject(Network::TcpListenerCallbacks::RejectCause::ListenerCxLimit);
+
+  EXPECT_EQ(1UL, TestUtility::findCounter(stats_store_, "downstream_cx_overflow")->value());
+  EXPECT_EQ(0UL, TestUtility::findCounter(stats_store_, "downstream_global_cx_overflow")->value());
+  EXPECT_CALL(*listener, onDestroy());
+}
+
 // Listener Filter matchers works.
 TEST_F(ConnectionHandlerTest, ListenerFilterWorks) {
   Network::TcpListenerCallbacks* listener_callbacks;
@@ -207,6 +207,65 @@ TEST_F(HotRestartingParentTest, GetListenSocketsForChildUnixDomainSocket) {
   EXPECT_EQ(0, message.reply().pass_listen_socket().fd());
 }
 
+// Verifies that all the listen sockets of the workers are passed at once, as long as they fit in a
+// single message.
+TEST_F(HotRestartingParentTest, GetAllListenSocketsForChild) {
+  MockListenerManager listener_manager;
+  NiceMock<Network::MockListenerConfig> tcp_listener_config;
+  NiceMock<Network::MockListenerConfig> udp_listener_config;
+  NiceMock<Network::MockListenerConfig> not_bound_listener_config;
+  NiceMock<MockOptions> options;
+  std::vector<std::reference_wrapper<Network::ListenerConfig>> listeners{
+      tcp_listener_config, not_bound_listener_config, udp_listener_config};
+  EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, listeners(ListenerManager::ListenerState::ACTIVE))
+      .WillRepeatedly(Return(listeners));
+  EXPECT_CALL(server_, options()).WillRepeatedly(ReturnRef(options));
+  ON_CALL(options, concurrency()).WillByDefault(Return(2));
+
+  Network::Address::InstanceConstSharedPtr udp_address(
+      new Network::Address::Ipv4Instance("127.0.0.1", 53));
+  ON_CALL(tcp_listener_config, bindToPort()).WillByDefault(Return(true));
+  ON_CALL(udp_listener_config, bindToPort()).WillByDefault(Return(true));
+  ON_CALL(*static_cast<Network::MockListenSocketFactory*>(
+              tcp_listener_config.socket_factories_[0].get()),
+          socketType())
+      .WillByDefault(Return(Network::Socket::Type::Stream));
+  auto* udp_socket_factory = static_cast<Network::MockListenSocketFactory*>(
+      udp_listener_config.socket_factories_[0].get());
+  ON_CALL(*udp_socket_factory, socketType()).WillByDefault(Return(Network::Socket::Type::Datagram));
+  ON_CALL(*udp_socket_factory, localAddress()).WillByDefault(ReturnRef(udp_address));
+
+  HotRestartMessage::Request request;
+  request.mutable_pass_listen_sockets();
+  HotRestartMessage message = hot_restarting_parent_.getAllListenSocketsForChild(request);
+  const auto& reply = message.reply().pass_listen_sockets();
+  EXPECT_FALSE(reply.more());
+  ASSERT_EQ(4, reply.sockets_size());
+  EXPECT_EQ("tcp://0.0.0.0:80", reply.sockets(0).address());
+  EXPECT_EQ(0, reply.sockets(0).worker_index());
+  EXPECT_EQ("tcp://0.0.0.0:80", reply.sockets(1).address());
+  EXPECT_EQ(1, reply.sockets(1).worker_index());
+  EXPECT_EQ("udp://127.0.0.1:53", reply.sockets(2).address());
+  EXPECT_EQ(0, reply.sockets(2).worker_index());
+  EXPECT_EQ("udp://127.0.0.1:53", reply.sockets(3).address());
+  EXPECT_EQ(1, reply.sockets(3).worker_index());
+
+  // With more sockets than fit in a message, the child asks for the rest.
+  ON_CALL(options, concurrency()).WillByDefault(Return(50));
+  message = hot_restarting_parent_.getAllListenSocketsForChild(request);
+  EXPECT_TRUE(message.reply().pass_listen_sockets().more());
+  const int first_sockets = message.reply().pass_listen_sockets().sockets_size();
+  EXPECT_LT(0, first_sockets);
+  EXPECT_GT(100, first_sockets);
+
+  request.mutable_pass_listen_sockets()->set_first_socket(first_sockets);
+  message = hot_restarting_parent_.getAllListenSocketsForChild(request);
+  EXPECT_FALSE(message.reply().pass_listen_sockets().more());
+  EXPECT_EQ(100 - first_sockets, message.reply().pass_listen_sockets().sockets_size());
+  EXPECT_EQ("udp://127.0.0.1:53", message.reply().pass_listen_sockets().sockets(0).address());
+}
+
 TEST_F(HotRestartingParentTest, ExportStatsToChild) {
   Stats::TestUtil::TestStore store;
   MockListenerManager listener_manager;
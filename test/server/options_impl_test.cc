@@ -98,12 +98,13 @@ TEST_F(OptionsImplTest, All) {
       "--file-flush-interval-msec 9000 "
       "--drain-time-s 60 --log-format [%v] --enable-fine-grain-logging --parent-shutdown-time-s 90 "
       "--log-path "
-      "/foo/bar "
+      "/foo/bar --log-async-buffer-size 65536 "
       "--disable-hot-restart --cpuset-threads --allow-unknown-static-fields "
       "--reject-unknown-dynamic-fields --base-id 5 "
       "--use-dynamic-base-id --base-id-path /foo/baz "
       "--stats-tag foo:bar --stats-tag baz:bar "
-      "--socket-path /foo/envoy_domain_socket --socket-mode 644");
+      "--stats-shared-memory-path /dev/shm/envoy_stats --stats-shared-memory-max-stats 1000 "
+      "--socket-path /foo/envoy_domain_socket --socket-mode 644 --worker-cpus 0-1,4");
   EXPECT_EQ(Server::Mode::Validate, options->mode());
   EXPECT_EQ(2U, options->concurrency());
   EXPECT_EQ("hello", options->configPath());
@@ -114,6 +115,7 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ(2, options->componentLogLevels().size());
   EXPECT_EQ("[%v]", options->logFormat());
   EXPECT_EQ("/foo/bar", options->logPath());
+  EXPECT_EQ(65536U, options->logAsyncBufferSize());
   EXPECT_EQ(true, options->enableFineGrainLogging());
   EXPECT_EQ("cluster", options->serviceClusterName());
   EXPECT_EQ("node", options->serviceNodeName());
@@ -123,6 +125,7 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
   EXPECT_TRUE(options->cpusetThreadsEnabled());
+  EXPECT_EQ((std::vector<uint32_t>{0, 1, 4}), options->workerCpus());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ(5U, options->baseId());
@@ -131,6 +134,8 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ("/foo/envoy_domain_socket", options->socketPath());
   EXPECT_EQ(0644, options->socketMode());
   EXPECT_EQ(2U, options->statsTags().size());
+  EXPECT_EQ("/dev/shm/envoy_stats", options->statsSharedMemoryPath());
+  EXPECT_EQ(1000U, options->statsSharedMemoryMaxStats());
 
   options = createOptionsImpl("envoy --mode init_only");
   EXPECT_EQ(Server::Mode::InitOnly, options->mode());
@@ -179,6 +184,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setLogLevel(spdlog::level::trace);
   options->setLogFormat("%L %n %v");
   options->setLogPath("/foo/bar");
+  options->setLogAsyncBufferSize(4096);
   options->setRestartEpoch(44);
   options->setFileFlushIntervalMsec(std::chrono::milliseconds(45));
   options->setMode(Server::Mode::Validate);
@@ -188,6 +194,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setHotRestartDisabled(!options->hotRestartDisabled());
   options->setSignalHandling(!options->signalHandlingEnabled());
   options->setCpusetThreads(!options->cpusetThreadsEnabled());
+  options->setWorkerCpus({2, 3});
   options->setAllowUnknownFields(true);
   options->setRejectUnknownFieldsDynamic(true);
   options->setSocketPath("/foo/envoy_domain_socket");
@@ -210,6 +217,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(spdlog::level::trace, options->logLevel());
   EXPECT_EQ("%L %n %v", options->logFormat());
   EXPECT_EQ("/foo/bar", options->logPath());
+  EXPECT_EQ(4096U, options->logAsyncBufferSize());
   EXPECT_EQ(std::chrono::seconds(43), options->parentShutdownTime());
   EXPECT_EQ(44, options->restartEpoch());
   EXPECT_EQ(std::chrono::milliseconds(45), options->fileFlushIntervalMsec());
@@ -220,6 +228,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(!hot_restart_disabled, options->hotRestartDisabled());
   EXPECT_EQ(!signal_handling_enabled, options->signalHandlingEnabled());
   EXPECT_EQ(!cpuset_threads_enabled, options->cpusetThreadsEnabled());
+  EXPECT_EQ((std::vector<uint32_t>{2, 3}), options->workerCpus());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ("/foo/envoy_domain_socket", options->socketPath());
@@ -243,6 +252,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(spdlog::level::to_string_view(options->logLevel()), command_line_options->log_level());
   EXPECT_EQ(options->logFormat(), command_line_options->log_format());
   EXPECT_EQ(options->logPath(), command_line_options->log_path());
+  EXPECT_EQ(options->logAsyncBufferSize(), command_line_options->log_async_buffer_size());
   EXPECT_EQ(options->restartEpoch(), command_line_options->restart_epoch());
   EXPECT_EQ(options->fileFlushIntervalMsec().count() / 1000,
             command_line_options->file_flush_interval().seconds());
@@ -254,6 +264,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->mutexTracingEnabled(), command_line_options->enable_mutex_tracing());
   EXPECT_EQ(options->coreDumpEnabled(), command_line_options->enable_core_dump());
   EXPECT_EQ(options->cpusetThreadsEnabled(), command_line_options->cpuset_threads());
+  EXPECT_THAT(command_line_options->worker_cpus(), testing::ElementsAre(2, 3));
   EXPECT_EQ(options->socketPath(), command_line_options->socket_path());
   EXPECT_EQ(options->socketMode(), command_line_options->socket_mode());
   EXPECT_EQ(1U, command_line_options->stats_tag().size());
@@ -272,6 +283,8 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ("@envoy_domain_socket", options->socketPath());
   EXPECT_EQ(0, options->socketMode());
   EXPECT_EQ(0U, options->statsTags().size());
+  EXPECT_EQ("", options->statsSharedMemoryPath());
+  EXPECT_EQ(16384U, options->statsSharedMemoryMaxStats());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
 
@@ -373,6 +386,10 @@ TEST_F(OptionsImplTest, OptionsFromArgvPrefix) {
 TEST_F(OptionsImplTest, BadCliOption) {
   EXPECT_THROW_WITH_REGEX(createOptionsImpl("envoy -c hello --local-address-ip-version foo"),
                           MalformedArgvException, "error: unknown IP address version 'foo'");
+  EXPECT_THROW_WITH_REGEX(
+      createOptionsImpl(
+          "envoy -c hello --stats-shared-memory-path /tmp/stats --stats-shared-memory-max-stats 0"),
+      MalformedArgvException, "error: stats-shared-memory-max-stats must be greater than 0");
 }
 
 TEST_F(OptionsImplTest, ParseComponentLogLevels) {
@@ -525,6 +542,24 @@ TEST_F(OptionsImplTest, SetCpusetOnly) {
   EXPECT_NE(options->concurrency(), 0);
 }
 
+TEST_F(OptionsImplTest, WorkerCpusSetConcurrency) {
+  std::unique_ptr<OptionsImpl> options =
+      createOptionsImpl("envoy -c hello --cpuset-threads --worker-cpus 2-5,9");
+  EXPECT_EQ((std::vector<uint32_t>{2, 3, 4, 5, 9}), options->workerCpus());
+  EXPECT_EQ(5U, options->concurrency());
+
+  options = createOptionsImpl("envoy -c hello --concurrency 8 --worker-cpus 3");
+  EXPECT_EQ((std::vector<uint32_t>{3}), options->workerCpus());
+  EXPECT_EQ(8U, options->concurrency());
+}
+
+TEST_F(OptionsImplTest, InvalidWorkerCpus) {
+  for (const std::string cpus : {"a", "1,", "3-1", "1-", "-1", "0-1024", "1;2"}) {
+    EXPECT_THROW_WITH_REGEX(createOptionsImpl("envoy -c hello --worker-cpus " + cpus),
+                            MalformedArgvException, "error: invalid CPU list");
+  }
+}
+
 TEST_F(OptionsImplTest, LogFormatDefault) {
   std::unique_ptr<OptionsImpl> options = createOptionsImpl({"envoy", "-c", "hello"});
   EXPECT_EQ(options->logFormat(), "[%Y-%m-%d %T.%e][%t][%l][%n] [%g:%#] %v");
@@ -794,6 +794,19 @@ TEST_F(OverloadManagerImplTest, ShouldThrowIfUsingResetStreamsWithoutBufferFacto
                           "Overload action .* requires buffer_factory_config.");
 }
 
+TEST_F(OverloadManagerImplTest, ShouldThrowIfUsingCloseConnectionsWithoutTrackingConnections) {
+  const std::string config = R"EOF(
+  buffer_factory_config:
+    minimum_account_to_track_power_of_two: 20
+  actions:
+    - name: envoy.overload_actions.close_high_memory_connections
+  )EOF";
+
+  EXPECT_THROW_WITH_REGEX(createOverloadManager(config), EnvoyException,
+                          "Overload action .* requires buffer_factory_config with "
+                          "track_connections.");
+}
+
 TEST_F(OverloadManagerImplTest, Shutdown) {
   setDispatcherExpectation();
 
@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
@@ -10,6 +11,7 @@
 #include "test/benchmark/main.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_cat.h"
@@ -47,7 +49,9 @@ public:
     // Create counters
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
       auto stat_name = pool_.add(absl::StrCat("counter.", idx));
-      stats_store_.rootScope()->counterFromStatName(stat_name).inc();
+      Stats::Counter& counter = stats_store_.rootScope()->counterFromStatName(stat_name);
+      counter.inc();
+      counters_.push_back(&counter);
     }
     // Create gauges
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
@@ -80,12 +84,34 @@ public:
     }
   }
 
+  // Flushes delta snapshots while 1% of the counters are incremented between flushes.
+  void testDelta(::benchmark::State& state) {
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues({{"envoy.reloadable_features.delta_stats_flush", "true"}});
+    std::list<Stats::SinkPtr> sinks;
+    auto* sink = new testing::NiceMock<Stats::MockSink>();
+    ON_CALL(*sink, acceptsDeltaSnapshots()).WillByDefault(testing::Return(true));
+    sinks.emplace_back(sink);
+    // The first flush has all the metrics.
+    Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, time_system_);
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      state.PauseTiming();
+      for (size_t idx = 0; idx < counters_.size(); idx += 100) {
+        counters_[idx]->inc();
+      }
+      state.ResumeTiming();
+      Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, time_system_);
+    }
+  }
+
 private:
   Stats::SymbolTableImpl symbol_table_;
   Stats::StatNamePool pool_;
   Stats::AllocatorImpl stats_allocator_;
   Stats::ThreadLocalStoreImpl stats_store_;
   Event::SimulatedTimeSystem time_system_;
+  std::vector<Stats::Counter*> counters_;
 };
 
 static void bmFlushToSinks(::benchmark::State& state) {
@@ -110,10 +136,25 @@ static void bmFlushToSinksWithPredicatesSet(::benchmark::State& state) {
   speed_test.test(state);
 }
 
+static void bmFlushDeltaToSinks(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  StatsSinkFlushSpeedTest speed_test(state.range(0));
+  speed_test.testDelta(state);
+}
+
 BENCHMARK(bmFlushToSinks)->Unit(::benchmark::kMillisecond)->RangeMultiplier(10)->Range(10, 1000000);
 BENCHMARK(bmFlushToSinksWithPredicatesSet)
     ->Unit(::benchmark::kMillisecond)
     ->RangeMultiplier(10)
     ->Range(10, 1000000);
+BENCHMARK(bmFlushDeltaToSinks)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000000);
 
 } // namespace Envoy
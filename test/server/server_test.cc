@@ -111,6 +111,60 @@ TEST(ServerInstanceUtil, flushHelper) {
   InstanceUtil::flushMetricsToSinks(sinks, mock_store, time_system);
 }
 
+// Delta snapshots only hold the metrics changed since the last flush, if all sinks accept them.
+TEST(ServerInstanceUtil, flushDeltaSnapshots) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.delta_stats_flush", "true"}});
+
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& c = store.counter("hello");
+  Stats::Gauge& g = store.gauge("world", Stats::Gauge::ImportMode::Accumulate);
+  store.counter("unused");
+  store.textReadout("text").set("is important");
+  c.inc();
+  g.set(5);
+
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* sink = new NiceMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+  ON_CALL(*sink, acceptsDeltaSnapshots()).WillByDefault(Return(true));
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "hello");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 1);
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "world");
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system);
+
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_TRUE(snapshot.gauges().empty());
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system);
+
+  g.dec();
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 4);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system);
+
+  // A single sink that needs every metric gets full snapshots.
+  Stats::MockSink* full_sink = new NiceMock<Stats::MockSink>();
+  sinks.emplace_back(full_sink);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 1);
+  }));
+  EXPECT_CALL(*full_sink, flush(_));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system);
+}
+
 class RunHelperTest : public testing::Test {
 public:
   RunHelperTest() {
@@ -127,7 +181,7 @@ public:
     ON_CALL(server_, shutdown()).WillByDefault(Assign(&shutdown_, true));
 
     helper_ = std::make_unique<RunHelper>(server_, options_, dispatcher_, cm_, access_log_manager_,
-                                          init_manager_, overload_manager_,
+                                          init_manager_, overload_manager_, startup_profiler_,
                                           [this] { start_workers_.ready(); });
   }
 
@@ -138,6 +192,9 @@ public:
   NiceMock<AccessLog::MockAccessLogManager> access_log_manager_;
   NiceMock<MockOverloadManager> overload_manager_;
   Init::ManagerImpl init_manager_{""};
+  Event::SimulatedTimeSystem time_system_;
+  Stats::TestUtil::TestStore stats_store_;
+  StartupProfiler startup_profiler_{time_system_, *stats_store_.rootScope()};
   ReadyWatcher start_workers_;
   std::unique_ptr<RunHelper> helper_;
   std::function<void()> cm_init_callback_;
@@ -153,6 +210,9 @@ public:
 TEST_F(RunHelperTest, Normal) {
   EXPECT_CALL(start_workers_, ready());
   cm_init_callback_();
+  const envoy::admin::v3::StartupProfile profile = startup_profiler_.profile(0);
+  ASSERT_EQ(1, profile.phases_size());
+  EXPECT_EQ("init_manager", profile.phases(0).name());
 }
 
 // no signals on Windows
@@ -0,0 +1,112 @@
+#include "envoy/admin/v3/startup_profile.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/server/startup_profiler.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/server/admin_stream.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+class StartupProfilerTest : public testing::Test {
+protected:
+  uint64_t wallTimeMs(const std::string& phase) {
+    return store_.findGaugeByString(absl::StrCat("server.startup.", phase, ".wall_time_ms"))
+        ->get()
+        .value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::TestUtil::TestStore store_;
+  StartupProfiler profiler_{time_system_, *store_.rootScope()};
+};
+
+// Verifies that each phase ends when the next one starts, and that the running phase is reported
+// with the time spent in it so far.
+TEST_F(StartupProfilerTest, Phases) {
+  profiler_.startPhase("first");
+  time_system_.advanceTimeWait(std::chrono::milliseconds(10));
+  profiler_.startPhase("second");
+  time_system_.advanceTimeWait(std::chrono::milliseconds(20));
+
+  envoy::admin::v3::StartupProfile profile = profiler_.profile(0);
+  ASSERT_EQ(2, profile.phases_size());
+  EXPECT_EQ("first", profile.phases(0).name());
+  EXPECT_EQ(0, Protobuf::util::TimeUtil::DurationToMilliseconds(profile.phases(0).start()));
+  EXPECT_EQ(10, Protobuf::util::TimeUtil::DurationToMilliseconds(profile.phases(0).wall_time()));
+  EXPECT_EQ("second", profile.phases(1).name());
+  EXPECT_EQ(10, Protobuf::util::TimeUtil::DurationToMilliseconds(profile.phases(1).start()));
+  EXPECT_EQ(20, Protobuf::util::TimeUtil::DurationToMilliseconds(profile.phases(1).wall_time()));
+  EXPECT_FALSE(profile.complete());
+  EXPECT_EQ(10, wallTimeMs("first"));
+  EXPECT_FALSE(store_.findGaugeByString("server.startup.second.wall_time_ms").has_value());
+
+  time_system_.advanceTimeWait(std::chrono::milliseconds(5));
+  profiler_.complete();
+  profiler_.startPhase("ignored");
+  time_system_.advanceTimeWait(std::chrono::milliseconds(5));
+
+  profile = profiler_.profile(0);
+  ASSERT_EQ(2, profile.phases_size());
+  EXPECT_EQ(25, Protobuf::util::TimeUtil::DurationToMilliseconds(profile.phases(1).wall_time()));
+  EXPECT_TRUE(profile.complete());
+  EXPECT_TRUE(profiler_.isComplete());
+  EXPECT_EQ(25, wallTimeMs("second"));
+  EXPECT_TRUE(store_.findGaugeByString("server.startup.second.cpu_time_ms").has_value());
+}
+
+// Verifies that the slowest init targets are reported first.
+TEST_F(StartupProfilerTest, SlowestInitTargets) {
+  profiler_.onInitTargetReady("a", std::chrono::milliseconds(10));
+  profiler_.onInitTargetReady("b", std::chrono::milliseconds(30));
+  profiler_.onInitTargetReady("c", std::chrono::milliseconds(20));
+
+  envoy::admin::v3::StartupProfile profile = profiler_.profile(2);
+  ASSERT_EQ(2, profile.slowest_init_targets_size());
+  EXPECT_EQ("b", profile.slowest_init_targets(0).name());
+  EXPECT_EQ(30, Protobuf::util::TimeUtil::DurationToMilliseconds(
+                    profile.slowest_init_targets(0).duration()));
+  EXPECT_EQ("c", profile.slowest_init_targets(1).name());
+  EXPECT_EQ(3, profiler_.profile(10).slowest_init_targets_size());
+}
+
+TEST_F(StartupProfilerTest, Handler) {
+  profiler_.startPhase("first");
+  profiler_.onInitTargetReady("a", std::chrono::milliseconds(10));
+  profiler_.onInitTargetReady("b", std::chrono::milliseconds(30));
+
+  NiceMock<MockAdminStream> admin_stream;
+  Http::TestResponseHeaderMapImpl response_headers;
+  Buffer::OwnedImpl response;
+  EXPECT_CALL(admin_stream, queryParams())
+      .WillOnce(Return(Http::Utility::QueryParams{{"init_targets", "1"}}));
+  EXPECT_EQ(Http::Code::OK,
+            profiler_.handlerStartupProfile(response_headers, response, admin_stream));
+  EXPECT_EQ("application/json", response_headers.getContentTypeValue());
+  envoy::admin::v3::StartupProfile profile;
+  TestUtility::loadFromJson(response.toString(), profile);
+  EXPECT_EQ(1, profile.phases_size());
+  ASSERT_EQ(1, profile.slowest_init_targets_size());
+  EXPECT_EQ("b", profile.slowest_init_targets(0).name());
+
+  response.drain(response.length());
+  EXPECT_CALL(admin_stream, queryParams())
+      .WillOnce(Return(Http::Utility::QueryParams{{"init_targets", "x"}}));
+  EXPECT_EQ(Http::Code::BadRequest,
+            profiler_.handlerStartupProfile(response_headers, response, admin_stream));
+}
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
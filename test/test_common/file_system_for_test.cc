@@ -56,6 +56,16 @@ protected:
     return resultSuccess(size);
   }
 
+  Api::IoCallSizeResult writev(absl::Span<const absl::string_view> buffers) override {
+    absl::MutexLock l(&info_->lock_);
+    ssize_t written = 0;
+    for (const absl::string_view buffer : buffers) {
+      info_->data_.append(buffer.data(), buffer.size());
+      written += buffer.size();
+    }
+    return resultSuccess(written);
+  }
+
   Api::IoCallBoolResult close() override {
     ASSERT(isOpen());
     open_ = false;